@@ -26,6 +26,17 @@ YML_SCHEMA: str = os.path.join('benchmark', '_schema.yml')
 
 BENCHMARK_SYSTEMS: list[str] = ['mutable', 'PostgreSQL', 'DuckDB', 'HyPer']     # List of systems
 
+BASELINE_DIR: str = os.path.join('benchmark', 'baselines')                      # Baselines, one file per machine
+
+MEASUREMENT_KEY: list[str] = ['suite', 'benchmark', 'experiment', 'name', 'config', 'case']  # What is compared
+
+# Two-sided 95% quantiles of Student's t-distribution by degrees of freedom; 1.96 for more than 30 degrees of freedom
+T_QUANTILES_95: list[float] = [
+    math.inf, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+]
+
 
 class BenchmarkError(Exception):
     pass
@@ -251,6 +262,82 @@ BEGIN
         output_sql_file.write('END$$;')
 
 
+#=======================================================================================================================
+# Statistics for regression tracking
+#=======================================================================================================================
+@typechecked
+def t_quantile_95(dof: float) -> float:
+    return T_QUANTILES_95[max(1, int(dof))] if dof <= 30 else 1.96
+
+# Returns the mean and the half-width of its 95% confidence interval
+@typechecked
+def confidence_interval(times: numpy.ndarray) -> tuple[float, float]:
+    mean: float = float(numpy.mean(times))
+    if len(times) < 2:
+        return mean, math.inf
+    return mean, t_quantile_95(len(times) - 1) * float(numpy.std(times, ddof=1)) / math.sqrt(len(times))
+
+# Returns whether the means of `times` and `baseline` differ significantly at the 5% level by Welch's t-test
+@typechecked
+def differs_significantly(times: numpy.ndarray, baseline: numpy.ndarray) -> bool:
+    if len(times) < 2 or len(baseline) < 2:
+        return False
+    var_t: float = float(numpy.var(times, ddof=1)) / len(times)
+    var_b: float = float(numpy.var(baseline, ddof=1)) / len(baseline)
+    if var_t + var_b == 0:
+        return float(numpy.mean(times)) != float(numpy.mean(baseline))
+    t: float = (float(numpy.mean(times)) - float(numpy.mean(baseline))) / math.sqrt(var_t + var_b)
+    dof: float = (var_t + var_b) ** 2 / \
+        ((var_t ** 2 / (len(times) - 1) if var_t else 0) + (var_b ** 2 / (len(baseline) - 1) if var_b else 0))
+    return abs(t) > t_quantile_95(dof)
+
+# Returns the path of the baseline of this machine
+@typechecked
+def default_baseline_path() -> str:
+    _, nodename, *_ = os.uname()
+    return os.path.join(BASELINE_DIR, f'{nodename}.csv')
+
+# Concatenates the measurements of mutable in `results`
+@typechecked
+def collect_measurements(results: Result) -> Measurements | None:
+    frames: list[Measurements] = list()
+    for suite in results.values():
+        for benchmark in suite.values():
+            for experiment, _ in benchmark.values():
+                frames.extend(m for config, m in experiment.items() if config.startswith('mutable'))
+    return pandas.concat(frames, ignore_index=True) if frames else None
+
+# Compares the measurements with the baseline and prints a report per YAML benchmark.  Returns the number of
+# statistically significant regressions of more than `threshold`.
+@typechecked
+def report_regressions(measurements: Measurements, baseline: Measurements, threshold: float) -> int:
+    num_regressions: int = 0
+    baseline_groups = dict(list(baseline.groupby(MEASUREMENT_KEY)))
+    for (suite, benchmark), benchmark_measurements in measurements.groupby(['suite', 'benchmark']):
+        tqdm_print(f'\n{suite}/{benchmark}:')
+        for key, group in benchmark_measurements.groupby(MEASUREMENT_KEY):
+            _, _, experiment, _, config, case = key
+            label: str = f'  {experiment} [{config}] case {case}'
+            times: numpy.ndarray = group['time'].to_numpy(dtype=float)
+            mean, ci = confidence_interval(times)
+            if key not in baseline_groups:
+                tqdm_print(f'{label}: {mean:.3f} ± {ci:.3f} ms (no baseline)')
+                continue
+            base_times: numpy.ndarray = baseline_groups[key]['time'].to_numpy(dtype=float)
+            base_mean, base_ci = confidence_interval(base_times)
+            change: float = mean / base_mean - 1 if base_mean else 0.
+            verdict: str = ''
+            if differs_significantly(times, base_times):
+                if change > threshold:
+                    verdict = '  REGRESSION'
+                    num_regressions += 1
+                elif change < -threshold:
+                    verdict = '  improvement'
+            tqdm_print(f'{label}: {mean:.3f} ± {ci:.3f} ms vs. {base_mean:.3f} ± {base_ci:.3f} ms '
+                       f'({change:+.1%}){verdict}')
+    return num_regressions
+
+
 #=======================================================================================================================
 # Perform the experiment specified in `yml` and `info` on the connector `conn` and add the measurements to `results`
 #=======================================================================================================================
@@ -262,7 +349,8 @@ def perform_experiment(
     info: SimpleNamespace,
     results: Result,
     output_csv_file: str | None,
-    num_runs: int
+    num_runs: int,
+    num_warmup_runs: int = 0
 ) -> None:
     # Experiment parameters
     systems: dict[str, Any] = yml.get('systems', dict())
@@ -278,7 +366,7 @@ def perform_experiment(
 
     # Perform benchmark
     try:
-        connector_result: ConnectorResult = conn.execute(num_runs, params)
+        connector_result: ConnectorResult = conn.execute(num_warmup_runs + num_runs, params)
     except connector.ConnectorException as ex:
         tqdm_print(f"\nAn error occurred for {system} while executing {info.path_to_file}: {str(ex)}\n")
         raise BenchmarkError()
@@ -290,6 +378,7 @@ def perform_experiment(
         measurements_list: list[list[str | int | float]] = list()
         for label, measurement_result in config_result.items():
             for case, times in measurement_result.items():
+                times = times[num_warmup_runs:]  # discard warm-up runs
                 for run in range(len(times)):
                     measurements_list.append([str(info.commit), info.date, info.version, info.suite_name, info.benchmark_name, info.experiment_name, config_name, label, case, times[run], run])
 
@@ -469,7 +558,8 @@ def run_benchmarks(args: argparse.Namespace) -> None:
                     if system == 'mutable':
                         num_experiments_total += 1
                     try:
-                        perform_experiment(yml, conn, system, info, results, output_csv_file, args.num_runs)
+                        perform_experiment(yml, conn, system, info, results, output_csv_file, args.num_runs,
+                                           args.num_warmup_runs)
                     except BenchmarkError:
                         pass  # nothing to be done
                     else:
@@ -485,8 +575,23 @@ def run_benchmarks(args: argparse.Namespace) -> None:
     log.clear()
     log.close()
 
+    # Compare with the baseline of this machine and store the new baseline
+    num_regressions: int = 0
+    measurements: Measurements | None = collect_measurements(results)
+    baseline_path: str = args.baseline or default_baseline_path()
+    if measurements is not None and os.path.isfile(baseline_path):
+        tqdm_print(f'\nComparing with baseline \'{baseline_path}\'.')
+        baseline: Measurements = pandas.read_csv(baseline_path, dtype={'case': str})
+        measurements['case'] = measurements['case'].astype(str)
+        num_regressions = report_regressions(measurements, baseline, args.regression_threshold)
+        tqdm_print(f'{num_regressions} significant regressions of more than {args.regression_threshold:.0%}')
+    if measurements is not None and args.save_baseline:
+        os.makedirs(os.path.dirname(baseline_path) or '.', exist_ok=True)
+        measurements.to_csv(baseline_path, index=False)
+        tqdm_print(f'Stored baseline \'{baseline_path}\'.')
+
     print(f'Performed {num_experiments_total} experiments on mutable')
-    exit(num_experiments_passed != num_experiments_total)
+    exit(num_experiments_passed != num_experiments_total or num_regressions != 0)
 
 
 #=======================================================================================================================
@@ -505,6 +610,16 @@ if __name__ == '__main__':
                         help='provide additional arguments to pass through to the binary')
     parser.add_argument('-n', '--num-runs', dest='num_runs', metavar='RUNS', default=5, action='store', type=int,
                         help='specify the number of runs per system, configuration, and case')
+    parser.add_argument('-w', '--warm-up', dest='num_warmup_runs', metavar='RUNS', default=1, action='store', type=int,
+                        help='specify the number of runs to discard before measuring')
+    parser.add_argument('--baseline', dest='baseline', metavar='FILE.csv', default=None, action='store',
+                        help='specify the baseline to compare with (defaults to '
+                             '\'benchmark/baselines/<hostname>.csv\')')
+    parser.add_argument('--save-baseline', dest='save_baseline', default=False, action='store_true',
+                        help='store the measurements of mutable as the new baseline')
+    parser.add_argument('--regression-threshold', dest='regression_threshold', metavar='FRACTION', default=0.05,
+                        action='store', type=float,
+                        help='report significant slowdowns by more than this fraction as regressions (defaults to 0.05)')
     parser.add_argument('-v', '--verbose', help='verbose output', dest='verbose', default=False, action='store_true')
     parser.add_argument('--pgsql', dest='pgsql', default=False, action='store_true',
                         help='create a .pgsql file with instructions to insert measurement results into a PostgreSQL '
@@ -1,6 +1,9 @@
 #include "storage/ColumnStore.hpp"
 
 #include "backend/StackMachine.hpp"
+#include "storage/Store.hpp"
+#include "storage/StoreTiering.hpp"
+#include <cstring>
 #include <mutable/catalog/Catalog.hpp>
 #include <numeric>
 
@@ -8,6 +11,43 @@
 using namespace m;
 
 
+namespace {
+
+/** Copies \p n bytes from \p src to \p dst.  Copies of at least `MIN_STREAM_SIZE` bytes bypass the caches using
+ * non-temporal stores since bulk-written columns are usually not read again soon. */
+void stream_copy(uint8_t *dst, const uint8_t *src, std::size_t n)
+{
+    constexpr std::size_t MIN_STREAM_SIZE = 1UL << 16; ///< 64 KiB
+    if (n < MIN_STREAM_SIZE) {
+        std::memcpy(dst, src, n);
+        return;
+    }
+
+    /* Copy the head regularly s.t. all streaming stores are aligned. */
+    const std::size_t head = -reinterpret_cast<uintptr_t>(dst) % sizeof(uint64_t);
+    std::memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    n -= head;
+
+    for (; n >= sizeof(uint64_t); n -= sizeof(uint64_t), dst += sizeof(uint64_t), src += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, src, sizeof(word));
+        __builtin_nontemporal_store(word, reinterpret_cast<uint64_t*>(dst));
+    }
+    std::memcpy(dst, src, n); // copy the tail regularly
+}
+
+/** Sets bit \p idx of the bitmap at \p bitmap to \p value, least significant bit first. */
+void set_bit(uint8_t *bitmap, std::size_t idx, bool value)
+{
+    const uint8_t mask = 1U << (idx % 8U);
+    bitmap[idx / 8U] = value ? bitmap[idx / 8U] | mask : bitmap[idx / 8U] & ~mask;
+}
+
+}
+
+
 ColumnStore::ColumnStore(const Table &table)
     : Store(table)
 {
@@ -15,6 +55,7 @@ ColumnStore::ColumnStore(const Table &table)
 
     /* Allocate memory for the attributes columns and the null bitmap column. */
     data_ = allocator_.allocate(ALLOCATION_SIZE * (table.num_attrs() + 1));
+    numa_interleave(data_.addr(), data_.size());
 
     /* Compute the capacity depending on the column with the largest attribute size. */
     for (auto attr = table.begin_all(); attr != table.end_all(); ++attr) {
@@ -30,13 +71,44 @@ ColumnStore::ColumnStore(const Table &table)
     capacity_ = (ALLOCATION_SIZE * 8) / max_attr_size;
 }
 
-ColumnStore::~ColumnStore() { }
+ColumnStore::~ColumnStore() { StoreTiering::Get().forget(*this); }
+
+void ColumnStore::write_column(std::size_t attr_id, std::size_t first_row, std::size_t num_rows, const void *values,
+                               const uint8_t *is_null)
+{
+    M_insist(attr_id < table().num_attrs(), "attribute ID out of range");
+    M_insist(first_row + num_rows <= num_rows_, "rows must have been appended before");
+
+    /*----- Write the values. -----*/
+    const auto size = table()[attr_id].type->size(); // in bits
+    auto column = reinterpret_cast<uint8_t*>(memory(attr_id));
+    auto src = reinterpret_cast<const uint8_t*>(values);
+    if (size % 8 == 0) {
+        stream_copy(column + first_row * (size / 8), src, num_rows * (size / 8));
+    } else {
+        M_insist(size == 1, "only booleans are not byte-aligned");
+        for (std::size_t i = 0; i != num_rows; ++i)
+            set_bit(column, first_row + i, src[i / 8U] >> (i % 8U) & 1U);
+    }
+
+    /*----- Write the NULL bits of the attribute to the NULL bitmap column, which stores `num_attrs` bits per row. -----*/
+    const auto num_attrs = table().num_attrs();
+    auto null_bitmap = reinterpret_cast<uint8_t*>(memory(num_attrs));
+    for (std::size_t i = 0; i != num_rows; ++i)
+        set_bit(null_bitmap, (first_row + i) * num_attrs + attr_id, is_null and (is_null[i / 8U] >> (i % 8U) & 1U));
+}
 
 M_LCOV_EXCL_START
 void ColumnStore::dump(std::ostream &out) const
 {
     out << "ColumnStore for table \"" << table().name() << "\": " << num_rows_ << '/' << capacity_
         << " rows, " << row_size_ << " bits per row" << std::endl;
+
+    std::vector<std::pair<const void*, std::size_t>> columns;
+    for (std::size_t attr_id = 0; attr_id != table().num_attrs(); ++attr_id)
+        columns.emplace_back(memory(attr_id), (num_rows_ * table()[attr_id].type->size() + 7) / 8);
+    columns.emplace_back(memory(table().num_attrs()), (num_rows_ * table().num_attrs() + 7) / 8); // NULL bitmap
+    dump_numa_placement(out, columns);
 }
 M_LCOV_EXCL_STOP
 
@@ -3,6 +3,7 @@
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/storage/Store.hpp>
 #include <mutable/util/memory.hpp>
+#include <utility>
 
 
 namespace m {
@@ -38,6 +39,20 @@ struct ColumnStore : Store
         ++num_rows_;
     }
 
+    /** Appends \p n rows at once and returns the id of the first appended row. */
+    std::size_t append(std::size_t n) {
+        if (n > capacity_ - num_rows_)
+            throw std::logic_error("row store exceeds capacity");
+        return std::exchange(num_rows_, num_rows_ + n);
+    }
+
+    /** Writes \p num_rows values of the attribute with id `attr_id`, densely packed at \p values, to the rows starting
+     * at \p first_row.  Booleans are packed as single bits, least significant bit first.  Bit `i` of \p is_null is set
+     * iff the `i`-th value is NULL; if \p is_null is `nullptr`, no value is NULL.  The rows must have been appended
+     * before.  Large columns are written with non-temporal stores to not pollute the caches. */
+    void write_column(std::size_t attr_id, std::size_t first_row, std::size_t num_rows, const void *values,
+                      const uint8_t *is_null = nullptr);
+
     void drop() override {
         M_insist(num_rows_);
         --num_rows_;
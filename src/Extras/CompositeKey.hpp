@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/util/exception.hpp>
+#include <mutable/util/fn.hpp>
+#include <vector>
+
+
+namespace m {
+
+namespace idx {
+
+/** Packs the values of multiple integral attributes, e.g. `(tenant_id, ts)`, into a single `int64_t` key, such that
+ * keys compare like the tuples of values, i.e. lexicographically.  Each attribute occupies a bit field of the width
+ * of its type, biased to be unsigned, with the first attribute in the most significant bits.  Hence, an index on the
+ * packed keys answers lookups of a whole tuple, of a prefix of the attributes, and of a prefix with a range on its
+ * last attribute as a range of keys, see `lower()` and `upper()`.
+ *
+ * Only attributes of type `BOOL`, `INT`, `DECIMAL`, `DATE`, and `DATETIME` whose widths sum up to at most 64 bits can
+ * be packed. */
+struct CompositeKey
+{
+    private:
+    std::vector<unsigned> widths_; ///< the width in bits of each attribute
+
+    public:
+    /** Creates the composite key of the attributes of \p key_schema.  Throws `invalid_argument` if the attributes
+     * cannot be packed into 64 bits. */
+    explicit CompositeKey(const Schema &key_schema) {
+        unsigned total_width = 0;
+        for (auto &e : key_schema) {
+            const unsigned width = visit(overloaded {
+                [](const Boolean&) -> unsigned { return 1; },
+                [](const Numeric &n) -> unsigned {
+                    if (n.kind == Numeric::N_Float)
+                        throw invalid_argument("Floating-point attributes cannot be part of a composite key.");
+                    return n.size();
+                },
+                [](const Date&) -> unsigned { return 32; },
+                [](const DateTime&) -> unsigned { return 64; },
+                [](auto&&) -> unsigned { throw invalid_argument("Invalid type of composite key attribute."); },
+            }, *e.type);
+            widths_.push_back(width);
+            total_width += width;
+        }
+        if (total_width > 64)
+            throw invalid_argument("Composite key does not fit into 64 bits.");
+    }
+
+    /** Returns the number of attributes of the key. */
+    std::size_t num_attributes() const { return widths_.size(); }
+
+    /** Returns the key of the tuple of \p values, one per attribute. */
+    int64_t pack(const std::vector<int64_t> &values) const {
+        M_insist(values.size() == num_attributes(), "one value per attribute required");
+        return lower(values);
+    }
+
+    /** Returns the smallest key whose leading attributes equal \p prefix. */
+    int64_t lower(const std::vector<int64_t> &prefix) const { return pack_prefix(prefix, false); }
+    /** Returns the largest key whose leading attributes equal \p prefix. */
+    int64_t upper(const std::vector<int64_t> &prefix) const { return pack_prefix(prefix, true); }
+
+    private:
+    /** Packs \p prefix and fills the bits of the remaining attributes with ones iff \p fill is set. */
+    int64_t pack_prefix(const std::vector<int64_t> &prefix, bool fill) const {
+        M_insist(prefix.size() <= num_attributes(), "prefix exceeds the attributes of the key");
+        uint64_t key = 0;
+        unsigned total_width = 0;
+        for (std::size_t i = 0; i != num_attributes(); ++i) {
+            const unsigned w = widths_[i];
+            const uint64_t mask = w == 64 ? ~uint64_t(0) : (uint64_t(1) << w) - 1;
+            uint64_t field;
+            if (i < prefix.size())
+                field = w == 1 ? uint64_t(prefix[i]) & 1 // booleans are unsigned
+                               : (uint64_t(prefix[i]) + (uint64_t(1) << (w - 1))) & mask; // bias to be unsigned
+            else
+                field = fill ? mask : 0;
+            key = w == 64 ? field : (key << w) | field;
+            total_width += w;
+        }
+        if (total_width and total_width < 64)
+            key <<= 64 - total_width; // align first attribute to the most significant bits
+        return int64_t(key ^ (uint64_t(1) << 63)); // flip the sign bit such that signed order equals unsigned order
+    }
+};
+
+}
+
+}
@@ -1,9 +1,14 @@
 #include <mutable/storage/DataLayoutFactory.hpp>
 
+#include <algorithm>
+#include <bit>
+#include <fstream>
 #include <memory>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/catalog/Type.hpp>
 #include <numeric>
+#include <string>
+#include <unistd.h>
 
 
 using namespace m;
@@ -226,6 +231,42 @@ DataLayout PAXLayoutFactory::make(std::vector<const Type*> types, std::size_t nu
     return layout;
 }
 
+namespace {
+
+/** Returns the size of the L2 cache in bytes, or 0 if unknown. */
+std::size_t l2_cache_size()
+{
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    if (const long size = sysconf(_SC_LEVEL2_CACHE_SIZE); size > 0)
+        return size;
+#endif
+    /* Fall back to the cache topology in sysfs, e.g. "1024K". */
+    std::ifstream in("/sys/devices/system/cpu/cpu0/cache/index2/size");
+    std::size_t size;
+    std::string unit;
+    if (not (in >> size))
+        return 0;
+    if (in >> unit) {
+        if (unit.starts_with('K')) size <<= 10;
+        else if (unit.starts_with('M')) size <<= 20;
+    }
+    return size;
+}
+
+/** Returns the block size in bytes for PAX layouts chosen by the host's cache hierarchy.  A block is sized to fill
+ * the L2 cache s.t. all columns of a block accessed by a scan stay cached while the block is processed and the number
+ * of blocks, and hence of jumps between blocks, is minimal.  The size is floored to a power of 2 and clamped to
+ * [4 KiB, 4 MiB].  Without cache information, the default 4 MiB blocks are used. */
+std::size_t auto_pax_block_size()
+{
+    const std::size_t l2_size = l2_cache_size();
+    if (l2_size == 0)
+        return 1UL << 22;
+    return std::clamp<std::size_t>(std::bit_floor(l2_size), 1UL << 12, 1UL << 22);
+}
+
+}
+
 __attribute__((constructor(202)))
 static void register_data_layouts()
 {
@@ -242,6 +283,11 @@ static void register_data_layouts()
     REGISTER_PAX_TUPLES(PAX16Tup, 16, "stores attributes using PAX layout with blocks for 16 tuples");
     REGISTER_PAX_TUPLES(PAX128Tup, 128, "stores attributes using PAX layout with blocks for 128 tuples");
     REGISTER_PAX_TUPLES(PAX1024Tup, 1024, "stores attributes using PAX layout with blocks for 1024 tuples");
+    REGISTER_PAX_TUPLES(PAX64KTup, 1UL << 16, "stores attributes using PAX layout with blocks for 65536 tuples, "
+                                              "i.e. in columnar row groups");
+    C.register_data_layout(C.pool("PAXAuto"),
+                           std::make_unique<PAXLayoutFactory>(PAXLayoutFactory::NBytes, auto_pax_block_size()),
+                           "stores attributes using PAX layout with blocks sized to the L2 cache of the host");
     C.register_data_layout(C.pool("Row"), std::make_unique<RowLayoutFactory>(), "stores attributes in row-major order");
 #undef REGISTER_PAX
 }
@@ -1,5 +1,6 @@
 #include <mutable/IR/HeuristicSearchPlanEnumerator.hpp>
 
+#include <chrono>
 #include <cstring>
 #include <execution>
 #include <functional>
@@ -187,6 +188,12 @@ bool heuristic_search(PlanTable &PT, const QueryGraph &G, const AdjacencyMatrix
             std::cout << "initial upper bound is " << config.upper_bound << std::endl;
     }
 
+    /* Measure the duration of the search itself, excluding plan reconstruction, to report the expansion rate. */
+    using clock = std::chrono::steady_clock;
+    const auto search_start = clock::now();
+    std::chrono::duration<double> search_time{0};
+    auto stop_search_timer = [&]() { search_time = clock::now() - search_start; };
+
     try {
         State initial_state = Expand::template Start<State>(PT, G, M, CF, CE);
         using H = Heuristic<PlanTable, State, Expand>;
@@ -201,6 +208,7 @@ bool heuristic_search(PlanTable &PT, const QueryGraph &G, const AdjacencyMatrix
             /*----- Context -----*/
             PT, G, M, CF, CE
         );
+        stop_search_timer();
         if (Options::Get().statistics)
             S.dump(std::cout);
 
@@ -212,6 +220,7 @@ bool heuristic_search(PlanTable &PT, const QueryGraph &G, const AdjacencyMatrix
             reconstruct_plan_bottom_up(goal, PT, G, CE, CF);
         }
     } catch (std::logic_error) {
+        stop_search_timer();
         /*----- Handle incomplete search not finding a plan. -----*/
         /* Any incplete search may *not* find a plan and hence throw a `std::logic_error`.  In this case, we can attempt
          * to use a plan we found during initialization of the search.  If we do no have such a plan, we resort to a
@@ -237,6 +246,7 @@ bool heuristic_search(PlanTable &PT, const QueryGraph &G, const AdjacencyMatrix
          * the state X with the lowest f-value (f(X)=g(X)+h(X)).  In the case that this state is a goal state, the found
          * path to this state is returned.  Otherwise, use GOO from this state to find a plan. */
 
+        stop_search_timer();
         M_insist(SearchAlgorithm::use_anytime_search, "exception can only be thrown during anytime search");
         if (Options::Get().statistics)
             S.dump(std::cout);
@@ -349,9 +359,12 @@ bool heuristic_search(PlanTable &PT, const QueryGraph &G, const AdjacencyMatrix
                   << "\nVertices expanded: " << State::NUM_STATES_EXPANDED()
                   << "\nVertices constructed: " << State::NUM_STATES_CONSTRUCTED()
                   << "\nVertices disposed: " << State::NUM_STATES_DISPOSED()
+                  << "\nVertices expanded per second: " << State::NUM_STATES_EXPANDED() / search_time.count()
                   << std::endl;
     }
 #endif
+    if (Options::Get().statistics)
+        std::cout << "Heuristic search time: " << search_time.count() * 1e3 << " ms" << std::endl;
     return true;
 }
 
@@ -1,10 +1,15 @@
 #include <mutable/storage/Index.hpp>
 
+#include "backend/Interpreter.hpp"
+#include "storage/CompositeKey.hpp"
+#include "storage/IndexMaintenance.hpp"
+#include "util/WorkerPool.hpp"
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/catalog/Type.hpp>
 #include <mutable/mutable.hpp>
 #include <mutable/Options.hpp>
 #include <mutable/util/Timer.hpp>
+#include <optional>
 #include <sstream>
 
 
@@ -18,56 +23,84 @@ namespace options {
 /** Which ratio of linear models to index entries should be used for `idx::RecursiveModelIndex`. */
 double rmi_model_entry_ratio = 0.01;
 
+/** How many threads should be used to sort index entries and train the models of `idx::RecursiveModelIndex`.  0 means
+ * all threads of the `WorkerPool`. */
+unsigned index_build_threads = 0;
+
 }
 
-__attribute__((constructor(201)))
-static void add_index_args()
+/** Returns the number of threads to use for building an index of \p num_entries entries.  Small indexes are built by a
+ * single thread since distributing the work would dominate. */
+std::size_t num_build_threads(std::size_t num_entries)
 {
-    Catalog &C = Catalog::Get();
-
-    /*----- Command-line arguments -----*/
-    C.arg_parser().add<double>(
-        /* group=       */ "Index",
-        /* short=       */ nullptr,
-        /* long=        */ "--rmi-model-entry-ratio",
-        /* description= */ "specify the ratio of linear models to index entries for recursive model indexes",
-        /* callback=    */ [](double rmi_model_entry_ratio){ options::rmi_model_entry_ratio = rmi_model_entry_ratio; }
-    );
+    constexpr std::size_t MIN_ENTRIES_PER_THREAD = 1UL << 16;
+    const std::size_t num_threads = options::index_build_threads ? options::index_build_threads
+                                                                 : WorkerPool::Get().num_threads();
+    return std::clamp<std::size_t>(num_entries / MIN_ENTRIES_PER_THREAD, 1, num_threads);
 }
 
+/** Calls \p fn for each of the \p num_threads consecutive, equally sized chunks of `[0, n)` on up to \p num_threads
+ * threads of the `WorkerPool` and waits for all of them to finish.  \p fn receives the index of the chunk and its
+ * bounds. */
+template<typename Fn>
+void parallel_for_chunks(std::size_t n, std::size_t num_threads, Fn &&fn)
+{
+    WorkerPool::Get().parallel_for(num_threads, [&](std::size_t t) {
+        fn(t, n * t / num_threads, n * (t + 1) / num_threads);
+    }, num_threads);
 }
 
-std::string IndexBase::build_query(const Table &table, const Schema &schema)
+/** Sorts `[begin, end)` w.r.t. \p cmp by sorting \p num_threads chunks in parallel and merging them pairwise in
+ * parallel rounds. */
+template<typename It, typename Cmp>
+void parallel_sort(It begin, It end, Cmp cmp, std::size_t num_threads)
 {
-    std::ostringstream oss;
-    oss << "SELECT ";
-    for (std::size_t i = 0; i != schema.num_entries(); ++i) {
-        if (i != 0) oss << ", ";
-        oss << schema.at(i).id;
+    const std::size_t n = std::distance(begin, end);
+    std::vector<std::size_t> bounds;
+    bounds.reserve(num_threads + 1);
+    for (std::size_t t = 0; t <= num_threads; ++t)
+        bounds.push_back(n * t / num_threads);
+
+    parallel_for_chunks(n, num_threads, [&](std::size_t, std::size_t lo, std::size_t hi) {
+        std::sort(begin + lo, begin + hi, cmp);
+    });
+
+    for (std::size_t width = 1; width < num_threads; width *= 2) {
+        const std::size_t num_merges = (num_threads + width - 1) / (2 * width); // chunks `i` and `i + width` each
+        WorkerPool::Get().parallel_for(num_merges, [&](std::size_t merge) {
+            const std::size_t i = 2 * width * merge;
+            const auto lo = begin + bounds[i];
+            const auto mid = begin + bounds[i + width];
+            const auto hi = begin + bounds[std::min(i + 2 * width, num_threads)];
+            std::inplace_merge(lo, mid, hi, cmp);
+        }, num_merges);
     }
-    oss << " FROM " << table.name() << ';';
-    return oss.str();
 }
 
+/** Checks that the attributes of \p key_schema can be keys of an index of key type `Key` and returns a function
+ * computing the key of a tuple of \p key_schema.  Emplaces \p composite_key, which the function refers to, if \p
+ * key_schema contains multiple entries.  Throws `invalid_argument` if the types do not match. */
 template<typename Key>
-void ArrayIndex<Key>::bulkload(const Table &table, const Schema &key_schema)
+std::function<Key(const Tuple&)> key_getter(const Schema &key_schema, std::optional<CompositeKey> &composite_key)
 {
-    /* XXX: Disable timer during execution to not print times for query that is performed as part of bulkloading. */
-    const auto &old_timer = std::exchange(Catalog::Get().timer(), Timer());
-
-    /* Check that key schema contains a single entry. */
-    if (key_schema.num_entries() != 1)
-        throw invalid_argument("Key schema should contain exactly one entry.");
+    /* Check that key schema contains a single entry or the entries of a composite key, see `CompositeKey`. */
+    if (key_schema.num_entries() == 0)
+        throw invalid_argument("Key schema should contain at least one entry.");
+    if (key_schema.num_entries() > 1) {
+        if constexpr(not std::same_as<Key, int64_t>)
+            throw invalid_argument("Composite keys require key type int64_t.");
+        composite_key.emplace(key_schema);
+    }
     auto entry = key_schema.at(0);
 
     /* Check that key type and attribute type match. */
     auto attribute_type = entry.type;
 #define CHECK(TYPE) \
-    if constexpr(not std::same_as<key_type, TYPE>) \
+    if constexpr(not std::same_as<Key, TYPE>) \
         throw invalid_argument("Key type and attribute type do not match."); \
     return
 
-    visit(overloaded {
+    if (not composite_key) visit(overloaded {
         [](const Boolean&) { CHECK(bool); },
         [](const Numeric &n) {
             switch (n.kind) {
@@ -93,7 +126,73 @@ void ArrayIndex<Key>::bulkload(const Table &table, const Schema &key_schema)
         [](const DateTime&) { CHECK(int64_t); },
         [](auto&&) { M_unreachable("invalid type"); },
     }, *attribute_type);
-#undef CHECk
+#undef CHECK
+
+    std::function<Key(const Tuple&)> fn_get;
+    if (composite_key) {
+        if constexpr(std::same_as<Key, int64_t>) {
+            fn_get = [&composite_key](const Tuple &t) {
+                std::vector<int64_t> values;
+                values.reserve(composite_key->num_attributes());
+                for (std::size_t i = 0; i != composite_key->num_attributes(); ++i)
+                    values.push_back(t.get(i).as<int64_t>());
+                return composite_key->pack(values);
+            };
+        }
+    } else if constexpr(integral<Key>)
+        fn_get = [](const Tuple &t) { return static_cast<Key>(t.get(0).as<int64_t>()); };
+    else // bool, float, double, const char*
+        fn_get = [](const Tuple &t) { return t.get(0).as<Key>(); };
+
+    return fn_get;
+}
+
+__attribute__((constructor(201)))
+static void add_index_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<double>(
+        /* group=       */ "Index",
+        /* short=       */ nullptr,
+        /* long=        */ "--rmi-model-entry-ratio",
+        /* description= */ "specify the ratio of linear models to index entries for recursive model indexes",
+        /* callback=    */ [](double rmi_model_entry_ratio){ options::rmi_model_entry_ratio = rmi_model_entry_ratio; }
+    );
+    C.arg_parser().add<unsigned>(
+        /* group=       */ "Index",
+        /* short=       */ nullptr,
+        /* long=        */ "--index-build-threads",
+        /* description= */ "specify the number of threads used to sort and train indexes (0 means all threads of the "
+                           "worker pool)",
+        /* callback=    */ [](unsigned index_build_threads){ options::index_build_threads = index_build_threads; }
+    );
+}
+
+}
+
+std::string IndexBase::build_query(const Table &table, const Schema &schema)
+{
+    std::ostringstream oss;
+    oss << "SELECT ";
+    for (std::size_t i = 0; i != schema.num_entries(); ++i) {
+        if (i != 0) oss << ", ";
+        oss << schema.at(i).id;
+    }
+    oss << " FROM " << table.name() << ';';
+    return oss.str();
+}
+
+template<typename Key>
+void ArrayIndex<Key>::bulkload(const Table &table, const Schema &key_schema)
+{
+    /* XXX: Disable timer during execution to not print times for query that is performed as part of bulkloading. */
+    const auto &old_timer = std::exchange(Catalog::Get().timer(), Timer());
+
+    /* Check the key schema and define get function based on key_type. */
+    std::optional<CompositeKey> composite_key;
+    auto fn_get = key_getter<key_type>(key_schema, composite_key);
 
     /* Build the query to retrieve keys. */
     auto query = build_query(table, key_schema);
@@ -104,17 +203,13 @@ void ArrayIndex<Key>::bulkload(const Table &table, const Schema &key_schema)
     /* Compute statement from query string. */
     auto stmt = statement_from_string(diag, query);
 
-    /* Define get function based on key_type. */
-    std::function<key_type(const Tuple&)> fn_get;
-    if constexpr(integral<key_type>)
-        fn_get = [](const Tuple &t) { return static_cast<key_type>(t.get(0).as<int64_t>()); };
-    else // bool, float, double, const char*
-        fn_get = [](const Tuple &t) { return t.get(0).as<key_type>(); };
-
     /* Define callback operator to add keys to index. */
     std::size_t tuple_id = 0;
-    auto fn_add = [&](const Schema&, const Tuple &tuple) {
-        if (not tuple.is_null(0))
+    auto fn_add = [&](const Schema &schema, const Tuple &tuple) {
+        bool has_null = false;
+        for (std::size_t i = 0; i != schema.num_entries(); ++i)
+            has_null = has_null or tuple.is_null(i);
+        if (not has_null)
             this->add(fn_get(tuple), tuple_id);
         tuple_id++;
     };
@@ -131,11 +226,11 @@ void ArrayIndex<Key>::bulkload(const Table &table, const Schema &key_schema)
     /* Execute query to insert tuples. */
     m::execute_query(diag, as<ast::SelectStmt>(*stmt), std::move(consumer), *backend);
 
+    /* XXX: Reenable timer, such that the timings of finalizing the index are reported. */
+    std::exchange(Catalog::Get().timer(), std::move(old_timer));
+
     /* Finalize index. */
     finalize();
-
-    /* XXX: Reenable timer. */
-    std::exchange(Catalog::Get().timer(), std::move(old_timer));
 }
 
 template<typename Key>
@@ -153,16 +248,28 @@ void ArrayIndex<Key>::add(const key_type key, const value_type value)
 template<arithmetic Key>
 void RecursiveModelIndex<Key>::finalize()
 {
-    /* Sort data. */
-    std::sort(base_type::data_.begin(), base_type::data_.end(), base_type::cmp);
+    auto &C = Catalog::Get();
+
+    /* Sort data.  Entries added after the last finalization, e.g. by `append_rows()`, form an unsorted suffix which is
+     * sorted on its own and merged with the sorted prefix. */
+    const std::size_t n_threads = num_build_threads(base_type::data_.size());
+    auto sorting = C.timer().create_timing("Sort index entries");
+    auto sorted_end = std::is_sorted_until(base_type::data_.begin(), base_type::data_.end(), base_type::cmp);
+    parallel_sort(sorted_end, base_type::data_.end(), base_type::cmp,
+                  num_build_threads(std::distance(sorted_end, base_type::data_.end())));
+    std::inplace_merge(base_type::data_.begin(), sorted_end, base_type::data_.end(), base_type::cmp);
+    sorting.stop();
 
     /* Compute number of models. */
     auto begin = base_type::begin();
     auto end = base_type::end();
     std::size_t n_keys = std::distance(begin, end);
     std::size_t n_models = std::max<std::size_t>(1, n_keys * options::rmi_model_entry_ratio);
+    models_.clear();
     models_.reserve(n_models + 1);
 
+    auto training = C.timer().create_timing("Train index models");
+
     /* Train first layer. */
     models_.emplace_back(
         LinearModel::train_linear_spline(
@@ -173,51 +280,53 @@ void RecursiveModelIndex<Key>::finalize()
         )
     );
 
-    /* Train second layer. */
+    /* Compute the segments of the second layer, i.e. the first key predicted to belong to each segment.  Since the
+     * first layer is monotone, each segment is found by binary search. */
     auto get_segment_id = [&](entry_type e) { return std::clamp<double>(models_[0](e.first), 0, n_models - 1);  };
-    std::size_t segment_start = 0;
-    std::size_t segment_id = 0;
-    for (std::size_t i = 0; i != n_keys; ++i) {
-        auto pos = begin + i;
-        std::size_t pred_segment_id = get_segment_id(*pos);
-        if (pred_segment_id > segment_id) {
-            models_.emplace_back(
-                LinearModel::train_linear_regression(
-                    /* begin=  */ begin + segment_start,
-                    /* end=    */ pos,
-                    /* offset= */ segment_start
-                )
-            );
-            for (std::size_t j = segment_id + 1; j < pred_segment_id; ++j) {
-                models_.emplace_back(
+    std::vector<std::size_t> segment_starts(n_models + 1);
+    segment_starts[0] = 0;
+    segment_starts[n_models] = n_keys;
+    const std::size_t n_boundaries = n_models - 1;
+    parallel_for_chunks(n_boundaries, std::min(n_threads, n_boundaries), [&](std::size_t, std::size_t lo, std::size_t hi) {
+        for (std::size_t segment_id = lo + 1; segment_id != hi + 1; ++segment_id) {
+            auto pos = std::partition_point(begin, end, [&](entry_type e) {
+                return std::size_t(get_segment_id(e)) < segment_id;
+            });
+            segment_starts[segment_id] = std::distance(begin, pos);
+        }
+    });
+
+    /* Train second layer in parallel.  Empty segments are trained on the last key preceding them. */
+    const std::size_t n_model_threads = std::min(n_threads, n_models);
+    std::vector<std::vector<LinearModel>> models(n_model_threads);
+    parallel_for_chunks(n_models, n_model_threads, [&](std::size_t t, std::size_t lo, std::size_t hi) {
+        models[t].reserve(hi - lo);
+        for (std::size_t segment_id = lo; segment_id != hi; ++segment_id) {
+            const std::size_t segment_start = segment_starts[segment_id];
+            const std::size_t segment_end = segment_starts[segment_id + 1];
+            if (segment_start != segment_end or segment_id == 0) {
+                models[t].emplace_back(
                     LinearModel::train_linear_regression(
-                        /* begin=  */ pos - 1,
-                        /* end=    */ pos,
-                        /* offset= */ i - 1
+                        /* begin=  */ begin + segment_start,
+                        /* end=    */ begin + segment_end,
+                        /* offset= */ segment_start
+                    )
+                );
+            } else {
+                const std::size_t last = std::max<std::size_t>(segment_start, 1) - 1;
+                models[t].emplace_back(
+                    LinearModel::train_linear_regression(
+                        /* begin=  */ begin + last,
+                        /* end=    */ begin + last + 1,
+                        /* offset= */ last
                     )
                 );
             }
-            segment_id = pred_segment_id;
-            segment_start = i;
-
         }
-    }
-    models_.emplace_back(
-        LinearModel::train_linear_regression(
-            /* begin=  */ begin + segment_start,
-            /* end=    */ end,
-            /* offset= */ segment_start
-        )
-    );
-    for (std::size_t j = segment_id + 1; j < n_models; ++j) {
-        models_.emplace_back(
-            LinearModel::train_linear_regression(
-                /* begin=  */ end - 1,
-                /* end=    */ end,
-                /* offset= */ n_keys - 1
-            )
-        );
-    }
+    });
+    for (auto &thread_models : models)
+        models_.insert(models_.end(), thread_models.begin(), thread_models.end());
+    training.stop();
 
     /* Mark index as finalized. */
     base_type::finalized_ = true;
@@ -228,3 +337,46 @@ void RecursiveModelIndex<Key>::finalize()
     template struct CLASS;
 M_INDEX_LIST_TEMPLATED(INSTANTIATE)
 #undef INSTANTIATE
+
+namespace {
+
+/** Adds the keys of \p key_schema of the rows of \p table from \p first_row on to \p index and finalizes it. */
+template<typename Key>
+void append_keys(ArrayIndex<Key> &index, const Table &table, const Schema &key_schema, std::size_t first_row)
+{
+    std::optional<CompositeKey> composite_key;
+    auto fn_get = key_getter<Key>(key_schema, composite_key);
+
+    /* Load the appended rows directly from the store and skip rows with NULL keys, like `bulkload()` does. */
+    const std::size_t num_rows = table.store().num_rows();
+    if (first_row < num_rows) {
+        auto loader = Interpreter::compile_load(key_schema, table.store().memory().addr(), table.layout(),
+                                                table.schema(), first_row);
+        Tuple tuple(key_schema);
+        Tuple *args[] = { &tuple };
+        for (std::size_t row = first_row; row != num_rows; ++row) {
+            loader(args);
+            bool has_null = false;
+            for (std::size_t i = 0; i != key_schema.num_entries(); ++i)
+                has_null = has_null or tuple.is_null(i);
+            if (not has_null)
+                index.add(fn_get(tuple), row);
+        }
+    }
+    index.finalize();
+}
+
+}
+
+bool m::idx::append_rows(IndexBase &index, const Table &table, const Schema &key_schema, std::size_t first_row)
+{
+    /* A `RecursiveModelIndex` is an `ArrayIndex` whose `finalize()` merges added entries and retrains the models. */
+#define APPEND(CLASS) \
+    if (auto idx = dynamic_cast<CLASS*>(&index)) { \
+        append_keys(*idx, table, key_schema, first_row); \
+        return true; \
+    }
+    M_INDEX_LIST_TEMPLATED(APPEND)
+#undef APPEND
+    return false;
+}
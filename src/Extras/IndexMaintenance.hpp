@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/storage/Index.hpp>
+
+
+namespace m {
+
+namespace idx {
+
+/** Adds the keys of \p key_schema of the rows of \p table from \p first_row on to \p index and finalizes it again.
+ * Only the appended rows are loaded, instead of rerunning the bulkloading query over the entire table.  Returns
+ * `false` if \p index does not support adding keys, in which case it must be bulkloaded again.  Throws
+ * `invalid_argument` if the key type of \p index does not match \p key_schema. */
+bool append_rows(IndexBase &index, const Table &table, const Schema &key_schema, std::size_t first_row);
+
+}
+
+}
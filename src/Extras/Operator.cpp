@@ -465,8 +465,6 @@ void SchemaMinimizer::operator()(LimitOperator &op)
 
 void SchemaMinimizer::operator()(GroupingOperator &op)
 {
-    Catalog &C = Catalog::Get();
-
     Schema ours;
     Schema required_by_us;
 
@@ -477,21 +475,18 @@ void SchemaMinimizer::operator()(GroupingOperator &op)
     }
 
     if (not op.aggregates().empty()) {
-        std::ostringstream oss;
         std::size_t pos_out = 0;
         for (std::size_t pos_in = 0; pos_in != op.aggregates().size(); ++pos_in) {
             M_insist(pos_out <= pos_in);
             auto &agg = op.aggregates()[pos_in];
+            /* Find the entry by position, since an aggregate may be renamed, e.g. by eager aggregation. */
+            auto &e = op.schema()[op.group_by().size() + pos_in];
 
-            oss.str("");
-            oss << agg.get();
-            Schema::Identifier agg_id(C.pool(oss.str()));
-
-            if (is_top_of_plan_ or required.has(agg_id)) { // if first, require everything
+            if (is_top_of_plan_ or required.has(e.id)) { // if first, require everything
                 for (auto &arg : agg.get().args)
                     required_by_us |= arg->get_required();
                 op.aggregates()[pos_out++] = std::move(op.aggregates()[pos_in]); // keep aggregate
-                ours.add(op.schema()[agg_id].second);
+                ours.add(e);
             }
         }
         M_insist(pos_out <= op.aggregates().size());
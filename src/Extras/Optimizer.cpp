@@ -1,12 +1,19 @@
 #include <mutable/IR/Optimizer.hpp>
 
+#include "catalog/Partitionings.hpp"
+#include "IR/PlanCache.hpp"
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/IR/Operator.hpp>
 #include <mutable/Options.hpp>
 #include <mutable/parse/AST.hpp>
 #include <mutable/storage/Store.hpp>
 #include <numeric>
+#include <optional>
+#include <string>
 #include <vector>
 
 
@@ -14,6 +21,75 @@ using namespace m;
 using namespace m::ast;
 
 
+namespace {
+
+namespace options {
+
+/** Whether to cache join orders of structurally identical queries. */
+bool plan_cache = false;
+/** Whether to join all relations of a cyclic query graph by a single multi-way join if the binary join order produces
+ * large intermediate results.  The interpreter evaluates such joins worst-case optimally, other backends by nested
+ * loops. */
+bool multiway_join = false;
+/** The factor by which the largest intermediate result of the binary join order must exceed both the largest input and
+ * the result of the join to use a multi-way join instead, see `--multiway-join`. */
+double multiway_join_min_blowup = 10;
+/** Whether to pre-aggregate a data source below the joins if that shrinks it sufficiently. */
+bool eager_aggregation = false;
+/** The maximal ratio of the estimated number of groups to the estimated cardinality of a data source to pre-aggregate
+ * it, see `--eager-aggregation`. */
+double eager_aggregation_max_ratio = 0.5;
+
+}
+
+__attribute__((constructor(201)))
+static void add_optimizer_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<bool>(
+        /* group=       */ "Optimizer",
+        /* short=       */ nullptr,
+        /* long=        */ "--plan-cache",
+        /* description= */ "reuse the join order of structurally identical queries with similar cardinality estimates",
+        /* callback=    */ [](bool b){ options::plan_cache = b; }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Optimizer",
+        /* short=       */ nullptr,
+        /* long=        */ "--multiway-join",
+        /* description= */ "join cyclic query graphs by a worst-case optimal multi-way join if the intermediate results "
+                           "of the binary join order blow up",
+        /* callback=    */ [](bool b){ options::multiway_join = b; }
+    );
+    C.arg_parser().add<double>(
+        /* group=       */ "Optimizer",
+        /* short=       */ nullptr,
+        /* long=        */ "--multiway-join-min-blowup",
+        /* description= */ "the factor by which the largest intermediate result must exceed the largest input and the "
+                           "result to use a multi-way join (default 10)",
+        /* callback=    */ [](double factor){ options::multiway_join_min_blowup = factor; }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Optimizer",
+        /* short=       */ nullptr,
+        /* long=        */ "--eager-aggregation",
+        /* description= */ "pre-aggregate a data source below the joins if that is estimated to shrink it sufficiently",
+        /* callback=    */ [](bool b){ options::eager_aggregation = b; }
+    );
+    C.arg_parser().add<double>(
+        /* group=       */ "Optimizer",
+        /* short=       */ nullptr,
+        /* long=        */ "--eager-aggregation-max-ratio",
+        /* description= */ "the maximal ratio of groups to rows of a data source to pre-aggregate it (default 0.5)",
+        /* callback=    */ [](double ratio){ options::eager_aggregation_max_ratio = ratio; }
+    );
+}
+
+}
+
+
 /*======================================================================================================================
  * Helper functions
  *====================================================================================================================*/
@@ -152,6 +228,205 @@ Optimizer::compute_projections_required_for_order_by(const std::vector<projectio
  * Optimizer
  *====================================================================================================================*/
 
+/** Returns `true` iff all relations of \p G should be joined by a single multi-way join rather than by the binary join
+ * order computed in \p PT, see `--multiway-join`.  This is the case if the query graph is connected and cyclic, all
+ * joins are equi-joins, and the largest intermediate result of the binary join order exceeds both the largest input
+ * and the result of the join by at least `--multiway-join-min-blowup`.  A worst-case optimal multi-way join avoids
+ * these intermediate results. */
+template<typename PlanTable>
+static bool is_multiway_join_beneficial(const QueryGraph &G, const PlanTable &PT)
+{
+    const std::size_t n = G.num_sources();
+    if (not options::multiway_join or n <= 2)
+        return false;
+
+    /*----- Check that the query graph is connected and cyclic, i.e. has at least as many edges as relations. -----*/
+    const AdjacencyMatrix &M = G.adjacency_matrix();
+    std::size_t num_edges = 0;
+    for (std::size_t i = 0; i != n; ++i)
+        num_edges += M.neighbors(Subproblem::Singleton(i)).size();
+    num_edges /= 2; // each edge is counted from both ends
+    Subproblem reached = Subproblem::Singleton(0);
+    for (Subproblem frontier = reached; not frontier.empty(); reached |= frontier)
+        frontier = M.neighbors(frontier) - reached;
+    if (reached != Subproblem::All(n) or num_edges < n)
+        return false;
+    for (auto &J : G.joins()) {
+        if (not J->condition().is_equi())
+            return false;
+    }
+
+    /*----- Compare the largest intermediate result of the binary join order to its inputs and result. -----*/
+    auto &CE = Catalog::Get().get_database_in_use().cardinality_estimator();
+    const Subproblem All = Subproblem::All(n);
+    double max_input = 0, max_intermediate = 0;
+    auto visit = [&](Subproblem s, auto &visit_rec) -> void {
+        const double cardinality = CE.predict_cardinality(*PT[s].model);
+        if (s.size() == 1) {
+            max_input = std::max(max_input, cardinality);
+            return;
+        }
+        if (s != All)
+            max_intermediate = std::max(max_intermediate, cardinality);
+        for (auto sub : PT[s].get_subproblems())
+            visit_rec(sub, visit_rec);
+    };
+    visit(All, visit);
+    const double result = CE.predict_cardinality(*PT[All].model);
+    return max_intermediate > options::multiway_join_min_blowup * std::max(max_input, result);
+}
+
+/** Constructs a single multi-way join of the plans \p source_plans of all relations of \p G. */
+template<typename PlanTable>
+static std::unique_ptr<Producer> construct_multiway_join(const QueryGraph &G, const PlanTable &PT,
+                                                         const std::unique_ptr<Producer*[]> &source_plans)
+{
+    auto &CE = Catalog::Get().get_database_in_use().cardinality_estimator();
+
+    cnf::CNF join_condition;
+    for (auto &J : G.joins())
+        join_condition = join_condition and J->condition();
+
+    auto join = std::make_unique<JoinOperator>(join_condition);
+    for (std::size_t i = 0; i != G.num_sources(); ++i)
+        join->add_child(source_plans[i]);
+    const Subproblem All = Subproblem::All(G.num_sources());
+    auto join_info = std::make_unique<OperatorInformation>();
+    join_info->subproblem = All;
+    join_info->estimated_cardinality = CE.predict_cardinality(*PT[All].model);
+    join->info(std::move(join_info));
+
+    if (Options::Get().statistics)
+        std::cout << "Joining " << G.num_sources() << " relations of the cyclic query graph by a multi-way join"
+                  << std::endl;
+    return join;
+}
+
+/** Pushes the grouping of \p G down below the joins, if beneficial, by pre-aggregating a single data source before it
+ * is joined, see `--eager-aggregation`.  This is *eager group-by* of Yan and Larson: if all aggregates of \p G are
+ * `SUM`, `MIN`, or `MAX` of distinct attributes of a single base table `R`, which are not used by any grouping key or
+ * join, then `R` is pre-aggregated by its attributes used as grouping keys or in joins.  Each pre-aggregated row stands
+ * for rows of `R` that join the same rows of the other data sources, hence aggregating the pre-aggregates by the
+ * original aggregates above the joins computes the original result.  The pre-aggregates replace the aggregated
+ * attributes of `R` under their names, which requires `SUM` to have the type of its argument.
+ *
+ * The choice between eager and *lazy* aggregation, i.e. grouping only after all joins, is cost-based: `R` is
+ * pre-aggregated only if the estimated number of its groups is at most `--eager-aggregation-max-ratio` times its
+ * estimated cardinality.  The model of `R` in \p PT is updated, s.t. the join order accounts for the smaller input. */
+template<typename PlanTable>
+static void push_down_grouping(const QueryGraph &G, PlanTable &PT, std::unique_ptr<Producer*[]> &source_plans)
+{
+    if (not options::eager_aggregation or G.num_sources() < 2 or G.aggregates().empty())
+        return;
+
+    auto id_of = [](const ast::Expr &e) -> std::optional<Schema::Identifier> {
+        if (not is<const Designator>(&e))
+            return std::nullopt;
+        auto required = e.get_required();
+        if (required.num_entries() != 1)
+            return std::nullopt;
+        return required[0].id;
+    };
+
+    /*----- Find the single base table whose attributes are aggregated. -----*/
+    std::vector<Schema::Identifier> aggregated;
+    for (auto &agg : G.aggregates()) {
+        auto &fn = agg.get();
+        const auto fnid = fn.get_function().fnid;
+        if (fnid != m::Function::FN_SUM and fnid != m::Function::FN_MIN and fnid != m::Function::FN_MAX)
+            return;
+        if (fn.args.size() != 1 or fn.args[0]->type() != fn.type())
+            return; // pre-aggregates must be able to replace their argument
+        auto id = id_of(*fn.args[0]);
+        if (not id or std::find(aggregated.begin(), aggregated.end(), *id) != aggregated.end())
+            return;
+        aggregated.push_back(std::move(*id));
+    }
+    const DataSource *R = nullptr;
+    for (auto &ds : G.sources()) {
+        if (is<const BaseTable>(ds.get()) and ds->name() == aggregated.front().prefix)
+            R = ds.get();
+    }
+    if (not R)
+        return;
+    for (auto &id : aggregated) {
+        if (id.prefix != R->name())
+            return;
+    }
+    auto is_of_R = [&](const Schema::Identifier &id) { return id.prefix == R->name(); };
+    auto is_aggregated = [&](const Schema::Identifier &id) {
+        return std::find(aggregated.begin(), aggregated.end(), id) != aggregated.end();
+    };
+
+    /*----- Collect the grouping keys of the pre-aggregation, i.e. the attributes of `R` used by keys and joins. -----*/
+    std::vector<GroupingOperator::group_type> group_by;
+    std::vector<Schema::Identifier> keys;
+    auto add_key = [&](const ast::Expr &e, const Schema::Identifier &id) {
+        if (std::find(keys.begin(), keys.end(), id) != keys.end())
+            return;
+        group_by.emplace_back(e, ThreadSafePooledOptionalString{});
+        keys.push_back(id);
+    };
+    for (auto &[grp, _] : G.group_by()) {
+        auto id = id_of(grp.get());
+        if (not id or is_aggregated(*id))
+            return; // grouping keys must be attributes that are not aggregated
+        if (is_of_R(*id))
+            add_key(grp.get(), *id);
+    }
+    bool uses_aggregated = false;
+    auto add_join_key = overloaded {
+        [&](const Designator &d) -> void {
+            auto id = id_of(d);
+            if (not id)
+                return;
+            if (is_aggregated(*id))
+                uses_aggregated = true;
+            else if (is_of_R(*id))
+                add_key(d, *id);
+        },
+        [](auto&&) -> void { /* nothing to be done */ },
+    };
+    for (auto &J : G.joins()) {
+        for (auto &clause : J->condition()) {
+            for (auto pred : clause)
+                visit(add_join_key, *pred, tag<ConstPreOrderExprVisitor>{});
+        }
+    }
+    if (uses_aggregated or keys.empty())
+        return; // the aggregated attributes are required individually by a join, or `R` is not joined by attributes
+
+    /*----- Choose between eager and lazy aggregation by the estimated reduction of `R`. -----*/
+    auto &CE = Catalog::Get().get_database_in_use().cardinality_estimator();
+    const Subproblem s = Subproblem::Singleton(R->id());
+    auto grouped_model = CE.estimate_grouping(G, *PT[s].model, group_by);
+    const auto num_rows = CE.predict_cardinality(*PT[s].model);
+    const auto num_groups = CE.predict_cardinality(*grouped_model);
+    if (num_groups > options::eager_aggregation_max_ratio * num_rows)
+        return;
+
+    /*----- Pre-aggregate `R`, naming the keys and pre-aggregates like the attributes they replace. -----*/
+    auto grouping = std::make_unique<GroupingOperator>(group_by, G.aggregates());
+    grouping->add_child(source_plans[R->id()]);
+    Schema S;
+    for (std::size_t i = 0; i != grouping->schema().num_entries(); ++i) {
+        auto &e = grouping->schema()[i];
+        S.add(i < keys.size() ? keys[i] : aggregated[i - keys.size()], e.type, e.constraints);
+    }
+    grouping->schema() = S;
+
+    auto info = std::make_unique<OperatorInformation>();
+    info->subproblem = s;
+    info->estimated_cardinality = num_groups;
+    grouping->info(std::move(info));
+    PT[s].model = std::move(grouped_model);
+    source_plans[R->id()] = grouping.release();
+
+    if (Options::Get().statistics)
+        std::cout << "Eager aggregation of " << R->name().assert_not_none() << " by " << keys.size() << " keys: " << num_rows
+                  << " rows to " << num_groups << " groups" << std::endl;
+}
+
 std::pair<std::unique_ptr<Producer>, PlanTableEntry> Optimizer::optimize(QueryGraph &G) const
 {
     switch (Options::Get().plan_table_type)
@@ -197,10 +472,12 @@ std::pair<std::unique_ptr<Producer>, PlanTable> Optimizer::optimize_with_plantab
 
     /*----- Initialize plan table and compute plans for data sources. -----*/
     auto source_plans = optimize_source_plans(G, PT);
+    push_down_grouping(G, PT, source_plans);
 
     /*----- Compute join order and construct plan containing all joins. -----*/
     optimize_join_order(G, PT);
-    std::unique_ptr<Producer> plan = construct_join_order(G, PT, source_plans);
+    std::unique_ptr<Producer> plan = is_multiway_join_beneficial(G, PT) ? construct_multiway_join(G, PT, source_plans)
+                                                                        : construct_join_order(G, PT, source_plans);
     auto &entry = PT.get_final();
 
     /*----- Construct plan for remaining operations. -----*/
@@ -285,12 +562,116 @@ std::unique_ptr<Producer*[]> Optimizer::optimize_source_plans(const QueryGraph &
                 filtered_ds->info(std::move(source_info));
             }
 
+            /* Prune the partitions of a partitioned base table ruled out by the filter.  The rows of the remaining
+             * partitions bound the cardinality of the filtered table, see `Partitionings`. */
+            if (auto bt = cast<const BaseTable>(ds.get())) {
+                auto &DB = Catalog::Get().get_database_in_use();
+                if (auto partitioning = Partitionings::Get().get(DB.name, bt->table())) {
+                    const auto remaining = Partitionings::Prune(*partitioning, bt->table(), ds->filter());
+                    std::size_t num_rows_remaining = 0;
+                    for (std::size_t p = 0; p != remaining.size(); ++p) {
+                        if (remaining[p])
+                            num_rows_remaining += partitioning->ranges[p].second - partitioning->ranges[p].first;
+                    }
+                    auto &info = filtered_ds->info();
+                    if (num_rows_remaining < info.estimated_cardinality)
+                        info.estimated_cardinality = num_rows_remaining;
+                }
+            }
+
             source_plans[ds->id()] = filtered_ds;
         }
     }
     return source_plans;
 }
 
+/** Appends the shape of \p cnf, i.e. its expressions without their constants, to \p key. */
+static void append_shape(PlanCache::key_type &key, const cnf::CNF &cnf)
+{
+    std::hash<std::string> h;
+    auto append_expr = overloaded {
+        [&key](auto&) { key.push_back(0); },
+        [&key, &h](const Designator &d) { key.push_back(h(to_string(d))); },
+        [&key](const Constant&) { key.push_back(1); }, // constants are omitted
+        [&key](const UnaryExpr &e) { key.push_back(2); key.push_back(e.op().type); },
+        [&key](const BinaryExpr &e) { key.push_back(3); key.push_back(e.op().type); },
+        [&key](const FnApplicationExpr&) { key.push_back(4); },
+        [&key](const QueryExpr&) { key.push_back(5); },
+    };
+    key.push_back(cnf.size());
+    for (auto &clause : cnf) {
+        key.push_back(clause.size());
+        for (auto pred : clause) {
+            key.push_back(pred.negative());
+            visit(append_expr, *pred, tag<ConstPreOrderExprVisitor>{});
+        }
+    }
+}
+
+/** Computes the `PlanCache` key of the join order of \p G, whose data sources have already been planned in \p PT. */
+template<typename PlanTable>
+static PlanCache::key_type plan_cache_key(const QueryGraph &G, const PlanTable &PT, const CardinalityEstimator &CE,
+                                          const PlanEnumerator &PE, const CostFunction &CF)
+{
+    std::hash<std::string_view> h;
+    PlanCache::key_type key;
+    key.push_back(reinterpret_cast<uintptr_t>(&PE));
+    key.push_back(reinterpret_cast<uintptr_t>(&CF));
+    key.push_back(reinterpret_cast<uintptr_t>(&CE));
+
+    key.push_back(G.num_sources());
+    for (auto &ds : G.sources()) {
+        if (auto bt = cast<const BaseTable>(ds.get()))
+            key.push_back(h(*bt->table().name()));
+        else
+            key.push_back(as<const Query>(*ds).query_graph().num_sources());
+        append_shape(key, ds->filter());
+        /* Bucket the estimated cardinality by its order of magnitude. */
+        const auto cardinality = CE.predict_cardinality(*PT[Subproblem::Singleton(ds->id())].model);
+        key.push_back(uint64_t(std::log2(double(cardinality) + 1)));
+    }
+
+    key.push_back(G.joins().size());
+    for (auto &J : G.joins()) {
+        Subproblem sources;
+        for (auto ds : J->sources())
+            sources(ds.get().id()) = true;
+        key.push_back(uint64_t(sources));
+        append_shape(key, J->condition());
+    }
+    return key;
+}
+
+/** Returns `true` iff \p join_order joins exactly the \p num_sources data sources, each join joining two disjoint and
+ * previously planned subproblems. */
+static bool is_complete_join_order(const PlanCache::join_order_type &join_order, std::size_t num_sources)
+{
+    const Subproblem All = Subproblem::All(num_sources);
+    if (join_order.empty()) return num_sources == 1;
+    for (auto [left, right] : join_order) {
+        if (left.empty() or right.empty() or (left & right) or not (left | right).is_subset(All))
+            return false;
+    }
+    return (join_order.back().first | join_order.back().second) == All;
+}
+
+/** Returns the joins of the final plan in \p PT in post-order. */
+template<typename PlanTable>
+static PlanCache::join_order_type extract_join_order(const PlanTable &PT, std::size_t num_sources)
+{
+    PlanCache::join_order_type join_order;
+    auto extract = [&](Subproblem S, auto &extract_rec) -> void {
+        auto subproblems = PT[S].get_subproblems();
+        if (subproblems.empty()) return;
+        M_insist(subproblems.size() == 2, "only binary joins are enumerated");
+        extract_rec(subproblems[0], extract_rec);
+        extract_rec(subproblems[1], extract_rec);
+        join_order.emplace_back(subproblems[0], subproblems[1]);
+    };
+    extract(Subproblem::All(num_sources), extract);
+    return join_order;
+}
+
 template<typename PlanTable>
 void Optimizer::optimize_join_order(const QueryGraph &G, PlanTable &PT) const
 {
@@ -309,7 +690,24 @@ void Optimizer::optimize_join_order(const QueryGraph &G, PlanTable &PT) const
     }
 #endif
 
-    M_TIME_EXPR(plan_enumerator()(G, cost_function(), PT), "Plan enumeration", C.timer());
+    if (options::plan_cache) {
+        auto key = plan_cache_key(G, PT, CE, plan_enumerator(), cost_function());
+        auto &cache = PlanCache::Get();
+        if (auto join_order = cache.find(key); join_order and is_complete_join_order(*join_order, G.num_sources())) {
+            /* Replay the cached join order bottom-up to compute the models and costs of its subproblems. */
+            auto replay = C.timer().create_timing("Plan enumeration");
+            for (auto [left, right] : *join_order)
+                PT.update(G, CE, cost_function(), left, right, cnf::CNF{}); // TODO: use actual condition
+            replay.stop();
+            if (Options::Get().statistics)
+                std::cout << "Reused join order from plan cache" << std::endl;
+        } else {
+            M_TIME_EXPR(plan_enumerator()(G, cost_function(), PT), "Plan enumeration", C.timer());
+            cache.insert(std::move(key), extract_join_order(PT, G.num_sources()));
+        }
+    } else {
+        M_TIME_EXPR(plan_enumerator()(G, cost_function(), PT), "Plan enumeration", C.timer());
+    }
 
     if (Options::Get().statistics) {
         std::cout << "Est. total cost: " << PT.get_final().cost
@@ -1,5 +1,8 @@
 #include "storage/PaxStore.hpp"
 
+#include "backend/Interpreter.hpp"
+#include "storage/Store.hpp"
+#include "storage/StoreTiering.hpp"
 #include <algorithm>
 #include <exception>
 #include <fstream>
@@ -19,10 +22,13 @@ PaxStore::PaxStore(const Table &table, uint32_t block_size_in_bytes)
     compute_block_offsets();
 
     data_ = allocator_.allocate(ALLOCATION_SIZE);
+    numa_interleave(data_.addr(), data_.size());
+    synopses_.resize(table.num_attrs());
 }
 
 PaxStore::~PaxStore()
 {
+    StoreTiering::Get().forget(*this);
     delete[] offsets_;
 }
 
@@ -90,6 +96,65 @@ void PaxStore::compute_block_offsets()
     delete[] attrs;
 }
 
+void PaxStore::update_synopses() const
+{
+    if (num_rows_summarized_ == num_rows_)
+        return; // nothing to be done
+
+    /*----- Recompute the synopses of the first block not entirely summarized and of all following ones. -----*/
+    const std::size_t first_block = num_rows_summarized_ / num_rows_per_block_;
+    const std::size_t num_blocks = (num_rows_ + num_rows_per_block_ - 1) / num_rows_per_block_;
+    const Schema table_schema = table().schema();
+    Schema S;
+    std::vector<std::size_t> attr_ids; ///< the attribute IDs of the entries of `S`
+    for (std::size_t attr_id = 0; attr_id != table().num_attrs(); ++attr_id) {
+        auto &e = table_schema[attr_id];
+        if (Has_Synopses(*e.type)) {
+            S.add(e.id, e.type, e.constraints);
+            attr_ids.push_back(attr_id);
+            synopses_[attr_id].resize(first_block); // drop synopses to be recomputed
+            synopses_[attr_id].resize(num_blocks);
+        }
+    }
+    if (attr_ids.empty()) {
+        num_rows_summarized_ = num_rows_;
+        return;
+    }
+
+    /*----- Load all rows to summarize and update the synopses of their blocks. -----*/
+    auto loader = Interpreter::compile_load(S, data_.addr(), table().layout(), table_schema,
+                                            first_block * num_rows_per_block_);
+    Tuple tup(S);
+    Tuple *args[] = { &tup };
+    for (std::size_t row_id = first_block * num_rows_per_block_; row_id != num_rows_; ++row_id) {
+        loader(args);
+        const std::size_t block = row_id / num_rows_per_block_;
+        for (std::size_t idx = 0; idx != attr_ids.size(); ++idx) {
+            auto &synopsis = synopses_[attr_ids[idx]][block];
+            if (tup.is_null(idx)) {
+                ++synopsis.num_nulls;
+                continue;
+            }
+            auto update = [&synopsis]<typename T>(T value) {
+                if (std::holds_alternative<std::monostate>(synopsis.min)) {
+                    synopsis.min = synopsis.max = value;
+                } else {
+                    synopsis.min = std::min(std::get<T>(synopsis.min), value);
+                    synopsis.max = std::max(std::get<T>(synopsis.max), value);
+                }
+            };
+            auto &ty = *S[idx].type;
+            if (ty.is_float())
+                update(double(tup[idx].as_f()));
+            else if (ty.is_double())
+                update(tup[idx].as_d());
+            else
+                update(int64_t(tup[idx].as_i()));
+        }
+    }
+    num_rows_summarized_ = num_rows_;
+}
+
 M_LCOV_EXCL_START
 void PaxStore::dump(std::ostream &out) const
 {
@@ -100,6 +165,9 @@ void PaxStore::dump(std::ostream &out) const
         out << offsets_[i];
     }
     out << ']' << std::endl;
+
+    const std::size_t num_blocks = (num_rows_ + num_rows_per_block_ - 1) / num_rows_per_block_;
+    dump_numa_placement(out, { { data_.addr(), num_blocks * block_size_ } });
 }
 M_LCOV_EXCL_STOP
 
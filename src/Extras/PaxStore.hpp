@@ -2,7 +2,10 @@
 
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/storage/Store.hpp>
+#include <algorithm>
 #include <mutable/util/memory.hpp>
+#include <variant>
+#include <vector>
 
 
 namespace m {
@@ -18,6 +21,15 @@ struct PaxStore : Store
 
     static constexpr uint32_t BLOCK_SIZE = 1UL << 12; ///< 4 KiB
 
+    /** A synopsis of the values of a single attribute within a single PAX block, i.e. an entry of its zone map. */
+    struct BlockSynopsis
+    {
+        ///> the minimum and maximum non-NULL value, as `int64_t` for integral and date(time) attributes and as `double`
+        ///> for floating-point attributes; `std::monostate` iff the block contains no non-NULL value
+        std::variant<std::monostate, int64_t, double> min, max;
+        uint32_t num_nulls = 0; ///< the number of NULL values
+    };
+
     private:
     memory::LinearAllocator allocator_; ///< the memory allocator
     memory::Memory data_; ///< the underlying memory containing the data
@@ -26,6 +38,9 @@ struct PaxStore : Store
     uint32_t *offsets_; ///< the offsets of each column within a PAX block, in bits
     uint32_t block_size_; ///< the size of a PAX block, in bytes; includes padding
     std::size_t num_rows_per_block_; ///< the number of rows within a PAX block
+    ///> for each attribute, the synopses of all PAX blocks; empty for attributes without synopses
+    mutable std::vector<std::vector<BlockSynopsis>> synopses_;
+    mutable std::size_t num_rows_summarized_ = 0; ///< the number of rows summarized by `synopses_`
 
     public:
     PaxStore(const Table &table, uint32_t block_size_in_bytes = BLOCK_SIZE);
@@ -50,6 +65,34 @@ struct PaxStore : Store
     void drop() override {
         M_insist(num_rows_);
         --num_rows_;
+        /* Invalidate synopses of the dropped row's block s.t. they are recomputed on the next access. */
+        num_rows_summarized_ = std::min(num_rows_summarized_, num_rows_ / num_rows_per_block_ * num_rows_per_block_);
+    }
+
+    /** Returns `true` iff synopses are maintained for attributes of type \p ty, i.e. for integral, floating-point,
+     * date, and date-time attributes. */
+    static bool Has_Synopses(const Type &ty) {
+        return ty.is_integral() or ty.is_floating_point() or ty.is_date() or ty.is_date_time();
+    }
+    /** Returns `true` iff synopses are maintained for attribute \p attr. */
+    bool has_synopses(const Attribute &attr) const { return Has_Synopses(*attr.type); }
+
+    /** Returns the synopses of all PAX blocks for attribute \p attr.  Summarizes all rows appended since the last call
+     * first. */
+    const std::vector<BlockSynopsis> & synopses(const Attribute &attr) const {
+        M_insist(has_synopses(attr), "no synopses maintained for attribute");
+        update_synopses();
+        return synopses_[attr.id];
+    }
+
+    /** Summarizes all rows appended since the last update in the synopses of their PAX blocks.  Must be called after
+     * rows are written, e.g. after importing data. */
+    void update_synopses() const;
+
+    /** Discards the synopses of the PAX blocks from the one of row \p first_row on, s.t. they are recomputed on the
+     * next access.  Must be called after rows are overwritten, e.g. by `DELETE` or `UPDATE`. */
+    void invalidate_synopses(std::size_t first_row) const {
+        num_rows_summarized_ = std::min(num_rows_summarized_, first_row / num_rows_per_block_ * num_rows_per_block_);
     }
 
     /** Returns the memory of the store. */
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "util/hash.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <mutable/IR/QueryGraph.hpp>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace m {
+
+/** Caches the join orders computed by the `Optimizer` for structurally identical queries.  A query is described by a
+ * key that captures its data sources, the shapes of its filters and joins, i.e. the expressions without their
+ * constants, and the estimated cardinalities of the filtered data sources bucketed by their order of magnitude.
+ * Queries that only differ in the constants of their predicates, and whose constants do not change the estimated
+ * cardinalities significantly, hence share their join order.
+ *
+ * The join order is stored as the sequence of joins in post-order, such that it can be replayed to fill a plan table
+ * bottom-up.  Since a join order of the right number of data sources is always a valid join order, a stale cache entry
+ * may only cause a suboptimal plan.  Nonetheless, the cache must be cleared when the cardinality estimator changes. */
+struct PlanCache
+{
+    using key_type = std::vector<uint64_t>;
+    ///> the joins of a join order in post-order, each given by the subproblems of its left and right child
+    using join_order_type = std::vector<std::pair<Subproblem, Subproblem>>;
+
+    ///> the maximum number of cached join orders; when exceeded, the cache is cleared
+    static constexpr std::size_t CAPACITY = 1024;
+
+    private:
+    std::unordered_map<key_type, join_order_type> cache_;
+    mutable std::mutex mutex_;
+
+    PlanCache() = default;
+
+    public:
+    static PlanCache & Get() {
+        static PlanCache the_cache;
+        return the_cache;
+    }
+
+    /** Returns the join order cached for \p key, if any. */
+    std::optional<join_order_type> find(const key_type &key) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto it = cache_.find(key); it != cache_.end())
+            return it->second;
+        return std::nullopt;
+    }
+
+    /** Caches \p join_order for \p key. */
+    void insert(key_type key, join_order_type join_order) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cache_.size() >= CAPACITY)
+            cache_.clear();
+        cache_.insert_or_assign(std::move(key), std::move(join_order));
+    }
+
+    /** Discards all cached join orders. */
+    void clear() { std::lock_guard<std::mutex> lock(mutex_); cache_.clear(); }
+
+    std::size_t size() const { std::lock_guard<std::mutex> lock(mutex_); return cache_.size(); }
+};
+
+}
@@ -1,6 +1,9 @@
 #include <mutable/IR/PlanEnumerator.hpp>
 
+#include "util/WorkerPool.hpp"
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstring>
 #include <execution>
 #include <functional>
@@ -9,6 +12,7 @@
 #include <memory>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/catalog/CostFunction.hpp>
+#include <mutable/Options.hpp>
 #include <mutable/util/ADT.hpp>
 #include <mutable/util/fn.hpp>
 #include <mutable/util/list_allocator.hpp>
@@ -16,6 +20,7 @@
 #include <queue>
 #include <set>
 #include <type_traits>
+#include <vector>
 #ifdef __BMI2__
 #include <x86intrin.h>
 #endif
@@ -25,6 +30,57 @@ using namespace m;
 using namespace m::pe;
 
 
+namespace {
+
+namespace options {
+
+/** How many threads should be used by parallel plan enumerators.  0 means all threads of the `WorkerPool`. */
+unsigned plan_enumeration_threads = 0;
+
+/** The wall-clock budget of the `Adaptive` plan enumerator for exhaustive enumeration, in milliseconds. */
+unsigned adaptive_budget_ms = 100;
+
+/** The maximum estimated number of connected subgraph complement pairs for which the `Adaptive` plan enumerator
+ * attempts exhaustive enumeration. */
+double adaptive_max_ccps = 1e7;
+
+}
+
+__attribute__((constructor(201)))
+static void add_plan_enumerator_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<unsigned>(
+        /* group=       */ "PlanEnumerator",
+        /* short=       */ nullptr,
+        /* long=        */ "--plan-enumeration-threads",
+        /* description= */ "specify the number of threads used by parallel plan enumerators (0 for all threads of the "
+                           "worker pool)",
+        /* callback=    */ [](unsigned num_threads){ options::plan_enumeration_threads = num_threads; }
+    );
+    C.arg_parser().add<unsigned>(
+        /* group=       */ "PlanEnumerator",
+        /* short=       */ nullptr,
+        /* long=        */ "--adaptive-budget",
+        /* description= */ "specify the time budget in milliseconds of the Adaptive plan enumerator for exhaustive "
+                           "enumeration, after which it falls back to greedy enumeration",
+        /* callback=    */ [](unsigned ms){ options::adaptive_budget_ms = ms; }
+    );
+    C.arg_parser().add<double>(
+        /* group=       */ "PlanEnumerator",
+        /* short=       */ nullptr,
+        /* long=        */ "--adaptive-max-ccps",
+        /* description= */ "specify the maximum estimated number of CCPs for which the Adaptive plan enumerator "
+                           "attempts exhaustive enumeration",
+        /* callback=    */ [](double max_ccps){ options::adaptive_max_ccps = max_ccps; }
+    );
+}
+
+}
+
+
 /*======================================================================================================================
  * PEall
  *====================================================================================================================*/
@@ -267,6 +323,82 @@ struct DPsubOpt final : PlanEnumeratorCRTP<DPsubOpt>
 };
 
 
+/*======================================================================================================================
+ * DPsubPar
+ *====================================================================================================================*/
+
+/** Computes the join order using subset-based dynamic programming on multiple threads.  Similar to PDPsva, the
+ * subproblems are stratified by their size.  All subproblems of the same size only depend on smaller subproblems and
+ * are hence optimized concurrently, with a barrier between strata.  Each subproblem is optimized by exactly one thread
+ * that enumerates its splits as in `DPsubOpt`, such that each entry of the plan table is only written by its owning
+ * thread.
+ *
+ * Since `PlanTableLargeAndSparse` may rehash on insertion, it is filled sequentially. */
+struct DPsubPar final : PlanEnumeratorCRTP<DPsubPar>
+{
+    using base_type = PlanEnumeratorCRTP<DPsubPar>;
+    using base_type::operator();
+
+    ///> the minimum number of subproblems of a stratum per thread; smaller strata are processed by fewer threads
+    static constexpr std::size_t MIN_SUBPROBLEMS_PER_THREAD = 64;
+    ///> the number of subproblems claimed at once by a thread
+    static constexpr std::size_t GRAIN_SIZE = 16;
+
+    template<typename PlanTable>
+    void operator()(enumerate_tag, PlanTable &PT, const QueryGraph &G, const CostFunction &CF) const {
+        const std::size_t n = G.sources().size();
+        const AdjacencyMatrix &M = G.adjacency_matrix();
+        auto &CE = Catalog::Get().get_database_in_use().cardinality_estimator();
+
+        /* Enumerates all splits of `S` into two connected subproblems, omitting symmetric ones. */
+        auto optimize = [&](const Subproblem S) {
+            uint64_t offset = S.capacity() - __builtin_clzl(uint64_t(S));
+            M_insist(offset != 0, "invalid subproblem offset");
+            Subproblem limit = Subproblem::Singleton(offset - 1);
+            cnf::CNF condition; // TODO use join condition
+            for (Subproblem S1(least_subset(S)); S1 != limit; S1 = Subproblem(next_subset(S1, S))) {
+                Subproblem S2 = S - S1;
+                if (not PT.has_plan(S1)) continue; // not connected -> skip
+                if (not PT.has_plan(S2)) continue; // not connected -> skip
+                PT.update(G, CE, CF, S1, S2, condition);
+            }
+        };
+
+        constexpr bool is_concurrent = std::is_same_v<PlanTable, PlanTableSmallOrDense>;
+        const std::size_t max_threads = not is_concurrent ? 1
+                                      : options::plan_enumeration_threads ? options::plan_enumeration_threads
+                                      : WorkerPool::Get().num_threads();
+
+        std::vector<Subproblem> stratum;
+        for (std::size_t s = 2; s <= n; ++s) {
+            /* Collect the connected subproblems of size `s`. */
+            stratum.clear();
+            for (auto S = GospersHack::enumerate_all(s, n); S; ++S) {
+                if (M.is_connected(*S))
+                    stratum.push_back(*S);
+            }
+
+            const std::size_t num_threads =
+                std::clamp<std::size_t>(stratum.size() / MIN_SUBPROBLEMS_PER_THREAD, 1, max_threads);
+            if (num_threads == 1) {
+                for (auto S : stratum)
+                    optimize(S);
+                continue;
+            }
+
+            /* Let the threads claim chunks of subproblems dynamically since the number of connected splits varies.
+             * `parallel_for()` returns when all chunks are done, i.e. is the barrier between strata. */
+            const std::size_t num_chunks = (stratum.size() + GRAIN_SIZE - 1) / GRAIN_SIZE;
+            WorkerPool::Get().parallel_for(num_chunks, [&](std::size_t chunk) {
+                const std::size_t end = std::min((chunk + 1) * GRAIN_SIZE, stratum.size());
+                for (std::size_t i = chunk * GRAIN_SIZE; i != end; ++i)
+                    optimize(stratum[i]);
+            }, num_threads);
+        }
+    }
+};
+
+
 /*======================================================================================================================
  * DPccp
  *====================================================================================================================*/
@@ -722,6 +854,110 @@ void TDGOO::operator()(enumerate_tag, PlanTable &PT, const QueryGraph &G, const
 }
 
 
+/*======================================================================================================================
+ * Adaptive
+ *====================================================================================================================*/
+
+/** Chooses the plan enumerator by the size and shape of the query graph to bound the optimization time.  If the
+ * number of connected subgraph complement pairs (CCPs) is small enough, the optimal plan is computed by `DPccp`.  The
+ * number of CCPs is estimated by the formulas of Moerkotte and Neumann for chains, cycles, stars, and cliques, treating
+ * other trees as stars and other cyclic graphs as cliques.  Otherwise, acyclic query graphs are optimized by `IKKBZ`
+ * and cyclic ones by `LinearizedDP`.
+ *
+ * Since the estimate may be far off, exhaustive enumeration is aborted when the wall-clock budget runs out.  The plans
+ * found so far remain valid, hence `GOO` completes the plan table from there. */
+struct Adaptive final : PlanEnumeratorCRTP<Adaptive>
+{
+    using base_type = PlanEnumeratorCRTP<Adaptive>;
+    using base_type::operator();
+
+    enum shape_type { Chain, Cycle, Star, Tree, Clique, Cyclic };
+    static constexpr const char *SHAPE_TO_STR[] = { "chain", "cycle", "star", "tree", "clique", "cyclic" };
+
+    ///> the number of CCPs between two checks of the wall-clock budget
+    static constexpr std::size_t CHECK_INTERVAL = 1024;
+
+    /** Thrown to abort exhaustive enumeration when the budget is exhausted. */
+    struct budget_exhausted { };
+
+    /** Classifies the connected query graph of \p n relations with adjacency matrix \p M. */
+    static shape_type classify(const AdjacencyMatrix &M, std::size_t n) {
+        std::size_t num_edges = 0, max_degree = 0;
+        bool all_degree_two = true;
+        for (std::size_t i = 0; i != n; ++i) {
+            const std::size_t degree = M.neighbors(Subproblem::Singleton(i)).size();
+            num_edges += degree;
+            max_degree = std::max(max_degree, degree);
+            all_degree_two = all_degree_two and degree == 2;
+        }
+        num_edges /= 2; // each edge is counted from both ends
+        if (num_edges + 1 == n) {
+            if (max_degree <= 2) return Chain;
+            if (max_degree + 1 == n) return Star;
+            return Tree;
+        }
+        if (num_edges == n and all_degree_two) return Cycle;
+        if (num_edges == n * (n - 1) / 2) return Clique;
+        return Cyclic;
+    }
+
+    /** Estimates the number of CCPs of a query graph of shape \p shape with \p n relations. */
+    static double estimate_CCPs(shape_type shape, std::size_t n) {
+        const double N = n;
+        switch (shape) {
+            case Chain:  return (N * N * N - N) / 6;
+            case Cycle:  return (N * N * N - 2 * N * N + N) / 2;
+            case Star:
+            case Tree:   return (N - 1) * std::exp2(N - 2);
+            case Clique:
+            case Cyclic: return (std::pow(3, N) - std::exp2(N + 1) + 1) / 2;
+        }
+        M_unreachable("invalid shape");
+    }
+
+    template<typename PlanTable>
+    void operator()(enumerate_tag, PlanTable &PT, const QueryGraph &G, const CostFunction &CF) const {
+        const std::size_t n = G.num_sources();
+        if (n <= 1) return;
+        const AdjacencyMatrix &M = G.adjacency_matrix();
+        const shape_type shape = classify(M, n);
+        const bool is_acyclic = shape == Chain or shape == Star or shape == Tree;
+
+        auto report = [&](const char *enumerator) {
+            if (Options::Get().statistics)
+                std::cout << "Adaptive plan enumeration of " << SHAPE_TO_STR[shape] << " query graph with " << n
+                          << " relations: " << enumerator << std::endl;
+        };
+
+        if (estimate_CCPs(shape, n) <= options::adaptive_max_ccps) {
+            auto &CE = Catalog::Get().get_database_in_use().cardinality_estimator();
+            const auto deadline = std::chrono::steady_clock::now() +
+                                  std::chrono::milliseconds(options::adaptive_budget_ms);
+            cnf::CNF condition; // TODO use join condition
+            std::size_t num_CCPs = 0;
+            auto handle_CSG_pair = [&](const Subproblem left, const Subproblem right) {
+                if (++num_CCPs % CHECK_INTERVAL == 0 and std::chrono::steady_clock::now() > deadline)
+                    throw budget_exhausted{};
+                PT.update(G, CE, CF, left, right, condition);
+            };
+            try {
+                M.for_each_CSG_pair_undirected(Subproblem::All(n), handle_CSG_pair);
+                report("DPccp");
+            } catch (budget_exhausted) {
+                report("DPccp, aborted after exhausting the budget, completed by GOO");
+                GOO{}(enumerate_tag{}, PT, G, CF);
+            }
+        } else if (is_acyclic) {
+            report("IKKBZ");
+            IKKBZ{}(enumerate_tag{}, PT, G, CF);
+        } else {
+            report("LinearizedDP");
+            LinearizedDP{}(enumerate_tag{}, PT, G, CF);
+        }
+    }
+};
+
+
 #define LIST_PE(X) \
     X(DPccp,        "enumerates connected subgraph complement pairs") \
     X(DPsize,       "size-based subproblem enumeration") \
@@ -729,13 +965,15 @@ void TDGOO::operator()(enumerate_tag, PlanTable &PT, const QueryGraph &G, const
     X(DPsizeSub,    "DPsize with enumeration of subset complement pairs") \
     X(DPsub,        "subset-based subproblem enumeration") \
     X(DPsubOpt,     "optimized DPsub: does not enumerate symmetric subproblems") \
+    X(DPsubPar,     "parallel DPsubOpt: optimizes subproblems of equal size concurrently") \
     X(GOO,          "Greedy Operator Ordering") \
     X(TDGOO,        "Top-down variant of Greedy Operator Ordering") \
     X(IKKBZ,        "greedy algorithm by IK/KBZ, ordering joins by rank") \
     X(LinearizedDP, "DP with search space linearization based on IK/KBZ") \
     X(TDbasic,      "basic top-down join enumeration using generate-and-test partitioning") \
     X(TDMinCutAGaT, "top-down join enumeration using minimal graph cuts and advanced generate-and-test partitioning") \
-    X(PEall,        "enumerates ALL join orders, inclding Cartesian products")
+    X(PEall,        "enumerates ALL join orders, inclding Cartesian products") \
+    X(Adaptive,     "chooses the enumerator by size and shape of the query graph, with a time budget for DP")
 
 #define INSTANTIATE(NAME, _) \
     template void NAME::operator()(enumerate_tag, PlanTableSmallOrDense &PT, const QueryGraph &G, const CostFunction &CF) const; \
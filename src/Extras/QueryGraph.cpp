@@ -341,6 +341,12 @@ bool Query::is_correlated() const { return query_graph_->is_correlated(); }
  * Transforming non-equi predicates gives no benefit over a dependent join, unless we can perform *re*-aggregation (e.g.
  * SUM of COUNTs).
  *
+ * Since equi-predicates are decorrelated into a grouping of the nested query joined with the outer statement, nested
+ * queries correlated only by equi-predicates, e.g. those of TPC-H Q2, Q17, and Q20, are evaluated in linear time by
+ * hash-based grouping and joins.  The nested query is evaluated once for all outer tuples rather than once per outer
+ * tuple, hence memoizing its results per correlation value would not gain anything.  Only a dependent join, which we
+ * do not support yet, would benefit from such memoization.
+ *
  *====================================================================================================================*/
 
 /** Given a `SelectStmt` \p stmt, extract the aggregates to compute while grouping. */
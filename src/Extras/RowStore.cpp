@@ -1,6 +1,8 @@
 #include "storage/RowStore.hpp"
 
 #include "backend/StackMachine.hpp"
+#include "storage/Store.hpp"
+#include "storage/StoreTiering.hpp"
 #include <algorithm>
 #include <exception>
 #include <fstream>
@@ -21,10 +23,12 @@ RowStore::RowStore(const Table &table)
     compute_offsets();
     capacity_ = ALLOCATION_SIZE / (row_size_ / 8);
     data_ = allocator_.allocate(ALLOCATION_SIZE);
+    numa_interleave(data_.addr(), data_.size());
 }
 
 RowStore::~RowStore()
 {
+    StoreTiering::Get().forget(*this);
     delete[] offsets_;
 }
 
@@ -73,6 +77,8 @@ void RowStore::dump(std::ostream &out) const
         out << offsets_[i];
     }
     out << ']' << std::endl;
+
+    dump_numa_placement(out, { { data_.addr(), num_rows_ * row_size_ / 8 } });
 }
 M_LCOV_EXCL_STOP
 
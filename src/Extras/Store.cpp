@@ -1,11 +1,51 @@
 #include "storage/Store.hpp"
 
+#include <cerrno>
+#include <climits>
 #include <cmath>
+#include <cstring>
+#include <map>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/util/fn.hpp>
+#include <mutable/util/memory.hpp>
+
+#if __linux
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 
 using namespace m;
 
 
+namespace {
+
+namespace options {
+
+/** Whether to interleave the memory of stores across all NUMA nodes and to report its placement when dumping stores. */
+bool numa = false;
+
+}
+
+__attribute__((constructor(201)))
+static void add_store_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<bool>(
+        /* group=       */ "Store",
+        /* short=       */ nullptr,
+        /* long=        */ "--numa",
+        /* description= */ "interleave the memory of stores across all NUMA nodes and report its placement in dumps",
+        /* callback=    */ [](bool b){ options::numa = b; }
+    );
+}
+
+}
+
+
 /*======================================================================================================================
  * Store
  *====================================================================================================================*/
@@ -13,3 +53,95 @@ using namespace m;
 M_LCOV_EXCL_START
 void Store::dump() const { dump(std::cerr); }
 M_LCOV_EXCL_STOP
+
+std::vector<std::pair<const void*, std::size_t>> m::memory_of_rows(const Store &store, std::size_t begin,
+                                                                    std::size_t end)
+{
+    std::vector<std::pair<const void*, std::size_t>> ranges;
+    if (begin >= end) return ranges;
+    auto bytes = [](const void *addr, std::size_t first_byte, std::size_t last_byte) {
+        return std::make_pair<const void*, std::size_t>(reinterpret_cast<const uint8_t*>(addr) + first_byte,
+                                                        last_byte - first_byte);
+    };
+
+    if (auto pax = cast<const PaxStore>(&store)) {
+        const std::size_t first_block = begin / pax->num_rows_per_block();
+        const std::size_t last_block = (end + pax->num_rows_per_block() - 1) / pax->num_rows_per_block();
+        ranges.push_back(bytes(pax->memory().addr(), first_block * pax->block_size(), last_block * pax->block_size()));
+    } else if (auto row = cast<const RowStore>(&store)) {
+        const std::size_t row_size = row->row_size() / 8;
+        ranges.push_back(bytes(row->memory().addr(), begin * row_size, end * row_size));
+    } else if (auto column = cast<const ColumnStore>(&store)) {
+        const auto &table = store.table();
+        for (std::size_t attr_id = 0; attr_id != table.num_attrs(); ++attr_id) {
+            const std::size_t size = table[attr_id].type->size(); // in bits
+            ranges.push_back(bytes(column->memory(attr_id), begin * size / 8, (end * size + 7) / 8));
+        }
+        const std::size_t num_attrs = table.num_attrs(); // one bit per attribute in the NULL bitmap
+        ranges.push_back(bytes(column->memory(num_attrs), begin * num_attrs / 8, (end * num_attrs + 7) / 8));
+    }
+    return ranges;
+}
+
+
+/*======================================================================================================================
+ * NUMA
+ *====================================================================================================================*/
+
+void m::numa_interleave(void *addr, std::size_t size)
+{
+    if (not options::numa) return;
+#if __linux
+    /* Interleave across all nodes the process may allocate memory on.  Since stores are backed by shared memory, the
+     * policy applies to all mappings of the memory, e.g. into the Wasm memory, as well.  Failing to set the policy
+     * only affects performance and is therefore ignored. */
+    unsigned long nodemask[16] = { 0 };
+    constexpr unsigned long MAX_NODE = sizeof(nodemask) * CHAR_BIT;
+    if (syscall(SYS_get_mempolicy, nullptr, nodemask, MAX_NODE, nullptr, MPOL_F_MEMS_ALLOWED))
+        return;
+    M_DISCARD syscall(SYS_mbind, addr, size, MPOL_INTERLEAVE, nodemask, MAX_NODE, 0);
+#endif
+}
+
+M_LCOV_EXCL_START
+void m::dump_numa_placement(std::ostream &out, const std::vector<std::pair<const void*, std::size_t>> &ranges)
+{
+    if (not options::numa) return;
+#if __linux
+    /* Sample at most `MAX_SAMPLES` pages evenly spread over all ranges. */
+    constexpr std::size_t MAX_SAMPLES = 4096;
+    const std::size_t page_size = get_pagesize();
+    std::size_t num_pages = 0;
+    for (auto &range : ranges)
+        num_pages += (range.second + page_size - 1) / page_size;
+    const std::size_t stride = std::max<std::size_t>(1, (num_pages + MAX_SAMPLES - 1) / MAX_SAMPLES) * page_size;
+    std::vector<void*> pages;
+    for (auto [addr, size] : ranges) {
+        for (std::size_t offset = 0; offset < size; offset += stride)
+            pages.push_back(const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(addr)) + offset);
+    }
+
+    /* Query the node of each sampled page without moving it. */
+    std::vector<int> status(pages.size());
+    if (syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, status.data(), 0)) {
+        out << "  NUMA placement unavailable: " << strerror(errno) << std::endl;
+        return;
+    }
+    std::map<int, std::size_t> num_pages_per_node;
+    std::size_t num_not_present = 0;
+    for (int s : status) {
+        if (s >= 0)
+            ++num_pages_per_node[s];
+        else
+            ++num_not_present; // not yet faulted in
+    }
+
+    out << "  NUMA placement of " << pages.size() << " sampled pages:";
+    for (auto [node, n] : num_pages_per_node)
+        out << " node " << node << ": " << n << ',';
+    out << " not present: " << num_not_present << std::endl;
+#else
+    out << "  NUMA placement unavailable" << std::endl;
+#endif
+}
+M_LCOV_EXCL_STOP
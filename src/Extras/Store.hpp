@@ -5,6 +5,10 @@
 #include "storage/ColumnStore.hpp"
 #include "storage/PaxStore.hpp"
 #include "storage/RowStore.hpp"
+#include <cstddef>
+#include <ostream>
+#include <utility>
+#include <vector>
 
 
 namespace m {
@@ -15,4 +19,15 @@ namespace m {
     X(PaxStore) \
     X(RowStore)
 
+/** Interleaves the \p size bytes of store memory at \p addr across all NUMA nodes iff `--numa` is given. */
+void numa_interleave(void *addr, std::size_t size);
+
+/** Prints the NUMA nodes of a sample of the pages within \p ranges, given as address and size in bytes each, to \p out
+ * iff `--numa` is given. */
+void dump_numa_placement(std::ostream &out, const std::vector<std::pair<const void*, std::size_t>> &ranges);
+
+/** Returns the ranges of memory, given as address and size in bytes each, that hold the rows in the range [\p begin,
+ * \p end) of \p store, or no ranges if the layout of \p store is unknown. */
+std::vector<std::pair<const void*, std::size_t>> memory_of_rows(const Store &store, std::size_t begin, std::size_t end);
+
 }
@@ -0,0 +1,114 @@
+#include "storage/StoreTiering.hpp"
+
+#include "storage/Store.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/util/memory.hpp>
+#include <utility>
+#include <vector>
+
+#if __linux
+#include <sys/mman.h>
+#endif
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** The memory budget of all stores in bytes, 0 for no budget. */
+std::size_t store_memory_budget = 0;
+
+}
+
+__attribute__((constructor(201)))
+static void add_store_tiering_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Store",
+        /* short=       */ nullptr,
+        /* long=        */ "--store-memory-budget",
+        /* description= */ "keep the memory of all stores within this many MiB by paging out the least frequently "
+                           "scanned stores to swap space, 0 for no budget",
+        /* callback=    */ [](std::size_t mib){ options::store_memory_budget = mib * 1024 * 1024; }
+    );
+}
+
+/** Applies `madvise()` with \p advice to the pages overlapping \p ranges.  Advice only affects performance, hence
+ * failures are ignored. */
+void advise(const std::vector<std::pair<const void*, std::size_t>> &ranges, [[maybe_unused]] int advice)
+{
+#if __linux
+    const std::size_t page_size = get_pagesize();
+    for (auto [addr, size] : ranges) {
+        if (size == 0) continue;
+        const uintptr_t first = reinterpret_cast<uintptr_t>(addr) & ~(page_size - 1); // align down to page
+        const uintptr_t last = reinterpret_cast<uintptr_t>(addr) + size;
+        M_DISCARD madvise(reinterpret_cast<void*>(first), last - first, advice);
+    }
+#endif
+}
+
+/** Returns the number of bytes of the rows of \p store. */
+std::size_t size_of(const Store &store)
+{
+    std::size_t size = 0;
+    for (auto &range : memory_of_rows(store, 0, store.num_rows()))
+        size += range.second;
+    return size;
+}
+
+}
+
+StoreTiering & StoreTiering::Get()
+{
+    static StoreTiering the_tiering;
+    return the_tiering;
+}
+
+bool StoreTiering::enabled() { return options::store_memory_budget != 0; }
+
+void StoreTiering::scanned(const Store &store)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++frequencies_[&store];
+    if (++num_scans_ == AGING_PERIOD) {
+        for (auto &entry : frequencies_)
+            entry.second /= 2;
+        num_scans_ = 0;
+    }
+
+    /* Keep the most frequently scanned stores, starting with the scanned store, until the budget is exhausted. */
+    std::vector<std::pair<std::size_t, const Store*>> stores;
+    for (auto [s, frequency] : frequencies_) {
+        if (s != &store)
+            stores.emplace_back(frequency, s);
+    }
+    std::sort(stores.begin(), stores.end(), [](auto &first, auto &second) { return first.first > second.first; });
+    std::size_t used = size_of(store);
+    for (auto [_, s] : stores) {
+        const std::size_t size = size_of(*s);
+        if (used + size <= options::store_memory_budget) {
+            used += size;
+            continue;
+        }
+#if __linux and defined(MADV_PAGEOUT)
+        advise(memory_of_rows(*s, 0, s->num_rows()), MADV_PAGEOUT); // cold, page out to swap space
+#endif
+        used = options::store_memory_budget; // all less frequently scanned stores are cold, too
+    }
+}
+
+void StoreTiering::prefetch(const Store &store, std::size_t begin, std::size_t end)
+{
+#if __linux
+    advise(memory_of_rows(store, begin, end), MADV_WILLNEED);
+#endif
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <mutable/storage/Store.hpp>
+#include <mutex>
+#include <unordered_map>
+
+
+namespace m {
+
+/** Keeps the memory of the stores of all tables within a budget, see `--store-memory-budget`, by tiering the stores
+ * between main memory and swap space, e.g. on an SSD.  Stores are backed by shared memory, which the kernel may swap
+ * out like any other memory.  However, left to the kernel, a scan of a table larger than the memory evicts the pages
+ * of all other tables and stalls on a page fault for every page it reads.  Instead, the stores compete for the budget
+ * by how frequently they are scanned: once the stores exceed the budget, the least frequently scanned stores are
+ * *cold* and paged out to swap space with `MADV_PAGEOUT`.  Scans read ahead with `MADV_WILLNEED`, `PREFETCH_DISTANCE`
+ * rows ahead of the rows currently scanned, s.t. the reads of the SSD overlap with query processing.
+ *
+ * The frequencies of scans are aged, s.t. a store scanned often in the past becomes cold when no longer scanned. */
+struct StoreTiering
+{
+    ///> the number of rows scans prefetch ahead of the rows currently scanned, about two morsels
+    static constexpr std::size_t PREFETCH_DISTANCE = 1UL << 15;
+    ///> the number of scans after which all scan frequencies are halved
+    static constexpr std::size_t AGING_PERIOD = 64;
+
+    private:
+    ///> the aged number of scans of each store
+    std::unordered_map<const Store*, std::size_t> frequencies_;
+    std::size_t num_scans_ = 0; ///< the number of scans since the frequencies were last aged
+    mutable std::mutex mutex_;
+
+    StoreTiering() = default;
+
+    public:
+    static StoreTiering & Get();
+
+    /** Returns `true` iff stores are tiered, i.e. a memory budget is given. */
+    static bool enabled();
+
+    /** Registers a scan of \p store and pages out the least frequently scanned stores other than \p store while the
+     * stores exceed the memory budget. */
+    void scanned(const Store &store);
+
+    /** Prefetches the rows in the range [\p begin, \p end) of \p store into memory without waiting for them. */
+    static void prefetch(const Store &store, std::size_t begin, std::size_t end);
+
+    /** Forgets \p store, e.g. when it is destroyed. */
+    void forget(const Store &store) { std::lock_guard<std::mutex> lock(mutex_); frequencies_.erase(&store); }
+};
+
+}
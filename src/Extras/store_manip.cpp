@@ -2,6 +2,7 @@
 
 #include "storage/ColumnStore.hpp"
 #include "util/datagen.hpp"
+#include "util/WorkerPool.hpp"
 #include <algorithm>
 #include <chrono>
 #include <cstring>
@@ -55,6 +56,35 @@ std::vector<T> generate_distinct_numbers(const T min, const T max, const std::si
     return values;
 }
 
+/** Writes `count` values to the column at address `column_ptr` by repeatedly writing all `values`, each time in a
+ * different arbitrary order.  Large columns are filled in parallel in chunks of whole rounds of `values`, where each
+ * chunk shuffles with its own PRNG stream seeded by `seed` and the chunk's index.  Hence, like the entire column, every
+ * chunk contains each value equally often and the result does not depend on the number of threads. */
+template<typename T>
+void fill_rounds(T *column_ptr, const std::vector<T> &values, std::size_t count, uint64_t seed)
+{
+    static constexpr std::size_t MIN_ROWS_PER_CHUNK = 1UL << 16;
+    M_insist(count == 0 or not values.empty(), "must provide at least one value");
+
+    auto fill_chunk = [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        std::vector<T> chunk_values(values);
+        std::mt19937_64 g(seed + chunk);
+        for (auto ptr = column_ptr + begin; ptr != column_ptr + end; ) {
+            /* Shuffle the vector before writing its values to the column. */
+            std::shuffle(chunk_values.begin(), chunk_values.end(), g);
+            const auto n = std::min<std::size_t>(chunk_values.size(), column_ptr + end - ptr);
+            ptr = std::copy_n(chunk_values.begin(), n, ptr);
+        }
+    };
+
+    /* Round the chunk size up to whole rounds of `values`. */
+    const std::size_t rows_per_chunk = (MIN_ROWS_PER_CHUNK + values.size() - 1) / values.size() * values.size();
+    const std::size_t num_chunks = (count + rows_per_chunk - 1) / rows_per_chunk;
+    WorkerPool::Get().parallel_for(num_chunks, [&](std::size_t chunk) {
+        fill_chunk(chunk, chunk * rows_per_chunk, std::min(count, (chunk + 1) * rows_per_chunk));
+    });
+}
+
 /** Generates data for a numeric column at address `column_ptr` of type `T` and writes it directly to memory.  The
 * rows must have been allocated before calling this function. */
 template<typename T>
@@ -78,20 +108,7 @@ void generate_numeric_column(T *column_ptr, std::size_t num_distinct_values, std
     M_insist(values.size() == num_distinct_values);
 
     /* Write distinct values repeatedly in arbitrary order to column. */
-    auto ptr = column_ptr + begin;
-    std::mt19937_64 g(0);
-    for (std::size_t i = 0; i != count; ) {
-        /* Shuffle the vector before writing its values to the column. */
-        std::shuffle(values.begin(), values.end(), g);
-        for (auto v : values) {
-            *ptr++ = v;
-            ++i;
-            if (i == count)
-                goto exit;
-        }
-    }
-exit:
-    M_insist(ptr - column_ptr == long(count), "incorrect number of elements written");
+    fill_rounds(column_ptr + begin, values, count, /* seed= */ 0);
 }
 
 template<typename T>
@@ -113,51 +130,13 @@ void generate_correlated_numeric_columns(T *left_ptr, T *right_ptr, std::size_t
         /* count= */ num_distinct_values_left + num_distinct_values_right - num_distinct_values_matching
     );
 
-    std::mt19937_64 g(0);
-
-    /* Fill `store_left`. */
-    {
-        /* Draw first `num_distinct_values_left` values from `values`. */
-        std::vector<T> values_left(values.begin(), values.begin() + num_distinct_values_left);
-
-        /* Write distinct values repeatedly in arbitrary order to column. */
-        auto left = left_ptr;
-        for (std::size_t i = 0; i != count_left; ) {
-            /* Shuffle the vector before writing its values to the column. */
-            std::shuffle(values_left.begin(), values_left.end(), g);
-            for (auto v : values_left) {
-                *left++ = v;
-                ++i;
-                if (i == count_left)
-                    goto exit_left;
-            }
-        }
-exit_left:
-        M_insist(left - left_ptr == long(count_left),
-                 "incorrect number of elements written to left store");
-    }
-
-    /* Fill `store_right`. */
-    {
-        /* Draw last `num_distinct_values_right` values from `values`. */
-        std::vector<T> values_right(values.rbegin(), values.rbegin() + num_distinct_values_right);
+    /* Fill `store_left` with the first `num_distinct_values_left` values of `values`. */
+    fill_rounds(left_ptr, std::vector<T>(values.begin(), values.begin() + num_distinct_values_left), count_left,
+                /* seed= */ 0);
 
-        /* Write distinct values repeatedly in arbitrary order to column. */
-        auto right = right_ptr;
-        for (std::size_t i = 0; i != count_right; ) {
-            /* Shuffle the vector before writing its values to the column. */
-            std::shuffle(values_right.begin(), values_right.end(), g);
-            for (auto v : values_right) {
-                *right++ = v;
-                ++i;
-                if (i == count_right)
-                    goto exit_right;
-            }
-        }
-exit_right:
-        M_insist(right - right_ptr == long(count_right),
-                "incorrect number of elements written to right store");
-    }
+    /* Fill `store_right` with the last `num_distinct_values_right` values of `values`. */
+    fill_rounds(right_ptr, std::vector<T>(values.rbegin(), values.rbegin() + num_distinct_values_right), count_right,
+                /* seed= */ uint64_t(1) << 32);
 }
 
 }
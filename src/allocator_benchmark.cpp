@@ -1,9 +1,12 @@
 #include <chrono>
 #include <cstdint>
 #include <iostream>
+#include <memory>
 #include <mutable/util/list_allocator.hpp>
 #include <mutable/util/malloc_allocator.hpp>
+#include <mutable/util/memory.hpp>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 
@@ -22,6 +25,27 @@ constexpr unsigned long long operator ""_Ki(unsigned long long n) { return n * 1
 constexpr unsigned long long operator ""_Mi(unsigned long long n) { return n * 1024 * 1024; }
 constexpr unsigned long long operator ""_Gi(unsigned long long n) { return n * 1024 * 1024 * 1024; }
 
+/** Adapts `m::memory::LinearAllocator`, which allocates whole pages of a memory file, to the interface of the other
+ * allocators.  A copy is a new, empty allocator. */
+struct memory_allocator
+{
+    private:
+    std::unique_ptr<m::memory::LinearAllocator> allocator_;
+    std::unordered_map<void*, m::memory::Memory> allocations_; ///< the allocated memory by its address
+
+    public:
+    memory_allocator() : allocator_(std::make_unique<m::memory::LinearAllocator>()) { }
+    memory_allocator(const memory_allocator&) : memory_allocator() { }
+
+    void * allocate(std::size_t size) {
+        auto mem = allocator_->allocate(size);
+        void *addr = mem.addr();
+        allocations_.emplace(addr, std::move(mem));
+        return addr;
+    }
+    void deallocate(void *ptr, std::size_t) { allocations_.erase(ptr); }
+};
+
 template<typename Allocator>
 void run_benchmark_allocations_fixed_allocate(const std::string &name, const Allocator &proto,
                                      const float fraction_deallocate, const std::size_t size)
@@ -140,6 +164,23 @@ void run_benchmark_suite_for_allocator(const std::string &name, const Allocator
 #endif
 }
 
+/** Since every allocation of a `memory_allocator` is a separate mapping, the allocations alive at the same time are
+ * limited by the maximum number of mappings per process.  Hence, only benchmarks deallocating at least every other
+ * allocation are run, which also exercise the reuse of deallocated memory. */
+void run_benchmark_suite_for_memory_allocator(const std::string &name, const memory_allocator &proto)
+{
+    for (float p : { .5f, 1.f}) {
+        run_benchmark_allocations_fixed_allocate(name, proto, p, 4_Ki);
+        run_benchmark_allocations_fixed_allocate(name, proto, p, 64_Ki);
+#ifdef NDEBUG
+        run_benchmark_allocations_fixed_allocate(name, proto, p, 8_Mi);
+#endif
+    }
+
+    run_benchmark_allocations_fixed_allocate_then_deallocate_reversed(name, proto, 4_Ki);
+    run_benchmark_allocations_fixed_allocate_then_deallocate_reversed(name, proto, 64_Ki);
+}
+
 
 int main(void)
 {
@@ -151,4 +192,5 @@ int main(void)
     run_benchmark_suite_for_allocator("list<Exponential-4K>", m::list_allocator{4_Ki, m::AllocationStrategy::Exponential});
     run_benchmark_suite_for_allocator("list<Exponential-64K>", m::list_allocator(64_Ki, m::AllocationStrategy::Exponential));
     run_benchmark_suite_for_allocator("list<Exponential-4M>", m::list_allocator(4_Mi, m::AllocationStrategy::Exponential));
+    run_benchmark_suite_for_memory_allocator("memory::Linear", memory_allocator{});
 }
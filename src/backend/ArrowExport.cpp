@@ -0,0 +1,330 @@
+#include "backend/ArrowExport.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "util/Date.hpp"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/util/fn.hpp>
+#include <mutable/util/macro.hpp>
+#include <optional>
+#include <sstream>
+#include <string>
+
+
+using namespace m;
+using namespace m::storage;
+using namespace m::wasm;
+
+
+namespace {
+
+/*======================================================================================================================
+ * Helper functions
+ *====================================================================================================================*/
+
+/** Returns the Arrow format string of values of `Type` \p type. */
+std::string arrow_format(const Type &type)
+{
+    std::ostringstream oss;
+    visit(overloaded {
+        [&](const Boolean&) { oss << 'b'; },
+        [&](const Numeric &n) {
+            switch (n.kind) {
+                case Numeric::N_Int:
+                    switch (n.size()) {
+                        default: M_unreachable("invalid integer size");
+                        case 8:  oss << 'c'; break;
+                        case 16: oss << 's'; break;
+                        case 32: oss << 'i'; break;
+                        case 64: oss << 'l'; break;
+                    }
+                    break;
+                case Numeric::N_Decimal:
+                    oss << "d:" << n.precision << ',' << n.scale << ',' << n.size(); // 32 or 64 bit decimal
+                    break;
+                case Numeric::N_Float:
+                    oss << (n.size() == 32 ? 'f' : 'g');
+                    break;
+            }
+        },
+        [&](const CharacterSequence &cs) { oss << "w:" << cs.size() / 8; }, // fixed-size, NUL-padded binary
+        [&](const Date&) { oss << "tdD"; },
+        [&](const DateTime&) { oss << "tss:"; }, // seconds since epoch without time zone
+        [&](const NoneType&) { oss << 'n'; },
+        [](auto&&) { M_unreachable("invalid type"); },
+    }, type);
+    return oss.str();
+}
+
+
+/*======================================================================================================================
+ * Exported structures
+ *====================================================================================================================*/
+
+/** The private data of an exported `ArrowSchema` of a record batch.  Owns the schemas of all columns. */
+struct schema_private_data
+{
+    std::vector<std::string> formats;
+    std::vector<std::string> names;
+    std::vector<ArrowSchema> children;
+    std::vector<ArrowSchema*> child_ptrs;
+};
+
+/** The private data of an exported `ArrowArray` of a record batch.  Owns the arrays of all columns and all buffers
+ * materialized for this batch. */
+struct array_private_data
+{
+    std::vector<ArrowArray> children;
+    std::vector<ArrowArray*> child_ptrs;
+    std::vector<std::vector<const void*>> buffers; ///< the buffers of each column
+    std::vector<std::unique_ptr<uint8_t[]>> materialized; ///< buffers materialized for this batch
+    const void *struct_buffers[1] = { nullptr }; ///< the record batch itself has no validity bitmap
+
+    uint8_t * materialize(std::size_t size_in_bytes) {
+        return materialized.emplace_back(std::make_unique<uint8_t[]>(size_in_bytes)).get(); // zero-initialized
+    }
+};
+
+/** Releases a column, which is owned by its record batch. */
+template<typename T>
+void release_child(T *child) { child->release = nullptr; }
+
+void release_schema(ArrowSchema *schema)
+{
+    delete static_cast<schema_private_data*>(schema->private_data);
+    schema->release = nullptr;
+}
+
+void release_array(ArrowArray *array)
+{
+    delete static_cast<array_private_data*>(array->private_data);
+    array->release = nullptr;
+}
+
+}
+
+
+/*======================================================================================================================
+ * Export
+ *====================================================================================================================*/
+
+void m::wasm::export_result_set_to_arrow(const Schema &schema, const Schema &layout_schema, const DataLayout *layout,
+                                         const uint8_t *data, std::size_t num_tuples,
+                                         const std::vector<const ast::Constant*> &constants,
+                                         const arrow_callback_t &callback)
+{
+    M_insist(constants.size() == schema.num_entries(), "constants must be given for each schema entry");
+    M_insist(bool(callback));
+
+    /*----- Collect the columns of a block, i.e. the offsets of all leaves and the NULL bitmap. -----*/
+    struct column_t
+    {
+        uint64_t offset_in_bits, stride_in_bits;
+    };
+    std::vector<std::optional<column_t>> columns(layout_schema.num_entries());
+    std::optional<column_t> null_bitmap;
+    std::size_t num_tuples_per_block = num_tuples; // single batch if result set contains only constants
+    uint64_t block_stride_in_bits = 0;
+    M_insist(bool(layout) == (layout_schema.num_entries() != 0), "layout must be given iff result set is not empty");
+    if (layout) {
+        layout->for_sibling_leaves([&](const std::vector<DataLayout::leaf_info_t> &leaves,
+                                       const DataLayout::level_info_stack_t &levels, uint64_t inode_offset_in_bits)
+        {
+            M_insist(levels.size() == 1 and inode_offset_in_bits == 0, "result set layout must consist of PAX blocks");
+            num_tuples_per_block = levels.back().num_tuples;
+            block_stride_in_bits = levels.back().stride_in_bits;
+            for (auto &leaf_info : leaves) {
+                const column_t column{ leaf_info.offset_in_bits, leaf_info.stride_in_bits };
+                if (leaf_info.leaf.index() == layout_schema.num_entries()) {
+                    null_bitmap = column;
+                } else {
+                    M_insist(leaf_info.offset_in_bits % 8 == 0, "columns must be byte aligned");
+                    M_insist(leaf_info.stride_in_bits == leaf_info.leaf.type()->size(), "columns must be packed");
+                    columns[leaf_info.leaf.index()] = column;
+                }
+            }
+        });
+    }
+    if (num_tuples_per_block == 0)
+        return; // no tuples in result set
+    M_insist(block_stride_in_bits % 8 == 0, "PAX blocks must be byte aligned");
+
+    /*----- Export each block as separate record batch. -----*/
+    for (std::size_t first = 0; first < num_tuples; first += num_tuples_per_block) {
+        const std::size_t length = std::min(num_tuples_per_block, num_tuples - first);
+        const uint8_t *block = data + (first / num_tuples_per_block) * (block_stride_in_bits / 8);
+
+        auto schema_data = new schema_private_data();
+        auto array_data = new array_private_data();
+        schema_data->formats.reserve(schema.num_entries());
+        schema_data->names.reserve(schema.num_entries());
+        schema_data->children.resize(schema.num_entries());
+        array_data->children.resize(schema.num_entries());
+        array_data->buffers.resize(schema.num_entries());
+
+        for (std::size_t i = 0; i != schema.num_entries(); ++i) {
+            auto &e = schema[i];
+            auto &child_schema = schema_data->children[i];
+            auto &child_array = array_data->children[i];
+            auto &buffers = array_data->buffers[i];
+
+            /*----- Describe the column. -----*/
+            std::ostringstream name;
+            name << e.id.name;
+            schema_data->formats.emplace_back(arrow_format(*e.type));
+            schema_data->names.emplace_back(name.str());
+            child_schema = ArrowSchema{
+                .format = schema_data->formats.back().c_str(),
+                .name = schema_data->names.back().c_str(),
+                .metadata = nullptr,
+                .flags = ARROW_FLAG_NULLABLE,
+                .n_children = 0,
+                .children = nullptr,
+                .dictionary = nullptr,
+                .release = &release_child<ArrowSchema>,
+                .private_data = nullptr,
+            };
+            child_array = ArrowArray{
+                .length = int64_t(length),
+                .null_count = 0,
+                .offset = 0,
+                .n_buffers = 2,
+                .n_children = 0,
+                .buffers = nullptr,
+                .children = nullptr,
+                .dictionary = nullptr,
+                .release = &release_child<ArrowArray>,
+                .private_data = nullptr,
+            };
+
+            if (e.type->is_none()) { // NULL constant, i.e. Arrow's null type without buffers
+                child_array.null_count = int64_t(length);
+                child_array.n_buffers = 0;
+                continue;
+            }
+
+            const std::size_t size_in_bits = e.type->size();
+            const void *values;
+            const void *validity = nullptr;
+            if (auto c = constants[i]) {
+                /*----- Materialize the constant for each tuple of the batch. -----*/
+                auto value = Interpreter::eval(*c);
+                uint8_t *buffer = array_data->materialize((length * size_in_bits + 7) / 8);
+                visit(overloaded {
+                    [&](const Boolean&) { std::memset(buffer, value.as_b() ? 0xFF : 0x00, (length + 7) / 8); },
+                    [&](const Numeric &n) {
+                        for (std::size_t j = 0; j != length; ++j) {
+                            uint8_t *dst = buffer + j * size_in_bits / 8;
+                            switch (n.kind) {
+                                case Numeric::N_Int:
+                                case Numeric::N_Decimal: {
+                                    const int64_t v = value.as_i();
+                                    std::memcpy(dst, &v, size_in_bits / 8); // little endian, i.e. truncates
+                                    break;
+                                }
+                                case Numeric::N_Float:
+                                    if (size_in_bits == 32) {
+                                        const float v = value.as_f();
+                                        std::memcpy(dst, &v, sizeof(v));
+                                    } else {
+                                        const double v = value.as_d();
+                                        std::memcpy(dst, &v, sizeof(v));
+                                    }
+                                    break;
+                            }
+                        }
+                    },
+                    [&](const CharacterSequence&) {
+                        for (std::size_t j = 0; j != length; ++j)
+                            std::strncpy(reinterpret_cast<char*>(buffer) + j * size_in_bits / 8,
+                                         reinterpret_cast<char*>(value.as_p()), size_in_bits / 8);
+                    },
+                    [&](const Date&) {
+                        const int32_t days = date::to_days(value.as_i());
+                        for (std::size_t j = 0; j != length; ++j)
+                            std::memcpy(buffer + j * sizeof(days), &days, sizeof(days));
+                    },
+                    [&](const DateTime&) {
+                        const int64_t time = value.as_i();
+                        for (std::size_t j = 0; j != length; ++j)
+                            std::memcpy(buffer + j * sizeof(time), &time, sizeof(time));
+                    },
+                    [](auto&&) { M_unreachable("invalid type"); },
+                }, *e.type);
+                values = buffer;
+            } else {
+                /*----- Refer to the column of the result set. -----*/
+                auto [layout_idx, layout_entry] = layout_schema[e.id];
+                M_insist(*layout_entry.type == *e.type);
+                M_insist(bool(columns[layout_idx]), "every result set entry must be contained in the layout");
+                const uint8_t *column = block + columns[layout_idx]->offset_in_bits / 8;
+
+                if (e.type->is_date()) {
+                    /*----- Convert dates to the number of days since the UNIX epoch. -----*/
+                    auto buffer = reinterpret_cast<int32_t*>(array_data->materialize(length * sizeof(int32_t)));
+                    auto dates = reinterpret_cast<const int32_t*>(column);
+                    for (std::size_t j = 0; j != length; ++j)
+                        buffer[j] = date::to_days(dates[j]);
+                    values = buffer;
+                } else {
+                    values = column; // zero copy
+                }
+
+                /*----- Compute the validity bitmap from the NULL bits of the tuples. -----*/
+                if (null_bitmap) {
+                    uint8_t *bitmap = array_data->materialize((length + 7) / 8);
+                    int64_t null_count = 0;
+                    for (std::size_t j = 0; j != length; ++j) {
+                        const uint64_t bit = null_bitmap->offset_in_bits + j * null_bitmap->stride_in_bits + layout_idx;
+                        const bool is_null = (block[bit / 8] >> (bit % 8)) & 0b1U;
+                        null_count += is_null;
+                        bitmap[j / 8] |= uint8_t(not is_null) << (j % 8);
+                    }
+                    child_array.null_count = null_count;
+                    if (null_count)
+                        validity = bitmap;
+                }
+            }
+            buffers = { validity, values };
+            child_array.buffers = buffers.data();
+        }
+
+        /*----- Describe the record batch. -----*/
+        for (auto &child : schema_data->children)
+            schema_data->child_ptrs.push_back(&child);
+        for (auto &child : array_data->children)
+            array_data->child_ptrs.push_back(&child);
+        ArrowSchema batch_schema{
+            .format = "+s",
+            .name = "",
+            .metadata = nullptr,
+            .flags = 0,
+            .n_children = int64_t(schema.num_entries()),
+            .children = schema_data->child_ptrs.data(),
+            .dictionary = nullptr,
+            .release = &release_schema,
+            .private_data = schema_data,
+        };
+        ArrowArray batch_array{
+            .length = int64_t(length),
+            .null_count = 0,
+            .offset = 0,
+            .n_buffers = 1,
+            .n_children = int64_t(schema.num_entries()),
+            .buffers = array_data->struct_buffers,
+            .children = array_data->child_ptrs.data(),
+            .dictionary = nullptr,
+            .release = &release_array,
+            .private_data = array_data,
+        };
+
+        /*----- Hand out the record batch and release it unless the callback moved it. -----*/
+        callback(batch_schema, batch_array);
+        if (batch_schema.release)
+            batch_schema.release(&batch_schema);
+        if (batch_array.release)
+            batch_array.release(&batch_array);
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/storage/DataLayout.hpp>
+#include <vector>
+
+
+/*======================================================================================================================
+ * Arrow C Data Interface
+ *
+ * The ABI-stable structures of the [Arrow C Data Interface](https://arrow.apache.org/docs/format/CDataInterface.html),
+ * copied verbatim from the specification as recommended by it.
+ *====================================================================================================================*/
+
+extern "C" {
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+  // Array type description
+  const char* format;
+  const char* name;
+  const char* metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowSchema*);
+  // Opaque producer-specific data
+  void* private_data;
+};
+
+struct ArrowArray {
+  // Array data description
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowArray*);
+  // Opaque producer-specific data
+  void* private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+}
+
+
+namespace m {
+
+namespace ast { struct Constant; }
+
+namespace wasm {
+
+/** A callback receiving a single record batch of a result set, i.e. an `ArrowSchema` of format `+s` describing the
+ * columns and an `ArrowArray` of the same format containing them.  The buffers of non-constant columns point directly
+ * into the result set in the Wasm memory and are therefore only valid until the callback returns.  Both structures
+ * are released after the callback returns unless the callback moved them, i.e. set their `release` to `nullptr`. */
+using arrow_callback_t = std::function<void(ArrowSchema&, ArrowArray&)>;
+
+/** Exports the first \p num_tuples tuples of the result set at \p data as Arrow record batches of the `Schema` \p
+ * schema and passes each batch to \p callback.  The result set must be stored in the columnar `DataLayout` \p layout
+ * of \p layout_schema, i.e. a PAX layout with one INode per block, and each block is exported as separate batch.  The
+ * tuples' non-constant entries are looked up in \p layout_schema by their identifier.  For each entry of \p schema,
+ * \p constants contains the `ast::Constant` of a constant entry and `nullptr` otherwise.  If \p schema contains only
+ * constants, \p layout and \p data must be `nullptr` and all tuples are exported as a single batch.
+ *
+ * Values are handed out without copying them, except for validity bitmaps (since the layout stores NULL bits per
+ * tuple rather than per column), dates (since their encoding differs from Arrow's `date32`), and constants, which are
+ * materialized per batch. */
+void export_result_set_to_arrow(const Schema &schema, const Schema &layout_schema, const storage::DataLayout *layout,
+                                const uint8_t *data, std::size_t num_tuples,
+                                const std::vector<const ast::Constant*> &constants, const arrow_callback_t &callback);
+
+}
+
+}
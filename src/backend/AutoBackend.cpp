@@ -0,0 +1,119 @@
+#include "backend/AutoBackend.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/Options.hpp>
+#include <utility>
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** How many times slower the `Interpreter` processes a tuple than compiled code. */
+double interpreter_slowdown = 20.;
+/** The cost of compiling a single operator, in tuples processed by compiled code. */
+double compile_cost = 2e6;
+
+}
+
+/** Returns the estimated number of tuples processed by the plan rooted in \p op, i.e. the sum of the estimated
+ * cardinalities of all operators, and the number of operators of the plan.  Operators without cardinality estimate
+ * contribute the estimate of their largest child. */
+std::pair<double, std::size_t> estimate_work(const Operator &op)
+{
+    double num_tuples = 0, max_child = 0;
+    std::size_t num_operators = 1;
+    if (auto c = cast<const Consumer>(&op)) {
+        for (auto child : c->children()) {
+            const auto [num_tuples_child, num_operators_child] = estimate_work(*child);
+            num_tuples += num_tuples_child;
+            max_child = std::max(max_child, num_tuples_child);
+            num_operators += num_operators_child;
+        }
+    }
+    return { num_tuples + (op.has_info() ? op.info().estimated_cardinality : max_child), num_operators };
+}
+
+}
+
+AutoBackend::AutoBackend()
+{
+    Catalog &C = Catalog::Get();
+    interpreter_ = C.create_backend(C.pool("Interpreter"));
+    const auto compiled_name = C.pool("WasmV8");
+    if (std::any_of(C.backends_cbegin(), C.backends_cend(), [&](auto &b) { return b.first == compiled_name; }))
+        compiled_ = C.create_backend(compiled_name);
+    chosen_ = interpreter_.get();
+}
+
+void AutoBackend::choose(const Operator &plan)
+{
+    if (not compiled_) {
+        chosen_ = interpreter_.get();
+        return;
+    }
+
+    const auto [num_tuples, num_operators] = estimate_work(plan);
+    const double cost_interpreted = options::interpreter_slowdown * num_tuples;
+    const double cost_compiled = options::compile_cost * num_operators + num_tuples;
+    chosen_ = cost_interpreted < cost_compiled ? interpreter_.get() : compiled_.get();
+
+    if (Options::Get().statistics) {
+        std::cout << "Backend: " << (chosen_ == interpreter_.get() ? "Interpreter" : "WasmV8")
+                  << " (estimated cost interpreted " << cost_interpreted << ", compiled " << cost_compiled << ')'
+                  << std::endl;
+    }
+}
+
+void AutoBackend::register_operators(PhysicalOptimizer &phys_opt) const
+{
+    M_insist(bool(chosen_));
+    chosen_->register_operators(phys_opt);
+}
+
+void AutoBackend::execute(const MatchBase &plan) const
+{
+    M_insist(bool(chosen_));
+    chosen_->execute(plan);
+}
+
+__attribute__((constructor(202)))
+static void register_auto_backend()
+{
+    Catalog &C = Catalog::Get();
+    C.register_backend<AutoBackend>(C.pool("auto"), "choose between Interpreter and WasmV8 per query by estimated cost "
+                                                    "of interpretation and of compilation and execution");
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<double>(
+        /* group=       */ "Auto backend",
+        /* short=       */ nullptr,
+        /* long=        */ "--auto-backend-interpreter-slowdown",
+        /* description= */ "set how many times slower the Interpreter processes a tuple than compiled code",
+        /* callback=    */ [](double slowdown){
+            if (slowdown <= 0) {
+                std::cerr << "warning: ignore invalid interpreter slowdown " << slowdown << std::endl;
+                return;
+            }
+            options::interpreter_slowdown = slowdown;
+        }
+    );
+    C.arg_parser().add<double>(
+        /* group=       */ "Auto backend",
+        /* short=       */ nullptr,
+        /* long=        */ "--auto-backend-compile-cost",
+        /* description= */ "set the cost of compiling a single operator, in tuples processed by compiled code",
+        /* callback=    */ [](double cost){
+            if (cost < 0) {
+                std::cerr << "warning: ignore invalid compile cost " << cost << std::endl;
+                return;
+            }
+            options::compile_cost = cost;
+        }
+    );
+}
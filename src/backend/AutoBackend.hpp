@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <mutable/backend/Backend.hpp>
+#include <mutable/IR/Operator.hpp>
+
+
+namespace m {
+
+/** A backend choosing per query between the `Interpreter` and the compiled WebAssembly backend by their estimated
+ * costs.  The interpreter starts executing immediately but processes each tuple slower, while the compiled backend
+ * first compiles the plan, which takes longer the more operators the plan has.  With `W` the estimated number of tuples
+ * processed by the plan, i.e. the sum of the estimated cardinalities of its operators, and `n` its number of operators,
+ * the cost of interpretation is estimated as `s * W` and the cost of compilation and execution as `c * n + W`, where
+ * `s` is the slowdown of the interpreter and `c` the cost of compiling a single operator, in tuples processed by
+ * compiled code, see `--auto-backend-interpreter-slowdown` and `--auto-backend-compile-cost`.  Hence, catalog lookups
+ * and point queries are interpreted while large scans and joins are compiled.
+ *
+ * `choose()` must be called with the logical plan of each query before the operators are registered and the plan is
+ * executed. */
+struct AutoBackend : Backend
+{
+    private:
+    std::unique_ptr<Backend> interpreter_;
+    std::unique_ptr<Backend> compiled_; ///< the compiled backend, `nullptr` if no such backend is available
+    const Backend *chosen_ = nullptr; ///< the backend chosen for the current query
+
+    public:
+    AutoBackend();
+
+    /** Chooses the backend for the query with logical plan \p plan.  Reports the choice and the estimated costs if
+     * statistics are requested. */
+    void choose(const Operator &plan);
+
+    void register_operators(PhysicalOptimizer &phys_opt) const override;
+    void execute(const MatchBase &plan) const override;
+};
+
+}
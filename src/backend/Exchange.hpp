@@ -0,0 +1,225 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutable/util/macro.hpp>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace m {
+
+/** A bounded, lock-free queue of a single producer and a single consumer. */
+template<typename T>
+struct SpscQueue
+{
+    private:
+    std::unique_ptr<std::optional<T>[]> slots_;
+    std::size_t num_slots_; ///< the capacity plus one, to tell a full from an empty queue
+    ///> the slot to pop next, written by the consumer only
+    alignas(64) std::atomic<std::size_t> head_ = 0;
+    ///> the slot to push next, written by the producer only
+    alignas(64) std::atomic<std::size_t> tail_ = 0;
+
+    public:
+    explicit SpscQueue(std::size_t capacity)
+        : slots_(std::make_unique<std::optional<T>[]>(capacity + 1))
+        , num_slots_(capacity + 1)
+    {
+        M_insist(capacity > 0);
+    }
+
+    /** Pushes \p value.  Returns `false`, and leaves \p value untouched, iff the queue is full. */
+    bool try_push(T &value) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t next = tail + 1 == num_slots_ ? 0 : tail + 1;
+        if (next == head_.load(std::memory_order_acquire))
+            return false;
+        slots_[tail].emplace(std::move(value));
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /** Pops the oldest value, or returns `std::nullopt` iff the queue is empty. */
+    std::optional<T> try_pop() {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+            return std::nullopt;
+        std::optional<T> value(std::move(slots_[head]));
+        slots_[head].reset();
+        head_.store(head + 1 == num_slots_ ? 0 : head + 1, std::memory_order_release);
+        return value;
+    }
+};
+
+/** Thrown by `Exchange::Producer::push()` when the exchange is cancelled, to unwind the producing fragment. */
+struct exchange_cancelled : std::exception
+{
+    const char * what() const noexcept override { return "exchange cancelled"; }
+};
+
+/** How an `Exchange` distributes the values of its producers among its consumers. */
+enum exchange_kind
+{
+    E_Repartition, ///< every value goes to the consumer chosen by its hash
+    E_Broadcast, ///< every value goes to every consumer
+    E_RoundRobin, ///< the batches of a producer go to the consumers in turn
+};
+
+/** Connects the fragments of a plan that are executed by different threads.  Each of `num_producers` producing
+ * fragments pushes values, e.g. tuples, into the exchange, which collects them in batches and passes full batches to
+ * the consuming fragments, one of `num_consumers`, as given by \p Kind.  There is one `SpscQueue` per pair of producer
+ * and consumer, hence producers and consumers never contend for a lock or a cache line.  A producer blocks while the
+ * queue to a consumer is full, which bounds the memory of the exchange and throttles producers to the pace of the
+ * consumers.
+ *
+ * An exchange of a single consumer *gathers* the values of all producers. */
+template<typename T, exchange_kind Kind>
+struct Exchange
+{
+    using batch_type = std::vector<T>;
+
+    /** The producing side of an exchange, used by a single thread. */
+    struct Producer
+    {
+        private:
+        Exchange *exchange_;
+        std::size_t id_;
+        std::vector<batch_type> batches_; ///< the batch being filled for each consumer
+        std::size_t next_consumer_ = 0; ///< the consumer receiving the next batch of a round-robin exchange
+
+        public:
+        Producer(Exchange &exchange, std::size_t id)
+            : exchange_(&exchange)
+            , id_(id)
+            , batches_(Kind == E_RoundRobin ? 1 : exchange.num_consumers())
+        { }
+
+        Producer(Producer&&) = default;
+
+        /** Pushes \p value, with hash \p hash for a repartitioning exchange.  Throws `exchange_cancelled` if the
+         * exchange was cancelled. */
+        void push(T value, std::size_t hash = 0) {
+            if constexpr (Kind == E_Repartition) {
+                append(hash % exchange_->num_consumers(), std::move(value));
+            } else if constexpr (Kind == E_Broadcast) {
+                for (std::size_t consumer = 1; consumer < exchange_->num_consumers(); ++consumer)
+                    append(consumer, T(value));
+                append(0, std::move(value));
+            } else {
+                auto &batch = batches_[0];
+                batch.push_back(std::move(value));
+                if (batch.size() == exchange_->batch_size()) {
+                    exchange_->send(id_, next_consumer_, batch);
+                    next_consumer_ = (next_consumer_ + 1) % exchange_->num_consumers();
+                }
+            }
+        }
+
+        /** Sends all partially filled batches and marks this producer as finished. */
+        void finish() {
+            if constexpr (Kind == E_RoundRobin) {
+                if (not batches_[0].empty())
+                    exchange_->send(id_, next_consumer_, batches_[0]);
+            } else {
+                for (std::size_t consumer = 0; consumer != batches_.size(); ++consumer) {
+                    if (not batches_[consumer].empty())
+                        exchange_->send(id_, consumer, batches_[consumer]);
+                }
+            }
+            exchange_->num_finished_.fetch_add(1, std::memory_order_release);
+        }
+
+        private:
+        void append(std::size_t consumer, T value) {
+            auto &batch = batches_[consumer];
+            batch.push_back(std::move(value));
+            if (batch.size() == exchange_->batch_size())
+                exchange_->send(id_, consumer, batch);
+        }
+    };
+
+    private:
+    std::size_t num_producers_;
+    std::size_t num_consumers_;
+    std::size_t batch_size_;
+    ///> the queue from producer `p` to consumer `c` at index `p * num_consumers_ + c`
+    std::vector<std::unique_ptr<SpscQueue<batch_type>>> queues_;
+    std::atomic<std::size_t> num_finished_ = 0; ///< the number of finished producers
+    std::atomic<bool> cancelled_ = false;
+
+    public:
+    /** Creates an exchange of \p num_producers producers and \p num_consumers consumers, passing batches of
+     * \p batch_size values, at most \p queue_capacity batches per pair of producer and consumer in flight. */
+    Exchange(std::size_t num_producers, std::size_t num_consumers, std::size_t batch_size,
+             std::size_t queue_capacity = 4)
+        : num_producers_(num_producers)
+        , num_consumers_(num_consumers)
+        , batch_size_(batch_size)
+    {
+        M_insist(num_producers > 0 and num_consumers > 0 and batch_size > 0);
+        for (std::size_t i = 0; i != num_producers * num_consumers; ++i)
+            queues_.push_back(std::make_unique<SpscQueue<batch_type>>(queue_capacity));
+    }
+
+    Exchange(const Exchange&) = delete;
+
+    std::size_t num_producers() const { return num_producers_; }
+    std::size_t num_consumers() const { return num_consumers_; }
+    std::size_t batch_size() const { return batch_size_; }
+
+    /** Returns the producing side of producer \p id. */
+    Producer producer(std::size_t id) {
+        M_insist(id < num_producers_);
+        return Producer(*this, id);
+    }
+
+    /** Returns the next batch for consumer \p consumer, waiting until one is available, or `std::nullopt` once all
+     * producers finished and all their batches were received, or the exchange was cancelled. */
+    std::optional<batch_type> receive(std::size_t consumer) {
+        M_insist(consumer < num_consumers_);
+        std::size_t producer = 0;
+        for (;;) {
+            if (cancelled_.load(std::memory_order_relaxed))
+                return std::nullopt;
+            /* Read the number of finished producers *before* polling, s.t. the batches they sent are visible. */
+            const bool all_finished = num_finished_.load(std::memory_order_acquire) == num_producers_;
+            for (std::size_t i = 0; i != num_producers_; ++i) {
+                auto &queue = *queues_[producer * num_consumers_ + consumer];
+                producer = producer + 1 == num_producers_ ? 0 : producer + 1; // poll producers fairly
+                if (auto batch = queue.try_pop())
+                    return batch;
+            }
+            if (all_finished)
+                return std::nullopt;
+            std::this_thread::yield();
+        }
+    }
+
+    /** Cancels the exchange: producers throw `exchange_cancelled` on their next push and consumers receive no more
+     * batches. */
+    void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+    /** Returns `true` iff the exchange was cancelled. */
+    bool cancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+
+    private:
+    /** Sends \p batch from \p producer to \p consumer, waiting while their queue is full, and clears \p batch. */
+    void send(std::size_t producer, std::size_t consumer, batch_type &batch) {
+        auto &queue = *queues_[producer * num_consumers_ + consumer];
+        for (;;) {
+            if (cancelled())
+                throw exchange_cancelled();
+            if (queue.try_push(batch))
+                break;
+            std::this_thread::yield();
+        }
+        batch = batch_type();
+        batch.reserve(batch_size_);
+    }
+};
+
+}
@@ -1,22 +1,88 @@
 #include "backend/Interpreter.hpp"
-
+#include "backend/Exchange.hpp"
+#include "backend/ResultWriter.hpp"
+#include "backend/SharedScans.hpp"
+
+#include "catalog/CardinalityFeedback.hpp"
+#include "catalog/NullFreeColumns.hpp"
+#include "catalog/QueryCancellation.hpp"
+#include "storage/PaxStore.hpp"
+#include "storage/StoreTiering.hpp"
 #include "util/container/RefCountingHashMap.hpp"
+#include "util/WorkerPool.hpp"
 #include <algorithm>
 #include <cerrno>
+#include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <functional>
 #include <iterator>
+#include <mutex>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/Options.hpp>
 #include <mutable/parse/AST.hpp>
 #include <mutable/util/fn.hpp>
 #include <numeric>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 
 using namespace m;
 using namespace m::storage;
 
 
+namespace {
+
+namespace options {
+
+/** The capacity of blocks of the `Interpreter`'s pipelines. */
+std::size_t block_capacity = 64;
+/** Whether sources of pipelines fill blocks only with as many tuples as fit into the L1 cache. */
+bool adaptive_block_size = false;
+/** Whether conjunctive filters reorder their clauses at runtime by the observed pass rates. */
+bool adaptive_filters = false;
+/** The maximum number of threads scanning a table in parallel. */
+std::size_t num_threads = 1;
+/** Whether scans of a table attach to running scans of the table by concurrent queries, see `SharedScans`. */
+bool shared_scans = false;
+/** Whether constant expressions are evaluated once at compile time and identity operations are removed. */
+bool constant_folding = true;
+
+}
+
+/** Whether the calling thread currently evaluates a constant expression, see `Interpreter::fold()`. */
+thread_local bool is_folding = false;
+
+/** Returns `true` iff \p e is built from constants by operators and casts and evaluating \p e cannot trap. */
+bool is_constant_expr(const ast::Expr &e)
+{
+    if (is<const ast::Constant>(e))
+        return true;
+    if (auto u = cast<const ast::UnaryExpr>(&e))
+        return is_constant_expr(*u->expr);
+    if (auto b = cast<const ast::BinaryExpr>(&e)) {
+        if ((b->op().type == TK_SLASH or b->op().type == TK_PERCENT) and not b->type()->is_floating_point())
+            return false; // integral division by zero traps
+        return is_constant_expr(*b->lhs) and is_constant_expr(*b->rhs);
+    }
+    if (auto fn = cast<const ast::FnApplicationExpr>(&e)) {
+        const auto fnid = fn->get_function().fnid;
+        if (fnid != Function::FN_INT and fnid != Function::FN_ISNULL)
+            return false; // aggregates and UDFs
+        return std::all_of(fn->args.begin(), fn->args.end(), [](auto &arg) { return is_constant_expr(*arg); });
+    }
+    return false; // designators and subqueries
+}
+
+}
+
+
 /*======================================================================================================================
  * Helper function
  *====================================================================================================================*/
@@ -541,10 +607,144 @@ static StackMachine compile_data_layout(const Schema &tuple_schema, void *addres
     return SM;
 }
 
+namespace {
+
+/** Caches the `StackMachine`s compiled by `Interpreter::compile_load()`, s.t. repeated scans of a table do not compile
+ * their loader anew.  A loader is identified by the address of the store, the IDs of the row and tuple it starts at,
+ * the schemas of the loaded tuples and of the layout, and the structure of the layout, see `loader_key()`.  Since
+ * evaluating a loader advances the pointers in its context, lookups return a copy of the cached loader. */
+struct LoaderCache
+{
+    ///> the maximum number of cached loaders; when exceeded, the cache is cleared
+    static constexpr std::size_t CAPACITY = 256;
+
+    private:
+    std::unordered_map<std::string, StackMachine> cache_;
+    mutable std::mutex mutex_;
+
+    LoaderCache() = default;
+
+    public:
+    static LoaderCache & Get() {
+        static LoaderCache the_cache;
+        return the_cache;
+    }
+
+    /** Returns a copy of the loader cached for \p key, if any. */
+    std::optional<StackMachine> find(const std::string &key) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto it = cache_.find(key); it != cache_.end())
+            return StackMachine(it->second);
+        return std::nullopt;
+    }
+
+    /** Caches a copy of \p loader for \p key. */
+    void insert(std::string key, const StackMachine &loader) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cache_.size() >= CAPACITY)
+            cache_.clear();
+        cache_.insert_or_assign(std::move(key), StackMachine(loader));
+    }
+};
+
+/** Returns the key of the loader compiled for the given arguments in the `LoaderCache`. */
+std::string loader_key(const Schema &tuple_schema, void *address, const DataLayout &layout,
+                       const Schema &layout_schema, std::size_t row_id, std::size_t tuple_id)
+{
+    std::ostringstream oss;
+    oss << address << ' ' << row_id << ' ' << tuple_id << '\n' << tuple_schema << '\n' << layout_schema << '\n';
+    for (auto &e : layout_schema)
+        oss << e.nullable();
+    auto print_node = [&oss](const DataLayout::INode &node, auto &print_node_ref) -> void {
+        oss << '(' << node.num_tuples();
+        for (auto &child : node) {
+            oss << ' ' << child.offset_in_bits << ':' << child.stride_in_bits << ':';
+            if (auto child_leaf = cast<const DataLayout::Leaf>(child.ptr.get()))
+                oss << child_leaf->index() << ':' << child_leaf->type();
+            else
+                print_node_ref(*as<const DataLayout::INode>(child.ptr.get()), print_node_ref);
+        }
+        oss << ')';
+    };
+    print_node(static_cast<const DataLayout::INode&>(layout), print_node);
+    return oss.str();
+}
+
+}
+
+std::optional<Value> Interpreter::fold(const ast::Expr &e)
+{
+    if (not options::constant_folding or is_folding or is<const ast::Constant>(e) or e.type()->is_none() or
+        e.type()->is_character_sequence() or not is_constant_expr(e))
+        return std::nullopt;
+
+    /* Compile the expression without folding it again. */
+    is_folding = true;
+    StackMachine SM;
+    SM.emit(e);
+    SM.emit_St_Tup(0, 0, e.type());
+    is_folding = false;
+
+    Tuple res({ e.type() });
+    Tuple *args[] = { &res };
+    SM(args);
+    if (res.is_null(0))
+        return std::nullopt;
+    return res[0];
+}
+
+const ast::Expr * Interpreter::identity_operand(const ast::BinaryExpr &e)
+{
+    if (not options::constant_folding)
+        return nullptr;
+
+    /* Returns `true` iff `operand` is an integral constant expression evaluating to `value`. */
+    auto evaluates_to = [](const ast::Expr &operand, int64_t value) {
+        if (not operand.type()->is_integral())
+            return false;
+        std::optional<Value> v;
+        if (auto c = cast<const ast::Constant>(&operand))
+            v = eval(*c);
+        else
+            v = fold(operand);
+        return v and v->as_i() == value;
+    };
+    /* Returns `operand` iff `e` has its type, i.e. no conversion is required. */
+    auto reduce_to = [&e](const ast::Expr &operand) { return operand.type() == e.type() ? &operand : nullptr; };
+
+    switch (e.op().type) {
+        default:
+            return nullptr;
+
+        case TK_PLUS:
+            if (evaluates_to(*e.rhs, 0)) return reduce_to(*e.lhs);
+            if (evaluates_to(*e.lhs, 0)) return reduce_to(*e.rhs);
+            return nullptr;
+
+        case TK_ASTERISK:
+            if (evaluates_to(*e.rhs, 1)) return reduce_to(*e.lhs);
+            if (evaluates_to(*e.lhs, 1)) return reduce_to(*e.rhs);
+            return nullptr;
+
+        case TK_MINUS:
+            return evaluates_to(*e.rhs, 0) ? reduce_to(*e.lhs) : nullptr;
+
+        case TK_SLASH:
+            return evaluates_to(*e.rhs, 1) ? reduce_to(*e.lhs) : nullptr;
+    }
+}
+
 StackMachine Interpreter::compile_load(const Schema &tuple_schema, void *address, const storage::DataLayout &layout,
                                        const Schema &layout_schema, std::size_t row_id, std::size_t tuple_id)
 {
-    return compile_data_layout<false>(tuple_schema, address, layout, layout_schema, row_id, tuple_id);
+    auto &cache = LoaderCache::Get();
+    auto key = loader_key(tuple_schema, address, layout, layout_schema, row_id, tuple_id);
+    if (auto loader = cache.find(key))
+        return std::move(*loader);
+    auto loader = compile_data_layout<false>(tuple_schema, address, layout, layout_schema, row_id, tuple_id);
+    loader.fuse(); // fuse once for all copies
+    cache.insert(std::move(key), loader);
+    return loader;
 }
 
 StackMachine Interpreter::compile_store(const Schema &tuple_schema, void *address, const storage::DataLayout &layout,
@@ -553,30 +753,279 @@ StackMachine Interpreter::compile_store(const Schema &tuple_schema, void *addres
     return compile_data_layout<true>(tuple_schema, address, layout, layout_schema, row_id, tuple_id);
 }
 
+void Interpreter::update_aggregate(const ast::FnApplicationExpr &fe, Tuple &group, std::size_t idx,
+                                   const Tuple &arguments, std::size_t nth_tuple)
+{
+    bool is_null = group.is_null(idx);
+    auto &val = group[idx];
+
+    auto ty = fe.type();
+    auto &fn = fe.get_function();
+
+    switch (fn.fnid) {
+        default:
+            M_unreachable("function kind not implemented");
+
+        case Function::FN_UDF:
+            M_unreachable("UDFs not yet supported");
+
+        case Function::FN_COUNT:
+            if (is_null)
+                group.set(idx, 0); // initialize
+            if (fe.args.size() == 0) { // COUNT(*)
+                val.as_i() += 1;
+            } else { // COUNT(x) aka. count not NULL
+                val.as_i() += not arguments.is_null(0);
+            }
+            break;
+
+        case Function::FN_SUM: {
+            auto n = as<const Numeric>(ty);
+            if (is_null) {
+                if (n->is_floating_point())
+                    group.set(idx, 0.); // double precision
+                else
+                    group.set(idx, 0); // int
+            }
+            if (arguments.is_null(0)) return; // skip NULL
+            if (n->is_floating_point())
+                val.as_d() += arguments[0].as_d();
+            else
+                val.as_i() += arguments[0].as_i();
+            break;
+        }
+
+        case Function::FN_AVG: {
+            if (is_null) {
+                if (ty->is_floating_point())
+                    group.set(idx, 0.); // double precision
+                else
+                    group.set(idx, 0); // int
+            }
+            if (arguments.is_null(0)) return; // skip NULL
+            /* Compute AVG as iterative mean as described in Knuth, The Art of Computer Programming Vol 2,
+             * section 4.2.2. */
+            val.as_d() += (arguments[0].as_d() - val.as_d()) / nth_tuple;
+            break;
+        }
+
+        case Function::FN_MIN: {
+            using std::min;
+            if (arguments.is_null(0)) return; // skip NULL
+            if (is_null) {
+                group.set(idx, arguments[0]);
+                return;
+            }
+
+            auto n = as<const Numeric>(ty);
+            if (n->is_float())
+                val.as_f() = min(val.as_f(), arguments[0].as_f());
+            else if (n->is_double())
+                val.as_d() = min(val.as_d(), arguments[0].as_d());
+            else
+                val.as_i() = min(val.as_i(), arguments[0].as_i());
+            break;
+        }
+
+        case Function::FN_MAX: {
+            using std::max;
+            if (arguments.is_null(0)) return; // skip NULL
+            if (is_null) {
+                group.set(idx, arguments[0]);
+                return;
+            }
+
+            auto n = as<const Numeric>(ty);
+            if (n->is_float())
+                val.as_f() = max(val.as_f(), arguments[0].as_f());
+            else if (n->is_double())
+                val.as_d() = max(val.as_d(), arguments[0].as_d());
+            else
+                val.as_i() = max(val.as_i(), arguments[0].as_i());
+            break;
+        }
+    }
+}
+
 /*======================================================================================================================
  * Declaration of operator data.
  *====================================================================================================================*/
 
 namespace {
 
-struct PrintData : OperatorData
+/** Merges the partial aggregate at index \p idx of \p from, computed from \p num_from tuples, into the partial
+ * aggregate at index \p idx of \p into, computed from \p num_into tuples.  The aggregate function is given by \p fe. */
+void merge_aggregate(const ast::FnApplicationExpr &fe, Tuple &into, std::size_t idx, std::size_t num_into,
+                     const Tuple &from, std::size_t num_from)
 {
-    uint32_t num_rows = 0;
-    StackMachine printer;
-    PrintData(const PrintOperator &op)
-        : printer(op.schema())
+    if (from.is_null(idx))
+        return; // nothing to merge
+    if (into.is_null(idx)) {
+        into.set(idx, from.get(idx));
+        return;
+    }
+
+    auto ty = fe.type();
+    auto &val = into[idx];
+    Value other = from.get(idx);
+
+    switch (fe.get_function().fnid) {
+        default:
+            M_unreachable("function kind not implemented");
+
+        case Function::FN_UDF:
+            M_unreachable("UDFs not yet supported");
+
+        case Function::FN_COUNT:
+            val.as_i() += other.as_i();
+            break;
+
+        case Function::FN_SUM: {
+            auto n = as<const Numeric>(ty);
+            if (n->is_floating_point())
+                val.as_d() += other.as_d();
+            else
+                val.as_i() += other.as_i();
+            break;
+        }
+
+        case Function::FN_AVG: {
+            /* Weigh the running means by the number of tuples they were computed from. */
+            const double total = num_into + num_from;
+            val.as_d() = val.as_d() * (num_into / total) + other.as_d() * (num_from / total);
+            break;
+        }
+
+        case Function::FN_MIN: {
+            using std::min;
+            auto n = as<const Numeric>(ty);
+            if (n->is_float())
+                val.as_f() = min(val.as_f(), other.as_f());
+            else if (n->is_double())
+                val.as_d() = min(val.as_d(), other.as_d());
+            else
+                val.as_i() = min(val.as_i(), other.as_i());
+            break;
+        }
+
+        case Function::FN_MAX: {
+            using std::max;
+            auto n = as<const Numeric>(ty);
+            if (n->is_float())
+                val.as_f() = max(val.as_f(), other.as_f());
+            else if (n->is_double())
+                val.as_d() = max(val.as_d(), other.as_d());
+            else
+                val.as_i() = max(val.as_i(), other.as_i());
+            break;
+        }
+    }
+}
+
+/** Stores rows of a fixed `Schema` in large chunks of memory, that are freed all at once when the arena is destroyed,
+ * instead of in one heap-allocated `Tuple` each.  A row is a contiguous sequence of bytes holding the `Value`s of the
+ * row, followed by one NULL byte per value and the characters of its character sequences. */
+struct RowArena
+{
+    ///> the minimum number of bytes allocated at once
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+    private:
+    struct attribute_info
     {
-        auto &S = op.schema();
-        auto ostream_index = printer.add(&op.out);
-        for (std::size_t i = 0; i != S.num_entries(); ++i) {
-            if (i != 0)
-                printer.emit_Putc(ostream_index, ',');
-            printer.emit_Ld_Tup(0, i);
-            printer.emit_Print(ostream_index, S[i].type);
+        std::size_t string_offset; ///< the offset of the characters in a row, if a character sequence
+        std::size_t string_length; ///< the maximum number of characters, if a character sequence, and 0 otherwise
+    };
+
+    std::vector<attribute_info> attributes_;
+    std::size_t row_size_; ///< the size of a row in bytes
+    std::vector<std::unique_ptr<uint8_t[]>> chunks_;
+    uint8_t *next_ = nullptr; ///< the beginning of the next row of the current chunk
+    uint8_t *end_ = nullptr; ///< the end of the current chunk
+
+    public:
+    RowArena(const Schema &S) {
+        std::size_t offset = S.num_entries() * (sizeof(Value) + 1); // values and NULL bytes
+        for (auto &e : S) {
+            if (auto cs = cast<const CharacterSequence>(e.type)) {
+                attributes_.push_back({ offset, cs->length });
+                offset += cs->length + 1; // terminating NUL byte
+            } else {
+                attributes_.push_back({ 0, 0 });
+            }
+        }
+        row_size_ = (offset + alignof(Value) - 1) / alignof(Value) * alignof(Value);
+    }
+
+    /** Copies \p tuple into a new row and returns the row. */
+    const uint8_t * append(Tuple &tuple) {
+        if (std::size_t(end_ - next_) < row_size_) {
+            const std::size_t size = std::max(CHUNK_SIZE, row_size_);
+            next_ = chunks_.emplace_back(new uint8_t[size]).get();
+            end_ = next_ + size;
+        }
+        uint8_t *row = next_;
+        next_ += row_size_;
+
+        Value *values = reinterpret_cast<Value*>(row);
+        uint8_t *nulls = row + attributes_.size() * sizeof(Value);
+        for (std::size_t i = 0; i != attributes_.size(); ++i) {
+            nulls[i] = tuple.is_null(i);
+            if (nulls[i])
+                continue;
+            if (auto &attr = attributes_[i]; attr.string_length) {
+                const char *str = reinterpret_cast<const char*>(tuple[i].as_p());
+                const auto len = strnlen(str, attr.string_length);
+                std::copy_n(str, len, row + attr.string_offset);
+                row[attr.string_offset + len] = '\0';
+            } else {
+                new (&values[i]) Value(tuple[i]);
+            }
+        }
+        return row;
+    }
+
+    /** Loads the value at index `first` of \p row into index `second` of \p tuple for each pair of \p mapping. */
+    void load(const uint8_t *row, Tuple &tuple, const std::vector<std::pair<std::size_t, std::size_t>> &mapping) const {
+        for (auto [from, to] : mapping)
+            load(row, from, tuple, to);
+    }
+
+    /** Loads all values of \p row into \p tuple. */
+    void load(const uint8_t *row, Tuple &tuple) const {
+        for (std::size_t i = 0; i != attributes_.size(); ++i)
+            load(row, i, tuple, i);
+    }
+
+    /** Moves the rows of \p other into this arena.  Rows returned by `other.append()` remain valid. */
+    void adopt(RowArena &other) {
+        M_insist(other.row_size_ == row_size_);
+        std::move(other.chunks_.begin(), other.chunks_.end(), std::back_inserter(chunks_));
+        other.chunks_.clear();
+        other.next_ = other.end_ = nullptr;
+    }
+
+    private:
+    void load(const uint8_t *row, std::size_t from, Tuple &tuple, std::size_t to) const {
+        if (row[attributes_.size() * sizeof(Value) + from]) {
+            tuple.null(to);
+        } else if (auto &attr = attributes_[from]; attr.string_length) {
+            std::strcpy(reinterpret_cast<char*>(tuple[to].as_p()),
+                        reinterpret_cast<const char*>(row + attr.string_offset));
+            tuple.not_null(to);
+        } else {
+            tuple.set(to, reinterpret_cast<const Value*>(row)[from]);
         }
     }
 };
 
+struct PrintData : OperatorData
+{
+    uint32_t num_rows = 0;
+    ResultWriter writer;
+    PrintData(const PrintOperator &op) : writer(op.out, op.schema()) { }
+};
+
 struct NoOpData : OperatorData
 {
     uint32_t num_rows = 0;
@@ -599,6 +1048,7 @@ struct ProjectionData : OperatorData
         for (auto &p : op.projections()) {
             projections->emit(p.first.get(), 1);
             projections->emit_St_Tup(0, out_idx++, p.first.get().type());
+            projections->emit_Pop();
         }
     }
 };
@@ -618,6 +1068,7 @@ struct JoinData : OperatorData
             if (it != pipeline.schema().end()) { // attribute is needed
                 SM.emit_Ld_Tup(1, schema_idx);
                 SM.emit_St_Tup(0, std::distance(pipeline.schema().begin(), it), e.type);
+                SM.emit_Pop();
             }
         }
     }
@@ -649,13 +1100,27 @@ struct SimpleHashJoinData : JoinData
     std::vector<std::pair<const ast::Expr*, const ast::Expr*>> exprs;
     StackMachine build_key; ///< extracts the key of the build input
     StackMachine probe_key; ///< extracts the key of the probe input
-    RefCountingHashMap<Tuple, Tuple> ht; ///< hash table on build input
+    RowArena build_rows; ///< the tuples of the build input
+    RefCountingHashMap<Tuple, const uint8_t*> ht; ///< hash table on build input, mapping keys to rows of `build_rows`
+    ///> the pairs of indices of the attributes of the build input and of the join result loaded from `build_rows`
+    std::vector<std::pair<std::size_t, std::size_t>> build_attrs;
 
     Schema key_schema; ///< the `Schema` of the `key`
     Tuple key; ///< `Tuple` to hold the key
+    std::vector<Tuple> probe_keys; ///< the keys of the tuples of a probe block
+    std::vector<Tuple*> probe_tuples; ///< the tuples of a probe block, in the order of `probe_keys`
+
+    bool track_key_range = false; ///< whether the range of the build keys is tracked, i.e. iff the key is integral
+    ///> the minimum and maximum non-`NULL` build key; `std::nullopt` if untracked or no such key was inserted
+    std::optional<std::pair<int64_t, int64_t>> build_key_range;
+    ///> the scan of the probe input whose PAX blocks are skipped by `build_key_range`, if any
+    const ScanOperator *probe_scan = nullptr;
+    ///> the ranges of rows of `probe_scan` whose PAX blocks may contain keys within `build_key_range`
+    std::vector<std::pair<std::size_t, std::size_t>> probe_scan_ranges;
 
     SimpleHashJoinData(const JoinOperator &op)
         : JoinData(op)
+        , build_rows(op.child(0)->schema())
         , ht(1024)
     {
         auto &schema_lhs = op.child(0)->schema();
@@ -702,6 +1167,76 @@ struct SimpleHashJoinData : JoinData
 
         /* Create the tuple holding a key. */
         key = Tuple(key_schema);
+
+        if (exprs.size() == 1) {
+            auto ty = exprs[0].first->type();
+            track_key_range = ty->is_integral() or ty->is_date() or ty->is_date_time();
+        }
+    }
+
+    /** Extends `build_key_range` by the non-`NULL` build key \p key. */
+    void extend_build_key_range(int64_t key) {
+        if (build_key_range)
+            *build_key_range = { std::min(build_key_range->first, key), std::max(build_key_range->second, key) };
+        else
+            build_key_range.emplace(key, key);
+    }
+
+    /** Returns `true` iff the probe key \p key may have a join partner w.r.t. `build_key_range`. */
+    bool in_build_key_range(const Tuple &key) const {
+        if (not build_key_range or key.is_null(0))
+            return true; // `NULL` keys are left to the hash table
+        const int64_t k = key[0].as_i();
+        return build_key_range->first <= k and k <= build_key_range->second;
+    }
+
+    /** Determines the scan of the probe input of \p op whose PAX blocks can be skipped by `build_key_range`, i.e. a
+     * scan of a `PaxStore` with synopses on the probe key, reached from the probe input only through filters, and
+     * computes the ranges of its rows whose blocks may contain keys within `build_key_range`. */
+    void compute_probe_scan_ranges(const JoinOperator &op) {
+        if (not build_key_range or CardinalityFeedback::enabled()) // feedback must observe the entire scan
+            return;
+        auto D = cast<const ast::Designator>(exprs[0].second);
+        if (not D)
+            return;
+        auto attr = std::get_if<const Attribute*>(&D->target());
+        if (not attr)
+            return;
+
+        const Producer *current = op.child(1);
+        for (;;) {
+            if (auto filter = cast<const FilterOperator>(current))
+                current = filter->child(0);
+            else if (auto filter = cast<const DisjunctiveFilterOperator>(current))
+                current = filter->child(0);
+            else
+                break;
+        }
+        auto scan = cast<const ScanOperator>(current);
+        if (not scan or &scan->store().table() != &(*attr)->table or
+            scan->schema().find({ D->table_name.text, D->attr_name.text.assert_not_none() }) == scan->schema().cend())
+            return;
+        auto pax = cast<const PaxStore>(&scan->store());
+        if (not pax or not pax->has_synopses(**attr))
+            return;
+
+        const auto [min, max] = *build_key_range;
+        const auto &synopses = pax->synopses(**attr);
+        const std::size_t num_rows = pax->num_rows();
+        const std::size_t num_rows_per_block = pax->num_rows_per_block();
+        for (std::size_t block = 0; block != synopses.size(); ++block) {
+            auto &synopsis = synopses[block];
+            if (std::holds_alternative<std::monostate>(synopsis.min) or std::get<int64_t>(synopsis.min) > max or
+                std::get<int64_t>(synopsis.max) < min)
+                continue; // skip block
+            const std::size_t begin = block * num_rows_per_block;
+            const std::size_t end = std::min(num_rows, (block + 1) * num_rows_per_block);
+            if (not probe_scan_ranges.empty() and probe_scan_ranges.back().second == begin)
+                probe_scan_ranges.back().second = end; // extend previous range
+            else
+                probe_scan_ranges.emplace_back(begin, end);
+        }
+        probe_scan = scan;
     }
 
     void load_build_key(const Schema &pipeline_schema) {
@@ -709,6 +1244,12 @@ struct SimpleHashJoinData : JoinData
             const ast::Expr *expr = exprs[i].first;
             build_key.emit(*expr, pipeline_schema, 1); // compile expr
             build_key.emit_St_Tup(0, i, expr->type()); // write result to index i
+            build_key.emit_Pop();
+        }
+        for (std::size_t schema_idx = 0; schema_idx != pipeline_schema.num_entries(); ++schema_idx) {
+            auto it = pipeline.schema().find(pipeline_schema[schema_idx].id);
+            if (it != pipeline.schema().end()) // attribute is needed
+                build_attrs.emplace_back(schema_idx, std::distance(pipeline.schema().begin(), it));
         }
     }
 
@@ -717,6 +1258,277 @@ struct SimpleHashJoinData : JoinData
             const ast::Expr *expr = exprs[i].second;
             probe_key.emit(*expr, pipeline_schema, 1); // compile expr
             probe_key.emit_St_Tup(0, i, expr->type()); // write result to index i
+            probe_key.emit_Pop();
+        }
+    }
+};
+
+/** Data of a worst-case optimal multi-way join of more than two children, whose predicate is a conjunction of
+ * equalities of attributes of different children, by *Generic Join* on hash tries.  The equalities partition the join
+ * attributes into equivalence classes, the *variables* of the join.  All children are buffered and each is indexed by
+ * a hash trie with one level per variable it binds, in a global order of the variables.  The join binds one variable
+ * at a time by intersecting the keys of the current trie nodes of all children binding the variable, iterating the
+ * smallest node.  In contrast to a tree of binary joins, the cost is bounded by the worst-case size of the result,
+ * which avoids the huge intermediate results of binary plans for cyclic queries, e.g. triangles. */
+struct MultiwayJoinData : JoinData
+{
+    /** An attribute `child.id` occurring in the join predicate. */
+    struct term_type
+    {
+        std::size_t child;
+        Schema::Identifier id;
+
+        bool operator==(const term_type &other) const { return child == other.child and id == other.id; }
+    };
+    using equality_type = std::pair<term_type, term_type>;
+
+    /** Indexes the tuples of a child by the values of its variables, one level per variable. */
+    struct HashTrie
+    {
+        struct node_type
+        {
+            std::unordered_map<Tuple, std::size_t> children; ///< maps each key of the next variable to its node
+            std::vector<std::size_t> rows; ///< the indices of the tuples of a leaf in the buffer of the child
+        };
+
+        std::vector<node_type> nodes; ///< all nodes of the trie, the root first
+
+        HashTrie() : nodes(1) { }
+    };
+
+    std::vector<std::vector<Tuple>> buffers; ///< tuple buffer per child
+    std::vector<Schema> buffer_schemas; ///< schema of each buffer
+    std::size_t active_child;
+
+    std::vector<Schema> key_schemas; ///< the `Schema` of the key of each variable
+    std::vector<Tuple> keys; ///< `Tuple` to hold the key of each variable
+    ///> the children binding each variable
+    std::vector<std::vector<std::size_t>> var_children;
+    ///> per child and level of its trie, the variable and the bound attribute
+    std::vector<std::vector<std::pair<std::size_t, Schema::Identifier>>> levels;
+    std::vector<std::vector<StackMachine>> extract_keys; ///< per child and level, extracts the key of the level
+    std::vector<HashTrie> tries; ///< the hash trie per child
+    std::vector<std::size_t> cursors; ///< the current trie node per child
+
+    ///> whether a child binds a variable to multiple attributes, which must additionally be checked for equality
+    bool needs_predicate = false;
+    StackMachine predicate; ///< evaluates the predicate to a bool
+    Tuple res;
+
+    MultiwayJoinData(const JoinOperator &op, const std::vector<equality_type> &equalities)
+        : JoinData(op)
+        , buffers(op.children().size())
+        , levels(op.children().size())
+        , extract_keys(op.children().size())
+        , tries(op.children().size())
+        , cursors(op.children().size(), 0)
+        , res({ Type::Get_Boolean(Type::TY_Vector) })
+    {
+        auto &C = Catalog::Get();
+
+        /*----- Compute the variables as equivalence classes of terms by union-find. -----*/
+        std::vector<term_type> terms;
+        std::vector<std::size_t> parent;
+        auto find = [&](std::size_t t) {
+            while (parent[t] != t)
+                t = parent[t] = parent[parent[t]];
+            return t;
+        };
+        auto term_id = [&](const term_type &term) {
+            auto it = std::find(terms.begin(), terms.end(), term);
+            if (it != terms.end())
+                return std::size_t(std::distance(terms.begin(), it));
+            terms.push_back(term);
+            parent.push_back(parent.size());
+            return terms.size() - 1;
+        };
+        for (auto &[first, second] : equalities) {
+            const std::size_t f = find(term_id(first));
+            const std::size_t s = find(term_id(second));
+            parent[f] = s;
+        }
+
+        std::vector<std::size_t> term_var(terms.size(), std::size_t(-1L));
+        std::vector<std::vector<std::size_t>> var_terms;
+        for (std::size_t t = 0; t != terms.size(); ++t) {
+            const std::size_t root = find(t);
+            if (term_var[root] == std::size_t(-1L)) {
+                term_var[root] = var_terms.size();
+                var_terms.emplace_back();
+            }
+            var_terms[term_var[root]].push_back(t);
+        }
+
+        /*----- Order the variables by the number of children binding them, s.t. the most constrained go first. -----*/
+        std::vector<std::vector<std::size_t>> children_of_var;
+        for (auto &vt : var_terms) {
+            auto &children = children_of_var.emplace_back();
+            for (std::size_t t : vt) {
+                if (std::find(children.begin(), children.end(), terms[t].child) == children.end())
+                    children.push_back(terms[t].child);
+                else
+                    needs_predicate = true; // the child binds the variable to multiple attributes
+            }
+        }
+        std::vector<std::size_t> order(var_terms.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t left, std::size_t right) {
+            return children_of_var[left].size() > children_of_var[right].size();
+        });
+
+        /*----- Compute the levels of the trie of each child. -----*/
+        for (std::size_t var = 0; var != order.size(); ++var) {
+            auto &vt = var_terms[order[var]];
+            auto &first = terms[vt.front()];
+            key_schemas.emplace_back().add(C.pool("key"), op.child(first.child)->schema().find(first.id)->type);
+            keys.emplace_back(key_schemas.back());
+            var_children.emplace_back(children_of_var[order[var]]);
+            for (std::size_t t : vt) {
+                auto &term = terms[t];
+                if (levels[term.child].empty() or levels[term.child].back().first != var)
+                    levels[term.child].emplace_back(var, term.id); // the first attribute of the child is indexed
+            }
+        }
+    }
+
+    /** Returns the equalities of the predicate of \p op if it can be evaluated by a `MultiwayJoinData`, i.e. \p op has
+     * more than two children and its predicate is a conjunction of equalities of attributes of distinct children of
+     * equal type, or `std::nullopt` otherwise. */
+    static std::optional<std::vector<equality_type>> Get_Equalities(const JoinOperator &op) {
+        if (op.children().size() <= 2 or op.predicate().empty())
+            return std::nullopt;
+
+        auto get_term = [&op](const ast::Expr *expr) -> std::optional<term_type> {
+            if (not is<const ast::Designator>(expr))
+                return std::nullopt;
+            auto required = expr->get_required();
+            if (required.num_entries() != 1)
+                return std::nullopt;
+            const auto &id = required[0].id;
+            for (std::size_t child = 0; child != op.children().size(); ++child) {
+                auto &schema = op.child(child)->schema();
+                if (schema.find(id) != schema.end())
+                    return term_type{ child, id };
+            }
+            return std::nullopt;
+        };
+
+        std::vector<equality_type> equalities;
+        for (auto &clause : op.predicate()) {
+            if (clause.size() != 1 or clause[0].negative())
+                return std::nullopt;
+            auto binary = cast<const ast::BinaryExpr>(&clause[0].expr());
+            if (not binary or binary->tok != TK_EQUAL or binary->lhs->type() != binary->rhs->type())
+                return std::nullopt;
+            auto first = get_term(binary->lhs.get());
+            auto second = get_term(binary->rhs.get());
+            if (not first or not second or first->child == second->child)
+                return std::nullopt;
+            equalities.emplace_back(std::move(*first), std::move(*second));
+        }
+        return equalities;
+    }
+
+    /** Compiles buffering the tuples of the active child, produced by a pipeline with `Schema` \p pipeline_schema. */
+    void compile_child(const JoinOperator &op, const Schema &pipeline_schema) {
+        buffer_schemas.emplace_back(pipeline_schema); // save the schema of the current pipeline
+        emit_load_attrs(pipeline_schema);
+        M_insist(buffer_schemas.size() == load_attrs.size());
+        for (auto &[var, id] : levels[active_child]) {
+            auto it = pipeline_schema.find(id);
+            M_insist(it != pipeline_schema.end(), "attribute of the join predicate must be produced by the child");
+            auto &SM = extract_keys[active_child].emplace_back();
+            SM.emit_Ld_Tup(1, std::distance(pipeline_schema.begin(), it));
+            SM.emit_St_Tup(0, 0, it->type);
+            SM.emit_Pop();
+        }
+        if (needs_predicate and buffer_schemas.size() == op.children().size()) {
+            std::vector<std::size_t> tuple_ids(op.children().size());
+            std::iota(tuple_ids.begin(), tuple_ids.end(), 1); // start at index 1
+            predicate.emit(op.predicate(), buffer_schemas, tuple_ids);
+            predicate.emit_St_Tup_b(0, 0);
+        }
+    }
+
+    /** Builds the hash trie of each child on its buffer. */
+    void build_tries() {
+        for (std::size_t child = 0; child != buffers.size(); ++child) {
+            auto &trie = tries[child];
+            auto &child_levels = levels[child];
+            for (std::size_t row = 0; row != buffers[child].size(); ++row) {
+                /* Extract the keys of all levels first, s.t. tuples with a NULL key do not leave empty paths. */
+                bool has_null = false;
+                for (std::size_t level = 0; level != child_levels.size(); ++level) {
+                    auto &key = keys[child_levels[level].first];
+                    Tuple *args[2] = { &key, &buffers[child][row] };
+                    extract_keys[child][level](args);
+                    if (key.is_null(0)) {
+                        has_null = true; // NULL never equals any value
+                        break;
+                    }
+                }
+                if (has_null)
+                    continue;
+
+                std::size_t node = 0;
+                for (auto &level : child_levels) {
+                    const std::size_t var = level.first;
+                    auto &children = trie.nodes[node].children;
+                    if (auto it = children.find(keys[var]); it != children.end()) {
+                        node = it->second;
+                    } else {
+                        const std::size_t next = trie.nodes.size();
+                        children.emplace(keys[var].clone(key_schemas[var]), next);
+                        trie.nodes.emplace_back(); // invalidates `children`
+                        node = next;
+                    }
+                }
+                trie.nodes[node].rows.push_back(row);
+            }
+        }
+    }
+
+    /** Binds the variables from \p var on by intersecting the trie nodes of the children at `cursors` and calls
+     * \p callback once all variables are bound, with `cursors` positioned at the leaves of all children. */
+    template<typename Callback>
+    void for_each_match(std::size_t var, Callback &&callback) {
+        if (var == var_children.size()) {
+            callback();
+            return;
+        }
+
+        /*----- Iterate the keys of the smallest node and probe the nodes of all other children binding `var`. -----*/
+        auto &children = var_children[var];
+        auto node_of = [this](std::size_t child) -> auto & { return tries[child].nodes[cursors[child]]; };
+        std::size_t smallest = children.front();
+        for (std::size_t child : children) {
+            if (node_of(child).children.size() < node_of(smallest).children.size())
+                smallest = child;
+        }
+
+        const auto &candidates = node_of(smallest).children; // `tries` remain unchanged while joining
+        std::vector<std::size_t> saved;
+        for (std::size_t child : children)
+            saved.push_back(cursors[child]);
+        for (auto &[key, next] : candidates) {
+            bool matches = true;
+            for (std::size_t child : children) {
+                if (child == smallest) {
+                    cursors[child] = next;
+                    continue;
+                }
+                auto &child_children = node_of(child).children;
+                auto it = child_children.find(key);
+                if (it == child_children.end()) {
+                    matches = false;
+                    break;
+                }
+                cursors[child] = it->second;
+            }
+            if (matches)
+                for_each_match(var + 1, callback);
+            for (std::size_t i = 0; i != children.size(); ++i)
+                cursors[children[i]] = saved[i];
         }
     }
 };
@@ -745,6 +1557,7 @@ struct GroupingData : OperatorData
             for (auto [grp, alias] : op.group_by()) {
                 compute_key.emit(grp.get(), 1);
                 compute_key.emit_St_Tup(0, key_idx++, grp.get().type());
+                compute_key.emit_Pop();
             }
         }
 
@@ -759,6 +1572,7 @@ struct GroupingData : OperatorData
                 sm.emit(*arg, 1);
                 sm.emit_Cast(agg.get().type(), arg->type()); // cast argument type to aggregate type, e.g. f32 to f64 for SUM
                 sm.emit_St_Tup(0, arg_idx++, arg->type());
+                sm.emit_Pop();
                 arg_types.push_back(arg->type());
             }
             args.emplace_back(Tuple(arg_types));
@@ -793,11 +1607,65 @@ struct AggregationData : OperatorData
                 sm.emit(*arg, 1);
                 sm.emit_Cast(agg.get().type(), arg->type()); // cast argument type to aggregate type, e.g. f32 to f64 for SUM
                 sm.emit_St_Tup(0, arg_idx++, agg.get().type()); // store casted argument of aggregate type to tuple
+                sm.emit_Pop();
                 arg_types.push_back(agg.get().type());
             }
             args.emplace_back(Tuple(arg_types));
             compute_aggregate_arguments.emplace_back(std::move(sm));
         }
+
+        /* Initialize aggregates. */
+        for (std::size_t i = 0, end = op.aggregates().size(); i != end; ++i) {
+            auto &fe = as<const ast::FnApplicationExpr>(op.aggregates()[i].get());
+            auto ty = fe.type();
+            auto &fn = fe.get_function();
+
+            switch (fn.fnid) {
+                default:
+                    M_unreachable("function kind not implemented");
+
+                case Function::FN_UDF:
+                    M_unreachable("UDFs not yet supported");
+
+                case Function::FN_COUNT:
+                    aggregates.set(i, 0); // initialize
+                    break;
+
+                case Function::FN_SUM: {
+                    auto n = as<const Numeric>(ty);
+                    if (n->is_floating_point())
+                        aggregates.set(i, 0.); // double precision
+                    else
+                        aggregates.set(i, 0L); // int64
+                    break;
+                }
+
+                case Function::FN_AVG: {
+                    if (ty->is_floating_point())
+                        aggregates.set(i, 0.); // double precision
+                    else
+                        aggregates.set(i, 0L); // int64
+                    break;
+                }
+
+                case Function::FN_MIN:
+                case Function::FN_MAX: {
+                    aggregates.null(i); // initialize to NULL
+                    break;
+                }
+            }
+        }
+    }
+
+    /** Merges the partial aggregates of \p other, computed by a worker of a parallel scan, into the aggregates. */
+    void merge(AggregationData &other, const AggregationOperator &op) {
+        const std::size_t count_idx = op.schema().num_entries();
+        const std::size_t num_tuples = aggregates[count_idx].as_i();
+        const std::size_t num_other = other.aggregates[count_idx].as_i();
+        for (std::size_t i = 0, end = op.aggregates().size(); i != end; ++i)
+            merge_aggregate(as<const ast::FnApplicationExpr>(op.aggregates()[i].get()),
+                            aggregates, i, num_tuples, other.aggregates, num_other);
+        aggregates[count_idx].as_i() += num_other;
     }
 };
 
@@ -842,31 +1710,434 @@ struct HashBasedGroupingData : GroupingData
      * of tuples that belong to this group. */
     std::unordered_map<Tuple, unsigned, hasher, equals> groups;
 
+    ///> the maximum initial number of buckets of `groups`, to bound the cost of overestimated groupings
+    static constexpr std::size_t MAX_INITIAL_BUCKETS = 1UL << 22;
+
     HashBasedGroupingData(const GroupingOperator &op)
         : GroupingData(op)
-        , groups(1024, hasher(op.group_by().size()), equals(op.group_by().size()))
+        , groups(initial_buckets(op), hasher(op.group_by().size()), equals(op.group_by().size()))
     { }
-};
 
-struct SortingData : OperatorData
-{
-    Pipeline pipeline;
-    std::vector<Tuple> buffer;
+    /** Merges the groups of \p other, computed by a worker of a parallel scan, into the groups. */
+    void merge(HashBasedGroupingData &other, const GroupingOperator &op) {
+        const std::size_t key_size = op.group_by().size();
+        while (not other.groups.empty()) {
+            auto node = other.groups.extract(other.groups.begin());
+            auto it = groups.find(node.key());
+            if (it == groups.end()) {
+                groups.insert(std::move(node));
+                continue;
+            }
+            Tuple &group = const_cast<Tuple&>(it->first);
+            for (std::size_t i = 0, end = op.aggregates().size(); i != end; ++i)
+                merge_aggregate(as<const ast::FnApplicationExpr>(op.aggregates()[i].get()),
+                                group, key_size + i, it->second, node.key(), node.mapped());
+            it->second += node.mapped();
+        }
+    }
 
-    SortingData(Schema buffer_schema) : pipeline(std::move(buffer_schema)) { }
+    /** Returns the initial number of buckets of `groups`, sized up front for the estimated number of groups of \p op
+     * to avoid rehashing while grouping. */
+    static std::size_t initial_buckets(const GroupingOperator &op) {
+        if (not op.has_info()) return 1024;
+        return std::clamp<std::size_t>(op.info().estimated_cardinality, 1024, MAX_INITIAL_BUCKETS);
+    }
 };
 
-struct FilterData : OperatorData
+/** Encodes the keys of a sorting into *normalized keys*, byte strings of fixed width that compare with `std::memcmp`
+ * in the order of the keys.  Each key is encoded as a byte that orders NULL first, like the `WasmEngine`, followed by
+ * the value in big-endian order: integers with their sign bit flipped, floating-point numbers as `double` with their
+ * sign bit flipped if positive and all bits inverted if negative, and character sequences padded with NUL bytes to
+ * their maximum length.  The values of descending keys are inverted. */
+struct NormalizedKeyEncoder
 {
-    StackMachine filter;
-    Tuple res;
+    private:
+    struct key_info
+    {
+        const Type *type;
+        std::size_t width; ///< the number of bytes of the encoded value, excluding the NULL byte
+        bool ascending;
+    };
+
+    std::vector<key_info> keys_;
+    std::size_t width_ = 0;
+
+    public:
+    /** Adds a key of type \p ty, sorted in ascending order iff \p ascending. */
+    void add(const Type *ty, bool ascending) {
+        std::size_t width;
+        if (ty->is_boolean())
+            width = 1;
+        else if (auto cs = cast<const CharacterSequence>(ty))
+            width = cs->length;
+        else
+            width = 8; // integers, decimals, dates, datetimes, and floating-point numbers as `double`
+        keys_.push_back({ ty, width, ascending });
+        width_ += 1 + width;
+    }
+
+    /** Returns the width of the normalized keys in bytes. */
+    std::size_t width() const { return width_; }
+
+    /** Writes the normalized key of the values of the keys in \p values to \p out. */
+    void encode(Tuple &values, uint8_t *out) const {
+        for (std::size_t i = 0; i != keys_.size(); ++i) {
+            auto &key = keys_[i];
+            if (values.is_null(i)) {
+                *out = 0;
+                std::fill_n(out + 1, key.width, 0);
+            } else {
+                *out = 1;
+                auto &val = values[i];
+                if (key.type->is_boolean()) {
+                    out[1] = val.as_b();
+                } else if (key.type->is_character_sequence()) {
+                    const char *str = reinterpret_cast<const char*>(val.as_p());
+                    const auto len = strnlen(str, key.width);
+                    std::copy_n(str, len, out + 1);
+                    std::fill_n(out + 1 + len, key.width - len, 0);
+                } else {
+                    uint64_t bits;
+                    auto n = cast<const Numeric>(key.type);
+                    if (n and n->kind == Numeric::N_Float) {
+                        double d = n->size() <= 32 ? double(val.as_f()) : val.as_d();
+                        if (d == 0) d = 0.; // -0.0 and 0.0 are equal
+                        std::memcpy(&bits, &d, sizeof(bits));
+                        bits = bits >> 63 ? ~bits : bits | (1UL << 63);
+                    } else {
+                        bits = uint64_t(val.as_i()) ^ (1UL << 63);
+                    }
+                    for (std::size_t b = 0; b != 8; ++b)
+                        out[1 + b] = bits >> (56 - 8 * b);
+                }
+                if (not key.ascending) {
+                    for (std::size_t b = 1; b <= key.width; ++b)
+                        out[b] = ~out[b];
+                }
+            }
+            out += 1 + key.width;
+        }
+    }
+};
+
+struct SortingData : OperatorData
+{
+    Pipeline pipeline;
+    RowArena rows; ///< the buffered tuples
+    std::vector<const uint8_t*> buffer; ///< the rows of the buffered tuples in `rows`, in the order of insertion
+    StackMachine compute_keys; ///< computes the values of the keys of a tuple
+    NormalizedKeyEncoder encoder;
+    Tuple keys; ///< tuple used to hold the values of the keys
+    std::vector<uint8_t> normalized_keys; ///< the normalized keys of the buffered tuples, in the order of `buffer`
+
+    SortingData(const SortingOperator &op, const Schema &buffer_schema)
+        : pipeline(buffer_schema)
+        , rows(buffer_schema)
+        , compute_keys(buffer_schema)
+    {
+        std::vector<const Type*> key_types;
+        for (auto o : op.order_by()) {
+            auto ty = o.first.get().type();
+            compute_keys.emit(o.first.get(), 1);
+            compute_keys.emit_St_Tup(0, key_types.size(), ty);
+            compute_keys.emit_Pop();
+            encoder.add(ty, o.second);
+            key_types.push_back(ty);
+        }
+        keys = Tuple(std::move(key_types));
+    }
+
+    /** Buffers \p tuple and its normalized key. */
+    void append(Tuple &tuple) {
+        buffer.push_back(rows.append(tuple));
+        Tuple *args[] = { &keys, &tuple };
+        compute_keys(args);
+        const auto offset = normalized_keys.size();
+        normalized_keys.resize(offset + encoder.width());
+        encoder.encode(keys, &normalized_keys[offset]);
+    }
+
+    /** Appends the tuples buffered by \p other, a worker of a parallel scan. */
+    void merge(SortingData &other) {
+        rows.adopt(other.rows);
+        buffer.insert(buffer.end(), other.buffer.begin(), other.buffer.end());
+        normalized_keys.insert(normalized_keys.end(), other.normalized_keys.begin(), other.normalized_keys.end());
+    }
+};
+
+/** Orders the clauses of a conjunctive filter, which is evaluated clause-at-a-time on entire `Block`s, by the pass
+ * rates of the clauses observed at runtime.  Every `REORDER_INTERVAL` blocks, the clauses are sorted by ascending pass
+ * rate, such that the most selective clause is evaluated first.  Afterwards, the observed counts are halved, such that
+ * the order follows drifting data. */
+struct ClauseOrder
+{
+    ///> the number of blocks after which the clauses are reordered
+    static constexpr std::size_t REORDER_INTERVAL = 16;
+
+    private:
+    ///> the indices of the clauses in evaluation order
+    std::vector<std::size_t> order_;
+    ///> the number of tuples received and passed by each clause
+    std::vector<std::pair<uint64_t, uint64_t>> counts_;
+    ///> the number of blocks filtered so far
+    std::size_t num_blocks_ = 0;
+
+    public:
+    ClauseOrder(std::size_t num_clauses) : order_(num_clauses), counts_(num_clauses, { 0, 0 }) {
+        std::iota(order_.begin(), order_.end(), 0);
+    }
+
+    /** Returns the indices of the clauses in the order they should be evaluated. */
+    const std::vector<std::size_t> & order() const { return order_; }
+
+    /** Accounts that clause \p idx received \p num_in tuples of which \p num_out passed. */
+    void account(std::size_t idx, std::size_t num_in, std::size_t num_out) {
+        counts_[idx].first += num_in;
+        counts_[idx].second += num_out;
+    }
+
+    /** Signals that a block was filtered entirely.  Reorders the clauses every `REORDER_INTERVAL` blocks. */
+    void next_block() {
+        if (++num_blocks_ % REORDER_INTERVAL != 0)
+            return;
+        /* Smooth the pass rates s.t. clauses that have not received any tuples yet are ranked neutrally. */
+        auto pass_rate = [this](std::size_t idx) {
+            return (counts_[idx].second + 1.) / (counts_[idx].first + 2.);
+        };
+        std::stable_sort(order_.begin(), order_.end(), [&](std::size_t lhs, std::size_t rhs) {
+            return pass_rate(lhs) < pass_rate(rhs);
+        });
+        for (auto &[num_in, num_out] : counts_) {
+            num_in /= 2;
+            num_out /= 2;
+        }
+    }
+};
+
+/** Evaluates a conjunction of disjunctions of comparisons of an attribute with a constant column-at-a-time on an
+ * entire `Block`.  The mask of alive tuples of the block serves as selection vector, which each clause refines in a
+ * tight loop over the respective attributes, i.e. without interpreting a `StackMachine` per tuple. */
+struct VectorizedFilter
+{
+    private:
+    struct comparison
+    {
+        std::size_t attr_idx; ///< the index of the compared attribute in the pipeline schema
+        TokenType cmp; ///< the comparison operator, with the attribute as left-hand side
+        Value constant; ///< the constant the attribute is compared to
+        bool is_double; ///< whether the attribute and the constant are compared as `double`s or as integers
+    };
+    ///> a clause of the filter, i.e. a disjunction of comparisons
+    using clause_type = std::vector<comparison>;
+
+    std::vector<clause_type> clauses_;
+    ///> the adaptive order of the clauses, if enabled
+    std::optional<ClauseOrder> order_;
+
+    VectorizedFilter() = default;
+
+    public:
+    /** Returns a `VectorizedFilter` for `cnf` evaluated on tuples of `Schema` `schema`, if every literal of `cnf` is
+     * a comparison of an integral, `double`, date, or datetime attribute with a constant of the same kind.  Returns
+     * `std::nullopt` otherwise. */
+    static std::optional<VectorizedFilter> Create(const cnf::CNF &cnf, const Schema &schema) {
+        VectorizedFilter VF;
+        for (auto &clause : cnf) {
+            clause_type &comparisons = VF.clauses_.emplace_back();
+            for (auto &pred : clause) {
+                auto c = Create_Comparison(pred, schema);
+                if (not c)
+                    return std::nullopt;
+                comparisons.push_back(std::move(*c));
+            }
+        }
+        if (options::adaptive_filters and VF.clauses_.size() > 1)
+            VF.order_.emplace(VF.clauses_.size());
+        return VF;
+    }
+
+    /** Erases all tuples from `block` which do not satisfy this filter. */
+    template<std::size_t N>
+    void operator()(Block<N> &block) {
+        if (not order_) {
+            for (auto &clause : clauses_) {
+                if (block.empty())
+                    return;
+                evaluate(block, clause);
+            }
+            return;
+        }
+
+        for (auto idx : order_->order()) {
+            if (block.empty())
+                break;
+            const auto num_in = block.size();
+            evaluate(block, clauses_[idx]);
+            order_->account(idx, num_in, block.size());
+        }
+        order_->next_block();
+    }
+
+    private:
+    /** Returns the comparison of literal `pred` evaluated on tuples of `Schema` `schema`, with the attribute as
+     * left-hand side and the negation, if any, applied to the comparison operator.  Returns `std::nullopt` if `pred`
+     * is no comparison of an integral, `double`, date, or datetime attribute with a constant of the same kind. */
+    static std::optional<comparison> Create_Comparison(const cnf::Predicate &pred, const Schema &schema) {
+        auto binary = cast<const ast::BinaryExpr>(&pred.expr());
+        if (not binary)
+            return std::nullopt;
+
+        TokenType cmp = binary->op().type;
+        auto designator = cast<const ast::Designator>(binary->lhs.get());
+        auto constant = cast<const ast::Constant>(binary->rhs.get());
+        if (not designator or not constant) { // try with constant as left-hand side
+            designator = cast<const ast::Designator>(binary->rhs.get());
+            constant = cast<const ast::Constant>(binary->lhs.get());
+            switch (cmp) {
+                default:                                        break;
+                case TK_LESS:          cmp = TK_GREATER;        break;
+                case TK_LESS_EQUAL:    cmp = TK_GREATER_EQUAL;  break;
+                case TK_GREATER:       cmp = TK_LESS;           break;
+                case TK_GREATER_EQUAL: cmp = TK_LESS_EQUAL;     break;
+            }
+        }
+        if (not designator or not constant or constant->tok == TK_Null)
+            return std::nullopt;
+        switch (cmp) {
+            default:
+                return std::nullopt;
+            case TK_EQUAL:
+            case TK_BANG_EQUAL:
+            case TK_LESS:
+            case TK_LESS_EQUAL:
+            case TK_GREATER:
+            case TK_GREATER_EQUAL:
+                break;
+        }
+        if (pred.negative()) { // the negation of a comparison with NULL is NULL as well, i.e. not satisfied
+            switch (cmp) {
+                default: M_unreachable("invalid comparison");
+                case TK_EQUAL:         cmp = TK_BANG_EQUAL;     break;
+                case TK_BANG_EQUAL:    cmp = TK_EQUAL;          break;
+                case TK_LESS:          cmp = TK_GREATER_EQUAL;  break;
+                case TK_LESS_EQUAL:    cmp = TK_GREATER;        break;
+                case TK_GREATER:       cmp = TK_LESS_EQUAL;     break;
+                case TK_GREATER_EQUAL: cmp = TK_LESS;           break;
+            }
+        }
+
+        /* Only compare values of the same kind, s.t. no casts or scaling have to be applied. */
+        const Type *ty_attr = designator->type();
+        const Type *ty_constant = constant->type();
+        bool is_double;
+        if (ty_attr->is_integral() and ty_constant->is_integral())
+            is_double = false;
+        else if ((ty_attr->is_date() and ty_constant->is_date()) or
+                 (ty_attr->is_date_time() and ty_constant->is_date_time()))
+            is_double = false;
+        else if (ty_attr->is_double() and ty_constant->is_double())
+            is_double = true;
+        else
+            return std::nullopt;
+
+        auto it = schema.find({ designator->table_name.text, designator->attr_name.text.assert_not_none() });
+        if (it == schema.cend())
+            return std::nullopt;
+        return comparison{
+            .attr_idx = std::size_t(std::distance(schema.cbegin(), it)),
+            .cmp = cmp,
+            .constant = Interpreter::eval(*constant),
+            .is_double = is_double,
+        };
+    }
+
+    /** Refines the selection vector of `block` by the disjunction `clause`.  Each comparison after the first is only
+     * evaluated on the tuples not satisfying any of the previous ones. */
+    template<std::size_t N>
+    static void evaluate(Block<N> &block, const clause_type &clause) {
+        if (clause.size() == 1) {
+            evaluate(block, clause.front());
+            return;
+        }
+
+        const auto alive = block.mask();
+        typename Block<N>::mask_type satisfied{}, remaining = alive;
+        for (auto &c : clause) {
+            block.mask(remaining);
+            evaluate(block, c);
+            for (std::size_t i = 0; i != satisfied.size(); ++i) {
+                satisfied[i] |= block.mask()[i];
+                remaining[i] = alive[i] & ~satisfied[i];
+            }
+        }
+        block.mask(satisfied);
+    }
+
+    /** Refines the selection vector of `block` by comparison `c`. */
+    template<std::size_t N>
+    static void evaluate(Block<N> &block, const comparison &c) {
+        switch (c.cmp) {
+            default: M_unreachable("invalid comparison");
+            case TK_EQUAL:         refine(block, c, std::equal_to<>());      break;
+            case TK_BANG_EQUAL:    refine(block, c, std::not_equal_to<>());  break;
+            case TK_LESS:          refine(block, c, std::less<>());          break;
+            case TK_LESS_EQUAL:    refine(block, c, std::less_equal<>());    break;
+            case TK_GREATER:       refine(block, c, std::greater<>());       break;
+            case TK_GREATER_EQUAL: refine(block, c, std::greater_equal<>()); break;
+        }
+    }
+
+    /** Refines the selection vector of `block` by comparison `c`, evaluated with `cmp`. */
+    template<std::size_t N, typename Cmp>
+    static void refine(Block<N> &block, const comparison &c, Cmp cmp) {
+        auto compare_all = [&]<typename T>(T constant) {
+            for (auto it = block.begin(); it != block.end(); ++it) {
+                const Tuple &t = *it;
+                const bool satisfied = not t.is_null(c.attr_idx) and [&]() {
+                    if constexpr (std::is_same_v<T, double>)
+                        return cmp(t[c.attr_idx].as_d(), constant);
+                    else
+                        return cmp(t[c.attr_idx].as_i(), constant);
+                }();
+                if (not satisfied)
+                    block.erase(it); // deselect tuple
+            }
+        };
+        if (c.is_double)
+            compare_all(c.constant.as_d());
+        else
+            compare_all(c.constant.as_i());
+    }
+};
+
+struct FilterData : OperatorData
+{
+    StackMachine filter;
+    Tuple res;
+    ///> the column-at-a-time evaluation of the filter, if applicable
+    std::optional<VectorizedFilter> vectorized;
+    ///> the clauses of the filter compiled separately, if they are reordered adaptively and not vectorized
+    std::vector<StackMachine> clauses;
+    ///> the adaptive order of `clauses`
+    std::optional<ClauseOrder> order;
 
     FilterData(const FilterOperator &op, const Schema &pipeline_schema)
         : filter(pipeline_schema)
         , res({ Type::Get_Boolean(Type::TY_Vector) })
+        , vectorized(VectorizedFilter::Create(op.filter(), pipeline_schema))
     {
         filter.emit(op.filter(), 1);
         filter.emit_St_Tup_b(0, 0);
+
+        if (options::adaptive_filters and not vectorized and op.filter().size() > 1) {
+            for (const cnf::Clause &clause : op.filter()) {
+                cnf::CNF cnf({ clause });
+                StackMachine &SM = clauses.emplace_back(pipeline_schema);
+                SM.emit(cnf, 1); // compile single clause
+                SM.emit_St_Tup_b(0, 0);
+            }
+            order.emplace(clauses.size());
+        }
     }
 };
 
@@ -896,37 +2167,74 @@ struct DisjunctiveFilterData : OperatorData
  * Pipeline
  *====================================================================================================================*/
 
-void Pipeline::operator()(const ScanOperator &op)
+std::size_t Pipeline::Block_Capacity() { return options::block_capacity; }
+
+std::size_t Pipeline::block_fill_size() const
 {
-    auto &store = op.store();
-    auto &table = store.table();
-    const auto num_rows = store.num_rows();
+    if (not options::adaptive_block_size)
+        return block_.capacity();
+
+    /* Choose the largest power of two s.t. the tuples of a block fit into the L1 cache, but at least 64 tuples. */
+    constexpr std::size_t L1_CACHE_SIZE = 32 * 1024; // 32 KiB
+    const std::size_t bytes_per_tuple = sizeof(Tuple) + std::max<std::size_t>(1, schema().num_entries()) * sizeof(Value);
+    std::size_t block_size = 64;
+    while (2 * block_size * bytes_per_tuple <= L1_CACHE_SIZE and 2 * block_size <= block_.capacity())
+        block_size *= 2;
+    return std::min(block_size, block_.capacity());
+}
 
-    /* Compile StackMachine to load tuples from store. */
-    auto loader = Interpreter::compile_load(op.schema(), store.memory().addr(), table.layout(), table.schema());
+void Pipeline::operator()(const ScanOperator &op) { scan(op, 0, op.store().num_rows()); }
 
-    const auto remainder = num_rows % block_.capacity();
+void Pipeline::scan(const ScanOperator &op, std::size_t begin, std::size_t end)
+{
+    auto &store = op.store();
+    auto &table = store.table();
+    const auto num_rows = end - begin;
+
+    /* Compile StackMachine to load tuples from store.  Omit the NULL bits of columns without NULL. */
+    auto &C = Catalog::Get();
+    const Schema layout_schema = C.has_database_in_use()
+                                 ? NullFreeColumns::Get().layout_schema(C.get_database_in_use().name, table)
+                                 : table.schema();
+    auto loader = Interpreter::compile_load(op.schema(), store.memory().addr(), table.layout(), layout_schema, begin);
+
+    const auto block_size = block_fill_size();
+    const auto remainder = num_rows % block_size;
+    /* Read the rows `StoreTiering::PREFETCH_DISTANCE` ahead of the current row, in steps of half the distance. */
+    const bool prefetch = StoreTiering::enabled();
+    std::size_t prefetched = begin; // rows before have been prefetched
+    auto prefetch_ahead = [&](std::size_t row) {
+        if (prefetch and prefetched < end and row + StoreTiering::PREFETCH_DISTANCE / 2 >= prefetched) {
+            const auto to = std::min(end, row + StoreTiering::PREFETCH_DISTANCE);
+            StoreTiering::prefetch(store, prefetched, to);
+            prefetched = to;
+        }
+    };
     std::size_t i = 0;
     /* Fill entire vector. */
-    for (auto end = num_rows - remainder; i != end; i += block_.capacity()) {
+    for (auto full_end = num_rows - remainder; i != full_end; i += block_size) {
+        QueryCancellation::Check();
+        prefetch_ahead(begin + i);
         block_.clear();
-        block_.fill();
-        for (std::size_t j = 0; j != block_.capacity(); ++j) {
+        block_.fill(block_size);
+        for (std::size_t j = 0; j != block_size; ++j) {
             Tuple *args[] = { &block_[j] };
             loader(args);
         }
-        op.parent()->accept(*this);
+        if (CardinalityFeedback::enabled()) CardinalityFeedback::count(op, block_size);
+        forward(op);
     }
     if (i != num_rows) {
         /* Fill last vector with remaining tuples. */
         block_.clear();
-        block_.mask((1UL << remainder) - 1);
-        for (std::size_t j = 0; i != op.store().num_rows(); ++i, ++j) {
-            M_insist(j < block_.capacity());
+        block_.fill(remainder);
+        for (std::size_t j = 0; i != num_rows; ++i, ++j) {
+            M_insist(j < block_size);
             Tuple *args[] = { &block_[j] };
             loader(args);
         }
-        op.parent()->accept(*this);
+        if (CardinalityFeedback::enabled()) CardinalityFeedback::count(op, remainder);
+        forward(op);
     }
 }
 
@@ -940,11 +2248,8 @@ void Pipeline::operator()(const PrintOperator &op)
 {
     auto data = as<PrintData>(op.data());
     data->num_rows += block_.size();
-    for (auto &t : block_) {
-        Tuple *args[] = { &t };
-        data->printer(args);
-        op.out << '\n';
-    }
+    for (auto &t : block_)
+        data->writer.write(t);
 }
 
 void Pipeline::operator()(const NoOpOperator &op)
@@ -954,25 +2259,45 @@ void Pipeline::operator()(const NoOpOperator &op)
 
 void Pipeline::operator()(const FilterOperator &op)
 {
-    if (not op.data())
-        op.data(new FilterData(op, this->schema()));
-
-    auto data = as<FilterData>(op.data());
-    for (auto it = block_.begin(); it != block_.end(); ++it) {
-        Tuple *args[] = { &data->res, &*it };
-        data->filter(args);
-        if (data->res.is_null(0) or not data->res[0].as_b()) block_.erase(it);
+    if (not op_data(op))
+        op_data(op, new FilterData(op, this->schema()));
+
+    auto data = as<FilterData>(op_data(op));
+    if (data->vectorized) {
+        (*data->vectorized)(block_);
+    } else if (data->order) {
+        /* Evaluate the filter clause-at-a-time in the order of the observed pass rates. */
+        for (auto idx : data->order->order()) {
+            if (block_.empty())
+                break;
+            const auto num_in = block_.size();
+            auto &clause = data->clauses[idx];
+            for (auto it = block_.begin(); it != block_.end(); ++it) {
+                Tuple *args[] = { &data->res, &*it };
+                clause(args);
+                if (data->res.is_null(0) or not data->res[0].as_b()) block_.erase(it);
+            }
+            data->order->account(idx, num_in, block_.size());
+        }
+        data->order->next_block();
+    } else {
+        for (auto it = block_.begin(); it != block_.end(); ++it) {
+            Tuple *args[] = { &data->res, &*it };
+            data->filter(args);
+            if (data->res.is_null(0) or not data->res[0].as_b()) block_.erase(it);
+        }
     }
+    if (CardinalityFeedback::enabled()) CardinalityFeedback::count(op, block_.size());
     if (not block_.empty())
-        op.parent()->accept(*this);
+        forward(op);
 }
 
 void Pipeline::operator()(const DisjunctiveFilterOperator &op)
 {
-    if (not op.data())
-        op.data(new DisjunctiveFilterData(op, this->schema()));
+    if (not op_data(op))
+        op_data(op, new DisjunctiveFilterData(op, this->schema()));
 
-    auto data = as<DisjunctiveFilterData>(op.data());
+    auto data = as<DisjunctiveFilterData>(op_data(op));
     for (auto it = block_.begin(); it != block_.end(); ++it) {
         data->res.set(0, false); // reset
         Tuple *args[] = { &data->res, &*it };
@@ -985,60 +2310,84 @@ void Pipeline::operator()(const DisjunctiveFilterOperator &op)
         block_.erase(it); // no predicate was satisfied ⇒ drop tuple
 satisfied:;
     }
+    if (CardinalityFeedback::enabled()) CardinalityFeedback::count(op, block_.size());
     if (not block_.empty())
-        op.parent()->accept(*this);
+        forward(op);
 }
 
 void Pipeline::operator()(const JoinOperator &op)
 {
-    if (is<SimpleHashJoinData>(op.data())) {
+    if (worker_data_ and not op_data(op))
+        op_data(op, new SimpleHashJoinData(op)); // a worker of a parallel scan builds its own hash table
+
+    if (is<MultiwayJoinData>(op_data(op))) {
+        /* Collect the tuples of the active child in a buffer, the multi-way join is performed once all children are
+         * buffered. */
+        auto data = as<MultiwayJoinData>(op.data());
+        const auto &tuple_schema = op.child(data->active_child)->schema();
+        if (data->buffer_schemas.size() <= data->active_child)
+            data->compile_child(op, this->schema());
+        for (auto &t : block_)
+            data->buffers[data->active_child].emplace_back(t.clone(tuple_schema));
+    } else if (is<SimpleHashJoinData>(op_data(op))) {
         /* Perform simple hash join. */
-        auto data = as<SimpleHashJoinData>(op.data());
+        auto data = as<SimpleHashJoinData>(op_data(op));
         Tuple *args[2] = { &data->key, nullptr };
         if (data->is_probe_phase) {
-            if (data->load_attrs.size() != 2) {
+            if (data->probe_key.num_ops() == 0) {
                 data->load_probe_key(this->schema());
                 data->emit_load_attrs(this->schema());
             }
             auto &pipeline = data->pipeline;
-            std::size_t i = 0;
+            const bool feedback = CardinalityFeedback::enabled();
+            if (feedback) CardinalityFeedback::count(op, 0); // the probe side is executed, even if nothing matches
+
+            /* Compute the keys of all tuples of the block first, then probe the hash table with all keys at once. */
+            while (data->probe_keys.size() < block_.capacity())
+                data->probe_keys.emplace_back(data->key_schema);
+            data->probe_tuples.resize(block_.capacity());
+            std::size_t num_keys = 0;
             for (auto &t : block_) {
-                args[1] = &t;
-                data->probe_key(args);
-                pipeline.block_.fill();
-                data->ht.for_all(*args[0], [&](std::pair<const Tuple, Tuple> &v) {
-                    if (i == pipeline.block_.capacity()) {
-                        pipeline.push(*op.parent());
-                        i = 0;
-                    }
-
-                    {
-                        Tuple *load_args[2] = { &pipeline.block_[i], &v.second };
-                        data->load_attrs[0](load_args); // load build attrs
-                    }
-                    {
-                        Tuple *load_args[2] = { &pipeline.block_[i], &t };
-                        data->load_attrs[1](load_args); // load probe attrs
-                    }
-                    ++i;
-                });
+                Tuple *key_args[] = { &data->probe_keys[num_keys], &t };
+                data->probe_key(key_args);
+                if (not data->in_build_key_range(data->probe_keys[num_keys]))
+                    continue; // drop probe tuple without join partner before probing the hash table
+                data->probe_tuples[num_keys++] = &t;
             }
 
+            std::size_t i = 0;
+            pipeline.block_.fill();
+            data->ht.for_all(data->probe_keys.data(), num_keys, [&](std::size_t k, auto &v) {
+                if (i == pipeline.block_.capacity()) {
+                    if (feedback) CardinalityFeedback::count(op, i);
+                    pipeline.push(*op.parent());
+                    pipeline.block_.fill();
+                    i = 0;
+                }
+
+                data->build_rows.load(v.second, pipeline.block_[i], data->build_attrs); // load build attrs
+                {
+                    Tuple *load_args[2] = { &pipeline.block_[i], data->probe_tuples[k] };
+                    data->load_attrs[0](load_args); // load probe attrs
+                }
+                ++i;
+            });
+
             if (i != 0) {
                 M_insist(i <= pipeline.block_.capacity());
-                pipeline.block_.mask(i == pipeline.block_.capacity() ? -1UL : (1UL << i) - 1);
+                pipeline.block_.fill(i);
+                if (feedback) CardinalityFeedback::count(op, i);
                 pipeline.push(*op.parent());
             }
         } else {
-            if (data->load_attrs.size() != 1) {
+            if (data->build_key.num_ops() == 0)
                 data->load_build_key(this->schema());
-                data->emit_load_attrs(this->schema());
-            }
-            const auto &tuple_schema = op.child(0)->schema();
             for (auto &t : block_) {
                 args[1] = &t;
                 data->build_key(args);
-                data->ht.insert_with_duplicates(args[0]->clone(data->key_schema), t.clone(tuple_schema));
+                if (data->track_key_range and not data->key.is_null(0))
+                    data->extend_build_key_range(data->key[0].as_i());
+                data->ht.insert_with_duplicates(args[0]->clone(data->key_schema), data->build_rows.append(t));
             }
         }
     } else {
@@ -1074,6 +2423,7 @@ void Pipeline::operator()(const JoinOperator &op)
 
             for (;;) {
                 if (child_id == size - 1) { // right-most child, which produced the RHS `block_`
+                    QueryCancellation::Check(); // a Cartesian product may run for a long time
                     /* Combine the tuples.  One tuple from each buffer. */
                     pipeline.clear();
                     pipeline.block_.mask(block_.mask());
@@ -1107,6 +2457,8 @@ void Pipeline::operator()(const JoinOperator &op)
                         }
                     }
 
+                    if (CardinalityFeedback::enabled())
+                        CardinalityFeedback::count(op, pipeline.block_.size());
                     if (not pipeline.block_.empty())
                         pipeline.push(*op.parent());
                     --child_id;
@@ -1140,8 +2492,14 @@ void Pipeline::operator()(const JoinOperator &op)
 
 void Pipeline::operator()(const ProjectionOperator &op)
 {
-    auto data = as<ProjectionData>(op.data());
+    if (not op_data(op))
+        op_data(op, new ProjectionData(op));
+
+    auto data = as<ProjectionData>(op_data(op));
     auto &pipeline = data->pipeline;
+    pipeline.worker_data_ = worker_data_;
+    pipeline.exchange_point_ = exchange_point_;
+    pipeline.exchange_ = exchange_;
     if (not data->projections)
         data->emit_projections(this->schema(), op);
 
@@ -1154,7 +2512,7 @@ void Pipeline::operator()(const ProjectionOperator &op)
         (*data->projections)(args);
     }
 
-    pipeline.push(*op.parent());
+    pipeline.forward(op);
 }
 
 void Pipeline::operator()(const LimitOperator &op)
@@ -1189,102 +2547,16 @@ void Pipeline::operator()(const GroupingOperator &op)
             auto &aggregate_arguments = data.args[i];
             Tuple *args[] = { &aggregate_arguments, &tuple };
             data.compute_aggregate_arguments[i](args);
-
-            bool is_null = group.is_null(key_size + i);
-            auto &val = group[key_size + i];
-
-            auto &fe = as<const ast::FnApplicationExpr>(op.aggregates()[i].get());
-            auto ty = fe.type();
-            auto &fn = fe.get_function();
-
-            switch (fn.fnid) {
-                default:
-                    M_unreachable("function kind not implemented");
-
-                case Function::FN_UDF:
-                    M_unreachable("UDFs not yet supported");
-
-                case Function::FN_COUNT:
-                    if (is_null)
-                        group.set(key_size + i, 0); // initialize
-                    if (fe.args.size() == 0) { // COUNT(*)
-                        val.as_i() += 1;
-                    } else { // COUNT(x) aka. count not NULL
-                        val.as_i() += not aggregate_arguments.is_null(0);
-                    }
-                    break;
-
-                case Function::FN_SUM: {
-                    auto n = as<const Numeric>(ty);
-                    if (is_null) {
-                        if (n->is_floating_point())
-                            group.set(key_size + i, 0.); // double precision
-                        else
-                            group.set(key_size + i, 0); // int
-                    }
-                    if (aggregate_arguments.is_null(0)) continue; // skip NULL
-                    if (n->is_floating_point())
-                        val.as_d() += aggregate_arguments[0].as_d();
-                    else
-                        val.as_i() += aggregate_arguments[0].as_i();
-                    break;
-                }
-
-                case Function::FN_AVG: {
-                    if (is_null) {
-                        if (ty->is_floating_point())
-                            group.set(key_size + i, 0.); // double precision
-                        else
-                            group.set(key_size + i, 0); // int
-                    }
-                    if (aggregate_arguments.is_null(0)) continue; // skip NULL
-                    /* Compute AVG as iterative mean as described in Knuth, The Art of Computer Programming Vol 2,
-                     * section 4.2.2. */
-                    val.as_d() += (aggregate_arguments[0].as_d() - val.as_d()) / nth_tuple;
-                    break;
-                }
-
-                case Function::FN_MIN: {
-                    using std::min;
-                    if (aggregate_arguments.is_null(0)) continue; // skip NULL
-                    if (is_null) {
-                        group.set(key_size + i, aggregate_arguments[0]);
-                        continue;
-                    }
-
-                    auto n = as<const Numeric>(ty);
-                    if (n->is_float())
-                        val.as_f() = min(val.as_f(), aggregate_arguments[0].as_f());
-                    else if (n->is_double())
-                        val.as_d() = min(val.as_d(), aggregate_arguments[0].as_d());
-                    else
-                        val.as_i() = min(val.as_i(), aggregate_arguments[0].as_i());
-                    break;
-                }
-
-                case Function::FN_MAX: {
-                    using std::max;
-                    if (aggregate_arguments.is_null(0)) continue; // skip NULL
-                    if (is_null) {
-                        group.set(key_size + i, aggregate_arguments[0]);
-                        continue;
-                    }
-
-                    auto n = as<const Numeric>(ty);
-                    if (n->is_float())
-                        val.as_f() = max(val.as_f(), aggregate_arguments[0].as_f());
-                    else if (n->is_double())
-                        val.as_d() = max(val.as_d(), aggregate_arguments[0].as_d());
-                    else
-                        val.as_i() = max(val.as_i(), aggregate_arguments[0].as_i());
-                    break;
-                }
-            }
+            Interpreter::update_aggregate(as<const ast::FnApplicationExpr>(op.aggregates()[i].get()), group,
+                                          key_size + i, aggregate_arguments, nth_tuple);
         }
     };
 
     /* Find the group. */
-    auto data = as<HashBasedGroupingData>(op.data());
+    if (not op_data(op))
+        op_data(op, new HashBasedGroupingData(op));
+
+    auto data = as<HashBasedGroupingData>(op_data(op));
     auto &groups = data->groups;
 
     Tuple key(op.schema());
@@ -1304,7 +2576,10 @@ void Pipeline::operator()(const GroupingOperator &op)
 
 void Pipeline::operator()(const AggregationOperator &op)
 {
-    auto data = as<AggregationData>(op.data());
+    if (not op_data(op))
+        op_data(op, new AggregationData(op));
+
+    auto data = as<AggregationData>(op_data(op));
     auto &nth_tuple = data->aggregates[op.schema().num_entries()].as_i();
 
     for (auto &tuple : block_) {
@@ -1396,13 +2671,13 @@ void Pipeline::operator()(const AggregationOperator &op)
 
 void Pipeline::operator()(const SortingOperator &op)
 {
-    if (not op.data())
-        op.data(new SortingData(this->schema()));
+    if (not op_data(op))
+        op_data(op, new SortingData(op, this->schema()));
 
     /* cache all tuples for sorting */
-    auto data = as<SortingData>(op.data());
+    auto data = as<SortingData>(op_data(op));
     for (auto &t : block_)
-        data->buffer.emplace_back(t.clone(this->schema()));
+        data->append(t);
 }
 
 /*======================================================================================================================
@@ -1418,7 +2693,9 @@ void Interpreter::operator()(const PrintOperator &op)
 {
     op.data(new PrintData(op));
     op.child(0)->accept(*this);
-    if (not Options::Get().quiet)
+    auto &writer = as<PrintData>(op.data())->writer;
+    writer.flush();
+    if (not Options::Get().quiet and ResultWriter::Is_Textual(writer.format()))
         op.out << as<PrintData>(op.data())->num_rows << " rows\n";
 }
 
@@ -1429,10 +2706,227 @@ void Interpreter::operator()(const NoOpOperator &op)
     op.out << as<NoOpData>(op.data())->num_rows << " rows\n";
 }
 
+namespace {
+
+/** The minimum number of rows scanned by each worker of a parallel scan. */
+constexpr std::size_t MIN_ROWS_PER_SCAN_WORKER = 1UL << 16;
+
+/** Returns the operator that ends the pipeline starting at \p scan if the pipeline can be executed by multiple workers,
+ * or `nullptr` otherwise.  Such a pipeline passes only filters and projections and ends in an aggregation, a grouping,
+ * a sorting, or the build phase of a simple hash join, s.t. the results of the workers can be merged. */
+const Operator * parallel_pipeline_end(const ScanOperator &scan)
+{
+    const Producer *current = &scan;
+    for (;;) {
+        const Consumer *parent = current->parent();
+        if (is<const FilterOperator>(parent) or is<const DisjunctiveFilterOperator>(parent) or
+            is<const ProjectionOperator>(parent))
+        {
+            current = as<const Producer>(parent);
+            continue;
+        }
+        if (is<const AggregationOperator>(parent) or is<const GroupingOperator>(parent) or
+            is<const SortingOperator>(parent))
+            return parent;
+        if (auto join = cast<const JoinOperator>(parent);
+            join and is<SimpleHashJoinData>(join->data()) and join->child(0) == current)
+            return parent;
+        return nullptr;
+    }
+}
+
+/** Returns the topmost filter or projection of the chain of filters and projections directly above \p scan, or
+ * `nullptr` if \p scan has no such parent.  The fragment from \p scan up to this operator is stateless, s.t. it can be
+ * executed by multiple producers of an `Exchange` whose consumer executes the remainder of the pipeline. */
+const Producer * exchange_point(const ScanOperator &scan)
+{
+    const Producer *current = &scan;
+    while (is<const FilterOperator>(current->parent()) or is<const DisjunctiveFilterOperator>(current->parent()) or
+           is<const ProjectionOperator>(current->parent()))
+        current = as<const Producer>(current->parent());
+    return current == &scan ? nullptr : current;
+}
+
+/** Merges the `OperatorData` of \p end, the operator that ends a pipeline, of a worker of a parallel scan into the
+ * operator's own data. */
+void merge_worker_data(const Operator &end, Pipeline::worker_data_type &worker_data)
+{
+    auto it = worker_data.find(&end);
+    if (it == worker_data.end())
+        return; // the worker produced no tuples
+
+    if (auto op = cast<const AggregationOperator>(&end)) {
+        as<AggregationData>(op->data())->merge(as<AggregationData>(*it->second), *op);
+    } else if (auto op = cast<const GroupingOperator>(&end)) {
+        as<HashBasedGroupingData>(op->data())->merge(as<HashBasedGroupingData>(*it->second), *op);
+    } else if (auto op = cast<const SortingOperator>(&end)) {
+        if (not op->data()) {
+            op->data(it->second.release());
+            return;
+        }
+        as<SortingData>(op->data())->merge(as<SortingData>(*it->second));
+    } else {
+        if (as<SimpleHashJoinData>(end.data())->build_key.num_ops() == 0) {
+            /* The first worker produced no tuples and hence did not compile the build phase, adopt this worker's. */
+            M_insist(as<SimpleHashJoinData>(end.data())->ht.size() == 0);
+            end.data(it->second.release());
+            return;
+        }
+        auto data = as<SimpleHashJoinData>(end.data());
+        auto &other = as<SimpleHashJoinData>(*it->second);
+        data->ht.resize(std::ceil((data->ht.size() + other.ht.size()) / data->ht.max_load_factor()));
+        for (auto &entry : other.ht) {
+            auto &key = const_cast<Tuple&>(entry.first); // the worker's hash table is discarded afterwards
+            data->ht.insert_with_duplicates(std::move(key), entry.second);
+        }
+        data->build_rows.adopt(other.build_rows);
+        if (other.build_key_range) {
+            data->extend_build_key_range(other.build_key_range->first);
+            data->extend_build_key_range(other.build_key_range->second);
+        }
+    }
+}
+
+/** Returns the ranges of rows to read by \p scan if it starts the probe pipeline of a simple hash join which skips PAX
+ * blocks of \p scan by the range of its build keys, see `SimpleHashJoinData::compute_probe_scan_ranges()`, or
+ * `nullptr` otherwise. */
+const std::vector<std::pair<std::size_t, std::size_t>> * probe_scan_ranges(const ScanOperator &scan)
+{
+    const Producer *current = &scan;
+    for (;;) {
+        const Consumer *parent = current->parent();
+        if (is<const FilterOperator>(parent) or is<const DisjunctiveFilterOperator>(parent)) {
+            current = as<const Producer>(parent);
+            continue;
+        }
+        auto join = cast<const JoinOperator>(parent);
+        if (not join or join->child(1) != current)
+            return nullptr;
+        auto data = cast<SimpleHashJoinData>(join->data());
+        if (not data or not data->is_probe_phase or data->probe_scan != &scan)
+            return nullptr;
+        return &data->probe_scan_ranges;
+    }
+}
+
+}
+
 void Interpreter::operator()(const ScanOperator &op)
 {
-    Pipeline pipeline(op.schema());
-    pipeline.push(op);
+    if (auto ranges = probe_scan_ranges(op)) {
+        /* Read only the PAX blocks which may contain join partners of the simple hash join. */
+        Pipeline pipeline(op.schema());
+        for (auto [begin, end] : *ranges)
+            pipeline.scan(op, begin, end);
+        return;
+    }
+
+    if (StoreTiering::enabled())
+        StoreTiering::Get().scanned(op.store());
+
+    const auto num_rows = op.store().num_rows();
+    const auto end = parallel_pipeline_end(op);
+    const auto exchange_at = end ? nullptr : exchange_point(op);
+    const std::size_t num_workers = (end or exchange_at) and not CardinalityFeedback::enabled()
+                                    ? std::clamp<std::size_t>(num_rows / MIN_ROWS_PER_SCAN_WORKER, 1, options::num_threads)
+                                    : 1;
+
+    if (num_workers == 1) {
+        Pipeline pipeline(op.schema());
+        if (options::shared_scans and num_rows >= 2 * SharedScans::MORSEL_SIZE) {
+            /* Scan circularly, morsel by morsel, starting where a running scan of the store currently is. */
+            auto cursor = SharedScans::Get().attach(op.store(), num_rows);
+            cursor.for_each_morsel([&](std::size_t begin, std::size_t end) { pipeline.scan(op, begin, end); });
+        } else {
+            pipeline.push(op);
+        }
+        return;
+    }
+
+    auto cancellation = QueryCancellation::Current();
+
+    if (exchange_at) {
+        /* The pipeline ends in an operator whose data cannot be merged, e.g. a limit or the callback of the query.
+         * Execute the fragment from the scan up to the exchange point by one producer per range of rows and gather
+         * the produced tuples on this thread, which executes the remainder of the pipeline. */
+        Exchange<Tuple, E_RoundRobin> exchange(num_workers, /* num_consumers= */ 1, Pipeline::Block_Capacity());
+        std::vector<Pipeline::worker_data_type> worker_data(num_workers);
+        std::vector<std::exception_ptr> errors(num_workers);
+        auto run_producer = [&](std::size_t worker) {
+            QueryCancellation::Current(cancellation); // producers observe the cancellation of the query
+            auto producer = exchange.producer(worker);
+            const std::function<void(Pipeline&)> push = [&](Pipeline &pipeline) {
+                for (auto &t : pipeline.block_)
+                    producer.push(t.clone(pipeline.schema()));
+            };
+            Pipeline pipeline(op.schema());
+            pipeline.worker_data_ = &worker_data[worker];
+            pipeline.exchange_point_ = exchange_at;
+            pipeline.exchange_ = &push;
+            try {
+                pipeline.scan(op, num_rows * worker / num_workers, num_rows * (worker + 1) / num_workers);
+                producer.finish();
+            } catch (exchange_cancelled) {
+                /* the consumer stopped */
+            } catch (...) {
+                errors[worker] = std::current_exception();
+                exchange.cancel(); // stop the other producers and the consumer
+            }
+        };
+        std::vector<std::thread> threads;
+        for (std::size_t worker = 0; worker != num_workers; ++worker)
+            threads.emplace_back(run_producer, worker);
+
+        try {
+            Pipeline pipeline(exchange_at->schema());
+            while (auto batch = exchange.receive(0)) {
+                pipeline.clear();
+                pipeline.block_.fill(batch->size());
+                for (std::size_t i = 0; i != batch->size(); ++i)
+                    pipeline.block_[i] = std::move((*batch)[i]);
+                exchange_at->parent()->accept(pipeline);
+            }
+        } catch (...) {
+            /* The consumer stopped early, e.g. by a limit unwinding the stack.  Stop the producers before unwinding. */
+            exchange.cancel();
+            for (auto &thread : threads)
+                thread.join();
+            throw;
+        }
+        for (auto &thread : threads)
+            thread.join();
+        QueryCancellation::Check();
+        for (auto &error : errors) {
+            if (error)
+                std::rethrow_exception(error);
+        }
+        return;
+    }
+
+    /* Split the rows into one contiguous range per worker.  The first worker uses the operators' own data, every other
+     * worker its own data, which is merged into the operators' data afterwards.  Merging in the order of the ranges
+     * retains the order of tuples of a sorting.  The workers are run by the threads of the `WorkerPool`. */
+    std::vector<Pipeline::worker_data_type> worker_data(num_workers - 1);
+    WorkerPool::Get().parallel_for(num_workers, [&](std::size_t worker) {
+        auto previous = QueryCancellation::Current();
+        QueryCancellation::Current(cancellation); // workers observe the cancellation of the query
+        Pipeline pipeline(op.schema());
+        if (worker != 0)
+            pipeline.worker_data_ = &worker_data[worker - 1];
+        try {
+            pipeline.scan(op, num_rows * worker / num_workers, num_rows * (worker + 1) / num_workers);
+        } catch (query_cancelled) {
+            /* stop this worker, the cancellation is rethrown once all workers stopped */
+        } catch (...) {
+            QueryCancellation::Current(previous);
+            throw;
+        }
+        QueryCancellation::Current(previous); // the thread of the pool may run tasks of other queries next
+    }, num_workers);
+    QueryCancellation::Check();
+
+    for (auto &data : worker_data)
+        merge_worker_data(*end, data);
 }
 
 void Interpreter::operator()(const FilterOperator &op)
@@ -1447,16 +2941,83 @@ void Interpreter::operator()(const DisjunctiveFilterOperator &op)
 
 void Interpreter::operator()(const JoinOperator &op)
 {
-    if (op.predicate().is_equi()) {
+    if (auto equalities = MultiwayJoinData::Get_Equalities(op)) {
+        /* Perform worst-case optimal multi-way join. */
+        auto data = new MultiwayJoinData(op, *equalities);
+        op.data(data);
+        for (std::size_t i = 0, end = op.children().size(); i != end; ++i) {
+            data->active_child = i;
+            op.child(i)->accept(*this);
+            if (data->buffers[i].empty()) // no tuples produced
+                return;
+        }
+        data->build_tries();
+
+        auto &pipeline = data->pipeline;
+        const bool feedback = CardinalityFeedback::enabled();
+        if (feedback) CardinalityFeedback::count(op, 0); // the join is executed, even if nothing matches
+        const std::size_t num_children = op.children().size();
+        std::vector<Tuple*> predicate_args(num_children + 1, nullptr);
+        predicate_args[0] = &data->res;
+        std::vector<std::size_t> positions(num_children); // positions within the rows of each leaf
+        std::size_t i = 0;
+        pipeline.block_.fill();
+        data->for_each_match(0, [&]() {
+            /* Combine the tuples of the leaves of all children.  One tuple from each leaf. */
+            auto rows_of = [&](std::size_t child) -> auto & {
+                return data->tries[child].nodes[data->cursors[child]].rows;
+            };
+            std::fill(positions.begin(), positions.end(), 0);
+            for (;;) {
+                bool matches = true;
+                if (data->needs_predicate) {
+                    for (std::size_t c = 0; c != num_children; ++c)
+                        predicate_args[c + 1] = &data->buffers[c][rows_of(c)[positions[c]]];
+                    data->predicate(predicate_args.data()); // check attributes of a child bound to the same variable
+                    matches = not data->res.is_null(0) and data->res[0].as_b();
+                }
+                if (matches) {
+                    if (i == pipeline.block_.capacity()) {
+                        if (feedback) CardinalityFeedback::count(op, i);
+                        pipeline.push(*op.parent());
+                        pipeline.block_.fill();
+                        i = 0;
+                    }
+                    for (std::size_t c = 0; c != num_children; ++c) {
+                        Tuple *load_args[2] = { &pipeline.block_[i], &data->buffers[c][rows_of(c)[positions[c]]] };
+                        data->load_attrs[c](load_args);
+                    }
+                    ++i;
+                }
+
+                /* Advance to the next combination, like an odometer. */
+                std::size_t c = num_children;
+                while (c != 0 and ++positions[c - 1] == rows_of(c - 1).size())
+                    positions[--c] = 0;
+                if (c == 0)
+                    break;
+            }
+        });
+
+        if (i != 0) {
+            M_insist(i <= pipeline.block_.capacity());
+            pipeline.block_.fill(i);
+            if (feedback) CardinalityFeedback::count(op, i);
+            pipeline.push(*op.parent());
+        }
+    } else if (op.predicate().is_equi()) {
         /* Perform simple hash join. */
         auto data = new SimpleHashJoinData(op);
         op.data(data);
         if (op.has_info())
             data->ht.resize(op.info().estimated_cardinality);
         op.child(0)->accept(*this); // build HT on LHS
+        data = as<SimpleHashJoinData>(op.data()); // a parallel scan may have replaced the data
         if (data->ht.size() == 0) // no tuples produced
             return;
+        data->ht.finish_growing(); // probes search a single table
         data->is_probe_phase = true;
+        data->compute_probe_scan_ranges(op); // skip blocks of the probe input w/o keys in the range of the build keys
         op.child(1)->accept(*this); // probe HT with RHS
     } else {
         /* Perform nested-loops join. */
@@ -1483,7 +3044,7 @@ void Interpreter::operator()(const ProjectionOperator &op)
         op.child(0)->accept(*this);
     else {
         Pipeline pipeline;
-        pipeline.block_.mask(1); // evaluate the projection EXACTLY ONCE on an empty tuple
+        pipeline.block_.fill(1); // evaluate the projection EXACTLY ONCE on an empty tuple
         pipeline.push(op);
     }
 }
@@ -1507,19 +3068,20 @@ void Interpreter::operator()(const GroupingOperator &op)
     op.child(0)->accept(*this);
 
     const auto num_groups = data->groups.size();
-    const auto remainder = num_groups % data->pipeline.block_.capacity();
+    const auto block_size = data->pipeline.block_fill_size();
+    const auto remainder = num_groups % block_size;
     auto it = data->groups.begin();
-    for (std::size_t i = 0; i != num_groups - remainder; i += data->pipeline.block_.capacity()) {
+    for (std::size_t i = 0; i != num_groups - remainder; i += block_size) {
         data->pipeline.block_.clear();
-        data->pipeline.block_.fill();
-        for (std::size_t j = 0; j != data->pipeline.block_.capacity(); ++j) {
+        data->pipeline.block_.fill(block_size);
+        for (std::size_t j = 0; j != block_size; ++j) {
             auto node = data->groups.extract(it++);
             swap(data->pipeline.block_[j], node.key());
         }
         data->pipeline.push(parent);
     }
     data->pipeline.block_.clear();
-    data->pipeline.block_.mask((1UL << remainder) - 1UL);
+    data->pipeline.block_.fill(remainder);
     for (std::size_t i = 0; i != remainder; ++i) {
         auto node = data->groups.extract(it++);
         swap(data->pipeline.block_[i], node.key());
@@ -1532,52 +3094,11 @@ void Interpreter::operator()(const AggregationOperator &op)
     op.data(new AggregationData(op));
     auto data = as<AggregationData>(op.data());
 
-    /* Initialize aggregates. */
-    for (std::size_t i = 0, end = op.aggregates().size(); i != end; ++i) {
-        auto &fe = as<const ast::FnApplicationExpr>(op.aggregates()[i].get());
-        auto ty = fe.type();
-        auto &fn = fe.get_function();
-
-        switch (fn.fnid) {
-            default:
-                M_unreachable("function kind not implemented");
-
-            case Function::FN_UDF:
-                M_unreachable("UDFs not yet supported");
-
-            case Function::FN_COUNT:
-                data->aggregates.set(i, 0); // initialize
-                break;
-
-            case Function::FN_SUM: {
-                auto n = as<const Numeric>(ty);
-                if (n->is_floating_point())
-                    data->aggregates.set(i, 0.); // double precision
-                else
-                    data->aggregates.set(i, 0L); // int64
-                break;
-            }
-
-            case Function::FN_AVG: {
-                if (ty->is_floating_point())
-                    data->aggregates.set(i, 0.); // double precision
-                else
-                    data->aggregates.set(i, 0L); // int64
-                break;
-            }
-
-            case Function::FN_MIN:
-            case Function::FN_MAX: {
-                data->aggregates.null(i); // initialize to NULL
-                break;
-            }
-        }
-    }
     op.child(0)->accept(*this);
 
     using std::swap;
     data->pipeline.block_.clear();
-    data->pipeline.block_.mask(1UL);
+    data->pipeline.block_.fill(1);
     swap(data->pipeline.block_[0], data->aggregates);
     data->pipeline.push(*op.parent());
 }
@@ -1590,67 +3111,31 @@ void Interpreter::operator()(const SortingOperator &op)
     if (not data) // no tuples produced
         return;
 
-    const auto &orderings = op.order_by();
-
-    StackMachine comparator(data->pipeline.schema());
-    for (auto o : orderings) {
-        comparator.emit(o.first.get(), 1); // LHS
-        comparator.emit(o.first.get(), 2); // RHS
-
-        /* Emit comparison. */
-        auto ty = o.first.get().type();
-        visit(overloaded {
-            [&comparator](const Boolean&) { comparator.emit_Cmp_b(); },
-            [&comparator](const CharacterSequence&) { comparator.emit_Cmp_s(); },
-            [&comparator](const Numeric &n) {
-                switch (n.kind) {
-                    case Numeric::N_Int:
-                    case Numeric::N_Decimal:
-                        comparator.emit_Cmp_i();
-                        break;
-
-                    case Numeric::N_Float:
-                        if (n.size() <= 32)
-                            comparator.emit_Cmp_f();
-                        else
-                            comparator.emit_Cmp_d();
-                        break;
-                }
-            },
-            [&comparator](const Date&) { comparator.emit_Cmp_i(); },
-            [&comparator](const DateTime&) { comparator.emit_Cmp_i(); },
-            [](auto&&) { M_insist("invalid type"); }
-        }, *ty);
-
-        if (not o.second)
-            comparator.emit_Minus_i(); // sort descending
-        comparator.emit_St_Tup_i(0, 0);
-        comparator.emit_Stop_NZ();
-    }
-
-    Tuple res({ Type::Get_Integer(Type::TY_Vector, 4) });
-    std::sort(data->buffer.begin(), data->buffer.end(), [&](Tuple &first, Tuple &second) {
-        Tuple *args[] = { &res, &first, &second };
-        comparator(args);
-        M_insist(not res.is_null(0));
-        return res[0].as_i() < 0;
+    /* Sort the tuples by the normalized keys computed when buffering them. */
+    const auto num_tuples = data->buffer.size();
+    const auto width = data->encoder.width();
+    auto &normalized_keys = data->normalized_keys;
+    std::vector<std::size_t> order(num_tuples);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t first, std::size_t second) {
+        return std::memcmp(&normalized_keys[first * width], &normalized_keys[second * width], width) < 0;
     });
 
     auto &parent = *op.parent();
-    const auto num_tuples = data->buffer.size();
-    const auto remainder = num_tuples % data->pipeline.block_.capacity();
-    auto it = data->buffer.begin();
-    for (std::size_t i = 0; i != num_tuples - remainder; i += data->pipeline.block_.capacity()) {
+    const auto block_size = data->pipeline.block_fill_size();
+    const auto remainder = num_tuples % block_size;
+    auto it = order.begin();
+    for (std::size_t i = 0; i != num_tuples - remainder; i += block_size) {
         data->pipeline.block_.clear();
-        data->pipeline.block_.fill();
-        for (std::size_t j = 0; j != data->pipeline.block_.capacity(); ++j)
-            data->pipeline.block_[j] = std::move(*it++);
+        data->pipeline.block_.fill(block_size);
+        for (std::size_t j = 0; j != block_size; ++j)
+            data->rows.load(data->buffer[*it++], data->pipeline.block_[j]);
         data->pipeline.push(parent);
     }
     data->pipeline.block_.clear();
-    data->pipeline.block_.mask((1UL << remainder) - 1UL);
+    data->pipeline.block_.fill(remainder);
     for (std::size_t i = 0; i != remainder; ++i)
-        data->pipeline.block_[i] = std::move(*it++);
+        data->rows.load(data->buffer[*it++], data->pipeline.block_[i]);
     data->pipeline.push(parent);
 }
 
@@ -1659,4 +3144,66 @@ static void register_interpreter()
 {
     Catalog &C = Catalog::Get();
     C.register_backend<Interpreter>(C.pool("Interpreter"), "tuple-at-a-time Interpreter built with virtual stack machines");
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Interpreter",
+        /* short=       */ nullptr,
+        /* long=        */ "--interpreter-block-size",
+        /* description= */ "set the number of tuples per block of the Interpreter (at most 2048)",
+        /* callback=    */ [](std::size_t capacity){
+            if (capacity == 0 or capacity > Pipeline::MAX_BLOCK_CAPACITY) {
+                std::cerr << "warning: ignore invalid block size " << capacity << std::endl;
+                return;
+            }
+            options::block_capacity = capacity;
+        }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Interpreter",
+        /* short=       */ nullptr,
+        /* long=        */ "--interpreter-adaptive-block-size",
+        /* description= */ "fill blocks of the Interpreter only with as many tuples as fit into the L1 cache, but at least "
+                           "64 and at most the block size",
+        /* callback=    */ [](bool){ options::adaptive_block_size = true; }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Interpreter",
+        /* short=       */ nullptr,
+        /* long=        */ "--interpreter-adaptive-filters",
+        /* description= */ "evaluate conjunctive filters clause-at-a-time and reorder the clauses by their observed pass "
+                           "rates",
+        /* callback=    */ [](bool){ options::adaptive_filters = true; }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Interpreter",
+        /* short=       */ nullptr,
+        /* long=        */ "--interpreter-threads",
+        /* description= */ "set the maximum number of threads scanning a table in parallel, if the results of the "
+                           "threads can be merged or the filters and projections above the scan can be run by the "
+                           "threads (default 1)",
+        /* callback=    */ [](std::size_t num_threads){
+            if (num_threads == 0) {
+                std::cerr << "warning: ignore invalid number of threads " << num_threads << std::endl;
+                return;
+            }
+            options::num_threads = num_threads;
+        }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Interpreter",
+        /* short=       */ nullptr,
+        /* long=        */ "--interpreter-shared-scans",
+        /* description= */ "let scans of a table attach to running scans of the table by concurrent queries and scan "
+                           "circularly, s.t. the queries share the rows through the caches; rotates the order of rows",
+        /* callback=    */ [](bool){ options::shared_scans = true; }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Interpreter",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-constant-folding",
+        /* description= */ "disable evaluating constant expressions once at compile time and removing identity "
+                           "operations, e.g. `x * 1`, in both the Interpreter and the WebAssembly backends",
+        /* callback=    */ [](bool){ options::constant_folding = false; }
+    );
 }
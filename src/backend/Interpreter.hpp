@@ -2,6 +2,9 @@
 
 #include "backend/InterpreterOperator.hpp"
 #include "backend/StackMachine.hpp"
+#include "util/Date.hpp"
+#include <algorithm>
+#include <array>
 #include <cerrno>
 #include <ctime>
 #include <mutable/backend/Backend.hpp>
@@ -9,16 +12,25 @@
 #include <mutable/IR/Operator.hpp>
 #include <mutable/IR/Tuple.hpp>
 #include <mutable/util/macro.hpp>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <unordered_map>
 
 
 namespace m {
 
-/** A block of size `N` contains `N` tuples.  */
+/** A block of at most `N` tuples.  The actual capacity of a block is chosen when creating the block.  Which tuples of
+ * the block are *alive* is tracked by a bit mask of `NUM_WORDS` many 64-bit words, of which only the words covering the
+ * capacity are used. */
 template<std::size_t N>
 struct Block
 {
-    static constexpr std::size_t CAPACITY = N; ///< the capacity of a block
+    static constexpr std::size_t CAPACITY = N; ///< the maximal capacity of a block
+    static constexpr std::size_t NUM_WORDS = (N + 63) / 64; ///< the number of 64-bit words of the mask
+    static_assert(N > 0, "block must have a capacity");
+
+    using mask_type = std::array<uint64_t, NUM_WORDS>;
 
     private:
     template<bool C>
@@ -32,24 +44,40 @@ struct Block
 
         private:
         block_t &block_;
-        uint64_t mask_;
+        mask_type mask_; ///< the remaining alive tuples; only the first `block_.num_words_` words are initialized
+        ///> the index of the first non-zero word of `mask_`, or `block_.num_words_` if there is none
+        std::size_t word_;
 
         public:
-        the_iterator(block_t &vec, uint64_t mask) : block_(vec), mask_(mask) { }
+        struct end_tag { };
+
+        the_iterator(block_t &vec, const mask_type &mask) : block_(vec), word_(0) {
+            std::copy_n(mask.begin(), block_.num_words_, mask_.begin());
+            skip_zero_words();
+        }
+        the_iterator(block_t &vec, end_tag) : block_(vec), word_(vec.num_words_) { }
 
-        bool operator==(the_iterator other) {
+        bool operator==(const the_iterator &other) const {
             M_insist(&this->block_ == &other.block_);
-            return this->mask_ == other.mask_;
+            return this->word_ == other.word_ and
+                   (word_ == block_.num_words_ or this->mask_[word_] == other.mask_[word_]);
         }
-        bool operator!=(the_iterator other) { return not operator==(other); }
+        bool operator!=(const the_iterator &other) const { return not operator==(other); }
 
-        the_iterator & operator++() { mask_ = mask_ & (mask_ - 1UL); /* set lowest 1-bit to 0 */ return *this; }
+        the_iterator & operator++() {
+            mask_[word_] = mask_[word_] & (mask_[word_] - 1UL); /* set lowest 1-bit to 0 */
+            skip_zero_words();
+            return *this;
+        }
         the_iterator operator++(int) { the_iterator clone(*this); operator++(); return clone; }
 
-        std::size_t index() const { return __builtin_ctzl(mask_); }
+        std::size_t index() const { return 64 * word_ + __builtin_ctzl(mask_[word_]); }
 
         reference operator*() const { return block_[index()]; }
         pointer operator->() const { return &block_[index()]; }
+
+        private:
+        void skip_zero_words() { while (word_ != block_.num_words_ and mask_[word_] == 0UL) ++word_; }
     };
 
     public:
@@ -58,8 +86,9 @@ struct Block
 
     private:
     std::array<Tuple, N> data_; ///< an array of the tuples of this `Block`; some slots may be unused
-    uint64_t mask_ = 0x0; ///< a mast identifying which slots of `data_` are in use
-    static_assert(N <= 64, "maximum block size exceeded");
+    mask_type mask_{}; ///< a mask identifying which slots of `data_` are in use
+    std::size_t capacity_ = N; ///< the capacity of this `Block`, i.e. the number of usable slots of `data_`
+    std::size_t num_words_ = NUM_WORDS; ///< the number of words of `mask_` covering the capacity
     Schema schema_;
 
     public:
@@ -67,12 +96,15 @@ struct Block
     Block(const Block&) = delete;
     Block(Block&&) = delete;
 
-    /** Create a new `Block` with tuples of `Schema` `schema`. */
-    Block(Schema schema)
-        : schema_(std::move(schema))
+    /** Create a new `Block` with tuples of `Schema` `schema` and room for `capacity` tuples. */
+    Block(Schema schema, std::size_t capacity = N)
+        : capacity_(capacity)
+        , num_words_((capacity + 63) / 64)
+        , schema_(std::move(schema))
     {
-        for (auto &t : data_)
-            t = Tuple(schema_);
+        M_insist(capacity_ != 0 and capacity_ <= N, "invalid block capacity");
+        for (std::size_t i = 0; i != capacity_; ++i)
+            data_[i] = Tuple(schema_);
     }
 
     /** Return a pointer to the underlying array of tuples. */
@@ -83,21 +115,31 @@ struct Block
     const Schema & schema() const { return schema_; }
 
     /** Return the capacity of this `Block`. */
-    static constexpr std::size_t capacity() { return CAPACITY; }
+    std::size_t capacity() const { return capacity_; }
     /** Return the number of *alive* tuples in this `Block`. */
-    std::size_t size() const { return __builtin_popcountl(mask_); }
+    std::size_t size() const {
+        std::size_t size = 0;
+        for (std::size_t i = 0; i != num_words_; ++i)
+            size += __builtin_popcountl(mask_[i]);
+        return size;
+    }
 
     iterator begin() { return iterator(*this, mask_); }
-    iterator end()   { return iterator(*this, 0UL); }
+    iterator end()   { return iterator(*this, typename iterator::end_tag{}); }
     const_iterator begin() const { return const_iterator(*this, mask_); }
-    const_iterator end()   const { return const_iterator(*this, 0UL); }
+    const_iterator end()   const { return const_iterator(*this, typename const_iterator::end_tag{}); }
     const_iterator cbegin() const { return const_iterator(*this, mask_); }
-    const_iterator cend()   const { return const_iterator(*this, 0UL); }
+    const_iterator cend()   const { return const_iterator(*this, typename const_iterator::end_tag{}); }
 
     /** Returns an iterator to the tuple at index `index`. */
     iterator at(std::size_t index) {
         M_insist(index < capacity());
-        return iterator(*this, mask_ & (-1UL << index));
+        mask_type mask;
+        std::copy_n(mask_.begin(), num_words_, mask.begin());
+        for (std::size_t i = 0; i != index / 64; ++i)
+            mask[i] = 0UL;
+        mask[index / 64] &= -1UL << (index % 64);
+        return iterator(*this, mask);
     }
     /** Returns an iterator to the tuple at index `index`. */
     const_iterator at(std::size_t index) const { return const_cast<Block>(this)->at(index); }
@@ -105,20 +147,20 @@ struct Block
     /** Check whether the tuple at the given `index` is alive. */
     bool alive(std::size_t index) const {
         M_insist(index < capacity());
-        return mask_ & (1UL << index);
+        return mask_[index / 64] & (1UL << (index % 64));
     }
 
     /** Returns `true` iff the block has no *alive* tuples, i.e.\ `size() == 0`. */
-    bool empty() const { return size() == 0; }
+    bool empty() const {
+        for (std::size_t i = 0; i != num_words_; ++i)
+            if (mask_[i]) return false;
+        return true;
+    }
 
     /** Returns the bit mask that identifies which tuples of this `Block` are alive. */
-    uint64_t mask() const { return mask_; }
-    /** Returns the bit mask that identifies which tuples of this `Block` are alive. */
-    void mask(uint64_t new_mask) { mask_ = new_mask; }
-
-    private:
-    /** Returns a bit vector with left-most `capacity()` many bits set to `1` and the others set to `0`.  */
-    static constexpr uint64_t AllOnes() { return -1UL >> (8 * sizeof(mask_) - capacity()); }
+    const mask_type & mask() const { return mask_; }
+    /** Sets the bit mask that identifies which tuples of this `Block` are alive to \p new_mask. */
+    void mask(const mask_type &new_mask) { std::copy_n(new_mask.begin(), num_words_, mask_.begin()); }
 
     public:
     /** Returns the tuple at index `index`.  The tuple must be *alive*!  */
@@ -131,12 +173,25 @@ struct Block
     const Tuple & operator[](std::size_t index) const { return const_cast<Block*>(this)->operator[](index); }
 
     /** Make all tuples in this `Block` *alive*. */
-    void fill() { mask_ = AllOnes(); M_insist(size() == capacity()); }
+    void fill() { fill(capacity()); M_insist(size() == capacity()); }
+
+    /** Make the first `n` tuples in this `Block` *alive* and all others *dead*. */
+    void fill(std::size_t n) {
+        M_insist(n <= capacity(), "index out of bounds");
+        for (std::size_t i = 0; i != num_words_; ++i) {
+            if (64 * (i + 1) <= n)
+                mask_[i] = -1UL;
+            else if (64 * i < n)
+                mask_[i] = -1UL >> (64 - (n - 64 * i));
+            else
+                mask_[i] = 0UL;
+        }
+    }
 
     /** Erase the tuple at the given `index` from this `Block`. */
     void erase(std::size_t index) {
         M_insist(index < capacity(), "index out of bounds");
-        setbit(&mask_, false, index);
+        setbit(&mask_[index / 64], false, index % 64);
     }
     /** Erase the tuple identified by `it` from this `Block`. */
     void erase(iterator it) { erase(it.index()); }
@@ -145,9 +200,9 @@ struct Block
 
     /** Renders all tuples *dead* and removes their attributes.. */
     void clear() {
-        mask_ = 0;
-        for (auto &t : data_)
-            t.clear();
+        std::fill_n(mask_.begin(), num_words_, 0UL);
+        for (std::size_t i = 0; i != capacity_; ++i)
+            data_[i].clear();
     }
 
 M_LCOV_EXCL_START
@@ -181,34 +236,82 @@ struct Pipeline : ConstOperatorVisitor
 {
     friend struct Interpreter;
 
+    /** The maximal capacity of the `Block` of a `Pipeline`. */
+    static constexpr std::size_t MAX_BLOCK_CAPACITY = 2048;
+
+    /** Maps operators to the `OperatorData` of one worker of a parallel scan. */
+    using worker_data_type = std::unordered_map<const Operator*, std::unique_ptr<OperatorData>>;
+
     private:
-    Block<64> block_;
+    Block<MAX_BLOCK_CAPACITY> block_;
+    /** The `OperatorData` of the operators of this pipeline if it is executed by a worker of a parallel scan, see
+     * `--interpreter-threads`, or `nullptr` if the operators' own data are used. */
+    worker_data_type *worker_data_ = nullptr;
+    /** The operator after which this pipeline passes its tuples to `exchange_` rather than to the operator's parent, if
+     * the pipeline is a fragment executed by a producer of an `Exchange`. */
+    const Producer *exchange_point_ = nullptr;
+    const std::function<void(Pipeline&)> *exchange_ = nullptr;
 
     public:
     Pipeline() { }
 
     Pipeline(const Schema &schema)
-        : block_(schema)
+        : block_(schema, Block_Capacity())
     {
-        block_.mask(1UL); // create one empty tuple in the block
+        block_.fill(1); // create one empty tuple in the block
     }
 
     Pipeline(Tuple &&t)
     {
-        block_.mask(1UL);
+        block_.fill(1);
         block_[0] = std::move(t);
     }
 
+    /** Returns the capacity of blocks of pipelines, as configured by the user. */
+    static std::size_t Block_Capacity();
+
+    /** Returns the number of tuples that sources of this pipeline, e.g. scans, put into a block.  Depending on the
+     * configuration, this is either the capacity of the block or chosen by the width of tuples of this pipeline, s.t.
+     * the alive tuples of a block fit into the L1 cache. */
+    std::size_t block_fill_size() const;
+
     void push(const Operator &pipeline_start) { (*this)(pipeline_start); }
 
     void clear() { block_.clear(); }
 
     const Schema & schema() const { return block_.schema(); }
 
+    /** Returns the `OperatorData` of \p op used by this pipeline, or `nullptr` if there is none yet. */
+    OperatorData * op_data(const Operator &op) const {
+        if (not worker_data_) return op.data();
+        auto it = worker_data_->find(&op);
+        return it == worker_data_->end() ? nullptr : it->second.get();
+    }
+    /** Sets the `OperatorData` of \p op used by this pipeline to \p data. */
+    void op_data(const Operator &op, OperatorData *data) const {
+        if (worker_data_)
+            (*worker_data_)[&op].reset(data);
+        else
+            op.data(data);
+    }
+
     using ConstOperatorVisitor::operator();
 #define DECLARE(CLASS) void operator()(Const<CLASS> &op) override;
     M_OPERATOR_LIST(DECLARE)
 #undef DECLARE
+
+    private:
+    /** Scans the rows in the range [\p begin, \p end) of the store of \p op and pushes them block-wise. */
+    void scan(const ScanOperator &op, std::size_t begin, std::size_t end);
+
+    /** Pushes the block of this pipeline, produced by \p op, to the parent of \p op or, if \p op is the exchange
+     * point, to the exchange. */
+    void forward(const Producer &op) {
+        if (&op == exchange_point_)
+            (*exchange_)(*this);
+        else
+            op.parent()->accept(*this);
+    }
 };
 
 /** Evaluates SQL operator trees on the database. */
@@ -267,7 +370,7 @@ struct Interpreter : Backend, ConstOperatorVisitor
                 int year, month, day;
                 if (3 != sscanf(*c.tok.text, "d'%d-%d-%d'", &year, &month, &day))
                     M_unreachable("invalid date");
-                return int32_t(unsigned(year) << 9 | month << 5 | day);
+                return date::encode(year, month, day);
             }
 
             /* Datetime */
@@ -310,6 +413,17 @@ struct Interpreter : Backend, ConstOperatorVisitor
         M_insist(errno == 0, "constant could not be parsed");
     }
 
+    /** Evaluates the constant expression \p e, i.e. an expression built from constants by operators and casts, once
+     * rather than per tuple.  Returns `std::nullopt` if \p e is a `Constant` itself or not constant, if evaluating \p e
+     * may trap, i.e. for integral division and modulo, or if \p e evaluates to NULL or to a string, which would not
+     * outlive the evaluation. */
+    static std::optional<Value> fold(const ast::Expr &e);
+
+    /** Returns the operand of \p e that \p e reduces to since the other operand is the integral identity element of
+     * the operation of \p e, e.g. `x` for `x * 1`, `x + 0`, or `x - 0`, provided the operand has the type of \p e.
+     * Returns `nullptr` otherwise. */
+    static const ast::Expr * identity_operand(const ast::BinaryExpr &e);
+
     /** Compile a `StackMachine` to load a tuple of `Schema` `tuple_schema` using a given memory address and a given
      * `DataLayout`.
      *
@@ -335,6 +449,17 @@ struct Interpreter : Backend, ConstOperatorVisitor
      */
     static StackMachine compile_store(const Schema &tuple_schema, void *address, const storage::DataLayout &layout,
                                       const Schema &layout_schema, std::size_t row_id = 0, std::size_t tuple_id = 0);
+
+    /** Adds a tuple to the aggregate \p fe of a group.
+     *
+     * @param fe        the aggregate function application
+     * @param group     the tuple of the group, holding the aggregate; a NULL aggregate is initialized
+     * @param idx       the index of the aggregate within \p group
+     * @param arguments the arguments of \p fe computed for the added tuple
+     * @param nth_tuple the number of tuples of the group, including the added tuple
+     */
+    static void update_aggregate(const ast::FnApplicationExpr &fe, Tuple &group, std::size_t idx,
+                                 const Tuple &arguments, std::size_t nth_tuple);
 };
 
 }
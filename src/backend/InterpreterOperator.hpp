@@ -1,5 +1,6 @@
 #pragma once
 
+#include "util/ObjectPool.hpp"
 #include <mutable/IR/PhysicalOptimizer.hpp>
 
 
@@ -14,8 +15,20 @@ struct ConstMatchBaseVisitor;
 /** An abstract `MatchBase` for the `Interpreter` backend.  Adds accept methods for respective visitor.  */
 struct MatchBase : m::MatchBase
 {
+    /** Since the physical optimizer creates a match for every candidate implementation, matches are allocated from a
+     * pool rather than by `malloc()`. */
+    static void * operator new(std::size_t size) { return pool().allocate(size); }
+    static void operator delete(void *ptr, std::size_t size) { pool().deallocate(ptr, size); }
+
     virtual void accept(MatchBaseVisitor &v) = 0;
     virtual void accept(ConstMatchBaseVisitor &v) const = 0;
+
+    private:
+    /** Returns the pool of all matches.  It is never destroyed since matches may outlive static objects. */
+    static ObjectPool & pool() {
+        static ObjectPool *the_pool = new ObjectPool();
+        return *the_pool;
+    }
 };
 
 }
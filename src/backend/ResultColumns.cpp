@@ -0,0 +1,207 @@
+#include "backend/ResultColumns.hpp"
+
+#include "backend/Interpreter.hpp"
+#include <algorithm>
+#include <cstring>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/util/fn.hpp>
+#include <mutable/util/macro.hpp>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+/*======================================================================================================================
+ * ResultColumns
+ *====================================================================================================================*/
+
+ResultColumns::ResultColumns(const Schema &schema)
+    : schema(schema)
+{
+    columns.resize(schema.num_entries());
+    for (std::size_t i = 0; i != schema.num_entries(); ++i) {
+        auto &type = *schema[i].type;
+        if (type.is_none())
+            columns[i].value_size = 0;
+        else if (type.is_boolean())
+            columns[i].value_size = 1;
+        else
+            columns[i].value_size = type.size() / 8;
+    }
+}
+
+void ResultColumns::resize(std::size_t num_tuples)
+{
+    this->num_tuples = num_tuples;
+    for (auto &column : columns) {
+        column.values.resize(num_tuples * column.value_size);
+        column.is_null.resize(num_tuples);
+    }
+}
+
+
+/*======================================================================================================================
+ * ResultSetDecoder
+ *====================================================================================================================*/
+
+ResultSetDecoder::ResultSetDecoder(const Schema &schema, const Schema &layout_schema, const DataLayout *layout,
+                                   const std::vector<const ast::Constant*> &constants)
+    : schema_(schema)
+    , leaves_(layout_schema.num_entries())
+{
+    M_insist(constants.size() == schema.num_entries(), "constants must be given for each schema entry");
+    M_insist(bool(layout) == (layout_schema.num_entries() != 0), "layout must be given iff result set is not empty");
+
+    /*----- Resolve the locations of all leaves and the NULL bitmap. -----*/
+    if (layout) {
+        layout->for_sibling_leaves([&](const std::vector<DataLayout::leaf_info_t> &leaves,
+                                       const DataLayout::level_info_stack_t &levels, uint64_t inode_offset_in_bits)
+        {
+            std::vector<level_t> path;
+            for (auto &level : levels) {
+                M_insist(level.num_tuples != 0, "INode must be large enough for at least one tuple");
+                path.push_back({ level.num_tuples, level.stride_in_bits });
+            }
+            for (auto &leaf_info : leaves) {
+                location_t location{ path, inode_offset_in_bits + leaf_info.offset_in_bits, leaf_info.stride_in_bits };
+                if (leaf_info.leaf.index() == layout_schema.num_entries())
+                    null_bitmap_ = std::move(location);
+                else
+                    leaves_[leaf_info.leaf.index()] = std::move(location);
+            }
+        });
+    }
+
+    /*----- Resolve the source of each entry, encoding constants once. -----*/
+    sources_.resize(schema.num_entries());
+    for (std::size_t i = 0; i != schema.num_entries(); ++i) {
+        auto &e = schema[i];
+        auto &source = sources_[i];
+        if (e.type->is_none())
+            continue; // NULL constant
+        if (auto c = constants[i]) {
+            auto value = Interpreter::eval(*c);
+            source.constant.resize(e.type->is_boolean() ? 1 : e.type->size() / 8);
+            uint8_t *dst = source.constant.data();
+            visit(overloaded {
+                [&](const Boolean&) { *dst = value.as_b(); },
+                [&](const Numeric &n) {
+                    switch (n.kind) {
+                        case Numeric::N_Int:
+                        case Numeric::N_Decimal: {
+                            const int64_t v = value.as_i();
+                            std::memcpy(dst, &v, source.constant.size()); // little endian, i.e. truncates
+                            break;
+                        }
+                        case Numeric::N_Float:
+                            if (n.size() <= 32) {
+                                const float v = value.as_f();
+                                std::memcpy(dst, &v, sizeof(v));
+                            } else {
+                                const double v = value.as_d();
+                                std::memcpy(dst, &v, sizeof(v));
+                            }
+                            break;
+                    }
+                },
+                [&](const CharacterSequence&) {
+                    std::strncpy(reinterpret_cast<char*>(dst), reinterpret_cast<char*>(value.as_p()),
+                                 source.constant.size());
+                },
+                [&](const Date&) {
+                    const int32_t date = value.as_i();
+                    std::memcpy(dst, &date, sizeof(date));
+                },
+                [&](const DateTime&) {
+                    const int64_t time = value.as_i();
+                    std::memcpy(dst, &time, sizeof(time));
+                },
+                [](auto&&) { M_unreachable("invalid type"); },
+            }, *e.type);
+        } else {
+            auto [layout_idx, layout_entry] = layout_schema[e.id];
+            M_insist(*layout_entry.type == *e.type);
+            M_insist(bool(leaves_[layout_idx]), "every result set entry must be contained in the layout");
+            source.layout_idx = layout_idx;
+        }
+    }
+}
+
+template<typename Fn>
+void ResultSetDecoder::for_each_run(const location_t &location, std::size_t first, std::size_t num_tuples, Fn &&fn)
+{
+    for (std::size_t i = 0; i != num_tuples; ) {
+        /*----- Compute the offset of the INode at the lowest level containing the tuple. -----*/
+        uint64_t id = first + i;
+        uint64_t offset_in_bits = location.offset_in_bits;
+        for (auto &level : location.levels) {
+            offset_in_bits += id / level.num_tuples * level.stride_in_bits;
+            id %= level.num_tuples;
+        }
+
+        /*----- The run extends to the end of that INode. -----*/
+        const std::size_t length = location.levels.empty()
+                                 ? num_tuples - i
+                                 : std::min<std::size_t>(num_tuples - i, location.levels.back().num_tuples - id);
+        fn(i, offset_in_bits + id * location.stride_in_bits, length);
+        i += length;
+    }
+}
+
+void ResultSetDecoder::decode(const uint8_t *data, std::size_t first, std::size_t num_tuples,
+                              ResultColumns &columns) const
+{
+    M_insist(&columns.schema == &schema_ or columns.schema == schema_, "columns must be of the result schema");
+    columns.resize(num_tuples);
+
+    for (std::size_t i = 0; i != schema_.num_entries(); ++i) {
+        auto &source = sources_[i];
+        auto &column = columns.columns[i];
+
+        if (not source.layout_idx) {
+            /*----- Replicate the constant, or mark all tuples NULL for the NULL constant. -----*/
+            std::fill(column.is_null.begin(), column.is_null.end(), source.constant.empty());
+            if (not source.constant.empty()) {
+                for (std::size_t j = 0; j != num_tuples; ++j)
+                    std::memcpy(column.values.data() + j * column.value_size, source.constant.data(),
+                                column.value_size);
+            }
+            continue;
+        }
+
+        /*----- Copy the values, run by run. -----*/
+        M_insist(data, "result set must be given if it contains non-constant entries");
+        auto &leaf = *leaves_[*source.layout_idx];
+        const std::size_t size = column.value_size;
+        const bool is_boolean = schema_[i].type->is_boolean();
+        for_each_run(leaf, first, num_tuples, [&](std::size_t j, uint64_t offset_in_bits, std::size_t length) {
+            uint8_t *dst = column.values.data() + j * size;
+            if (is_boolean) {
+                for (std::size_t k = 0; k != length; ++k, offset_in_bits += leaf.stride_in_bits)
+                    dst[k] = (data[offset_in_bits / 8] >> (offset_in_bits % 8)) & 0b1U;
+            } else if (leaf.stride_in_bits == 8 * size) {
+                M_insist(offset_in_bits % 8 == 0, "values must be byte aligned");
+                std::memcpy(dst, data + offset_in_bits / 8, length * size); // contiguous run
+            } else {
+                for (std::size_t k = 0; k != length; ++k, offset_in_bits += leaf.stride_in_bits) {
+                    M_insist(offset_in_bits % 8 == 0, "values must be byte aligned");
+                    std::memcpy(dst + k * size, data + offset_in_bits / 8, size);
+                }
+            }
+        });
+
+        /*----- Extract the NULL bits. -----*/
+        if (null_bitmap_) {
+            const uint64_t stride_in_bits = null_bitmap_->stride_in_bits;
+            for_each_run(*null_bitmap_, first, num_tuples, [&](std::size_t j, uint64_t offset_in_bits,
+                                                               std::size_t length) {
+                offset_in_bits += *source.layout_idx;
+                for (std::size_t k = 0; k != length; ++k, offset_in_bits += stride_in_bits)
+                    column.is_null[j + k] = (data[offset_in_bits / 8] >> (offset_in_bits % 8)) & 0b1U;
+            });
+        } else {
+            std::fill(column.is_null.begin(), column.is_null.end(), false);
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/storage/DataLayout.hpp>
+#include <optional>
+#include <vector>
+
+
+namespace m {
+
+namespace ast { struct Constant; }
+
+/** A batch of result tuples stored column-at-a-time, i.e. for each entry of the result `Schema` the packed values of
+ * all tuples and whether they are NULL.  Values are stored in native byte order: booleans as one byte, integers and
+ * decimals with their size, floats and doubles as IEEE 754, character sequences NUL-padded to their maximal length,
+ * and dates and datetimes as 32 and 64 bit integers in the encoding of `Tuple`s.  Values of NULL entries are
+ * unspecified.
+ *
+ * The buffers are provided by the caller and retain their capacity when the batch is refilled, s.t. decoding a result
+ * set batch by batch allocates only once. */
+struct ResultColumns
+{
+    struct Column
+    {
+        std::size_t value_size = 0; ///< the size of a single value in bytes; 0 for the NONE type
+        std::vector<uint8_t> values; ///< the values of all tuples, packed
+        std::vector<uint8_t> is_null; ///< for each tuple, whether its value is NULL
+
+        /** Returns the address of the value of the \p i-th tuple. */
+        const uint8_t * operator[](std::size_t i) const { return values.data() + i * value_size; }
+    };
+
+    const Schema &schema;
+    std::size_t num_tuples = 0;
+    std::vector<Column> columns; ///< one column per entry of `schema`
+
+    explicit ResultColumns(const Schema &schema);
+
+    /** Resizes all columns to \p num_tuples tuples. */
+    void resize(std::size_t num_tuples);
+};
+
+/** A callback receiving a result set batch by batch.  The columns are only valid until the callback returns. */
+using result_batch_callback_t = std::function<void(const ResultColumns&)>;
+
+/** Decodes a result set stored in a `DataLayout` into `ResultColumns`, one column at a time.  The layout is resolved
+ * once, when the decoder is created, and runs of values that are contiguous in the layout, e.g. the columns of a PAX
+ * block, are copied as a whole. */
+struct ResultSetDecoder
+{
+    private:
+    /** A level of INodes on the path from the root of the layout to a leaf. */
+    struct level_t
+    {
+        uint64_t num_tuples;
+        uint64_t stride_in_bits;
+    };
+
+    /** The location of the values of a leaf in the layout. */
+    struct location_t
+    {
+        std::vector<level_t> levels;
+        uint64_t offset_in_bits; ///< the offset of the leaf, including the offset of its parent INode
+        uint64_t stride_in_bits;
+    };
+
+    /** Where the values of an entry of the result schema come from. */
+    struct source_t
+    {
+        std::optional<std::size_t> layout_idx; ///< the index in the layout schema; none for constants
+        std::vector<uint8_t> constant; ///< the encoded value of a constant; empty for the NULL constant
+    };
+
+    const Schema &schema_;
+    std::vector<std::optional<location_t>> leaves_; ///< the locations of the entries of the layout schema
+    std::optional<location_t> null_bitmap_;
+    std::vector<source_t> sources_; ///< the sources of the entries of `schema_`
+
+    public:
+    /** Creates a decoder of result sets of the `Schema` \p schema stored in the `DataLayout` \p layout of \p
+     * layout_schema.  The tuples' non-constant entries are looked up in \p layout_schema by their identifier.  For each
+     * entry of \p schema, \p constants contains the `ast::Constant` of a constant entry and `nullptr` otherwise.  If \p
+     * schema contains only constants, \p layout must be `nullptr`. */
+    ResultSetDecoder(const Schema &schema, const Schema &layout_schema, const storage::DataLayout *layout,
+                     const std::vector<const ast::Constant*> &constants);
+
+    /** Decodes the \p num_tuples tuples starting at tuple \p first of the result set at \p data into \p columns, which
+     * must be of the result schema of this decoder. */
+    void decode(const uint8_t *data, std::size_t first, std::size_t num_tuples, ResultColumns &columns) const;
+
+    private:
+    /** Calls \p fn for each run of tuples in `[first, first + num_tuples)` within the same INode at the lowest level of
+     * \p location, with the index of the first tuple of the run relative to \p first, the offset of its value in bits,
+     * and the number of tuples of the run. */
+    template<typename Fn>
+    static void for_each_run(const location_t &location, std::size_t first, std::size_t num_tuples, Fn &&fn);
+};
+
+}
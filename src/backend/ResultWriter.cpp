@@ -0,0 +1,441 @@
+#include "backend/ResultWriter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/util/fn.hpp>
+#include <sstream>
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** The format in which results are written. */
+ResultWriter::format_t output_format = ResultWriter::F_CSV;
+
+}
+
+__attribute__((constructor(201)))
+static void add_result_writer_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<const char*>(
+        /* group=       */ "Output",
+        /* short=       */ nullptr,
+        /* long=        */ "--output-format",
+        /* description= */ "the format of printed results, one of csv (default), tsv, or binary",
+        /* callback=    */ [](const char *str) {
+            if (streq(str, "csv")) {
+                options::output_format = ResultWriter::F_CSV;
+            } else if (streq(str, "tsv")) {
+                options::output_format = ResultWriter::F_TSV;
+            } else if (streq(str, "binary")) {
+                options::output_format = ResultWriter::F_Binary;
+            } else {
+                std::cerr << "There is no output format with the name \"" << str << "\".\n";
+                std::exit(EXIT_FAILURE);
+            }
+        }
+    );
+}
+
+///> the decimal digits of all numbers from 0 to 99, two characters per number
+constexpr auto TWO_DIGITS = []() {
+    std::array<char, 200> digits{};
+    for (std::size_t i = 0; i != 100; ++i) {
+        digits[2 * i]     = char('0' + i / 10);
+        digits[2 * i + 1] = char('0' + i % 10);
+    }
+    return digits;
+}();
+
+///> the powers of ten representable as `int64_t`
+constexpr auto POWERS_OF_TEN = []() {
+    std::array<int64_t, 19> powers{};
+    int64_t power = 1;
+    for (auto &p : powers) {
+        p = power;
+        power *= 10;
+    }
+    return powers;
+}();
+
+/** Writes \p n, which must be less than 100, as two digits to \p p. */
+char * write_two_digits(char *p, unsigned n)
+{
+    M_insist(n < 100);
+    std::memcpy(p, &TWO_DIGITS[2 * n], 2);
+    return p + 2;
+}
+
+char * write_integer(char *p, int64_t value)
+{
+    return std::to_chars(p, p + std::numeric_limits<int64_t>::digits10 + 2, value).ptr;
+}
+
+/** Writes \p value zero-padded to at least \p width characters, including the sign, like `std::setw(width)` with fill
+ * `0` and `std::internal`. */
+char * write_padded(char *p, int64_t value, unsigned width)
+{
+    char digits[std::numeric_limits<uint64_t>::digits10 + 1];
+    const uint64_t abs = value < 0 ? -uint64_t(value) : uint64_t(value);
+    const std::size_t num_digits = std::to_chars(digits, digits + sizeof(digits), abs).ptr - digits;
+    if (value < 0)
+        *p++ = '-';
+    for (std::size_t i = num_digits + (value < 0); i < width; ++i)
+        *p++ = '0';
+    std::memcpy(p, digits, num_digits);
+    return p + num_digits;
+}
+
+/** Writes the date \p date, encoded as in `Tuple`s, exactly like the `Print_date` operation of the `StackMachine`. */
+char * write_date(char *p, int32_t date)
+{
+    const int32_t year = date >> 9; // signed because year is signed
+    p = write_padded(p, year, year > 0 ? 4 : 5);
+    *p++ = '-';
+    p = write_two_digits(p, (date >> 5) & 0xF);
+    *p++ = '-';
+    return write_two_digits(p, date & 0x1F);
+}
+
+/** Writes the datetime \p time, in seconds since the UNIX epoch, exactly like the `Print_datetime` operation of the
+ * `StackMachine`.  Years of four digits are formatted directly, all others by `put_tm()`. */
+char * write_datetime(char *p, time_t time, std::size_t max_length)
+{
+    std::tm tm;
+    gmtime_r(&time, &tm);
+    const int year = tm.tm_year + 1900;
+    if (year < 1000 or year > 9999) {
+        std::ostringstream oss;
+        oss << put_tm(tm);
+        const std::string str = oss.str();
+        M_insist(str.length() <= max_length, "datetime exceeds its maximal length");
+        std::memcpy(p, str.data(), str.length());
+        return p + str.length();
+    }
+    p = write_two_digits(p, year / 100);
+    p = write_two_digits(p, year % 100);
+    *p++ = '-';
+    p = write_two_digits(p, tm.tm_mon + 1);
+    *p++ = '-';
+    p = write_two_digits(p, tm.tm_mday);
+    *p++ = ' ';
+    p = write_two_digits(p, tm.tm_hour);
+    *p++ = ':';
+    p = write_two_digits(p, tm.tm_min);
+    *p++ = ':';
+    return write_two_digits(p, tm.tm_sec);
+}
+
+/** Writes the decimal \p value of scale \p scale with its decimal point. */
+char * write_decimal(char *p, int64_t value, unsigned scale)
+{
+    if (scale == 0)
+        return write_integer(p, value);
+    const uint64_t abs = value < 0 ? -uint64_t(value) : uint64_t(value);
+    const uint64_t div = POWERS_OF_TEN[scale];
+    if (value < 0)
+        *p++ = '-';
+    p = std::to_chars(p, p + std::numeric_limits<uint64_t>::digits10 + 1, abs / div).ptr;
+    *p++ = '.';
+    return write_padded(p, abs % div, scale);
+}
+
+/** Writes \p str with backslash, tab, newline, and carriage return escaped, as appropriate for TSV. */
+char * write_escaped(char *p, const char *str, std::size_t length)
+{
+    for (const char *end = str + length; str != end; ++str) {
+        switch (*str) {
+            case '\\': *p++ = '\\'; *p++ = '\\'; break;
+            case '\t': *p++ = '\\'; *p++ = 't';  break;
+            case '\n': *p++ = '\\'; *p++ = 'n';  break;
+            case '\r': *p++ = '\\'; *p++ = 'r';  break;
+            default:   *p++ = *str;              break;
+        }
+    }
+    return p;
+}
+
+/** Provides the entries of a `Tuple` to `ResultWriter::write_textual()` and `ResultWriter::write_binary()`. */
+struct tuple_row_t
+{
+    const Tuple &tuple;
+
+    bool is_null(std::size_t idx) const { return tuple.is_null(idx); }
+    bool as_b(std::size_t idx) const { return tuple[idx].as_b(); }
+    int64_t as_i(std::size_t idx) const { return tuple[idx].as_i(); }
+    float as_f(std::size_t idx) const { return tuple[idx].as_f(); }
+    double as_d(std::size_t idx) const { return tuple[idx].as_d(); }
+    const char * as_p(std::size_t idx) const { return reinterpret_cast<const char*>(tuple[idx].as_p()); }
+};
+
+/** Provides the entries of a single tuple of `ResultColumns`, reading the values directly from the columns. */
+struct columns_row_t
+{
+    const ResultColumns &columns;
+    std::size_t row;
+
+    bool is_null(std::size_t idx) const { return columns.columns[idx].is_null[row]; }
+    bool as_b(std::size_t idx) const { return *columns.columns[idx][row]; }
+    int64_t as_i(std::size_t idx) const {
+        auto &column = columns.columns[idx];
+        switch (column.value_size) {
+            default: M_unreachable("invalid integer size");
+            case 1: return read<int8_t>(column[row]);
+            case 2: return read<int16_t>(column[row]);
+            case 4: return read<int32_t>(column[row]);
+            case 8: return read<int64_t>(column[row]);
+        }
+    }
+    float as_f(std::size_t idx) const { return read<float>(columns.columns[idx][row]); }
+    double as_d(std::size_t idx) const { return read<double>(columns.columns[idx][row]); }
+    const char * as_p(std::size_t idx) const { return reinterpret_cast<const char*>(columns.columns[idx][row]); }
+
+    private:
+    template<typename T>
+    static T read(const uint8_t *p) {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        return value;
+    }
+};
+
+/** Writes the \p size least significant bytes of \p value in native byte order. */
+void write_binary_integer(char *p, int64_t value, uint32_t size)
+{
+    switch (size) {
+        default: M_unreachable("invalid integer size");
+        case 1: { const int8_t  v = value; std::memcpy(p, &v, sizeof(v)); break; }
+        case 2: { const int16_t v = value; std::memcpy(p, &v, sizeof(v)); break; }
+        case 4: { const int32_t v = value; std::memcpy(p, &v, sizeof(v)); break; }
+        case 8: { std::memcpy(p, &value, sizeof(value)); break; }
+    }
+}
+
+}
+
+
+ResultWriter::format_t ResultWriter::Default_Format() { return options::output_format; }
+
+ResultWriter::ResultWriter(std::ostream &out, const Schema &schema, format_t format)
+    : out_(out)
+    , format_(format)
+{
+    constexpr uint32_t MAX_INTEGER_LENGTH = std::numeric_limits<int64_t>::digits10 + 2; // sign and all digits
+    attributes_.reserve(schema.num_entries());
+    for (auto &e : schema) {
+        attribute_t attr;
+        visit(overloaded {
+            [&](const Boolean&) { attr = { attribute_t::K_Boolean, 0, 1, 5 }; },
+            [&](const Numeric &n) {
+                switch (n.kind) {
+                    case Numeric::N_Int:
+                        attr = { attribute_t::K_Int, 0, uint32_t(n.size() / 8), MAX_INTEGER_LENGTH };
+                        break;
+                    case Numeric::N_Decimal:
+                        if (format_ == F_TSV) {
+                            attr = { attribute_t::K_Decimal, uint8_t(n.scale), uint32_t(n.size() / 8),
+                                     MAX_INTEGER_LENGTH + 1 };
+                        } else {
+                            attr = { attribute_t::K_Int, 0, uint32_t(n.size() / 8), MAX_INTEGER_LENGTH };
+                        }
+                        break;
+                    case Numeric::N_Float:
+                        if (n.size() <= 32)
+                            attr = { attribute_t::K_Float, 0, 4, 24 };
+                        else
+                            attr = { attribute_t::K_Double, 0, 8, 32 };
+                        break;
+                }
+            },
+            [&](const CharacterSequence &cs) {
+                const uint32_t length = format_ == F_TSV ? 2 * cs.length : cs.length + 2;
+                attr = { attribute_t::K_Char, 0, uint32_t(cs.length), length };
+            },
+            [&](const Date&) { attr = { attribute_t::K_Date, 0, 4, 16 }; },
+            [&](const DateTime&) { attr = { attribute_t::K_DateTime, 0, 8, 32 }; },
+            [&](const NoneType&) { attr = { attribute_t::K_None, 0, 0, 0 }; },
+            [](auto&&) { M_unreachable("invalid type"); },
+        }, *e.type);
+        attr.max_length = std::max<uint32_t>(attr.max_length, 4); // NULL
+        attributes_.push_back(attr);
+    }
+
+    /*----- Compute the maximal size of a row and allocate a buffer of at least one row. -----*/
+    if (format_ == F_Binary) {
+        max_row_size_ = (attributes_.size() + 7) / 8; // NULL bitmap
+        for (auto &attr : attributes_)
+            max_row_size_ += attr.size;
+    } else {
+        max_row_size_ = attributes_.size(); // delimiters and newline
+        for (auto &attr : attributes_)
+            max_row_size_ += attr.max_length;
+    }
+    capacity_ = std::max(BUFFER_SIZE, max_row_size_);
+    buffer_ = std::make_unique<char[]>(capacity_);
+    pos_ = buffer_.get();
+}
+
+void ResultWriter::write(const Tuple &tuple)
+{
+    reserve(max_row_size_);
+    if (format_ == F_Binary)
+        write_binary(tuple_row_t{ tuple });
+    else
+        write_textual(tuple_row_t{ tuple });
+}
+
+void ResultWriter::write(const ResultColumns &columns)
+{
+    M_insist(columns.columns.size() == attributes_.size(), "columns must be of the schema of this writer");
+    for (std::size_t row = 0; row != columns.num_tuples; ++row) {
+        reserve(max_row_size_);
+        if (format_ == F_Binary)
+            write_binary(columns_row_t{ columns, row });
+        else
+            write_textual(columns_row_t{ columns, row });
+    }
+}
+
+void ResultWriter::flush()
+{
+    if (pos_ == buffer_.get())
+        return;
+    out_.write(buffer_.get(), pos_ - buffer_.get());
+    pos_ = buffer_.get();
+}
+
+template<typename Row>
+void ResultWriter::write_textual(const Row &row)
+{
+    const char delimiter = format_ == F_TSV ? '\t' : ',';
+    char *p = pos_;
+    for (std::size_t idx = 0; idx != attributes_.size(); ++idx) {
+        if (idx != 0)
+            *p++ = delimiter;
+        auto &attr = attributes_[idx];
+        if (row.is_null(idx)) {
+            std::memcpy(p, "NULL", 4);
+            p += 4;
+            continue;
+        }
+        switch (attr.kind) {
+            case attribute_t::K_None:
+                M_unreachable("value of NONE type must be NULL");
+
+            case attribute_t::K_Boolean:
+                if (row.as_b(idx)) {
+                    std::memcpy(p, "TRUE", 4);
+                    p += 4;
+                } else {
+                    std::memcpy(p, "FALSE", 5);
+                    p += 5;
+                }
+                break;
+
+            case attribute_t::K_Int:
+                p = write_integer(p, row.as_i(idx));
+                break;
+
+            case attribute_t::K_Decimal:
+                p = write_decimal(p, row.as_i(idx), attr.scale);
+                break;
+
+            case attribute_t::K_Float:
+                p = std::to_chars(p, p + attr.max_length, row.as_f(idx), std::chars_format::general,
+                                  std::numeric_limits<float>::max_digits10 - 1).ptr;
+                break;
+
+            case attribute_t::K_Double:
+                p = std::to_chars(p, p + attr.max_length, row.as_d(idx), std::chars_format::general,
+                                  std::numeric_limits<double>::max_digits10 - 1).ptr;
+                break;
+
+            case attribute_t::K_Char: {
+                const char *str = row.as_p(idx);
+                const std::size_t length = strnlen(str, attr.size);
+                if (format_ == F_TSV) {
+                    p = write_escaped(p, str, length);
+                } else {
+                    *p++ = '"';
+                    std::memcpy(p, str, length);
+                    p += length;
+                    *p++ = '"';
+                }
+                break;
+            }
+
+            case attribute_t::K_Date:
+                p = write_date(p, row.as_i(idx));
+                break;
+
+            case attribute_t::K_DateTime:
+                p = write_datetime(p, row.as_i(idx), attr.max_length);
+                break;
+        }
+    }
+    *p++ = '\n';
+    pos_ = p;
+}
+
+template<typename Row>
+void ResultWriter::write_binary(const Row &row)
+{
+    char *bitmap = pos_;
+    std::memset(bitmap, 0, max_row_size_); // values of NULL entries are zero
+    char *p = bitmap + (attributes_.size() + 7) / 8;
+    for (std::size_t idx = 0; idx != attributes_.size(); ++idx) {
+        auto &attr = attributes_[idx];
+        if (row.is_null(idx)) {
+            bitmap[idx / 8] |= char(1U << (idx % 8));
+            p += attr.size;
+            continue;
+        }
+        switch (attr.kind) {
+            case attribute_t::K_None:
+                M_unreachable("value of NONE type must be NULL");
+
+            case attribute_t::K_Boolean:
+                *p = row.as_b(idx);
+                break;
+
+            case attribute_t::K_Int:
+            case attribute_t::K_Decimal:
+            case attribute_t::K_Date:
+            case attribute_t::K_DateTime:
+                write_binary_integer(p, row.as_i(idx), attr.size);
+                break;
+
+            case attribute_t::K_Float: {
+                const float f = row.as_f(idx);
+                std::memcpy(p, &f, sizeof(f));
+                break;
+            }
+
+            case attribute_t::K_Double: {
+                const double d = row.as_d(idx);
+                std::memcpy(p, &d, sizeof(d));
+                break;
+            }
+
+            case attribute_t::K_Char:
+                std::strncpy(p, row.as_p(idx), attr.size);
+                break;
+        }
+        p += attr.size;
+    }
+    pos_ = p;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "backend/ResultColumns.hpp"
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <vector>
+
+
+namespace m {
+
+/** Formats the tuples of a query result into a large output buffer and writes the buffer to an output stream in big
+ * chunks, instead of formatting every value with iostreams.  Numbers are formatted with `std::to_chars`, dates and
+ * times with precomputed two-digit tables.  The format of each attribute is resolved once, when the writer is created.
+ *
+ * The output format is chosen by `--output-format`:
+ *
+ * - `csv` (the default) prints exactly what the `Print` operations of the `StackMachine` print, i.e. values are
+ *   separated by commas, strings are enclosed in double quotes, and NULL is printed as `NULL`.
+ * - `tsv` separates values by tabs, prints strings without quotes, escaping backslash, tab, newline, and carriage
+ *   return as `\\`, `\t`, `\n`, and `\r`, and prints decimals with their decimal point.  (The `Print` operations
+ *   print decimals as their scaled integer, which `csv` retains for compatibility.)
+ * - `binary` writes every row as a NULL bitmap of one bit per attribute, least significant bit first, followed by the
+ *   values of all attributes in native byte order: booleans as one byte, integers and decimals with their size, floats
+ *   and doubles as IEEE 754, character sequences NUL-padded to their maximal length, and dates and datetimes as 32 and
+ *   64 bit integers in the encoding of `Tuple`s.  Values of NULL entries are zero.  Rows are not separated and there
+ *   is no header, hence all rows of a result have the same size. */
+struct ResultWriter
+{
+    enum format_t
+    {
+        F_CSV,
+        F_TSV,
+        F_Binary,
+    };
+
+    /** Returns the output format selected by `--output-format`. */
+    static format_t Default_Format();
+    /** Returns `true` iff results are written in a textual format and may thus be followed by other text, e.g. the
+     * number of result rows. */
+    static bool Is_Textual(format_t format) { return format != F_Binary; }
+
+    private:
+    ///> how a single attribute is written
+    struct attribute_t
+    {
+        enum kind_t : uint8_t
+        {
+            K_None,
+            K_Boolean,
+            K_Int,
+            K_Float,
+            K_Double,
+            K_Char,
+            K_Date,
+            K_DateTime,
+            K_Decimal,
+        } kind;
+        ///> the scale of decimals
+        uint8_t scale = 0;
+        ///> the size of the attribute in the binary format, in bytes
+        uint32_t size = 0;
+        ///> the maximal length of the attribute in a textual format, in bytes
+        uint32_t max_length = 0;
+    };
+
+    ///> the minimal capacity of the output buffer
+    static constexpr std::size_t BUFFER_SIZE = 1UL << 20;
+
+    std::ostream &out_;
+    format_t format_;
+    std::vector<attribute_t> attributes_;
+    ///> the maximal size of a single row in the output format; the buffer holds at least one row
+    std::size_t max_row_size_ = 0;
+    std::size_t capacity_;
+    std::unique_ptr<char[]> buffer_;
+    char *pos_; ///< the end of the formatted data in `buffer_`
+
+    public:
+    ResultWriter(std::ostream &out, const Schema &schema, format_t format = Default_Format());
+    ResultWriter(const ResultWriter&) = delete;
+    ~ResultWriter() { flush(); }
+
+    format_t format() const { return format_; }
+
+    /** Writes \p tuple, which must be of the schema this writer was created for, as a single row. */
+    void write(const Tuple &tuple);
+    /** Writes all tuples of \p columns, which must be of the schema this writer was created for, one row per tuple.
+     * The values are read directly from the columns, without materializing a `Tuple` per row. */
+    void write(const ResultColumns &columns);
+
+    /** Writes all buffered rows to the output stream. */
+    void flush();
+
+    private:
+    /** Returns the number of bytes left in the output buffer. */
+    std::size_t available() const { return buffer_.get() + capacity_ - pos_; }
+    /** Ensures that at least \p n bytes are available in the output buffer, flushing it if necessary. */
+    void reserve(std::size_t n) { if (available() < n) flush(); }
+
+    /** Writes the row \p row, which provides the entries of a tuple either of a `Tuple` or of `ResultColumns`. */
+    template<typename Row>
+    void write_textual(const Row &row);
+    template<typename Row>
+    void write_binary(const Row &row);
+};
+
+}
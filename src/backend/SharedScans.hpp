@@ -0,0 +1,116 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutable/storage/Store.hpp>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+
+namespace m {
+
+/** Coordinates the scans of a store by concurrently executed queries, in the spirit of the cooperative scans of
+ * Crescando and QPipe and the synchronized sequential scans of PostgreSQL.  Every scan publishes its position at the
+ * granularity of morsels.  A scan that starts while another scan of the same store is running attaches to that scan:
+ * it starts at the current morsel of the running scan and wraps around at the end of the store.  The scans then read
+ * the same morsels at about the same time, such that the morsels are pulled through the memory hierarchy once and
+ * shared through the caches, instead of once per query.  Since a circular scan visits the rows in a rotated order,
+ * only scans whose consumers do not depend on the order of the rows may attach. */
+struct SharedScans
+{
+    ///> the number of rows of a morsel, i.e. the granularity at which scans publish their position
+    static constexpr std::size_t MORSEL_SIZE = 1UL << 14;
+
+    /** A circular scan of a store, registered with `SharedScans` while it exists. */
+    struct Cursor
+    {
+        friend struct SharedScans;
+
+        private:
+        SharedScans *scans_;
+        const Store *store_;
+        std::size_t num_rows_;
+        std::size_t start_; ///< the first row of the scan
+        ///> the first row of the morsel currently scanned; owned s.t. its address is stable when the cursor is moved
+        std::unique_ptr<std::atomic<std::size_t>> position_;
+
+        Cursor(SharedScans &scans, const Store &store, std::size_t num_rows, std::size_t start)
+            : scans_(&scans)
+            , store_(&store)
+            , num_rows_(num_rows)
+            , start_(start)
+            , position_(std::make_unique<std::atomic<std::size_t>>(start))
+        { }
+
+        public:
+        Cursor(Cursor&&) = default;
+        ~Cursor() { if (position_) scans_->detach(*this); }
+
+        std::size_t start() const { return start_; }
+
+        /** Calls \p fn with the first and the past-the-end row of every morsel of the scan in circular order, starting
+         * at `start()`, and publishes the position of the scan before each morsel. */
+        template<typename Fn>
+        void for_each_morsel(Fn &&fn) {
+            auto scan = [&](std::size_t begin, std::size_t end) {
+                for (std::size_t morsel = begin; morsel < end; morsel += MORSEL_SIZE) {
+                    position_->store(morsel, std::memory_order_relaxed);
+                    fn(morsel, std::min(morsel + MORSEL_SIZE, end));
+                }
+            };
+            scan(start_, num_rows_);
+            scan(0, start_);
+        }
+    };
+
+    private:
+    ///> the positions of all running scans, by store
+    std::unordered_multimap<const Store*, const std::atomic<std::size_t>*> scans_;
+    mutable std::mutex mutex_;
+
+    SharedScans() = default;
+
+    public:
+    static SharedScans & Get() {
+        static SharedScans the_scans;
+        return the_scans;
+    }
+
+    /** Starts a scan of the first \p num_rows rows of \p store.  If \p store is currently scanned, the returned cursor
+     * starts at the current morsel of one of the running scans, otherwise at row 0. */
+    Cursor attach(const Store &store, std::size_t num_rows) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::size_t start = 0;
+        if (auto it = scans_.find(&store); it != scans_.end()) {
+            const std::size_t position = it->second->load(std::memory_order_relaxed);
+            if (position < num_rows)
+                start = position / MORSEL_SIZE * MORSEL_SIZE;
+        }
+        Cursor cursor(*this, store, num_rows, start);
+        scans_.emplace(&store, cursor.position_.get());
+        return cursor;
+    }
+
+    /** Returns the number of running scans of \p store. */
+    std::size_t num_scans(const Store &store) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return scans_.count(&store);
+    }
+
+    private:
+    void detach(const Cursor &cursor) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto [begin, end] = scans_.equal_range(cursor.store_);
+        for (auto it = begin; it != end; ++it) {
+            if (it->second == cursor.position_.get()) {
+                scans_.erase(it);
+                return;
+            }
+        }
+    }
+};
+
+}
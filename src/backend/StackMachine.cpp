@@ -1,9 +1,13 @@
 #include "backend/StackMachine.hpp"
 
 #include "backend/Interpreter.hpp"
+#include "util/LikeDFA.hpp"
 #include <ctime>
 #include <functional>
+#include <iterator>
+#include <limits>
 #include <mutable/util/fn.hpp>
+#include <optional>
 #include <regex>
 
 
@@ -14,6 +18,61 @@ using namespace m;
  * Helper functions
  *====================================================================================================================*/
 
+namespace {
+
+/** A constant pattern of a LIKE expression, compiled once.  Patterns are matched by their minimal DFA, and by a regular
+ * expression only if the DFA would be too large or the pattern is invalid. */
+struct like_pattern_t
+{
+    std::optional<LikeDFA> dfa;
+    std::optional<std::regex> regex;
+
+    explicit like_pattern_t(const std::string &pattern) : dfa(LikeDFA::Compile(pattern)) {
+        if (not dfa)
+            regex.emplace(pattern_to_regex(pattern.c_str(), true));
+    }
+
+    bool operator()(const char *str) const { return dfa ? (*dfa)(str) : std::regex_match(str, *regex); }
+};
+
+/** Returns the maximal number of decimal digits of a value of the integral or decimal type \p n. */
+uint32_t max_digits(const Numeric *n)
+{
+    if (n->is_decimal())
+        return n->precision;
+    switch (n->size()) {
+        case 8:  return 3;
+        case 16: return 5;
+        case 32: return 10;
+        default: return 19;
+    }
+}
+
+/** Returns `true` iff \p e is a multiplication of integral or decimal operands, which is computed exactly. */
+bool is_exact_product(const ast::Expr &e)
+{
+    auto b = cast<const ast::BinaryExpr>(&e);
+    if (not b or b->op().type != TK_ASTERISK)
+        return false;
+    auto n_lhs = cast<const Numeric>(b->lhs->type());
+    auto n_rhs = cast<const Numeric>(b->rhs->type());
+    return n_lhs and n_rhs and not n_lhs->is_floating_point() and not n_rhs->is_floating_point();
+}
+
+/** Collects the factors of the chain of exact multiplications \p e in \p factors. */
+void collect_factors(const ast::Expr &e, std::vector<const ast::Expr*> &factors)
+{
+    if (is_exact_product(e)) {
+        auto &b = as<const ast::BinaryExpr>(e);
+        collect_factors(*b.lhs, factors);
+        collect_factors(*b.rhs, factors);
+    } else {
+        factors.push_back(&e);
+    }
+}
+
+}
+
 /** Return the type suffix for the given `PrimitiveType` `ty`. */
 const char * tystr(const PrimitiveType *ty) {
     if (ty->is_boolean())
@@ -58,7 +117,7 @@ struct m::StackMachineBuilder : ast::ConstASTExprVisitor
     }
 
     private:
-    static std::unordered_map<std::string, std::regex> regexes_; ///< regexes built from patterns in LIKE expressions
+    static std::unordered_map<std::string, like_pattern_t> patterns_; ///< compiled patterns of LIKE expressions
 
     /** Returns a pair of (tuple_id, attr_id). */
     std::pair<std::size_t, std::size_t>
@@ -82,7 +141,7 @@ struct m::StackMachineBuilder : ast::ConstASTExprVisitor
     void operator()(Const<ast::QueryExpr> &e) override;
 };
 
-std::unordered_map<std::string, std::regex> StackMachineBuilder::regexes_;
+std::unordered_map<std::string, like_pattern_t> StackMachineBuilder::patterns_;
 
 void StackMachineBuilder::operator()(Const<ast::Designator> &e)
 {
@@ -99,6 +158,11 @@ void StackMachineBuilder::operator()(Const<ast::Constant> &e) {
 
 void StackMachineBuilder::operator()(Const<ast::FnApplicationExpr> &e)
 {
+    if (auto value = Interpreter::fold(e)) { // constant expression, evaluate only once
+        stack_machine_.add_and_emit_load(*value);
+        return;
+    }
+
     auto &C = Catalog::Get();
     auto &fn = e.get_function();
 
@@ -153,6 +217,11 @@ void StackMachineBuilder::operator()(Const<ast::FnApplicationExpr> &e)
 
 void StackMachineBuilder::operator()(Const<ast::UnaryExpr> &e)
 {
+    if (auto value = Interpreter::fold(e)) { // constant expression, evaluate only once
+        stack_machine_.add_and_emit_load(*value);
+        return;
+    }
+
     (*this)(*e.expr);
     auto ty = e.expr->type();
 
@@ -199,6 +268,16 @@ void StackMachineBuilder::operator()(Const<ast::UnaryExpr> &e)
 
 void StackMachineBuilder::operator()(Const<ast::BinaryExpr> &e)
 {
+    if (auto value = Interpreter::fold(e)) { // constant expression, evaluate only once
+        stack_machine_.add_and_emit_load(*value);
+        return;
+    }
+
+    if (auto operand = Interpreter::identity_operand(e)) { // identity operation, e.g. `x * 1`
+        (*this)(*operand);
+        return;
+    }
+
     auto ty = as<const PrimitiveType>(e.type());
     auto ty_lhs = as<const PrimitiveType>(e.lhs->type());
     auto ty_rhs = as<const PrimitiveType>(e.rhs->type());
@@ -337,6 +416,37 @@ void StackMachineBuilder::operator()(Const<ast::BinaryExpr> &e)
             auto n_lhs = as<const Numeric>(ty_lhs);
             auto n_rhs = as<const Numeric>(ty_rhs);
             auto n_res = as<const Numeric>(ty);
+
+            /* Compute a chain of decimal multiplications, e.g. `price * (1 - discount) * (1 + tax)`, at the sum of the
+             * scales of its factors and rescale only the final product, instead of scaling down after every single
+             * multiplication.  This requires that the unscaled product cannot overflow. */
+            if (n_res->is_decimal() and is_exact_product(e)) {
+                std::vector<const ast::Expr*> factors;
+                collect_factors(e, factors);
+                uint32_t digits = 0;
+                uint32_t scale_product = 0;
+                for (auto f : factors) {
+                    auto n = as<const Numeric>(f->type());
+                    digits += max_digits(n);
+                    scale_product += n->scale;
+                }
+                if (factors.size() > 2 and digits <= std::numeric_limits<int64_t>::digits10) {
+                    (*this)(*factors.front());
+                    for (auto it = std::next(factors.begin()); it != factors.end(); ++it) {
+                        (*this)(**it);
+                        stack_machine_.emit_Mul_i();
+                    }
+                    if (scale_product > n_res->scale) {
+                        load_numeric(powi<int64_t>(10, scale_product - n_res->scale), n_res);
+                        stack_machine_.emit_Div_i(); // scale down once
+                    } else if (scale_product < n_res->scale) {
+                        load_numeric(powi<int64_t>(10, n_res->scale - scale_product), n_res);
+                        stack_machine_.emit_Mul_i(); // scale up once
+                    }
+                    break;
+                }
+            }
+
             uint32_t the_scale = 0;
 
             (*this)(*e.lhs);
@@ -484,9 +594,9 @@ void StackMachineBuilder::operator()(Const<ast::BinaryExpr> &e)
             if (auto rhs = cast<const ast::Constant>(e.rhs.get())) {
                 (*this)(*e.lhs);
                 auto pattern = interpret(*rhs->tok.text);
-                auto it = regexes_.find(pattern);
-                if (it == regexes_.end())
-                    it = StackMachineBuilder::regexes_.insert({pattern, pattern_to_regex(pattern.c_str(), true)}).first;
+                auto it = patterns_.find(pattern);
+                if (it == patterns_.end())
+                    it = StackMachineBuilder::patterns_.try_emplace(pattern, pattern).first;
                 stack_machine_.add_and_emit_load(&(it->second));
                 stack_machine_.emit_Like_const();
             } else {
@@ -527,9 +637,78 @@ void StackMachineBuilder::operator()(Const<ast::QueryExpr> &e) {
 const std::unordered_map<std::string, StackMachine::Opcode> StackMachine::STR_TO_OPCODE = {
 #define M_OPCODE(CODE, ...) { #CODE, StackMachine::Opcode:: CODE },
 #include "tables/Opcodes.tbl"
+#include "tables/Superinstructions.tbl"
 #undef M_OPCODE
 };
 
+namespace {
+
+#define NUM_OPERANDS_(XXX, _1, _2, _3, _4, N, ...) N
+#define NUM_OPERANDS(...) NUM_OPERANDS_(XXX, ##__VA_ARGS__, 4, 3, 2, 1, 0)
+
+/** The number of operands following each opcode in the opcode sequence. */
+constexpr std::size_t NUM_OPERANDS[] = {
+#define M_OPCODE(CODE, DELTA, ...) NUM_OPERANDS(__VA_ARGS__),
+#include "tables/Opcodes.tbl"
+#include "tables/Superinstructions.tbl"
+#undef M_OPCODE
+};
+
+#undef NUM_OPERANDS
+#undef NUM_OPERANDS_
+
+/** Returns the superinstruction comparing a tuple attribute with a context value by the comparison \p cmp, or
+ * `Opcode::Last` if there is none. */
+StackMachine::Opcode fuse_compare(StackMachine::Opcode cmp)
+{
+    using Opcode = StackMachine::Opcode;
+    switch (cmp) {
+#define FUSE(CMP) \
+        case Opcode:: CMP ## _i: return Opcode:: CMP ## _Tup_Ctx_i; \
+        case Opcode:: CMP ## _f: return Opcode:: CMP ## _Tup_Ctx_f; \
+        case Opcode:: CMP ## _d: return Opcode:: CMP ## _Tup_Ctx_d;
+        FUSE(Eq)
+        FUSE(NE)
+        FUSE(LT)
+        FUSE(GT)
+        FUSE(LE)
+        FUSE(GE)
+#undef FUSE
+        default: return Opcode::Last;
+    }
+}
+
+/** Returns the superinstruction storing the value of type \p load, loaded from the address in the context, with
+ * \p store to a tuple, or `Opcode::Last` if there is none. */
+StackMachine::Opcode fuse_load_store(StackMachine::Opcode load, StackMachine::Opcode store)
+{
+    using Opcode = StackMachine::Opcode;
+    switch (load) {
+        case Opcode::Ld_i8:  return store == Opcode::St_Tup_i ? Opcode::Ld_Ctx_St_Tup_i8  : Opcode::Last;
+        case Opcode::Ld_i16: return store == Opcode::St_Tup_i ? Opcode::Ld_Ctx_St_Tup_i16 : Opcode::Last;
+        case Opcode::Ld_i32: return store == Opcode::St_Tup_i ? Opcode::Ld_Ctx_St_Tup_i32 : Opcode::Last;
+        case Opcode::Ld_i64: return store == Opcode::St_Tup_i ? Opcode::Ld_Ctx_St_Tup_i64 : Opcode::Last;
+        case Opcode::Ld_f:   return store == Opcode::St_Tup_f ? Opcode::Ld_Ctx_St_Tup_f   : Opcode::Last;
+        case Opcode::Ld_d:   return store == Opcode::St_Tup_d ? Opcode::Ld_Ctx_St_Tup_d   : Opcode::Last;
+        default:             return Opcode::Last;
+    }
+}
+
+/** Returns the superinstruction loading a tuple attribute and applying the cast \p cast, or `Opcode::Last` if there is
+ * none. */
+StackMachine::Opcode fuse_cast(StackMachine::Opcode cast)
+{
+    using Opcode = StackMachine::Opcode;
+    switch (cast) {
+        case Opcode::Cast_f_i: return Opcode::Ld_Tup_Cast_f_i;
+        case Opcode::Cast_d_i: return Opcode::Ld_Tup_Cast_d_i;
+        case Opcode::Cast_d_f: return Opcode::Ld_Tup_Cast_d_f;
+        default:               return Opcode::Last;
+    }
+}
+
+}
+
 StackMachine::StackMachine(Schema in_schema, const ast::Expr &expr)
     : in_schema(in_schema)
 {
@@ -853,14 +1032,86 @@ void StackMachine::emit_Cast(const Type *to_ty, const Type *from_ty)
     M_unreachable("unsupported conversion");
 }
 
+void StackMachine::fuse()
+{
+    std::vector<Opcode> fused;
+    fused.reserve(ops.size());
+
+    const std::size_t size = ops.size();
+    auto is = [&](std::size_t i, Opcode opc) { return i < size and ops[i] == opc; };
+
+    for (std::size_t i = 0; i != size; ) {
+        const Opcode opc = ops[i];
+        if (opc == Opcode::Ld_Tup and i + 3 < size) {
+            /* The operation following `Ld_Tup tuple_id index` starts at `i + 3`. */
+            const Opcode next = ops[i + 3];
+            if (next == Opcode::Ld_Ctx and i + 5 < size) {
+                if (auto cmp = fuse_compare(ops[i + 5]); cmp != Opcode::Last) {
+                    fused.insert(fused.end(), { cmp, ops[i + 1], ops[i + 2], ops[i + 4] });
+                    i += 6;
+                    continue;
+                }
+            } else if (auto cast = fuse_cast(next); cast != Opcode::Last) {
+                fused.insert(fused.end(), { cast, ops[i + 1], ops[i + 2] });
+                i += 4;
+                continue;
+            } else if ((next == Opcode::St_Tup_b or next == Opcode::St_Tup_i or next == Opcode::St_Tup_f or
+                        next == Opcode::St_Tup_d) and is(i + 6, Opcode::Pop))
+            {
+                fused.insert(fused.end(), { Opcode::Cp_Tup, ops[i + 1], ops[i + 2], ops[i + 4], ops[i + 5] });
+                i += 7;
+                continue;
+            }
+        }
+
+        if (opc == Opcode::Ld_Ctx and i + 2 < size) {
+            /* The operation following `Ld_Ctx idx` starts at `i + 2`. */
+            const Opcode next = ops[i + 2];
+            if (i + 3 < size and is(i + 6, Opcode::Pop)) {
+                if (auto load_store = fuse_load_store(next, ops[i + 3]); load_store != Opcode::Last) {
+                    fused.insert(fused.end(), { load_store, ops[i + 1], ops[i + 4], ops[i + 5] });
+                    i += 7;
+                    continue;
+                }
+            }
+            if (next == Opcode::Ld_Ctx and is(i + 4, Opcode::Add_p) and is(i + 5, Opcode::Upd_Ctx) and
+                i + 6 < size and ops[i + 6] == ops[i + 3] and is(i + 7, Opcode::Pop))
+            {
+                fused.insert(fused.end(), { Opcode::Add_Ctx_p, ops[i + 1], ops[i + 3] });
+                i += 8;
+                continue;
+            }
+            if (next == Opcode::Inc and is(i + 3, Opcode::Upd_Ctx) and i + 4 < size and ops[i + 4] == ops[i + 1] and
+                is(i + 5, Opcode::Pop))
+            {
+                fused.insert(fused.end(), { Opcode::Inc_Ctx, ops[i + 1] });
+                i += 6;
+                continue;
+            }
+        }
+
+        /* Copy the operation and its operands. */
+        const std::size_t length = 1 + NUM_OPERANDS[std::size_t(opc)];
+        M_insist(i + length <= size, "operands out of bounds");
+        fused.insert(fused.end(), ops.begin() + i, ops.begin() + i + length);
+        i += length;
+    }
+
+    ops = std::move(fused);
+    num_fused_ops_ = ops.size();
+}
+
 void StackMachine::operator()(Tuple **tuples) const
 {
     static const void *labels[] = {
 #define M_OPCODE(CODE, ...) && CODE,
 #include "tables/Opcodes.tbl"
+#include "tables/Superinstructions.tbl"
 #undef M_OPCODE
     };
 
+    if (num_fused_ops_ != ops.size())
+        const_cast<StackMachine*>(this)->fuse();
     const_cast<StackMachine*>(this)->emit_Stop();
     if (not values_) {
         values_ = new Value[required_stack_size()];
@@ -1456,11 +1707,11 @@ Cmp_s: BINARY(strcmp, char*);
 
 Like_const: {
     M_insist(top_ >= 2);
-    std::regex *re = TOP.as<std::regex*>();
+    const like_pattern_t *pattern = TOP.as<like_pattern_t*>();
     POP();
     if (not TOP_IS_NULL) {
         char *str = TOP.as<char*>();
-        TOP = std::regex_match(str, *re);
+        TOP = (*pattern)(str);
     }
 }
 NEXT;
@@ -1537,6 +1788,108 @@ Cast_d_f: UNARY((double), float);
 #undef BINARY
 #undef UNARY
 
+
+/*======================================================================================================================
+ * Superinstructions
+ *====================================================================================================================*/
+
+#define CMP_TUP_CTX(OP, TYPE) { \
+    std::size_t tuple_id = std::size_t(*op_++); \
+    std::size_t index = std::size_t(*op_++); \
+    std::size_t idx = std::size_t(*op_++); \
+    M_insist(idx < context_.size(), "index out of bounds"); \
+    auto &t = *tuples[tuple_id]; \
+    PUSH(OP(t[index].as<TYPE>(), context_[idx].as<TYPE>()), t.is_null(index)); \
+} \
+NEXT;
+
+Eq_Tup_Ctx_i: CMP_TUP_CTX(std::equal_to{}, int64_t);
+Eq_Tup_Ctx_f: CMP_TUP_CTX(std::equal_to{}, float);
+Eq_Tup_Ctx_d: CMP_TUP_CTX(std::equal_to{}, double);
+
+NE_Tup_Ctx_i: CMP_TUP_CTX(std::not_equal_to{}, int64_t);
+NE_Tup_Ctx_f: CMP_TUP_CTX(std::not_equal_to{}, float);
+NE_Tup_Ctx_d: CMP_TUP_CTX(std::not_equal_to{}, double);
+
+LT_Tup_Ctx_i: CMP_TUP_CTX(std::less{}, int64_t);
+LT_Tup_Ctx_f: CMP_TUP_CTX(std::less{}, float);
+LT_Tup_Ctx_d: CMP_TUP_CTX(std::less{}, double);
+
+GT_Tup_Ctx_i: CMP_TUP_CTX(std::greater{}, int64_t);
+GT_Tup_Ctx_f: CMP_TUP_CTX(std::greater{}, float);
+GT_Tup_Ctx_d: CMP_TUP_CTX(std::greater{}, double);
+
+LE_Tup_Ctx_i: CMP_TUP_CTX(std::less_equal{}, int64_t);
+LE_Tup_Ctx_f: CMP_TUP_CTX(std::less_equal{}, float);
+LE_Tup_Ctx_d: CMP_TUP_CTX(std::less_equal{}, double);
+
+GE_Tup_Ctx_i: CMP_TUP_CTX(std::greater_equal{}, int64_t);
+GE_Tup_Ctx_f: CMP_TUP_CTX(std::greater_equal{}, float);
+GE_Tup_Ctx_d: CMP_TUP_CTX(std::greater_equal{}, double);
+
+#undef CMP_TUP_CTX
+
+#define LD_TUP_CAST(TO_TYPE, FROM_TYPE) { \
+    std::size_t tuple_id = std::size_t(*op_++); \
+    std::size_t index = std::size_t(*op_++); \
+    auto &t = *tuples[tuple_id]; \
+    PUSH((TO_TYPE)(t[index].as<FROM_TYPE>()), t.is_null(index)); \
+} \
+NEXT;
+
+Ld_Tup_Cast_f_i: LD_TUP_CAST(float,  int64_t);
+Ld_Tup_Cast_d_i: LD_TUP_CAST(double, int64_t);
+Ld_Tup_Cast_d_f: LD_TUP_CAST(double, float);
+
+#undef LD_TUP_CAST
+
+Cp_Tup: {
+    std::size_t from_tuple_id = std::size_t(*op_++);
+    std::size_t from_index = std::size_t(*op_++);
+    std::size_t to_tuple_id = std::size_t(*op_++);
+    std::size_t to_index = std::size_t(*op_++);
+    auto &from = *tuples[from_tuple_id];
+    tuples[to_tuple_id]->set(to_index, from[from_index], from.is_null(from_index));
+}
+NEXT;
+
+#define LD_CTX_ST_TUP(TO_TYPE, FROM_TYPE) { \
+    std::size_t idx = std::size_t(*op_++); \
+    std::size_t tuple_id = std::size_t(*op_++); \
+    std::size_t index = std::size_t(*op_++); \
+    M_insist(idx < context_.size(), "index out of bounds"); \
+    const void *ptr = context_[idx].as_p(); \
+    tuples[tuple_id]->set(index, (TO_TYPE)(*reinterpret_cast<const FROM_TYPE*>(ptr)), false); \
+} \
+NEXT;
+
+Ld_Ctx_St_Tup_i8:  LD_CTX_ST_TUP(int64_t, int8_t);
+Ld_Ctx_St_Tup_i16: LD_CTX_ST_TUP(int64_t, int16_t);
+Ld_Ctx_St_Tup_i32: LD_CTX_ST_TUP(int64_t, int32_t);
+Ld_Ctx_St_Tup_i64: LD_CTX_ST_TUP(int64_t, int64_t);
+Ld_Ctx_St_Tup_f:   LD_CTX_ST_TUP(float,   float);
+Ld_Ctx_St_Tup_d:   LD_CTX_ST_TUP(double,  double);
+
+#undef LD_CTX_ST_TUP
+
+Add_Ctx_p: {
+    std::size_t stride = std::size_t(*op_++);
+    std::size_t ptr = std::size_t(*op_++);
+    M_insist(stride < context_.size(), "index out of bounds");
+    M_insist(ptr < context_.size(), "index out of bounds");
+    auto &context = const_cast<StackMachine*>(this)->context_;
+    context[ptr] = context[stride].as<int64_t>() + reinterpret_cast<uint8_t*>(context[ptr].as_p());
+}
+NEXT;
+
+Inc_Ctx: {
+    std::size_t idx = std::size_t(*op_++);
+    M_insist(idx < context_.size(), "index out of bounds");
+    auto &context = const_cast<StackMachine*>(this)->context_;
+    context[idx] = context[idx].as<int64_t>() + 1;
+}
+NEXT;
+
 Stop:
     const_cast<StackMachine*>(this)->ops.pop_back(); // terminating Stop
 
@@ -1570,43 +1923,8 @@ void StackMachine::dump(std::ostream &out) const
             out << "        ";
         out << "[0x" << std::hex << std::setfill('0') << std::setw(4) << i << std::dec << "]: "
             << StackMachine::OPCODE_TO_STR[static_cast<std::size_t>(opc)];
-        switch (opc) {
-            /* Opcodes with *three* operands. */
-            case Opcode::St_Tup_s:
-                ++i;
-                out << ' ' << static_cast<int64_t>(ops[i]);
-                /* fall through */
-
-            /* Opcodes with *two* operands. */
-            case Opcode::Ld_Tup:
-            case Opcode::St_Tup_Null:
-            case Opcode::St_Tup_i:
-            case Opcode::St_Tup_f:
-            case Opcode::St_Tup_d:
-            case Opcode::St_Tup_b:
-            case Opcode::Putc:
-                ++i;
-                out << ' ' << static_cast<int64_t>(ops[i]);
-                /* fall through */
-
-            /* Opcodes with *one* operand. */
-            case Opcode::Ld_Ctx:
-            case Opcode::Upd_Ctx:
-            case Opcode::Print_i:
-            case Opcode::Print_f:
-            case Opcode::Print_d:
-            case Opcode::Print_s:
-            case Opcode::Print_b:
-            case Opcode::Ld_s:
-            case Opcode::Ld_b:
-            case Opcode::St_s:
-            case Opcode::St_b:
-                ++i;
-                out << ' ' << static_cast<int64_t>(ops[i]);
-                /* fall through */
-
-            default:;
-        }
+        for (std::size_t operands = NUM_OPERANDS[static_cast<std::size_t>(opc)]; operands; --operands)
+            out << ' ' << static_cast<int64_t>(ops[++i]);
         out << '\n';
     }
     out << "    Stack:\n";
@@ -33,6 +33,7 @@ struct StackMachine
     {
 #define M_OPCODE(CODE, ...) CODE,
 #include "tables/Opcodes.tbl"
+#include "tables/Superinstructions.tbl"
 #undef M_OPCODE
         Last
     };
@@ -44,6 +45,7 @@ struct StackMachine
     static constexpr const char *OPCODE_TO_STR[] = {
 #define M_OPCODE(CODE, ...) #CODE,
 #include "tables/Opcodes.tbl"
+#include "tables/Superinstructions.tbl"
 #undef M_OPCODE
     };
     static const std::unordered_map<std::string, Opcode> STR_TO_OPCODE;
@@ -61,6 +63,7 @@ struct StackMachine
     std::vector<Value> context_; ///< the context of the stack machine, e.g. constants or global variables
     int64_t required_stack_size_ = 0; ///< the required size of the stack
     int64_t current_stack_size_ = 0; ///< the "current" stack size; i.e. after the last operation is executed
+    std::size_t num_fused_ops_ = 0; ///< the number of operations in `ops` after the last run of `fuse()`
 
     /*----- Fields capturing the internal state during execution. ----------------------------------------------------*/
     mutable Value *values_ = nullptr; ///< array of values used as a stack
@@ -87,7 +90,17 @@ struct StackMachine
      * evaluates exactly one CNF formula. */
     StackMachine(Schema in_schema, const cnf::CNF &cnf);
 
-    StackMachine(const StackMachine&) = delete;
+    /** Copies the opcode sequence and the context of \p other but not its state of execution, s.t. the copy can be
+     * evaluated independently of \p other. */
+    StackMachine(const StackMachine &other)
+        : in_schema(other.in_schema)
+        , out_schema(other.out_schema)
+        , ops(other.ops)
+        , context_(other.context_)
+        , required_stack_size_(other.required_stack_size_)
+        , current_stack_size_(other.current_stack_size_)
+        , num_fused_ops_(other.num_fused_ops_)
+    { }
     StackMachine(StackMachine&&) = default;
 
     ~StackMachine() {
@@ -132,12 +145,14 @@ struct StackMachine
      * with the index of the context value.  The macro will expand to the method `emit_Ld_Ctx(uint8_t idx)`, that first
      * appends the `Ld_Ctx` opcode to the opcode sequence and then appends the `idx` parameter to the opcode sequence.
      */
-#define SELECT(XXX, _1, _2, _3, FN, ...) FN(__VA_ARGS__)
+#define SELECT(XXX, _1, _2, _3, _4, FN, ...) FN(__VA_ARGS__)
 #define ARGS_0(XXX, ...)
 #define ARGS_1(I, XXX, ARG0, ...) uint8_t ARG0
 #define ARGS_2(I, II, XXX, ARG0, ARG1, ...) uint8_t ARG0, uint8_t ARG1
 #define ARGS_3(I, II, III, XXX, ARG0, ARG1, ARG2, ...) uint8_t ARG0, uint8_t ARG1, uint8_t ARG2
-#define ARGS(...) SELECT(__VA_ARGS__, ARGS_3, ARGS_2, ARGS_1, ARGS_0, __VA_ARGS__)
+#define ARGS_4(I, II, III, IV, XXX, ARG0, ARG1, ARG2, ARG3, ...) \
+    uint8_t ARG0, uint8_t ARG1, uint8_t ARG2, uint8_t ARG3
+#define ARGS(...) SELECT(__VA_ARGS__, ARGS_4, ARGS_3, ARGS_2, ARGS_1, ARGS_0, __VA_ARGS__)
 #define PUSH_0(XXX, ...)
 #define PUSH_1(I, XXX, ARG0, ...) \
     ops.push_back(static_cast<Opcode>((ARG0)));
@@ -148,7 +163,12 @@ struct StackMachine
     ops.push_back(static_cast<Opcode>((ARG0))); \
     ops.push_back(static_cast<Opcode>((ARG1))); \
     ops.push_back(static_cast<Opcode>((ARG2)));
-#define PUSH(...) SELECT(__VA_ARGS__, PUSH_3, PUSH_2, PUSH_1, PUSH_0, __VA_ARGS__)
+#define PUSH_4(I, II, III, IV, XXX, ARG0, ARG1, ARG2, ARG3, ...) \
+    ops.push_back(static_cast<Opcode>((ARG0))); \
+    ops.push_back(static_cast<Opcode>((ARG1))); \
+    ops.push_back(static_cast<Opcode>((ARG2))); \
+    ops.push_back(static_cast<Opcode>((ARG3)));
+#define PUSH(...) SELECT(__VA_ARGS__, PUSH_4, PUSH_3, PUSH_2, PUSH_1, PUSH_0, __VA_ARGS__)
 
 #define M_OPCODE(CODE, DELTA, ...) \
     void emit_ ## CODE ( ARGS(XXX, ##__VA_ARGS__) ) { \
@@ -160,16 +180,21 @@ struct StackMachine
     }
 
 #include "tables/Opcodes.tbl"
+#include "tables/Superinstructions.tbl"
 
 #undef M_OPCODE
 #undef SELECT
 #undef ARGS_0
 #undef ARGS_1
 #undef ARGS_2
+#undef ARGS_3
+#undef ARGS_4
 #undef ARGS
 #undef PUSH_0
 #undef PUSH_1
 #undef PUSH_2
+#undef PUSH_3
+#undef PUSH_4
 #undef PUSH
 
     /** Append the given opcode to the opcode sequence. */
@@ -211,6 +236,10 @@ struct StackMachine
         return idx;
     }
 
+    /** Replaces common opcode sequences of `ops` by their superinstruction, see `tables/Superinstructions.tbl`.  This
+     * peephole pass runs automatically before evaluating operations emitted since its last run. */
+    void fuse();
+
     /** Evaluate this `StackMachine` given the `Tuple`s referenced by `tuples`.
      *
      * By convention, the *output* `Tuple`s should be given before the *input* `Tuple`s.  However, a `Tuple` can be used
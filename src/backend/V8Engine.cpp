@@ -1,8 +1,12 @@
 #include "backend/V8Engine.hpp"
 
 #include "backend/Interpreter.hpp"
+#include "backend/ResultWriter.hpp"
 #include "backend/WasmOperator.hpp"
 #include "backend/WasmUtil.hpp"
+#include "catalog/Compaction.hpp"
+#include "catalog/NullFreeColumns.hpp"
+#include "catalog/QueryCancellation.hpp"
 #include "mutable/util/macro.hpp"
 #include "storage/Store.hpp"
 #include <chrono>
@@ -13,6 +17,8 @@
 #include <fstream>
 #include <fstream>
 #include <libplatform/libplatform.h>
+#include <list>
+#include <mutex>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/IR/PhysicalOptimizer.hpp>
 #include <mutable/IR/Tuple.hpp>
@@ -23,9 +29,12 @@
 #include <mutable/util/enum_ops.hpp>
 #include <mutable/util/memory.hpp>
 #include <mutable/util/Timer.hpp>
+#include <numeric>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string_view>
+#include <unordered_map>
 #include <unordered_set>
 
 // must be included after Binaryen due to conflicts, e.g. with `::wasm::Throw`
@@ -47,18 +56,120 @@ namespace options {
 int wasm_optimization_level = 0;
 /** Whether to execute Wasm adaptively. */
 bool wasm_adaptive = false;
+/** The estimated number of tuples processed by a query from which on its Wasm module is compiled eagerly by TurboFan
+ * rather than lazily by Liftoff.  0 disables the cardinality-aware choice of the tiering strategy. */
+std::size_t wasm_adaptive_threshold = 0;
 /** Whether compilation cache should be enabled. */
 bool wasm_compilation_cache = true;
+/** Whether the V8 context providing the host functions is created once and reused by all executions. */
+bool wasm_context_reuse = true;
+/** Whether the Binaryen module of an execution is reset and reused by the next execution rather than created anew. */
+bool wasm_module_reuse = true;
+/** Whether functions are compiled lazily by TurboFan on their first call rather than all before execution starts, s.t.
+ * the first pipeline runs while later pipelines are not compiled yet. */
+bool wasm_lazy_compilation = false;
+/** The estimated number of tuples processed by a function from which on the function is optimized by Binaryen.  0
+ * optimizes the entire module. */
+std::size_t wasm_opt_hot_threshold = 0;
+/** Whether functions that are identical or differ only in constants are merged before optimization.  Merging loses the
+ * names of the merged functions, which perf maps and the selection of hot functions rely on. */
+bool wasm_function_dedup = false;
 /** Whether to dump the generated WebAssembly code. */
 bool wasm_dump = false;
 /** Whether to dump the generated assembly code. */
 bool asm_dump = false;
+/** Whether to write the names and addresses of the generated machine code for Linux `perf`. */
+bool perf_map = false;
 /** The port to use for the Chrome DevTools web socket. */
 uint16_t cdt_port = 0;
+/** The maximal number of compiled modules kept in the module cache.  0 disables the cache. */
+std::size_t wasm_module_cache_capacity = 0;
+/** Whether numeric and date constants are read from imported globals when the module cache is enabled, s.t. a cached
+ * module serves all queries which differ only in these constants. */
+bool wasm_late_bound_constants = true;
 
 }
 
 
+/*======================================================================================================================
+ * ModuleCache
+ *====================================================================================================================*/
+
+/** A least-recently-used cache of compiled WebAssembly modules.  Entries are keyed by a fingerprint of the physical
+ * plan, see `ModuleCache::Fingerprint()`, s.t. repeated executions of the same plan skip code generation and
+ * compilation of WebAssembly to machine code. */
+struct ModuleCache
+{
+    struct entry_type
+    {
+        ///> the compiled module, independent of any V8 context
+        v8::CompiledWasmModule module;
+        ///> the factory of the result set layout set during code generation, if any
+        std::unique_ptr<const storage::DataLayoutFactory> result_set_factory;
+        ///> the morsel size of each morsel queue created during code generation
+        std::vector<uint32_t> morsel_sizes;
+        ///> the address and the contents of each memory region written during code generation, e.g. LIKE patterns
+        std::vector<std::pair<uint32_t, std::string>> raw_memory;
+    };
+
+    private:
+    using list_type = std::list<std::pair<std::string, entry_type>>;
+    ///> the cached entries in least-recently-used order, i.e. the most recently used entry first
+    list_type entries_;
+    ///> maps a fingerprint to its entry in `entries_`
+    std::unordered_map<std::string_view, list_type::iterator> lookup_;
+    std::size_t num_hits_ = 0; ///< number of successful lookups
+    std::size_t num_misses_ = 0; ///< number of failed lookups
+    std::size_t num_evictions_ = 0; ///< number of entries evicted to make room for new ones
+
+    public:
+    /** Computes the fingerprint of \p plan.  The fingerprint comprises the physical plan, all expressions of the
+     * logical plan, the size and data version of each scanned table, and the options affecting code generation.  If
+     * constants are bound late, their values are masked in the fingerprint and the constants are appended to
+     * \p parameters in a canonical order, i.e. plans with equal fingerprints yield their parameters in the same order.
+     */
+    static std::string Fingerprint(const m::MatchBase &plan, std::vector<const ast::Constant*> &parameters);
+
+    std::size_t capacity() const { return options::wasm_module_cache_capacity; }
+    std::size_t size() const { return entries_.size(); }
+    std::size_t num_hits() const { return num_hits_; }
+    std::size_t num_misses() const { return num_misses_; }
+    std::size_t num_evictions() const { return num_evictions_; }
+
+    /** Returns the entry for \p fingerprint and marks it most recently used, or `nullptr` if there is no such
+     * entry. */
+    const entry_type * find(const std::string &fingerprint) {
+        auto it = lookup_.find(fingerprint);
+        if (it == lookup_.end()) {
+            ++num_misses_;
+            return nullptr;
+        }
+        ++num_hits_;
+        entries_.splice(entries_.begin(), entries_, it->second); // move to front
+        return &it->second->second;
+    }
+
+    /** Adds \p entry for \p fingerprint, evicting the least recently used entries if the cache is full. */
+    void insert(std::string fingerprint, entry_type entry) {
+        M_insist(not lookup_.contains(fingerprint), "fingerprint already cached");
+        if (capacity() == 0)
+            return;
+        while (entries_.size() >= capacity()) {
+            lookup_.erase(entries_.back().first);
+            entries_.pop_back();
+            ++num_evictions_;
+        }
+        entries_.emplace_front(std::move(fingerprint), std::move(entry));
+        lookup_.emplace(entries_.front().first, entries_.begin());
+    }
+
+    void print_statistics(std::ostream &out) const {
+        out << "Wasm module cache: " << num_hits_ << " hits, " << num_misses_ << " misses, " << num_evictions_
+            << " evictions, " << entries_.size() << " of " << capacity() << " entries used" << std::endl;
+    }
+};
+
+
 /*======================================================================================================================
  * V8Engine
  *====================================================================================================================*/
@@ -67,7 +178,6 @@ uint16_t cdt_port = 0;
  * engine] (https://v8.dev/). */
 struct V8Engine : m::WasmEngine
 {
-    friend void create_V8Engine();
     friend void destroy_V8Engine();
     friend void register_WasmV8();
 
@@ -79,6 +189,13 @@ struct V8Engine : m::WasmEngine
     /*----- Objects for remote debugging via CDT. --------------------------------------------------------------------*/
     std::unique_ptr<V8InspectorClientImpl> inspector_;
 
+    ///> the cache of compiled modules of previously executed plans
+    ModuleCache module_cache_;
+    ///> the context with the host functions, created once and reused by all executions unless debugging via CDT
+    v8::Global<v8::Context> context_;
+    ///> the module of the previous execution, reset for reuse by the next one, see `Module::Release()`
+    std::unique_ptr<Module> spare_module_;
+
     public:
     V8Engine();
     V8Engine(const V8Engine&) = delete;
@@ -94,6 +211,21 @@ struct V8Engine : m::WasmEngine
     void initialize();
     void compile(const m::MatchBase &plan) const override;
     void execute(const m::MatchBase &plan) override;
+
+    private:
+    /** Creates a new context whose global object provides the host functions, e.g. for index accesses.  Requires an
+     * entered isolate and a `v8::HandleScope`. */
+    v8::Local<v8::Context> new_context();
+
+    /** Disposes of the `CodeGenContext` and the `Module` of an execution.  The module is kept for the next execution,
+     * unless `--no-wasm-module-reuse`. */
+    void dispose_module() {
+        CodeGenContext::Dispose();
+        if (options::wasm_module_reuse)
+            spare_module_ = Module::Release();
+        else
+            Module::Dispose();
+    }
 };
 
 
@@ -284,9 +416,42 @@ void m::wasm::detail::print_memory_consumption(const v8::FunctionCallbackInfo<v8
 
     auto alloc_total_mem = info[0].As<v8::Uint32>()->Value();
     auto alloc_peak_mem = info[1].As<v8::Uint32>()->Value();
+    auto alloc_fragmented_mem = info[2].As<v8::Uint32>()->Value();
 
     std::cout << "Allocated memory overall consumption: " << alloc_total_mem / (1024.0 * 1024.0) << " MiB"<< std::endl;
     std::cout << "Allocated memory peak consumption: " << alloc_peak_mem / (1024.0 * 1024.0) << " MiB"<< std::endl;
+    std::cout << "Allocated memory fragmentation: " << alloc_fragmented_mem / (1024.0 * 1024.0) << " MiB"<< std::endl;
+}
+
+void m::wasm::detail::report_tuple_count(const v8::FunctionCallbackInfo<v8::Value> &info)
+{
+    M_insist(m::options::explain_analyze);
+
+    auto idx = info[0].As<v8::Uint32>()->Value();
+    auto num_tuples = info[1].As<v8::Uint32>()->Value();
+    OperatorTupleCounts::Get().record(idx, num_tuples);
+}
+
+void m::wasm::detail::report_selection_strategy(const v8::FunctionCallbackInfo<v8::Value> &info)
+{
+    M_insist(m::options::explain_analyze);
+
+    auto idx = info[0].As<v8::Uint32>()->Value();
+    OperatorSelectionStrategies::decision_t decision;
+    decision.mode = OperatorSelectionStrategies::mode_t(info[1].As<v8::Uint32>()->Value());
+    decision.num_sampled = info[2].As<v8::Uint32>()->Value();
+    decision.num_passed = info[3].As<v8::Uint32>()->Value();
+    OperatorSelectionStrategies::Get().record(idx, decision);
+}
+
+void m::wasm::detail::report_memory_consumption(const v8::FunctionCallbackInfo<v8::Value> &info)
+{
+    M_insist(OperatorMemoryConsumption::enabled());
+
+    auto idx = info[0].As<v8::Uint32>()->Value();
+    auto alloc_peak_mem = info[1].As<v8::Uint32>()->Value();
+    auto alloc_fragmented_mem = info[2].As<v8::Uint32>()->Value();
+    OperatorMemoryConsumption::Get().record(idx, alloc_peak_mem);
 }
 
 void m::wasm::detail::set_wasm_instance_raw_memory(const v8::FunctionCallbackInfo<v8::Value> &info)
@@ -348,85 +513,70 @@ void m::wasm::detail::read_result_set(const v8::FunctionCallbackInfo<v8::Value>
     };
     auto projection = find_projection(root_op);
 
-    ///> helper function to print given `ast::Constant` \p c of `Type` \p type to \p out
-    auto print_constant = [](std::ostringstream &out, const ast::Constant &c, const Type *type){
-        if (type->is_none()) {
-            out << "NULL";
+    /* Results are either passed to the callback or printed. */
+    auto callback_op = cast<const CallbackOperator>(&root_op);
+    auto print_op = cast<const PrintOperator>(&root_op);
+    if (not callback_op and not print_op)
+        return;
+
+    /* Export results as Arrow record batches or decode them column-at-a-time if requested or printed. */
+    const bool export_to_arrow = callback_op and m::options::arrow_result_set_callback;
+    if (export_to_arrow or print_op or m::options::result_set_batch_callback) {
+        std::vector<const ast::Constant*> constants(schema.num_entries(), nullptr);
+        for (std::size_t i = 0; i < schema.num_entries(); ++i) {
+            auto &e = schema[i];
+            if (e.id.is_constant() and not e.type->is_none()) {
+                M_insist(bool(projection), "projection must be found");
+                constants[i] = &as<const ast::Constant>(projection->projections()[i].first);
+            }
+        }
+        std::optional<DataLayout> layout;
+        if (deduplicated_schema_without_constants.num_entries() != 0) {
+            M_insist(bool(context.result_set_factory), "result set factory must be set");
+            layout.emplace(context.result_set_factory->make(deduplicated_schema_without_constants));
+        }
+
+        if (export_to_arrow) {
+            export_result_set_to_arrow(schema, deduplicated_schema_without_constants, layout ? &*layout : nullptr,
+                                       layout ? result_set : nullptr, num_tuples, constants,
+                                       m::options::arrow_result_set_callback);
             return;
         }
 
-        /* Interpret constant. */
-        auto value = Interpreter::eval(c);
-
-        visit(overloaded {
-            [&](const Boolean&) { out << (value.as_b() ? "TRUE" : "FALSE"); },
-            [&](const Numeric &n) {
-                switch (n.kind) {
-                    case Numeric::N_Int:
-                    case Numeric::N_Decimal:
-                        out << value.as_i();
-                        break;
-                    case Numeric::N_Float:
-                        if (n.size() <= 32) {
-                            const auto old_precision = out.precision(std::numeric_limits<float>::max_digits10 - 1);
-                            out << value.as_f();
-                            out.precision(old_precision);
-                        } else {
-                            const auto old_precision = out.precision(std::numeric_limits<double>::max_digits10 - 1);
-                            out << value.as_d();
-                            out.precision(old_precision);
-                        }
-                }
-            },
-            [&](const CharacterSequence&) { out << '"' << reinterpret_cast<char*>(value.as_p()) << '"'; },
-            [&](const Date&) {
-                const int32_t date = value.as_i(); // signed because year is signed
-                const auto oldfill = out.fill('0');
-                const auto oldfmt = out.flags();
-                out << std::internal
-                    << std::setw(date >> 9 > 0 ? 4 : 5) << (date >> 9) << '-'
-                    << std::setw(2) << ((date >> 5) & 0xF) << '-'
-                    << std::setw(2) << (date & 0x1F);
-                out.fill(oldfill);
-                out.flags(oldfmt);
-            },
-            [&](const DateTime&) {
-                const time_t time = value.as_i();
-                std::tm tm;
-                gmtime_r(&time, &tm);
-                out << put_tm(tm);
-            },
-            [](const NoneType&) { M_unreachable("should've been handled earlier"); },
-            [](auto&&) { M_unreachable("invalid type"); },
-        }, *type);
-    };
+        ResultSetDecoder decoder(schema, deduplicated_schema_without_constants, layout ? &*layout : nullptr,
+                                 constants);
+        ResultColumns columns(schema); // reused for all batches
+        std::optional<ResultWriter> writer;
+        if (print_op)
+            writer.emplace(print_op->out, schema);
+        const std::size_t batch_size = std::max<std::size_t>(m::options::result_set_batch_size, 1);
+        for (std::size_t first = 0; first < num_tuples; first += batch_size) {
+            decoder.decode(layout ? result_set : nullptr, first, std::min<std::size_t>(batch_size, num_tuples - first),
+                           columns);
+            if (writer)
+                writer->write(columns);
+            else
+                m::options::result_set_batch_callback(columns);
+        }
+        return;
+    }
+
+    ///> helper function to pass the result tuple \p tup to the callback
+    auto emit_result = [&](const Tuple &tup) { callback_op->callback()(schema, tup); };
 
     if (deduplicated_schema_without_constants.num_entries() == 0) {
         /* Schema contains only constants. Create simple loop to generate `num_tuples` constant result tuples. */
         M_insist(bool(projection), "projection must be found");
         auto &projections = projection->projections();
-        if (auto callback_op = cast<const CallbackOperator>(&root_op)) {
-            Tuple tup(schema); // tuple entries which are not set are implicitly NULL
-            for (std::size_t i = 0; i < schema.num_entries(); ++i) {
-                auto &e = schema[i];
-                if (e.type->is_none()) continue; // NULL constant
-                M_insist(e.id.is_constant());
-                tup.set(i, Interpreter::eval(as<const ast::Constant>(projections[i].first)));
-            }
-            for (std::size_t i = 0; i < num_tuples; ++i)
-                callback_op->callback()(schema, tup);
-        } else if (auto print_op = cast<const PrintOperator>(&root_op)) {
-            std::ostringstream tup;
-            for (std::size_t i = 0; i < schema.num_entries(); ++i) {
-                auto &e = schema[i];
-                if (i)
-                    tup << ',';
-                M_insist(e.id.is_constant());
-                print_constant(tup, as<const ast::Constant>(projections[i].first), e.type);
-            }
-            for (std::size_t i = 0; i < num_tuples; ++i)
-                print_op->out << tup.str() << '\n';
+        Tuple tup(schema); // tuple entries which are not set are implicitly NULL
+        for (std::size_t i = 0; i < schema.num_entries(); ++i) {
+            auto &e = schema[i];
+            if (e.type->is_none()) continue; // NULL constant
+            M_insist(e.id.is_constant());
+            tup.set(i, Interpreter::eval(as<const ast::Constant>(projections[i].first)));
         }
+        for (std::size_t i = 0; i < num_tuples; ++i)
+            emit_result(tup);
         return;
     }
 
@@ -435,102 +585,70 @@ void m::wasm::detail::read_result_set(const v8::FunctionCallbackInfo<v8::Value>
     auto layout = context.result_set_factory->make(deduplicated_schema_without_constants);
 
     /* Extract results. */
-    if (auto callback_op = cast<const CallbackOperator>(&root_op)) {
-        auto loader = Interpreter::compile_load(deduplicated_schema_without_constants, result_set, layout,
-                                                deduplicated_schema_without_constants);
-        if (schema.num_entries() == deduplicated_schema.num_entries()) {
-            /* No deduplication was performed. Compute `Tuple` with constants. */
-            M_insist(schema == deduplicated_schema);
-            Tuple tup(schema); // tuple entries which are not set are implicitly NULL
-            for (std::size_t i = 0; i < schema.num_entries(); ++i) {
-                auto &e = schema[i];
-                if (e.type->is_none()) continue; // NULL constant
-                if (e.id.is_constant()) { // other constant
-                    M_insist(bool(projection), "projection must be found");
-                    tup.set(i, Interpreter::eval(as<const ast::Constant>(projection->projections()[i].first)));
-                }
-            }
-            Tuple *args[] = { &tup };
-            for (std::size_t i = 0; i != num_tuples; ++i) {
-                loader(args);
-                callback_op->callback()(schema, tup);
-                tup.clear();
-            }
-        } else {
-            /* Deduplication was performed. Compute a `Tuple` with duplicates and constants. */
-            Tuple tup_dedupl(deduplicated_schema_without_constants);
-            Tuple tup_dupl(schema); // tuple entries which are not set are implicitly NULL
-            for (std::size_t i = 0; i < schema.num_entries(); ++i) {
-                auto &e = schema[i];
-                if (e.type->is_none()) continue; // NULL constant
-                if (e.id.is_constant()) { // other constant
-                    M_insist(bool(projection), "projection must be found");
-                    tup_dupl.set(i, Interpreter::eval(as<const ast::Constant>(projection->projections()[i].first)));
-                }
-            }
-            Tuple *args[] = { &tup_dedupl, &tup_dupl };
-            for (std::size_t i = 0; i != deduplicated_schema_without_constants.num_entries(); ++i) {
-                auto &entry = deduplicated_schema_without_constants[i];
-                if (not entry.type->is_none())
-                    loader.emit_Ld_Tup(0, i);
-                for (std::size_t j = 0; j != schema.num_entries(); ++j) {
-                    auto &e = schema[j];
-                    if (e.id == entry.id) {
-                        M_insist(e.type == entry.type);
-                        loader.emit_St_Tup(1, j, e.type);
-                    }
-                }
-                if (not entry.type->is_none())
-                    loader.emit_Pop();
-            }
-            for (std::size_t i = 0; i != num_tuples; ++i) {
-                loader(args);
-                callback_op->callback()(schema, tup_dupl);
+    auto loader = Interpreter::compile_load(deduplicated_schema_without_constants, result_set, layout,
+                                            deduplicated_schema_without_constants);
+    if (schema.num_entries() == deduplicated_schema.num_entries()) {
+        /* No deduplication was performed. Compute `Tuple` with constants. */
+        M_insist(schema == deduplicated_schema);
+        Tuple tup(schema); // tuple entries which are not set are implicitly NULL
+        for (std::size_t i = 0; i < schema.num_entries(); ++i) {
+            auto &e = schema[i];
+            if (e.type->is_none()) continue; // NULL constant
+            if (e.id.is_constant()) { // other constant
+                M_insist(bool(projection), "projection must be found");
+                tup.set(i, Interpreter::eval(as<const ast::Constant>(projection->projections()[i].first)));
             }
         }
-    } else if (auto print_op = cast<const PrintOperator>(&root_op)) {
-        /* Compute a `Tuple` with duplicates and constants. */
-        Tuple tup(deduplicated_schema_without_constants);
         Tuple *args[] = { &tup };
-        auto printer = Interpreter::compile_load(deduplicated_schema_without_constants, result_set, layout,
-                                                 deduplicated_schema_without_constants);
-        auto ostream_index = printer.add(&print_op->out);
-        bool constant_emitted = false;
-        std::size_t old_idx = -1UL;
-        for (std::size_t i = 0; i != schema.num_entries(); ++i) {
-            if (i != 0)
-                printer.emit_Putc(ostream_index, ',');
+        for (std::size_t i = 0; i != num_tuples; ++i) {
+            loader(args); // overwrites all non-constant entries, including their NULL bits
+            emit_result(tup);
+        }
+    } else {
+        /* Deduplication was performed. Compute a `Tuple` with duplicates and constants. */
+        Tuple tup_dedupl(deduplicated_schema_without_constants);
+        Tuple tup_dupl(schema); // tuple entries which are not set are implicitly NULL
+        for (std::size_t i = 0; i < schema.num_entries(); ++i) {
             auto &e = schema[i];
-            if (not e.type->is_none()) {
-                if (e.id.is_constant()) { // constant except NULL
-                    M_insist(bool(projection), "projection must be found");
-                    printer.add_and_emit_load(Interpreter::eval(as<const ast::Constant>(projection->projections()[i].first)));
-                    constant_emitted = true;
-                } else { // actual value
-                    auto idx = deduplicated_schema_without_constants[e.id].first;
-                    if (idx != old_idx) {
-                        if (old_idx != -1UL)
-                            printer.emit_Pop(); // to remove last loaded value
-                        printer.emit_Ld_Tup(0, idx);
-                        old_idx = idx;
-                    }
-                }
+            if (e.type->is_none()) continue; // NULL constant
+            if (e.id.is_constant()) { // other constant
+                M_insist(bool(projection), "projection must be found");
+                tup_dupl.set(i, Interpreter::eval(as<const ast::Constant>(projection->projections()[i].first)));
             }
-            printer.emit_Print(ostream_index, e.type);
-            if (e.type->is_none() or constant_emitted) {
-                printer.emit_Pop(); // to remove NULL pushed by `emit_Print()` or other constant pushed above
-                constant_emitted = false;
+        }
+        Tuple *args[] = { &tup_dedupl, &tup_dupl };
+        for (std::size_t i = 0; i != deduplicated_schema_without_constants.num_entries(); ++i) {
+            auto &entry = deduplicated_schema_without_constants[i];
+            if (not entry.type->is_none())
+                loader.emit_Ld_Tup(0, i);
+            for (std::size_t j = 0; j != schema.num_entries(); ++j) {
+                auto &e = schema[j];
+                if (e.id == entry.id) {
+                    M_insist(e.type == entry.type);
+                    loader.emit_St_Tup(1, j, e.type);
+                }
             }
+            if (not entry.type->is_none())
+                loader.emit_Pop();
         }
-        if (old_idx != -1UL)
-            printer.emit_Pop(); // to remove last loaded value
         for (std::size_t i = 0; i != num_tuples; ++i) {
-            printer(args);
-            print_op->out << '\n';
+            loader(args);
+            emit_result(tup_dupl);
         }
     }
 }
 
+void m::wasm::detail::next_morsel(const v8::FunctionCallbackInfo<v8::Value> &info)
+{
+    M_insist(info.Length() == 2);
+    auto queue_id = info[0].As<v8::Uint32>()->Value();
+    auto num_rows = info[1].As<v8::Uint32>()->Value();
+
+    /*----- Claim the next morsel of the respective scan and return its first row. -----*/
+    auto &queue = CodeGenContext::Get().morsel_queue(queue_id);
+    info.GetReturnValue().Set(queue.claim(num_rows));
+}
+
 template<typename Index, typename V8ValueT, bool IsLower>
 void m::wasm::detail::index_seek(const v8::FunctionCallbackInfo<v8::Value> &info)
 {
@@ -583,6 +701,61 @@ void m::wasm::detail::index_sequential_scan(const v8::FunctionCallbackInfo<v8::V
         buffer_address[i] = it->second;
 }
 
+template<typename Index>
+void m::wasm::detail::index_seek_batch(const v8::FunctionCallbackInfo<v8::Value> &info)
+{
+    using key_type = Index::key_type;
+    static_assert(m::arithmetic<key_type>, "keys are read from Wasm memory as is");
+
+    /*----- Unpack function parameters -----*/
+    auto index_id = info[0].As<v8::BigInt>()->Uint64Value();
+    auto keys_offset = info[1].As<v8::Uint32>()->Value();
+    auto num_keys = info[2].As<v8::Uint32>()->Value();
+    auto ranges_offset = info[3].As<v8::Uint32>()->Value();
+
+    /*----- Compute addresses to read keys from and write ranges to. -----*/
+    auto &context = WasmEngine::Get_Wasm_Context_By_ID(Module::ID());
+    auto keys = reinterpret_cast<const key_type*>(context.vm.as<uint8_t*>() + keys_offset);
+    auto ranges = reinterpret_cast<uint32_t*>(context.vm.as<uint8_t*>() + ranges_offset);
+
+    /*----- Obtain index and cast to correct type. -----*/
+    auto &index = as<const Index>(context.indexes[index_id]);
+
+    /*----- Sort the keys indirectly to walk the index only once, in ascending key order. -----*/
+    std::vector<uint32_t> order(num_keys);
+    std::iota(order.begin(), order.end(), 0U);
+    std::sort(order.begin(), order.end(), [keys](uint32_t lhs, uint32_t rhs) { return keys[lhs] < keys[rhs]; });
+
+    /*----- Since keys are ascending, each search starts at the end of the previous range and gallops forward, i.e.
+     * doubles its step until overshooting, before binary searching the last step.  Hence, dense keys are resolved in
+     * (nearly) constant time each and the total cost is bounded by a single binary search per key. -----*/
+    const auto begin = index.begin();
+    const std::size_t num_entries = std::distance(begin, index.end());
+    auto gallop = [begin, num_entries](std::size_t first, auto is_before) -> std::size_t {
+        std::size_t step = 1;
+        while (first + step <= num_entries and is_before((begin + (first + step - 1))->first)) {
+            first += step; // all entries up to `first` are before
+            step *= 2;
+        }
+        auto it = std::partition_point(begin + first, begin + std::min(first + step, num_entries),
+                                       [&is_before](const auto &e) { return is_before(e.first); });
+        return std::distance(begin, it);
+    };
+
+    /*----- Seek index for each key and write the offsets of its range of equal keys to `ranges`. -----*/
+    std::size_t lo = 0, hi = 0;
+    for (uint32_t i = 0; i != num_keys; ++i) {
+        const key_type key = keys[order[i]];
+        if (i == 0 or keys[order[i - 1]] != key) { // duplicate keys reuse the previous range
+            lo = gallop(hi, [key](const key_type k) { return k < key; });
+            hi = gallop(lo, [key](const key_type k) { return k <= key; });
+        }
+        M_insist(std::in_range<uint32_t>(hi), "should fit in uint32_t");
+        ranges[2 * order[i]]     = uint32_t(lo);
+        ranges[2 * order[i] + 1] = uint32_t(hi);
+    }
+}
+
 
 /*======================================================================================================================
  * V8Engine helper classes
@@ -722,15 +895,298 @@ struct CollectTables : ConstOperatorVisitor
 };
 
 
+/** Prints a canonical representation of a logical plan, including all its expressions and the sizes of scanned
+ * tables.  Late-bindable constants are optionally masked and collected as parameters. */
+struct PrintCanonicalPlan : ConstOperatorVisitor, ast::ConstASTExprVisitor
+{
+    private:
+    std::ostream &out_;
+    ///> the collected parameters, i.e. late-bound constants; `nullptr` if constants are not bound late
+    std::vector<const ast::Constant*> *parameters_;
+
+    public:
+    static void Print(std::ostream &out, const Operator &plan, std::vector<const ast::Constant*> *parameters) {
+        PrintCanonicalPlan P(out, parameters);
+        P(plan);
+    }
+
+    private:
+    PrintCanonicalPlan(std::ostream &out, std::vector<const ast::Constant*> *parameters)
+        : out_(out), parameters_(parameters)
+    { }
+
+    using ConstOperatorVisitor::operator();
+    using ConstASTExprVisitor::operator();
+
+    void recurse(const Consumer &C) {
+        out_ << " (";
+        for (auto &c: C.children())
+            (*this)(*c);
+        out_ << ')';
+    }
+
+    /*----- Operator -------------------------------------------------------------------------------------------------*/
+    void operator()(const ScanOperator &op) override {
+        out_ << " scan " << op.store().table().name() << ' ' << op.alias() << ' ' << op.store().num_rows() << ' '
+             << Compaction::Get().data_version(op.store().table());
+    }
+    void operator()(const CallbackOperator &op) override { out_ << " callback"; recurse(op); }
+    void operator()(const PrintOperator &op) override { out_ << " print"; recurse(op); }
+    void operator()(const NoOpOperator &op) override { out_ << " noop"; recurse(op); }
+    void operator()(const FilterOperator &op) override {
+        out_ << " filter ";
+        (*this)(op.filter());
+        recurse(op);
+    }
+    void operator()(const DisjunctiveFilterOperator &op) override {
+        out_ << " disjunctive_filter ";
+        (*this)(op.filter());
+        recurse(op);
+    }
+    void operator()(const JoinOperator &op) override {
+        out_ << " join ";
+        (*this)(op.predicate());
+        recurse(op);
+    }
+    void operator()(const ProjectionOperator &op) override {
+        out_ << " projection";
+        for (auto &p : op.projections()) {
+            out_ << ' ';
+            (*this)(p.first.get());
+            if (p.second.has_value())
+                out_ << " AS " << p.second;
+        }
+        recurse(op);
+    }
+    void operator()(const LimitOperator &op) override {
+        out_ << " limit " << op.limit() << ' ' << op.offset();
+        recurse(op);
+    }
+    void operator()(const GroupingOperator &op) override {
+        out_ << " grouping";
+        for (auto &[grp, alias] : op.group_by()) {
+            out_ << ' ';
+            (*this)(grp.get());
+            if (alias.has_value())
+                out_ << " AS " << alias;
+        }
+        out_ << " ;";
+        for (auto &agg : op.aggregates()) {
+            out_ << ' ';
+            (*this)(agg.get());
+        }
+        recurse(op);
+    }
+    void operator()(const AggregationOperator &op) override {
+        out_ << " aggregation";
+        for (auto &agg : op.aggregates()) {
+            out_ << ' ';
+            (*this)(agg.get());
+        }
+        recurse(op);
+    }
+    void operator()(const SortingOperator &op) override {
+        out_ << " sorting";
+        for (auto &[expr, ascending] : op.order_by()) {
+            out_ << ' ';
+            (*this)(expr.get());
+            out_ << (ascending ? " ASC" : " DESC");
+        }
+        recurse(op);
+    }
+
+    /*----- CNF ------------------------------------------------------------------------------------------------------*/
+    void operator()(const cnf::CNF &cnf) {
+        out_ << '[';
+        for (auto &clause: cnf) {
+            out_ << '[';
+            for (auto &pred: clause) {
+                out_ << (pred.negative() ? " NOT " : " ");
+                (*this)(*pred);
+            }
+            out_ << ']';
+        }
+        out_ << ']';
+    }
+
+    /*----- Expr -----------------------------------------------------------------------------------------------------*/
+    void operator()(const ast::ErrorExpr&) override { M_unreachable("no errors at this stage"); }
+    void operator()(const ast::Designator &e) override {
+        if (e.table_name)
+            out_ << e.table_name.text << '.';
+        out_ << e.attr_name.text;
+    }
+    void operator()(const ast::Constant &e) override {
+        if (parameters_ and is_late_bindable(e)) {
+            out_ << '?' << *e.type();
+            parameters_->push_back(&e);
+        } else {
+            out_ << e.tok.text;
+        }
+    }
+    void operator()(const ast::FnApplicationExpr &e) override {
+        (*this)(*e.fn);
+        out_ << '(';
+        for (auto &arg : e.args) {
+            out_ << ' ';
+            (*this)(*arg);
+        }
+        out_ << ')';
+    }
+    void operator()(const ast::UnaryExpr &e) override {
+        out_ << '(' << e.op().text << ' ';
+        (*this)(*e.expr);
+        out_ << ')';
+    }
+    void operator()(const ast::BinaryExpr &e) override {
+        out_ << '(';
+        (*this)(*e.lhs);
+        out_ << ' ' << e.op().text << ' ';
+        (*this)(*e.rhs);
+        out_ << ')';
+    }
+    void operator()(const ast::QueryExpr &e) override { out_ << e.alias() << "._res"; }
+};
+
+
+/** The options which affect code generation or compilation to machine code but are not necessarily reflected in the
+ * physical plan, each given as `X(name, value)`.  All of them are part of the fingerprint of cached modules, hence an
+ * option affecting the generated module must be listed here.  The options of `WasmUtil.cpp` are printed by
+ * `print_codegen_options()`. */
+#define M_WASM_MODULE_OPTION_LIST(X) \
+    X(wasm_optimization_level, options::wasm_optimization_level) \
+    X(wasm_opt_hot_threshold, options::wasm_opt_hot_threshold) \
+    X(wasm_function_dedup, options::wasm_function_dedup) \
+    X(wasm_adaptive, options::wasm_adaptive) \
+    X(wasm_adaptive_threshold, options::wasm_adaptive_threshold) \
+    X(wasm_lazy_compilation, options::wasm_lazy_compilation) \
+    X(wasm_late_bound_constants, options::wasm_late_bound_constants) \
+    X(perf_map, options::perf_map) \
+    X(statistics, Options::Get().statistics) \
+    X(filter_selection_strategy, uint64_t(m::options::filter_selection_strategy)) \
+    X(quicksort_cmp_selection_strategy, uint64_t(m::options::quicksort_cmp_selection_strategy)) \
+    X(nested_loops_join_selection_strategy, uint64_t(m::options::nested_loops_join_selection_strategy)) \
+    X(simple_hash_join_selection_strategy, uint64_t(m::options::simple_hash_join_selection_strategy)) \
+    X(simple_hash_join_ordering_strategy, uint64_t(m::options::simple_hash_join_ordering_strategy)) \
+    X(simple_hash_join_probe_window_size, m::options::simple_hash_join_probe_window_size) \
+    X(simple_hash_join_bloom_filter_strategy, uint64_t(m::options::simple_hash_join_bloom_filter_strategy)) \
+    X(simple_hash_join_key_range_filter, m::options::simple_hash_join_key_range_filter) \
+    X(index_nested_loops_join_probe_window_size, m::options::index_nested_loops_join_probe_window_size) \
+    X(sort_merge_join_selection_strategy, uint64_t(m::options::sort_merge_join_selection_strategy)) \
+    X(sort_merge_join_cmp_selection_strategy, uint64_t(m::options::sort_merge_join_cmp_selection_strategy)) \
+    X(sort_merge_join_gallop_threshold, m::options::sort_merge_join_gallop_threshold) \
+    X(radix_partitioned_hash_join_partition_size, m::options::radix_partitioned_hash_join_partition_size) \
+    X(radix_partitioned_hash_join_role_reversal_factor, m::options::radix_partitioned_hash_join_role_reversal_factor) \
+    X(radix_partitioned_grouping_partition_size, m::options::radix_partitioned_grouping_partition_size) \
+    X(direct_address_join_max_domain_factor, m::options::direct_address_join_max_domain_factor) \
+    X(array_grouping_max_domain_size, m::options::array_grouping_max_domain_size) \
+    X(hash_table_implementation, uint64_t(m::options::hash_table_implementation)) \
+    X(hash_table_probing_strategy, uint64_t(m::options::hash_table_probing_strategy)) \
+    X(hash_table_storing_strategy, uint64_t(m::options::hash_table_storing_strategy)) \
+    X(load_factor_open_addressing, m::options::load_factor_open_addressing) \
+    X(load_factor_chained, m::options::load_factor_chained) \
+    X(hash_table_initial_capacity, m::options::hash_table_initial_capacity.value_or(0)) \
+    X(hash_table_capacity_margin, m::options::hash_table_capacity_margin) \
+    X(hash_table_max_estimated_capacity, m::options::hash_table_max_estimated_capacity) \
+    X(soft_pipeline_breaker, uint64_t(m::options::soft_pipeline_breaker)) \
+    X(soft_pipeline_breaker_num_tuples, m::options::soft_pipeline_breaker_num_tuples) \
+    X(soft_pipeline_breaker_max_selectivity, m::options::soft_pipeline_breaker_max_selectivity) \
+    X(index_sequential_scan_batch_size, m::options::index_sequential_scan_batch_size) \
+    X(index_sequential_scan_adaptive_batch_size, m::options::index_sequential_scan_adaptive_batch_size) \
+    X(index_sequential_scan_max_batch_size, m::options::index_sequential_scan_max_batch_size) \
+    X(scan_morsel_size, m::options::scan_morsel_size) \
+    X(scan_morsel_functions, m::options::scan_morsel_functions) \
+    X(selection_vector_size, m::options::selection_vector_size) \
+    X(result_set_window_size, m::options::result_set_window_size) \
+    X(arrow_result_set_callback, bool(m::options::arrow_result_set_callback)) \
+    X(arrow_batch_size, m::options::arrow_batch_size) \
+    X(result_set_batch_callback, bool(m::options::result_set_batch_callback)) \
+    X(result_set_batch_size, m::options::result_set_batch_size) \
+    X(exploit_unique_build, m::options::exploit_unique_build) \
+    X(simd, m::options::simd) \
+    X(double_pumping, m::options::double_pumping) \
+    X(simd_lanes, m::options::simd_lanes) \
+    X(aggregation_accumulators, m::options::aggregation_accumulators) \
+    X(explain_analyze, m::options::explain_analyze) \
+    X(memory_budget, m::dsl_options::memory_budget) \
+    X(null_free_columns, NullFreeColumns::enabled())
+
+std::string ModuleCache::Fingerprint(const m::MatchBase &plan, std::vector<const ast::Constant*> &parameters)
+{
+    std::ostringstream oss;
+
+    /*----- The physical plan, including the chosen implementations, buffers, and cardinality estimates. -----*/
+    oss << plan << '\n';
+
+    /*----- The logical plan with all its expressions.  The sizes of scanned tables determine where string literals
+     * are mapped, the data versions of scanned tables the zone maps, partitions, and NULL-free columns. -----*/
+    PrintCanonicalPlan::Print(oss, plan.get_matched_root(),
+                              options::wasm_late_bound_constants ? &parameters : nullptr);
+    oss << '\n';
+
+    /*----- Options which affect code generation but are not reflected in the physical plan. -----*/
+    oss << "options";
+#define PRINT(NAME, VALUE) oss << ' ' << #NAME << '=' << (VALUE);
+    M_WASM_MODULE_OPTION_LIST(PRINT)
+#undef PRINT
+    oss << ' ';
+    print_codegen_options(oss);
+
+    return oss.str();
+}
+
+
+/*======================================================================================================================
+ * Tiering
+ *====================================================================================================================*/
+
+/** Returns the V8 flags for the tiering strategy, i.e. baseline code compiled lazily by Liftoff with dynamic tier-up
+ * to TurboFan if \p adaptive, and optimized code compiled by TurboFan otherwise, lazily iff `--wasm-lazy-compilation`
+ * is given. */
+const char * tiering_flags(bool adaptive)
+{
+    if (adaptive) {
+        return "--opt "
+               "--liftoff "
+               "--wasm-tier-up "
+               "--wasm-dynamic-tiering "
+               "--wasm-lazy-compilation "; // compile code lazily at runtime if needed
+    } else if (options::wasm_lazy_compilation) {
+        return "--no-liftoff "
+               "--wasm-lazy-compilation "; // compile each function by TurboFan on its first call
+    } else {
+        return "--no-liftoff "
+               "--no-wasm-lazy-compilation "; // compile code before starting execution
+    }
+}
+
+/** Returns the estimated number of tuples processed by the plan rooted in \p op, i.e. the sum of the estimated
+ * cardinalities of all operators.  Operators without cardinality estimate contribute the estimate of their largest
+ * child. */
+double estimate_num_tuples_processed(const Operator &op)
+{
+    double num_tuples = 0, max_child = 0;
+    if (auto c = cast<const Consumer>(&op)) {
+        for (auto child : c->children()) {
+            const double num_tuples_child = estimate_num_tuples_processed(*child);
+            num_tuples += num_tuples_child;
+            max_child = std::max(max_child, num_tuples_child);
+        }
+    }
+    return num_tuples + (op.has_info() ? op.info().estimated_cardinality : max_child);
+}
+
+
 /*======================================================================================================================
  * V8Engine implementation
  *====================================================================================================================*/
 
-V8Engine::V8Engine() { initialize(); }
+V8Engine::V8Engine() { } // V8 is initialized lazily on first execution, see `initialize()`
 
 V8Engine::~V8Engine()
 {
     inspector_.reset();
+    context_.Reset(); // must be released before its isolate is disposed
     if (isolate_) {
         M_insist(allocator_);
         isolate_->Dispose();
@@ -740,6 +1196,15 @@ V8Engine::~V8Engine()
 
 void V8Engine::initialize()
 {
+    /*----- Initialize V8 once per process, on first use, s.t. invocations not executing Wasm do not pay for it. ----*/
+    static std::once_flag V8_initialized;
+    std::call_once(V8_initialized, [](){
+        PLATFORM_ = v8::platform::NewDefaultPlatform().release();
+        v8::V8::InitializePlatform(PLATFORM_);
+        v8::V8::SetFlagsFromString("--no-freeze-flags-after-init"); // allow changing flags after initialization
+        v8::V8::Initialize();
+    });
+
     M_insist(not allocator_);
     M_insist(not isolate_);
 
@@ -748,16 +1213,7 @@ void V8Engine::initialize()
      * https://chromium.googlesource.com/v8/v8/+/2c22fd50128ad130e9dba77fce828e5661559121/src/flags/flag-definitions.h.*/
     std::ostringstream flags;
     flags << "--stack_size 1000000 ";
-    if (options::wasm_adaptive) {
-        flags << "--opt "
-              << "--liftoff "
-              << "--wasm-tier-up "
-              << "--wasm-dynamic-tiering "
-              << "--wasm-lazy-compilation "; // compile code lazily at runtime if needed
-    } else {
-        flags << "--no-liftoff "
-              << "--no-wasm-lazy-compilation "; // compile code before starting execution
-    }
+    flags << tiering_flags(options::wasm_adaptive);
     if (not options::wasm_compilation_cache) {
         flags << "--no-compilation-cache "
               << "--no-wasm-native-module-cache-enabled ";
@@ -766,6 +1222,10 @@ void V8Engine::initialize()
         flags << "--code-comments " // include code comments
               << "--print-code ";
     }
+    if (options::perf_map) {
+        flags << "--perf-basic-prof " // write /tmp/perf-<pid>.map
+              << "--perf-prof "; // write jitdump files for `perf inject --jit`
+    }
     if (options::cdt_port >= 1024) {
         flags << "--wasm-bounds-checks "
               << "--wasm-stack-checks "
@@ -785,6 +1245,14 @@ void V8Engine::initialize()
     v8::Isolate::CreateParams create_params;
     create_params.array_buffer_allocator = allocator_ = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
     isolate_ = v8::Isolate::New(create_params);
+
+    /*----- Pre-warm the context s.t. the first execution does not pay for creating it. ------------------------------*/
+    if (options::wasm_context_reuse and options::cdt_port < 1024) {
+        v8::Locker locker(isolate_);
+        v8::Isolate::Scope isolate_scope(isolate_);
+        v8::HandleScope handle_scope(isolate_);
+        context_.Reset(isolate_, new_context());
+    }
 }
 
 void V8Engine::compile(const m::MatchBase &plan) const
@@ -792,8 +1260,14 @@ void V8Engine::compile(const m::MatchBase &plan) const
 #if 1
     /*----- Add print function. --------------------------------------------------------------------------------------*/
     Module::Get().emit_function_import<void(uint32_t)>("print");
-    Module::Get().emit_function_import<void(uint32_t, uint32_t)>("print_memory_consumption");
+    Module::Get().emit_function_import<void(uint32_t, uint32_t, uint32_t)>("print_memory_consumption");
 #endif
+    if (m::options::explain_analyze) {
+        Module::Get().emit_function_import<void(uint32_t, uint32_t)>("report_tuple_count");
+        Module::Get().emit_function_import<void(uint32_t, uint32_t, uint32_t, uint32_t)>("report_selection_strategy");
+    }
+    if (OperatorMemoryConsumption::enabled())
+        Module::Get().emit_function_import<void(uint32_t, uint32_t)>("report_memory_consumption");
 
     /*----- Emit code for run function which computes the last pipeline and calls other pipeline functions. ----------*/
     FUNCTION(run, void(void))
@@ -814,8 +1288,14 @@ void V8Engine::compile(const m::MatchBase &plan) const
                       << " MiB" << std::endl;
             Module::Get().emit_call<void>("print_memory_consumption",
                                           Module::Allocator().allocated_memory_consumption(),
-                                          Module::Allocator().allocated_memory_peak());
+                                          Module::Allocator().allocated_memory_peak(),
+                                          Module::Allocator().allocated_memory_fragmentation());
         }
+        if (m::options::explain_analyze)
+            OperatorTupleCounts::Get().emit_report(); // report the tuples produced by each operator
+        OperatorSelectionStrategies::Get().emit_report(); // report the decisions of adaptive filters, if requested
+        if (OperatorMemoryConsumption::enabled())
+            OperatorMemoryConsumption::Get().emit_report(); // report the memory consumption of each operator
         main.emit_return(CodeGenContext::Get().num_tuples()); // return size of result set
     }
 
@@ -842,8 +1322,23 @@ void V8Engine::compile(const m::MatchBase &plan) const
     std::ostringstream dump_before_opt;
     Module::Get().dump(dump_before_opt);
 #endif
-    if (options::wasm_optimization_level)
-        Module::Optimize(options::wasm_optimization_level);
+    if (options::wasm_function_dedup and options::wasm_optimization_level)
+        Module::Deduplicate(); // before optimization, s.t. merged functions are optimized only once
+    if (options::wasm_optimization_level) {
+        if (options::wasm_opt_hot_threshold) {
+            /* Optimize only the hot functions, i.e. those estimated to process many tuples.  Functions without
+             * pipelines, e.g. sorting or rehashing, are hot iff the entire plan is. */
+            const bool is_plan_hot =
+                estimate_num_tuples_processed(plan.get_matched_root()) >= options::wasm_opt_hot_threshold;
+            Module::Optimize(options::wasm_optimization_level, [is_plan_hot](const ::wasm::Function &fn) {
+                if (auto work = CodeGenContext::Get().estimated_work(fn))
+                    return *work >= options::wasm_opt_hot_threshold;
+                return is_plan_hot;
+            });
+        } else {
+            Module::Optimize(options::wasm_optimization_level);
+        }
+    }
 
 #ifndef NDEBUG
     /*----- Validate module after optimization. ----------------------------------------------------------------------*/
@@ -857,13 +1352,66 @@ void V8Engine::compile(const m::MatchBase &plan) const
 #endif
 }
 
+v8::Local<v8::Context> V8Engine::new_context()
+{
+    /*----- Create global template providing the host functions. -----*/
+    v8::Local<v8::ObjectTemplate> global = v8::ObjectTemplate::New(isolate_);
+    global->Set(isolate_, "set_wasm_instance_raw_memory", v8::FunctionTemplate::New(isolate_, set_wasm_instance_raw_memory));
+    global->Set(isolate_, "read_result_set", v8::FunctionTemplate::New(isolate_, read_result_set));
+
+#define CREATE_TEMPLATES(IDXTYPE, KEYTYPE, V8TYPE, IDXNAME, SUFFIX) \
+    global->Set(isolate_, M_STR(idx_lower_bound_##IDXNAME##_##SUFFIX), v8::FunctionTemplate::New(isolate_, index_seek<IDXTYPE<KEYTYPE>, V8TYPE, true>)); \
+    global->Set(isolate_, M_STR(idx_upper_bound_##IDXNAME##_##SUFFIX), v8::FunctionTemplate::New(isolate_, index_seek<IDXTYPE<KEYTYPE>, V8TYPE, false>)); \
+    global->Set(isolate_, M_STR(idx_scan_##IDXNAME##_##SUFFIX),        v8::FunctionTemplate::New(isolate_, index_sequential_scan<IDXTYPE<KEYTYPE>>))
+
+    CREATE_TEMPLATES(idx::ArrayIndex, bool,        v8::Boolean, array, b);
+    CREATE_TEMPLATES(idx::ArrayIndex, int8_t,      v8::Int32,   array, i1);
+    CREATE_TEMPLATES(idx::ArrayIndex, int16_t,     v8::Int32,   array, i2);
+    CREATE_TEMPLATES(idx::ArrayIndex, int32_t,     v8::Int32,   array, i4);
+    CREATE_TEMPLATES(idx::ArrayIndex, int64_t,     v8::BigInt,  array, i8);
+    CREATE_TEMPLATES(idx::ArrayIndex, float,       v8::Number,  array, f);
+    CREATE_TEMPLATES(idx::ArrayIndex, double,      v8::Number,  array, d);
+    CREATE_TEMPLATES(idx::ArrayIndex, const char*, v8::String,  array, p);
+    CREATE_TEMPLATES(idx::RecursiveModelIndex, int8_t,      v8::Int32,  rmi, i1);
+    CREATE_TEMPLATES(idx::RecursiveModelIndex, int16_t,     v8::Int32,  rmi, i2);
+    CREATE_TEMPLATES(idx::RecursiveModelIndex, int32_t,     v8::Int32,  rmi, i4);
+    CREATE_TEMPLATES(idx::RecursiveModelIndex, int64_t,     v8::BigInt, rmi, i8);
+    CREATE_TEMPLATES(idx::RecursiveModelIndex, float,       v8::Number, rmi, f);
+    CREATE_TEMPLATES(idx::RecursiveModelIndex, double,      v8::Number, rmi, d);
+#undef CREATE_TEMPLATES
+
+#define CREATE_BATCH_TEMPLATE(IDXTYPE, KEYTYPE, IDXNAME, SUFFIX) \
+    global->Set(isolate_, M_STR(idx_seek_batch_##IDXNAME##_##SUFFIX), v8::FunctionTemplate::New(isolate_, index_seek_batch<IDXTYPE<KEYTYPE>>))
+
+    CREATE_BATCH_TEMPLATE(idx::ArrayIndex,          int8_t,  array, i1);
+    CREATE_BATCH_TEMPLATE(idx::ArrayIndex,          int16_t, array, i2);
+    CREATE_BATCH_TEMPLATE(idx::ArrayIndex,          int32_t, array, i4);
+    CREATE_BATCH_TEMPLATE(idx::ArrayIndex,          int64_t, array, i8);
+    CREATE_BATCH_TEMPLATE(idx::ArrayIndex,          float,   array, f);
+    CREATE_BATCH_TEMPLATE(idx::ArrayIndex,          double,  array, d);
+    CREATE_BATCH_TEMPLATE(idx::RecursiveModelIndex, int8_t,  rmi, i1);
+    CREATE_BATCH_TEMPLATE(idx::RecursiveModelIndex, int16_t, rmi, i2);
+    CREATE_BATCH_TEMPLATE(idx::RecursiveModelIndex, int32_t, rmi, i4);
+    CREATE_BATCH_TEMPLATE(idx::RecursiveModelIndex, int64_t, rmi, i8);
+    CREATE_BATCH_TEMPLATE(idx::RecursiveModelIndex, float,   rmi, f);
+    CREATE_BATCH_TEMPLATE(idx::RecursiveModelIndex, double,  rmi, d);
+#undef CREATE_BATCH_TEMPLATE
+
+    return v8::Context::New(isolate_, /* extensions= */ nullptr, global);
+}
+
 void V8Engine::execute(const m::MatchBase &plan)
 {
     Catalog &C = Catalog::Get();
 
-    Module::Init();
+    Module::Init(std::move(spare_module_)); // reuse the module of the previous execution, if any
     CodeGenContext::Init(); // fresh context
+    OperatorTupleCounts::Get().clear(); // forget the counts of the previous plan
+    OperatorMemoryConsumption::Get().clear(); // forget the memory consumption of the previous plan
+    OperatorSelectionStrategies::Get().clear(); // forget the selection strategies of the previous plan
 
+    if (not isolate_)
+        initialize();
     M_insist(bool(isolate_), "must have an isolate");
     v8::Locker locker(isolate_);
     isolate_->Enter();
@@ -873,33 +1421,16 @@ void V8Engine::execute(const m::MatchBase &plan)
         v8::Isolate::Scope isolate_scope(isolate_);
         v8::HandleScope handle_scope(isolate_); // tracks and disposes of all object handles
 
-        /* Create global template and context. */
-        v8::Local<v8::ObjectTemplate> global = v8::ObjectTemplate::New(isolate_);
-        global->Set(isolate_, "set_wasm_instance_raw_memory", v8::FunctionTemplate::New(isolate_, set_wasm_instance_raw_memory));
-        global->Set(isolate_, "read_result_set", v8::FunctionTemplate::New(isolate_, read_result_set));
-
-#define CREATE_TEMPLATES(IDXTYPE, KEYTYPE, V8TYPE, IDXNAME, SUFFIX) \
-        global->Set(isolate_, M_STR(idx_lower_bound_##IDXNAME##_##SUFFIX), v8::FunctionTemplate::New(isolate_, index_seek<IDXTYPE<KEYTYPE>, V8TYPE, true>)); \
-        global->Set(isolate_, M_STR(idx_upper_bound_##IDXNAME##_##SUFFIX), v8::FunctionTemplate::New(isolate_, index_seek<IDXTYPE<KEYTYPE>, V8TYPE, false>)); \
-        global->Set(isolate_, M_STR(idx_scan_##IDXNAME##_##SUFFIX),        v8::FunctionTemplate::New(isolate_, index_sequential_scan<IDXTYPE<KEYTYPE>>))
-
-        CREATE_TEMPLATES(idx::ArrayIndex, bool,        v8::Boolean, array, b);
-        CREATE_TEMPLATES(idx::ArrayIndex, int8_t,      v8::Int32,   array, i1);
-        CREATE_TEMPLATES(idx::ArrayIndex, int16_t,     v8::Int32,   array, i2);
-        CREATE_TEMPLATES(idx::ArrayIndex, int32_t,     v8::Int32,   array, i4);
-        CREATE_TEMPLATES(idx::ArrayIndex, int64_t,     v8::BigInt,  array, i8);
-        CREATE_TEMPLATES(idx::ArrayIndex, float,       v8::Number,  array, f);
-        CREATE_TEMPLATES(idx::ArrayIndex, double,      v8::Number,  array, d);
-        CREATE_TEMPLATES(idx::ArrayIndex, const char*, v8::String,  array, p);
-        CREATE_TEMPLATES(idx::RecursiveModelIndex, int8_t,      v8::Int32,  rmi, i1);
-        CREATE_TEMPLATES(idx::RecursiveModelIndex, int16_t,     v8::Int32,  rmi, i2);
-        CREATE_TEMPLATES(idx::RecursiveModelIndex, int32_t,     v8::Int32,  rmi, i4);
-        CREATE_TEMPLATES(idx::RecursiveModelIndex, int64_t,     v8::BigInt, rmi, i8);
-        CREATE_TEMPLATES(idx::RecursiveModelIndex, float,       v8::Number, rmi, f);
-        CREATE_TEMPLATES(idx::RecursiveModelIndex, double,      v8::Number, rmi, d);
-#undef CREATE_TEMPLATES
-
-        v8::Local<v8::Context> context = v8::Context::New(isolate_, /* extensions= */ nullptr, global);
+        /* Reuse the context of previous executions, whose global object provides the host functions.  Debugging via
+         * CDT requires a fresh context. */
+        v8::Local<v8::Context> context;
+        if (options::wasm_context_reuse and options::cdt_port < 1024 and not context_.IsEmpty()) {
+            context = context_.Get(isolate_);
+        } else {
+            context = new_context();
+            if (options::wasm_context_reuse and options::cdt_port < 1024)
+                context_.Reset(isolate_, context);
+        }
         v8::Context::Scope context_scope(context);
 
         /* Create the import object for instantiating the WebAssembly module. */
@@ -917,13 +1448,90 @@ void V8Engine::execute(const m::MatchBase &plan)
         const auto bytes_remaining = wasm_context.vm.size() - wasm_context.heap;
         memory::Memory mem = Catalog::Get().allocator().allocate(bytes_remaining);
         mem.map(bytes_remaining, 0, wasm_context.vm, wasm_context.heap);
+        advise_wasm_mapping(wasm_context.vm.as<uint8_t*>() + wasm_context.heap, bytes_remaining, /* is_written= */ true);
 
         auto compile_time = C.timer().create_timing("Compile SQL to machine code");
-        /* Compile the plan and thereby build the Wasm module. */
-        M_TIME_EXPR(compile(plan), "|- Compile SQL to WebAssembly", C.timer());
+        /* Look up the compiled module of the plan in the cache.  Debugging via CDT always requires the Wasm module.
+         * A cached module lacks the counters for explaining the plan. */
+        const bool use_module_cache =
+            module_cache_.capacity() != 0 and options::cdt_port < 1024 and not m::options::explain_analyze;
+        std::string fingerprint;
+        const ModuleCache::entry_type *cached = nullptr;
+        if (use_module_cache) {
+            std::vector<const ast::Constant*> parameters;
+            fingerprint = ModuleCache::Fingerprint(plan, parameters);
+            cached = module_cache_.find(fingerprint);
+
+            /* Bind the parameters, i.e. provide the values of the late-bound constants as imports. */
+            for (auto c : parameters) {
+                const auto idx = CodeGenContext::Get().add_parameter(*c);
+                auto value = Interpreter::eval(*c);
+                v8::Local<v8::Value> v8_value = visit(overloaded {
+                    [this, &value](const Numeric &n) -> v8::Local<v8::Value> {
+                        if (n.kind == Numeric::N_Float) {
+                            return v8::Number::New(isolate_, n.size() <= 32 ? double(value.as_f()) : value.as_d());
+                        } else if (n.size() <= 32) {
+                            return v8::Int32::New(isolate_, int32_t(value.as_i()));
+                        } else {
+                            return v8::BigInt::New(isolate_, value.as_i());
+                        }
+                    },
+                    [this, &value](const Date&) -> v8::Local<v8::Value> {
+                        return v8::Int32::New(isolate_, int32_t(value.as_i()));
+                    },
+                    [this, &value](const DateTime&) -> v8::Local<v8::Value> {
+                        return v8::BigInt::New(isolate_, value.as_i());
+                    },
+                    [](auto&&) -> v8::Local<v8::Value> { M_unreachable("constant cannot be bound late"); },
+                }, *c->type());
+                M_DISCARD env->Set(context, mkstr(*isolate_, CodeGenContext::Parameter_Name(idx)), v8_value);
+            }
+        }
+        v8::Local<v8::WasmModuleObject> wasm_module;
+        if (cached) {
+            /* Replay the effects of code generation which the cached module relies on. */
+            if (cached->result_set_factory)
+                wasm_context.result_set_factory = cached->result_set_factory->clone();
+            for (auto morsel_size : cached->morsel_sizes)
+                CodeGenContext::Get().add_morsel_queue(morsel_size);
+            for (auto &[addr, bytes] : cached->raw_memory)
+                std::memcpy(wasm_context.vm.as<uint8_t*>() + addr, bytes.data(), bytes.size());
+            wasm_module = v8::WasmModuleObject::FromCompiledModule(isolate_, cached->module).ToLocalChecked();
+        } else {
+            /* Compile the plan and thereby build the Wasm module. */
+            M_TIME_EXPR(compile(plan), "|- Compile SQL to WebAssembly", C.timer());
+            /* Choose the tiering strategy by the estimated work of the plan: short-running queries start on baseline
+             * code immediately while long-running queries do not pay for executing baseline code before tier-up. */
+            if (options::wasm_adaptive_threshold) {
+                const bool adaptive =
+                    estimate_num_tuples_processed(plan.get_matched_root()) < options::wasm_adaptive_threshold;
+                v8::V8::SetFlagsFromString(tiering_flags(adaptive));
+                if (Options::Get().statistics)
+                    std::cout << "Wasm tiering: " << (adaptive ? "Liftoff with dynamic tier-up" : "TurboFan")
+                              << std::endl;
+            }
+            /* Compile the Wasm module to machine code. */
+            wasm_module = M_TIME_EXPR(compile_module(*isolate_), " ` Compile WebAssembly to machine code", C.timer());
+
+            /* Add the compiled module to the cache if it may be reused. */
+            if (use_module_cache and CodeGenContext::Get().is_module_reusable()) {
+                ModuleCache::entry_type entry{ wasm_module->GetCompiledModule(), nullptr, {} };
+                if (wasm_context.result_set_factory)
+                    entry.result_set_factory = wasm_context.result_set_factory->clone();
+                for (std::size_t i = 0; i != CodeGenContext::Get().num_morsel_queues(); ++i)
+                    entry.morsel_sizes.push_back(CodeGenContext::Get().morsel_queue(i).morsel_size());
+                for (auto [addr, bytes] : Module::Allocator().raw_allocations()) {
+                    auto contents = reinterpret_cast<const char*>(wasm_context.vm.as<uint8_t*>() + addr);
+                    entry.raw_memory.emplace_back(addr, std::string(contents, bytes));
+                }
+                module_cache_.insert(std::move(fingerprint), std::move(entry));
+            }
+        }
         /* Create a WebAssembly instance object. */
-        auto instance = M_TIME_EXPR(instantiate(*isolate_, imports), " ` Compile WebAssembly to machine code", C.timer());
+        auto instance = instantiate(*isolate_, wasm_module, imports);
         compile_time.stop();
+        if (use_module_cache and Options::Get().statistics)
+            module_cache_.print_statistics(std::cout);
 
         /* Set the underlying memory for the instance. */
         v8::SetWasmInstanceRawMemory(instance, wasm_context.vm.as<uint8_t*>(), wasm_context.vm.size());
@@ -940,41 +1548,50 @@ void V8Engine::execute(const m::MatchBase &plan)
             return;
         }
 
-        /* Invoke the exported function `main` of the module. */
+        /* Invoke the exported function `main` of the module.  Cancelling the query terminates the execution. */
         args_t args { v8::Int32::New(isolate_, wasm_context.id), };
-        const uint32_t num_rows =
-            M_TIME_EXPR(main->Call(context, context->Global(), 1, args).ToLocalChecked().As<v8::Uint32>()->Value(),
-                        "Execute machine code", C.timer());
+        v8::MaybeLocal<v8::Value> result;
+        {
+            QueryCancellation::Hook terminate([isolate = isolate_]() { isolate->TerminateExecution(); });
+            result = M_TIME_EXPR(main->Call(context, context->Global(), 1, args), "Execute machine code", C.timer());
+        }
+        if (auto token = QueryCancellation::Current(); token and token->cancelled) {
+            /* Clear a termination requested after the execution finished, and unwind like below. */
+            isolate_->CancelTerminateExecution();
+            Dispose_Wasm_Context(wasm_context);
+            isolate_->Exit();
+            dispose_module();
+            throw query_cancelled();
+        }
+        const uint32_t num_rows = result.ToLocalChecked().As<v8::Uint32>()->Value();
 
         /* Print total number of result tuples. */
         auto &root_op = plan.get_matched_root();
         if (auto print_op = cast<const PrintOperator>(&root_op)) {
-            if (not Options::Get().quiet)
+            if (not Options::Get().quiet and ResultWriter::Is_Textual(ResultWriter::Default_Format()))
                 print_op->out << num_rows << " rows\n";
         } else if (auto noop_op = cast<const NoOpOperator>(&root_op)) {
             if (not Options::Get().quiet)
                 noop_op->out << num_rows << " rows\n";
         }
+
+        /* Print the physical plan with the numbers of tuples produced and the memory consumed by each operator. */
+        if (m::options::explain_analyze)
+            std::cout << "Physical plan with estimated and actual numbers of tuples:" << plan << std::endl;
+        else if (Options::Get().statistics and not cached)
+            std::cout << "Physical plan with memory consumption per operator:" << plan << std::endl;
         Dispose_Wasm_Context(wasm_context);
     }
 
     isolate_->Exit();
-    CodeGenContext::Dispose();
-    Module::Dispose();
-}
-
-__attribute__((constructor(101)))
-static void create_V8Engine()
-{
-    V8Engine::PLATFORM_ = v8::platform::NewDefaultPlatform().release();
-    v8::V8::InitializePlatform(V8Engine::PLATFORM_);
-    v8::V8::SetFlagsFromString("--no-freeze-flags-after-init"); // allow changing flags after initialization
-    v8::V8::Initialize();
+    dispose_module();
 }
 
 __attribute__((destructor(101)))
 static void destroy_V8Engine()
 {
+    if (not V8Engine::PLATFORM_)
+        return; // V8 was never initialized
     v8::V8::Dispose();
     v8::V8::DisposePlatform();
 }
@@ -993,6 +1610,14 @@ static void register_WasmV8()
         /* description= */ "set the optimization level for Wasm modules (0, 1, or 2)",
                            [] (int i) { options::wasm_optimization_level = i; }
     );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--wasm-opt-hot-threshold",
+        /* description= */ "optimize only the functions estimated to process at least this many tuples, i.e. the hot "
+                           "pipelines, instead of the entire module (0 disables)",
+                           [] (std::size_t threshold) { options::wasm_opt_hot_threshold = threshold; }
+    );
     C.arg_parser().add<bool>(
         /* group=       */ "WasmV8",
         /* short=       */ nullptr,
@@ -1000,6 +1625,15 @@ static void register_WasmV8()
         /* description= */ "enable adaptive execution of Wasm with Liftoff and dynamic tier-up",
                            [] (bool b) { options::wasm_adaptive = b; }
     );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "WasmV8",
+        /* short=       */ nullptr,
+        /* long=        */ "--wasm-adaptive-threshold",
+        /* description= */ "choose the tiering per query: execute queries estimated to process fewer tuples than the "
+                           "threshold adaptively with Liftoff and dynamic tier-up, and compile all other queries "
+                           "eagerly with TurboFan (0 disables)",
+                           [] (std::size_t threshold) { options::wasm_adaptive_threshold = threshold; }
+    );
     C.arg_parser().add<bool>(
         /* group=       */ "WasmV8",
         /* short=       */ nullptr,
@@ -1007,6 +1641,38 @@ static void register_WasmV8()
         /* description= */ "disable V8's compilation cache",
                            [] (bool) { options::wasm_compilation_cache = false; }
     );
+    C.arg_parser().add<bool>(
+        /* group=       */ "WasmV8",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-wasm-context-reuse",
+        /* description= */ "create a fresh V8 context for every execution instead of reusing a pre-warmed one",
+                           [] (bool) { options::wasm_context_reuse = false; }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "WasmV8",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-wasm-module-reuse",
+        /* description= */ "create a fresh Binaryen module for every execution instead of resetting the module of the "
+                           "previous execution",
+                           [] (bool) { options::wasm_module_reuse = false; }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "WasmV8",
+        /* short=       */ nullptr,
+        /* long=        */ "--wasm-lazy-compilation",
+        /* description= */ "compile each function with TurboFan on its first call instead of the entire module before "
+                           "execution, s.t. the first pipeline starts while later pipelines are not compiled yet",
+                           [] (bool b) { options::wasm_lazy_compilation = b; }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--wasm-function-dedup",
+        /* description= */ "merge generated functions that are identical or differ only in constants, e.g. the code "
+                           "of structurally identical operators, before optimization (requires `--wasm-opt`); merged "
+                           "functions lose their names in perf maps and for `--wasm-opt-hot-threshold`",
+                           [] (bool b) { options::wasm_function_dedup = b; }
+    );
     C.arg_parser().add<bool>(
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
@@ -1021,6 +1687,30 @@ static void register_WasmV8()
         /* description= */ "dump the generated assembly code to stdout",
                            [] (bool b) { options::asm_dump = b; }
     );
+    C.arg_parser().add<bool>(
+        /* group=       */ "WasmV8",
+        /* short=       */ nullptr,
+        /* long=        */ "--perf-map",
+        /* description= */ "write the generated machine code with the names of the pipeline functions to a perf map "
+                           "and jitdump files for profiling with Linux `perf`",
+                           [] (bool b) { options::perf_map = b; }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "WasmV8",
+        /* short=       */ nullptr,
+        /* long=        */ "--wasm-module-cache",
+        /* description= */ "set the maximal number of compiled modules to cache for reuse by later executions of the "
+                           "same plan (0 disables the cache)",
+                           [] (std::size_t capacity) { options::wasm_module_cache_capacity = capacity; }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "WasmV8",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-wasm-late-bound-constants",
+        /* description= */ "embed all constants into the generated code instead of binding numeric and date constants "
+                           "late for reuse of cached modules",
+                           [] (bool) { options::wasm_late_bound_constants = false; }
+    );
     C.arg_parser().add<int>(
         /* group=       */ "WasmV8",
         /* short=       */ nullptr,
@@ -1043,9 +1733,15 @@ v8::Local<v8::String> m::wasm::detail::mkstr(v8::Isolate &isolate, const std::st
 }
 
 v8::Local<v8::WasmModuleObject> m::wasm::detail::instantiate(v8::Isolate &isolate, v8::Local<v8::Object> imports)
+{
+    return instantiate(isolate, compile_module(isolate), imports);
+}
+
+v8::Local<v8::WasmModuleObject> m::wasm::detail::compile_module(v8::Isolate &isolate)
 {
     auto Ctx = isolate.GetCurrentContext();
-    auto [binary_addr, binary_size] = Module::Get().binary();
+    /* Name the functions, e.g. `simple_hash_join_child_pipeline<3>`, in the perf map rather than by their indices. */
+    auto [binary_addr, binary_size] = Module::Get().binary(/* names_section= */ options::perf_map);
     auto bs = v8::ArrayBuffer::NewBackingStore(
         /* data =        */ binary_addr,
         /* byte_length=  */ binary_size,
@@ -1066,6 +1762,15 @@ v8::Local<v8::WasmModuleObject> m::wasm::detail::instantiate(v8::Isolate &isolat
     if (Options::Get().statistics)
         std::cout << "Machine code size: " << wasm_module->GetCompiledModule().Serialize().size << std::endl;
 
+    return wasm_module;
+}
+
+v8::Local<v8::WasmModuleObject> m::wasm::detail::instantiate(v8::Isolate &isolate,
+                                                             v8::Local<v8::WasmModuleObject> wasm_module,
+                                                             v8::Local<v8::Object> imports)
+{
+    auto Ctx = isolate.GetCurrentContext();
+    auto wasm = Ctx->Global()->Get(Ctx, mkstr(isolate, "WebAssembly")).ToLocalChecked().As<v8::Object>(); // WebAssembly class
     args_t instance_args { wasm_module, imports };
     return wasm->Get(Ctx, mkstr(isolate, "Instance")).ToLocalChecked().As<v8::Object>()
                ->CallAsConstructor(Ctx, 2, instance_args).ToLocalChecked().As<v8::WasmModuleObject>();
@@ -1118,6 +1823,7 @@ v8::Local<v8::Object> m::wasm::detail::create_env(v8::Isolate &isolate, const m:
 
     /* Add functions to environment. */
     Module::Get().emit_function_import<void(void*,uint32_t)>("read_result_set");
+    Module::Get().emit_function_import<uint32_t(uint32_t, uint32_t)>("next_morsel");
 
 #define EMIT_FUNC_IMPORTS(KEYTYPE, IDXNAME, SUFFIX) \
     Module::Get().emit_function_import<uint32_t(std::size_t,KEYTYPE)>(M_STR(idx_lower_bound_##IDXNAME##_##SUFFIX)); \
@@ -1140,6 +1846,23 @@ v8::Local<v8::Object> m::wasm::detail::create_env(v8::Isolate &isolate, const m:
     EMIT_FUNC_IMPORTS(double,      rmi, d);
 #undef EMIT_FUNC_IMPORTS
 
+#define EMIT_BATCH_FUNC_IMPORT(IDXNAME, SUFFIX) \
+    Module::Get().emit_function_import<void(std::size_t,void*,uint32_t,void*)>(M_STR(idx_seek_batch_##IDXNAME##_##SUFFIX))
+
+    EMIT_BATCH_FUNC_IMPORT(array, i1);
+    EMIT_BATCH_FUNC_IMPORT(array, i2);
+    EMIT_BATCH_FUNC_IMPORT(array, i4);
+    EMIT_BATCH_FUNC_IMPORT(array, i8);
+    EMIT_BATCH_FUNC_IMPORT(array, f);
+    EMIT_BATCH_FUNC_IMPORT(array, d);
+    EMIT_BATCH_FUNC_IMPORT(rmi, i1);
+    EMIT_BATCH_FUNC_IMPORT(rmi, i2);
+    EMIT_BATCH_FUNC_IMPORT(rmi, i4);
+    EMIT_BATCH_FUNC_IMPORT(rmi, i8);
+    EMIT_BATCH_FUNC_IMPORT(rmi, f);
+    EMIT_BATCH_FUNC_IMPORT(rmi, d);
+#undef EMIT_BATCH_FUNC_IMPORT
+
 #define ADD_FUNC(FUNC, NAME) { \
     auto func = v8::Function::New(Ctx, (FUNC)).ToLocalChecked(); \
     env->Set(Ctx, mkstr(isolate, NAME), func).Check(); \
@@ -1148,7 +1871,11 @@ v8::Local<v8::Object> m::wasm::detail::create_env(v8::Isolate &isolate, const m:
     ADD_FUNC_(insist)
     ADD_FUNC_(print)
     ADD_FUNC_(print_memory_consumption)
+    ADD_FUNC_(report_tuple_count)
+    ADD_FUNC_(report_selection_strategy)
+    ADD_FUNC_(report_memory_consumption)
     ADD_FUNC_(read_result_set)
+    ADD_FUNC_(next_morsel)
     ADD_FUNC(_throw, "throw")
 
 #define ADD_FUNCS(IDXTYPE, KEYTYPE, V8TYPE, IDXNAME, SUFFIX) \
@@ -1171,6 +1898,23 @@ v8::Local<v8::Object> m::wasm::detail::create_env(v8::Isolate &isolate, const m:
     ADD_FUNCS(idx::RecursiveModelIndex, float,       v8::Number,  rmi, f);
     ADD_FUNCS(idx::RecursiveModelIndex, double,      v8::Number,  rmi, d);
 #undef ADD_FUNCS
+
+#define ADD_BATCH_FUNC(IDXTYPE, KEYTYPE, IDXNAME, SUFFIX) \
+    ADD_FUNC(index_seek_batch<IDXTYPE<KEYTYPE>>, M_STR(idx_seek_batch_##IDXNAME##_##SUFFIX))
+
+    ADD_BATCH_FUNC(idx::ArrayIndex,          int8_t,  array, i1);
+    ADD_BATCH_FUNC(idx::ArrayIndex,          int16_t, array, i2);
+    ADD_BATCH_FUNC(idx::ArrayIndex,          int32_t, array, i4);
+    ADD_BATCH_FUNC(idx::ArrayIndex,          int64_t, array, i8);
+    ADD_BATCH_FUNC(idx::ArrayIndex,          float,   array, f);
+    ADD_BATCH_FUNC(idx::ArrayIndex,          double,  array, d);
+    ADD_BATCH_FUNC(idx::RecursiveModelIndex, int8_t,  rmi, i1);
+    ADD_BATCH_FUNC(idx::RecursiveModelIndex, int16_t, rmi, i2);
+    ADD_BATCH_FUNC(idx::RecursiveModelIndex, int32_t, rmi, i4);
+    ADD_BATCH_FUNC(idx::RecursiveModelIndex, int64_t, rmi, i8);
+    ADD_BATCH_FUNC(idx::RecursiveModelIndex, float,   rmi, f);
+    ADD_BATCH_FUNC(idx::RecursiveModelIndex, double,  rmi, d);
+#undef ADD_BATCH_FUNC
 #undef ADD_FUNC_
 #undef ADD_FUNC
 
@@ -81,14 +81,26 @@ void insist(const v8::FunctionCallbackInfo<v8::Value> &info);
 void _throw(const v8::FunctionCallbackInfo<v8::Value> &info);
 void print(const v8::FunctionCallbackInfo<v8::Value> &info);
 void print_memory_consumption(const v8::FunctionCallbackInfo<v8::Value> &info);
+void report_tuple_count(const v8::FunctionCallbackInfo<v8::Value> &info);
+void report_selection_strategy(const v8::FunctionCallbackInfo<v8::Value> &info);
+void report_memory_consumption(const v8::FunctionCallbackInfo<v8::Value> &info);
 void set_wasm_instance_raw_memory(const v8::FunctionCallbackInfo<v8::Value> &info);
 void read_result_set(const v8::FunctionCallbackInfo<v8::Value> &info);
+void next_morsel(const v8::FunctionCallbackInfo<v8::Value> &info);
 template<typename Index, typename V8ValueT, bool IsLower>
 void index_seek(const v8::FunctionCallbackInfo<v8::Value> &info);
 template<typename Index>
 void index_sequential_scan(const v8::FunctionCallbackInfo<v8::Value> &info);
+template<typename Index>
+void index_seek_batch(const v8::FunctionCallbackInfo<v8::Value> &info);
 
 v8::Local<v8::String> mkstr(v8::Isolate &isolate, const std::string &str);
+/** Compiles the current `Module` to machine code. */
+v8::Local<v8::WasmModuleObject> compile_module(v8::Isolate &isolate);
+/** Instantiates the compiled \p wasm_module with the given \p imports. */
+v8::Local<v8::WasmModuleObject> instantiate(v8::Isolate &isolate, v8::Local<v8::WasmModuleObject> wasm_module,
+                                            v8::Local<v8::Object> imports);
+/** Compiles the current `Module` to machine code and instantiates it with the given \p imports. */
 v8::Local<v8::WasmModuleObject> instantiate(v8::Isolate &isolate, v8::Local<v8::Object> imports);
 v8::Local<v8::Object> create_env(v8::Isolate &isolate, const m::MatchBase &plan);
 v8::Local<v8::String> to_json(v8::Isolate &isolate, v8::Local<v8::Value> val);
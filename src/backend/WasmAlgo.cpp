@@ -247,6 +247,212 @@ void m::wasm::quicksort(Buffer<IsGlobal> &buffer, const std::vector<SortingOpera
 template void m::wasm::quicksort<false>(GlobalBuffer&, const std::vector<SortingOperator::order_type>&);
 template void m::wasm::quicksort<true>(GlobalBuffer&, const std::vector<SortingOperator::order_type>&);
 
+std::optional<uint32_t> m::wasm::radix_key_size_in_bits(const std::vector<SortingOperator::order_type> &order)
+{
+    uint32_t size_in_bits = 0;
+    for (auto &o : order) {
+        const Type *type = o.first.get().type();
+        if (not type->is_integral() and not type->is_date() and not type->is_boolean())
+            return std::nullopt;
+        size_in_bits += type->size() + 1; // plus NULL bit
+    }
+    if (size_in_bits == 0 or size_in_bits > 64)
+        return std::nullopt;
+    return size_in_bits;
+}
+
+namespace {
+
+/** Computes the radix key of the tuple in the current environment for the ordering \p order.  The key is the
+ * concatenation of the order expressions, each preceded by a bit which is unset iff the value is NULL s.t. NULLs are
+ * ordered first (exactly as by `compare()`).  Signed values are biased and values to be ordered descending are
+ * inverted s.t. unsigned comparison of keys yields the requested ordering.  The key is aligned to the most
+ * significant bit. */
+U64x1 compute_radix_key(const std::vector<SortingOperator::order_type> &order, uint32_t key_size_in_bits)
+{
+    auto &env = CodeGenContext::Get().env();
+
+    Var<U64x1> key(uint64_t(0));
+    for (auto &o : order) {
+        const uint32_t size = o.first.get().type()->size();
+        const uint64_t mask = size == 64 ? ~uint64_t(0) : (uint64_t(1) << size) - uint64_t(1);
+        std::visit(overloaded {
+            [&]<typename T>(Expr<T> _val) -> void {
+                auto [val, is_null] = _val.split();
+
+                /*----- Reinterpret value s.t. unsigned comparison matches the requested ordering. -----*/
+                U64x1 bits = [&]() -> U64x1 {
+                    if constexpr (std::same_as<T, bool>) {
+                        return val.template to<uint64_t>();
+                    } else if constexpr (std::is_signed_v<T>) {
+                        /* sign-extend, truncate to `size` bits, and flip sign bit to bias the value */
+                        return (val.template to<int64_t>().make_unsigned() bitand mask) xor
+                               (uint64_t(1) << (size - 1));
+                    } else {
+                        return val.template to<uint64_t>();
+                    }
+                }();
+                if (not o.second)
+                    bits = bits xor mask; // invert for descending ordering
+
+                /*----- Append NULL bit and value, which is zeroed for NULL. -----*/
+                key <<= size + 1;
+                if (_val.can_be_null()) {
+                    const Var<U64x1> is_null_bit(is_null.template to<uint64_t>());
+                    key |= ((is_null_bit xor uint64_t(1)) << uint64_t(size)) bitor
+                           ((is_null_bit - uint64_t(1)) bitand bits); // mask is all-ones iff value is not NULL
+                } else {
+                    is_null.discard();
+                    key |= (uint64_t(1) << size) bitor bits;
+                }
+            },
+            [](auto&&) -> void { M_unreachable("invalid type of order expression for radix sort"); },
+        }, env.compile(o.first));
+    }
+
+    if (key_size_in_bits < 64)
+        return key << uint64_t(64 - key_size_in_bits); // align to the most significant bit
+    return key;
+}
+
+}
+
+template<bool IsGlobal>
+void m::wasm::radix_sort(Buffer<IsGlobal> &buffer, const std::vector<SortingOperator::order_type> &order)
+{
+    static_assert(IsGlobal, "radix sort on local buffers is not yet supported");
+
+    const auto key_size_in_bits = radix_key_size_in_bits(order);
+    M_insist(bool(key_size_in_bits), "order cannot be sorted using radix sort");
+    constexpr uint32_t NUM_DIGITS = 256; ///< number of distinct values of an 8-bit digit
+    constexpr uint32_t INSERTION_SORT_THRESHOLD = 16; ///< largest range size to sort using insertion sort
+    const uint32_t num_levels = (*key_size_in_bits + 7) / 8;
+
+    /*----- Create load and swap proxies for buffer. -----*/
+    auto load = buffer.create_load_proxy();
+    auto swap = buffer.create_swap_proxy();
+
+    /*----- Allocate the digit offsets and cursors for each level of the recursion.  The offsets of a level must
+     * survive all recursive calls of this level, i.e. digit `d` of a level consists of the tuple IDs in
+     * [offsets[d], offsets[d + 1]), and the cursors are used while permuting. -----*/
+    Ptr<U32x1> all_offsets = Module::Allocator().pre_malloc<uint32_t>(num_levels * (NUM_DIGITS + 1));
+    Ptr<U32x1> all_cursors = Module::Allocator().pre_malloc<uint32_t>(num_levels * NUM_DIGITS);
+
+    /*----- Create function to load a tuple and compute its radix key. -----*/
+    auto radix_key_of = [&](U32x1 tuple_id) -> U64x1 {
+        auto S = CodeGenContext::Get().scoped_environment();
+        load(tuple_id);
+        return compute_radix_key(order, *key_size_in_bits);
+    };
+
+    /*---- Create radix sort function. -----*/
+    /* Receives the ID of the first tuple to sort, the past-the-end ID to sort, and the level of the recursion, i.e. the
+     * index of the digit to sort by, as parameters.  All tuples in the range already agree on the digits of all
+     * previous levels. */
+    FUNCTION(radix_sort, void(uint32_t, uint32_t, uint32_t))
+    {
+        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment
+
+        buffer.setup_base_address(); // to access base address during loading and swapping as local
+
+        const auto begin = PARAMETER(0); // first ID to sort
+        const auto end = PARAMETER(1); // past-the-end ID to sort
+        const auto level = PARAMETER(2); // level of recursion
+        Wasm_insist(begin <= end);
+        Wasm_insist(level < num_levels);
+
+        IF (end - begin <= INSERTION_SORT_THRESHOLD) {
+            /*----- Sort small range using insertion sort. -----*/
+            Var<U32x1> i(begin + 1U);
+            WHILE (i < end) {
+                Var<U32x1> j(i.val());
+                const Var<U64x1> key(radix_key_of(i));
+                WHILE (j > begin) {
+                    BREAK(radix_key_of(j - 1U) <= key); // stop as soon as predecessor is not greater
+                    swap(j - 1U, j);
+                    j -= 1U;
+                }
+                i += 1U;
+            }
+        } ELSE {
+            const Var<Ptr<U32x1>> offsets(all_offsets.clone() + (level * (NUM_DIGITS + 1)).make_signed());
+            const Var<Ptr<U32x1>> cursors(all_cursors.clone() + (level * NUM_DIGITS).make_signed());
+            auto at = [](const Var<Ptr<U32x1>> &ptr, U32x1 idx) { return *(ptr.val() + idx.make_signed()); };
+            const Var<U64x1> shift((U32x1(56U) - level * 8U).to<uint64_t>());
+            auto digit_of = [&](U32x1 tuple_id) -> U32x1 {
+                return ((radix_key_of(tuple_id) >> shift) bitand uint64_t(NUM_DIGITS - 1)).to<uint32_t>();
+            };
+
+            /*----- Compute histogram, i.e. the number of tuples with digit `d` into `offsets[d + 1]`. -----*/
+            Var<U32x1> d(0U);
+            WHILE (d <= NUM_DIGITS) {
+                at(offsets, d) = 0U;
+                d += 1U;
+            }
+            Var<U32x1> tuple_id(begin);
+            WHILE (tuple_id < end) {
+                at(offsets, digit_of(tuple_id) + 1U) += 1U;
+                tuple_id += 1U;
+            }
+
+            /*----- Compute prefix sum s.t. `offsets[d]` is the first tuple ID with digit `d`. -----*/
+            at(offsets, U32x1(0U)) = begin;
+            d = 1U;
+            WHILE (d <= NUM_DIGITS) {
+                U32x1 prev = at(offsets, d - 1U);
+                at(offsets, d) += prev;
+                d += 1U;
+            }
+
+            /*----- Permute tuples s.t. all tuples with digit `d` are located in [offsets[d], offsets[d + 1]).  Each
+             * cursor points to the first tuple of its digit which is not yet known to be at its final position. -----*/
+            d = 0U;
+            WHILE (d < NUM_DIGITS) {
+                at(cursors, d) = U32x1(at(offsets, d));
+                d += 1U;
+            }
+            d = 0U;
+            WHILE (d < NUM_DIGITS) {
+                const Var<U32x1> digit_end(U32x1(at(offsets, d + 1U)));
+                WHILE (U32x1(at(cursors, d)) < digit_end) {
+                    const Var<U32x1> first(U32x1(at(cursors, d)));
+                    const Var<U32x1> digit(digit_of(first));
+                    IF (digit == d) {
+                        at(cursors, d) += 1U; // tuple is already located at its digit
+                    } ELSE {
+                        const Var<U32x1> second(U32x1(at(cursors, digit)));
+                        at(cursors, digit) += 1U;
+                        swap(first, second); // move tuple to its digit and examine the swapped one next
+                    };
+                }
+                d += 1U;
+            }
+
+            /*----- Recurse into each digit containing at least two tuples, if there are digits left. -----*/
+            IF (level + 1U < num_levels) {
+                d = 0U;
+                WHILE (d < NUM_DIGITS) {
+                    const Var<U32x1> digit_begin(U32x1(at(offsets, d)));
+                    const Var<U32x1> digit_end(U32x1(at(offsets, d + 1U)));
+                    IF (digit_end - digit_begin >= 2U) {
+                        radix_sort(digit_begin, digit_end, level + 1U);
+                    };
+                    d += 1U;
+                }
+            };
+        };
+
+        buffer.teardown_base_address();
+    }
+    radix_sort(0, buffer.size(), 0);
+
+    all_offsets.discard(); // since it was always cloned
+    all_cursors.discard(); // since it was always cloned
+}
+
+// explicit instantiations to prevent linker errors
+template void m::wasm::radix_sort(GlobalBuffer&, const std::vector<SortingOperator::order_type>&);
+
 
 /*======================================================================================================================
  * hashing
@@ -291,23 +497,72 @@ U64x1 m::wasm::murmur3_bit_mix(U64x1 bits)
     return res;
 }
 
+template<std::size_t L>
+requires (L > 1)
+PrimitiveExpr<uint64_t, L> m::wasm::murmur3_bit_mix(PrimitiveExpr<uint64_t, L> bits)
+{
+    /* Same as the scalar version above but for all lanes at once.  Wasm provides lane-wise 64-bit shifts, xors, and
+     * multiplications, thus each step requires a single instruction per 128-bit vector. */
+    Var<PrimitiveExpr<uint64_t, L>> res(bits);
+    res = res xor (res >> U32x1(31U));
+    res = res * PrimitiveExpr<uint64_t, L>(uint64_t(0x7fb5d329728ea185UL));
+    res = res xor (res >> U32x1(27U));
+    res = res * PrimitiveExpr<uint64_t, L>(uint64_t(0x81dadef4bc2dd44dUL));
+    res = res xor (res >> U32x1(33U));
+    return res;
+}
+
+// explicit instantiations to prevent linker errors
+template PrimitiveExpr<uint64_t, 2> m::wasm::murmur3_bit_mix(PrimitiveExpr<uint64_t, 2>);
+template PrimitiveExpr<uint64_t, 4> m::wasm::murmur3_bit_mix(PrimitiveExpr<uint64_t, 4>);
+template PrimitiveExpr<uint64_t, 8> m::wasm::murmur3_bit_mix(PrimitiveExpr<uint64_t, 8>);
+template PrimitiveExpr<uint64_t, 16> m::wasm::murmur3_bit_mix(PrimitiveExpr<uint64_t, 16>);
+template PrimitiveExpr<uint64_t, 32> m::wasm::murmur3_bit_mix(PrimitiveExpr<uint64_t, 32>);
+
 
 /*----- hash functions -----------------------------------------------------------------------------------------------*/
 
 U64x1 m::wasm::fnv_1a(Ptr<U8x1> bytes, U32x1 num_bytes)
 {
-    Wasm_insist(not bytes.clone().is_nullptr(), "cannot compute hash of nullptr");
+    static thread_local struct {} _; // unique caller handle
+    struct data_t : GarbageCollectedData
+    {
+        public:
+        std::optional<FunctionProxy<uint64_t(uint8_t*, uint32_t)>> fnv_1a;
+
+        data_t(GarbageCollectedData &&d) : GarbageCollectedData(std::move(d)) { }
+    };
+    auto &d = Module::Get().add_garbage_collected_data<data_t>(&_); // garbage collect the `data_t` instance
+
+    if (not d.fnv_1a) {
+        /*----- Create function to compute the hash once per module rather than emitting the loop at each use. -----*/
+        FUNCTION(fnv_1a, uint64_t(uint8_t*, uint32_t))
+        {
+            auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+
+            auto bytes = PARAMETER(0);
+            const auto num_bytes = PARAMETER(1);
 
-    Var<U64x1> h(0xcbf29ce484222325UL);
+            Wasm_insist(not bytes.is_nullptr(), "cannot compute hash of nullptr");
 
-    Var<Ptr<U8x1>> ptr(bytes.clone());
-    WHILE (ptr != bytes + num_bytes.make_signed() and U8x1(*ptr).to<bool>()) {
-        h ^= *ptr;
-        h *= uint64_t(0x100000001b3UL);
-        ptr += 1;
+            Var<U64x1> h(0xcbf29ce484222325UL);
+
+            const Var<Ptr<U8x1>> end(bytes + num_bytes.make_signed());
+            WHILE (bytes != end and U8x1(*bytes).to<bool>()) {
+                h ^= *bytes;
+                h *= uint64_t(0x100000001b3UL);
+                bytes += 1;
+            }
+
+            RETURN(h);
+        }
+        d.fnv_1a = std::move(fnv_1a);
     }
 
-    return h;
+    /*----- Call fnv_1a function. ------*/
+    M_insist(bool(d.fnv_1a));
+    const Var<U64x1> hash((*d.fnv_1a)(bytes, num_bytes)); // to prevent duplicated computation due to `clone()`
+    return hash;
 }
 
 U64x1 m::wasm::str_hash(NChar _str)
@@ -431,9 +686,147 @@ U64x1 m::wasm::murmur3_64a_hash(std::vector<std::pair<const Type*, SQL_t>> value
     return murmur3_bit_mix(h);
 }
 
+template<std::size_t L>
+requires (L > 1)
+PrimitiveExpr<uint64_t, L> m::wasm::murmur3_64a_hash(std::vector<std::pair<const Type*, SQL_t>> values)
+{
+    /* Lane-wise version of the scalar `murmur3_64a_hash()` above.  Both must compute the same hash for the same key
+     * s.t. keys hashed by SIMDfied code can be matched against keys hashed by scalar code.  Strings are never
+     * SIMDfied and are therefore not supported. */
+    using U64xL = PrimitiveExpr<uint64_t, L>;
+    M_insist(values.size() != 0, "cannot compute hash of an empty sequence of values");
+
+    /*----- Handle a single value. -----*/
+    if (values.size() == 1) {
+        return std::visit(overloaded {
+            [&]<typename T>(Expr<T, L> val) -> U64xL { return murmur3_bit_mix(val.hash()); },
+            [](std::monostate) -> U64xL { M_unreachable("invalid variant"); },
+            [](auto) -> U64xL { M_unreachable("invalid number of SIMD lanes or string SIMDfication"); }
+        }, values.front().second);
+    }
+
+    /*----- Compute total size in bits of all values including NULL bits. -----*/
+    uint64_t total_size_in_bits = 0;
+    for (const auto &p : values)
+        total_size_in_bits += p.first->size();
+
+    /*----- If all values of a lane can be combined into a single 64-bit lane, combine all values and bit mix. -----*/
+    if (total_size_in_bits <= 64) {
+        Var<U64xL> h(U64xL(uint64_t(0)));
+        for (auto &p : values) {
+            std::visit(overloaded {
+                [&]<typename T>(Expr<T, L> _val) -> void {
+                    h = h << U32x1(uint32_t(p.first->size()));
+                    if (_val.can_be_null()) {
+                        auto [val, is_null] = _val.split();
+                        auto mask = is_null.template to<uint64_t, L>() - U64xL(uint64_t(1)); // zero for NULL lanes
+                        h = h bitor (mask bitand val.hash());
+                    } else {
+                        h = h bitor _val.insist_not_null().hash(); // add reinterpreted value
+                    }
+                },
+                [](std::monostate) -> void { M_unreachable("invalid variant"); },
+                [](auto) -> void { M_unreachable("invalid number of SIMD lanes or string SIMDfication"); }
+            }, p.second);
+        }
+        return murmur3_bit_mix(h.val());
+    }
+
+    /*----- Perform general Murmur3_64a. -----*/
+    constexpr uint64_t m = 0xc6a4a7935bd1e995UL;
+    Var<U64xL> k; // always set before used
+    Var<U64xL> h(U64xL(uint64_t(values.size()) * m));
+
+    for (auto &p : values) {
+        std::visit(overloaded {
+            [&]<typename T>(Expr<T, L> val) -> void {
+                k = val.hash() * U64xL(m);
+                k = (k << U32x1(47U)) bitor (k >> U32x1(17U)); // rotate left by 47
+                k = k * U64xL(m);
+                h = h xor k;
+                h = (h << U32x1(45U)) bitor (h >> U32x1(19U)); // rotate left by 45
+                h = h * U64xL(uint64_t(5UL)) + U64xL(uint64_t(0xe6546b64UL));
+            },
+            [](std::monostate) -> void { M_unreachable("invalid variant"); },
+            [](auto) -> void { M_unreachable("invalid number of SIMD lanes or string SIMDfication"); }
+        }, p.second);
+    }
+    h = h xor U64xL(uint64_t(values.size()));
+
+    return murmur3_bit_mix(h.val());
+}
+
+// explicit instantiations to prevent linker errors
+template PrimitiveExpr<uint64_t, 2> m::wasm::murmur3_64a_hash<2>(std::vector<std::pair<const Type*, SQL_t>>);
+template PrimitiveExpr<uint64_t, 4> m::wasm::murmur3_64a_hash<4>(std::vector<std::pair<const Type*, SQL_t>>);
+template PrimitiveExpr<uint64_t, 8> m::wasm::murmur3_64a_hash<8>(std::vector<std::pair<const Type*, SQL_t>>);
+template PrimitiveExpr<uint64_t, 16> m::wasm::murmur3_64a_hash<16>(std::vector<std::pair<const Type*, SQL_t>>);
+template PrimitiveExpr<uint64_t, 32> m::wasm::murmur3_64a_hash<32>(std::vector<std::pair<const Type*, SQL_t>>);
+
 
 /*----- hash tables --------------------------------------------------------------------------------------------------*/
 
+U64x1 HashTable::hash(std::vector<SQL_t> key) const
+{
+    M_insist(key.size() == key_indices_.size(),
+             "provided number of key elements does not match hash table's number of key indices");
+
+    /*----- If keys are mapped directly, compute the offset of the key within the key domain. -----*/
+    if (direct_mapping_min_) {
+        return std::visit(overloaded {
+            [&]<typename T>(Expr<T> _val) -> U64x1 requires std::integral<T> and (not std::same_as<T, bool>) {
+                const PrimitiveExpr<int64_t> min(*direct_mapping_min_);
+                if (_val.can_be_null()) {
+                    auto [val, is_null] = _val.split();
+                    auto offset = (val.template to<int64_t>() - min).template to<uint64_t>();
+                    return (~uint64_t(0) + is_null.template to<uint64_t>()) bitand offset; // map NULL to 0
+                } else {
+                    auto val = _val.insist_not_null();
+                    return (val.template to<int64_t>() - min).template to<uint64_t>();
+                }
+            },
+            [](auto) -> U64x1 { M_unreachable("direct mapping requires a single integral key"); },
+            [](std::monostate) -> U64x1 { M_unreachable("invalid variant"); }
+        }, key.front());
+    }
+
+    /*----- Collect types of key together with the respective value. -----*/
+    std::vector<std::pair<const Type*, SQL_t>> values;
+    values.reserve(key_indices_.size());
+    auto key_it = key.begin();
+    for (auto k : key_indices_)
+        values.emplace_back(schema_.get()[k].type, std::move(*key_it++));
+
+    /*----- Compute hash of key using Murmur3_64a. -----*/
+    return murmur3_64a_hash(std::move(values));
+}
+
+template<std::size_t L>
+requires (L > 1)
+PrimitiveExpr<uint64_t, L> HashTable::hash(std::vector<SQL_t> key) const
+{
+    M_insist(key.size() == key_indices_.size(),
+             "provided number of key elements does not match hash table's number of key indices");
+    M_insist(not direct_mapping_min_, "direct mapping of keys is not SIMDfied");
+
+    /*----- Collect types of key together with the respective value. -----*/
+    std::vector<std::pair<const Type*, SQL_t>> values;
+    values.reserve(key_indices_.size());
+    auto key_it = key.begin();
+    for (auto k : key_indices_)
+        values.emplace_back(schema_.get()[k].type, std::move(*key_it++));
+
+    /*----- Compute hashes of all lanes of key at once using Murmur3_64a. -----*/
+    return murmur3_64a_hash<L>(std::move(values));
+}
+
+// explicit instantiations to prevent linker errors
+template PrimitiveExpr<uint64_t, 2> HashTable::hash<2>(std::vector<SQL_t>) const;
+template PrimitiveExpr<uint64_t, 4> HashTable::hash<4>(std::vector<SQL_t>) const;
+template PrimitiveExpr<uint64_t, 8> HashTable::hash<8>(std::vector<SQL_t>) const;
+template PrimitiveExpr<uint64_t, 16> HashTable::hash<16>(std::vector<SQL_t>) const;
+template PrimitiveExpr<uint64_t, 32> HashTable::hash<32>(std::vector<SQL_t>) const;
+
 std::pair<HashTable::size_t, HashTable::size_t>
 HashTable::set_byte_offsets(std::vector<HashTable::offset_t> &offsets_in_bytes, const std::vector<const Type*> &types,
                             HashTable::offset_t initial_offset_in_bytes,
@@ -469,6 +862,111 @@ HashTable::set_byte_offsets(std::vector<HashTable::offset_t> &offsets_in_bytes,
     return { current_offset_in_bytes, max_alignment_in_bytes };
 }
 
+bool HashTable::set_packed_key_offsets()
+{
+    packed_key_size_in_bytes_ = 0;
+    packed_key_offsets_in_bytes_.clear();
+
+    if (key_indices_.size() < 2)
+        return false; // a single key value is compared with a single comparison anyways
+
+    /*----- Check whether all key values are distinct `NOT NULL` integral values. -----*/
+    std::vector<std::size_t> key_sizes_in_bytes;
+    for (std::size_t i = 0; i != key_indices_.size(); ++i) {
+        /* NOTE: `std::find` results in quadratic complexity but we expect rather short keys anyway */
+        if (std::find(key_indices_.begin(), key_indices_.begin() + i, key_indices_[i]) != key_indices_.begin() + i)
+            return false; // duplicated key value
+        auto &e = schema_.get()[key_indices_[i]];
+        if (e.nullable())
+            return false;
+        const bool is_integral = visit(overloaded {
+            [](const Numeric &n) { return n.kind == Numeric::N_Int or n.kind == Numeric::N_Decimal; },
+            [](const Date&) { return true; },
+            [](const DateTime&) { return true; },
+            [](auto&&) { return false; }, // floats compare differently than their bits, e.g. -0.0 == 0.0
+        }, *e.type);
+        if (not is_integral)
+            return false;
+        key_sizes_in_bytes.push_back(e.type->size() / 8);
+    }
+
+    /*----- Sort key values by size s.t. each value is aligned within the packed key. -----*/
+    std::size_t indices[key_indices_.size()];
+    std::iota(indices, indices + key_indices_.size(), 0);
+    std::stable_sort(indices, indices + key_indices_.size(), [&](std::size_t left, std::size_t right) {
+        return key_sizes_in_bytes[left] > key_sizes_in_bytes[right];
+    });
+
+    /*----- Compute offsets within the packed key. -----*/
+    std::vector<offset_t> offsets(key_indices_.size());
+    offset_t current_offset_in_bytes = 0;
+    for (std::size_t idx = 0; idx != key_indices_.size(); ++idx) {
+        offsets[indices[idx]] = current_offset_in_bytes;
+        current_offset_in_bytes += key_sizes_in_bytes[indices[idx]];
+    }
+    if (current_offset_in_bytes > 8)
+        return false; // does not fit into a single word
+
+    packed_key_size_in_bytes_ = current_offset_in_bytes <= 4 ? 4 : 8;
+    packed_key_offsets_in_bytes_ = std::move(offsets);
+    return true;
+}
+
+bool HashTable::is_packable(const std::vector<SQL_t> &key) const
+{
+    if (packed_key_size_in_bytes_ == 0)
+        return false;
+    return std::none_of(key.begin(), key.end(), [](const SQL_t &value) {
+        return std::visit(overloaded {
+            [](const auto &v) { return v.can_be_null(); },
+            [](const std::monostate&) -> bool { M_unreachable("invalid variant"); },
+        }, value);
+    });
+}
+
+U64x1 HashTable::pack_key(std::vector<SQL_t> key) const
+{
+    M_insist(is_packable(key), "key cannot be packed");
+
+    Var<U64x1> packed(uint64_t(0));
+    for (std::size_t i = 0; i != key.size(); ++i) {
+        const uint64_t shift = 8 * packed_key_offsets_in_bytes_[i];
+        std::visit(overloaded {
+            [&]<typename T>(Expr<T> val) -> void {
+                if constexpr (std::integral<T> and not std::same_as<T, bool>) {
+                    U64x1 bits = reinterpret_to_U64(val.insist_not_null()); // zero-extended
+                    if (shift)
+                        packed |= bits << shift;
+                    else
+                        packed |= bits;
+                } else {
+                    M_unreachable("invalid type of packed key value");
+                }
+            },
+            [](auto) -> void { M_unreachable("invalid type of packed key value"); },
+            [](std::monostate) -> void { M_unreachable("invalid variant"); }
+        }, std::move(key[i]));
+    }
+    return packed;
+}
+
+U64x1 HashTable::load_packed_key(Ptr<void> entry) const
+{
+    M_insist(packed_key_size_in_bytes_ != 0, "key is not packed");
+    if (packed_key_size_in_bytes_ == 4)
+        return U32x1(*entry.to<uint32_t*>()).to<uint64_t>();
+    return U64x1(*entry.to<uint64_t*>());
+}
+
+void HashTable::store_packed_key(Ptr<void> entry, U64x1 packed_key) const
+{
+    M_insist(packed_key_size_in_bytes_ != 0, "key is not packed");
+    if (packed_key_size_in_bytes_ == 4)
+        *entry.to<uint32_t*>() = packed_key.to<uint32_t>();
+    else
+        *entry.to<uint64_t*>() = packed_key;
+}
+
 
 /*----- chained hash tables ------------------------------------------------------------------------------------------*/
 
@@ -480,23 +978,29 @@ ChainedHashTable<IsGlobal>::ChainedHashTable(const Schema &schema, std::vector<H
     std::vector<const Type*> types;
     bool has_nullable = false;
 
+    /*----- Decide whether to pack the key into a single word at the front of each entry. -----*/
+    const bool packed = set_packed_key_offsets();
+
     /*----- Add pointer to next entry in linked collision list. -----*/
     types.push_back(Type::Get_Integer(Type::TY_Vector, sizeof(uint32_t)));
 
-    /*----- Add schema types. -----*/
-    for (auto &e : schema_.get()) {
-        types.push_back(e.type);
-        has_nullable |= e.nullable();
+    /*----- Add schema types.  Exclude packed keys. -----*/
+    for (std::size_t i = 0; i < schema_.get().num_entries(); ++i) {
+        has_nullable |= schema_.get()[i].nullable();
+        if (packed and contains(key_indices_, i))
+            continue;
+        types.push_back(schema_.get()[i].type);
     }
 
     if (has_nullable) {
         /*----- Add type for NULL bitmap. Pointer to next entry in collision list cannot be NULL. -----*/
-        types.push_back(Type::Get_Bitmap(Type::TY_Vector, types.size() - 1));
+        types.push_back(Type::Get_Bitmap(Type::TY_Vector, schema_.get().num_entries()));
     }
 
     /*----- Compute entry offsets and set entry size and alignment requirement. -----*/
     std::vector<HashTable::offset_t> offsets;
-    std::tie(entry_size_in_bytes_, entry_max_alignment_in_bytes_) = set_byte_offsets(offsets, types);
+    std::tie(entry_size_in_bytes_, entry_max_alignment_in_bytes_) =
+        set_byte_offsets(offsets, types, packed_key_size_in_bytes_, std::max<size_t>(1, packed_key_size_in_bytes_));
 
     /*----- Set offset for pointer to next entry in collision list. -----*/
     ptr_offset_in_bytes_ = offsets.front();
@@ -508,7 +1012,17 @@ ChainedHashTable<IsGlobal>::ChainedHashTable(const Schema &schema, std::vector<H
     }
 
     /*----- Set entry offset. Exclude offset for pointer to next entry in collision list. -----*/
-    entry_offsets_in_bytes_ = std::vector<HashTable::offset_t>(std::next(offsets.begin()), offsets.end());
+    auto offset_it = std::next(offsets.begin());
+    for (std::size_t i = 0; i < schema_.get().num_entries(); ++i) {
+        if (packed and contains(key_indices_, i)) {
+            const auto key_pos = std::distance(key_indices_.begin(), std::find(key_indices_.begin(),
+                                                                               key_indices_.end(), i));
+            entry_offsets_in_bytes_.push_back(packed_key_offsets_in_bytes_[key_pos]); // packed key is at offset 0
+        } else {
+            entry_offsets_in_bytes_.push_back(*offset_it++);
+        }
+    }
+    M_insist(offset_it == offsets.end());
 
     /*----- Initialize capacity and absolute high watermark. -----*/
     const auto capacity_init = ceil_to_pow_2(initial_capacity);
@@ -537,7 +1051,7 @@ ChainedHashTable<IsGlobal>::~ChainedHashTable()
             WHILE (not bucket_it.is_nullptr()) { // another entry in collision list
                 const Var<Ptr<void>> tmp(bucket_it);
                 bucket_it = Ptr<void>(*(bucket_it + ptr_offset_in_bytes_).template to<uint32_t*>());
-                Module::Allocator().deallocate(tmp, entry_size_in_bytes_);
+                Module::Allocator().deallocate_object(tmp, entry_size_in_bytes_, entry_max_alignment_in_bytes_);
             }
             it += int32_t(sizeof(uint32_t));
         }
@@ -557,7 +1071,7 @@ ChainedHashTable<IsGlobal>::~ChainedHashTable()
             WHILE (not bucket_it.is_nullptr()) { // another entry in collision list
                 const Var<Ptr<void>> tmp(bucket_it);
                 bucket_it = Ptr<void>(*(bucket_it + ptr_offset_in_bytes_).to<uint32_t*>());
-                Module::Allocator().deallocate(tmp, entry_size_in_bytes_);
+                Module::Allocator().deallocate_object(tmp, entry_size_in_bytes_, entry_max_alignment_in_bytes_);
             }
 #endif
             Module::Allocator().deallocate(*predication_dummy_, sizeof(uint32_t));
@@ -628,7 +1142,7 @@ void ChainedHashTable<IsGlobal>::teardown()
             WHILE (not bucket_it.is_nullptr()) { // another entry in collision list
                 const Var<Ptr<void>> tmp(bucket_it);
                 bucket_it = Ptr<void>(*(bucket_it + ptr_offset_in_bytes_).template to<uint32_t*>());
-                Module::Allocator().deallocate(tmp, entry_size_in_bytes_);
+                Module::Allocator().deallocate_object(tmp, entry_size_in_bytes_, entry_max_alignment_in_bytes_);
             }
             it += int32_t(sizeof(uint32_t));
         }
@@ -648,7 +1162,7 @@ void ChainedHashTable<IsGlobal>::teardown()
             WHILE (not bucket_it.is_nullptr()) { // another entry in collision list
                 const Var<Ptr<void>> tmp(bucket_it);
                 bucket_it = Ptr<void>(*(bucket_it + ptr_offset_in_bytes_).to<uint32_t*>());
-                Module::Allocator().deallocate(tmp, entry_size_in_bytes_);
+                Module::Allocator().deallocate_object(tmp, entry_size_in_bytes_, entry_max_alignment_in_bytes_);
             }
 #endif
             Module::Allocator().deallocate(*predication_dummy_, sizeof(uint32_t));
@@ -681,7 +1195,7 @@ void ChainedHashTable<IsGlobal>::clear()
         WHILE (not bucket_it.is_nullptr()) { // another entry in collision list
             const Var<Ptr<void>> tmp(bucket_it);
             bucket_it = Ptr<void>(*(bucket_it + ptr_offset_in_bytes_).to<uint32_t*>());
-            Module::Allocator().deallocate(tmp, entry_size_in_bytes_); // free collision list entry
+            Module::Allocator().deallocate_object(tmp, entry_size_in_bytes_, entry_max_alignment_in_bytes_);
         }
 #endif
         *(it + ptr_offset_in_bytes_).template to<uint32_t*>() = 0U; // set to nullptr
@@ -692,19 +1206,13 @@ void ChainedHashTable<IsGlobal>::clear()
 template<bool IsGlobal>
 Ptr<void> ChainedHashTable<IsGlobal>::hash_to_bucket(std::vector<SQL_t> key) const
 {
-    M_insist(bool(mask_), "must call `setup()` before");
-    M_insist(key.size() == key_indices_.size(),
-             "provided number of key elements does not match hash table's number of key indices");
-
-    /*----- Collect types of key together with the respective value. -----*/
-    std::vector<std::pair<const Type*, SQL_t>> values;
-    values.reserve(key_indices_.size());
-    auto key_it = key.begin();
-    for (auto k : key_indices_)
-        values.emplace_back(schema_.get()[k].type, std::move(*key_it++));
+    return bucket_of(hash(std::move(key)));
+}
 
-    /*----- Compute hash of key using Murmur3_64a. -----*/
-    U64x1 hash = murmur3_64a_hash(std::move(values));
+template<bool IsGlobal>
+Ptr<void> ChainedHashTable<IsGlobal>::bucket_of(U64x1 hash) const
+{
+    M_insist(bool(mask_), "must call `setup()` before");
 
     /*----- Compute bucket address. -----*/
     U32x1 bucket_idx = hash.to<uint32_t>() bitand *mask_; // modulo capacity
@@ -775,7 +1283,7 @@ HashTable::entry_t ChainedHashTable<IsGlobal>::emplace_without_rehashing(std::ve
     ); // clone key since we need it again for insertion
 
     /*----- Allocate memory for entry. -----*/
-    Var<Ptr<void>> entry = Module::Allocator().allocate(entry_size_in_bytes_, entry_max_alignment_in_bytes_);
+    Var<Ptr<void>> entry = Module::Allocator().allocate_object(entry_size_in_bytes_, entry_max_alignment_in_bytes_);
 
     /*----- Iff no predication is used or predicate is fulfilled, insert entry at collision list's front. -----*/
     *(entry + ptr_offset_in_bytes_).template to<uint32_t*>() = *bucket.to<uint32_t*>();
@@ -847,7 +1355,7 @@ std::pair<HashTable::entry_t, Boolx1> ChainedHashTable<IsGlobal>::try_emplace(st
         entry_inserted = true;
 
         /*----- Allocate memory for entry. -----*/
-        Var<Ptr<void>> entry = Module::Allocator().allocate(entry_size_in_bytes_, entry_max_alignment_in_bytes_);
+        Var<Ptr<void>> entry = Module::Allocator().allocate_object(entry_size_in_bytes_, entry_max_alignment_in_bytes_);
 
         /*----- Iff no predication is used or predicate is fulfilled, insert entry at the collision list's end. -----*/
         *(bucket_it + ptr_offset_in_bytes_).template to<uint32_t*>() = pred ? Select(*pred, entry.to<uint32_t>(), 0U)
@@ -944,6 +1452,9 @@ HashTable::entry_t ChainedHashTable<IsGlobal>::dummy_entry()
 template<bool IsGlobal>
 Boolx1 ChainedHashTable<IsGlobal>::equal_key(Ptr<void> entry, std::vector<SQL_t> key) const
 {
+    if (is_packable(key))
+        return load_packed_key(entry) == pack_key(std::move(key));
+
     Var<Boolx1> res(true);
 
     for (std::size_t i = 0; i < key_indices_.size(); ++i) {
@@ -1009,6 +1520,13 @@ Boolx1 ChainedHashTable<IsGlobal>::equal_key(Ptr<void> entry, std::vector<SQL_t>
 template<bool IsGlobal>
 void ChainedHashTable<IsGlobal>::insert_key(Ptr<void> entry, std::vector<SQL_t> key)
 {
+    if (is_packable(key)) {
+        store_packed_key(entry, pack_key(std::move(key)));
+        return;
+    }
+    if (packed_key_size_in_bytes_)
+        store_packed_key(entry.clone(), U64x1(uint64_t(0))); // zero bytes of the packed key not covered by values
+
     for (std::size_t i = 0; i < key_indices_.size(); ++i) {
         /* NOTE: `std::find` results in quadratic complexity but we expect rather short keys anyway */
         if (std::find(key_indices_.begin(), key_indices_.begin() + i, key_indices_[i]) != key_indices_.begin() + i) {
@@ -1331,19 +1849,11 @@ void OpenAddressingHashTableBase::clear()
 
 Ptr<void> OpenAddressingHashTableBase::hash_to_bucket(std::vector<SQL_t> key) const
 {
-    M_insist(key.size() == key_indices_.size(),
-             "provided number of key elements does not match hash table's number of key indices");
-
-    /*----- Collect types of key together with the respective value. -----*/
-    std::vector<std::pair<const Type*, SQL_t>> values;
-    values.reserve(key_indices_.size());
-    auto key_it = key.begin();
-    for (auto k : key_indices_)
-        values.emplace_back(schema_.get()[k].type, std::move(*key_it++));
-
-    /*----- Compute hash of key using Murmur3_64a. -----*/
-    U64x1 hash = murmur3_64a_hash(std::move(values));
+    return bucket_of(hash(std::move(key)));
+}
 
+Ptr<void> OpenAddressingHashTableBase::bucket_of(U64x1 hash) const
+{
     /*----- Compute bucket address. -----*/
     U32x1 bucket_idx = hash.to<uint32_t>() bitand mask(); // modulo capacity
     Ptr<void> bucket = begin() + (bucket_idx * entry_size_in_bytes_).make_signed();
@@ -1354,33 +1864,50 @@ Ptr<void> OpenAddressingHashTableBase::hash_to_bucket(std::vector<SQL_t> key) co
 template<bool IsGlobal, bool ValueInPlace>
 OpenAddressingHashTable<IsGlobal, ValueInPlace>::OpenAddressingHashTable(const Schema &schema,
                                                                          std::vector<HashTable::index_t> key_indices,
-                                                                         uint32_t initial_capacity)
+                                                                         uint32_t initial_capacity,
+                                                                         bool with_reference_counters)
     : OpenAddressingHashTableBase(schema, std::move(key_indices))
 {
+    M_insist(ValueInPlace or with_reference_counters, "out-of-place values require reference counters");
+
     std::vector<const Type*> types;
     bool has_nullable = false;
 
+    /*----- Decide whether to pack the key into a single word at the front of each slot. -----*/
+    const bool packed = set_packed_key_offsets();
+    /* Returns the offset of the `i`-th entry of the schema within the packed key.  The packed key is at offset 0. */
+    auto packed_key_offset = [this](std::size_t i) {
+        const auto key_pos = std::distance(key_indices_.begin(), std::find(key_indices_.begin(), key_indices_.end(), i));
+        return packed_key_offsets_in_bytes_[key_pos];
+    };
+    const HashTable::offset_t initial_offset_in_bytes = packed_key_size_in_bytes_;
+    const HashTable::offset_t initial_max_alignment_in_bytes = std::max<size_t>(1, packed_key_size_in_bytes_);
+
     /*----- Add reference counter. -----*/
-    types.push_back(Type::Get_Integer(Type::TY_Vector, sizeof(ref_t)));
+    if (with_reference_counters)
+        types.push_back(Type::Get_Integer(Type::TY_Vector, sizeof(ref_t)));
 
     if constexpr (ValueInPlace) {
-        /*----- Add schema types. -----*/
-        for (auto &e : schema_.get()) {
-            types.push_back(e.type);
-            has_nullable |= e.nullable();
+        /*----- Add schema types.  Exclude packed keys. -----*/
+        for (std::size_t i = 0; i < schema_.get().num_entries(); ++i) {
+            has_nullable |= schema_.get()[i].nullable();
+            if (packed and contains(key_indices_, i))
+                continue;
+            types.push_back(schema_.get()[i].type);
         }
 
         if (has_nullable) {
             /*----- Add type for NULL bitmap. Reference counter cannot be NULL. -----*/
-            types.push_back(Type::Get_Bitmap(Type::TY_Vector, types.size() - 1));
+            types.push_back(Type::Get_Bitmap(Type::TY_Vector, schema_.get().num_entries()));
         }
 
         /*----- Compute entry offsets and set entry size and alignment requirement. -----*/
         std::vector<HashTable::offset_t> offsets;
-        std::tie(entry_size_in_bytes_, entry_max_alignment_in_bytes_) = set_byte_offsets(offsets, types);
+        std::tie(entry_size_in_bytes_, entry_max_alignment_in_bytes_) =
+            set_byte_offsets(offsets, types, initial_offset_in_bytes, initial_max_alignment_in_bytes);
 
         /*----- Set offset for reference counter. -----*/
-        refs_offset_in_bytes_ = offsets.front();
+        refs_offset_in_bytes_ = with_reference_counters ? offsets.front() : -1;
 
         if (has_nullable) {
             /*----- Set offset for NULL bitmap and remove it from `offsets`. -----*/
@@ -1389,27 +1916,36 @@ OpenAddressingHashTable<IsGlobal, ValueInPlace>::OpenAddressingHashTable(const S
         }
 
         /*----- Set entry offset. Exclude offset for reference counter. -----*/
-        layout_.entry_offsets_in_bytes_ = std::vector<HashTable::offset_t>(std::next(offsets.begin()), offsets.end());
+        auto offset_it = std::next(offsets.begin(), with_reference_counters);
+        for (std::size_t i = 0; i < schema_.get().num_entries(); ++i) {
+            if (packed and contains(key_indices_, i))
+                layout_.entry_offsets_in_bytes_.push_back(packed_key_offset(i));
+            else
+                layout_.entry_offsets_in_bytes_.push_back(*offset_it++);
+        }
+        M_insist(offset_it == offsets.end());
     } else {
-        /*----- Add key types. -----*/
+        /*----- Add key types.  Exclude packed keys. -----*/
         for (std::size_t i = 0; i < schema_.get().num_entries(); ++i) {
-            if (not contains(key_indices_, i))
+            if (packed or not contains(key_indices_, i))
                 continue;
             types.push_back(schema_.get()[i].type);
             has_nullable |= schema_.get()[i].nullable();
         }
+        const std::size_t num_key_types = types.size() - 1; // exclude reference counter
 
         /*----- Add type for pointer to out-of-place values. -----*/
         types.push_back(Type::Get_Integer(Type::TY_Vector, 4));
 
         if (has_nullable) {
             /*----- Add type for keys NULL bitmap. Reference counter and pointer to values cannot be NULL. -----*/
-            types.push_back(Type::Get_Bitmap(Type::TY_Vector, types.size() - 2));
+            types.push_back(Type::Get_Bitmap(Type::TY_Vector, num_key_types));
         }
 
         /*----- Compute entry offsets and set entry size and alignment requirement. -----*/
         std::vector<HashTable::offset_t> offsets;
-        std::tie(entry_size_in_bytes_, entry_max_alignment_in_bytes_) = set_byte_offsets(offsets, types);
+        std::tie(entry_size_in_bytes_, entry_max_alignment_in_bytes_) =
+            set_byte_offsets(offsets, types, initial_offset_in_bytes, initial_max_alignment_in_bytes);
 
         /*----- Set offset for reference counter. -----*/
         refs_offset_in_bytes_ = offsets.front();
@@ -1422,8 +1958,15 @@ OpenAddressingHashTable<IsGlobal, ValueInPlace>::OpenAddressingHashTable(const S
 
         /*----- Set offset for pointer to out-of-place values and key offsets. Exclude offset for reference counter. -*/
         layout_.ptr_offset_in_bytes_ = offsets.back();
-        layout_.key_offsets_in_bytes_ =
-            std::vector<HashTable::offset_t>(std::next(offsets.begin()), std::prev(offsets.end()));
+        if (packed) {
+            for (std::size_t i = 0; i < schema_.get().num_entries(); ++i) {
+                if (contains(key_indices_, i))
+                    layout_.key_offsets_in_bytes_.push_back(packed_key_offset(i));
+            }
+        } else {
+            layout_.key_offsets_in_bytes_ =
+                std::vector<HashTable::offset_t>(std::next(offsets.begin()), std::prev(offsets.end()));
+        }
 
         /*----- Add value types. -----*/
         types.clear();
@@ -1484,8 +2027,10 @@ OpenAddressingHashTable<IsGlobal, ValueInPlace>::~OpenAddressingHashTable()
             WHILE (it != end) {
                 Wasm_insist(storage_.address_ <= it and it < end, "entry out-of-bounds");
                 IF (reference_count(it) != ref_t(0)) { // occupied
-                    Module::Allocator().deallocate(Ptr<void>(*(it + layout_.ptr_offset_in_bytes_).template to<uint32_t*>()),
-                                                   layout_.values_size_in_bytes_);
+                    Module::Allocator().deallocate_object(
+                        Ptr<void>(*(it + layout_.ptr_offset_in_bytes_).template to<uint32_t*>()),
+                        layout_.values_size_in_bytes_, layout_.values_max_alignment_in_bytes_
+                    );
                 };
                 it += int32_t(entry_size_in_bytes_);
             }
@@ -1561,8 +2106,10 @@ void OpenAddressingHashTable<IsGlobal, ValueInPlace>::teardown()
             WHILE (it != end()) {
                 Wasm_insist(begin() <= it and it < end(), "entry out-of-bounds");
                 IF (reference_count(it) != ref_t(0)) { // occupied
-                    Module::Allocator().deallocate(Ptr<void>(*(it + layout_.ptr_offset_in_bytes_).template to<uint32_t*>()),
-                                                   layout_.values_size_in_bytes_);
+                    Module::Allocator().deallocate_object(
+                        Ptr<void>(*(it + layout_.ptr_offset_in_bytes_).template to<uint32_t*>()),
+                        layout_.values_size_in_bytes_, layout_.values_max_alignment_in_bytes_
+                    );
                 };
                 it += int32_t(entry_size_in_bytes_);
             }
@@ -1633,7 +2180,7 @@ HashTable::entry_t OpenAddressingHashTable<IsGlobal, ValueInPlace>::emplace(std:
     } else {
         /*----- Allocate memory for out-of-place values and set pointer to it. -----*/
         Ptr<void> ptr =
-            Module::Allocator().allocate(layout_.values_size_in_bytes_, layout_.values_max_alignment_in_bytes_);
+            Module::Allocator().allocate_object(layout_.values_size_in_bytes_, layout_.values_max_alignment_in_bytes_);
         *(slot + layout_.ptr_offset_in_bytes_).template to<uint32_t*>() = ptr.clone().to<uint32_t>();
 
         /*----- Return entry handle containing all values. -----*/
@@ -1764,8 +2311,8 @@ OpenAddressingHashTable<IsGlobal, ValueInPlace>::try_emplace(std::vector<SQL_t>
 
         if constexpr (not ValueInPlace) {
             /*----- Allocate memory for out-of-place values and set pointer to it. -----*/
-            Ptr<void> ptr =
-                Module::Allocator().allocate(layout_.values_size_in_bytes_, layout_.values_max_alignment_in_bytes_);
+            Ptr<void> ptr = Module::Allocator().allocate_object(layout_.values_size_in_bytes_,
+                                                                layout_.values_max_alignment_in_bytes_);
             *(slot + layout_.ptr_offset_in_bytes_).template to<uint32_t*>() = ptr.clone().to<uint32_t>();
 
             if (pred) {
@@ -1903,6 +2450,9 @@ HashTable::entry_t OpenAddressingHashTable<IsGlobal, ValueInPlace>::dummy_entry(
 template<bool IsGlobal, bool ValueInPlace>
 Boolx1 OpenAddressingHashTable<IsGlobal, ValueInPlace>::equal_key(Ptr<void> slot, std::vector<SQL_t> key) const
 {
+    if (is_packable(key))
+        return load_packed_key(slot) == pack_key(std::move(key));
+
     Var<Boolx1> res(true);
 
     const auto off_null_bitmap = M_CONSTEXPR_COND(ValueInPlace, layout_.null_bitmap_offset_in_bytes_,
@@ -1980,6 +2530,13 @@ Boolx1 OpenAddressingHashTable<IsGlobal, ValueInPlace>::equal_key(Ptr<void> slot
 template<bool IsGlobal, bool ValueInPlace>
 void OpenAddressingHashTable<IsGlobal, ValueInPlace>::insert_key(Ptr<void> slot, std::vector<SQL_t> key)
 {
+    if (is_packable(key)) {
+        store_packed_key(slot, pack_key(std::move(key)));
+        return;
+    }
+    if (packed_key_size_in_bytes_)
+        store_packed_key(slot.clone(), U64x1(uint64_t(0))); // zero bytes of the packed key not covered by values
+
     const auto off_null_bitmap = M_CONSTEXPR_COND(ValueInPlace, layout_.null_bitmap_offset_in_bytes_,
                                                                 layout_.keys_null_bitmap_offset_in_bytes_);
     for (std::size_t i = 0; i < key_indices_.size(); ++i) {
@@ -2379,6 +2936,506 @@ template struct m::wasm::OpenAddressingHashTable<true, false>;
 template struct m::wasm::OpenAddressingHashTable<true, true>;
 
 
+/*----- Swiss tables -------------------------------------------------------------------------------------------------*/
+
+template<bool IsGlobal>
+SwissHashTable<IsGlobal>::SwissHashTable(const Schema &schema, std::vector<HashTable::index_t> key_indices,
+                                         uint32_t initial_capacity)
+    : base_type(schema, std::move(key_indices), std::max(initial_capacity, GROUP_SIZE - 1U),
+                /* with_reference_counters= */ false) // at least one group, i.e. capacity `GROUP_SIZE`
+    , empty_group_(Module::Allocator().pre_malloc<uint8_t, GROUP_SIZE>())
+{
+    if constexpr (IsGlobal)
+        control_storage_.control_.init(0); // init with nullptr
+}
+
+template<bool IsGlobal>
+SwissHashTable<IsGlobal>::~SwissHashTable()
+{
+    empty_group_.discard();
+    if constexpr (IsGlobal) { // free memory of global hash table when object is destroyed and no use may occur later
+        /*----- Free control bytes.  The slots are freed by the base class. -----*/
+        Module::Allocator().deallocate(control_storage_.control_, this->storage_.mask_ + 1U);
+    }
+}
+
+template<bool IsGlobal>
+void SwissHashTable<IsGlobal>::setup()
+{
+    M_insist(not control_, "must not call `setup()` twice");
+
+    /*----- Create local variable for control bytes.  Allocate them before the slots s.t. the base class can clear
+     * them when allocating the slots. -----*/
+    control_.emplace();
+    if constexpr (IsGlobal) {
+        IF (control_storage_.control_.is_nullptr()) { // hash table not yet allocated
+            *control_ = Module::Allocator().allocate(this->storage_.mask_ + 1U, GROUP_SIZE);
+        } ELSE {
+            *control_ = control_storage_.control_;
+        };
+    } else {
+        *control_ = Module::Allocator().allocate(this->capacity(), GROUP_SIZE);
+    }
+
+    /*----- Initialize the control bytes of the group without occupied slots at runtime s.t. a cached module does not
+     * rely on memory written during code generation. -----*/
+    *empty_group_.clone() = U8x1(EMPTY).template broadcast<GROUP_SIZE>();
+
+    base_type::setup();
+}
+
+template<bool IsGlobal>
+void SwissHashTable<IsGlobal>::teardown()
+{
+    M_insist(bool(control_), "must call `setup()` before");
+
+    if constexpr (IsGlobal) {
+        /*----- Write control bytes address into global backup. -----*/
+        control_storage_.control_ = *control_;
+        base_type::teardown();
+    } else {
+        /*----- Free control bytes after the slots. -----*/
+        const Var<U32x1> capacity(this->capacity());
+        base_type::teardown();
+        Module::Allocator().deallocate(*control_, capacity);
+    }
+
+    /*----- Destroy local variable. -----*/
+    control_.reset();
+}
+
+template<bool IsGlobal>
+void SwissHashTable<IsGlobal>::clear()
+{
+    /*----- Set all control bytes to `EMPTY`, one group at a time. -----*/
+    const Var<U8<GROUP_SIZE>> empty(U8x1(EMPTY).template broadcast<GROUP_SIZE>());
+    Var<U32x1> group_idx(0U);
+    WHILE (group_idx != group_mask() + 1U) {
+        *group(group_idx).template to<uint8_t*, GROUP_SIZE>() = empty;
+        group_idx += 1U;
+    }
+}
+
+template<bool IsGlobal>
+std::optional<Boolx1> SwissHashTable<IsGlobal>::extract_predicate() const
+{
+    auto &env = CodeGenContext::Get().env();
+    if (not env.predicated())
+        return std::nullopt;
+
+    M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes");
+    if (not this->predication_dummy_) {
+        /*----- Create dummy entry for predication.  It needs no control byte since it is never probed. -----*/
+        auto _this = const_cast<SwissHashTable<IsGlobal>*>(this);
+        _this->predication_dummy_.emplace(); // since globals cannot be constructed with runtime values
+        *_this->predication_dummy_ =
+            Module::Allocator().allocate(this->entry_size_in_bytes_, this->entry_max_alignment_in_bytes_);
+        _this->dummy_allocations_.emplace_back(*this->predication_dummy_, this->entry_size_in_bytes_);
+    }
+    return env.extract_predicate<_Boolx1>().is_true_and_not_null();
+}
+
+template<bool IsGlobal>
+Ptr<void> SwissHashTable<IsGlobal>::first_group(U64x1 hash, std::optional<Boolx1> pred) const
+{
+    Ptr<void> first = group(hash.to<uint32_t>() bitand group_mask()); // modulo number of groups
+    if (pred) // use group without occupied slots if predicate is not fulfilled
+        return Select(*pred, first, empty_group_.clone().template to<void*>());
+    return first;
+}
+
+template<bool IsGlobal>
+std::pair<Ptr<void>, U8x1> SwissHashTable<IsGlobal>::probe_start(std::vector<SQL_t> key,
+                                                                 HashTable::hint_t bucket_hint) const
+{
+    const Var<U64x1> hash(this->hash(std::move(key)));
+    Ptr<void> first = bucket_hint ? *bucket_hint : first_group(hash, extract_predicate());
+    return { first, tag_of(hash) };
+}
+
+template<bool IsGlobal>
+U32x1 SwissHashTable<IsGlobal>::probe(Ptr<void> first, U8x1 tag, std::function<void(U32x1)> Match) const
+{
+    std::optional<Var<U8<GROUP_SIZE>>> tags;
+    if (Match)
+        tags.emplace(tag.template broadcast<GROUP_SIZE>());
+    else
+        tag.discard();
+
+    /*----- Compute index of first group.  Mask it s.t. the group without occupied slots maps to a valid index. -----*/
+    Var<Ptr<void>> control(first.clone());
+    Var<U32x1> group_idx(((first - *control_).make_unsigned() >> LOG_GROUP_SIZE) bitand group_mask());
+
+    Var<U32x1> step(0U);
+    Var<U32x1> empty_slots;
+    LOOP () {
+        const Var<U8<GROUP_SIZE>> controls(*control.template to<uint8_t*, GROUP_SIZE>());
+
+        /*----- Call `Match` for each slot whose control byte equals the tag. -----*/
+        if (Match) {
+            Var<U32x1> matches((controls == *tags).bitmask());
+            WHILE (matches != 0U) {
+                Match((group_idx << LOG_GROUP_SIZE) + matches.ctz());
+                matches = matches bitand (matches - 1U); // clear lowest set bit
+            }
+        }
+
+        /*----- Stop at the first group with an unoccupied slot. -----*/
+        empty_slots = controls.bitmask(); // only `EMPTY` has the most significant bit set
+        BREAK(empty_slots != 0U);
+
+        /*----- Advance to next group using quadratic probing. -----*/
+        step += 1U;
+        Wasm_insist(step <= group_mask(), "probing has to find unoccupied slot if there is one");
+        group_idx = (group_idx + step) bitand group_mask();
+        control = group(group_idx);
+        CONTINUE();
+    }
+
+    return (group_idx << LOG_GROUP_SIZE) + empty_slots.ctz();
+}
+
+template<bool IsGlobal>
+Ptr<void> SwissHashTable<IsGlobal>::compute_bucket(std::vector<SQL_t> key) const
+{
+    auto pred = extract_predicate();
+    const Var<Ptr<void>> first(first_group(this->hash(std::move(key)), std::move(pred)));
+    return first;
+}
+
+template<bool IsGlobal>
+Ptr<void> SwissHashTable<IsGlobal>::bucket_of(U64x1 hash) const
+{
+    return first_group(hash, std::nullopt);
+}
+
+template<bool IsGlobal>
+HashTable::entry_t SwissHashTable<IsGlobal>::emplace(std::vector<SQL_t> key)
+{
+    M_insist(bool(this->num_entries_), "must call `setup()` before");
+    M_insist(bool(this->high_watermark_absolute_), "must call `setup()` before");
+
+    /*----- If high watermark is reached, perform rehashing and update high watermark. -----*/
+    IF (*this->num_entries_ == *this->high_watermark_absolute_) {
+        rehash();
+        this->update_high_watermark();
+    };
+
+    /*----- Return entry handle containing all values. -----*/
+    return this->value_entry(emplace_without_rehashing(std::move(key)));
+}
+
+template<bool IsGlobal>
+Ptr<void> SwissHashTable<IsGlobal>::emplace_without_rehashing(std::vector<SQL_t> key)
+{
+    M_insist(bool(this->num_entries_), "must call `setup()` before");
+    M_insist(bool(this->high_watermark_absolute_), "must call `setup()` before");
+
+    Wasm_insist(*this->num_entries_ < *this->high_watermark_absolute_);
+
+    /*----- If predication is used, introduce predication variable and update it before inserting a key. -----*/
+    std::optional<Var<Boolx1>> pred;
+    if (auto p = extract_predicate())
+        pred.emplace(*p);
+
+    /*----- Hash the key and search the first unoccupied slot. -----*/
+    const Var<U64x1> hash(this->hash(HashTable::clone(key))); // clone key since we need it again for insertion
+    const Var<U8x1> tag(tag_of(hash));
+    const Var<U32x1> idx(probe(first_group(hash, pred ? std::optional<Boolx1>(*pred) : std::nullopt), tag));
+
+    /*----- Iff no predication is used or predicate is fulfilled, occupy slot.  Otherwise, use dummy slot and
+     * retain the control byte. -----*/
+    const Var<Ptr<void>> slot(pred ? Select(*pred, this->slot(idx), *this->predication_dummy_) : this->slot(idx));
+    *control_byte(idx) = pred ? Select(*pred, tag, *control_byte(idx)) : tag.val();
+
+    /*----- Update number of entries. -----*/
+    *this->num_entries_ += pred ? pred->template to<uint32_t>() : U32x1(1);
+    Wasm_insist(*this->num_entries_ < this->capacity(), "at least one entry must always be unoccupied for lookups");
+
+    /*----- Insert key. -----*/
+    this->insert_key(slot, std::move(key)); // move key at last use
+
+    return slot;
+}
+
+template<bool IsGlobal>
+std::pair<HashTable::entry_t, Boolx1> SwissHashTable<IsGlobal>::try_emplace(std::vector<SQL_t> key)
+{
+    M_insist(bool(this->num_entries_), "must call `setup()` before");
+    M_insist(bool(this->high_watermark_absolute_), "must call `setup()` before");
+
+    /*----- If high watermark is reached, perform rehashing and update high watermark. -----*/
+    IF (*this->num_entries_ == *this->high_watermark_absolute_) {
+        rehash();
+        this->update_high_watermark();
+    };
+    Wasm_insist(*this->num_entries_ < *this->high_watermark_absolute_);
+
+    /*----- If predication is used, introduce predication variable and update it before inserting a key. -----*/
+    std::optional<Var<Boolx1>> pred;
+    if (auto p = extract_predicate())
+        pred.emplace(*p);
+
+    /*----- Hash the key. -----*/
+    const Var<U64x1> hash(this->hash(HashTable::clone(key))); // clone key since we need it again for comparison
+    const Var<U8x1> tag(tag_of(hash));
+
+    /*----- Probe slots with matching tags, abort and skip insertion if key already exists. -----*/
+    Var<Boolx1> entry_inserted(false);
+    Var<Ptr<void>> slot(this->begin());
+    BLOCK(insert_entry) {
+        const Var<U32x1> idx(probe(
+            /* first= */ first_group(hash, pred ? std::optional<Boolx1>(*pred) : std::nullopt),
+            /* tag=   */ tag,
+            /* Match= */ [&](U32x1 idx) {
+                slot = this->slot(idx);
+                GOTO(this->equal_key(slot, HashTable::clone(key)), insert_entry); // clone key (see above)
+            }
+        ));
+
+        /*----- Set flag to indicate insertion. -----*/
+        entry_inserted = true;
+
+        /*----- Iff no predication is used or predicate is fulfilled, occupy slot.  Otherwise, use dummy slot and
+         * retain the control byte. -----*/
+        slot = pred ? Select(*pred, this->slot(idx), *this->predication_dummy_) : this->slot(idx);
+        *control_byte(idx) = pred ? Select(*pred, tag, *control_byte(idx)) : tag.val();
+
+        /*----- Update number of entries. -----*/
+        *this->num_entries_ += pred ? pred->template to<uint32_t>() : U32x1(1);
+        Wasm_insist(*this->num_entries_ < this->capacity(),
+                    "at least one entry must always be unoccupied for lookups");
+
+        /*----- Insert key. -----*/
+        this->insert_key(slot, std::move(key)); // move key at last use
+    }
+
+    /* GOTO from above jumps here */
+
+    /*----- Return entry handle containing all values and the flag whether an insertion was performed. -----*/
+    return { this->value_entry(slot), entry_inserted };
+}
+
+template<bool IsGlobal>
+std::pair<HashTable::entry_t, Boolx1> SwissHashTable<IsGlobal>::find(std::vector<SQL_t> key,
+                                                                    HashTable::hint_t bucket_hint)
+{
+    M_insist(bool(this->num_entries_), "must call `setup()` before");
+
+    auto [first, tag] = probe_start(HashTable::clone(key), std::move(bucket_hint)); // clone key for comparison
+
+    /*----- Probe slots with matching tags, abort if key is found. -----*/
+    Var<Boolx1> key_found(false);
+    Var<Ptr<void>> slot(this->begin());
+    BLOCK(find_entry) {
+        probe(first, tag, [&](U32x1 idx) {
+            slot = this->slot(idx);
+            key_found = this->equal_key(slot, HashTable::clone(key));
+            GOTO(key_found, find_entry);
+        }).discard();
+    }
+    for (auto &k : key)
+        discard(k); // since it was always cloned
+
+    /*----- Return entry handle containing both keys and values and the flag whether key was found. -----*/
+    return { this->value_entry(slot), key_found };
+}
+
+template<bool IsGlobal>
+void SwissHashTable<IsGlobal>::for_each(HashTable::callback_t Pipeline) const
+{
+    /*----- Iterate over all groups and call pipeline (with entry handle argument) on occupied slots. -----*/
+    Var<U32x1> group_idx(0U);
+    WHILE (group_idx != group_mask() + 1U) {
+        Var<U32x1> occupied(occupied_slots(*group(group_idx).template to<uint8_t*, GROUP_SIZE>()));
+        WHILE (occupied != 0U) {
+            Pipeline(this->entry(slot((group_idx << LOG_GROUP_SIZE) + occupied.ctz())));
+            occupied = occupied bitand (occupied - 1U); // clear lowest set bit
+        }
+        group_idx += 1U;
+    }
+}
+
+template<bool IsGlobal>
+void SwissHashTable<IsGlobal>::for_each_in_equal_range(std::vector<SQL_t> key, HashTable::callback_t Pipeline,
+                                                       bool predicated, HashTable::hint_t bucket_hint) const
+{
+    M_insist(bool(this->num_entries_), "must call `setup()` before");
+
+    auto [first, tag] = probe_start(HashTable::clone(key), std::move(bucket_hint)); // clone key for comparison
+
+    /*----- Call pipeline (with entry handle argument) on slots with matching tags and the given key. -----*/
+    probe(first, tag, [&](U32x1 idx) {
+        const Var<Ptr<void>> slot(this->slot(idx));
+        if (predicated) {
+            CodeGenContext::Get().env().add_predicate(this->equal_key(slot, HashTable::clone(key)));
+            Pipeline(this->entry(slot));
+        } else {
+            IF (this->equal_key(slot, HashTable::clone(key))) { // match found
+                Pipeline(this->entry(slot));
+            };
+        }
+    }).discard();
+    for (auto &k : key)
+        discard(k); // since it was always cloned
+}
+
+template<bool IsGlobal>
+void SwissHashTable<IsGlobal>::rehash()
+{
+    if (options::insist_no_rehashing)
+        Throw(exception::unreachable, "rehashing must not occur");
+
+    auto emit_rehash = [this](){
+        auto S = CodeGenContext::Get().scoped_environment(); // fresh environment to remove predication while rehashing
+
+        M_insist(bool(this->address_), "must call `setup()` before");
+        M_insist(bool(this->mask_), "must call `setup()` before");
+        M_insist(bool(this->num_entries_), "must call `setup()` before");
+        M_insist(bool(control_), "must call `setup()` before");
+
+        /*----- Store old slots, control bytes, and capacity (since they will be overwritten). -----*/
+        const Var<Ptr<void>> begin_old(this->begin());
+        const Var<Ptr<void>> control_old(*control_);
+        const Var<U32x1> capacity_old(this->capacity());
+
+        /*----- Double capacity. -----*/
+        *this->mask_ = (*this->mask_ << 1U) + 1U;
+
+        /*----- Allocate memory for new hash table with updated capacity. -----*/
+        *this->address_ = Module::Allocator().allocate(this->size_in_bytes(), this->entry_max_alignment_in_bytes_);
+        *control_ = Module::Allocator().allocate(this->capacity(), GROUP_SIZE);
+
+        /*----- Clear newly created hash table. -----*/
+        clear();
+
+#ifndef NDEBUG
+        /*----- Store old number of entries. -----*/
+        const Var<U32x1> num_entries_old(*this->num_entries_);
+#endif
+
+        /*----- Reset number of entries (since they will be incremented at each insertion into the new hash table). --*/
+        *this->num_entries_ = 0U;
+
+        /*----- Insert each element from old hash table into new one. -----*/
+        Var<U32x1> idx(0U);
+        WHILE (idx != capacity_old) {
+            Var<U32x1> occupied(occupied_slots(*(control_old + idx.make_signed()).template to<uint8_t*, GROUP_SIZE>()));
+            WHILE (occupied != 0U) {
+                const Var<Ptr<void>> slot_old(
+                    begin_old + ((idx + occupied.ctz()) * this->entry_size_in_bytes_).make_signed()
+                );
+                auto e_old = this->entry(slot_old);
+
+                /*----- Access key from old entry. -----*/
+                std::vector<SQL_t> key;
+                for (auto k : this->key_indices_) {
+                    std::visit(overloaded {
+                        [&](auto &&r) -> void { key.emplace_back(r); },
+                        [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                    }, e_old.get(this->schema_.get()[k].id));
+                }
+
+                /*----- Insert key into new hash table. No rehashing needed since the new hash table is large enough. */
+                auto e_new = this->value_entry(emplace_without_rehashing(std::move(key)));
+
+                /*----- Insert values from old entry into new one. -----*/
+                for (auto v : this->value_indices_) {
+                    auto id = this->schema_.get()[v].id;
+                    std::visit(overloaded {
+                        [&]<sql_type T>(HashTable::reference_t<T> &&r) -> void { r = e_old.template extract<T>(id); },
+                        [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                    }, e_new.extract(id));
+                }
+                M_insist(e_new.empty());
+
+                occupied = occupied bitand (occupied - 1U); // clear lowest set bit
+            }
+
+            /*----- Advance to next group in old hash table. -----*/
+            idx += GROUP_SIZE;
+        }
+
+#ifndef NDEBUG
+        Wasm_insist(*this->num_entries_ == num_entries_old, "number of entries of old and new hash table do not match");
+#endif
+
+        /*----- Free old hash table. -----*/
+        Module::Allocator().deallocate(control_old, capacity_old);
+        Module::Allocator().deallocate(begin_old, capacity_old * this->entry_size_in_bytes_);
+    };
+
+    if constexpr (IsGlobal) {
+        if (not this->rehash_) {
+            /*----- Backup former local variables to be able to use new ones for rehashing function. -----*/
+            auto old_address = std::exchange(this->address_, std::nullopt);
+            auto old_mask = std::exchange(this->mask_, std::nullopt);
+            auto old_num_entries = std::exchange(this->num_entries_, std::nullopt);
+            auto old_high_watermark_absolute = std::exchange(this->high_watermark_absolute_, std::nullopt);
+            auto old_control = std::exchange(control_, std::nullopt);
+
+            /*----- Create function for rehashing. -----*/
+            FUNCTION(rehash, void(void))
+            {
+                /*----- Perform setup for local variables. -----*/
+                this->address_.emplace(this->storage_.address_);
+                this->mask_.emplace(this->storage_.mask_);
+                this->num_entries_.emplace(this->storage_.num_entries_);
+                this->high_watermark_absolute_.emplace(this->storage_.high_watermark_absolute_);
+                control_.emplace(control_storage_.control_);
+
+                emit_rehash();
+
+                /*----- Perform teardown for local variables. -----*/
+                this->storage_.address_ = *this->address_;
+                this->storage_.mask_ = *this->mask_;
+                this->storage_.num_entries_ = *this->num_entries_;
+                this->storage_.high_watermark_absolute_ = *this->high_watermark_absolute_;
+                control_storage_.control_ = *control_;
+                this->address_.reset();
+                this->mask_.reset();
+                this->num_entries_.reset();
+                this->high_watermark_absolute_.reset();
+                control_.reset();
+            }
+            this->rehash_ = std::move(rehash);
+
+            /*----- Restore local variables. -----*/
+            std::exchange(this->address_, std::move(old_address));
+            std::exchange(this->mask_, std::move(old_mask));
+            std::exchange(this->num_entries_, std::move(old_num_entries));
+            std::exchange(this->high_watermark_absolute_, std::move(old_high_watermark_absolute));
+            std::exchange(control_, std::move(old_control));
+        }
+
+        /*----- Store local variables in global backups. -----*/
+        this->storage_.address_ = *this->address_;
+        this->storage_.mask_ = *this->mask_;
+        this->storage_.num_entries_ = *this->num_entries_;
+        this->storage_.high_watermark_absolute_ = *this->high_watermark_absolute_;
+        control_storage_.control_ = *control_;
+
+        /*----- Call rehashing function. ------*/
+        M_insist(bool(this->rehash_));
+        (*this->rehash_)();
+
+        /*----- Restore local variables from global backups. -----*/
+        *this->address_ = this->storage_.address_;
+        *this->mask_ = this->storage_.mask_;
+        *this->num_entries_ = this->storage_.num_entries_;
+        *this->high_watermark_absolute_ = this->storage_.high_watermark_absolute_;
+        *control_ = control_storage_.control_;
+    } else {
+        /*----- Emit rehashing code. ------*/
+        emit_rehash();
+    }
+}
+
+// explicit instantiations to prevent linker errors
+template struct m::wasm::SwissHashTable<false>;
+template struct m::wasm::SwissHashTable<true>;
+
+
 /*----- probing strategies for open addressing hash tables -----------------------------------------------------------*/
 
 Ptr<void> LinearProbing::skip_slots(Ptr<void> bucket, U32x1 skips) const
@@ -2414,3 +3471,71 @@ Ptr<void> QuadraticProbing::advance_to_next_slot(Ptr<void> slot, U32x1 current_s
     Wasm_insist(next < ht_.end() + ht_.size_in_bytes().make_signed());
     return Select(next < ht_.end(), next, next - ht_.size_in_bytes().make_signed());
 }
+
+
+/*----- Bloom filters ------------------------------------------------------------------------------------------------*/
+
+/** Computes the logarithm of the number of 64-bit blocks of a `BloomFilter` for \p num_keys inserted hashes. */
+uint32_t compute_log_num_bloom_filter_blocks(std::size_t num_keys)
+{
+    const uint64_t num_bits = std::max<uint64_t>(num_keys, 1) * BloomFilter::NUM_BITS_PER_KEY;
+    const uint64_t num_blocks =
+        std::clamp<uint64_t>(ceil_to_pow_2((num_bits + 63) / 64), 2, BloomFilter::MAX_NUM_BLOCKS);
+    uint32_t log_num_blocks = 0;
+    while ((uint64_t(1) << log_num_blocks) < num_blocks)
+        ++log_num_blocks;
+    return log_num_blocks;
+}
+
+BloomFilter::BloomFilter(std::size_t num_keys)
+    : blocks_(Module::Allocator().pre_malloc<uint64_t>(1U << compute_log_num_bloom_filter_blocks(num_keys)))
+    , log_num_blocks_(compute_log_num_bloom_filter_blocks(num_keys))
+{
+    M_insist(log_num_blocks_ > 0 and log_num_blocks_ < 32, "invalid number of blocks");
+}
+
+void BloomFilter::clear()
+{
+    Var<Ptr<U64x1>> it(blocks_.clone());
+    const Var<Ptr<U64x1>> end(blocks_.clone() + int32_t(num_blocks()));
+    WHILE (it != end) {
+        *it.val() = uint64_t(0);
+        it += 1;
+    }
+}
+
+std::pair<Ptr<U64x1>, U64x1> BloomFilter::block_and_mask(U64x1 hash) const
+{
+    const Var<U64x1> h(hash);
+
+    /*----- Select the block by the highest bits of the hash since the lowest bits already select hash buckets. -----*/
+    U32x1 block_idx = (h >> uint64_t(64 - log_num_blocks_)).to<uint32_t>();
+    Ptr<U64x1> block = blocks_.clone() + block_idx.make_signed();
+
+    /*----- Select the bits inside the block by consecutive 6-bit groups of the lowest bits of the hash. -----*/
+    std::optional<U64x1> mask;
+    for (uint32_t i = 0; i != NUM_BITS_PER_HASH; ++i) {
+        U64x1 bit = U64x1(uint64_t(1)) << ((h >> uint64_t(6 * i)) bitand uint64_t(63));
+        if (mask)
+            mask.emplace(*mask bitor bit);
+        else
+            mask.emplace(std::move(bit));
+    }
+    M_insist(bool(mask));
+
+    return { block, *mask };
+}
+
+void BloomFilter::insert(U64x1 hash)
+{
+    auto [block, mask] = block_and_mask(hash);
+    const Var<Ptr<U64x1>> block_var(block); // due to multiple uses
+    *block_var.val() = U64x1(*block_var.val()) bitor mask;
+}
+
+Boolx1 BloomFilter::contains(U64x1 hash) const
+{
+    auto [block, mask] = block_and_mask(hash);
+    const Var<U64x1> mask_var(mask); // due to multiple uses
+    return (U64x1(*block) bitand mask_var) == mask_var;
+}
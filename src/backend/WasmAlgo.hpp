@@ -15,6 +15,7 @@ namespace wasm {
 // forward declarations
 template<bool IsGlobal> struct ChainedHashTable;
 template<bool IsGlobal, bool ValueInPlace> struct OpenAddressingHashTable;
+template<bool IsGlobal> struct SwissHashTable;
 struct ProbingStrategy;
 
 /*======================================================================================================================
@@ -27,6 +28,19 @@ struct ProbingStrategy;
 template<bool CmpPredicated, bool IsGlobal>
 void quicksort(Buffer<IsGlobal> &buffer, const std::vector<SortingOperator::order_type> &order);
 
+/** Returns the size in bits of the radix key used by `radix_sort()` to sort by \p order, i.e. the size of all
+ * order expressions plus a NULL bit each, or `std::nullopt` if \p order cannot be sorted by `radix_sort()`, i.e. if
+ * not all order expressions are integral, date, or boolean or if the radix key exceeds 64 bits. */
+std::optional<uint32_t> radix_key_size_in_bits(const std::vector<SortingOperator::order_type> &order);
+
+/** Sorts the buffer \p buffer in-place using the most-significant-digit radix sort algorithm with 8-bit digits, i.e.
+ * American flag sort, on a radix key combining the values of all order expressions.  Small ranges are sorted using
+ * insertion sort.  The ordering is specified by \p order where the first element is the expression to order on and
+ * the second element is `true` iff ordering should be performed ascending.  Requires that `radix_key_size_in_bits()`
+ * returns a value for \p order. */
+template<bool IsGlobal>
+void radix_sort(Buffer<IsGlobal> &buffer, const std::vector<SortingOperator::order_type> &order);
+
 
 /*======================================================================================================================
  * hashing
@@ -36,6 +50,10 @@ void quicksort(Buffer<IsGlobal> &buffer, const std::vector<SortingOperator::orde
 
 /** Mixes the bits of \p bits using the Murmur3 algorithm. */
 U64x1 murmur3_bit_mix(U64x1 bits);
+/** Mixes the bits of each of the \tparam L lanes of \p bits using the Murmur3 algorithm. */
+template<std::size_t L>
+requires (L > 1)
+PrimitiveExpr<uint64_t, L> murmur3_bit_mix(PrimitiveExpr<uint64_t, L> bits);
 
 
 /*----- hash functions -----------------------------------------------------------------------------------------------*/
@@ -47,6 +65,12 @@ U64x1 str_hash(NChar str);
 /** Hashes the elements of \p values where the first element is the type of the value to hash and the second element
  * is the value itself using the Murmur3-64a algorithm. */
 U64x1 murmur3_64a_hash(std::vector<std::pair<const Type*, SQL_t>> values);
+/** Hashes the elements of \p values lane-wise using the Murmur3-64a algorithm, i.e. computes the hashes of \tparam L
+ * keys at once.  All values must be SIMD vectors with \tparam L lanes.  Produces the same hash for each lane as the
+ * scalar version does for the respective key. */
+template<std::size_t L>
+requires (L > 1)
+PrimitiveExpr<uint64_t, L> murmur3_64a_hash(std::vector<std::pair<const Type*, SQL_t>> values);
 
 
 /*----- hash tables --------------------------------------------------------------------------------------------------*/
@@ -504,6 +528,12 @@ struct HashTable
     std::reference_wrapper<const Schema> schema_; ///< schema of hash table
     std::vector<index_t> key_indices_; ///< keys of hash table
     std::vector<index_t> value_indices_; ///< values of hash table
+    ///> size in bytes of the packed key stored at the front of each entry, i.e. 4 or 8; 0 iff the key is not packed
+    size_t packed_key_size_in_bytes_ = 0;
+    ///> byte offsets of the key values within the packed key, in the order of `key_indices_`
+    std::vector<offset_t> packed_key_offsets_in_bytes_;
+    ///> the minimum of the key domain iff the single integral key is mapped directly to buckets, see `set_direct_mapping()`
+    std::optional<int64_t> direct_mapping_min_;
 
     public:
     HashTable() = delete;
@@ -530,6 +560,18 @@ struct HashTable
 
     const Schema & schema() const { return schema_; }
 
+    /** Maps keys directly to buckets instead of hashing them, i.e. `hash()` computes the offset `k - min` of the single
+     * integral key `k` within the key domain starting at \p min and NULL to 0.  If the capacity of the hash table is at
+     * least the size of the key domain, distinct keys of the domain never collide and are found at the first probe.
+     * Keys outside of the domain are still found, by probing.  Must be called before `setup()` and not combined with
+     * hash tables relying on the high bits of the hash, i.e. Swiss tables. */
+    void set_direct_mapping(int64_t min) {
+        M_insist(key_indices_.size() == 1, "direct mapping requires a single key");
+        M_insist(schema_.get()[key_indices_.front()].type->is_integral() or
+                 schema_.get()[key_indices_.front()].type->is_date(), "direct mapping requires an integral key");
+        direct_mapping_min_ = min;
+    }
+
     /** Performs the setup of the hash table.  Must be called before any call to a setup method, i.e. setting the
      * high watermark, or an access method, i.e. clearing, insertion, lookup, or dummy entry creation. */
     virtual void setup() = 0;
@@ -546,6 +588,17 @@ struct HashTable
 
     /** Computes the bucket for key \p key.  Often used as hint for `find()` and `for_each_in_equal_range()`. */
     virtual Ptr<void> compute_bucket(std::vector<SQL_t> key) const = 0;
+    /** Computes the hash of key \p key.  Together with `bucket_of()`, this allows to hash keys well before their
+     * buckets are accessed, e.g. to compute and touch the buckets of an entire batch of keys at once. */
+    U64x1 hash(std::vector<SQL_t> key) const;
+    /** Computes the hashes of the \tparam L keys given lane-wise by the SIMD vectors of \p key at once.  Each lane
+     * is hashed exactly as `hash()` does for the respective scalar key. */
+    template<std::size_t L>
+    requires (L > 1)
+    PrimitiveExpr<uint64_t, L> hash(std::vector<SQL_t> key) const;
+    /** Returns the bucket for the hash \p hash of a key computed by `hash()`.  Often used as hint for `find()` and
+     * `for_each_in_equal_range()`.  Predication is *not* supported. */
+    virtual Ptr<void> bucket_of(U64x1 hash) const = 0;
 
     /** Inserts an entry into the hash table with key \p key regardless whether it already exists, i.e. duplicates
      * are allowed.  Returns a handle to the newly inserted entry which may be used to write the values for this
@@ -599,6 +652,21 @@ struct HashTable
                                                const std::vector<const Type*> &types,
                                                offset_t initial_offset_in_bytes = 0,
                                                offset_t initial_max_alignment_in_bytes = 1);
+
+    /** Decides whether the key is packed, i.e. whether it consists of at least two distinct `NOT NULL` integral values
+     * of at most 64 bits in total.  If so, sets the byte offsets of the key values within a single word of 4 or 8
+     * bytes, which is stored at the front of each entry, and returns `true`.  A packed key is written with a single
+     * store and compared with a single load and comparison, instead of one per key value. */
+    bool set_packed_key_offsets();
+    /** Returns `true` iff the key is packed and the values of key \p key are known to be not NULL, i.e. iff \p key can
+     * be packed by `pack_key()`. */
+    bool is_packable(const std::vector<SQL_t> &key) const;
+    /** Packs the values of key \p key into a single word.  Bytes of the word not covered by any key value are 0. */
+    U64x1 pack_key(std::vector<SQL_t> key) const;
+    /** Loads the packed key from the front of the entry at \p entry. */
+    U64x1 load_packed_key(Ptr<void> entry) const;
+    /** Stores the packed key \p packed_key at the front of the entry at \p entry. */
+    void store_packed_key(Ptr<void> entry, U64x1 packed_key) const;
 };
 
 
@@ -717,6 +785,7 @@ struct ChainedHashTable : HashTable
     void clear() override;
 
     Ptr<void> compute_bucket(std::vector<SQL_t> key) const override;
+    Ptr<void> bucket_of(U64x1 hash) const override;
 
     entry_t emplace(std::vector<SQL_t> key) override;
     std::pair<entry_t, Boolx1> try_emplace(std::vector<SQL_t> key) override;
@@ -844,6 +913,8 @@ struct OpenAddressingHashTableBase : HashTable
     public:
     void clear() override;
 
+    Ptr<void> bucket_of(U64x1 hash) const override;
+
     protected:
     /** Returns the bucket address for the key \p key by hashing it. */
     Ptr<void> hash_to_bucket(std::vector<SQL_t> key) const;
@@ -898,7 +969,7 @@ class open_addressing_hash_table_storage<true>
 template<bool IsGlobal, bool ValueInPlace>
 struct OpenAddressingHashTable : OpenAddressingHashTableBase
 {
-    private:
+    protected:
     ///> variable type dependent on whether the hash table should be globally usable
     template<typename T>
     using var_t = std::conditional_t<IsGlobal, Global<T>, Var<T>>;
@@ -920,13 +991,22 @@ struct OpenAddressingHashTable : OpenAddressingHashTableBase
      * for \p initial_capacity entries.  Emits code to allocate a fresh hash table.  The hash table is globally visible
      * iff \tparam IsGlobal and the values are stores in-place iff \tparam ValueInPlace. */
     OpenAddressingHashTable(const Schema &schema, std::vector<HashTable::index_t> key_indices,
-                            uint32_t initial_capacity);
+                            uint32_t initial_capacity)
+        : OpenAddressingHashTable(schema, std::move(key_indices), initial_capacity,
+                                  /* with_reference_counters= */ true)
+    { }
 
     OpenAddressingHashTable(OpenAddressingHashTable&&) = default;
 
     ~OpenAddressingHashTable();
 
-    private:
+    protected:
+    /** Creates an open addressing hash table as above.  Iff \p with_reference_counters is not set, entries do not
+     * contain reference counters, e.g. since a derived hash table tracks occupied slots differently.  Then, only
+     * in-place values are supported. */
+    OpenAddressingHashTable(const Schema &schema, std::vector<HashTable::index_t> key_indices,
+                            uint32_t initial_capacity, bool with_reference_counters);
+
     Ptr<void> begin() const override { M_insist(bool(address_), "must call `setup()` before"); return *address_; }
     Ptr<void> end() const override { return begin() + (capacity() * entry_size_in_bytes_).make_signed(); }
     U32x1 mask() const override { M_insist(bool(mask_), "must call `setup()` before"); return *mask_; }
@@ -941,7 +1021,7 @@ struct OpenAddressingHashTable : OpenAddressingHashTableBase
      * access method, i.e. clearing, insertion, lookup, or dummy entry creation. */
     void teardown() override;
 
-    private:
+    protected:
     void update_high_watermark() override {
         M_insist(bool(high_watermark_absolute_), "must call `setup()` before");
         auto _capacity = capacity().make_signed().template to<double>();
@@ -978,7 +1058,7 @@ struct OpenAddressingHashTable : OpenAddressingHashTableBase
 
     entry_t dummy_entry() override;
 
-    private:
+    protected:
     /** Inserts an entry into the hash table with key \p key regardless whether it already exists, i.e. duplicates
      * are allowed.  Returns a pointer to the newly inserted slot without allocating any space for possible
      * out-of-place values.  No rehashing of the hash table must be performed, i.e. the hash table must have at least
@@ -1011,6 +1091,132 @@ using LocalOpenAddressingInPlaceHashTable = OpenAddressingHashTable<false, true>
 using GlobalOpenAddressingInPlaceHashTable = OpenAddressingHashTable<true, true>;
 
 
+/*----- Swiss tables -------------------------------------------------------------------------------------------------*/
+
+template<bool IsGlobal>
+class swiss_hash_table_storage;
+
+template<>
+class swiss_hash_table_storage<false> {};
+
+template<>
+class swiss_hash_table_storage<true>
+{
+    friend struct SwissHashTable<true>;
+
+    Global<Ptr<void>> control_; ///< global backup for address of control bytes of hash table
+};
+
+/** Open addressing hash table with in-place values in the style of Abseil's Swiss tables.  Besides its slots, the
+ * hash table keeps one control byte per slot which is either `EMPTY` or a 7-bit tag of the hash of the slot's key.
+ * Slots are organized in groups of `GROUP_SIZE` consecutive slots and groups are probed quadratically.  A probe
+ * compares the control bytes of an entire group with the tag of the key using a single SIMD comparison and compares
+ * only the keys of slots with a matching tag.  The control bytes replace the reference counters of
+ * `OpenAddressingHashTable`. */
+template<bool IsGlobal>
+struct SwissHashTable : OpenAddressingHashTable<IsGlobal, true>
+{
+    using base_type = OpenAddressingHashTable<IsGlobal, true>;
+
+    ///> the logarithm of the number of slots of a group
+    static constexpr uint32_t LOG_GROUP_SIZE = 4;
+    ///> the number of slots of a group, i.e. whose control bytes are compared at once
+    static constexpr uint32_t GROUP_SIZE = 1U << LOG_GROUP_SIZE;
+    ///> the control byte of an unoccupied slot; tags never have the most significant bit set
+    static constexpr uint8_t EMPTY = 0x80;
+
+    private:
+    std::optional<Var<Ptr<void>>> control_; ///< address of the control bytes of hash table
+    ///> if `IsGlobal`, contains backup for address of control bytes
+    swiss_hash_table_storage<IsGlobal> control_storage_;
+    ///> control bytes of a group without occupied slots, written by `setup()`; used for predication; always cloned
+    Ptr<U8<GROUP_SIZE>> empty_group_;
+
+    public:
+    /** Creates a Swiss table with schema \p schema, keys at \p key_indices, and an initial capacity for \p
+     * initial_capacity entries.  The capacity is at least `GROUP_SIZE`.  The hash table is globally visible iff
+     * \tparam IsGlobal. */
+    SwissHashTable(const Schema &schema, std::vector<HashTable::index_t> key_indices, uint32_t initial_capacity);
+
+    SwissHashTable(SwissHashTable&&) = default;
+
+    ~SwissHashTable();
+
+    void setup() override;
+    void teardown() override;
+
+    void clear() override;
+
+    /** Returns the address of the control bytes of the first group to probe for key \p key. */
+    Ptr<void> compute_bucket(std::vector<SQL_t> key) const override;
+    /** Returns the address of the control bytes of the first group to probe for hash \p hash. */
+    Ptr<void> bucket_of(U64x1 hash) const override;
+
+    HashTable::entry_t emplace(std::vector<SQL_t> key) override;
+    std::pair<HashTable::entry_t, Boolx1> try_emplace(std::vector<SQL_t> key) override;
+
+    std::pair<HashTable::entry_t, Boolx1> find(std::vector<SQL_t> key, HashTable::hint_t bucket_hint) override;
+
+    void for_each(HashTable::callback_t Pipeline) const override;
+    void for_each_in_equal_range(std::vector<SQL_t> key, HashTable::callback_t Pipeline, bool predicated,
+                                 HashTable::hint_t bucket_hint) const override;
+
+    private:
+    /** Returns the tag of hash \p hash stored in the control byte of an occupied slot. */
+    static U8x1 tag_of(U64x1 hash) { return (hash >> uint64_t(57)).template to<uint8_t>(); }
+    /** Returns the mask of the group indices, i.e. the number of groups - 1U. */
+    U32x1 group_mask() const { return this->mask() >> LOG_GROUP_SIZE; }
+    /** Returns the address of the control byte of the slot with index \p idx. */
+    Ptr<U8x1> control_byte(U32x1 idx) const {
+        M_insist(bool(control_), "must call `setup()` before");
+        return (*control_ + idx.make_signed()).template to<uint8_t*>();
+    }
+    /** Returns the address of the slot with index \p idx. */
+    Ptr<void> slot(U32x1 idx) const {
+        return this->begin() + (idx * this->entry_size_in_bytes_).make_signed();
+    }
+
+    /** Returns the address of the control bytes of the group with index \p group_idx. */
+    Ptr<void> group(U32x1 group_idx) const {
+        M_insist(bool(control_), "must call `setup()` before");
+        return *control_ + (group_idx << LOG_GROUP_SIZE).make_signed();
+    }
+    /** Returns the mask of the occupied slots of the group whose control bytes are \p control. */
+    static U32x1 occupied_slots(U8<GROUP_SIZE> control) {
+        return control.bitmask() xor ((1U << GROUP_SIZE) - 1U); // only `EMPTY` has the most significant bit set
+    }
+
+    /** Returns the predication predicate of the current environment, if any, and creates the dummy entry for
+     * predication if necessary. */
+    std::optional<Boolx1> extract_predicate() const;
+
+    /** Returns the address of the control bytes of the first group to probe for hash \p hash, or the address of
+     * `empty_group_` if predication is used and the predication predicate is not fulfilled. */
+    Ptr<void> first_group(U64x1 hash, std::optional<Boolx1> pred) const;
+    /** Returns the address of the control bytes of the first group to probe for key \p key, i.e. \p bucket_hint if
+     * given, together with the tag of \p key. */
+    std::pair<Ptr<void>, U8x1> probe_start(std::vector<SQL_t> key, HashTable::hint_t bucket_hint) const;
+
+    /** Probes the groups starting at the one whose control bytes are located at \p first for tag \p tag and calls
+     * \p Match, if given, with the index of each slot with a matching tag.  Stops after the first group with an
+     * unoccupied slot and returns the index of the first unoccupied slot in this group.  Since the hash table always
+     * contains an unoccupied slot, probing terminates. */
+    U32x1 probe(Ptr<void> first, U8x1 tag, std::function<void(U32x1)> Match = {}) const;
+
+    /** Inserts an entry into the hash table with key \p key regardless whether it already exists, i.e. duplicates
+     * are allowed.  Returns a pointer to the newly inserted slot.  No rehashing of the hash table must be performed,
+     * i.e. the hash table must have at least one free entry slot. */
+    Ptr<void> emplace_without_rehashing(std::vector<SQL_t> key);
+
+    /** Performs rehashing, i.e. resizes the hash table to the double of its capacity (by internally creating a new
+     * one) and reinserts all entries. */
+    void rehash();
+};
+
+using LocalSwissHashTable = SwissHashTable<false>;
+using GlobalSwissHashTable = SwissHashTable<true>;
+
+
 /*----- probing strategies for open addressing hash tables -----------------------------------------------------------*/
 
 /** Linear probing strategy, i.e. always the following slot in a bucket is accessed. */
@@ -1033,18 +1239,66 @@ struct QuadraticProbing : OpenAddressingHashTableBase::ProbingStrategy
 };
 
 
+/*----- Bloom filters ------------------------------------------------------------------------------------------------*/
+
+/** Blocked Bloom filter on the hashes of keys, e.g. computed by `HashTable::hash()`.  Each hash sets or tests
+ * `NUM_BITS_PER_HASH` bits of a single 64-bit block, thus both insertion and lookup access memory exactly once.  The
+ * blocks are allocated statically at code generation time. */
+struct BloomFilter
+{
+    ///> the number of bits set per hash inside its block
+    static constexpr uint32_t NUM_BITS_PER_HASH = 4;
+    ///> the targeted number of bits of the filter per inserted hash
+    static constexpr uint32_t NUM_BITS_PER_KEY = 16;
+    ///> the maximal number of 64-bit blocks, i.e. at most 32 MiB are allocated
+    static constexpr uint32_t MAX_NUM_BLOCKS = 1U << 22;
+
+    private:
+    Ptr<U64x1> blocks_; ///< the address of the first block; always cloned
+    uint32_t log_num_blocks_; ///< the logarithm of the number of blocks
+
+    public:
+    /** Creates a Bloom filter for about \p num_keys inserted hashes.  The number of blocks is a power of 2 which is at
+     * least 2 and at most `MAX_NUM_BLOCKS`. */
+    BloomFilter(std::size_t num_keys);
+
+    BloomFilter(const BloomFilter&) = delete;
+    BloomFilter(BloomFilter&&) = delete;
+
+    ~BloomFilter() { blocks_.discard(); }
+
+    /** Returns the number of blocks of this filter. */
+    uint32_t num_blocks() const { return 1U << log_num_blocks_; }
+
+    /** Clears the filter, i.e. resets all its bits. */
+    void clear();
+    /** Inserts the hash \p hash into the filter. */
+    void insert(U64x1 hash);
+    /** Returns `true` if the hash \p hash *may* have been inserted into the filter and `false` if it was definitely
+     * *not* inserted. */
+    Boolx1 contains(U64x1 hash) const;
+
+    private:
+    /** Returns the block of the hash \p hash together with the mask of the bits to set or test in it. */
+    std::pair<Ptr<U64x1>, U64x1> block_and_mask(U64x1 hash) const;
+};
+
+
 /*======================================================================================================================
  * explicit instantiation declarations
  *====================================================================================================================*/
 
 extern template void quicksort<false>(GlobalBuffer&, const std::vector<SortingOperator::order_type>&);
 extern template void quicksort<true>(GlobalBuffer&, const std::vector<SortingOperator::order_type>&);
+extern template void radix_sort(GlobalBuffer&, const std::vector<SortingOperator::order_type>&);
 extern template struct m::wasm::ChainedHashTable<false>;
 extern template struct m::wasm::ChainedHashTable<true>;
 extern template struct m::wasm::OpenAddressingHashTable<false, false>;
 extern template struct m::wasm::OpenAddressingHashTable<false, true>;
 extern template struct m::wasm::OpenAddressingHashTable<true, false>;
 extern template struct m::wasm::OpenAddressingHashTable<true, true>;
+extern template struct m::wasm::SwissHashTable<false>;
+extern template struct m::wasm::SwissHashTable<true>;
 
 }
 
@@ -19,8 +19,16 @@ static void add_wasm_dsl_args()
 {
     Catalog &C = Catalog::Get();
 
-#if !defined(NDEBUG) && defined(M_ENABLE_SANITY_FIELDS)
     /*----- Command-line arguments -----*/
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--wasm-memory-budget",
+        /* description= */ "set the budget in bytes for the memory of a query, exceeding it aborts the query (0 means "
+                           "the memory is only bounded by the Wasm address space)",
+        /* callback=    */ [](std::size_t budget){ dsl_options::memory_budget = budget; }
+    );
+#if !defined(NDEBUG) && defined(M_ENABLE_SANITY_FIELDS)
     C.arg_parser().add<bool>(
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
@@ -118,6 +126,8 @@ struct MockInterface final : ::wasm::ModuleRunner::ExternalInterface
     private:
     ///> the underlying virtual address space used
     const memory::AddressSpace &memory_;
+    ///> the first address of the memory of this allocator, used to compute the memory consumption within the budget
+    uint32_t start_addr_;
 
     public:
     MockInterface(const memory::AddressSpace &memory) : memory_(memory) { }
@@ -208,12 +218,24 @@ struct MockInterface final : ::wasm::ModuleRunner::ExternalInterface
 
 /** A simple linear allocator which keeps a global pointer to the next free memory address and advances it for
  * allocation.  Deallocation can only reclaim memory if all chronologically later allocations have been deallocated
- * before.  If possible, deallocate memory in the inverse order of allocation. */
+ * before.  If possible, deallocate memory in the inverse order of allocation.
+ *
+ * Small objects allocated by `allocate_object()` are rounded up to size classes, which are multiples of
+ * `SIZE_CLASS_GRANULARITY`.  Deallocated objects are kept in a free list per size class, linked through their first
+ * four bytes, and recycled by later allocations of the same size class.  Hence, e.g. the entries of collision lists
+ * are reclaimed regardless of the order of deallocation. */
 struct LinearAllocator : Allocator
 {
+    ///> the granularity of size classes, which is also the alignment of small objects
+    static constexpr uint32_t SIZE_CLASS_GRANULARITY = 8;
+    ///> the size of the largest size class; larger objects are allocated linearly
+    static constexpr uint32_t MAX_SIZE_CLASS = 256;
+
     private:
     ///> the underlying virtual address space used
     const memory::AddressSpace &memory_;
+    ///> the first address of the memory of this allocator, used to compute the memory consumption within the budget
+    uint32_t start_addr_;
     ///> flag whether pre-allocations were already performed, i.e. `perform_pre_allocations()` was already called
     bool pre_allocations_performed_ = false;
     ///> compile-time size of the currently used memory, used as pointer to next free pre-allocation
@@ -222,14 +244,48 @@ struct LinearAllocator : Allocator
     Global<U32x1> alloc_addr_;
     ///> compile-time total memory consumption
     uint32_t pre_alloc_total_mem_ = 0;
+    ///> the address and size of each pre-allocation by `raw_allocate()`
+    std::vector<std::pair<uint32_t, uint32_t>> raw_allocations_;
     ///> runtime total memory consumption
     Global<U32x1> alloc_total_mem_;
     ///> runtime peak memory consumption
     Global<U32x1> alloc_peak_mem_;
+    ///> runtime memory that was deallocated but not reclaimed, i.e. in free lists or below later allocations
+    Global<U32x1> alloc_fragmented_mem_;
+    ///> the heads of the free lists of all size classes, created on their first use; 0 denotes an empty list
+    std::array<std::unique_ptr<Global<U32x1>>, MAX_SIZE_CLASS / SIZE_CLASS_GRANULARITY> free_lists_;
+    /** The state of the allocator when a scope of temporary allocations was begun. */
+    struct temporaries_t
+    {
+        const void *tag;
+        std::unique_ptr<Global<U32x1>> alloc_addr;
+        std::unique_ptr<Global<U32x1>> alloc_fragmented_mem;
+        std::unique_ptr<Global<U32x1>> tagged_alloc_mem;
+    };
+    ///> the scopes of temporary allocations by nesting depth, reused by subsequent scopes of the same depth
+    std::vector<temporaries_t> temporaries_;
+    ///> the number of currently open scopes of temporary allocations
+    std::size_t num_open_temporaries_ = 0;
+    ///> the requester of the current requests, or `nullptr` if the requests are not accounted per requester
+    const void *tag_ = nullptr;
+    /** The memory consumption of a single requester. */
+    struct tagged_consumption_t
+    {
+        const void *tag;
+        ///> compile-time total memory consumption
+        uint32_t pre_alloc_total_mem = 0;
+        ///> runtime current memory consumption, i.e. allocated but not deallocated
+        std::unique_ptr<Global<U32x1>> alloc_mem;
+        ///> runtime peak memory consumption
+        std::unique_ptr<Global<U32x1>> alloc_peak_mem;
+    };
+    ///> the memory consumption of all requesters, in the order of their first request
+    std::vector<tagged_consumption_t> tagged_;
 
     public:
     LinearAllocator(const memory::AddressSpace &memory, uint32_t start_addr)
         : memory_(memory)
+        , start_addr_(start_addr)
         , pre_alloc_addr_(start_addr)
     {
         M_insist(start_addr != 0, "memory address 0 is reserved as `nullptr`");
@@ -237,6 +293,7 @@ struct LinearAllocator : Allocator
         alloc_addr_.val().discard();  // artificial use of `alloc_addr_` to silence diagnostics if allocator is not used
         alloc_total_mem_.val().discard();  // artificial use of `alloc_total_mem_` to silence diagnostics if allocator is not used
         alloc_peak_mem_.val().discard();  // artificial use of `alloc_peak_mem_` to silence diagnostics if allocator is not used
+        alloc_fragmented_mem_.val().discard();  // artificial use of `alloc_fragmented_mem_` to silence diagnostics
 #endif
     }
 
@@ -252,9 +309,13 @@ struct LinearAllocator : Allocator
         if (alignment != 1U)
             align_pre_memory(alignment);
         void *ptr = static_cast<uint8_t*>(memory_.addr()) + pre_alloc_addr_;
+        raw_allocations_.emplace_back(pre_alloc_addr_, bytes);
         pre_alloc_addr_ += bytes; // advance memory size by bytes
         pre_alloc_total_mem_ += bytes;
+        if (tag_)
+            consumption(tag_).pre_alloc_total_mem += bytes;
         M_insist(memory_.size() >= pre_alloc_addr_, "allocation must fit in memory");
+        check_pre_allocation_budget();
         return ptr;
     }
     Ptr<void> pre_allocate(uint32_t bytes, uint32_t alignment) override {
@@ -267,7 +328,10 @@ struct LinearAllocator : Allocator
         Ptr<void> ptr(U32x1(pre_alloc_addr_).template to<void*>());
         pre_alloc_addr_ += bytes; // advance memory size by bytes
         pre_alloc_total_mem_ += bytes;
+        if (tag_)
+            consumption(tag_).pre_alloc_total_mem += bytes;
         M_insist(memory_.size() >= pre_alloc_addr_, "allocation must fit in memory");
+        check_pre_allocation_budget();
         return ptr;
     }
     Var<Ptr<void>> allocate(U32x1 bytes, uint32_t alignment) override {
@@ -277,19 +341,98 @@ struct LinearAllocator : Allocator
             align_memory(alignment);
         Var<Ptr<void>> ptr(alloc_addr_.template to<void*>());
         alloc_addr_ += bytes.clone(); // advance memory size by bytes
-        alloc_total_mem_ += bytes;
+        account_allocation(bytes);
         alloc_peak_mem_ = Select(alloc_peak_mem_ > alloc_addr_, alloc_peak_mem_, alloc_addr_);
         Wasm_insist(memory_.size() >= alloc_addr_, "allocation must fit in memory");
+        if (dsl_options::memory_budget) {
+            IF (alloc_addr_ - start_addr_ > uint32_t(std::min<std::size_t>(dsl_options::memory_budget, UINT32_MAX))) {
+                Throw(exception::memory_budget_exceeded, "memory budget of query exceeded");
+            };
+        }
         return ptr;
     }
 
     void deallocate(Ptr<void> ptr, U32x1 bytes) override {
         Wasm_insist(ptr.clone().template to<uint32_t>() < alloc_addr_, "must not try to free unallocated memory");
+        if (tag_)
+            *consumption(tag_).alloc_mem -= bytes.clone();
         IF (ptr.template to<uint32_t>() + bytes.clone() == alloc_addr_) { // last allocation can be freed
-            alloc_addr_ -= bytes; // free by decreasing memory size
+            alloc_addr_ -= bytes.clone(); // free by decreasing memory size
+        } ELSE {
+            alloc_fragmented_mem_ += bytes;
         };
     }
 
+    Var<Ptr<void>> allocate_object(uint32_t bytes, uint32_t alignment) override {
+        if (not has_size_class(bytes, alignment))
+            return allocate(U32x1(bytes), alignment);
+        const uint32_t size = size_class(bytes);
+        auto &head = free_list(size);
+        Var<Ptr<void>> ptr(head.template to<void*>());
+        IF (ptr.is_nullptr()) { // free list empty
+            ptr = allocate(U32x1(size), SIZE_CLASS_GRANULARITY);
+        } ELSE { // recycle first object of free list
+            head = *ptr.template to<uint32_t*>();
+            alloc_fragmented_mem_ -= size;
+            account_allocation(U32x1(size));
+        };
+        return ptr;
+    }
+
+    void deallocate_object(Ptr<void> _ptr, uint32_t bytes, uint32_t alignment) override {
+        if (not has_size_class(bytes, alignment))
+            return deallocate(_ptr, U32x1(bytes));
+        const uint32_t size = size_class(bytes);
+        const Var<U32x1> ptr(_ptr.template to<uint32_t>());
+        Wasm_insist(ptr < alloc_addr_, "must not try to free unallocated memory");
+        if (tag_)
+            *consumption(tag_).alloc_mem -= size;
+        IF (ptr + size == alloc_addr_) { // last allocation can be freed
+            alloc_addr_ -= size;
+        } ELSE { // prepend to free list
+            auto &head = free_list(size);
+            *ptr.template to<uint32_t*>() = head;
+            head = ptr;
+            alloc_fragmented_mem_ += size;
+        };
+    }
+
+    void begin_temporaries() override {
+        if (num_open_temporaries_ == temporaries_.size()) {
+            temporaries_.emplace_back(temporaries_t{
+                .tag = nullptr,
+                .alloc_addr = std::make_unique<Global<U32x1>>(),
+                .alloc_fragmented_mem = std::make_unique<Global<U32x1>>(),
+                .tagged_alloc_mem = std::make_unique<Global<U32x1>>(),
+            });
+#ifdef M_ENABLE_SANITY_FIELDS
+            temporaries_.back().tagged_alloc_mem->val().discard();  // artificial use to silence diagnostics
+#endif
+        }
+        auto &T = temporaries_[num_open_temporaries_++];
+        T.tag = tag_;
+        *T.alloc_addr = alloc_addr_.val();
+        *T.alloc_fragmented_mem = alloc_fragmented_mem_.val();
+        if (tag_)
+            *T.tagged_alloc_mem = consumption(tag_).alloc_mem->val();
+    }
+
+    void end_temporaries() override {
+        M_insist(num_open_temporaries_ != 0, "no scope of temporary allocations to end");
+        auto &T = temporaries_[--num_open_temporaries_];
+        M_insist(T.tag == tag_, "scope of temporary allocations must be ended by the requester that began it");
+        alloc_addr_ = T.alloc_addr->val();
+        alloc_fragmented_mem_ = T.alloc_fragmented_mem->val();
+        if (tag_)
+            *consumption(tag_).alloc_mem = T.tagged_alloc_mem->val();
+        /* The free lists may contain objects allocated within the scope.  Objects freed before the scope remain
+         * unreclaimed and are already accounted as fragmented memory. */
+        for (auto &head : free_lists_) {
+            if (head)
+                *head = 0U;
+        }
+    }
+
     void perform_pre_allocations() override {
         M_insist(not pre_allocations_performed_,
                  "must not call `perform_pre_allocations()` multiple times");
@@ -297,11 +440,86 @@ struct LinearAllocator : Allocator
         pre_allocations_performed_ = true;
     }
 
+    const std::vector<std::pair<uint32_t, uint32_t>> & raw_allocations() const override { return raw_allocations_; }
+
     uint32_t pre_allocated_memory_consumption() const override { return pre_alloc_total_mem_; }
     U32x1 allocated_memory_consumption() const override { return alloc_total_mem_; }
     U32x1 allocated_memory_peak() const override { return alloc_peak_mem_; }
+    U32x1 allocated_memory_fragmentation() const override { return alloc_fragmented_mem_; }
+
+    const void * tag(const void *tag) override { return std::exchange(tag_, tag); }
+    std::vector<const void*> tags() const override {
+        std::vector<const void*> tags;
+        for (auto &C : tagged_)
+            tags.push_back(C.tag);
+        return tags;
+    }
+    uint32_t pre_allocated_memory_consumption(const void *tag) const override {
+        auto C = find(tag);
+        return C ? C->pre_alloc_total_mem : 0;
+    }
+    U32x1 allocated_memory_peak(const void *tag) const override {
+        auto C = find(tag);
+        return C ? C->alloc_peak_mem->val() : U32x1(0U);
+    }
 
     private:
+    /** Returns `true` iff an object of \p bytes bytes with alignment requirement \p alignment is allocated in a size
+     * class. */
+    static bool has_size_class(uint32_t bytes, uint32_t alignment) {
+        M_insist(alignment);
+        M_insist(is_pow_2(alignment), "alignment must be a power of 2");
+        return bytes != 0 and bytes <= MAX_SIZE_CLASS and alignment <= SIZE_CLASS_GRANULARITY;
+    }
+    /** Returns the size of the size class of objects of \p bytes bytes. */
+    static uint32_t size_class(uint32_t bytes) {
+        return (bytes + (SIZE_CLASS_GRANULARITY - 1U)) bitand ~(SIZE_CLASS_GRANULARITY - 1U);
+    }
+    /** Returns the head of the free list of size class \p size, creating it on its first use. */
+    Global<U32x1> & free_list(uint32_t size) {
+        auto &head = free_lists_[size / SIZE_CLASS_GRANULARITY - 1U];
+        if (not head) {
+            head = std::make_unique<Global<U32x1>>();
+#ifdef M_ENABLE_SANITY_FIELDS
+            head->val().discard();  // artificial use of `head` to silence diagnostics if objects are never freed
+#endif
+        }
+        return *head;
+    }
+    /** Accounts the allocation of \p bytes bytes to the total memory consumption and the requester. */
+    void account_allocation(U32x1 bytes) {
+        if (tag_) {
+            auto &C = consumption(tag_);
+            *C.alloc_mem += bytes.clone();
+            *C.alloc_peak_mem = Select(*C.alloc_peak_mem > *C.alloc_mem, *C.alloc_peak_mem, *C.alloc_mem);
+        }
+        alloc_total_mem_ += bytes;
+    }
+    /** Returns the memory consumption of the requester \p tag, or `nullptr` if \p tag did not request memory. */
+    const tagged_consumption_t * find(const void *tag) const {
+        auto it = std::find_if(tagged_.begin(), tagged_.end(), [tag](auto &C) { return C.tag == tag; });
+        return it != tagged_.end() ? &*it : nullptr;
+    }
+    /** Returns the memory consumption of the requester \p tag, creating it on its first request. */
+    tagged_consumption_t & consumption(const void *tag) {
+        if (auto C = find(tag))
+            return const_cast<tagged_consumption_t&>(*C);
+        auto &C = tagged_.emplace_back(tagged_consumption_t{
+            .tag = tag,
+            .alloc_mem = std::make_unique<Global<U32x1>>(),
+            .alloc_peak_mem = std::make_unique<Global<U32x1>>(),
+        });
+#ifdef M_ENABLE_SANITY_FIELDS
+        C.alloc_mem->val().discard();  // artificial use of `alloc_mem` to silence diagnostics if requester only pre-allocates
+        C.alloc_peak_mem->val().discard();  // artificial use of `alloc_peak_mem` to silence diagnostics if not reported
+#endif
+        return C;
+    }
+    /** Aborts code generation if the pre-allocations exceed the memory budget. */
+    void check_pre_allocation_budget() const {
+        if (dsl_options::memory_budget and pre_alloc_addr_ - start_addr_ > dsl_options::memory_budget)
+            throw exception(exception::memory_budget_exceeded, "memory budget of query exceeded by pre-allocations");
+    }
     /** Aligns the memory for pre-allocations with alignment requirement `align`. */
     void align_pre_memory(uint32_t alignment) {
         M_insist(is_pow_2(alignment));
@@ -351,6 +569,45 @@ Module::Module()
     module_.features.setSIMD(true);
 }
 
+std::unique_ptr<Module> Module::Release()
+{
+    M_insist(bool(the_module_), "must have a module");
+    the_module_->reset();
+    return std::move(the_module_);
+}
+
+void Module::reset()
+{
+    M_insist(local_bitmaps_stack_.empty() and local_bitvectors_stack_.empty(), "must not be inside a function");
+
+    /*----- Discard the per-query state in the reverse order of declaration, like the destructor does. -----*/
+    garbage_collected_data_.clear();
+    interface_.reset();
+    messages_.clear();
+    branch_target_stack_.clear();
+    allocator_.reset();
+    vm_.reset();
+    active_function_ = nullptr;
+    active_block_ = nullptr;
+
+    /*----- Remove everything generated for the query from the Binaryen module and free its expressions. -----*/
+    module_.removeFunctions([](::wasm::Function *fn) {
+        return not fn->imported() or (fn->base != "insist" and fn->base != "throw");
+    });
+    module_.removeGlobals([](::wasm::Global*) { return true; });
+    module_.removeExports([](::wasm::Export *e) { return e->name != "memory"; });
+    module_.start = ::wasm::Name();
+    for (auto *arena = &module_.allocator; arena; arena = arena->next.load())
+        arena->clear(); // the remaining imports, memory, and export are not allocated in the arena
+    module_.features = ::wasm::FeatureSet::MVP;
+    module_.features.setBulkMemory(true);
+    module_.features.setSIMD(true);
+
+    /*----- Start the next query with a new ID, s.t. it gets a fresh `WasmContext`, and fresh names. -----*/
+    id_ = NEXT_MODULE_ID_.fetch_add(1U, std::memory_order_relaxed);
+    next_block_id_ = next_function_id_ = next_global_id_ = next_if_id_ = next_loop_id_ = 0;
+}
+
 ::wasm::ModuleRunner::ExternalInterface * Module::get_mock_interface()
 {
     if (not interface_) [[unlikely]]
@@ -366,6 +623,14 @@ bool Module::Validate(bool verbose, bool global)
     return ::wasm::WasmValidator{}.validate(Get().module_, flags);
 }
 
+void Module::Deduplicate()
+{
+    ::wasm::PassRunner runner(&Get().module_, ::wasm::PassOptions());
+    runner.add("duplicate-function-elimination");
+    runner.add("merge-similar-functions");
+    runner.run();
+}
+
 void Module::Optimize(int optimization_level)
 {
     ::wasm::PassOptions options;
@@ -376,11 +641,24 @@ void Module::Optimize(int optimization_level)
     runner.run();
 }
 
-std::pair<uint8_t*, std::size_t> Module::binary()
+void Module::Optimize(int optimization_level, const std::function<bool(const ::wasm::Function&)> &is_hot)
+{
+    ::wasm::PassOptions options;
+    options.optimizeLevel = optimization_level;
+    options.shrinkLevel = 0; // shrinking not required
+    ::wasm::PassRunner runner(&Get().module_, options);
+    runner.addDefaultFunctionOptimizationPasses();
+    for (auto &fn : Get().module_.functions) {
+        if (not fn->imported() and is_hot(*fn))
+            runner.runOnFunction(fn.get());
+    }
+}
+
+std::pair<uint8_t*, std::size_t> Module::binary(bool names_section)
 {
     ::wasm::BufferWithRandomAccess buffer;
     ::wasm::WasmBinaryWriter writer(&module_, buffer);
-    writer.setNamesSection(false);
+    writer.setNamesSection(names_section);
     writer.write();
     void *binary = malloc(buffer.size());
     std::copy_n(buffer.begin(), buffer.size(), static_cast<char*>(binary));
@@ -30,15 +30,23 @@
 
 namespace m {
 
-#if !defined(NDEBUG) && defined(M_ENABLE_SANITY_FIELDS)
 namespace dsl_options {
 
+/** The budget in bytes for the memory of a query, i.e. the static data and the memory allocated at runtime, e.g. for
+ * hash tables and sort buffers.  Exceeding the budget aborts the query.  0 means that the memory of a query is only
+ * bounded by its Wasm address space. */
+inline std::size_t memory_budget = 0;
+
+#if !defined(NDEBUG) && defined(M_ENABLE_SANITY_FIELDS)
 /** Whether there must not be any ternary logic, i.e. NULL value computation.  Note that NULL values have different
  * origins, e.g. NULL values stored in a table or default aggregate values in an aggregation operator. */
 static bool insist_no_ternary_logic = false;
+#endif
 
 }
 
+#if !defined(NDEBUG) && defined(M_ENABLE_SANITY_FIELDS)
+
 #define M_insist_no_ternary_logic() M_insist(not m::dsl_options::insist_no_ternary_logic, "ternary logic must not occur")
 
 #else
@@ -548,7 +556,8 @@ inline std::array<::wasm::Literal, (L * sizeof(T)) / 16> make_literal(Us... valu
 #define M_EXCEPTION_LIST(X) \
     X(invalid_escape_sequence) \
     X(unreachable) \
-    X(failed_unittest_check)
+    X(failed_unittest_check) \
+    X(memory_budget_exceeded)
 
 struct exception : backend_exception
 {
@@ -707,10 +716,22 @@ struct Module final
         M_insist(not the_module_, "must not have a module yet");
         the_module_ = std::unique_ptr<Module>(new Module());
     }
+    /** Installs \p module, a module returned by `Release()`, as the module of this thread, or a new module if \p module
+     * is `nullptr`. */
+    static void Init(std::unique_ptr<Module> module) {
+        if (not module) return Init();
+        M_insist(not the_module_, "must not have a module yet");
+        the_module_ = std::move(module);
+    }
     static void Dispose() {
         M_insist(bool(the_module_), "must have a module");
         the_module_ = nullptr;
     }
+    /** Removes the module of this thread like `Dispose()` but returns it, reset to its initial state, for reuse by the
+     * next query via `Init(std::unique_ptr<Module>)`.  The Binaryen module keeps its imported functions, its memory,
+     * and the export of its memory, while the functions, globals, and exports generated for the query, the expressions
+     * in its arena, and all other per-query state, e.g. the allocator and the address space, are discarded. */
+    static std::unique_ptr<Module> Release();
     static Module & Get() {
         M_insist(bool(the_module_), "must have a module");
         return *the_module_;
@@ -753,8 +774,17 @@ struct Module final
     /** Validates that the module is well-formed. */
     static bool Validate(bool verbose = true, bool global = true);
 
+    /** Merges the functions of the module that are identical or differ only in constants, e.g. the addresses of the
+     * tables or buffers they access.  Functions of the latter kind are replaced by calls to a single function taking
+     * the differing constants as parameters.  Hence, the code size grows with the number of distinct operators rather
+     * than with the size of the plan. */
+    static void Deduplicate();
+
     /** Optimizes the module with the optimization level set to `level`. */
     static void Optimize(int optimization_level);
+    /** Optimizes only the functions of the module for which \p is_hot returns `true` with the optimization level set
+     * to `level`.  Only function-local passes are run, i.e. no inlining across functions. */
+    static void Optimize(int optimization_level, const std::function<bool(const ::wasm::Function&)> &is_hot);
 
     /** Sets the new active `::wasm::Block` and returns the previously active `::wasm::Block`. */
     ::wasm::Block * set_active_block(::wasm::Block *block) { return std::exchange(active_block_, block); }
@@ -931,10 +961,13 @@ struct Module final
     void set_feature(::wasm::FeatureSet feature, bool value) { module_.features.set(feature, value); }
 
     /** Returns the binary representation of `module_` in a freshly allocated memory.  The caller must dispose of this
-     * memory. */
-    std::pair<uint8_t*, std::size_t> binary();
+     * memory.  If \p names_section, the binary contains the names of the functions, e.g. for profilers. */
+    std::pair<uint8_t*, std::size_t> binary(bool names_section = false);
 
     private:
+    /** Resets this module to the state of a freshly created module with a new ID, see `Release()`. */
+    void reset();
+
     void create_local_bitmap_stack();
     void create_local_bitvector_stack();
     void dispose_local_bitmap_stack();
@@ -2274,6 +2307,15 @@ struct PrimitiveExpr<T, L>
         return reinterpret<int64_t>().make_unsigned();
     }
     PrimitiveExpr<uint64_t, L> hash() requires std::same_as<T, bool> and (L == 1) { return to<uint64_t>(); }
+    PrimitiveExpr<uint64_t, L> hash() requires unsigned_integral<T> and (L > 1) { return to<uint64_t, L>(); }
+    PrimitiveExpr<uint64_t, L> hash() requires signed_integral<T> and (L > 1) {
+        return make_unsigned().template to<uint64_t, L>();
+    }
+    PrimitiveExpr<uint64_t, L> hash() requires std::floating_point<T> and (L > 1) {
+        using U = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        return PrimitiveExpr<U, L>(move()).template to<uint64_t, L>(); // reinterpreting a vector is a no-op
+    }
+    PrimitiveExpr<uint64_t, L> hash() requires std::same_as<T, bool> and (L > 1) { return to<uint64_t, L>(); }
 
 #undef UNARY_VOP
 #undef UNFVOP_
@@ -3720,6 +3762,18 @@ struct PrimitiveExpr<T, L>
         return *res;
     }
 
+    /*----- Hashing operations ---------------------------------------------------------------------------------------*/
+
+    PrimitiveExpr<uint64_t, L> hash() requires unsigned_integral<T> { return to<uint64_t, L>(); }
+    PrimitiveExpr<uint64_t, L> hash() requires signed_integral<T> {
+        return make_unsigned().template to<uint64_t, L>();
+    }
+    PrimitiveExpr<uint64_t, L> hash() requires std::floating_point<T> {
+        using U = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        return PrimitiveExpr<U, L>(move<U, L>()).template to<uint64_t, L>(); // reinterpreting vectors is a no-op
+    }
+    PrimitiveExpr<uint64_t, L> hash() requires std::same_as<T, bool> { return to<uint64_t, L>(); }
+
 
     /*------------------------------------------------------------------------------------------------------------------
      * Binary operations
@@ -4786,12 +4840,22 @@ UNARY_LIST(UNARY)
 
     /*----- Hashing operations with special three-valued logic -------------------------------------------------------*/
 
-    PrimitiveExpr<uint64_t, L> hash() requires requires { value_.hash(); } {
+    PrimitiveExpr<uint64_t, L> hash() requires requires { value_.hash(); } and (L == 1) {
         if (can_be_null())
             return Select(is_null_, PrimitiveExpr<uint64_t, 1>(1UL << 63), value_.hash());
         else
             return value_.hash();
     }
+    PrimitiveExpr<uint64_t, L> hash() requires requires { value_.hash(); } and (L > 1) {
+        if (can_be_null()) {
+            /* Mask lane-wise instead of using `Select` since the NULL bits are narrower than the 64-bit hash lanes. */
+            auto is_null = is_null_.template to<uint64_t, L>(); // 1 for NULL lanes, 0 otherwise
+            auto mask = is_null.clone() - PrimitiveExpr<uint64_t, L>(1UL); // all bits set for non-NULL lanes
+            return (mask bitand value_.hash()) bitor (is_null << PrimitiveExpr<uint32_t, 1>(63U));
+        } else {
+            return value_.hash();
+        }
+    }
 
 
     /*------------------------------------------------------------------------------------------------------------------
@@ -6494,16 +6558,50 @@ struct Allocator
     /** Deallocates the `bytes` consecutive bytes of allocated memory at address `ptr`. */
     virtual void deallocate(Ptr<void> ptr, U32x1 bytes) = 0;
 
+    /** Allocates memory for a single object of \p bytes bytes with alignment requirement \p align, e.g. an entry of a
+     * collision list, and returns a pointer to the beginning of this memory.  In contrast to `allocate()`, memory of
+     * small objects is recycled independently of the order of deallocation, hence the memory must not be grown in
+     * place.  Must only be deallocated by `deallocate_object()`. */
+    virtual Var<Ptr<void>> allocate_object(uint32_t bytes, uint32_t align = 1) = 0;
+    /** Deallocates the object at address \p ptr which was allocated by `allocate_object()` with the same \p bytes and
+     * \p align. */
+    virtual void deallocate_object(Ptr<void> ptr, uint32_t bytes, uint32_t align = 1) = 0;
+
+    /** Begins a scope of temporary allocations, e.g. of a single pipeline.  All memory allocated within the scope is
+     * freed at once by the matching `end_temporaries()`, which must be emitted in the same function.  Memory allocated
+     * before the scope must not be deallocated within the scope.  Scopes may be nested. */
+    virtual void begin_temporaries() = 0;
+    /** Ends the innermost scope of temporary allocations and frees all memory allocated within it. */
+    virtual void end_temporaries() = 0;
+
     /** Performs the actual pre-allocations.  Must be called exactly **once** **after** the last pre-allocation was
      * requested. */
     virtual void perform_pre_allocations() = 0;
 
+    /** Returns the address and the size in bytes of each pre-allocation requested by `raw_allocate()`, i.e. of the
+     * memory whose contents are written at compile time rather than by the generated code. */
+    virtual const std::vector<std::pair<uint32_t, uint32_t>> & raw_allocations() const = 0;
+
     /** Returns the pre-allocated memory overall consumption. */
     virtual uint32_t pre_allocated_memory_consumption() const = 0;
     /** Returns the allocated memory overall consumption. */
     virtual U32x1 allocated_memory_consumption() const = 0;
     /** Returns the allocated memory peak consumption. */
     virtual U32x1 allocated_memory_peak() const = 0;
+    /** Returns the allocated memory fragmentation, i.e. the memory that was deallocated but is not reclaimed, either
+     * because it is recycled only for objects of its size or because later allocations are still in use. */
+    virtual U32x1 allocated_memory_fragmentation() const = 0;
+
+    /** Sets the requester of subsequent (pre-)allocations and deallocations to \p tag, e.g. the operator whose code is
+     * being generated, and returns the previous requester.  The memory consumption is additionally accounted per
+     * requester for all requests made while a tag is set.  `nullptr` stops the accounting per requester. */
+    virtual const void * tag(const void *tag) = 0;
+    /** Returns all requesters that requested memory, in the order of their first request. */
+    virtual std::vector<const void*> tags() const = 0;
+    /** Returns the pre-allocated memory consumption of the requester \p tag. */
+    virtual uint32_t pre_allocated_memory_consumption(const void *tag) const = 0;
+    /** Returns the allocated memory peak consumption of the requester \p tag. */
+    virtual U32x1 allocated_memory_peak(const void *tag) const = 0;
 
     Var<Ptr<void>> allocate(uint32_t bytes, uint32_t align = 1) { return allocate(U32x1(bytes), align); }
     void deallocate(Ptr<void> ptr, uint32_t bytes) { return deallocate(ptr, U32x1(bytes)); }
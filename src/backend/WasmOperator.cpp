@@ -3,7 +3,17 @@
 #include "backend/Interpreter.hpp"
 #include "backend/WasmAlgo.hpp"
 #include "backend/WasmMacro.hpp"
+#include "catalog/ColumnStatistics.hpp"
+#include "catalog/NullFreeColumns.hpp"
+#include "catalog/OperatorCalibration.hpp"
+#include "catalog/Partitionings.hpp"
+#include "catalog/SortOrders.hpp"
+#include "storage/PaxStore.hpp"
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <mutable/catalog/Catalog.hpp>
+#include <mutable/Options.hpp>
 #include <mutable/parse/AST.hpp>
 #include <mutable/util/fn.hpp>
 #include <numeric>
@@ -31,7 +41,8 @@ static void add_wasm_operator_args()
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
         /* long=        */ "--scan-implementations",
-        /* description= */ "a comma seperated list of physical scan implementations to consider (`Scan` or `IndexScan`)",
+        /* description= */ "a comma seperated list of physical scan implementations to consider (`Scan`, `IndexScan`, "
+                           "`LateMaterializingScan`, `ZoneMapScan`, or `SelectionVectorScan`)",
         /* callback=    */ [](std::vector<std::string_view> impls){
             options::scan_implementations = option_configs::ScanImplementation(0UL);
             for (const auto &elem : impls) {
@@ -39,6 +50,12 @@ static void add_wasm_operator_args()
                     options::scan_implementations |= option_configs::ScanImplementation::SCAN;
                 else if (strneq(elem.data(), "IndexScan", elem.size()))
                     options::scan_implementations |= option_configs::ScanImplementation::INDEX_SCAN;
+                else if (strneq(elem.data(), "LateMaterializingScan", elem.size()))
+                    options::scan_implementations |= option_configs::ScanImplementation::LATE_MATERIALIZING;
+                else if (strneq(elem.data(), "ZoneMapScan", elem.size()))
+                    options::scan_implementations |= option_configs::ScanImplementation::ZONE_MAP;
+                else if (strneq(elem.data(), "SelectionVectorScan", elem.size()))
+                    options::scan_implementations |= option_configs::ScanImplementation::SELECTION_VECTOR;
                 else
                     std::cerr << "warning: ignore invalid physical scan implementation " << elem << std::endl;
             }
@@ -48,8 +65,8 @@ static void add_wasm_operator_args()
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
         /* long=        */ "--grouping-implementations",
-        /* description= */ "a comma seperated list of physical grouping implementations to consider (`HashBased` or "
-                           "`Ordered`)",
+        /* description= */ "a comma seperated list of physical grouping implementations to consider (`HashBased`, "
+                           "`Ordered`, `Array`, or `RadixPartitioned`)",
         /* callback=    */ [](std::vector<std::string_view> impls){
             options::grouping_implementations = option_configs::GroupingImplementation(0UL);
             for (const auto &elem : impls) {
@@ -57,6 +74,10 @@ static void add_wasm_operator_args()
                     options::grouping_implementations |= option_configs::GroupingImplementation::HASH_BASED;
                 else if (strneq(elem.data(), "Ordered", elem.size()))
                     options::grouping_implementations |= option_configs::GroupingImplementation::ORDERED;
+                else if (strneq(elem.data(), "Array", elem.size()))
+                    options::grouping_implementations |= option_configs::GroupingImplementation::ARRAY;
+                else if (strneq(elem.data(), "RadixPartitioned", elem.size()))
+                    options::grouping_implementations |= option_configs::GroupingImplementation::RADIX_PARTITIONED;
                 else
                     std::cerr << "warning: ignore invalid physical grouping implementation " << elem << std::endl;
             }
@@ -66,13 +87,15 @@ static void add_wasm_operator_args()
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
         /* long=        */ "--sorting-implementations",
-        /* description= */ "a comma seperated list of physical sorting implementations to consider (`Quicksort` or "
-                           "`NoOp`)",
+        /* description= */ "a comma seperated list of physical sorting implementations to consider (`Quicksort`, "
+                           "`Radix`, or `NoOp`)",
         /* callback=    */ [](std::vector<std::string_view> impls){
             options::sorting_implementations = option_configs::SortingImplementation(0UL);
             for (const auto &elem : impls) {
                 if (strneq(elem.data(), "Quicksort", elem.size()))
                     options::sorting_implementations |= option_configs::SortingImplementation::QUICKSORT;
+                else if (strneq(elem.data(), "Radix", elem.size()))
+                    options::sorting_implementations |= option_configs::SortingImplementation::RADIX;
                 else if (strneq(elem.data(), "NoOp", elem.size()))
                     options::sorting_implementations |= option_configs::SortingImplementation::NOOP;
                 else
@@ -85,7 +108,8 @@ static void add_wasm_operator_args()
         /* short=       */ nullptr,
         /* long=        */ "--join-implementations",
         /* description= */ "a comma seperated list of physical join implementations to consider (`NestedLoops`, "
-                           "`SimpleHash`, or `SortMerge`)",
+                           "`SimpleHash`, `SortMerge`, `RadixPartitioned`, `PartitionWise`, `IndexNestedLoops`, "
+                           "`DirectAddress`, or `Band`)",
         /* callback=    */ [](std::vector<std::string_view> impls){
             options::join_implementations = option_configs::JoinImplementation(0UL);
             for (const auto &elem : impls) {
@@ -95,6 +119,16 @@ static void add_wasm_operator_args()
                     options::join_implementations |= option_configs::JoinImplementation::SIMPLE_HASH;
                 else if (strneq(elem.data(), "SortMerge", elem.size()))
                     options::join_implementations |= option_configs::JoinImplementation::SORT_MERGE;
+                else if (strneq(elem.data(), "RadixPartitioned", elem.size()))
+                    options::join_implementations |= option_configs::JoinImplementation::RADIX_PARTITIONED;
+                else if (strneq(elem.data(), "PartitionWise", elem.size()))
+                    options::join_implementations |= option_configs::JoinImplementation::PARTITION_WISE;
+                else if (strneq(elem.data(), "IndexNestedLoops", elem.size()))
+                    options::join_implementations |= option_configs::JoinImplementation::INDEX_NESTED_LOOPS;
+                else if (strneq(elem.data(), "DirectAddress", elem.size()))
+                    options::join_implementations |= option_configs::JoinImplementation::DIRECT_ADDRESS;
+                else if (strneq(elem.data(), "Band", elem.size()))
+                    options::join_implementations |= option_configs::JoinImplementation::BAND;
                 else
                     std::cerr << "warning: ignore invalid physical join implementation " << elem << std::endl;
             }
@@ -162,11 +196,19 @@ static void add_wasm_operator_args()
                 std::cerr << "warning: ignore invalid index scan strategy " << strategy << std::endl;
         }
     );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-index-only-scan",
+        /* description= */ "disable answering index scans that require only the indexed attribute from the index alone",
+        /* callback=    */ [](bool){ options::index_only_scan = false; }
+    );
     C.arg_parser().add<const char*>(
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
         /* long=        */ "--filter-selection-strategy",
-        /* description= */ "specify the selection strategy for filters (`Branching` or `Predicated`)",
+        /* description= */ "specify the selection strategy for filters (`Branching` or `Predicated`); by default, "
+                           "it is additionally chosen at runtime by sampling the selectivity",
         /* callback=    */ [](const char *strategy){
             if (streq(strategy, "Branching"))
                 options::filter_selection_strategy = option_configs::SelectionStrategy::BRANCHING;
@@ -232,6 +274,57 @@ static void add_wasm_operator_args()
                 std::cerr << "warning: ignore invalid simple hash join ordering strategy " << strategy << std::endl;
         }
     );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--simple-hash-join-probe-window-size",
+        /* description= */ "set the window size in tuples for batched probes in simple hash joins, i.e. the number of "
+                           "probe tuples whose buckets are accessed before they are actually probed (0 means no "
+                           "batching; a multiple of 32 allows SIMDfied hashing of the probe keys)",
+        /* callback=    */ [](std::size_t size){
+            if (not std::in_range<uint32_t>(size))
+                std::cerr << "warning: ignore invalid simple hash join probe window size " << size << std::endl;
+            else
+                options::simple_hash_join_probe_window_size = size;
+        }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--index-nested-loops-join-probe-window-size",
+        /* description= */ "set the window size in tuples for batched index lookups in index nested-loops joins, i.e. "
+                           "the number of outer tuples whose keys are looked up by a single host call",
+        /* callback=    */ [](std::size_t size){
+            if (size == 0 or not std::in_range<uint32_t>(size))
+                std::cerr << "warning: ignore invalid index nested-loops join probe window size " << size << std::endl;
+            else
+                options::index_nested_loops_join_probe_window_size = size;
+        }
+    );
+    C.arg_parser().add<const char*>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--simple-hash-join-bloom-filter",
+        /* description= */ "specify whether simple hash joins use a Bloom filter on the build keys to drop probe "
+                           "tuples early (`Always` or `Never`)",
+        /* callback=    */ [](const char *strategy){
+            if (streq(strategy, "Always"))
+                options::simple_hash_join_bloom_filter_strategy = option_configs::BloomFilterStrategy::ALWAYS;
+            else if (streq(strategy, "Never"))
+                options::simple_hash_join_bloom_filter_strategy = option_configs::BloomFilterStrategy::NEVER;
+            else
+                std::cerr << "warning: ignore invalid simple hash join Bloom filter strategy " << strategy
+                          << std::endl;
+        }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-simple-hash-join-key-range-filter",
+        /* description= */ "disable dropping probe tuples of simple hash joins whose key lies outside of the range of "
+                           "the build keys",
+        /* callback=    */ [](bool){ options::simple_hash_join_key_range_filter = false; }
+    );
     C.arg_parser().add<const char*>(
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
@@ -262,16 +355,65 @@ static void add_wasm_operator_args()
                           << std::endl;
         }
     );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--sort-merge-join-gallop-threshold",
+        /* description= */ "set the number of consecutive steps on the same child after which sort merge joins skip "
+                           "tuples of this child by exponential search (0 means never skip)",
+        /* callback=    */ [](std::size_t threshold){ options::sort_merge_join_gallop_threshold = threshold; }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--radix-join-partition-size",
+        /* description= */ "specify the targeted size in bytes of a build side partition in radix partitioned hash "
+                           "joins, e.g. the size of the L2 cache",
+        /* callback=    */ [](std::size_t size){
+            if (size == 0)
+                std::cerr << "warning: ignore invalid radix join partition size " << size << std::endl;
+            else
+                options::radix_partitioned_hash_join_partition_size = size;
+        }
+    );
+    C.arg_parser().add<double>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--radix-join-role-reversal-factor",
+        /* description= */ "specify the factor by which the build child of a radix partitioned hash join must turn out "
+                           "to be larger than its probe child to reverse their roles at runtime (0 to disable)",
+        /* callback=    */ [](double factor){
+            if (factor < 0)
+                std::cerr << "warning: ignore invalid radix join role reversal factor " << factor << std::endl;
+            else
+                options::radix_partitioned_hash_join_role_reversal_factor = factor;
+        }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--radix-grouping-partition-size",
+        /* description= */ "specify the targeted size in bytes of the groups of a partition in radix partitioned "
+                           "groupings, e.g. the size of the L2 cache",
+        /* callback=    */ [](std::size_t size){
+            if (size == 0)
+                std::cerr << "warning: ignore invalid radix grouping partition size " << size << std::endl;
+            else
+                options::radix_partitioned_grouping_partition_size = size;
+        }
+    );
     C.arg_parser().add<const char*>(
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
         /* long=        */ "--hash-table-implementation",
-        /* description= */ "specify the hash table implementation (`OpenAddressing` or `Chained`)",
+        /* description= */ "specify the hash table implementation (`OpenAddressing`, `Chained`, or `Swiss`)",
         /* callback=    */ [](const char *impl){
             if (streq(impl, "OpenAddressing"))
                 options::hash_table_implementation = option_configs::HashTableImplementation::OPEN_ADDRESSING;
             else if (streq(impl, "Chained"))
                 options::hash_table_implementation = option_configs::HashTableImplementation::CHAINED;
+            else if (streq(impl, "Swiss"))
+                options::hash_table_implementation = option_configs::HashTableImplementation::SWISS;
             else
                 std::cerr << "warning: ignore invalid hash table implementation " << impl << std::endl;
         }
@@ -324,6 +466,56 @@ static void add_wasm_operator_args()
             options::hash_table_initial_capacity = initial_capacity;
         }
     );
+    C.arg_parser().add<double>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--hash-table-capacity-margin",
+        /* description= */ "specify the factor by which estimated cardinalities are enlarged when sizing hash tables "
+                           "(at least 1)",
+        /* callback=    */ [](double margin){
+            if (margin < 1.0)
+                std::cerr << "warning: ignore invalid hash table capacity margin " << margin << std::endl;
+            else
+                options::hash_table_capacity_margin = margin;
+        }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--hash-table-max-estimated-capacity",
+        /* description= */ "specify the maximal initial capacity of hash tables sized by estimated cardinalities",
+        /* callback=    */ [](std::size_t capacity){
+            if (capacity == 0 or not std::in_range<uint32_t>(capacity))
+                std::cerr << "warning: ignore invalid hash table capacity " << capacity << std::endl;
+            else
+                options::hash_table_max_estimated_capacity = capacity;
+        }
+    );
+    C.arg_parser().add<double>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--direct-address-join-max-domain-factor",
+        /* description= */ "specify the maximal ratio of the size of the key domain of direct address joins to the "
+                           "number of build tuples (at least 1)",
+        /* callback=    */ [](double factor){
+            if (factor < 1.0)
+                std::cerr << "warning: ignore invalid key domain factor " << factor << std::endl;
+            else
+                options::direct_address_join_max_domain_factor = factor;
+        }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--array-grouping-max-domain-size",
+        /* description= */ "specify the maximal number of values of the key domain of array-based grouping",
+        /* callback=    */ [](std::size_t size){
+            if (size == 0 or not std::in_range<uint32_t>(size))
+                std::cerr << "warning: ignore invalid key domain size " << size << std::endl;
+            else
+                options::array_grouping_max_domain_size = size;
+        }
+    );
     C.arg_parser().add<bool>(
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
@@ -331,6 +523,20 @@ static void add_wasm_operator_args()
         /* description= */ "disable potential use of hash-based group-join",
         /* callback=    */ [](bool){ options::hash_based_group_join = false; }
     );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-hash-semi-join",
+        /* description= */ "disable potential use of hash semi-join",
+        /* callback=    */ [](bool){ options::hash_semi_join = false; }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-top-k",
+        /* description= */ "disable potential use of a heap-based top-k for limits on top of sortings",
+        /* callback=    */ [](bool){ options::top_k = false; }
+    );
     C.arg_parser().add<const char*>(
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
@@ -379,7 +585,8 @@ static void add_wasm_operator_args()
         /* short=       */ nullptr,
         /* long=        */ "--soft-pipeline-breaker",
         /* description= */ "a comma seperated list where to insert soft pipeline breakers (`AfterAll`, `AfterScan`, "
-                           "`AfterFilter`, `AfterProjection`, `AfterNestedLoopsJoin`, or `AfterSimpleHashJoin`)",
+                           "`AfterFilter`, `AfterProjection`, `AfterNestedLoopsJoin`, `AfterSimpleHashJoin`, or "
+                           "`Adaptive` to decide after each filter by its estimated selectivity)",
         /* callback=    */ [](std::vector<std::string_view> location){
             options::soft_pipeline_breaker = option_configs::SoftPipelineBreakerStrategy(0UL);
             for (const auto &elem : location) {
@@ -397,6 +604,8 @@ static void add_wasm_operator_args()
                     options::soft_pipeline_breaker |= option_configs::SoftPipelineBreakerStrategy::AFTER_NESTED_LOOPS_JOIN;
                 else if (strneq(elem.data(), "AfterSimpleHashJoin", elem.size()))
                     options::soft_pipeline_breaker |= option_configs::SoftPipelineBreakerStrategy::AFTER_SIMPLE_HASH_JOIN;
+                else if (strneq(elem.data(), "Adaptive", elem.size()))
+                    options::soft_pipeline_breaker |= option_configs::SoftPipelineBreakerStrategy::ADAPTIVE;
                 else
                     std::cerr << "warning: ignore invalid location for soft pipeline breakers " << elem << std::endl;
             }
@@ -452,6 +661,14 @@ static void add_wasm_operator_args()
         /* description= */ "set the size in tuples for soft pipeline breakers (0 means infinite)",
         /* callback=    */ [](std::size_t num_tuples){ options::soft_pipeline_breaker_num_tuples = num_tuples; }
     );
+    C.arg_parser().add<double>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--soft-pipeline-breaker-max-selectivity",
+        /* description= */ "set the maximal estimated selectivity of a filter after which an adaptive soft pipeline "
+                           "breaker is inserted",
+        /* callback=    */ [](double selectivity){ options::soft_pipeline_breaker_max_selectivity = selectivity; }
+    );
     C.arg_parser().add<std::size_t>(
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
@@ -461,6 +678,50 @@ static void add_wasm_operator_args()
                            "(0 means infinite), ignored in case of --isam-compile-qualifying",
         /* callback=    */ [](std::size_t size){ options::index_sequential_scan_batch_size = size; }
     );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-adaptive-index-sequential-scan-batch-size",
+        /* description= */ "disable doubling the batch size of index sequential scans after each batch",
+        /* callback=    */ [](bool){ options::index_sequential_scan_adaptive_batch_size = false; }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--index-sequential-scan-max-batch-size",
+        /* description= */ "set the maximal number of tuple ids communicated between host and V8 per batch during "
+                           "index sequential scan with adaptive batch sizes (0 means infinite)",
+        /* callback=    */ [](std::size_t size){ options::index_sequential_scan_max_batch_size = size; }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--scan-morsel-size",
+        /* description= */ "set the number of rows per morsel claimed by scans from their work queue (0 means scans "
+                           "are not split into morsels)",
+        /* callback=    */ [](std::size_t size){ options::scan_morsel_size = size; }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--selection-vector-size",
+        /* description= */ "set the number of rows whose selection vector is computed at once by a selection vector "
+                           "scan",
+        /* callback=    */ [](std::size_t size){
+            if (size == 0)
+                std::cerr << "warning: ignore invalid selection vector size 0" << std::endl;
+            else
+                options::selection_vector_size = size;
+        }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--scan-morsel-functions",
+        /* description= */ "process each morsel of a scan by a call of a function of its own s.t. the pipeline may "
+                           "switch to optimized code between morsels, e.g. with --wasm-adaptive",
+        /* callback=    */ [](bool b){ options::scan_morsel_functions = b; }
+    );
     C.arg_parser().add<std::size_t>(
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
@@ -468,6 +729,21 @@ static void add_wasm_operator_args()
         /* description= */ "set the window size in tuples for the result set (0 means infinite)",
         /* callback=    */ [](std::size_t size){ options::result_set_window_size = size; }
     );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--wasm-huge-pages",
+        /* description= */ "advise the kernel to back tables and the heap in Wasm memory by transparent huge pages",
+        /* callback=    */ [](bool b){ options::wasm_huge_pages = b; }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--wasm-prefault-size",
+        /* description= */ "set the number of bytes of each table and the heap in Wasm memory to prefault before "
+                           "execution (0 disables)",
+        /* callback=    */ [](std::size_t size){ options::wasm_prefault_size = size; }
+    );
     C.arg_parser().add<bool>(
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
@@ -489,6 +765,14 @@ static void add_wasm_operator_args()
         /* description= */ "disable use of double pumping (has only an effect if SIMDfication is enabled)",
         /* callback=    */ [](bool){ options::double_pumping = false; }
     );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--wasm-explain-analyze",
+        /* description= */ "count the tuples produced by each physical operator and print them next to the estimated "
+                           "cardinalities after execution",
+        /* callback=    */ [](bool b){ options::explain_analyze = b; }
+    );
     C.arg_parser().add<std::size_t>(
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
@@ -496,6 +780,19 @@ static void add_wasm_operator_args()
         /* description= */ "set the number of SIMD lanes to prefer",
         /* callback=    */ [](std::size_t lanes){ options::simd_lanes = lanes; }
     );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--aggregation-accumulators",
+        /* description= */ "set the number of independent SIMD vectors accumulating each aggregate of an ungrouped "
+                           "aggregation (has only an effect if SIMDfication is enabled)",
+        /* callback=    */ [](std::size_t n){
+            if (n == 0)
+                std::cerr << "warning: ignore invalid number of aggregation accumulators 0" << std::endl;
+            else
+                options::aggregation_accumulators = n;
+        }
+    );
     C.arg_parser().add<std::vector<std::string_view>>(
         /* group=       */ "Hacks",
         /* short=       */ nullptr,
@@ -557,16 +854,28 @@ void m::register_wasm_operators(PhysicalOptimizer &phys_opt)
         if (bool(options::index_implementations bitand option_configs::IndexImplementation::RMI))
             phys_opt.register_operator<IndexScan<idx::IndexMethod::Rmi>>();
     }
+    if (bool(options::scan_implementations bitand option_configs::ScanImplementation::LATE_MATERIALIZING))
+        phys_opt.register_operator<LateMaterializingScan>();
+    if (bool(options::scan_implementations bitand option_configs::ScanImplementation::ZONE_MAP))
+        phys_opt.register_operator<ZoneMapScan>();
+    if (bool(options::scan_implementations bitand option_configs::ScanImplementation::SELECTION_VECTOR))
+        phys_opt.register_operator<SelectionVectorScan>();
     if (bool(options::filter_selection_strategy bitand option_configs::SelectionStrategy::BRANCHING))
         phys_opt.register_operator<Filter<false>>();
     if (bool(options::filter_selection_strategy bitand option_configs::SelectionStrategy::PREDICATED))
         phys_opt.register_operator<Filter<true>>();
+    if (options::filter_selection_strategy == option_configs::SelectionStrategy::AUTO)
+        phys_opt.register_operator<AdaptiveFilter>();
     phys_opt.register_operator<LazyDisjunctiveFilter>();
     phys_opt.register_operator<Projection>();
     if (bool(options::grouping_implementations bitand option_configs::GroupingImplementation::HASH_BASED))
         phys_opt.register_operator<HashBasedGrouping>();
     if (bool(options::grouping_implementations bitand option_configs::GroupingImplementation::ORDERED))
         phys_opt.register_operator<OrderedGrouping>();
+    if (bool(options::grouping_implementations bitand option_configs::GroupingImplementation::ARRAY))
+        phys_opt.register_operator<ArrayGrouping>();
+    if (bool(options::grouping_implementations bitand option_configs::GroupingImplementation::RADIX_PARTITIONED))
+        phys_opt.register_operator<RadixPartitionedGrouping>();
     phys_opt.register_operator<Aggregation>();
     if (bool(options::sorting_implementations bitand option_configs::SortingImplementation::QUICKSORT)) {
         if (bool(options::quicksort_cmp_selection_strategy bitand option_configs::SelectionStrategy::BRANCHING))
@@ -574,6 +883,8 @@ void m::register_wasm_operators(PhysicalOptimizer &phys_opt)
         if (bool(options::quicksort_cmp_selection_strategy bitand option_configs::SelectionStrategy::PREDICATED))
             phys_opt.register_operator<Quicksort<true>>();
     }
+    if (bool(options::sorting_implementations bitand option_configs::SortingImplementation::RADIX))
+        phys_opt.register_operator<RadixSort>();
     if (bool(options::sorting_implementations bitand option_configs::SortingImplementation::NOOP))
         phys_opt.register_operator<NoOpSorting>();
     if (bool(options::join_implementations bitand option_configs::JoinImplementation::NESTED_LOOPS)) {
@@ -624,9 +935,27 @@ void m::register_wasm_operators(PhysicalOptimizer &phys_opt)
             }
         }
     }
+    if (bool(options::join_implementations bitand option_configs::JoinImplementation::RADIX_PARTITIONED))
+        phys_opt.register_operator<RadixPartitionedHashJoin>();
+    if (bool(options::join_implementations bitand option_configs::JoinImplementation::PARTITION_WISE))
+        phys_opt.register_operator<PartitionWiseHashJoin>();
+    if (bool(options::join_implementations bitand option_configs::JoinImplementation::DIRECT_ADDRESS))
+        phys_opt.register_operator<DirectAddressJoin>();
+    if (bool(options::join_implementations bitand option_configs::JoinImplementation::BAND))
+        phys_opt.register_operator<BandJoin>();
+    if (bool(options::join_implementations bitand option_configs::JoinImplementation::INDEX_NESTED_LOOPS)) {
+        if (bool(options::index_implementations bitand option_configs::IndexImplementation::ARRAY))
+            phys_opt.register_operator<IndexNestedLoopsJoin<idx::IndexMethod::Array>>();
+        if (bool(options::index_implementations bitand option_configs::IndexImplementation::RMI))
+            phys_opt.register_operator<IndexNestedLoopsJoin<idx::IndexMethod::Rmi>>();
+    }
     phys_opt.register_operator<Limit>();
+    if (options::top_k)
+        phys_opt.register_operator<TopK>();
     if (options::hash_based_group_join)
         phys_opt.register_operator<HashBasedGroupJoin>();
+    if (options::hash_semi_join)
+        phys_opt.register_operator<HashSemiJoin>();
 }
 
 
@@ -933,6 +1262,22 @@ compute_aggregate_info(const std::vector<std::reference_wrapper<const FnApplicat
     return { std::move(aggregates_info), std::move(avg_aggregates_info) };
 }
 
+/** Returns the grouping keys \p group_by and the arguments of the aggregates \p aggregates, whose common
+ * subexpressions are bound once per tuple before the keys and aggregates are computed. */
+std::vector<std::reference_wrapper<const ast::Expr>>
+grouping_expressions(const std::vector<GroupingOperator::group_type> &group_by,
+                     const std::vector<std::reference_wrapper<const FnApplicationExpr>> &aggregates)
+{
+    std::vector<std::reference_wrapper<const ast::Expr>> exprs;
+    for (auto &[grp, _] : group_by)
+        exprs.emplace_back(grp);
+    for (auto &agg : aggregates) {
+        for (auto &arg : agg.get().args)
+            exprs.emplace_back(*arg);
+    }
+    return exprs;
+}
+
 /** Decompose the equi-predicate \p cnf, i.e. a conjunction of equality comparisons of each two designators, into all
  * identifiers contained in schema \p schema_left (returned as first element) and all identifiers not contained in
  * the aforementioned schema (return as second element). */
@@ -976,14 +1321,19 @@ Ptr<void> get_base_address(const ThreadSafePooledString &table_name) {
 }
 
 /** Computes the initial hash table capacity for \p op. The function ensures that the initial capacity is in the range
- * [0, 2^32 - 1] such that the capacity does *not* exceed the `uint32_t` value limit. */
+ * [0, 2^32 - 1] such that the capacity does *not* exceed the `uint32_t` value limit.  Estimated cardinalities are
+ * enlarged by `options::hash_table_capacity_margin` and the resulting capacity is bounded by
+ * `options::hash_table_max_estimated_capacity`. */
 uint32_t compute_initial_ht_capacity(const Operator &op, double load_factor) {
     uint64_t initial_capacity;
     if (options::hash_table_initial_capacity) {
         initial_capacity = *options::hash_table_initial_capacity;
     } else {
         if (op.has_info())
-            initial_capacity = static_cast<uint64_t>(std::ceil(op.info().estimated_cardinality / load_factor));
+            initial_capacity = std::min<uint64_t>(
+                std::ceil(op.info().estimated_cardinality * options::hash_table_capacity_margin / load_factor),
+                options::hash_table_max_estimated_capacity
+            );
         else if (auto scan = cast<const ScanOperator>(&op))
             initial_capacity = static_cast<uint64_t>(std::ceil(scan->store().num_rows() / load_factor));
         else
@@ -992,6 +1342,232 @@ uint32_t compute_initial_ht_capacity(const Operator &op, double load_factor) {
     return std::in_range<uint32_t>(initial_capacity) ? initial_capacity : std::numeric_limits<uint32_t>::max();
 }
 
+/** Decides how an open addressing hash table with the maximal load factor \p load_factor stores its values and how it
+ * resolves collisions, given the total size in bits of its keys \p key_size_in_bits and of its values \p
+ * value_size_in_bits (both ignoring padding).  Returns whether values are stored in-place and whether quadratic
+ * probing is used.  Strategies already fixed by \p in_place_values and \p quadratic_probing, e.g. by
+ * `--hash-table-storing-strategy`, are kept.
+ *
+ * In-place values save an indirection per access but widen every slot, s.t. each probed slot touches more memory.
+ * Hence, values are stored in-place unless they are much larger than the keys.  Linear probing scans adjacent slots
+ * and is thus cache friendly, but suffers from primary clustering, which lengthens probe sequences quickly as the
+ * table fills.  Hence, linear probing is used if the table never gets dense, i.e. for a small maximal load factor, or
+ * if its slots are narrow, s.t. even long probe sequences span only a few cache lines. */
+std::pair<bool, bool> choose_open_addressing_strategies(std::optional<bool> in_place_values,
+                                                        std::optional<bool> quadratic_probing, double load_factor,
+                                                        uint64_t key_size_in_bits, uint64_t value_size_in_bits)
+{
+    constexpr uint64_t IN_PLACE_MIN_THRESHOLD_IN_BITS = 128; ///< values of at most this size are always in-place
+    constexpr uint64_t IN_PLACE_KEY_FACTOR = 4; ///< values of at most this factor of the key size are in-place
+    constexpr double LINEAR_PROBING_MAX_LOAD_FACTOR = 0.7;
+    constexpr uint64_t LINEAR_PROBING_MAX_SLOT_SIZE_IN_BITS = 128; ///< at least four slots per cache line
+
+    const bool in_place = in_place_values.value_or(
+        value_size_in_bits <= std::max(IN_PLACE_MIN_THRESHOLD_IN_BITS, IN_PLACE_KEY_FACTOR * key_size_in_bits)
+    );
+    const uint64_t slot_size_in_bits = key_size_in_bits + (in_place ? value_size_in_bits : 32); // 32 bit pointer
+    const bool quadratic = quadratic_probing.value_or(
+        load_factor > LINEAR_PROBING_MAX_LOAD_FACTOR and slot_size_in_bits > LINEAR_PROBING_MAX_SLOT_SIZE_IN_BITS
+    );
+    return { in_place, quadratic };
+}
+
+/** Returns the size in bytes of a tuple of schema \p schema stored in a hash table or sorted, ignoring padding and
+ * NULL bitmaps, as used by the cost functions together with the coefficients per byte of `OperatorCalibration`. */
+double tuple_size_in_bytes(const Schema &schema)
+{
+    uint64_t size_in_bits = 0;
+    for (auto &e : schema.drop_constants().deduplicate())
+        size_in_bits += e.type->size();
+    return std::ceil(size_in_bits / 8.);
+}
+
+/** Returns the cost of building a hash table on \p build and probing it with \p probe as by `wasm::SimpleHashJoin`,
+ * where the keys of \p build are unique iff \p unique_build. */
+double simple_hash_join_cost(const Operator &build, const Operator &probe, bool unique_build)
+{
+    auto &coefficients = OperatorCalibration::Get().coefficients();
+    return (coefficients.hash_join_build_per_row +
+            coefficients.hash_table_per_byte * tuple_size_in_bytes(build.schema())) *
+        build.info().estimated_cardinality +
+        (unique_build ? 1.0 : 1.1) * coefficients.hash_join_probe_per_row * probe.info().estimated_cardinality;
+}
+
+/** Computes the number of radix bits, i.e. the logarithm of the number of partitions, used to partition the build
+ * child \p build, or the groups of a grouping, s.t. each partition is expected to fit into \p partition_size bytes.
+ * The number of bits is bounded to keep the fan-out of the partitioning small enough to not thrash the TLB. */
+uint32_t compute_num_radix_bits(const Operator &build, std::size_t partition_size) {
+    constexpr uint32_t MAX_NUM_RADIX_BITS = 10;
+    double num_tuples;
+    if (build.has_info())
+        num_tuples = build.info().estimated_cardinality;
+    else if (auto scan = cast<const ScanOperator>(&build))
+        num_tuples = scan->store().num_rows();
+    else
+        return 0; // fallback
+    uint64_t tuple_size_in_bits = 0;
+    for (auto &e : build.schema().drop_constants().deduplicate())
+        tuple_size_in_bits += e.type->size();
+    const double size_in_bytes = num_tuples * std::ceil(tuple_size_in_bits / 8.0);
+    if (size_in_bytes <= partition_size)
+        return 0;
+    const auto num_bits = static_cast<uint32_t>(std::ceil(std::log2(size_in_bytes / partition_size)));
+    return std::min(num_bits, MAX_NUM_RADIX_BITS);
+}
+
+/** Returns the domain of the integral attribute \p attr iff its minimum and maximum are known and it has at most
+ * \p max_size values.  The minimum and maximum are determined exactly by the zone maps of a `PaxStore` or, otherwise,
+ * estimated by the column statistics computed by `ANALYZE`, which may miss values. */
+std::optional<key_domain_t> find_key_domain(const Attribute &attr, uint64_t max_size)
+{
+    if (not attr.type->is_integral() and not attr.type->is_date())
+        return std::nullopt;
+
+    std::optional<std::pair<int64_t, int64_t>> min_max;
+    auto update_min_max = [&](int64_t min, int64_t max) {
+        min_max = min_max ? std::make_pair(std::min(min_max->first, min), std::max(min_max->second, max))
+                          : std::make_pair(min, max);
+    };
+
+    /*----- Determine minimum and maximum exactly by the zone maps of the table, if any. -----*/
+    if (auto pax = cast<const PaxStore>(&attr.table.store()); pax and pax->has_synopses(attr)) {
+        const std::size_t num_rows_per_block = pax->num_rows_per_block();
+        for (std::size_t block = 0, num_blocks = (pax->num_rows() + num_rows_per_block - 1) / num_rows_per_block;
+             block != num_blocks; ++block)
+        {
+            auto &synopsis = pax->synopses(attr)[block];
+            if (std::holds_alternative<std::monostate>(synopsis.min))
+                continue; // block contains only NULL values
+            update_min_max(std::get<int64_t>(synopsis.min), std::get<int64_t>(synopsis.max));
+        }
+    }
+
+    /*----- Otherwise, estimate minimum and maximum by the column statistics. -----*/
+    if (not min_max) {
+        Catalog &C = Catalog::Get();
+        if (not C.has_database_in_use())
+            return std::nullopt;
+        auto stats = ColumnStatistics::Get().find(C.get_database_in_use().name, attr.table.name());
+        if (not stats)
+            return std::nullopt;
+        auto it = stats->columns.find(attr.name);
+        if (it == stats->columns.end())
+            return std::nullopt;
+        const ColumnHistogram &H = it->second;
+        for (auto &mcv : H.mcvs)
+            update_min_max(std::llround(mcv.first), std::llround(mcv.first));
+        if (not H.bounds.empty())
+            update_min_max(std::llround(H.bounds.front()), std::llround(H.bounds.back()));
+        if (not min_max)
+            return std::nullopt; // no non-NULL value sampled
+    }
+
+    /*----- Check the size of the domain.  Compute it unsigned to not overflow. -----*/
+    const uint64_t max_offset = uint64_t(min_max->second) - uint64_t(min_max->first);
+    if (max_offset >= max_size)
+        return std::nullopt;
+    return std::make_pair(min_max->first, max_offset + 1);
+}
+
+/** Computes the radix partition of the current tuple, i.e. the \p num_bits high-order bits of the hash of its key
+ * \p keys whose types are given by \p schema.  Hash tables compute buckets from the low-order bits of the same hash,
+ * thus the high-order bits are used to not cluster the keys of a single partition in only few buckets. */
+U32x1 compute_radix_partition(const Schema &schema, const std::vector<Schema::Identifier> &keys, uint32_t num_bits)
+{
+    M_insist(num_bits > 0 and num_bits < 32, "invalid number of radix bits");
+    auto &env = CodeGenContext::Get().env();
+
+    /*----- Collect types of key together with the respective value. -----*/
+    std::vector<std::pair<const Type*, SQL_t>> values;
+    values.reserve(keys.size());
+    for (auto &key : keys)
+        values.emplace_back(schema[key].second.type, env.get(key));
+
+    /*----- Compute hash of key using Murmur3_64a and extract the high-order bits. -----*/
+    U64x1 hash = murmur3_64a_hash(std::move(values));
+    return (hash >> uint64_t(64 - num_bits)).to<uint32_t>();
+}
+
+/** Partitions \p buffer in-place, i.e. by swapping its tuples, into `2^num_radix_bits` partitions and writes its
+ * partition offsets to \p offsets, i.e. partition `p` consists of the tuple IDs in [offsets[p], offsets[p + 1]).  The
+ * partition of a tuple is computed by \p partition_of_current once the values of \p key_schema of the tuple are
+ * loaded into the current environment.  \p cursors must provide space for one cursor per partition.  Partitioning is
+ * done in two passes: the first one computes the histogram of the partitions, the second one moves each tuple directly
+ * to its final position, i.e. each tuple is moved at most once. */
+void partition_buffer(GlobalBuffer &buffer, const Schema &key_schema,
+                      const std::function<U32x1(void)> &partition_of_current, uint32_t num_radix_bits,
+                      Var<Ptr<U32x1>> &offsets, Var<Ptr<U32x1>> &cursors)
+{
+    const uint32_t num_partitions = 1U << num_radix_bits;
+    auto at = [](Var<Ptr<U32x1>> &ptr, U32x1 idx) { return *(ptr.val() + idx.make_signed()); };
+
+    buffer.setup_base_address(); // to access base address during loading and swapping as local
+    const Var<U32x1> size(buffer.size());
+
+    if (num_radix_bits == 0) {
+        /*----- Single partition contains the entire buffer. -----*/
+        at(offsets, U32x1(0U)) = 0U;
+        at(offsets, U32x1(1U)) = size.val();
+        buffer.teardown_base_address();
+        return;
+    }
+
+    /*----- Create load proxy for the keys and swap proxy for entire tuples. -----*/
+    auto load = buffer.create_load_proxy(key_schema);
+    auto swap = buffer.create_swap_proxy();
+    auto partition_of = [&](U32x1 tuple_id) -> U32x1 {
+        auto S = CodeGenContext::Get().scoped_environment();
+        load(tuple_id);
+        return partition_of_current();
+    };
+
+    /*----- Compute histogram, i.e. the number of tuples of partition `p` into `offsets[p + 1]`. -----*/
+    Var<U32x1> p(0U);
+    WHILE (p <= num_partitions) {
+        at(offsets, p) = 0U;
+        p += 1U;
+    }
+    Var<U32x1> tuple_id(0U);
+    WHILE (tuple_id < size) {
+        at(offsets, partition_of(tuple_id) + 1U) += 1U;
+        tuple_id += 1U;
+    }
+
+    /*----- Compute prefix sum s.t. `offsets[p]` is the first tuple ID of partition `p`. -----*/
+    p = 1U;
+    WHILE (p <= num_partitions) {
+        U32x1 prev = at(offsets, p - 1U);
+        at(offsets, p) += prev;
+        p += 1U;
+    }
+
+    /*----- Permute tuples s.t. all tuples of partition `p` are located in [offsets[p], offsets[p + 1]). Each
+     * cursor points to the first tuple of its partition which is not yet known to be at its final position. -----*/
+    p = 0U;
+    WHILE (p < num_partitions) {
+        at(cursors, p) = U32x1(at(offsets, p));
+        p += 1U;
+    }
+    p = 0U;
+    WHILE (p < num_partitions) {
+        const Var<U32x1> end(U32x1(at(offsets, p + 1U)));
+        WHILE (U32x1(at(cursors, p)) < end) {
+            const Var<U32x1> first(U32x1(at(cursors, p)));
+            const Var<U32x1> pid(partition_of(first));
+            IF (pid == p) {
+                at(cursors, p) += 1U; // tuple is already located in its partition
+            } ELSE {
+                const Var<U32x1> second(U32x1(at(cursors, pid)));
+                at(cursors, pid) += 1U;
+                swap(first, second); // move tuple to its partition and examine the swapped one next
+            };
+        }
+        p += 1U;
+    }
+
+    buffer.teardown_base_address();
+}
+
 ///> helper struct holding the bounds for index scan
 struct index_scan_bounds_t
 {
@@ -1102,47 +1678,628 @@ index_scan_bounds_t extract_index_scan_bounds(const cnf::CNF &cnf)
 }
 
 
-/*======================================================================================================================
- * NoOp
- *====================================================================================================================*/
-
-void NoOp::execute(const Match<NoOp> &M, setup_t, pipeline_t, teardown_t)
+/** Creates the hash table of the hash-based grouping \p M with an initial capacity of \p initial_capacity.  Its
+ * entries consist of the keys of the grouping and the aggregates \p aggregates. */
+std::unique_ptr<HashTable> create_grouping_hash_table(const Match<HashBasedGrouping> &M,
+                                                      const std::vector<aggregate_info_t> &aggregates,
+                                                      uint32_t initial_capacity)
 {
-    std::optional<Var<U32x1>> num_tuples; ///< variable to *locally* count additional result tuples
+    const auto num_keys = M.grouping.group_by().size();
 
-    M.child->execute(
-        /* setup=    */ setup_t::Make_Without_Parent([&](){ num_tuples.emplace(CodeGenContext::Get().num_tuples()); }),
-        /* pipeline= */ [&](){
-            M_insist(bool(num_tuples));
-            if (auto &env = CodeGenContext::Get().env(); env.predicated()) {
-                switch (CodeGenContext::Get().num_simd_lanes()) {
-                    default: M_unreachable("invalid number of simd lanes");
-                    case  1: {
-                        *num_tuples += env.extract_predicate<_Boolx1>().is_true_and_not_null().to<uint32_t>();
-                        break;
-                    }
-                    case 16: {
-                        auto pred = env.extract_predicate<_Boolx16>().is_true_and_not_null();
-                        *num_tuples += pred.bitmask().popcnt();
-                        break;
-                    }
-                }
-            } else {
-                *num_tuples += uint32_t(CodeGenContext::Get().num_simd_lanes());
-            }
-        },
-        /* teardown= */ teardown_t::Make_Without_Parent([&](){
-            M_insist(bool(num_tuples));
-            CodeGenContext::Get().set_num_tuples(*num_tuples);
-            num_tuples.reset();
-        })
+    /*----- Compute hash table schema. -----*/
+    Schema ht_schema;
+    /* Add key(s). */
+    uint64_t keys_size_in_bits = 0;
+    for (std::size_t i = 0; i < num_keys; ++i) {
+        auto &e = M.grouping.schema()[i];
+        ht_schema.add(e.id, e.type, e.constraints);
+        keys_size_in_bits += e.type->size();
+    }
+    /* Add payload. */
+    uint64_t aggregates_size_in_bits = 0;
+    for (auto &info : aggregates) {
+        ht_schema.add(info.entry);
+        aggregates_size_in_bits += info.entry.type->size();
+    }
+    const auto [in_place, quadratic] = choose_open_addressing_strategies(
+        M.use_in_place_values, M.use_quadratic_probing, M.load_factor, keys_size_in_bits, aggregates_size_in_bits
     );
+
+    /*----- Create hash table. -----*/
+    std::unique_ptr<HashTable> ht;
+    std::vector<HashTable::index_t> key_indices(num_keys);
+    std::iota(key_indices.begin(), key_indices.end(), 0);
+    if (M.use_swiss_hashing and in_place) {
+        ht = std::make_unique<GlobalSwissHashTable>(ht_schema, std::move(key_indices), initial_capacity);
+    } else if (M.use_open_addressing_hashing or M.use_swiss_hashing) { // Swiss tables store values only in-place
+        if (in_place)
+            ht = std::make_unique<GlobalOpenAddressingInPlaceHashTable>(ht_schema, std::move(key_indices),
+                                                                        initial_capacity);
+        else
+            ht = std::make_unique<GlobalOpenAddressingOutOfPlaceHashTable>(ht_schema, std::move(key_indices),
+                                                                           initial_capacity);
+        if (quadratic)
+            as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<QuadraticProbing>();
+        else
+            as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<LinearProbing>();
+    } else {
+        ht = std::make_unique<GlobalChainedHashTable>(ht_schema, std::move(key_indices), initial_capacity);
+    }
+    return ht;
 }
 
+/** Inserts the group of the current tuple into the hash table \p ht of \p grouping unless it already exists and
+ * initializes or updates its aggregates, given by \p aggregates and \p avg_aggregates.  The values of aggregates
+ * whose arguments are NULL are written to \p dummy to be ignored. */
+void update_group(HashTable &ht, const GroupingOperator &grouping, const std::vector<aggregate_info_t> &aggregates,
+                  const std::unordered_map<Schema::Identifier, avg_aggregate_info_t> &avg_aggregates,
+                  HashTable::entry_t &dummy)
+{
+    bind_common_subexpressions(CodeGenContext::Get().env(),
+                               grouping_expressions(grouping.group_by(), grouping.aggregates()));
+    const auto &env = CodeGenContext::Get().env();
+
+    /*----- Insert key if not yet done. -----*/
+    std::vector<SQL_t> key;
+    for (auto &p : grouping.group_by())
+        key.emplace_back(env.compile(p.first.get()));
+    auto [entry, inserted] = ht.try_emplace(std::move(key));
+
+    /*----- Compute aggregates. -----*/
+    Block init_aggs("hash_based_grouping.init_aggs", false),
+          update_aggs("hash_based_grouping.update_aggs", false),
+          update_avg_aggs("hash_based_grouping.update_avg_aggs", false);
+    for (auto &info : aggregates) {
+        bool is_min = false; ///< flag to indicate whether aggregate function is MIN
+        switch (info.fnid) {
+            default:
+                M_unreachable("unsupported aggregate function");
+            case m::Function::FN_MIN:
+                is_min = true; // set flag and delegate to MAX case
+            case m::Function::FN_MAX: {
+                M_insist(info.args.size() == 1,
+                         "MIN and MAX aggregate functions expect exactly one argument");
+                const auto &arg = *info.args[0];
+                std::visit(overloaded {
+                    [&]<sql_type _T>(HashTable::reference_t<_T> &&r) -> void
+                    requires (not (std::same_as<_T, _Boolx1> or std::same_as<_T, NChar>)) {
+                        using type = typename _T::type;
+                        using T = PrimitiveExpr<type>;
 
-/*======================================================================================================================
- * Callback
- *====================================================================================================================*/
+                        auto _arg = env.compile(arg);
+                        _T _new_val = convert<_T>(_arg);
+
+                        BLOCK_OPEN(init_aggs) {
+                            auto [val_, is_null] = _new_val.clone().split();
+                            T val(val_); // due to structured binding and lambda closure
+                            IF (is_null) {
+                                auto neutral = is_min ? T(std::numeric_limits<type>::max())
+                                                      : T(std::numeric_limits<type>::lowest());
+                                r.clone().set_value(neutral); // initialize with neutral element +inf or -inf
+                                if (info.entry.nullable())
+                                    r.clone().set_null(); // first value is NULL
+                            } ELSE {
+                                r.clone().set_value(val); // initialize with first value
+                                if (info.entry.nullable())
+                                    r.clone().set_not_null(); // first value is not NULL
+                            };
+                        }
+                        BLOCK_OPEN(update_aggs) {
+                            if (_new_val.can_be_null()) {
+                                M_insist_no_ternary_logic();
+                                auto [new_val_, new_val_is_null_] = _new_val.split();
+                                auto [old_min_max_, old_min_max_is_null] = _T(r.clone()).split();
+                                const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
+
+                                auto chosen_r = Select(new_val_is_null, dummy.extract<_T>(info.entry.id),
+                                                                        r.clone());
+                                if constexpr (std::floating_point<type>) {
+                                    chosen_r.set_value(
+                                        is_min ? min(old_min_max_, new_val_) // update old min with new value
+                                               : max(old_min_max_, new_val_) // update old max with new value
+                                    ); // if new value is NULL, only dummy is written
+                                } else {
+                                    const Var<T> new_val(new_val_),
+                                                 old_min_max(old_min_max_); // due to multiple uses
+                                    auto cmp = is_min ? new_val < old_min_max : new_val > old_min_max;
+
+                                    chosen_r.set_value(
+                                        Select(cmp,
+                                               new_val, // update to new value
+                                               old_min_max) // do not update
+                                    ); // if new value is NULL, only dummy is written
+
+                                    IF (cmp) {
+                                        r.set_value(new_val);
+                                    };
+
+                                }
+                                r.set_null_bit(
+                                    old_min_max_is_null and new_val_is_null // MIN/MAX is NULL iff all values are NULL
+                                );
+                            } else {
+                                auto new_val_ = _new_val.insist_not_null();
+                                auto old_min_max_ = _T(r.clone()).insist_not_null();
+                                if constexpr (std::floating_point<type>) {
+                                    r.set_value(
+                                        is_min ? min(old_min_max_, new_val_) // update old min with new value
+                                               : max(old_min_max_, new_val_) // update old max with new value
+                                    );
+                                } else {
+                                    const Var<T> new_val(new_val_),
+                                                 old_min_max(old_min_max_); // due to multiple uses
+                                    auto cmp = is_min ? new_val < old_min_max : new_val > old_min_max;
+
+                                    r.set_value(
+                                        Select(cmp,
+                                               new_val, // update to new value
+                                               old_min_max) // do not update
+                                    );
+
+                                    IF (cmp) {
+                                        r.set_value(new_val);
+                                    };
+
+                                }
+                                /* do not update NULL bit since it is already set to `false` */
+                            }
+                        }
+                    },
+                    []<sql_type _T>(HashTable::reference_t<_T>&&) -> void
+                    requires std::same_as<_T,_Boolx1> or std::same_as<_T, NChar> {
+                        M_unreachable("invalid type");
+                    },
+                    [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                }, entry.extract(info.entry.id));
+                break;
+            }
+            case m::Function::FN_AVG: {
+                auto it = avg_aggregates.find(info.entry.id);
+                M_insist(it != avg_aggregates.end());
+                const auto &avg_info = it->second;
+                M_insist(avg_info.compute_running_avg,
+                         "AVG aggregate may only occur for running average computations");
+                M_insist(info.args.size() == 1, "AVG aggregate function expects exactly one argument");
+                const auto &arg = *info.args[0];
+
+                auto r = entry.extract<_Doublex1>(info.entry.id);
+                auto _arg = env.compile(arg);
+                _Doublex1 _new_val = convert<_Doublex1>(_arg);
+
+                BLOCK_OPEN(init_aggs) {
+                    auto [val_, is_null] = _new_val.clone().split();
+                    Doublex1 val(val_); // due to structured binding and lambda closure
+                    IF (is_null) {
+                        r.clone().set_value(Doublex1(0.0)); // initialize with neutral element 0
+                        if (info.entry.nullable())
+                            r.clone().set_null(); // first value is NULL
+                    } ELSE {
+                        r.clone().set_value(val); // initialize with first value
+                        if (info.entry.nullable())
+                            r.clone().set_not_null(); // first value is not NULL
+                    };
+                }
+                BLOCK_OPEN(update_avg_aggs) {
+                    /* Compute AVG as iterative mean as described in Knuth, The Art of Computer Programming
+                     * Vol 2, section 4.2.2. */
+                    if (_new_val.can_be_null()) {
+                        M_insist_no_ternary_logic();
+                        auto [new_val, new_val_is_null_] = _new_val.split();
+                        auto [old_avg_, old_avg_is_null] = _Doublex1(r.clone()).split();
+                        const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
+                        const Var<Doublex1> old_avg(old_avg_); // due to multiple uses
+
+                        auto delta_absolute = new_val - old_avg;
+                        auto running_count = _I64x1(entry.get<_I64x1>(avg_info.running_count)).insist_not_null();
+                        auto delta_relative = delta_absolute / running_count.to<double>();
+
+                        auto chosen_r = Select(new_val_is_null, dummy.extract<_Doublex1>(info.entry.id),
+                                                                r.clone());
+                        chosen_r.set_value(
+                            old_avg + delta_relative // update old average with new value
+                        ); // if new value is NULL, only dummy is written
+                        r.set_null_bit(
+                            old_avg_is_null and new_val_is_null // AVG is NULL iff all values are NULL
+                        );
+                    } else {
+                        auto new_val = _new_val.insist_not_null();
+                        auto old_avg_ = _Doublex1(r.clone()).insist_not_null();
+                        const Var<Doublex1> old_avg(old_avg_); // due to multiple uses
+
+                        auto delta_absolute = new_val - old_avg;
+                        auto running_count = _I64x1(entry.get<_I64x1>(avg_info.running_count)).insist_not_null();
+                        auto delta_relative = delta_absolute / running_count.to<double>();
+                        r.set_value(
+                            old_avg + delta_relative // update old average with new value
+                        );
+                        /* do not update NULL bit since it is already set to `false` */
+                    }
+                }
+                break;
+            }
+            case m::Function::FN_SUM: {
+                M_insist(info.args.size() == 1, "SUM aggregate function expects exactly one argument");
+                const auto &arg = *info.args[0];
+                std::visit(overloaded {
+                    [&]<sql_type _T>(HashTable::reference_t<_T> &&r) -> void
+                    requires (not (std::same_as<_T, _Boolx1> or std::same_as<_T, NChar>)) {
+                        using type = typename _T::type;
+                        using T = PrimitiveExpr<type>;
+
+                        auto _arg = env.compile(arg);
+                        _T _new_val = convert<_T>(_arg);
+
+                        BLOCK_OPEN(init_aggs) {
+                            auto [val_, is_null] = _new_val.clone().split();
+                            T val(val_); // due to structured binding and lambda closure
+                            IF (is_null) {
+                                r.clone().set_value(T(type(0))); // initialize with neutral element 0
+                                if (info.entry.nullable())
+                                    r.clone().set_null(); // first value is NULL
+                            } ELSE {
+                                r.clone().set_value(val); // initialize with first value
+                                if (info.entry.nullable())
+                                    r.clone().set_not_null(); // first value is not NULL
+                            };
+                        }
+                        BLOCK_OPEN(update_aggs) {
+                            if (_new_val.can_be_null()) {
+                                M_insist_no_ternary_logic();
+                                auto [new_val, new_val_is_null_] = _new_val.split();
+                                auto [old_sum, old_sum_is_null] = _T(r.clone()).split();
+                                const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
+
+                                auto chosen_r = Select(new_val_is_null, dummy.extract<_T>(info.entry.id),
+                                                                        r.clone());
+                                chosen_r.set_value(
+                                    old_sum + new_val // add new value to old sum
+                                ); // if new value is NULL, only dummy is written
+                                r.set_null_bit(
+                                    old_sum_is_null and new_val_is_null // SUM is NULL iff all values are NULL
+                                );
+                            } else {
+                                auto new_val = _new_val.insist_not_null();
+                                auto old_sum = _T(r.clone()).insist_not_null();
+                                r.set_value(
+                                    old_sum + new_val // add new value to old sum
+                                );
+                                /* do not update NULL bit since it is already set to `false` */
+                            }
+                        }
+                    },
+                    []<sql_type _T>(HashTable::reference_t<_T>&&) -> void
+                    requires std::same_as<_T,_Boolx1> or std::same_as<_T, NChar> {
+                        M_unreachable("invalid type");
+                    },
+                    [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                }, entry.extract(info.entry.id));
+                break;
+            }
+            case m::Function::FN_COUNT: {
+                M_insist(info.args.size() <= 1, "COUNT aggregate function expects at most one argument");
+
+                auto r = entry.get<_I64x1>(info.entry.id); // do not extract to be able to access for AVG case
+
+                if (info.args.empty()) {
+                    BLOCK_OPEN(init_aggs) {
+                        r.clone() = _I64x1(1); // initialize with 1 (for first value)
+                    }
+                    BLOCK_OPEN(update_aggs) {
+                        auto old_count = _I64x1(r.clone()).insist_not_null();
+                        r.set_value(
+                            old_count + int64_t(1) // increment old count by 1
+                        );
+                        /* do not update NULL bit since it is already set to `false` */
+                    }
+                } else {
+                    const auto &arg = *info.args[0];
+
+                    auto _arg = env.compile(arg);
+                    I64x1 new_val_not_null = not_null(_arg).to<int64_t>();
+
+                    BLOCK_OPEN(init_aggs) {
+                        r.clone() = _I64x1(new_val_not_null.clone()); // initialize with 1 iff first value is present
+                    }
+                    BLOCK_OPEN(update_aggs) {
+                        auto old_count = _I64x1(r.clone()).insist_not_null();
+                        r.set_value(
+                            old_count + new_val_not_null // increment old count by 1 iff new value is present
+                        );
+                        /* do not update NULL bit since it is already set to `false` */
+                    }
+                }
+                break;
+            }
+        }
+    }
+
+    /*----- If group has been inserted, initialize aggregates. Otherwise, update them. -----*/
+    IF (inserted) {
+        init_aggs.attach_to_current();
+    } ELSE {
+        update_aggs.attach_to_current();
+        update_avg_aggs.attach_to_current(); // after others to ensure that running count is incremented before
+    };
+}
+
+/** Adds the group \p entry of the hash table of \p grouping, i.e. its keys and its aggregates, to the current
+ * environment.  AVG aggregates which are not computed as running average, see \p avg_aggregates, are computed here. */
+void add_group_to_environment(HashTable::const_entry_t entry, const GroupingOperator &grouping,
+                              const std::unordered_map<Schema::Identifier, avg_aggregate_info_t> &avg_aggregates)
+{
+    const auto num_keys = grouping.group_by().size();
+    auto &env = CodeGenContext::Get().env();
+
+    /*----- Compute key schema to detect duplicated keys. -----*/
+    Schema key_schema;
+    for (std::size_t i = 0; i < num_keys; ++i) {
+        auto &e = grouping.schema()[i];
+        key_schema.add(e.id, e.type, e.constraints);
+    }
+
+    /*----- Add computed group tuples to current environment. ----*/
+    for (auto &e : grouping.schema().deduplicate()) {
+        try {
+            key_schema.find(e.id);
+        } catch (invalid_argument&) {
+            continue; // skip duplicated keys since they must not be used afterwards
+        }
+
+        if (auto it = avg_aggregates.find(e.id);
+            it != avg_aggregates.end() and not it->second.compute_running_avg)
+        { // AVG aggregates which is not yet computed, divide computed sum with computed count
+            auto &avg_info = it->second;
+            auto sum = std::visit(overloaded {
+                [&]<sql_type T>(HashTable::const_reference_t<T> &&r) -> _Doublex1
+                requires (std::same_as<T, _I64x1> or std::same_as<T, _Doublex1>) {
+                    return T(r).template to<double>();
+                },
+                [](auto&&) -> _Doublex1 { M_unreachable("invalid type"); },
+                [](std::monostate&&) -> _Doublex1 { M_unreachable("invalid reference"); },
+            }, entry.get(avg_info.sum));
+            auto count = _I64x1(entry.get<_I64x1>(avg_info.running_count)).insist_not_null().to<double>();
+            auto avg = sum / count;
+            if (avg.can_be_null()) {
+                _Var<Doublex1> var(avg); // introduce variable s.t. uses only load from it
+                env.add(e.id, var);
+            } else {
+                /* introduce variable w/o NULL bit s.t. uses only load from it */
+                Var<Doublex1> var(avg.insist_not_null());
+                env.add(e.id, _Doublex1(var));
+            }
+        } else { // part of key or already computed aggregate
+            std::visit(overloaded {
+                [&]<typename T>(HashTable::const_reference_t<Expr<T>> &&r) -> void {
+                    Expr<T> value = r;
+                    if (value.can_be_null()) {
+                        Var<Expr<T>> var(value); // introduce variable s.t. uses only load from it
+                        env.add(e.id, var);
+                    } else {
+                        /* introduce variable w/o NULL bit s.t. uses only load from it */
+                        Var<PrimitiveExpr<T>> var(value.insist_not_null());
+                        env.add(e.id, Expr<T>(var));
+                    }
+                },
+                [&](HashTable::const_reference_t<NChar> &&r) -> void {
+                    NChar value(r);
+                    Var<Ptr<Charx1>> var(value.val()); // introduce variable s.t. uses only load from it
+                    env.add(e.id, NChar(var, value.can_be_null(), value.length(),
+                                        value.guarantees_terminating_nul()));
+                },
+                [](std::monostate&&) -> void { M_unreachable("invalid reference"); },
+            }, entry.get(e.id)); // do not extract to be able to access for not-yet-computed AVG aggregates
+        }
+    }
+}
+
+
+/*======================================================================================================================
+ * Soft pipeline breakers
+ *====================================================================================================================*/
+
+bool m::wasm::is_adaptive_soft_pipeline_breaker_beneficial(const Operator &filter, const Operator &child)
+{
+    if (not bool(options::soft_pipeline_breaker bitand option_configs::SoftPipelineBreakerStrategy::ADAPTIVE))
+        return false;
+    if (not options::simd)
+        return false; // without SIMDfication, filtered tuples do not leave gaps in vectors
+    if (not filter.has_info() or not child.has_info() or child.info().estimated_cardinality == 0)
+        return false; // selectivity unknown
+    const double selectivity = filter.info().estimated_cardinality / double(child.info().estimated_cardinality);
+    return selectivity <= options::soft_pipeline_breaker_max_selectivity;
+}
+
+
+/*======================================================================================================================
+ * OperatorTupleCounts
+ *====================================================================================================================*/
+
+OperatorTupleCounts & OperatorTupleCounts::Get()
+{
+    static OperatorTupleCounts the_counts;
+    return the_counts;
+}
+
+Global<U32x1> & OperatorTupleCounts::counter(const Operator &op)
+{
+    if (auto it = std::find(operators_.begin(), operators_.end(), &op); it != operators_.end())
+        return *counters_[std::distance(operators_.begin(), it)];
+    operators_.push_back(&op);
+    return *counters_.emplace_back(std::make_unique<Global<U32x1>>());
+}
+
+void OperatorTupleCounts::emit_report()
+{
+    for (std::size_t idx = 0; idx != counters_.size(); ++idx)
+        Module::Get().emit_call<void>("report_tuple_count", U32x1(uint32_t(idx)), counters_[idx]->val());
+    counters_.clear(); // the globals are not used by any later code; keep the operators for recording the counts
+}
+
+pipeline_t m::wasm::record_estimated_work(const Operator &op, pipeline_t pipeline)
+{
+    if (not pipeline or not op.has_info())
+        return pipeline;
+
+    return [num_tuples=op.info().estimated_cardinality, pipeline=std::move(pipeline)](){
+        CodeGenContext::Get().add_estimated_work(Module::Function(), num_tuples);
+        pipeline();
+    };
+}
+
+pipeline_t m::wasm::count_tuples(const Operator &op, pipeline_t pipeline)
+{
+    if (not options::explain_analyze)
+        return pipeline;
+
+    return [&counter=OperatorTupleCounts::Get().counter(op), pipeline=std::move(pipeline)](){
+        /* Count the tuples without consuming the predicate, which is still needed by the pipeline. */
+        if (auto &env = CodeGenContext::Get().env(); env.predicated()) {
+            switch (CodeGenContext::Get().num_simd_lanes()) {
+                default: M_unreachable("invalid number of simd lanes");
+                case  1: {
+                    counter += env.get_predicate<_Boolx1>().is_true_and_not_null().to<uint32_t>();
+                    break;
+                }
+                case 16: {
+                    auto pred = env.get_predicate<_Boolx16>().is_true_and_not_null();
+                    counter += pred.bitmask().popcnt();
+                    break;
+                }
+            }
+        } else {
+            counter += uint32_t(CodeGenContext::Get().num_simd_lanes());
+        }
+        pipeline();
+    };
+}
+
+
+/*======================================================================================================================
+ * OperatorMemoryConsumption
+ *====================================================================================================================*/
+
+OperatorMemoryConsumption & OperatorMemoryConsumption::Get()
+{
+    static OperatorMemoryConsumption the_consumption;
+    return the_consumption;
+}
+
+bool OperatorMemoryConsumption::enabled() { return Options::Get().statistics or options::explain_analyze; }
+
+void OperatorMemoryConsumption::emit_report()
+{
+    auto &A = Module::Allocator();
+    for (auto tag : A.tags()) {
+        auto op = static_cast<const Operator*>(tag);
+        const uint32_t idx = operators_.size();
+        operators_.push_back(op);
+        consumption_[op].pre_allocated = A.pre_allocated_memory_consumption(tag);
+        Module::Get().emit_call<void>("report_memory_consumption", U32x1(idx), A.allocated_memory_peak(tag));
+    }
+}
+
+OperatorMemoryScope::OperatorMemoryScope(const Operator &op, setup_t &setup, pipeline_t &pipeline,
+                                         teardown_t &teardown)
+    : enabled_(OperatorMemoryConsumption::enabled())
+{
+    if (not enabled_)
+        return;
+
+    parent_tag_ = Module::Allocator().tag(&op);
+
+    /* Tag the requests of the parent's callbacks with the parent.  The callbacks are shared since `setup_t` and
+     * `teardown_t` must be copyable when wrapped. */
+    auto with_parent_tag = [tag=parent_tag_](auto callback) {
+        return [tag, callback=std::make_shared<decltype(callback)>(std::move(callback))](){
+            auto prev = Module::Allocator().tag(tag);
+            (*callback)();
+            Module::Allocator().tag(prev);
+        };
+    };
+    setup = setup_t::Make_Without_Parent(with_parent_tag(std::move(setup)));
+    pipeline = with_parent_tag(std::move(pipeline));
+    teardown = teardown_t::Make_Without_Parent(with_parent_tag(std::move(teardown)));
+}
+
+OperatorMemoryScope::~OperatorMemoryScope()
+{
+    if (enabled_)
+        Module::Allocator().tag(parent_tag_);
+}
+
+
+/*======================================================================================================================
+ * OperatorSelectionStrategies
+ *====================================================================================================================*/
+
+OperatorSelectionStrategies & OperatorSelectionStrategies::Get()
+{
+    static OperatorSelectionStrategies the_strategies;
+    return the_strategies;
+}
+
+OperatorSelectionStrategies::state_t & OperatorSelectionStrategies::state(const Operator &op)
+{
+    if (auto it = std::find(operators_.begin(), operators_.end(), &op); it != operators_.end())
+        return *states_[std::distance(operators_.begin(), it)];
+    operators_.push_back(&op);
+    return *states_.emplace_back(std::make_unique<state_t>());
+}
+
+void OperatorSelectionStrategies::emit_report()
+{
+    if (options::explain_analyze) {
+        for (std::size_t idx = 0; idx != states_.size(); ++idx) {
+            auto &state = *states_[idx];
+            Module::Get().emit_call<void>("report_selection_strategy", U32x1(uint32_t(idx)), state.mode.val(),
+                                          state.num_sampled.val(), state.num_passed.val());
+        }
+    }
+    states_.clear(); // the globals are not used by any later code; keep the operators for recording the decisions
+}
+
+
+/*======================================================================================================================
+ * NoOp
+ *====================================================================================================================*/
+
+void NoOp::execute(const Match<NoOp> &M, setup_t, pipeline_t, teardown_t)
+{
+    std::optional<Var<U32x1>> num_tuples; ///< variable to *locally* count additional result tuples
+
+    M.child->execute(
+        /* setup=    */ setup_t::Make_Without_Parent([&](){ num_tuples.emplace(CodeGenContext::Get().num_tuples()); }),
+        /* pipeline= */ [&](){
+            M_insist(bool(num_tuples));
+            if (auto &env = CodeGenContext::Get().env(); env.predicated()) {
+                switch (CodeGenContext::Get().num_simd_lanes()) {
+                    default: M_unreachable("invalid number of simd lanes");
+                    case  1: {
+                        *num_tuples += env.extract_predicate<_Boolx1>().is_true_and_not_null().to<uint32_t>();
+                        break;
+                    }
+                    case 16: {
+                        auto pred = env.extract_predicate<_Boolx16>().is_true_and_not_null();
+                        *num_tuples += pred.bitmask().popcnt();
+                        break;
+                    }
+                }
+            } else {
+                *num_tuples += uint32_t(CodeGenContext::Get().num_simd_lanes());
+            }
+        },
+        /* teardown= */ teardown_t::Make_Without_Parent([&](){
+            M_insist(bool(num_tuples));
+            CodeGenContext::Get().set_num_tuples(*num_tuples);
+            num_tuples.reset();
+        })
+    );
+}
+
+
+/*======================================================================================================================
+ * Callback
+ *====================================================================================================================*/
 
 template<bool SIMDfied>
 ConditionSet Callback<SIMDfied>::pre_condition(std::size_t child_idx, const std::tuple<const CallbackOperator*>&)
@@ -1208,23 +2365,63 @@ void Print<SIMDfied>::execute(const Match<Print> &M, setup_t, pipeline_t, teardo
  * Scan
  *====================================================================================================================*/
 
-template<bool SIMDfied>
-ConditionSet Scan<SIMDfied>::pre_condition(std::size_t child_idx,
-                                           const std::tuple<const ScanOperator*> &partial_inner_nodes)
+/** Adds the `Sortedness` of the attributes of \p scan to \p post_cond.  An attribute is sorted if it is assumed to be
+ * sorted, see `options::sorted_attributes`, or if its column is declared or observed to be sorted, see `SortOrders`. */
+void add_scan_sortedness(ConditionSet &post_cond, const ScanOperator &scan)
 {
-     M_insist(child_idx == 0);
-
-    ConditionSet pre_cond;
-
-    if constexpr (SIMDfied) {
-        auto &scan = *std::get<0>(partial_inner_nodes);
-        auto &table = scan.store().table();
-
-        /*----- SIMDfied scan needs the data layout to support SIMD. -----*/
-        if (not supports_simd(table.layout(), table.schema(scan.alias()), scan.schema()))
-            return ConditionSet::Make_Unsatisfiable();
-
-        /*----- SIMDfied scan needs the number of rows to load be a whole multiple of the number of SIMD lanes used. -*/
+    auto &table = scan.store().table();
+    Catalog &C = Catalog::Get();
+    Sortedness::order_t orders;
+    for (auto &e : scan.schema()) {
+        auto pred = [&e](const auto &p){ return e.id == p.first; };
+        if (auto it = std::find_if(options::sorted_attributes.cbegin(), options::sorted_attributes.cend(), pred);
+            it != options::sorted_attributes.cend())
+        {
+            orders.add(e.id, it->second ? Sortedness::O_ASC : Sortedness::O_DESC);
+        } else if (C.has_database_in_use()) {
+            if (auto asc = SortOrders::Get().order(C.get_database_in_use().name, table, e.id.name))
+                orders.add(e.id, *asc ? Sortedness::O_ASC : Sortedness::O_DESC);
+        }
+    }
+    if (not orders.empty())
+        post_cond.add_condition(Sortedness(std::move(orders)));
+}
+
+/** Returns the layout schema to load the rows of \p scan with, in which the attributes whose columns contain no NULL
+ * are not nullable, see `NullFreeColumns`. */
+Schema scan_layout_schema(const ScanOperator &scan)
+{
+    auto &table = scan.store().table();
+    Catalog &C = Catalog::Get();
+    if (not C.has_database_in_use())
+        return table.schema(scan.alias());
+    return NullFreeColumns::Get().layout_schema(C.get_database_in_use().name, table, scan.alias());
+}
+
+template<bool SIMDfied>
+double Scan<SIMDfied>::cost(const Match<Scan>&)
+{
+    auto &coefficients = OperatorCalibration::Get().coefficients();
+    return M_CONSTEXPR_COND(SIMDfied, coefficients.scan_simdfied, coefficients.scan_scalar);
+}
+
+template<bool SIMDfied>
+ConditionSet Scan<SIMDfied>::pre_condition(std::size_t child_idx,
+                                           const std::tuple<const ScanOperator*> &partial_inner_nodes)
+{
+     M_insist(child_idx == 0);
+
+    ConditionSet pre_cond;
+
+    if constexpr (SIMDfied) {
+        auto &scan = *std::get<0>(partial_inner_nodes);
+        auto &table = scan.store().table();
+
+        /*----- SIMDfied scan needs the data layout to support SIMD. -----*/
+        if (not supports_simd(table.layout(), table.schema(scan.alias()), scan.schema()))
+            return ConditionSet::Make_Unsatisfiable();
+
+        /*----- SIMDfied scan needs the number of rows to load be a whole multiple of the number of SIMD lanes used. -*/
         if (scan.store().num_rows() % get_num_simd_lanes(table.layout(), table.schema(scan.alias()), scan.schema()) != 0)
             return ConditionSet::Make_Unsatisfiable();
     }
@@ -1250,18 +2447,8 @@ ConditionSet Scan<SIMDfied>::post_condition(const Match<Scan> &M)
         post_cond.add_condition(NoSIMD());
     }
 
-    /*----- Check if any attribute of scanned table is assumed to be sorted. -----*/
-    Sortedness::order_t orders;
-    for (auto &e : M.scan.schema()) {
-        auto pred = [&e](const auto &p){ return e.id == p.first; };
-        if (auto it = std::find_if(options::sorted_attributes.cbegin(), options::sorted_attributes.cend(), pred);
-            it != options::sorted_attributes.cend())
-        {
-            orders.add(e.id, it->second ? Sortedness::O_ASC : Sortedness::O_DESC);
-        }
-    }
-    if (not orders.empty())
-        post_cond.add_condition(Sortedness(std::move(orders)));
+    /*----- Check if any attribute of scanned table is sorted. -----*/
+    add_scan_sortedness(post_cond, M.scan);
 
     return post_cond;
 }
@@ -1278,7 +2465,7 @@ void Scan<SIMDfied>::execute(const Match<Scan> &M, setup_t setup, pipeline_t pip
     Var<U32x1> tuple_id; // default initialized to 0
 
     /*----- Compute possible number of SIMD lanes and decide which to use with regard to other operators preferences. */
-    const auto layout_schema = table.schema(M.scan.alias());
+    const auto layout_schema = scan_layout_schema(M.scan);
     CodeGenContext::Get().update_num_simd_lanes_preferred(options::simd_lanes); // set configured preference
     const auto num_simd_lanes_preferred =
         CodeGenContext::Get().num_simd_lanes_preferred(); // get other operators preferences
@@ -1295,6 +2482,7 @@ void Scan<SIMDfied>::execute(const Match<Scan> &M, setup_t setup, pipeline_t pip
     if (schema.num_entries() == 0) {
         setup();
         WHILE (tuple_id < num_rows) {
+            break_on_pipeline_exit();
             tuple_id += uint32_t(num_simd_lanes);
             pipeline();
         }
@@ -1302,3921 +2490,6530 @@ void Scan<SIMDfied>::execute(const Match<Scan> &M, setup_t setup, pipeline_t pip
         return;
     }
 
+    /*----- Register a morsel queue for this scan, if requested.  Round the morsel size up to a whole multiple of the
+     * number of SIMD lanes s.t. each morsel starts at a tuple ID beginning a SIMD batch. -----*/
+    const std::size_t morsel_size =
+        (options::scan_morsel_size + num_simd_lanes - 1) / num_simd_lanes * num_simd_lanes;
+    M_insist(std::in_range<uint32_t>(morsel_size), "morsel size must fit in uint32_t");
+    std::optional<std::size_t> queue_id;
+    if (morsel_size)
+        queue_id = CodeGenContext::Get().add_morsel_queue(morsel_size);
+    auto claim_morsel = [&queue_id, &num_rows](){
+        return Module::Get().emit_call<uint32_t>("next_morsel", U32x1(*queue_id), num_rows.clone());
+    };
+
+    static Schema empty_schema;
+    if (queue_id and options::scan_morsel_functions) {
+        /*----- Create function to process a single morsel, given by its first tuple ID and its end.  The entire
+         * pipeline including its setup and teardown code is emitted into this function, like into
+         * `Buffer::resume_pipeline()`.  Since the function is called anew for each morsel, the engine may switch to
+         * optimized code of the pipeline between morsels. -----*/
+        FUNCTION(scan_morsel, void(uint32_t, uint32_t))
+        {
+            auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+
+            /*----- Access first tuple ID and end parameters. -----*/
+            U32x1 begin = PARAMETER(0);
+            U32x1 end = PARAMETER(1);
+            Var<U32x1> morsel_tuple_id(begin);
+            const Var<U32x1> morsel_end(end);
+
+            /*----- Emit setup code *before* compiling data layout to not overwrite its temporary boolean variables. */
+            setup();
+
+            /*----- Compile data layout to generate sequential load from the morsel's first tuple on. -----*/
+            auto [inits, loads, jumps] = compile_load_sequential(schema, empty_schema, get_base_address(table.name()),
+                                                                 table.layout(), num_simd_lanes, layout_schema,
+                                                                 morsel_tuple_id, morsel_end.val());
+
+            /*----- Generate the loop for the actual scan of the morsel, with the pipeline emitted into the loop
+             * body. -----*/
+            inits.attach_to_current();
+            WHILE (morsel_tuple_id < morsel_end) {
+                break_on_pipeline_exit();
+                loads.attach_to_current();
+                pipeline();
+                jumps.attach_to_current();
+            }
+
+            /*----- Emit teardown code. -----*/
+            teardown();
+        }
+
+        /*----- Generate the loop claiming morsels from the queue until the table is exhausted. -----*/
+        tuple_id = claim_morsel();
+        WHILE (tuple_id < num_rows.clone()) {
+            break_on_pipeline_exit();
+            scan_morsel(tuple_id.val(), Select(num_rows.clone() - tuple_id > uint32_t(morsel_size),
+                                               tuple_id + uint32_t(morsel_size), num_rows.clone()));
+            tuple_id = claim_morsel();
+        }
+        num_rows.discard();
+        return;
+    }
+
     /*----- Import the base address of the mapped memory. -----*/
     Ptr<void> base_address = get_base_address(table.name());
 
     /*----- Emit setup code *before* compiling data layout to not overwrite its temporary boolean variables. -----*/
     setup();
 
-    /*----- Compile data layout to generate sequential load from table. -----*/
-    static Schema empty_schema;
-    auto [inits, loads, jumps] = compile_load_sequential(schema, empty_schema, base_address, table.layout(),
-                                                         num_simd_lanes, layout_schema, tuple_id);
+    if (queue_id) {
+        /*----- Generate the loop claiming morsels from the queue until the table is exhausted. -----*/
+        Var<U32x1> morsel_end;
+        tuple_id = claim_morsel();
+        WHILE (tuple_id < num_rows.clone()) {
+            break_on_pipeline_exit();
+            morsel_end = Select(num_rows.clone() - tuple_id > uint32_t(morsel_size),
+                                tuple_id + uint32_t(morsel_size), num_rows.clone());
+
+            /*----- Compile data layout to generate sequential load from the morsel's first tuple on. -----*/
+            auto [inits, loads, jumps] = compile_load_sequential(schema, empty_schema, base_address.clone(),
+                                                                 table.layout(), num_simd_lanes, layout_schema,
+                                                                 tuple_id, num_rows.clone());
+
+            /*----- Generate the loop for the actual scan of the morsel, with the pipeline emitted into the loop
+             * body. -----*/
+            inits.attach_to_current();
+            WHILE (tuple_id < morsel_end) {
+                break_on_pipeline_exit();
+                loads.attach_to_current();
+                pipeline();
+                jumps.attach_to_current();
+            }
 
-    /*----- Generate the loop for the actual scan, with the pipeline emitted into the loop body. -----*/
-    inits.attach_to_current();
-    WHILE (tuple_id < num_rows) {
-        loads.attach_to_current();
-        pipeline();
-        jumps.attach_to_current();
+            tuple_id = claim_morsel();
+        }
+        base_address.discard();
+        num_rows.discard();
+    } else {
+        /*----- Compile data layout to generate sequential load from table. -----*/
+        auto [inits, loads, jumps] = compile_load_sequential(schema, empty_schema, base_address, table.layout(),
+                                                             num_simd_lanes, layout_schema, tuple_id,
+                                                             num_rows.clone());
+
+        /*----- Generate the loop for the actual scan, with the pipeline emitted into the loop body. -----*/
+        inits.attach_to_current();
+        WHILE (tuple_id < num_rows) {
+            break_on_pipeline_exit();
+            loads.attach_to_current();
+            pipeline();
+            jumps.attach_to_current();
+        }
     }
 
     /*----- Emit teardown code. -----*/
     teardown();
 }
 
+
 /*======================================================================================================================
- * Index Scan
+ * Late Materializing Scan
  *====================================================================================================================*/
 
-template<idx::IndexMethod IndexMethod>
-ConditionSet IndexScan<IndexMethod>::pre_condition(std::size_t child_idx,
-                                                   const std::tuple<const FilterOperator*,
-                                                   const ScanOperator*> &partial_inner_nodes)
+/** Splits the schema of \p scan into the entries required by the filter condition \p cnf and the remaining ones. */
+std::pair<Schema, Schema> split_late_materialization_schema(const ScanOperator &scan, const cnf::CNF &cnf)
+{
+    Schema required = cnf.get_required();
+    Schema filter_schema, remaining_schema;
+    for (auto &e : scan.schema()) {
+        if (required.has(e.id))
+            filter_schema.add(e.id, e.type, e.constraints);
+        else
+            remaining_schema.add(e.id, e.type, e.constraints);
+    }
+    return { std::move(filter_schema), std::move(remaining_schema) };
+}
+
+ConditionSet LateMaterializingScan::pre_condition(
+    std::size_t child_idx,
+    const std::tuple<const FilterOperator*, const ScanOperator*> &partial_inner_nodes)
 {
     M_insist(child_idx == 0);
 
-    /*----- Check if index on one of the attributes in filter condition exists. -----*/
     auto &filter = *std::get<0>(partial_inner_nodes);
-    auto &cnf = filter.filter();
-
-    M_insist(not cnf.empty(), "Filter condition must not be empty");
-
     auto &scan = *std::get<1>(partial_inner_nodes);
-    auto &table = scan.store().table();
-
-    Catalog &C = Catalog::Get();
-    auto &DB = C.get_database_in_use();
-
-    /* Extract attributes from filter condition. */
-    std::vector<Schema::Identifier> ids;
-    for (auto &entry : cnf.get_required()) {
-        Schema::Identifier &id = entry.id;
-        M_insist(table.name() == id.prefix, "Table name should match designator table name");
-
-        /* Keep attributes for which an index exists. */
-        if (DB.has_index(table.name(), id.name, IndexMethod))
-            ids.push_back(id);
-    }
-    if (ids.empty()) // no usable index found
-        return ConditionSet::Make_Unsatisfiable();
 
-    /*----- Check if filter condition is supported. -----*/
-    /* We currently only support filter conditions of the following form.
-     * 1. Point: condition with a single equality predicate, e.g.
-     *    x = 42.
-     * 2. One-sided range: condition with a single greater/greater-or-equal/less/less-or-equal predicate, e.g.
-     *    x > 42.
-     * 3. Two-sided range: condition with a greater/greater-or-equal predicate and a less/less-or-equal predicate, e.g.
-     *    x > 42 AND x <= 89.
-     * Attributes may appear on either side.  The other side is required to be a `Constant`. */
-    if (ids.size() > 1) // conditions with more than one attribute currently not supported
+    /*----- Late materialization is only reasonable if the filter needs some but not all attributes. -----*/
+    const auto [filter_schema, remaining_schema] = split_late_materialization_schema(scan, filter.filter());
+    if (filter_schema.num_entries() == 0 or remaining_schema.num_entries() == 0)
         return ConditionSet::Make_Unsatisfiable();
 
-    bool has_lo_bound = false;
-    bool has_hi_bound = false;
-    for (auto &clause : cnf) {
-        if (clause.size() != 1) // disjunctions not supported
-            return ConditionSet::Make_Unsatisfiable();
-
-        auto &predicate = clause[0];
-        if (predicate.negative()) // negated predicates not supported
-            return ConditionSet::Make_Unsatisfiable();
+    ConditionSet pre_cond;
 
-        auto expr = cast<const BinaryExpr>(&predicate.expr());
-        if (not expr) // not a binary expression
-            return ConditionSet::Make_Unsatisfiable();
+    return pre_cond;
+}
 
-        bool has_attribute_left = is<const Designator>(expr->lhs);
-        auto &attribute = has_attribute_left ? *expr->lhs : *expr->rhs;
-        auto &constant = has_attribute_left ? *expr->rhs : *expr->lhs;
-        if (not is<const Designator>(attribute)) // attribute must be on lhs
-            return ConditionSet::Make_Unsatisfiable();
-        if (not is_valid_bound(constant))
-            return ConditionSet::Make_Unsatisfiable();
+double LateMaterializingScan::cost(const Match<LateMaterializingScan> &M)
+{
+    /*----- Estimate the selectivity of the filter, assuming that all tuples qualify if no estimate exists. -----*/
+    double selectivity = 1.0;
+    if (M.filter.has_info() and M.scan.store().num_rows() != 0)
+        selectivity = std::min(1.0, M.filter.info().estimated_cardinality / double(M.scan.store().num_rows()));
+
+    /*----- Relate the amount of loaded attributes to the ones of a non-SIMDfied `wasm::Scan`.  Point accesses are
+     * penalized since they are random instead of sequential. -----*/
+    const auto [filter_schema, remaining_schema] = split_late_materialization_schema(M.scan, M.filter.filter());
+    const double num_loads = filter_schema.num_entries() + 2.0 * selectivity * remaining_schema.num_entries();
+    const double scan_cost =
+        OperatorCalibration::Get().coefficients().scan_scalar * num_loads / M.scan.schema().num_entries();
+
+    /*----- Add cost of evaluating the filter condition as for `wasm::Filter`. -----*/
+    const cnf::CNF &cond = M.filter.filter();
+    const unsigned filter_cost = std::accumulate(cond.cbegin(), cond.cend(), 0U, [](unsigned cost, const cnf::Clause &clause) {
+        return cost + clause.size();
+    });
 
-        switch(expr->tok.type) {
-            default:
-                return ConditionSet::Make_Unsatisfiable();
-            case TK_EQUAL:
-                if (not has_lo_bound and not has_hi_bound) { // lo and hi bound not yet set
-                    has_lo_bound = has_hi_bound = true;
-                } else {
-                    return ConditionSet::Make_Unsatisfiable();
-                }
-                break;
-            case TK_GREATER:
-            case TK_GREATER_EQUAL:
-                if (has_attribute_left and not has_lo_bound) { // attribute on lhs, lo bound not yet set
-                    has_lo_bound = true;
-                } else if (not has_attribute_left and not has_hi_bound) { // attribute on rhs, hi bound not yet set
-                    has_hi_bound = true;
-                } else {
-                    return ConditionSet::Make_Unsatisfiable();
-                }
-                break;
-            case TK_LESS:
-            case TK_LESS_EQUAL:
-                if (has_attribute_left and not has_hi_bound) { // attribute on lhs, hi bound not yet set
-                    has_hi_bound = true;
-                } else if (not has_attribute_left and not has_lo_bound) { // attribute on rhs, lo bound not yet set
-                    has_lo_bound = true;
-                } else {
-                    return ConditionSet::Make_Unsatisfiable();
-                }
-                break;
-        }
-    }
-    return ConditionSet();
+    return scan_cost + filter_cost;
 }
 
-template<idx::IndexMethod IndexMethod>
-ConditionSet IndexScan<IndexMethod>::post_condition(const Match<IndexScan<IndexMethod>> &M)
+ConditionSet LateMaterializingScan::post_condition(const Match<LateMaterializingScan> &M)
 {
     ConditionSet post_cond;
 
-    /*----- Index scan does not introduce predication. -----*/
+    /*----- Late materializing scan does not introduce predication. -----*/
     post_cond.add_condition(Predicated(false));
 
-    /*----- Non-SIMDfied index scan does not introduce SIMD. -----*/
+    /*----- Late materializing scan does not introduce SIMD. -----*/
     post_cond.add_condition(NoSIMD());
 
-    /*----- Index scan introduces sortedness on indexed attribute. -----*/
-    /* Extract identifier from cnf. */
-    auto &cnf = M.filter.filter();
-    Schema designators = cnf.get_required();
-    M_insist(designators.num_entries() == 1, "filter condition must contain exactly one designator");
-    Schema::Identifier &id = designators[0].id;
-
-    /* Add sortedness post condition. */
-    Sortedness::order_t orders;
-    orders.add(id, Sortedness::O_ASC);
-    post_cond.add_condition(Sortedness(std::move(orders)));
+    /*----- Check if any attribute of scanned table is sorted. -----*/
+    add_scan_sortedness(post_cond, M.scan);
 
     return post_cond;
 }
 
-template<idx::IndexMethod IndexMethod>
-double IndexScan<IndexMethod>::cost(const Match<IndexScan<IndexMethod>>&)
+void LateMaterializingScan::execute(const Match<LateMaterializingScan> &M, setup_t setup, pipeline_t pipeline,
+                                    teardown_t teardown)
 {
-    /* TODO: add meaningful cost function. */
-    return 0.0;
-}
+    auto &schema = M.scan.schema();
+    auto &table = M.scan.store().table();
 
-template<idx::IndexMethod IndexMethod, typename Index, sql_type SqlT>
-void index_scan_codegen_compilation(const Index &index, const index_scan_bounds_t &bounds,
-                                    const Match<IndexScan<IndexMethod>> &M,
-                                    setup_t setup, pipeline_t pipeline, teardown_t teardown) {
-    using sql_type = SqlT;
+    M_insist(schema == schema.drop_constants().deduplicate(), "schema of `ScanOperator` must not contain NULL or duplicates");
+    M_insist(not table.layout().is_finite(), "layout for `wasm::LateMaterializingScan` must be infinite");
 
-    if (options::index_scan_compilation_strategy == option_configs::IndexScanCompilationStrategy::CALLBACK) {
-        /*----- Resolve callback function names. -----*/
-        const char *scan_fn, *lower_bound_fn, *upper_bound_fn;
-#define SET_CALLBACK_FNS(INDEX, KEY) \
-        scan_fn        = M_STR(idx_scan_##INDEX##_##KEY); \
-        lower_bound_fn = M_STR(idx_lower_bound_##INDEX##_##KEY); \
-        upper_bound_fn = M_STR(idx_upper_bound_##INDEX##_##KEY)
+    const auto [filter_schema, remaining_schema] = split_late_materialization_schema(M.scan, M.filter.filter());
+    M_insist(filter_schema.num_entries() != 0 and remaining_schema.num_entries() != 0);
 
-#define RESOLVE_KEYTYPE(INDEX) \
-        if constexpr(std::same_as<SqlT, _Boolx1>) { \
-            SET_CALLBACK_FNS(INDEX, b); \
-        } else if constexpr(std::same_as<sql_type, _I8x1>) { \
-            SET_CALLBACK_FNS(INDEX, i1); \
-        } else if constexpr(std::same_as<sql_type, _I16x1>) { \
-            SET_CALLBACK_FNS(INDEX, i2); \
-        } else if constexpr(std::same_as<sql_type, _I32x1>) { \
-            SET_CALLBACK_FNS(INDEX, i4); \
-        } else if constexpr(std::same_as<sql_type, _I64x1>) { \
-            SET_CALLBACK_FNS(INDEX, i8); \
-        } else if constexpr(std::same_as<sql_type, _Floatx1>) { \
-            SET_CALLBACK_FNS(INDEX, f); \
-        } else if constexpr(std::same_as<sql_type, _Doublex1>) { \
-            SET_CALLBACK_FNS(INDEX, d); \
-        } else if constexpr(std::same_as<sql_type, NChar>) { \
-            SET_CALLBACK_FNS(IDNEX, p); \
-        } else { \
-            M_unreachable("incompatible SQL type"); \
-        }
-        if constexpr(is_specialization<Index, idx::ArrayIndex>) {
-            RESOLVE_KEYTYPE(array)
-        } else if constexpr(is_specialization<Index, idx::RecursiveModelIndex>) {
-            RESOLVE_KEYTYPE(rmi)
-        } else {
-            M_unreachable("unknown index type");
-        }
-#undef RESOLVE_KEYTYPE
-#undef SET_CALLBACK_FNS
+    Var<U32x1> tuple_id; // default initialized to 0
 
-        /*----- Add index to context. -----*/
-        auto &context = WasmEngine::Get_Wasm_Context_By_ID(Module::ID());
-        U64x1 index_id(context.add_index(index));
+    /*----- Late materializing scan does not support SIMD. -----*/
+    const auto layout_schema = scan_layout_schema(M.scan);
+    CodeGenContext::Get().set_num_simd_lanes(1);
 
-        /*----- Emit host calls to query the index for lo and hi bounds. -----*/
-        auto compile_bound_lookup = [&](const ast::Expr &bound, bool is_lower_bound) {
-            auto key = CodeGenContext::Get().env().compile(bound);
-            return Module::Get().emit_call<uint32_t>(
-                /* fn=       */ is_lower_bound ? lower_bound_fn : upper_bound_fn,
-                /* index_id= */ index_id.clone(),
-                /* key=      */ convert<sql_type>(key).insist_not_null()
-            );
-        };
-        Var<U32x1> lo(bool(bounds.lo) ? compile_bound_lookup(bounds.lo->get(), bounds.is_inclusive_lo)
-                                      : U32x1(0));
-        const Var<U32x1> hi(bool(bounds.hi) ? compile_bound_lookup(bounds.hi->get(), not bounds.is_inclusive_hi)
-                                      : U32x1(index.num_entries()));
-        Wasm_insist(lo <= hi, "bounds need to be valid");
+    /*----- Import the number of rows of `table` and the base address of the mapped memory. -----*/
+    U32x1 num_rows = get_num_rows(table.name());
+    Ptr<void> base_address = get_base_address(table.name());
 
-        /*----- Allocate memory for communication to host. -----*/
-        M_insist(std::in_range<uint32_t>(M.batch_size), "should fit in uint32_t");
+    /*----- Emit setup code *before* compiling data layout to not overwrite its temporary boolean variables. -----*/
+    setup();
 
-        /* Determine alloc size as minimum of number of results and command-line parameter batch size, where 0 is
-         * interpreted as infinity. */
-        const Var<U32x1> alloc_size([&](){
-            U32x1 num_results = hi - lo;
-            U32x1 num_results_cpy = num_results.clone();
-            U32x1 batch_size = M.batch_size == 0 ? num_results.clone() : U32x1(M.batch_size);
-            U32x1 batch_size_cpy = batch_size.clone();
-            return Select(batch_size < num_results, batch_size_cpy, num_results_cpy);
-        }());
-        Ptr<U32x1> buffer_address = Module::Allocator().malloc<uint32_t>(alloc_size);
+    /*----- Create function to emit the body of the scan loop.  Loads the remaining attributes of the current tuple via
+     * point access iff it qualifies. -----*/
+    static Schema empty_schema;
+    auto emit_loop_body = [&](){
+        IF (CodeGenContext::Get().env().compile<_Boolx1>(M.filter.filter()).is_true_and_not_null()) {
+            compile_load_point_access(remaining_schema, empty_schema, base_address.clone(), table.layout(),
+                                      layout_schema, tuple_id);
+            pipeline();
+        };
+    };
 
-        /*----- Emit setup code *after* allocating memory to guarantee sequential memory allocation for pipeline. -----*/
-        setup();
+    if (options::scan_morsel_size) {
+        /*----- Register a morsel queue for this scan. -----*/
+        const std::size_t morsel_size = options::scan_morsel_size;
+        M_insist(std::in_range<uint32_t>(morsel_size), "morsel size must fit in uint32_t");
+        const auto queue_id = CodeGenContext::Get().add_morsel_queue(morsel_size);
+        auto claim_morsel = [queue_id, &num_rows](){
+            return Module::Get().emit_call<uint32_t>("next_morsel", U32x1(queue_id), num_rows.clone());
+        };
 
-        /*----- Emit loop code. -----*/
-        Var<U32x1> num_tuples_in_batch;
-        Var<Ptr<U32x1>> ptr;
-        WHILE (lo < hi) {
-            num_tuples_in_batch = Select(hi - lo > alloc_size, alloc_size, hi - lo);
-            /* Call host to fill buffer memory with next batch of tuple ids. */
-            Module::Get().emit_call<void>(
-                /* fn=           */ scan_fn,
-                /* index_id=     */ index_id,
-                /* entry_offset= */ lo.val(),
-                /* address=      */ buffer_address.clone(),
-                /* batch_size=   */ num_tuples_in_batch.val()
-            );
-            lo += num_tuples_in_batch;
-            ptr = buffer_address.clone();
-            WHILE(num_tuples_in_batch > 0U) {
-                static Schema empty_schema;
-                compile_load_point_access(
-                    /* tuple_value_schema=   */ M.scan.schema(),
-                    /* tuple_address_schema= */ empty_schema,
-                    /* base_address=         */ get_base_address(M.scan.store().table().name()),
-                    /* layout=               */ M.scan.store().table().layout(),
-                    /* layout_schema=        */ M.scan.store().table().schema(M.scan.alias()),
-                    /* tuple_id=             */ *ptr
-                );
-                pipeline();
-                num_tuples_in_batch -= 1U;
-                ptr += 1;
+        /*----- Generate the loop claiming morsels from the queue until the table is exhausted. -----*/
+        Var<U32x1> morsel_end;
+        tuple_id = claim_morsel();
+        WHILE (tuple_id < num_rows.clone()) {
+            break_on_pipeline_exit();
+            morsel_end = Select(num_rows.clone() - tuple_id > uint32_t(morsel_size),
+                                tuple_id + uint32_t(morsel_size), num_rows.clone());
+
+            /*----- Compile data layout to generate sequential load of the filter attributes from the morsel's first
+             * tuple on. -----*/
+            auto [inits, loads, jumps] = compile_load_sequential(filter_schema, empty_schema, base_address.clone(),
+                                                                 table.layout(), 1, layout_schema, tuple_id);
+
+            /*----- Generate the loop for the actual scan of the morsel. -----*/
+            inits.attach_to_current();
+            WHILE (tuple_id < morsel_end) {
+                break_on_pipeline_exit();
+                loads.attach_to_current();
+                emit_loop_body();
+                jumps.attach_to_current();
             }
-        }
-
-        /*----- Emit teardown code. -----*/
-        teardown();
 
-        /*----- Free buffer memory. -----*/
-        IF (alloc_size > U32x1(0)) { // only free if actually allocated
-            Module::Allocator().free(buffer_address, alloc_size);
-        };
-    } else if (options::index_scan_compilation_strategy == option_configs::IndexScanCompilationStrategy::EXPOSED_MEMORY) {
-        M_unreachable("not implemented yet");
+            tuple_id = claim_morsel();
+        }
     } else {
-        M_unreachable("unknown compilation stategy");
+        /*----- Compile data layout to generate sequential load of the filter attributes from table. -----*/
+        auto [inits, loads, jumps] = compile_load_sequential(filter_schema, empty_schema, base_address.clone(),
+                                                             table.layout(), 1, layout_schema, tuple_id);
+
+        /*----- Generate the loop for the actual scan. -----*/
+        inits.attach_to_current();
+        WHILE (tuple_id < num_rows.clone()) {
+            break_on_pipeline_exit();
+            loads.attach_to_current();
+            emit_loop_body();
+            jumps.attach_to_current();
+        }
     }
+    base_address.discard();
+    num_rows.discard();
+
+    /*----- Emit teardown code. -----*/
+    teardown();
 }
 
-template<idx::IndexMethod IndexMethod, typename Index>
-void index_scan_codegen_interpretation(const Index &index, const index_scan_bounds_t &bounds,
-                                       const Match<IndexScan<IndexMethod>> &M,
-                                       setup_t setup, pipeline_t pipeline, teardown_t teardown)
+/*======================================================================================================================
+ * Zone Map Scan
+ *====================================================================================================================*/
+
+///> helper struct holding a predicate of the form `attribute <cmp> constant` which can be decided on zone maps
+struct zone_map_predicate_t
 {
-    using key_type = Index::key_type;
+    std::reference_wrapper<const Attribute> attr; ///< the attribute, i.e. the left-hand side
+    TokenType cmp; ///< the comparison
+    std::variant<int64_t, double> bound; ///< the constant, i.e. the right-hand side, of the attribute's synopsis type
+};
 
-    static Schema empty_schema;
+/** Extracts all clauses of the filter condition of \p filter consisting of a single predicate of the form `attribute
+ * <cmp> constant` (or vice versa) on an attribute of \p scan for which the `PaxStore` maintains synopses. */
+std::vector<zone_map_predicate_t> extract_zone_map_predicates(const FilterOperator &filter, const ScanOperator &scan)
+{
+    std::vector<zone_map_predicate_t> predicates;
 
-    /*----- Interpret lo and hi bounds to retrieve index scan range -----*/
-    auto interpret_and_lookup_bound = [&](const ast::Expr &bound, bool is_lower_bound) -> std::size_t {
-        auto [constant, is_negative] = get_valid_bound(bound);
-        auto c = Interpreter::eval(constant);
-        key_type key;
-        if constexpr(m::boolean<key_type>) {
-            key = bool(c);
-            M_insist(not is_negative, "boolean cannot be negative");
-        } else if constexpr(m::integral<key_type>) {
-            auto i64 = int64_t(c);
-            M_insist(std::in_range<key_type>(i64), "integeral constant must be in range");
-            key = key_type(i64);
-            key = is_negative ? -key : key;
-        } else if constexpr(std::same_as<float, key_type>) {
-            auto d = double(c);
-            key = key_type(d);
-            M_insist(key == d, "downcasting should not impact precision");
-            key = is_negative ? -key : key;
-        } else if constexpr(std::same_as<double, key_type>) {
-            key = double(c);
-            key = is_negative ? -key : key;
-        } else if constexpr(std::same_as<const char*, key_type>) {
-            key = reinterpret_cast<const char*>(c.as_p());
-            M_insist(not is_negative, "string cannot be negative");
-        }
-        return std::distance(index.begin(), is_lower_bound ? index.lower_bound(key)
-                                                           : index.upper_bound(key));
-    };
-    std::size_t lo = bool(bounds.lo) ? interpret_and_lookup_bound(bounds.lo->get(), bounds.is_inclusive_lo)
-                                     : 0UL;
-    std::size_t hi = bool(bounds.hi) ? interpret_and_lookup_bound(bounds.hi->get(), not bounds.is_inclusive_hi)
-                                     : index.num_entries();
-    M_insist(lo <= hi, "bounds need to be valid");
+    auto pax = cast<const PaxStore>(&scan.store());
+    if (not pax)
+        return predicates;
+    auto &table = scan.store().table();
 
-    if (options::index_scan_materialization_strategy == option_configs::IndexScanMaterializationStrategy::MEMORY) {
-        /*----- Allocate sufficient memory for results. -----*/
-        uint32_t num_results = hi - lo;
-        uint32_t *buffer_address = Module::Allocator().raw_malloc<uint32_t>(num_results);
+    for (auto &clause : filter.filter()) {
+        if (clause.size() != 1 or clause[0].negative())
+            continue; // only single, non-negated predicates can be decided on zone maps
+        auto binary = cast<const BinaryExpr>(&clause[0].expr());
+        if (not binary)
+            continue;
+
+        /*----- Determine comparison with the attribute on the left-hand side. -----*/
+        TokenType cmp;
+        switch (binary->tok.type) {
+            default: continue; // unsupported comparison
+            case TK_EQUAL:         cmp = TK_EQUAL;         break;
+            case TK_LESS:          cmp = TK_LESS;          break;
+            case TK_LESS_EQUAL:    cmp = TK_LESS_EQUAL;    break;
+            case TK_GREATER:       cmp = TK_GREATER;       break;
+            case TK_GREATER_EQUAL: cmp = TK_GREATER_EQUAL; break;
+        }
+        const Designator *des;
+        const ast::Expr *bound;
+        if (is<const Designator>(binary->lhs) and is_valid_bound(*binary->rhs)) {
+            des = &as<const Designator>(*binary->lhs);
+            bound = binary->rhs.get();
+        } else if (is<const Designator>(binary->rhs) and is_valid_bound(*binary->lhs)) {
+            des = &as<const Designator>(*binary->rhs);
+            bound = binary->lhs.get();
+            switch (cmp) { // mirror comparison
+                default:               break;
+                case TK_LESS:          cmp = TK_GREATER;       break;
+                case TK_LESS_EQUAL:    cmp = TK_GREATER_EQUAL; break;
+                case TK_GREATER:       cmp = TK_LESS;          break;
+                case TK_GREATER_EQUAL: cmp = TK_LESS_EQUAL;    break;
+            }
+        } else {
+            continue;
+        }
 
-        /*----- Perform index scan and fill memory with results. -----*/
-        uint32_t *buffer_ptr = buffer_address;
-        for (auto it = index.begin() + lo; it != index.begin() + hi; ++it) {
-            M_insist(std::in_range<uint32_t>(it->second), "tuple id must fit in uint32_t");
-            *buffer_ptr = it->second;
-            ++buffer_ptr;
+        /*----- Check whether synopses are maintained for the attribute. -----*/
+        if (not scan.schema().has(Schema::Identifier(des->table_name.text, des->attr_name.text.assert_not_none())))
+            continue;
+        auto &attr = table[des->attr_name.text.assert_not_none()];
+        if (not pax->has_synopses(attr))
+            continue;
+
+        /*----- Interpret the bound as value of the attribute's synopsis type. -----*/
+        auto [constant, is_negative] = get_valid_bound(*bound);
+        auto &ty_attr = *attr.type;
+        auto &ty_bound = *constant.type();
+        auto c = Interpreter::eval(constant);
+        if (ty_attr.is_floating_point() and ty_bound.is_floating_point()) {
+            const double d = ty_bound.is_float() ? double(c.as_f()) : c.as_d();
+            predicates.push_back({ std::cref(attr), cmp, is_negative ? -d : d });
+        } else if ((ty_attr.is_integral() and ty_bound.is_integral()) or
+                   (ty_attr.is_date() and ty_bound.is_date()) or
+                   (ty_attr.is_date_time() and ty_bound.is_date_time()))
+        {
+            const int64_t i = c.as_i();
+            predicates.push_back({ std::cref(attr), cmp, is_negative ? -i : i });
         }
+    }
 
-        /*----- Emit setup code *after* allocating memory to guarantee sequential memory allocation for pipeline. -----*/
-        setup();
+    return predicates;
+}
 
-        /*----- Emit loop code. -----*/
-        Var<Ptr<U32x1>> ptr(buffer_address);
-        Ptr<U32x1> end(buffer_address + num_results);
-        WHILE(ptr < end) {
-            compile_load_point_access(
-                /* tuple_value_schema=   */ M.scan.schema(),
-                /* tuple_address_schema= */ empty_schema,
-                /* base_address=         */ get_base_address(M.scan.store().table().name()),
-                /* layout=               */ M.scan.store().table().layout(),
-                /* layout_schema=        */ M.scan.store().table().schema(M.scan.alias()),
-                /* tuple_id=             */ *ptr
-            );
-            pipeline();
-            ptr += 1;
+/** Returns `true` iff a PAX block summarized by \p synopsis may contain a value satisfying \p pred. */
+bool may_satisfy(const PaxStore::BlockSynopsis &synopsis, const zone_map_predicate_t &pred)
+{
+    if (std::holds_alternative<std::monostate>(synopsis.min))
+        return false; // block contains only NULL values which never satisfy the predicate
+    return std::visit([&]<typename T>(T bound) -> bool {
+        const T min = std::get<T>(synopsis.min);
+        const T max = std::get<T>(synopsis.max);
+        switch (pred.cmp) {
+            default: M_unreachable("invalid comparison");
+            case TK_EQUAL:         return min <= bound and bound <= max;
+            case TK_LESS:          return min < bound;
+            case TK_LESS_EQUAL:    return min <= bound;
+            case TK_GREATER:       return max > bound;
+            case TK_GREATER_EQUAL: return max >= bound;
         }
+    }, pred.bound);
+}
 
-        /*----- Emit teardown code. -----*/
-        teardown();
-    } else if (options::index_scan_materialization_strategy == option_configs::IndexScanMaterializationStrategy::INLINE) {
-        /*----- Define function that emits code for loading and executing pipeline for a single tuple. -----*/
-        FUNCTION(index_scan_parent_pipeline, void(uint32_t))
-        {
-            auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+/** Returns the partitions of the table scanned by \p scan, if it is partitioned, see `Partitionings`. */
+std::optional<Partitionings::Partitioning> get_partitioning(const ScanOperator &scan)
+{
+    Catalog &C = Catalog::Get();
+    if (not C.has_database_in_use())
+        return std::nullopt;
+    return Partitionings::Get().get(C.get_database_in_use().name, scan.store().table());
+}
 
-            /*----- Emit setup code. -----*/
-            setup();
+/** Returns `true` iff the table scanned by \p scan is partitioned and the filter condition of \p filter prunes some of
+ * its partitions. */
+bool prunes_partitions(const FilterOperator &filter, const ScanOperator &scan)
+{
+    auto partitioning = get_partitioning(scan);
+    if (not partitioning)
+        return false;
+    const auto remaining = Partitionings::Prune(*partitioning, scan.store().table(), filter.filter());
+    return std::find(remaining.cbegin(), remaining.cend(), false) != remaining.cend();
+}
 
-            /*----- Load tuple. ----- */
-            compile_load_point_access(
-                /* tuple_value_schema=   */ M.scan.schema(),
-                /* tuple_address_schema= */ empty_schema,
-                /* base_address=         */ get_base_address(M.scan.store().table().name()),
-                /* layout=               */ M.scan.store().table().layout(),
-                /* layout_schema=        */ M.scan.store().table().schema(M.scan.alias()),
-                /* tuple_id=             */ PARAMETER(0)
-            );
+/** Computes the ranges of row IDs of the partitions of the table scanned by \p scan which are not pruned by the filter
+ * condition of \p filter, if any.  Returns `std::nullopt` if the table is not partitioned. */
+std::optional<std::vector<std::pair<uint32_t, uint32_t>>> compute_partition_ranges(const FilterOperator *filter,
+                                                                                    const ScanOperator &scan)
+{
+    auto partitioning = get_partitioning(scan);
+    if (not partitioning)
+        return std::nullopt;
+    const auto remaining = filter ? Partitionings::Prune(*partitioning, scan.store().table(), filter->filter())
+                                  : std::vector<bool>(partitioning->ranges.size(), true);
+
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    for (std::size_t p = 0; p != partitioning->ranges.size(); ++p) {
+        auto [begin, end] = partitioning->ranges[p];
+        if (not remaining[p] or begin == end)
+            continue; // skip partition
+        if (not ranges.empty() and ranges.back().second == begin)
+            ranges.back().second = end; // extend previous range
+        else
+            ranges.emplace_back(begin, end);
+    }
+    return ranges;
+}
 
-            /*----- Emit pipeline code. -----*/
-            pipeline();
+/** Computes the ranges of row IDs of the table scanned by \p scan which may contain tuples satisfying the filter
+ * condition of \p filter.  Each range consists of consecutive PAX blocks not ruled out by their zone maps, if any, and
+ * lies within the partitions not pruned by the filter condition, if the table is partitioned. */
+std::vector<std::pair<uint32_t, uint32_t>> compute_zone_map_ranges(const FilterOperator &filter,
+                                                                    const ScanOperator &scan)
+{
+    const auto predicates = extract_zone_map_predicates(filter, scan);
+    const std::size_t num_rows = scan.store().num_rows();
+    M_insist(std::in_range<uint32_t>(num_rows), "number of rows must fit in uint32_t");
+
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    if (predicates.empty()) {
+        if (num_rows != 0)
+            ranges.emplace_back(0, num_rows);
+    } else {
+        auto &pax = as<const PaxStore>(scan.store());
+        const std::size_t num_rows_per_block = pax.num_rows_per_block();
+        for (std::size_t block = 0, num_blocks = (num_rows + num_rows_per_block - 1) / num_rows_per_block;
+             block != num_blocks; ++block)
+        {
+            const bool qualifies = std::all_of(predicates.cbegin(), predicates.cend(), [&](const auto &pred) {
+                return may_satisfy(pax.synopses(pred.attr.get())[block], pred);
+            });
+            if (not qualifies)
+                continue; // skip block
 
-            /*----- Emit teardown code. -----*/
-            teardown();
+            const uint32_t begin = block * num_rows_per_block;
+            const uint32_t end = std::min(num_rows, (block + 1) * num_rows_per_block);
+            if (not ranges.empty() and ranges.back().second == begin)
+                ranges.back().second = end; // extend previous range
+            else
+                ranges.emplace_back(begin, end);
         }
+    }
 
-        /*----- Perform index sequential scan, emit code to execute pipeline for each tuple. -----*/
-        for (auto it = index.begin() + lo; it != index.begin() + hi; ++it) {
-            M_insist(std::in_range<uint32_t>(it->second), "tuple id must fit in uint32_t");
-            index_scan_parent_pipeline(uint32_t(it->second));
+    /*----- Intersect the ranges with the ones of the partitions not pruned, both being ascending and disjoint. -----*/
+    if (auto partition_ranges = compute_partition_ranges(&filter, scan)) {
+        std::vector<std::pair<uint32_t, uint32_t>> intersection;
+        auto it = ranges.cbegin();
+        auto partition_it = partition_ranges->cbegin();
+        while (it != ranges.cend() and partition_it != partition_ranges->cend()) {
+            const uint32_t begin = std::max(it->first, partition_it->first);
+            const uint32_t end = std::min(it->second, partition_it->second);
+            if (begin < end)
+                intersection.emplace_back(begin, end);
+            if (it->second < partition_it->second)
+                ++it;
+            else
+                ++partition_it;
         }
-    } else {
-        M_unreachable("unknown materialization strategy");
+        ranges = std::move(intersection);
     }
+
+    return ranges;
 }
 
-template<idx::IndexMethod IndexMethod, typename Index, sql_type SqlT>
-void index_scan_codegen_hybrid(const Index &index, const index_scan_bounds_t &bounds,
-                               const Match<IndexScan<IndexMethod>> &M,
-                               setup_t setup, pipeline_t pipeline, teardown_t teardown)
+ConditionSet ZoneMapScan::pre_condition(
+    std::size_t child_idx,
+    const std::tuple<const FilterOperator*, const ScanOperator*> &partial_inner_nodes)
 {
-    using key_type = Index::key_type;
-    using sql_type = SqlT;
+    M_insist(child_idx == 0);
 
-    /*----- Resolve callback function name. -----*/
-    const char *scan_fn;
-#define SET_CALLBACK_FNS(INDEX, KEY) \
-    scan_fn = M_STR(idx_scan_##INDEX##_##KEY)
+    auto &filter = *std::get<0>(partial_inner_nodes);
+    auto &scan = *std::get<1>(partial_inner_nodes);
 
-#define RESOLVE_KEYTYPE(INDEX) \
-    if constexpr(std::same_as<SqlT, _Boolx1>) { \
-        SET_CALLBACK_FNS(INDEX, b); \
-    } else if constexpr(std::same_as<sql_type, _I8x1>) { \
-        SET_CALLBACK_FNS(INDEX, i1); \
-    } else if constexpr(std::same_as<sql_type, _I16x1>) { \
-        SET_CALLBACK_FNS(INDEX, i2); \
-    } else if constexpr(std::same_as<sql_type, _I32x1>) { \
-        SET_CALLBACK_FNS(INDEX, i4); \
-    } else if constexpr(std::same_as<sql_type, _I64x1>) { \
-        SET_CALLBACK_FNS(INDEX, i8); \
-    } else if constexpr(std::same_as<sql_type, _Floatx1>) { \
-        SET_CALLBACK_FNS(INDEX, f); \
-    } else if constexpr(std::same_as<sql_type, _Doublex1>) { \
-        SET_CALLBACK_FNS(INDEX, d); \
-    } else if constexpr(std::same_as<sql_type, NChar>) { \
-        SET_CALLBACK_FNS(IDNEX, p); \
-    } else { \
-        M_unreachable("incompatible SQL type"); \
+    /*----- Zone map scan needs a `PaxStore` maintaining synopses for some predicate of the filter condition or a
+     * partitioned table of which the filter condition prunes some partitions. -----*/
+    if (extract_zone_map_predicates(filter, scan).empty() and not prunes_partitions(filter, scan))
+        return ConditionSet::Make_Unsatisfiable();
+
+    ConditionSet pre_cond;
+
+    return pre_cond;
+}
+
+double ZoneMapScan::cost(const Match<ZoneMapScan> &M)
+{
+    /*----- Relate the number of rows to load to the ones of a non-SIMDfied `wasm::Scan`. -----*/
+    const auto ranges = compute_zone_map_ranges(M.filter, M.scan);
+    const uint64_t num_rows_loaded = std::accumulate(ranges.cbegin(), ranges.cend(), uint64_t(0),
+                                                     [](uint64_t sum, const auto &range) {
+        return sum + (range.second - range.first);
+    });
+    const double scan_cost = M.scan.store().num_rows() ? OperatorCalibration::Get().coefficients().scan_scalar *
+                                                         num_rows_loaded / M.scan.store().num_rows()
+                                                       : 0.0;
+
+    /*----- Add cost of evaluating the filter condition as for `wasm::Filter`. -----*/
+    const cnf::CNF &cond = M.filter.filter();
+    const unsigned filter_cost = std::accumulate(cond.cbegin(), cond.cend(), 0U, [](unsigned cost, const cnf::Clause &clause) {
+        return cost + clause.size();
+    });
+
+    return scan_cost + filter_cost;
+}
+
+ConditionSet ZoneMapScan::post_condition(const Match<ZoneMapScan> &M)
+{
+    ConditionSet post_cond;
+
+    /*----- Zone map scan does not introduce predication. -----*/
+    post_cond.add_condition(Predicated(false));
+
+    /*----- Zone map scan does not introduce SIMD. -----*/
+    post_cond.add_condition(NoSIMD());
+
+    /*----- Check if any attribute of scanned table is sorted. -----*/
+    add_scan_sortedness(post_cond, M.scan);
+
+    return post_cond;
+}
+
+void ZoneMapScan::execute(const Match<ZoneMapScan> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    auto &schema = M.scan.schema();
+    auto &table = M.scan.store().table();
+
+    M_insist(schema == schema.drop_constants().deduplicate(), "schema of `ScanOperator` must not contain NULL or duplicates");
+    M_insist(not table.layout().is_finite(), "layout for `wasm::ZoneMapScan` must be infinite");
+
+    /*----- Zone map scan does not support SIMD. -----*/
+    const auto layout_schema = scan_layout_schema(M.scan);
+    CodeGenContext::Get().set_num_simd_lanes(1);
+
+    /*----- Zone map scans evaluate the filter constants at compile time, which may be bound late, hence the module
+     * must not be reused for later executions. -----*/
+    CodeGenContext::Get().mark_module_not_reusable();
+
+    /*----- Compute the row ranges not ruled out by the zone maps and write them into memory. -----*/
+    const auto ranges = compute_zone_map_ranges(M.filter, M.scan);
+    if (ranges.empty()) { // no tuple can satisfy the filter condition
+        setup();
+        teardown();
+        return;
     }
-    if constexpr(is_specialization<Index, idx::ArrayIndex>) {
-        RESOLVE_KEYTYPE(array)
-    } else if constexpr(is_specialization<Index, idx::RecursiveModelIndex>) {
-        RESOLVE_KEYTYPE(rmi)
-    } else {
-        M_unreachable("unknown index type");
+    uint32_t *ranges_address = Module::Allocator().raw_malloc<uint32_t>(2 * ranges.size());
+    for (std::size_t i = 0; i != ranges.size(); ++i) {
+        ranges_address[2 * i]     = ranges[i].first;
+        ranges_address[2 * i + 1] = ranges[i].second;
     }
-#undef RESOLVE_KEYTYPE
-#undef SET_CALLBACK_FNS
 
-    /*----- Add index to context. -----*/
-    auto &context = WasmEngine::Get_Wasm_Context_By_ID(Module::ID());
-    U64x1 index_id(context.add_index(index)); ///< id of index in context
+    /*----- Import the base address of the mapped memory. -----*/
+    Ptr<void> base_address = get_base_address(table.name());
 
-    /*----- Interpret lo and hi bounds to retrieve index scan range -----*/
-    auto interpret_and_lookup_bound = [&](const ast::Expr &bound, bool is_lower_bound) -> std::size_t {
-        auto [constant, is_negative] = get_valid_bound(bound);
-        auto c = Interpreter::eval(constant);
-        key_type key;
-        if constexpr(m::boolean<key_type>) {
-            key = bool(c);
-            M_insist(not is_negative, "boolean cannot be negative");
-        } else if constexpr(m::integral<key_type>) {
-            auto i64 = int64_t(c);
-            M_insist(std::in_range<key_type>(i64), "integeral constant must be in range");
-            key = key_type(i64);
-            key = is_negative ? -key : key;
-        } else if constexpr(std::same_as<float, key_type>) {
-            auto d = double(c);
-            key = key_type(d);
-            M_insist(key == d, "downcasting should not impact precision");
-            key = is_negative ? -key : key;
-        } else if constexpr(std::same_as<double, key_type>) {
-            key = double(c);
-            key = is_negative ? -key : key;
-        } else if constexpr(std::same_as<const char*, key_type>) {
-            key = reinterpret_cast<const char*>(c.as_p());
-            M_insist(not is_negative, "string cannot be negative");
-        }
-        return std::distance(index.begin(), is_lower_bound ? index.lower_bound(key)
-                                                           : index.upper_bound(key));
-    };
-    std::size_t lo = bool(bounds.lo) ? interpret_and_lookup_bound(bounds.lo->get(), bounds.is_inclusive_lo)
-                                     : 0UL;
-    std::size_t hi = bool(bounds.hi) ? interpret_and_lookup_bound(bounds.hi->get(), not bounds.is_inclusive_hi)
-                                     : index.num_entries();
-    M_insist(lo <= hi, "bounds need to be valid");
-    M_insist(std::in_range<uint32_t>(lo), "should fit in uint32_t");
-    M_insist(std::in_range<uint32_t>(hi), "should fit in uint32_t");
+    /*----- Emit setup code *after* allocating memory and *before* compiling data layout to not overwrite its temporary
+     * boolean variables. -----*/
+    setup();
 
-    /*----- Materialize offsets hi and lo. -----*/
-    Var<U32x1> begin;
-    std::optional<U32x1> end;
-    if (options::index_scan_materialization_strategy == option_configs::IndexScanMaterializationStrategy::INLINE) {
-        begin = U32x1(lo);
-        end.emplace(hi);
-    } else if (options::index_scan_materialization_strategy == option_configs::IndexScanMaterializationStrategy::MEMORY) {
-        /* If we materialize before allocating buffer memory, the addresses are independent of the buffer size.  As a
-         * result, queries that only differ in the filter predicate are compiled to the exact same WebAssembly code,
-         * enabling caching of compiled plans in V8. */
-        uint32_t *offset_address = Module::Allocator().raw_malloc<uint32_t>(2);
-        offset_address[0] = uint32_t(lo);
-        offset_address[1] = uint32_t(hi);
+    /*----- Generate the loop over all ranges. -----*/
+    static Schema empty_schema;
+    Var<U32x1> tuple_id;
+    Var<U32x1> range_end;
+    Var<Ptr<U32x1>> range(ranges_address);
+    const Var<Ptr<U32x1>> ranges_end(Ptr<U32x1>(ranges_address + 2 * ranges.size()));
+    WHILE (range < ranges_end) {
+        break_on_pipeline_exit();
+        tuple_id = *range;
+        range_end = *(range + 1);
+
+        /*----- Compile data layout to generate sequential load from the range's first tuple on. -----*/
+        auto [inits, loads, jumps] = compile_load_sequential(schema, empty_schema, base_address.clone(),
+                                                             table.layout(), 1, layout_schema, tuple_id);
+
+        /*----- Generate the loop for the actual scan of the range, with the filter and the pipeline emitted into the
+         * loop body. -----*/
+        inits.attach_to_current();
+        WHILE (tuple_id < range_end) {
+            break_on_pipeline_exit();
+            loads.attach_to_current();
+            IF (CodeGenContext::Get().env().compile<_Boolx1>(M.filter.filter()).is_true_and_not_null()) {
+                pipeline();
+            };
+            jumps.attach_to_current();
+        }
 
-        Ptr<U32x1> offset_ptr(offset_address);
-        begin = *offset_ptr.clone();
-        end.emplace(*(offset_ptr + 1));
-    } else {
-        M_unreachable("unknown materialization strategy");
+        range += 2;
     }
-    M_insist(bool(end), "end must be set");
+    base_address.discard();
 
-    if (options::index_scan_compilation_strategy == option_configs::IndexScanCompilationStrategy::CALLBACK) {
-        /*----- Allocate buffer memory for communication to host. -----*/
-        M_insist(std::in_range<uint32_t>(M.batch_size), "should fit in uint32_t");
-
-        /* Determine alloc size as minimum of number of results and command-line parameter batch size, where 0 is
-         * interpreted as infinity. */
-        const Var<U32x1> alloc_size([&](){
-            U32x1 num_results = end->clone() - begin;
-            U32x1 num_results_cpy = num_results.clone();
-            U32x1 batch_size = M.batch_size == 0 ? num_results.clone() : U32x1(M.batch_size);
-            U32x1 batch_size_cpy = batch_size.clone();
-            return Select(batch_size < num_results, batch_size_cpy, num_results_cpy);
-        }());
-        Ptr<U32x1> buffer_address = Module::Allocator().malloc<uint32_t>(alloc_size);
+    /*----- Emit teardown code. -----*/
+    teardown();
+}
 
-        /*----- Emit setup code *after* allocating memory to guarantee sequential memory allocation for pipeline. -----*/
-        setup();
+/*======================================================================================================================
+ * Selection Vector Scan
+ *====================================================================================================================*/
 
-        /*----- Emit loop code. -----*/
-        Var<U32x1> num_tuples_in_batch;
-        Var<Ptr<U32x1>> ptr;
-        WHILE (begin < end->clone()) {
-            auto end_cpy = end->clone();
-            num_tuples_in_batch = Select(*end - begin > alloc_size, alloc_size, end_cpy - begin);
-            /* Call host to fill buffer memory with next batch of tuple ids. */
-            Module::Get().emit_call<void>(
-                /* fn=           */ scan_fn,
-                /* index_id=     */ index_id,
-                /* entry_offset= */ begin.val(),
-                /* address=      */ buffer_address.clone(),
-                /* batch_size=   */ num_tuples_in_batch.val()
-            );
-            begin += num_tuples_in_batch;
-            ptr = buffer_address.clone();
-            WHILE(num_tuples_in_batch > 0U) {
-                static Schema empty_schema;
-                compile_load_point_access(
-                    /* tuple_value_schema=   */ M.scan.schema(),
-                    /* tuple_address_schema= */ empty_schema,
-                    /* base_address=         */ get_base_address(M.scan.store().table().name()),
-                    /* layout=               */ M.scan.store().table().layout(),
-                    /* layout_schema=        */ M.scan.store().table().schema(M.scan.alias()),
-                    /* tuple_id=             */ *ptr
-                );
-                pipeline();
-                num_tuples_in_batch -= 1U;
-                ptr += 1;
-            }
-        }
+ConditionSet SelectionVectorScan::pre_condition(
+    std::size_t child_idx,
+    const std::tuple<const FilterOperator*, const ScanOperator*> &partial_inner_nodes)
+{
+    M_insist(child_idx == 0);
 
-        /*----- Emit teardown code. -----*/
-        teardown();
+    auto &filter = *std::get<0>(partial_inner_nodes);
 
-        /*----- Free buffer memory. -----*/
-        IF (alloc_size > U32x1(0)) { // only free if actually allocated
-            Module::Allocator().free(buffer_address, alloc_size);
-        };
-    } else if (options::index_scan_compilation_strategy == option_configs::IndexScanCompilationStrategy::EXPOSED_MEMORY) {
-        M_unreachable("not implemented yet");
-    } else {
-        M_unreachable("unknwon compilation strategy");
-    }
-}
+    /*----- Evaluating the filter clause by clause is only reasonable if it consists of multiple clauses. -----*/
+    if (filter.filter().size() < 2)
+        return ConditionSet::Make_Unsatisfiable();
 
-/** Resolves the index scan strategy and calls the appropriate codegen function. */
-template<idx::IndexMethod IndexMethod, typename Index, sql_type SqlT>
-void index_scan_resolve_strategy(const Index &index, const index_scan_bounds_t &bounds, const Match<IndexScan<IndexMethod>> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
-{
-    if (options::index_scan_strategy == option_configs::IndexScanStrategy::COMPILATION) {
-        index_scan_codegen_compilation<IndexMethod, Index, SqlT>(index, bounds, M, std::move(setup), std::move(pipeline), std::move(teardown));
-    } else if (options::index_scan_strategy == option_configs::IndexScanStrategy::INTERPRETATION) {
-        index_scan_codegen_interpretation<IndexMethod, Index>(index, bounds, M, std::move(setup), std::move(pipeline), std::move(teardown));
-    } else if (options::index_scan_strategy == option_configs::IndexScanStrategy::HYBRID) {
-        index_scan_codegen_hybrid<IndexMethod, Index, SqlT>(index, bounds, M, std::move(setup), std::move(pipeline), std::move(teardown));
-    } else {
-        M_unreachable("invalid index access strategy");
-    }
+    ConditionSet pre_cond;
+
+    return pre_cond;
 }
 
-/** Resolves the index method and calls the appropriate codegen function. */
-template<idx::IndexMethod IndexMethod, typename AttrT, sql_type SqlT>
-void index_scan_resolve_index_method(const index_scan_bounds_t &bounds, const Match<IndexScan<IndexMethod>> &M,
-                                     setup_t setup, pipeline_t pipeline, teardown_t teardown)
+double SelectionVectorScan::cost(const Match<SelectionVectorScan> &M)
 {
-    /*----- Lookup index. -----*/
-    Catalog &C = Catalog::Get();
-    auto &DB = C.get_database_in_use();
-    auto &table_name = M.scan.store().table().name();
-    auto &attribute_name = bounds.attribute.id.name;
-    auto &index_base = DB.get_index(table_name, attribute_name, IndexMethod);
-
-    /*----- Resolve index type. -----*/
-    if constexpr(IndexMethod == idx::IndexMethod::Array and requires { typename idx::ArrayIndex<AttrT>; }) {
-        auto &index = as<const idx::ArrayIndex<AttrT>>(index_base);
-        index_scan_resolve_strategy<IndexMethod, const idx::ArrayIndex<AttrT>, SqlT>(
-            index, bounds, M, std::move(setup), std::move(pipeline), std::move(teardown)
-        );
-    } else if constexpr(IndexMethod == idx::IndexMethod::Rmi and requires { typename idx::RecursiveModelIndex<AttrT>; }) {
-        auto &index = as<const idx::RecursiveModelIndex<AttrT>>(index_base);
-        index_scan_resolve_strategy<IndexMethod, const idx::RecursiveModelIndex<AttrT>, SqlT>(
-            index, bounds, M, std::move(setup), std::move(pipeline), std::move(teardown)
-        );
-    } else {
-        M_unreachable("invalid index method");
+    /*----- Estimate the selectivity of the filter, assuming that all tuples qualify if no estimate exists.  The clauses
+     * are assumed to be independent and equally selective. -----*/
+    double selectivity = 1.0;
+    if (M.filter.has_info() and M.scan.store().num_rows() != 0)
+        selectivity = std::min(1.0, M.filter.info().estimated_cardinality / double(M.scan.store().num_rows()));
+    const cnf::CNF &cond = M.filter.filter();
+    const double clause_selectivity = std::pow(selectivity, 1.0 / cond.size());
+
+    /*----- Each clause is evaluated, and its attributes are loaded, only for the tuples satisfying all previous
+     * clauses.  Relate the amount of loaded attributes to the ones of a non-SIMDfied `wasm::Scan`.  As for
+     * `wasm::LateMaterializingScan`, point accesses are penalized since they are random instead of sequential. -----*/
+    double num_loads = 0.0;
+    double filter_cost = 0.0;
+    double fraction = 1.0; ///< the fraction of tuples evaluated by the current clause
+    for (auto &clause : cond) {
+        const auto clause_schema = split_late_materialization_schema(M.scan, cnf::CNF({ clause })).first;
+        num_loads += 2.0 * fraction * clause_schema.num_entries();
+        filter_cost += fraction * clause.size();
+        fraction *= clause_selectivity;
     }
+    num_loads += 2.0 * selectivity * M.scan.schema().num_entries();
+    const double scan_cost =
+        OperatorCalibration::Get().coefficients().scan_scalar * num_loads / M.scan.schema().num_entries();
+
+    return scan_cost + filter_cost;
 }
 
-/** Resolves the attribute type and calls the appropriate codegen function. */
-template<idx::IndexMethod IndexMethod>
-void index_scan_resolve_attribute_type(const Match<IndexScan<IndexMethod>> &M,
-                                       setup_t setup, pipeline_t pipeline, teardown_t teardown)
+ConditionSet SelectionVectorScan::post_condition(const Match<SelectionVectorScan> &M)
 {
-    /*----- Extract bounds from CNF. -----*/
-    auto &cnf = M.filter.filter();
-    auto bounds = extract_index_scan_bounds(cnf);
+    ConditionSet post_cond;
 
-    /*----- Resolve attribute type. -----*/
-#define RESOLVE_INDEX_METHOD(ATTRTYPE, SQLTYPE) \
-    index_scan_resolve_index_method<IndexMethod, ATTRTYPE, SQLTYPE>(bounds, M, std::move(setup), std::move(pipeline), std::move(teardown))
+    /*----- Selection vector scan does not introduce predication. -----*/
+    post_cond.add_condition(Predicated(false));
 
-    visit(overloaded {
-        [&](const Boolean&) { RESOLVE_INDEX_METHOD(bool, _Boolx1); },
-        [&](const Numeric &n) {
-            switch (n.kind) {
-                case Numeric::N_Int:
-                case Numeric::N_Decimal:
-                    switch (n.size()) {
-                        default: M_unreachable("invalid size");
-                        case  8: RESOLVE_INDEX_METHOD(int8_t,   _I8x1); break;
-                        case 16: RESOLVE_INDEX_METHOD(int16_t, _I16x1); break;
-                        case 32: RESOLVE_INDEX_METHOD(int32_t, _I32x1); break;
-                        case 64: RESOLVE_INDEX_METHOD(int64_t, _I64x1); break;
-                    }
-                    break;
-                case Numeric::N_Float:
-                    switch (n.size()) {
-                        default: M_unreachable("invalid size");
-                        case 32: RESOLVE_INDEX_METHOD(float,   _Floatx1); break;
-                        case 64: RESOLVE_INDEX_METHOD(double, _Doublex1); break;
-                    }
-                    break;
-            }
-        },
-        [&](const CharacterSequence&) { RESOLVE_INDEX_METHOD(const char*, NChar); },
-        [&](const Date&) { RESOLVE_INDEX_METHOD(int32_t, _I32x1); },
-        [&](const DateTime&) { RESOLVE_INDEX_METHOD(int64_t, _I64x1); },
-        [](auto&&) { M_unreachable("invalid type"); },
-    }, *bounds.attribute.type);
+    /*----- Selection vector scan does not introduce SIMD. -----*/
+    post_cond.add_condition(NoSIMD());
 
-#undef RESOLVE_INDEX_METHOD
+    /*----- Check if any attribute of scanned table is sorted since qualifying tuples are emitted in order. -----*/
+    add_scan_sortedness(post_cond, M.scan);
+
+    return post_cond;
 }
 
-template<idx::IndexMethod IndexMethod>
-void IndexScan<IndexMethod>::execute(const Match<IndexScan<IndexMethod>> &M,
-                                     setup_t setup, pipeline_t pipeline, teardown_t teardown)
+void SelectionVectorScan::execute(const Match<SelectionVectorScan> &M, setup_t setup, pipeline_t pipeline,
+                                  teardown_t teardown)
 {
     auto &schema = M.scan.schema();
-    M_insist(schema == schema.drop_constants().deduplicate(), "Schema of `ScanOperator` must neither contain NULL nor duplicates");
-
     auto &table = M.scan.store().table();
-    M_insist(not table.layout().is_finite(), "layout for `wasm::IndexScan` must be infinite");
 
-    /** Generating code for an index scan requires resolving the following:
-     * 1. attribute type of the indexed attribute,
-     * 2. index method of the index used by the operator,
-     * 3. strategy used for performing the index scan.
-     * We avoid code duplication by handling each step in a separate function and forwarding the result via template
-     * arguments to the next function. */
-    index_scan_resolve_attribute_type(M, std::move(setup), std::move(pipeline), std::move(teardown));
-}
+    M_insist(schema == schema.drop_constants().deduplicate(), "schema of `ScanOperator` must not contain NULL or duplicates");
+    M_insist(not table.layout().is_finite(), "layout for `wasm::SelectionVectorScan` must be infinite");
+    M_insist(std::in_range<uint32_t>(M.vector_size) and M.vector_size > 0, "invalid vector size");
+
+    const uint32_t vector_size = M.vector_size;
+    const uint32_t num_clauses = M.filter.filter().size();
+
+    /*----- Split the filter condition into its clauses, each with the attributes it requires. -----*/
+    std::vector<cnf::CNF> clauses;
+    std::vector<Schema> clause_schemas;
+    for (auto &clause : M.filter.filter()) {
+        clauses.emplace_back(cnf::CNF({ clause }));
+        clause_schemas.emplace_back(split_late_materialization_schema(M.scan, clauses.back()).first);
+    }
 
+    /*----- Selection vector scan does not support SIMD. -----*/
+    const auto layout_schema = scan_layout_schema(M.scan);
+    CodeGenContext::Get().set_num_simd_lanes(1);
 
-/*======================================================================================================================
- * Filter
- *====================================================================================================================*/
+    /*----- Import the number of rows of `table` and the base address of the mapped memory. -----*/
+    const Var<U32x1> num_rows(get_num_rows(table.name()));
+    const Var<Ptr<void>> base_address(get_base_address(table.name()));
 
-template<bool Predicated>
-ConditionSet Filter<Predicated>::pre_condition(std::size_t child_idx, const std::tuple<const FilterOperator*>&)
-{
-     M_insist(child_idx == 0);
+    /*----- Allocate the selection vector, the current order of the clauses, and the observed selectivity of each
+     * clause. -----*/
+    Var<Ptr<U32x1>> selection(Module::Allocator().pre_malloc<uint32_t>(vector_size));
+    Var<Ptr<U32x1>> order(Module::Allocator().pre_malloc<uint32_t>(num_clauses));
+    Var<Ptr<Doublex1>> selectivities(Module::Allocator().pre_malloc<double>(num_clauses));
+    auto at = [](auto &ptr, U32x1 idx) { return *(ptr.val() + idx.make_signed()); };
 
-    ConditionSet pre_cond;
+    /*----- Emit setup code *before* compiling data layout to not overwrite its temporary boolean variables. -----*/
+    setup();
 
-    if constexpr (not Predicated) {
-        /*----- Branching filter does not support SIMD. -----*/
-        pre_cond.add_condition(NoSIMD());
+    /*----- Start with the clauses in the order of the filter condition. -----*/
+    for (uint32_t j = 0; j != num_clauses; ++j) {
+        at(order, U32x1(j)) = j;
+        at(selectivities, U32x1(j)) = 1.0;
     }
 
-    return pre_cond;
-}
+    /*----- Create function to filter the tuples with IDs in [begin, end) and to resume the pipeline for each qualifying
+     * one. -----*/
+    static Schema empty_schema;
+    auto emit_vector = [&](const Var<U32x1> &begin, const Var<U32x1> &end){
+        /*----- Initially, all tuples of the vector are selected. -----*/
+        Var<U32x1> num_selected(end - begin);
+        Var<U32x1> i(0U);
+        WHILE (i < num_selected) {
+            at(selection, i) = begin + i;
+            i += 1U;
+        }
 
-template<bool Predicated>
-ConditionSet Filter<Predicated>::adapt_post_condition(const Match<Filter>&, const ConditionSet &post_cond_child)
-{
-    ConditionSet post_cond(post_cond_child);
+        /*----- Evaluate the clauses in their current order, each on the selected tuples only, and compact the
+         * selection vector to the tuples satisfying the clause without branching. -----*/
+        Var<U32x1> pos(0U);
+        WHILE (pos < num_clauses and num_selected != 0U) {
+            const Var<U32x1> clause(U32x1(at(order, pos)));
+            for (uint32_t j = 0; j != num_clauses; ++j) {
+                IF (clause == j) {
+                    Var<U32x1> num_passed(0U);
+                    i = 0U;
+                    WHILE (i < num_selected) {
+                        auto S = CodeGenContext::Get().scoped_environment();
+                        const Var<U32x1> tuple_id(U32x1(at(selection, i)));
+                        compile_load_point_access(clause_schemas[j], empty_schema, base_address.val(),
+                                                  table.layout(), layout_schema, tuple_id.val());
+                        const Var<Boolx1> passed(
+                            CodeGenContext::Get().env().compile<_Boolx1>(clauses[j]).is_true_and_not_null()
+                        );
+                        at(selection, num_passed) = tuple_id.val();
+                        num_passed += passed.to<uint32_t>();
+                        i += 1U;
+                    }
 
-    if constexpr (Predicated) {
-        /*----- Predicated filter introduces predication. -----*/
-        post_cond.add_or_replace_condition(m::Predicated(true));
+                    /*----- Update the observed selectivity of the clause, giving recent vectors more weight. -----*/
+                    at(selectivities, clause) = Doublex1(at(selectivities, clause)) * 0.5 +
+                        num_passed.to<double>() / num_selected.to<double>() * 0.5;
+                    num_selected = num_passed;
+                };
+            }
+            pos += 1U;
+        }
+
+        /*----- Swap adjacent clauses if the latter one is more selective.  Thereby, the order converges to ascending
+         * observed selectivities over the vectors. -----*/
+        pos = 1U;
+        WHILE (pos < num_clauses) {
+            const Var<U32x1> prev(U32x1(at(order, pos - 1U)));
+            const Var<U32x1> curr(U32x1(at(order, pos)));
+            IF (Doublex1(at(selectivities, curr)) < Doublex1(at(selectivities, prev))) {
+                at(order, pos - 1U) = curr.val();
+                at(order, pos) = prev.val();
+            };
+            pos += 1U;
+        }
+
+        /*----- Load all attributes of each qualifying tuple via point access and resume the pipeline. -----*/
+        i = 0U;
+        WHILE (i < num_selected) {
+            break_on_pipeline_exit();
+            const Var<U32x1> tuple_id(U32x1(at(selection, i)));
+            i += 1U;
+            compile_load_point_access(schema, empty_schema, base_address.val(), table.layout(), layout_schema,
+                                      tuple_id.val());
+            pipeline();
+        }
+    };
+
+    Var<U32x1> begin; // default initialized to 0
+    Var<U32x1> end;
+    if (options::scan_morsel_size) {
+        /*----- Register a morsel queue for this scan. -----*/
+        const std::size_t morsel_size = options::scan_morsel_size;
+        M_insist(std::in_range<uint32_t>(morsel_size), "morsel size must fit in uint32_t");
+        const auto queue_id = CodeGenContext::Get().add_morsel_queue(morsel_size);
+        auto claim_morsel = [queue_id, &num_rows](){
+            return Module::Get().emit_call<uint32_t>("next_morsel", U32x1(queue_id), num_rows.val());
+        };
+
+        /*----- Generate the loop claiming morsels from the queue until the table is exhausted, splitting each morsel
+         * into vectors. -----*/
+        Var<U32x1> morsel_end;
+        begin = claim_morsel();
+        WHILE (begin < num_rows) {
+            break_on_pipeline_exit();
+            morsel_end = Select(num_rows - begin > uint32_t(morsel_size), begin + uint32_t(morsel_size),
+                                num_rows.val());
+            WHILE (begin < morsel_end) {
+                end = Select(morsel_end - begin > vector_size, begin + vector_size, morsel_end.val());
+                emit_vector(begin, end);
+                begin = end;
+            }
+            begin = claim_morsel();
+        }
+    } else {
+        /*----- Generate the loop for the actual scan, splitting the table into vectors. -----*/
+        WHILE (begin < num_rows) {
+            break_on_pipeline_exit();
+            end = Select(num_rows - begin > vector_size, begin + vector_size, num_rows.val());
+            emit_vector(begin, end);
+            begin = end;
+        }
     }
 
-    return post_cond;
-}
-
-template<bool Predicated>
-double Filter<Predicated>::cost(const Match<Filter> &M)
-{
-    const cnf::CNF &cond = M.filter.filter();
-    const unsigned cost = std::accumulate(cond.cbegin(), cond.cend(), 0U, [](unsigned cost, const cnf::Clause &clause) {
-        return cost + clause.size();
-    });
-    return cost;
-}
-
-template<bool Predicated>
-void Filter<Predicated>::execute(const Match<Filter> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
-{
-    /*----- Set minimal number of SIMD lanes preferred to get fully utilized SIMD vectors for the filter condition. --*/
-    CodeGenContext::Get().update_num_simd_lanes_preferred(16); // set own preference
-
-    /*----- Execute filter. -----*/
-    M.child->execute(
-        /* setup=    */ std::move(setup),
-        /* pipeline= */ [&, pipeline=std::move(pipeline)](){
-            if constexpr (Predicated) {
-                CodeGenContext::Get().env().add_predicate(M.filter.filter());
-                pipeline();
-            } else {
-                M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes");
-                IF (CodeGenContext::Get().env().compile<_Boolx1>(M.filter.filter()).is_true_and_not_null()) {
-                    pipeline();
-                };
-            }
-        },
-        /* teardown= */ std::move(teardown)
-    );
+    /*----- Emit teardown code. -----*/
+    teardown();
 }
 
 
 /*======================================================================================================================
- * LazyDisjunctiveFilter
+ * Index Scan
  *====================================================================================================================*/
 
-ConditionSet LazyDisjunctiveFilter::pre_condition(std::size_t child_idx, const std::tuple<const FilterOperator*>&)
+template<idx::IndexMethod IndexMethod>
+ConditionSet IndexScan<IndexMethod>::pre_condition(std::size_t child_idx,
+                                                   const std::tuple<const FilterOperator*,
+                                                   const ScanOperator*> &partial_inner_nodes)
 {
-     M_insist(child_idx == 0);
+    M_insist(child_idx == 0);
 
-    ConditionSet pre_cond;
+    /*----- Check if index on one of the attributes in filter condition exists. -----*/
+    auto &filter = *std::get<0>(partial_inner_nodes);
+    auto &cnf = filter.filter();
 
-    /*----- Lazy disjunctive filter does not support SIMD. -----*/
-    pre_cond.add_condition(NoSIMD());
+    M_insist(not cnf.empty(), "Filter condition must not be empty");
 
-    return pre_cond;
-}
+    auto &scan = *std::get<1>(partial_inner_nodes);
+    auto &table = scan.store().table();
 
-double LazyDisjunctiveFilter::cost(const Match<LazyDisjunctiveFilter> &M)
-{
-    const cnf::CNF &cond = M.filter.filter();
-    M_insist(cond.size() == 1, "disjunctive filter condition must be a single clause");
-    return cond[0].size() / 2.0; // on avg. half the number of predicates in the clause XXX consider selectivities
-}
+    Catalog &C = Catalog::Get();
+    auto &DB = C.get_database_in_use();
 
-void LazyDisjunctiveFilter::execute(const Match<LazyDisjunctiveFilter> &M, setup_t setup, pipeline_t pipeline,
-                                    teardown_t teardown)
-{
-    const cnf::Clause &clause = M.filter.filter()[0];
+    /* Extract attributes from filter condition. */
+    std::vector<Schema::Identifier> ids;
+    for (auto &entry : cnf.get_required()) {
+        Schema::Identifier &id = entry.id;
+        M_insist(table.name() == id.prefix, "Table name should match designator table name");
 
-    M.child->execute(
-        /* setup=    */ std::move(setup),
-        /* pipeline= */ [&, pipeline=std::move(pipeline)](){
-            M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes");
-            BLOCK(lazy_disjunctive_filter)
-            {
-                BLOCK(lazy_disjunctive_filter_then)
-                {
-                    for (const cnf::Predicate &pred : clause) {
-                        auto cond = CodeGenContext::Get().env().compile<_Boolx1>(*pred);
-                        if (pred.negative())
-                            GOTO(cond.is_false_and_not_null(), lazy_disjunctive_filter_then); // break to remainder of pipline
-                        else
-                            GOTO(cond.is_true_and_not_null(), lazy_disjunctive_filter_then); // break to remainder of pipline
-                    }
-                    GOTO(lazy_disjunctive_filter); // skip pipeline
+        /* Keep attributes for which an index exists. */
+        if (DB.has_index(table.name(), id.name, IndexMethod))
+            ids.push_back(id);
+    }
+    if (ids.empty()) // no usable index found
+        return ConditionSet::Make_Unsatisfiable();
+
+    /*----- Check if filter condition is supported. -----*/
+    /* We currently only support filter conditions of the following form.
+     * 1. Point: condition with a single equality predicate, e.g.
+     *    x = 42.
+     * 2. One-sided range: condition with a single greater/greater-or-equal/less/less-or-equal predicate, e.g.
+     *    x > 42.
+     * 3. Two-sided range: condition with a greater/greater-or-equal predicate and a less/less-or-equal predicate, e.g.
+     *    x > 42 AND x <= 89.
+     * Attributes may appear on either side.  The other side is required to be a `Constant`. */
+    if (ids.size() > 1) // conditions with more than one attribute currently not supported
+        return ConditionSet::Make_Unsatisfiable();
+
+    bool has_lo_bound = false;
+    bool has_hi_bound = false;
+    for (auto &clause : cnf) {
+        if (clause.size() != 1) // disjunctions not supported
+            return ConditionSet::Make_Unsatisfiable();
+
+        auto &predicate = clause[0];
+        if (predicate.negative()) // negated predicates not supported
+            return ConditionSet::Make_Unsatisfiable();
+
+        auto expr = cast<const BinaryExpr>(&predicate.expr());
+        if (not expr) // not a binary expression
+            return ConditionSet::Make_Unsatisfiable();
+
+        bool has_attribute_left = is<const Designator>(expr->lhs);
+        auto &attribute = has_attribute_left ? *expr->lhs : *expr->rhs;
+        auto &constant = has_attribute_left ? *expr->rhs : *expr->lhs;
+        if (not is<const Designator>(attribute)) // attribute must be on lhs
+            return ConditionSet::Make_Unsatisfiable();
+        if (not is_valid_bound(constant))
+            return ConditionSet::Make_Unsatisfiable();
+
+        switch(expr->tok.type) {
+            default:
+                return ConditionSet::Make_Unsatisfiable();
+            case TK_EQUAL:
+                if (not has_lo_bound and not has_hi_bound) { // lo and hi bound not yet set
+                    has_lo_bound = has_hi_bound = true;
+                } else {
+                    return ConditionSet::Make_Unsatisfiable();
                 }
-                pipeline();
-            }
-        },
-        /* teardown= */ std::move(teardown)
-    );
+                break;
+            case TK_GREATER:
+            case TK_GREATER_EQUAL:
+                if (has_attribute_left and not has_lo_bound) { // attribute on lhs, lo bound not yet set
+                    has_lo_bound = true;
+                } else if (not has_attribute_left and not has_hi_bound) { // attribute on rhs, hi bound not yet set
+                    has_hi_bound = true;
+                } else {
+                    return ConditionSet::Make_Unsatisfiable();
+                }
+                break;
+            case TK_LESS:
+            case TK_LESS_EQUAL:
+                if (has_attribute_left and not has_hi_bound) { // attribute on lhs, hi bound not yet set
+                    has_hi_bound = true;
+                } else if (not has_attribute_left and not has_lo_bound) { // attribute on rhs, lo bound not yet set
+                    has_lo_bound = true;
+                } else {
+                    return ConditionSet::Make_Unsatisfiable();
+                }
+                break;
+        }
+    }
+    return ConditionSet();
 }
 
+template<idx::IndexMethod IndexMethod>
+ConditionSet IndexScan<IndexMethod>::post_condition(const Match<IndexScan<IndexMethod>> &M)
+{
+    ConditionSet post_cond;
 
-/*======================================================================================================================
- * Projection
- *====================================================================================================================*/
+    /*----- Index scan does not introduce predication. -----*/
+    post_cond.add_condition(Predicated(false));
 
-ConditionSet Projection::pre_condition(
-    std::size_t child_idx,
-    const std::tuple<const ProjectionOperator*> &partial_inner_nodes)
-{
-     M_insist(child_idx == 0);
+    /*----- Non-SIMDfied index scan does not introduce SIMD. -----*/
+    post_cond.add_condition(NoSIMD());
 
-    ConditionSet pre_cond;
+    /*----- Index scan introduces sortedness on indexed attribute. -----*/
+    /* Extract identifier from cnf. */
+    auto &cnf = M.filter.filter();
+    Schema designators = cnf.get_required();
+    M_insist(designators.num_entries() == 1, "filter condition must contain exactly one designator");
+    Schema::Identifier &id = designators[0].id;
 
-    auto &projection = *std::get<0>(partial_inner_nodes);
+    /* Add sortedness post condition. */
+    Sortedness::order_t orders;
+    orders.add(id, Sortedness::O_ASC);
+    post_cond.add_condition(Sortedness(std::move(orders)));
 
-    if (not projection.children().empty()) { // projections starting a pipeline produce only a single tuple, i.e. no SIMD
-        /*----- Projection does only support SIMD if all expressions can be computed using SIMD instructions. -----*/
-        auto is_simd_computable = [](const ast::Expr &e){
-            bool simd_computable = true;
-            visit(overloaded {
-                [&](const ast::BinaryExpr &b) -> void {
-                    if (b.lhs->type()->is_character_sequence() or b.rhs->type()->is_character_sequence()) {
-                        simd_computable = false; // string operations are not SIMDfiable
-                        throw visit_stop_recursion(); // abort recursion
-                    }
-                    if (b.common_operand_type->is_integral() and b.op().type == TK_SLASH) {
-                        simd_computable = false; // integer division is not SIMDfiable
-                        throw visit_stop_recursion(); // abort recursion
-                    }
-                    if (b.op().type == TK_PERCENT) {
-                        simd_computable = false; // modulo is not SIMDfiable
-                        throw visit_stop_recursion(); // abort recursion
-                    }
-                },
-                [](auto&) -> void {
-                    /* designators, constants, unary expressions, NULL(), INT(), already computed aggregates and results
-                     * of a nested query are SIMDfiable; nothing to be done */
-                },
-            }, e, m::tag<m::ast::ConstPreOrderExprVisitor>());
-            return simd_computable;
-        };
-        auto pred = [&](auto &p){ return not is_simd_computable(p.first); };
-        if (std::any_of(projection.projections().cbegin(), projection.projections().cend(), pred))
-            pre_cond.add_condition(NoSIMD());
-    }
+    return post_cond;
+}
 
-    return pre_cond;
+template<idx::IndexMethod IndexMethod>
+double IndexScan<IndexMethod>::cost(const Match<IndexScan<IndexMethod>>&)
+{
+    /* TODO: add meaningful cost function. */
+    return 0.0;
 }
 
-ConditionSet Projection::adapt_post_condition(const Match<Projection> &M, const ConditionSet &post_cond_child)
+/** Emits code to fetch the tuple IDs of the index entries in `[lo, hi)` of the index with ID \p index_id in batches by
+ * calling the host function \p scan_fn once per batch, and to call \p consume for each tuple ID.  The first batch
+ * holds \p batch_size entries, where 0 is interpreted as infinity.  With adaptive batch sizes, each batch doubles the
+ * size of the next one, such that large ranges cross the boundary between V8 and the host only logarithmically often,
+ * while a pipeline exiting early, e.g. due to a `LIMIT`, fetches at most twice the tuple IDs it consumes.  The buffer
+ * for the batches is sized for the number of entries in `[lo, hi)`, but at most for the maximal batch size.
+ * \p setup is emitted after allocating the buffer and \p teardown before freeing it.  If \p break_on_exit is set, the
+ * loops are left on pipeline exit. */
+void index_sequential_scan_batched(const char *scan_fn, U64x1 index_id, Var<U32x1> &lo, const Var<U32x1> &hi,
+                                   std::size_t batch_size, bool break_on_exit, setup_t setup,
+                                   const std::function<void(U32x1)> &consume, teardown_t teardown)
 {
-    ConditionSet post_cond(post_cond_child);
+    M_insist(std::in_range<uint32_t>(batch_size), "should fit in uint32_t");
+    const std::size_t max_batch_size = options::index_sequential_scan_adaptive_batch_size
+                                       ? options::index_sequential_scan_max_batch_size : batch_size;
+    M_insist(std::in_range<uint32_t>(max_batch_size), "should fit in uint32_t");
+
+    /* Determine alloc size as minimum of number of results and maximal batch size, where 0 is interpreted as
+     * infinity. */
+    const Var<U32x1> alloc_size([&](){
+        U32x1 num_results = hi - lo;
+        if (max_batch_size == 0)
+            return num_results;
+        U32x1 num_results_cpy = num_results.clone();
+        return Select(num_results < U32x1(max_batch_size), num_results_cpy, U32x1(max_batch_size));
+    }());
+    Ptr<U32x1> buffer_address = Module::Allocator().malloc<uint32_t>(alloc_size);
+
+    /*----- Emit setup code *after* allocating memory to guarantee sequential memory allocation for pipeline. -----*/
+    setup();
 
-    /*----- Project and rename in duplicated post condition. -----*/
-    M_insist(M.projection.projections().size() == M.projection.schema().num_entries(),
-             "projections must match the operator's schema");
-    std::vector<std::pair<Schema::Identifier, Schema::Identifier>> old2new;
-    auto p = M.projection.projections().begin();
-    for (auto &e: M.projection.schema()) {
-        auto pred = [&e](const auto &p) { return p.second == e.id; };
-        if (std::find_if(old2new.cbegin(), old2new.cend(), pred) == old2new.cend()) {
-            M_insist(p != M.projection.projections().end());
-            old2new.emplace_back(Schema::Identifier(p->first.get()), e.id);
+    /*----- Emit loop code. -----*/
+    Var<U32x1> next_batch_size(
+        batch_size == 0 ? U32x1(alloc_size) : Select(U32x1(batch_size) < alloc_size, U32x1(batch_size), alloc_size)
+    );
+    Var<U32x1> num_tuples_in_batch;
+    Var<Ptr<U32x1>> ptr;
+    WHILE (lo < hi) {
+        if (break_on_exit) break_on_pipeline_exit();
+        num_tuples_in_batch = Select(hi - lo > next_batch_size, next_batch_size, hi - lo);
+        /* Call host to fill buffer memory with next batch of tuple ids. */
+        Module::Get().emit_call<void>(
+            /* fn=           */ scan_fn,
+            /* index_id=     */ index_id,
+            /* entry_offset= */ lo.val(),
+            /* address=      */ buffer_address.clone(),
+            /* batch_size=   */ num_tuples_in_batch.val()
+        );
+        lo += num_tuples_in_batch;
+        if (options::index_sequential_scan_adaptive_batch_size)
+            next_batch_size = Select(next_batch_size > alloc_size / 2U, alloc_size, next_batch_size * 2U);
+        ptr = buffer_address.clone();
+        WHILE(num_tuples_in_batch > 0U) {
+            if (break_on_exit) break_on_pipeline_exit();
+            consume(*ptr);
+            num_tuples_in_batch -= 1U;
+            ptr += 1;
         }
-        ++p;
     }
-    post_cond.project_and_rename(old2new);
-
-    if (not M.child) {
-        /*----- Leaf projection does not introduce predication. -----*/
-        post_cond.add_condition(Predicated(false));
 
-        /*----- Leaf projection does not introduce SIMD. -----*/
-        post_cond.add_condition(NoSIMD());
-    }
+    /*----- Emit teardown code. -----*/
+    teardown();
 
-    return post_cond;
+    /*----- Free buffer memory. -----*/
+    IF (alloc_size > U32x1(0)) { // only free if actually allocated
+        Module::Allocator().free(buffer_address, alloc_size);
+    };
 }
 
-void Projection::execute(const Match<Projection> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
+/** Returns `true` iff the index scan \p M requires no attribute of the scanned table, e.g. for `SELECT COUNT(*)`, and
+ * index-only scans are enabled.  Such a scan executes the pipeline once per qualifying index entry without accessing
+ * the store. */
+template<idx::IndexMethod IndexMethod>
+bool is_index_only_without_attributes(const Match<IndexScan<IndexMethod>> &M)
 {
-    auto execute_projection = [&, pipeline=std::move(pipeline)](){
-        auto &old_env = CodeGenContext::Get().env();
-        Environment new_env; // fresh environment
+    return options::index_only_scan and M.scan.schema().num_entries() == 0;
+}
 
-        /*----- If predication is used, move predicate to newly created environment. -----*/
-        if (old_env.predicated())
-            new_env.add_predicate(old_env.extract_predicate());
-
-        /*----- Add projections to newly created environment. -----*/
-        M_insist(M.projection.projections().size() == M.projection.schema().num_entries(),
-                 "projections must match the operator's schema");
-        auto p = M.projection.projections().begin();
-        for (auto &e: M.projection.schema()) {
-            if (not new_env.has(e.id) and not e.id.is_constant()) { // no duplicate and no constant
-                if (old_env.has(e.id)) {
-                    /*----- Migrate compiled expression to new context. ------*/
-                    new_env.add(e.id, old_env.get(e.id)); // to retain `e.id` for later compilation of expressions
-                } else {
-                    /*----- Compile expression. -----*/
-                    M_insist(p != M.projection.projections().end());
-                    std::visit(overloaded {
-                        [&]<typename T, std::size_t L>(Expr<T, L> value) -> void {
-                            if (value.can_be_null()) {
-                                Var<Expr<T, L>> var(value); // introduce variable s.t. uses only load from it
-                                new_env.add(e.id, var);
-                            } else {
-                                /* introduce variable w/o NULL bit s.t. uses only load from it */
-                                Var<PrimitiveExpr<T, L>> var(value.insist_not_null());
-                                new_env.add(e.id, Expr<T, L>(var));
-                            }
-                        },
-                        [&](NChar value) -> void {
-                            Var<Ptr<Charx1>> var(value.val()); // introduce variable s.t. uses only load from it
-                            new_env.add(e.id, NChar(var, value.can_be_null(), value.length(),
-                                                    value.guarantees_terminating_nul()));
-                        },
-                        [](std::monostate) -> void { M_unreachable("invalid expression"); },
-                    }, old_env.compile(p->first));
-                }
-            }
-            ++p;
-        }
-
-        /*----- Resume pipeline with newly created environment. -----*/
-        {
-            auto S = CodeGenContext::Get().scoped_environment(std::move(new_env));
-            pipeline();
-        }
-    };
-
-    if (M.child) {
-        /*----- Set minimal number of SIMD lanes preferred to get fully utilized SIMD vectors *after* the projection. */
-        uint64_t min_size_in_bytes = 16;
-        for (auto &p : M.projection.projections()) {
-            visit(overloaded {
-                [](const m::ast::ErrorExpr&) -> void { M_unreachable("no errors at this stage"); },
-                [](const m::ast::Designator&) -> void { /* nothing to be done */ },
-                [](const m::ast::Constant&) -> void { /* nothing to be done */ },
-                [](const m::ast::QueryExpr&) -> void { /* nothing to be done */ },
-                [&min_size_in_bytes](const m::ast::FnApplicationExpr &fn) -> void {
-                    if (fn.get_function().is_aggregate())
-                        throw visit_skip_subtree(); // skip arguments to already computed aggregate
-                    min_size_in_bytes = std::min(min_size_in_bytes, (fn.type()->size() + 7) / 8);
-                    if (min_size_in_bytes == 1)
-                        throw visit_stop_recursion(); // abort recursion
-                },
-                [&min_size_in_bytes](auto &e) -> void { // i.e. for unary and binary expressions
-                    min_size_in_bytes = std::min(min_size_in_bytes, (e.type()->size() + 7) / 8);
-                    if (min_size_in_bytes == 1)
-                        throw visit_stop_recursion(); // abort recursion
-                }
-            }, p.first.get(), m::tag<m::ast::ConstPreOrderExprVisitor>());
-        }
-        CodeGenContext::Get().update_num_simd_lanes_preferred(16 / min_size_in_bytes); // set own preference
-
-        /*----- Execute projection. -----*/
-        M.child->get()->execute(std::move(setup), std::move(execute_projection), std::move(teardown));
+/** Returns `true` iff the index scan \p M requires only the attribute indexed with key type `Key` given by \p bounds
+ * and index-only scans are enabled.  Such a scan loads the keys from the qualifying index entries instead of the
+ * tuples from the store.  Only non-boolean arithmetic keys can be loaded from memory. */
+template<typename Key, idx::IndexMethod IndexMethod>
+bool is_index_only_with_key(const Match<IndexScan<IndexMethod>> &M, const index_scan_bounds_t &bounds)
+{
+    if constexpr (m::arithmetic<Key> and not m::boolean<Key>) {
+        auto &schema = M.scan.schema();
+        return options::index_only_scan and schema.num_entries() == 1 and schema[0].id == bounds.attribute.id;
     } else {
-        /*----- Execute projection. -----*/
-        setup();
-        CodeGenContext::Get().set_num_simd_lanes(1); // since only a single tuple is produced
-        execute_projection();
-        teardown();
+        return false;
     }
 }
 
+/** Adds \p key as value of the indexed attribute \p id to the current environment. */
+template<typename Key>
+void add_index_only_key(const Schema::Identifier &id, PrimitiveExpr<Key> key)
+{
+    Var<PrimitiveExpr<Key>> var(key); // introduce variable s.t. uses only load from it
+    CodeGenContext::Get().env().add(id, Expr<Key>(var));
+}
 
-/*======================================================================================================================
- * Grouping
- *====================================================================================================================*/
+template<idx::IndexMethod IndexMethod, typename Index, sql_type SqlT>
+void index_scan_codegen_compilation(const Index &index, const index_scan_bounds_t &bounds,
+                                    const Match<IndexScan<IndexMethod>> &M,
+                                    setup_t setup, pipeline_t pipeline, teardown_t teardown) {
+    using sql_type = SqlT;
 
-ConditionSet HashBasedGrouping::pre_condition(std::size_t child_idx, const std::tuple<const GroupingOperator*>&)
-{
-     M_insist(child_idx == 0);
+    if (options::index_scan_compilation_strategy == option_configs::IndexScanCompilationStrategy::CALLBACK) {
+        /*----- Resolve callback function names. -----*/
+        const char *scan_fn, *lower_bound_fn, *upper_bound_fn;
+#define SET_CALLBACK_FNS(INDEX, KEY) \
+        scan_fn        = M_STR(idx_scan_##INDEX##_##KEY); \
+        lower_bound_fn = M_STR(idx_lower_bound_##INDEX##_##KEY); \
+        upper_bound_fn = M_STR(idx_upper_bound_##INDEX##_##KEY)
 
-    ConditionSet pre_cond;
+#define RESOLVE_KEYTYPE(INDEX) \
+        if constexpr(std::same_as<SqlT, _Boolx1>) { \
+            SET_CALLBACK_FNS(INDEX, b); \
+        } else if constexpr(std::same_as<sql_type, _I8x1>) { \
+            SET_CALLBACK_FNS(INDEX, i1); \
+        } else if constexpr(std::same_as<sql_type, _I16x1>) { \
+            SET_CALLBACK_FNS(INDEX, i2); \
+        } else if constexpr(std::same_as<sql_type, _I32x1>) { \
+            SET_CALLBACK_FNS(INDEX, i4); \
+        } else if constexpr(std::same_as<sql_type, _I64x1>) { \
+            SET_CALLBACK_FNS(INDEX, i8); \
+        } else if constexpr(std::same_as<sql_type, _Floatx1>) { \
+            SET_CALLBACK_FNS(INDEX, f); \
+        } else if constexpr(std::same_as<sql_type, _Doublex1>) { \
+            SET_CALLBACK_FNS(INDEX, d); \
+        } else if constexpr(std::same_as<sql_type, NChar>) { \
+            SET_CALLBACK_FNS(IDNEX, p); \
+        } else { \
+            M_unreachable("incompatible SQL type"); \
+        }
+        if constexpr(is_specialization<Index, idx::ArrayIndex>) {
+            RESOLVE_KEYTYPE(array)
+        } else if constexpr(is_specialization<Index, idx::RecursiveModelIndex>) {
+            RESOLVE_KEYTYPE(rmi)
+        } else {
+            M_unreachable("unknown index type");
+        }
+#undef RESOLVE_KEYTYPE
+#undef SET_CALLBACK_FNS
 
-    /*----- Hash-based grouping does not support SIMD. -----*/
-    pre_cond.add_condition(NoSIMD());
+        /*----- Add index to context. -----*/
+        auto &context = WasmEngine::Get_Wasm_Context_By_ID(Module::ID());
+        U64x1 index_id(context.add_index(index));
 
-    return pre_cond;
-}
+        /*----- Emit host calls to query the index for lo and hi bounds. -----*/
+        auto compile_bound_lookup = [&](const ast::Expr &bound, bool is_lower_bound) {
+            auto key = CodeGenContext::Get().env().compile(bound);
+            return Module::Get().emit_call<uint32_t>(
+                /* fn=       */ is_lower_bound ? lower_bound_fn : upper_bound_fn,
+                /* index_id= */ index_id.clone(),
+                /* key=      */ convert<sql_type>(key).insist_not_null()
+            );
+        };
+        Var<U32x1> lo(bool(bounds.lo) ? compile_bound_lookup(bounds.lo->get(), bounds.is_inclusive_lo)
+                                      : U32x1(0));
+        const Var<U32x1> hi(bool(bounds.hi) ? compile_bound_lookup(bounds.hi->get(), not bounds.is_inclusive_hi)
+                                      : U32x1(index.num_entries()));
+        Wasm_insist(lo <= hi, "bounds need to be valid");
 
-double HashBasedGrouping::cost(const Match<HashBasedGrouping> &M)
-{
-    return 1.5 * M.child->get_matched_root().info().estimated_cardinality;
+        /*----- Execute pipeline once per qualifying entry if no attribute is required. -----*/
+        if (is_index_only_without_attributes(M)) {
+            setup();
+            WHILE (lo < hi) {
+                break_on_pipeline_exit();
+                pipeline();
+                lo += 1U;
+            }
+            teardown();
+            return;
+        }
+
+        /*----- Fetch tuple IDs in batches from host, load tuples, and emit pipeline code. -----*/
+        index_sequential_scan_batched(
+            /* scan_fn=       */ scan_fn,
+            /* index_id=      */ index_id,
+            /* lo=            */ lo,
+            /* hi=            */ hi,
+            /* batch_size=    */ M.batch_size,
+            /* break_on_exit= */ true,
+            /* setup=         */ std::move(setup),
+            /* consume=       */ [&](U32x1 tuple_id) {
+                static Schema empty_schema;
+                compile_load_point_access(
+                    /* tuple_value_schema=   */ M.scan.schema(),
+                    /* tuple_address_schema= */ empty_schema,
+                    /* base_address=         */ get_base_address(M.scan.store().table().name()),
+                    /* layout=               */ M.scan.store().table().layout(),
+                    /* layout_schema=        */ M.scan.store().table().schema(M.scan.alias()),
+                    /* tuple_id=             */ tuple_id
+                );
+                pipeline();
+            },
+            /* teardown=      */ std::move(teardown)
+        );
+    } else if (options::index_scan_compilation_strategy == option_configs::IndexScanCompilationStrategy::EXPOSED_MEMORY) {
+        M_unreachable("not implemented yet");
+    } else {
+        M_unreachable("unknown compilation stategy");
+    }
 }
 
-ConditionSet HashBasedGrouping::post_condition(const Match<HashBasedGrouping>&)
+template<idx::IndexMethod IndexMethod, typename Index>
+void index_scan_codegen_interpretation(const Index &index, const index_scan_bounds_t &bounds,
+                                       const Match<IndexScan<IndexMethod>> &M,
+                                       setup_t setup, pipeline_t pipeline, teardown_t teardown)
 {
-    ConditionSet post_cond;
+    using key_type = Index::key_type;
 
-    /*----- Hash-based grouping does not introduce predication (it is already handled by the hash table). -----*/
-    post_cond.add_condition(Predicated(false));
+    static Schema empty_schema;
 
-    /*----- Hash-based grouping does not introduce SIMD. -----*/
-    post_cond.add_condition(NoSIMD());
+    /*----- Interpret lo and hi bounds to retrieve index scan range -----*/
+    auto interpret_and_lookup_bound = [&](const ast::Expr &bound, bool is_lower_bound) -> std::size_t {
+        auto [constant, is_negative] = get_valid_bound(bound);
+        auto c = Interpreter::eval(constant);
+        key_type key;
+        if constexpr(m::boolean<key_type>) {
+            key = bool(c);
+            M_insist(not is_negative, "boolean cannot be negative");
+        } else if constexpr(m::integral<key_type>) {
+            auto i64 = int64_t(c);
+            M_insist(std::in_range<key_type>(i64), "integeral constant must be in range");
+            key = key_type(i64);
+            key = is_negative ? -key : key;
+        } else if constexpr(std::same_as<float, key_type>) {
+            auto d = double(c);
+            key = key_type(d);
+            M_insist(key == d, "downcasting should not impact precision");
+            key = is_negative ? -key : key;
+        } else if constexpr(std::same_as<double, key_type>) {
+            key = double(c);
+            key = is_negative ? -key : key;
+        } else if constexpr(std::same_as<const char*, key_type>) {
+            key = reinterpret_cast<const char*>(c.as_p());
+            M_insist(not is_negative, "string cannot be negative");
+        }
+        return std::distance(index.begin(), is_lower_bound ? index.lower_bound(key)
+                                                           : index.upper_bound(key));
+    };
+    std::size_t lo = bool(bounds.lo) ? interpret_and_lookup_bound(bounds.lo->get(), bounds.is_inclusive_lo)
+                                     : 0UL;
+    std::size_t hi = bool(bounds.hi) ? interpret_and_lookup_bound(bounds.hi->get(), not bounds.is_inclusive_hi)
+                                     : index.num_entries();
+    M_insist(lo <= hi, "bounds need to be valid");
+    M_insist(std::in_range<uint32_t>(hi - lo), "number of results must fit in uint32_t");
 
-    return post_cond;
-}
+    /*----- Execute pipeline once per qualifying entry if no attribute is required. -----*/
+    if (is_index_only_without_attributes(M)) {
+        setup();
+        Var<U32x1> num_results(uint32_t(hi - lo));
+        WHILE(num_results > 0U) {
+            pipeline();
+            num_results -= 1U;
+        }
+        teardown();
+        return;
+    }
 
-void HashBasedGrouping::execute(const Match<HashBasedGrouping> &M, setup_t setup, pipeline_t pipeline,
-                                teardown_t teardown)
-{
-    // TODO: determine setup
-    const uint64_t AGGREGATES_SIZE_THRESHOLD_IN_BITS =
-        M.use_in_place_values ? std::numeric_limits<uint64_t>::max() : 0;
+    /*----- Load keys from index entries instead of tuples from store if only the indexed attribute is required. -----*/
+    if (is_index_only_with_key<key_type>(M, bounds)) {
+        auto &id = M.scan.schema()[0].id;
+        const auto strategy = options::index_scan_materialization_strategy;
+        if constexpr (m::arithmetic<key_type> and not m::boolean<key_type>) {
+            if (strategy == option_configs::IndexScanMaterializationStrategy::MEMORY) {
+                /*----- Allocate sufficient memory for keys and fill it with the keys of the results. -----*/
+                uint32_t num_results = hi - lo;
+                key_type *buffer_address = Module::Allocator().raw_malloc<key_type>(num_results);
+                std::transform(index.begin() + lo, index.begin() + hi, buffer_address,
+                               [](const auto &entry) { return entry.first; });
+
+                /*----- Emit setup code *after* allocating memory to guarantee sequential memory allocation. -----*/
+                setup();
+
+                /*----- Emit loop code. -----*/
+                Var<Ptr<PrimitiveExpr<key_type>>> ptr(buffer_address);
+                Ptr<PrimitiveExpr<key_type>> end(buffer_address + num_results);
+                WHILE(ptr < end) {
+                    add_index_only_key<key_type>(id, *ptr);
+                    pipeline();
+                    ptr += 1;
+                }
 
-    const auto num_keys = M.grouping.group_by().size();
+                /*----- Emit teardown code. -----*/
+                teardown();
+            } else if (strategy == option_configs::IndexScanMaterializationStrategy::INLINE) {
+                /*----- Define function that emits code for executing pipeline for a single key. -----*/
+                FUNCTION(index_only_scan_parent_pipeline, void(key_type))
+                {
+                    auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+                    setup();
+                    add_index_only_key<key_type>(id, PARAMETER(0));
+                    pipeline();
+                    teardown();
+                }
 
-    /*----- Compute hash table schema and information about aggregates, especially AVG aggregates. -----*/
-    Schema ht_schema;
-    /* Add key(s). */
-    for (std::size_t i = 0; i < num_keys; ++i) {
-        auto &e = M.grouping.schema()[i];
-        ht_schema.add(e.id, e.type, e.constraints);
-    }
-    /* Add payload. */
-    auto p = compute_aggregate_info(M.grouping.aggregates(), M.grouping.schema(), num_keys);
-    const auto &aggregates = p.first;
-    const auto &avg_aggregates = p.second;
-    uint64_t aggregates_size_in_bits = 0;
-    for (auto &info : aggregates) {
-        ht_schema.add(info.entry);
-        aggregates_size_in_bits += info.entry.type->size();
+                /*----- Perform index sequential scan, emit code to execute pipeline for each key. -----*/
+                for (auto it = index.begin() + lo; it != index.begin() + hi; ++it)
+                    index_only_scan_parent_pipeline(it->first);
+            } else {
+                M_unreachable("unknown materialization strategy");
+            }
+        }
+        return;
     }
 
-    /*----- Compute initial capacity of hash table. -----*/
-    uint32_t initial_capacity = compute_initial_ht_capacity(M.grouping, M.load_factor);
-
-    /*----- Create hash table. -----*/
-    std::unique_ptr<HashTable> ht;
-    std::vector<HashTable::index_t> key_indices(num_keys);
-    std::iota(key_indices.begin(), key_indices.end(), 0);
-    if (M.use_open_addressing_hashing) {
-        if (aggregates_size_in_bits < AGGREGATES_SIZE_THRESHOLD_IN_BITS)
-            ht = std::make_unique<GlobalOpenAddressingInPlaceHashTable>(ht_schema, std::move(key_indices),
-                                                                        initial_capacity);
-        else
-            ht = std::make_unique<GlobalOpenAddressingOutOfPlaceHashTable>(ht_schema, std::move(key_indices),
-                                                                           initial_capacity);
-        if (M.use_quadratic_probing)
-            as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<QuadraticProbing>();
-        else
-            as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<LinearProbing>();
-    } else {
-        ht = std::make_unique<GlobalChainedHashTable>(ht_schema, std::move(key_indices), initial_capacity);
-    }
+    if (options::index_scan_materialization_strategy == option_configs::IndexScanMaterializationStrategy::MEMORY) {
+        /*----- Allocate sufficient memory for results. -----*/
+        uint32_t num_results = hi - lo;
+        uint32_t *buffer_address = Module::Allocator().raw_malloc<uint32_t>(num_results);
 
-    /*----- Create child function. -----*/
-    FUNCTION(hash_based_grouping_child_pipeline, void(void)) // create function for pipeline
-    {
-        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+        /*----- Perform index scan and fill memory with results. -----*/
+        uint32_t *buffer_ptr = buffer_address;
+        for (auto it = index.begin() + lo; it != index.begin() + hi; ++it) {
+            M_insist(std::in_range<uint32_t>(it->second), "tuple id must fit in uint32_t");
+            *buffer_ptr = it->second;
+            ++buffer_ptr;
+        }
 
-        std::optional<HashTable::entry_t> dummy; ///< *local* dummy slot
+        /*----- Emit setup code *after* allocating memory to guarantee sequential memory allocation for pipeline. -----*/
+        setup();
 
-        M.child->execute(
-            /* setup=    */ setup_t::Make_Without_Parent([&](){
-                ht->setup();
-                ht->set_high_watermark(M.load_factor);
-                dummy.emplace(ht->dummy_entry()); // create dummy slot to ignore NULL values in aggregate computations
-            }),
-            /* pipeline= */ [&](){
-                M_insist(bool(dummy));
-                const auto &env = CodeGenContext::Get().env();
+        /*----- Emit loop code. -----*/
+        Var<Ptr<U32x1>> ptr(buffer_address);
+        Ptr<U32x1> end(buffer_address + num_results);
+        WHILE(ptr < end) {
+            compile_load_point_access(
+                /* tuple_value_schema=   */ M.scan.schema(),
+                /* tuple_address_schema= */ empty_schema,
+                /* base_address=         */ get_base_address(M.scan.store().table().name()),
+                /* layout=               */ M.scan.store().table().layout(),
+                /* layout_schema=        */ M.scan.store().table().schema(M.scan.alias()),
+                /* tuple_id=             */ *ptr
+            );
+            pipeline();
+            ptr += 1;
+        }
 
-                /*----- Insert key if not yet done. -----*/
-                std::vector<SQL_t> key;
-                for (auto &p : M.grouping.group_by())
-                    key.emplace_back(env.compile(p.first.get()));
-                auto [entry, inserted] = ht->try_emplace(std::move(key));
-
-                /*----- Compute aggregates. -----*/
-                Block init_aggs("hash_based_grouping.init_aggs", false),
-                      update_aggs("hash_based_grouping.update_aggs", false),
-                      update_avg_aggs("hash_based_grouping.update_avg_aggs", false);
-                for (auto &info : aggregates) {
-                    bool is_min = false; ///< flag to indicate whether aggregate function is MIN
-                    switch (info.fnid) {
-                        default:
-                            M_unreachable("unsupported aggregate function");
-                        case m::Function::FN_MIN:
-                            is_min = true; // set flag and delegate to MAX case
-                        case m::Function::FN_MAX: {
-                            M_insist(info.args.size() == 1,
-                                     "MIN and MAX aggregate functions expect exactly one argument");
-                            const auto &arg = *info.args[0];
-                            std::visit(overloaded {
-                                [&]<sql_type _T>(HashTable::reference_t<_T> &&r) -> void
-                                requires (not (std::same_as<_T, _Boolx1> or std::same_as<_T, NChar>)) {
-                                    using type = typename _T::type;
-                                    using T = PrimitiveExpr<type>;
+        /*----- Emit teardown code. -----*/
+        teardown();
+    } else if (options::index_scan_materialization_strategy == option_configs::IndexScanMaterializationStrategy::INLINE) {
+        /*----- Define function that emits code for loading and executing pipeline for a single tuple. -----*/
+        FUNCTION(index_scan_parent_pipeline, void(uint32_t))
+        {
+            auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
 
-                                    auto _arg = env.compile(arg);
-                                    _T _new_val = convert<_T>(_arg);
+            /*----- Emit setup code. -----*/
+            setup();
 
-                                    BLOCK_OPEN(init_aggs) {
-                                        auto [val_, is_null] = _new_val.clone().split();
-                                        T val(val_); // due to structured binding and lambda closure
-                                        IF (is_null) {
-                                            auto neutral = is_min ? T(std::numeric_limits<type>::max())
-                                                                  : T(std::numeric_limits<type>::lowest());
-                                            r.clone().set_value(neutral); // initialize with neutral element +inf or -inf
-                                            if (info.entry.nullable())
-                                                r.clone().set_null(); // first value is NULL
-                                        } ELSE {
-                                            r.clone().set_value(val); // initialize with first value
-                                            if (info.entry.nullable())
-                                                r.clone().set_not_null(); // first value is not NULL
-                                        };
-                                    }
-                                    BLOCK_OPEN(update_aggs) {
-                                        if (_new_val.can_be_null()) {
-                                            M_insist_no_ternary_logic();
-                                            auto [new_val_, new_val_is_null_] = _new_val.split();
-                                            auto [old_min_max_, old_min_max_is_null] = _T(r.clone()).split();
-                                            const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
-
-                                            auto chosen_r = Select(new_val_is_null, dummy->extract<_T>(info.entry.id),
-                                                                                    r.clone());
-                                            if constexpr (std::floating_point<type>) {
-                                                chosen_r.set_value(
-                                                    is_min ? min(old_min_max_, new_val_) // update old min with new value
-                                                           : max(old_min_max_, new_val_) // update old max with new value
-                                                ); // if new value is NULL, only dummy is written
-                                            } else {
-                                                const Var<T> new_val(new_val_),
-                                                             old_min_max(old_min_max_); // due to multiple uses
-                                                auto cmp = is_min ? new_val < old_min_max : new_val > old_min_max;
-#if 1
-                                                chosen_r.set_value(
-                                                    Select(cmp,
-                                                           new_val, // update to new value
-                                                           old_min_max) // do not update
-                                                ); // if new value is NULL, only dummy is written
-#else
-                                                IF (cmp) {
-                                                    r.set_value(new_val);
-                                                };
-#endif
-                                            }
-                                            r.set_null_bit(
-                                                old_min_max_is_null and new_val_is_null // MIN/MAX is NULL iff all values are NULL
-                                            );
-                                        } else {
-                                            auto new_val_ = _new_val.insist_not_null();
-                                            auto old_min_max_ = _T(r.clone()).insist_not_null();
-                                            if constexpr (std::floating_point<type>) {
-                                                r.set_value(
-                                                    is_min ? min(old_min_max_, new_val_) // update old min with new value
-                                                           : max(old_min_max_, new_val_) // update old max with new value
-                                                );
-                                            } else {
-                                                const Var<T> new_val(new_val_),
-                                                             old_min_max(old_min_max_); // due to multiple uses
-                                                auto cmp = is_min ? new_val < old_min_max : new_val > old_min_max;
-#if 1
-                                                r.set_value(
-                                                    Select(cmp,
-                                                           new_val, // update to new value
-                                                           old_min_max) // do not update
-                                                );
-#else
-                                                IF (cmp) {
-                                                    r.set_value(new_val);
-                                                };
-#endif
-                                            }
-                                            /* do not update NULL bit since it is already set to `false` */
-                                        }
-                                    }
-                                },
-                                []<sql_type _T>(HashTable::reference_t<_T>&&) -> void
-                                requires std::same_as<_T,_Boolx1> or std::same_as<_T, NChar> {
-                                    M_unreachable("invalid type");
-                                },
-                                [](std::monostate) -> void { M_unreachable("invalid reference"); },
-                            }, entry.extract(info.entry.id));
-                            break;
-                        }
-                        case m::Function::FN_AVG: {
-                            auto it = avg_aggregates.find(info.entry.id);
-                            M_insist(it != avg_aggregates.end());
-                            const auto &avg_info = it->second;
-                            M_insist(avg_info.compute_running_avg,
-                                     "AVG aggregate may only occur for running average computations");
-                            M_insist(info.args.size() == 1, "AVG aggregate function expects exactly one argument");
-                            const auto &arg = *info.args[0];
+            /*----- Load tuple. ----- */
+            compile_load_point_access(
+                /* tuple_value_schema=   */ M.scan.schema(),
+                /* tuple_address_schema= */ empty_schema,
+                /* base_address=         */ get_base_address(M.scan.store().table().name()),
+                /* layout=               */ M.scan.store().table().layout(),
+                /* layout_schema=        */ M.scan.store().table().schema(M.scan.alias()),
+                /* tuple_id=             */ PARAMETER(0)
+            );
 
-                            auto r = entry.extract<_Doublex1>(info.entry.id);
-                            auto _arg = env.compile(arg);
-                            _Doublex1 _new_val = convert<_Doublex1>(_arg);
+            /*----- Emit pipeline code. -----*/
+            pipeline();
 
-                            BLOCK_OPEN(init_aggs) {
-                                auto [val_, is_null] = _new_val.clone().split();
-                                Doublex1 val(val_); // due to structured binding and lambda closure
-                                IF (is_null) {
-                                    r.clone().set_value(Doublex1(0.0)); // initialize with neutral element 0
-                                    if (info.entry.nullable())
-                                        r.clone().set_null(); // first value is NULL
-                                } ELSE {
-                                    r.clone().set_value(val); // initialize with first value
-                                    if (info.entry.nullable())
-                                        r.clone().set_not_null(); // first value is not NULL
-                                };
-                            }
-                            BLOCK_OPEN(update_avg_aggs) {
-                                /* Compute AVG as iterative mean as described in Knuth, The Art of Computer Programming
-                                 * Vol 2, section 4.2.2. */
-                                if (_new_val.can_be_null()) {
-                                    M_insist_no_ternary_logic();
-                                    auto [new_val, new_val_is_null_] = _new_val.split();
-                                    auto [old_avg_, old_avg_is_null] = _Doublex1(r.clone()).split();
-                                    const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
-                                    const Var<Doublex1> old_avg(old_avg_); // due to multiple uses
+            /*----- Emit teardown code. -----*/
+            teardown();
+        }
 
-                                    auto delta_absolute = new_val - old_avg;
-                                    auto running_count = _I64x1(entry.get<_I64x1>(avg_info.running_count)).insist_not_null();
-                                    auto delta_relative = delta_absolute / running_count.to<double>();
+        /*----- Perform index sequential scan, emit code to execute pipeline for each tuple. -----*/
+        for (auto it = index.begin() + lo; it != index.begin() + hi; ++it) {
+            M_insist(std::in_range<uint32_t>(it->second), "tuple id must fit in uint32_t");
+            index_scan_parent_pipeline(uint32_t(it->second));
+        }
+    } else {
+        M_unreachable("unknown materialization strategy");
+    }
+}
 
-                                    auto chosen_r = Select(new_val_is_null, dummy->extract<_Doublex1>(info.entry.id),
-                                                                            r.clone());
-                                    chosen_r.set_value(
-                                        old_avg + delta_relative // update old average with new value
-                                    ); // if new value is NULL, only dummy is written
-                                    r.set_null_bit(
-                                        old_avg_is_null and new_val_is_null // AVG is NULL iff all values are NULL
-                                    );
-                                } else {
-                                    auto new_val = _new_val.insist_not_null();
-                                    auto old_avg_ = _Doublex1(r.clone()).insist_not_null();
-                                    const Var<Doublex1> old_avg(old_avg_); // due to multiple uses
+template<idx::IndexMethod IndexMethod, typename Index, sql_type SqlT>
+void index_scan_codegen_hybrid(const Index &index, const index_scan_bounds_t &bounds,
+                               const Match<IndexScan<IndexMethod>> &M,
+                               setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    using key_type = Index::key_type;
+    using sql_type = SqlT;
 
-                                    auto delta_absolute = new_val - old_avg;
-                                    auto running_count = _I64x1(entry.get<_I64x1>(avg_info.running_count)).insist_not_null();
-                                    auto delta_relative = delta_absolute / running_count.to<double>();
-                                    r.set_value(
-                                        old_avg + delta_relative // update old average with new value
-                                    );
-                                    /* do not update NULL bit since it is already set to `false` */
-                                }
-                            }
-                            break;
-                        }
-                        case m::Function::FN_SUM: {
-                            M_insist(info.args.size() == 1, "SUM aggregate function expects exactly one argument");
-                            const auto &arg = *info.args[0];
-                            std::visit(overloaded {
-                                [&]<sql_type _T>(HashTable::reference_t<_T> &&r) -> void
-                                requires (not (std::same_as<_T, _Boolx1> or std::same_as<_T, NChar>)) {
-                                    using type = typename _T::type;
-                                    using T = PrimitiveExpr<type>;
+    /*----- Resolve callback function name. -----*/
+    const char *scan_fn;
+#define SET_CALLBACK_FNS(INDEX, KEY) \
+    scan_fn = M_STR(idx_scan_##INDEX##_##KEY)
 
-                                    auto _arg = env.compile(arg);
-                                    _T _new_val = convert<_T>(_arg);
+#define RESOLVE_KEYTYPE(INDEX) \
+    if constexpr(std::same_as<SqlT, _Boolx1>) { \
+        SET_CALLBACK_FNS(INDEX, b); \
+    } else if constexpr(std::same_as<sql_type, _I8x1>) { \
+        SET_CALLBACK_FNS(INDEX, i1); \
+    } else if constexpr(std::same_as<sql_type, _I16x1>) { \
+        SET_CALLBACK_FNS(INDEX, i2); \
+    } else if constexpr(std::same_as<sql_type, _I32x1>) { \
+        SET_CALLBACK_FNS(INDEX, i4); \
+    } else if constexpr(std::same_as<sql_type, _I64x1>) { \
+        SET_CALLBACK_FNS(INDEX, i8); \
+    } else if constexpr(std::same_as<sql_type, _Floatx1>) { \
+        SET_CALLBACK_FNS(INDEX, f); \
+    } else if constexpr(std::same_as<sql_type, _Doublex1>) { \
+        SET_CALLBACK_FNS(INDEX, d); \
+    } else if constexpr(std::same_as<sql_type, NChar>) { \
+        SET_CALLBACK_FNS(IDNEX, p); \
+    } else { \
+        M_unreachable("incompatible SQL type"); \
+    }
+    if constexpr(is_specialization<Index, idx::ArrayIndex>) {
+        RESOLVE_KEYTYPE(array)
+    } else if constexpr(is_specialization<Index, idx::RecursiveModelIndex>) {
+        RESOLVE_KEYTYPE(rmi)
+    } else {
+        M_unreachable("unknown index type");
+    }
+#undef RESOLVE_KEYTYPE
+#undef SET_CALLBACK_FNS
 
-                                    BLOCK_OPEN(init_aggs) {
-                                        auto [val_, is_null] = _new_val.clone().split();
-                                        T val(val_); // due to structured binding and lambda closure
-                                        IF (is_null) {
-                                            r.clone().set_value(T(type(0))); // initialize with neutral element 0
-                                            if (info.entry.nullable())
-                                                r.clone().set_null(); // first value is NULL
-                                        } ELSE {
-                                            r.clone().set_value(val); // initialize with first value
-                                            if (info.entry.nullable())
-                                                r.clone().set_not_null(); // first value is not NULL
-                                        };
-                                    }
-                                    BLOCK_OPEN(update_aggs) {
-                                        if (_new_val.can_be_null()) {
-                                            M_insist_no_ternary_logic();
-                                            auto [new_val, new_val_is_null_] = _new_val.split();
-                                            auto [old_sum, old_sum_is_null] = _T(r.clone()).split();
-                                            const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
-
-                                            auto chosen_r = Select(new_val_is_null, dummy->extract<_T>(info.entry.id),
-                                                                                    r.clone());
-                                            chosen_r.set_value(
-                                                old_sum + new_val // add new value to old sum
-                                            ); // if new value is NULL, only dummy is written
-                                            r.set_null_bit(
-                                                old_sum_is_null and new_val_is_null // SUM is NULL iff all values are NULL
-                                            );
-                                        } else {
-                                            auto new_val = _new_val.insist_not_null();
-                                            auto old_sum = _T(r.clone()).insist_not_null();
-                                            r.set_value(
-                                                old_sum + new_val // add new value to old sum
-                                            );
-                                            /* do not update NULL bit since it is already set to `false` */
-                                        }
-                                    }
-                                },
-                                []<sql_type _T>(HashTable::reference_t<_T>&&) -> void
-                                requires std::same_as<_T,_Boolx1> or std::same_as<_T, NChar> {
-                                    M_unreachable("invalid type");
-                                },
-                                [](std::monostate) -> void { M_unreachable("invalid reference"); },
-                            }, entry.extract(info.entry.id));
-                            break;
-                        }
-                        case m::Function::FN_COUNT: {
-                            M_insist(info.args.size() <= 1, "COUNT aggregate function expects at most one argument");
+    /*----- Add index to context. -----*/
+    auto &context = WasmEngine::Get_Wasm_Context_By_ID(Module::ID());
+    U64x1 index_id(context.add_index(index)); ///< id of index in context
 
-                            auto r = entry.get<_I64x1>(info.entry.id); // do not extract to be able to access for AVG case
+    /*----- Interpret lo and hi bounds to retrieve index scan range -----*/
+    auto interpret_and_lookup_bound = [&](const ast::Expr &bound, bool is_lower_bound) -> std::size_t {
+        auto [constant, is_negative] = get_valid_bound(bound);
+        auto c = Interpreter::eval(constant);
+        key_type key;
+        if constexpr(m::boolean<key_type>) {
+            key = bool(c);
+            M_insist(not is_negative, "boolean cannot be negative");
+        } else if constexpr(m::integral<key_type>) {
+            auto i64 = int64_t(c);
+            M_insist(std::in_range<key_type>(i64), "integeral constant must be in range");
+            key = key_type(i64);
+            key = is_negative ? -key : key;
+        } else if constexpr(std::same_as<float, key_type>) {
+            auto d = double(c);
+            key = key_type(d);
+            M_insist(key == d, "downcasting should not impact precision");
+            key = is_negative ? -key : key;
+        } else if constexpr(std::same_as<double, key_type>) {
+            key = double(c);
+            key = is_negative ? -key : key;
+        } else if constexpr(std::same_as<const char*, key_type>) {
+            key = reinterpret_cast<const char*>(c.as_p());
+            M_insist(not is_negative, "string cannot be negative");
+        }
+        return std::distance(index.begin(), is_lower_bound ? index.lower_bound(key)
+                                                           : index.upper_bound(key));
+    };
+    std::size_t lo = bool(bounds.lo) ? interpret_and_lookup_bound(bounds.lo->get(), bounds.is_inclusive_lo)
+                                     : 0UL;
+    std::size_t hi = bool(bounds.hi) ? interpret_and_lookup_bound(bounds.hi->get(), not bounds.is_inclusive_hi)
+                                     : index.num_entries();
+    M_insist(lo <= hi, "bounds need to be valid");
+    M_insist(std::in_range<uint32_t>(lo), "should fit in uint32_t");
+    M_insist(std::in_range<uint32_t>(hi), "should fit in uint32_t");
 
-                            if (info.args.empty()) {
-                                BLOCK_OPEN(init_aggs) {
-                                    r.clone() = _I64x1(1); // initialize with 1 (for first value)
-                                }
-                                BLOCK_OPEN(update_aggs) {
-                                    auto old_count = _I64x1(r.clone()).insist_not_null();
-                                    r.set_value(
-                                        old_count + int64_t(1) // increment old count by 1
-                                    );
-                                    /* do not update NULL bit since it is already set to `false` */
-                                }
-                            } else {
-                                const auto &arg = *info.args[0];
+    /*----- Materialize offsets hi and lo. -----*/
+    Var<U32x1> begin;
+    std::optional<U32x1> end;
+    if (options::index_scan_materialization_strategy == option_configs::IndexScanMaterializationStrategy::INLINE) {
+        begin = U32x1(lo);
+        end.emplace(hi);
+    } else if (options::index_scan_materialization_strategy == option_configs::IndexScanMaterializationStrategy::MEMORY) {
+        /* If we materialize before allocating buffer memory, the addresses are independent of the buffer size.  As a
+         * result, queries that only differ in the filter predicate are compiled to the exact same WebAssembly code,
+         * enabling caching of compiled plans in V8. */
+        uint32_t *offset_address = Module::Allocator().raw_malloc<uint32_t>(2);
+        offset_address[0] = uint32_t(lo);
+        offset_address[1] = uint32_t(hi);
 
-                                auto _arg = env.compile(arg);
-                                I64x1 new_val_not_null = not_null(_arg).to<int64_t>();
+        Ptr<U32x1> offset_ptr(offset_address);
+        begin = *offset_ptr.clone();
+        end.emplace(*(offset_ptr + 1));
+    } else {
+        M_unreachable("unknown materialization strategy");
+    }
+    M_insist(bool(end), "end must be set");
 
-                                BLOCK_OPEN(init_aggs) {
-                                    r.clone() = _I64x1(new_val_not_null.clone()); // initialize with 1 iff first value is present
-                                }
-                                BLOCK_OPEN(update_aggs) {
-                                    auto old_count = _I64x1(r.clone()).insist_not_null();
-                                    r.set_value(
-                                        old_count + new_val_not_null // increment old count by 1 iff new value is present
-                                    );
-                                    /* do not update NULL bit since it is already set to `false` */
-                                }
-                            }
-                            break;
-                        }
-                    }
-                }
+    /*----- Execute pipeline once per qualifying entry if no attribute is required. -----*/
+    if (is_index_only_without_attributes(M)) {
+        setup();
+        WHILE (begin < end->clone()) {
+            break_on_pipeline_exit();
+            pipeline();
+            begin += 1U;
+        }
+        teardown();
+        return;
+    }
 
-                /*----- If group has been inserted, initialize aggregates. Otherwise, update them. -----*/
-                IF (inserted) {
-                    init_aggs.attach_to_current();
-                } ELSE {
-                    update_aggs.attach_to_current();
-                    update_avg_aggs.attach_to_current(); // after others to ensure that running count is incremented before
-                };
+    if (options::index_scan_compilation_strategy == option_configs::IndexScanCompilationStrategy::CALLBACK) {
+        /*----- Fetch tuple IDs in batches from host, load tuples, and emit pipeline code. -----*/
+        const Var<U32x1> hi(*end);
+        index_sequential_scan_batched(
+            /* scan_fn=       */ scan_fn,
+            /* index_id=      */ index_id,
+            /* lo=            */ begin,
+            /* hi=            */ hi,
+            /* batch_size=    */ M.batch_size,
+            /* break_on_exit= */ true,
+            /* setup=         */ std::move(setup),
+            /* consume=       */ [&](U32x1 tuple_id) {
+                static Schema empty_schema;
+                compile_load_point_access(
+                    /* tuple_value_schema=   */ M.scan.schema(),
+                    /* tuple_address_schema= */ empty_schema,
+                    /* base_address=         */ get_base_address(M.scan.store().table().name()),
+                    /* layout=               */ M.scan.store().table().layout(),
+                    /* layout_schema=        */ M.scan.store().table().schema(M.scan.alias()),
+                    /* tuple_id=             */ tuple_id
+                );
+                pipeline();
             },
-            /* teardown= */ teardown_t::Make_Without_Parent([&](){ ht->teardown(); })
+            /* teardown=      */ std::move(teardown)
         );
+    } else if (options::index_scan_compilation_strategy == option_configs::IndexScanCompilationStrategy::EXPOSED_MEMORY) {
+        M_unreachable("not implemented yet");
+    } else {
+        M_unreachable("unknwon compilation strategy");
     }
-    hash_based_grouping_child_pipeline(); // call child function
+}
 
-    auto &env = CodeGenContext::Get().env();
+/** Resolves the index scan strategy and calls the appropriate codegen function. */
+template<idx::IndexMethod IndexMethod, typename Index, sql_type SqlT>
+void index_scan_resolve_strategy(const Index &index, const index_scan_bounds_t &bounds, const Match<IndexScan<IndexMethod>> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    if (options::index_scan_strategy == option_configs::IndexScanStrategy::COMPILATION) {
+        index_scan_codegen_compilation<IndexMethod, Index, SqlT>(index, bounds, M, std::move(setup), std::move(pipeline), std::move(teardown));
+    } else if (options::index_scan_strategy == option_configs::IndexScanStrategy::INTERPRETATION) {
+        index_scan_codegen_interpretation<IndexMethod, Index>(index, bounds, M, std::move(setup), std::move(pipeline), std::move(teardown));
+    } else if (options::index_scan_strategy == option_configs::IndexScanStrategy::HYBRID) {
+        index_scan_codegen_hybrid<IndexMethod, Index, SqlT>(index, bounds, M, std::move(setup), std::move(pipeline), std::move(teardown));
+    } else {
+        M_unreachable("invalid index access strategy");
+    }
+}
 
-    /*----- Process each computed group. -----*/
-    setup_t(std::move(setup), [&](){ ht->setup(); })();
-    ht->for_each([&, pipeline=std::move(pipeline)](HashTable::const_entry_t entry){
-        /*----- Compute key schema to detect duplicated keys. -----*/
-        Schema key_schema;
-        for (std::size_t i = 0; i < num_keys; ++i) {
-            auto &e = M.grouping.schema()[i];
-            key_schema.add(e.id, e.type, e.constraints);
-        }
+/** Resolves the index method and calls the appropriate codegen function. */
+template<idx::IndexMethod IndexMethod, typename AttrT, sql_type SqlT>
+void index_scan_resolve_index_method(const index_scan_bounds_t &bounds, const Match<IndexScan<IndexMethod>> &M,
+                                     setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    /*----- Lookup index. -----*/
+    Catalog &C = Catalog::Get();
+    auto &DB = C.get_database_in_use();
+    auto &table_name = M.scan.store().table().name();
+    auto &attribute_name = bounds.attribute.id.name;
+    auto &index_base = DB.get_index(table_name, attribute_name, IndexMethod);
 
-        /*----- Add computed group tuples to current environment. ----*/
-        for (auto &e : M.grouping.schema().deduplicate()) {
-            try {
-                key_schema.find(e.id);
-            } catch (invalid_argument&) {
-                continue; // skip duplicated keys since they must not be used afterwards
-            }
+    /*----- Resolve index type. -----*/
+    if constexpr(IndexMethod == idx::IndexMethod::Array and requires { typename idx::ArrayIndex<AttrT>; }) {
+        auto &index = as<const idx::ArrayIndex<AttrT>>(index_base);
+        index_scan_resolve_strategy<IndexMethod, const idx::ArrayIndex<AttrT>, SqlT>(
+            index, bounds, M, std::move(setup), std::move(pipeline), std::move(teardown)
+        );
+    } else if constexpr(IndexMethod == idx::IndexMethod::Rmi and requires { typename idx::RecursiveModelIndex<AttrT>; }) {
+        auto &index = as<const idx::RecursiveModelIndex<AttrT>>(index_base);
+        index_scan_resolve_strategy<IndexMethod, const idx::RecursiveModelIndex<AttrT>, SqlT>(
+            index, bounds, M, std::move(setup), std::move(pipeline), std::move(teardown)
+        );
+    } else {
+        M_unreachable("invalid index method");
+    }
+}
 
-            if (auto it = avg_aggregates.find(e.id);
-                it != avg_aggregates.end() and not it->second.compute_running_avg)
-            { // AVG aggregates which is not yet computed, divide computed sum with computed count
-                auto &avg_info = it->second;
-                auto sum = std::visit(overloaded {
-                    [&]<sql_type T>(HashTable::const_reference_t<T> &&r) -> _Doublex1
-                    requires (std::same_as<T, _I64x1> or std::same_as<T, _Doublex1>) {
-                        return T(r).template to<double>();
-                    },
-                    [](auto&&) -> _Doublex1 { M_unreachable("invalid type"); },
-                    [](std::monostate&&) -> _Doublex1 { M_unreachable("invalid reference"); },
-                }, entry.get(avg_info.sum));
-                auto count = _I64x1(entry.get<_I64x1>(avg_info.running_count)).insist_not_null().to<double>();
-                auto avg = sum / count;
-                if (avg.can_be_null()) {
-                    _Var<Doublex1> var(avg); // introduce variable s.t. uses only load from it
-                    env.add(e.id, var);
-                } else {
-                    /* introduce variable w/o NULL bit s.t. uses only load from it */
-                    Var<Doublex1> var(avg.insist_not_null());
-                    env.add(e.id, _Doublex1(var));
-                }
-            } else { // part of key or already computed aggregate
-                std::visit(overloaded {
-                    [&]<typename T>(HashTable::const_reference_t<Expr<T>> &&r) -> void {
-                        Expr<T> value = r;
-                        if (value.can_be_null()) {
-                            Var<Expr<T>> var(value); // introduce variable s.t. uses only load from it
-                            env.add(e.id, var);
-                        } else {
-                            /* introduce variable w/o NULL bit s.t. uses only load from it */
-                            Var<PrimitiveExpr<T>> var(value.insist_not_null());
-                            env.add(e.id, Expr<T>(var));
-                        }
-                    },
-                    [&](HashTable::const_reference_t<NChar> &&r) -> void {
-                        NChar value(r);
-                        Var<Ptr<Charx1>> var(value.val()); // introduce variable s.t. uses only load from it
-                        env.add(e.id, NChar(var, value.can_be_null(), value.length(),
-                                            value.guarantees_terminating_nul()));
-                    },
-                    [](std::monostate&&) -> void { M_unreachable("invalid reference"); },
-                }, entry.get(e.id)); // do not extract to be able to access for not-yet-computed AVG aggregates
+/** Resolves the attribute type and calls the appropriate codegen function. */
+template<idx::IndexMethod IndexMethod>
+void index_scan_resolve_attribute_type(const Match<IndexScan<IndexMethod>> &M,
+                                       setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    /*----- Extract bounds from CNF. -----*/
+    auto &cnf = M.filter.filter();
+    auto bounds = extract_index_scan_bounds(cnf);
+
+    /*----- Resolve attribute type. -----*/
+#define RESOLVE_INDEX_METHOD(ATTRTYPE, SQLTYPE) \
+    index_scan_resolve_index_method<IndexMethod, ATTRTYPE, SQLTYPE>(bounds, M, std::move(setup), std::move(pipeline), std::move(teardown))
+
+    visit(overloaded {
+        [&](const Boolean&) { RESOLVE_INDEX_METHOD(bool, _Boolx1); },
+        [&](const Numeric &n) {
+            switch (n.kind) {
+                case Numeric::N_Int:
+                case Numeric::N_Decimal:
+                    switch (n.size()) {
+                        default: M_unreachable("invalid size");
+                        case  8: RESOLVE_INDEX_METHOD(int8_t,   _I8x1); break;
+                        case 16: RESOLVE_INDEX_METHOD(int16_t, _I16x1); break;
+                        case 32: RESOLVE_INDEX_METHOD(int32_t, _I32x1); break;
+                        case 64: RESOLVE_INDEX_METHOD(int64_t, _I64x1); break;
+                    }
+                    break;
+                case Numeric::N_Float:
+                    switch (n.size()) {
+                        default: M_unreachable("invalid size");
+                        case 32: RESOLVE_INDEX_METHOD(float,   _Floatx1); break;
+                        case 64: RESOLVE_INDEX_METHOD(double, _Doublex1); break;
+                    }
+                    break;
             }
-        }
+        },
+        [&](const CharacterSequence&) { RESOLVE_INDEX_METHOD(const char*, NChar); },
+        [&](const Date&) { RESOLVE_INDEX_METHOD(int32_t, _I32x1); },
+        [&](const DateTime&) { RESOLVE_INDEX_METHOD(int64_t, _I64x1); },
+        [](auto&&) { M_unreachable("invalid type"); },
+    }, *bounds.attribute.type);
 
-        /*----- Resume pipeline. -----*/
-        pipeline();
-    });
-    teardown_t(std::move(teardown), [&](){ ht->teardown(); })();
+#undef RESOLVE_INDEX_METHOD
 }
 
-ConditionSet OrderedGrouping::pre_condition(
-    std::size_t child_idx,
-    const std::tuple<const GroupingOperator*> &partial_inner_nodes)
+template<idx::IndexMethod IndexMethod>
+void IndexScan<IndexMethod>::execute(const Match<IndexScan<IndexMethod>> &M,
+                                     setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    auto &schema = M.scan.schema();
+    M_insist(schema == schema.drop_constants().deduplicate(), "Schema of `ScanOperator` must neither contain NULL nor duplicates");
+
+    /*----- Index scans query the index at compile time or register it in the Wasm context, hence the module must not
+     * be reused for later executions. -----*/
+    CodeGenContext::Get().mark_module_not_reusable();
+
+    auto &table = M.scan.store().table();
+    M_insist(not table.layout().is_finite(), "layout for `wasm::IndexScan` must be infinite");
+
+    /** Generating code for an index scan requires resolving the following:
+     * 1. attribute type of the indexed attribute,
+     * 2. index method of the index used by the operator,
+     * 3. strategy used for performing the index scan.
+     * We avoid code duplication by handling each step in a separate function and forwarding the result via template
+     * arguments to the next function. */
+    index_scan_resolve_attribute_type(M, std::move(setup), std::move(pipeline), std::move(teardown));
+}
+
+
+/*======================================================================================================================
+ * Filter
+ *====================================================================================================================*/
+
+template<bool Predicated>
+ConditionSet Filter<Predicated>::pre_condition(std::size_t child_idx, const std::tuple<const FilterOperator*>&)
 {
      M_insist(child_idx == 0);
 
     ConditionSet pre_cond;
 
-    /*----- Ordered grouping needs the data sorted on the grouping key (in either order). -----*/
-    Sortedness::order_t orders;
-    for (auto &p : std::get<0>(partial_inner_nodes)->group_by()) {
-        Schema::Identifier id(p.first);
-        if (orders.find(id) == orders.cend())
-            orders.add(std::move(id), Sortedness::O_UNDEF);
+    if constexpr (not Predicated) {
+        /*----- Branching filter does not support SIMD. -----*/
+        pre_cond.add_condition(NoSIMD());
     }
-    pre_cond.add_condition(Sortedness(std::move(orders)));
-
-    /*----- Ordered grouping does not support SIMD. -----*/
-    pre_cond.add_condition(NoSIMD());
 
     return pre_cond;
 }
 
-double OrderedGrouping::cost(const Match<OrderedGrouping> &M)
+template<bool Predicated>
+ConditionSet Filter<Predicated>::adapt_post_condition(const Match<Filter>&, const ConditionSet &post_cond_child)
 {
-    return 1.0 * M.child->get_matched_root().info().estimated_cardinality;
-}
+    ConditionSet post_cond(post_cond_child);
 
-ConditionSet OrderedGrouping::adapt_post_condition(const Match<OrderedGrouping> &M, const ConditionSet &post_cond_child)
-{
-    ConditionSet post_cond;
-
-    /*----- Ordered grouping does not introduce predication. -----*/
-    post_cond.add_condition(Predicated(false));
-
-    /*----- Preserve order of child for grouping keys. -----*/
-    Sortedness::order_t orders;
-    const auto &sortedness_child = post_cond_child.get_condition<Sortedness>();
-    for (auto &[expr, alias] : M.grouping.group_by()) {
-        auto it = sortedness_child.orders().find(Schema::Identifier(expr));
-        M_insist(it != sortedness_child.orders().cend());
-        Schema::Identifier id = alias.has_value() ? Schema::Identifier(alias.assert_not_none())
-                                                  : Schema::Identifier(expr);
-        if (orders.find(id) == orders.cend())
-            orders.add(std::move(id), it->second); // drop duplicate since it must not be used afterwards
-    }
-    post_cond.add_condition(Sortedness(std::move(orders)));
-
-    /*----- Ordered grouping does not introduce SIMD. -----*/
-    post_cond.add_condition(NoSIMD());
+    if constexpr (Predicated) {
+        /*----- Predicated filter introduces predication. -----*/
+        post_cond.add_or_replace_condition(m::Predicated(true));
+    }
 
     return post_cond;
 }
 
-void OrderedGrouping::execute(const Match<OrderedGrouping> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
+template<bool Predicated>
+double Filter<Predicated>::cost(const Match<Filter> &M)
 {
-    Environment results; ///< stores current result tuple
-    const auto num_keys = M.grouping.group_by().size();
+    const cnf::CNF &cond = M.filter.filter();
+    const unsigned cost = std::accumulate(cond.cbegin(), cond.cend(), 0U, [](unsigned cost, const cnf::Clause &clause) {
+        return cost + clause.size();
+    });
+    return cost;
+}
 
-    /*----- Compute key schema to detect duplicated keys. -----*/
-    Schema key_schema;
-    for (std::size_t i = 0; i < num_keys; ++i) {
-        auto &e = M.grouping.schema()[i];
-        key_schema.add(e.id, e.type, e.constraints);
-    }
+template<bool Predicated>
+void Filter<Predicated>::execute(const Match<Filter> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    /*----- Set minimal number of SIMD lanes preferred to get fully utilized SIMD vectors for the filter condition. --*/
+    CodeGenContext::Get().update_num_simd_lanes_preferred(16); // set own preference
 
-    /*----- Compute information about aggregates, especially about AVG aggregates. -----*/
-    auto p = compute_aggregate_info(M.grouping.aggregates(), M.grouping.schema(), num_keys);
-    const auto &aggregates = p.first;
-    const auto &avg_aggregates = p.second;
+    /*----- Execute filter. -----*/
+    M.child->execute(
+        /* setup=    */ std::move(setup),
+        /* pipeline= */ [&, pipeline=std::move(pipeline)](){
+            std::vector<std::reference_wrapper<const ast::Expr>> predicates;
+            for (auto &clause : M.filter.filter()) {
+                for (auto pred : clause)
+                    predicates.emplace_back(*pred);
+            }
+            bind_common_subexpressions(CodeGenContext::Get().env(), predicates);
 
-    /*----- Forward declare function to emit a group tuple in the current environment and resume the pipeline. -----*/
-    FunctionProxy<void(void)> emit_group_and_resume_pipeline("emit_group_and_resume_pipeline");
+            if constexpr (Predicated) {
+                CodeGenContext::Get().env().add_predicate(M.filter.filter());
+                pipeline();
+            } else {
+                M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes");
+                IF (CodeGenContext::Get().env().compile<_Boolx1>(M.filter.filter()).is_true_and_not_null()) {
+                    pipeline();
+                };
+            }
+        },
+        /* teardown= */ std::move(teardown)
+    );
+}
 
-    std::optional<Var<Boolx1>> first_iteration; ///< variable to *locally* check for first iteration
-    ///> *global* flag backup since the following code may be called multiple times
-    Global<Boolx1> first_iteration_backup(true);
 
-    using agg_t = agg_t_<false>;
-    using agg_backup_t = agg_t_<true>;
-    agg_t agg_values[aggregates.size()]; ///< *local* values of the computed aggregates
-    agg_backup_t agg_value_backups[aggregates.size()]; ///< *global* value backups of the computed aggregates
+/*======================================================================================================================
+ * LazyDisjunctiveFilter
+ *====================================================================================================================*/
 
-    using key_t = key_t_<false>;
-    using key_backup_t = key_t_<true>;
-    key_t key_values[num_keys]; ///< *local* values of the computed keys
-    key_backup_t key_value_backups[num_keys]; ///< *global* value backups of the computed keys
+ConditionSet LazyDisjunctiveFilter::pre_condition(std::size_t child_idx, const std::tuple<const FilterOperator*>&)
+{
+     M_insist(child_idx == 0);
 
-    auto store_locals_to_globals = [&](){
-        /*----- Store local aggregate values to globals to access them in other function. -----*/
-        for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
-            auto &info = aggregates[idx];
+    ConditionSet pre_cond;
 
-            switch (info.fnid) {
-                default:
-                    M_unreachable("unsupported aggregate function");
-                case m::Function::FN_MIN:
-                case m::Function::FN_MAX: {
-                    auto min_max = [&]<typename T>() {
-                        auto &[min_max, is_null] = *M_notnull((
-                            std::get_if<std::pair<Var<PrimitiveExpr<T>>, std::optional<Var<Boolx1>>>>(&agg_values[idx])
-                        ));
-                        auto &[min_max_backup, is_null_backup] = *M_notnull((
-                            std::get_if<std::pair<Global<PrimitiveExpr<T>>,
-                                                  std::optional<Global<Boolx1>>>>(&agg_value_backups[idx])
-                        ));
-                        M_insist(bool(is_null) == bool(is_null_backup));
+    /*----- Lazy disjunctive filter does not support SIMD. -----*/
+    pre_cond.add_condition(NoSIMD());
 
-                        min_max_backup = min_max;
-                        if (is_null)
-                            *is_null_backup = *is_null;
-                    };
-                    auto &n = as<const Numeric>(*info.entry.type);
-                    switch (n.kind) {
-                        case Numeric::N_Int:
-                        case Numeric::N_Decimal:
-                            switch (n.size()) {
-                                default: M_unreachable("invalid size");
-                                case  8: min_max.template operator()<int8_t >(); break;
-                                case 16: min_max.template operator()<int16_t>(); break;
-                                case 32: min_max.template operator()<int32_t>(); break;
-                                case 64: min_max.template operator()<int64_t>(); break;
-                            }
-                            break;
-                        case Numeric::N_Float:
-                            if (n.size() <= 32)
-                                min_max.template operator()<float>();
-                            else
-                                min_max.template operator()<double>();
+    return pre_cond;
+}
+
+double LazyDisjunctiveFilter::cost(const Match<LazyDisjunctiveFilter> &M)
+{
+    const cnf::CNF &cond = M.filter.filter();
+    M_insist(cond.size() == 1, "disjunctive filter condition must be a single clause");
+    return cond[0].size() / 2.0; // on avg. half the number of predicates in the clause XXX consider selectivities
+}
+
+void LazyDisjunctiveFilter::execute(const Match<LazyDisjunctiveFilter> &M, setup_t setup, pipeline_t pipeline,
+                                    teardown_t teardown)
+{
+    const cnf::Clause &clause = M.filter.filter()[0];
+
+    M.child->execute(
+        /* setup=    */ std::move(setup),
+        /* pipeline= */ [&, pipeline=std::move(pipeline)](){
+            M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes");
+            BLOCK(lazy_disjunctive_filter)
+            {
+                BLOCK(lazy_disjunctive_filter_then)
+                {
+                    for (const cnf::Predicate &pred : clause) {
+                        auto cond = CodeGenContext::Get().env().compile<_Boolx1>(*pred);
+                        if (pred.negative())
+                            GOTO(cond.is_false_and_not_null(), lazy_disjunctive_filter_then); // break to remainder of pipline
+                        else
+                            GOTO(cond.is_true_and_not_null(), lazy_disjunctive_filter_then); // break to remainder of pipline
                     }
-                    break;
+                    GOTO(lazy_disjunctive_filter); // skip pipeline
                 }
-                case m::Function::FN_AVG: {
-                    auto &[avg, is_null] = *M_notnull((
-                        std::get_if<std::pair<Var<Doublex1>, std::optional<Var<Boolx1>>>>(&agg_values[idx])
-                    ));
-                    auto &[avg_backup, is_null_backup] = *M_notnull((
-                        std::get_if<std::pair<Global<Doublex1>, std::optional<Global<Boolx1>>>>(&agg_value_backups[idx])
-                    ));
-                    M_insist(bool(is_null) == bool(is_null_backup));
+                pipeline();
+            }
+        },
+        /* teardown= */ std::move(teardown)
+    );
+}
 
-                    avg_backup = avg;
-                    if (is_null)
-                        *is_null_backup = *is_null;
 
-                    break;
-                }
-                case m::Function::FN_SUM: {
-                    M_insist(info.args.size() == 1, "SUM aggregate function expects exactly one argument");
-                    const auto &arg = *info.args[0];
+/*======================================================================================================================
+ * AdaptiveFilter
+ *====================================================================================================================*/
 
-                    auto sum = [&]<typename T>() {
-                        auto &[sum, is_null] = *M_notnull((
-                            std::get_if<std::pair<Var<PrimitiveExpr<T>>, std::optional<Var<Boolx1>>>>(&agg_values[idx])
-                        ));
-                        auto &[sum_backup, is_null_backup] = *M_notnull((
-                            std::get_if<std::pair<Global<PrimitiveExpr<T>>,
-                                                  std::optional<Global<Boolx1>>>>(&agg_value_backups[idx])
-                        ));
-                        M_insist(bool(is_null) == bool(is_null_backup));
+ConditionSet AdaptiveFilter::pre_condition(std::size_t child_idx, const std::tuple<const FilterOperator*>&)
+{
+     M_insist(child_idx == 0);
 
-                        sum_backup = sum;
-                        if (is_null)
-                            *is_null_backup = *is_null;
-                    };
-                    auto &n = as<const Numeric>(*info.entry.type);
-                    switch (n.kind) {
-                        case Numeric::N_Int:
-                        case Numeric::N_Decimal:
-                            switch (n.size()) {
-                                default: M_unreachable("invalid size");
-                                case  8: sum.template operator()<int8_t >(); break;
-                                case 16: sum.template operator()<int16_t>(); break;
-                                case 32: sum.template operator()<int32_t>(); break;
-                                case 64: sum.template operator()<int64_t>(); break;
-                            }
-                            break;
-                        case Numeric::N_Float:
-                            if (n.size() <= 32)
-                                sum.template operator()<float>();
-                            else
-                                sum.template operator()<double>();
-                    }
-                    break;
-                }
-                case m::Function::FN_COUNT: {
-                    auto &count = *M_notnull(std::get_if<Var<I64x1>>(&agg_values[idx]));
-                    auto &count_backup = *M_notnull(std::get_if<Global<I64x1>>(&agg_value_backups[idx]));
+    ConditionSet pre_cond;
 
-                    count_backup = count;
+    /*----- Adaptive filter does not support SIMD since it may branch. -----*/
+    pre_cond.add_condition(NoSIMD());
 
-                    break;
-                }
-            }
-        }
+    return pre_cond;
+}
 
-        /*----- Store local key values to globals to access them in other function. -----*/
-        auto store = [&]<typename T>(std::size_t idx) {
-            auto &[key, is_null] = *M_notnull((
-                std::get_if<std::pair<Var<PrimitiveExpr<T>>, std::optional<Var<Boolx1>>>>(&key_values[idx])
-            ));
-            auto &[key_backup, is_null_backup] = *M_notnull((
-                std::get_if<std::pair<Global<PrimitiveExpr<T>>, std::optional<Global<Boolx1>>>>(&key_value_backups[idx])
-            ));
-            M_insist(bool(is_null) == bool(is_null_backup));
+double AdaptiveFilter::cost(const Match<AdaptiveFilter> &M)
+{
+    const cnf::CNF &cond = M.filter.filter();
+    const unsigned cost = std::accumulate(cond.cbegin(), cond.cend(), 0U, [](unsigned cost, const cnf::Clause &clause) {
+        return cost + clause.size();
+    });
+    /* Prefer the adaptive filter over the statically chosen strategies of equal cost since it does not depend on the
+     * estimated selectivity. */
+    return 0.9 * cost;
+}
 
-            key_backup = key;
-            if (is_null)
-                *is_null_backup = *is_null;
-        };
-        for (std::size_t idx = 0; idx < num_keys; ++idx) {
-            visit(overloaded{
-                [&](const Boolean&) { store.template operator()<bool>(idx); },
-                [&](const Numeric &n) {
-                    switch (n.kind) {
-                        case Numeric::N_Int:
-                        case Numeric::N_Decimal:
-                            switch (n.size()) {
-                                default: M_unreachable("invalid size");
-                                case  8: store.template operator()<int8_t >(idx); break;
-                                case 16: store.template operator()<int16_t>(idx); break;
-                                case 32: store.template operator()<int32_t>(idx); break;
-                                case 64: store.template operator()<int64_t>(idx); break;
-                            }
-                            break;
-                        case Numeric::N_Float:
-                            if (n.size() <= 32)
-                                store.template operator()<float>(idx);
-                            else
-                                store.template operator()<double>(idx);
-                    }
-                },
-                [&](const CharacterSequence &cs) {
-                    auto &key = *M_notnull(std::get_if<Var<Ptr<Charx1>>>(&key_values[idx]));
-                    auto &key_backup = *M_notnull(std::get_if<Global<Ptr<Charx1>>>(&key_value_backups[idx]));
+void AdaptiveFilter::execute(const Match<AdaptiveFilter> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    using Strategies = OperatorSelectionStrategies;
+    auto &state = Strategies::Get().state(M.filter);
 
-                    key_backup = key;
-                },
-                [&](const Date&) { store.template operator()<int32_t>(idx); },
-                [&](const DateTime&) { store.template operator()<int64_t>(idx); },
-                [](auto&&) { M_unreachable("invalid type"); },
-            }, *M.grouping.schema()[idx].type);
-        }
-    };
+    /* variables to *locally* keep the sampling state, backed up by the *global* state since the following code may be
+     * called multiple times */
+    std::optional<Var<U32x1>> mode, num_sampled, num_passed;
 
     M.child->execute(
-        /* setup=    */ setup_t::Make_Without_Parent([&](){
-            first_iteration.emplace(first_iteration_backup);
+        /* setup=    */ setup_t(std::move(setup), [&](){
+            mode.emplace(state.mode);
+            num_sampled.emplace(state.num_sampled);
+            num_passed.emplace(state.num_passed);
+        }),
+        /* pipeline= */ [&, pipeline=std::move(pipeline)](){
+            M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes");
+            M_insist(bool(mode) and bool(num_sampled) and bool(num_passed));
+
+            IF (*mode == uint32_t(Strategies::M_Predicated)) {
+                /*----- Emit the pipeline with predication in a copy of the current environment since the pipeline
+                 * is emitted a second time for branching below. -----*/
+                auto &outer = CodeGenContext::Get().env();
+                Environment env;
+                env.add(outer);
+                if (outer.predicated())
+                    env.add_predicate(outer.get_predicate());
+                auto S = CodeGenContext::Get().scoped_environment(std::move(env));
+                CodeGenContext::Get().env().add_predicate(M.filter.filter());
+                pipeline();
+            } ELSE {
+                const Var<Boolx1> passed(
+                    CodeGenContext::Get().env().compile<_Boolx1>(M.filter.filter()).is_true_and_not_null()
+                );
 
-            /*----- Initialize aggregates and their backups. -----*/
-            for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
-                auto &info = aggregates[idx];
-                const bool nullable = info.entry.nullable();
+                /*----- Sample the selectivity and decide the strategy once the sample is complete.  Predication is
+                 * used if the selectivity is within [25%, 75%], where branches are mispredicted most often. -----*/
+                IF (*mode == uint32_t(Strategies::M_Sampling)) {
+                    *num_sampled += 1U;
+                    *num_passed += passed.to<uint32_t>();
+                    IF (*num_sampled == SAMPLE_SIZE) {
+                        IF (*num_passed >= SAMPLE_SIZE / 4 and *num_passed <= SAMPLE_SIZE - SAMPLE_SIZE / 4) {
+                            *mode = uint32_t(Strategies::M_Predicated);
+                        } ELSE {
+                            *mode = uint32_t(Strategies::M_Branching);
+                        };
+                    };
+                };
 
-                bool is_min = false; ///< flag to indicate whether aggregate function is MIN
-                switch (info.fnid) {
-                    default:
-                        M_unreachable("unsupported aggregate function");
-                    case m::Function::FN_MIN:
-                        is_min = true; // set flag and delegate to MAX case
-                    case m::Function::FN_MAX: {
-                        auto min_max = [&]<typename T>() {
-                            auto neutral = is_min ? std::numeric_limits<T>::max()
-                                                  : std::numeric_limits<T>::lowest();
+                IF (passed) {
+                    pipeline();
+                };
+            };
+        },
+        /* teardown= */ teardown_t(std::move(teardown), [&](){
+            M_insist(bool(mode) and bool(num_sampled) and bool(num_passed));
+            state.mode = *mode;
+            state.num_sampled = *num_sampled;
+            state.num_passed = *num_passed;
+            mode.reset();
+            num_sampled.reset();
+            num_passed.reset();
+        })
+    );
+}
 
-                            Var<PrimitiveExpr<T>> min_max;
-                            Global<PrimitiveExpr<T>> min_max_backup(neutral); // initialize with neutral element +inf or -inf
-                            std::optional<Var<Boolx1>> is_null;
-                            std::optional<Global<Boolx1>> is_null_backup;
 
-                            /*----- Set local aggregate variables to global backups. -----*/
-                            min_max = min_max_backup;
-                            if (nullable) {
-                                is_null_backup.emplace(true); // MIN/MAX is initially NULL
-                                is_null.emplace(*is_null_backup);
-                            }
+/*======================================================================================================================
+ * Projection
+ *====================================================================================================================*/
 
-                            /*----- Add global aggregate to result environment to access it in other function. -----*/
-                            if (nullable)
-                                results.add(info.entry.id, Select(*is_null_backup, Expr<T>::Null(), min_max_backup));
-                            else
-                                results.add(info.entry.id, min_max_backup.val());
+ConditionSet Projection::pre_condition(
+    std::size_t child_idx,
+    const std::tuple<const ProjectionOperator*> &partial_inner_nodes)
+{
+     M_insist(child_idx == 0);
 
-                            /*----- Move aggregate variables to access them later. ----*/
-                            new (&agg_values[idx]) agg_t(std::make_pair(std::move(min_max), std::move(is_null)));
-                            new (&agg_value_backups[idx]) agg_backup_t(std::make_pair(
-                                std::move(min_max_backup), std::move(is_null_backup)
-                            ));
-                        };
-                        auto &n = as<const Numeric>(*info.entry.type);
-                        switch (n.kind) {
-                            case Numeric::N_Int:
-                            case Numeric::N_Decimal:
-                                switch (n.size()) {
-                                    default: M_unreachable("invalid size");
-                                    case  8: min_max.template operator()<int8_t >(); break;
-                                    case 16: min_max.template operator()<int16_t>(); break;
-                                    case 32: min_max.template operator()<int32_t>(); break;
-                                    case 64: min_max.template operator()<int64_t>(); break;
-                                }
-                                break;
-                            case Numeric::N_Float:
-                                if (n.size() <= 32)
-                                    min_max.template operator()<float>();
-                                else
-                                    min_max.template operator()<double>();
-                        }
-                        break;
-                    }
-                    case m::Function::FN_AVG: {
-                        Var<Doublex1> avg;
-                        Global<Doublex1> avg_backup(0.0); // initialize with neutral element 0
-                        std::optional<Var<Boolx1>> is_null;
-                        std::optional<Global<Boolx1>> is_null_backup;
+    ConditionSet pre_cond;
 
-                        /*----- Set local aggregate variables to global backups. -----*/
-                        avg = avg_backup;
-                        if (nullable) {
-                            is_null_backup.emplace(true); // AVG is initially NULL
-                            is_null.emplace(*is_null_backup);
-                        }
+    auto &projection = *std::get<0>(partial_inner_nodes);
 
-                        /*----- Add global aggregate to result environment to access it in other function. -----*/
-                        if (nullable)
-                            results.add(info.entry.id, Select(*is_null_backup, _Doublex1::Null(), avg_backup));
-                        else
-                            results.add(info.entry.id, avg_backup.val());
+    if (not projection.children().empty()) { // projections starting a pipeline produce only a single tuple, i.e. no SIMD
+        /*----- Projection does only support SIMD if all expressions can be computed using SIMD instructions. -----*/
+        auto is_simd_computable = [](const ast::Expr &e){
+            bool simd_computable = true;
+            visit(overloaded {
+                [&](const ast::BinaryExpr &b) -> void {
+                    if (b.lhs->type()->is_character_sequence() or b.rhs->type()->is_character_sequence()) {
+                        simd_computable = false; // string operations are not SIMDfiable
+                        throw visit_stop_recursion(); // abort recursion
+                    }
+                    if (b.common_operand_type->is_integral() and b.op().type == TK_SLASH) {
+                        simd_computable = false; // integer division is not SIMDfiable
+                        throw visit_stop_recursion(); // abort recursion
+                    }
+                    if (b.op().type == TK_PERCENT) {
+                        simd_computable = false; // modulo is not SIMDfiable
+                        throw visit_stop_recursion(); // abort recursion
+                    }
+                },
+                [](auto&) -> void {
+                    /* designators, constants, unary expressions, NULL(), INT(), already computed aggregates and results
+                     * of a nested query are SIMDfiable; nothing to be done */
+                },
+            }, e, m::tag<m::ast::ConstPreOrderExprVisitor>());
+            return simd_computable;
+        };
+        auto pred = [&](auto &p){ return not is_simd_computable(p.first); };
+        if (std::any_of(projection.projections().cbegin(), projection.projections().cend(), pred))
+            pre_cond.add_condition(NoSIMD());
+    }
 
-                        /*----- Move aggregate variables to access them later. ----*/
-                        new (&agg_values[idx]) agg_t(std::make_pair(std::move(avg), std::move(is_null)));
-                        new (&agg_value_backups[idx]) agg_backup_t(std::make_pair(
-                            std::move(avg_backup), std::move(is_null_backup)
-                        ));
+    return pre_cond;
+}
 
-                        break;
-                    }
-                    case m::Function::FN_SUM: {
-                        auto sum = [&]<typename T>() {
-                            Var<PrimitiveExpr<T>> sum;
-                            Global<PrimitiveExpr<T>> sum_backup(T(0)); // initialize with neutral element 0
-                            std::optional<Var<Boolx1>> is_null;
-                            std::optional<Global<Boolx1>> is_null_backup;
+ConditionSet Projection::adapt_post_condition(const Match<Projection> &M, const ConditionSet &post_cond_child)
+{
+    ConditionSet post_cond(post_cond_child);
 
-                            /*----- Set local aggregate variables to global backups. -----*/
-                            sum = sum_backup;
-                            if (nullable) {
-                                is_null_backup.emplace(true); // SUM is initially NULL
-                                is_null.emplace(*is_null_backup);
-                            }
+    /*----- Project and rename in duplicated post condition. -----*/
+    M_insist(M.projection.projections().size() == M.projection.schema().num_entries(),
+             "projections must match the operator's schema");
+    std::vector<std::pair<Schema::Identifier, Schema::Identifier>> old2new;
+    auto p = M.projection.projections().begin();
+    for (auto &e: M.projection.schema()) {
+        auto pred = [&e](const auto &p) { return p.second == e.id; };
+        if (std::find_if(old2new.cbegin(), old2new.cend(), pred) == old2new.cend()) {
+            M_insist(p != M.projection.projections().end());
+            old2new.emplace_back(Schema::Identifier(p->first.get()), e.id);
+        }
+        ++p;
+    }
+    post_cond.project_and_rename(old2new);
 
-                            /*----- Add global aggregate to result environment to access it in other function. -----*/
-                            if (nullable)
-                                results.add(info.entry.id, Select(*is_null_backup, Expr<T>::Null(), sum_backup));
-                            else
-                                results.add(info.entry.id, sum_backup.val());
+    if (not M.child) {
+        /*----- Leaf projection does not introduce predication. -----*/
+        post_cond.add_condition(Predicated(false));
 
-                            /*----- Move aggregate variables to access them later. ----*/
-                            new (&agg_values[idx]) agg_t(std::make_pair(std::move(sum), std::move(is_null)));
-                            new (&agg_value_backups[idx]) agg_backup_t(std::make_pair(
-                                std::move(sum_backup), std::move(is_null_backup)
-                            ));
-                        };
-                        auto &n = as<const Numeric>(*info.entry.type);
-                        switch (n.kind) {
-                            case Numeric::N_Int:
-                            case Numeric::N_Decimal:
-                                switch (n.size()) {
-                                    default: M_unreachable("invalid size");
-                                    case  8: sum.template operator()<int8_t >(); break;
-                                    case 16: sum.template operator()<int16_t>(); break;
-                                    case 32: sum.template operator()<int32_t>(); break;
-                                    case 64: sum.template operator()<int64_t>(); break;
-                                }
-                                break;
-                            case Numeric::N_Float:
-                                if (n.size() <= 32)
-                                    sum.template operator()<float>();
-                                else
-                                    sum.template operator()<double>();
-                        }
-                        break;
-                    }
-                    case m::Function::FN_COUNT: {
-                        Var<I64x1> count;
-                        Global<I64x1> count_backup(0); // initialize with neutral element 0
-                        /* no `is_null` variables needed since COUNT will not be NULL */
+        /*----- Leaf projection does not introduce SIMD. -----*/
+        post_cond.add_condition(NoSIMD());
+    }
 
-                        /*----- Set local aggregate variable to global backup. -----*/
-                        count = count_backup;
+    return post_cond;
+}
 
-                        /*----- Add global aggregate to result environment to access it in other function. -----*/
-                        results.add(info.entry.id, count_backup.val());
+void Projection::execute(const Match<Projection> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    auto execute_projection = [&, pipeline=std::move(pipeline)](){
+        auto &old_env = CodeGenContext::Get().env();
+        Environment new_env; // fresh environment
 
-                        /*----- Move aggregate variables to access them later. ----*/
-                        new (&agg_values[idx]) agg_t(std::move(count));
-                        new (&agg_value_backups[idx]) agg_backup_t(std::move(count_backup));
+        /*----- If predication is used, move predicate to newly created environment. -----*/
+        if (old_env.predicated())
+            new_env.add_predicate(old_env.extract_predicate());
 
-                        break;
-                    }
-                }
+        /*----- Bind common subexpressions of the projections to compile. -----*/
+        M_insist(M.projection.projections().size() == M.projection.schema().num_entries(),
+                 "projections must match the operator's schema");
+        {
+            std::vector<std::reference_wrapper<const ast::Expr>> exprs;
+            auto p = M.projection.projections().begin();
+            for (auto &e : M.projection.schema()) {
+                if (not old_env.has(e.id) and not e.id.is_constant())
+                    exprs.emplace_back(p->first);
+                ++p;
             }
+            bind_common_subexpressions(old_env, exprs);
+        }
 
-            /*----- Initialize keys and their backups. -----*/
-            auto init = [&]<typename T>(std::size_t idx) {
-                const bool nullable = M.grouping.schema()[idx].nullable();
+        /*----- Add projections to newly created environment. -----*/
+        auto p = M.projection.projections().begin();
+        for (auto &e: M.projection.schema()) {
+            if (not new_env.has(e.id) and not e.id.is_constant()) { // no duplicate and no constant
+                if (old_env.has(e.id)) {
+                    /*----- Migrate compiled expression to new context. ------*/
+                    new_env.add(e.id, old_env.get(e.id)); // to retain `e.id` for later compilation of expressions
+                } else {
+                    /*----- Compile expression. -----*/
+                    M_insist(p != M.projection.projections().end());
+                    std::visit(overloaded {
+                        [&]<typename T, std::size_t L>(Expr<T, L> value) -> void {
+                            if (value.can_be_null()) {
+                                Var<Expr<T, L>> var(value); // introduce variable s.t. uses only load from it
+                                new_env.add(e.id, var);
+                            } else {
+                                /* introduce variable w/o NULL bit s.t. uses only load from it */
+                                Var<PrimitiveExpr<T, L>> var(value.insist_not_null());
+                                new_env.add(e.id, Expr<T, L>(var));
+                            }
+                        },
+                        [&](NChar value) -> void {
+                            Var<Ptr<Charx1>> var(value.val()); // introduce variable s.t. uses only load from it
+                            new_env.add(e.id, NChar(var, value.can_be_null(), value.length(),
+                                                    value.guarantees_terminating_nul()));
+                        },
+                        [](std::monostate) -> void { M_unreachable("invalid expression"); },
+                    }, old_env.compile(p->first));
+                }
+            }
+            ++p;
+        }
 
-                Var<PrimitiveExpr<T>> key;
-                Global<PrimitiveExpr<T>> key_backup;
-                std::optional<Var<Boolx1>> is_null;
-                std::optional<Global<Boolx1>> is_null_backup;
+        /*----- Resume pipeline with newly created environment. -----*/
+        {
+            auto S = CodeGenContext::Get().scoped_environment(std::move(new_env));
+            pipeline();
+        }
+    };
 
-                /*----- Set local key variables to global backups. -----*/
-                key = key_backup;
-                if (nullable) {
-                    is_null_backup.emplace();
-                    is_null.emplace(*is_null_backup);
+    if (M.child) {
+        /*----- Set minimal number of SIMD lanes preferred to get fully utilized SIMD vectors *after* the projection. */
+        uint64_t min_size_in_bytes = 16;
+        for (auto &p : M.projection.projections()) {
+            visit(overloaded {
+                [](const m::ast::ErrorExpr&) -> void { M_unreachable("no errors at this stage"); },
+                [](const m::ast::Designator&) -> void { /* nothing to be done */ },
+                [](const m::ast::Constant&) -> void { /* nothing to be done */ },
+                [](const m::ast::QueryExpr&) -> void { /* nothing to be done */ },
+                [&min_size_in_bytes](const m::ast::FnApplicationExpr &fn) -> void {
+                    if (fn.get_function().is_aggregate())
+                        throw visit_skip_subtree(); // skip arguments to already computed aggregate
+                    min_size_in_bytes = std::min(min_size_in_bytes, (fn.type()->size() + 7) / 8);
+                    if (min_size_in_bytes == 1)
+                        throw visit_stop_recursion(); // abort recursion
+                },
+                [&min_size_in_bytes](auto &e) -> void { // i.e. for unary and binary expressions
+                    min_size_in_bytes = std::min(min_size_in_bytes, (e.type()->size() + 7) / 8);
+                    if (min_size_in_bytes == 1)
+                        throw visit_stop_recursion(); // abort recursion
                 }
+            }, p.first.get(), m::tag<m::ast::ConstPreOrderExprVisitor>());
+        }
+        CodeGenContext::Get().update_num_simd_lanes_preferred(16 / min_size_in_bytes); // set own preference
 
-                try {
-                    auto id = M.grouping.schema()[idx].id;
-                    key_schema.find(id);
+        /*----- Execute projection. -----*/
+        M.child->get()->execute(std::move(setup), std::move(execute_projection), std::move(teardown));
+    } else {
+        /*----- Execute projection. -----*/
+        setup();
+        CodeGenContext::Get().set_num_simd_lanes(1); // since only a single tuple is produced
+        execute_projection();
+        teardown();
+    }
+}
 
-                    /*----- Add global key to result environment to access it in other function. -----*/
-                    if (nullable)
-                        results.add(id, Select(*is_null_backup, Expr<T>::Null(), key_backup));
-                    else
-                        results.add(id, key_backup.val());
-                } catch (invalid_argument&) {
-                    /* skip adding to result environment for duplicate keys since they must not be used afterwards */
-                }
 
-                /*----- Move key variables to access them later. ----*/
-                new (&key_values[idx]) key_t(std::make_pair(std::move(key), std::move(is_null)));
-                new (&key_value_backups[idx]) key_backup_t(std::make_pair(
-                    std::move(key_backup), std::move(is_null_backup)
-                ));
-            };
-            for (std::size_t idx = 0; idx < num_keys; ++idx) {
-                visit(overloaded{
-                    [&](const Boolean&) { init.template operator()<bool>(idx); },
-                    [&](const Numeric &n) {
-                        switch (n.kind) {
-                            case Numeric::N_Int:
-                            case Numeric::N_Decimal:
-                                switch (n.size()) {
-                                    default: M_unreachable("invalid size");
-                                    case  8: init.template operator()<int8_t >(idx); break;
-                                    case 16: init.template operator()<int16_t>(idx); break;
-                                    case 32: init.template operator()<int32_t>(idx); break;
-                                    case 64: init.template operator()<int64_t>(idx); break;
-                                }
-                                break;
-                            case Numeric::N_Float:
-                                if (n.size() <= 32)
-                                    init.template operator()<float>(idx);
-                                else
-                                    init.template operator()<double>(idx);
-                        }
-                    },
-                    [&](const CharacterSequence &cs) {
-                        Var<Ptr<Charx1>> key;
-                        Global<Ptr<Charx1>> key_backup;
-                        /* no `is_null` variables needed since pointer types must not be NULL */
+/*======================================================================================================================
+ * Grouping
+ *====================================================================================================================*/
 
-                        /*----- Set local key variable to global backup. -----*/
-                        key = key_backup;
+ConditionSet HashBasedGrouping::pre_condition(std::size_t child_idx, const std::tuple<const GroupingOperator*>&)
+{
+     M_insist(child_idx == 0);
 
-                        try {
-                            auto id = M.grouping.schema()[idx].id;
-                            key_schema.find(id);
+    ConditionSet pre_cond;
 
-                            /*----- Add global key to result environment to access it in other function. -----*/
-                            NChar str(key_backup.val(), M.grouping.schema()[idx].nullable(), cs.length, cs.is_varying);
-                            results.add(id, std::move(str));
-                        } catch (invalid_argument&) {
-                            /* skip adding to result environment for duplicate keys since they must not be used
-                             * afterwards */
-                        }
+    /*----- Hash-based grouping does not support SIMD. -----*/
+    pre_cond.add_condition(NoSIMD());
 
-                        /*----- Move key variables to access them later. ----*/
-                        new (&key_values[idx]) key_t(std::move(key));
-                        new (&key_value_backups[idx]) key_backup_t(std::move(key_backup));
-                    },
-                    [&](const Date&) { init.template operator()<int32_t>(idx); },
-                    [&](const DateTime&) { init.template operator()<int64_t>(idx); },
-                    [](auto&&) { M_unreachable("invalid type"); },
-                }, *M.grouping.schema()[idx].type);
-            }
-        }),
-        /* pipeline= */ [&](){
-            auto &env = CodeGenContext::Get().env();
+    return pre_cond;
+}
 
-            /*----- If predication is used, introduce pred. var. and update it before computing aggregates. -----*/
-            std::optional<Var<Boolx1>> pred;
-            if (env.predicated()) {
-                M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes");
-                pred = env.extract_predicate<_Boolx1>().is_true_and_not_null();
-            }
+double HashBasedGrouping::cost(const Match<HashBasedGrouping> &M)
+{
+    auto &coefficients = OperatorCalibration::Get().coefficients();
+    return (coefficients.hash_grouping_per_row +
+            coefficients.hash_table_per_byte * tuple_size_in_bytes(M.grouping.schema())) *
+        M.child->get_matched_root().info().estimated_cardinality;
+}
 
-            /*----- Compute aggregates. -----*/
-            Block reset_aggs("ordered_grouping.reset_aggs", false),
-                  update_aggs("ordered_grouping.update_aggs", false),
-                  update_avg_aggs("ordered_grouping.update_avg_aggs", false);
-            for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
-                auto &info = aggregates[idx];
+ConditionSet HashBasedGrouping::post_condition(const Match<HashBasedGrouping>&)
+{
+    ConditionSet post_cond;
 
-                bool is_min = false; ///< flag to indicate whether aggregate function is MIN
-                switch (info.fnid) {
-                    default:
-                        M_unreachable("unsupported aggregate function");
-                    case m::Function::FN_MIN:
-                        is_min = true; // set flag and delegate to MAX case
-                    case m::Function::FN_MAX: {
-                        M_insist(info.args.size() == 1, "MIN and MAX aggregate functions expect exactly one argument");
-                        const auto &arg = *info.args[0];
-                        auto min_max = [&]<typename T>() {
-                            auto neutral = is_min ? std::numeric_limits<T>::max()
-                                                  : std::numeric_limits<T>::lowest();
+    /*----- Hash-based grouping does not introduce predication (it is already handled by the hash table). -----*/
+    post_cond.add_condition(Predicated(false));
 
-                            auto &[min_max, is_null] = *M_notnull((
-                                std::get_if<std::pair<Var<PrimitiveExpr<T>>, std::optional<Var<Boolx1>>>>(&agg_values[idx])
-                            ));
+    /*----- Hash-based grouping does not introduce SIMD. -----*/
+    post_cond.add_condition(NoSIMD());
 
-                            BLOCK_OPEN(reset_aggs) {
-                                min_max = neutral;
-                                if (is_null)
-                                    is_null->set_true();
-                            }
+    return post_cond;
+}
 
-                            BLOCK_OPEN(update_aggs) {
-                                auto _arg = env.compile(arg);
-                                Expr<T> _new_val = convert<Expr<T>>(_arg);
-                                M_insist(_new_val.can_be_null() == bool(is_null));
-                                if (_new_val.can_be_null()) {
-                                    M_insist_no_ternary_logic();
-                                    auto _new_val_pred = pred ? Select(*pred, _new_val, Expr<T>::Null()) : _new_val;
-                                    auto [new_val_, new_val_is_null_] = _new_val_pred.split();
-                                    const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
+void HashBasedGrouping::execute(const Match<HashBasedGrouping> &M, setup_t setup, pipeline_t pipeline,
+                                teardown_t teardown, std::optional<key_domain_t> key_domain)
+{
+    /*----- Compute information about aggregates, especially AVG aggregates. -----*/
+    auto p = compute_aggregate_info(M.grouping.aggregates(), M.grouping.schema(), M.grouping.group_by().size());
+    const auto &aggregates = p.first;
+    const auto &avg_aggregates = p.second;
 
-                                    if constexpr (std::floating_point<T>) {
-                                        min_max = Select(new_val_is_null,
-                                                         min_max, // ignore NULL
-                                                         is_min ? min(min_max, new_val_) // update old min with new value
-                                                                : max(min_max, new_val_)); // update old max with new value
-                                    } else {
-                                        const Var<PrimitiveExpr<T>> new_val(new_val_); // due to multiple uses
-                                        auto cmp = is_min ? new_val < min_max : new_val > min_max;
-#if 1
-                                        min_max = Select(new_val_is_null,
-                                                         min_max, // ignore NULL
-                                                         Select(cmp,
-                                                                new_val, // update to new value
-                                                                min_max)); // do not update
-#else
-                                        IF (not new_val_is_null and cmp) {
-                                            min_max = new_val;
-                                        };
-#endif
-                                    }
-                                    *is_null = *is_null and new_val_is_null; // MIN/MAX is NULL iff all values are NULL
-                                } else {
-                                    auto _new_val_pred = pred ? Select(*pred, _new_val, neutral) : _new_val;
-                                    auto new_val_ = _new_val_pred.insist_not_null();
-                                    if constexpr (std::floating_point<T>) {
-                                        min_max = is_min ? min(min_max, new_val_) // update old min with new value
-                                                         : max(min_max, new_val_); // update old max with new value
-                                    } else {
-                                        const Var<PrimitiveExpr<T>> new_val(new_val_); // due to multiple uses
-                                        auto cmp = is_min ? new_val < min_max : new_val > min_max;
-#if 1
-                                        min_max = Select(cmp,
-                                                         new_val, // update to new value
-                                                         min_max); // do not update
-#else
-                                        IF (cmp) {
-                                            min_max = new_val;
-                                        };
-#endif
-                                    }
-                                }
-                            }
-                        };
-                        auto &n = as<const Numeric>(*info.entry.type);
-                        switch (n.kind) {
-                            case Numeric::N_Int:
-                            case Numeric::N_Decimal:
-                                switch (n.size()) {
-                                    default: M_unreachable("invalid size");
-                                    case  8: min_max.template operator()<int8_t >(); break;
-                                    case 16: min_max.template operator()<int16_t>(); break;
-                                    case 32: min_max.template operator()<int32_t>(); break;
-                                    case 64: min_max.template operator()<int64_t>(); break;
-                                }
-                                break;
-                            case Numeric::N_Float:
-                                if (n.size() <= 32)
-                                    min_max.template operator()<float>();
-                                else
-                                    min_max.template operator()<double>();
-                        }
-                        break;
-                    }
-                    case m::Function::FN_AVG:
-                        break; // skip here and handle later
-                    case m::Function::FN_SUM: {
-                        M_insist(info.args.size() == 1, "SUM aggregate function expects exactly one argument");
-                        const auto &arg = *info.args[0];
+    /*----- Compute initial capacity of hash table.  A directly mapped key domain, plus NULL, must fit entirely. -----*/
+    uint32_t initial_capacity =
+        key_domain ? std::ceil((key_domain->second + 1) / M.load_factor)
+                   : compute_initial_ht_capacity(M.grouping, M.load_factor);
 
-                        auto sum = [&]<typename T>() {
-                            auto &[sum, is_null] = *M_notnull((
-                                std::get_if<std::pair<Var<PrimitiveExpr<T>>, std::optional<Var<Boolx1>>>>(&agg_values[idx])
-                            ));
+    /*----- Create hash table. -----*/
+    auto ht = create_grouping_hash_table(M, aggregates, initial_capacity);
+    if (key_domain)
+        ht->set_direct_mapping(key_domain->first);
 
-                            BLOCK_OPEN(reset_aggs) {
-                                sum = T(0);
-                                if (is_null)
-                                    is_null->set_true();
-                            }
+    /*----- Create child function. -----*/
+    FUNCTION(hash_based_grouping_child_pipeline, void(void)) // create function for pipeline
+    {
+        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
 
-                            BLOCK_OPEN(update_aggs) {
-                                auto _arg = env.compile(arg);
-                                Expr<T> _new_val = convert<Expr<T>>(_arg);
-                                M_insist(_new_val.can_be_null() == bool(is_null));
-                                if (_new_val.can_be_null()) {
-                                    M_insist_no_ternary_logic();
-                                    auto _new_val_pred = pred ? Select(*pred, _new_val, Expr<T>::Null()) : _new_val;
-                                    auto [new_val, new_val_is_null_] = _new_val_pred.split();
-                                    const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
+        std::optional<HashTable::entry_t> dummy; ///< *local* dummy slot
 
-                                    sum += Select(new_val_is_null,
-                                                  T(0), // ignore NULL
-                                                  new_val); // add new value to old sum
-                                    *is_null = *is_null and new_val_is_null; // SUM is NULL iff all values are NULL
-                                } else {
-                                    auto _new_val_pred = pred ? Select(*pred, _new_val, T(0)) : _new_val;
-                                    sum += _new_val_pred.insist_not_null(); // add new value to old sum
-                                }
-                            }
-                        };
-                        auto &n = as<const Numeric>(*info.entry.type);
-                        switch (n.kind) {
-                            case Numeric::N_Int:
-                            case Numeric::N_Decimal:
-                                switch (n.size()) {
-                                    default: M_unreachable("invalid size");
-                                    case  8: sum.template operator()<int8_t >(); break;
-                                    case 16: sum.template operator()<int16_t>(); break;
-                                    case 32: sum.template operator()<int32_t>(); break;
-                                    case 64: sum.template operator()<int64_t>(); break;
-                                }
-                                break;
-                            case Numeric::N_Float:
-                                if (n.size() <= 32)
-                                    sum.template operator()<float>();
-                                else
-                                    sum.template operator()<double>();
-                        }
-                        break;
-                    }
-                    case m::Function::FN_COUNT: {
-                        M_insist(info.args.size() <= 1, "COUNT aggregate function expects at most one argument");
-                        M_insist(info.entry.type->is_integral() and info.entry.type->size() == 64);
+        M.child->execute(
+            /* setup=    */ setup_t::Make_Without_Parent([&](){
+                ht->setup();
+                ht->set_high_watermark(M.load_factor);
+                dummy.emplace(ht->dummy_entry()); // create dummy slot to ignore NULL values in aggregate computations
+            }),
+            /* pipeline= */ [&](){
+                M_insist(bool(dummy));
+                update_group(*ht, M.grouping, aggregates, avg_aggregates, *dummy);
+            },
+            /* teardown= */ teardown_t::Make_Without_Parent([&](){ ht->teardown(); })
+        );
+    }
+    hash_based_grouping_child_pipeline(); // call child function
 
-                        auto &count = *M_notnull(std::get_if<Var<I64x1>>(&agg_values[idx]));
+    /*----- Process each computed group. -----*/
+    setup_t(std::move(setup), [&](){ ht->setup(); })();
+    ht->for_each([&, pipeline=std::move(pipeline)](HashTable::const_entry_t entry){
+        add_group_to_environment(std::move(entry), M.grouping, avg_aggregates);
 
-                        BLOCK_OPEN(reset_aggs) {
-                            count = int64_t(0);
-                        }
+        /*----- Resume pipeline. -----*/
+        pipeline();
+    });
+    teardown_t(std::move(teardown), [&](){ ht->teardown(); })();
+}
 
-                        BLOCK_OPEN(update_aggs) {
-                            if (info.args.empty()) {
-                                count += pred ? pred->to<int64_t>() : I64x1(1); // increment old count by 1 iff `pred` is true
-                            } else {
-                                auto _new_val = env.compile(*info.args[0]);
-                                if (can_be_null(_new_val)) {
-                                    M_insist_no_ternary_logic();
-                                    I64x1 inc = pred ? (not_null(_new_val) and *pred).to<int64_t>()
-                                                   : not_null(_new_val).to<int64_t>();
-                                    count += inc; // increment old count by 1 iff new value is present and `pred` is true
-                                } else {
-                                    discard(_new_val); // since it is not needed in this case
-                                    I64x1 inc = pred ? pred->to<int64_t>() : I64x1(1);
-                                    count += inc; // increment old count by 1 iff new value is present and `pred` is true
-                                }
-                            }
-                        }
-                        break;
-                    }
-                }
-            }
+std::optional<key_domain_t> ArrayGrouping::find_key_domain(const GroupingOperator &grouping)
+{
+    if (grouping.group_by().size() != 1)
+        return std::nullopt;
+    auto des = cast<const Designator>(&grouping.group_by().front().first.get());
+    if (not des)
+        return std::nullopt;
+    auto attr = std::get_if<const Attribute*>(&des->target());
+    if (not attr)
+        return std::nullopt;
+    return ::find_key_domain(**attr, options::array_grouping_max_domain_size);
+}
 
-            /*----- Compute AVG aggregates after others to ensure that running count is already created. -----*/
-            for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
-                auto &info = aggregates[idx];
+ConditionSet ArrayGrouping::pre_condition(std::size_t child_idx,
+                                          const std::tuple<const GroupingOperator*> &partial_inner_nodes)
+{
+    M_insist(child_idx == 0);
 
-                if (info.fnid == m::Function::FN_AVG) {
-                    M_insist(info.args.size() == 1, "AVG aggregate function expects exactly one argument");
-                    const auto &arg = *info.args[0];
-                    M_insist(info.entry.type->is_double());
+    ConditionSet pre_cond;
 
-                    auto it = avg_aggregates.find(info.entry.id);
-                    M_insist(it != avg_aggregates.end());
-                    const auto &avg_info = it->second;
-                    M_insist(avg_info.compute_running_avg,
-                             "AVG aggregate may only occur for running average computations");
+    /*----- Array grouping needs a single integral key of a known, small domain. -----*/
+    if (not find_key_domain(*std::get<0>(partial_inner_nodes)))
+        return ConditionSet::Make_Unsatisfiable();
 
-                    auto &[avg, is_null] = *M_notnull((
-                        std::get_if<std::pair<Var<Doublex1>, std::optional<Var<Boolx1>>>>(&agg_values[idx])
-                    ));
+    /*----- Array grouping does not support SIMD. -----*/
+    pre_cond.add_condition(NoSIMD());
 
-                    BLOCK_OPEN(reset_aggs) {
-                        avg = 0.0;
-                        if (is_null)
-                            is_null->set_true();
-                    }
+    return pre_cond;
+}
 
-                    BLOCK_OPEN(update_avg_aggs) {
-                        /* Compute AVG as iterative mean as described in Knuth, The Art of Computer Programming
-                         * Vol 2, section 4.2.2. */
-                        auto running_count_idx = std::distance(
-                            aggregates.cbegin(),
-                            std::find_if(aggregates.cbegin(), aggregates.cend(), [&avg_info](const auto &info){
-                                return info.entry.id == avg_info.running_count;
-                            })
-                        );
-                        M_insist(0 <= running_count_idx and running_count_idx < aggregates.size());
-                        auto &running_count = *M_notnull(std::get_if<Var<I64x1>>(&agg_values[running_count_idx]));
+double ArrayGrouping::cost(const Match<ArrayGrouping> &M)
+{
+    /* No hashing and no collisions, but all slots of the domain are allocated and iterated. */
+    return 1.0 * M.child->get_matched_root().info().estimated_cardinality + 0.1 * M.key_domain.second;
+}
 
-                        auto _arg = env.compile(arg);
-                        _Doublex1 _new_val = convert<_Doublex1>(_arg);
-                        M_insist(_new_val.can_be_null() == bool(is_null));
-                        if (_new_val.can_be_null()) {
-                            M_insist_no_ternary_logic();
-                            auto _new_val_pred = pred ? Select(*pred, _new_val, _Doublex1::Null()) : _new_val;
-                            auto [new_val, new_val_is_null_] = _new_val_pred.split();
-                            const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
+ConditionSet ArrayGrouping::post_condition(const Match<ArrayGrouping> &M)
+{
+    return HashBasedGrouping::post_condition(M);
+}
 
-                            auto delta_absolute = new_val - avg;
-                            auto delta_relative = delta_absolute / running_count.to<double>();
+void ArrayGrouping::execute(const Match<ArrayGrouping> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    HashBasedGrouping::execute(M, std::move(setup), std::move(pipeline), std::move(teardown), M.key_domain);
+}
 
-                            avg += Select(new_val_is_null,
-                                          0.0, // ignore NULL
-                                          delta_relative); // update old average with new value
-                            *is_null = *is_null and new_val_is_null; // AVG is NULL iff all values are NULL
-                        } else {
-                            auto _new_val_pred = pred ? Select(*pred, _new_val, avg) : _new_val;
-                            auto delta_absolute = _new_val_pred.insist_not_null() - avg;
-                            auto delta_relative = delta_absolute / running_count.to<double>();
+ConditionSet RadixPartitionedGrouping::pre_condition(std::size_t child_idx,
+                                                     const std::tuple<const GroupingOperator*>&)
+{
+    M_insist(child_idx == 0);
 
-                            avg += delta_relative; // update old average with new value
-                        }
-                    }
-                }
-            }
+    ConditionSet pre_cond;
 
-            /*----- Compute whether new group starts and update key variables accordingly. -----*/
-            std::optional<Boolx1> group_differs;
-            Block update_keys("ordered_grouping.update_grouping_keys", false);
-            for (std::size_t idx = 0; idx < num_keys; ++idx) {
-                std::visit(overloaded {
-                    [&]<typename T>(Expr<T> value) -> void {
-                        auto &[key_val, key_is_null] = *M_notnull((
-                            std::get_if<std::pair<Var<PrimitiveExpr<T>>, std::optional<Var<Boolx1>>>>(&key_values[idx])
-                        ));
-                        M_insist(value.can_be_null() == bool(key_is_null));
+    /*----- Radix partitioned grouping does not support SIMD. -----*/
+    pre_cond.add_condition(NoSIMD());
 
-                        if (value.can_be_null()) {
-                            M_insist_no_ternary_logic();
-                            auto [val, is_null] = value.clone().split();
-                            auto null_differs = is_null != *key_is_null;
-                            Boolx1 key_differs = null_differs or (not *key_is_null and val != key_val);
-                            if (group_differs)
-                                group_differs.emplace(key_differs or *group_differs);
-                            else
-                                group_differs.emplace(key_differs);
+    return pre_cond;
+}
 
-                            BLOCK_OPEN(update_keys) {
-                                std::tie(key_val, key_is_null) = value.split();
-                            }
-                        } else {
-                            Boolx1 key_differs = key_val != value.clone().insist_not_null();
-                            if (group_differs)
-                                group_differs.emplace(key_differs or *group_differs);
-                            else
-                                group_differs.emplace(key_differs);
+double RadixPartitionedGrouping::cost(const Match<RadixPartitionedGrouping> &M)
+{
+    const double card = M.child->get_matched_root().info().estimated_cardinality;
 
-                            BLOCK_OPEN(update_keys) {
-                               key_val = value.insist_not_null();
-                            }
-                        }
-                    },
-                    [&](NChar value) -> void {
-                        auto &key = *M_notnull(std::get_if<Var<Ptr<Charx1>>>(&key_values[idx]));
+    /* The number of partitions depends on the estimated number of groups, i.e. the size of the hash table. */
+    double cost = 0.3 * card; // cost for materializing and partitioning the child
+    if (compute_num_radix_bits(M.grouping, M.partition_size) == 0)
+        cost += 1.5 * card; // single partition, i.e. cost as for hash-based grouping
+    else
+        cost += 0.9 * card; // cache-resident partitions, i.e. mostly cache hits
 
-                        auto [key_addr, key_is_nullptr] = key.val().split();
-                        auto [addr, is_nullptr] = value.val().clone().split();
-                        auto addr_differs = strncmp(
-                            /* left=  */ NChar(addr, value.can_be_null(), value.length(),
-                                               value.guarantees_terminating_nul()),
-                            /* right= */ NChar(key_addr, value.can_be_null(), value.length(),
-                                               value.guarantees_terminating_nul()),
-                            /* len=   */ U32x1(value.length()),
-                            /* op=    */ NE
-                        );
-                        auto [addr_differs_value, addr_differs_is_null] = addr_differs.split();
-                        addr_differs_is_null.discard(); // use potentially-null value but it is overruled if it is NULL
-                        auto nullptr_differs = is_nullptr != key_is_nullptr.clone();
-                        Boolx1 key_differs = nullptr_differs or (not key_is_nullptr and addr_differs_value);
-                        if (group_differs)
-                            group_differs.emplace(key_differs or *group_differs);
-                        else
-                            group_differs.emplace(key_differs);
+    return cost;
+}
 
-                        BLOCK_OPEN(update_keys) {
-                            key = value.val();
-                        }
-                    },
-                    [](auto) -> void { M_unreachable("SIMDfication currently not supported"); },
-                    [](std::monostate) -> void { M_unreachable("invalid expression"); },
-                }, env.compile(M.grouping.group_by()[idx].first.get()));
-            }
-            M_insist(bool(group_differs));
+ConditionSet RadixPartitionedGrouping::post_condition(const Match<RadixPartitionedGrouping> &M)
+{
+    return HashBasedGrouping::post_condition(M);
+}
 
-            /*----- Resume pipeline with computed group iff new one starts and emit code to reset aggregates. ---*/
-            M_insist(bool(first_iteration));
-            Boolx1 cond = *first_iteration or *group_differs; // `group_differs` defaulted in first iteration but overruled anyway
-            IF (pred ? Select(*pred, cond, false) : cond) { // ignore entries for which predication predicate is not fulfilled
-                IF (not *first_iteration) {
-                    store_locals_to_globals();
-                    emit_group_and_resume_pipeline();
-                    reset_aggs.attach_to_current();
-                };
-                update_keys.attach_to_current();
-                *first_iteration = false;
-            };
+void RadixPartitionedGrouping::execute(const Match<RadixPartitionedGrouping> &M, setup_t setup, pipeline_t pipeline,
+                                       teardown_t teardown)
+{
+    const auto buffer_schema = M.child->get_matched_root().schema().drop_constants().deduplicate();
 
-            /*----- Emit code to update aggregates. -----*/
-            update_aggs.attach_to_current();
-            update_avg_aggs.attach_to_current(); // after others to ensure that running count is incremented before
-        },
-        /* teardown= */ teardown_t::Make_Without_Parent([&](){
-            store_locals_to_globals();
+    /*----- Compute information about aggregates, especially AVG aggregates. -----*/
+    auto p = compute_aggregate_info(M.grouping.aggregates(), M.grouping.schema(), M.grouping.group_by().size());
+    const auto &aggregates = p.first;
+    const auto &avg_aggregates = p.second;
 
-            /*----- Destroy created aggregate values and their backups. -----*/
-            for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
-                agg_values[idx].~agg_t();
-                agg_value_backups[idx].~agg_backup_t();
-            }
+    /*----- Compute number of partitions s.t. the groups of each partition are expected to fit into the cache. -----*/
+    const uint32_t num_radix_bits = compute_num_radix_bits(M.grouping, M.partition_size);
+    const uint32_t num_partitions = 1U << num_radix_bits;
 
-            M_insist(bool(first_iteration));
-            first_iteration_backup = *first_iteration;
-            first_iteration.reset();
-        })
-    );
+    /*----- Create hash table which is reused for each partition. -----*/
+    uint32_t initial_capacity =
+        std::max(compute_initial_ht_capacity(M.grouping, M.load_factor) >> num_radix_bits, 16U);
+    auto ht = create_grouping_hash_table(M, aggregates, initial_capacity);
 
-    /*----- If input was not empty, emit last group tuple in the current environment and resume the pipeline. -----*/
-    IF (not first_iteration_backup) {
-        emit_group_and_resume_pipeline();
-    };
+    /*----- Create infinite buffer to materialize the child. -----*/
+    M_insist(bool(M.materializing_factory),
+             "`wasm::RadixPartitionedGrouping` must have a factory for the materialized child");
+    GlobalBuffer buffer(buffer_schema, *M.materializing_factory);
 
-    /*----- Delayed definition of function to emit group and resume pipeline (since result environment is needed). ---*/
-    auto fn = emit_group_and_resume_pipeline.make_function(); // outside BLOCK_OPEN-macro to register as current function
-    BLOCK_OPEN(fn.body()) {
+    /*----- Create child function to materialize the child. -----*/
+    FUNCTION(radix_partitioned_grouping_child_pipeline, void(void)) // create function for pipeline
+    {
         auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
-        auto &env = CodeGenContext::Get().env();
+        M.child->execute(
+            /* setup=    */ setup_t::Make_Without_Parent([&](){ buffer.setup(); }),
+            /* pipeline= */ [&](){ buffer.consume(); },
+            /* teardown= */ teardown_t::Make_Without_Parent([&](){ buffer.teardown(); })
+        );
+    }
+    radix_partitioned_grouping_child_pipeline(); // call child function
 
-        /*----- Emit setup code *before* possibly introducing temporary boolean variables to not overwrite them. -----*/
-        setup();
+    /*----- Partition the buffer by the hash of the grouping key, i.e. all tuples of a group belong to the same
+     * partition.  Partition `p` consists of the tuple IDs in [offsets[p], offsets[p + 1]). -----*/
+    Var<Ptr<U32x1>> offsets(Module::Allocator().pre_malloc<uint32_t>(num_partitions + 1));
+    Var<Ptr<U32x1>> cursors(Module::Allocator().pre_malloc<uint32_t>(num_partitions));
+    auto at = [](Var<Ptr<U32x1>> &ptr, U32x1 idx) { return *(ptr.val() + idx.make_signed()); };
+    Schema key_schema;
+    for (auto &grp : M.grouping.group_by()) {
+        for (auto &e : grp.first.get().get_required()) {
+            if (not key_schema.has(e.id))
+                key_schema.add(buffer_schema[e.id].second);
+        }
+    }
+    partition_buffer(
+        /* buffer=               */ buffer,
+        /* key_schema=           */ key_schema,
+        /* partition_of_current= */ [&](){
+            auto &env = CodeGenContext::Get().env();
+            std::vector<std::pair<const Type*, SQL_t>> values;
+            for (auto &grp : M.grouping.group_by())
+                values.emplace_back(grp.first.get().type(), env.compile(grp.first.get()));
 
-        /*----- Add computed group tuple to current environment. ----*/
-        for (auto &e : M.grouping.schema().deduplicate()) {
-            try {
-                key_schema.find(e.id);
-            } catch (invalid_argument&) {
-                continue; // skip duplicated keys since they must not be used afterwards
-            }
+            /* Use the high-order bits of the hash, see `compute_radix_partition()`. */
+            U64x1 hash = murmur3_64a_hash(std::move(values));
+            return (hash >> uint64_t(64 - num_radix_bits)).to<uint32_t>();
+        },
+        /* num_radix_bits=       */ num_radix_bits,
+        /* offsets=              */ offsets,
+        /* cursors=              */ cursors
+    );
 
-            if (auto it = avg_aggregates.find(e.id);
-                it != avg_aggregates.end() and not it->second.compute_running_avg)
-            { // AVG aggregates which is not yet computed, divide computed sum with computed count
-                auto &avg_info = it->second;
-                auto sum = results.get(avg_info.sum);
-                auto count = results.get<_I64x1>(avg_info.running_count).insist_not_null().to<double>();
-                auto avg = convert<_Doublex1>(sum) / count;
-                if (avg.can_be_null()) {
-                    _Var<Doublex1> var(avg); // introduce variable s.t. uses only load from it
-                    env.add(e.id, var);
-                } else {
-                    /* introduce variable w/o NULL bit s.t. uses only load from it */
-                    Var<Doublex1> var(avg.insist_not_null());
-                    env.add(e.id, _Doublex1(var));
-                }
-            } else { // part of key or already computed aggregate
-                std::visit(overloaded {
-                    [&]<typename T>(Expr<T> value) -> void {
-                        if (value.can_be_null()) {
-                            Var<Expr<T>> var(value); // introduce variable s.t. uses only load from it
-                            env.add(e.id, var);
-                        } else {
-                            /* introduce variable w/o NULL bit s.t. uses only load from it */
-                            Var<PrimitiveExpr<T>> var(value.insist_not_null());
-                            env.add(e.id, Expr<T>(var));
-                        }
-                    },
-                    [&](NChar value) -> void {
-                        Var<Ptr<Charx1>> var(value.val()); // introduce variable s.t. uses only load from it
-                        env.add(e.id, NChar(var, value.can_be_null(), value.length(),
-                                            value.guarantees_terminating_nul()));
-                    },
-                    [](auto) -> void { M_unreachable("SIMDfication currently not supported"); },
-                    [](std::monostate) -> void { M_unreachable("invalid reference"); },
-                }, results.get(e.id)); // do not extract to be able to access for not-yet-computed AVG aggregates
-            }
+    /*----- Process partitions one after another by grouping the tuples of the partition in the hash table and
+     * emitting its groups. -----*/
+    setup();
+    ht->setup();
+    ht->set_high_watermark(M.load_factor);
+    auto dummy = ht->dummy_entry(); // create dummy slot to ignore NULL values in aggregate computations
+    buffer.setup_base_address();
+    auto load = buffer.create_load_proxy();
+
+    Var<U32x1> partition(0U);
+    WHILE (partition < num_partitions) {
+        ht->clear();
+
+        /*----- Group the tuples of the current partition. -----*/
+        Var<U32x1> tuple_id(U32x1(at(offsets, partition)));
+        const Var<U32x1> end(U32x1(at(offsets, partition + 1U)));
+        WHILE (tuple_id < end) {
+            auto S = CodeGenContext::Get().scoped_environment();
+            load(tuple_id);
+            update_group(*ht, M.grouping, aggregates, avg_aggregates, dummy);
+            tuple_id += 1U;
         }
 
-        /*----- Resume pipeline. -----*/
-        pipeline();
+        /*----- Emit the groups of the current partition. -----*/
+        ht->for_each([&](HashTable::const_entry_t entry){
+            add_group_to_environment(std::move(entry), M.grouping, avg_aggregates);
 
-        /*----- Emit teardown code. -----*/
-        teardown();
-    }
-}
+            /*----- Resume pipeline. -----*/
+            pipeline();
+        });
 
+        partition += 1U;
+    }
 
-/*======================================================================================================================
- * Aggregation
- *====================================================================================================================*/
+    buffer.teardown_base_address();
+    ht->teardown();
+    teardown();
+}
 
-ConditionSet Aggregation::pre_condition(std::size_t child_idx, const std::tuple<const AggregationOperator*>&)
+ConditionSet OrderedGrouping::pre_condition(
+    std::size_t child_idx,
+    const std::tuple<const GroupingOperator*> &partial_inner_nodes)
 {
      M_insist(child_idx == 0);
 
     ConditionSet pre_cond;
 
+    /*----- Ordered grouping needs the data sorted on the grouping key (in either order). -----*/
+    Sortedness::order_t orders;
+    for (auto &p : std::get<0>(partial_inner_nodes)->group_by()) {
+        Schema::Identifier id(p.first);
+        if (orders.find(id) == orders.cend())
+            orders.add(std::move(id), Sortedness::O_UNDEF);
+    }
+    pre_cond.add_condition(Sortedness(std::move(orders)));
+
+    /*----- Ordered grouping does not support SIMD. -----*/
+    pre_cond.add_condition(NoSIMD());
+
     return pre_cond;
 }
 
-ConditionSet Aggregation::post_condition(const Match<Aggregation> &M)
+double OrderedGrouping::cost(const Match<OrderedGrouping> &M)
+{
+    return OperatorCalibration::Get().coefficients().ordered_grouping_per_row *
+        M.child->get_matched_root().info().estimated_cardinality;
+}
+
+ConditionSet OrderedGrouping::adapt_post_condition(const Match<OrderedGrouping> &M, const ConditionSet &post_cond_child)
 {
     ConditionSet post_cond;
 
-    /*----- Aggregation does not introduce predication. -----*/
+    /*----- Ordered grouping does not introduce predication. -----*/
     post_cond.add_condition(Predicated(false));
 
-    /*----- Aggregation does implicitly sort the data since only one tuple is produced. -----*/
+    /*----- Preserve order of child for grouping keys. -----*/
     Sortedness::order_t orders;
-    for (auto &e : M.aggregation.schema().deduplicate())
-        orders.add(e.id, Sortedness::O_UNDEF);
+    const auto &sortedness_child = post_cond_child.get_condition<Sortedness>();
+    for (auto &[expr, alias] : M.grouping.group_by()) {
+        auto it = sortedness_child.orders().find(Schema::Identifier(expr));
+        M_insist(it != sortedness_child.orders().cend());
+        Schema::Identifier id = alias.has_value() ? Schema::Identifier(alias.assert_not_none())
+                                                  : Schema::Identifier(expr);
+        if (orders.find(id) == orders.cend())
+            orders.add(std::move(id), it->second); // drop duplicate since it must not be used afterwards
+    }
     post_cond.add_condition(Sortedness(std::move(orders)));
 
-    /*----- Aggregation does not introduce SIMD since only one tuple is produced. -----*/
+    /*----- Ordered grouping does not introduce SIMD. -----*/
     post_cond.add_condition(NoSIMD());
 
     return post_cond;
 }
 
-void Aggregation::execute(const Match<Aggregation> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
+void OrderedGrouping::execute(const Match<OrderedGrouping> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
 {
-    Environment results; ///< stores result tuple
-    ///> code to construct aggregates from SIMD vectors; must be emitted *after* the child pipeline is executed
-    std::vector<std::function<void(void)>> finalize_aggregates;
+    Environment results; ///< stores current result tuple
+    const auto num_keys = M.grouping.group_by().size();
+
+    /*----- Compute key schema to detect duplicated keys. -----*/
+    Schema key_schema;
+    for (std::size_t i = 0; i < num_keys; ++i) {
+        auto &e = M.grouping.schema()[i];
+        key_schema.add(e.id, e.type, e.constraints);
+    }
 
     /*----- Compute information about aggregates, especially about AVG aggregates. -----*/
-    auto p = compute_aggregate_info(M.aggregation.aggregates(), M.aggregation.schema());
+    auto p = compute_aggregate_info(M.grouping.aggregates(), M.grouping.schema(), num_keys);
     const auto &aggregates = p.first;
     const auto &avg_aggregates = p.second;
 
-    /*----- Set minimal number of SIMD lanes preferred to get fully utilized SIMD vectors for the aggregate args. ----*/
-    uint64_t min_size_in_bytes = 16;
-    for (auto &fn : M.aggregation.aggregates()) {
-        for (auto &e : fn.get().args) {
-            visit(overloaded {
-                [](const m::ast::ErrorExpr&) -> void { M_unreachable("no errors at this stage"); },
-                [](const m::ast::Designator&) -> void { /* nothing to be done */ },
-                [](const m::ast::Constant&) -> void { /* nothing to be done */ },
-                [](const m::ast::QueryExpr&) -> void { /* nothing to be done */ },
-                [&min_size_in_bytes](const m::ast::FnApplicationExpr &fn) -> void {
-                    M_insist(not fn.get_function().is_aggregate(), "aggregate arguments must not be aggregates");
-                    min_size_in_bytes = std::min(min_size_in_bytes, (fn.type()->size() + 7) / 8);
-                    if (min_size_in_bytes == 1)
-                        throw visit_stop_recursion(); // abort recursion
-                },
-                [&min_size_in_bytes](auto &e) -> void { // i.e. for unary and binary expressions
-                    min_size_in_bytes = std::min(min_size_in_bytes, (e.type()->size() + 7) / 8);
-                    if (min_size_in_bytes == 1)
-                        throw visit_stop_recursion(); // abort recursion
-                }
-            }, *e, m::tag<m::ast::ConstPreOrderExprVisitor>());
-        }
-    }
-    CodeGenContext::Get().update_num_simd_lanes_preferred(16 / min_size_in_bytes); // set own preference
-
-    /*----- Set minimal number of SIMD lanes preferred to be able to compute running averages. ----*/
-    if (std::any_of(avg_aggregates.begin(), avg_aggregates.end(), [](auto &i){ return i.second.compute_running_avg; }))
-        CodeGenContext::Get().update_num_simd_lanes_preferred(4); // set own preference
+    /*----- Forward declare function to emit a group tuple in the current environment and resume the pipeline. -----*/
+    FunctionProxy<void(void)> emit_group_and_resume_pipeline("emit_group_and_resume_pipeline");
 
-    /*----- Create child function. -----*/
-    FUNCTION(aggregation_child_pipeline, void(void)) // create function for pipeline
-    {
-        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+    std::optional<Var<Boolx1>> first_iteration; ///< variable to *locally* check for first iteration
+    ///> *global* flag backup since the following code may be called multiple times
+    Global<Boolx1> first_iteration_backup(true);
 
-#ifndef NDEBUG
-        std::size_t num_simd_lanes; ///< to insist that setup, pipeline, and teardown callbacks use the same value
-#endif
-        void *_agg_values; ///< *local* values of the computed aggregates
-        void *_agg_value_backups; ///< *global* value backups of the computed aggregates
+    using agg_t = agg_t_<false>;
+    using agg_backup_t = agg_t_<true>;
+    agg_t agg_values[aggregates.size()]; ///< *local* values of the computed aggregates
+    agg_backup_t agg_value_backups[aggregates.size()]; ///< *global* value backups of the computed aggregates
 
-        M.child->execute(
-            /* setup=    */ setup_t::Make_Without_Parent([&]() {
-                auto execute_setup = [&]<std::size_t L>() {
-#ifndef NDEBUG
-                    num_simd_lanes = L;
-#endif
+    using key_t = key_t_<false>;
+    using key_backup_t = key_t_<true>;
+    key_t key_values[num_keys]; ///< *local* values of the computed keys
+    key_backup_t key_value_backups[num_keys]; ///< *global* value backups of the computed keys
 
-                    /*----- Initialize aggregates helper structures. -----*/
-                    using agg_t = agg_t_<false, L>;
-                    using agg_backup_t = agg_t_<true, L>;
-                    auto agg_values = new agg_t[aggregates.size()];
-                    auto agg_value_backups = new agg_backup_t[aggregates.size()];
+    auto store_locals_to_globals = [&](){
+        /*----- Store local aggregate values to globals to access them in other function. -----*/
+        for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
+            auto &info = aggregates[idx];
 
-                    /*----- Store aggregates helper structures for pipeline and teardown callbacks. -----*/
-                    _agg_values = static_cast<void*>(agg_values);
+            switch (info.fnid) {
+                default:
+                    M_unreachable("unsupported aggregate function");
+                case m::Function::FN_MIN:
+                case m::Function::FN_MAX: {
+                    auto min_max = [&]<typename T>() {
+                        auto &[min_max, is_null] = *M_notnull((
+                            std::get_if<std::pair<Var<PrimitiveExpr<T>>, std::optional<Var<Boolx1>>>>(&agg_values[idx])
+                        ));
+                        auto &[min_max_backup, is_null_backup] = *M_notnull((
+                            std::get_if<std::pair<Global<PrimitiveExpr<T>>,
+                                                  std::optional<Global<Boolx1>>>>(&agg_value_backups[idx])
+                        ));
+                        M_insist(bool(is_null) == bool(is_null_backup));
+
+                        min_max_backup = min_max;
+                        if (is_null)
+                            *is_null_backup = *is_null;
+                    };
+                    auto &n = as<const Numeric>(*info.entry.type);
+                    switch (n.kind) {
+                        case Numeric::N_Int:
+                        case Numeric::N_Decimal:
+                            switch (n.size()) {
+                                default: M_unreachable("invalid size");
+                                case  8: min_max.template operator()<int8_t >(); break;
+                                case 16: min_max.template operator()<int16_t>(); break;
+                                case 32: min_max.template operator()<int32_t>(); break;
+                                case 64: min_max.template operator()<int64_t>(); break;
+                            }
+                            break;
+                        case Numeric::N_Float:
+                            if (n.size() <= 32)
+                                min_max.template operator()<float>();
+                            else
+                                min_max.template operator()<double>();
+                    }
+                    break;
+                }
+                case m::Function::FN_AVG: {
+                    auto &[avg, is_null] = *M_notnull((
+                        std::get_if<std::pair<Var<Doublex1>, std::optional<Var<Boolx1>>>>(&agg_values[idx])
+                    ));
+                    auto &[avg_backup, is_null_backup] = *M_notnull((
+                        std::get_if<std::pair<Global<Doublex1>, std::optional<Global<Boolx1>>>>(&agg_value_backups[idx])
+                    ));
+                    M_insist(bool(is_null) == bool(is_null_backup));
+
+                    avg_backup = avg;
+                    if (is_null)
+                        *is_null_backup = *is_null;
+
+                    break;
+                }
+                case m::Function::FN_SUM: {
+                    M_insist(info.args.size() == 1, "SUM aggregate function expects exactly one argument");
+                    const auto &arg = *info.args[0];
+
+                    auto sum = [&]<typename T>() {
+                        auto &[sum, is_null] = *M_notnull((
+                            std::get_if<std::pair<Var<PrimitiveExpr<T>>, std::optional<Var<Boolx1>>>>(&agg_values[idx])
+                        ));
+                        auto &[sum_backup, is_null_backup] = *M_notnull((
+                            std::get_if<std::pair<Global<PrimitiveExpr<T>>,
+                                                  std::optional<Global<Boolx1>>>>(&agg_value_backups[idx])
+                        ));
+                        M_insist(bool(is_null) == bool(is_null_backup));
+
+                        sum_backup = sum;
+                        if (is_null)
+                            *is_null_backup = *is_null;
+                    };
+                    auto &n = as<const Numeric>(*info.entry.type);
+                    switch (n.kind) {
+                        case Numeric::N_Int:
+                        case Numeric::N_Decimal:
+                            switch (n.size()) {
+                                default: M_unreachable("invalid size");
+                                case  8: sum.template operator()<int8_t >(); break;
+                                case 16: sum.template operator()<int16_t>(); break;
+                                case 32: sum.template operator()<int32_t>(); break;
+                                case 64: sum.template operator()<int64_t>(); break;
+                            }
+                            break;
+                        case Numeric::N_Float:
+                            if (n.size() <= 32)
+                                sum.template operator()<float>();
+                            else
+                                sum.template operator()<double>();
+                    }
+                    break;
+                }
+                case m::Function::FN_COUNT: {
+                    auto &count = *M_notnull(std::get_if<Var<I64x1>>(&agg_values[idx]));
+                    auto &count_backup = *M_notnull(std::get_if<Global<I64x1>>(&agg_value_backups[idx]));
+
+                    count_backup = count;
+
+                    break;
+                }
+            }
+        }
+
+        /*----- Store local key values to globals to access them in other function. -----*/
+        auto store = [&]<typename T>(std::size_t idx) {
+            auto &[key, is_null] = *M_notnull((
+                std::get_if<std::pair<Var<PrimitiveExpr<T>>, std::optional<Var<Boolx1>>>>(&key_values[idx])
+            ));
+            auto &[key_backup, is_null_backup] = *M_notnull((
+                std::get_if<std::pair<Global<PrimitiveExpr<T>>, std::optional<Global<Boolx1>>>>(&key_value_backups[idx])
+            ));
+            M_insist(bool(is_null) == bool(is_null_backup));
+
+            key_backup = key;
+            if (is_null)
+                *is_null_backup = *is_null;
+        };
+        for (std::size_t idx = 0; idx < num_keys; ++idx) {
+            visit(overloaded{
+                [&](const Boolean&) { store.template operator()<bool>(idx); },
+                [&](const Numeric &n) {
+                    switch (n.kind) {
+                        case Numeric::N_Int:
+                        case Numeric::N_Decimal:
+                            switch (n.size()) {
+                                default: M_unreachable("invalid size");
+                                case  8: store.template operator()<int8_t >(idx); break;
+                                case 16: store.template operator()<int16_t>(idx); break;
+                                case 32: store.template operator()<int32_t>(idx); break;
+                                case 64: store.template operator()<int64_t>(idx); break;
+                            }
+                            break;
+                        case Numeric::N_Float:
+                            if (n.size() <= 32)
+                                store.template operator()<float>(idx);
+                            else
+                                store.template operator()<double>(idx);
+                    }
+                },
+                [&](const CharacterSequence &cs) {
+                    auto &key = *M_notnull(std::get_if<Var<Ptr<Charx1>>>(&key_values[idx]));
+                    auto &key_backup = *M_notnull(std::get_if<Global<Ptr<Charx1>>>(&key_value_backups[idx]));
+
+                    key_backup = key;
+                },
+                [&](const Date&) { store.template operator()<int32_t>(idx); },
+                [&](const DateTime&) { store.template operator()<int64_t>(idx); },
+                [](auto&&) { M_unreachable("invalid type"); },
+            }, *M.grouping.schema()[idx].type);
+        }
+    };
+
+    M.child->execute(
+        /* setup=    */ setup_t::Make_Without_Parent([&](){
+            first_iteration.emplace(first_iteration_backup);
+
+            /*----- Initialize aggregates and their backups. -----*/
+            for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
+                auto &info = aggregates[idx];
+                const bool nullable = info.entry.nullable();
+
+                bool is_min = false; ///< flag to indicate whether aggregate function is MIN
+                switch (info.fnid) {
+                    default:
+                        M_unreachable("unsupported aggregate function");
+                    case m::Function::FN_MIN:
+                        is_min = true; // set flag and delegate to MAX case
+                    case m::Function::FN_MAX: {
+                        auto min_max = [&]<typename T>() {
+                            auto neutral = is_min ? std::numeric_limits<T>::max()
+                                                  : std::numeric_limits<T>::lowest();
+
+                            Var<PrimitiveExpr<T>> min_max;
+                            Global<PrimitiveExpr<T>> min_max_backup(neutral); // initialize with neutral element +inf or -inf
+                            std::optional<Var<Boolx1>> is_null;
+                            std::optional<Global<Boolx1>> is_null_backup;
+
+                            /*----- Set local aggregate variables to global backups. -----*/
+                            min_max = min_max_backup;
+                            if (nullable) {
+                                is_null_backup.emplace(true); // MIN/MAX is initially NULL
+                                is_null.emplace(*is_null_backup);
+                            }
+
+                            /*----- Add global aggregate to result environment to access it in other function. -----*/
+                            if (nullable)
+                                results.add(info.entry.id, Select(*is_null_backup, Expr<T>::Null(), min_max_backup));
+                            else
+                                results.add(info.entry.id, min_max_backup.val());
+
+                            /*----- Move aggregate variables to access them later. ----*/
+                            new (&agg_values[idx]) agg_t(std::make_pair(std::move(min_max), std::move(is_null)));
+                            new (&agg_value_backups[idx]) agg_backup_t(std::make_pair(
+                                std::move(min_max_backup), std::move(is_null_backup)
+                            ));
+                        };
+                        auto &n = as<const Numeric>(*info.entry.type);
+                        switch (n.kind) {
+                            case Numeric::N_Int:
+                            case Numeric::N_Decimal:
+                                switch (n.size()) {
+                                    default: M_unreachable("invalid size");
+                                    case  8: min_max.template operator()<int8_t >(); break;
+                                    case 16: min_max.template operator()<int16_t>(); break;
+                                    case 32: min_max.template operator()<int32_t>(); break;
+                                    case 64: min_max.template operator()<int64_t>(); break;
+                                }
+                                break;
+                            case Numeric::N_Float:
+                                if (n.size() <= 32)
+                                    min_max.template operator()<float>();
+                                else
+                                    min_max.template operator()<double>();
+                        }
+                        break;
+                    }
+                    case m::Function::FN_AVG: {
+                        Var<Doublex1> avg;
+                        Global<Doublex1> avg_backup(0.0); // initialize with neutral element 0
+                        std::optional<Var<Boolx1>> is_null;
+                        std::optional<Global<Boolx1>> is_null_backup;
+
+                        /*----- Set local aggregate variables to global backups. -----*/
+                        avg = avg_backup;
+                        if (nullable) {
+                            is_null_backup.emplace(true); // AVG is initially NULL
+                            is_null.emplace(*is_null_backup);
+                        }
+
+                        /*----- Add global aggregate to result environment to access it in other function. -----*/
+                        if (nullable)
+                            results.add(info.entry.id, Select(*is_null_backup, _Doublex1::Null(), avg_backup));
+                        else
+                            results.add(info.entry.id, avg_backup.val());
+
+                        /*----- Move aggregate variables to access them later. ----*/
+                        new (&agg_values[idx]) agg_t(std::make_pair(std::move(avg), std::move(is_null)));
+                        new (&agg_value_backups[idx]) agg_backup_t(std::make_pair(
+                            std::move(avg_backup), std::move(is_null_backup)
+                        ));
+
+                        break;
+                    }
+                    case m::Function::FN_SUM: {
+                        auto sum = [&]<typename T>() {
+                            Var<PrimitiveExpr<T>> sum;
+                            Global<PrimitiveExpr<T>> sum_backup(T(0)); // initialize with neutral element 0
+                            std::optional<Var<Boolx1>> is_null;
+                            std::optional<Global<Boolx1>> is_null_backup;
+
+                            /*----- Set local aggregate variables to global backups. -----*/
+                            sum = sum_backup;
+                            if (nullable) {
+                                is_null_backup.emplace(true); // SUM is initially NULL
+                                is_null.emplace(*is_null_backup);
+                            }
+
+                            /*----- Add global aggregate to result environment to access it in other function. -----*/
+                            if (nullable)
+                                results.add(info.entry.id, Select(*is_null_backup, Expr<T>::Null(), sum_backup));
+                            else
+                                results.add(info.entry.id, sum_backup.val());
+
+                            /*----- Move aggregate variables to access them later. ----*/
+                            new (&agg_values[idx]) agg_t(std::make_pair(std::move(sum), std::move(is_null)));
+                            new (&agg_value_backups[idx]) agg_backup_t(std::make_pair(
+                                std::move(sum_backup), std::move(is_null_backup)
+                            ));
+                        };
+                        auto &n = as<const Numeric>(*info.entry.type);
+                        switch (n.kind) {
+                            case Numeric::N_Int:
+                            case Numeric::N_Decimal:
+                                switch (n.size()) {
+                                    default: M_unreachable("invalid size");
+                                    case  8: sum.template operator()<int8_t >(); break;
+                                    case 16: sum.template operator()<int16_t>(); break;
+                                    case 32: sum.template operator()<int32_t>(); break;
+                                    case 64: sum.template operator()<int64_t>(); break;
+                                }
+                                break;
+                            case Numeric::N_Float:
+                                if (n.size() <= 32)
+                                    sum.template operator()<float>();
+                                else
+                                    sum.template operator()<double>();
+                        }
+                        break;
+                    }
+                    case m::Function::FN_COUNT: {
+                        Var<I64x1> count;
+                        Global<I64x1> count_backup(0); // initialize with neutral element 0
+                        /* no `is_null` variables needed since COUNT will not be NULL */
+
+                        /*----- Set local aggregate variable to global backup. -----*/
+                        count = count_backup;
+
+                        /*----- Add global aggregate to result environment to access it in other function. -----*/
+                        results.add(info.entry.id, count_backup.val());
+
+                        /*----- Move aggregate variables to access them later. ----*/
+                        new (&agg_values[idx]) agg_t(std::move(count));
+                        new (&agg_value_backups[idx]) agg_backup_t(std::move(count_backup));
+
+                        break;
+                    }
+                }
+            }
+
+            /*----- Initialize keys and their backups. -----*/
+            auto init = [&]<typename T>(std::size_t idx) {
+                const bool nullable = M.grouping.schema()[idx].nullable();
+
+                Var<PrimitiveExpr<T>> key;
+                Global<PrimitiveExpr<T>> key_backup;
+                std::optional<Var<Boolx1>> is_null;
+                std::optional<Global<Boolx1>> is_null_backup;
+
+                /*----- Set local key variables to global backups. -----*/
+                key = key_backup;
+                if (nullable) {
+                    is_null_backup.emplace();
+                    is_null.emplace(*is_null_backup);
+                }
+
+                try {
+                    auto id = M.grouping.schema()[idx].id;
+                    key_schema.find(id);
+
+                    /*----- Add global key to result environment to access it in other function. -----*/
+                    if (nullable)
+                        results.add(id, Select(*is_null_backup, Expr<T>::Null(), key_backup));
+                    else
+                        results.add(id, key_backup.val());
+                } catch (invalid_argument&) {
+                    /* skip adding to result environment for duplicate keys since they must not be used afterwards */
+                }
+
+                /*----- Move key variables to access them later. ----*/
+                new (&key_values[idx]) key_t(std::make_pair(std::move(key), std::move(is_null)));
+                new (&key_value_backups[idx]) key_backup_t(std::make_pair(
+                    std::move(key_backup), std::move(is_null_backup)
+                ));
+            };
+            for (std::size_t idx = 0; idx < num_keys; ++idx) {
+                visit(overloaded{
+                    [&](const Boolean&) { init.template operator()<bool>(idx); },
+                    [&](const Numeric &n) {
+                        switch (n.kind) {
+                            case Numeric::N_Int:
+                            case Numeric::N_Decimal:
+                                switch (n.size()) {
+                                    default: M_unreachable("invalid size");
+                                    case  8: init.template operator()<int8_t >(idx); break;
+                                    case 16: init.template operator()<int16_t>(idx); break;
+                                    case 32: init.template operator()<int32_t>(idx); break;
+                                    case 64: init.template operator()<int64_t>(idx); break;
+                                }
+                                break;
+                            case Numeric::N_Float:
+                                if (n.size() <= 32)
+                                    init.template operator()<float>(idx);
+                                else
+                                    init.template operator()<double>(idx);
+                        }
+                    },
+                    [&](const CharacterSequence &cs) {
+                        Var<Ptr<Charx1>> key;
+                        Global<Ptr<Charx1>> key_backup;
+                        /* no `is_null` variables needed since pointer types must not be NULL */
+
+                        /*----- Set local key variable to global backup. -----*/
+                        key = key_backup;
+
+                        try {
+                            auto id = M.grouping.schema()[idx].id;
+                            key_schema.find(id);
+
+                            /*----- Add global key to result environment to access it in other function. -----*/
+                            NChar str(key_backup.val(), M.grouping.schema()[idx].nullable(), cs.length, cs.is_varying);
+                            results.add(id, std::move(str));
+                        } catch (invalid_argument&) {
+                            /* skip adding to result environment for duplicate keys since they must not be used
+                             * afterwards */
+                        }
+
+                        /*----- Move key variables to access them later. ----*/
+                        new (&key_values[idx]) key_t(std::move(key));
+                        new (&key_value_backups[idx]) key_backup_t(std::move(key_backup));
+                    },
+                    [&](const Date&) { init.template operator()<int32_t>(idx); },
+                    [&](const DateTime&) { init.template operator()<int64_t>(idx); },
+                    [](auto&&) { M_unreachable("invalid type"); },
+                }, *M.grouping.schema()[idx].type);
+            }
+        }),
+        /* pipeline= */ [&](){
+            auto &env = CodeGenContext::Get().env();
+            bind_common_subexpressions(env, grouping_expressions(M.grouping.group_by(), M.grouping.aggregates()));
+
+            /*----- If predication is used, introduce pred. var. and update it before computing aggregates. -----*/
+            std::optional<Var<Boolx1>> pred;
+            if (env.predicated()) {
+                M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes");
+                pred = env.extract_predicate<_Boolx1>().is_true_and_not_null();
+            }
+
+            /*----- Compute aggregates. -----*/
+            Block reset_aggs("ordered_grouping.reset_aggs", false),
+                  update_aggs("ordered_grouping.update_aggs", false),
+                  update_avg_aggs("ordered_grouping.update_avg_aggs", false);
+            for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
+                auto &info = aggregates[idx];
+
+                bool is_min = false; ///< flag to indicate whether aggregate function is MIN
+                switch (info.fnid) {
+                    default:
+                        M_unreachable("unsupported aggregate function");
+                    case m::Function::FN_MIN:
+                        is_min = true; // set flag and delegate to MAX case
+                    case m::Function::FN_MAX: {
+                        M_insist(info.args.size() == 1, "MIN and MAX aggregate functions expect exactly one argument");
+                        const auto &arg = *info.args[0];
+                        auto min_max = [&]<typename T>() {
+                            auto neutral = is_min ? std::numeric_limits<T>::max()
+                                                  : std::numeric_limits<T>::lowest();
+
+                            auto &[min_max, is_null] = *M_notnull((
+                                std::get_if<std::pair<Var<PrimitiveExpr<T>>, std::optional<Var<Boolx1>>>>(&agg_values[idx])
+                            ));
+
+                            BLOCK_OPEN(reset_aggs) {
+                                min_max = neutral;
+                                if (is_null)
+                                    is_null->set_true();
+                            }
+
+                            BLOCK_OPEN(update_aggs) {
+                                auto _arg = env.compile(arg);
+                                Expr<T> _new_val = convert<Expr<T>>(_arg);
+                                M_insist(_new_val.can_be_null() == bool(is_null));
+                                if (_new_val.can_be_null()) {
+                                    M_insist_no_ternary_logic();
+                                    auto _new_val_pred = pred ? Select(*pred, _new_val, Expr<T>::Null()) : _new_val;
+                                    auto [new_val_, new_val_is_null_] = _new_val_pred.split();
+                                    const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
+
+                                    if constexpr (std::floating_point<T>) {
+                                        min_max = Select(new_val_is_null,
+                                                         min_max, // ignore NULL
+                                                         is_min ? min(min_max, new_val_) // update old min with new value
+                                                                : max(min_max, new_val_)); // update old max with new value
+                                    } else {
+                                        const Var<PrimitiveExpr<T>> new_val(new_val_); // due to multiple uses
+                                        auto cmp = is_min ? new_val < min_max : new_val > min_max;
+#if 1
+                                        min_max = Select(new_val_is_null,
+                                                         min_max, // ignore NULL
+                                                         Select(cmp,
+                                                                new_val, // update to new value
+                                                                min_max)); // do not update
+#else
+                                        IF (not new_val_is_null and cmp) {
+                                            min_max = new_val;
+                                        };
+#endif
+                                    }
+                                    *is_null = *is_null and new_val_is_null; // MIN/MAX is NULL iff all values are NULL
+                                } else {
+                                    auto _new_val_pred = pred ? Select(*pred, _new_val, neutral) : _new_val;
+                                    auto new_val_ = _new_val_pred.insist_not_null();
+                                    if constexpr (std::floating_point<T>) {
+                                        min_max = is_min ? min(min_max, new_val_) // update old min with new value
+                                                         : max(min_max, new_val_); // update old max with new value
+                                    } else {
+                                        const Var<PrimitiveExpr<T>> new_val(new_val_); // due to multiple uses
+                                        auto cmp = is_min ? new_val < min_max : new_val > min_max;
+#if 1
+                                        min_max = Select(cmp,
+                                                         new_val, // update to new value
+                                                         min_max); // do not update
+#else
+                                        IF (cmp) {
+                                            min_max = new_val;
+                                        };
+#endif
+                                    }
+                                }
+                            }
+                        };
+                        auto &n = as<const Numeric>(*info.entry.type);
+                        switch (n.kind) {
+                            case Numeric::N_Int:
+                            case Numeric::N_Decimal:
+                                switch (n.size()) {
+                                    default: M_unreachable("invalid size");
+                                    case  8: min_max.template operator()<int8_t >(); break;
+                                    case 16: min_max.template operator()<int16_t>(); break;
+                                    case 32: min_max.template operator()<int32_t>(); break;
+                                    case 64: min_max.template operator()<int64_t>(); break;
+                                }
+                                break;
+                            case Numeric::N_Float:
+                                if (n.size() <= 32)
+                                    min_max.template operator()<float>();
+                                else
+                                    min_max.template operator()<double>();
+                        }
+                        break;
+                    }
+                    case m::Function::FN_AVG:
+                        break; // skip here and handle later
+                    case m::Function::FN_SUM: {
+                        M_insist(info.args.size() == 1, "SUM aggregate function expects exactly one argument");
+                        const auto &arg = *info.args[0];
+
+                        auto sum = [&]<typename T>() {
+                            auto &[sum, is_null] = *M_notnull((
+                                std::get_if<std::pair<Var<PrimitiveExpr<T>>, std::optional<Var<Boolx1>>>>(&agg_values[idx])
+                            ));
+
+                            BLOCK_OPEN(reset_aggs) {
+                                sum = T(0);
+                                if (is_null)
+                                    is_null->set_true();
+                            }
+
+                            BLOCK_OPEN(update_aggs) {
+                                auto _arg = env.compile(arg);
+                                Expr<T> _new_val = convert<Expr<T>>(_arg);
+                                M_insist(_new_val.can_be_null() == bool(is_null));
+                                if (_new_val.can_be_null()) {
+                                    M_insist_no_ternary_logic();
+                                    auto _new_val_pred = pred ? Select(*pred, _new_val, Expr<T>::Null()) : _new_val;
+                                    auto [new_val, new_val_is_null_] = _new_val_pred.split();
+                                    const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
+
+                                    sum += Select(new_val_is_null,
+                                                  T(0), // ignore NULL
+                                                  new_val); // add new value to old sum
+                                    *is_null = *is_null and new_val_is_null; // SUM is NULL iff all values are NULL
+                                } else {
+                                    auto _new_val_pred = pred ? Select(*pred, _new_val, T(0)) : _new_val;
+                                    sum += _new_val_pred.insist_not_null(); // add new value to old sum
+                                }
+                            }
+                        };
+                        auto &n = as<const Numeric>(*info.entry.type);
+                        switch (n.kind) {
+                            case Numeric::N_Int:
+                            case Numeric::N_Decimal:
+                                switch (n.size()) {
+                                    default: M_unreachable("invalid size");
+                                    case  8: sum.template operator()<int8_t >(); break;
+                                    case 16: sum.template operator()<int16_t>(); break;
+                                    case 32: sum.template operator()<int32_t>(); break;
+                                    case 64: sum.template operator()<int64_t>(); break;
+                                }
+                                break;
+                            case Numeric::N_Float:
+                                if (n.size() <= 32)
+                                    sum.template operator()<float>();
+                                else
+                                    sum.template operator()<double>();
+                        }
+                        break;
+                    }
+                    case m::Function::FN_COUNT: {
+                        M_insist(info.args.size() <= 1, "COUNT aggregate function expects at most one argument");
+                        M_insist(info.entry.type->is_integral() and info.entry.type->size() == 64);
+
+                        auto &count = *M_notnull(std::get_if<Var<I64x1>>(&agg_values[idx]));
+
+                        BLOCK_OPEN(reset_aggs) {
+                            count = int64_t(0);
+                        }
+
+                        BLOCK_OPEN(update_aggs) {
+                            if (info.args.empty()) {
+                                count += pred ? pred->to<int64_t>() : I64x1(1); // increment old count by 1 iff `pred` is true
+                            } else {
+                                auto _new_val = env.compile(*info.args[0]);
+                                if (can_be_null(_new_val)) {
+                                    M_insist_no_ternary_logic();
+                                    I64x1 inc = pred ? (not_null(_new_val) and *pred).to<int64_t>()
+                                                   : not_null(_new_val).to<int64_t>();
+                                    count += inc; // increment old count by 1 iff new value is present and `pred` is true
+                                } else {
+                                    discard(_new_val); // since it is not needed in this case
+                                    I64x1 inc = pred ? pred->to<int64_t>() : I64x1(1);
+                                    count += inc; // increment old count by 1 iff new value is present and `pred` is true
+                                }
+                            }
+                        }
+                        break;
+                    }
+                }
+            }
+
+            /*----- Compute AVG aggregates after others to ensure that running count is already created. -----*/
+            for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
+                auto &info = aggregates[idx];
+
+                if (info.fnid == m::Function::FN_AVG) {
+                    M_insist(info.args.size() == 1, "AVG aggregate function expects exactly one argument");
+                    const auto &arg = *info.args[0];
+                    M_insist(info.entry.type->is_double());
+
+                    auto it = avg_aggregates.find(info.entry.id);
+                    M_insist(it != avg_aggregates.end());
+                    const auto &avg_info = it->second;
+                    M_insist(avg_info.compute_running_avg,
+                             "AVG aggregate may only occur for running average computations");
+
+                    auto &[avg, is_null] = *M_notnull((
+                        std::get_if<std::pair<Var<Doublex1>, std::optional<Var<Boolx1>>>>(&agg_values[idx])
+                    ));
+
+                    BLOCK_OPEN(reset_aggs) {
+                        avg = 0.0;
+                        if (is_null)
+                            is_null->set_true();
+                    }
+
+                    BLOCK_OPEN(update_avg_aggs) {
+                        /* Compute AVG as iterative mean as described in Knuth, The Art of Computer Programming
+                         * Vol 2, section 4.2.2. */
+                        auto running_count_idx = std::distance(
+                            aggregates.cbegin(),
+                            std::find_if(aggregates.cbegin(), aggregates.cend(), [&avg_info](const auto &info){
+                                return info.entry.id == avg_info.running_count;
+                            })
+                        );
+                        M_insist(0 <= running_count_idx and running_count_idx < aggregates.size());
+                        auto &running_count = *M_notnull(std::get_if<Var<I64x1>>(&agg_values[running_count_idx]));
+
+                        auto _arg = env.compile(arg);
+                        _Doublex1 _new_val = convert<_Doublex1>(_arg);
+                        M_insist(_new_val.can_be_null() == bool(is_null));
+                        if (_new_val.can_be_null()) {
+                            M_insist_no_ternary_logic();
+                            auto _new_val_pred = pred ? Select(*pred, _new_val, _Doublex1::Null()) : _new_val;
+                            auto [new_val, new_val_is_null_] = _new_val_pred.split();
+                            const Var<Boolx1> new_val_is_null(new_val_is_null_); // due to multiple uses
+
+                            auto delta_absolute = new_val - avg;
+                            auto delta_relative = delta_absolute / running_count.to<double>();
+
+                            avg += Select(new_val_is_null,
+                                          0.0, // ignore NULL
+                                          delta_relative); // update old average with new value
+                            *is_null = *is_null and new_val_is_null; // AVG is NULL iff all values are NULL
+                        } else {
+                            auto _new_val_pred = pred ? Select(*pred, _new_val, avg) : _new_val;
+                            auto delta_absolute = _new_val_pred.insist_not_null() - avg;
+                            auto delta_relative = delta_absolute / running_count.to<double>();
+
+                            avg += delta_relative; // update old average with new value
+                        }
+                    }
+                }
+            }
+
+            /*----- Compute whether new group starts and update key variables accordingly. -----*/
+            std::optional<Boolx1> group_differs;
+            Block update_keys("ordered_grouping.update_grouping_keys", false);
+            for (std::size_t idx = 0; idx < num_keys; ++idx) {
+                std::visit(overloaded {
+                    [&]<typename T>(Expr<T> value) -> void {
+                        auto &[key_val, key_is_null] = *M_notnull((
+                            std::get_if<std::pair<Var<PrimitiveExpr<T>>, std::optional<Var<Boolx1>>>>(&key_values[idx])
+                        ));
+                        M_insist(value.can_be_null() == bool(key_is_null));
+
+                        if (value.can_be_null()) {
+                            M_insist_no_ternary_logic();
+                            auto [val, is_null] = value.clone().split();
+                            auto null_differs = is_null != *key_is_null;
+                            Boolx1 key_differs = null_differs or (not *key_is_null and val != key_val);
+                            if (group_differs)
+                                group_differs.emplace(key_differs or *group_differs);
+                            else
+                                group_differs.emplace(key_differs);
+
+                            BLOCK_OPEN(update_keys) {
+                                std::tie(key_val, key_is_null) = value.split();
+                            }
+                        } else {
+                            Boolx1 key_differs = key_val != value.clone().insist_not_null();
+                            if (group_differs)
+                                group_differs.emplace(key_differs or *group_differs);
+                            else
+                                group_differs.emplace(key_differs);
+
+                            BLOCK_OPEN(update_keys) {
+                               key_val = value.insist_not_null();
+                            }
+                        }
+                    },
+                    [&](NChar value) -> void {
+                        auto &key = *M_notnull(std::get_if<Var<Ptr<Charx1>>>(&key_values[idx]));
+
+                        auto [key_addr, key_is_nullptr] = key.val().split();
+                        auto [addr, is_nullptr] = value.val().clone().split();
+                        auto addr_differs = strncmp(
+                            /* left=  */ NChar(addr, value.can_be_null(), value.length(),
+                                               value.guarantees_terminating_nul()),
+                            /* right= */ NChar(key_addr, value.can_be_null(), value.length(),
+                                               value.guarantees_terminating_nul()),
+                            /* len=   */ U32x1(value.length()),
+                            /* op=    */ NE
+                        );
+                        auto [addr_differs_value, addr_differs_is_null] = addr_differs.split();
+                        addr_differs_is_null.discard(); // use potentially-null value but it is overruled if it is NULL
+                        auto nullptr_differs = is_nullptr != key_is_nullptr.clone();
+                        Boolx1 key_differs = nullptr_differs or (not key_is_nullptr and addr_differs_value);
+                        if (group_differs)
+                            group_differs.emplace(key_differs or *group_differs);
+                        else
+                            group_differs.emplace(key_differs);
+
+                        BLOCK_OPEN(update_keys) {
+                            key = value.val();
+                        }
+                    },
+                    [](auto) -> void { M_unreachable("SIMDfication currently not supported"); },
+                    [](std::monostate) -> void { M_unreachable("invalid expression"); },
+                }, env.compile(M.grouping.group_by()[idx].first.get()));
+            }
+            M_insist(bool(group_differs));
+
+            /*----- Resume pipeline with computed group iff new one starts and emit code to reset aggregates. ---*/
+            M_insist(bool(first_iteration));
+            Boolx1 cond = *first_iteration or *group_differs; // `group_differs` defaulted in first iteration but overruled anyway
+            IF (pred ? Select(*pred, cond, false) : cond) { // ignore entries for which predication predicate is not fulfilled
+                IF (not *first_iteration) {
+                    store_locals_to_globals();
+                    emit_group_and_resume_pipeline();
+                    reset_aggs.attach_to_current();
+                };
+                update_keys.attach_to_current();
+                *first_iteration = false;
+            };
+
+            /*----- Emit code to update aggregates. -----*/
+            update_aggs.attach_to_current();
+            update_avg_aggs.attach_to_current(); // after others to ensure that running count is incremented before
+        },
+        /* teardown= */ teardown_t::Make_Without_Parent([&](){
+            store_locals_to_globals();
+
+            /*----- Destroy created aggregate values and their backups. -----*/
+            for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
+                agg_values[idx].~agg_t();
+                agg_value_backups[idx].~agg_backup_t();
+            }
+
+            M_insist(bool(first_iteration));
+            first_iteration_backup = *first_iteration;
+            first_iteration.reset();
+        })
+    );
+
+    /*----- If input was not empty, emit last group tuple in the current environment and resume the pipeline. -----*/
+    IF (not first_iteration_backup) {
+        emit_group_and_resume_pipeline();
+    };
+
+    /*----- Delayed definition of function to emit group and resume pipeline (since result environment is needed). ---*/
+    auto fn = emit_group_and_resume_pipeline.make_function(); // outside BLOCK_OPEN-macro to register as current function
+    BLOCK_OPEN(fn.body()) {
+        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+        auto &env = CodeGenContext::Get().env();
+
+        /*----- Emit setup code *before* possibly introducing temporary boolean variables to not overwrite them. -----*/
+        setup();
+
+        /*----- Add computed group tuple to current environment. ----*/
+        for (auto &e : M.grouping.schema().deduplicate()) {
+            try {
+                key_schema.find(e.id);
+            } catch (invalid_argument&) {
+                continue; // skip duplicated keys since they must not be used afterwards
+            }
+
+            if (auto it = avg_aggregates.find(e.id);
+                it != avg_aggregates.end() and not it->second.compute_running_avg)
+            { // AVG aggregates which is not yet computed, divide computed sum with computed count
+                auto &avg_info = it->second;
+                auto sum = results.get(avg_info.sum);
+                auto count = results.get<_I64x1>(avg_info.running_count).insist_not_null().to<double>();
+                auto avg = convert<_Doublex1>(sum) / count;
+                if (avg.can_be_null()) {
+                    _Var<Doublex1> var(avg); // introduce variable s.t. uses only load from it
+                    env.add(e.id, var);
+                } else {
+                    /* introduce variable w/o NULL bit s.t. uses only load from it */
+                    Var<Doublex1> var(avg.insist_not_null());
+                    env.add(e.id, _Doublex1(var));
+                }
+            } else { // part of key or already computed aggregate
+                std::visit(overloaded {
+                    [&]<typename T>(Expr<T> value) -> void {
+                        if (value.can_be_null()) {
+                            Var<Expr<T>> var(value); // introduce variable s.t. uses only load from it
+                            env.add(e.id, var);
+                        } else {
+                            /* introduce variable w/o NULL bit s.t. uses only load from it */
+                            Var<PrimitiveExpr<T>> var(value.insist_not_null());
+                            env.add(e.id, Expr<T>(var));
+                        }
+                    },
+                    [&](NChar value) -> void {
+                        Var<Ptr<Charx1>> var(value.val()); // introduce variable s.t. uses only load from it
+                        env.add(e.id, NChar(var, value.can_be_null(), value.length(),
+                                            value.guarantees_terminating_nul()));
+                    },
+                    [](auto) -> void { M_unreachable("SIMDfication currently not supported"); },
+                    [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                }, results.get(e.id)); // do not extract to be able to access for not-yet-computed AVG aggregates
+            }
+        }
+
+        /*----- Resume pipeline. -----*/
+        pipeline();
+
+        /*----- Emit teardown code. -----*/
+        teardown();
+    }
+}
+
+
+/*======================================================================================================================
+ * Aggregation
+ *====================================================================================================================*/
+
+ConditionSet Aggregation::pre_condition(std::size_t child_idx, const std::tuple<const AggregationOperator*>&)
+{
+     M_insist(child_idx == 0);
+
+    ConditionSet pre_cond;
+
+    return pre_cond;
+}
+
+ConditionSet Aggregation::post_condition(const Match<Aggregation> &M)
+{
+    ConditionSet post_cond;
+
+    /*----- Aggregation does not introduce predication. -----*/
+    post_cond.add_condition(Predicated(false));
+
+    /*----- Aggregation does implicitly sort the data since only one tuple is produced. -----*/
+    Sortedness::order_t orders;
+    for (auto &e : M.aggregation.schema().deduplicate())
+        orders.add(e.id, Sortedness::O_UNDEF);
+    post_cond.add_condition(Sortedness(std::move(orders)));
+
+    /*----- Aggregation does not introduce SIMD since only one tuple is produced. -----*/
+    post_cond.add_condition(NoSIMD());
+
+    return post_cond;
+}
+
+void Aggregation::execute(const Match<Aggregation> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    Environment results; ///< stores result tuple
+    ///> code to construct aggregates from SIMD vectors; must be emitted *after* the child pipeline is executed
+    std::vector<std::function<void(void)>> finalize_aggregates;
+
+    /*----- Compute information about aggregates, especially about AVG aggregates. -----*/
+    auto p = compute_aggregate_info(M.aggregation.aggregates(), M.aggregation.schema());
+    const auto &aggregates = p.first;
+    const auto &avg_aggregates = p.second;
+
+    /*----- Set minimal number of SIMD lanes preferred to get fully utilized SIMD vectors for the aggregate args. ----*/
+    uint64_t min_size_in_bytes = 16;
+    for (auto &fn : M.aggregation.aggregates()) {
+        for (auto &e : fn.get().args) {
+            visit(overloaded {
+                [](const m::ast::ErrorExpr&) -> void { M_unreachable("no errors at this stage"); },
+                [](const m::ast::Designator&) -> void { /* nothing to be done */ },
+                [](const m::ast::Constant&) -> void { /* nothing to be done */ },
+                [](const m::ast::QueryExpr&) -> void { /* nothing to be done */ },
+                [&min_size_in_bytes](const m::ast::FnApplicationExpr &fn) -> void {
+                    M_insist(not fn.get_function().is_aggregate(), "aggregate arguments must not be aggregates");
+                    min_size_in_bytes = std::min(min_size_in_bytes, (fn.type()->size() + 7) / 8);
+                    if (min_size_in_bytes == 1)
+                        throw visit_stop_recursion(); // abort recursion
+                },
+                [&min_size_in_bytes](auto &e) -> void { // i.e. for unary and binary expressions
+                    min_size_in_bytes = std::min(min_size_in_bytes, (e.type()->size() + 7) / 8);
+                    if (min_size_in_bytes == 1)
+                        throw visit_stop_recursion(); // abort recursion
+                }
+            }, *e, m::tag<m::ast::ConstPreOrderExprVisitor>());
+        }
+    }
+    CodeGenContext::Get().update_num_simd_lanes_preferred(16 / min_size_in_bytes); // set own preference
+
+    /*----- Prefer multiple vectors' worth of SIMD lanes s.t. each aggregate is accumulated in independent vectors,
+     * hiding the latency of the additions.  Limit the lanes to 16 since a double pumped scan doubles them again. -----*/
+    uint64_t min_aggregate_size_in_bytes = 16;
+    for (auto &e : M.aggregation.schema())
+        min_aggregate_size_in_bytes = std::min<uint64_t>(min_aggregate_size_in_bytes, (e.type->size() + 7) / 8);
+    const std::size_t accumulator_lanes = options::aggregation_accumulators * (16 / min_aggregate_size_in_bytes);
+    CodeGenContext::Get().update_num_simd_lanes_preferred(
+        std::min<std::size_t>(16, ceil_to_pow_2(accumulator_lanes))
+    ); // set own preference
+
+    /*----- Set minimal number of SIMD lanes preferred to be able to compute running averages. ----*/
+    if (std::any_of(avg_aggregates.begin(), avg_aggregates.end(), [](auto &i){ return i.second.compute_running_avg; }))
+        CodeGenContext::Get().update_num_simd_lanes_preferred(4); // set own preference
+
+    /*----- Create child function. -----*/
+    FUNCTION(aggregation_child_pipeline, void(void)) // create function for pipeline
+    {
+        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+
+#ifndef NDEBUG
+        std::size_t num_simd_lanes; ///< to insist that setup, pipeline, and teardown callbacks use the same value
+#endif
+        void *_agg_values; ///< *local* values of the computed aggregates
+        void *_agg_value_backups; ///< *global* value backups of the computed aggregates
+
+        M.child->execute(
+            /* setup=    */ setup_t::Make_Without_Parent([&]() {
+                auto execute_setup = [&]<std::size_t L>() {
+#ifndef NDEBUG
+                    num_simd_lanes = L;
+#endif
+
+                    /*----- Initialize aggregates helper structures. -----*/
+                    using agg_t = agg_t_<false, L>;
+                    using agg_backup_t = agg_t_<true, L>;
+                    auto agg_values = new agg_t[aggregates.size()];
+                    auto agg_value_backups = new agg_backup_t[aggregates.size()];
+
+                    /*----- Store aggregates helper structures for pipeline and teardown callbacks. -----*/
+                    _agg_values = static_cast<void*>(agg_values);
                     _agg_value_backups = static_cast<void*>(agg_value_backups);
 
-                    /*----- Initialize aggregates and their backups. -----*/
-                    for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
-                        auto &info = aggregates[idx];
+                    /*----- Initialize aggregates and their backups. -----*/
+                    for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
+                        auto &info = aggregates[idx];
+
+                        bool is_min = false; ///< flag to indicate whether aggregate function is MIN
+                        switch (info.fnid) {
+                            default:
+                                M_unreachable("unsupported aggregate function");
+                            case m::Function::FN_MIN:
+                                is_min = true; // set flag and delegate to MAX case
+                            case m::Function::FN_MAX: {
+                                auto min_max = [&]<typename T>() {
+                                    auto neutral = is_min ? std::numeric_limits<T>::max()
+                                                          : std::numeric_limits<T>::lowest();
+
+                                    Var<PrimitiveExpr<T, L>> min_max;
+                                    Global<PrimitiveExpr<T, L>> min_max_backup(
+                                        neutral // initialize with neutral element +inf or -inf
+                                    );
+                                    Var<Bool<L>> is_null;
+                                    Global<Bool<L>> is_null_backup(true); // MIN/MAX is initially NULL
+
+                                    /*----- Set local aggregate variables to global backups. -----*/
+                                    min_max = min_max_backup;
+                                    is_null = is_null_backup;
+
+                                    /*----- Add global aggregate to result env. to access it in other function. -----*/
+                                    if constexpr (L == 1) { // scalar
+                                        PrimitiveExpr<T> value = min_max_backup;
+                                        Boolx1 is_null = is_null_backup;
+                                        results.add(info.entry.id, Select(is_null, Expr<T>::Null(), value));
+                                    } else { // vectorial
+                                        /* Create lambda which emits the computation of the final *scalar* aggregate.
+                                         * This can then be called in the pipeline function starting at the aggregation
+                                         * operator s.t. the emitted variable is a local of the correct function.
+                                         * Do not access the global variables inside the lambda using closure by
+                                         * reference since they are already destroyed when the lambda will be called.
+                                         * Instead, copy their values into the lambda. However, since DSL expressions
+                                         * are not const-copy-constructible, we have to allocate them on the heap and
+                                         * destroy them manually inside the lambda. */
+                                        auto simd_min_max = new PrimitiveExpr<T, L>(min_max_backup.val());
+                                        auto simd_is_null = new Bool<L>(is_null_backup.val());
+                                        finalize_aggregates.emplace_back([&, is_min, simd_min_max, simd_is_null]() {
+                                            PrimitiveExpr<T> value = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                                                Var<PrimitiveExpr<T>> res(simd_min_max->clone().template extract<0>());
+                                                auto update = [&]<std::size_t I>(){
+                                                    if constexpr (requires (PrimitiveExpr<T> v) { min(v, v); max(v, v); }) {
+                                                        res = is_min ? min(res, simd_min_max->clone().template extract<I>())
+                                                                     : max(res, simd_min_max->clone().template extract<I>());
+                                                    } else {
+                                                        const Var<PrimitiveExpr<T>> extracted(
+                                                            simd_min_max->clone().template extract<I>()
+                                                        ); // due to multiple uses
+                                                        auto cmp = is_min ? extracted < res : extracted > res;
+#if 1
+                                                        res = Select(cmp, extracted, res);
+#else
+                                                        IF (cmp) {
+                                                            res = extracted;
+                                                        };
+#endif
+                                                    }
+                                                };
+                                                (update.template operator()<Is + 1>(), ...);
+                                                return res;
+                                            }(std::make_index_sequence<L - 1>{});
+                                            simd_min_max->discard(); // since it was always cloned
+                                            Boolx1 is_null = simd_is_null->all_true();
+                                            results.add(info.entry.id, Select(is_null, Expr<T>::Null(), value));
+                                            delete simd_min_max; // destroy heap-allocated variable
+                                            delete simd_is_null; // destroy heap-allocated variable
+                                        });
+                                    }
+
+                                    /*----- Move aggregate variables to access them later. ----*/
+                                    new (&agg_values[idx]) agg_t(std::make_pair(
+                                        std::move(min_max), std::move(is_null))
+                                    );
+                                    new (&agg_value_backups[idx]) agg_backup_t(std::make_pair(
+                                        std::move(min_max_backup), std::move(is_null_backup)
+                                    ));
+                                };
+                                auto &n = as<const Numeric>(*info.entry.type);
+                                switch (n.kind) {
+                                    case Numeric::N_Int:
+                                    case Numeric::N_Decimal:
+                                        switch (n.size()) {
+                                            default: M_unreachable("invalid size");
+                                            case  8: min_max.template operator()<int8_t >(); break;
+                                            case 16: min_max.template operator()<int16_t>(); break;
+                                            case 32: min_max.template operator()<int32_t>(); break;
+                                            case 64: min_max.template operator()<int64_t>(); break;
+                                        }
+                                        break;
+                                    case Numeric::N_Float:
+                                        if (n.size() <= 32)
+                                            min_max.template operator()<float>();
+                                        else
+                                            min_max.template operator()<double>();
+                                }
+                                break;
+                            }
+                            case m::Function::FN_AVG:
+                                break; // skip here and handle later
+                            case m::Function::FN_SUM: {
+                                auto sum = [&]<typename T>() {
+                                    Var<PrimitiveExpr<T, L>> sum;
+                                    Global<PrimitiveExpr<T, L>> sum_backup(T(0)); // initialize with neutral element 0
+                                    Var<Bool<L>> is_null;
+                                    Global<Bool<L>> is_null_backup(true); // SUM is initially NULL
+
+                                    /*----- Set local aggregate variables to global backups. -----*/
+                                    sum = sum_backup;
+                                    is_null = is_null_backup;
+
+                                    /*----- Add global aggregate to result env. to access it in other function. -----*/
+                                    if constexpr (L == 1) { // scalar
+                                        PrimitiveExpr<T> value = sum_backup;
+                                        Boolx1 is_null = is_null_backup;
+                                        results.add(info.entry.id, Select(is_null, Expr<T>::Null(), value));
+                                    } else { // vectorial
+                                        PrimitiveExpr<T> value = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                                            return (sum_backup.template extract<Is>() + ...);
+                                        }(std::make_index_sequence<L>{});
+                                        Boolx1 is_null = is_null_backup.all_true();
+                                        results.add(info.entry.id, Select(is_null, Expr<T>::Null(), value));
+                                    }
+
+                                    /*----- Move aggregate variables to access them later. ----*/
+                                    new (&agg_values[idx]) agg_t(std::make_pair(std::move(sum), std::move(is_null)));
+                                    new (&agg_value_backups[idx]) agg_backup_t(std::make_pair(
+                                        std::move(sum_backup), std::move(is_null_backup)
+                                    ));
+                                };
+                                auto &n = as<const Numeric>(*info.entry.type);
+                                switch (n.kind) {
+                                    case Numeric::N_Int:
+                                    case Numeric::N_Decimal:
+                                        switch (n.size()) {
+                                            default: M_unreachable("invalid size");
+                                            case  8: sum.template operator()<int8_t >(); break;
+                                            case 16: sum.template operator()<int16_t>(); break;
+                                            case 32: sum.template operator()<int32_t>(); break;
+                                            case 64: sum.template operator()<int64_t>(); break;
+                                        }
+                                        break;
+                                    case Numeric::N_Float:
+                                        if (n.size() <= 32)
+                                            sum.template operator()<float>();
+                                        else
+                                            sum.template operator()<double>();
+                                }
+                                break;
+                            }
+                            case m::Function::FN_COUNT: {
+                                Var<I64<L>> count;
+                                Global<I64<L>> count_backup(0); // initialize with neutral element 0
+                                /* no `is_null` variables needed since COUNT will not be NULL */
+
+                                /*----- Set local aggregate variable to global backup. -----*/
+                                count = count_backup;
+
+                                /*----- Add global aggregate to result env. to access it in other function. -----*/
+                                if constexpr (L == 1) { // scalar
+                                    I64x1 value = count_backup;
+                                    results.add(info.entry.id, value);
+                                } else { // vectorial
+                                    I64x1 value = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                                        return (count_backup.template extract<Is>() + ...);
+                                    }(std::make_index_sequence<L>{});
+                                    results.add(info.entry.id, value);
+                                }
+
+                                /*----- Move aggregate variables to access them later. ----*/
+                                new (&agg_values[idx]) agg_t(std::move(count));
+                                new (&agg_value_backups[idx]) agg_backup_t(std::move(count_backup));
+
+                                break;
+                            }
+                        }
+                    }
+
+                    /*----- Initialize AVG aggregates after others to ensure that running count is initialized before. */
+                    for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
+                        auto &info = aggregates[idx];
+
+                        if (info.fnid == m::Function::FN_AVG) {
+                            Var<Double<L>> avg;
+                            Global<Double<L>> avg_backup(0.0); // initialize with neutral element 0
+                            Var<Bool<L>> is_null;
+                            Global<Bool<L>> is_null_backup(true); // AVG is initially NULL
+
+                            /*----- Set local aggregate variables to global backups. -----*/
+                            avg = avg_backup;
+                            is_null = is_null_backup;
+
+                            /*----- Add global aggregate to result env. to access it in other function. -----*/
+                            if constexpr (L == 1) { // scalar
+                                Doublex1 value = avg_backup;
+                                Boolx1 is_null = is_null_backup;
+                                results.add(info.entry.id, Select(is_null, _Doublex1::Null(), value));
+                            } else { // vectorial
+                                /* Create lambda which emits the computation of the final *scalar* aggregate.
+                                 * This can then be called in the pipeline function starting at the aggregation
+                                 * operator s.t. the emitted variable is a local of the correct function.
+                                 * Do not access the global variables inside the lambda using closure by
+                                 * reference since they are already destroyed when the lambda will be called.
+                                 * Instead, copy their values into the lambda. However, since DSL expressions
+                                 * are not const-copy-constructible, we have to allocate them on the heap and
+                                 * destroy them manually inside the lambda. */
+                                auto simd_avg = new Double<L>(avg_backup.val());
+                                auto simd_is_null = new Bool<L>(is_null_backup.val());
+                                auto simd_running_count = new I64<L>([&](){
+                                    auto it = avg_aggregates.find(info.entry.id);
+                                    M_insist(it != avg_aggregates.end());
+                                    const auto &avg_info = it->second;
+                                    M_insist(avg_info.compute_running_avg,
+                                             "AVG aggregate may only occur for running average computations");
+
+                                    auto running_count_idx = std::distance(
+                                        aggregates.cbegin(),
+                                        std::find_if(
+                                            aggregates.cbegin(), aggregates.cend(), [&avg_info](const auto &info){
+                                                return info.entry.id == avg_info.running_count;
+                                        })
+                                    );
+                                    M_insist(0 <= running_count_idx and running_count_idx < aggregates.size());
+
+                                    auto &running_count =
+                                        *M_notnull(std::get_if<Global<I64<L>>>(&agg_value_backups[running_count_idx]));
+                                    return running_count.val();
+                                }());
+                                finalize_aggregates.emplace_back([&, simd_avg, simd_is_null, simd_running_count]() {
+                                    Doublex1 value = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                                        I64x1 count = (simd_running_count->clone().template extract<Is>() + ...);
+                                        const Var<Double<L>> simd_sum([&](){
+                                            if constexpr (L != 2) {
+                                                return *simd_avg * simd_running_count->template to<double>();
+                                            } else {
+                                                M_unreachable("conversion from `I64<2>` to `Double<2>` not supported");
+                                                return Double<L>(0.0); // this line is never reached; return dummy value
+                                            }
+                                        }());
+                                        return (simd_sum.template extract<Is>() + ...) / count.to<double>();
+                                    }(std::make_index_sequence<L>{});
+                                    Boolx1 is_null = simd_is_null->all_true();
+                                    results.add(info.entry.id, Select(is_null, _Doublex1::Null(), value));
+                                    delete simd_avg; // destroy heap-allocated variable
+                                    delete simd_is_null; // destroy heap-allocated variable
+                                    delete simd_running_count; // destroy heap-allocated variable
+                                });
+                            }
+
+                            /*----- Move aggregate variables to access them later. ----*/
+                            new (&agg_values[idx]) agg_t(std::make_pair(std::move(avg), std::move(is_null)));
+                            new (&agg_value_backups[idx]) agg_backup_t(std::make_pair(
+                                std::move(avg_backup), std::move(is_null_backup)
+                            ));
+                        }
+                    }
+                };
+                switch (CodeGenContext::Get().num_simd_lanes()) {
+                    default: M_unreachable("unsupported number of SIMD lanes");
+                    case  1: execute_setup.operator()<1>();  break;
+                    case  2: execute_setup.operator()<2>();  break;
+                    case  4: execute_setup.operator()<4>();  break;
+                    case  8: execute_setup.operator()<8>();  break;
+                    case 16: execute_setup.operator()<16>(); break;
+                    case 32: execute_setup.operator()<32>(); break;
+                }
+            }),
+            /* pipeline= */ [&](){
+                auto execute_pipeline = [&]<std::size_t L>(){
+#ifndef NDEBUG
+                    M_insist(num_simd_lanes == L,
+                             "number of SIMD lanes in pipeline callback must match the one in setup callback");
+#endif
+
+                    /*----- Get aggregates helper structures. -----*/
+                    using agg_t = agg_t_<false, L>;
+                    using agg_backup_t = agg_t_<true, L>;
+                    auto agg_values = static_cast<agg_t*>(_agg_values);
+                    auto agg_value_backups = static_cast<agg_backup_t*>(_agg_value_backups);
+
+                    auto &env = CodeGenContext::Get().env();
+                    bind_common_subexpressions(env, grouping_expressions({}, M.aggregation.aggregates()));
+
+                    /*----- If predication is used, introduce pred. var. and update it before computing aggregates. --*/
+                    std::optional<Var<Bool<L>>> pred;
+                    if (env.predicated()) {
+                        if constexpr (sql_boolean_type<_Bool<L>>)
+                            pred = env.extract_predicate<_Bool<L>>().is_true_and_not_null();
+                        else
+                            M_unreachable("invalid number of SIMD lanes");
+                    }
+
+                    /*----- Compute aggregates (except AVG). -----*/
+                    for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
+                        auto &info = aggregates[idx];
+
+                        bool is_min = false; ///< flag to indicate whether aggregate function is MIN
+                        switch (info.fnid) {
+                            default:
+                                M_unreachable("unsupported aggregate function");
+                            case m::Function::FN_MIN:
+                                is_min = true; // set flag and delegate to MAX case
+                            case m::Function::FN_MAX: {
+                                M_insist(info.args.size() == 1,
+                                         "MIN and MAX aggregate functions expect exactly one argument");
+                                const auto &arg = *info.args[0];
+                                auto min_max = overloaded{
+                                    [&]<typename T>() requires sql_type<Expr<T, L>> {
+                                        auto &[min_max, is_null] = *M_notnull((
+                                            std::get_if<
+                                                std::pair<Var<PrimitiveExpr<T, L>>, Var<Bool<L>>>
+                                            >(&agg_values[idx])
+                                        ));
+
+                                        auto _arg = env.compile(arg);
+                                        Expr<T, L> _new_val = convert<Expr<T, L>>(_arg);
+                                        if (_new_val.can_be_null()) {
+                                            M_insist_no_ternary_logic();
+                                            auto _new_val_pred =
+                                                pred ? Select(*pred, _new_val, Expr<T, L>::Null()) : _new_val;
+                                            auto [new_val_, new_val_is_null_] = _new_val_pred.split();
+                                            const Var<Bool<L>> new_val_is_null(new_val_is_null_); // due to multiple uses
+
+                                            if constexpr (requires (PrimitiveExpr<T, L> v) { min(v, v); max(v, v); }) {
+                                                min_max = Select(new_val_is_null,
+                                                                 min_max, // ignore NULL
+                                                                 is_min ? min(min_max, new_val_) // update old min with new value
+                                                                        : max(min_max, new_val_)); // update old max with new value
+                                            } else {
+                                                const Var<PrimitiveExpr<T, L>> new_val(new_val_); // due to multiple uses
+                                                auto cmp = is_min ? new_val < min_max : new_val > min_max;
+#if 1
+                                                min_max = Select(new_val_is_null,
+                                                                 min_max, // ignore NULL
+                                                                 Select(cmp,
+                                                                        new_val, // update to new value
+                                                                        min_max)); // do not update
+#else
+                                                IF (not new_val_is_null and cmp) {
+                                                    min_max = new_val;
+                                                };
+#endif
+                                            }
+                                            is_null = is_null and new_val_is_null; // MIN/MAX is NULL iff all values are NULL
+                                        } else {
+                                            auto neutral = is_min ? std::numeric_limits<T>::max()
+                                                                  : std::numeric_limits<T>::lowest();
+                                            auto _new_val_pred =
+                                                pred ? Select(*pred, _new_val, PrimitiveExpr<T, L>(neutral)) : _new_val;
+                                            auto new_val_ = _new_val_pred.insist_not_null();
+                                            if constexpr (requires (PrimitiveExpr<T, L> v) { min(v, v); max(v, v); }) {
+                                                min_max = is_min ? min(min_max, new_val_) // update old min with new value
+                                                                 : max(min_max, new_val_); // update old max with new value
+                                            } else {
+                                                const Var<PrimitiveExpr<T, L>> new_val(new_val_); // due to multiple uses
+                                                auto cmp = is_min ? new_val < min_max : new_val > min_max;
+#if 1
+                                                min_max = Select(cmp,
+                                                                 new_val, // update to new value
+                                                                 min_max); // do not update
+#else
+                                                IF (cmp) {
+                                                    min_max = new_val;
+                                                };
+#endif
+                                            }
+                                            is_null.set_false(); // at least one non-NULL value is consumed
+                                        }
+                                    },
+                                    []<typename>() { M_unreachable("invalid type for given number of SIMD lanes"); }
+                                };
+                                auto &n = as<const Numeric>(*info.entry.type);
+                                switch (n.kind) {
+                                    case Numeric::N_Int:
+                                    case Numeric::N_Decimal:
+                                        switch (n.size()) {
+                                            default: M_unreachable("invalid size");
+                                            case  8: min_max.template operator()<int8_t >(); break;
+                                            case 16: min_max.template operator()<int16_t>(); break;
+                                            case 32: min_max.template operator()<int32_t>(); break;
+                                            case 64: min_max.template operator()<int64_t>(); break;
+                                        }
+                                        break;
+                                    case Numeric::N_Float:
+                                        if (n.size() <= 32)
+                                            min_max.template operator()<float>();
+                                        else
+                                            min_max.template operator()<double>();
+                                }
+                                break;
+                            }
+                            case m::Function::FN_AVG:
+                                break; // skip here and handle later
+                            case m::Function::FN_SUM: {
+                                M_insist(info.args.size() == 1, "SUM aggregate function expects exactly one argument");
+                                const auto &arg = *info.args[0];
+
+                                auto sum = overloaded{
+                                    [&]<typename T>() requires sql_type<Expr<T, L>> {
+                                        auto &[sum, is_null] = *M_notnull((
+                                            std::get_if<
+                                                std::pair<Var<PrimitiveExpr<T, L>>, Var<Bool<L>>>
+                                            >(&agg_values[idx])
+                                        ));
+
+                                        auto _arg = env.compile(arg);
+                                        Expr<T, L> _new_val = convert<Expr<T, L>>(_arg);
+                                        if (_new_val.can_be_null()) {
+                                            M_insist_no_ternary_logic();
+                                            auto _new_val_pred =
+                                                pred ? Select(*pred, _new_val, Expr<T, L>::Null()) : _new_val;
+                                            auto [new_val, new_val_is_null_] = _new_val_pred.split();
+                                            const Var<Bool<L>> new_val_is_null(new_val_is_null_); // due to multiple uses
+
+                                            sum += Select(new_val_is_null,
+                                                          PrimitiveExpr<T, L>(T(0)), // ignore NULL
+                                                          new_val); // add new value to old sum
+                                            is_null = is_null and new_val_is_null; // SUM is NULL iff all values are NULL
+                                        } else {
+                                            auto _new_val_pred =
+                                                pred ? Select(*pred, _new_val, PrimitiveExpr<T, L>(T(0))) : _new_val;
+                                            sum += _new_val_pred.insist_not_null(); // add new value to old sum
+                                            is_null.set_false(); // at least one non-NULL value is consumed
+                                        }
+                                    },
+                                    []<typename>() { M_unreachable("invalid type for given number of SIMD lanes"); }
+                                };
+                                auto &n = as<const Numeric>(*info.entry.type);
+                                switch (n.kind) {
+                                    case Numeric::N_Int:
+                                    case Numeric::N_Decimal:
+                                        switch (n.size()) {
+                                            default: M_unreachable("invalid size");
+                                            case  8: sum.template operator()<int8_t >(); break;
+                                            case 16: sum.template operator()<int16_t>(); break;
+                                            case 32: sum.template operator()<int32_t>(); break;
+                                            case 64: sum.template operator()<int64_t>(); break;
+                                        }
+                                        break;
+                                    case Numeric::N_Float:
+                                        if (n.size() <= 32)
+                                            sum.template operator()<float>();
+                                        else
+                                            sum.template operator()<double>();
+                                }
+                                break;
+                            }
+                            case m::Function::FN_COUNT: {
+                                M_insist(info.args.size() <= 1, "COUNT aggregate function expects at most one argument");
+                                M_insist(info.entry.type->is_integral() and info.entry.type->size() == 64);
+
+                                auto &count = *M_notnull(std::get_if<Var<I64<L>>>(&agg_values[idx]));
+
+                                if (info.args.empty()) {
+                                    count += pred ? pred->template to<int64_t>() : I64<L>(1); // increment old count by 1 iff `pred` is true
+                                } else {
+                                    auto _new_val = env.compile(*info.args[0]);
+                                    if (can_be_null(_new_val)) {
+                                        M_insist_no_ternary_logic();
+                                        I64<L> inc = pred ? (not_null<L>(_new_val) and *pred).template to<int64_t>()
+                                                          : not_null<L>(_new_val).template to<int64_t>();
+                                        count += inc; // increment old count by 1 iff new value is present and `pred` is true
+                                    } else {
+                                        discard(_new_val); // since it is not needed in this case
+                                        I64<L> inc = pred ? pred->template to<int64_t>() : I64<L>(1);
+                                        count += inc; // increment old count by 1 iff new value is present and `pred` is true
+                                    }
+                                }
+                                break;
+                            }
+                        }
+                    }
+
+                    /*----- Compute AVG aggregates after others to ensure that running count is incremented before. --*/
+                    for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
+                        auto &info = aggregates[idx];
+
+                        if (info.fnid == m::Function::FN_AVG) {
+                            M_insist(info.args.size() == 1, "AVG aggregate function expects exactly one argument");
+                            const auto &arg = *info.args[0];
+                            M_insist(info.entry.type->is_double());
+
+                            auto it = avg_aggregates.find(info.entry.id);
+                            M_insist(it != avg_aggregates.end());
+                            const auto &avg_info = it->second;
+                            M_insist(avg_info.compute_running_avg,
+                                     "AVG aggregate may only occur for running average computations");
+
+                            auto &[avg, is_null] = *M_notnull((
+                                std::get_if<std::pair<Var<Double<L>>, Var<Bool<L>>>>(&agg_values[idx])
+                            ));
+
+                            /* Compute AVG as iterative mean as described in Knuth, The Art of Computer Programming
+                             * Vol 2, section 4.2.2. */
+                            auto running_count_idx = std::distance(
+                                aggregates.cbegin(),
+                                std::find_if(aggregates.cbegin(), aggregates.cend(), [&avg_info](const auto &info){
+                                    return info.entry.id == avg_info.running_count;
+                                })
+                            );
+                            M_insist(0 <= running_count_idx and running_count_idx < aggregates.size());
+                            Double<L> running_count = [&](){
+                                auto &running_count =
+                                    *M_notnull(std::get_if<Var<I64<L>>>(&agg_values[running_count_idx]));
+                                if constexpr (L != 2) {
+                                    return running_count.template to<double>();
+                                } else {
+                                    M_unreachable("conversion from `I64<2>` to `Double<2>` not supported");
+                                    return Double<L>(0.0); // this line is never reached; return dummy value
+                                }
+                            }();
+
+                            auto _arg = env.compile(arg);
+                            _Double<L> _new_val = convert<_Double<L>>(_arg);
+                            if (_new_val.can_be_null()) {
+                                M_insist_no_ternary_logic();
+                                auto _new_val_pred = pred ? Select(*pred, _new_val, _Double<L>::Null()) : _new_val;
+                                auto [new_val, new_val_is_null_] = _new_val_pred.split();
+                                const Var<Bool<L>> new_val_is_null(new_val_is_null_); // due to multiple uses
+
+                                auto delta_absolute = new_val - avg;
+                                auto delta_relative = delta_absolute / running_count;
+
+                                avg += Select(new_val_is_null,
+                                              Double<L>(0.0), // ignore NULL
+                                              delta_relative); // update old average with new value
+                                is_null = is_null and new_val_is_null; // AVG is NULL iff all values are NULL
+                            } else {
+                                auto _new_val_pred = pred ? Select(*pred, _new_val, avg) : _new_val;
+                                auto delta_absolute = _new_val_pred.insist_not_null() - avg;
+                                auto delta_relative = delta_absolute / running_count;
+
+                                avg += delta_relative; // update old average with new value
+                                is_null.set_false(); // at least one non-NULL value is consumed
+                            }
+                        }
+                    }
+                };
+                switch (CodeGenContext::Get().num_simd_lanes()) {
+                    default: M_unreachable("unsupported number of SIMD lanes");
+                    case  1: execute_pipeline.operator()<1>();  break;
+                    case  2: execute_pipeline.operator()<2>();  break;
+                    case  4: execute_pipeline.operator()<4>();  break;
+                    case  8: execute_pipeline.operator()<8>();  break;
+                    case 16: execute_pipeline.operator()<16>(); break;
+                    case 32: execute_pipeline.operator()<32>(); break;
+                }
+            },
+            /* teardown= */ teardown_t::Make_Without_Parent([&](){
+                auto execute_teardown = [&]<std::size_t L>(){
+#ifndef NDEBUG
+                    M_insist(num_simd_lanes == L,
+                             "number of SIMD lanes in teardown callback must match the one in setup callback");
+#endif
+
+                    /*----- Get aggregates helper structures. -----*/
+                    using agg_t = agg_t_<false, L>;
+                    using agg_backup_t = agg_t_<true, L>;
+                    auto agg_values = static_cast<agg_t*>(_agg_values);
+                    auto agg_value_backups = static_cast<agg_backup_t*>(_agg_value_backups);
+
+                    /*----- Store local aggregate values to globals to access them in other function. -----*/
+                    for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
+                        auto &info = aggregates[idx];
+
+                        bool is_min = false; ///< flag to indicate whether aggregate function is MIN
+                        switch (info.fnid) {
+                            default:
+                                M_unreachable("unsupported aggregate function");
+                            case m::Function::FN_MIN:
+                                is_min = true; // set flag and delegate to MAX case
+                            case m::Function::FN_MAX: {
+                                auto min_max = [&]<typename T>() {
+                                    auto &[min_max_backup, is_null_backup] = *M_notnull((
+                                        std::get_if<
+                                            std::pair<Global<PrimitiveExpr<T, L>>, Global<Bool<L>>>
+                                        >(&agg_value_backups[idx])
+                                    ));
+                                    std::tie(min_max_backup, is_null_backup) = *M_notnull((
+                                        std::get_if<std::pair<Var<PrimitiveExpr<T, L>>, Var<Bool<L>>>>(&agg_values[idx])
+                                    ));
+                                };
+                                auto &n = as<const Numeric>(*info.entry.type);
+                                switch (n.kind) {
+                                    case Numeric::N_Int:
+                                    case Numeric::N_Decimal:
+                                        switch (n.size()) {
+                                            default: M_unreachable("invalid size");
+                                            case  8: min_max.template operator()<int8_t >(); break;
+                                            case 16: min_max.template operator()<int16_t>(); break;
+                                            case 32: min_max.template operator()<int32_t>(); break;
+                                            case 64: min_max.template operator()<int64_t>(); break;
+                                        }
+                                        break;
+                                    case Numeric::N_Float:
+                                        if (n.size() <= 32)
+                                            min_max.template operator()<float>();
+                                        else
+                                            min_max.template operator()<double>();
+                                }
+                                break;
+                            }
+                            case m::Function::FN_AVG: {
+                                auto &[avg_backup, is_null_backup] = *M_notnull((
+                                    std::get_if<std::pair<Global<Double<L>>, Global<Bool<L>>>>(&agg_value_backups[idx])
+                                ));
+                                std::tie(avg_backup, is_null_backup) = *M_notnull((
+                                    std::get_if<std::pair<Var<Double<L>>, Var<Bool<L>>>>(&agg_values[idx])
+                                ));
+
+                                break;
+                            }
+                            case m::Function::FN_SUM: {
+                                M_insist(info.args.size() == 1, "SUM aggregate function expects exactly one argument");
+                                const auto &arg = *info.args[0];
+
+                                auto sum = [&]<typename T>() {
+                                    auto &[sum_backup, is_null_backup] = *M_notnull((
+                                        std::get_if<
+                                            std::pair<Global<PrimitiveExpr<T, L>>, Global<Bool<L>>>
+                                        >(&agg_value_backups[idx])
+                                    ));
+                                    std::tie(sum_backup, is_null_backup) = *M_notnull((
+                                        std::get_if<std::pair<Var<PrimitiveExpr<T, L>>, Var<Bool<L>>>>(&agg_values[idx])
+                                    ));
+                                };
+                                auto &n = as<const Numeric>(*info.entry.type);
+                                switch (n.kind) {
+                                    case Numeric::N_Int:
+                                    case Numeric::N_Decimal:
+                                        switch (n.size()) {
+                                            default: M_unreachable("invalid size");
+                                            case  8: sum.template operator()<int8_t >(); break;
+                                            case 16: sum.template operator()<int16_t>(); break;
+                                            case 32: sum.template operator()<int32_t>(); break;
+                                            case 64: sum.template operator()<int64_t>(); break;
+                                        }
+                                        break;
+                                    case Numeric::N_Float:
+                                        if (n.size() <= 32)
+                                            sum.template operator()<float>();
+                                        else
+                                            sum.template operator()<double>();
+                                }
+                                break;
+                            }
+                            case m::Function::FN_COUNT: {
+                                auto &count_backup = *M_notnull(std::get_if<Global<I64<L>>>(&agg_value_backups[idx]));
+                                count_backup = *M_notnull(std::get_if<Var<I64<L>>>(&agg_values[idx]));
+
+                                break;
+                            }
+                        }
+                    }
+
+                    /*----- Destroy created aggregates and their backups. -----*/
+                    for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
+                        agg_values[idx].~agg_t();
+                        agg_value_backups[idx].~agg_backup_t();
+                    }
+
+                    /*----- Free aggregates helper structures. -----*/
+                    delete[] agg_values;
+                    delete[] agg_value_backups;
+                };
+                switch (CodeGenContext::Get().num_simd_lanes()) {
+                    default: M_unreachable("unsupported number of SIMD lanes");
+                    case  1: execute_teardown.operator()<1>();  break;
+                    case  2: execute_teardown.operator()<2>();  break;
+                    case  4: execute_teardown.operator()<4>();  break;
+                    case  8: execute_teardown.operator()<8>();  break;
+                    case 16: execute_teardown.operator()<16>(); break;
+                    case 32: execute_teardown.operator()<32>(); break;
+                }
+            })
+        );
+    }
+    aggregation_child_pipeline(); // call child function
+
+    /*----- Emit setup code *before* possibly introducing temporary boolean variables to not overwrite them. -----*/
+    setup();
+
+    /*----- Emit code to finalize aggregate computations. -----*/
+    for (auto &fn : finalize_aggregates)
+        fn();
+
+    /*----- Add computed aggregates tuple to current environment. ----*/
+    auto &env = CodeGenContext::Get().env();
+    for (auto &e : M.aggregation.schema().deduplicate()) {
+        if (auto it = avg_aggregates.find(e.id);
+            it != avg_aggregates.end() and not it->second.compute_running_avg)
+        { // AVG aggregates which is not yet computed, divide computed sum with computed count
+            auto &avg_info = it->second;
+            auto sum = results.get(avg_info.sum);
+            auto count = results.get<_I64x1>(avg_info.running_count).insist_not_null().to<double>();
+            auto avg = convert<_Doublex1>(sum) / count;
+            M_insist(avg.can_be_null());
+            _Var<Doublex1> var(avg); // introduce variable s.t. uses only load from it
+            env.add(e.id, var);
+        } else { // already computed aggregate
+            std::visit(overloaded {
+                [&]<typename T>(Expr<T> value) -> void {
+                    if (value.can_be_null()) {
+                        Var<Expr<T>> var(value); // introduce variable s.t. uses only load from it
+                        env.add(e.id, var);
+                    } else {
+                        /* introduce variable w/o NULL bit s.t. uses only load from it */
+                        Var<PrimitiveExpr<T>> var(value.insist_not_null());
+                        env.add(e.id, Expr<T>(var));
+                    }
+                },
+                [](auto) -> void { M_unreachable("only scalar and non-string values must occur"); },
+                [](std::monostate) -> void { M_unreachable("invalid reference"); },
+            }, results.get(e.id)); // do not extract to be able to access for not-yet-computed AVG aggregates
+        }
+    }
+
+    /*----- Resume pipeline. -----*/
+    CodeGenContext::Get().set_num_simd_lanes(1); // since only a single tuple is produced
+    pipeline();
+
+    /*----- Emit teardown code. -----*/
+    teardown();
+}
+
+
+/*======================================================================================================================
+ * Sorting
+ *====================================================================================================================*/
+
+template<bool CmpPredicated>
+ConditionSet Quicksort<CmpPredicated>::pre_condition(std::size_t child_idx, const std::tuple<const SortingOperator*>&)
+{
+     M_insist(child_idx == 0);
+
+    ConditionSet pre_cond;
+
+    /*----- Sorting does not support SIMD. -----*/
+    pre_cond.add_condition(NoSIMD());
+
+    return pre_cond;
+}
+
+template<bool CmpPredicated>
+ConditionSet Quicksort<CmpPredicated>::post_condition(const Match<Quicksort> &M)
+{
+    ConditionSet post_cond;
+
+    /*----- Quicksort does not introduce predication. -----*/
+    post_cond.add_condition(Predicated(false));
+
+    /*----- Quicksort does sort the data. -----*/
+    Sortedness::order_t orders;
+    for (auto &o : M.sorting.order_by()) {
+        Schema::Identifier id(o.first);
+        if (orders.find(id) == orders.cend())
+            orders.add(std::move(id), o.second ? Sortedness::O_ASC : Sortedness::O_DESC);
+    }
+    post_cond.add_condition(Sortedness(std::move(orders)));
+
+    /*----- Sorting does not introduce SIMD. -----*/
+    post_cond.add_condition(NoSIMD());
+
+    return post_cond;
+}
+
+template<bool CmpPredicated>
+void Quicksort<CmpPredicated>::execute(const Match<Quicksort> &M, setup_t setup, pipeline_t pipeline,
+                                       teardown_t teardown)
+{
+    /*----- Create infinite buffer to materialize the current results but resume the pipeline later. -----*/
+    M_insist(bool(M.materializing_factory), "`wasm::Quicksort` must have a factory for the materialized child");
+    const auto buffer_schema = M.child->get_matched_root().schema().drop_constants().deduplicate();
+    const auto sorting_schema = M.sorting.schema().drop_constants().deduplicate();
+    GlobalBuffer buffer(
+        buffer_schema, *M.materializing_factory, false, 0, std::move(setup), std::move(pipeline), std::move(teardown)
+    );
+
+    /*----- Create child function. -----*/
+    FUNCTION(sorting_child_pipeline, void(void)) // create function for pipeline
+    {
+        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+
+        M.child->execute(
+            /* setup=    */ setup_t::Make_Without_Parent([&](){ buffer.setup(); }),
+            /* pipeline= */ [&](){ buffer.consume(); },
+            /* teardown= */ teardown_t::Make_Without_Parent([&](){ buffer.teardown(); })
+        );
+    }
+    sorting_child_pipeline(); // call child function
+
+    /*----- Invoke quicksort algorithm with buffer to sort. -----*/
+    quicksort<CmpPredicated>(buffer, M.sorting.order_by());
+
+    /*----- Process sorted buffer. -----*/
+    buffer.resume_pipeline(sorting_schema);
+}
+
+ConditionSet RadixSort::pre_condition(std::size_t child_idx,
+                                      const std::tuple<const SortingOperator*> &partial_inner_nodes)
+{
+    M_insist(child_idx == 0);
+
+    /*----- Radix sort needs all order expressions to fit into a single fixed-width key. -----*/
+    if (not radix_key_size_in_bits(std::get<0>(partial_inner_nodes)->order_by()))
+        return ConditionSet::Make_Unsatisfiable();
+
+    ConditionSet pre_cond;
+
+    /*----- Sorting does not support SIMD. -----*/
+    pre_cond.add_condition(NoSIMD());
+
+    return pre_cond;
+}
+
+ConditionSet RadixSort::post_condition(const Match<RadixSort> &M)
+{
+    ConditionSet post_cond;
+
+    /*----- Radix sort does not introduce predication. -----*/
+    post_cond.add_condition(Predicated(false));
+
+    /*----- Radix sort does sort the data. -----*/
+    Sortedness::order_t orders;
+    for (auto &o : M.sorting.order_by()) {
+        Schema::Identifier id(o.first);
+        if (orders.find(id) == orders.cend())
+            orders.add(std::move(id), o.second ? Sortedness::O_ASC : Sortedness::O_DESC);
+    }
+    post_cond.add_condition(Sortedness(std::move(orders)));
+
+    /*----- Sorting does not introduce SIMD. -----*/
+    post_cond.add_condition(NoSIMD());
+
+    return post_cond;
+}
+
+void RadixSort::execute(const Match<RadixSort> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    /*----- Create infinite buffer to materialize the current results but resume the pipeline later. -----*/
+    M_insist(bool(M.materializing_factory), "`wasm::RadixSort` must have a factory for the materialized child");
+    const auto buffer_schema = M.child->get_matched_root().schema().drop_constants().deduplicate();
+    const auto sorting_schema = M.sorting.schema().drop_constants().deduplicate();
+    GlobalBuffer buffer(
+        buffer_schema, *M.materializing_factory, false, 0, std::move(setup), std::move(pipeline), std::move(teardown)
+    );
+
+    /*----- Create child function. -----*/
+    FUNCTION(sorting_child_pipeline, void(void)) // create function for pipeline
+    {
+        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+
+        M.child->execute(
+            /* setup=    */ setup_t::Make_Without_Parent([&](){ buffer.setup(); }),
+            /* pipeline= */ [&](){ buffer.consume(); },
+            /* teardown= */ teardown_t::Make_Without_Parent([&](){ buffer.teardown(); })
+        );
+    }
+    sorting_child_pipeline(); // call child function
+
+    /*----- Invoke radix sort algorithm with buffer to sort. -----*/
+    radix_sort(buffer, M.sorting.order_by());
+
+    /*----- Process sorted buffer. -----*/
+    buffer.resume_pipeline(sorting_schema);
+}
+
+ConditionSet NoOpSorting::pre_condition(std::size_t child_idx,
+                                        const std::tuple<const SortingOperator*> &partial_inner_nodes)
+{
+    M_insist(child_idx == 0);
+
+    ConditionSet pre_cond;
+
+    /*----- NoOpSorting, i.e. a noop to match sorting, needs the data already sorted. -----*/
+    Sortedness::order_t orders;
+    for (auto &o : std::get<0>(partial_inner_nodes)->order_by()) {
+        Schema::Identifier id(o.first);
+        if (orders.find(id) == orders.cend())
+            orders.add(std::move(id), o.second ? Sortedness::O_ASC : Sortedness::O_DESC);
+    }
+    pre_cond.add_condition(Sortedness(std::move(orders)));
+
+    return pre_cond;
+}
+
+void NoOpSorting::execute(const Match<NoOpSorting> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    M.child->execute(std::move(setup), std::move(pipeline), std::move(teardown));
+}
+
+
+/*======================================================================================================================
+ * Join
+ *====================================================================================================================*/
+
+template<bool Predicated>
+ConditionSet NestedLoopsJoin<Predicated>::pre_condition(std::size_t, const std::tuple<const JoinOperator*>&)
+{
+    ConditionSet pre_cond;
+
+    /*----- Nested-loops join does not support SIMD. -----*/
+    pre_cond.add_condition(NoSIMD());
+
+    return pre_cond;
+}
+
+template<bool Predicated>
+ConditionSet NestedLoopsJoin<Predicated>::adapt_post_conditions(
+    const Match<NestedLoopsJoin>&,
+    std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children)
+{
+    M_insist(post_cond_children.size() >= 2);
+
+    ConditionSet post_cond(post_cond_children.back().get()); // preserve conditions of right-most child
+
+    if constexpr (Predicated) {
+        /*----- Predicated nested-loops join introduces predication. -----*/
+        post_cond.add_or_replace_condition(m::Predicated(true));
+    }
+
+    return post_cond;
+}
+
+template<bool Predicated>
+double NestedLoopsJoin<Predicated>::cost(const Match<NestedLoopsJoin> &M)
+{
+    double cost = 1;
+    for (auto &child : M.children)
+        cost *= child->get_matched_root().info().estimated_cardinality;
+    return cost;
+}
+
+template<bool Predicated>
+void NestedLoopsJoin<Predicated>::execute(const Match<NestedLoopsJoin> &M, setup_t setup, pipeline_t pipeline,
+                                          teardown_t teardown)
+{
+    const auto num_left_children = M.children.size() - 1; // all children but right-most one
+
+    std::vector<Schema> schemas; // to own adapted schemas
+    schemas.reserve(num_left_children);
+    std::vector<GlobalBuffer> buffers;
+    buffers.reserve(num_left_children);
+
+    /*----- Process all but right-most child. -----*/
+    for (std::size_t i = 0; i < num_left_children; ++i) {
+        /*----- Create function for each child. -----*/
+        FUNCTION(nested_loop_join_child_pipeline, void(void))
+        {
+            auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+
+            /*----- Create infinite buffer to materialize the current results. -----*/
+            M_insist(bool(M.materializing_factories_[i]),
+                     "`wasm::NestedLoopsJoin` must have a factory for each materialized child");
+            const auto &schema = schemas.emplace_back(
+                M.children[i]->get_matched_root().schema().drop_constants().deduplicate()
+            );
+            if (i == 0) {
+                /*----- Exactly one child (here left-most one) checks join predicate and resumes pipeline. -----*/
+                buffers.emplace_back(
+                    /* schema=        */ schema,
+                    /* factory=       */ *M.materializing_factories_[i],
+                    /* load_simdfied= */ false,
+                    /* num_tuples=    */ 0, // i.e. infinite
+                    /* setup=         */ setup_t::Make_Without_Parent(),
+                    /* pipeline=      */ [&, pipeline=std::move(pipeline)](){
+                        if constexpr (Predicated) {
+                            CodeGenContext::Get().env().add_predicate(M.join.predicate());
+                            pipeline();
+                        } else {
+                            M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes");
+                            IF (CodeGenContext::Get().env().compile<_Boolx1>(M.join.predicate()).is_true_and_not_null()) {
+                                pipeline();
+                            };
+                        }
+                    },
+                    /* teardown=      */ teardown_t::Make_Without_Parent()
+                );
+            } else {
+                /*----- All but exactly one child (here left-most one) load lastly inserted buffer again. -----*/
+                /* All buffers are "connected" with each other by setting the pipeline callback as calling the
+                 * `resume_pipeline_inline()` method of the lastly inserted buffer. Therefore, calling
+                 * `resume_pipeline_inline()` on the lastly inserted buffer will load one tuple from it, recursively
+                 * call `resume_pipeline_inline()` on the buffer created before that which again loads one tuple from
+                 * it, and so on until the buffer inserted first (here the one of the left-most child) will load one
+                 * of its tuples and check the join predicate for this one cartesian-product-combination of result
+                 * tuples. */
+                buffers.emplace_back(
+                    /* schema=        */ schema,
+                    /* factory=       */ *M.materializing_factories_[i],
+                    /* load_simdfied= */ false,
+                    /* num_tuples=    */ 0, // i.e. infinite
+                    /* setup=         */ setup_t::Make_Without_Parent(),
+                    /* pipeline=      */ [&](){ buffers.back().resume_pipeline_inline(); },
+                    /* teardown=      */ teardown_t::Make_Without_Parent()
+                );
+            }
+
+            /*----- Materialize the current result tuple in pipeline. -----*/
+            M.children[i]->execute(
+                /* setup=    */ setup_t::Make_Without_Parent([&](){ buffers.back().setup(); }),
+                /* pipeline= */ [&](){ buffers.back().consume(); },
+                /* teardown= */ teardown_t::Make_Without_Parent([&](){ buffers.back().teardown(); })
+            );
+        }
+        nested_loop_join_child_pipeline(); // call child function
+    }
+
+    /*----- Process right-most child. -----*/
+    M.children.back()->execute(
+        /* setup=    */ std::move(setup),
+        /* pipeline= */ [&](){ buffers.back().resume_pipeline_inline(); },
+        /* teardown= */ std::move(teardown)
+    );
+}
+
+template<idx::IndexMethod IndexMethod>
+ConditionSet IndexNestedLoopsJoin<IndexMethod>::pre_condition(
+    std::size_t child_idx,
+    const std::tuple<const JoinOperator*, const ScanOperator*, const Wildcard*> &partial_inner_nodes)
+{
+    M_insist(child_idx == 0);
+
+    ConditionSet pre_cond;
+
+    /*----- Index nested-loops join can only be used for binary joins on a single equi-predicate. -----*/
+    auto &join = *std::get<0>(partial_inner_nodes);
+    if (not join.predicate().is_equi() or join.predicate().size() != 1)
+        return ConditionSet::Make_Unsatisfiable();
+
+    /*----- Decompose the equi-predicate of the form `A.x = B.y` into the indexed key and the outer key. -----*/
+    auto &scan = *M_notnull(std::get<1>(partial_inner_nodes));
+    auto &literal = join.predicate()[0][0];
+    auto &binary = as<const BinaryExpr>(literal.expr());
+    M_insist(is<const Designator>(binary.lhs), "invalid equi-predicate");
+    M_insist(is<const Designator>(binary.rhs), "invalid equi-predicate");
+    Schema::Identifier id_first(*binary.lhs), id_second(*binary.rhs);
+    const bool has_first = scan.schema().has(id_first);
+    if (has_first == scan.schema().has(id_second)) // scanned table must contain exactly one of the keys
+        return ConditionSet::Make_Unsatisfiable();
+    const auto &inner_key = has_first ? id_first : id_second;
+
+    /*----- Index nested-loops join passes the outer keys to the index as is, hence only supports numeric keys of the
+     * same type. -----*/
+    if (binary.lhs->type() != binary.rhs->type() or binary.lhs->type()->is_boolean() or
+        binary.lhs->type()->is_character_sequence())
+        return ConditionSet::Make_Unsatisfiable();
+
+    /*----- Check if index on the indexed key exists. -----*/
+    auto &table = scan.store().table();
+    if (table.layout().is_finite()) // point accesses require an infinite layout
+        return ConditionSet::Make_Unsatisfiable();
+    auto &DB = Catalog::Get().get_database_in_use();
+    if (not DB.has_index(table.name(), inner_key.name, IndexMethod))
+        return ConditionSet::Make_Unsatisfiable();
+
+    /*----- Index nested-loops join does not support SIMD. -----*/
+    pre_cond.add_condition(NoSIMD());
+
+    return pre_cond;
+}
+
+template<idx::IndexMethod IndexMethod>
+ConditionSet IndexNestedLoopsJoin<IndexMethod>::adapt_post_condition(const Match<IndexNestedLoopsJoin>&,
+                                                                    const ConditionSet &post_cond_child)
+{
+    ConditionSet post_cond(post_cond_child); // preserve conditions of outer child, e.g. its sortedness
+
+    /*----- Index nested-loops join does not introduce SIMD. -----*/
+    post_cond.add_or_replace_condition(NoSIMD());
+
+    /*----- Index nested-loops join does not introduce predication since it emits matching tuples only. -----*/
+    post_cond.add_or_replace_condition(m::Predicated(false));
+
+    return post_cond;
+}
+
+template<idx::IndexMethod IndexMethod>
+double IndexNestedLoopsJoin<IndexMethod>::cost(const Match<IndexNestedLoopsJoin> &M)
+{
+    /* Each outer tuple is looked up in the index and each result tuple is loaded via a point access whereas, in
+     * contrast to hash joins, the indexed table is never consumed entirely. */
+    constexpr double LOOKUP_COST = 2.0;
+    return LOOKUP_COST * M.outer.info().estimated_cardinality + M.join.info().estimated_cardinality;
+}
+
+template<idx::IndexMethod IndexMethod, typename Index, sql_type SqlT>
+void index_nested_loops_join_codegen(const Index &index, const Schema::Identifier &outer_key,
+                                     const Match<IndexNestedLoopsJoin<IndexMethod>> &M,
+                                     setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    using key_type = typename SqlT::type;
+
+    /*----- Resolve callback function names. -----*/
+    const char *seek_batch_fn, *scan_fn;
+#define SET_CALLBACK_FNS(INDEX, KEY) \
+    seek_batch_fn = M_STR(idx_seek_batch_##INDEX##_##KEY); \
+    scan_fn       = M_STR(idx_scan_##INDEX##_##KEY)
+
+#define RESOLVE_KEYTYPE(INDEX) \
+    if constexpr(std::same_as<SqlT, _I8x1>) { \
+        SET_CALLBACK_FNS(INDEX, i1); \
+    } else if constexpr(std::same_as<SqlT, _I16x1>) { \
+        SET_CALLBACK_FNS(INDEX, i2); \
+    } else if constexpr(std::same_as<SqlT, _I32x1>) { \
+        SET_CALLBACK_FNS(INDEX, i4); \
+    } else if constexpr(std::same_as<SqlT, _I64x1>) { \
+        SET_CALLBACK_FNS(INDEX, i8); \
+    } else if constexpr(std::same_as<SqlT, _Floatx1>) { \
+        SET_CALLBACK_FNS(INDEX, f); \
+    } else if constexpr(std::same_as<SqlT, _Doublex1>) { \
+        SET_CALLBACK_FNS(INDEX, d); \
+    } else { \
+        M_unreachable("incompatible SQL type"); \
+    }
+    if constexpr(is_specialization<Index, idx::ArrayIndex>) {
+        RESOLVE_KEYTYPE(array)
+    } else if constexpr(is_specialization<Index, idx::RecursiveModelIndex>) {
+        RESOLVE_KEYTYPE(rmi)
+    } else {
+        M_unreachable("unknown index type");
+    }
+#undef RESOLVE_KEYTYPE
+#undef SET_CALLBACK_FNS
+
+    /*----- Add index to context. -----*/
+    auto &context = WasmEngine::Get_Wasm_Context_By_ID(Module::ID());
+    const auto index_id = context.add_index(index);
+
+    M_insist(std::in_range<uint32_t>(M.probe_window_size), "probe window size must fit in uint32_t");
+    M_insist(M.probe_window_size > 0, "probe window must not be empty");
+    M_insist(std::in_range<uint32_t>(M.batch_size), "should fit in uint32_t");
+    const uint32_t window_size = M.probe_window_size;
+    const auto window_schema = M.outer.schema().drop_constants().deduplicate();
+
+    /*----- Pre-allocate the keys of the window, the ranges of index entries with equal keys, and their number. -----*/
+    Ptr<PrimitiveExpr<key_type>> keys = Module::Allocator().pre_malloc<key_type>(window_size);
+    Ptr<U32x1> ranges = Module::Allocator().pre_malloc<uint32_t>(2 * window_size);
+    Ptr<U32x1> num_keys = Module::Allocator().pre_malloc<uint32_t>();
+
+    /*----- Create function to load all tuples of the indexed table referenced by the index entries in [lo, hi) and
+     * resume the pipeline for each of them, communicating their tuple IDs in batches as `wasm::IndexScan` does. -----*/
+    auto join_range = [&, pipeline=std::move(pipeline)](Var<U32x1> &lo, const Var<U32x1> &hi){
+        index_sequential_scan_batched(
+            /* scan_fn=       */ scan_fn,
+            /* index_id=      */ U64x1(index_id),
+            /* lo=            */ lo,
+            /* hi=            */ hi,
+            /* batch_size=    */ M.batch_size,
+            /* break_on_exit= */ false,
+            /* setup=         */ setup_t::Make_Without_Parent(),
+            /* consume=       */ [&](U32x1 tuple_id) {
+                static Schema empty_schema;
+                compile_load_point_access(
+                    /* tuple_value_schema=   */ M.scan.schema(),
+                    /* tuple_address_schema= */ empty_schema,
+                    /* base_address=         */ get_base_address(M.scan.store().table().name()),
+                    /* layout=               */ M.scan.store().table().layout(),
+                    /* layout_schema=        */ M.scan.store().table().schema(M.scan.alias()),
+                    /* tuple_id=             */ tuple_id
+                );
+                pipeline();
+            },
+            /* teardown=      */ teardown_t::Make_Without_Parent()
+        );
+    };
+
+    /*----- Buffer a window of outer tuples while storing their keys, then look up the keys of the entire window by a
+     * single host call, and only then join the buffered tuples with their ranges of index entries. -----*/
+    std::optional<Var<U32x1>> window_idx; ///< index of the currently joined tuple in the window
+    GlobalBuffer window(
+        /* schema=        */ window_schema,
+        /* factory=       */ *M.probe_window_factory,
+        /* load_simdfied= */ false,
+        /* num_tuples=    */ window_size,
+        /* setup=         */ setup_t(std::move(setup), [&](){
+            Module::Get().emit_call<void>(
+                /* fn=       */ seek_batch_fn,
+                /* index_id= */ U64x1(index_id),
+                /* keys=     */ keys.clone(),
+                /* num_keys= */ U32x1(*num_keys.clone()),
+                /* ranges=   */ ranges.clone()
+            );
+            window_idx.emplace(0U);
+        }),
+        /* pipeline=      */ [&](){
+            M_insist(bool(window_idx));
+            Var<U32x1> lo(*(ranges.clone() + (window_idx->val() * 2U).make_signed()));
+            const Var<U32x1> hi(*(ranges.clone() + (window_idx->val() * 2U + 1U).make_signed()));
+            *window_idx += 1U;
+            join_range(lo, hi);
+        },
+        /* teardown=      */ teardown_t(std::move(teardown), [&](){
+            window_idx.reset();
+            *num_keys.clone() = 0U; // since the window is emptied after resuming the pipeline
+        })
+    );
+
+    M.child->execute(
+        /* setup=    */ setup_t::Make_Without_Parent([&](){
+            window.setup();
+            *num_keys.clone() = 0U;
+        }),
+        /* pipeline= */ [&](){
+            auto &env = CodeGenContext::Get().env();
+
+            /*----- Append the outer key to the window before buffering the tuple itself.  Tuples with NULL key are
+             * dropped since they have no join partner. -----*/
+            SQL_t key_variant = env.get(outer_key);
+            auto [key, key_is_null] = convert<SqlT>(key_variant).split();
+            IF (not key_is_null) {
+                const Var<U32x1> num(U32x1(*num_keys.clone()));
+                *(keys.clone() + num.val().make_signed()) = key;
+                *num_keys.clone() = num + 1U;
+                window.consume();
+            };
+        },
+        /* teardown= */ teardown_t::Make_Without_Parent([&](){ window.teardown(); })
+    );
+    window.resume_pipeline(); // join remaining tuples of the window
+
+    keys.discard(); // since it was always cloned
+    ranges.discard(); // since it was always cloned
+    num_keys.discard(); // since it was always cloned
+}
+
+/** Resolves the index method and calls the codegen function of the index nested-loops join. */
+template<idx::IndexMethod IndexMethod, typename AttrT, sql_type SqlT>
+void index_nested_loops_join_resolve_index_method(const Schema::Identifier &inner_key,
+                                                  const Schema::Identifier &outer_key,
+                                                  const Match<IndexNestedLoopsJoin<IndexMethod>> &M,
+                                                  setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    /*----- Lookup index. -----*/
+    auto &DB = Catalog::Get().get_database_in_use();
+    auto &index_base = DB.get_index(M.scan.store().table().name(), inner_key.name, IndexMethod);
+
+    /*----- Resolve index type. -----*/
+    if constexpr(IndexMethod == idx::IndexMethod::Array and requires { typename idx::ArrayIndex<AttrT>; }) {
+        auto &index = as<const idx::ArrayIndex<AttrT>>(index_base);
+        index_nested_loops_join_codegen<IndexMethod, const idx::ArrayIndex<AttrT>, SqlT>(
+            index, outer_key, M, std::move(setup), std::move(pipeline), std::move(teardown)
+        );
+    } else if constexpr(IndexMethod == idx::IndexMethod::Rmi and requires { typename idx::RecursiveModelIndex<AttrT>; }) {
+        auto &index = as<const idx::RecursiveModelIndex<AttrT>>(index_base);
+        index_nested_loops_join_codegen<IndexMethod, const idx::RecursiveModelIndex<AttrT>, SqlT>(
+            index, outer_key, M, std::move(setup), std::move(pipeline), std::move(teardown)
+        );
+    } else {
+        M_unreachable("invalid index method");
+    }
+}
+
+template<idx::IndexMethod IndexMethod>
+void IndexNestedLoopsJoin<IndexMethod>::execute(const Match<IndexNestedLoopsJoin> &M, setup_t setup,
+                                                pipeline_t pipeline, teardown_t teardown)
+{
+    auto &schema = M.scan.schema();
+    M_insist(schema == schema.drop_constants().deduplicate(), "Schema of `ScanOperator` must neither contain NULL nor duplicates");
+    M_insist(not M.scan.store().table().layout().is_finite(),
+             "layout for `wasm::IndexNestedLoopsJoin` must be infinite");
+
+    /*----- Index lookups register the index in the Wasm context, hence the module must not be reused for later
+     * executions. -----*/
+    CodeGenContext::Get().mark_module_not_reusable();
+
+    /*----- Decompose the join predicate of the form `A.x = B.y` into the indexed key and the outer key. -----*/
+    const auto [inner_keys, outer_keys] = decompose_equi_predicate(M.join.predicate(), schema);
+    M_insist(inner_keys.size() == 1, "index nested-loops join requires exactly one equi-predicate");
+    auto &inner_key = inner_keys[0];
+    auto &outer_key = outer_keys[0];
+
+    /*----- Resolve attribute type. -----*/
+#define RESOLVE_INDEX_METHOD(ATTRTYPE, SQLTYPE) \
+    index_nested_loops_join_resolve_index_method<IndexMethod, ATTRTYPE, SQLTYPE>( \
+        inner_key, outer_key, M, std::move(setup), std::move(pipeline), std::move(teardown) \
+    )
+
+    visit(overloaded {
+        [&](const Numeric &n) {
+            switch (n.kind) {
+                case Numeric::N_Int:
+                case Numeric::N_Decimal:
+                    switch (n.size()) {
+                        default: M_unreachable("invalid size");
+                        case  8: RESOLVE_INDEX_METHOD(int8_t,   _I8x1); break;
+                        case 16: RESOLVE_INDEX_METHOD(int16_t, _I16x1); break;
+                        case 32: RESOLVE_INDEX_METHOD(int32_t, _I32x1); break;
+                        case 64: RESOLVE_INDEX_METHOD(int64_t, _I64x1); break;
+                    }
+                    break;
+                case Numeric::N_Float:
+                    switch (n.size()) {
+                        default: M_unreachable("invalid size");
+                        case 32: RESOLVE_INDEX_METHOD(float,   _Floatx1); break;
+                        case 64: RESOLVE_INDEX_METHOD(double, _Doublex1); break;
+                    }
+                    break;
+            }
+        },
+        [&](const Date&) { RESOLVE_INDEX_METHOD(int32_t, _I32x1); },
+        [&](const DateTime&) { RESOLVE_INDEX_METHOD(int64_t, _I64x1); },
+        [](auto&&) { M_unreachable("invalid type"); },
+    }, *schema[inner_key].second.type);
+
+#undef RESOLVE_INDEX_METHOD
+}
+
+template<bool UniqueBuild, bool Predicated>
+ConditionSet SimpleHashJoin<UniqueBuild, Predicated>::pre_condition(
+    std::size_t child_idx,
+    const std::tuple<const JoinOperator*, const Wildcard*, const Wildcard*> &partial_inner_nodes)
+{
+    ConditionSet pre_cond;
+
+    /*----- Simple hash join can only be used for binary joins on equi-predicates. -----*/
+    auto &join = *std::get<0>(partial_inner_nodes);
+    if (not join.predicate().is_equi())
+        return ConditionSet::Make_Unsatisfiable();
+
+    if constexpr (UniqueBuild) {
+        /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
+        auto &build = *std::get<1>(partial_inner_nodes);
+        for (auto &clause : join.predicate()) {
+            M_insist(clause.size() == 1, "invalid equi-predicate");
+            auto &literal = clause[0];
+            auto &binary = as<const BinaryExpr>(literal.expr());
+            M_insist((not literal.negative() and binary.tok == TK_EQUAL) or
+                     (literal.negative() and binary.tok == TK_BANG_EQUAL), "invalid equi-predicate");
+            M_insist(is<const Designator>(binary.lhs), "invalid equi-predicate");
+            M_insist(is<const Designator>(binary.rhs), "invalid equi-predicate");
+            Schema::Identifier id_first(*binary.lhs), id_second(*binary.rhs);
+            const auto &entry_build = build.schema().has(id_first) ? build.schema()[id_first].second
+                                                                   : build.schema()[id_second].second;
+
+            /*----- Unique simple hash join can only be used on unique build key. -----*/
+            if (not entry_build.unique())
+                return ConditionSet::Make_Unsatisfiable();
+        }
+    }
+
+    /*----- Simple hash join supports SIMD on the probe child iff probing is windowed and each window can hold whole
+     * SIMD batches, i.e. its size is a whole multiple of the maximal number of 32 SIMD lanes.  Otherwise, simple hash
+     * join does not support SIMD. -----*/
+    const auto window_size = options::simple_hash_join_probe_window_size;
+    if (child_idx == 0 or window_size == 0 or window_size % 32 != 0)
+        pre_cond.add_condition(NoSIMD());
+    else
+        pre_cond.add_condition(m::Predicated(false)); // SIMDfication with predication not supported
+
+    return pre_cond;
+}
+
+template<bool UniqueBuild, bool Predicated>
+ConditionSet SimpleHashJoin<UniqueBuild, Predicated>::adapt_post_conditions(
+    const Match<SimpleHashJoin>&,
+    std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children)
+{
+    M_insist(post_cond_children.size() == 2);
+
+    ConditionSet post_cond(post_cond_children[1].get()); // preserve conditions of right child
+
+    /*----- Simple hash join does not introduce SIMD, i.e. SIMD of the probe child ends at the probe window. -----*/
+    post_cond.add_or_replace_condition(NoSIMD());
+
+    if constexpr (Predicated) {
+        /*----- Predicated simple hash join introduces predication. -----*/
+        post_cond.add_or_replace_condition(m::Predicated(true));
+    } else {
+        /*----- Branching simple hash join does not introduce predication (it is already handled by the hash table). -*/
+        post_cond.add_or_replace_condition(m::Predicated(false));
+    }
+
+    return post_cond;
+}
+
+template<bool UniqueBuild, bool Predicated>
+double SimpleHashJoin<UniqueBuild, Predicated>::cost(const Match<SimpleHashJoin> &M)
+{
+    if (options::simple_hash_join_ordering_strategy == option_configs::OrderingStrategy::BUILD_ON_LEFT)
+        return (M.build.id() == M.children[0]->get_matched_root().id() ? 1.0 : 2.0) + (UniqueBuild ? 0.0 : 0.1);
+    else if (options::simple_hash_join_ordering_strategy == option_configs::OrderingStrategy::BUILD_ON_RIGHT)
+        return M.build.id() == M.children[1]->get_matched_root().id() ? 1.0 : 2.0 + (UniqueBuild ? 0.0 : 0.1);
+    return simple_hash_join_cost(M.build, M.probe, UniqueBuild);
+}
+
+template<bool UniqueBuild, bool Predicated>
+void SimpleHashJoin<UniqueBuild, Predicated>::execute(const Match<SimpleHashJoin> &M, setup_t setup,
+                                                      pipeline_t pipeline, teardown_t teardown)
+{
+    M_insist(((M.join.schema() | M.join.predicate().get_required()) & M.build.schema()) == M.build.schema());
+    M_insist(M.build.schema().drop_constants() == M.build.schema());
+    const auto ht_schema = M.build.schema().deduplicate();
+
+    /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
+    const auto [build_keys, probe_keys] = decompose_equi_predicate(M.join.predicate(), ht_schema);
+
+    /*----- Compute payload IDs and the total sizes in bits of keys and payload (ignoring padding). -----*/
+    std::vector<Schema::Identifier> payload_ids;
+    uint64_t keys_size_in_bits = 0;
+    uint64_t payload_size_in_bits = 0;
+    for (auto &e : ht_schema) {
+        if (contains(build_keys, e.id)) {
+            keys_size_in_bits += e.type->size();
+        } else {
+            payload_ids.push_back(e.id);
+            payload_size_in_bits += e.type->size();
+        }
+    }
+    const auto [in_place, quadratic] = choose_open_addressing_strategies(
+        M.use_in_place_values, M.use_quadratic_probing, M.load_factor, keys_size_in_bits, payload_size_in_bits
+    );
+
+    /*----- Compute initial capacity of hash table. -----*/
+    uint32_t initial_capacity = compute_initial_ht_capacity(M.build, M.load_factor);
+
+    /*----- Create hash table for build child. -----*/
+    std::unique_ptr<HashTable> ht;
+    std::vector<HashTable::index_t> build_key_indices;
+    for (auto &build_key : build_keys)
+        build_key_indices.push_back(ht_schema[build_key].first);
+    if (M.use_swiss_hashing and in_place) {
+        ht = std::make_unique<GlobalSwissHashTable>(ht_schema, std::move(build_key_indices), initial_capacity);
+    } else if (M.use_open_addressing_hashing or M.use_swiss_hashing) { // Swiss tables store values only in-place
+        if (in_place)
+            ht = std::make_unique<GlobalOpenAddressingInPlaceHashTable>(ht_schema, std::move(build_key_indices),
+                                                                        initial_capacity);
+        else
+            ht = std::make_unique<GlobalOpenAddressingOutOfPlaceHashTable>(ht_schema, std::move(build_key_indices),
+                                                                           initial_capacity);
+        if (quadratic)
+            as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<QuadraticProbing>();
+        else
+            as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<LinearProbing>();
+    } else {
+        ht = std::make_unique<GlobalChainedHashTable>(ht_schema, std::move(build_key_indices), initial_capacity);
+    }
+
+    /*----- Create Bloom filter on the build keys, sized for the expected number of build tuples, if requested. -----*/
+    std::optional<BloomFilter> bloom_filter;
+    if (M.use_bloom_filter)
+        bloom_filter.emplace(compute_initial_ht_capacity(M.build, 1.0));
+
+    /*----- Track the range of the build keys if there is a single integral key, if requested. -----*/
+    auto is_integral_key = [](const Type *ty) { return ty->is_integral() or ty->is_date() or ty->is_date_time(); };
+    std::optional<Global<I64x1>> key_min, key_max;
+    if (M.use_key_range_filter and build_keys.size() == 1 and
+        is_integral_key(ht_schema[build_keys.front()].second.type) and
+        is_integral_key(M.probe.schema()[probe_keys.front()].second.type))
+    {
+        key_min.emplace(std::numeric_limits<int64_t>::max());
+        key_max.emplace(std::numeric_limits<int64_t>::min());
+    }
+
+    /*----- Create function to split the single integral key \p key into its value as 64 bit integer and its NULL
+     * bit. -----*/
+    auto split_key = [](SQL_t key) -> std::pair<I64x1, Boolx1> {
+        return std::visit(overloaded {
+            []<typename T>(Expr<T> _val) -> std::pair<I64x1, Boolx1>
+            requires std::integral<T> and (not std::same_as<T, bool>) {
+                auto [val, is_null] = _val.split();
+                return { val.template to<int64_t>(), is_null };
+            },
+            [](auto) -> std::pair<I64x1, Boolx1> { M_unreachable("key range requires a single integral key"); },
+            [](std::monostate) -> std::pair<I64x1, Boolx1> { M_unreachable("invalid variant"); }
+        }, std::move(key));
+    };
+
+    /*----- Create function to check whether the single probe key \p key lies within the range of the build keys. */
+    auto in_key_range = [&](SQL_t key) -> Boolx1 {
+        M_insist(key_min and key_max);
+        auto [val, is_null] = split_key(std::move(key));
+        const Var<I64x1> k(val); // due to multiple uses
+        return not is_null and k >= *key_min and k <= *key_max;
+    };
+
+    /*----- Create function for build child. -----*/
+    FUNCTION(simple_hash_join_child_pipeline, void(void)) // create function for pipeline
+    {
+        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+
+        M.children[0]->execute(
+            /* setup=    */ setup_t::Make_Without_Parent([&](){
+                ht->setup();
+                ht->set_high_watermark(M.load_factor);
+                if (bloom_filter)
+                    bloom_filter->clear();
+                if (key_min) {
+                    *key_min = I64x1(std::numeric_limits<int64_t>::max());
+                    *key_max = I64x1(std::numeric_limits<int64_t>::min());
+                }
+            }),
+            /* pipeline= */ [&](){
+                auto &env = CodeGenContext::Get().env();
+
+                std::optional<Boolx1> build_key_not_null;
+                for (auto &build_key : build_keys) {
+                    auto val = env.get(build_key);
+                    if (build_key_not_null)
+                        build_key_not_null.emplace(*build_key_not_null and not_null(val));
+                    else
+                        build_key_not_null.emplace(not_null(val));
+                }
+                M_insist(bool(build_key_not_null));
+                IF (*build_key_not_null) { // TODO: predicated version
+                    /*----- Insert key. -----*/
+                    std::vector<SQL_t> key;
+                    for (auto &build_key : build_keys)
+                        key.emplace_back(env.get(build_key));
+                    if (bloom_filter) {
+                        std::vector<SQL_t> bloom_filter_key;
+                        for (auto &build_key : build_keys)
+                            bloom_filter_key.emplace_back(env.get(build_key));
+                        bloom_filter->insert(ht->hash(std::move(bloom_filter_key)));
+                    }
+                    if (key_min) {
+                        const Var<I64x1> k(split_key(env.get(build_keys.front())).first); // due to multiple uses
+                        *key_min = Select(k < *key_min, k, *key_min);
+                        *key_max = Select(k > *key_max, k, *key_max);
+                    }
+                    auto entry = ht->emplace(std::move(key));
+
+                    /*----- Insert payload. -----*/
+                    for (auto &id : payload_ids) {
+                        std::visit(overloaded {
+                            [&]<sql_type T>(HashTable::reference_t<T> &&r) -> void { r = env.extract<T>(id); },
+                            [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                        }, entry.extract(id));
+                    }
+                };
+            },
+            /* teardown= */ teardown_t::Make_Without_Parent([&](){ ht->teardown(); })
+        );
+    }
+    simple_hash_join_child_pipeline(); // call child function
+
+    /*----- Create function to probe the hash table with the current tuple using the poss. given bucket hint. -----*/
+    auto probe = [&, pipeline=std::move(pipeline)](HashTable::hint_t bucket_hint){
+        auto &env = CodeGenContext::Get().env();
+
+        auto emit_tuple_and_resume_pipeline = [&, pipeline=std::move(pipeline)](HashTable::const_entry_t entry){
+            /*----- Add found entry from hash table, i.e. from build child, to current environment. -----*/
+            for (auto &e : ht_schema) {
+                if (not entry.has(e.id)) { // entry may not contain build key in case `ht->find()` was used
+                    M_insist(contains(build_keys, e.id));
+                    M_insist(env.has(e.id), "build key must already be contained in the current environment");
+                    continue;
+                }
+
+                std::visit(overloaded {
+                    [&]<typename T>(HashTable::const_reference_t<Expr<T>> &&r) -> void {
+                        Expr<T> value = r;
+                        if (value.can_be_null()) {
+                            Var<Expr<T>> var(value); // introduce variable s.t. uses only load from it
+                            env.add(e.id, var);
+                        } else {
+                            /* introduce variable w/o NULL bit s.t. uses only load from it */
+                            Var<PrimitiveExpr<T>> var(value.insist_not_null());
+                            env.add(e.id, Expr<T>(var));
+                        }
+                    },
+                    [&](HashTable::const_reference_t<NChar> &&r) -> void {
+                        NChar value(r);
+                        Var<Ptr<Charx1>> var(value.val()); // introduce variable s.t. uses only load from it
+                        env.add(e.id, NChar(var, value.can_be_null(), value.length(),
+                                            value.guarantees_terminating_nul()));
+                    },
+                    [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                }, entry.extract(e.id));
+            }
+
+            /*----- Resume pipeline. -----*/
+            pipeline();
+        };
+
+        /* TODO: may check for NULL on probe keys as well, branching + predicated version */
+        /*----- Probe with probe key. -----*/
+        std::vector<SQL_t> key;
+        for (auto &probe_key : probe_keys)
+            key.emplace_back(env.get(probe_key));
+        if constexpr (UniqueBuild) {
+            /*----- Add build key to current environment since `ht->find()` will only return the payload values. -----*/
+            for (auto build_it = build_keys.cbegin(), probe_it = probe_keys.cbegin(); build_it != build_keys.cend();
+                 ++build_it, ++probe_it)
+            {
+                M_insist(probe_it != probe_keys.cend());
+                if (not env.has(*build_it)) // skip duplicated build keys and only add first occurrence
+                    env.add(*build_it, env.get(*probe_it)); // since build and probe keys match for join partners
+            }
+
+            /*----- Try to find the *single* possible join partner. -----*/
+            auto p = ht->find(std::move(key), std::move(bucket_hint));
+            auto &entry = p.first;
+            auto &found = p.second;
+            if constexpr (Predicated) {
+                env.add_predicate(found);
+                emit_tuple_and_resume_pipeline(std::move(entry));
+            } else {
+                IF (found) {
+                    emit_tuple_and_resume_pipeline(std::move(entry));
+                };
+            }
+        } else {
+            /*----- Search for *all* join partners. -----*/
+            ht->for_each_in_equal_range(std::move(key), std::move(emit_tuple_and_resume_pipeline), Predicated,
+                                        std::move(bucket_hint));
+        }
+    };
+
+    if (M.probe_window_size == 0) {
+        M.children[1]->execute(
+            /* setup=    */ setup_t(std::move(setup), [&](){ ht->setup(); }),
+            /* pipeline= */ [&](){
+                auto &env = CodeGenContext::Get().env();
+                auto filter_and_probe = [&](){
+                    if (bloom_filter) {
+                        /*----- Drop probe tuples whose key was definitely not inserted before accessing the hash
+                         * table. -----*/
+                        std::vector<SQL_t> key;
+                        for (auto &probe_key : probe_keys)
+                            key.emplace_back(env.get(probe_key));
+                        IF (bloom_filter->contains(ht->hash(std::move(key)))) {
+                            probe(HashTable::hint_t());
+                        };
+                    } else {
+                        probe(HashTable::hint_t());
+                    }
+                };
+                if (key_min) {
+                    /*----- Drop probe tuples whose key lies outside of the range of the build keys. -----*/
+                    IF (in_key_range(env.get(probe_keys.front()))) {
+                        filter_and_probe();
+                    };
+                } else {
+                    filter_and_probe();
+                }
+            },
+            /* teardown= */ teardown_t(std::move(teardown), [&](){ ht->teardown(); })
+        );
+    } else {
+        /*----- Probe batches of tuples: hash the probe keys while buffering a window of probe tuples, then compute and
+         * touch the buckets of the entire window, and only then actually probe the buffered tuples.  Thereby, the
+         * cache misses of accessing the buckets of the window overlap instead of stalling each probe. -----*/
+        M_insist(bool(M.probe_window_factory),
+                 "`wasm::SimpleHashJoin` must have a factory for the window of buffered probe tuples");
+        M_insist(std::in_range<uint32_t>(M.probe_window_size), "probe window size must fit in uint32_t");
+        const uint32_t window_size = M.probe_window_size;
+        const auto window_schema = M.probe.schema().drop_constants().deduplicate();
+
+        /*----- Pre-allocate the hashes and buckets of the window as well as their current number. -----*/
+        Ptr<U64x1> hashes = Module::Allocator().pre_malloc<uint64_t>(window_size);
+        Ptr<U32x1> buckets = Module::Allocator().pre_malloc<uint32_t>(window_size);
+        Ptr<U32x1> num_hashes = Module::Allocator().pre_malloc<uint32_t>();
+        Ptr<U32x1> touched_sink = Module::Allocator().pre_malloc<uint32_t>(); // to not optimize away touching loads
+
+        std::optional<Var<U32x1>> window_idx; ///< index of the currently probed tuple in the window
+        GlobalBuffer window(
+            /* schema=        */ window_schema,
+            /* factory=       */ *M.probe_window_factory,
+            /* load_simdfied= */ false,
+            /* num_tuples=    */ window_size,
+            /* setup=         */ setup_t(std::move(setup), [&](){
+                ht->setup();
+
+                /*----- Compute and touch the buckets of all hashes of the window. -----*/
+                Var<U32x1> idx(0U);
+                Var<U32x1> touched(0U);
+                WHILE (idx < U32x1(*num_hashes.clone())) {
+                    const Var<Ptr<void>> bucket(ht->bucket_of(*(hashes.clone() + idx.val().make_signed())));
+                    touched |= U32x1(*bucket.val().to<uint32_t*>()); // load bucket into the cache
+                    *(buckets.clone() + idx.val().make_signed()) = bucket.val().to<uint32_t>();
+                    idx += 1U;
+                }
+                *touched_sink.clone() = touched.val();
+
+                window_idx.emplace(0U);
+            }),
+            /* pipeline=      */ [&](){
+                M_insist(bool(window_idx));
+                HashTable::hint_t bucket_hint;
+                if (not CodeGenContext::Get().env().predicated()) // predicated probes must compute their dummy bucket
+                    bucket_hint.emplace(Ptr<void>(*(buckets.clone() + window_idx->val().make_signed())));
+                *window_idx += 1U;
+                probe(std::move(bucket_hint));
+            },
+            /* teardown=      */ teardown_t(std::move(teardown), [&](){
+                ht->teardown();
+                window_idx.reset();
+                *num_hashes.clone() = 0U; // since the window is emptied after resuming the pipeline
+            })
+        );
+
+        M.children[1]->execute(
+            /* setup=    */ setup_t::Make_Without_Parent([&](){
+                window.setup();
+                *num_hashes.clone() = 0U;
+            }),
+            /* pipeline= */ [&](){
+                auto &env = CodeGenContext::Get().env();
+
+                /*----- Hash probe key and append the hash to the window before buffering the tuple itself. -----*/
+                std::vector<SQL_t> key;
+                for (auto &probe_key : probe_keys)
+                    key.emplace_back(env.get(probe_key));
+                const Var<U32x1> num(U32x1(*num_hashes.clone()));
+                auto append_hashes = [&]<std::size_t L>(){
+                    if constexpr (L == 1) { // scalar
+                        const Var<U64x1> hash(ht->hash(std::move(key)));
+                        auto append = [&](){
+                            *(hashes.clone() + num.val().make_signed()) = hash.val();
+                            *num_hashes.clone() = num + 1U;
+                            window.consume();
+                        };
+                        /*----- Buffer only probe tuples whose key may have been inserted. -----*/
+                        std::optional<Boolx1> may_match;
+                        if (bloom_filter)
+                            may_match.emplace(bloom_filter->contains(hash));
+                        if (key_min) {
+                            auto in_range = in_key_range(env.get(probe_keys.front()));
+                            if (may_match)
+                                may_match.emplace(*may_match and in_range);
+                            else
+                                may_match.emplace(in_range);
+                        }
+                        if (may_match) {
+                            IF (*may_match) {
+                                append();
+                            };
+                        } else {
+                            append();
+                        }
+                    } else { // vectorial
+                        /* Neither the Bloom filter nor the key range is applied since dropping single lanes would
+                         * require to compact the SIMD vectors of the tuple; the hash table still drops probe tuples
+                         * without join partner. */
+                        M_insist(window_size % L == 0, "probe window must hold whole SIMD batches");
+                        /*----- Hash the keys of all lanes at once and scatter the lane-wise hashes to the window. */
+                        const Var<PrimitiveExpr<uint64_t, L>> simd_hashes(ht->hash<L>(std::move(key)));
+                        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                            ((*(hashes.clone() + (num + uint32_t(Is)).make_signed()) =
+                                  simd_hashes.template extract<Is>()), ...);
+                        }(std::make_index_sequence<L>{});
+                        *num_hashes.clone() = num + uint32_t(L);
+                        window.consume(); // stores all lanes at once and resumes the pipeline iff the window is full
+                    }
+                };
+                switch (CodeGenContext::Get().num_simd_lanes()) {
+                    default: M_unreachable("unsupported number of SIMD lanes");
+                    case  1: append_hashes.operator()<1>();  break;
+                    case  2: append_hashes.operator()<2>();  break;
+                    case  4: append_hashes.operator()<4>();  break;
+                    case  8: append_hashes.operator()<8>();  break;
+                    case 16: append_hashes.operator()<16>(); break;
+                    case 32: append_hashes.operator()<32>(); break;
+                }
+            },
+            /* teardown= */ teardown_t::Make_Without_Parent([&](){ window.teardown(); })
+        );
+        window.resume_pipeline(); // probe remaining tuples of the window
+
+        hashes.discard(); // since it was always cloned
+        buckets.discard(); // since it was always cloned
+        num_hashes.discard(); // since it was always cloned
+        touched_sink.discard(); // since it was always cloned
+    }
+}
+
+template<bool SortLeft, bool SortRight, bool Predicated, bool CmpPredicated>
+ConditionSet SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::pre_condition(
+    std::size_t child_idx,
+    const std::tuple<const JoinOperator*, const Wildcard*, const Wildcard*> &partial_inner_nodes)
+{
+    ConditionSet pre_cond;
+
+    /*----- Sort merge join can only be used for binary joins on conjunctions of equi-predicates. -----*/
+    auto &join = *std::get<0>(partial_inner_nodes);
+    if (not join.predicate().is_equi())
+        return ConditionSet::Make_Unsatisfiable();
 
-                        bool is_min = false; ///< flag to indicate whether aggregate function is MIN
-                        switch (info.fnid) {
-                            default:
-                                M_unreachable("unsupported aggregate function");
-                            case m::Function::FN_MIN:
-                                is_min = true; // set flag and delegate to MAX case
-                            case m::Function::FN_MAX: {
-                                auto min_max = [&]<typename T>() {
-                                    auto neutral = is_min ? std::numeric_limits<T>::max()
-                                                          : std::numeric_limits<T>::lowest();
+    /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
+    auto parent = std::get<1>(partial_inner_nodes);
+    auto child  = std::get<2>(partial_inner_nodes);
+    M_insist(parent);
+    M_insist(child_idx != 1 or child);
+    std::vector<Schema::Identifier> keys_parent, keys_child;
+    for (auto &clause : join.predicate()) {
+        M_insist(clause.size() == 1, "invalid equi-predicate");
+        auto &literal = clause[0];
+        auto &binary = as<const BinaryExpr>(literal.expr());
+        M_insist((not literal.negative() and binary.tok == TK_EQUAL) or
+                 (literal.negative() and binary.tok == TK_BANG_EQUAL), "invalid equi-predicate");
+        M_insist(is<const Designator>(binary.lhs), "invalid equi-predicate");
+        M_insist(is<const Designator>(binary.rhs), "invalid equi-predicate");
+        Schema::Identifier id_first(*binary.lhs), id_second(*binary.rhs);
+        auto dummy = Schema::entry_type::CreateArtificial(); ///< dummy entry used in case of `child_idx` != 1, i.e. `child` is not yet set
+        const auto &[entry_parent, entry_child] = parent->schema().has(id_first)
+            ? std::make_pair(parent->schema()[id_first].second, child_idx == 1 ? child->schema()[id_second].second : std::move(dummy))
+            : std::make_pair(parent->schema()[id_second].second, child_idx == 1 ? child->schema()[id_first].second : std::move(dummy));
+        keys_parent.push_back(entry_parent.id);
+        keys_child.push_back(entry_child.id);
 
-                                    Var<PrimitiveExpr<T, L>> min_max;
-                                    Global<PrimitiveExpr<T, L>> min_max_backup(
-                                        neutral // initialize with neutral element +inf or -inf
-                                    );
-                                    Var<Bool<L>> is_null;
-                                    Global<Bool<L>> is_null_backup(true); // MIN/MAX is initially NULL
+        /*----- Sort merge join can only be used on unique parent key. -----*/
+        if (not entry_parent.unique())
+            return ConditionSet::Make_Unsatisfiable();
+    }
+    M_insist(keys_parent.size() == keys_child.size(), "number of found IDs differ");
+    M_insist(not keys_parent.empty(), "must find at least one ID");
 
-                                    /*----- Set local aggregate variables to global backups. -----*/
-                                    min_max = min_max_backup;
-                                    is_null = is_null_backup;
+    if constexpr (not SortLeft or not SortRight) {
+        /*----- Sort merge join without sorting needs its data sorted on the respective key. -----*/
+        Sortedness::order_t orders;
+        M_insist(child_idx < 2);
+        if (not SortLeft and child_idx == 0) {
+            for (auto &key_parent : keys_parent) {
+                if (orders.find(key_parent) == orders.cend())
+                    orders.add(key_parent, Sortedness::O_ASC); // TODO: support different order
+            }
+        } else if (not SortRight and child_idx == 1) {
+            for (auto &key_child : keys_child) {
+                if (orders.find(key_child) == orders.cend())
+                    orders.add(key_child, Sortedness::O_ASC); // TODO: support different order
+            }
+        }
+        pre_cond.add_condition(Sortedness(std::move(orders)));
+    }
 
-                                    /*----- Add global aggregate to result env. to access it in other function. -----*/
-                                    if constexpr (L == 1) { // scalar
-                                        PrimitiveExpr<T> value = min_max_backup;
-                                        Boolx1 is_null = is_null_backup;
-                                        results.add(info.entry.id, Select(is_null, Expr<T>::Null(), value));
-                                    } else { // vectorial
-                                        /* Create lambda which emits the computation of the final *scalar* aggregate.
-                                         * This can then be called in the pipeline function starting at the aggregation
-                                         * operator s.t. the emitted variable is a local of the correct function.
-                                         * Do not access the global variables inside the lambda using closure by
-                                         * reference since they are already destroyed when the lambda will be called.
-                                         * Instead, copy their values into the lambda. However, since DSL expressions
-                                         * are not const-copy-constructible, we have to allocate them on the heap and
-                                         * destroy them manually inside the lambda. */
-                                        auto simd_min_max = new PrimitiveExpr<T, L>(min_max_backup.val());
-                                        auto simd_is_null = new Bool<L>(is_null_backup.val());
-                                        finalize_aggregates.emplace_back([&, is_min, simd_min_max, simd_is_null]() {
-                                            PrimitiveExpr<T> value = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
-                                                Var<PrimitiveExpr<T>> res(simd_min_max->clone().template extract<0>());
-                                                auto update = [&]<std::size_t I>(){
-                                                    if constexpr (requires (PrimitiveExpr<T> v) { min(v, v); max(v, v); }) {
-                                                        res = is_min ? min(res, simd_min_max->clone().template extract<I>())
-                                                                     : max(res, simd_min_max->clone().template extract<I>());
-                                                    } else {
-                                                        const Var<PrimitiveExpr<T>> extracted(
-                                                            simd_min_max->clone().template extract<I>()
-                                                        ); // due to multiple uses
-                                                        auto cmp = is_min ? extracted < res : extracted > res;
-#if 1
-                                                        res = Select(cmp, extracted, res);
-#else
-                                                        IF (cmp) {
-                                                            res = extracted;
-                                                        };
-#endif
-                                                    }
-                                                };
-                                                (update.template operator()<Is + 1>(), ...);
-                                                return res;
-                                            }(std::make_index_sequence<L - 1>{});
-                                            simd_min_max->discard(); // since it was always cloned
-                                            Boolx1 is_null = simd_is_null->all_true();
-                                            results.add(info.entry.id, Select(is_null, Expr<T>::Null(), value));
-                                            delete simd_min_max; // destroy heap-allocated variable
-                                            delete simd_is_null; // destroy heap-allocated variable
-                                        });
-                                    }
+    /*----- Sort merge join does not support SIMD. -----*/
+    pre_cond.add_condition(NoSIMD());
 
-                                    /*----- Move aggregate variables to access them later. ----*/
-                                    new (&agg_values[idx]) agg_t(std::make_pair(
-                                        std::move(min_max), std::move(is_null))
-                                    );
-                                    new (&agg_value_backups[idx]) agg_backup_t(std::make_pair(
-                                        std::move(min_max_backup), std::move(is_null_backup)
-                                    ));
-                                };
-                                auto &n = as<const Numeric>(*info.entry.type);
-                                switch (n.kind) {
-                                    case Numeric::N_Int:
-                                    case Numeric::N_Decimal:
-                                        switch (n.size()) {
-                                            default: M_unreachable("invalid size");
-                                            case  8: min_max.template operator()<int8_t >(); break;
-                                            case 16: min_max.template operator()<int16_t>(); break;
-                                            case 32: min_max.template operator()<int32_t>(); break;
-                                            case 64: min_max.template operator()<int64_t>(); break;
-                                        }
-                                        break;
-                                    case Numeric::N_Float:
-                                        if (n.size() <= 32)
-                                            min_max.template operator()<float>();
-                                        else
-                                            min_max.template operator()<double>();
-                                }
-                                break;
-                            }
-                            case m::Function::FN_AVG:
-                                break; // skip here and handle later
-                            case m::Function::FN_SUM: {
-                                auto sum = [&]<typename T>() {
-                                    Var<PrimitiveExpr<T, L>> sum;
-                                    Global<PrimitiveExpr<T, L>> sum_backup(T(0)); // initialize with neutral element 0
-                                    Var<Bool<L>> is_null;
-                                    Global<Bool<L>> is_null_backup(true); // SUM is initially NULL
+    return pre_cond;
+}
 
-                                    /*----- Set local aggregate variables to global backups. -----*/
-                                    sum = sum_backup;
-                                    is_null = is_null_backup;
+template<bool SortLeft, bool SortRight, bool Predicated, bool CmpPredicated>
+ConditionSet SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::adapt_post_conditions(
+    const Match<SortMergeJoin> &M,
+    std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children)
+{
+    M_insist(post_cond_children.size() == 2);
 
-                                    /*----- Add global aggregate to result env. to access it in other function. -----*/
-                                    if constexpr (L == 1) { // scalar
-                                        PrimitiveExpr<T> value = sum_backup;
-                                        Boolx1 is_null = is_null_backup;
-                                        results.add(info.entry.id, Select(is_null, Expr<T>::Null(), value));
-                                    } else { // vectorial
-                                        PrimitiveExpr<T> value = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
-                                            return (sum_backup.template extract<Is>() + ...);
-                                        }(std::make_index_sequence<L>{});
-                                        Boolx1 is_null = is_null_backup.all_true();
-                                        results.add(info.entry.id, Select(is_null, Expr<T>::Null(), value));
-                                    }
+    ConditionSet post_cond;
 
-                                    /*----- Move aggregate variables to access them later. ----*/
-                                    new (&agg_values[idx]) agg_t(std::make_pair(std::move(sum), std::move(is_null)));
-                                    new (&agg_value_backups[idx]) agg_backup_t(std::make_pair(
-                                        std::move(sum_backup), std::move(is_null_backup)
-                                    ));
-                                };
-                                auto &n = as<const Numeric>(*info.entry.type);
-                                switch (n.kind) {
-                                    case Numeric::N_Int:
-                                    case Numeric::N_Decimal:
-                                        switch (n.size()) {
-                                            default: M_unreachable("invalid size");
-                                            case  8: sum.template operator()<int8_t >(); break;
-                                            case 16: sum.template operator()<int16_t>(); break;
-                                            case 32: sum.template operator()<int32_t>(); break;
-                                            case 64: sum.template operator()<int64_t>(); break;
-                                        }
-                                        break;
-                                    case Numeric::N_Float:
-                                        if (n.size() <= 32)
-                                            sum.template operator()<float>();
-                                        else
-                                            sum.template operator()<double>();
-                                }
-                                break;
-                            }
-                            case m::Function::FN_COUNT: {
-                                Var<I64<L>> count;
-                                Global<I64<L>> count_backup(0); // initialize with neutral element 0
-                                /* no `is_null` variables needed since COUNT will not be NULL */
+    if constexpr (Predicated) {
+        /*----- Predicated sort merge join introduces predication. -----*/
+        post_cond.add_or_replace_condition(m::Predicated(true));
+    }
 
-                                /*----- Set local aggregate variable to global backup. -----*/
-                                count = count_backup;
+    /*----- Sort merge join does not introduce SIMD. -----*/
+    post_cond.add_condition(NoSIMD());
 
-                                /*----- Add global aggregate to result env. to access it in other function. -----*/
-                                if constexpr (L == 1) { // scalar
-                                    I64x1 value = count_backup;
-                                    results.add(info.entry.id, value);
-                                } else { // vectorial
-                                    I64x1 value = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
-                                        return (count_backup.template extract<Is>() + ...);
-                                    }(std::make_index_sequence<L>{});
-                                    results.add(info.entry.id, value);
-                                }
+    Sortedness::order_t orders;
+    if constexpr (not SortLeft) {
+        Sortedness sorting_left(post_cond_children[0].get().get_condition<Sortedness>());
+        orders.merge(sorting_left.orders()); // preserve sortedness of left child (including order)
+    }
+    if constexpr (not SortRight) {
+        Sortedness sorting_right(post_cond_children[1].get().get_condition<Sortedness>());
+        orders.merge(sorting_right.orders()); // preserve sortedness of right child (including order)
+    }
+    if constexpr (SortLeft or SortRight) {
+        /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
+        auto [keys_parent, keys_child] = decompose_equi_predicate(M.join.predicate(), M.parent.schema());
 
-                                /*----- Move aggregate variables to access them later. ----*/
-                                new (&agg_values[idx]) agg_t(std::move(count));
-                                new (&agg_value_backups[idx]) agg_backup_t(std::move(count_backup));
+        /*----- Sort merge join does sort the data on the respective key. -----*/
+        if constexpr (SortLeft) {
+            for (auto &key_parent : keys_parent) {
+                if (orders.find(key_parent) == orders.cend())
+                    orders.add(key_parent, Sortedness::O_ASC); // add sortedness for left child
+            }
+        }
+        if constexpr (SortRight) {
+            for (auto &key_child : keys_child) {
+                if (orders.find(key_child) == orders.cend())
+                    orders.add(key_child, Sortedness::O_ASC); // add sortedness for right child
+            }
+        }
+    }
+    post_cond.add_condition(Sortedness(std::move(orders)));
 
-                                break;
-                            }
-                        }
-                    }
+    return post_cond;
+}
 
-                    /*----- Initialize AVG aggregates after others to ensure that running count is initialized before. */
-                    for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
-                        auto &info = aggregates[idx];
+template<bool SortLeft, bool SortRight, bool Predicated, bool CmpPredicated>
+double SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::cost(const Match<SortMergeJoin> &M)
+{
+    const double card_left  = M.parent.info().estimated_cardinality;
+    const double card_right = M.child.info().estimated_cardinality;
 
-                        if (info.fnid == m::Function::FN_AVG) {
-                            Var<Double<L>> avg;
-                            Global<Double<L>> avg_backup(0.0); // initialize with neutral element 0
-                            Var<Bool<L>> is_null;
-                            Global<Bool<L>> is_null_backup(true); // AVG is initially NULL
+    auto &coefficients = OperatorCalibration::Get().coefficients();
+    double cost = coefficients.sort_merge_join_merge_per_row * (card_left + card_right); // cost for merge
+    if constexpr (SortLeft) { // cost for sort left
+        cost += (coefficients.sort_merge_join_sort_per_row +
+                 coefficients.sort_per_byte * tuple_size_in_bytes(M.parent.schema())) *
+            std::log2(card_left) * card_left;
+    }
+    if constexpr (SortRight) { // cost for sort right
+        cost += (coefficients.sort_merge_join_sort_per_row +
+                 coefficients.sort_per_byte * tuple_size_in_bytes(M.child.schema())) *
+            std::log2(card_right) * card_right;
+    }
 
-                            /*----- Set local aggregate variables to global backups. -----*/
-                            avg = avg_backup;
-                            is_null = is_null_backup;
+    return cost;
+}
 
-                            /*----- Add global aggregate to result env. to access it in other function. -----*/
-                            if constexpr (L == 1) { // scalar
-                                Doublex1 value = avg_backup;
-                                Boolx1 is_null = is_null_backup;
-                                results.add(info.entry.id, Select(is_null, _Doublex1::Null(), value));
-                            } else { // vectorial
-                                /* Create lambda which emits the computation of the final *scalar* aggregate.
-                                 * This can then be called in the pipeline function starting at the aggregation
-                                 * operator s.t. the emitted variable is a local of the correct function.
-                                 * Do not access the global variables inside the lambda using closure by
-                                 * reference since they are already destroyed when the lambda will be called.
-                                 * Instead, copy their values into the lambda. However, since DSL expressions
-                                 * are not const-copy-constructible, we have to allocate them on the heap and
-                                 * destroy them manually inside the lambda. */
-                                auto simd_avg = new Double<L>(avg_backup.val());
-                                auto simd_is_null = new Bool<L>(is_null_backup.val());
-                                auto simd_running_count = new I64<L>([&](){
-                                    auto it = avg_aggregates.find(info.entry.id);
-                                    M_insist(it != avg_aggregates.end());
-                                    const auto &avg_info = it->second;
-                                    M_insist(avg_info.compute_running_avg,
-                                             "AVG aggregate may only occur for running average computations");
+template<bool SortLeft, bool SortRight, bool Predicated, bool CmpPredicated>
+void SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::execute(
+    const Match<SortMergeJoin> &M,
+    setup_t setup,
+    pipeline_t pipeline,
+    teardown_t teardown)
+{
+    auto &env = CodeGenContext::Get().env();
+    const bool needs_buffer_parent = not is<const ScanOperator>(M.parent) or SortLeft;
+    const bool needs_buffer_child  = not is<const ScanOperator>(M.child) or SortRight;
 
-                                    auto running_count_idx = std::distance(
-                                        aggregates.cbegin(),
-                                        std::find_if(
-                                            aggregates.cbegin(), aggregates.cend(), [&avg_info](const auto &info){
-                                                return info.entry.id == avg_info.running_count;
-                                        })
-                                    );
-                                    M_insist(0 <= running_count_idx and running_count_idx < aggregates.size());
+    /*----- Create infinite buffers to materialize the current results (if necessary). -----*/
+    M_insist(bool(M.left_materializing_factory),
+             "`wasm::SortMergeJoin` must have a factory for the materialized left child");
+    M_insist(bool(M.right_materializing_factory),
+             "`wasm::SortMergeJoin` must have a factory for the materialized right child");
+    const auto schema_parent = M.parent.schema().drop_constants().deduplicate();
+    const auto schema_child  = M.child.schema().drop_constants().deduplicate();
+    std::optional<GlobalBuffer> buffer_parent, buffer_child;
+    if (needs_buffer_parent)
+        buffer_parent.emplace(schema_parent, *M.left_materializing_factory);
+    if (needs_buffer_child)
+        buffer_child.emplace(schema_child, *M.right_materializing_factory);
 
-                                    auto &running_count =
-                                        *M_notnull(std::get_if<Global<I64<L>>>(&agg_value_backups[running_count_idx]));
-                                    return running_count.val();
-                                }());
-                                finalize_aggregates.emplace_back([&, simd_avg, simd_is_null, simd_running_count]() {
-                                    Doublex1 value = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
-                                        I64x1 count = (simd_running_count->clone().template extract<Is>() + ...);
-                                        const Var<Double<L>> simd_sum([&](){
-                                            if constexpr (L != 2) {
-                                                return *simd_avg * simd_running_count->template to<double>();
-                                            } else {
-                                                M_unreachable("conversion from `I64<2>` to `Double<2>` not supported");
-                                                return Double<L>(0.0); // this line is never reached; return dummy value
-                                            }
-                                        }());
-                                        return (simd_sum.template extract<Is>() + ...) / count.to<double>();
-                                    }(std::make_index_sequence<L>{});
-                                    Boolx1 is_null = simd_is_null->all_true();
-                                    results.add(info.entry.id, Select(is_null, _Doublex1::Null(), value));
-                                    delete simd_avg; // destroy heap-allocated variable
-                                    delete simd_is_null; // destroy heap-allocated variable
-                                    delete simd_running_count; // destroy heap-allocated variable
-                                });
-                            }
+    /*----- Create child functions. -----*/
+    if (needs_buffer_parent) {
+        FUNCTION(sort_merge_join_parent_pipeline, void(void)) // create function for parent pipeline
+        {
+            auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+            M.children[0]->execute(
+                    /* setup=    */ setup_t::Make_Without_Parent([&](){ buffer_parent->setup(); }),
+                    /* pipeline= */ [&](){ buffer_parent->consume(); },
+                    /* teardown= */ teardown_t::Make_Without_Parent([&](){ buffer_parent->teardown(); })
+            );
+        }
+        sort_merge_join_parent_pipeline(); // call parent function
+    }
+    if (needs_buffer_child) {
+        FUNCTION(sort_merge_join_child_pipeline, void(void)) // create function for child pipeline
+        {
+            auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+            M.children[1]->execute(
+                /* setup=    */ setup_t::Make_Without_Parent([&](){ buffer_child->setup(); }),
+                /* pipeline= */ [&](){ buffer_child->consume(); },
+                /* teardown= */ teardown_t::Make_Without_Parent([&](){ buffer_child->teardown(); })
+            );
+        }
+        sort_merge_join_child_pipeline(); // call child function
+    }
 
-                            /*----- Move aggregate variables to access them later. ----*/
-                            new (&agg_values[idx]) agg_t(std::make_pair(std::move(avg), std::move(is_null)));
-                            new (&agg_value_backups[idx]) agg_backup_t(std::make_pair(
-                                std::move(avg_backup), std::move(is_null_backup)
-                            ));
-                        }
-                    }
-                };
-                switch (CodeGenContext::Get().num_simd_lanes()) {
-                    default: M_unreachable("unsupported number of SIMD lanes");
-                    case  1: execute_setup.operator()<1>();  break;
-                    case  2: execute_setup.operator()<2>();  break;
-                    case  4: execute_setup.operator()<4>();  break;
-                    case  8: execute_setup.operator()<8>();  break;
-                    case 16: execute_setup.operator()<16>(); break;
-                    case 32: execute_setup.operator()<32>(); break;
-                }
-            }),
-            /* pipeline= */ [&](){
-                auto execute_pipeline = [&]<std::size_t L>(){
-#ifndef NDEBUG
-                    M_insist(num_simd_lanes == L,
-                             "number of SIMD lanes in pipeline callback must match the one in setup callback");
-#endif
+    /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
+    std::vector<SortingOperator::order_type> order_parent, order_child;
+    for (auto &clause : M.join.predicate()) {
+        M_insist(clause.size() == 1, "invalid equi-predicate");
+        auto &literal = clause[0];
+        auto &binary = as<const BinaryExpr>(literal.expr());
+        M_insist((not literal.negative() and binary.tok == TK_EQUAL) or
+                 (literal.negative() and binary.tok == TK_BANG_EQUAL), "invalid equi-predicate");
+        M_insist(is<const Designator>(binary.lhs), "invalid equi-predicate");
+        M_insist(is<const Designator>(binary.rhs), "invalid equi-predicate");
+        auto [expr_parent, expr_child] = M.parent.schema().has(Schema::Identifier(*binary.lhs)) ?
+            std::make_pair(binary.lhs.get(), binary.rhs.get()) : std::make_pair(binary.rhs.get(), binary.lhs.get());
+        order_parent.emplace_back(*expr_parent, true); // ascending order
+        order_child.emplace_back(*expr_child, true); // ascending order
+    }
+    M_insist(order_parent.size() == order_child.size(), "number of found IDs differ");
+    M_insist(not order_parent.empty(), "must find at least one ID");
 
-                    /*----- Get aggregates helper structures. -----*/
-                    using agg_t = agg_t_<false, L>;
-                    using agg_backup_t = agg_t_<true, L>;
-                    auto agg_values = static_cast<agg_t*>(_agg_values);
-                    auto agg_value_backups = static_cast<agg_backup_t*>(_agg_value_backups);
+    /*----- If necessary, invoke sorting algorithm with buffer to sort. -----*/
+    if constexpr (SortLeft)
+        quicksort<CmpPredicated>(*buffer_parent, order_parent);
+    if constexpr (SortRight)
+        quicksort<CmpPredicated>(*buffer_child, order_child);
 
-                    auto &env = CodeGenContext::Get().env();
+    /*----- Create predicate to check if child co-group is smaller or equal than the one of the parent relation. -----*/
+    auto child_smaller_equal = [&]() -> Boolx1 {
+        std::optional<Boolx1> child_smaller_equal_;
+        for (std::size_t i = 0; i < order_child.size(); ++i) {
+            auto &des_parent = as<const Designator>(order_parent[i].first);
+            auto &des_child  = as<const Designator>(order_child[i].first);
+            Token leq = Token::CreateArtificial(TK_LESS_EQUAL);
+            auto cpy_parent = std::make_unique<Designator>(des_parent.tok, des_parent.table_name, des_parent.attr_name,
+                                                           des_parent.type(), des_parent.target());
+            auto cpy_child  = std::make_unique<Designator>(des_child.tok, des_child.table_name, des_child.attr_name,
+                                                           des_child.type(), des_child.target());
+            BinaryExpr expr(std::move(leq), std::move(cpy_child), std::move(cpy_parent));
 
-                    /*----- If predication is used, introduce pred. var. and update it before computing aggregates. --*/
-                    std::optional<Var<Bool<L>>> pred;
-                    if (env.predicated()) {
-                        if constexpr (sql_boolean_type<_Bool<L>>)
-                            pred = env.extract_predicate<_Bool<L>>().is_true_and_not_null();
-                        else
-                            M_unreachable("invalid number of SIMD lanes");
-                    }
+            auto child = env.get(Schema::Identifier(des_child));
+            Boolx1 cmp = env.compile<_Boolx1>(expr).is_true_and_not_null();
+            if (child_smaller_equal_)
+                child_smaller_equal_.emplace(*child_smaller_equal_ and (is_null(child) or cmp));
+            else
+                child_smaller_equal_.emplace(is_null(child) or cmp);
+        }
+        M_insist(bool(child_smaller_equal_));
+        return *child_smaller_equal_;
+    };
 
-                    /*----- Compute aggregates (except AVG). -----*/
-                    for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
-                        auto &info = aggregates[idx];
+    /*----- Compile data layouts to generate sequential loads from buffers. -----*/
+    static Schema empty_schema;
+    Var<U32x1> tuple_id_parent, tuple_id_child; // default initialized to 0
+    auto [inits_parent, loads_parent, _jumps_parent] = [&](){
+       if (needs_buffer_parent) {
+           return compile_load_sequential(buffer_parent->schema(), empty_schema, buffer_parent->base_address(),
+                                          buffer_parent->layout(), 1, buffer_parent->schema(), tuple_id_parent);
+       } else {
+           auto &scan = as<const ScanOperator>(M.parent);
+           return compile_load_sequential(schema_parent, empty_schema, get_base_address(scan.store().table().name()),
+                                          scan.store().table().layout(), 1, scan.store().table().schema(scan.alias()),
+                                          tuple_id_parent);
+       }
+    }();
+    auto [inits_child, loads_child, _jumps_child] = [&](){
+       if (needs_buffer_child) {
+           return compile_load_sequential(buffer_child->schema(), empty_schema, buffer_child->base_address(),
+                                          buffer_child->layout(), 1, buffer_child->schema(), tuple_id_child);
+       } else {
+           auto &scan = as<const ScanOperator>(M.child);
+           return compile_load_sequential(schema_child, empty_schema, get_base_address(scan.store().table().name()),
+                                          scan.store().table().layout(), 1, scan.store().table().schema(scan.alias()),
+                                          tuple_id_child);
+       }
+    }();
+    /* since structured bindings cannot be used in lambda capture */
+    Block jumps_parent(std::move(_jumps_parent)), jumps_child(std::move(_jumps_child));
 
-                        bool is_min = false; ///< flag to indicate whether aggregate function is MIN
-                        switch (info.fnid) {
-                            default:
-                                M_unreachable("unsupported aggregate function");
-                            case m::Function::FN_MIN:
-                                is_min = true; // set flag and delegate to MAX case
-                            case m::Function::FN_MAX: {
-                                M_insist(info.args.size() == 1,
-                                         "MIN and MAX aggregate functions expect exactly one argument");
-                                const auto &arg = *info.args[0];
-                                auto min_max = overloaded{
-                                    [&]<typename T>() requires sql_type<Expr<T, L>> {
-                                        auto &[min_max, is_null] = *M_notnull((
-                                            std::get_if<
-                                                std::pair<Var<PrimitiveExpr<T, L>>, Var<Bool<L>>>
-                                            >(&agg_values[idx])
-                                        ));
+    /*----- Process both buffers together. -----*/
+    setup();
+    const Var<U32x1> size_parent(
+        needs_buffer_parent ? buffer_parent->size()
+                            : get_num_rows(as<const ScanOperator>(M.parent).store().table().name())
+    );
+    const Var<U32x1> size_child(
+        needs_buffer_child ? buffer_child->size()
+                           : get_num_rows(as<const ScanOperator>(M.child).store().table().name())
+    );
+
+    /*----- Merge both children step by step.  If enabled, the merge stops after advancing the same child for
+     * `gallop_threshold` consecutive steps, s.t. this child may be skipped by exponential search, see below. -----*/
+    const uint32_t gallop_threshold =
+        order_parent.size() == 1 ? options::sort_merge_join_gallop_threshold : 0; // gallop only on a single key
+    auto merge = [&](std::optional<Var<U32x1>> &num_steps_parent, std::optional<Var<U32x1>> &num_steps_child) {
+        Boolx1 not_done = [&]() -> Boolx1 {
+            if (not gallop_threshold)
+                return tuple_id_parent < size_parent and tuple_id_child < size_child;
+            num_steps_parent.emplace(0U);
+            num_steps_child.emplace(0U);
+            return tuple_id_parent < size_parent and tuple_id_child < size_child and
+                   *num_steps_parent < gallop_threshold and *num_steps_child < gallop_threshold;
+        }();
+        WHILE (not_done) { // neither end reached
+            loads_parent.attach_to_current();
+            loads_child.attach_to_current();
+            if constexpr (Predicated) {
+                env.add_predicate(M.join.predicate());
+                pipeline();
+            } else {
+                M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes");
+                IF (env.compile<_Boolx1>(M.join.predicate()).is_true_and_not_null()) { // predicate fulfilled
+                    pipeline();
+                };
+            }
+            IF (child_smaller_equal()) {
+                jumps_child.attach_to_current();
+                if (gallop_threshold) {
+                    *num_steps_child += 1U;
+                    *num_steps_parent = 0U;
+                }
+            } ELSE {
+                jumps_parent.attach_to_current();
+                if (gallop_threshold) {
+                    *num_steps_parent += 1U;
+                    *num_steps_child = 0U;
+                }
+            };
+        }
+    };
 
-                                        auto _arg = env.compile(arg);
-                                        Expr<T, L> _new_val = convert<Expr<T, L>>(_arg);
-                                        if (_new_val.can_be_null()) {
-                                            M_insist_no_ternary_logic();
-                                            auto _new_val_pred =
-                                                pred ? Select(*pred, _new_val, Expr<T, L>::Null()) : _new_val;
-                                            auto [new_val_, new_val_is_null_] = _new_val_pred.split();
-                                            const Var<Bool<L>> new_val_is_null(new_val_is_null_); // due to multiple uses
+    if (not gallop_threshold) {
+        inits_parent.attach_to_current();
+        inits_child.attach_to_current();
+        std::optional<Var<U32x1>> num_steps_parent, num_steps_child;
+        merge(num_steps_parent, num_steps_child);
+        teardown();
+        return;
+    }
 
-                                            if constexpr (requires (PrimitiveExpr<T, L> v) { min(v, v); max(v, v); }) {
-                                                min_max = Select(new_val_is_null,
-                                                                 min_max, // ignore NULL
-                                                                 is_min ? min(min_max, new_val_) // update old min with new value
-                                                                        : max(min_max, new_val_)); // update old max with new value
-                                            } else {
-                                                const Var<PrimitiveExpr<T, L>> new_val(new_val_); // due to multiple uses
-                                                auto cmp = is_min ? new_val < min_max : new_val > min_max;
-#if 1
-                                                min_max = Select(new_val_is_null,
-                                                                 min_max, // ignore NULL
-                                                                 Select(cmp,
-                                                                        new_val, // update to new value
-                                                                        min_max)); // do not update
-#else
-                                                IF (not new_val_is_null and cmp) {
-                                                    min_max = new_val;
-                                                };
-#endif
-                                            }
-                                            is_null = is_null and new_val_is_null; // MIN/MAX is NULL iff all values are NULL
-                                        } else {
-                                            auto neutral = is_min ? std::numeric_limits<T>::max()
-                                                                  : std::numeric_limits<T>::lowest();
-                                            auto _new_val_pred =
-                                                pred ? Select(*pred, _new_val, PrimitiveExpr<T, L>(neutral)) : _new_val;
-                                            auto new_val_ = _new_val_pred.insist_not_null();
-                                            if constexpr (requires (PrimitiveExpr<T, L> v) { min(v, v); max(v, v); }) {
-                                                min_max = is_min ? min(min_max, new_val_) // update old min with new value
-                                                                 : max(min_max, new_val_); // update old max with new value
-                                            } else {
-                                                const Var<PrimitiveExpr<T, L>> new_val(new_val_); // due to multiple uses
-                                                auto cmp = is_min ? new_val < min_max : new_val > min_max;
-#if 1
-                                                min_max = Select(cmp,
-                                                                 new_val, // update to new value
-                                                                 min_max); // do not update
-#else
-                                                IF (cmp) {
-                                                    min_max = new_val;
-                                                };
-#endif
-                                            }
-                                            is_null.set_false(); // at least one non-NULL value is consumed
-                                        }
-                                    },
-                                    []<typename>() { M_unreachable("invalid type for given number of SIMD lanes"); }
-                                };
-                                auto &n = as<const Numeric>(*info.entry.type);
-                                switch (n.kind) {
-                                    case Numeric::N_Int:
-                                    case Numeric::N_Decimal:
-                                        switch (n.size()) {
-                                            default: M_unreachable("invalid size");
-                                            case  8: min_max.template operator()<int8_t >(); break;
-                                            case 16: min_max.template operator()<int16_t>(); break;
-                                            case 32: min_max.template operator()<int32_t>(); break;
-                                            case 64: min_max.template operator()<int64_t>(); break;
-                                        }
-                                        break;
-                                    case Numeric::N_Float:
-                                        if (n.size() <= 32)
-                                            min_max.template operator()<float>();
-                                        else
-                                            min_max.template operator()<double>();
-                                }
-                                break;
-                            }
-                            case m::Function::FN_AVG:
-                                break; // skip here and handle later
-                            case m::Function::FN_SUM: {
-                                M_insist(info.args.size() == 1, "SUM aggregate function expects exactly one argument");
-                                const auto &arg = *info.args[0];
+    /*----- Create function to load the key of the tuple with ID `tuple_id` of the parent iff `is_parent` is set, of
+     * the child otherwise, via point access into the current environment. -----*/
+    auto &des_parent = as<const Designator>(order_parent[0].first);
+    auto &des_child  = as<const Designator>(order_child[0].first);
+    auto load_key = [&](bool is_parent, U32x1 tuple_id) {
+        auto &des = is_parent ? des_parent : des_child;
+        auto &schema = is_parent ? schema_parent : schema_child;
+        const auto &e = schema[Schema::Identifier(des)].second;
+        Schema key_schema;
+        key_schema.add(e.id, e.type, e.constraints);
+        if (is_parent ? needs_buffer_parent : needs_buffer_child) {
+            auto &buffer = is_parent ? *buffer_parent : *buffer_child;
+            compile_load_point_access(key_schema, empty_schema, buffer.base_address(), buffer.layout(),
+                                      buffer.schema(), tuple_id);
+        } else {
+            auto &scan = as<const ScanOperator>(is_parent ? M.parent : M.child);
+            compile_load_point_access(key_schema, empty_schema, get_base_address(scan.store().table().name()),
+                                      scan.store().table().layout(), scan.store().table().schema(scan.alias()),
+                                      tuple_id);
+        }
+    };
 
-                                auto sum = overloaded{
-                                    [&]<typename T>() requires sql_type<Expr<T, L>> {
-                                        auto &[sum, is_null] = *M_notnull((
-                                            std::get_if<
-                                                std::pair<Var<PrimitiveExpr<T, L>>, Var<Bool<L>>>
-                                            >(&agg_values[idx])
-                                        ));
+    /*----- Create predicate to check if the key of the parent iff `is_parent` is set, of the child otherwise, is
+     * smaller than the one of the other child.  NULL is never smaller s.t. skipping stops at NULL since its position
+     * in the order is unknown. -----*/
+    auto key_smaller = [&](bool is_parent) -> Boolx1 {
+        auto copy = [](const Designator &des) {
+            return std::make_unique<Designator>(des.tok, des.table_name, des.attr_name, des.type(), des.target());
+        };
+        Token lt = Token::CreateArtificial(TK_LESS);
+        BinaryExpr expr(std::move(lt), copy(is_parent ? des_parent : des_child),
+                        copy(is_parent ? des_child : des_parent));
+        return CodeGenContext::Get().env().compile<_Boolx1>(expr).is_true_and_not_null();
+    };
 
-                                        auto _arg = env.compile(arg);
-                                        Expr<T, L> _new_val = convert<Expr<T, L>>(_arg);
-                                        if (_new_val.can_be_null()) {
-                                            M_insist_no_ternary_logic();
-                                            auto _new_val_pred =
-                                                pred ? Select(*pred, _new_val, Expr<T, L>::Null()) : _new_val;
-                                            auto [new_val, new_val_is_null_] = _new_val_pred.split();
-                                            const Var<Bool<L>> new_val_is_null(new_val_is_null_); // due to multiple uses
+    /*----- Create function to skip the tuples of the parent iff `is_parent` is set, of the child otherwise, whose key
+     * is smaller than the current key of the other child.  Doubles the distance of the probed tuple until it is not
+     * smaller any more and then searches binary between the last two probes, i.e. needs a logarithmic number of
+     * comparisons in the number of skipped tuples instead of a linear one. -----*/
+    auto gallop = [&](bool is_parent) {
+        auto &tuple_id = is_parent ? tuple_id_parent : tuple_id_child;
+        auto &size = is_parent ? size_parent : size_child;
+        auto smaller = [&](U32x1 id) -> Boolx1 {
+            auto S = CodeGenContext::Get().scoped_environment(); // to load the keys of the probed tuples
+            load_key(is_parent, id);
+            load_key(not is_parent, is_parent ? tuple_id_child.val() : tuple_id_parent.val());
+            return key_smaller(is_parent);
+        };
 
-                                            sum += Select(new_val_is_null,
-                                                          PrimitiveExpr<T, L>(T(0)), // ignore NULL
-                                                          new_val); // add new value to old sum
-                                            is_null = is_null and new_val_is_null; // SUM is NULL iff all values are NULL
-                                        } else {
-                                            auto _new_val_pred =
-                                                pred ? Select(*pred, _new_val, PrimitiveExpr<T, L>(T(0))) : _new_val;
-                                            sum += _new_val_pred.insist_not_null(); // add new value to old sum
-                                            is_null.set_false(); // at least one non-NULL value is consumed
-                                        }
-                                    },
-                                    []<typename>() { M_unreachable("invalid type for given number of SIMD lanes"); }
-                                };
-                                auto &n = as<const Numeric>(*info.entry.type);
-                                switch (n.kind) {
-                                    case Numeric::N_Int:
-                                    case Numeric::N_Decimal:
-                                        switch (n.size()) {
-                                            default: M_unreachable("invalid size");
-                                            case  8: sum.template operator()<int8_t >(); break;
-                                            case 16: sum.template operator()<int16_t>(); break;
-                                            case 32: sum.template operator()<int32_t>(); break;
-                                            case 64: sum.template operator()<int64_t>(); break;
-                                        }
-                                        break;
-                                    case Numeric::N_Float:
-                                        if (n.size() <= 32)
-                                            sum.template operator()<float>();
-                                        else
-                                            sum.template operator()<double>();
-                                }
-                                break;
-                            }
-                            case m::Function::FN_COUNT: {
-                                M_insist(info.args.size() <= 1, "COUNT aggregate function expects at most one argument");
-                                M_insist(info.entry.type->is_integral() and info.entry.type->size() == 64);
+        /*----- Invariant: the key of tuple `lo` is smaller, the one of tuple `hi` is not or `hi` is the end. -----*/
+        IF (smaller(tuple_id.val())) {
+            Var<U32x1> lo(tuple_id.val()), step(1U);
+            WHILE (lo + step < size) {
+                BREAK(not smaller(lo + step));
+                lo += step;
+                step <<= 1U;
+            }
+            Var<U32x1> hi(Select(lo + step < size, lo + step, size));
+            WHILE (lo + 1U < hi) {
+                Var<U32x1> mid((lo + hi) >> 1U); // (lo + hi) / 2
+                IF (smaller(mid)) {
+                    lo = mid;
+                } ELSE {
+                    hi = mid;
+                };
+            }
+            tuple_id = hi;
+        };
+    };
 
-                                auto &count = *M_notnull(std::get_if<Var<I64<L>>>(&agg_values[idx]));
+    /*----- Alternate between merging and skipping.  Sequential loads are re-initialized since skipping moves the
+     * tuple IDs. -----*/
+    WHILE (tuple_id_parent < size_parent and tuple_id_child < size_child) { // neither end reached
+        inits_parent.attach_to_current();
+        inits_child.attach_to_current();
+        std::optional<Var<U32x1>> num_steps_parent, num_steps_child;
+        merge(num_steps_parent, num_steps_child);
+        IF (tuple_id_parent < size_parent and tuple_id_child < size_child) {
+            IF (*num_steps_child == gallop_threshold) {
+                gallop(false);
+            } ELSE {
+                gallop(true);
+            };
+        };
+    }
+    teardown();
+}
 
-                                if (info.args.empty()) {
-                                    count += pred ? pred->template to<int64_t>() : I64<L>(1); // increment old count by 1 iff `pred` is true
-                                } else {
-                                    auto _new_val = env.compile(*info.args[0]);
-                                    if (can_be_null(_new_val)) {
-                                        M_insist_no_ternary_logic();
-                                        I64<L> inc = pred ? (not_null<L>(_new_val) and *pred).template to<int64_t>()
-                                                          : not_null<L>(_new_val).template to<int64_t>();
-                                        count += inc; // increment old count by 1 iff new value is present and `pred` is true
-                                    } else {
-                                        discard(_new_val); // since it is not needed in this case
-                                        I64<L> inc = pred ? pred->template to<int64_t>() : I64<L>(1);
-                                        count += inc; // increment old count by 1 iff new value is present and `pred` is true
-                                    }
-                                }
-                                break;
-                            }
-                        }
-                    }
+/** Creates a hash table, which is reused for each partition of a partitioned hash join matched by \p M, on the tuples
+ * of schema \p schema with key \p keys and initial capacity \p initial_capacity.  The implementation and the
+ * strategies of the hash table are chosen as configured by \p M. */
+template<typename Match>
+std::unique_ptr<HashTable> create_partition_hash_table(const Match &M, const Schema &schema,
+                                                       const std::vector<Schema::Identifier> &keys,
+                                                       uint32_t initial_capacity)
+{
+    /*----- Compute total sizes in bits of keys and payload (ignoring padding). -----*/
+    uint64_t keys_size_in_bits = 0;
+    uint64_t payload_size_in_bits = 0;
+    for (auto &e : schema)
+        (contains(keys, e.id) ? keys_size_in_bits : payload_size_in_bits) += e.type->size();
+    const auto [in_place, quadratic] = choose_open_addressing_strategies(
+        M.use_in_place_values, M.use_quadratic_probing, M.load_factor, keys_size_in_bits, payload_size_in_bits
+    );
 
-                    /*----- Compute AVG aggregates after others to ensure that running count is incremented before. --*/
-                    for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
-                        auto &info = aggregates[idx];
+    std::unique_ptr<HashTable> ht;
+    std::vector<HashTable::index_t> key_indices;
+    for (auto &key : keys)
+        key_indices.push_back(schema[key].first);
+    if (M.use_swiss_hashing and in_place) {
+        ht = std::make_unique<GlobalSwissHashTable>(schema, std::move(key_indices), initial_capacity);
+    } else if (M.use_open_addressing_hashing or M.use_swiss_hashing) { // Swiss tables store values only in-place
+        if (in_place)
+            ht = std::make_unique<GlobalOpenAddressingInPlaceHashTable>(schema, std::move(key_indices),
+                                                                        initial_capacity);
+        else
+            ht = std::make_unique<GlobalOpenAddressingOutOfPlaceHashTable>(schema, std::move(key_indices),
+                                                                           initial_capacity);
+        if (quadratic)
+            as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<QuadraticProbing>();
+        else
+            as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<LinearProbing>();
+    } else {
+        ht = std::make_unique<GlobalChainedHashTable>(schema, std::move(key_indices), initial_capacity);
+    }
+    return ht;
+}
 
-                        if (info.fnid == m::Function::FN_AVG) {
-                            M_insist(info.args.size() == 1, "AVG aggregate function expects exactly one argument");
-                            const auto &arg = *info.args[0];
-                            M_insist(info.entry.type->is_double());
+ConditionSet RadixPartitionedHashJoin::pre_condition(
+    std::size_t,
+    const std::tuple<const JoinOperator*, const Wildcard*, const Wildcard*> &partial_inner_nodes)
+{
+    ConditionSet pre_cond;
 
-                            auto it = avg_aggregates.find(info.entry.id);
-                            M_insist(it != avg_aggregates.end());
-                            const auto &avg_info = it->second;
-                            M_insist(avg_info.compute_running_avg,
-                                     "AVG aggregate may only occur for running average computations");
+    /*----- Radix partitioned hash join can only be used for binary joins on equi-predicates. -----*/
+    auto &join = *std::get<0>(partial_inner_nodes);
+    if (not join.predicate().is_equi())
+        return ConditionSet::Make_Unsatisfiable();
 
-                            auto &[avg, is_null] = *M_notnull((
-                                std::get_if<std::pair<Var<Double<L>>, Var<Bool<L>>>>(&agg_values[idx])
-                            ));
+    /*----- Radix partitioned hash join does not support SIMD. -----*/
+    pre_cond.add_condition(NoSIMD());
 
-                            /* Compute AVG as iterative mean as described in Knuth, The Art of Computer Programming
-                             * Vol 2, section 4.2.2. */
-                            auto running_count_idx = std::distance(
-                                aggregates.cbegin(),
-                                std::find_if(aggregates.cbegin(), aggregates.cend(), [&avg_info](const auto &info){
-                                    return info.entry.id == avg_info.running_count;
-                                })
-                            );
-                            M_insist(0 <= running_count_idx and running_count_idx < aggregates.size());
-                            Double<L> running_count = [&](){
-                                auto &running_count =
-                                    *M_notnull(std::get_if<Var<I64<L>>>(&agg_values[running_count_idx]));
-                                if constexpr (L != 2) {
-                                    return running_count.template to<double>();
-                                } else {
-                                    M_unreachable("conversion from `I64<2>` to `Double<2>` not supported");
-                                    return Double<L>(0.0); // this line is never reached; return dummy value
-                                }
-                            }();
+    return pre_cond;
+}
 
-                            auto _arg = env.compile(arg);
-                            _Double<L> _new_val = convert<_Double<L>>(_arg);
-                            if (_new_val.can_be_null()) {
-                                M_insist_no_ternary_logic();
-                                auto _new_val_pred = pred ? Select(*pred, _new_val, _Double<L>::Null()) : _new_val;
-                                auto [new_val, new_val_is_null_] = _new_val_pred.split();
-                                const Var<Bool<L>> new_val_is_null(new_val_is_null_); // due to multiple uses
+ConditionSet RadixPartitionedHashJoin::adapt_post_conditions(
+    const Match<RadixPartitionedHashJoin>&,
+    std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children)
+{
+    M_insist(post_cond_children.size() == 2);
+
+    /* Note that no sortedness of the probe child is preserved since its tuples are processed in partition order. */
+    ConditionSet post_cond;
+
+    /*----- Radix partitioned hash join does not introduce predication (it is already handled by the hash table). --*/
+    post_cond.add_condition(m::Predicated(false));
 
-                                auto delta_absolute = new_val - avg;
-                                auto delta_relative = delta_absolute / running_count;
+    /*----- Radix partitioned hash join does not introduce SIMD. -----*/
+    post_cond.add_condition(NoSIMD());
 
-                                avg += Select(new_val_is_null,
-                                              Double<L>(0.0), // ignore NULL
-                                              delta_relative); // update old average with new value
-                                is_null = is_null and new_val_is_null; // AVG is NULL iff all values are NULL
-                            } else {
-                                auto _new_val_pred = pred ? Select(*pred, _new_val, avg) : _new_val;
-                                auto delta_absolute = _new_val_pred.insist_not_null() - avg;
-                                auto delta_relative = delta_absolute / running_count;
+    return post_cond;
+}
 
-                                avg += delta_relative; // update old average with new value
-                                is_null.set_false(); // at least one non-NULL value is consumed
-                            }
-                        }
-                    }
-                };
-                switch (CodeGenContext::Get().num_simd_lanes()) {
-                    default: M_unreachable("unsupported number of SIMD lanes");
-                    case  1: execute_pipeline.operator()<1>();  break;
-                    case  2: execute_pipeline.operator()<2>();  break;
-                    case  4: execute_pipeline.operator()<4>();  break;
-                    case  8: execute_pipeline.operator()<8>();  break;
-                    case 16: execute_pipeline.operator()<16>(); break;
-                    case 32: execute_pipeline.operator()<32>(); break;
-                }
-            },
-            /* teardown= */ teardown_t::Make_Without_Parent([&](){
-                auto execute_teardown = [&]<std::size_t L>(){
-#ifndef NDEBUG
-                    M_insist(num_simd_lanes == L,
-                             "number of SIMD lanes in teardown callback must match the one in setup callback");
-#endif
+double RadixPartitionedHashJoin::cost(const Match<RadixPartitionedHashJoin> &M)
+{
+    const double card_build = M.build.info().estimated_cardinality;
+    const double card_probe = M.probe.info().estimated_cardinality;
 
-                    /*----- Get aggregates helper structures. -----*/
-                    using agg_t = agg_t_<false, L>;
-                    using agg_backup_t = agg_t_<true, L>;
-                    auto agg_values = static_cast<agg_t*>(_agg_values);
-                    auto agg_value_backups = static_cast<agg_backup_t*>(_agg_value_backups);
+    double cost = 0.3 * (card_build + card_probe); // cost for materializing and partitioning both children
+    if (compute_num_radix_bits(M.build, M.partition_size) == 0)
+        cost += simple_hash_join_cost(M.build, M.probe, false); // single partition, i.e. as for simple hash join
+    else
+        cost += 0.6 * card_build + 0.4 * card_probe; // cache-resident partitions, i.e. mostly cache hits
 
-                    /*----- Store local aggregate values to globals to access them in other function. -----*/
-                    for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
-                        auto &info = aggregates[idx];
+    return cost;
+}
 
-                        bool is_min = false; ///< flag to indicate whether aggregate function is MIN
-                        switch (info.fnid) {
-                            default:
-                                M_unreachable("unsupported aggregate function");
-                            case m::Function::FN_MIN:
-                                is_min = true; // set flag and delegate to MAX case
-                            case m::Function::FN_MAX: {
-                                auto min_max = [&]<typename T>() {
-                                    auto &[min_max_backup, is_null_backup] = *M_notnull((
-                                        std::get_if<
-                                            std::pair<Global<PrimitiveExpr<T, L>>, Global<Bool<L>>>
-                                        >(&agg_value_backups[idx])
-                                    ));
-                                    std::tie(min_max_backup, is_null_backup) = *M_notnull((
-                                        std::get_if<std::pair<Var<PrimitiveExpr<T, L>>, Var<Bool<L>>>>(&agg_values[idx])
-                                    ));
-                                };
-                                auto &n = as<const Numeric>(*info.entry.type);
-                                switch (n.kind) {
-                                    case Numeric::N_Int:
-                                    case Numeric::N_Decimal:
-                                        switch (n.size()) {
-                                            default: M_unreachable("invalid size");
-                                            case  8: min_max.template operator()<int8_t >(); break;
-                                            case 16: min_max.template operator()<int16_t>(); break;
-                                            case 32: min_max.template operator()<int32_t>(); break;
-                                            case 64: min_max.template operator()<int64_t>(); break;
-                                        }
-                                        break;
-                                    case Numeric::N_Float:
-                                        if (n.size() <= 32)
-                                            min_max.template operator()<float>();
-                                        else
-                                            min_max.template operator()<double>();
-                                }
-                                break;
-                            }
-                            case m::Function::FN_AVG: {
-                                auto &[avg_backup, is_null_backup] = *M_notnull((
-                                    std::get_if<std::pair<Global<Double<L>>, Global<Bool<L>>>>(&agg_value_backups[idx])
-                                ));
-                                std::tie(avg_backup, is_null_backup) = *M_notnull((
-                                    std::get_if<std::pair<Var<Double<L>>, Var<Bool<L>>>>(&agg_values[idx])
-                                ));
+void RadixPartitionedHashJoin::execute(const Match<RadixPartitionedHashJoin> &M, setup_t setup,
+                                       pipeline_t pipeline, teardown_t teardown)
+{
+    M_insist(((M.join.schema() | M.join.predicate().get_required()) & M.build.schema()) == M.build.schema());
+    M_insist(M.build.schema().drop_constants() == M.build.schema());
+    const auto ht_schema = M.build.schema().deduplicate();
+    const auto probe_schema = M.probe.schema().drop_constants().deduplicate();
 
-                                break;
-                            }
-                            case m::Function::FN_SUM: {
-                                M_insist(info.args.size() == 1, "SUM aggregate function expects exactly one argument");
-                                const auto &arg = *info.args[0];
+    /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
+    const auto [build_keys, probe_keys] = decompose_equi_predicate(M.join.predicate(), ht_schema);
 
-                                auto sum = [&]<typename T>() {
-                                    auto &[sum_backup, is_null_backup] = *M_notnull((
-                                        std::get_if<
-                                            std::pair<Global<PrimitiveExpr<T, L>>, Global<Bool<L>>>
-                                        >(&agg_value_backups[idx])
-                                    ));
-                                    std::tie(sum_backup, is_null_backup) = *M_notnull((
-                                        std::get_if<std::pair<Var<PrimitiveExpr<T, L>>, Var<Bool<L>>>>(&agg_values[idx])
-                                    ));
-                                };
-                                auto &n = as<const Numeric>(*info.entry.type);
-                                switch (n.kind) {
-                                    case Numeric::N_Int:
-                                    case Numeric::N_Decimal:
-                                        switch (n.size()) {
-                                            default: M_unreachable("invalid size");
-                                            case  8: sum.template operator()<int8_t >(); break;
-                                            case 16: sum.template operator()<int16_t>(); break;
-                                            case 32: sum.template operator()<int32_t>(); break;
-                                            case 64: sum.template operator()<int64_t>(); break;
-                                        }
-                                        break;
-                                    case Numeric::N_Float:
-                                        if (n.size() <= 32)
-                                            sum.template operator()<float>();
-                                        else
-                                            sum.template operator()<double>();
-                                }
-                                break;
-                            }
-                            case m::Function::FN_COUNT: {
-                                auto &count_backup = *M_notnull(std::get_if<Global<I64<L>>>(&agg_value_backups[idx]));
-                                count_backup = *M_notnull(std::get_if<Var<I64<L>>>(&agg_values[idx]));
+    /*----- Compute number of partitions s.t. each partition of the build child is expected to fit into the cache. --*/
+    const uint32_t num_radix_bits = compute_num_radix_bits(M.build, M.partition_size);
+    const uint32_t num_partitions = 1U << num_radix_bits;
 
-                                break;
-                            }
-                        }
-                    }
+    /*----- Create function to create a hash table on the tuples of schema `schema` with key `keys` of child `child`
+     * which is reused for each partition of the child. -----*/
+    auto create_hash_table = [&](const Schema &schema, const std::vector<Schema::Identifier> &keys,
+                                 const Operator &child) -> std::unique_ptr<HashTable>
+    {
+        /*----- Compute initial capacity of hash table s.t. it fits a single partition. -----*/
+        uint32_t initial_capacity =
+            std::max(compute_initial_ht_capacity(child, M.load_factor) >> num_radix_bits, 16U);
+        return create_partition_hash_table(M, schema, keys, initial_capacity);
+    };
 
-                    /*----- Destroy created aggregates and their backups. -----*/
-                    for (std::size_t idx = 0; idx < aggregates.size(); ++idx) {
-                        agg_values[idx].~agg_t();
-                        agg_value_backups[idx].~agg_backup_t();
-                    }
+    /*----- Create hash table on the build child and, if roles may be reversed, on the probe child. -----*/
+    auto ht = create_hash_table(ht_schema, build_keys, M.build);
+    std::unique_ptr<HashTable> reversed_ht;
+    if (M.role_reversal_factor > 0)
+        reversed_ht = create_hash_table(probe_schema, probe_keys, M.probe);
+
+    /*----- Create infinite buffers to materialize both children. -----*/
+    M_insist(bool(M.build_materializing_factory),
+             "`wasm::RadixPartitionedHashJoin` must have a factory for the materialized build child");
+    M_insist(bool(M.probe_materializing_factory),
+             "`wasm::RadixPartitionedHashJoin` must have a factory for the materialized probe child");
+    GlobalBuffer build_buffer(ht_schema, *M.build_materializing_factory);
+    GlobalBuffer probe_buffer(probe_schema, *M.probe_materializing_factory);
+
+    /*----- Create predicate to check whether all entries of the key `keys` of the current tuple are not NULL. -----*/
+    auto key_not_null = [](const std::vector<Schema::Identifier> &keys) -> Boolx1 {
+        auto &env = CodeGenContext::Get().env();
+        std::optional<Boolx1> key_not_null_;
+        for (auto &key : keys) {
+            auto val = env.get(key);
+            if (key_not_null_)
+                key_not_null_.emplace(*key_not_null_ and not_null(val));
+            else
+                key_not_null_.emplace(not_null(val));
+        }
+        M_insist(bool(key_not_null_));
+        return std::move(*key_not_null_);
+    };
 
-                    /*----- Free aggregates helper structures. -----*/
-                    delete[] agg_values;
-                    delete[] agg_value_backups;
+    /*----- Create child functions to materialize all tuples with non-NULL keys since only those may find join
+     * partners. -----*/
+    FUNCTION(radix_partitioned_hash_join_build_pipeline, void(void)) // create function for build pipeline
+    {
+        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+        M.children[0]->execute(
+            /* setup=    */ setup_t::Make_Without_Parent([&](){ build_buffer.setup(); }),
+            /* pipeline= */ [&](){
+                IF (key_not_null(build_keys)) {
+                    build_buffer.consume();
                 };
-                switch (CodeGenContext::Get().num_simd_lanes()) {
-                    default: M_unreachable("unsupported number of SIMD lanes");
-                    case  1: execute_teardown.operator()<1>();  break;
-                    case  2: execute_teardown.operator()<2>();  break;
-                    case  4: execute_teardown.operator()<4>();  break;
-                    case  8: execute_teardown.operator()<8>();  break;
-                    case 16: execute_teardown.operator()<16>(); break;
-                    case 32: execute_teardown.operator()<32>(); break;
-                }
-            })
+            },
+            /* teardown= */ teardown_t::Make_Without_Parent([&](){ build_buffer.teardown(); })
         );
     }
-    aggregation_child_pipeline(); // call child function
-
-    /*----- Emit setup code *before* possibly introducing temporary boolean variables to not overwrite them. -----*/
-    setup();
-
-    /*----- Emit code to finalize aggregate computations. -----*/
-    for (auto &fn : finalize_aggregates)
-        fn();
-
-    /*----- Add computed aggregates tuple to current environment. ----*/
-    auto &env = CodeGenContext::Get().env();
-    for (auto &e : M.aggregation.schema().deduplicate()) {
-        if (auto it = avg_aggregates.find(e.id);
-            it != avg_aggregates.end() and not it->second.compute_running_avg)
-        { // AVG aggregates which is not yet computed, divide computed sum with computed count
-            auto &avg_info = it->second;
-            auto sum = results.get(avg_info.sum);
-            auto count = results.get<_I64x1>(avg_info.running_count).insist_not_null().to<double>();
-            auto avg = convert<_Doublex1>(sum) / count;
-            M_insist(avg.can_be_null());
-            _Var<Doublex1> var(avg); // introduce variable s.t. uses only load from it
-            env.add(e.id, var);
-        } else { // already computed aggregate
-            std::visit(overloaded {
-                [&]<typename T>(Expr<T> value) -> void {
-                    if (value.can_be_null()) {
-                        Var<Expr<T>> var(value); // introduce variable s.t. uses only load from it
-                        env.add(e.id, var);
-                    } else {
-                        /* introduce variable w/o NULL bit s.t. uses only load from it */
-                        Var<PrimitiveExpr<T>> var(value.insist_not_null());
-                        env.add(e.id, Expr<T>(var));
-                    }
-                },
-                [](auto) -> void { M_unreachable("only scalar and non-string values must occur"); },
-                [](std::monostate) -> void { M_unreachable("invalid reference"); },
-            }, results.get(e.id)); // do not extract to be able to access for not-yet-computed AVG aggregates
-        }
+    radix_partitioned_hash_join_build_pipeline(); // call build function
+    FUNCTION(radix_partitioned_hash_join_probe_pipeline, void(void)) // create function for probe pipeline
+    {
+        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+        M.children[1]->execute(
+            /* setup=    */ setup_t::Make_Without_Parent([&](){ probe_buffer.setup(); }),
+            /* pipeline= */ [&](){
+                IF (key_not_null(probe_keys)) {
+                    probe_buffer.consume();
+                };
+            },
+            /* teardown= */ teardown_t::Make_Without_Parent([&](){ probe_buffer.teardown(); })
+        );
     }
+    radix_partitioned_hash_join_probe_pipeline(); // call probe function
+
+    /*----- Allocate partition offsets for both buffers, i.e. partition `p` consists of the tuple IDs in
+     * [offsets[p], offsets[p + 1]), and the partition cursors used while partitioning. -----*/
+    Var<Ptr<U32x1>> build_offsets(Module::Allocator().pre_malloc<uint32_t>(num_partitions + 1));
+    Var<Ptr<U32x1>> probe_offsets(Module::Allocator().pre_malloc<uint32_t>(num_partitions + 1));
+    Var<Ptr<U32x1>> cursors(Module::Allocator().pre_malloc<uint32_t>(num_partitions));
+    auto at = [](Var<Ptr<U32x1>> &ptr, U32x1 idx) { return *(ptr.val() + idx.make_signed()); };
+
+    /*----- Create function to partition a buffer by its keys `keys` and to compute its partition offsets. -----*/
+    auto partition = [&](GlobalBuffer &buffer, const std::vector<Schema::Identifier> &keys,
+                         Var<Ptr<U32x1>> &offsets)
+    {
+        Schema key_schema;
+        for (auto &key : keys) {
+            if (not key_schema.has(key))
+                key_schema.add(buffer.schema()[key].second);
+        }
+        partition_buffer(buffer, key_schema,
+                         [&](){ return compute_radix_partition(buffer.schema(), keys, num_radix_bits); },
+                         num_radix_bits, offsets, cursors);
+    };
 
-    /*----- Resume pipeline. -----*/
-    CodeGenContext::Get().set_num_simd_lanes(1); // since only a single tuple is produced
-    pipeline();
-
-    /*----- Emit teardown code. -----*/
-    teardown();
-}
+    /*----- Partition both buffers. -----*/
+    partition(build_buffer, build_keys, build_offsets);
+    partition(probe_buffer, probe_keys, probe_offsets);
+
+    /*----- Create function to process partitions one after another by building the hash table `table` on the partition
+     * of the buffer `build` and probing it with the respective partition of the buffer `probe`. -----*/
+    auto join_partitions = [&](HashTable &table,
+                               GlobalBuffer &build, const std::vector<Schema::Identifier> &keys_build,
+                               Var<Ptr<U32x1>> &offsets_build,
+                               GlobalBuffer &probe, const std::vector<Schema::Identifier> &keys_probe,
+                               Var<Ptr<U32x1>> &offsets_probe)
+    {
+        table.setup();
+        table.set_high_watermark(M.load_factor);
+        auto load_build = build.create_load_proxy();
+        auto load_probe = probe.create_load_proxy();
+
+        /*----- Compute payload IDs. -----*/
+        std::vector<Schema::Identifier> payload_ids;
+        for (auto &e : build.schema()) {
+            if (not contains(keys_build, e.id))
+                payload_ids.push_back(e.id);
+        }
 
+        auto emit_tuple_and_resume_pipeline = [&](HashTable::const_entry_t entry){
+            auto &env = CodeGenContext::Get().env();
 
-/*======================================================================================================================
- * Sorting
- *====================================================================================================================*/
+            /*----- Add found entry from hash table, i.e. from build partition, to current environment. -----*/
+            for (auto &e : build.schema()) {
+                std::visit(overloaded {
+                    [&]<typename T>(HashTable::const_reference_t<Expr<T>> &&r) -> void {
+                        Expr<T> value = r;
+                        if (value.can_be_null()) {
+                            Var<Expr<T>> var(value); // introduce variable s.t. uses only load from it
+                            env.add(e.id, var);
+                        } else {
+                            /* introduce variable w/o NULL bit s.t. uses only load from it */
+                            Var<PrimitiveExpr<T>> var(value.insist_not_null());
+                            env.add(e.id, Expr<T>(var));
+                        }
+                    },
+                    [&](HashTable::const_reference_t<NChar> &&r) -> void {
+                        NChar value(r);
+                        Var<Ptr<Charx1>> var(value.val()); // introduce variable s.t. uses only load from it
+                        env.add(e.id, NChar(var, value.can_be_null(), value.length(),
+                                            value.guarantees_terminating_nul()));
+                    },
+                    [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                }, entry.extract(e.id));
+            }
 
-template<bool CmpPredicated>
-ConditionSet Quicksort<CmpPredicated>::pre_condition(std::size_t child_idx, const std::tuple<const SortingOperator*>&)
-{
-     M_insist(child_idx == 0);
+            /*----- Resume pipeline. -----*/
+            pipeline();
+        };
 
-    ConditionSet pre_cond;
+        Var<U32x1> p(0U);
+        WHILE (p < num_partitions) {
+            table.clear();
 
-    /*----- Sorting does not support SIMD. -----*/
-    pre_cond.add_condition(NoSIMD());
+            /*----- Build hash table on the current build partition. -----*/
+            Var<U32x1> build_id(U32x1(at(offsets_build, p)));
+            const Var<U32x1> build_end(U32x1(at(offsets_build, p + 1U)));
+            WHILE (build_id < build_end) {
+                auto S = CodeGenContext::Get().scoped_environment();
+                auto &env = CodeGenContext::Get().env();
+                load_build(build_id);
 
-    return pre_cond;
-}
+                /*----- Insert key. -----*/
+                std::vector<SQL_t> key;
+                for (auto &build_key : keys_build)
+                    key.emplace_back(env.get(build_key));
+                auto entry = table.emplace(std::move(key));
 
-template<bool CmpPredicated>
-ConditionSet Quicksort<CmpPredicated>::post_condition(const Match<Quicksort> &M)
-{
-    ConditionSet post_cond;
+                /*----- Insert payload. -----*/
+                for (auto &id : payload_ids) {
+                    std::visit(overloaded {
+                        [&]<sql_type T>(HashTable::reference_t<T> &&r) -> void { r = env.extract<T>(id); },
+                        [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                    }, entry.extract(id));
+                }
 
-    /*----- Quicksort does not introduce predication. -----*/
-    post_cond.add_condition(Predicated(false));
+                build_id += 1U;
+            }
 
-    /*----- Quicksort does sort the data. -----*/
-    Sortedness::order_t orders;
-    for (auto &o : M.sorting.order_by()) {
-        Schema::Identifier id(o.first);
-        if (orders.find(id) == orders.cend())
-            orders.add(std::move(id), o.second ? Sortedness::O_ASC : Sortedness::O_DESC);
-    }
-    post_cond.add_condition(Sortedness(std::move(orders)));
+            /*----- Probe hash table with the respective probe partition. -----*/
+            Var<U32x1> probe_id(U32x1(at(offsets_probe, p)));
+            const Var<U32x1> probe_end(U32x1(at(offsets_probe, p + 1U)));
+            WHILE (probe_id < probe_end) {
+                auto S = CodeGenContext::Get().scoped_environment();
+                auto &env = CodeGenContext::Get().env();
+                load_probe(probe_id);
 
-    /*----- Sorting does not introduce SIMD. -----*/
-    post_cond.add_condition(NoSIMD());
+                /*----- Search for *all* join partners. -----*/
+                std::vector<SQL_t> key;
+                for (auto &probe_key : keys_probe)
+                    key.emplace_back(env.get(probe_key));
+                table.for_each_in_equal_range(std::move(key), emit_tuple_and_resume_pipeline, /* predicated= */ false);
 
-    return post_cond;
-}
+                probe_id += 1U;
+            }
 
-template<bool CmpPredicated>
-void Quicksort<CmpPredicated>::execute(const Match<Quicksort> &M, setup_t setup, pipeline_t pipeline,
-                                       teardown_t teardown)
-{
-    /*----- Create infinite buffer to materialize the current results but resume the pipeline later. -----*/
-    M_insist(bool(M.materializing_factory), "`wasm::Quicksort` must have a factory for the materialized child");
-    const auto buffer_schema = M.child->get_matched_root().schema().drop_constants().deduplicate();
-    const auto sorting_schema = M.sorting.schema().drop_constants().deduplicate();
-    GlobalBuffer buffer(
-        buffer_schema, *M.materializing_factory, false, 0, std::move(setup), std::move(pipeline), std::move(teardown)
-    );
+            p += 1U;
+        }
 
-    /*----- Create child function. -----*/
-    FUNCTION(sorting_child_pipeline, void(void)) // create function for pipeline
-    {
-        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+        table.teardown();
+    };
 
-        M.child->execute(
-            /* setup=    */ setup_t::Make_Without_Parent([&](){ buffer.setup(); }),
-            /* pipeline= */ [&](){ buffer.consume(); },
-            /* teardown= */ teardown_t::Make_Without_Parent([&](){ buffer.teardown(); })
-        );
+    setup();
+    build_buffer.setup_base_address();
+    probe_buffer.setup_base_address();
+    if (reversed_ht) {
+        /*----- Reverse the roles of both children iff the build child turns out to be larger than the probe child by
+         * more than the role reversal factor, e.g. due to a misestimated cardinality.  Since both children are
+         * materialized anyways, their actual sizes are known before any hash table is built. -----*/
+        IF (build_buffer.size().to<double>() > probe_buffer.size().to<double>() * M.role_reversal_factor) {
+            join_partitions(*reversed_ht, probe_buffer, probe_keys, probe_offsets,
+                            build_buffer, build_keys, build_offsets);
+        } ELSE {
+            join_partitions(*ht, build_buffer, build_keys, build_offsets, probe_buffer, probe_keys, probe_offsets);
+        };
+    } else {
+        join_partitions(*ht, build_buffer, build_keys, build_offsets, probe_buffer, probe_keys, probe_offsets);
     }
-    sorting_child_pipeline(); // call child function
+    build_buffer.teardown_base_address();
+    probe_buffer.teardown_base_address();
+    teardown();
+}
 
-    /*----- Invoke quicksort algorithm with buffer to sort. -----*/
-    quicksort<CmpPredicated>(buffer, M.sorting.order_by());
 
-    /*----- Process sorted buffer. -----*/
-    buffer.resume_pipeline(sorting_schema);
+/** Returns the scan of \p op if \p op is a `ScanOperator` or a `FilterOperator` on a `ScanOperator`, and `nullptr`
+ * otherwise. */
+const ScanOperator * get_partition_wise_scan(const Operator &op)
+{
+    if (auto scan = cast<const ScanOperator>(&op))
+        return scan;
+    if (auto filter = cast<const FilterOperator>(&op))
+        return cast<const ScanOperator>(filter->child(0));
+    return nullptr;
 }
 
-ConditionSet NoOpSorting::pre_condition(std::size_t child_idx,
-                                        const std::tuple<const SortingOperator*> &partial_inner_nodes)
+/** Returns the partitions of the tables scanned by \p build and \p probe if both are (filtered) scans of tables
+ * partitioned by the same scheme and some clause of the equi-predicate of \p join equates their partitioning
+ * attributes, and `std::nullopt` otherwise. */
+std::optional<std::pair<Partitionings::Partitioning, Partitionings::Partitioning>>
+find_co_partitioning(const JoinOperator &join, const Operator &build, const Operator &probe)
 {
-    M_insist(child_idx == 0);
-
-    ConditionSet pre_cond;
+    auto build_scan = get_partition_wise_scan(build);
+    auto probe_scan = get_partition_wise_scan(probe);
+    if (not build_scan or not probe_scan)
+        return std::nullopt;
+    auto build_partitioning = get_partitioning(*build_scan);
+    auto probe_partitioning = get_partitioning(*probe_scan);
+    if (not build_partitioning or not probe_partitioning or
+        not build_partitioning->scheme.co_partitioned(probe_partitioning->scheme))
+        return std::nullopt;
+
+    /*----- Create function to check whether `expr` designates the partitioning attribute of the table scanned by
+     * `scan` in the schema of `child`. -----*/
+    auto is_partitioning_attr = [](const ast::Expr &expr, const Operator &child, const ScanOperator &scan,
+                                   const Partitionings::Partitioning &partitioning)
+    {
+        auto D = cast<const Designator>(&expr);
+        if (not D or not child.schema().has(Schema::Identifier(*D)))
+            return false;
+        auto attr = std::get_if<const Attribute*>(&D->target());
+        return attr and &(*attr)->table == &scan.store().table() and (*attr)->name == partitioning.scheme.attr;
+    };
 
-    /*----- NoOpSorting, i.e. a noop to match sorting, needs the data already sorted. -----*/
-    Sortedness::order_t orders;
-    for (auto &o : std::get<0>(partial_inner_nodes)->order_by()) {
-        Schema::Identifier id(o.first);
-        if (orders.find(id) == orders.cend())
-            orders.add(std::move(id), o.second ? Sortedness::O_ASC : Sortedness::O_DESC);
+    for (auto &clause : join.predicate()) {
+        M_insist(clause.size() == 1, "invalid equi-predicate");
+        auto &binary = as<const BinaryExpr>(clause[0].expr());
+        if ((is_partitioning_attr(*binary.lhs, build, *build_scan, *build_partitioning) and
+             is_partitioning_attr(*binary.rhs, probe, *probe_scan, *probe_partitioning)) or
+            (is_partitioning_attr(*binary.lhs, probe, *probe_scan, *probe_partitioning) and
+             is_partitioning_attr(*binary.rhs, build, *build_scan, *build_partitioning)))
+            return std::make_pair(std::move(*build_partitioning), std::move(*probe_partitioning));
     }
-    pre_cond.add_condition(Sortedness(std::move(orders)));
-
-    return pre_cond;
+    return std::nullopt;
 }
 
-void NoOpSorting::execute(const Match<NoOpSorting> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
+/** Computes the row IDs `[build_begin, build_end, probe_begin, probe_end]` of each pair of corresponding partitions of
+ * the co-partitioned children \p build and \p probe of \p join which may contain join partners, i.e. which are neither
+ * empty nor pruned by the filter condition of the respective child on either side. */
+std::vector<std::array<uint32_t, 4>> compute_joined_partitions(const JoinOperator &join, const Operator &build,
+                                                               const Operator &probe)
 {
-    M.child->execute(std::move(setup), std::move(pipeline), std::move(teardown));
+    auto co_partitioning = find_co_partitioning(join, build, probe);
+    M_insist(bool(co_partitioning), "children must be co-partitioned");
+    auto &[build_partitioning, probe_partitioning] = *co_partitioning;
+
+    auto remaining = [](const Operator &child, const Partitionings::Partitioning &partitioning) {
+        if (auto filter = cast<const FilterOperator>(&child))
+            return Partitionings::Prune(partitioning, get_partition_wise_scan(child)->store().table(),
+                                        filter->filter());
+        return std::vector<bool>(partitioning.ranges.size(), true);
+    };
+    const auto remaining_build = remaining(build, build_partitioning);
+    const auto remaining_probe = remaining(probe, probe_partitioning);
+
+    std::vector<std::array<uint32_t, 4>> partitions;
+    for (std::size_t p = 0; p != build_partitioning.ranges.size(); ++p) {
+        auto [build_begin, build_end] = build_partitioning.ranges[p];
+        auto [probe_begin, probe_end] = probe_partitioning.ranges[p];
+        if (not remaining_build[p] or not remaining_probe[p] or build_begin == build_end or probe_begin == probe_end)
+            continue; // no join partners in this partition
+        partitions.push_back({ build_begin, build_end, probe_begin, probe_end });
+    }
+    return partitions;
 }
 
-
-/*======================================================================================================================
- * Join
- *====================================================================================================================*/
-
-template<bool Predicated>
-ConditionSet NestedLoopsJoin<Predicated>::pre_condition(std::size_t, const std::tuple<const JoinOperator*>&)
+ConditionSet PartitionWiseHashJoin::pre_condition(
+    std::size_t child_idx,
+    const std::tuple<const JoinOperator*, const Wildcard*, const Wildcard*> &partial_inner_nodes)
 {
     ConditionSet pre_cond;
 
-    /*----- Nested-loops join does not support SIMD. -----*/
+    /*----- Partition-wise hash join can only be used for binary joins on equi-predicates. -----*/
+    auto &join = *std::get<0>(partial_inner_nodes);
+    if (not join.predicate().is_equi())
+        return ConditionSet::Make_Unsatisfiable();
+
+    /*----- Partition-wise hash join can only be used for (filtered) scans of tables co-partitioned on a join key. --*/
+    const Operator &build = *M_notnull(std::get<1>(partial_inner_nodes));
+    if (child_idx == 0) {
+        auto scan = get_partition_wise_scan(build);
+        if (not scan or not get_partitioning(*scan))
+            return ConditionSet::Make_Unsatisfiable();
+    } else {
+        const Operator &probe = *M_notnull(std::get<2>(partial_inner_nodes));
+        if (not find_co_partitioning(join, build, probe))
+            return ConditionSet::Make_Unsatisfiable();
+    }
+
+    /*----- Partition-wise hash join does not support SIMD. -----*/
     pre_cond.add_condition(NoSIMD());
 
     return pre_cond;
 }
 
-template<bool Predicated>
-ConditionSet NestedLoopsJoin<Predicated>::adapt_post_conditions(
-    const Match<NestedLoopsJoin>&,
+ConditionSet PartitionWiseHashJoin::adapt_post_conditions(
+    const Match<PartitionWiseHashJoin>&,
     std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children)
 {
-    M_insist(post_cond_children.size() >= 2);
+    M_insist(post_cond_children.size() == 2);
 
-    ConditionSet post_cond(post_cond_children.back().get()); // preserve conditions of right-most child
+    /* Note that the sortedness of the probe child is not preserved since its tuples are processed in partition
+     * order. */
+    ConditionSet post_cond;
 
-    if constexpr (Predicated) {
-        /*----- Predicated nested-loops join introduces predication. -----*/
-        post_cond.add_or_replace_condition(m::Predicated(true));
-    }
+    /*----- Partition-wise hash join does not introduce predication (it is already handled by the hash table). -----*/
+    post_cond.add_condition(m::Predicated(false));
+
+    /*----- Partition-wise hash join does not introduce SIMD. -----*/
+    post_cond.add_condition(NoSIMD());
 
     return post_cond;
 }
 
-template<bool Predicated>
-double NestedLoopsJoin<Predicated>::cost(const Match<NestedLoopsJoin> &M)
+double PartitionWiseHashJoin::cost(const Match<PartitionWiseHashJoin> &M)
 {
-    double cost = 1;
-    for (auto &child : M.children)
-        cost *= child->get_matched_root().info().estimated_cardinality;
-    return cost;
+    const double card_build = M.build.info().estimated_cardinality;
+    const double card_probe = M.probe.info().estimated_cardinality;
+
+    /*----- Estimate the size of the largest build partition by its share of the rows of the joined partitions. -----*/
+    uint64_t num_build_rows = 0;
+    uint64_t max_build_rows = 0;
+    for (auto &p : compute_joined_partitions(M.join, M.build, M.probe)) {
+        num_build_rows += p[1] - p[0];
+        max_build_rows = std::max<uint64_t>(max_build_rows, p[1] - p[0]);
+    }
+    const double max_partition_size_in_bytes =
+        num_build_rows ? card_build * max_build_rows / num_build_rows * tuple_size_in_bytes(M.build.schema()) : 0.;
+
+    /* In contrast to `wasm::RadixPartitionedHashJoin`, neither child is materialized or partitioned. */
+    if (max_partition_size_in_bytes <= M.partition_size)
+        return 0.6 * card_build + 0.4 * card_probe; // cache-resident partitions, i.e. mostly cache hits
+    else
+        return simple_hash_join_cost(M.build, M.probe, false); // large partitions, i.e. as for simple hash join
 }
 
-template<bool Predicated>
-void NestedLoopsJoin<Predicated>::execute(const Match<NestedLoopsJoin> &M, setup_t setup, pipeline_t pipeline,
-                                          teardown_t teardown)
+void PartitionWiseHashJoin::execute(const Match<PartitionWiseHashJoin> &M, setup_t setup, pipeline_t pipeline,
+                                    teardown_t teardown)
 {
-    const auto num_left_children = M.children.size() - 1; // all children but right-most one
+    M_insist(((M.join.schema() | M.join.predicate().get_required()) & M.build.schema()) == M.build.schema());
+    M_insist(M.build.schema().drop_constants() == M.build.schema());
+    const auto ht_schema = M.build.schema().deduplicate();
 
-    std::vector<Schema> schemas; // to own adapted schemas
-    schemas.reserve(num_left_children);
-    std::vector<GlobalBuffer> buffers;
-    buffers.reserve(num_left_children);
+    /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
+    const auto [build_keys, probe_keys] = decompose_equi_predicate(M.join.predicate(), ht_schema);
 
-    /*----- Process all but right-most child. -----*/
-    for (std::size_t i = 0; i < num_left_children; ++i) {
-        /*----- Create function for each child. -----*/
-        FUNCTION(nested_loop_join_child_pipeline, void(void))
-        {
-            auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+    /*----- Determine the scans and filters of both children, which are read directly from the tables. -----*/
+    const Operator &build = M.build;
+    const Operator &probe = M.probe;
+    auto &build_scan = *M_notnull(get_partition_wise_scan(build));
+    auto &probe_scan = *M_notnull(get_partition_wise_scan(probe));
+    auto build_filter = cast<const FilterOperator>(&build);
+    auto probe_filter = cast<const FilterOperator>(&probe);
+
+    /*----- Partition-wise hash join does not support SIMD. -----*/
+    const auto build_layout_schema = scan_layout_schema(build_scan);
+    const auto probe_layout_schema = scan_layout_schema(probe_scan);
+    CodeGenContext::Get().set_num_simd_lanes(1);
+
+    /*----- Partition-wise hash joins prune partitions by the filter constants at compile time, which may be bound late,
+     * hence the module must not be reused for later executions. -----*/
+    CodeGenContext::Get().mark_module_not_reusable();
+
+    /*----- Compute the row IDs of the partitions to join and write them into memory. -----*/
+    const auto partitions = compute_joined_partitions(M.join, build, probe);
+    if (partitions.empty()) { // no partition may contain join partners
+        setup();
+        teardown();
+        return;
+    }
+    uint32_t *partitions_address = Module::Allocator().raw_malloc<uint32_t>(4 * partitions.size());
+    uint32_t max_build_rows = 0;
+    for (std::size_t i = 0; i != partitions.size(); ++i) {
+        std::copy(partitions[i].cbegin(), partitions[i].cend(), partitions_address + 4 * i);
+        max_build_rows = std::max(max_build_rows, partitions[i][1] - partitions[i][0]);
+    }
 
-            /*----- Create infinite buffer to materialize the current results. -----*/
-            M_insist(bool(M.materializing_factories_[i]),
-                     "`wasm::NestedLoopsJoin` must have a factory for each materialized child");
-            const auto &schema = schemas.emplace_back(
-                M.children[i]->get_matched_root().schema().drop_constants().deduplicate()
-            );
-            if (i == 0) {
-                /*----- Exactly one child (here left-most one) checks join predicate and resumes pipeline. -----*/
-                buffers.emplace_back(
-                    /* schema=        */ schema,
-                    /* factory=       */ *M.materializing_factories_[i],
-                    /* load_simdfied= */ false,
-                    /* num_tuples=    */ 0, // i.e. infinite
-                    /* setup=         */ setup_t::Make_Without_Parent(),
-                    /* pipeline=      */ [&, pipeline=std::move(pipeline)](){
-                        if constexpr (Predicated) {
-                            CodeGenContext::Get().env().add_predicate(M.join.predicate());
-                            pipeline();
-                        } else {
-                            M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes");
-                            IF (CodeGenContext::Get().env().compile<_Boolx1>(M.join.predicate()).is_true_and_not_null()) {
-                                pipeline();
-                            };
-                        }
-                    },
-                    /* teardown=      */ teardown_t::Make_Without_Parent()
-                );
-            } else {
-                /*----- All but exactly one child (here left-most one) load lastly inserted buffer again. -----*/
-                /* All buffers are "connected" with each other by setting the pipeline callback as calling the
-                 * `resume_pipeline_inline()` method of the lastly inserted buffer. Therefore, calling
-                 * `resume_pipeline_inline()` on the lastly inserted buffer will load one tuple from it, recursively
-                 * call `resume_pipeline_inline()` on the buffer created before that which again loads one tuple from
-                 * it, and so on until the buffer inserted first (here the one of the left-most child) will load one
-                 * of its tuples and check the join predicate for this one cartesian-product-combination of result
-                 * tuples. */
-                buffers.emplace_back(
-                    /* schema=        */ schema,
-                    /* factory=       */ *M.materializing_factories_[i],
-                    /* load_simdfied= */ false,
-                    /* num_tuples=    */ 0, // i.e. infinite
-                    /* setup=         */ setup_t::Make_Without_Parent(),
-                    /* pipeline=      */ [&](){ buffers.back().resume_pipeline_inline(); },
-                    /* teardown=      */ teardown_t::Make_Without_Parent()
-                );
+    /*----- Create hash table on the build child which is reused for each partition and fits the largest one. -----*/
+    auto ht = create_partition_hash_table(M, ht_schema, build_keys,
+                                          std::max(uint32_t(std::ceil(max_build_rows / M.load_factor)), 16U));
+
+    /*----- Compute payload IDs. -----*/
+    std::vector<Schema::Identifier> payload_ids;
+    for (auto &e : ht_schema) {
+        if (not contains(build_keys, e.id))
+            payload_ids.push_back(e.id);
+    }
+
+    /*----- Import the base addresses of the mapped memory of both tables. -----*/
+    Ptr<void> build_base_address = get_base_address(build_scan.store().table().name());
+    Ptr<void> probe_base_address = get_base_address(probe_scan.store().table().name());
+
+    /*----- Create function to iterate the rows `[begin, end)` of the table scanned by `scan` and to call `consume`
+     * for each row whose key `keys` is not NULL and which satisfies the filter condition of `filter`, if any. -----*/
+    auto for_each_row = [](const ScanOperator &scan, const FilterOperator *filter, const Schema &layout_schema,
+                           Ptr<void> base_address, const std::vector<Schema::Identifier> &keys, U32x1 begin,
+                           U32x1 end, std::function<void(void)> consume)
+    {
+        static Schema empty_schema;
+        auto S = CodeGenContext::Get().scoped_environment();
+        Var<U32x1> tuple_id(begin);
+        const Var<U32x1> tuple_end(end);
+
+        /*----- Compile data layout to generate sequential load from the first row on. -----*/
+        auto [inits, loads, jumps] = compile_load_sequential(scan.schema(), empty_schema, std::move(base_address),
+                                                             scan.store().table().layout(), 1, layout_schema,
+                                                             tuple_id);
+        inits.attach_to_current();
+        WHILE (tuple_id < tuple_end) {
+            loads.attach_to_current();
+            auto &env = CodeGenContext::Get().env();
+            std::optional<Boolx1> qualifies;
+            for (auto &key : keys) {
+                auto val = env.get(key);
+                if (qualifies)
+                    qualifies.emplace(*qualifies and not_null(val));
+                else
+                    qualifies.emplace(not_null(val));
             }
+            M_insist(bool(qualifies));
+            if (filter)
+                qualifies.emplace(*qualifies and env.compile<_Boolx1>(filter->filter()).is_true_and_not_null());
+            IF (*qualifies) {
+                consume();
+            };
+            jumps.attach_to_current();
+        }
+    };
 
-            /*----- Materialize the current result tuple in pipeline. -----*/
-            M.children[i]->execute(
-                /* setup=    */ setup_t::Make_Without_Parent([&](){ buffers.back().setup(); }),
-                /* pipeline= */ [&](){ buffers.back().consume(); },
-                /* teardown= */ teardown_t::Make_Without_Parent([&](){ buffers.back().teardown(); })
-            );
+    /*----- Create function to insert the current build row into the hash table. -----*/
+    auto insert = [&](){
+        auto &env = CodeGenContext::Get().env();
+
+        /*----- Insert key. -----*/
+        std::vector<SQL_t> key;
+        for (auto &build_key : build_keys)
+            key.emplace_back(env.get(build_key));
+        auto entry = ht->emplace(std::move(key));
+
+        /*----- Insert payload. -----*/
+        for (auto &id : payload_ids) {
+            std::visit(overloaded {
+                [&]<sql_type T>(HashTable::reference_t<T> &&r) -> void { r = env.extract<T>(id); },
+                [](std::monostate) -> void { M_unreachable("invalid reference"); },
+            }, entry.extract(id));
         }
-        nested_loop_join_child_pipeline(); // call child function
+    };
+
+    /*----- Create function to probe the hash table with the current probe row and to resume the pipeline for each
+     * join partner. -----*/
+    auto emit_tuple_and_resume_pipeline = [&](HashTable::const_entry_t entry){
+        auto &env = CodeGenContext::Get().env();
+
+        /*----- Add found entry from hash table, i.e. from build partition, to current environment. -----*/
+        for (auto &e : ht_schema) {
+            std::visit(overloaded {
+                [&]<typename T>(HashTable::const_reference_t<Expr<T>> &&r) -> void {
+                    Expr<T> value = r;
+                    if (value.can_be_null()) {
+                        Var<Expr<T>> var(value); // introduce variable s.t. uses only load from it
+                        env.add(e.id, var);
+                    } else {
+                        /* introduce variable w/o NULL bit s.t. uses only load from it */
+                        Var<PrimitiveExpr<T>> var(value.insist_not_null());
+                        env.add(e.id, Expr<T>(var));
+                    }
+                },
+                [&](HashTable::const_reference_t<NChar> &&r) -> void {
+                    NChar value(r);
+                    Var<Ptr<Charx1>> var(value.val()); // introduce variable s.t. uses only load from it
+                    env.add(e.id, NChar(var, value.can_be_null(), value.length(),
+                                        value.guarantees_terminating_nul()));
+                },
+                [](std::monostate) -> void { M_unreachable("invalid reference"); },
+            }, entry.extract(e.id));
+        }
+
+        /*----- Resume pipeline. -----*/
+        pipeline();
+    };
+    auto probe_and_resume_pipeline = [&](){
+        auto &env = CodeGenContext::Get().env();
+
+        /*----- Search for *all* join partners. -----*/
+        std::vector<SQL_t> key;
+        for (auto &probe_key : probe_keys)
+            key.emplace_back(env.get(probe_key));
+        ht->for_each_in_equal_range(std::move(key), emit_tuple_and_resume_pipeline, /* predicated= */ false);
+    };
+
+    /*----- Emit setup code *after* allocating memory and *before* compiling data layouts to not overwrite their
+     * temporary boolean variables. -----*/
+    setup();
+    ht->setup();
+    ht->set_high_watermark(M.load_factor);
+
+    /*----- Process partitions one after another by building the hash table on the build partition and probing it with
+     * the respective probe partition. -----*/
+    Var<Ptr<U32x1>> partition(partitions_address);
+    const Var<Ptr<U32x1>> partitions_end(Ptr<U32x1>(partitions_address + 4 * partitions.size()));
+    WHILE (partition < partitions_end) {
+        break_on_pipeline_exit();
+        ht->clear();
+        for_each_row(build_scan, build_filter, build_layout_schema, build_base_address.clone(), build_keys,
+                     U32x1(*partition), U32x1(*(partition + 1)), insert);
+        for_each_row(probe_scan, probe_filter, probe_layout_schema, probe_base_address.clone(), probe_keys,
+                     U32x1(*(partition + 2)), U32x1(*(partition + 3)), probe_and_resume_pipeline);
+        partition += 4;
     }
 
-    /*----- Process right-most child. -----*/
-    M.children.back()->execute(
-        /* setup=    */ std::move(setup),
-        /* pipeline= */ [&](){ buffers.back().resume_pipeline_inline(); },
-        /* teardown= */ std::move(teardown)
-    );
+    ht->teardown();
+    build_base_address.discard();
+    probe_base_address.discard();
+
+    /*----- Emit teardown code. -----*/
+    teardown();
+}
+
+std::optional<key_domain_t> DirectAddressJoin::find_key_domain(const JoinOperator &join, const Wildcard &build)
+{
+    if (join.predicate().size() != 1 or not build.has_info())
+        return std::nullopt;
+    auto &literal = join.predicate().front()[0];
+    auto &binary = as<const BinaryExpr>(literal.expr());
+    auto &build_key = build.schema().has(Schema::Identifier(*binary.lhs)) ? *binary.lhs : *binary.rhs;
+    auto attr = std::get_if<const Attribute*>(&as<const Designator>(build_key).target());
+    if (not attr)
+        return std::nullopt;
+
+    const double max_size = options::direct_address_join_max_domain_factor * build.info().estimated_cardinality;
+    return ::find_key_domain(**attr, std::min<double>(max_size, std::numeric_limits<uint32_t>::max()));
 }
 
-template<bool UniqueBuild, bool Predicated>
-ConditionSet SimpleHashJoin<UniqueBuild, Predicated>::pre_condition(
-    std::size_t,
+ConditionSet DirectAddressJoin::pre_condition(
+    std::size_t child_idx,
     const std::tuple<const JoinOperator*, const Wildcard*, const Wildcard*> &partial_inner_nodes)
 {
     ConditionSet pre_cond;
 
-    /*----- Simple hash join can only be used for binary joins on equi-predicates. -----*/
+    /*----- Direct address join can only be used for binary joins on equi-predicates. -----*/
     auto &join = *std::get<0>(partial_inner_nodes);
     if (not join.predicate().is_equi())
         return ConditionSet::Make_Unsatisfiable();
 
-    if constexpr (UniqueBuild) {
-        /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
-        auto &build = *std::get<1>(partial_inner_nodes);
-        for (auto &clause : join.predicate()) {
-            M_insist(clause.size() == 1, "invalid equi-predicate");
-            auto &literal = clause[0];
-            auto &binary = as<const BinaryExpr>(literal.expr());
-            M_insist((not literal.negative() and binary.tok == TK_EQUAL) or
-                     (literal.negative() and binary.tok == TK_BANG_EQUAL), "invalid equi-predicate");
-            M_insist(is<const Designator>(binary.lhs), "invalid equi-predicate");
-            M_insist(is<const Designator>(binary.rhs), "invalid equi-predicate");
-            Schema::Identifier id_first(*binary.lhs), id_second(*binary.rhs);
-            const auto &entry_build = build.schema().has(id_first) ? build.schema()[id_first].second
-                                                                   : build.schema()[id_second].second;
+    /*----- Direct address join can only be used on a single, unique build key of a dense domain. -----*/
+    auto &build = *std::get<1>(partial_inner_nodes);
+    const auto build_keys = decompose_equi_predicate(join.predicate(), build.schema()).first;
+    if (build_keys.size() != 1 or not build.schema()[build_keys.front()].second.unique())
+        return ConditionSet::Make_Unsatisfiable();
+    if (not find_key_domain(join, build))
+        return ConditionSet::Make_Unsatisfiable();
 
-            /*----- Unique simple hash join can only be used on unique build key. -----*/
-            if (not entry_build.unique())
-                return ConditionSet::Make_Unsatisfiable();
-        }
-    }
+    M_insist(child_idx < 2);
 
-    /*----- Simple hash join does not support SIMD. -----*/
+    /*----- Direct address join does not support SIMD. -----*/
     pre_cond.add_condition(NoSIMD());
 
     return pre_cond;
 }
 
-template<bool UniqueBuild, bool Predicated>
-ConditionSet SimpleHashJoin<UniqueBuild, Predicated>::adapt_post_conditions(
-    const Match<SimpleHashJoin>&,
+ConditionSet DirectAddressJoin::adapt_post_conditions(
+    const Match<DirectAddressJoin>&,
     std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children)
 {
     M_insist(post_cond_children.size() == 2);
 
     ConditionSet post_cond(post_cond_children[1].get()); // preserve conditions of right child
 
-    if constexpr (Predicated) {
-        /*----- Predicated simple hash join introduces predication. -----*/
-        post_cond.add_or_replace_condition(m::Predicated(true));
-    } else {
-        /*----- Branching simple hash join does not introduce predication (it is already handled by the hash table). -*/
-        post_cond.add_or_replace_condition(m::Predicated(false));
-    }
+    /*----- Direct address join does not introduce predication (it is already handled by the array). -----*/
+    post_cond.add_or_replace_condition(m::Predicated(false));
+
+    /*----- Direct address join does not introduce SIMD. -----*/
+    post_cond.add_or_replace_condition(NoSIMD());
 
     return post_cond;
 }
 
-template<bool UniqueBuild, bool Predicated>
-double SimpleHashJoin<UniqueBuild, Predicated>::cost(const Match<SimpleHashJoin> &M)
+double DirectAddressJoin::cost(const Match<DirectAddressJoin> &M)
 {
-    if (options::simple_hash_join_ordering_strategy == option_configs::OrderingStrategy::BUILD_ON_LEFT)
-        return (M.build.id() == M.children[0]->get_matched_root().id() ? 1.0 : 2.0) + (UniqueBuild ? 0.0 : 0.1);
-    else if (options::simple_hash_join_ordering_strategy == option_configs::OrderingStrategy::BUILD_ON_RIGHT)
-        return M.build.id() == M.children[1]->get_matched_root().id() ? 1.0 : 2.0 + (UniqueBuild ? 0.0 : 0.1);
-    else
-        return 1.5 * M.build.info().estimated_cardinality +
-            (UniqueBuild ? 1.0 : 1.1) * M.probe.info().estimated_cardinality;
+    /* Cheaper than a unique simple hash join since keys are neither hashed nor compared to colliding keys, but all
+     * slots of the domain are allocated. */
+    return 1.0 * M.build.info().estimated_cardinality + 0.75 * M.probe.info().estimated_cardinality +
+        0.1 * M.key_domain.second;
 }
 
-template<bool UniqueBuild, bool Predicated>
-void SimpleHashJoin<UniqueBuild, Predicated>::execute(const Match<SimpleHashJoin> &M, setup_t setup,
-                                                      pipeline_t pipeline, teardown_t teardown)
+void DirectAddressJoin::execute(const Match<DirectAddressJoin> &M, setup_t setup, pipeline_t pipeline,
+                                teardown_t teardown)
 {
-    // TODO: determine setup
-    const uint64_t PAYLOAD_SIZE_THRESHOLD_IN_BITS =
-        M.use_in_place_values ? std::numeric_limits<uint64_t>::max() : 0;
-
     M_insist(((M.join.schema() | M.join.predicate().get_required()) & M.build.schema()) == M.build.schema());
     M_insist(M.build.schema().drop_constants() == M.build.schema());
     const auto ht_schema = M.build.schema().deduplicate();
 
-    /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
+    /*----- Decompose the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
     const auto [build_keys, probe_keys] = decompose_equi_predicate(M.join.predicate(), ht_schema);
+    M_insist(build_keys.size() == 1 and probe_keys.size() == 1);
+    const auto &build_key = build_keys.front();
+    const auto &probe_key = probe_keys.front();
+    auto key_of = [](SQL_t key) { std::vector<SQL_t> v; v.emplace_back(std::move(key)); return v; };
 
-    /*----- Compute payload IDs and its total size in bits (ignoring padding). -----*/
-    std::vector<Schema::Identifier> payload_ids;
-    uint64_t payload_size_in_bits = 0;
-    for (auto &e : ht_schema) {
-        if (not contains(build_keys, e.id)) {
-            payload_ids.push_back(e.id);
-            payload_size_in_bits += e.type->size();
-        }
-    }
-
-    /*----- Compute initial capacity of hash table. -----*/
-    uint32_t initial_capacity = compute_initial_ht_capacity(M.build, M.load_factor);
+    /*----- Create the array, i.e. a hash table mapping keys directly to its slots, covering the entire domain. -----*/
+    const uint32_t capacity = std::ceil(M.key_domain.second / M.load_factor);
+    GlobalOpenAddressingInPlaceHashTable ht(ht_schema, { ht_schema[build_key].first }, capacity);
+    ht.set_probing_strategy<LinearProbing>();
+    ht.set_direct_mapping(M.key_domain.first);
 
-    /*----- Create hash table for build child. -----*/
-    std::unique_ptr<HashTable> ht;
-    std::vector<HashTable::index_t> build_key_indices;
-    for (auto &build_key : build_keys)
-        build_key_indices.push_back(ht_schema[build_key].first);
-    if (M.use_open_addressing_hashing) {
-        if (payload_size_in_bits < PAYLOAD_SIZE_THRESHOLD_IN_BITS)
-            ht = std::make_unique<GlobalOpenAddressingInPlaceHashTable>(ht_schema, std::move(build_key_indices),
-                                                                        initial_capacity);
-        else
-            ht = std::make_unique<GlobalOpenAddressingOutOfPlaceHashTable>(ht_schema, std::move(build_key_indices),
-                                                                           initial_capacity);
-        if (M.use_quadratic_probing)
-            as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<QuadraticProbing>();
-        else
-            as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<LinearProbing>();
-    } else {
-        ht = std::make_unique<GlobalChainedHashTable>(ht_schema, std::move(build_key_indices), initial_capacity);
-    }
+    /*----- Whether all build keys are within the domain s.t. probe keys outside of it cannot have a partner. -----*/
+    Global<Boolx1> build_keys_in_domain(true);
 
     /*----- Create function for build child. -----*/
-    FUNCTION(simple_hash_join_child_pipeline, void(void)) // create function for pipeline
+    FUNCTION(direct_address_join_child_pipeline, void(void)) // create function for pipeline
     {
         auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
 
         M.children[0]->execute(
             /* setup=    */ setup_t::Make_Without_Parent([&](){
-                ht->setup();
-                ht->set_high_watermark(M.load_factor);
+                ht.setup();
+                ht.set_high_watermark(M.load_factor);
             }),
             /* pipeline= */ [&](){
                 auto &env = CodeGenContext::Get().env();
 
-                std::optional<Boolx1> build_key_not_null;
-                for (auto &build_key : build_keys) {
-                    auto val = env.get(build_key);
-                    if (build_key_not_null)
-                        build_key_not_null.emplace(*build_key_not_null and not_null(val));
-                    else
-                        build_key_not_null.emplace(not_null(val));
-                }
-                M_insist(bool(build_key_not_null));
-                IF (*build_key_not_null) { // TODO: predicated version
-                    /*----- Insert key. -----*/
-                    std::vector<SQL_t> key;
-                    for (auto &build_key : build_keys)
-                        key.emplace_back(env.get(build_key));
-                    auto entry = ht->emplace(std::move(key));
+                /*----- Skip NULL keys since they never satisfy the join predicate. -----*/
+                IF (not_null(env.get(build_key))) {
+                    /*----- Insert key at its offset within the domain, i.e. hashing is the identity. -----*/
+                    auto offset = ht.hash(key_of(env.get(build_key)));
+                    build_keys_in_domain = build_keys_in_domain and offset < U64x1(M.key_domain.second);
+                    auto entry = ht.emplace(key_of(env.get(build_key)));
 
                     /*----- Insert payload. -----*/
-                    for (auto &id : payload_ids) {
+                    for (auto &e : ht_schema) {
+                        if (e.id == build_key)
+                            continue;
                         std::visit(overloaded {
-                            [&]<sql_type T>(HashTable::reference_t<T> &&r) -> void { r = env.extract<T>(id); },
+                            [&]<sql_type T>(HashTable::reference_t<T> &&r) -> void { r = env.extract<T>(e.id); },
                             [](std::monostate) -> void { M_unreachable("invalid reference"); },
-                        }, entry.extract(id));
+                        }, entry.extract(e.id));
                     }
                 };
             },
-            /* teardown= */ teardown_t::Make_Without_Parent([&](){ ht->teardown(); })
+            /* teardown= */ teardown_t::Make_Without_Parent([&](){ ht.teardown(); })
         );
     }
-    simple_hash_join_child_pipeline(); // call child function
+    direct_address_join_child_pipeline(); // call child function
 
     M.children[1]->execute(
-        /* setup=    */ setup_t(std::move(setup), [&](){ ht->setup(); }),
+        /* setup=    */ setup_t(std::move(setup), [&](){ ht.setup(); }),
         /* pipeline= */ [&, pipeline=std::move(pipeline)](){
             auto &env = CodeGenContext::Get().env();
 
-            auto emit_tuple_and_resume_pipeline = [&, pipeline=std::move(pipeline)](HashTable::const_entry_t entry){
-                /*----- Add found entry from hash table, i.e. from build child, to current environment. -----*/
-                for (auto &e : ht_schema) {
-                    if (not entry.has(e.id)) { // entry may not contain build key in case `ht->find()` was used
-                        M_insist(contains(build_keys, e.id));
-                        M_insist(env.has(e.id), "build key must already be contained in the current environment");
-                        continue;
-                    }
+            /*----- Add build key to current environment since `ht.find()` only returns the payload values. -----*/
+            if (not env.has(build_key))
+                env.add(build_key, env.get(probe_key)); // since build and probe keys match for join partners
 
-                    std::visit(overloaded {
-                        [&]<typename T>(HashTable::const_reference_t<Expr<T>> &&r) -> void {
-                            Expr<T> value = r;
-                            if (value.can_be_null()) {
-                                Var<Expr<T>> var(value); // introduce variable s.t. uses only load from it
-                                env.add(e.id, var);
-                            } else {
-                                /* introduce variable w/o NULL bit s.t. uses only load from it */
-                                Var<PrimitiveExpr<T>> var(value.insist_not_null());
-                                env.add(e.id, Expr<T>(var));
-                            }
-                        },
-                        [&](HashTable::const_reference_t<NChar> &&r) -> void {
-                            NChar value(r);
-                            Var<Ptr<Charx1>> var(value.val()); // introduce variable s.t. uses only load from it
-                            env.add(e.id, NChar(var, value.can_be_null(), value.length(),
-                                                value.guarantees_terminating_nul()));
-                        },
-                        [](std::monostate) -> void { M_unreachable("invalid reference"); },
-                    }, entry.extract(e.id));
-                }
+            /*----- Look up the *single* possible join partner at the offset of the probe key within the domain. -----*/
+            auto offset = ht.hash(key_of(env.get(probe_key)));
+            IF (not build_keys_in_domain or offset < U64x1(M.key_domain.second)) {
+                auto [entry, found] = ht.find(key_of(env.get(probe_key)));
+                IF (found) {
+                    /*----- Add found entry from the array, i.e. from build child, to current environment. -----*/
+                    for (auto &e : ht_schema) {
+                        if (e.id == build_key)
+                            continue;
+                        std::visit(overloaded {
+                            [&]<typename T>(HashTable::const_reference_t<Expr<T>> &&r) -> void {
+                                Expr<T> value = r;
+                                if (value.can_be_null()) {
+                                    Var<Expr<T>> var(value); // introduce variable s.t. uses only load from it
+                                    env.add(e.id, var);
+                                } else {
+                                    /* introduce variable w/o NULL bit s.t. uses only load from it */
+                                    Var<PrimitiveExpr<T>> var(value.insist_not_null());
+                                    env.add(e.id, Expr<T>(var));
+                                }
+                            },
+                            [&](HashTable::const_reference_t<NChar> &&r) -> void {
+                                NChar value(r);
+                                Var<Ptr<Charx1>> var(value.val()); // introduce variable s.t. uses only load from it
+                                env.add(e.id, NChar(var, value.can_be_null(), value.length(),
+                                                    value.guarantees_terminating_nul()));
+                            },
+                            [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                        }, entry.extract(e.id));
+                    }
 
-                /*----- Resume pipeline. -----*/
-                pipeline();
+                    /*----- Resume pipeline. -----*/
+                    pipeline();
+                };
             };
-
-            /* TODO: may check for NULL on probe keys as well, branching + predicated version */
-            /*----- Probe with probe key. -----*/
-            std::vector<SQL_t> key;
-            for (auto &probe_key : probe_keys)
-                key.emplace_back(env.get(probe_key));
-            if constexpr (UniqueBuild) {
-                /*----- Add build key to current environment since `ht->find()` will only return the payload values. -----*/
-                for (auto build_it = build_keys.cbegin(), probe_it = probe_keys.cbegin(); build_it != build_keys.cend();
-                     ++build_it, ++probe_it)
-                {
-                    M_insist(probe_it != probe_keys.cend());
-                    if (not env.has(*build_it)) // skip duplicated build keys and only add first occurrence
-                        env.add(*build_it, env.get(*probe_it)); // since build and probe keys match for join partners
-                }
-
-                /*----- Try to find the *single* possible join partner. -----*/
-                auto p = ht->find(std::move(key));
-                auto &entry = p.first;
-                auto &found = p.second;
-                if constexpr (Predicated) {
-                    env.add_predicate(found);
-                    emit_tuple_and_resume_pipeline(std::move(entry));
-                } else {
-                    IF (found) {
-                        emit_tuple_and_resume_pipeline(std::move(entry));
-                    };
-                }
-            } else {
-                /*----- Search for *all* join partners. -----*/
-                ht->for_each_in_equal_range(std::move(key), std::move(emit_tuple_and_resume_pipeline), Predicated);
-            }
         },
-        /* teardown= */ teardown_t(std::move(teardown), [&](){ ht->teardown(); })
+        /* teardown= */ teardown_t(std::move(teardown), [&](){ ht.teardown(); })
     );
 }
 
-template<bool SortLeft, bool SortRight, bool Predicated, bool CmpPredicated>
-ConditionSet SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::pre_condition(
+
+std::optional<BandJoin::band_t> BandJoin::find_band(const JoinOperator &join, const Wildcard &build)
+{
+    std::optional<band_t> band;
+    for (auto &clause : join.predicate()) {
+        /*----- Consider only clauses of the form `A.x op B.y` with `op` being one of `<`, `<=`, `>`, and `>=`. -----*/
+        if (clause.size() != 1 or clause[0].negative())
+            continue;
+        auto binary = cast<const BinaryExpr>(&clause[0].expr());
+        if (not binary)
+            continue;
+        const bool is_less = binary->tok == TK_LESS or binary->tok == TK_LESS_EQUAL;
+        const bool is_greater = binary->tok == TK_GREATER or binary->tok == TK_GREATER_EQUAL;
+        if (not is_less and not is_greater)
+            continue;
+        auto lhs = cast<const Designator>(binary->lhs.get());
+        auto rhs = cast<const Designator>(binary->rhs.get());
+        if (not lhs or not rhs)
+            continue;
+
+        /*----- Exactly one side must be an attribute of the build child, the key. -----*/
+        const bool lhs_is_key = build.schema().has(Schema::Identifier(*lhs));
+        if (lhs_is_key == build.schema().has(Schema::Identifier(*rhs)))
+            continue;
+        auto key = lhs_is_key ? lhs : rhs;
+        if (band and Schema::Identifier(*band->key) != Schema::Identifier(*key))
+            continue; // bounds another build attribute, hence only checked for the build tuples within the band
+        const auto &e = build.schema()[Schema::Identifier(*key)].second;
+        if (e.nullable() or e.type->is_boolean()) // NULLs would break the order searched by bisection
+            continue;
+        if (not band)
+            band = band_t{ key };
+
+        /*----- `key > y`, `key >= y`, `y < key`, and `y <= key` bound the key from below, the others from above. -*/
+        auto &bound = lhs_is_key == is_greater ? band->lower : band->upper;
+        if (not bound)
+            bound = binary;
+    }
+    return band;
+}
+
+ConditionSet BandJoin::pre_condition(
     std::size_t child_idx,
     const std::tuple<const JoinOperator*, const Wildcard*, const Wildcard*> &partial_inner_nodes)
 {
     ConditionSet pre_cond;
 
-    /*----- Sort merge join can only be used for binary joins on conjunctions of equi-predicates. -----*/
+    /*----- Band join is meant for range predicates, equi-predicates are left to the other joins. -----*/
     auto &join = *std::get<0>(partial_inner_nodes);
-    if (not join.predicate().is_equi())
+    if (join.predicate().is_equi())
         return ConditionSet::Make_Unsatisfiable();
 
-    /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
-    auto parent = std::get<1>(partial_inner_nodes);
-    auto child  = std::get<2>(partial_inner_nodes);
-    M_insist(parent);
-    M_insist(child_idx != 1 or child);
-    std::vector<Schema::Identifier> keys_parent, keys_child;
-    for (auto &clause : join.predicate()) {
-        M_insist(clause.size() == 1, "invalid equi-predicate");
-        auto &literal = clause[0];
-        auto &binary = as<const BinaryExpr>(literal.expr());
-        M_insist((not literal.negative() and binary.tok == TK_EQUAL) or
-                 (literal.negative() and binary.tok == TK_BANG_EQUAL), "invalid equi-predicate");
-        M_insist(is<const Designator>(binary.lhs), "invalid equi-predicate");
-        M_insist(is<const Designator>(binary.rhs), "invalid equi-predicate");
-        Schema::Identifier id_first(*binary.lhs), id_second(*binary.rhs);
-        auto dummy = Schema::entry_type::CreateArtificial(); ///< dummy entry used in case of `child_idx` != 1, i.e. `child` is not yet set
-        const auto &[entry_parent, entry_child] = parent->schema().has(id_first)
-            ? std::make_pair(parent->schema()[id_first].second, child_idx == 1 ? child->schema()[id_second].second : std::move(dummy))
-            : std::make_pair(parent->schema()[id_second].second, child_idx == 1 ? child->schema()[id_first].second : std::move(dummy));
-        keys_parent.push_back(entry_parent.id);
-        keys_child.push_back(entry_child.id);
-
-        /*----- Sort merge join can only be used on unique parent key. -----*/
-        if (not entry_parent.unique())
-            return ConditionSet::Make_Unsatisfiable();
-    }
-    M_insist(keys_parent.size() == keys_child.size(), "number of found IDs differ");
-    M_insist(not keys_parent.empty(), "must find at least one ID");
+    /*----- Band join can only be used if the predicate bounds a single attribute of the build child. -----*/
+    auto &build = *std::get<1>(partial_inner_nodes);
+    if (not find_band(join, build))
+        return ConditionSet::Make_Unsatisfiable();
 
-    if constexpr (not SortLeft or not SortRight) {
-        /*----- Sort merge join without sorting needs its data sorted on the respective key. -----*/
-        Sortedness::order_t orders;
-        M_insist(child_idx < 2);
-        if (not SortLeft and child_idx == 0) {
-            for (auto &key_parent : keys_parent) {
-                if (orders.find(key_parent) == orders.cend())
-                    orders.add(key_parent, Sortedness::O_ASC); // TODO: support different order
-            }
-        } else if (not SortRight and child_idx == 1) {
-            for (auto &key_child : keys_child) {
-                if (orders.find(key_child) == orders.cend())
-                    orders.add(key_child, Sortedness::O_ASC); // TODO: support different order
-            }
-        }
-        pre_cond.add_condition(Sortedness(std::move(orders)));
-    }
+    M_insist(child_idx < 2);
 
-    /*----- Sort merge join does not support SIMD. -----*/
+    /*----- Band join does not support SIMD. -----*/
     pre_cond.add_condition(NoSIMD());
 
     return pre_cond;
 }
 
-template<bool SortLeft, bool SortRight, bool Predicated, bool CmpPredicated>
-ConditionSet SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::adapt_post_conditions(
-    const Match<SortMergeJoin> &M,
+ConditionSet BandJoin::adapt_post_conditions(
+    const Match<BandJoin>&,
     std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children)
 {
     M_insist(post_cond_children.size() == 2);
 
-    ConditionSet post_cond;
-
-    if constexpr (Predicated) {
-        /*----- Predicated sort merge join introduces predication. -----*/
-        post_cond.add_or_replace_condition(m::Predicated(true));
-    }
-
-    /*----- Sort merge join does not introduce SIMD. -----*/
-    post_cond.add_condition(NoSIMD());
-
-    Sortedness::order_t orders;
-    if constexpr (not SortLeft) {
-        Sortedness sorting_left(post_cond_children[0].get().get_condition<Sortedness>());
-        orders.merge(sorting_left.orders()); // preserve sortedness of left child (including order)
-    }
-    if constexpr (not SortRight) {
-        Sortedness sorting_right(post_cond_children[1].get().get_condition<Sortedness>());
-        orders.merge(sorting_right.orders()); // preserve sortedness of right child (including order)
-    }
-    if constexpr (SortLeft or SortRight) {
-        /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
-        auto [keys_parent, keys_child] = decompose_equi_predicate(M.join.predicate(), M.parent.schema());
-
-        /*----- Sort merge join does sort the data on the respective key. -----*/
-        if constexpr (SortLeft) {
-            for (auto &key_parent : keys_parent) {
-                if (orders.find(key_parent) == orders.cend())
-                    orders.add(key_parent, Sortedness::O_ASC); // add sortedness for left child
-            }
-        }
-        if constexpr (SortRight) {
-            for (auto &key_child : keys_child) {
-                if (orders.find(key_child) == orders.cend())
-                    orders.add(key_child, Sortedness::O_ASC); // add sortedness for right child
-            }
-        }
-    }
-    post_cond.add_condition(Sortedness(std::move(orders)));
+    ConditionSet post_cond(post_cond_children[1].get()); // preserve conditions of right child
+
+    /*----- Band join does not introduce predication since it emits matching tuples only. -----*/
+    post_cond.add_or_replace_condition(m::Predicated(false));
+
+    /*----- Band join does not introduce SIMD. -----*/
+    post_cond.add_or_replace_condition(NoSIMD());
 
     return post_cond;
 }
 
-template<bool SortLeft, bool SortRight, bool Predicated, bool CmpPredicated>
-double SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::cost(const Match<SortMergeJoin> &M)
+double BandJoin::cost(const Match<BandJoin> &M)
 {
-    const double card_left  = M.parent.info().estimated_cardinality;
-    const double card_right = M.child.info().estimated_cardinality;
-
-    double cost = card_left + card_right; // cost for merge
-    if constexpr (SortLeft)
-        cost += std::log2(card_left) * card_left; // cost for sort left
-    if constexpr (SortRight)
-        cost += std::log2(card_right) * card_right; // cost for sort right
+    const double card_build = M.build.info().estimated_cardinality;
+    const double card_probe = M.probe.info().estimated_cardinality;
+    const double num_searches = bool(M.band.lower) + bool(M.band.upper);
 
-    return cost;
+    /* Sort the build child, search the band of each probe tuple, and check the build tuples within the band. */
+    const double log_build = std::log2(card_build + 1.0);
+    return 1.5 * card_build * log_build + 1.0 * num_searches * card_probe * log_build +
+        1.0 * M.join.info().estimated_cardinality;
 }
 
-template<bool SortLeft, bool SortRight, bool Predicated, bool CmpPredicated>
-void SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::execute(
-    const Match<SortMergeJoin> &M,
-    setup_t setup,
-    pipeline_t pipeline,
-    teardown_t teardown)
+void BandJoin::execute(const Match<BandJoin> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
 {
-    auto &env = CodeGenContext::Get().env();
-    const bool needs_buffer_parent = not is<const ScanOperator>(M.parent) or SortLeft;
-    const bool needs_buffer_child  = not is<const ScanOperator>(M.child) or SortRight;
-
-    /*----- Create infinite buffers to materialize the current results (if necessary). -----*/
-    M_insist(bool(M.left_materializing_factory),
-             "`wasm::SortMergeJoin` must have a factory for the materialized left child");
-    M_insist(bool(M.right_materializing_factory),
-             "`wasm::SortMergeJoin` must have a factory for the materialized right child");
-    const auto schema_parent = M.parent.schema().drop_constants().deduplicate();
-    const auto schema_child  = M.child.schema().drop_constants().deduplicate();
-    std::optional<GlobalBuffer> buffer_parent, buffer_child;
-    if (needs_buffer_parent)
-        buffer_parent.emplace(schema_parent, *M.left_materializing_factory);
-    if (needs_buffer_child)
-        buffer_child.emplace(schema_child, *M.right_materializing_factory);
+    const auto schema_build = M.build.schema().drop_constants().deduplicate();
+    const Schema::Identifier key(*M.band.key);
 
-    /*----- Create child functions. -----*/
-    if (needs_buffer_parent) {
-        FUNCTION(sort_merge_join_parent_pipeline, void(void)) // create function for parent pipeline
-        {
-            auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
-            M.children[0]->execute(
-                    /* setup=    */ setup_t::Make_Without_Parent([&](){ buffer_parent->setup(); }),
-                    /* pipeline= */ [&](){ buffer_parent->consume(); },
-                    /* teardown= */ teardown_t::Make_Without_Parent([&](){ buffer_parent->teardown(); })
-            );
-        }
-        sort_merge_join_parent_pipeline(); // call parent function
-    }
-    if (needs_buffer_child) {
-        FUNCTION(sort_merge_join_child_pipeline, void(void)) // create function for child pipeline
-        {
-            auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
-            M.children[1]->execute(
-                /* setup=    */ setup_t::Make_Without_Parent([&](){ buffer_child->setup(); }),
-                /* pipeline= */ [&](){ buffer_child->consume(); },
-                /* teardown= */ teardown_t::Make_Without_Parent([&](){ buffer_child->teardown(); })
-            );
-        }
-        sort_merge_join_child_pipeline(); // call child function
-    }
+    /*----- Create infinite buffer to materialize the build child. -----*/
+    M_insist(bool(M.build_materializing_factory),
+             "`wasm::BandJoin` must have a factory for the materialized build child");
+    GlobalBuffer buffer(schema_build, *M.build_materializing_factory);
 
-    /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
-    std::vector<SortingOperator::order_type> order_parent, order_child;
-    for (auto &clause : M.join.predicate()) {
-        M_insist(clause.size() == 1, "invalid equi-predicate");
-        auto &literal = clause[0];
-        auto &binary = as<const BinaryExpr>(literal.expr());
-        M_insist((not literal.negative() and binary.tok == TK_EQUAL) or
-                 (literal.negative() and binary.tok == TK_BANG_EQUAL), "invalid equi-predicate");
-        M_insist(is<const Designator>(binary.lhs), "invalid equi-predicate");
-        M_insist(is<const Designator>(binary.rhs), "invalid equi-predicate");
-        auto [expr_parent, expr_child] = M.parent.schema().has(Schema::Identifier(*binary.lhs)) ?
-            std::make_pair(binary.lhs.get(), binary.rhs.get()) : std::make_pair(binary.rhs.get(), binary.lhs.get());
-        order_parent.emplace_back(*expr_parent, true); // ascending order
-        order_child.emplace_back(*expr_child, true); // ascending order
+    /*----- Create function for build child. -----*/
+    FUNCTION(band_join_build_child_pipeline, void(void)) // create function for pipeline
+    {
+        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+        M.children[0]->execute(
+            /* setup=    */ setup_t::Make_Without_Parent([&](){ buffer.setup(); }),
+            /* pipeline= */ [&](){ buffer.consume(); },
+            /* teardown= */ teardown_t::Make_Without_Parent([&](){ buffer.teardown(); })
+        );
     }
-    M_insist(order_parent.size() == order_child.size(), "number of found IDs differ");
-    M_insist(not order_parent.empty(), "must find at least one ID");
+    band_join_build_child_pipeline(); // call build child function
 
-    /*----- If necessary, invoke sorting algorithm with buffer to sort. -----*/
-    if constexpr (SortLeft)
-        quicksort<CmpPredicated>(*buffer_parent, order_parent);
-    if constexpr (SortRight)
-        quicksort<CmpPredicated>(*buffer_child, order_child);
+    /*----- Sort the build tuples on the key. -----*/
+    std::vector<SortingOperator::order_type> order;
+    order.emplace_back(*M.band.key, true); // ascending order
+    quicksort<false>(buffer, order);
 
-    /*----- Create predicate to check if child co-group is smaller or equal than the one of the parent relation. -----*/
-    auto child_smaller_equal = [&]() -> Boolx1 {
-        std::optional<Boolx1> child_smaller_equal_;
-        for (std::size_t i = 0; i < order_child.size(); ++i) {
-            auto &des_parent = as<const Designator>(order_parent[i].first);
-            auto &des_child  = as<const Designator>(order_child[i].first);
-            Token leq = Token::CreateArtificial(TK_LESS_EQUAL);
-            auto cpy_parent = std::make_unique<Designator>(des_parent.tok, des_parent.table_name, des_parent.attr_name,
-                                                           des_parent.type(), des_parent.target());
-            auto cpy_child  = std::make_unique<Designator>(des_child.tok, des_child.table_name, des_child.attr_name,
-                                                           des_child.type(), des_child.target());
-            BinaryExpr expr(std::move(leq), std::move(cpy_child), std::move(cpy_parent));
+    Schema key_schema;
+    const auto &key_entry = schema_build[key].second;
+    key_schema.add(key_entry.id, key_entry.type, key_entry.constraints);
 
-            auto child = env.get(Schema::Identifier(des_child));
-            Boolx1 cmp = env.compile<_Boolx1>(expr).is_true_and_not_null();
-            if (child_smaller_equal_)
-                child_smaller_equal_.emplace(*child_smaller_equal_ and (is_null(child) or cmp));
-            else
-                child_smaller_equal_.emplace(is_null(child) or cmp);
-        }
-        M_insist(bool(child_smaller_equal_));
-        return *child_smaller_equal_;
-    };
+    M.children[1]->execute(
+        /* setup=    */ std::move(setup),
+        /* pipeline= */ [&, pipeline=std::move(pipeline)](){
+            M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes");
+            auto &env = CodeGenContext::Get().env();
+            static Schema empty_schema;
 
-    /*----- Compile data layouts to generate sequential loads from buffers. -----*/
-    static Schema empty_schema;
-    Var<U32x1> tuple_id_parent, tuple_id_child; // default initialized to 0
-    auto [inits_parent, loads_parent, _jumps_parent] = [&](){
-       if (needs_buffer_parent) {
-           return compile_load_sequential(buffer_parent->schema(), empty_schema, buffer_parent->base_address(),
-                                          buffer_parent->layout(), 1, buffer_parent->schema(), tuple_id_parent);
-       } else {
-           auto &scan = as<const ScanOperator>(M.parent);
-           return compile_load_sequential(schema_parent, empty_schema, get_base_address(scan.store().table().name()),
-                                          scan.store().table().layout(), 1, scan.store().table().schema(scan.alias()),
-                                          tuple_id_parent);
-       }
-    }();
-    auto [inits_child, loads_child, _jumps_child] = [&](){
-       if (needs_buffer_child) {
-           return compile_load_sequential(buffer_child->schema(), empty_schema, buffer_child->base_address(),
-                                          buffer_child->layout(), 1, buffer_child->schema(), tuple_id_child);
-       } else {
-           auto &scan = as<const ScanOperator>(M.child);
-           return compile_load_sequential(schema_child, empty_schema, get_base_address(scan.store().table().name()),
-                                          scan.store().table().layout(), 1, scan.store().table().schema(scan.alias()),
-                                          tuple_id_child);
-       }
-    }();
-    /* since structured bindings cannot be used in lambda capture */
-    Block jumps_parent(std::move(_jumps_parent)), jumps_child(std::move(_jumps_child));
+            /*----- If predication is used, the band of a probe tuple not satisfying the predicate is empty. -----*/
+            std::optional<Var<Boolx1>> pred;
+            if (env.predicated())
+                pred = env.extract_predicate<_Boolx1>().is_true_and_not_null();
 
-    /*----- Process both buffers together. -----*/
-    setup();
-    inits_parent.attach_to_current();
-    inits_child.attach_to_current();
-    U32x1 size_parent = needs_buffer_parent ? buffer_parent->size()
-                                            : get_num_rows(as<const ScanOperator>(M.parent).store().table().name());
-    U32x1 size_child = needs_buffer_child ? buffer_child->size()
-                                          : get_num_rows(as<const ScanOperator>(M.child).store().table().name());
-    WHILE (tuple_id_parent < size_parent and tuple_id_child < size_child) { // neither end reached
-        loads_parent.attach_to_current();
-        loads_child.attach_to_current();
-        if constexpr (Predicated) {
-            env.add_predicate(M.join.predicate());
-            pipeline();
-        } else {
-            M_insist(CodeGenContext::Get().num_simd_lanes() == 1, "invalid number of SIMD lanes");
-            IF (env.compile<_Boolx1>(M.join.predicate()).is_true_and_not_null()) { // predicate fulfilled
-                pipeline();
+            /*----- Create function to evaluate the bound `bound` for the build tuple with ID `tuple_id`. -----*/
+            auto holds = [&](const BinaryExpr &bound, U32x1 tuple_id) -> Boolx1 {
+                auto S = CodeGenContext::Get().scoped_environment(); // to load the key of the probed tuple
+                auto &bound_env = CodeGenContext::Get().env();
+                bound_env.add(env); // copy values of the probe tuple
+                compile_load_point_access(key_schema, empty_schema, buffer.base_address(), buffer.layout(),
+                                          buffer.schema(), tuple_id);
+                return bound_env.compile<_Boolx1>(bound).is_true_and_not_null();
             };
-        }
-        IF (child_smaller_equal()) {
-            jumps_child.attach_to_current();
-        } ELSE {
-            jumps_parent.attach_to_current();
-        };
-    }
-    teardown();
+
+            /*----- Search the band of build tuples satisfying both bounds by bisection. -----*/
+            const Var<U32x1> size(buffer.size());
+            Var<U32x1> begin(0U), end(size.val());
+            if (M.band.lower) { // find first build tuple satisfying the lower bound
+                Var<U32x1> hi(size.val());
+                WHILE (begin < hi) {
+                    Var<U32x1> mid((begin + hi) >> 1U); // (begin + hi) / 2
+                    IF (holds(*M.band.lower, mid)) {
+                        hi = mid;
+                    } ELSE {
+                        begin = mid + 1U;
+                    };
+                }
+            }
+            if (M.band.upper) { // find first build tuple not satisfying the upper bound
+                Var<U32x1> lo(begin.val());
+                WHILE (lo < end) {
+                    Var<U32x1> mid((lo + end) >> 1U); // (lo + end) / 2
+                    IF (holds(*M.band.upper, mid)) {
+                        lo = mid + 1U;
+                    } ELSE {
+                        end = mid;
+                    };
+                }
+            }
+            if (pred)
+                end = Select(*pred, end, begin);
+
+            /*----- Check the join predicate for the build tuples within the band. -----*/
+            Var<U32x1> tuple_id(begin.val());
+            auto [inits, loads, jumps] = compile_load_sequential(buffer.schema(), empty_schema, buffer.base_address(),
+                                                                 buffer.layout(), 1, buffer.schema(), tuple_id);
+            inits.attach_to_current();
+            WHILE (tuple_id < end) {
+                loads.attach_to_current();
+                IF (env.compile<_Boolx1>(M.join.predicate()).is_true_and_not_null()) { // predicate fulfilled
+                    pipeline();
+                };
+                jumps.attach_to_current();
+            }
+        },
+        /* teardown= */ std::move(teardown)
+    );
 }
 
 
@@ -5245,6 +9042,12 @@ void Limit::execute(const Match<Limit> &M, setup_t setup, pipeline_t pipeline, t
     /* default initialized to 0 */
     Global<U32x1> counter_backup; ///< *global* counter backup since the following code may be called multiple times
 
+    /*----- Exit the loops driving the input pipelines, even across functions and buffers, once the limit is reached.
+     * The jump to the teardown code only leaves the function of the current pipeline, e.g. `Buffer::resume_pipeline()`,
+     * but not the scan filling the buffer. -----*/
+    Global<Boolx1> limit_reached(false);
+    CodeGenContext::Get().push_pipeline_exit(limit_reached);
+
     M.child->execute(
         /* setup=    */ setup_t(std::move(setup), [&](){
             counter.emplace(counter_backup);
@@ -5261,7 +9064,8 @@ void Limit::execute(const Match<Limit> &M, setup_t setup, pipeline_t pipeline, t
                 GOTO(*teardown_block);
             };
 
-            /*----- Emit result if in bounds. -----*/
+            /*----- Emit result if in bounds.  Loops of the consumers must not be exited. -----*/
+            auto exits = CodeGenContext::Get().suspend_pipeline_exits();
             if (M.limit.offset()) {
                 IF (*counter >= uint32_t(M.limit.offset())) {
                     Wasm_insist(*counter < limit, "counter must not exceed limit");
@@ -5271,21 +9075,185 @@ void Limit::execute(const Match<Limit> &M, setup_t setup, pipeline_t pipeline, t
                 Wasm_insist(*counter < limit, "counter must not exceed limit");
                 pipeline();
             }
+            CodeGenContext::Get().restore_pipeline_exits(std::move(exits));
+
+            /*----- Update counter and request exiting the input loops once the limit is reached. -----*/
+            *counter += 1U;
+            limit_reached = *counter >= limit;
+        },
+        /* teardown= */ teardown_t::Make_Without_Parent([&, teardown=std::move(teardown)](){
+            M_insist(bool(teardown_block));
+            M_insist(bool(use_teardown));
+            use_teardown.reset(); // deactivate block
+            teardown_block.reset(); // emit block containing pipeline code into parent -> GOTO jumps here
+            auto exits = CodeGenContext::Get().suspend_pipeline_exits(); // consumers' loops must not be exited
+            teardown(); // *before* own teardown code to *not* jump over it in case of another limit operator
+            CodeGenContext::Get().restore_pipeline_exits(std::move(exits));
+            M_insist(bool(counter));
+            counter_backup = *counter;
+            counter.reset();
+        })
+    );
+    CodeGenContext::Get().pop_pipeline_exit();
+}
+
+
+/*======================================================================================================================
+ * Limit combined with Sorting
+ *====================================================================================================================*/
+
+ConditionSet TopK::pre_condition(
+    std::size_t child_idx,
+    const std::tuple<const LimitOperator*, const SortingOperator*, const Wildcard*> &partial_inner_nodes)
+{
+    M_insist(child_idx == 0);
+
+    /*----- Top-k is only reasonable if at least one tuple has to be kept. -----*/
+    auto &limit = *std::get<0>(partial_inner_nodes);
+    const uint64_t k = uint64_t(limit.offset()) + uint64_t(limit.limit());
+    if (k == 0 or k > std::numeric_limits<uint32_t>::max())
+        return ConditionSet::Make_Unsatisfiable();
+
+    ConditionSet pre_cond;
+
+    /*----- Top-k needs actual tuples to maintain its heap, i.e. it supports neither SIMD nor predication. -----*/
+    pre_cond.add_condition(m::Predicated(false));
+    pre_cond.add_condition(NoSIMD());
+
+    return pre_cond;
+}
+
+ConditionSet TopK::post_condition(const Match<TopK> &M)
+{
+    ConditionSet post_cond;
+
+    /*----- Top-k does not introduce predication. -----*/
+    post_cond.add_condition(Predicated(false));
+
+    /*----- Top-k does sort the data. -----*/
+    Sortedness::order_t orders;
+    for (auto &o : M.sorting.order_by()) {
+        Schema::Identifier id(o.first);
+        if (orders.find(id) == orders.cend())
+            orders.add(std::move(id), o.second ? Sortedness::O_ASC : Sortedness::O_DESC);
+    }
+    post_cond.add_condition(Sortedness(std::move(orders)));
+
+    /*----- Top-k does not introduce SIMD. -----*/
+    post_cond.add_condition(NoSIMD());
+
+    return post_cond;
+}
+
+void TopK::execute(const Match<TopK> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    const uint32_t k = M.limit.offset() + M.limit.limit();
+    const auto &order = M.sorting.order_by();
+
+    /*----- Skip the first `offset` tuples of the sorted heap when resuming the pipeline. -----*/
+    std::optional<Var<U32x1>> counter; ///< variable to *locally* count the resumed tuples
+    if (M.limit.offset()) {
+        setup = setup_t(std::move(setup), [&](){ counter.emplace(0U); });
+        pipeline = [&, pipeline=std::move(pipeline)](){
+            M_insist(bool(counter));
+            IF (*counter >= uint32_t(M.limit.offset())) {
+                pipeline();
+            };
+            *counter += 1U;
+        };
+        teardown = teardown_t(std::move(teardown), [&](){
+            M_insist(bool(counter));
+            counter.reset();
+        });
+    }
+
+    /*----- Create infinite buffer to materialize the heap but resume the pipeline later.  The buffer never exceeds
+     * `k` tuples since a new tuple replaces the root of the heap once the heap is full. -----*/
+    M_insist(bool(M.materializing_factory), "`wasm::TopK` must have a factory for the materialized child");
+    const auto buffer_schema = M.child->get_matched_root().schema().drop_constants().deduplicate();
+    const auto sorting_schema = M.sorting.schema().drop_constants().deduplicate();
+    GlobalBuffer heap(
+        buffer_schema, *M.materializing_factory, false, 0, std::move(setup), std::move(pipeline), std::move(teardown)
+    );
+
+    /*----- Create load, store, and swap proxies for heap. -----*/
+    auto load = heap.create_load_proxy();
+    auto store = heap.create_store_proxy();
+    auto swap = heap.create_swap_proxy();
+
+    /*----- Create function to three-way compare the heap entries at IDs `first` and `second`. -----*/
+    auto compare_entries = [&](U32x1 first, U32x1 second) -> I32x1 {
+        auto env_first = [&](){
+            auto S = CodeGenContext::Get().scoped_environment();
+            load(first);
+            return S.extract();
+        }();
+        auto env_second = [&](){
+            auto S = CodeGenContext::Get().scoped_environment();
+            load(second);
+            return S.extract();
+        }();
+        return compare<false>(env_first, env_second, order);
+    };
+
+    /*----- Create child function. -----*/
+    FUNCTION(top_k_child_pipeline, void(void)) // create function for pipeline
+    {
+        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+
+        M.child->execute(
+            /* setup=    */ setup_t::Make_Without_Parent([&](){ heap.setup(); }),
+            /* pipeline= */ [&](){
+                /*----- Maintain a max-heap w.r.t. the ordering, i.e. its root is the worst of the best `k` tuples. -*/
+                IF (heap.size() < k) {
+                    /*----- Append current tuple and sift it up. -----*/
+                    heap.consume();
+                    Var<U32x1> child(heap.size() - 1U);
+                    WHILE (child > 0U) {
+                        const Var<U32x1> parent((child - 1U) >> 1U);
+                        BREAK(compare_entries(child, parent) <= 0); // heap property restored
+                        swap(parent, child);
+                        child = parent;
+                    }
+                } ELSE {
+                    /*----- Replace root by current tuple iff the latter is ordered before the root. -----*/
+                    auto env_root = [&](){
+                        auto S = CodeGenContext::Get().scoped_environment();
+                        load(0U);
+                        return S.extract();
+                    }();
+                    IF (compare<false>(CodeGenContext::Get().env(), env_root, order) < 0) {
+                        store(0U);
+
+                        /*----- Sift new root down. -----*/
+                        Var<U32x1> parent(0U);
+                        LOOP () {
+                            const Var<U32x1> left((parent << 1U) + 1U);
+                            BREAK(left >= k); // parent is a leaf
+                            Var<U32x1> child(left.val());
+                            IF (left + 1U < k) {
+                                IF (compare_entries(left + 1U, left) > 0) {
+                                    child = left + 1U; // right child is greater
+                                };
+                            };
+                            BREAK(compare_entries(child, parent) <= 0); // heap property restored
+                            swap(parent, child);
+                            parent = child;
+                            CONTINUE();
+                        }
+                    };
+                };
+            },
+            /* teardown= */ teardown_t::Make_Without_Parent([&](){ heap.teardown(); })
+        );
+    }
+    top_k_child_pipeline(); // call child function
 
-            /*----- Update counter. -----*/
-            *counter += 1U;
-        },
-        /* teardown= */ teardown_t::Make_Without_Parent([&, teardown=std::move(teardown)](){
-            M_insist(bool(teardown_block));
-            M_insist(bool(use_teardown));
-            use_teardown.reset(); // deactivate block
-            teardown_block.reset(); // emit block containing pipeline code into parent -> GOTO jumps here
-            teardown(); // *before* own teardown code to *not* jump over it in case of another limit operator
-            M_insist(bool(counter));
-            counter_backup = *counter;
-            counter.reset();
-        })
-    );
+    /*----- Sort heap, which contains at most `k` tuples. -----*/
+    quicksort<false>(heap, order);
+
+    /*----- Process sorted heap. -----*/
+    heap.resume_pipeline(sorting_schema);
 }
 
 
@@ -5317,15 +9285,33 @@ ConditionSet HashBasedGroupJoin::pre_condition(
     if (child_idx == 0) {
         /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
         auto &build = *std::get<2>(partial_inner_nodes);
-        const auto build_keys = decompose_equi_predicate(join.predicate(), build.schema()).first;
-
-        /*----- Hash-based group-join can only be used if grouping and join (i.e. build) key match (ignoring order). -*/
-        const auto num_grouping_keys = grouping.group_by().size();
-        if (num_grouping_keys != build_keys.size()) // XXX: duplicated IDs are still a match but rejected here
-            return ConditionSet::Make_Unsatisfiable();
-        for (std::size_t i = 0; i < num_grouping_keys; ++i) {
-            Schema::Identifier grouping_key(grouping.group_by()[i].first.get());
-            if (not contains(build_keys, grouping_key))
+        const auto [build_keys, probe_keys] = decompose_equi_predicate(join.predicate(), build.schema());
+
+        /*----- Hash-based group-join can only be used if each join key is a grouping key, either by its build or by its
+         * probe part, and all other grouping keys are functionally dependent on the join key. -----*/
+        std::vector<bool> is_grouped(build_keys.size(), false);
+        bool has_dependent_keys = false;
+        for (auto &[grouping_key_expr, _] : grouping.group_by()) {
+            Schema::Identifier grouping_key(grouping_key_expr.get());
+            bool is_join_key = false;
+            for (std::size_t i = 0; i != build_keys.size(); ++i) {
+                if (grouping_key == build_keys[i] or grouping_key == probe_keys[i]) {
+                    is_grouped[i] = true;
+                    is_join_key = true;
+                }
+            }
+            if (not is_join_key) {
+                if (not build.schema().has(grouping_key))
+                    return ConditionSet::Make_Unsatisfiable(); // not dependent on the join key
+                has_dependent_keys = true;
+            }
+        }
+        if (not std::all_of(is_grouped.cbegin(), is_grouped.cend(), [](bool b) { return b; }))
+            return ConditionSet::Make_Unsatisfiable(); // groups would comprise multiple join keys
+        if (has_dependent_keys) {
+            /* Build attributes are functionally dependent on the join key only if the join key is unique. */
+            auto is_unique = [&](const Schema::Identifier &id) { return build.schema()[id].second.unique(); };
+            if (not std::any_of(build_keys.cbegin(), build_keys.cend(), is_unique))
                 return ConditionSet::Make_Unsatisfiable();
         }
     }
@@ -5358,24 +9344,55 @@ ConditionSet HashBasedGroupJoin::post_condition(const Match<HashBasedGroupJoin>&
 void HashBasedGroupJoin::execute(const Match<HashBasedGroupJoin> &M, setup_t setup, pipeline_t pipeline,
                                  teardown_t teardown)
 {
-    // TODO: determine setup
-    const uint64_t AGGREGATES_SIZE_THRESHOLD_IN_BITS =
-        M.use_in_place_values ? std::numeric_limits<uint64_t>::max() : 0;
-
     auto &C = Catalog::Get();
     const auto num_keys = M.grouping.group_by().size();
 
-    /*----- Compute hash table schema and information about aggregates, especially AVG aggregates. -----*/
+    /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
+    const auto [build_keys, probe_keys] = decompose_equi_predicate(M.join.predicate(), M.build.schema());
+
+    /*----- Compute the join key, i.e. the build key, which corresponds to the grouping key with index `i`, if any. */
+    auto join_key_of = [&](std::size_t i) -> std::optional<std::size_t> {
+        Schema::Identifier grouping_key(M.grouping.group_by()[i].first.get());
+        for (std::size_t j = 0; j != build_keys.size(); ++j) {
+            if (grouping_key == build_keys[j] or grouping_key == probe_keys[j])
+                return j;
+        }
+        return std::nullopt;
+    };
+
+    /*----- Compute hash table schema and information about aggregates, especially AVG aggregates.  The hash table is
+     * keyed by the join key, named as the respective grouping keys.  Other grouping keys, i.e. duplicates of the join
+     * key or attributes of the build child functionally dependent on it, are stored as values of the build tuple. --*/
     Schema ht_schema;
+    uint64_t keys_size_in_bits = 0;
+    for (std::size_t j = 0; j != build_keys.size(); ++j) {
+        for (std::size_t i = 0; i < num_keys; ++i) {
+            if (join_key_of(i) == j) {
+                auto &e = M.grouping.schema()[i];
+                ht_schema.add(e.id, e.type, e.constraints);
+                keys_size_in_bits += e.type->size();
+                break;
+            }
+        }
+    }
+    M_insist(ht_schema.num_entries() == build_keys.size(), "each join key must be a grouping key");
+    ///> the grouping keys stored as values with the ID of the respective value in the build child
+    std::vector<std::pair<Schema::Identifier, Schema::Identifier>> dependent_keys;
+    uint64_t aggregates_size_in_bits = 0;
     for (std::size_t i = 0; i < num_keys; ++i) {
         auto &e = M.grouping.schema()[i];
+        if (ht_schema.has(e.id))
+            continue; // join key or duplicated grouping key
+        const auto j = join_key_of(i);
+        dependent_keys.emplace_back(e.id, j ? build_keys[*j]
+                                            : Schema::Identifier(M.grouping.group_by()[i].first.get()));
         ht_schema.add(e.id, e.type, e.constraints);
+        aggregates_size_in_bits += e.type->size();
     }
     auto aggregates_info = compute_aggregate_info(M.grouping.aggregates(), M.grouping.schema(), num_keys);
     const auto &aggregates = aggregates_info.first;
     const auto &avg_aggregates = aggregates_info.second;
     bool needs_build_counter = false; ///< flag whether additional COUNT per group during build phase must be emitted
-    uint64_t aggregates_size_in_bits = 0;
     for (auto &info : aggregates) {
         ht_schema.add(info.entry);
         aggregates_size_in_bits += info.entry.type->size();
@@ -5400,25 +9417,26 @@ void HashBasedGroupJoin::execute(const Match<HashBasedGroupJoin> &M, setup_t set
                   Schema::entry_type::NOT_NULLABLE);
     aggregates_size_in_bits += 64;
 
-    /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y`. -----*/
-    const auto [build_keys, probe_keys] = decompose_equi_predicate(M.join.predicate(), M.build.schema());
-    M_insist(build_keys.size() == num_keys);
-
     /*----- Compute initial capacity of hash table. -----*/
     uint32_t initial_capacity = compute_initial_ht_capacity(M.grouping, M.load_factor);
 
     /*----- Create hash table for build relation. -----*/
+    const auto [in_place, quadratic] = choose_open_addressing_strategies(
+        M.use_in_place_values, M.use_quadratic_probing, M.load_factor, keys_size_in_bits, aggregates_size_in_bits
+    );
     std::unique_ptr<HashTable> ht;
-    std::vector<HashTable::index_t> key_indices(num_keys);
+    std::vector<HashTable::index_t> key_indices(build_keys.size());
     std::iota(key_indices.begin(), key_indices.end(), 0);
-    if (M.use_open_addressing_hashing) {
-        if (aggregates_size_in_bits < AGGREGATES_SIZE_THRESHOLD_IN_BITS)
+    if (M.use_swiss_hashing and in_place) {
+        ht = std::make_unique<GlobalSwissHashTable>(ht_schema, std::move(key_indices), initial_capacity);
+    } else if (M.use_open_addressing_hashing or M.use_swiss_hashing) { // Swiss tables store values only in-place
+        if (in_place)
             ht = std::make_unique<GlobalOpenAddressingInPlaceHashTable>(ht_schema, std::move(key_indices),
                                                                         initial_capacity);
         else
             ht = std::make_unique<GlobalOpenAddressingOutOfPlaceHashTable>(ht_schema, std::move(key_indices),
                                                                            initial_capacity);
-        if (M.use_quadratic_probing)
+        if (quadratic)
             as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<QuadraticProbing>();
         else
             as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<LinearProbing>();
@@ -5809,6 +9827,16 @@ void HashBasedGroupJoin::execute(const Match<HashBasedGroupJoin> &M, setup_t set
                         r = _I64x1(0); // initialize with neutral element 0
                     }
 
+                    /*----- Add dependent grouping keys to compiled aggregates, i.e. store them once per group. -----*/
+                    BLOCK_OPEN(init_aggs) {
+                        for (auto &[id, build_id] : dependent_keys) {
+                            std::visit(overloaded {
+                                [&]<sql_type T>(HashTable::reference_t<T> &&r) -> void { r = env.get<T>(build_id); },
+                                [](std::monostate) -> void { M_unreachable("invalid reference"); },
+                            }, entry.extract(id));
+                        }
+                    }
+
                     /*----- If group has been inserted, initialize aggregates. Otherwise, update them. -----*/
                     IF (inserted) {
                         init_aggs.attach_to_current();
@@ -6024,6 +10052,179 @@ void HashBasedGroupJoin::execute(const Match<HashBasedGroupJoin> &M, setup_t set
 }
 
 
+/*======================================================================================================================
+ * Join with distinct keys
+ *====================================================================================================================*/
+
+ConditionSet HashSemiJoin::pre_condition(
+    std::size_t child_idx,
+    const std::tuple<const JoinOperator*, const GroupingOperator*, const Wildcard*, const Wildcard*>
+        &partial_inner_nodes)
+{
+    ConditionSet pre_cond;
+
+    /*----- Hash semi-join can only be used for binary joins on equi-predicates. -----*/
+    auto &join = *std::get<0>(partial_inner_nodes);
+    if (not join.predicate().is_equi())
+        return ConditionSet::Make_Unsatisfiable();
+
+    /*----- Hash semi-join can only be used if the grouping computes the distinct keys of its child, i.e. it has no
+     * aggregates and groups by attributes of its child. -----*/
+    auto &grouping = *std::get<1>(partial_inner_nodes);
+    if (not grouping.aggregates().empty())
+        return ConditionSet::Make_Unsatisfiable();
+    for (auto &[grp, alias] : grouping.group_by()) {
+        if (not is<const Designator>(grp.get()))
+            return ConditionSet::Make_Unsatisfiable();
+    }
+
+    /*----- Hash semi-join can only be used if grouping and join (i.e. build) key match (ignoring order), since
+     * otherwise a join key may occur in multiple groups. -----*/
+    const auto build_keys = decompose_equi_predicate(join.predicate(), grouping.schema()).first;
+    const auto num_grouping_keys = grouping.group_by().size();
+    if (num_grouping_keys != build_keys.size()) // XXX: duplicated IDs are still a match but rejected here
+        return ConditionSet::Make_Unsatisfiable();
+    for (std::size_t i = 0; i < num_grouping_keys; ++i) {
+        if (not contains(build_keys, grouping.schema()[i].id))
+            return ConditionSet::Make_Unsatisfiable();
+    }
+
+    M_insist(child_idx < 2);
+
+    /*----- Hash semi-join does not support SIMD. -----*/
+    pre_cond.add_condition(NoSIMD());
+
+    return pre_cond;
+}
+
+double HashSemiJoin::cost(const Match<HashSemiJoin> &M)
+{
+    /* Cheaper than a hash-based grouping followed by a simple hash join, which consumes the build child once and then
+     * inserts the groups into a second hash table. */
+    return 1.5 * M.build.info().estimated_cardinality + 1.0 * M.probe.info().estimated_cardinality;
+}
+
+ConditionSet HashSemiJoin::post_condition(const Match<HashSemiJoin>&)
+{
+    ConditionSet post_cond;
+
+    /*----- Hash semi-join does not introduce predication (it is already handled by the hash table). -----*/
+    post_cond.add_condition(Predicated(false));
+
+    /*----- Hash semi-join does not introduce SIMD. -----*/
+    post_cond.add_condition(NoSIMD());
+
+    return post_cond;
+}
+
+void HashSemiJoin::execute(const Match<HashSemiJoin> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    const auto num_keys = M.grouping.group_by().size();
+
+    /*----- The hash table only stores the distinct keys, i.e. the keys of the groups, without any payload. -----*/
+    Schema ht_schema;
+    uint64_t keys_size_in_bits = 0;
+    for (std::size_t i = 0; i < num_keys; ++i) {
+        auto &e = M.grouping.schema()[i];
+        ht_schema.add(e.id, e.type, e.constraints);
+        keys_size_in_bits += e.type->size();
+    }
+
+    /*----- Decompose each clause of the join predicate of the form `A.x = B.y` into parts `A.x` and `B.y` and order
+     * the probe keys like the keys of the hash table. -----*/
+    const auto [build_keys, probe_keys] = decompose_equi_predicate(M.join.predicate(), M.grouping.schema());
+    M_insist(build_keys.size() == num_keys);
+    std::vector<Schema::Identifier> ordered_probe_keys;
+    for (std::size_t i = 0; i < num_keys; ++i) {
+        auto it = std::find(build_keys.cbegin(), build_keys.cend(), ht_schema[i].id);
+        M_insist(it != build_keys.cend(), "grouping key must be a join key");
+        ordered_probe_keys.push_back(probe_keys[std::distance(build_keys.cbegin(), it)]);
+    }
+
+    /*----- Compute initial capacity of hash table. -----*/
+    uint32_t initial_capacity = compute_initial_ht_capacity(M.grouping, M.load_factor);
+
+    /*----- Create hash table for the distinct build keys. -----*/
+    std::unique_ptr<HashTable> ht;
+    std::vector<HashTable::index_t> key_indices(num_keys);
+    std::iota(key_indices.begin(), key_indices.end(), 0);
+    if (M.use_swiss_hashing) {
+        ht = std::make_unique<GlobalSwissHashTable>(ht_schema, std::move(key_indices), initial_capacity);
+    } else if (M.use_open_addressing_hashing) {
+        ht = std::make_unique<GlobalOpenAddressingInPlaceHashTable>(ht_schema, std::move(key_indices),
+                                                                    initial_capacity);
+        const bool quadratic = choose_open_addressing_strategies(
+            true, M.use_quadratic_probing, M.load_factor, keys_size_in_bits, 0
+        ).second;
+        if (quadratic)
+            as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<QuadraticProbing>();
+        else
+            as<OpenAddressingHashTableBase>(*ht).set_probing_strategy<LinearProbing>();
+    } else {
+        ht = std::make_unique<GlobalChainedHashTable>(ht_schema, std::move(key_indices), initial_capacity);
+    }
+
+    /*----- Create function for build child. -----*/
+    FUNCTION(hash_semi_join_child_pipeline, void(void)) // create function for pipeline
+    {
+        auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+
+        M.children[0]->execute(
+            /* setup=    */ setup_t::Make_Without_Parent([&](){
+                ht->setup();
+                ht->set_high_watermark(M.load_factor);
+            }),
+            /* pipeline= */ [&](){
+                auto &env = CodeGenContext::Get().env();
+
+                /*----- Skip NULL keys since they never satisfy the join predicate. -----*/
+                std::optional<Boolx1> key_not_null;
+                for (auto &[grp, _] : M.grouping.group_by()) {
+                    auto val = env.get(Schema::Identifier(grp.get()));
+                    if (key_not_null)
+                        key_not_null.emplace(*key_not_null and not_null(val));
+                    else
+                        key_not_null.emplace(not_null(val));
+                }
+                M_insist(bool(key_not_null));
+                IF (*key_not_null) {
+                    /*----- Insert key if not yet done, i.e. only the distinct keys are kept. -----*/
+                    std::vector<SQL_t> key;
+                    for (auto &[grp, _] : M.grouping.group_by())
+                        key.emplace_back(env.get(Schema::Identifier(grp.get())));
+                    ht->try_emplace(std::move(key));
+                };
+            },
+            /* teardown= */ teardown_t::Make_Without_Parent([&](){ ht->teardown(); })
+        );
+    }
+    hash_semi_join_child_pipeline(); // call child function
+
+    M.children[1]->execute(
+        /* setup=    */ setup_t(std::move(setup), [&](){ ht->setup(); }),
+        /* pipeline= */ [&, pipeline=std::move(pipeline)](){
+            auto &env = CodeGenContext::Get().env();
+
+            /*----- Add build keys to current environment since they match the probe keys of join partners. -----*/
+            for (std::size_t i = 0; i < num_keys; ++i) {
+                if (not env.has(ht_schema[i].id))
+                    env.add(ht_schema[i].id, env.get(ordered_probe_keys[i]));
+            }
+
+            /*----- Emit the probe tuple iff its key is found, i.e. stop at the first and only join partner. -----*/
+            std::vector<SQL_t> key;
+            for (auto &probe_key : ordered_probe_keys)
+                key.emplace_back(env.get(probe_key));
+            auto [_, found] = ht->find(std::move(key));
+            IF (found) {
+                pipeline();
+            };
+        },
+        /* teardown= */ teardown_t(std::move(teardown), [&](){ ht->teardown(); })
+    );
+}
+
+
 /*======================================================================================================================
  * Match<T>::print()
  *====================================================================================================================*/
@@ -6035,6 +10236,12 @@ struct print_info
     friend std::ostream & operator<<(std::ostream &out, const print_info &info) {
         if (info.op.has_info())
             out << " <" << info.op.info().estimated_cardinality << '>';
+        if (auto num_tuples = OperatorTupleCounts::Get().find(info.op))
+            out << " [" << *num_tuples << " tuples]";
+        if (auto memory = OperatorMemoryConsumption::Get().find(info.op)) {
+            out << " [" << memory->pre_allocated / (1024.0 * 1024.0) << " MiB pre-allocated, "
+                << memory->allocated_peak / (1024.0 * 1024.0) << " MiB allocated peak]";
+        }
         return out;
     }
 };
@@ -6072,6 +10279,25 @@ void Match<m::wasm::Scan<SIMDfied>>::print(std::ostream &out, unsigned level) co
     out << this->scan.schema() << print_info(this->scan) << " (cumulative cost " << cost() << ')';
 }
 
+void Match<m::wasm::LateMaterializingScan>::print(std::ostream &out, unsigned level) const
+{
+    indent(out, level) << "wasm::LateMaterializingScan(" << this->scan.alias() << ") "
+                       << this->filter.schema() << print_info(this->filter) << " (cumulative cost " << cost() << ')';
+}
+
+void Match<m::wasm::ZoneMapScan>::print(std::ostream &out, unsigned level) const
+{
+    indent(out, level) << "wasm::ZoneMapScan(" << this->scan.alias() << ") "
+                       << this->filter.schema() << print_info(this->filter) << " (cumulative cost " << cost() << ')';
+}
+
+void Match<m::wasm::SelectionVectorScan>::print(std::ostream &out, unsigned level) const
+{
+    indent(out, level) << "wasm::SelectionVectorScan(" << this->scan.alias() << ") with " << this->vector_size
+                       << " tuples selection vector " << this->filter.schema() << print_info(this->filter)
+                       << " (cumulative cost " << cost() << ')';
+}
+
 template<idx::IndexMethod IndexMethod>
 void Match<m::wasm::IndexScan<IndexMethod>>::print(std::ostream &out, unsigned level) const
 {
@@ -6132,6 +10358,25 @@ void Match<m::wasm::Filter<Predicated>>::print(std::ostream &out, unsigned level
     this->child->print(out, level + 1);
 }
 
+void Match<m::wasm::AdaptiveFilter>::print(std::ostream &out, unsigned level) const
+{
+    indent(out, level) << "wasm::AdaptiveFilter ";
+    if (this->buffer_factory_ and this->filter.schema().drop_constants().deduplicate().num_entries())
+        out << "with " << this->buffer_num_tuples_ << " tuples output buffer ";
+    out << this->filter.schema() << print_info(this->filter);
+    if (auto decision = OperatorSelectionStrategies::Get().find(this->filter)) {
+        out << " [";
+        switch (decision->mode) {
+            case OperatorSelectionStrategies::M_Sampling:   out << "sampling"; break;
+            case OperatorSelectionStrategies::M_Branching:  out << "branching"; break;
+            case OperatorSelectionStrategies::M_Predicated: out << "predicated"; break;
+        }
+        out << ", " << decision->num_passed << " of " << decision->num_sampled << " sampled tuples passed]";
+    }
+    out << " (cumulative cost " << cost() << ')';
+    this->child->print(out, level + 1);
+}
+
 void Match<m::wasm::LazyDisjunctiveFilter>::print(std::ostream &out, unsigned level) const
 {
     indent(out, level) << "wasm::LazyDisjunctiveFilter ";
@@ -6170,6 +10415,23 @@ void Match<m::wasm::OrderedGrouping>::print(std::ostream &out, unsigned level) c
     this->child->print(out, level + 1);
 }
 
+void Match<m::wasm::ArrayGrouping>::print(std::ostream &out, unsigned level) const
+{
+    indent(out, level) << "wasm::ArrayGrouping " << this->grouping.schema() << " with key domain ["
+                       << this->key_domain.first << ", " << this->key_domain.first + int64_t(this->key_domain.second)
+                       << ')' << print_info(this->grouping) << " (cumulative cost " << cost() << ')';
+    this->child->print(out, level + 1);
+}
+
+void Match<m::wasm::RadixPartitionedGrouping>::print(std::ostream &out, unsigned level) const
+{
+    indent(out, level) << "wasm::RadixPartitionedGrouping with "
+                       << (1U << compute_num_radix_bits(this->grouping, this->partition_size)) << " partitions "
+                       << this->grouping.schema() << print_info(this->grouping)
+                       << " (cumulative cost " << cost() << ')';
+    this->child->print(out, level + 1);
+}
+
 void Match<m::wasm::Aggregation>::print(std::ostream &out, unsigned level) const
 {
     indent(out, level) << "wasm::Aggregation " << this->aggregation.schema() << print_info(this->aggregation)
@@ -6185,6 +10447,13 @@ void Match<m::wasm::Quicksort<CmpPredicated>>::print(std::ostream &out, unsigned
     this->child->print(out, level + 1);
 }
 
+void Match<m::wasm::RadixSort>::print(std::ostream &out, unsigned level) const
+{
+    indent(out, level) << "wasm::RadixSort " << this->sorting.schema() << print_info(this->sorting)
+                       << " (cumulative cost " << cost() << ')';
+    this->child->print(out, level + 1);
+}
+
 void Match<m::wasm::NoOpSorting>::print(std::ostream &out, unsigned level) const
 {
     indent(out, level) << "wasm::NoOpSorting" << print_info(this->sorting) << " (cumulative cost " << cost() << ')';
@@ -6208,6 +10477,23 @@ void Match<m::wasm::NestedLoopsJoin<Predicated>>::print(std::ostream &out, unsig
     }
 }
 
+template<idx::IndexMethod IndexMethod>
+void Match<m::wasm::IndexNestedLoopsJoin<IndexMethod>>::print(std::ostream &out, unsigned level) const
+{
+    if (IndexMethod == idx::IndexMethod::Array)
+        indent(out, level) << "wasm::ArrayIndexNestedLoopsJoin(";
+    else if (IndexMethod == idx::IndexMethod::Rmi)
+        indent(out, level) << "wasm::RecursiveModelIndexNestedLoopsJoin(";
+    else
+        M_unreachable("unknown index");
+    out << this->scan.alias() << ") with " << this->probe_window_size << " tuples probe window "
+        << this->join.schema() << print_info(this->join) << " (cumulative cost " << cost() << ')';
+
+    ++level;
+    indent(out, level) << "outer input";
+    this->child->print(out, level + 1);
+}
+
 template<bool Unique, bool Predicated>
 void Match<m::wasm::SimpleHashJoin<Unique, Predicated>>::print(std::ostream &out, unsigned level) const
 {
@@ -6215,6 +10501,10 @@ void Match<m::wasm::SimpleHashJoin<Unique, Predicated>>::print(std::ostream &out
     if (Unique) out << " on UNIQUE key ";
     if (this->buffer_factory_ and this->join.schema().drop_constants().deduplicate().num_entries())
         out << "with " << this->buffer_num_tuples_ << " tuples output buffer ";
+    if (this->probe_window_size)
+        out << "with " << this->probe_window_size << " tuples probe window ";
+    if (this->use_bloom_filter)
+        out << "with Bloom filter ";
     out << this->join.schema() << print_info(this->join) << " (cumulative cost " << cost() << ')';
 
     ++level;
@@ -6257,6 +10547,65 @@ void Match<m::wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated
     left.print(out, level + 1);
 }
 
+void Match<m::wasm::RadixPartitionedHashJoin>::print(std::ostream &out, unsigned level) const
+{
+    indent(out, level) << "wasm::RadixPartitionedHashJoin with "
+                       << (1U << compute_num_radix_bits(this->build, this->partition_size)) << " partitions "
+                       << this->join.schema() << print_info(this->join) << " (cumulative cost " << cost() << ')';
+
+    ++level;
+    const m::wasm::MatchBase &build = *this->children[0];
+    const m::wasm::MatchBase &probe = *this->children[1];
+    indent(out, level) << "probe input";
+    probe.print(out, level + 1);
+    indent(out, level) << "build input";
+    build.print(out, level + 1);
+}
+
+void Match<m::wasm::PartitionWiseHashJoin>::print(std::ostream &out, unsigned level) const
+{
+    indent(out, level) << "wasm::PartitionWiseHashJoin of "
+                       << compute_joined_partitions(this->join, this->build, this->probe).size() << " partitions "
+                       << this->join.schema() << print_info(this->join) << " (cumulative cost " << cost() << ')';
+
+    ++level;
+    const m::wasm::MatchBase &build = *this->children[0];
+    const m::wasm::MatchBase &probe = *this->children[1];
+    indent(out, level) << "probe input";
+    probe.print(out, level + 1);
+    indent(out, level) << "build input";
+    build.print(out, level + 1);
+}
+
+void Match<m::wasm::DirectAddressJoin>::print(std::ostream &out, unsigned level) const
+{
+    indent(out, level) << "wasm::DirectAddressJoin with key domain [" << this->key_domain.first << ", "
+                       << this->key_domain.first + int64_t(this->key_domain.second) << ") " << this->join.schema()
+                       << print_info(this->join) << " (cumulative cost " << cost() << ')';
+
+    ++level;
+    const m::wasm::MatchBase &build = *this->children[0];
+    const m::wasm::MatchBase &probe = *this->children[1];
+    indent(out, level) << "probe input";
+    probe.print(out, level + 1);
+    indent(out, level) << "build input";
+    build.print(out, level + 1);
+}
+
+void Match<m::wasm::BandJoin>::print(std::ostream &out, unsigned level) const
+{
+    indent(out, level) << "wasm::BandJoin on " << Schema::Identifier(*this->band.key) << ' ' << this->join.schema()
+                       << print_info(this->join) << " (cumulative cost " << cost() << ')';
+
+    ++level;
+    const m::wasm::MatchBase &build = *this->children[0];
+    const m::wasm::MatchBase &probe = *this->children[1];
+    indent(out, level) << "probe input";
+    probe.print(out, level + 1);
+    indent(out, level) << "build input";
+    build.print(out, level + 1);
+}
+
 void Match<m::wasm::Limit>::print(std::ostream &out, unsigned level) const
 {
     indent(out, level) << "wasm::Limit " << this->limit.schema() << print_info(this->limit)
@@ -6264,6 +10613,13 @@ void Match<m::wasm::Limit>::print(std::ostream &out, unsigned level) const
     this->child->print(out, level + 1);
 }
 
+void Match<m::wasm::TopK>::print(std::ostream &out, unsigned level) const
+{
+    indent(out, level) << "wasm::TopK " << this->limit.schema() << print_info(this->limit) << " ordered by "
+                       << this->sorting.schema() << " (cumulative cost " << cost() << ')';
+    this->child->print(out, level + 1);
+}
+
 void Match<m::wasm::HashBasedGroupJoin>::print(std::ostream &out, unsigned level) const
 {
     indent(out, level) << "wasm::HashBasedGroupJoin ";
@@ -6281,6 +10637,20 @@ void Match<m::wasm::HashBasedGroupJoin>::print(std::ostream &out, unsigned level
 }
 
 
+void Match<m::wasm::HashSemiJoin>::print(std::ostream &out, unsigned level) const
+{
+    indent(out, level) << "wasm::HashSemiJoin " << this->join.schema() << print_info(this->join)
+                       << " on distinct keys " << this->grouping.schema() << " (cumulative cost " << cost() << ')';
+
+    ++level;
+    const m::wasm::MatchBase &build = *this->children[0];
+    const m::wasm::MatchBase &probe = *this->children[1];
+    indent(out, level) << "probe input";
+    probe.print(out, level + 1);
+    indent(out, level) << "build input";
+    build.print(out, level + 1);
+}
+
 /*======================================================================================================================
  * ThePreOrderMatchBaseVisitor, ThePostOrderMatchBaseVisitor
  *====================================================================================================================*/
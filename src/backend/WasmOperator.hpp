@@ -1,6 +1,9 @@
 #pragma once
 
+#include "backend/ArrowExport.hpp"
+#include "backend/ResultColumns.hpp"
 #include "backend/WasmUtil.hpp"
+#include "util/ObjectPool.hpp"
 #include <mutable/IR/PhysicalOptimizer.hpp>
 #include <mutable/storage/DataLayoutFactory.hpp>
 #include <mutable/util/enum_ops.hpp>
@@ -20,28 +23,39 @@ namespace option_configs {
 
 /*----- algorithmic decisions ----------------------------------------------------------------------------------------*/
 enum class ScanImplementation : uint64_t {
-    ALL        = 0b11,
-    SCAN       = 0b01,
-    INDEX_SCAN = 0b10,
+    ALL                = 0b11111,
+    SCAN               = 0b00001,
+    INDEX_SCAN         = 0b00010,
+    LATE_MATERIALIZING = 0b00100,
+    ZONE_MAP           = 0b01000,
+    SELECTION_VECTOR   = 0b10000,
 };
 
 enum class GroupingImplementation : uint64_t {
-    ALL        = 0b11,
-    HASH_BASED = 0b01,
-    ORDERED    = 0b10,
+    ALL               = 0b1111,
+    HASH_BASED        = 0b0001,
+    ORDERED           = 0b0010,
+    ARRAY             = 0b0100,
+    RADIX_PARTITIONED = 0b1000,
 };
 
 enum class SortingImplementation : uint64_t {
-    ALL       = 0b11,
-    QUICKSORT = 0b01,
-    NOOP      = 0b10,
+    ALL       = 0b111,
+    QUICKSORT = 0b001,
+    NOOP      = 0b010,
+    RADIX     = 0b100,
 };
 
 enum class JoinImplementation : uint64_t {
-    ALL          = 0b111,
-    NESTED_LOOPS = 0b001,
-    SIMPLE_HASH  = 0b010,
-    SORT_MERGE   = 0b100,
+    ALL                = 0b11111111,
+    NESTED_LOOPS       = 0b00000001,
+    SIMPLE_HASH        = 0b00000010,
+    SORT_MERGE         = 0b00000100,
+    RADIX_PARTITIONED  = 0b00001000,
+    INDEX_NESTED_LOOPS = 0b00010000,
+    DIRECT_ADDRESS     = 0b00100000,
+    BAND               = 0b01000000,
+    PARTITION_WISE     = 0b10000000,
 };
 
 enum class IndexImplementation : uint64_t {
@@ -59,6 +73,7 @@ enum class SoftPipelineBreakerStrategy : uint64_t {
     AFTER_NESTED_LOOPS_JOIN     = 0b0010000,
     AFTER_SIMPLE_HASH_JOIN      = 0b0100000,
     AFTER_HASH_BASED_GROUP_JOIN = 0b1000000,
+    ADAPTIVE                    = 0b10000000, ///< after filters depending on their estimated selectivity
     NONE                        = 0b0000000,
 };
 
@@ -86,9 +101,10 @@ enum class SelectionStrategy : uint64_t {
 };
 
 enum class HashTableImplementation : uint64_t {
-    ALL             = 0b11,
-    OPEN_ADDRESSING = 0b01,
-    CHAINED         = 0b10,
+    ALL             = 0b111,
+    OPEN_ADDRESSING = 0b001,
+    CHAINED         = 0b010,
+    SWISS           = 0b100,
 };
 
 enum class ProbingStrategy : uint64_t {
@@ -109,6 +125,12 @@ enum class OrderingStrategy : uint64_t {
     BUILD_ON_RIGHT = 0b10,
 };
 
+enum class BloomFilterStrategy : uint64_t {
+    AUTO   = 0b11,
+    ALWAYS = 0b01,
+    NEVER  = 0b10,
+};
+
 }
 
 namespace options {
@@ -140,7 +162,12 @@ inline option_configs::IndexScanCompilationStrategy index_scan_compilation_strat
 inline option_configs::IndexScanMaterializationStrategy index_scan_materialization_strategy =
     option_configs::IndexScanMaterializationStrategy::MEMORY;
 
-/** Which selection strategy should be used for `wasm::Filter`. */
+/** Whether `wasm::IndexScan` may answer scans that require no attribute besides the indexed one from the index entries
+ * alone, i.e. without accessing the store. */
+inline bool index_only_scan = true;
+
+/** Which selection strategy should be used for `wasm::Filter`.  `AUTO` additionally considers `wasm::AdaptiveFilter`,
+ * which chooses the strategy at runtime. */
 inline option_configs::SelectionStrategy filter_selection_strategy = option_configs::SelectionStrategy::AUTO;
 
 /** Which selection strategy should be used for comparisons in `wasm::Quicksort`. */
@@ -155,6 +182,24 @@ inline option_configs::SelectionStrategy simple_hash_join_selection_strategy = o
 /** Which ordering strategy should be used for `wasm::SimpleHashJoin`. */
 inline option_configs::OrderingStrategy simple_hash_join_ordering_strategy = option_configs::OrderingStrategy::AUTO;
 
+/** The number of probe tuples of `wasm::SimpleHashJoin` whose buckets are computed and accessed as a batch before the
+ * tuples are actually probed s.t. the cache misses of the batch overlap.  0 means that each tuple is probed
+ * immediately.  A whole multiple of 32 additionally allows a SIMDfied probe child whose keys are hashed lane-wise. */
+inline std::size_t simple_hash_join_probe_window_size = 0;
+
+/** Whether `wasm::SimpleHashJoin` should build a Bloom filter on the build keys to drop probe tuples without join
+ * partner before the hash table is accessed. */
+inline option_configs::BloomFilterStrategy simple_hash_join_bloom_filter_strategy =
+    option_configs::BloomFilterStrategy::AUTO;
+
+/** Whether `wasm::SimpleHashJoin` should track the range of its single integral build key to drop probe tuples whose
+ * key lies outside of this range before the hash table is accessed. */
+inline bool simple_hash_join_key_range_filter = true;
+
+/** The number of outer tuples of `wasm::IndexNestedLoopsJoin` whose keys are looked up in the index by a single host
+ * call before the tuples are actually joined s.t. the cost of the call is amortized over the window. */
+inline std::size_t index_nested_loops_join_probe_window_size = 64;
+
 /** Which selection strategy should be used for `wasm::SortMergeJoin`. */
 inline option_configs::SelectionStrategy sort_merge_join_selection_strategy = option_configs::SelectionStrategy::AUTO;
 
@@ -162,15 +207,35 @@ inline option_configs::SelectionStrategy sort_merge_join_selection_strategy = op
 inline option_configs::SelectionStrategy sort_merge_join_cmp_selection_strategy =
     option_configs::SelectionStrategy::AUTO;
 
+/** The number of consecutive steps by which `wasm::SortMergeJoin` advances the same child before it skips the tuples
+ * of this child whose key is smaller than the current key of the other child by exponential search.  0 means that the
+ * children are never skipped. */
+inline std::size_t sort_merge_join_gallop_threshold = 8;
+
+/** The targeted size in bytes of a single build side partition of `wasm::RadixPartitionedHashJoin`, e.g. the size of
+ * the L2 cache. */
+inline std::size_t radix_partitioned_hash_join_partition_size = 256 * 1024;
+
+/** The factor by which the materialized build child of `wasm::RadixPartitionedHashJoin` must be larger than its
+ * materialized probe child to reverse their roles at runtime, e.g. if the cardinality of the build child was
+ * underestimated.  0 means that roles are never reversed. */
+inline double radix_partitioned_hash_join_role_reversal_factor = 4.0;
+
+/** The maximal ratio of the number of values of the key domain of `wasm::DirectAddressJoin` to the estimated number
+ * of build tuples, i.e. the maximal share of gaps in the array of build tuples. */
+inline double direct_address_join_max_domain_factor = 4.0;
+
 /** Which implementation should be used for `wasm::HashTable`s. */
 inline option_configs::HashTableImplementation hash_table_implementation = option_configs::HashTableImplementation::ALL;
 
 /** Which probing strategy should be used for `wasm::OpenAddressingHashTable`s.  Does not have any effect if
- * `wasm::ChainedHashTable`s are used. */
+ * `wasm::ChainedHashTable`s are used.  If `AUTO`, the strategy is chosen per hash table from its maximal load factor
+ * and the size of its slots. */
 inline option_configs::ProbingStrategy hash_table_probing_strategy = option_configs::ProbingStrategy::AUTO;
 
 /** Which storing strategy should be used for `wasm::OpenAddressingHashTable`s.  Does not have any effect if
- * `wasm::ChainedHashTable`s are used. */
+ * `wasm::ChainedHashTable`s are used.  If `AUTO`, the strategy is chosen per hash table from the sizes of its keys
+ * and values. */
 inline option_configs::StoringStrategy hash_table_storing_strategy = option_configs::StoringStrategy::AUTO;
 
 /** Which maximal load factor should be used for `wasm::OpenAddressingHashTable`s.  Does not have any effect if
@@ -184,9 +249,31 @@ inline double load_factor_chained = 1.5;
 /** Which initial capacity should be used for `wasm::HashTable`s. */
 inline std::optional<uint32_t> hash_table_initial_capacity;
 
+/** The factor by which estimated cardinalities are enlarged when sizing `wasm::HashTable`s to make rehashing unlikely
+ * in case of underestimation.  Does not have any effect if `hash_table_initial_capacity` is set. */
+inline double hash_table_capacity_margin = 1.2;
+
+/** The maximal initial capacity of `wasm::HashTable`s sized by estimated cardinalities to bound the memory wasted in
+ * case of overestimation.  Does not have any effect if `hash_table_initial_capacity` is set. */
+inline uint32_t hash_table_max_estimated_capacity = 1U << 24;
+
+/** The maximal number of values of the key domain of `wasm::ArrayGrouping`, i.e. the maximal number of slots it
+ * allocates regardless of the actual number of groups. */
+inline uint32_t array_grouping_max_domain_size = 1U << 16;
+
+/** The targeted size in bytes of the groups of a single partition of `wasm::RadixPartitionedGrouping`, e.g. the size
+ * of the L2 cache. */
+inline std::size_t radix_partitioned_grouping_partition_size = 256 * 1024;
+
 /** Whether to use `wasm::HashBasedGroupJoin` if possible. */
 inline bool hash_based_group_join = true;
 
+/** Whether to use `wasm::HashSemiJoin` if possible. */
+inline bool hash_semi_join = true;
+
+/** Whether to use `wasm::TopK` if possible. */
+inline bool top_k = true;
+
 /** Which layout factory should be used for hard pipeline breakers. */
 inline std::unique_ptr<const m::storage::DataLayoutFactory> hard_pipeline_breaker_layout =
     std::make_unique<storage::RowLayoutFactory>();
@@ -202,13 +289,63 @@ inline std::unique_ptr<const m::storage::DataLayoutFactory> soft_pipeline_breake
 /** Which size in tuples should be used for soft pipeline breakers. */
 inline std::size_t soft_pipeline_breaker_num_tuples = 0;
 
+/** The maximal estimated selectivity of a SIMDfiable filter after which an adaptive soft pipeline breaker is
+ * inserted. */
+inline double soft_pipeline_breaker_max_selectivity = 0.25;
+
 /** The number of results from index sequential scan to be communicated between host and v8 per batch.  0 means that
  * all results are communicated in a single batch. */
 inline std::size_t index_sequential_scan_batch_size = 1;
 
+/** Whether the number of results communicated between host and v8 per batch during index sequential scan grows
+ * geometrically, starting at `index_sequential_scan_batch_size`. */
+inline bool index_sequential_scan_adaptive_batch_size = true;
+
+/** The maximal number of results from index sequential scan communicated between host and v8 per batch if batch sizes
+ * are adaptive.  0 means that batches may grow up to all results. */
+inline std::size_t index_sequential_scan_max_batch_size = 64 * 1024;
+
+/** The number of rows per morsel claimed by a `wasm::Scan` from its shared work queue.  0 means that scans are not
+ * split into morsels. */
+inline std::size_t scan_morsel_size = 0;
+
+/** The number of rows whose selection vector is computed at once by a `wasm::SelectionVectorScan`. */
+inline std::size_t selection_vector_size = 1024;
+
+/** Whether each morsel of a `wasm::Scan` is processed by a call of a function of its own rather than within the loop
+ * claiming the morsels.  Thereby, the engine may switch to optimized code of the pipeline between morsels, e.g. by
+ * dynamic tier-up from baseline code, while the first morsels are already processed. */
+inline bool scan_morsel_functions = false;
+
 /** Which window size should be used for the result set. */
 inline std::size_t result_set_window_size = 0;
 
+/** The callback receiving the results of `CallbackOperator`s as Arrow record batches.  If set, the result set of a
+ * `wasm::Callback` is written in a columnar layout and exported without copying, see
+ * `m::wasm::export_result_set_to_arrow()`, instead of passing each result tuple to the operator's callback. */
+inline m::wasm::arrow_callback_t arrow_result_set_callback;
+
+/** The number of tuples per Arrow record batch if `arrow_result_set_callback` is set and the result set is
+ * materialized entirely, i.e. without a window. */
+inline std::size_t arrow_batch_size = 64 * 1024;
+
+/** The callback receiving the results of `CallbackOperator`s as `ResultColumns`, one batch at a time.  If set, and
+ * `arrow_result_set_callback` is not, the result set of a `wasm::Callback` is decoded column-at-a-time and passed to
+ * this callback instead of passing each result tuple to the operator's callback. */
+inline m::result_batch_callback_t result_set_batch_callback;
+
+/** The maximal number of tuples per batch when decoding the result set column-at-a-time, i.e. when printing results
+ * or passing them to `result_set_batch_callback`. */
+inline std::size_t result_set_batch_size = 64 * 1024;
+
+/** Whether the Linux kernel is advised to back the mappings of tables and of the heap into the Wasm memory by
+ * transparent huge pages, reducing TLB misses when scanning large tables. */
+inline bool wasm_huge_pages = false;
+
+/** The number of bytes at the beginning of each mapping of a table and of the heap into the Wasm memory to prefault
+ * before execution, avoiding page faults during execution.  0 disables prefaulting. */
+inline std::size_t wasm_prefault_size = 0;
+
 /** Whether to exploit uniqueness of build key in hash joins. */
 inline bool exploit_unique_build = true;
 
@@ -218,9 +355,19 @@ inline bool simd = true;
 /** Whether to use double pumping if SIMDfication is enabled. */
 inline bool double_pumping = true;
 
+/** Whether to count the tuples produced by each physical operator during execution and print them next to the
+ * estimated cardinalities of the physical plan afterwards, i.e. whether to *explain analyze* queries. */
+inline bool explain_analyze = false;
+
 /** Which number of SIMD lanes to prefer. */
 inline std::size_t simd_lanes = 1;
 
+/** The number of independent SIMD vectors accumulating each aggregate of an ungrouped aggregation.  The aggregation
+ * prefers this many vectors' worth of SIMD lanes, such that the additions into the lanes of different vectors do not
+ * depend on each other and their latencies overlap.  The lanes are reduced horizontally once after the child pipeline
+ * finished. */
+inline std::size_t aggregation_accumulators = 2;
+
 /** Which attributes are assumed to be sorted.  For each entry, the first element is the name of the attribute and the
  * second one is `true` iff the attribute is sorted ascending and vice versa. */
 inline std::vector<std::pair<m::Schema::Identifier, bool>> sorted_attributes;
@@ -233,14 +380,27 @@ namespace m {
 
 #define M_WASM_OPERATOR_LIST_NON_TEMPLATED(X) \
     X(NoOp) \
+    X(LateMaterializingScan) \
+    X(ZoneMapScan) \
+    X(SelectionVectorScan) \
     X(LazyDisjunctiveFilter) \
+    X(AdaptiveFilter) \
     X(Projection) \
     X(HashBasedGrouping) \
     X(OrderedGrouping) \
+    X(ArrayGrouping) \
+    X(RadixPartitionedGrouping) \
     X(Aggregation) \
     X(NoOpSorting) \
+    X(RadixSort) \
+    X(RadixPartitionedHashJoin) \
+    X(PartitionWiseHashJoin) \
+    X(DirectAddressJoin) \
+    X(BandJoin) \
     X(Limit) \
-    X(HashBasedGroupJoin)
+    X(TopK) \
+    X(HashBasedGroupJoin) \
+    X(HashSemiJoin)
 #define M_WASM_OPERATOR_LIST_TEMPLATED(X) \
     X(Callback<false>) \
     X(Callback<true>) \
@@ -256,6 +416,8 @@ namespace m {
     X(Quicksort<true>) \
     X(NestedLoopsJoin<false>) \
     X(NestedLoopsJoin<true>) \
+    X(IndexNestedLoopsJoin<m::idx::IndexMethod::Array>) \
+    X(IndexNestedLoopsJoin<m::idx::IndexMethod::Rmi>) \
     X(SimpleHashJoin<M_COMMA(false) false>) \
     X(SimpleHashJoin<M_COMMA(false) true>) \
     X(SimpleHashJoin<M_COMMA(true) false>) \
@@ -298,6 +460,8 @@ namespace m {
     X(m::Match<m::wasm::Quicksort<true>>) \
     X(m::Match<m::wasm::NestedLoopsJoin<false>>) \
     X(m::Match<m::wasm::NestedLoopsJoin<true>>) \
+    X(m::Match<m::wasm::IndexNestedLoopsJoin<m::idx::IndexMethod::Array>>) \
+    X(m::Match<m::wasm::IndexNestedLoopsJoin<m::idx::IndexMethod::Rmi>>) \
     X(m::Match<m::wasm::SimpleHashJoin<M_COMMA(false) false>>) \
     X(m::Match<m::wasm::SimpleHashJoin<M_COMMA(false) true>>) \
     X(m::Match<m::wasm::SimpleHashJoin<M_COMMA(true) false>>) \
@@ -350,6 +514,9 @@ template<bool CmpPredicated> struct Match<wasm::Quicksort<CmpPredicated>>;
 namespace wasm { template<bool Predicated> struct NestedLoopsJoin; }
 template<bool Predicated> struct Match<wasm::NestedLoopsJoin<Predicated>>;
 
+namespace wasm { template<idx::IndexMethod IndexMethod> struct IndexNestedLoopsJoin; }
+template<idx::IndexMethod IndexMethod> struct Match<wasm::IndexNestedLoopsJoin<IndexMethod>>;
+
 namespace wasm { template<bool UniqueBuild, bool Predicated> struct SimpleHashJoin; }
 template<bool UniqueBuild, bool Predicated> struct Match<wasm::SimpleHashJoin<UniqueBuild, Predicated>>;
 
@@ -388,7 +555,7 @@ template<bool SIMDfied>
 struct Scan : PhysicalOperator<Scan<SIMDfied>, ScanOperator>
 {
     static void execute(const Match<Scan> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
-    static double cost(const Match<Scan>&) { return M_CONSTEXPR_COND(SIMDfied, 1.0, 2.0); }
+    static double cost(const Match<Scan>&);
     static ConditionSet pre_condition(std::size_t child_idx,
                                       const std::tuple<const ScanOperator*> &partial_inner_nodes);
     static ConditionSet post_condition(const Match<Scan> &M);
@@ -404,6 +571,46 @@ struct IndexScan : PhysicalOperator<IndexScan<IndexMethod>, pattern_t<FilterOper
     static ConditionSet post_condition(const Match<IndexScan> &M);
 };
 
+/** Scans a table and filters it by loading only the attributes required by the filter condition sequentially.  The
+ * remaining attributes are loaded via point accesses for qualifying tuples only.  Hence, beneficial for wide tables
+ * and selective filters. */
+struct LateMaterializingScan : PhysicalOperator<LateMaterializingScan, pattern_t<FilterOperator, ScanOperator>>
+{
+    static void execute(const Match<LateMaterializingScan> &M, setup_t setup, pipeline_t pipeline,
+                        teardown_t teardown);
+    static double cost(const Match<LateMaterializingScan> &M);
+    static ConditionSet pre_condition(std::size_t child_idx,
+                                      const std::tuple<const FilterOperator*, const ScanOperator*> &partial_inner_nodes);
+    static ConditionSet post_condition(const Match<LateMaterializingScan> &M);
+};
+
+/** Scans a table stored in a `PaxStore` and filters it by skipping all PAX blocks whose zone maps, i.e. their
+ * per-block synopses, prove that no tuple of the block satisfies the filter condition.  Likewise, skips the partitions
+ * of a partitioned table pruned by the filter condition, see `Partitionings`. */
+struct ZoneMapScan : PhysicalOperator<ZoneMapScan, pattern_t<FilterOperator, ScanOperator>>
+{
+    static void execute(const Match<ZoneMapScan> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
+    static double cost(const Match<ZoneMapScan> &M);
+    static ConditionSet pre_condition(std::size_t child_idx,
+                                      const std::tuple<const FilterOperator*, const ScanOperator*> &partial_inner_nodes);
+    static ConditionSet post_condition(const Match<ZoneMapScan> &M);
+};
+
+/** Scans a table and filters it clause by clause on vectors of consecutive rows.  Each clause of the filter condition
+ * is evaluated on the rows of the vector that satisfied all previous clauses only, given by a *selection vector* of
+ * their tuple IDs, which is compacted without branching.  Only the attributes required by a clause are loaded to
+ * evaluate it, and the remaining attributes are loaded for qualifying tuples only.  The clauses are reordered at
+ * runtime by their observed selectivities such that the most selective clauses are evaluated first.  Hence,
+ * beneficial for filters of multiple selective clauses. */
+struct SelectionVectorScan : PhysicalOperator<SelectionVectorScan, pattern_t<FilterOperator, ScanOperator>>
+{
+    static void execute(const Match<SelectionVectorScan> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
+    static double cost(const Match<SelectionVectorScan> &M);
+    static ConditionSet pre_condition(std::size_t child_idx,
+                                      const std::tuple<const FilterOperator*, const ScanOperator*> &partial_inner_nodes);
+    static ConditionSet post_condition(const Match<SelectionVectorScan> &M);
+};
+
 template<bool Predicated>
 struct Filter : PhysicalOperator<Filter<Predicated>, FilterOperator>
 {
@@ -422,6 +629,21 @@ struct LazyDisjunctiveFilter : PhysicalOperator<LazyDisjunctiveFilter, Disjuncti
                                       const std::tuple<const FilterOperator*> &partial_inner_nodes);
 };
 
+/** A filter which chooses between branching and predication at runtime.  It evaluates the filter condition of the
+ * first `SAMPLE_SIZE` tuples with branching and counts how many tuples pass.  Afterwards, it uses predication if the
+ * observed selectivity is close to 50%, where branches are mispredicted most often, and branching otherwise.  The code
+ * of the remaining pipeline is emitted for both strategies. */
+struct AdaptiveFilter : PhysicalOperator<AdaptiveFilter, FilterOperator>
+{
+    ///> the number of tuples whose selectivity is measured before deciding the selection strategy
+    static constexpr uint32_t SAMPLE_SIZE = 1024;
+
+    static void execute(const Match<AdaptiveFilter> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
+    static double cost(const Match<AdaptiveFilter>&);
+    static ConditionSet pre_condition(std::size_t child_idx,
+                                      const std::tuple<const FilterOperator*> &partial_inner_nodes);
+};
+
 struct Projection : PhysicalOperator<Projection, ProjectionOperator>
 {
     static void execute(const Match<Projection> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
@@ -431,9 +653,15 @@ struct Projection : PhysicalOperator<Projection, ProjectionOperator>
     static ConditionSet adapt_post_condition(const Match<Projection> &M, const ConditionSet &post_cond_child);
 };
 
+/** The domain of a single integral key, i.e. its minimum and its number of values. */
+using key_domain_t = std::pair<int64_t, uint64_t>;
+
 struct HashBasedGrouping : PhysicalOperator<HashBasedGrouping, GroupingOperator>
 {
-    static void execute(const Match<HashBasedGrouping> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
+    /** Performs the grouping.  If \p key_domain is given, keys are mapped directly to the slots of the hash table
+     * instead of being hashed, see `wasm::ArrayGrouping`. */
+    static void execute(const Match<HashBasedGrouping> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown,
+                        std::optional<key_domain_t> key_domain = std::nullopt);
     static double cost(const Match<HashBasedGrouping>&);
     static ConditionSet pre_condition(std::size_t child_idx,
                                       const std::tuple<const GroupingOperator*> &partial_inner_nodes);
@@ -475,6 +703,40 @@ struct OrderedGrouping : PhysicalOperator<OrderedGrouping, GroupingOperator>
     static ConditionSet adapt_post_condition(const Match<OrderedGrouping> &M, const ConditionSet &post_cond_child);
 };
 
+/** Groups by a single integral key of a small domain, e.g. a flag, a status code, or a date, whose minimum and maximum
+ * are known from zone maps or column statistics.  Each key is mapped to the slot `key - min` of an array of aggregates
+ * rather than being hashed and probed for.  The array is an open addressing hash table that maps keys directly to
+ * its slots and is large enough to hold the entire domain without collisions, see `HashTable::set_direct_mapping()`.
+ * Hence, keys outside of the known domain, e.g. inserted after the statistics were computed, are still grouped
+ * correctly, only by probing. */
+struct ArrayGrouping : PhysicalOperator<ArrayGrouping, GroupingOperator>
+{
+    /** Returns the domain of the single grouping key of \p grouping iff it is an integral attribute whose minimum and
+     * maximum are known and whose domain has at most `options::array_grouping_max_domain_size` values. */
+    static std::optional<key_domain_t> find_key_domain(const GroupingOperator &grouping);
+
+    static void execute(const Match<ArrayGrouping> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
+    static double cost(const Match<ArrayGrouping>&);
+    static ConditionSet pre_condition(std::size_t child_idx,
+                                      const std::tuple<const GroupingOperator*> &partial_inner_nodes);
+    static ConditionSet post_condition(const Match<ArrayGrouping> &M);
+};
+
+/** Groups a large number of groups, i.e. more than fit into the cache, by first materializing its child and
+ * partitioning the tuples in-place by the hash of their grouping key s.t. the groups of each partition are expected
+ * to fit into `options::radix_partitioned_grouping_partition_size` bytes.  Then, each partition is grouped in a hash
+ * table which is reused for all partitions and hence stays resident in the cache.  The groups are emitted partition
+ * by partition. */
+struct RadixPartitionedGrouping : PhysicalOperator<RadixPartitionedGrouping, GroupingOperator>
+{
+    static void execute(const Match<RadixPartitionedGrouping> &M, setup_t setup, pipeline_t pipeline,
+                        teardown_t teardown);
+    static double cost(const Match<RadixPartitionedGrouping> &M);
+    static ConditionSet pre_condition(std::size_t child_idx,
+                                      const std::tuple<const GroupingOperator*> &partial_inner_nodes);
+    static ConditionSet post_condition(const Match<RadixPartitionedGrouping> &M);
+};
+
 struct Aggregation : PhysicalOperator<Aggregation, AggregationOperator>
 {
     private:
@@ -509,6 +771,18 @@ struct Quicksort : PhysicalOperator<Quicksort<CmpPredicated>, SortingOperator>
     static ConditionSet post_condition(const Match<Quicksort> &M);
 };
 
+/** Sorts the materialized child using an in-place MSD radix sort on a single 64-bit key derived from all order
+ * expressions.  Hence, only applicable if all order expressions are of fixed-width integral, date, or boolean type and
+ * fit into 64 bits including one NULL bit each. */
+struct RadixSort : PhysicalOperator<RadixSort, SortingOperator>
+{
+    static void execute(const Match<RadixSort> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
+    static double cost(const Match<RadixSort>&) { return 0.9; }
+    static ConditionSet pre_condition(std::size_t child_idx,
+                                      const std::tuple<const SortingOperator*> &partial_inner_nodes);
+    static ConditionSet post_condition(const Match<RadixSort> &M);
+};
+
 struct NoOpSorting : PhysicalOperator<NoOpSorting, SortingOperator>
 {
     static void execute(const Match<NoOpSorting> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
@@ -528,6 +802,23 @@ struct NestedLoopsJoin : PhysicalOperator<NestedLoopsJoin<Predicated>, JoinOpera
                           std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children);
 };
 
+/** Joins a scanned table, i.e. the left child of the join, with its outer child, i.e. the right child, by looking up
+ * the join key of each outer tuple in an index on the join attribute of the table and loading the matching tuples via
+ * point accesses.  Hence, beneficial if the outer child is small compared to the indexed table.  The lookups of a
+ * window of outer tuples are batched into a single host call. */
+template<idx::IndexMethod IndexMethod>
+struct IndexNestedLoopsJoin
+    : PhysicalOperator<IndexNestedLoopsJoin<IndexMethod>, pattern_t<JoinOperator, ScanOperator, Wildcard>>
+{
+    static void execute(const Match<IndexNestedLoopsJoin> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
+    static double cost(const Match<IndexNestedLoopsJoin> &M);
+    static ConditionSet
+    pre_condition(std::size_t child_idx,
+                  const std::tuple<const JoinOperator*, const ScanOperator*, const Wildcard*> &partial_inner_nodes);
+    static ConditionSet adapt_post_condition(const Match<IndexNestedLoopsJoin> &M,
+                                             const ConditionSet &post_cond_child);
+};
+
 template<bool UniqueBuild, bool Predicated>
 struct SimpleHashJoin
     : PhysicalOperator<SimpleHashJoin<UniqueBuild, Predicated>, pattern_t<JoinOperator, Wildcard, Wildcard>>
@@ -557,6 +848,94 @@ struct SortMergeJoin
                           std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children);
 };
 
+struct RadixPartitionedHashJoin
+    : PhysicalOperator<RadixPartitionedHashJoin, pattern_t<JoinOperator, Wildcard, Wildcard>>
+{
+    static void execute(const Match<RadixPartitionedHashJoin> &M, setup_t setup, pipeline_t pipeline,
+                        teardown_t teardown);
+    static double cost(const Match<RadixPartitionedHashJoin> &M);
+    static ConditionSet
+    pre_condition(std::size_t child_idx,
+                  const std::tuple<const JoinOperator*, const Wildcard*, const Wildcard*> &partial_inner_nodes);
+    static ConditionSet
+    adapt_post_conditions(const Match<RadixPartitionedHashJoin> &M,
+                          std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children);
+};
+
+/** Joins two tables that are partitioned by the same scheme on their join keys, see `Partitionings`, partition by
+ * partition.  Since the rows of each partition are clustered, no tuples are materialized or partitioned at query
+ * time.  For each partition, a small hash table is built on the partition of the build table and probed with the
+ * respective partition of the probe table.  Both children must be scans of the tables, optionally filtered, whose
+ * filter conditions are evaluated while iterating the partitions.  Partitions pruned by the filter condition of either
+ * child are skipped entirely. */
+struct PartitionWiseHashJoin
+    : PhysicalOperator<PartitionWiseHashJoin, pattern_t<JoinOperator, Wildcard, Wildcard>>
+{
+    static void execute(const Match<PartitionWiseHashJoin> &M, setup_t setup, pipeline_t pipeline,
+                        teardown_t teardown);
+    static double cost(const Match<PartitionWiseHashJoin> &M);
+    static ConditionSet
+    pre_condition(std::size_t child_idx,
+                  const std::tuple<const JoinOperator*, const Wildcard*, const Wildcard*> &partial_inner_nodes);
+    static ConditionSet
+    adapt_post_conditions(const Match<PartitionWiseHashJoin> &M,
+                          std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children);
+};
+
+/** Joins on a single integral key which is unique and dense on the build side, e.g. a surrogate primary key.  The build
+ * tuples are stored in an array indexed by `key - min` over the key domain known from zone maps or column statistics,
+ * i.e. in an open addressing hash table mapping keys directly to its slots, see `HashTable::set_direct_mapping()`.  The
+ * occupancy of the slots tells the gaps of the domain.  Hence, probing is a single lookup without collisions.  Probe
+ * keys outside of the domain do not access the array at all unless build keys outside of it were inserted, e.g. since
+ * the column statistics are outdated. */
+struct DirectAddressJoin : PhysicalOperator<DirectAddressJoin, pattern_t<JoinOperator, Wildcard, Wildcard>>
+{
+    /** Returns the domain of the single build key of \p join with build child \p build iff it is a unique, integral
+     * attribute whose minimum and maximum are known and whose domain has at most
+     * `options::direct_address_join_max_domain_factor` times as many values as \p build is estimated to produce. */
+    static std::optional<key_domain_t> find_key_domain(const JoinOperator &join, const Wildcard &build);
+
+    static void execute(const Match<DirectAddressJoin> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
+    static double cost(const Match<DirectAddressJoin> &M);
+    static ConditionSet
+    pre_condition(std::size_t child_idx,
+                  const std::tuple<const JoinOperator*, const Wildcard*, const Wildcard*> &partial_inner_nodes);
+    static ConditionSet
+    adapt_post_conditions(const Match<DirectAddressJoin> &M,
+                          std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children);
+};
+
+/** Joins on a range predicate, e.g. `A.ts BETWEEN B.start AND B.end`, i.e. on comparisons of a single attribute of the
+ * build child with attributes of the probe child.  The build child is materialized and sorted on this attribute.  For
+ * each probe tuple, the range of build tuples within its bounds is found by binary search and only this range is
+ * checked against the join predicate.  Hence, the cost is in O((n + m) log n) plus the size of the result instead of
+ * the O(n * m) of a nested-loops join. */
+struct BandJoin : PhysicalOperator<BandJoin, pattern_t<JoinOperator, Wildcard, Wildcard>>
+{
+    /** The bounds of a band join, i.e. the build key and the comparisons bounding it from below and from above. */
+    struct band_t
+    {
+        const ast::Designator *key; ///< the attribute of the build child the build tuples are sorted on
+        ///> the comparison that holds from the first build tuple within the band on, if any
+        const ast::BinaryExpr *lower = nullptr;
+        ///> the comparison that holds up to the last build tuple within the band, if any
+        const ast::BinaryExpr *upper = nullptr;
+    };
+
+    /** Returns the bounds of \p join with build child \p build iff its predicate compares a single non-nullable
+     * attribute of \p build with attributes of the probe child. */
+    static std::optional<band_t> find_band(const JoinOperator &join, const Wildcard &build);
+
+    static void execute(const Match<BandJoin> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
+    static double cost(const Match<BandJoin> &M);
+    static ConditionSet
+    pre_condition(std::size_t child_idx,
+                  const std::tuple<const JoinOperator*, const Wildcard*, const Wildcard*> &partial_inner_nodes);
+    static ConditionSet
+    adapt_post_conditions(const Match<BandJoin> &M,
+                          std::vector<std::reference_wrapper<const ConditionSet>> &&post_cond_children);
+};
+
 struct Limit : PhysicalOperator<Limit, LimitOperator>
 {
     static void execute(const Match<Limit> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
@@ -565,6 +944,23 @@ struct Limit : PhysicalOperator<Limit, LimitOperator>
                                       const std::tuple<const LimitOperator*> &partial_inner_nodes);
 };
 
+/** Computes the first `offset + limit` tuples of the sorted child by maintaining a bounded max-heap of these tuples
+ * while consuming the child, i.e. without materializing and sorting the entire child. */
+struct TopK : PhysicalOperator<TopK, pattern_t<LimitOperator, pattern_t<SortingOperator, Wildcard>>>
+{
+    static void execute(const Match<TopK> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
+    static double cost(const Match<TopK>&) { return 1.0; }
+    static ConditionSet
+    pre_condition(std::size_t child_idx,
+                  const std::tuple<const LimitOperator*, const SortingOperator*, const Wildcard*>
+                      &partial_inner_nodes);
+    static ConditionSet post_condition(const Match<TopK> &M);
+};
+
+/** Computes a grouping of an equi-join in a single hash table keyed by the join key, i.e. an eager aggregation of both
+ * children of the join.  Applicable iff each join key is a grouping key, either by its build or by its probe part, and
+ * all other grouping keys are attributes of the build child functionally dependent on the join key, i.e. the join key
+ * is unique, as for the dimension table of a star schema.  Aggregates may take their argument from either child. */
 struct HashBasedGroupJoin
     : PhysicalOperator<HashBasedGroupJoin, pattern_t<GroupingOperator, pattern_t<JoinOperator, Wildcard, Wildcard>>>
 {
@@ -577,11 +973,39 @@ struct HashBasedGroupJoin
     static ConditionSet post_condition(const Match<HashBasedGroupJoin> &M);
 };
 
+/** Computes a semi-join of the probe child with the distinct keys of the build child, i.e. a join whose build child is a
+ * grouping without aggregates on exactly the join keys, as obtained from unnesting `IN` and `EXISTS` subqueries.
+ * Instead of grouping the build child in a hash table and then building a second hash table on the groups, the keys of
+ * the build child are inserted into a single hash table, once per distinct key and without payload.  Each probe tuple
+ * is then emitted iff its key is found, i.e. probing stops at the first match. */
+struct HashSemiJoin
+    : PhysicalOperator<HashSemiJoin, pattern_t<JoinOperator, pattern_t<GroupingOperator, Wildcard>, Wildcard>>
+{
+    static void execute(const Match<HashSemiJoin> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
+    static double cost(const Match<HashSemiJoin>&);
+    static ConditionSet
+    pre_condition(std::size_t child_idx,
+                  const std::tuple<const JoinOperator*, const GroupingOperator*, const Wildcard*, const Wildcard*>
+                      &partial_inner_nodes);
+    static ConditionSet post_condition(const Match<HashSemiJoin> &M);
+};
+
 }
 
 /** Registers physical Wasm operators in \p phys_opt depending on the set CLI options. */
 void register_wasm_operators(PhysicalOptimizer &phys_opt);
 
+namespace wasm {
+
+/** Returns `true` iff an adaptive soft pipeline breaker should be inserted after the SIMDfiable filter \p filter
+ * with child \p child, i.e. iff `SoftPipelineBreakerStrategy::ADAPTIVE` is enabled, the pipeline is SIMDfied, and
+ * the estimated selectivity of the filter is at most `--soft-pipeline-breaker-max-selectivity`.  Compacting the few
+ * qualifying tuples into a buffer makes the vectors of the remaining pipeline dense, whereas after a non-selective
+ * filter the buffer only causes additional memory traffic. */
+bool is_adaptive_soft_pipeline_breaker_beneficial(const Operator &filter, const Operator &child);
+
+}
+
 template<typename T>
 void execute_buffered(const Match<T> &M, const Schema &schema,
                       const std::unique_ptr<const storage::DataLayoutFactory> &buffer_factory,
@@ -613,8 +1037,20 @@ namespace wasm {
 /** An abstract `MatchBase` for the `WasmV8` backend.  Adds accept methods for respective visitor.  */
 struct MatchBase : m::MatchBase
 {
+    /** Since the physical optimizer creates a match for every candidate implementation, matches are allocated from a
+     * pool rather than by `malloc()`. */
+    static void * operator new(std::size_t size) { return pool().allocate(size); }
+    static void operator delete(void *ptr, std::size_t size) { pool().deallocate(ptr, size); }
+
     virtual void accept(MatchBaseVisitor &v) = 0;
     virtual void accept(ConstMatchBaseVisitor &v) const = 0;
+
+    private:
+    /** Returns the pool of all matches.  It is never destroyed since matches may outlive static objects. */
+    static ObjectPool & pool() {
+        static ObjectPool *the_pool = new ObjectPool();
+        return *the_pool;
+    }
 };
 
 /** Intermediate match type for leaves, i.e. physical operator matches without children. */
@@ -647,6 +1083,193 @@ struct MatchMultipleChildren : wasm::MatchBase
     }
 };
 
+/** The numbers of tuples produced by the physical operators of a plan, counted by the generated code if
+ * `--wasm-explain-analyze` is given.  During code generation, each operator gets a global counter which the code
+ * emitted by `count_tuples()` increments.  At the end of `main`, the counters are reported to the host by the imported
+ * function `report_tuple_count` such that `Match<T>::print()` can print them next to the estimated cardinalities. */
+struct OperatorTupleCounts
+{
+    private:
+    ///> the operators with counters in the order of their creation, i.e. by counter index
+    std::vector<const Operator*> operators_;
+    ///> the counters of the plan being compiled, by counter index
+    std::vector<std::unique_ptr<Global<U32x1>>> counters_;
+    ///> the reported numbers of tuples, by operator
+    std::unordered_map<const Operator*, uint32_t> counts_;
+
+    OperatorTupleCounts() = default;
+
+    public:
+    static OperatorTupleCounts & Get();
+
+    /** Returns the counter of \p op, creating it on first use. */
+    Global<U32x1> & counter(const Operator &op);
+
+    /** Emits code to report the values of all counters by calling the imported function `report_tuple_count` and
+     * disposes the counters afterwards.  Must be called at the end of `main`. */
+    void emit_report();
+
+    /** Records that \p num_tuples tuples were produced by the operator of the \p idx-th counter. */
+    void record(uint32_t idx, uint32_t num_tuples) {
+        M_insist(idx < operators_.size(), "invalid counter index");
+        counts_[operators_[idx]] = num_tuples;
+    }
+
+    /** Returns the reported number of tuples produced by \p op, or `std::nullopt` if there is none. */
+    std::optional<uint32_t> find(const Operator &op) const {
+        if (auto it = counts_.find(&op); it != counts_.end())
+            return it->second;
+        return std::nullopt;
+    }
+
+    /** Discards all counters and reported numbers of tuples, e.g. before compiling the next plan. */
+    void clear() { operators_.clear(); counters_.clear(); counts_.clear(); }
+};
+
+/** Returns \p pipeline preceded by code counting the tuples produced by \p op if `--wasm-explain-analyze` is given,
+ * and \p pipeline unchanged otherwise. */
+pipeline_t count_tuples(const Operator &op, pipeline_t pipeline);
+
+/** Returns \p pipeline preceded by adding the estimated cardinality of \p op to the estimated work of the function
+ * the pipeline is emitted into, see `CodeGenContext::estimated_work()`.  Returns \p pipeline unchanged if it is empty
+ * or \p op has no cardinality estimate. */
+pipeline_t record_estimated_work(const Operator &op, pipeline_t pipeline);
+
+/** The memory consumption of the physical operators of a plan if `--statistics` or `--wasm-explain-analyze` is given.
+ * While the code of an operator is generated, its memory requests, e.g. for hash tables, `GlobalBuffer`s, and sort
+ * buffers, are tagged with the operator by an `OperatorMemoryScope` such that `Module::Allocator()` accounts them per
+ * operator.  At the end of `main`, the allocated memory peak consumption of each operator is reported to the host by
+ * the imported function `report_memory_consumption` such that `Match<T>::print()` can print it. */
+struct OperatorMemoryConsumption
+{
+    /** The memory consumption of a single operator. */
+    struct consumption_t
+    {
+        uint32_t pre_allocated = 0; ///< the pre-allocated memory consumption in bytes
+        uint32_t allocated_peak = 0; ///< the allocated memory peak consumption in bytes
+    };
+
+    private:
+    ///> the operators that requested memory in the order of their first request, i.e. by report index
+    std::vector<const Operator*> operators_;
+    ///> the memory consumption, by operator
+    std::unordered_map<const Operator*, consumption_t> consumption_;
+
+    OperatorMemoryConsumption() = default;
+
+    public:
+    static OperatorMemoryConsumption & Get();
+
+    /** Returns `true` iff the memory consumption is accounted per operator, i.e. if `--statistics` or
+     * `--wasm-explain-analyze` is given. */
+    static bool enabled();
+
+    /** Emits code to report the allocated memory peak consumption of all operators by calling the imported function
+     * `report_memory_consumption` and records their pre-allocated memory consumption.  Must be called at the end of
+     * `main`. */
+    void emit_report();
+
+    /** Records that the operator of the \p idx-th report had an allocated memory peak consumption of \p bytes.  The
+     * reports of a module taken from the module cache are ignored since its operators are unknown. */
+    void record(uint32_t idx, uint32_t bytes) {
+        if (idx < operators_.size())
+            consumption_[operators_[idx]].allocated_peak = bytes;
+    }
+
+    /** Returns the memory consumption of \p op, or `std::nullopt` if \p op did not request memory. */
+    std::optional<consumption_t> find(const Operator &op) const {
+        if (auto it = consumption_.find(&op); it != consumption_.end())
+            return it->second;
+        return std::nullopt;
+    }
+
+    /** Discards the memory consumption of all operators, e.g. before compiling the next plan. */
+    void clear() { operators_.clear(); consumption_.clear(); }
+};
+
+/** Tags the memory requested by the code generated for an operator with this operator, see
+ * `OperatorMemoryConsumption`.  While the scope exists, requests are tagged with the operator.  The callbacks of the
+ * parent, passed to the constructor, are modified to tag their requests with the parent again, since they are invoked
+ * from within the code of the operator. */
+struct OperatorMemoryScope
+{
+    private:
+    bool enabled_;
+    const void *parent_tag_ = nullptr; ///< the tag of the parent, i.e. the tag when the scope was entered
+
+    public:
+    OperatorMemoryScope(const Operator &op, setup_t &setup, pipeline_t &pipeline, teardown_t &teardown);
+    OperatorMemoryScope(const OperatorMemoryScope&) = delete;
+    ~OperatorMemoryScope();
+};
+
+/** The selection strategies chosen at runtime by the `AdaptiveFilter`s of a plan.  Each filter keeps its sampling
+ * state in globals owned by this class.  If `--wasm-explain-analyze` is given, the states are reported to the host at
+ * the end of `main` by the imported function `report_selection_strategy` such that `Match<T>::print()` can print the
+ * decisions. */
+struct OperatorSelectionStrategies
+{
+    /** The strategy of an `AdaptiveFilter`. */
+    enum mode_t : uint32_t
+    {
+        M_Sampling, ///< the selectivity is still sampled, using branching
+        M_Branching,
+        M_Predicated,
+    };
+
+    /** The sampling state of a single `AdaptiveFilter`, *globally* kept across multiple invocations of its code. */
+    struct state_t
+    {
+        Global<U32x1> mode; ///< the current `mode_t`
+        Global<U32x1> num_sampled; ///< the number of sampled tuples
+        Global<U32x1> num_passed; ///< the number of sampled tuples which passed the filter
+    };
+
+    /** The decision of a single `AdaptiveFilter`. */
+    struct decision_t
+    {
+        mode_t mode;
+        uint32_t num_sampled;
+        uint32_t num_passed;
+    };
+
+    private:
+    ///> the operators with a state in the order of their creation, i.e. by report index
+    std::vector<const Operator*> operators_;
+    ///> the states of the plan being compiled, by report index
+    std::vector<std::unique_ptr<state_t>> states_;
+    ///> the reported decisions, by operator
+    std::unordered_map<const Operator*, decision_t> decisions_;
+
+    OperatorSelectionStrategies() = default;
+
+    public:
+    static OperatorSelectionStrategies & Get();
+
+    /** Returns the state of \p op, creating it on first use. */
+    state_t & state(const Operator &op);
+
+    /** Emits code to report all states by calling the imported function `report_selection_strategy` and disposes the
+     * states afterwards.  Must be called at the end of `main`. */
+    void emit_report();
+
+    /** Records the decision of the operator of the \p idx-th state. */
+    void record(uint32_t idx, decision_t decision) {
+        M_insist(idx < operators_.size(), "invalid state index");
+        decisions_[operators_[idx]] = decision;
+    }
+
+    /** Returns the reported decision of \p op, or `std::nullopt` if there is none. */
+    std::optional<decision_t> find(const Operator &op) const {
+        if (auto it = decisions_.find(&op); it != decisions_.end())
+            return it->second;
+        return std::nullopt;
+    }
+
+    /** Discards all states and reported decisions, e.g. before compiling the next plan. */
+    void clear() { operators_.clear(); states_.clear(); decisions_.clear(); }
+};
+
 };
 
 template<>
@@ -660,6 +1283,8 @@ struct Match<wasm::NoOp> : wasm::MatchSingleChild
     { }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
         wasm::NoOp::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -677,7 +1302,12 @@ struct Match<wasm::Callback<SIMDfied>> : wasm::MatchSingleChild
 {
     const CallbackOperator &callback;
     std::unique_ptr<const storage::DataLayoutFactory> result_set_factory =
-        M_notnull(options::hard_pipeline_breaker_layout.get())->clone();
+        options::arrow_result_set_callback
+            ? std::make_unique<storage::PAXLayoutFactory>( // columnar s.t. it can be exported to Arrow without copying
+                  storage::PAXLayoutFactory::NTuples,
+                  options::result_set_window_size ? options::result_set_window_size : options::arrow_batch_size
+              )
+            : M_notnull(options::hard_pipeline_breaker_layout.get())->clone();
     std::size_t result_set_window_size = options::result_set_window_size;
 
     Match(const CallbackOperator *callback, std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
@@ -686,6 +1316,8 @@ struct Match<wasm::Callback<SIMDfied>> : wasm::MatchSingleChild
     { }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
         wasm::Callback<SIMDfied>::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -712,6 +1344,8 @@ struct Match<wasm::Print<SIMDfied>> : wasm::MatchSingleChild
     { }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
         wasm::Print<SIMDfied>::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -743,6 +1377,9 @@ struct Match<wasm::Scan<SIMDfied>> : wasm::MatchLeaf
     }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
         if (buffer_factory_) {
             auto buffer_schema = scan.schema().drop_constants().deduplicate();
             if (buffer_schema.num_entries()) {
@@ -798,6 +1435,9 @@ struct Match<wasm::IndexScan<IndexMethod>> : wasm::MatchLeaf
     }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
         execute_buffered(*this, filter.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
@@ -811,26 +1451,25 @@ struct Match<wasm::IndexScan<IndexMethod>> : wasm::MatchLeaf
     void print(std::ostream &out, unsigned level) const override;
 };
 
-template<bool Predicated>
-struct Match<wasm::Filter<Predicated>> : wasm::MatchSingleChild
+template<>
+struct Match<wasm::LateMaterializingScan> : wasm::MatchLeaf
 {
+    const ScanOperator &scan;
     const FilterOperator &filter;
-    private:
-    std::unique_ptr<const storage::DataLayoutFactory> buffer_factory_ =
-        bool(options::soft_pipeline_breaker bitand option_configs::SoftPipelineBreakerStrategy::AFTER_FILTER)
-            ? M_notnull(options::soft_pipeline_breaker_layout.get())->clone()
-            : std::unique_ptr<storage::DataLayoutFactory>();
-    std::size_t buffer_num_tuples_ = options::soft_pipeline_breaker_num_tuples;
 
-    public:
-    Match(const FilterOperator *filter, std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
-        : wasm::MatchSingleChild(std::move(children))
+    Match(const FilterOperator *filter, const ScanOperator *scan,
+          std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : scan(*scan)
         , filter(*filter)
-    { }
+    {
+        M_insist(children.empty());
+    }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
-        execute_buffered(*this, filter.schema(), buffer_factory_, buffer_num_tuples_,
-                         std::move(setup), std::move(pipeline), std::move(teardown));
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        wasm::LateMaterializingScan::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
     const Operator & get_matched_root() const override { return filter; }
@@ -843,25 +1482,24 @@ struct Match<wasm::Filter<Predicated>> : wasm::MatchSingleChild
 };
 
 template<>
-struct Match<wasm::LazyDisjunctiveFilter> : wasm::MatchSingleChild
+struct Match<wasm::ZoneMapScan> : wasm::MatchLeaf
 {
-    const DisjunctiveFilterOperator &filter;
-    private:
-    std::unique_ptr<const storage::DataLayoutFactory> buffer_factory_ =
-        bool(options::soft_pipeline_breaker bitand option_configs::SoftPipelineBreakerStrategy::AFTER_FILTER)
-            ? M_notnull(options::soft_pipeline_breaker_layout.get())->clone()
-            : std::unique_ptr<storage::DataLayoutFactory>();
-    std::size_t buffer_num_tuples_ = options::soft_pipeline_breaker_num_tuples;
+    const ScanOperator &scan;
+    const FilterOperator &filter;
 
-    public:
-    Match(const DisjunctiveFilterOperator *filter, std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
-        : wasm::MatchSingleChild(std::move(children))
+    Match(const FilterOperator *filter, const ScanOperator *scan,
+          std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : scan(*scan)
         , filter(*filter)
-    { }
+    {
+        M_insist(children.empty());
+    }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
-        execute_buffered(*this, filter.schema(), buffer_factory_, buffer_num_tuples_,
-                         std::move(setup), std::move(pipeline), std::move(teardown));
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        wasm::ZoneMapScan::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
     const Operator & get_matched_root() const override { return filter; }
@@ -874,30 +1512,167 @@ struct Match<wasm::LazyDisjunctiveFilter> : wasm::MatchSingleChild
 };
 
 template<>
-struct Match<wasm::Projection> : wasm::MatchBase
+struct Match<wasm::SelectionVectorScan> : wasm::MatchLeaf
 {
-    const ProjectionOperator &projection;
-    std::optional<unsharable_shared_ptr<const wasm::MatchBase>> child;
-    private:
-    std::unique_ptr<const storage::DataLayoutFactory> buffer_factory_ =
-        bool(options::soft_pipeline_breaker bitand option_configs::SoftPipelineBreakerStrategy::AFTER_PROJECTION)
-            ? M_notnull(options::soft_pipeline_breaker_layout.get())->clone()
-            : std::unique_ptr<storage::DataLayoutFactory>();
-    std::size_t buffer_num_tuples_ = options::soft_pipeline_breaker_num_tuples;
+    const ScanOperator &scan;
+    const FilterOperator &filter;
+    std::size_t vector_size = options::selection_vector_size;
 
-    public:
-    Match(const ProjectionOperator *projection, std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
-        : projection(*projection)
+    Match(const FilterOperator *filter, const ScanOperator *scan,
+          std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : scan(*scan)
+        , filter(*filter)
     {
-        if (not children.empty()) {
-            M_insist(children.size() == 1);
-            child = as<const wasm::MatchBase>(std::move(children[0]));
-        }
+        M_insist(children.empty());
     }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
-        execute_buffered(*this, projection.schema(), buffer_factory_, buffer_num_tuples_,
-                         std::move(setup), std::move(pipeline), std::move(teardown));
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        wasm::SelectionVectorScan::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    const Operator & get_matched_root() const override { return filter; }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
+template<bool Predicated>
+struct Match<wasm::Filter<Predicated>> : wasm::MatchSingleChild
+{
+    const FilterOperator &filter;
+    private:
+    std::unique_ptr<const storage::DataLayoutFactory> buffer_factory_ =
+        bool(options::soft_pipeline_breaker bitand option_configs::SoftPipelineBreakerStrategy::AFTER_FILTER) or
+        (Predicated and wasm::is_adaptive_soft_pipeline_breaker_beneficial(filter, child->get_matched_root()))
+            ? M_notnull(options::soft_pipeline_breaker_layout.get())->clone()
+            : std::unique_ptr<storage::DataLayoutFactory>();
+    std::size_t buffer_num_tuples_ = options::soft_pipeline_breaker_num_tuples;
+
+    public:
+    Match(const FilterOperator *filter, std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : wasm::MatchSingleChild(std::move(children))
+        , filter(*filter)
+    { }
+
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        execute_buffered(*this, filter.schema(), buffer_factory_, buffer_num_tuples_,
+                         std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    const Operator & get_matched_root() const override { return filter; }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
+template<>
+struct Match<wasm::LazyDisjunctiveFilter> : wasm::MatchSingleChild
+{
+    const DisjunctiveFilterOperator &filter;
+    private:
+    std::unique_ptr<const storage::DataLayoutFactory> buffer_factory_ =
+        bool(options::soft_pipeline_breaker bitand option_configs::SoftPipelineBreakerStrategy::AFTER_FILTER)
+            ? M_notnull(options::soft_pipeline_breaker_layout.get())->clone()
+            : std::unique_ptr<storage::DataLayoutFactory>();
+    std::size_t buffer_num_tuples_ = options::soft_pipeline_breaker_num_tuples;
+
+    public:
+    Match(const DisjunctiveFilterOperator *filter, std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : wasm::MatchSingleChild(std::move(children))
+        , filter(*filter)
+    { }
+
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        execute_buffered(*this, filter.schema(), buffer_factory_, buffer_num_tuples_,
+                         std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    const Operator & get_matched_root() const override { return filter; }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
+template<>
+struct Match<wasm::AdaptiveFilter> : wasm::MatchSingleChild
+{
+    const FilterOperator &filter;
+    private:
+    std::unique_ptr<const storage::DataLayoutFactory> buffer_factory_ =
+        bool(options::soft_pipeline_breaker bitand option_configs::SoftPipelineBreakerStrategy::AFTER_FILTER)
+            ? M_notnull(options::soft_pipeline_breaker_layout.get())->clone()
+            : std::unique_ptr<storage::DataLayoutFactory>();
+    std::size_t buffer_num_tuples_ = options::soft_pipeline_breaker_num_tuples;
+
+    public:
+    Match(const FilterOperator *filter, std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : wasm::MatchSingleChild(std::move(children))
+        , filter(*filter)
+    { }
+
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        execute_buffered(*this, filter.schema(), buffer_factory_, buffer_num_tuples_,
+                         std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    const Operator & get_matched_root() const override { return filter; }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
+template<>
+struct Match<wasm::Projection> : wasm::MatchBase
+{
+    const ProjectionOperator &projection;
+    std::optional<unsharable_shared_ptr<const wasm::MatchBase>> child;
+    private:
+    std::unique_ptr<const storage::DataLayoutFactory> buffer_factory_ =
+        bool(options::soft_pipeline_breaker bitand option_configs::SoftPipelineBreakerStrategy::AFTER_PROJECTION)
+            ? M_notnull(options::soft_pipeline_breaker_layout.get())->clone()
+            : std::unique_ptr<storage::DataLayoutFactory>();
+    std::size_t buffer_num_tuples_ = options::soft_pipeline_breaker_num_tuples;
+
+    public:
+    Match(const ProjectionOperator *projection, std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : projection(*projection)
+    {
+        if (not children.empty()) {
+            M_insist(children.size() == 1);
+            child = as<const wasm::MatchBase>(std::move(children[0]));
+        }
+    }
+
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        execute_buffered(*this, projection.schema(), buffer_factory_, buffer_num_tuples_,
+                         std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
     const Operator & get_matched_root() const override { return projection; }
@@ -915,10 +1690,19 @@ struct Match<wasm::HashBasedGrouping> : wasm::MatchSingleChild
     const GroupingOperator &grouping;
     bool use_open_addressing_hashing =
         bool(options::hash_table_implementation bitand option_configs::HashTableImplementation::OPEN_ADDRESSING);
-    bool use_in_place_values = bool(options::hash_table_storing_strategy bitand option_configs::StoringStrategy::IN_PLACE);
-    bool use_quadratic_probing = bool(options::hash_table_probing_strategy bitand option_configs::ProbingStrategy::QUADRATIC);
+    bool use_swiss_hashing = not use_open_addressing_hashing and
+        bool(options::hash_table_implementation bitand option_configs::HashTableImplementation::SWISS);
+    ///> whether to store values in-place, `std::nullopt` to decide per hash table
+    std::optional<bool> use_in_place_values =
+        options::hash_table_storing_strategy == option_configs::StoringStrategy::AUTO ? std::nullopt
+            : std::optional(options::hash_table_storing_strategy == option_configs::StoringStrategy::IN_PLACE);
+    ///> whether to use quadratic probing, `std::nullopt` to decide per hash table
+    std::optional<bool> use_quadratic_probing =
+        options::hash_table_probing_strategy == option_configs::ProbingStrategy::AUTO ? std::nullopt
+            : std::optional(options::hash_table_probing_strategy == option_configs::ProbingStrategy::QUADRATIC);
     double load_factor =
-        use_open_addressing_hashing ? options::load_factor_open_addressing : options::load_factor_chained;
+        use_open_addressing_hashing or use_swiss_hashing ? options::load_factor_open_addressing
+                                                         : options::load_factor_chained;
 
     Match(const GroupingOperator *grouping, std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
         : wasm::MatchSingleChild(std::move(children))
@@ -926,6 +1710,9 @@ struct Match<wasm::HashBasedGrouping> : wasm::MatchSingleChild
     { }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
         wasm::HashBasedGrouping::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -949,6 +1736,9 @@ struct Match<wasm::OrderedGrouping> : wasm::MatchSingleChild
     { }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
         wasm::OrderedGrouping::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -961,6 +1751,62 @@ struct Match<wasm::OrderedGrouping> : wasm::MatchSingleChild
     void print(std::ostream &out, unsigned level) const override;
 };
 
+template<>
+struct Match<wasm::ArrayGrouping> : Match<wasm::HashBasedGrouping>
+{
+    wasm::key_domain_t key_domain; ///< the domain of the grouping key
+
+    Match(const GroupingOperator *grouping, std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : Match<wasm::HashBasedGrouping>(grouping, std::move(children))
+        , key_domain(wasm::ArrayGrouping::find_key_domain(*grouping).value()) // guaranteed by pre-condition
+    {
+        /* The array is an open addressing hash table with values in-place that never needs to be probed. */
+        use_open_addressing_hashing = true;
+        use_swiss_hashing = false;
+        use_in_place_values = true;
+        use_quadratic_probing = false;
+        load_factor = options::load_factor_open_addressing;
+    }
+
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        wasm::ArrayGrouping::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
+template<>
+struct Match<wasm::RadixPartitionedGrouping> : Match<wasm::HashBasedGrouping>
+{
+    std::size_t partition_size = options::radix_partitioned_grouping_partition_size;
+    std::unique_ptr<const storage::DataLayoutFactory> materializing_factory =
+        M_notnull(options::hard_pipeline_breaker_layout.get())->clone();
+
+    Match(const GroupingOperator *grouping, std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : Match<wasm::HashBasedGrouping>(grouping, std::move(children))
+    { }
+
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        wasm::RadixPartitionedGrouping::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
 template<>
 struct Match<wasm::Aggregation> : wasm::MatchSingleChild
 {
@@ -972,6 +1818,9 @@ struct Match<wasm::Aggregation> : wasm::MatchSingleChild
     { }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
         wasm::Aggregation::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -997,6 +1846,9 @@ struct Match<wasm::Quicksort<CmpPredicated>> : wasm::MatchSingleChild
     { }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
         wasm::Quicksort<CmpPredicated>::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -1009,6 +1861,34 @@ struct Match<wasm::Quicksort<CmpPredicated>> : wasm::MatchSingleChild
     void print(std::ostream &out, unsigned level) const override;
 };
 
+template<>
+struct Match<wasm::RadixSort> : wasm::MatchSingleChild
+{
+    const SortingOperator &sorting;
+    std::unique_ptr<const storage::DataLayoutFactory> materializing_factory =
+        M_notnull(options::hard_pipeline_breaker_layout.get())->clone();
+
+    Match(const SortingOperator *sorting, std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : wasm::MatchSingleChild(std::move(children))
+        , sorting(*sorting)
+    { }
+
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        wasm::RadixSort::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    const Operator & get_matched_root() const override { return sorting; }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
 template<>
 struct Match<wasm::NoOpSorting> : wasm::MatchSingleChild
 {
@@ -1020,6 +1900,9 @@ struct Match<wasm::NoOpSorting> : wasm::MatchSingleChild
     { }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
         wasm::NoOpSorting::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -1054,6 +1937,9 @@ struct Match<wasm::NestedLoopsJoin<Predicated>> : wasm::MatchMultipleChildren
     }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
         execute_buffered(*this, join.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
@@ -1067,6 +1953,42 @@ struct Match<wasm::NestedLoopsJoin<Predicated>> : wasm::MatchMultipleChildren
     void print(std::ostream &out, unsigned level) const override;
 };
 
+template<idx::IndexMethod IndexMethod>
+struct Match<wasm::IndexNestedLoopsJoin<IndexMethod>> : wasm::MatchSingleChild
+{
+    const JoinOperator &join;
+    const ScanOperator &scan;
+    const Wildcard &outer;
+    std::size_t probe_window_size = options::index_nested_loops_join_probe_window_size;
+    std::unique_ptr<const storage::DataLayoutFactory> probe_window_factory =
+        M_notnull(options::soft_pipeline_breaker_layout.get())->clone();
+    std::size_t batch_size = options::index_sequential_scan_batch_size;
+
+    Match(const JoinOperator *join, const ScanOperator *scan, const Wildcard *outer,
+          std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : wasm::MatchSingleChild(std::move(children))
+        , join(*join)
+        , scan(*scan)
+        , outer(*outer)
+    { }
+
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        wasm::IndexNestedLoopsJoin<IndexMethod>::execute(*this, std::move(setup), std::move(pipeline),
+                                                         std::move(teardown));
+    }
+
+    const Operator & get_matched_root() const override { return join; }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
 template<bool UniqueBuild, bool Predicated>
 struct Match<wasm::SimpleHashJoin<UniqueBuild, Predicated>> : wasm::MatchMultipleChildren
 {
@@ -1075,10 +1997,25 @@ struct Match<wasm::SimpleHashJoin<UniqueBuild, Predicated>> : wasm::MatchMultipl
     const Wildcard &probe;
     bool use_open_addressing_hashing =
         bool(options::hash_table_implementation bitand option_configs::HashTableImplementation::OPEN_ADDRESSING);
-    bool use_in_place_values = bool(options::hash_table_storing_strategy bitand option_configs::StoringStrategy::IN_PLACE);
-    bool use_quadratic_probing = bool(options::hash_table_probing_strategy bitand option_configs::ProbingStrategy::QUADRATIC);
+    bool use_swiss_hashing = not use_open_addressing_hashing and
+        bool(options::hash_table_implementation bitand option_configs::HashTableImplementation::SWISS);
+    ///> whether to store values in-place, `std::nullopt` to decide per hash table
+    std::optional<bool> use_in_place_values =
+        options::hash_table_storing_strategy == option_configs::StoringStrategy::AUTO ? std::nullopt
+            : std::optional(options::hash_table_storing_strategy == option_configs::StoringStrategy::IN_PLACE);
+    ///> whether to use quadratic probing, `std::nullopt` to decide per hash table
+    std::optional<bool> use_quadratic_probing =
+        options::hash_table_probing_strategy == option_configs::ProbingStrategy::AUTO ? std::nullopt
+            : std::optional(options::hash_table_probing_strategy == option_configs::ProbingStrategy::QUADRATIC);
     double load_factor =
-        use_open_addressing_hashing ? options::load_factor_open_addressing : options::load_factor_chained;
+        use_open_addressing_hashing or use_swiss_hashing ? options::load_factor_open_addressing
+                                                         : options::load_factor_chained;
+    std::size_t probe_window_size = options::simple_hash_join_probe_window_size;
+    std::unique_ptr<const storage::DataLayoutFactory> probe_window_factory =
+        probe_window_size ? M_notnull(options::soft_pipeline_breaker_layout.get())->clone()
+                          : std::unique_ptr<storage::DataLayoutFactory>();
+    bool use_bloom_filter = false;
+    bool use_key_range_filter = not Predicated and options::simple_hash_join_key_range_filter;
     private:
     std::unique_ptr<const storage::DataLayoutFactory> buffer_factory_ =
         bool(options::soft_pipeline_breaker bitand option_configs::SoftPipelineBreakerStrategy::AFTER_SIMPLE_HASH_JOIN)
@@ -1095,9 +2032,29 @@ struct Match<wasm::SimpleHashJoin<UniqueBuild, Predicated>> : wasm::MatchMultipl
         , probe(*probe)
     {
         M_insist(children.size() == 2);
+
+        /*----- Decide whether to use a Bloom filter.  Since a predicated join accesses the hash table anyways, the
+         * filter only pays off for branching joins and only if it is expected to drop a large share of the probe
+         * tuples, i.e. if the join is selective w.r.t. the probe side. -----*/
+        constexpr double MAX_SELECTIVITY = 0.5;
+        switch (options::simple_hash_join_bloom_filter_strategy) {
+            case option_configs::BloomFilterStrategy::ALWAYS:
+                use_bloom_filter = not Predicated;
+                break;
+            case option_configs::BloomFilterStrategy::NEVER:
+                use_bloom_filter = false;
+                break;
+            case option_configs::BloomFilterStrategy::AUTO:
+                use_bloom_filter = not Predicated and join->has_info() and probe->has_info() and
+                    join->info().estimated_cardinality < MAX_SELECTIVITY * probe->info().estimated_cardinality;
+                break;
+        }
     }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
         execute_buffered(*this, join.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
@@ -1133,6 +2090,9 @@ struct Match<wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>
     }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
         wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::execute(
             *this, std::move(setup), std::move(pipeline), std::move(teardown)
         );
@@ -1147,6 +2107,183 @@ struct Match<wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>
     void print(std::ostream &out, unsigned level) const override;
 };
 
+template<>
+struct Match<wasm::RadixPartitionedHashJoin> : wasm::MatchMultipleChildren
+{
+    const JoinOperator &join;
+    const Wildcard &build;
+    const Wildcard &probe;
+    bool use_open_addressing_hashing =
+        bool(options::hash_table_implementation bitand option_configs::HashTableImplementation::OPEN_ADDRESSING);
+    bool use_swiss_hashing = not use_open_addressing_hashing and
+        bool(options::hash_table_implementation bitand option_configs::HashTableImplementation::SWISS);
+    ///> whether to store values in-place, `std::nullopt` to decide per hash table
+    std::optional<bool> use_in_place_values =
+        options::hash_table_storing_strategy == option_configs::StoringStrategy::AUTO ? std::nullopt
+            : std::optional(options::hash_table_storing_strategy == option_configs::StoringStrategy::IN_PLACE);
+    ///> whether to use quadratic probing, `std::nullopt` to decide per hash table
+    std::optional<bool> use_quadratic_probing =
+        options::hash_table_probing_strategy == option_configs::ProbingStrategy::AUTO ? std::nullopt
+            : std::optional(options::hash_table_probing_strategy == option_configs::ProbingStrategy::QUADRATIC);
+    double load_factor =
+        use_open_addressing_hashing or use_swiss_hashing ? options::load_factor_open_addressing
+                                                         : options::load_factor_chained;
+    std::size_t partition_size = options::radix_partitioned_hash_join_partition_size;
+    double role_reversal_factor = options::radix_partitioned_hash_join_role_reversal_factor;
+    std::unique_ptr<const storage::DataLayoutFactory> build_materializing_factory =
+        M_notnull(options::hard_pipeline_breaker_layout.get())->clone();
+    std::unique_ptr<const storage::DataLayoutFactory> probe_materializing_factory =
+        M_notnull(options::hard_pipeline_breaker_layout.get())->clone();
+
+    Match(const JoinOperator *join, const Wildcard *build, const Wildcard *probe,
+          std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : wasm::MatchMultipleChildren(std::move(children))
+        , join(*join)
+        , build(*build)
+        , probe(*probe)
+    {
+        M_insist(children.size() == 2);
+    }
+
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        wasm::RadixPartitionedHashJoin::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    const Operator & get_matched_root() const override { return join; }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
+template<>
+struct Match<wasm::PartitionWiseHashJoin> : wasm::MatchMultipleChildren
+{
+    const JoinOperator &join;
+    const Wildcard &build;
+    const Wildcard &probe;
+    bool use_open_addressing_hashing =
+        bool(options::hash_table_implementation bitand option_configs::HashTableImplementation::OPEN_ADDRESSING);
+    bool use_swiss_hashing = not use_open_addressing_hashing and
+        bool(options::hash_table_implementation bitand option_configs::HashTableImplementation::SWISS);
+    ///> whether to store values in-place, `std::nullopt` to decide per hash table
+    std::optional<bool> use_in_place_values =
+        options::hash_table_storing_strategy == option_configs::StoringStrategy::AUTO ? std::nullopt
+            : std::optional(options::hash_table_storing_strategy == option_configs::StoringStrategy::IN_PLACE);
+    ///> whether to use quadratic probing, `std::nullopt` to decide per hash table
+    std::optional<bool> use_quadratic_probing =
+        options::hash_table_probing_strategy == option_configs::ProbingStrategy::AUTO ? std::nullopt
+            : std::optional(options::hash_table_probing_strategy == option_configs::ProbingStrategy::QUADRATIC);
+    double load_factor =
+        use_open_addressing_hashing or use_swiss_hashing ? options::load_factor_open_addressing
+                                                         : options::load_factor_chained;
+    ///> the size in bytes of a build partition up to which its hash table is expected to fit into the cache
+    std::size_t partition_size = options::radix_partitioned_hash_join_partition_size;
+
+    Match(const JoinOperator *join, const Wildcard *build, const Wildcard *probe,
+          std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : wasm::MatchMultipleChildren(std::move(children))
+        , join(*join)
+        , build(*build)
+        , probe(*probe)
+    {
+        M_insist(children.size() == 2);
+    }
+
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        wasm::PartitionWiseHashJoin::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    const Operator & get_matched_root() const override { return join; }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
+template<>
+struct Match<wasm::DirectAddressJoin> : wasm::MatchMultipleChildren
+{
+    const JoinOperator &join;
+    const Wildcard &build;
+    const Wildcard &probe;
+    wasm::key_domain_t key_domain; ///< the domain of the build key
+    double load_factor = options::load_factor_open_addressing;
+
+    Match(const JoinOperator *join, const Wildcard *build, const Wildcard *probe,
+          std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : wasm::MatchMultipleChildren(std::move(children))
+        , join(*join)
+        , build(*build)
+        , probe(*probe)
+        , key_domain(wasm::DirectAddressJoin::find_key_domain(*join, *build).value()) // guaranteed by pre-condition
+    {
+        M_insist(children.size() == 2);
+    }
+
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        wasm::DirectAddressJoin::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    const Operator & get_matched_root() const override { return join; }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
+template<>
+struct Match<wasm::BandJoin> : wasm::MatchMultipleChildren
+{
+    const JoinOperator &join;
+    const Wildcard &build;
+    const Wildcard &probe;
+    wasm::BandJoin::band_t band; ///< the bounds of the join
+    std::unique_ptr<const storage::DataLayoutFactory> build_materializing_factory =
+        M_notnull(options::hard_pipeline_breaker_layout.get())->clone();
+
+    Match(const JoinOperator *join, const Wildcard *build, const Wildcard *probe,
+          std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : wasm::MatchMultipleChildren(std::move(children))
+        , join(*join)
+        , build(*build)
+        , probe(*probe)
+        , band(wasm::BandJoin::find_band(*join, *build).value()) // guaranteed by pre-condition
+    {
+        M_insist(children.size() == 2);
+    }
+
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        wasm::BandJoin::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    const Operator & get_matched_root() const override { return join; }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
 template<>
 struct Match<wasm::Limit> : wasm::MatchSingleChild
 {
@@ -1158,6 +2295,9 @@ struct Match<wasm::Limit> : wasm::MatchSingleChild
     { }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
         wasm::Limit::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -1170,6 +2310,37 @@ struct Match<wasm::Limit> : wasm::MatchSingleChild
     void print(std::ostream &out, unsigned level) const override;
 };
 
+template<>
+struct Match<wasm::TopK> : wasm::MatchSingleChild
+{
+    const LimitOperator &limit;
+    const SortingOperator &sorting;
+    std::unique_ptr<const storage::DataLayoutFactory> materializing_factory =
+        M_notnull(options::hard_pipeline_breaker_layout.get())->clone();
+
+    Match(const LimitOperator *limit, const SortingOperator *sorting, const Wildcard*,
+          std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : wasm::MatchSingleChild(std::move(children))
+        , limit(*limit)
+        , sorting(*sorting)
+    { }
+
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        wasm::TopK::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    const Operator & get_matched_root() const override { return limit; }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
 template<>
 struct Match<wasm::HashBasedGroupJoin> : wasm::MatchMultipleChildren
 {
@@ -1179,10 +2350,19 @@ struct Match<wasm::HashBasedGroupJoin> : wasm::MatchMultipleChildren
     const Wildcard &probe;
     bool use_open_addressing_hashing =
         bool(options::hash_table_implementation bitand option_configs::HashTableImplementation::OPEN_ADDRESSING);
-    bool use_in_place_values = bool(options::hash_table_storing_strategy bitand option_configs::StoringStrategy::IN_PLACE);
-    bool use_quadratic_probing = bool(options::hash_table_probing_strategy bitand option_configs::ProbingStrategy::QUADRATIC);
+    bool use_swiss_hashing = not use_open_addressing_hashing and
+        bool(options::hash_table_implementation bitand option_configs::HashTableImplementation::SWISS);
+    ///> whether to store values in-place, `std::nullopt` to decide per hash table
+    std::optional<bool> use_in_place_values =
+        options::hash_table_storing_strategy == option_configs::StoringStrategy::AUTO ? std::nullopt
+            : std::optional(options::hash_table_storing_strategy == option_configs::StoringStrategy::IN_PLACE);
+    ///> whether to use quadratic probing, `std::nullopt` to decide per hash table
+    std::optional<bool> use_quadratic_probing =
+        options::hash_table_probing_strategy == option_configs::ProbingStrategy::AUTO ? std::nullopt
+            : std::optional(options::hash_table_probing_strategy == option_configs::ProbingStrategy::QUADRATIC);
     double load_factor =
-        use_open_addressing_hashing ? options::load_factor_open_addressing : options::load_factor_chained;
+        use_open_addressing_hashing or use_swiss_hashing ? options::load_factor_open_addressing
+                                                         : options::load_factor_chained;
     private:
     std::unique_ptr<const storage::DataLayoutFactory> buffer_factory_ =
         bool(options::soft_pipeline_breaker bitand option_configs::SoftPipelineBreakerStrategy::AFTER_HASH_BASED_GROUP_JOIN)
@@ -1203,6 +2383,9 @@ struct Match<wasm::HashBasedGroupJoin> : wasm::MatchMultipleChildren
     }
 
     void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
         execute_buffered(*this, grouping.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
@@ -1216,6 +2399,52 @@ struct Match<wasm::HashBasedGroupJoin> : wasm::MatchMultipleChildren
     void print(std::ostream &out, unsigned level) const override;
 };
 
+template<>
+struct Match<wasm::HashSemiJoin> : wasm::MatchMultipleChildren
+{
+    const JoinOperator &join;
+    const GroupingOperator &grouping;
+    const Wildcard &build;
+    const Wildcard &probe;
+    bool use_open_addressing_hashing =
+        bool(options::hash_table_implementation bitand option_configs::HashTableImplementation::OPEN_ADDRESSING);
+    bool use_swiss_hashing = not use_open_addressing_hashing and
+        bool(options::hash_table_implementation bitand option_configs::HashTableImplementation::SWISS);
+    ///> whether to use quadratic probing, `std::nullopt` to decide per hash table
+    std::optional<bool> use_quadratic_probing =
+        options::hash_table_probing_strategy == option_configs::ProbingStrategy::AUTO ? std::nullopt
+            : std::optional(options::hash_table_probing_strategy == option_configs::ProbingStrategy::QUADRATIC);
+    double load_factor =
+        use_open_addressing_hashing or use_swiss_hashing ? options::load_factor_open_addressing
+                                                         : options::load_factor_chained;
+
+    Match(const JoinOperator *join, const GroupingOperator *grouping, const Wildcard *build, const Wildcard *probe,
+          std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : wasm::MatchMultipleChildren(std::move(children))
+        , join(*join)
+        , grouping(*grouping)
+        , build(*build)
+        , probe(*probe)
+    {
+        M_insist(children.size() == 2);
+    }
+
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        pipeline = wasm::count_tuples(get_matched_root(), std::move(pipeline));
+        pipeline = wasm::record_estimated_work(get_matched_root(), std::move(pipeline));
+        wasm::OperatorMemoryScope memory_scope(get_matched_root(), setup, pipeline, teardown);
+        wasm::HashSemiJoin::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    const Operator & get_matched_root() const override { return join; }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
 namespace wasm {
 
 #define M_WASM_VISITABLE_MATCH_LIST(X) \
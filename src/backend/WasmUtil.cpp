@@ -3,10 +3,13 @@
 #include "backend/Interpreter.hpp"
 #include "backend/WasmMacro.hpp"
 #include "mutable/util/macro.hpp"
+#include "util/LikeDFA.hpp"
+#include <algorithm>
 #include <mutable/util/concepts.hpp>
 #include <optional>
 #include <regex>
 #include <tuple>
+#include <utility>
 
 
 using namespace m;
@@ -24,6 +27,34 @@ bool pointer_sharing = true;
 /** Whether data layout compilation makes use of remainder removal optimization. */
 bool remainder_removal = true;
 
+/** The number of INodes, e.g. PAX blocks, by which sequential loads touch the accessed columns ahead of use; 0 to not
+ * touch ahead. */
+std::size_t touch_ahead_inodes = 1;
+
+/** Whether string comparisons and LIKE make use of SIMD kernels. */
+bool simd_strings = true;
+
+/** Whether string (in)equalities are decided on the first four bytes of both strings whenever possible. */
+bool string_prefix_comparison = true;
+
+/** Whether subexpressions occurring multiple times in the expressions of an operator are evaluated only once. */
+bool common_subexpression_elimination = true;
+
+/** Returns `true` iff \p e contains a constant that is bound late, see `CodeGenContext::parameter_index()`. */
+bool contains_late_bound_constant(const ast::Expr &e)
+{
+    if (auto c = cast<const ast::Constant>(&e))
+        return bool(CodeGenContext::Get().parameter_index(*c));
+    if (auto u = cast<const ast::UnaryExpr>(&e))
+        return contains_late_bound_constant(*u->expr);
+    if (auto b = cast<const ast::BinaryExpr>(&e))
+        return contains_late_bound_constant(*b->lhs) or contains_late_bound_constant(*b->rhs);
+    if (auto fn = cast<const ast::FnApplicationExpr>(&e))
+        return std::any_of(fn->args.begin(), fn->args.end(),
+                           [](auto &arg) { return contains_late_bound_constant(*arg); });
+    return false;
+}
+
 }
 
 __attribute__((constructor(201)))
@@ -46,6 +77,105 @@ static void add_wasm_util_args()
         /* description= */ "do not use remainder removal optimization for data layout compilation",
         /* callback=    */ [](bool){ options::remainder_removal = false; }
     );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--touch-ahead-inodes",
+        /* description= */ "set the number of INodes, e.g. PAX blocks, by which sequential loads touch the accessed "
+                           "columns ahead of use (0 means no touching ahead)",
+        /* callback=    */ [](std::size_t num_inodes){ options::touch_ahead_inodes = num_inodes; }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-simd-strings",
+        /* description= */ "do not use SIMD kernels for string comparisons and LIKE",
+        /* callback=    */ [](bool){ options::simd_strings = false; }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-string-prefix-comparison",
+        /* description= */ "do not decide string (in)equalities on the first four bytes of both strings",
+        /* callback=    */ [](bool){ options::string_prefix_comparison = false; }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-cse",
+        /* description= */ "do not evaluate common subexpressions of projections, aggregates, and filters only once",
+        /* callback=    */ [](bool){ options::common_subexpression_elimination = false; }
+    );
+}
+
+/** Loads the 16 characters at \p ptr as a vector. */
+U8x16 load_chunk(Ptr<Charx1> ptr) { return *ptr.to<void*>().to<uint8_t*, 16>(); }
+
+/** Advances \p left and \p right over their common prefix in whole chunks of 16 characters, comparing a chunk at a time
+ * with `i8x16` instructions.  Stops at the first chunk that differs, that contains a NUL byte in \p left, or that
+ * exceeds \p end_left or \p end_right.  Hence, the remaining characters must be compared character-wise. */
+template<typename Left, typename Right>
+void skip_equal_chunks(Left &left, Right &right, const Var<Ptr<Charx1>> &end_left, const Var<Ptr<Charx1>> &end_right)
+{
+    WHILE (left + 16 <= end_left and right + 16 <= end_right) {
+        const Var<U8x16> chunk_left(load_chunk(left));
+        U8x16 chunk_right = load_chunk(right);
+        BREAK((chunk_left != chunk_right or chunk_left == U8x16(0U)).any_true());
+        left += 16;
+        right += 16;
+    }
+}
+
+/** Compares the first four bytes of the strings at \p left and \p right, whose types both provide at least four
+ * characters, as a single word, like the inline prefix of "German strings".  Only the bytes within the first \p len
+ * characters and up to and including the first NUL byte of \p left are compared.  Returns whether this decides the
+ * equality of the strings, i.e. the prefixes differ, \p left ends within the prefix, at most \p len characters are to
+ * be compared, or \p prefix_is_entire_string, and whether the prefixes are equal. */
+std::pair<Boolx1, Boolx1> compare_prefixes(Ptr<Charx1> left, Ptr<Charx1> right, U32x1 len, bool prefix_is_entire_string)
+{
+    const Var<U32x1> word_left(*left.to<void*>().to<uint32_t*>());
+    const Var<U32x1> word_right(*right.to<void*>().to<uint32_t*>());
+    const Var<U32x1> len_(len);
+
+    /* Flag the NUL bytes of `left`, see "Determine if a word has a zero byte" of Bit Twiddling Hacks.  Only the lowest
+     * flag is exact, which suffices since Wasm is little-endian, i.e. the first character is the lowest byte. */
+    const Var<U32x1> zeros((word_left - 0x01010101U) bitand ~word_left bitand 0x80808080U);
+    const Var<U32x1> first_zero(zeros bitand (U32x1(0U) - zeros));
+
+    /* The shift overflows to 0 if there is no NUL byte or if it is the last byte, hence all bytes are masked. */
+    U32x1 nul_mask = (first_zero << 1U) - 1U;
+    U32x1 len_mask = Select(len_ < 4U, (U32x1(1U) << (len_ * 8U)) - 1U, U32x1(~0U));
+    const Var<U32x1> mask(nul_mask bitand len_mask);
+
+    const Var<Boolx1> equal((word_left bitand mask) == (word_right bitand mask));
+    if (prefix_is_entire_string)
+        return { Boolx1(true), equal };
+    return { not equal or first_zero != 0U or len_ <= 4U, equal };
+}
+
+/** Returns the 16 characters at \p chars as a vector constant. */
+U8x16 make_chunk(const char *chars)
+{
+    return [chars]<std::size_t... I>(std::index_sequence<I...>) {
+        return U8x16(uint8_t(chars[I])...);
+    }(std::make_index_sequence<16>());
+}
+
+/** Returns `true` iff the \p len characters at \p _str equal the characters of \p pattern.  Chunks of 16 characters
+ * are compared with `i8x16` instructions against vector constants and the remaining characters one at a time against
+ * constants.  Hence, \p pattern is only read during code generation and need not reside in the Wasm memory. */
+Boolx1 equals_static(Ptr<Charx1> _str, const char *pattern, int32_t len)
+{
+    const Var<Ptr<Charx1>> str(_str);
+    Var<Boolx1> equal(true);
+    int32_t idx = 0;
+    if (options::simd_strings) {
+        for (; idx + 16 <= len; idx += 16)
+            equal = equal and (load_chunk(str + idx) == make_chunk(pattern + idx)).all_true();
+    }
+    for (; idx < len; ++idx)
+        equal = equal and *(str + idx) == pattern[idx];
+    return equal;
 }
 
 }
@@ -150,6 +280,28 @@ std::conditional_t<CanBeNull, _Bool<L>, Bool<L>> compile_cnf(ExprCompiler &C, co
  * ExprCompiler
  *====================================================================================================================*/
 
+bool m::wasm::is_late_bindable(const ast::Constant &c)
+{
+    if (c.type()->is_none())
+        return false;
+    return visit(overloaded {
+        [](const Numeric&) { return true; },
+        [](const Date&) { return true; },
+        [](const DateTime&) { return true; },
+        [](auto&&) { return false; }, // booleans have only two values and strings are mapped as literals
+    }, *c.type());
+}
+
+void m::wasm::print_codegen_options(std::ostream &out)
+{
+    out << "pointer_sharing=" << options::pointer_sharing
+        << " remainder_removal=" << options::remainder_removal
+        << " touch_ahead_inodes=" << options::touch_ahead_inodes
+        << " simd_strings=" << options::simd_strings
+        << " string_prefix_comparison=" << options::string_prefix_comparison
+        << " common_subexpression_elimination=" << options::common_subexpression_elimination;
+}
+
 void ExprCompiler::operator()(const ast::ErrorExpr&) { M_unreachable("no errors at this stage"); }
 
 void ExprCompiler::operator()(const ast::Designator &e)
@@ -187,10 +339,61 @@ void ExprCompiler::operator()(const ast::Constant &e)
         return;
     }
 
+    /* Read late-bound constants from their imported global.  Only scalar values are supported, vectorial uses embed
+     * the constant and thus prevent reusing the module for other parameter values. */
+    if (auto idx = CodeGenContext::Get().parameter_index(e)) {
+        if (CodeGenContext::Get().num_simd_lanes() == 1) {
+            const auto name = CodeGenContext::Parameter_Name(*idx);
+            auto load = [idx, &name]<dsl_primitive T>() -> PrimitiveExpr<T> {
+                if (CodeGenContext::Get().import_parameter(*idx))
+                    Module::Get().emit_import<T>(name.c_str());
+                return Module::Get().get_global<T>(name.c_str());
+            };
+            visit(overloaded {
+                [this, &load](const Numeric &n) {
+                    switch (n.kind) {
+                        case Numeric::N_Int:
+                        case Numeric::N_Decimal:
+                            switch (n.size()) {
+                                default:
+                                    M_unreachable("invalid integer size");
+                                case 8:
+                                    set(_I8x1(load.operator()<int32_t>().to<int8_t>()));
+                                    break;
+                                case 16:
+                                    set(_I16x1(load.operator()<int32_t>().to<int16_t>()));
+                                    break;
+                                case 32:
+                                    set(_I32x1(load.operator()<int32_t>()));
+                                    break;
+                                case 64:
+                                    set(_I64x1(load.operator()<int64_t>()));
+                                    break;
+                            }
+                            break;
+                        case Numeric::N_Float:
+                            if (n.size() <= 32)
+                                set(_Floatx1(load.operator()<float>()));
+                            else
+                                set(_Doublex1(load.operator()<double>()));
+                    }
+                },
+                [this, &load](const Date&) { set(_I32x1(load.operator()<int32_t>())); },
+                [this, &load](const DateTime&) { set(_I64x1(load.operator()<int64_t>())); },
+                [](auto&&) { M_unreachable("constant cannot be bound late"); },
+            }, *e.type());
+            return;
+        }
+        CodeGenContext::Get().mark_module_not_reusable();
+    }
+
     /* Interpret constant. */
-    auto value = Interpreter::eval(e);
+    set_constant(Interpreter::eval(e), e.type());
+}
 
-    auto set_constant = [this, &e, &value]<std::size_t L>(){
+void ExprCompiler::set_constant(const Value &value, const Type *type)
+{
+    auto set_constant = [this, type, &value]<std::size_t L>(){
         auto set_helper = overloaded {
             [this]<sql_type T>(T &&actual) { this->set(std::forward<T>(actual)); },
             [](auto&&) { M_unreachable("not a SQL type"); }
@@ -234,7 +437,7 @@ void ExprCompiler::operator()(const ast::Constant &e)
             [&value, &set_helper](const DateTime&) { set_helper(_I64<L>(value.as_i())); },
             [](const NoneType&) { M_unreachable("should've been handled earlier"); },
             [](auto&&) { M_unreachable("invalid type for given number of SIMD lanes"); },
-        }, *e.type());
+        }, *type);
     };
     switch (CodeGenContext::Get().num_simd_lanes()) {
         default: M_unreachable("invalid number of SIMD lanes");
@@ -249,6 +452,14 @@ void ExprCompiler::operator()(const ast::Constant &e)
 
 void ExprCompiler::operator()(const ast::UnaryExpr &e)
 {
+    if (env_.has_subexpression(e)) { // common subexpression bound to a variable
+        set(env_.get_subexpression(e));
+        return;
+    }
+
+    if (fold(e)) // constant expression, evaluated only once
+        return;
+
     /* This is a helper to apply unary operations to `Expr<T>`s.  It uses SFINAE within `overloaded` to only apply the
      * operation if it is well typed, e.g. `+42` is ok whereas `+true` is not. */
     auto apply_unop = [this, &e](auto unop) {
@@ -283,6 +494,21 @@ void ExprCompiler::operator()(const ast::UnaryExpr &e)
 
 void ExprCompiler::operator()(const ast::BinaryExpr &e)
 {
+    if (env_.has_subexpression(e)) { // common subexpression bound to a variable
+        set(env_.get_subexpression(e));
+        return;
+    }
+
+    if (fold(e)) // constant expression, evaluated only once
+        return;
+
+    if (not contains_late_bound_constant(e)) {
+        if (auto operand = Interpreter::identity_operand(e)) { // identity operation, e.g. `x * 1`
+            (*this)(*operand);
+            return;
+        }
+    }
+
     /* This is a helper to apply binary operations to `Expr<T>`s.  It uses SFINAE within `overloaded` to only apply the
      * operation if it is well typed, e.g. `42 + 13` is ok whereas `true + 42` is not. */
     auto apply_binop = [this, &e](auto binop) {
@@ -374,6 +600,10 @@ void ExprCompiler::operator()(const ast::BinaryExpr &e)
                     set(like_suffix(str, pattern));
                     break;
                 }
+                if (auto dfa = LikeDFA::Compile(*pattern)) { // arbitrary static pattern
+                    set(like_dfa(str, pattern, *dfa));
+                    break;
+                }
             }
             /* no specialization applicable, fallback to general dynamic programming approach */
             (*this)(*e.rhs);
@@ -449,6 +679,14 @@ void ExprCompiler::operator()(const ast::BinaryExpr &e)
 
 void ExprCompiler::operator()(const ast::FnApplicationExpr &e)
 {
+    if (env_.has_subexpression(e)) { // common subexpression bound to a variable
+        set(env_.get_subexpression(e));
+        return;
+    }
+
+    if (fold(e)) // constant expression, evaluated only once
+        return;
+
     switch (e.get_function().fnid) {
         default:
             M_unreachable("function kind not implemented");
@@ -495,6 +733,17 @@ void ExprCompiler::operator()(const ast::FnApplicationExpr &e)
     }
 }
 
+bool ExprCompiler::fold(const ast::Expr &e)
+{
+    if (contains_late_bound_constant(e))
+        return false; // keep module reusable for other parameter values
+    auto value = Interpreter::fold(e);
+    if (not value)
+        return false;
+    set_constant(*value, e.type());
+    return true;
+}
+
 void ExprCompiler::operator()(const ast::QueryExpr &e)
 {
     /* Search with fully qualified name. */
@@ -514,6 +763,60 @@ SQL_boolean_t ExprCompiler::compile(const cnf::CNF &cnf)
 
 
 
+/*======================================================================================================================
+ * Common subexpression elimination
+ *====================================================================================================================*/
+
+void m::wasm::bind_common_subexpressions(Environment &env,
+                                         const std::vector<std::reference_wrapper<const ast::Expr>> &exprs)
+{
+    if (not options::common_subexpression_elimination)
+        return;
+
+    /*----- Count the occurrences of composite subexpressions.  Aggregates, designators, constants, and nested queries
+     * are looked up in the environment or are cheap to compile, hence they are not descended into. -----*/
+    std::unordered_map<std::reference_wrapper<const ast::Expr>, unsigned> counts;
+    std::vector<std::reference_wrapper<const ast::Expr>> common; // in post-order, s.t. inner ones are bound first
+    auto count = [&](const ast::Expr &e, auto &count_rec) -> void {
+        if (auto u = cast<const ast::UnaryExpr>(&e)) {
+            count_rec(*u->expr, count_rec);
+        } else if (auto b = cast<const ast::BinaryExpr>(&e)) {
+            count_rec(*b->lhs, count_rec);
+            count_rec(*b->rhs, count_rec);
+        } else if (auto fn = cast<const ast::FnApplicationExpr>(&e); fn and not fn->get_function().is_aggregate()) {
+            for (auto &arg : fn->args)
+                count_rec(*arg, count_rec);
+        } else {
+            return;
+        }
+        if (++counts[e] == 2)
+            common.emplace_back(e);
+    };
+    for (auto &e : exprs)
+        count(e.get(), count);
+
+    /*----- Evaluate each common subexpression once into a variable, which all later occurrences load from. -----*/
+    for (auto &e : common) {
+        if (env.has_subexpression(e) or e.get().type()->is_none() or e.get().type()->is_character_sequence())
+            continue; // already bound, NULL, or a string, which is not copied
+        std::visit(overloaded {
+            [&]<typename T, std::size_t L>(Expr<T, L> value) -> void {
+                if (value.can_be_null()) {
+                    Var<Expr<T, L>> var(value); // introduce variable s.t. uses only load from it
+                    env.add_subexpression(e, var);
+                } else {
+                    /* introduce variable w/o NULL bit s.t. uses only load from it */
+                    Var<PrimitiveExpr<T, L>> var(value.insist_not_null());
+                    env.add_subexpression(e, Expr<T, L>(var));
+                }
+            },
+            [](NChar) -> void { M_unreachable("strings are not bound"); },
+            [](std::monostate) -> void { M_unreachable("invalid expression"); },
+        }, env.compile(e.get()));
+    }
+}
+
+
 /*======================================================================================================================
  * Environment
  *====================================================================================================================*/
@@ -563,7 +866,10 @@ namespace wasm {
  * multiple times and each call starts storing at exactly the point where it has ended in the last call. The given
  * variable \p tuple_id will be incremented automatically before advancing to the next tuple (i.e. code for this will
  * be emitted at the start of the block returned as third element).  Predication is supported and emitted respectively
- * for storing tuples.  SIMDfication is supported and will be emitted iff \tparam L is greater than 1.
+ * for storing tuples.  SIMDfication is supported and will be emitted iff \tparam L is greater than 1.  If
+ * \p num_tuples is given, loads touch the accessed columns of the INode `options::touch_ahead_inodes` ahead of the
+ * current one whenever entering a new INode with more than one tuple, e.g. a PAX block, as long as that INode
+ * contains a tuple with an ID less than \p num_tuples.
  *
  * Does not emit any code but returns three `wasm::Block`s containing code: the first one initializes all needed
  * variables, the second one stores/loads one tuple, and the third one advances to the next tuple.  Additionally, if not
@@ -574,7 +880,8 @@ requires (L > 0) and (is_pow_2(L))
 std::tuple<Block, Block, Block>
 compile_data_layout_sequential(const Schema &_tuple_value_schema, const Schema &_tuple_addr_schema,
                                Ptr<void> base_address, const storage::DataLayout &layout, const Schema &layout_schema,
-                               Variable<uint32_t, Kind, false> &tuple_id)
+                               Variable<uint32_t, Kind, false> &tuple_id,
+                               std::optional<U32x1> num_tuples = std::nullopt)
 {
     const auto tuple_value_schema = _tuple_value_schema.deduplicate().drop_constants();
     const auto tuple_addr_schema = _tuple_addr_schema.deduplicate().drop_constants();
@@ -632,6 +939,22 @@ compile_data_layout_sequential(const Schema &_tuple_value_schema, const Schema &
         }
     }
 
+    /*----- If touching ahead, remember the end of the tuples and where to store the touched bytes to. -----*/
+    std::optional<Var<U32x1>> touch_end;
+    std::optional<Ptr<U32x1>> touch_sink; ///< to not optimize away touching loads
+    if (num_tuples) {
+        M_insist(not IsStore, "only loads touch ahead");
+        M_insist(SinglePass, "touching ahead requires a single pass");
+        if (options::touch_ahead_inodes) {
+            BLOCK_OPEN(inits) {
+                touch_end.emplace(*std::exchange(num_tuples, std::nullopt));
+            }
+            touch_sink.emplace(Module::Allocator().pre_malloc<uint32_t>());
+        } else {
+            num_tuples->discard();
+        }
+    }
+
     /*----- Check whether any of the entries in `tuple_value_schema` can be NULL, so that we need the NULL bitmap. -----*/
     const bool needs_null_bitmap = [&]() {
         for (auto &tuple_entry : tuple_value_schema) {
@@ -1511,6 +1834,29 @@ compile_data_layout_sequential(const Schema &_tuple_value_schema, const Schema &
             rec(curr, end, rec);
         };
 
+        /*----- Touch the accessed columns of the INode `options::touch_ahead_inodes` ahead of the current one s.t.
+         * the cache misses of starting their streams overlap with processing the current INode.  Omitted for INodes
+         * of a single tuple, e.g. rows, since the hardware prefetcher already follows a single stream. -----*/
+        auto touch_ahead = [&]() {
+            if (not touch_end or levels.back().num_tuples == 1U) return;
+            const uint64_t distance_in_tuples = options::touch_ahead_inodes * levels.back().num_tuples;
+            const uint64_t distance_in_bytes = options::touch_ahead_inodes * (levels.back().stride_in_bits / 8);
+            if (not std::in_range<uint32_t>(distance_in_tuples) or not std::in_range<int32_t>(distance_in_bytes))
+                return; // INode ahead out of reach
+            IF (tuple_id + uint32_t(distance_in_tuples) < *touch_end) {
+                Var<U32x1> touched(0U);
+                for (auto &[_, value] : loading_context) {
+                    U8x1 byte = *(value.ptr + int32_t(distance_in_bytes)).template to<uint8_t*>();
+                    touched |= byte.template to<uint32_t>(); // load first byte of the column into the cache
+                }
+                if (null_bitmap_ptr) {
+                    U8x1 byte = *(*null_bitmap_ptr + int32_t(distance_in_bytes)).template to<uint8_t*>();
+                    touched |= byte.template to<uint32_t>(); // load first byte of the NULL bitmap into the cache
+                }
+                *touch_sink->clone() = touched.val();
+            };
+        };
+
         /*----- Process path from DataLayout leaves to the root to emit stride jumps. -----*/
         BLOCK_OPEN(jumps) {
             /*----- Emit the per-leaf stride jumps, i.e. from one instance of the leaf to the next. -----*/
@@ -1647,6 +1993,9 @@ compile_data_layout_sequential(const Schema &_tuple_value_schema, const Schema &
 
                             /*----- Recurse within IF. -----*/
                             emit_stride_jumps(std::next(levels.crbegin()), levels.crend());
+
+                            /*----- Touch ahead after entering the next INode. -----*/
+                            touch_ahead();
                         };
                     } else {
                         lowest_inode_jumps.attach_to_current();
@@ -1722,6 +2071,8 @@ compile_data_layout_sequential(const Schema &_tuple_value_schema, const Schema &
         }
     }
     base_address.discard(); // discard base address (as it was always cloned)
+    if (touch_sink)
+        touch_sink->discard(); // discard touch sink (as it was always cloned)
 
 #ifndef NDEBUG
     if constexpr (IsStore)
@@ -1851,51 +2202,58 @@ template<VariableKind Kind>
 std::tuple<m::wasm::Block, m::wasm::Block, m::wasm::Block>
 m::wasm::compile_load_sequential(const Schema &tuple_value_schema, const Schema &tuple_addr_schema,
                                  Ptr<void> base_address, const storage::DataLayout &layout, std::size_t num_simd_lanes,
-                                 const Schema &layout_schema, Variable<uint32_t, Kind, false> &tuple_id)
+                                 const Schema &layout_schema, Variable<uint32_t, Kind, false> &tuple_id,
+                                 std::optional<U32x1> num_tuples)
 {
     if (options::pointer_sharing) {
         switch (num_simd_lanes) {
             default: M_unreachable("unsupported number of SIMD lanes");
             case  1: return compile_data_layout_sequential<false,  1, true, true>(tuple_value_schema, tuple_addr_schema,
                                                                                   base_address, layout, layout_schema,
-                                                                                  tuple_id);
+                                                                                  tuple_id, std::move(num_tuples));
             case  2: return compile_data_layout_sequential<false,  2, true, true>(tuple_value_schema, tuple_addr_schema,
                                                                                   base_address, layout, layout_schema,
-                                                                                  tuple_id);
+                                                                                  tuple_id, std::move(num_tuples));
             case  4: return compile_data_layout_sequential<false,  4, true, true>(tuple_value_schema, tuple_addr_schema,
                                                                                   base_address, layout, layout_schema,
-                                                                                  tuple_id);
+                                                                                  tuple_id, std::move(num_tuples));
             case  8: return compile_data_layout_sequential<false,  8, true, true>(tuple_value_schema, tuple_addr_schema,
                                                                                   base_address, layout, layout_schema,
-                                                                                  tuple_id);
+                                                                                  tuple_id, std::move(num_tuples));
             case 16: return compile_data_layout_sequential<false, 16, true, true>(tuple_value_schema, tuple_addr_schema,
                                                                                   base_address, layout, layout_schema,
-                                                                                  tuple_id);
+                                                                                  tuple_id, std::move(num_tuples));
             case 32: return compile_data_layout_sequential<false, 32, true, true>(tuple_value_schema, tuple_addr_schema,
                                                                                   base_address, layout, layout_schema,
-                                                                                  tuple_id);
+                                                                                  tuple_id, std::move(num_tuples));
         }
     } else {
         switch (num_simd_lanes) {
             default: M_unreachable("unsupported number of SIMD lanes");
             case  1: return compile_data_layout_sequential<false,  1, true, false>(tuple_value_schema,
                                                                                    tuple_addr_schema, base_address,
-                                                                                   layout, layout_schema, tuple_id);
+                                                                                   layout, layout_schema, tuple_id,
+                                                                                   std::move(num_tuples));
             case  2: return compile_data_layout_sequential<false,  2, true, false>(tuple_value_schema,
                                                                                    tuple_addr_schema, base_address,
-                                                                                   layout, layout_schema, tuple_id);
+                                                                                   layout, layout_schema, tuple_id,
+                                                                                   std::move(num_tuples));
             case  4: return compile_data_layout_sequential<false,  4, true, false>(tuple_value_schema,
                                                                                    tuple_addr_schema, base_address,
-                                                                                   layout, layout_schema, tuple_id);
+                                                                                   layout, layout_schema, tuple_id,
+                                                                                   std::move(num_tuples));
             case  8: return compile_data_layout_sequential<false,  8, true, false>(tuple_value_schema,
                                                                                    tuple_addr_schema, base_address,
-                                                                                   layout, layout_schema, tuple_id);
+                                                                                   layout, layout_schema, tuple_id,
+                                                                                   std::move(num_tuples));
             case 16: return compile_data_layout_sequential<false, 16, true, false>(tuple_value_schema,
                                                                                    tuple_addr_schema, base_address,
-                                                                                   layout, layout_schema, tuple_id);
+                                                                                   layout, layout_schema, tuple_id,
+                                                                                   std::move(num_tuples));
             case 32: return compile_data_layout_sequential<false, 32, true, false>(tuple_value_schema,
                                                                                    tuple_addr_schema, base_address,
-                                                                                   layout, layout_schema, tuple_id);
+                                                                                   layout, layout_schema, tuple_id,
+                                                                                   std::move(num_tuples));
         }
     }
 }
@@ -1922,14 +2280,17 @@ template std::tuple<m::wasm::Block, m::wasm::Block, m::wasm::Block> m::wasm::com
     Variable<uint32_t, VariableKind::Param, false>&
 );
 template std::tuple<m::wasm::Block, m::wasm::Block, m::wasm::Block> m::wasm::compile_load_sequential(
-    const Schema&, const Schema&, Ptr<void>, const storage::DataLayout&, std::size_t, const Schema&, Var<U32x1>&
+    const Schema&, const Schema&, Ptr<void>, const storage::DataLayout&, std::size_t, const Schema&, Var<U32x1>&,
+    std::optional<U32x1>
 );
 template std::tuple<m::wasm::Block, m::wasm::Block, m::wasm::Block> m::wasm::compile_load_sequential(
-    const Schema&, const Schema&, Ptr<void>, const storage::DataLayout&, std::size_t, const Schema&, Global<U32x1>&
+    const Schema&, const Schema&, Ptr<void>, const storage::DataLayout&, std::size_t, const Schema&, Global<U32x1>&,
+    std::optional<U32x1>
 );
 template std::tuple<m::wasm::Block, m::wasm::Block, m::wasm::Block> m::wasm::compile_load_sequential(
     const Schema&, const Schema&, Ptr<void>, const storage::DataLayout&, std::size_t, const Schema&,
-    Variable<uint32_t, VariableKind::Param, false>&
+    Variable<uint32_t, VariableKind::Param, false>&,
+    std::optional<U32x1>
 );
 
 namespace m {
@@ -2721,6 +3082,7 @@ void Buffer<IsGlobal>::resume_pipeline(param_t _tuple_value_schema, param_t _tup
             if (tuple_value_schema.num_entries() == 0 and tuple_addr_schema.num_entries() == 0) {
                 /*----- If no attributes must be loaded, generate a loop just executing the pipeline `size`-times. -----*/
                 WHILE (load_tuple_id < size) {
+                    break_on_pipeline_exit();
                     load_tuple_id += uint32_t(num_simd_lanes);
                     pipeline_();
                 }
@@ -2734,6 +3096,7 @@ void Buffer<IsGlobal>::resume_pipeline(param_t _tuple_value_schema, param_t _tup
                 /*----- Generate loop for loading entire buffer, with the pipeline emitted into the loop body. -----*/
                 load_inits.attach_to_current();
                 WHILE (load_tuple_id < size) {
+                    break_on_pipeline_exit();
                     loads.attach_to_current();
                     pipeline_();
                     load_jumps.attach_to_current();
@@ -2802,6 +3165,7 @@ void Buffer<IsGlobal>::execute_pipeline(setup_t setup, pipeline_t pipeline, tear
         if (tuple_value_schema.num_entries() == 0 and tuple_addr_schema.num_entries() == 0) {
             /*----- If no attributes must be loaded, generate a loop just executing the pipeline `size`-times. -----*/
             WHILE (load_tuple_id < size) {
+                break_on_pipeline_exit();
                 load_tuple_id += uint32_t(num_simd_lanes);
                 pipeline();
             }
@@ -2815,6 +3179,7 @@ void Buffer<IsGlobal>::execute_pipeline(setup_t setup, pipeline_t pipeline, tear
             /*----- Generate loop for loading entire buffer, with the pipeline emitted into the loop body. -----*/
             load_inits.attach_to_current();
             WHILE (load_tuple_id < size) {
+                break_on_pipeline_exit();
                 loads.attach_to_current();
                 pipeline();
                 load_jumps.attach_to_current();
@@ -3144,6 +3509,9 @@ _I32x1 m::wasm::strncmp(NChar _left, NChar _right, U32x1 len, bool reverse)
                         Var<Ptr<Charx1>> end_left (left  + len_left);
                         Var<Ptr<Charx1>> end_right(right + len_right);
 
+                        if (options::simd_strings)
+                            skip_equal_chunks(left, right, end_left, end_right);
+
                         LOOP() {
                             /* Check whether one side is shorter than the other. */
                             result = (left != end_left).to<int32_t>() - (right != end_right).to<int32_t>();
@@ -3214,6 +3582,9 @@ _I32x1 m::wasm::strncmp(NChar _left, NChar _right, U32x1 len, bool reverse)
                             end_right -= 1;
                         }
 
+                        if (options::simd_strings and not reverse)
+                            skip_equal_chunks(left, right, end_left, end_right);
+
                         LOOP() {
                             /* Check whether one side is shorter than the other. Load next character with in-bounds
                              * checks since the strings may not be NUL byte terminated. */
@@ -3277,6 +3648,43 @@ _I32x1 m::wasm::strcmp(NChar left, NChar right, bool reverse)
 
 _Boolx1 m::wasm::strncmp(NChar left, NChar right, U32x1 len, cmp_op op, bool reverse)
 {
+    if ((op == EQ or op == NE) and not reverse and options::string_prefix_comparison and
+        left.length() >= 4 and right.length() >= 4)
+    {
+        /*----- Decide most (in)equalities on the prefixes of both strings, i.e. without calling the character-wise
+         * comparison. -----*/
+        const bool prefix_is_entire_string = left.length() == 4 and right.length() == 4;
+        const bool can_be_null = left.can_be_null() or right.can_be_null();
+        const Var<Ptr<Charx1>> ptr_left(left.val()), ptr_right(right.val());
+        const Var<U32x1> len_(len);
+        NChar left_(ptr_left, left.can_be_null(), left.length(), left.guarantees_terminating_nul());
+        NChar right_(ptr_right, right.can_be_null(), right.length(), right.guarantees_terminating_nul());
+
+        _Var<Boolx1> result; // always set here
+        auto compare = [&](){
+            auto [decided, equal] = compare_prefixes(ptr_left, ptr_right, len_, prefix_is_entire_string);
+            IF (decided) {
+                if (op == EQ)
+                    result = _Boolx1(equal);
+                else
+                    result = _Boolx1(not equal);
+            } ELSE {
+                _I32x1 res = strncmp(left_, right_, len_, reverse);
+                result = op == EQ ? res == 0 : res != 0;
+            };
+        };
+        if (can_be_null) {
+            IF (ptr_left.is_null() or ptr_right.is_null()) {
+                result = _Boolx1::Null();
+            } ELSE {
+                compare();
+            };
+        } else {
+            compare();
+        }
+        return result;
+    }
+
     _I32x1 res = strncmp(left, right, len, reverse);
 
     switch (op) {
@@ -3291,16 +3699,9 @@ _Boolx1 m::wasm::strncmp(NChar left, NChar right, U32x1 len, cmp_op op, bool rev
 
 _Boolx1 m::wasm::strcmp(NChar left, NChar right, cmp_op op, bool reverse)
 {
-    _I32x1 res = strcmp(left, right, reverse);
-
-    switch (op) {
-        case EQ: return res == 0;
-        case NE: return res != 0;
-        case LT: return res <  0;
-        case LE: return res <= 0;
-        case GT: return res >  0;
-        case GE: return res >= 0;
-    }
+    /* Delegate to `strncmp` with length set to minimum of both string lengths **plus** 1, see `strcmp` above. */
+    U32x1 len(std::min<uint32_t>(left.length(), right.length()) + 1U);
+    return strncmp(left, right, len, op, reverse);
 }
 
 
@@ -3591,8 +3992,41 @@ _Boolx1 m::wasm::like_contains(NChar _str, const ThreadSafePooledString &_patter
                     tbl[i] = len_prefix;
                 }
 
-                /*----- Search pattern in string. -----*/
                 const Var<Ptr<Charx1>> end_str(val_str + len_ty_str);
+
+                /*----- Search candidates by the first and the last character of the pattern in chunks of 16
+                 * positions with `i8x16` instructions, see http://0x80.pl/articles/simd-strfind.html. -----*/
+                if (options::simd_strings) {
+                    const char first = pattern[0];
+                    const char last = pattern[len_pattern - 1];
+                    WHILE (val_str + (len_pattern - 1 + 16) <= end_str) {
+                        const Var<U8x16> chunk_first(load_chunk(val_str));
+                        U8x16 chunk_last = load_chunk(val_str + (len_pattern - 1));
+
+                        /* Candidates must start before the terminating NUL byte, if any. */
+                        const Var<U32x1> nul((chunk_first == U8x16(0U)).bitmask());
+                        Var<U32x1> candidates(
+                            ((chunk_first == U8x16(uint8_t(first))) and (chunk_last == U8x16(uint8_t(last)))).bitmask()
+                        );
+                        candidates = candidates bitand ((nul bitand (U32x1(0U) - nul)) - 1U); // bits below first NUL
+
+                        /* Compare the characters in between of each candidate. */
+                        WHILE (candidates != 0U) {
+                            Ptr<Charx1> candidate = val_str + candidates.ctz().make_signed();
+                            IF (equals_static(candidate + 1, pattern + 1, len_pattern - 2)) {
+                                RETURN(true);
+                            };
+                            candidates = candidates bitand (candidates - 1U); // clear lowest candidate
+                        }
+
+                        IF (nul != 0U) {
+                            RETURN(false); // reached end of string
+                        };
+                        val_str += 16;
+                    }
+                }
+
+                /*----- Search pattern in (the remainder of) string. -----*/
                 Var<I32x1> pos_pattern(0);
                 WHILE (val_str < end_str and *val_str != '\0') {
                     WHILE(pos_pattern >= 0 and *val_str != *(Ptr<Charx1>(pattern) + pos_pattern)) {
@@ -3632,58 +4066,241 @@ _Boolx1 m::wasm::like_contains(NChar _str, const ThreadSafePooledString &_patter
     }
 }
 
-_Boolx1 m::wasm::like_prefix(NChar str, const ThreadSafePooledString &pattern)
+_Boolx1 m::wasm::like_prefix(NChar _str, const ThreadSafePooledString &_pattern)
 {
-    M_insist(std::regex_match(*pattern, std::regex("[^_%\\\\]+%")), "invalid prefix pattern");
-
-    /*----- Create lower bound. -----*/
-    const int32_t len_pattern = strlen(*pattern) - 1; // minus 1 due to ending `%`
-    auto _lower_bound = Module::Allocator().raw_malloc<char>(len_pattern + 1);
-    for (std::size_t i = 0; i < len_pattern; ++i)
-        _lower_bound[i] = (*pattern)[i];
-    _lower_bound[len_pattern] = '\0';
-    NChar lower_bound(Ptr<Charx1>(_lower_bound), false, len_pattern, true);
-
-    /*----- Create upper bound. -----*/
-    auto _upper_bound = Module::Allocator().raw_malloc<char>(len_pattern + 1);
-    for (std::size_t i = 0; i < len_pattern - 1; ++i)
-        _upper_bound[i] = (*pattern)[i];
-    const char last_char = (*pattern)[len_pattern - 1];
-    _upper_bound[len_pattern - 1] = last_char + 1; // increment last character for upper bound
-    _upper_bound[len_pattern] = '\0';
-    NChar upper_bound(Ptr<Charx1>(_upper_bound), false, len_pattern, true);
-
-    /*----- Compute result by checking whether given string is in created interval. -----*/
-    auto str_cpy = str.clone();
-    return strcmp(str_cpy, lower_bound, GE) and strcmp(str, upper_bound, LT);
+    static thread_local struct {} _; // unique caller handle
+    struct data_t : GarbageCollectedData
+    {
+        public:
+        ///> one function per static pattern
+        std::unordered_map<ThreadSafePooledString, FunctionProxy<bool(int32_t, char*)>> prefix_map;
+
+        data_t(GarbageCollectedData &&d) : GarbageCollectedData(std::move(d)) { }
+    };
+    auto &d = Module::Get().add_garbage_collected_data<data_t>(&_); // garbage collect the `data_t` instance
+
+    M_insist(std::regex_match(*_pattern, std::regex("[^_%\\\\]+%")), "invalid prefix pattern");
+
+    const int32_t len_pattern = strlen(*_pattern) - 1; // minus 1 due to ending `%`
+
+    auto prefix_non_null = [&d, &_str, &_pattern, len_pattern](Ptr<Charx1> str) -> Boolx1 {
+        Wasm_insist(str.clone().not_null(), "string operand must not be NULL");
+
+        auto it = d.prefix_map.find(_pattern);
+        if (it == d.prefix_map.end()) {
+            /*----- Create function to compute the result. -----*/
+            FUNCTION(prefix, bool(int32_t, char*))
+            {
+                auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+
+                const auto len_ty_str = PARAMETER(0);
+                const auto val_str = PARAMETER(1);
+
+                /*----- Compare the first characters of the string to the pattern.  Since the pattern contains no NUL
+                 * byte, this fails for shorter strings. -----*/
+                IF (len_ty_str < len_pattern) {
+                    RETURN(false);
+                };
+                RETURN(equals_static(val_str, *_pattern, len_pattern)); // ignore ending `%`
+            }
+            it = d.prefix_map.emplace_hint(it, _pattern, std::move(prefix));
+        }
+
+        /*----- Call prefix function. ------*/
+        M_insist(it != d.prefix_map.end());
+        return (it->second)(_str.length(), str);
+    };
+
+    if (_str.can_be_null()) {
+        auto [_val_str, is_null_str] = _str.split();
+        Ptr<Charx1> val_str(_val_str); // since structured bindings cannot be used in lambda capture
+
+        _Var<Boolx1> result; // always set here
+        IF (is_null_str) {
+            result = _Boolx1::Null();
+        } ELSE {
+            result = prefix_non_null(val_str);
+        };
+        return result;
+    } else {
+        const Var<Boolx1> result(prefix_non_null(_str)); // to prevent duplicated computation due to `clone()`
+        return _Boolx1(result);
+    }
 }
 
-_Boolx1 m::wasm::like_suffix(NChar str, const ThreadSafePooledString &pattern)
+_Boolx1 m::wasm::like_suffix(NChar _str, const ThreadSafePooledString &_pattern)
 {
-    M_insist(std::regex_match(*pattern, std::regex("%[^_%\\\\]+")), "invalid suffix pattern");
-
-    /*----- Create lower bound. -----*/
-    const int32_t len_pattern = strlen(*pattern) - 1; // minus 1 due to starting `%`
-    auto _lower_bound = Module::Allocator().raw_malloc<char>(len_pattern + 1);
-    for (std::size_t i = 0; i < len_pattern; ++i)
-        _lower_bound[i] = (*pattern)[i + 1]; // access pattern with offset +1 due to starting `%`
-    _lower_bound[len_pattern] = '\0';
-    NChar lower_bound(Ptr<Charx1>(_lower_bound), false, len_pattern, true);
-
-    /*----- Create upper bound. -----*/
-    auto _upper_bound = Module::Allocator().raw_malloc<char>(len_pattern + 1);
-    const char first_char = (*pattern)[1]; // access first character at offset 1 due to starting `%`
-    _upper_bound[0] = first_char + 1; // increment first character for upper bound
-    for (std::size_t i = 1; i < len_pattern; ++i)
-        _upper_bound[i] = (*pattern)[i + 1]; // access pattern with offset +1 due to starting `%`
-    _upper_bound[len_pattern] = '\0';
-    NChar upper_bound(Ptr<Charx1>(_upper_bound), false, len_pattern, true);
-
-    /*----- Compute result by checking whether given string is in created interval when reversed. -----*/
-    const auto max_length = std::max<uint32_t>(str.length(), len_pattern); // use maximal length due to reversed strncmp
-    auto str_cpy = str.clone();
-    return strncmp(str_cpy, lower_bound, U32x1(max_length), GE, true) and
-           strncmp(str,     upper_bound, U32x1(max_length), LT, true);
+    static thread_local struct {} _; // unique caller handle
+    struct data_t : GarbageCollectedData
+    {
+        public:
+        ///> one function per static pattern
+        std::unordered_map<ThreadSafePooledString, FunctionProxy<bool(int32_t, char*)>> suffix_map;
+
+        data_t(GarbageCollectedData &&d) : GarbageCollectedData(std::move(d)) { }
+    };
+    auto &d = Module::Get().add_garbage_collected_data<data_t>(&_); // garbage collect the `data_t` instance
+
+    M_insist(std::regex_match(*_pattern, std::regex("%[^_%\\\\]+")), "invalid suffix pattern");
+
+    const int32_t len_pattern = strlen(*_pattern) - 1; // minus 1 due to starting `%`
+
+    auto suffix_non_null = [&d, &_str, &_pattern, len_pattern](Ptr<Charx1> str) -> Boolx1 {
+        Wasm_insist(str.clone().not_null(), "string operand must not be NULL");
+
+        auto it = d.suffix_map.find(_pattern);
+        if (it == d.suffix_map.end()) {
+            /*----- Create function to compute the result. -----*/
+            FUNCTION(suffix, bool(int32_t, char*))
+            {
+                auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+
+                const auto len_ty_str = PARAMETER(0);
+                auto val_str = PARAMETER(1);
+
+                /*----- Find the end of the string, i.e. its terminating NUL byte, if any. -----*/
+                const Var<Ptr<Charx1>> begin_str(val_str);
+                Var<Ptr<Charx1>> end_str(val_str + len_ty_str);
+                if (options::simd_strings) {
+                    WHILE (val_str + 16 <= end_str) {
+                        const Var<U32x1> nul((load_chunk(val_str) == U8x16(0U)).bitmask());
+                        IF (nul != 0U) {
+                            end_str = val_str + nul.ctz().make_signed();
+                        };
+                        BREAK(nul != 0U);
+                        val_str += 16;
+                    }
+                }
+                WHILE (val_str < end_str) {
+                    BREAK(*val_str == '\0');
+                    val_str += 1;
+                }
+                end_str = val_str;
+
+                /*----- Compare the last characters of the string to the pattern. -----*/
+                IF (end_str < begin_str + len_pattern) {
+                    RETURN(false);
+                };
+                RETURN(equals_static(end_str - len_pattern, *_pattern + 1, len_pattern)); // skip starting `%`
+            }
+            it = d.suffix_map.emplace_hint(it, _pattern, std::move(suffix));
+        }
+
+        /*----- Call suffix function. ------*/
+        M_insist(it != d.suffix_map.end());
+        return (it->second)(_str.length(), str);
+    };
+
+    if (_str.can_be_null()) {
+        auto [_val_str, is_null_str] = _str.split();
+        Ptr<Charx1> val_str(_val_str); // since structured bindings cannot be used in lambda capture
+
+        _Var<Boolx1> result; // always set here
+        IF (is_null_str) {
+            result = _Boolx1::Null();
+        } ELSE {
+            result = suffix_non_null(val_str);
+        };
+        return result;
+    } else {
+        const Var<Boolx1> result(suffix_non_null(_str)); // to prevent duplicated computation due to `clone()`
+        return _Boolx1(result);
+    }
+}
+
+_Boolx1 m::wasm::like_dfa(NChar _str, const ThreadSafePooledString &_pattern, const LikeDFA &dfa)
+{
+    static thread_local struct {} _; // unique caller handle
+    struct data_t : GarbageCollectedData
+    {
+        public:
+        ///> one function per static pattern
+        std::unordered_map<ThreadSafePooledString, FunctionProxy<bool(int32_t, char*)>> dfa_map;
+
+        data_t(GarbageCollectedData &&d) : GarbageCollectedData(std::move(d)) { }
+    };
+    auto &d = Module::Get().add_garbage_collected_data<data_t>(&_); // garbage collect the `data_t` instance
+
+    auto dfa_non_null = [&d, &_str, &_pattern, &dfa](Ptr<Charx1> str) -> Boolx1 {
+        Wasm_insist(str.clone().not_null(), "string operand must not be NULL");
+
+        auto it = d.dfa_map.find(_pattern);
+        if (it == d.dfa_map.end()) {
+            /*----- Create function to compute the result. -----*/
+            FUNCTION(matcher, bool(int32_t, char*))
+            {
+                auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
+
+                const auto len_ty_str = PARAMETER(0);
+                const auto val_str = PARAMETER(1);
+
+                /*----- Copy the character classes and the transition table to make them accessible with runtime
+                 * offset. -----*/
+                const int32_t num_classes = dfa.num_classes();
+                auto classes = Module::Allocator().raw_malloc<uint8_t>(256);
+                for (std::size_t i = 0; i != 256; ++i)
+                    classes[i] = dfa.classes()[i];
+                auto transitions = Module::Allocator().raw_malloc<uint16_t>(dfa.transitions().size());
+                for (std::size_t i = 0; i != dfa.transitions().size(); ++i)
+                    transitions[i] = dfa.transitions()[i];
+                auto accepting = Module::Allocator().raw_malloc<uint8_t>(dfa.num_states());
+                for (std::size_t s = 0; s != dfa.num_states(); ++s)
+                    accepting[s] = dfa.is_accepting(s);
+
+                /*----- Determine the sink states, which decide the result without consuming the rest of the string.
+                 * The minimal DFA has at most one accepting and one rejecting sink. -----*/
+                std::optional<int32_t> accepting_sink, rejecting_sink;
+                for (std::size_t s = 0; s != dfa.num_states(); ++s) {
+                    if (dfa.is_sink(s))
+                        (dfa.is_accepting(s) ? accepting_sink : rejecting_sink) = s;
+                }
+
+                /*----- Run the DFA on the string, one table lookup per character. -----*/
+                Var<Ptr<U8x1>> pos(val_str.to<void*>().to<uint8_t*>());
+                const Var<Ptr<U8x1>> end_str(pos + len_ty_str);
+                Var<I32x1> state(0);
+                WHILE (pos < end_str) {
+                    const Var<U8x1> c(*pos);
+                    BREAK(c == uint8_t(0));
+                    const I32x1 cls = (*(Ptr<U8x1>(classes) + c.to<int32_t>())).to<int32_t>();
+                    state = (*(Ptr<U16x1>(transitions) + (state * num_classes + cls))).to<int32_t>();
+                    if (accepting_sink) {
+                        IF (state == *accepting_sink) {
+                            RETURN(true);
+                        };
+                    }
+                    if (rejecting_sink) {
+                        IF (state == *rejecting_sink) {
+                            RETURN(false);
+                        };
+                    }
+                    pos += 1;
+                }
+                RETURN((*(Ptr<U8x1>(accepting) + state)).to<bool>());
+            }
+            it = d.dfa_map.emplace_hint(it, _pattern, std::move(matcher));
+        }
+
+        /*----- Call DFA function. ------*/
+        M_insist(it != d.dfa_map.end());
+        return (it->second)(_str.length(), str);
+    };
+
+    if (_str.can_be_null()) {
+        auto [_val_str, is_null_str] = _str.split();
+        Ptr<Charx1> val_str(_val_str); // since structured bindings cannot be used in lambda capture
+
+        _Var<Boolx1> result; // always set here
+        IF (is_null_str) {
+            result = _Boolx1::Null();
+        } ELSE {
+            result = dfa_non_null(val_str);
+        };
+        return result;
+    } else {
+        const Var<Boolx1> result(dfa_non_null(_str)); // to prevent duplicated computation due to `clone()`
+        return _Boolx1(result);
+    }
 }
 
 
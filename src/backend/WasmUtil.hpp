@@ -1,12 +1,16 @@
 #pragma once
 
 #include "backend/WasmDSL.hpp"
+#include "util/LikeDFA.hpp"
+#include <atomic>
 #include <functional>
+#include <iosfwd>
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/IR/PhysicalOptimizer.hpp>
 #include <mutable/parse/AST.hpp>
 #include <mutable/util/concepts.hpp>
 #include <optional>
+#include <unordered_map>
 #include <variant>
 
 #include <mutable/util/macro.hpp>
@@ -488,6 +492,14 @@ inline Bool<L> not_null(SQL_t &variant)
  * ExprCompiler
  *====================================================================================================================*/
 
+/** Returns `true` iff the value of the constant \p c can be bound late, i.e. read from an imported global at runtime
+ * instead of being embedded into the generated code. */
+bool is_late_bindable(const ast::Constant &c);
+
+/** Prints the options of the code generation of expressions and data layouts to \p out, e.g. `--no-cse` and
+ * `--touch-ahead-inodes`, s.t. they are part of the fingerprint of a compiled module, see `ModuleCache`. */
+void print_codegen_options(std::ostream &out);
+
 /** Compiles AST expressions `m::Expr` to Wasm ASTs `m::wasm::Expr<T>`.  Also supports compiling `m::cnf::CNF`s. */
 struct ExprCompiler : ast::ConstASTExprVisitor
 {
@@ -534,6 +546,12 @@ struct ExprCompiler : ast::ConstASTExprVisitor
     void operator()(const ast::FnApplicationExpr &op) override;
     void operator()(const ast::QueryExpr &op) override;
 
+    /** Sets the intermediate result to the constant \p value of type \p type. */
+    void set_constant(const Value &value, const Type *type);
+    /** Sets the intermediate result to the value of \p e if \p e is a constant expression, see `Interpreter::fold()`.
+     * Returns `true` iff \p e was folded. */
+    bool fold(const ast::Expr &e);
+
     SQL_t get() { return std::move(intermediate_result_); }
 
     template<sql_type T>
@@ -564,6 +582,8 @@ struct Environment
     std::unordered_map<Schema::Identifier, SQL_t> exprs_;
     ///> maps `Schema::Identifier`s to `Ptr<Expr<T>>`s that evaluate to the address of the current expression
     std::unordered_map<Schema::Identifier, SQL_addr_t> expr_addrs_;
+    ///> maps common subexpressions to `Expr<T>`s that load their current value, see `bind_common_subexpressions()`
+    std::unordered_map<std::reference_wrapper<const ast::Expr>, SQL_t> subexprs_;
     ///> optional predicate if predication is used
     SQL_boolean_t predicate_;
 
@@ -577,6 +597,8 @@ struct Environment
             discard(p.second);
         for (auto &p : expr_addrs_)
             discard(p.second);
+        for (auto &p : subexprs_)
+            discard(p.second);
         /* do not discard `predicate_` to make sure predication predicate is used if it was set */
     }
 
@@ -600,7 +622,11 @@ struct Environment
         return std::holds_alternative<T>(it->second);
     }
     /** Returns `true` iff this `Environment` is empty. */
-    bool empty() const { return exprs_.empty() and expr_addrs_.empty(); }
+    bool empty() const { return exprs_.empty() and expr_addrs_.empty() and subexprs_.empty(); }
+    /** Returns `true` iff this `Environment` binds the common subexpression \p e. */
+    bool has_subexpression(const ast::Expr &e) const {
+        return not subexprs_.empty() and subexprs_.find(e) != subexprs_.end();
+    }
 
     /** Clears this `Environment`. */
     void clear() {
@@ -608,8 +634,11 @@ struct Environment
             discard(p.second);
         for (auto &p : expr_addrs_)
             discard(p.second);
+        for (auto &p : subexprs_)
+            discard(p.second);
         exprs_.clear();
         expr_addrs_.clear();
+        subexprs_.clear();
     }
 
     ///> Adds a mapping from \p id to \p expr.
@@ -650,6 +679,10 @@ struct Environment
                 [this, &p](auto &e) -> void { this->add_addr(p.first, e.clone()); },
             }, p.second);
         }
+        for (auto &p : other.subexprs_) {
+            if (not has_subexpression(p.first))
+                add_subexpression(p.first, other.get_subexpression(p.first));
+        }
     }
     ///> **Moves** all entries of \p other into `this`.
     void add(Environment &&other) {
@@ -657,6 +690,22 @@ struct Environment
         M_insist(other.exprs_.empty(), "duplicate ID not moved from other to this");
         this->expr_addrs_.merge(other.expr_addrs_);
         M_insist(other.expr_addrs_.empty(), "duplicate ID not moved from other to this");
+        this->subexprs_.merge(other.subexprs_); // duplicates remain in `other` and are discarded with it
+    }
+
+    ///> Binds the common subexpression \p e to \p value.
+    void add_subexpression(const ast::Expr &e, SQL_t &&value) {
+        auto res = subexprs_.emplace(e, std::move(value));
+        M_insist(res.second, "duplicate subexpression");
+    }
+    ///> Returns the **copied** value of the common subexpression \p e.
+    SQL_t get_subexpression(const ast::Expr &e) const {
+        auto it = subexprs_.find(e);
+        M_insist(it != subexprs_.end(), "subexpression not found");
+        return std::visit(overloaded {
+            [](auto &e) -> SQL_t { return e.clone(); },
+            [](std::monostate) -> SQL_t { M_unreachable("invalid expression"); },
+        }, it->second);
     }
 
     ///> Returns the **moved** entry for identifier \p id.
@@ -813,6 +862,46 @@ struct Environment
 };
 
 
+/*======================================================================================================================
+ * MorselQueue
+ *====================================================================================================================*/
+
+/** A thread-safe work queue that hands out *morsels*, i.e. consecutive row ranges of fixed size, of a single table to
+ * the workers executing a scan of that table.  Claiming a morsel is a single atomic increment, hence any number of
+ * workers may share one queue.  The number of rows is given by each claim, since the generated code reads it at
+ * runtime and a module may be reused after rows were appended.
+ *
+ * Currently, the generated code is the only worker, i.e. scans claim their morsels one after another on a single
+ * thread. */
+struct MorselQueue
+{
+    private:
+    std::atomic<uint64_t> next_ = 0; ///< the first row of the next unclaimed morsel
+    uint32_t morsel_size_; ///< the number of rows per morsel
+
+    public:
+    MorselQueue(uint32_t morsel_size)
+        : morsel_size_(morsel_size)
+    {
+        M_insist(morsel_size_ != 0, "morsels must not be empty");
+    }
+    MorselQueue(const MorselQueue&) = delete;
+
+    uint32_t morsel_size() const { return morsel_size_; }
+
+    /** Claims the next morsel of a table of \p num_rows rows and returns its first row.  Returns \p num_rows if all
+     * morsels were claimed already.  The claimed morsel ends at the minimum of the returned row plus `morsel_size()`
+     * and \p num_rows. */
+    uint32_t claim(uint32_t num_rows) {
+        const uint64_t begin = next_.fetch_add(morsel_size_, std::memory_order_relaxed);
+        return begin < num_rows ? uint32_t(begin) : num_rows;
+    }
+
+    /** Makes all morsels available again, e.g. to rerun the scan. */
+    void reset() { next_.store(0, std::memory_order_relaxed); }
+};
+
+
 /*======================================================================================================================
  * CodeGenContext
  *====================================================================================================================*/
@@ -845,6 +934,9 @@ struct Scope
  * - an `ExprCompiler` to compile expressions within the current `Environment`
  * - the number of tuples written to the result set
  * / the number of SIMD lanes currently used
+ * - the `MorselQueue`s of morsel-driven scans
+ * - the late-bound constants, i.e. parameters, read from imported globals
+ * - the flags by which operators needing no further input, e.g. `Limit`, exit the loops driving their input
  */
 struct CodeGenContext
 {
@@ -858,6 +950,18 @@ struct CodeGenContext
     std::size_t num_simd_lanes_ = 1;
     ///> number of SIMD lanes currently preferred, i.e. 1 for scalar and at least 2 for vectorial values
     std::size_t num_simd_lanes_preferred_ = 1;
+    ///> the morsel queues of all morsel-driven scans, indexed by the ID returned from `add_morsel_queue()`
+    std::vector<std::unique_ptr<MorselQueue>> morsel_queues_;
+    ///> whether the generated module depends only on the plan, i.e. may be reused for another execution of that plan
+    bool is_module_reusable_ = true;
+    ///> maps each late-bound constant to its parameter index
+    std::unordered_map<const ast::Constant*, std::size_t> parameters_;
+    ///> whether the global of the parameter with the respective index was already imported
+    std::vector<bool> parameter_imported_;
+    ///> the estimated number of tuples processed by each function into which pipelines were emitted
+    std::unordered_map<const ::wasm::Function*, double> estimated_work_;
+    ///> the flags of all operators whose input pipelines are currently emitted and which may need no further input
+    std::vector<const Global<Boolx1>*> pipeline_exits_;
 
     public:
     CodeGenContext() = default;
@@ -934,8 +1038,101 @@ struct CodeGenContext
     void update_num_simd_lanes_preferred(std::size_t n) {
         num_simd_lanes_preferred_ = std::max(num_simd_lanes_preferred_, n);
     }
+
+    /** Adds a `MorselQueue` distributing rows in morsels of \p morsel_size rows and returns its ID. */
+    std::size_t add_morsel_queue(uint32_t morsel_size) {
+        morsel_queues_.emplace_back(std::make_unique<MorselQueue>(morsel_size));
+        return morsel_queues_.size() - 1;
+    }
+    /** Returns the `MorselQueue` with ID \p id. */
+    MorselQueue & morsel_queue(std::size_t id) {
+        M_insist(id < morsel_queues_.size(), "unknown morsel queue");
+        return *morsel_queues_[id];
+    }
+    /** Returns the number of `MorselQueue`s. */
+    std::size_t num_morsel_queues() const { return morsel_queues_.size(); }
+
+    /** Adds \p num_tuples to the estimated number of tuples processed by function \p fn, e.g. because the pipeline
+     * of an operator producing an estimated number of \p num_tuples tuples is emitted into \p fn. */
+    void add_estimated_work(const ::wasm::Function &fn, double num_tuples) { estimated_work_[&fn] += num_tuples; }
+    /** Returns the estimated number of tuples processed by function \p fn, or `std::nullopt` if no pipeline was
+     * emitted into \p fn. */
+    std::optional<double> estimated_work(const ::wasm::Function &fn) const {
+        if (auto it = estimated_work_.find(&fn); it != estimated_work_.end())
+            return it->second;
+        return std::nullopt;
+    }
+
+    /** Returns `true` iff the generated module may be reused for another execution of the same plan. */
+    bool is_module_reusable() const { return is_module_reusable_; }
+    /** Marks the generated module as not reusable, e.g. because it embeds the result of evaluating data at compile
+     * time. */
+    void mark_module_not_reusable() { is_module_reusable_ = false; }
+
+    /** Adds the late-bound constant \p c and returns its parameter index. */
+    std::size_t add_parameter(const ast::Constant &c) {
+        M_insist(is_late_bindable(c), "constant cannot be bound late");
+        auto [it, inserted] = parameters_.emplace(&c, parameter_imported_.size());
+        if (inserted)
+            parameter_imported_.push_back(false);
+        return it->second;
+    }
+    /** Returns the parameter index of \p c if it is bound late, and `std::nullopt` otherwise. */
+    std::optional<std::size_t> parameter_index(const ast::Constant &c) const {
+        if (auto it = parameters_.find(&c); it != parameters_.end())
+            return it->second;
+        return std::nullopt;
+    }
+    /** Returns the number of parameters. */
+    std::size_t num_parameters() const { return parameter_imported_.size(); }
+    /** Marks the global of the parameter with index \p idx imported.  Returns `true` iff it was not imported before,
+     * i.e. iff the import must be emitted. */
+    bool import_parameter(std::size_t idx) {
+        M_insist(idx < parameter_imported_.size(), "unknown parameter");
+        return not std::exchange(parameter_imported_[idx], true);
+    }
+    /** Returns the name of the imported global holding the value of the parameter with index \p idx. */
+    static std::string Parameter_Name(std::size_t idx) { return "param_" + std::to_string(idx); }
+
+    /** Registers \p flag s.t. the loops driving the pipelines emitted from now on, e.g. scans and buffers, are exited
+     * once \p flag is set, i.e. once the registering operator needs no further input.  Must be unregistered by
+     * `pop_pipeline_exit()` after the operator's input is emitted. */
+    void push_pipeline_exit(const Global<Boolx1> &flag) { pipeline_exits_.push_back(&flag); }
+    /** Unregisters the lastly registered flag, see `push_pipeline_exit()`. */
+    void pop_pipeline_exit() {
+        M_insist(not pipeline_exits_.empty(), "no flag registered");
+        pipeline_exits_.pop_back();
+    }
+    /** Unregisters all flags and returns them, e.g. while the code of an operator's consumers is emitted whose loops
+     * must not be exited.  Register them again by `restore_pipeline_exits()`. */
+    std::vector<const Global<Boolx1>*> suspend_pipeline_exits() { return std::exchange(pipeline_exits_, {}); }
+    /** Registers the flags \p exits again which were returned by `suspend_pipeline_exits()`. */
+    void restore_pipeline_exits(std::vector<const Global<Boolx1>*> exits) {
+        M_insist(pipeline_exits_.empty(), "flags must not be registered while suspended");
+        pipeline_exits_ = std::move(exits);
+    }
+    /** Returns a condition which is `true` iff any registered flag is set, i.e. iff the current loop driving a pipeline
+     * is to be exited, or `std::nullopt` if no flag is registered. */
+    std::optional<Boolx1> pipeline_exit() const {
+        std::optional<Boolx1> exit;
+        for (auto flag : pipeline_exits_) {
+            if (exit)
+                exit.emplace(*exit or Boolx1(*flag));
+            else
+                exit.emplace(*flag);
+        }
+        return exit;
+    }
 };
 
+/** Emits a break of the innermost loop, if the loop is to be exited since the pipeline driven by it is not needed
+ * anymore, see `CodeGenContext::push_pipeline_exit()`.  Must be emitted directly into the body of the loop. */
+inline void break_on_pipeline_exit()
+{
+    if (auto exit = CodeGenContext::Get().pipeline_exit())
+        BREAK(*exit);
+}
+
 inline Scope::Scope(Environment inner)
     : inner_(std::move(inner))
 {
@@ -999,7 +1196,8 @@ compile_store_sequential_single_pass(const Schema &tuple_value_schema, const Sch
  * tuples of schema \p tuple_value_schema starting at memory address \p base_address and tuple ID \p tuple_id.  The given
  * variable \p tuple_id will be incremented automatically before advancing to the next tuple (i.e. code for this will
  * be emitted at the start of the block returned as third element).  SIMDfication is supported and will be emitted
- * iff \p num_simd_lanes is greater than 1.
+ * iff \p num_simd_lanes is greater than 1.  If the number of tuples \p num_tuples is given, the accessed columns of
+ * INodes ahead, e.g. of the next PAX block, are touched when entering an INode, see `--touch-ahead-inodes`.
  *
  * Does not emit any code but returns three `wasm::Block`s containing code: the first one initializes all needed
  * variables, the second one loads one tuple, and the third one advances to the next tuple.  Additionally, if not
@@ -1009,7 +1207,7 @@ template<VariableKind Kind>
 std::tuple<Block, Block, Block>
 compile_load_sequential(const Schema &tuple_value_schema, const Schema &tuple_addr_schema, Ptr<void> base_address,
                         const storage::DataLayout &layout, std::size_t num_simd_lanes, const Schema &layout_schema,
-                        Variable<uint32_t, Kind, false> &tuple_id);
+                        Variable<uint32_t, Kind, false> &tuple_id, std::optional<U32x1> num_tuples = std::nullopt);
 
 /** Compiles the data layout \p layout starting at memory address \p base_address and containing tuples of schema
  * \p layout_schema such that it stores the single tuple with schema \p tuple_value_schema and ID \p tuple_id.
@@ -1325,7 +1523,8 @@ enum cmp_op
     EQ, NE, LT, LE, GT, GE
 };
 
-/** Compares two strings \p left and \p right.  Has similar semantics to `strncmp` of libc. */
+/** Compares two strings \p left and \p right.  Has similar semantics to `strncmp` of libc.  Unless \p reverse, the
+ * common prefix of both strings is skipped in chunks of 16 characters using `i8x16` instructions. */
 _I32x1 strncmp(NChar left, NChar right, U32x1 len, bool reverse = false);
 /** Compares two strings \p left and \p right.  Has similar semantics to `strcmp` of libc. */
 _I32x1 strcmp(NChar left, NChar right, bool reverse = false);
@@ -1353,18 +1552,35 @@ Ptr<Charx1> strncpy(Ptr<Charx1> dst, Ptr<Charx1> src, U32x1 count);
 /** Checks whether the string \p str matches the pattern \p pattern regarding SQL LIKE semantics using escape
  * character \p escape_char. */
 _Boolx1 like(NChar str, NChar pattern, const char escape_char = '\\');
-/** Checks whether the string \p str contains the pattern \p pattern.  The implementation is based on the
- * Knuth–Morris–Pratt algorithm and represents a special case of the SQL LIKE in which the pattern is known at query
- * compile time and has the form `%[^_%\\]+%`. */
+/** Checks whether the string \p str contains the pattern \p pattern.  The implementation filters candidate positions
+ * by the first and the last character of the pattern in chunks of 16 positions using `i8x16` instructions and falls
+ * back to the Knuth–Morris–Pratt algorithm for the remainder of the string.  It represents a special case of the SQL
+ * LIKE in which the pattern is known at query compile time and has the form `%[^_%\\]+%`. */
 _Boolx1 like_contains(NChar str, const ThreadSafePooledString &pattern);
-/** Checks whether the string \p str has the prefix \p pattern.  The implementation is based on rewriting to string
- * comparisons and represents a special case of the SQL LIKE in which the pattern is known at query compile time and
- * has the form `[^_%\\]+%`. */
+/** Checks whether the string \p str has the prefix \p pattern.  The implementation compares the string to the pattern
+ * in chunks of 16 characters using `i8x16` instructions and represents a special case of the SQL LIKE in which the
+ * pattern is known at query compile time and has the form `[^_%\\]+%`. */
 _Boolx1 like_prefix(NChar str, const ThreadSafePooledString &pattern);
-/** Checks whether the string \p str has the suffix \p pattern.  The implementation is based on rewriting to string
- * comparisons and represents a special case of the SQL LIKE in which the pattern is known at query compile time and
- * has the form `%[^_%\\]+`. */
+/** Checks whether the string \p str has the suffix \p pattern.  The implementation searches the end of the string and
+ * compares the string to the pattern in chunks of 16 characters using `i8x16` instructions.  It represents a special
+ * case of the SQL LIKE in which the pattern is known at query compile time and has the form `%[^_%\\]+`. */
 _Boolx1 like_suffix(NChar str, const ThreadSafePooledString &pattern);
+/** Checks whether the string \p str matches the pattern \p pattern by running \p dfa, the DFA compiled from \p
+ * pattern, with a single table lookup per character of the string.  This is the general case of the SQL LIKE in which
+ * the pattern is known at query compile time.  Functions are generated once per pattern. */
+_Boolx1 like_dfa(NChar str, const ThreadSafePooledString &pattern, const LikeDFA &dfa);
+
+
+/*======================================================================================================================
+ * Common subexpression elimination
+ *====================================================================================================================*/
+
+/** Binds each composite subexpression, i.e. unary and binary expression or non-aggregate function application, that
+ * occurs more than once among \p exprs to a variable in \p env.  Hence, the subexpression is evaluated only once per
+ * tuple and compiling any of its occurrences with \p env, or with an `Environment` copied from it, loads the variable.
+ * Must be called where the variables dominate all uses, i.e. before any of \p exprs is compiled.  Subexpressions of
+ * character sequence type are not bound.  Has no effect if common subexpression elimination is disabled. */
+void bind_common_subexpressions(Environment &env, const std::vector<std::reference_wrapper<const ast::Expr>> &exprs);
 
 
 /*======================================================================================================================
@@ -1426,14 +1642,17 @@ extern template std::tuple<Block, Block, Block> compile_store_sequential_single_
     Variable<uint32_t, VariableKind::Param, false>&
 );
 extern template std::tuple<Block, Block, Block> compile_load_sequential(
-    const Schema&, const Schema&, Ptr<void>, const storage::DataLayout&, std::size_t, const Schema&, Var<U32x1>&
+    const Schema&, const Schema&, Ptr<void>, const storage::DataLayout&, std::size_t, const Schema&, Var<U32x1>&,
+    std::optional<U32x1>
 );
 extern template std::tuple<Block, Block, Block> compile_load_sequential(
-    const Schema&, const Schema&, Ptr<void>, const storage::DataLayout&, std::size_t, const Schema&, Global<U32x1>&
+    const Schema&, const Schema&, Ptr<void>, const storage::DataLayout&, std::size_t, const Schema&, Global<U32x1>&,
+    std::optional<U32x1>
 );
 extern template std::tuple<Block, Block, Block> compile_load_sequential(
     const Schema&, const Schema&, Ptr<void>, const storage::DataLayout&, std::size_t, const Schema&,
-    Variable<uint32_t, VariableKind::Param, false>&
+    Variable<uint32_t, VariableKind::Param, false>&,
+    std::optional<U32x1>
 );
 extern template struct Buffer<false>;
 extern template struct Buffer<true>;
@@ -1,6 +1,7 @@
 #include "backend/WebAssembly.hpp"
 
 #include "backend/WasmOperator.hpp"
+#include <algorithm>
 #include <binaryen-c.h>
 #include <iostream>
 #include <sys/mman.h>
@@ -10,6 +11,20 @@
 using namespace m;
 
 
+void m::advise_wasm_mapping(void *addr, std::size_t size, bool is_written)
+{
+    M_insist(Is_Page_Aligned(reinterpret_cast<uintptr_t>(addr)));
+#if __linux
+    if (options::wasm_huge_pages)
+        M_DISCARD madvise(addr, size, MADV_HUGEPAGE);
+#ifdef MADV_POPULATE_WRITE
+    if (const auto prefault_size = std::min(Ceil_To_Next_Page(options::wasm_prefault_size), size))
+        M_DISCARD madvise(addr, prefault_size, is_written ? MADV_POPULATE_WRITE : MADV_POPULATE_READ);
+#endif
+#endif
+}
+
+
 /*======================================================================================================================
  * WasmModule
  *====================================================================================================================*/
@@ -79,6 +94,7 @@ uint32_t WasmEngine::WasmContext::map_table(const Table &table)
     const auto &mem = table.store().memory();
     if (aligned_bytes) {
         mem.map(aligned_bytes, 0, vm, off);
+        advise_wasm_mapping(vm.as<uint8_t*>() + off, aligned_bytes, /* is_written= */ false);
         heap += aligned_bytes;
         install_guard_page();
     }
@@ -13,6 +13,11 @@ struct Expression;
 
 namespace m {
 
+/** Advises the kernel about the mapping of \p size bytes at the page aligned address \p addr into the Wasm memory
+ * according to `options::wasm_huge_pages` and `options::wasm_prefault_size`.  The mapping is prefaulted for writing
+ * iff \p is_written.  Failing advice is ignored since it only affects performance. */
+void advise_wasm_mapping(void *addr, std::size_t size, bool is_written);
+
 /** A `WasmModule` is a wrapper around a [**Binaryen**] (https://github.com/WebAssembly/binaryen) `wasm::Module`. */
 struct WasmModule
 {
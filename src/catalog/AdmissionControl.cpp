@@ -0,0 +1,149 @@
+#include "catalog/AdmissionControl.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/util/fn.hpp>
+#include <vector>
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** The memory budget of all concurrently executed queries, in bytes; 0 disables admission control. */
+std::size_t memory_budget = 0;
+/** The estimated peak memory, in bytes, up to which a query is admitted immediately. */
+std::size_t fast_track_size = 16UL << 20; // 16 MiB
+
+}
+
+__attribute__((constructor(201)))
+static void add_admission_control_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Catalog",
+        /* short=       */ nullptr,
+        /* long=        */ "--memory-budget",
+        /* description= */ "admit queries for execution s.t. their estimated peak memory, in bytes, fits into this "
+                           "budget (0 admits all queries)",
+        /* callback=    */ [](std::size_t budget){ options::memory_budget = budget; }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Catalog",
+        /* short=       */ nullptr,
+        /* long=        */ "--admission-fast-track-size",
+        /* description= */ "admit queries whose estimated peak memory, in bytes, is at most this size immediately",
+        /* callback=    */ [](std::size_t size){ options::fast_track_size = size; }
+    );
+}
+
+///> the factor by which a hash table exceeds the size of its entries, accounting for its load factor and capacity margin
+constexpr double HASH_TABLE_OVERHEAD = 2.;
+
+/** Returns the size in bytes of an entry of a hash table or buffer holding tuples of \p schema.  Like the hash tables
+ * of the WebAssembly backend, see `HashTable::set_byte_offsets()`, values are sorted by their alignment and the entry
+ * is padded to the largest alignment.  A NULL bitmap is added for the nullable values. */
+std::size_t entry_size_in_bytes(const Schema &schema)
+{
+    std::vector<const Type*> types;
+    std::size_t num_nullable = 0;
+    for (auto &e : schema.deduplicate()) {
+        if (e.type->is_none()) continue; // NULL constants are not stored
+        types.push_back(e.type);
+        num_nullable += e.nullable();
+    }
+    std::stable_sort(types.begin(), types.end(), [](const Type *left, const Type *right) {
+        return left->alignment() > right->alignment();
+    });
+
+    std::size_t size_in_bytes = (num_nullable + 7) / 8;
+    std::size_t max_alignment_in_bytes = 1;
+    for (auto ty : types) {
+        size_in_bytes += (ty->size() + 7) / 8;
+        max_alignment_in_bytes = std::max<std::size_t>(max_alignment_in_bytes, (ty->alignment() + 7) / 8);
+    }
+    if (const auto rem = size_in_bytes % max_alignment_in_bytes; rem)
+        size_in_bytes += max_alignment_in_bytes - rem;
+    return size_in_bytes;
+}
+
+/** Returns the estimated cardinality of \p op, or 0 if \p op has no estimate. */
+double cardinality(const Operator &op) { return op.has_info() ? op.info().estimated_cardinality : 0.; }
+
+}
+
+AdmissionControl & AdmissionControl::Get()
+{
+    static AdmissionControl the_admission_control;
+    return the_admission_control;
+}
+
+bool AdmissionControl::enabled() { return options::memory_budget != 0; }
+
+std::size_t AdmissionControl::Estimate_Peak_Memory(const Operator &plan)
+{
+    double size_in_bytes = 0.;
+    auto estimate = [&size_in_bytes](const Operator &op, auto &estimate_rec) -> void {
+        if (auto join = cast<const JoinOperator>(&op)) {
+            /* All but the largest child are built into hash tables. */
+            double largest = 0., sum = 0.;
+            for (auto child : join->children()) {
+                const double child_size =
+                    HASH_TABLE_OVERHEAD * cardinality(*child) * entry_size_in_bytes(child->schema());
+                largest = std::max(largest, child_size);
+                sum += child_size;
+            }
+            size_in_bytes += sum - largest;
+        } else if (is<const GroupingOperator>(op)) {
+            size_in_bytes += HASH_TABLE_OVERHEAD * cardinality(op) * entry_size_in_bytes(op.schema());
+        } else if (auto sorting = cast<const SortingOperator>(&op)) {
+            auto &child = *sorting->child(0);
+            size_in_bytes += cardinality(child) * entry_size_in_bytes(child.schema());
+        }
+
+        if (auto c = cast<const Consumer>(&op)) {
+            for (auto child : c->children())
+                estimate_rec(*child, estimate_rec);
+        }
+    };
+    estimate(plan, estimate);
+    return std::ceil(size_in_bytes);
+}
+
+AdmissionControl::Ticket AdmissionControl::admit(std::size_t size_in_bytes)
+{
+    if (not enabled())
+        return Ticket();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (size_in_bytes > options::fast_track_size) {
+        /* Queue the query and wait until it is the next one and its memory fits into the budget, or until it is the
+         * only query holding memory. */
+        const uint64_t ticket = next_ticket_++;
+        released_.wait(lock, [&]() {
+            return ticket == now_serving_ and
+                   (in_use_ + size_in_bytes <= options::memory_budget or in_use_ == 0);
+        });
+        ++now_serving_;
+        released_.notify_all(); // the next queued query may fit as well
+    }
+    in_use_ += size_in_bytes;
+    return Ticket(*this, size_in_bytes);
+}
+
+void AdmissionControl::release(std::size_t size_in_bytes)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        M_insist(in_use_ >= size_in_bytes);
+        in_use_ -= size_in_bytes;
+    }
+    released_.notify_all();
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/Operator.hpp>
+#include <mutex>
+
+
+namespace m {
+
+/** Admits queries for execution against a global memory budget, see `--memory-budget`, such that concurrently
+ * executed queries do not overcommit memory.  The peak memory of a query is estimated from its plan, see
+ * `Estimate_Peak_Memory()`.  A *small* query, whose estimate is at most `--admission-fast-track-size`, is admitted
+ * immediately.  A large query is queued and admitted in the order of arrival once the memory of the admitted queries
+ * and its own estimate fit into the budget.  A query exceeding the budget on its own is admitted once no other query
+ * holds memory.  Hence, the memory in use exceeds the budget by at most the estimates of the small queries. */
+struct AdmissionControl
+{
+    /** Holds the memory of an admitted query and releases it when destroyed, i.e. when the query finished. */
+    struct Ticket
+    {
+        friend struct AdmissionControl;
+
+        private:
+        AdmissionControl *admission_control_ = nullptr;
+        std::size_t size_in_bytes_ = 0;
+
+        Ticket(AdmissionControl &admission_control, std::size_t size_in_bytes)
+            : admission_control_(&admission_control)
+            , size_in_bytes_(size_in_bytes)
+        { }
+
+        public:
+        Ticket() = default;
+        Ticket(const Ticket&) = delete;
+        Ticket(Ticket &&other) { swap(*this, other); }
+        ~Ticket() { if (admission_control_) admission_control_->release(size_in_bytes_); }
+
+        Ticket & operator=(Ticket other) { swap(*this, other); return *this; }
+
+        friend void swap(Ticket &first, Ticket &second) {
+            using std::swap;
+            swap(first.admission_control_, second.admission_control_);
+            swap(first.size_in_bytes_, second.size_in_bytes_);
+        }
+
+        /** Returns the estimated peak memory of the admitted query, in bytes. */
+        std::size_t size_in_bytes() const { return size_in_bytes_; }
+    };
+
+    private:
+    std::size_t in_use_ = 0; ///< the estimated memory of all admitted queries, in bytes
+    uint64_t next_ticket_ = 0; ///< the number drawn by the next queued query
+    uint64_t now_serving_ = 0; ///< the number of the queued query to admit next
+    std::mutex mutex_;
+    std::condition_variable released_; ///< signals queued queries that memory was released or a query was admitted
+
+    AdmissionControl() = default;
+
+    public:
+    static AdmissionControl & Get();
+
+    /** Returns `true` iff queries are admitted against a memory budget, i.e. a budget is given. */
+    static bool enabled();
+
+    /** Returns an estimate of the peak memory, in bytes, of executing the logical plan \p plan.  The estimate sums up
+     * the memory of the operators that materialize their input, i.e. of the hash tables of joins and groupings and of
+     * the buffers of sorting, computed from the estimated cardinalities and the widths of the tuples. */
+    static std::size_t Estimate_Peak_Memory(const Operator &plan);
+
+    /** Admits a query with estimated peak memory of \p size_in_bytes, waiting as described above.  The memory is held
+     * until the returned ticket is destroyed.  Returns immediately if admission control is not enabled. */
+    Ticket admit(std::size_t size_in_bytes);
+
+    private:
+    void release(std::size_t size_in_bytes);
+};
+
+}
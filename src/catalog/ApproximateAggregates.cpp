@@ -0,0 +1,194 @@
+#include "catalog/ApproximateAggregates.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "catalog/SpnWrapper.hpp"
+#include <cmath>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/IR/Operator.hpp>
+#include <mutable/parse/AST.hpp>
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** Whether to answer simple aggregate queries approximately from the SPNs of their tables. */
+bool approximate_aggregates = false;
+
+}
+
+__attribute__((constructor(201)))
+static void add_approximate_aggregates_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<bool>(
+        /* group=       */ "Cardinality estimation",
+        /* short=       */ nullptr,
+        /* long=        */ "--approximate-aggregates",
+        /* description= */ "answer COUNT, SUM, and AVG over a single table approximately from its SPN, if any, "
+                           "without scanning the table",
+        /* callback=    */ [](bool b){ options::approximate_aggregates = b; }
+    );
+}
+
+/** Returns the attribute \p e designates, or `nullptr` if \p e is not a designator of an attribute. */
+const Attribute * get_attribute(const ast::Expr &e)
+{
+    if (auto D = cast<const ast::Designator>(&e)) {
+        if (auto attr = std::get_if<const Attribute*>(&D->target()))
+            return *attr;
+    }
+    return nullptr;
+}
+
+/** Returns the value of the numeric constant \p e as `float`, or `std::nullopt` if \p e is no numeric constant. */
+std::optional<float> get_constant(const ast::Expr &e)
+{
+    auto c = cast<const ast::Constant>(&e);
+    if (not c) return std::nullopt;
+    auto n = cast<const Numeric>(c->type());
+    if (not n) return std::nullopt;
+    auto value = Interpreter::eval(*c);
+    switch (n->kind) {
+        case Numeric::N_Int:     return float(value.as_i());
+        case Numeric::N_Float:   return n->precision == 32 ? value.as_f() : float(value.as_d());
+        case Numeric::N_Decimal: return float(value.as_i() / std::pow(10., n->scale));
+    }
+}
+
+/** Translates \p filter to a filter of \p spn.  Returns `std::nullopt` if \p filter is not a conjunction of
+ * comparisons of distinct attributes of \p spn with numeric constants. */
+std::optional<SpnWrapper::Filter> translate_filter(const cnf::CNF &filter, const SpnWrapper &spn)
+{
+    SpnWrapper::Filter spn_filter;
+    for (auto &clause : filter) {
+        if (clause.size() != 1 or clause[0].negative()) return std::nullopt;
+        auto binary = cast<const ast::BinaryExpr>(&clause[0].expr());
+        if (not binary) return std::nullopt;
+
+        /* Normalize the comparison to `attribute op constant`. */
+        bool mirrored = false;
+        const Attribute *attr = get_attribute(*binary->lhs);
+        std::optional<float> value = get_constant(*binary->rhs);
+        if (not attr) {
+            attr = get_attribute(*binary->rhs);
+            value = get_constant(*binary->lhs);
+            mirrored = true;
+        }
+        if (not attr or not value) return std::nullopt;
+
+        Spn::SpnOperator op;
+        switch (binary->op().type) {
+            default:                return std::nullopt;
+            case TK_EQUAL:          op = Spn::EQUAL; break;
+            case TK_LESS:           op = mirrored ? Spn::GREATER : Spn::LESS; break;
+            case TK_LESS_EQUAL:     op = mirrored ? Spn::GREATER_EQUAL : Spn::LESS_EQUAL; break;
+            case TK_GREATER:        op = mirrored ? Spn::LESS : Spn::GREATER; break;
+            case TK_GREATER_EQUAL:  op = mirrored ? Spn::LESS_EQUAL : Spn::GREATER_EQUAL; break;
+        }
+
+        auto it = spn.get_attribute_to_id().find(attr->name);
+        if (it == spn.get_attribute_to_id().end()) return std::nullopt;
+        /* An SPN filter holds a single condition per attribute, e.g. ranges cannot be expressed. */
+        if (not spn_filter.emplace(it->second, std::make_pair(op, *value)).second) return std::nullopt;
+    }
+    return spn_filter;
+}
+
+/** Converts \p value to a `Value` of type \p ty, or returns `std::nullopt` if \p ty is not numeric. */
+std::optional<Value> to_value(double value, const Type *ty)
+{
+    auto n = cast<const Numeric>(ty);
+    if (not n) return std::nullopt;
+    switch (n->kind) {
+        case Numeric::N_Int:     return Value(int64_t(std::llround(value)));
+        case Numeric::N_Float:   return n->precision == 32 ? Value(float(value)) : Value(value);
+        case Numeric::N_Decimal: return Value(int64_t(std::llround(value * std::pow(10., n->scale))));
+    }
+}
+
+}
+
+bool ApproximateAggregates::enabled() { return options::approximate_aggregates; }
+
+std::optional<ApproximateAggregates::answer_type>
+ApproximateAggregates::answer(const ThreadSafePooledString &database_name, const QueryGraph &G)
+{
+    /*----- Check whether the query is supported. -----*/
+    if (G.sources().size() != 1) return std::nullopt;
+    auto bt = cast<const BaseTable>(G.sources()[0].get());
+    if (not bt) return std::nullopt;
+    if (not G.group_by().empty() or G.aggregates().empty()) return std::nullopt;
+    if (not G.order_by().empty() or G.limit().limit or G.limit().offset) return std::nullopt;
+    if (G.projections().empty()) return std::nullopt;
+    for (auto &[proj, _] : G.projections()) {
+        auto fe = cast<const ast::FnApplicationExpr>(&proj.get());
+        if (not fe or not fe->has_function()) return std::nullopt; // only aggregates, no expressions of them
+        switch (fe->get_function().fnid) {
+            default:
+                return std::nullopt;
+            case Function::FN_COUNT:
+                if (not fe->args.empty()) return std::nullopt; // only `COUNT(*)`, NULLs are not modelled
+                break;
+            case Function::FN_SUM:
+            case Function::FN_AVG:
+                if (fe->args.size() != 1 or not get_attribute(*fe->args[0])) return std::nullopt;
+                break;
+        }
+    }
+
+    std::optional<answer_type> answer;
+    SpnMaintenance::Get().with_spn(database_name, bt->table().name(), [&](const SpnWrapper &spn) {
+        auto filter = translate_filter(bt->filter(), spn);
+        if (not filter) return;
+
+        const double num_rows = spn.num_rows();
+        const double p = spn.likelihood(*filter);
+        const double p_lo = std::min<double>(p, spn.lower_bound(*filter));
+        const double p_hi = std::max<double>(p, spn.upper_bound(*filter));
+
+        ProjectionOperator projection(G.projections());
+        answer_type result{ .schema = projection.schema(), .row = Tuple(projection.schema()), .bounds = {} };
+
+        std::size_t idx = 0;
+        for (auto &[proj, _] : G.projections()) {
+            auto &fe = as<const ast::FnApplicationExpr>(proj.get());
+            double estimate, lo, hi;
+            if (fe.get_function().fnid == Function::FN_COUNT) {
+                estimate = p * num_rows;
+                lo = p_lo * num_rows;
+                hi = p_hi * num_rows;
+            } else {
+                auto attr = get_attribute(*fe.args[0]);
+                auto it = spn.get_attribute_to_id().find(attr->name);
+                /* The expectation adds a condition on the aggregated attribute, which must not be filtered. */
+                if (it == spn.get_attribute_to_id().end() or filter->contains(it->second)) return;
+                if (p == 0) { // no qualifying rows, hence `SUM` and `AVG` are `NULL`
+                    result.row.null(idx++);
+                    result.bounds.emplace_back(0, 0);
+                    continue;
+                }
+                const double avg = spn.expectation(it->second, *filter);
+                if (fe.get_function().fnid == Function::FN_AVG) {
+                    estimate = lo = hi = avg;
+                } else {
+                    estimate = avg * p * num_rows;
+                    lo = std::min(avg * p_lo, avg * p_hi) * num_rows;
+                    hi = std::max(avg * p_lo, avg * p_hi) * num_rows;
+                }
+            }
+            auto value = to_value(estimate, result.schema[idx].type);
+            if (not value) return;
+            result.row.set(idx++, *value);
+            result.bounds.emplace_back(lo, hi);
+        }
+        answer = std::move(result);
+    });
+    return answer;
+}
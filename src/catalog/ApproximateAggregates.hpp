@@ -0,0 +1,39 @@
+#pragma once
+
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/QueryGraph.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/util/Pool.hpp>
+#include <optional>
+#include <utility>
+#include <vector>
+
+
+namespace m {
+
+/** Answers simple aggregate queries approximately from the SPN of the queried table rather than by scanning it, as
+ * proposed by DeepDB.  A query is answered iff it reads a single table with a registered SPN, see `SpnMaintenance`,
+ * neither groups nor orders nor limits, only selects `COUNT`, `SUM`, and `AVG` of attributes, and its filter is a
+ * conjunction of comparisons of attributes of the SPN with constants.
+ *
+ * With `p` the likelihood of the filter and `n` the number of rows of the SPN, `COUNT(*)` is estimated as `p * n`,
+ * `AVG(x)` as the expectation of `x` under the filter, and `SUM(x)` as their product.  Bounds of `COUNT` and `SUM` are
+ * derived from the lower and upper bound of the likelihood, which differ from `p` for continuous leaves. */
+struct ApproximateAggregates
+{
+    /** An approximate answer of a query. */
+    struct answer_type
+    {
+        Schema schema; ///< the schema of the result
+        Tuple row; ///< the single row of the result
+        std::vector<std::pair<double, double>> bounds; ///< the lower and upper bound of every value of `row`
+    };
+
+    /** Returns `true` iff queries are to be answered approximately, see `--approximate-aggregates`. */
+    static bool enabled();
+
+    /** Answers the query of \p G on database \p database_name approximately, if it is supported. */
+    static std::optional<answer_type> answer(const ThreadSafePooledString &database_name, const QueryGraph &G);
+};
+
+}
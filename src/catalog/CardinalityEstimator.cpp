@@ -1,9 +1,16 @@
 #include <mutable/catalog/CardinalityEstimator.hpp>
 
 #include "backend/Interpreter.hpp"
+#include "catalog/CardinalityFeedback.hpp"
+#include "catalog/ColumnSketches.hpp"
+#include "catalog/ColumnStatistics.hpp"
+#include "catalog/HistogramEstimator.hpp"
+#include "catalog/SamplingEstimator.hpp"
 #include "catalog/SpnWrapper.hpp"
 #include "util/Spn.hpp"
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
@@ -17,6 +24,11 @@
 #include <mutable/util/Diagnostic.hpp>
 #include <mutable/util/Pool.hpp>
 #include <nlohmann/json.hpp>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 
 
 using namespace m;
@@ -111,11 +123,14 @@ CartesianProductEstimator::estimate_limit(const QueryGraph&, const DataModel &_d
 
 std::unique_ptr<DataModel>
 CartesianProductEstimator::estimate_grouping(const QueryGraph&, const DataModel &_data,
-                                             const std::vector<group_type>&) const
+                                             const std::vector<group_type> &groups) const
 {
     auto &data = as<const CartesianProductDataModel>(_data);
     auto model = std::make_unique<CartesianProductDataModel>();
-    model->size = data.size; // this model cannot estimate the effects of grouping
+    model->size = data.size;
+    /* Estimate the number of groups by the distinct values of the grouping keys, if they are columns. */
+    if (auto num_groups = ColumnSketches::Get().estimate_groups(groups))
+        model->size = std::min<std::size_t>(data.size, std::ceil(*num_groups));
     return model;
 }
 
@@ -166,11 +181,83 @@ M_LCOV_EXCL_STOP... /*==========================================================
  * InjectionCardinalityEstimator
  *====================================================================================================================*/
 
+namespace {
+
+/** Incremented whenever an `InjectionCardinalityEstimator` is constructed, such that a cached table of injected
+ * cardinalities is never mistaken for the table of another estimator at the same address. */
+std::atomic<uint64_t> injection_estimator_generation = 0;
+
+/** The injected cardinalities of an `InjectionCardinalityEstimator` for the subproblems of a `QueryGraph`. */
+struct InjectedCardinalities
+{
+    const InjectionCardinalityEstimator *estimator = nullptr; ///< the estimator whose cardinalities are tabulated
+    uint64_t generation = 0; ///< the value of `injection_estimator_generation` when building the table
+    std::vector<ThreadSafePooledString> source_names; ///< the names of the sources of the query graph, by id
+    std::unordered_map<Subproblem, std::size_t, SubproblemHash> cardinalities; ///< the injected cardinalities
+};
+
+/** Returns the injected cardinalities \p cardinality_table of \p estimator for the subproblems of \p G, by
+ * `Subproblem`.  The table is built once per query graph by resolving the relation names of each injected entry to the
+ * ids of the sources of \p G, such that looking up a subproblem during plan enumeration neither builds nor pools its
+ * identifier.  Since plans may be enumerated concurrently, see `DPsubPar`, every thread caches its own table. */
+template<typename Table>
+const std::unordered_map<Subproblem, std::size_t, SubproblemHash> &
+injected_cardinalities(const InjectionCardinalityEstimator &estimator, const Table &cardinality_table,
+                       const QueryGraph &G)
+{
+    static thread_local InjectedCardinalities cache;
+
+    /* Reuse the cached table if it was built by this estimator for a query graph with the same sources. */
+    const uint64_t generation = injection_estimator_generation.load(std::memory_order_relaxed);
+    if (cache.estimator == &estimator and cache.generation == generation and
+        cache.source_names.size() == G.num_sources())
+    {
+        bool same_sources = true;
+        for (std::size_t id = 0; same_sources and id != G.num_sources(); ++id)
+            same_sources = cache.source_names[id] == G.sources()[id]->name().assert_not_none();
+        if (same_sources)
+            return cache.cardinalities;
+    }
+
+    cache.estimator = &estimator;
+    cache.generation = generation;
+    cache.source_names.clear();
+    cache.cardinalities.clear();
+    std::unordered_map<std::string_view, std::size_t> source_ids;
+    for (std::size_t id = 0; id != G.num_sources(); ++id) {
+        cache.source_names.emplace_back(G.sources()[id]->name().assert_not_none());
+        source_ids.emplace(*cache.source_names.back(), id);
+    }
+
+    /* Resolve the '$'-separated relation names of each entry, skipping entries of relations not in `G`. */
+    for (auto &[id, cardinality] : cardinality_table) {
+        const std::string_view names(*id);
+        Subproblem S;
+        bool resolved = true;
+        for (std::size_t begin = 0; resolved and begin <= names.size();) {
+            const std::size_t end = std::min(names.find('$', begin), names.size());
+            auto it = source_ids.find(names.substr(begin, end - begin));
+            if (it == source_ids.end())
+                resolved = false;
+            else
+                S = S | Subproblem::Singleton(it->second);
+            begin = end + 1;
+        }
+        if (resolved)
+            cache.cardinalities.emplace(S, cardinality);
+    }
+
+    return cache.cardinalities;
+}
+
+}
+
 /*----- Constructors -------------------------------------------------------------------------------------------------*/
 
 InjectionCardinalityEstimator::InjectionCardinalityEstimator(ThreadSafePooledString name_of_csv)
     : fallback_(name_of_csv)
 {
+    ++injection_estimator_generation;
     Diagnostic diag(Options::Get().has_color, std::cout, std::cerr);
     Position pos("InjectionCardinalityEstimator");
 
@@ -191,6 +278,7 @@ InjectionCardinalityEstimator::InjectionCardinalityEstimator(Diagnostic &diag, T
                                                              std::istream &in)
     : fallback_(name_of_csv)
 {
+    ++injection_estimator_generation;
     read_json(diag, in, name_of_csv);
 }
 
@@ -265,7 +353,14 @@ std::unique_ptr<DataModel> InjectionCardinalityEstimator::estimate_scan(const Qu
     const auto idx = *P.begin();
     auto &DS = *G.sources()[idx];
 
-    if (auto it = cardinality_table_.find(DS.name().assert_not_none()); it != cardinality_table_.end()) {
+    /* Prefer the cardinality observed during a previous execution over the injected cardinality. */
+    if (CardinalityFeedback::enabled()) {
+        if (auto observed = CardinalityFeedback::Get().observed(DS.name().assert_not_none()))
+            return std::make_unique<InjectionCardinalityDataModel>(P, *observed);
+    }
+
+    auto &injected = injected_cardinalities(*this, cardinality_table_, G);
+    if (auto it = injected.find(P); it != injected.end()) {
         return std::make_unique<InjectionCardinalityDataModel>(P, it->second);
     } else {
         /* no match, fall back */
@@ -314,6 +409,11 @@ InjectionCardinalityEstimator::estimate_grouping(const QueryGraph&, const DataMo
         /* Clamp injected cardinality to at most the cardinality of the grouping's child since it cannot produce more
          * tuples than it receives. */
         return std::make_unique<InjectionCardinalityDataModel>(data.subproblem_, std::min(it->second, data.size_));
+    } else if (auto num_groups = ColumnSketches::Get().estimate_groups(exprs)) {
+        /* Estimate the number of groups by the distinct values of the grouping keys. */
+        return std::make_unique<InjectionCardinalityDataModel>(
+            data.subproblem_, std::min<std::size_t>(data.size_, std::ceil(*num_groups))
+        );
     } else {
         /* This model cannot estimate the effects of grouping. */
         return std::make_unique<InjectionCardinalityDataModel>(data); // copy
@@ -328,8 +428,18 @@ InjectionCardinalityEstimator::estimate_join(const QueryGraph &G, const DataMode
     auto &right = as<const InjectionCardinalityDataModel>(_right);
 
     const Subproblem subproblem = left.subproblem_ | right.subproblem_;
-    ThreadSafePooledString id = make_identifier(G, subproblem);... /* Lookup cardinality in table. */
-    if (auto it = cardinality_table_.find(id); it != cardinality_table_.end()) {
+
+    /* Prefer the cardinality observed during a previous execution over the injected cardinality. */
+    if (CardinalityFeedback::enabled()) {
+        if (auto observed = CardinalityFeedback::Get().observed(make_identifier(G, subproblem))) {
+            const std::size_t max_cardinality = left.size_ * right.size_;
+            return std::make_unique<InjectionCardinalityDataModel>(subproblem, std::min(*observed, max_cardinality));
+        }
+    }
+
+    /* Lookup cardinality in table. */
+    auto &injected = injected_cardinalities(*this, cardinality_table_, G);
+    if (auto it = injected.find(subproblem); it != injected.end()) {
         /* Clamp injected cardinality to at most the cardinality of the cartesian product of the join's children
          * since it cannot produce more tuples than that. */
         const std::size_t max_cardinality = left.size_ * right.size_;
@@ -344,22 +454,32 @@ InjectionCardinalityEstimator::estimate_join(const QueryGraph &G, const DataMode
         auto right_fallback = std::make_unique<CartesianProductEstimator::CartesianProductDataModel>();
         right_fallback->size = right.size_;
         auto fallback_model = fallback_.estimate_join(G, *left_fallback, *right_fallback, condition);
-        return std::make_unique<InjectionCardinalityDataModel>(subproblem,
-                                                               fallback_.predict_cardinality(*fallback_model));
+        std::size_t size = fallback_.predict_cardinality(*fallback_model);
+        /* Reduce the cartesian product by the fan-out of the equi-join clauses, if any. */
+        if (auto selectivity = ColumnSketches::Get().join_selectivity(condition))
+            size = std::ceil(size * *selectivity);
+        return std::make_unique<InjectionCardinalityDataModel>(subproblem, size);
     }
 }... template<typename PlanTable>
 std::unique_ptr<DataModel>
 InjectionCardinalityEstimator::operator()(estimate_join_all_tag, PlanTable &&PT, const QueryGraph &G,
-                                          Subproblem to_join, const cnf::CNF&) const
+                                          Subproblem to_join, const cnf::CNF &condition) const
 {
-    ThreadSafePooledString id = make_identifier(G, to_join);
-    if (auto it = cardinality_table_.find(id); it != cardinality_table_.end()) {
+    std::optional<std::size_t> cardinality;
+    if (CardinalityFeedback::enabled()) // prefer the cardinality observed previously
+        cardinality = CardinalityFeedback::Get().observed(make_identifier(G, to_join));
+    if (not cardinality) {
+        auto &injected = injected_cardinalities(*this, cardinality_table_, G);
+        if (auto it = injected.find(to_join); it != injected.end())
+            cardinality = it->second;
+    }
+    if (cardinality) {
         /* Clamp injected cardinality to at most the cardinality of the cartesian product of the join's children
          * since it cannot produce more tuples than that. */
         std::size_t max_cardinality = 1;
         for (auto it = to_join.begin(); it != to_join.end(); ++it)
             max_cardinality *= as<const InjectionCardinalityDataModel>(*PT[it.as_set()].model).size_;
-        return std::make_unique<InjectionCardinalityDataModel>(to_join, std::min(it->second, max_cardinality));
+        return std::make_unique<InjectionCardinalityDataModel>(to_join, std::min(*cardinality, max_cardinality));
     } else {
         /* Fallback to cartesian product. */
         if (not Options::Get().quiet)
@@ -368,6 +488,9 @@ InjectionCardinalityEstimator::operator()(estimate_join_all_tag, PlanTable &&PT,
         std::size_t size = as<const InjectionCardinalityDataModel>(*PT[ds_it.as_set()].model).size_;
         for (; ds_it != to_join.end(); ++ds_it)
             size *= as<const InjectionCardinalityDataModel>(*PT[ds_it.as_set()].model).size_;
+        /* Reduce the cartesian product by the fan-out of the equi-join clauses, if any. */
+        if (auto selectivity = ColumnSketches::Get().join_selectivity(condition))
+            size = std::ceil(size * *selectivity);
         return std::make_unique<InjectionCardinalityDataModel>(to_join, size);
     }
 }
@@ -415,15 +538,17 @@ ThreadSafePooledString InjectionCardinalityEstimator::make_identifier(const Quer
     names.clear();
     for (auto id : S)
         names.emplace_back(G.sources()[id]->name());
-    std::sort(names.begin(), names.end(), [](auto lhs, auto rhs){ return strcmp(*lhs, *rhs) < 0; });... buf_.clear();
+    std::sort(names.begin(), names.end(), [](auto lhs, auto rhs){ return strcmp(*lhs, *rhs) < 0; });
+
+    /* Use a buffer of this thread since plans may be enumerated concurrently, see `DPsubPar`. */
+    static thread_local std::string buf;
+    buf.clear();
     for (auto it = names.begin(); it != names.end(); ++it) {
         if (it != names.begin())
-            buf_.emplace_back('$');
-        buf_append(**it);
+            buf += '$';
+        buf += **it;
     }
-
-    buf_.emplace_back(0);
-    return C.pool(buf_view());
+    return C.pool(buf.c_str());
 }
 /*======================================================================================================================
  * SpnEstimator
@@ -540,18 +665,29 @@ struct JoinTranslator : ast::ConstASTExprVisitor {
 
 SpnEstimator::~SpnEstimator()
 {
-    for (auto &e : table_to_spn_)
+    for (auto &e : table_to_spn_) {
+        SpnMaintenance::Get().remove(*e.second);
         delete e.second;
+    }
 }
 
-void SpnEstimator::learn_spns() { table_to_spn_ = SpnWrapper::learn_spn_csv(name_of_csv_); }
+void SpnEstimator::learn_spns()
+{
+    for (auto &e : table_to_spn_)
+        SpnMaintenance::Get().remove(*e.second);
+    table_to_spn_ = SpnWrapper::learn_spn_csv(name_of_csv_);
+    /* Keep the learned SPNs up to date with the rows written to their tables. */
+    for (auto &e : table_to_spn_)
+        SpnMaintenance::Get().add(name_of_csv_, e.first, *e.second);
+}
 
 void SpnEstimator::learn_new_spn(const ThreadSafePooledString &name_of_table)
 {
-    table_to_spn_.emplace(
+    auto [it, _] = table_to_spn_.emplace(
         name_of_table,
         new SpnWrapper(SpnWrapper::learn_spn_table(name_of_csv_, name_of_table))
     );
+    SpnMaintenance::Get().add(name_of_csv_, name_of_table, *it->second);
 }
 
 std::pair<unsigned, bool> SpnEstimator::find_spn_id(const SpnDataModel &data, SpnJoin &join)
@@ -772,10 +908,512 @@ std::size_t SpnEstimator::predict_cardinality(const DataModel &_data) const
 void SpnEstimator::print(std::ostream&) const { }
 
 
+/*======================================================================================================================
+ * SamplingEstimator
+ *====================================================================================================================*/
+
+std::shared_ptr<const SamplingEstimator::sample_type> SamplingEstimator::sample(const Table &table) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &S = samples_[table.name()];
+    const std::size_t num_rows = table.store().num_rows();
+    if (num_rows < S.num_rows_seen)
+        S = TableSample(); // the table was replaced by a smaller one, draw a new sample
+    if (S.tuples and S.num_rows_seen == num_rows)
+        return S.tuples;
+
+    /* Feed the rows appended since the last call into the reservoir.  Only row ids are drawn, such that only the rows
+     * that end up in the reservoir must be loaded. */
+    std::vector<std::size_t> replaced; // the reservoir slots whose row changed
+    for (std::size_t row = S.num_rows_seen; row != num_rows; ++row) {
+        if (S.row_ids.size() < SAMPLE_SIZE) {
+            replaced.push_back(S.row_ids.size());
+            S.row_ids.push_back(row);
+        } else if (auto slot = std::uniform_int_distribution<std::size_t>(0, row)(S.g); slot < SAMPLE_SIZE) {
+            replaced.push_back(slot);
+            S.row_ids[slot] = row;
+        }
+    }
+    S.num_rows_seen = num_rows;
+    std::sort(replaced.begin(), replaced.end());
+    replaced.erase(std::unique(replaced.begin(), replaced.end()), replaced.end());
+
+    /* Copy the reservoir, since it may still be used by the models of other queries, and load the new rows. */
+    auto tuples = S.tuples ? std::make_shared<sample_type>(*S.tuples) : std::make_shared<sample_type>();
+    tuples->resize(S.row_ids.size());
+    const Schema &schema = table.schema();
+    for (auto slot : replaced) {
+        auto loader = Interpreter::compile_load(schema, table.store().memory().addr(), table.layout(), schema,
+                                                S.row_ids[slot]);
+        auto tuple = std::make_shared<Tuple>(schema);
+        Tuple *args[] = { tuple.get() };
+        loader(args);
+        (*tuples)[slot] = std::move(tuple);
+    }
+    S.tuples = std::move(tuples);
+    return S.tuples;
+}
+
+std::unique_ptr<DataModel> SamplingEstimator::empty_model() const
+{
+    return std::make_unique<SamplingDataModel>(Subproblem(), 0);
+}
+
+std::unique_ptr<DataModel> SamplingEstimator::estimate_scan(const QueryGraph &G, Subproblem P) const
+{
+    M_insist(P.size() == 1, "Subproblem must identify exactly one DataSource");
+    auto &source = *G.sources()[*P.begin()];
+
+    if (auto BT = cast<const BaseTable>(&source)) {
+        auto &table = BT->table();
+        auto filtered = std::make_shared<FilteredSample>();
+        filtered->tuples = sample(table);
+        filtered->schema = table.schema(source.name());
+        filtered->rows.resize(filtered->tuples->size());
+        std::iota(filtered->rows.begin(), filtered->rows.end(), 0);
+        filtered->num_table_rows = table.store().num_rows();
+        const double size = filtered->num_table_rows;
+        return std::make_unique<SamplingDataModel>(
+            P, size, std::vector<std::shared_ptr<const FilteredSample>>{ std::move(filtered) }
+        );
+    } else if (auto CT = cast<const CsvTable>(&source)) {
+        return std::make_unique<SamplingDataModel>(P, CT->get_num_rows()); // CSV files are not sampled
+    } else {
+        throw data_model_exception("Data source can not be sampled");
+    }
+}
+
+std::unique_ptr<DataModel>
+SamplingEstimator::estimate_filter(const QueryGraph&, const DataModel &_data, const cnf::CNF &filter) const
+{
+    auto &data = as<const SamplingDataModel>(_data);
+
+    /* A filter can only be evaluated on the sample of a single data source that provides all attributes used. */
+    const Schema required = filter.get_required();
+    if (filter.empty() or data.samples_.size() != 1 or data.subproblem_.size() != 1 or
+        not ((required & data.samples_.front()->schema) == required) or data.samples_.front()->rows.empty())
+        return std::make_unique<SamplingDataModel>(data); // copy
+    auto &in = *data.samples_.front();
+
+    StackMachine SM(in.schema);
+    SM.emit(filter, 1);
+    SM.emit_St_Tup_b(0, 0);
+    Tuple res({ Type::Get_Boolean(Type::TY_Vector) });
+
+    auto out = std::make_shared<FilteredSample>();
+    out->tuples = in.tuples;
+    out->schema = in.schema;
+    out->num_table_rows = in.num_table_rows;
+    for (auto row : in.rows) {
+        Tuple *args[] = { &res, (*in.tuples)[row].get() };
+        SM(args);
+        if (not res.is_null(0) and res[0].as_b())
+            out->rows.push_back(row);
+    }
+
+    /* If no sampled row qualifies, assume half a sampled row would rather than estimating an empty result. */
+    const double selectivity = (out->rows.empty() ? .5 : double(out->rows.size())) / in.rows.size();
+    return std::make_unique<SamplingDataModel>(
+        data.subproblem_, data.size_ * selectivity, std::vector<std::shared_ptr<const FilteredSample>>{ std::move(out) }
+    );
+}
+
+std::unique_ptr<DataModel>
+SamplingEstimator::estimate_limit(const QueryGraph&, const DataModel &_data, std::size_t limit,
+                                  std::size_t offset) const
+{
+    auto &data = as<const SamplingDataModel>(_data);
+    const double remaining = std::max(0., data.size_ - offset);
+    return std::make_unique<SamplingDataModel>(data.subproblem_, std::min(remaining, double(limit)), data.samples_);
+}
+
+std::unique_ptr<DataModel>
+SamplingEstimator::estimate_grouping(const QueryGraph&, const DataModel &_data,
+                                     const std::vector<group_type> &groups) const
+{
+    auto &data = as<const SamplingDataModel>(_data);
+    /* Without grouping keys, a single group is produced.  Otherwise, estimate the number of groups by the distinct
+     * values of the grouping keys, if they are columns. */
+    if (groups.empty())
+        return std::make_unique<SamplingDataModel>(data.subproblem_, 1.);
+    if (auto num_groups = ColumnSketches::Get().estimate_groups(groups))
+        return std::make_unique<SamplingDataModel>(data.subproblem_, std::min(data.size_, *num_groups));
+    return std::make_unique<SamplingDataModel>(data.subproblem_, data.size_);
+}
+
+double SamplingEstimator::selectivity(const cnf::Clause &clause,
+                                      const std::vector<std::shared_ptr<const FilteredSample>> &samples)
+{
+    /* Locate the filtered samples providing the attributes used by the clause. */
+    std::vector<const FilteredSample*> referenced;
+    for (auto &entry : clause.get_required()) {
+        auto it = std::find_if(samples.begin(), samples.end(), [&entry](auto &S) { return S->schema.has(entry.id); });
+        if (it == samples.end())
+            return 1.; // the clause uses a data source without sample
+        if (std::find(referenced.begin(), referenced.end(), it->get()) == referenced.end())
+            referenced.push_back(it->get());
+    }
+    if (referenced.empty() or referenced.size() > 2)
+        return 1.;
+    std::sort(referenced.begin(), referenced.end());
+    for (auto S : referenced) {
+        if (S->rows.empty())
+            return 1.; // nothing to evaluate on; the filter already accounts for the few qualifying rows
+    }
+
+    /* Look up the selectivity of the clause, if it was already evaluated on the same samples.  The selectivities are
+     * cached by the filtered sample with the lowest address. */
+    std::vector<uintptr_t> key;
+    key.push_back(referenced.size() == 2 ? reinterpret_cast<uintptr_t>(referenced[1]) : 0);
+    for (auto &pred : clause) {
+        key.push_back(reinterpret_cast<uintptr_t>(&pred.expr()));
+        key.push_back(pred.negative());
+    }
+    auto &cache_owner = *referenced.front();
+    {
+        std::lock_guard<std::mutex> lock(cache_owner.mutex_);
+        if (auto it = cache_owner.selectivities_.find(key); it != cache_owner.selectivities_.end())
+            return it->second;
+    }
+
+    /* Evaluate the clause on the cross product of up to `JOIN_SAMPLE_SIZE` evenly spaced rows of each sample. */
+    std::vector<Schema> schemas;
+    std::vector<std::size_t> tuple_ids;
+    std::vector<std::vector<Tuple*>> tuples;
+    for (auto S : referenced) {
+        schemas.push_back(S->schema);
+        tuple_ids.push_back(tuple_ids.size() + 1); // start at index 1
+        auto &T = tuples.emplace_back();
+        const std::size_t n = std::min(S->rows.size(), JOIN_SAMPLE_SIZE);
+        for (std::size_t i = 0; i != n; ++i)
+            T.push_back((*S->tuples)[S->rows[i * S->rows.size() / n]].get());
+    }
+    StackMachine SM;
+    SM.emit(cnf::CNF({ clause }), schemas, tuple_ids);
+    SM.emit_St_Tup_b(0, 0);
+    Tuple res({ Type::Get_Boolean(Type::TY_Vector) });
+
+    std::size_t num_pairs = 0, num_matches = 0;
+    auto evaluate = [&](Tuple *lhs, Tuple *rhs) {
+        Tuple *args[] = { &res, lhs, rhs };
+        SM(args);
+        ++num_pairs;
+        num_matches += not res.is_null(0) and res[0].as_b();
+    };
+    if (tuples.size() == 1) {
+        for (auto t : tuples[0])
+            evaluate(t, nullptr);
+    } else {
+        for (auto lhs : tuples[0]) {
+            for (auto rhs : tuples[1])
+                evaluate(lhs, rhs);
+        }
+    }
+
+    double selectivity;
+    if (num_matches) {
+        selectivity = double(num_matches) / num_pairs;
+    } else {
+        /* No pair of sampled rows qualifies, e.g. for a key/foreign-key join of two large tables.  Estimate the
+         * selectivity of an equi-join by the distinct values of the joined columns.  Otherwise, assume each row of the
+         * larger table joins with one row of the smaller.  In either case, assume at most half a pair of the evaluated
+         * ones qualifies. */
+        std::size_t max_rows = 1;
+        for (auto S : referenced)
+            max_rows = std::max(max_rows, S->num_table_rows);
+        const double fan_out = ColumnSketches::Get().join_selectivity(cnf::CNF({ clause })).value_or(1. / max_rows);
+        selectivity = std::min(fan_out, .5 / num_pairs);
+    }
+
+    std::lock_guard<std::mutex> lock(cache_owner.mutex_);
+    cache_owner.selectivities_.emplace(std::move(key), selectivity);
+    return selectivity;
+}
+
+std::unique_ptr<SamplingEstimator::SamplingDataModel>
+SamplingEstimator::join(const std::vector<const SamplingDataModel*> &models, const cnf::CNF &condition) const
+{
+    Subproblem subproblem;
+    double size = 1.;
+    std::vector<std::shared_ptr<const FilteredSample>> samples;
+    for (auto model : models) {
+        subproblem = subproblem | model->subproblem_;
+        size *= model->size_;
+        samples.insert(samples.end(), model->samples_.begin(), model->samples_.end());
+    }
+    for (auto &clause : condition)
+        size *= selectivity(clause, samples);
+    return std::make_unique<SamplingDataModel>(subproblem, size, std::move(samples));
+}
+
+std::unique_ptr<DataModel>
+SamplingEstimator::estimate_join(const QueryGraph&, const DataModel &_left, const DataModel &_right,
+                                 const cnf::CNF &condition) const
+{
+    auto &left = as<const SamplingDataModel>(_left);
+    auto &right = as<const SamplingDataModel>(_right);
+    return join({ &left, &right }, condition);
+}
+
+template<typename PlanTable>
+std::unique_ptr<DataModel>
+SamplingEstimator::operator()(estimate_join_all_tag, PlanTable &&PT, const QueryGraph&, Subproblem to_join,
+                              const cnf::CNF &condition) const
+{
+    M_insist(not to_join.empty());
+    std::vector<const SamplingDataModel*> models;
+    for (auto it = to_join.begin(); it != to_join.end(); ++it)
+        models.push_back(&as<const SamplingDataModel>(*PT[it.as_set()].model));
+    return join(models, condition);
+}
+
+std::size_t SamplingEstimator::predict_cardinality(const DataModel &data) const
+{
+    return std::llround(as<const SamplingDataModel>(data).size_);
+}
+
+M_LCOV_EXCL_START
+void SamplingEstimator::print(std::ostream &out) const
+{
+    out << "SamplingEstimator - evaluates predicates on reservoir samples of up to " << SAMPLE_SIZE
+        << " rows per table";
+}
+M_LCOV_EXCL_STOP
+
+
+/*======================================================================================================================
+ * HistogramEstimator
+ *====================================================================================================================*/
+
+namespace {
+
+/** Returns the `Attribute` designated by \p e, or `nullptr` if \p e does not designate a column of a table. */
+const Attribute * get_attribute(const ast::Expr &e)
+{
+    if (auto D = cast<const ast::Designator>(&e)) {
+        if (auto attr = std::get_if<const Attribute*>(&D->target()))
+            return *attr;
+    }
+    return nullptr;
+}
+
+/** Returns the value of the constant \p c as `double`, or `std::nullopt` if \p c is NULL or not numeric. */
+std::optional<double> to_double(const ast::Constant &c)
+{
+    if (c.tok.type == TK_Null) return std::nullopt;
+    const Type *ty = c.type();
+    if (not (ty->is_boolean() or ty->is_numeric() or ty->is_date() or ty->is_date_time()))
+        return std::nullopt;
+    auto v = Interpreter::eval(c);
+    if (ty->is_boolean()) return v.as_b();
+    if (auto n = cast<const Numeric>(ty)) {
+        switch (n->kind) {
+            case Numeric::N_Int:     return v.as_i();
+            case Numeric::N_Float:   return n->precision == 32 ? v.as_f() : v.as_d();
+            case Numeric::N_Decimal: return v.as_d();
+        }
+    }
+    return v.as_i(); // date or datetime
+}
+
+}
+
+std::optional<double> HistogramEstimator::distinct_values(const Attribute &attr)
+{
+    Catalog &C = Catalog::Get();
+    if (not C.has_database_in_use()) return std::nullopt;
+    auto &database_name = C.get_database_in_use().name;
+    if (auto stats = ColumnStatistics::Get().find(database_name, attr.table.name())) {
+        if (auto it = stats->columns.find(attr.name); it != stats->columns.end())
+            return std::max(1., it->second.num_distinct);
+    }
+    return ColumnSketches::Get().distinct_values(database_name, attr);
+}
+
+std::optional<double> HistogramEstimator::selectivity(const cnf::Predicate &pred)
+{
+    auto binary = cast<const ast::BinaryExpr>(&pred.expr());
+    if (not binary) return std::nullopt;
+
+    /* Equi-joins are estimated by the distinct values of the joined columns. */
+    auto lhs_attr = get_attribute(*binary->lhs);
+    auto rhs_attr = get_attribute(*binary->rhs);
+    if (lhs_attr and rhs_attr) {
+        if (binary->op().type != TK_EQUAL) return std::nullopt;
+        auto num_distinct_lhs = distinct_values(*lhs_attr);
+        auto num_distinct_rhs = distinct_values(*rhs_attr);
+        if (not num_distinct_lhs or not num_distinct_rhs) return std::nullopt;
+        const double selectivity = 1. / std::max(*num_distinct_lhs, *num_distinct_rhs);
+        return pred.negative() ? 1. - selectivity : selectivity;
+    }
+
+    /* Otherwise, only comparisons of a column with a constant are estimated, with the column on the left. */
+    auto op = binary->op().type;
+    const Attribute *attr = lhs_attr;
+    auto constant = cast<const ast::Constant>(binary->rhs.get());
+    if (not attr) {
+        attr = rhs_attr;
+        constant = cast<const ast::Constant>(binary->lhs.get());
+        switch (op) {
+            default:               break;
+            case TK_LESS:          op = TK_GREATER;       break;
+            case TK_LESS_EQUAL:    op = TK_GREATER_EQUAL; break;
+            case TK_GREATER:       op = TK_LESS;          break;
+            case TK_GREATER_EQUAL: op = TK_LESS_EQUAL;    break;
+        }
+    }
+    if (not attr or not constant) return std::nullopt;
+
+    Catalog &C = Catalog::Get();
+    if (not C.has_database_in_use()) return std::nullopt;
+    auto stats = ColumnStatistics::Get().find(C.get_database_in_use().name, attr->table.name());
+    if (not stats) return std::nullopt;
+    auto it = stats->columns.find(attr->name);
+    if (it == stats->columns.end()) return std::nullopt;
+    const ColumnHistogram &H = it->second;
+
+    double selectivity;
+    if (attr->type->is_character_sequence()) {
+        if (constant->tok.type != TK_STRING_LITERAL or (op != TK_EQUAL and op != TK_BANG_EQUAL))
+            return std::nullopt;
+        const double equal = H.selectivity_equal(std::string(Interpreter::eval(*constant).as<const char*>()));
+        selectivity = op == TK_EQUAL ? equal : 1. - H.null_fraction - equal;
+    } else {
+        auto value = to_double(*constant);
+        if (not value) return std::nullopt;
+        switch (op) {
+            default:               return std::nullopt;
+            case TK_EQUAL:         selectivity = H.selectivity_equal(*value); break;
+            case TK_BANG_EQUAL:    selectivity = 1. - H.null_fraction - H.selectivity_equal(*value); break;
+            case TK_LESS:          selectivity = H.selectivity_less(*value, false); break;
+            case TK_LESS_EQUAL:    selectivity = H.selectivity_less(*value, true); break;
+            case TK_GREATER:       selectivity = H.selectivity_greater(*value, false); break;
+            case TK_GREATER_EQUAL: selectivity = H.selectivity_greater(*value, true); break;
+        }
+    }
+    /* NULL satisfies neither the comparison nor its negation. */
+    if (pred.negative())
+        selectivity = 1. - H.null_fraction - selectivity;
+    return std::clamp(selectivity, 0., 1.);
+}
+
+double HistogramEstimator::selectivity(const cnf::CNF &cnf)
+{
+    double result = 1.;
+    for (auto &clause : cnf) {
+        /* The selectivity of a disjunction of independent predicates. */
+        double none_satisfied = 1.;
+        for (auto &pred : clause) {
+            double s;
+            if (auto estimated = selectivity(pred)) {
+                s = *estimated;
+            } else {
+                auto binary = cast<const ast::BinaryExpr>(&pred.expr());
+                const bool is_equality = binary and binary->op().type == TK_EQUAL;
+                s = is_equality != pred.negative() ? DEFAULT_EQUALITY_SELECTIVITY : DEFAULT_SELECTIVITY;
+            }
+            none_satisfied *= 1. - s;
+        }
+        result *= 1. - none_satisfied;
+    }
+    return result;
+}
+
+std::unique_ptr<DataModel> HistogramEstimator::empty_model() const
+{
+    return std::make_unique<HistogramDataModel>(Subproblem(), 0);
+}
+
+std::unique_ptr<DataModel> HistogramEstimator::estimate_scan(const QueryGraph &G, Subproblem P) const
+{
+    M_insist(P.size() == 1, "Subproblem must identify exactly one DataSource");
+    auto &source = *G.sources()[*P.begin()];
+
+    if (auto BT = cast<const BaseTable>(&source))
+        return std::make_unique<HistogramDataModel>(P, BT->table().store().num_rows());
+    else if (auto CT = cast<const CsvTable>(&source))
+        return std::make_unique<HistogramDataModel>(P, CT->get_num_rows());
+    else
+        throw data_model_exception("Data source is neither a table nor a CSV file");
+}
+
+std::unique_ptr<DataModel>
+HistogramEstimator::estimate_filter(const QueryGraph&, const DataModel &_data, const cnf::CNF &filter) const
+{
+    auto &data = as<const HistogramDataModel>(_data);
+    return std::make_unique<HistogramDataModel>(data.subproblem_, data.size_ * selectivity(filter));
+}
+
+std::unique_ptr<DataModel>
+HistogramEstimator::estimate_limit(const QueryGraph&, const DataModel &_data, std::size_t limit,
+                                   std::size_t offset) const
+{
+    auto &data = as<const HistogramDataModel>(_data);
+    const double remaining = std::max(0., data.size_ - offset);
+    return std::make_unique<HistogramDataModel>(data.subproblem_, std::min(remaining, double(limit)));
+}
+
+std::unique_ptr<DataModel>
+HistogramEstimator::estimate_grouping(const QueryGraph&, const DataModel &_data,
+                                      const std::vector<group_type> &groups) const
+{
+    auto &data = as<const HistogramDataModel>(_data);
+    if (groups.empty())
+        return std::make_unique<HistogramDataModel>(data.subproblem_, 1.); // single group
+
+    /* Assume independent grouping keys. */
+    double num_groups = 1.;
+    for (auto &[grp, _] : groups) {
+        auto attr = get_attribute(grp.get());
+        auto num_distinct = attr ? distinct_values(*attr) : std::nullopt;
+        if (not num_distinct)
+            return std::make_unique<HistogramDataModel>(data); // this model cannot estimate the grouping
+        num_groups *= *num_distinct;
+    }
+    return std::make_unique<HistogramDataModel>(data.subproblem_, std::min(data.size_, num_groups));
+}
+
+std::unique_ptr<DataModel>
+HistogramEstimator::estimate_join(const QueryGraph&, const DataModel &_left, const DataModel &_right,
+                                  const cnf::CNF &condition) const
+{
+    auto &left = as<const HistogramDataModel>(_left);
+    auto &right = as<const HistogramDataModel>(_right);
+    return std::make_unique<HistogramDataModel>(left.subproblem_ | right.subproblem_,
+                                                left.size_ * right.size_ * selectivity(condition));
+}
+
+template<typename PlanTable>
+std::unique_ptr<DataModel>
+HistogramEstimator::operator()(estimate_join_all_tag, PlanTable &&PT, const QueryGraph&, Subproblem to_join,
+                               const cnf::CNF &condition) const
+{
+    M_insist(not to_join.empty());
+    double size = 1.;
+    for (auto it = to_join.begin(); it != to_join.end(); ++it)
+        size *= as<const HistogramDataModel>(*PT[it.as_set()].model).size_;
+    return std::make_unique<HistogramDataModel>(to_join, size * selectivity(condition));
+}
+
+std::size_t HistogramEstimator::predict_cardinality(const DataModel &data) const
+{
+    return std::llround(as<const HistogramDataModel>(data).size_);
+}
+
+M_LCOV_EXCL_START
+void HistogramEstimator::print(std::ostream &out) const
+{
+    out << "HistogramEstimator - estimates cardinalities by column statistics computed with `analyze`";
+}
+M_LCOV_EXCL_STOP
+
+
 #define LIST_CE(X) \
     X(CartesianProductEstimator, "CartesianProduct", "estimates cardinalities as Cartesian product") \
     X(InjectionCardinalityEstimator, "Injected", "estimates cardinalities based on a JSON file") \
-    X(SpnEstimator, "Spn", "estimates cardinalities based on Sum-Product Networks")
+    X(SpnEstimator, "Spn", "estimates cardinalities based on Sum-Product Networks") \
+    X(SamplingEstimator, "Sampling", "estimates cardinalities by evaluating predicates on samples of the tables") \
+    X(HistogramEstimator, "Histogram", "estimates cardinalities based on column statistics computed with `analyze`")
 
 #define INSTANTIATE(TYPE, _1, _2) \
     template std::unique_ptr<DataModel> TYPE::operator()(estimate_join_all_tag, PlanTableSmallOrDense &&PT, \
@@ -0,0 +1,124 @@
+#include "catalog/CardinalityFeedback.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutable/catalog/Catalog.hpp>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** Whether to count actual cardinalities during execution and feed them back into cardinality estimation. */
+bool cardinality_feedback = false;
+
+}
+
+__attribute__((constructor(201)))
+static void add_cardinality_feedback_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<bool>(
+        /* group=       */ "Cardinality estimation",
+        /* short=       */ nullptr,
+        /* long=        */ "--cardinality-feedback",
+        /* description= */ "count actual cardinalities during execution and prefer them over injected cardinalities "
+                           "in later optimizations",
+        /* callback=    */ [](bool b){ options::cardinality_feedback = b; }
+    );
+}
+
+}
+
+thread_local std::unordered_map<const Operator*, std::size_t> CardinalityFeedback::counts_;
+
+CardinalityFeedback & CardinalityFeedback::Get()
+{
+    static CardinalityFeedback the_feedback;
+    return the_feedback;
+}
+
+bool CardinalityFeedback::enabled() { return options::cardinality_feedback; }
+
+ThreadSafePooledString CardinalityFeedback::make_identifier(const QueryGraph &G, Subproblem S)
+{
+    auto &C = Catalog::Get();
+    static thread_local std::vector<ThreadSafePooledString> names;
+    names.clear();
+    for (auto id : S)
+        names.emplace_back(G.sources()[id]->name());
+    std::sort(names.begin(), names.end(), [](auto lhs, auto rhs){ return strcmp(*lhs, *rhs) < 0; });
+
+    static thread_local std::string buf;
+    buf.clear();
+    for (auto it = names.begin(); it != names.end(); ++it) {
+        if (it != names.begin())
+            buf += '$';
+        buf += **it;
+    }
+    return C.pool(buf.c_str());
+}
+
+void CardinalityFeedback::record(const QueryGraph &G, const Operator &plan, std::ostream *out)
+{
+    /* Collect the operators computing subproblems of `G`, in pre-order.  Any other operator below them is the plan of
+     * a nested query, whose subproblems refer to the query graph of the nested query, and is hence not collected.
+     * Operators below a limit may not have produced all their tuples, hence plans with a limit are not recorded. */
+    std::vector<const Operator*> operators;
+    bool has_limit = false;
+    auto collect = [&](const Operator &op, bool below_joins, auto &collect_rec) -> void {
+        if (is<const LimitOperator>(op)) has_limit = true;
+        auto is_having = [](const Operator &op) { // filters of HAVING do not compute a subproblem
+            auto c = cast<const Consumer>(&op);
+            return is<const GroupingOperator>(c->child(0)) or is<const AggregationOperator>(c->child(0));
+        };
+        const bool computes_subproblem = is<const ScanOperator>(op) or is<const JoinOperator>(op) or
+                                         ((is<const FilterOperator>(op) or is<const DisjunctiveFilterOperator>(op)) and
+                                          not is_having(op));
+        if (computes_subproblem)
+            operators.push_back(&op);
+        else if (below_joins)
+            return; // plan of a nested query
+        if (auto c = cast<const Consumer>(&op)) {
+            for (auto child : c->children())
+                collect_rec(*child, computes_subproblem, collect_rec);
+        }
+    };
+    collect(plan, false, collect);
+
+    if (not has_limit) {
+        std::unordered_set<uint64_t> recorded;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto op : operators) {
+            if (not op->has_info()) continue;
+            const Subproblem S = op->info().subproblem;
+            if (S.empty() or not recorded.insert(uint64_t(S)).second)
+                continue; // an operator closer to the root already computed this subproblem
+            auto it = counts_.find(op);
+            if (it == counts_.end()) continue; // not executed, e.g. the probe side of a join with an empty build side
+            const std::size_t actual = it->second;
+            auto id = make_identifier(G, S);
+            if (out)
+                *out << "Cardinality of " << id << ": estimated " << op->info().estimated_cardinality
+                     << ", actual " << actual << '\n';
+            observed_.insert_or_assign(std::move(id), actual);
+        }
+    }
+    counts_.clear();
+}
+
+std::optional<std::size_t> CardinalityFeedback::observed(const ThreadSafePooledString &id) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto it = observed_.find(id); it != observed_.end())
+        return it->second;
+    return std::nullopt;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <mutable/IR/Operator.hpp>
+#include <mutable/IR/QueryGraph.hpp>
+#include <mutable/util/Pool.hpp>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+
+namespace m {
+
+/** Collects the actual cardinalities of executed plans to correct the estimates of later optimizations, in the spirit
+ * of DB2's LEarning Optimizer (LEO).  While a plan is executed, the backend counts the tuples produced by each operator
+ * of the current thread.  After execution, the counts of all operators with a known subproblem are recorded as the
+ * observed cardinalities of their subproblems.  Subproblems are identified by the sorted names of their data sources,
+ * exactly like in `InjectionCardinalityEstimator::make_identifier()`, such that observed cardinalities take precedence
+ * over injected ones.
+ *
+ * Since queries may be executed concurrently, the observed cardinalities are protected by a mutex while the counts of
+ * the currently executed plan are local to the executing thread. */
+struct CardinalityFeedback
+{
+    private:
+    ///> the observed cardinalities by identifier of their subproblem
+    std::unordered_map<ThreadSafePooledString, std::size_t> observed_;
+    mutable std::mutex mutex_;
+
+    ///> the number of tuples produced by each operator of the plan executed by the current thread
+    static thread_local std::unordered_map<const Operator*, std::size_t> counts_;
+
+    CardinalityFeedback() = default;
+
+    public:
+    static CardinalityFeedback & Get();
+
+    /** Returns `true` iff actual cardinalities should be counted and fed back into cardinality estimation. */
+    static bool enabled();
+
+    /** Accounts \p num_tuples tuples produced by \p op to the plan executed by the current thread. */
+    static void count(const Operator &op, std::size_t num_tuples) { counts_[&op] += num_tuples; }
+
+    /** Returns the identifier of subproblem \p S of query graph \p G. */
+    static ThreadSafePooledString make_identifier(const QueryGraph &G, Subproblem S);
+
+    /** Records the cardinalities of the subproblems of \p plan for query graph \p G counted by the current thread and
+     * resets the counts of the current thread.  Of multiple operators computing the same subproblem, e.g. a scan and
+     * a filter, the count of the operator closest to the root is recorded.  Reports the estimated and the actual
+     * cardinalities to \p out, if given. */
+    void record(const QueryGraph &G, const Operator &plan, std::ostream *out = nullptr);
+
+    /** Returns the observed cardinality of the subproblem with identifier \p id, if any. */
+    std::optional<std::size_t> observed(const ThreadSafePooledString &id) const;
+
+    /** Discards all observed cardinalities. */
+    void clear() { std::lock_guard<std::mutex> lock(mutex_); observed_.clear(); }
+};
+
+}
@@ -0,0 +1,232 @@
+#include "catalog/Cluster.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "util/WireClient.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/util/exception.hpp>
+#include <mutable/util/fn.hpp>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** The maximum number of rows per record batch sent to a node. */
+std::size_t batch_size = 64 * 1024;
+
+}
+
+__attribute__((constructor(201)))
+static void add_cluster_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<const char*>(
+        /* group=       */ "Cluster",
+        /* short=       */ nullptr,
+        /* long=        */ "--node",
+        /* description= */ "add the mutable-server at HOST:PORT as node of the cluster",
+        /* callback=    */ [](const char *str){
+            try {
+                Cluster::Get().add_node(Cluster::Node::Parse(str));
+            } catch (invalid_argument) {
+                std::cerr << "Invalid node " << str << ", expected HOST:PORT.\n";
+                std::exit(EXIT_FAILURE);
+            }
+        }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Cluster",
+        /* short=       */ nullptr,
+        /* long=        */ "--cluster-batch-size",
+        /* description= */ "the maximum number of rows per record batch sent to a node of the cluster",
+        /* callback=    */ [](std::size_t n){ options::batch_size = std::max<std::size_t>(n, 1); }
+    );
+}
+
+}
+
+Cluster::Node Cluster::Node::Parse(std::string_view str)
+{
+    const auto colon = str.rfind(':');
+    if (colon == std::string_view::npos or colon == 0 or colon + 1 == str.size())
+        throw invalid_argument("expected HOST:PORT");
+    unsigned port = 0;
+    for (char c : str.substr(colon + 1)) {
+        if (c < '0' or c > '9') throw invalid_argument("invalid port");
+        port = port * 10 + (c - '0');
+        if (port > UINT16_MAX) throw invalid_argument("invalid port");
+    }
+    return Node{ std::string(str.substr(0, colon)), uint16_t(port) };
+}
+
+Cluster & Cluster::Get()
+{
+    static Cluster the_cluster;
+    return the_cluster;
+}
+
+std::size_t Cluster::Node_Of(const Type &type, const Value &value, std::size_t num_nodes)
+{
+    M_insist(num_nodes > 0);
+    if (type.is_character_sequence())
+        return StrHash{}(reinterpret_cast<const char*>(value.as_p())) % num_nodes;
+    return std::hash<Value>{}(value) % num_nodes;
+}
+
+std::size_t Cluster::partition(const Table &table, const ThreadSafePooledString &attr, Diagnostic &diag)
+{
+    const Schema &schema = table.schema();
+    std::optional<std::size_t> attr_idx;
+    for (std::size_t idx = 0; idx != schema.num_entries(); ++idx) {
+        if (schema[idx].id.name == attr)
+            attr_idx = idx;
+    }
+    if (not attr_idx) {
+        diag.err() << "Table " << table.name() << " has no attribute " << attr << ".\n";
+        return 0;
+    }
+
+    const Type &type = *schema[*attr_idx].type;
+    return send_rows(table, [&](const Tuple &tuple, std::vector<bool> &destinations) {
+        const std::size_t node = tuple.is_null(*attr_idx) ? 0
+                                                          : Node_Of(type, tuple[*attr_idx], destinations.size());
+        destinations[node] = true;
+    }, diag);
+}
+
+std::size_t Cluster::broadcast(const Table &table, Diagnostic &diag)
+{
+    return send_rows(table, [](const Tuple&, std::vector<bool> &destinations) {
+        destinations.assign(destinations.size(), true);
+    }, diag);
+}
+
+std::size_t Cluster::send_rows(const Table &table,
+                               const std::function<void(const Tuple&, std::vector<bool>&)> &node_of,
+                               Diagnostic &diag)
+{
+    const auto nodes = this->nodes();
+    if (nodes.empty()) {
+        diag.err() << "The cluster has no nodes, see --node and \\add_node.\n";
+        return 0;
+    }
+
+    std::vector<std::unique_ptr<wire::Client>> clients;
+    std::vector<wire::BatchWriter> batches;
+    try {
+        for (auto &node : nodes) {
+            clients.push_back(std::make_unique<wire::Client>(node.host, node.port));
+            batches.emplace_back(table.schema());
+        }
+
+        std::string error;
+        auto send = [&](std::size_t node) {
+            if (not clients[node]->append(*table.name(), batches[node].finish(), error)) {
+                std::ostringstream oss;
+                oss << "node " << nodes[node] << ": " << error;
+                throw std::runtime_error(oss.str());
+            }
+        };
+
+        /*----- Load the rows and add each to the batches of its destinations, sending full batches. -----*/
+        const Schema &schema = table.schema();
+        const std::size_t num_rows = table.store().num_rows();
+        auto loader = Interpreter::compile_load(schema, table.store().memory().addr(), table.layout(), schema);
+        Tuple tuple(schema);
+        Tuple *args[] = { &tuple };
+        std::vector<bool> destinations(nodes.size());
+        for (std::size_t row = 0; row != num_rows; ++row) {
+            loader(args);
+            destinations.assign(nodes.size(), false);
+            node_of(tuple, destinations);
+            for (std::size_t node = 0; node != nodes.size(); ++node) {
+                if (not destinations[node]) continue;
+                batches[node].append(tuple);
+                if (batches[node].num_rows() == options::batch_size)
+                    send(node);
+            }
+        }
+
+        /*----- Send the remaining rows. -----*/
+        for (std::size_t node = 0; node != nodes.size(); ++node) {
+            if (batches[node].num_rows())
+                send(node);
+        }
+        return num_rows;
+    } catch (std::runtime_error e) {
+        diag.err() << "Could not send the rows of " << table.name() << ": " << e.what() << '\n';
+        return 0;
+    }
+}
+
+bool Cluster::gather(std::string_view sql, const consumer_type &consumer, Diagnostic &diag)
+{
+    const auto nodes = this->nodes();
+    if (nodes.empty()) {
+        diag.err() << "The cluster has no nodes, see --node and \\add_node.\n";
+        return false;
+    }
+
+    std::optional<Schema> schema; ///< the schema of the result, as sent by the first node
+    std::vector<std::string> errors(nodes.size());
+    std::mutex mutex; // serializes the consumer
+
+    auto fragment = [&](std::size_t node) {
+        std::optional<Schema> node_schema;
+        try {
+            wire::Client client(nodes[node].host, nodes[node].port);
+            auto on_schema = [&](std::string_view payload) {
+                node_schema.emplace(wire::decode_schema(payload));
+                std::lock_guard<std::mutex> lock(mutex);
+                if (not schema)
+                    schema = *node_schema;
+                else if (schema->num_entries() != node_schema->num_entries())
+                    throw invalid_argument("the schema of the result differs between nodes");
+            };
+            auto on_batch = [&](std::string_view payload) {
+                M_insist(bool(node_schema), "schema must precede the first batch");
+                wire::BatchReader R(*node_schema, payload);
+                Tuple tuple(*node_schema);
+                std::lock_guard<std::mutex> lock(mutex);
+                while (not R.empty()) {
+                    R.read(tuple);
+                    consumer(*schema, tuple);
+                }
+            };
+            client.query(sql, on_schema, on_batch, errors[node]);
+        } catch (const std::exception &e) {
+            errors[node] = e.what();
+        }
+    };
+
+    /*----- Execute the fragments on all nodes concurrently. -----*/
+    std::vector<std::thread> threads;
+    for (std::size_t node = 1; node < nodes.size(); ++node)
+        threads.emplace_back(fragment, node);
+    fragment(0);
+    for (auto &t : threads)
+        t.join();
+
+    bool success = true;
+    for (std::size_t node = 0; node != nodes.size(); ++node) {
+        if (errors[node].empty()) continue;
+        diag.err() << "Query failed on node " << nodes[node] << ": " << errors[node];
+        if (errors[node].back() != '\n') diag.err() << '\n';
+        success = false;
+    }
+    return success;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutable/catalog/Scheduler.hpp>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/util/Diagnostic.hpp>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace m {
+
+/** The nodes of a cluster of `mutable-server`s, see `--node` and `\add_node`, and the *exchanges* moving rows between
+ * them.  Rows move in columnar record batches over the wire protocol, see `m::wire`.
+ *
+ * - *Repartition* distributes the rows of a table across the nodes by the hash of an attribute, see `partition()`.
+ *   Partitioning the tables of a query on their join keys makes equi-joins local to each node.
+ * - *Broadcast* copies the rows of a table to every node, e.g. of a small dimension table, see `broadcast()`.
+ * - *Gather* executes a query on every node and combines the rows of the results, see `gather()`.
+ *
+ * The nodes execute their fragment of a query with their own backend, e.g. the WebAssembly backend on V8.  The tables
+ * must be created on every node beforehand.  The coordinator, i.e. the instance issuing the exchanges, needs not be a
+ * node itself. */
+struct Cluster
+{
+    /** A node of the cluster. */
+    struct Node
+    {
+        std::string host;
+        uint16_t port;
+
+        /** Parses a node given as `HOST:PORT`.  Throws `invalid_argument` if \p str is malformed. */
+        static Node Parse(std::string_view str);
+
+        friend std::ostream & operator<<(std::ostream &out, const Node &node) {
+            return out << node.host << ':' << node.port;
+        }
+    };
+
+    using consumer_type = std::function<void(const Schema&, const Tuple&)>;
+
+    private:
+    std::vector<Node> nodes_;
+    ///> the record batches received by `mutable-server` by table name, staged by transaction until they are appended
+    std::unordered_map<const Scheduler::Transaction*, std::vector<std::pair<std::string, std::string>>> staged_;
+    mutable std::mutex mutex_;
+
+    Cluster() = default;
+
+    public:
+    static Cluster & Get();
+
+    /** Adds \p node to the cluster. */
+    void add_node(Node node) { std::lock_guard<std::mutex> lock(mutex_); nodes_.push_back(std::move(node)); }
+    /** Returns the nodes of the cluster. */
+    std::vector<Node> nodes() const { std::lock_guard<std::mutex> lock(mutex_); return nodes_; }
+
+    /** Returns the index of the node receiving a row whose partitioning attribute of `Type` \p type has value \p value
+     * among \p num_nodes nodes. */
+    static std::size_t Node_Of(const Type &type, const Value &value, std::size_t num_nodes);
+
+    /** Sends every row of \p table to the node chosen by the hash of its attribute \p attr, see `Node_Of()`.  Rows
+     * with NULL in \p attr are sent to the first node.  Returns the number of rows sent.  Errors are reported to
+     * \p diag. */
+    std::size_t partition(const Table &table, const ThreadSafePooledString &attr, Diagnostic &diag);
+
+    /** Sends every row of \p table to every node.  Returns the number of rows sent to each node.  Errors are reported
+     * to \p diag. */
+    std::size_t broadcast(const Table &table, Diagnostic &diag);
+
+    /** Executes the query \p sql on every node concurrently and passes the rows of the results to \p consumer, one at a
+     * time.  Returns `false` if the query failed on any node.  Errors are reported to \p diag. */
+    bool gather(std::string_view sql, const consumer_type &consumer, Diagnostic &diag);
+
+    /** Stages the record batch \p batch received for table \p table_name by transaction \p t. */
+    void stage(const Scheduler::Transaction &t, std::string table_name, std::string batch) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        staged_[&t].emplace_back(std::move(table_name), std::move(batch));
+    }
+
+    /** Returns and forgets the record batches staged by transaction \p t. */
+    std::vector<std::pair<std::string, std::string>> take_staged(const Scheduler::Transaction *t) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = staged_.find(t);
+        if (it == staged_.end()) return {};
+        auto batches = std::move(it->second);
+        staged_.erase(it);
+        return batches;
+    }
+
+    private:
+    /** Sends the rows of \p table to the nodes chosen by \p node_of for each row.  Returns the number of rows sent. */
+    std::size_t send_rows(const Table &table, const std::function<void(const Tuple&, std::vector<bool>&)> &node_of,
+                          Diagnostic &diag);
+};
+
+}
@@ -0,0 +1,112 @@
+#include "catalog/ColumnSketches.hpp"
+
+#include "backend/Interpreter.hpp"
+#include <algorithm>
+#include <functional>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/parse/AST.hpp>
+#include <mutable/util/fn.hpp>
+
+
+using namespace m;
+
+
+ColumnSketches & ColumnSketches::Get()
+{
+    static ColumnSketches the_sketches;
+    return the_sketches;
+}
+
+void ColumnSketches::update_unlocked(const ThreadSafePooledString &database_name, const Table &table)
+{
+    auto &T = sketches_[database_name][table.name()];
+    const std::size_t num_rows = table.store().num_rows();
+    if (num_rows < T.num_rows_seen)
+        T = TableSketches(); // the table was replaced by a smaller one, sketch it anew
+    if (num_rows == T.num_rows_seen)
+        return;
+
+    const Schema &schema = table.schema();
+    std::vector<sketch_type*> sketches;
+    for (auto &e : schema)
+        sketches.push_back(&T.columns[e.id.name]);
+
+    auto loader = Interpreter::compile_load(schema, table.store().memory().addr(), table.layout(), schema,
+                                            T.num_rows_seen);
+    Tuple tuple(schema);
+    Tuple *args[] = { &tuple };
+    std::hash<Value> h;
+    StrHash str_h;
+    for (std::size_t row = T.num_rows_seen; row != num_rows; ++row) {
+        loader(args);
+        for (std::size_t idx = 0; idx != schema.num_entries(); ++idx) {
+            if (tuple.is_null(idx)) continue; // NULL is not a distinct value
+            if (schema[idx].type->is_character_sequence())
+                sketches[idx]->add(str_h(reinterpret_cast<const char*>(tuple[idx].as_p())));
+            else
+                sketches[idx]->add(h(tuple[idx]));
+        }
+    }
+    T.num_rows_seen = num_rows;
+}
+
+std::optional<double> ColumnSketches::distinct_values(const ThreadSafePooledString &database_name,
+                                                      const Attribute &attr)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    update_unlocked(database_name, attr.table);
+    auto &T = sketches_[database_name][attr.table.name()];
+    if (auto it = T.columns.find(attr.name); it != T.columns.end())
+        return std::max(1., it->second.estimate());
+    return std::nullopt; // e.g. a hidden attribute
+}
+
+std::optional<double> ColumnSketches::estimate_groups(const std::vector<QueryGraph::group_type> &keys)
+{
+    Catalog &C = Catalog::Get();
+    if (not C.has_database_in_use()) return std::nullopt;
+    auto &database_name = C.get_database_in_use().name;
+
+    double num_groups = 1.;
+    for (auto &[grp, _] : keys) {
+        auto D = cast<const ast::Designator>(&grp.get());
+        if (not D) return std::nullopt;
+        auto attr = std::get_if<const Attribute*>(&D->target());
+        if (not attr) return std::nullopt;
+        auto num_distinct = distinct_values(database_name, **attr);
+        if (not num_distinct) return std::nullopt;
+        num_groups *= *num_distinct; // assume the keys are independent
+    }
+    return num_groups;
+}
+
+std::optional<double> ColumnSketches::join_selectivity(const cnf::CNF &condition)
+{
+    Catalog &C = Catalog::Get();
+    if (not C.has_database_in_use()) return std::nullopt;
+    auto &database_name = C.get_database_in_use().name;
+
+    auto get_attribute = [](const ast::Expr &e) -> const Attribute* {
+        if (auto D = cast<const ast::Designator>(&e)) {
+            if (auto attr = std::get_if<const Attribute*>(&D->target()))
+                return *attr;
+        }
+        return nullptr;
+    };
+
+    std::optional<double> selectivity;
+    for (auto &clause : condition) {
+        if (clause.size() != 1 or clause[0].negative()) continue;
+        auto binary = cast<const ast::BinaryExpr>(&clause[0].expr());
+        if (not binary or binary->op().type != TK_EQUAL) continue;
+        auto lhs = get_attribute(*binary->lhs);
+        auto rhs = get_attribute(*binary->rhs);
+        if (not lhs or not rhs) continue;
+        auto num_distinct_lhs = distinct_values(database_name, *lhs);
+        auto num_distinct_rhs = distinct_values(database_name, *rhs);
+        if (not num_distinct_lhs or not num_distinct_rhs) continue;
+        selectivity = selectivity.value_or(1.) / std::max(*num_distinct_lhs, *num_distinct_rhs);
+    }
+    return selectivity;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "util/HyperLogLog.hpp"
+#include <cstddef>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/CNF.hpp>
+#include <mutable/IR/QueryGraph.hpp>
+#include <mutable/util/Pool.hpp>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+
+namespace m {
+
+/** Maintains a `HyperLogLog` sketch of the distinct values of every column of the tables of all databases.  The
+ * sketches are fed the rows appended by `INSERT` and `IMPORT` when the rows are written.  Additionally, a lookup feeds
+ * all rows appended since the last update, such that the sketches of tables filled by other means are built on first
+ * use.  Since only appending rows is supported, the sketches never need to forget values.
+ *
+ * Cardinality estimators use the sketches to estimate the number of groups of a grouping and the selectivity of
+ * equi-joins. */
+struct ColumnSketches
+{
+    using sketch_type = HyperLogLog<>;
+
+    private:
+    struct TableSketches
+    {
+        ///> the sketches of the columns, by attribute name
+        std::unordered_map<ThreadSafePooledString, sketch_type> columns;
+        std::size_t num_rows_seen = 0; ///< the number of rows of the table fed into the sketches
+    };
+
+    ///> the sketches by database name and table name
+    std::unordered_map<ThreadSafePooledString, std::unordered_map<ThreadSafePooledString, TableSketches>> sketches_;
+    mutable std::mutex mutex_;
+
+    ColumnSketches() = default;
+
+    public:
+    static ColumnSketches & Get();
+
+    /** Feeds the rows of \p table of the database \p database_name appended since the last update into the sketches of
+     * its columns. */
+    void update(const ThreadSafePooledString &database_name, const Table &table) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        update_unlocked(database_name, table);
+    }
+
+    /** Returns the estimated number of distinct values of \p attr in the database \p database_name, or `std::nullopt`
+     * if the values of \p attr cannot be sketched. */
+    std::optional<double> distinct_values(const ThreadSafePooledString &database_name, const Attribute &attr);
+
+    /** Returns the estimated number of groups produced by grouping by \p keys in the database in use, or `std::nullopt`
+     * if any key is not a column. */
+    std::optional<double> estimate_groups(const std::vector<QueryGraph::group_type> &keys);
+
+    /** Returns the estimated selectivity of the equi-join clauses of \p condition in the database in use, assuming
+     * that the smaller domain of each pair of joined columns is contained in the larger, or `std::nullopt` if
+     * \p condition has no clause of the form `A.x = B.y`. */
+    std::optional<double> join_selectivity(const cnf::CNF &condition);
+
+    /** Discards all sketches. */
+    void clear() { std::lock_guard<std::mutex> lock(mutex_); sketches_.clear(); }
+
+    private:
+    void update_unlocked(const ThreadSafePooledString &database_name, const Table &table);
+};
+
+}
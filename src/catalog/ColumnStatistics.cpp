@@ -0,0 +1,325 @@
+#include "catalog/ColumnStatistics.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "util/WorkerPool.hpp"
+#include <cmath>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <numeric>
+#include <random>
+#include <unordered_set>
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** The number of rows sampled per table by `ANALYZE`. */
+std::size_t analyze_sample_size = 30000;
+/** The number of threads computing the statistics of the columns of a table.  0 means all threads of the
+ * `WorkerPool`. */
+std::size_t analyze_threads = 0;
+
+}
+
+__attribute__((constructor(201)))
+static void add_column_statistics_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Cardinality estimation",
+        /* short=       */ nullptr,
+        /* long=        */ "--analyze-sample-size",
+        /* description= */ "the number of rows sampled per table to compute column statistics with `analyze`",
+        /* callback=    */ [](std::size_t n){ options::analyze_sample_size = std::max<std::size_t>(n, 1); }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Cardinality estimation",
+        /* short=       */ nullptr,
+        /* long=        */ "--analyze-threads",
+        /* description= */ "the number of threads computing column statistics with `analyze` (0 means all threads of "
+                           "the worker pool)",
+        /* callback=    */ [](std::size_t n){ options::analyze_threads = n; }
+    );
+}
+
+/** Returns `true` iff the values of type \p ty can be represented as `double` for a histogram. */
+bool is_numeric(const Type *ty)
+{
+    return ty->is_boolean() or ty->is_numeric() or ty->is_date() or ty->is_date_time();
+}
+
+/** Returns the value \p v of type \p ty as `double`.  Decimals are scaled to their actual value. */
+double to_double(const Type *ty, const Value &v)
+{
+    if (ty->is_boolean()) return v.as_b();
+    if (ty->is_float()) return v.as_f();
+    if (ty->is_double()) return v.as_d();
+    if (auto n = cast<const Numeric>(ty); n and n->kind == Numeric::N_Decimal)
+        return v.as_i() / std::pow(10., n->scale);
+    return v.as_i();
+}
+
+/** Estimates the number of distinct values of a column of \p num_rows non-NULL values from a sample of \p num_sampled
+ * values with \p num_distinct distinct values, \p num_singletons of which occur exactly once.  This is the estimator
+ * of Haas and Stokes, also used by PostgreSQL. */
+double estimate_distinct(std::size_t num_distinct, std::size_t num_singletons, std::size_t num_sampled,
+                         double num_rows)
+{
+    if (num_sampled >= num_rows) return num_distinct; // the sample is complete
+    if (num_singletons == num_sampled) return num_rows; // all sampled values are unique, assume a key
+    const double n = num_sampled;
+    const double estimate = n * num_distinct / (n - num_singletons + num_singletons * n / num_rows);
+    return std::clamp(estimate, double(num_distinct), num_rows);
+}
+
+/** Selects the most common values among the distinct sampled values \p counts, given with their number of occurrences,
+ * of \p num_sampled sampled values.  If all distinct values fit, all are selected.  Otherwise, the values occurring
+ * more than once and significantly more often than the average value are selected, at most `NUM_MCVS`. */
+template<typename T>
+std::vector<std::pair<T, std::size_t>> select_mcvs(std::vector<std::pair<T, std::size_t>> counts,
+                                                   std::size_t num_sampled)
+{
+    if (counts.size() <= ColumnHistogram::NUM_MCVS)
+        return counts;
+    const double threshold = 1.25 * num_sampled / counts.size();
+    std::erase_if(counts, [threshold](auto &c) { return c.second < 2 or c.second <= threshold; });
+    std::sort(counts.begin(), counts.end(), [](auto &lhs, auto &rhs) { return lhs.second > rhs.second; });
+    if (counts.size() > ColumnHistogram::NUM_MCVS)
+        counts.resize(ColumnHistogram::NUM_MCVS);
+    return counts;
+}
+
+}
+
+
+/*======================================================================================================================
+ * ColumnHistogram
+ *====================================================================================================================*/
+
+ColumnHistogram ColumnHistogram::Build(std::vector<double> values, std::size_t num_nulls, std::size_t num_rows)
+{
+    ColumnHistogram H;
+    const std::size_t num_sampled = values.size() + num_nulls;
+    if (num_sampled == 0) return H;
+    H.null_fraction = double(num_nulls) / num_sampled;
+    if (values.empty()) return H;
+
+    /* Count the occurrences of the distinct sampled values. */
+    std::sort(values.begin(), values.end());
+    std::vector<std::pair<double, std::size_t>> counts;
+    std::size_t num_singletons = 0;
+    for (auto v : values) {
+        if (counts.empty() or counts.back().first != v)
+            counts.emplace_back(v, 0);
+        ++counts.back().second;
+    }
+    for (auto &c : counts)
+        num_singletons += c.second == 1;
+    H.num_distinct = estimate_distinct(counts.size(), num_singletons, values.size(),
+                                       num_rows * (1. - H.null_fraction));
+
+    /* Extract the MCVs, ordered by value. */
+    auto mcvs = select_mcvs(counts, values.size());
+    std::sort(mcvs.begin(), mcvs.end());
+    std::size_t num_mcv_values = 0;
+    for (auto &[v, count] : mcvs) {
+        H.mcvs.emplace_back(v, double(count) / num_sampled);
+        num_mcv_values += count;
+    }
+
+    /* Build the equi-depth histogram over the remaining values.  Each bucket holds the same number of sampled values
+     * and is bounded by the sampled values at its borders. */
+    std::vector<double> rest;
+    rest.reserve(values.size() - num_mcv_values);
+    for (auto v : values) {
+        auto it = std::lower_bound(H.mcvs.begin(), H.mcvs.end(), v, [](auto &mcv, double v) { return mcv.first < v; });
+        if (it == H.mcvs.end() or it->first != v)
+            rest.push_back(v);
+    }
+    H.histogram_fraction = double(rest.size()) / num_sampled;
+    if (not rest.empty()) {
+        const std::size_t num_buckets = std::min(NUM_BUCKETS, std::max<std::size_t>(rest.size() - 1, 1));
+        for (std::size_t i = 0; i <= num_buckets; ++i)
+            H.bounds.push_back(rest[i * (rest.size() - 1) / num_buckets]);
+    }
+    return H;
+}
+
+ColumnHistogram ColumnHistogram::Build(std::vector<std::string> values, std::size_t num_nulls, std::size_t num_rows)
+{
+    ColumnHistogram H;
+    const std::size_t num_sampled = values.size() + num_nulls;
+    if (num_sampled == 0) return H;
+    H.null_fraction = double(num_nulls) / num_sampled;
+    if (values.empty()) return H;
+
+    /* Count the occurrences of the distinct sampled values. */
+    std::unordered_map<std::string, std::size_t> occurrences;
+    for (auto &v : values)
+        ++occurrences[v];
+    std::vector<std::pair<std::string, std::size_t>> counts(occurrences.begin(), occurrences.end());
+    std::size_t num_singletons = 0;
+    for (auto &c : counts)
+        num_singletons += c.second == 1;
+    H.num_distinct = estimate_distinct(counts.size(), num_singletons, values.size(),
+                                       num_rows * (1. - H.null_fraction));
+
+    std::size_t num_mcv_values = 0;
+    for (auto &[v, count] : select_mcvs(std::move(counts), values.size())) {
+        H.string_mcvs.emplace_back(v, double(count) / num_sampled);
+        num_mcv_values += count;
+    }
+    H.histogram_fraction = double(values.size() - num_mcv_values) / num_sampled;
+    return H;
+}
+
+double ColumnHistogram::selectivity_equal(double value) const
+{
+    auto it = std::lower_bound(mcvs.begin(), mcvs.end(), value, [](auto &mcv, double v) { return mcv.first < v; });
+    if (it != mcvs.end() and it->first == value)
+        return it->second;
+    if (bounds.empty() or value < bounds.front() or value > bounds.back())
+        return 0;
+    /* Assume the values of the histogram are uniformly distributed over its distinct values. */
+    return histogram_fraction / std::max(1., num_distinct - mcvs.size());
+}
+
+double ColumnHistogram::selectivity_equal(const std::string &value) const
+{
+    for (auto &[v, frequency] : string_mcvs) {
+        if (v == value)
+            return frequency;
+    }
+    return histogram_fraction / std::max(1., num_distinct - string_mcvs.size());
+}
+
+double ColumnHistogram::selectivity_less(double value, bool inclusive) const
+{
+    double selectivity = 0;
+    for (auto &[v, frequency] : mcvs) {
+        if (v < value or (inclusive and v == value))
+            selectivity += frequency;
+    }
+
+    if (bounds.empty() or value < bounds.front())
+        return selectivity;
+    if (value > bounds.back() or (inclusive and value == bounds.back()))
+        return selectivity + histogram_fraction;
+    if (bounds.size() == 1)
+        return selectivity; // all values of the histogram equal `value`
+    /* Interpolate linearly within the bucket containing `value`. */
+    const std::size_t num_buckets = bounds.size() - 1;
+    const std::size_t bucket = std::min<std::size_t>(
+        std::upper_bound(bounds.begin(), bounds.end(), value) - bounds.begin() - 1, num_buckets - 1
+    );
+    const double lo = bounds[bucket], hi = bounds[bucket + 1];
+    const double within = hi > lo ? (value - lo) / (hi - lo) : 0.;
+    return selectivity + histogram_fraction * (bucket + within) / num_buckets;
+}
+
+
+/*======================================================================================================================
+ * ColumnStatistics
+ *====================================================================================================================*/
+
+ColumnStatistics & ColumnStatistics::Get()
+{
+    static ColumnStatistics the_statistics;
+    return the_statistics;
+}
+
+void ColumnStatistics::analyze(const ThreadSafePooledString &database_name, const Table &table)
+{
+    const std::size_t num_rows = table.store().num_rows();
+    const Schema &schema = table.schema();
+    const std::size_t num_columns = schema.num_entries();
+    const std::size_t sample_size = options::analyze_sample_size;
+
+    /* Draw the ids of the sampled rows.  If the table is not larger than the sample, all rows are used.  Otherwise,
+     * Floyd's algorithm draws distinct row ids in time linear in the sample size. */
+    std::vector<std::size_t> row_ids;
+    if (num_rows <= sample_size) {
+        row_ids.resize(num_rows);
+        std::iota(row_ids.begin(), row_ids.end(), 0);
+    } else {
+        std::mt19937_64 g(0); // deterministic, for reproducible estimates
+        std::unordered_set<std::size_t> ids;
+        for (std::size_t j = num_rows - sample_size; j != num_rows; ++j) {
+            if (not ids.insert(std::uniform_int_distribution<std::size_t>(0, j)(g)).second)
+                ids.insert(j);
+        }
+        row_ids.assign(ids.begin(), ids.end());
+        std::sort(row_ids.begin(), row_ids.end());
+    }
+
+    /* Load the sampled rows column-wise. */
+    std::vector<std::vector<double>> numeric_values(num_columns);
+    std::vector<std::vector<std::string>> string_values(num_columns);
+    std::vector<std::size_t> num_nulls(num_columns, 0);
+    Tuple tuple(schema);
+    Tuple *args[] = { &tuple };
+    auto collect = [&]() {
+        for (std::size_t idx = 0; idx != num_columns; ++idx) {
+            const Type *ty = schema[idx].type;
+            if (tuple.is_null(idx))
+                ++num_nulls[idx];
+            else if (ty->is_character_sequence())
+                string_values[idx].emplace_back(reinterpret_cast<const char*>(tuple[idx].as_p()));
+            else if (is_numeric(ty))
+                numeric_values[idx].push_back(to_double(ty, tuple[idx]));
+        }
+    };
+    if (row_ids.size() == num_rows) {
+        auto loader = Interpreter::compile_load(schema, table.store().memory().addr(), table.layout(), schema);
+        for (std::size_t row = 0; row != num_rows; ++row) {
+            loader(args);
+            collect();
+        }
+    } else {
+        for (auto row : row_ids) {
+            auto loader = Interpreter::compile_load(schema, table.store().memory().addr(), table.layout(), schema,
+                                                    row);
+            loader(args);
+            collect();
+        }
+    }
+
+    /* Compute the statistics of the columns in parallel. */
+    std::vector<ColumnHistogram> histograms(num_columns);
+    WorkerPool::Get().parallel_for(num_columns, [&](std::size_t idx) {
+        const Type *ty = schema[idx].type;
+        if (ty->is_character_sequence())
+            histograms[idx] = ColumnHistogram::Build(std::move(string_values[idx]), num_nulls[idx], num_rows);
+        else if (is_numeric(ty))
+            histograms[idx] = ColumnHistogram::Build(std::move(numeric_values[idx]), num_nulls[idx], num_rows);
+    }, options::analyze_threads);
+
+    auto statistics = std::make_shared<TableStatistics>();
+    statistics->num_rows = num_rows;
+    for (std::size_t idx = 0; idx != num_columns; ++idx) {
+        const Type *ty = schema[idx].type;
+        if (ty->is_character_sequence() or is_numeric(ty))
+            statistics->columns.emplace(schema[idx].id.name, std::move(histograms[idx]));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    tables_[database_name][table.name()] = std::move(statistics);
+}
+
+std::shared_ptr<const ColumnStatistics::TableStatistics>
+ColumnStatistics::find(const ThreadSafePooledString &database_name, const ThreadSafePooledString &table_name) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto db_it = tables_.find(database_name); db_it != tables_.end()) {
+        if (auto it = db_it->second.find(table_name); it != db_it->second.end())
+            return it->second;
+    }
+    return nullptr;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/util/Pool.hpp>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace m {
+
+/** The statistics of the values of a single column: the fraction of NULL values, the number of distinct values, the
+ * most common values (MCVs) with their frequencies, and an equi-depth histogram of the remaining values.  The
+ * statistics are computed from a sample of the column by `ANALYZE`.  Numeric values, dates, and datetimes are
+ * represented as `double`.  Of character sequences, only the MCVs are kept since a histogram over strings cannot be
+ * interpolated. */
+struct ColumnHistogram
+{
+    ///> the maximum number of buckets of the equi-depth histogram
+    static constexpr std::size_t NUM_BUCKETS = 100;
+    ///> the maximum number of most common values
+    static constexpr std::size_t NUM_MCVS = 100;
+
+    double null_fraction = 0; ///< the fraction of rows that are NULL
+    double num_distinct = 0; ///< the estimated number of distinct non-NULL values
+    ///> the most common numeric values and their frequencies as fractions of all rows, ordered by value
+    std::vector<std::pair<double, double>> mcvs;
+    ///> the most common strings and their frequencies as fractions of all rows
+    std::vector<std::pair<std::string, double>> string_mcvs;
+    ///> the bucket boundaries of the equi-depth histogram over the non-NULL values that are not MCVs
+    std::vector<double> bounds;
+    ///> the fraction of rows that are neither NULL nor an MCV, i.e. the rows covered by the histogram, if any
+    double histogram_fraction = 0;
+
+    /** Computes the statistics of a column of \p num_rows rows from the sampled non-NULL \p values and \p num_nulls
+     * sampled NULL values. */
+    static ColumnHistogram Build(std::vector<double> values, std::size_t num_nulls, std::size_t num_rows);
+    /** Computes the statistics of a column of character sequences of \p num_rows rows from the sampled non-NULL
+     * \p values and \p num_nulls sampled NULL values. */
+    static ColumnHistogram Build(std::vector<std::string> values, std::size_t num_nulls, std::size_t num_rows);
+
+    /** Returns the estimated fraction of rows equal to \p value. */
+    double selectivity_equal(double value) const;
+    /** Returns the estimated fraction of rows equal to \p value. */
+    double selectivity_equal(const std::string &value) const;
+    /** Returns the estimated fraction of rows less than \p value, or less than or equal to \p value if \p inclusive. */
+    double selectivity_less(double value, bool inclusive) const;
+    /** Returns the estimated fraction of rows greater than \p value, or greater than or equal to \p value if
+     * \p inclusive. */
+    double selectivity_greater(double value, bool inclusive) const {
+        return std::max(0., 1. - null_fraction - selectivity_less(value, not inclusive));
+    }
+};
+
+/** The statistics of the columns of all analyzed tables, by database and table.  The statistics are computed by the
+ * `analyze` instruction from a uniform sample of each table.  They are not maintained on writes; rows appended after
+ * `ANALYZE` are only accounted for by re-analyzing their table. */
+struct ColumnStatistics
+{
+    /** The statistics of a table. */
+    struct TableStatistics
+    {
+        std::size_t num_rows = 0; ///< the number of rows of the table when it was analyzed
+        ///> the statistics of the columns, by attribute name
+        std::unordered_map<ThreadSafePooledString, ColumnHistogram> columns;
+    };
+
+    private:
+    std::unordered_map<ThreadSafePooledString,
+                       std::unordered_map<ThreadSafePooledString, std::shared_ptr<const TableStatistics>>> tables_;
+    mutable std::mutex mutex_;
+
+    ColumnStatistics() = default;
+
+    public:
+    static ColumnStatistics & Get();
+
+    /** Computes the statistics of all columns of \p table of the database \p database_name from a uniform sample of
+     * `--analyze-sample-size` rows.  The statistics of the columns are computed in parallel. */
+    void analyze(const ThreadSafePooledString &database_name, const Table &table);
+
+    /** Returns the statistics of the table \p table_name of the database \p database_name, or `nullptr` if the table
+     * was not analyzed. */
+    std::shared_ptr<const TableStatistics> find(const ThreadSafePooledString &database_name,
+                                                const ThreadSafePooledString &table_name) const;
+
+    /** Discards all statistics. */
+    void clear() { std::lock_guard<std::mutex> lock(mutex_); tables_.clear(); }
+};
+
+}
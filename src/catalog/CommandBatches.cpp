@@ -0,0 +1,139 @@
+#include "catalog/CommandBatches.hpp"
+
+#include "catalog/ResultSinks.hpp"
+#include "util/WorkerPool.hpp"
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/util/macro.hpp>
+#include <utility>
+
+
+using namespace m;
+
+
+CommandBatches::~CommandBatches()
+{
+    if (not dispatcher_.joinable())
+        return; // never used
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    batch_submitted_.notify_one();
+    dispatcher_.join();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        dispatcher_stopped_ = true;
+    }
+    batch_scheduled_.notify_one();
+    completer_.join();
+}
+
+CommandBatches & CommandBatches::Get()
+{
+    static CommandBatches the_command_batches;
+    return the_command_batches;
+}
+
+std::shared_ptr<const CommandBatches::Batch>
+CommandBatches::submit(std::vector<std::string> statements, callback_type on_complete, prepare_type prepare)
+{
+    auto batch = std::make_shared<Batch>();
+    batch->statements_.reserve(statements.size());
+    for (auto &sql : statements) {
+        auto &stmt = *batch->statements_.emplace_back(std::make_unique<Batch::statement_t>());
+        stmt.sql = std::move(sql);
+        stmt.diag = std::make_unique<Diagnostic>(false, stmt.out, stmt.err);
+    }
+    batch->on_complete_ = std::move(on_complete);
+    batch->prepare_ = std::move(prepare);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        M_insist(not stop_, "must not submit batches while shutting down");
+        submitted_.push_back(batch);
+        if (not dispatcher_.joinable()) {
+            dispatcher_ = std::thread(&CommandBatches::dispatch, this);
+            completer_ = std::thread(&CommandBatches::complete, this);
+        }
+    }
+    batch_submitted_.notify_one();
+    return batch;
+}
+
+void CommandBatches::dispatch()
+{
+    WorkerPool::Pin_To_Reserved_CPUs();
+    Scheduler &S = Catalog::Get().scheduler();
+    for (;;) {
+        std::shared_ptr<Batch> batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            batch_submitted_.wait(lock, [this]() { return stop_ or not submitted_.empty(); });
+            if (submitted_.empty())
+                return; // stopped and all submitted batches are scheduled
+            batch = std::move(submitted_.front());
+            submitted_.pop_front();
+        }
+
+        /*----- Parse each statement and schedule it right away, such that it executes while parsing the next. -----*/
+        batch->transaction_ = S.begin_transaction();
+        if (batch->prepare_)
+            batch->prepare_(*batch->transaction_);
+        for (auto &stmt : batch->statements_) {
+            auto command = command_from_string(*stmt->diag, stmt->sql);
+            if (stmt->diag->num_errors() == 0 and command)
+                stmt->executed = S.schedule_command(*batch->transaction_, std::move(command), *stmt->diag);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            scheduled_.push_back(std::move(batch));
+        }
+        batch_scheduled_.notify_one();
+    }
+}
+
+void CommandBatches::complete()
+{
+    WorkerPool::Pin_To_Reserved_CPUs();
+    Scheduler &S = Catalog::Get().scheduler();
+    for (;;) {
+        std::shared_ptr<Batch> batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            batch_scheduled_.wait(lock, [this]() { return dispatcher_stopped_ or not scheduled_.empty(); });
+            if (scheduled_.empty())
+                return; // stopped and all scheduled batches are completed
+            batch = std::move(scheduled_.front());
+            scheduled_.pop_front();
+        }
+
+        /*----- Collect the results of the statements in order. -----*/
+        bool success = true;
+        batch->results_.resize(batch->statements_.size());
+        for (std::size_t i = 0; i != batch->statements_.size(); ++i) {
+            auto &stmt = *batch->statements_[i];
+            auto &result = batch->results_[i];
+            result.success = stmt.executed.valid() and stmt.executed.get() and stmt.diag->num_errors() == 0;
+            result.output = stmt.out.str();
+            result.errors = stmt.err.str();
+            success = success and result.success;
+        }
+        batch->statements_.clear(); // release the statements and their diagnostics
+
+        /*----- End the transaction and complete the batch. -----*/
+        ResultSinks::Get().remove(*batch->transaction_);
+        if (success)
+            batch->committed_ = S.commit(std::move(batch->transaction_));
+        else
+            S.abort(std::move(batch->transaction_));
+        {
+            std::lock_guard<std::mutex> lock(batch->mutex_);
+            batch->done_ = true;
+        }
+        batch->completed_.notify_all();
+        if (batch->on_complete_)
+            batch->on_complete_(*batch);
+    }
+}
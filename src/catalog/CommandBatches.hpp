@@ -0,0 +1,117 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutable/catalog/Scheduler.hpp>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace m {
+
+/** Executes batches of SQL statements asynchronously on behalf of embedding applications that issue many small
+ * statements.  `submit()` returns immediately with a single handle for the entire batch, instead of one round trip
+ * through `Scheduler::autocommit()` per statement.
+ *
+ * All statements of a batch are executed in order in one transaction, which is committed if all statements succeeded
+ * and aborted otherwise.  A statement is executed regardless of the success of earlier statements of its batch, like a
+ * script.  Statements are parsed by a dispatcher thread and scheduled as soon as they are parsed, such that parsing
+ * later statements overlaps with executing earlier ones.  Semantic analysis remains with the scheduler, since it
+ * depends on the effects of the earlier statements, e.g. on tables created by them.  A completer thread waits for the
+ * statements, ends the transaction, and completes the batch.  Both threads are started on first use. */
+struct CommandBatches
+{
+    /** The outcome of a single statement of a batch. */
+    struct statement_result
+    {
+        bool success = false; ///< whether the statement was parsed, analyzed, and executed without errors
+        std::string output; ///< the messages of the statement, e.g. of a `CREATE TABLE`
+        std::string errors; ///< the diagnostics of parsing, semantic analysis, and execution
+    };
+
+    struct Batch;
+    using callback_type = std::function<void(const Batch&)>;
+    using prepare_type = std::function<void(const Scheduler::Transaction&)>;
+
+    /** The completion handle of a submitted batch. */
+    struct Batch
+    {
+        friend struct CommandBatches;
+
+        private:
+        /** A statement in flight. */
+        struct statement_t
+        {
+            std::string sql;
+            std::ostringstream out, err;
+            std::unique_ptr<Diagnostic> diag;
+            std::future<bool> executed; ///< invalid if the statement could not be parsed
+        };
+
+        std::vector<std::unique_ptr<statement_t>> statements_;
+        std::vector<statement_result> results_;
+        callback_type on_complete_;
+        prepare_type prepare_;
+        std::unique_ptr<Scheduler::Transaction> transaction_;
+        bool committed_ = false;
+        bool done_ = false;
+        mutable std::mutex mutex_; ///< protects `done_`
+        mutable std::condition_variable completed_;
+
+        public:
+        /** Returns `true` iff all statements of this batch completed. */
+        bool done() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return done_;
+        }
+        /** Blocks until all statements of this batch completed. */
+        void wait() const {
+            std::unique_lock<std::mutex> lock(mutex_);
+            completed_.wait(lock, [this]() { return done_; });
+        }
+
+        /** Returns the results of the statements in order of submission.  Blocks until the batch completed. */
+        const std::vector<statement_result> & results() const { wait(); return results_; }
+        /** Returns `true` iff the transaction of this batch was committed.  Blocks until the batch completed. */
+        bool committed() const { wait(); return committed_; }
+    };
+
+    private:
+    std::deque<std::shared_ptr<Batch>> submitted_; ///< batches whose statements are not yet scheduled
+    std::deque<std::shared_ptr<Batch>> scheduled_; ///< batches whose statements are scheduled but not yet completed
+    std::mutex mutex_; ///< protects both queues and the flags
+    std::condition_variable batch_submitted_;
+    std::condition_variable batch_scheduled_;
+    bool stop_ = false; ///< whether the dispatcher shall terminate once all submitted batches are scheduled
+    bool dispatcher_stopped_ = false; ///< whether the completer shall terminate once all scheduled batches completed
+    std::thread dispatcher_;
+    std::thread completer_;
+
+    CommandBatches() = default;
+    ~CommandBatches();
+
+    public:
+    static CommandBatches & Get();
+
+    /** Submits \p statements for asynchronous execution as a single batch and returns its completion handle without
+     * blocking.  Once the batch completed, \p on_complete is called by the completer thread and must not throw.  \p
+     * prepare is called with the transaction of the batch before its first statement is scheduled, e.g. to register a
+     * sink for the results of its queries in `ResultSinks`, which is removed before the transaction ends. */
+    std::shared_ptr<const Batch> submit(std::vector<std::string> statements, callback_type on_complete = {},
+                                        prepare_type prepare = {});
+
+    private:
+    /** Parses and schedules the statements of submitted batches until `stop_` is set. */
+    void dispatch();
+    /** Waits for the statements of scheduled batches and completes the batches until `dispatcher_stopped_` is set. */
+    void complete();
+};
+
+}
@@ -0,0 +1,225 @@
+#include "catalog/Compaction.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "catalog/ColumnSketches.hpp"
+#include "catalog/Maintenance.hpp"
+#include "catalog/MaterializedViews.hpp"
+#include "catalog/NullFreeColumns.hpp"
+#include "catalog/Partitionings.hpp"
+#include "catalog/ResultCache.hpp"
+#include "catalog/SortOrders.hpp"
+#include "storage/PaxStore.hpp"
+#include <algorithm>
+#include <iostream>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <optional>
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** The fraction of dead versions of a table at which the table is compacted. */
+double compaction_threshold = .25;
+
+}
+
+__attribute__((constructor(201)))
+static void add_compaction_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<double>(
+        /* group=       */ "Catalog",
+        /* short=       */ nullptr,
+        /* long=        */ "--compaction-threshold",
+        /* description= */ "compact a multi-versioned table once this fraction of its rows are deleted versions",
+        /* callback=    */ [](double threshold){
+            if (threshold <= 0. or threshold > 1.)
+                std::cerr << "warning: ignore invalid compaction threshold " << threshold << std::endl;
+            else
+                options::compaction_threshold = threshold;
+        }
+    );
+}
+
+/** Returns the index of the hidden attribute \p name within \p schema, the schema of \p table, if any. */
+std::optional<std::size_t> find_hidden(const Table &table, const Schema &schema, const char *name)
+{
+    auto it = schema.find(Schema::Identifier(table.name(), Catalog::Get().pool(name)));
+    if (it == schema.cend()) return std::nullopt;
+    return std::distance(schema.cbegin(), it);
+}
+
+}
+
+Compaction & Compaction::Get()
+{
+    static Compaction the_compaction;
+    return the_compaction;
+}
+
+double Compaction::threshold() { return options::compaction_threshold; }
+
+void Compaction::rows_overwritten(Database &DB, Table &T, std::size_t first_row)
+{
+    {
+        auto &compaction = Get();
+        std::lock_guard<std::mutex> lock(compaction.mutex_);
+        compaction.data_versions_[&T] = compaction.next_data_version_++;
+    }
+    DB.invalidate_indexes(T.name());
+    ResultCache::Get().invalidate(T);
+    if (auto pax = cast<const PaxStore>(&T.store()))
+        pax->invalidate_synopses(first_row);
+    ColumnSketches::Get().update(DB.name, T); // a table shrunk by removing rows is sketched anew
+    SortOrders::Get().reset(DB.name, T);
+    Partitionings::Get().invalidate(DB.name, T);
+    MaterializedViews::Get().rows_deleted(DB.name, T);
+    Maintenance::Get().rows_modified(DB.name, T, T.store().num_rows() - std::min(first_row, T.store().num_rows()));
+}
+
+std::size_t Compaction::delete_rows(Database &DB, Table &table, const std::vector<bool> &deleted,
+                                    const Scheduler::Transaction &t)
+{
+    const std::size_t num_rows = table.store().num_rows();
+    M_insist(deleted.size() == num_rows, "one bit per row required");
+    const std::size_t num_deleted = std::count(deleted.begin(), deleted.end(), true);
+    if (num_deleted == 0)
+        return 0;
+
+    const Schema schema = table.schema();
+    auto ts_end = find_hidden(table, schema, "$ts_end");
+    if (not ts_end) {
+        remove_rows(DB, table, deleted, num_rows);
+        return num_deleted;
+    }
+
+    /*----- Mark the deleted versions as dead by setting their `$ts_end` to the start time of `t`. -----*/
+    const std::size_t first_row = std::distance(deleted.begin(), std::find(deleted.begin(), deleted.end(), true));
+    const std::size_t last_row = num_rows - std::distance(deleted.rbegin(),
+                                                          std::find(deleted.rbegin(), deleted.rend(), true));
+    void *addr = table.store().memory().addr();
+    auto loader = Interpreter::compile_load(schema, addr, table.layout(), schema, first_row);
+    auto storer = Interpreter::compile_store(schema, addr, table.layout(), schema, first_row);
+    Tuple tuple(schema);
+    Tuple *args[] = { &tuple };
+    for (std::size_t row = first_row; row != last_row; ++row) {
+        loader(args);
+        if (deleted[row])
+            tuple.set(*ts_end, Value(t.start_time()));
+        storer(args);
+    }
+
+    /*----- Compact the table once its dead versions exceed the threshold. -----*/
+    bool must_compact;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &num_dead = num_dead_rows_[DB.name][table.name()];
+        num_dead += num_deleted;
+        must_compact = num_dead >= threshold() * num_rows;
+    }
+    if (must_compact)
+        M_TIME_EXPR(compact(DB, table, first_row), "Compact table", Catalog::Get().timer()); // maintains derived state
+    else
+        rows_overwritten(DB, table, first_row);
+    return num_deleted;
+}
+
+std::size_t Compaction::compact(Database &DB, Table &table)
+{
+    return compact(DB, table, table.store().num_rows());
+}
+
+std::size_t Compaction::compact(Database &DB, Table &table, std::size_t first_overwritten)
+{
+    const Schema schema = table.schema();
+    auto ts_end = find_hidden(table, schema, "$ts_end");
+    if (not ts_end)
+        return 0; // only multi-versioned tables have dead versions
+
+    /* A version deleted at time `t` is seen by the transactions that started before `t`.  Versions deleted at or before
+     * the start of the oldest active transaction are hence seen by no transaction anymore. */
+    std::optional<int64_t> oldest_start_time;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &[_, start_time] : active_transactions_) {
+            if (not oldest_start_time or start_time < *oldest_start_time)
+                oldest_start_time = start_time;
+        }
+    }
+
+    /*----- Collect the dead versions no transaction sees, i.e. the versions with a finite `$ts_end` at or before the
+     * start of the oldest active transaction. -----*/
+    Schema ts_schema;
+    ts_schema.add(schema[*ts_end].id, schema[*ts_end].type, schema[*ts_end].constraints);
+    const std::size_t num_rows = table.store().num_rows();
+    std::vector<bool> dead(num_rows);
+    auto loader = Interpreter::compile_load(ts_schema, table.store().memory().addr(), table.layout(), schema);
+    Tuple tuple(ts_schema);
+    Tuple *args[] = { &tuple };
+    std::size_t num_dead = 0, num_removed = 0;
+    for (std::size_t row = 0; row != num_rows; ++row) {
+        loader(args);
+        const int64_t deleted_at = tuple[0].as_i();
+        if (deleted_at == -1) continue; // -1 represents infinity, i.e. a live version
+        ++num_dead;
+        if (not oldest_start_time or deleted_at <= *oldest_start_time) {
+            dead[row] = true;
+            ++num_removed;
+        }
+    }
+
+    {
+        /* Count the dead versions still seen by some transaction towards the next compaction. */
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (num_dead == num_removed)
+            num_dead_rows_[DB.name].erase(table.name());
+        else
+            num_dead_rows_[DB.name][table.name()] = num_dead - num_removed;
+    }
+
+    if (num_removed)
+        remove_rows(DB, table, dead, first_overwritten);
+    else if (first_overwritten < num_rows)
+        rows_overwritten(DB, table, first_overwritten);
+    return num_removed;
+}
+
+void Compaction::remove_rows(Database &DB, Table &table, const std::vector<bool> &removed,
+                             std::size_t first_overwritten)
+{
+    auto &store = table.store();
+    const std::size_t num_rows = store.num_rows();
+    const std::size_t first_row = std::distance(removed.begin(), std::find(removed.begin(), removed.end(), true));
+    if (first_row == num_rows)
+        return; // nothing to be done
+
+    /* Observe the NULL-free columns of all rows before rows are moved into the observed prefix of the table. */
+    NullFreeColumns::Get().layout_schema(DB.name, table);
+
+    /*----- Move each remaining row following the first removed one to the front, closing the gaps. -----*/
+    const Schema schema = table.schema();
+    void *addr = store.memory().addr();
+    auto loader = Interpreter::compile_load(schema, addr, table.layout(), schema, first_row);
+    auto storer = Interpreter::compile_store(schema, addr, table.layout(), schema, first_row);
+    Tuple tuple(schema);
+    Tuple *args[] = { &tuple };
+    std::size_t num_remaining = first_row;
+    for (std::size_t row = first_row; row != num_rows; ++row) {
+        loader(args);
+        if (not removed[row]) {
+            storer(args); // rows never overlap since the row stored to precedes the row loaded
+            ++num_remaining;
+        }
+    }
+    while (store.num_rows() > num_remaining)
+        store.drop();
+
+    rows_overwritten(DB, table, std::min(first_row, first_overwritten));
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutable/catalog/Scheduler.hpp>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/util/Pool.hpp>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+namespace m {
+
+/** Deletes rows from the tables of all databases, as marked by `DELETE` and `UPDATE` in a *delete bitmap*, and removes
+ * deleted rows from the stores.  Stores remain dense, i.e. scans read all rows from `0` to `num_rows()` and never test
+ * whether a row is deleted.  Hence, deletions do not add to the cost of scans of tables.
+ *
+ * Rows of a multi-versioned table, i.e. of a table with the hidden attributes `$ts_begin` and `$ts_end`, are deleted by
+ * setting their `$ts_end` to the start time of the deleting transaction, s.t. the timestamp filter of later queries
+ * hides them.  These *dead* versions are counted per table and, once they make up `--compaction-threshold` of the rows
+ * of a table, the table is *compacted*: all dead versions that no active transaction sees anymore are removed at once.
+ * Tables are also compacted when they are refreshed, in particular by the background `Maintenance`.
+ * A dead version is seen by the transactions that started before it was deleted, hence the schedulers report the start
+ * and end of every transaction with `transaction_started()` and `transaction_ended()`.  Rows of all other tables are
+ * removed immediately.  Removing rows moves the rows following the first removed one to close the gaps, preserving
+ * their order.
+ *
+ * Compaction relies on DML statements being executed exclusively, such that no query scans a table while its rows are
+ * moved.
+ *
+ * Deletions are neither logged by the `WriteAheadLog` nor shipped by the `Replication`, hence `DELETE` and `UPDATE`
+ * are rejected while either is configured. */
+struct Compaction
+{
+    private:
+    ///> the number of dead versions of the multi-versioned tables, by database name and table name
+    std::unordered_map<ThreadSafePooledString, std::unordered_map<ThreadSafePooledString, std::size_t>> num_dead_rows_;
+    ///> the start times of all transactions that started and did not yet end
+    std::unordered_map<const Scheduler::Transaction*, int64_t> active_transactions_;
+    ///> the version of the rows of every table whose rows were overwritten, see `data_version()`
+    std::unordered_map<const Table*, uint64_t> data_versions_;
+    uint64_t next_data_version_ = 1;
+    mutable std::mutex mutex_;
+
+    Compaction() = default;
+
+    public:
+    static Compaction & Get();
+
+    /** Returns the fraction of dead versions of a table at which the table is compacted, see `--compaction-threshold`.
+     */
+    static double threshold();
+
+    /** Deletes the rows of \p table of database \p DB set in \p deleted on behalf of transaction \p t, as described
+     * above.  Compacts \p table if its dead versions exceed the threshold.  Returns the number of rows deleted. */
+    std::size_t delete_rows(Database &DB, Table &table, const std::vector<bool> &deleted,
+                            const Scheduler::Transaction &t);
+
+    /** Removes all dead versions of \p table of database \p DB that no active transaction sees.  Returns the number of
+     * rows removed. */
+    std::size_t compact(Database &DB, Table &table);
+
+    /** Maintains the derived state of table \p T of database \p DB after its rows were overwritten from \p first_row
+     * on, i.e. after rows were deleted, removed, or moved: invalidates its indexes, the cached results that read it,
+     * the synopses of its PAX blocks, and its partitions, observes it anew, recomputes its materialized views, and
+     * changes its data version. */
+    static void rows_overwritten(Database &DB, Table &T, std::size_t first_row);
+
+    /** Starts transaction \p t by assigning it the next start time of \p next_start_time.  The start time is assigned
+     * and recorded atomically, such that a concurrent compaction never removes versions that \p t sees. */
+    void transaction_started(Scheduler::Transaction &t, std::atomic<int64_t> &next_start_time) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        t.start_time(next_start_time++);
+        active_transactions_.insert_or_assign(&t, t.start_time());
+    }
+    /** Returns the version of the rows of table \p T.  The version changes whenever rows of \p T are overwritten, i.e.
+     * whenever its rows change without necessarily changing its number of rows.  Code generated for the rows of \p T,
+     * e.g. for its zone maps, partitions, or NULL-free columns, is stale once the version changed. */
+    uint64_t data_version(const Table &T) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = data_versions_.find(&T);
+        return it == data_versions_.end() ? 0 : it->second;
+    }
+
+    /** Records that transaction \p t committed or aborted. */
+    void transaction_ended(const Scheduler::Transaction &t) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        active_transactions_.erase(&t);
+    }
+
+    /** Forgets the counts of dead versions. */
+    void clear() { std::lock_guard<std::mutex> lock(mutex_); num_dead_rows_.clear(); }
+
+    private:
+    /** Removes all dead versions of \p table of database \p DB that no active transaction sees, after its rows were
+     * overwritten from \p first_overwritten on. */
+    std::size_t compact(Database &DB, Table &table, std::size_t first_overwritten);
+
+    /** Removes the rows of \p table of database \p DB set in \p removed from its store, after its rows were overwritten
+     * from \p first_overwritten on. */
+    static void remove_rows(Database &DB, Table &table, const std::vector<bool> &removed,
+                            std::size_t first_overwritten);
+};
+
+}
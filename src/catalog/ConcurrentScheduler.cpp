@@ -0,0 +1,185 @@
+#include "catalog/ConcurrentScheduler.hpp"
+#include "catalog/Compaction.hpp"
+#include "catalog/Maintenance.hpp"
+#include "catalog/Replication.hpp"
+#include "catalog/WriteAheadLog.hpp"
+#include "parse/Sema.hpp"
+#include "util/WorkerPool.hpp"
+#include <algorithm>
+#include <mutable/mutable.hpp>
+
+
+using namespace m;
+
+
+std::optional<m::Scheduler::queued_command> ConcurrentScheduler::CommandQueue::pop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto is_ready = [this](queued_command &x) { return not running_transactions_.contains(&std::get<0>(x)); };
+    std::list<queued_command>::iterator it;
+    has_element_.wait(lock, [&]{
+        // always wake up if the queue is closed
+        if (closed_) [[unlikely]]
+            return true;
+        // wake up if there is a command of a transaction without a command in execution
+        it = std::find_if(command_list_.begin(), command_list_.end(), is_ready);
+        return it != command_list_.end();
+    });
+    if (closed_) [[unlikely]] return std::nullopt;
+
+    queued_command res = std::move(*it);
+    command_list_.erase(it);
+    running_transactions_.insert(&std::get<0>(res));
+    return {std::move(res)};
+}
+
+void ConcurrentScheduler::CommandQueue::push(Transaction &t, std::unique_ptr<ast::Command> command, Diagnostic &diag,
+                                             std::promise<bool> promise)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_) {
+        /* Since the command queue is closed, no more command will be executed
+         * => set the promise of this newly pushed command to false right away */
+        promise.set_value(false);
+        return;
+    }
+    command_list_.emplace_back(t, std::move(command), diag, std::move(promise));
+    lock.unlock();
+    has_element_.notify_one();
+}
+
+void ConcurrentScheduler::CommandQueue::close()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    closed_ = true;
+    while (not command_list_.empty()) {
+        std::get<3>(command_list_.front()).set_value(false);
+        command_list_.pop_front();
+    }
+    lock.unlock();
+    has_element_.notify_all();
+}
+
+bool ConcurrentScheduler::CommandQueue::is_closed()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+}
+
+void ConcurrentScheduler::CommandQueue::finish_command(Transaction &t)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    M_insist(running_transactions_.contains(&t));
+    running_transactions_.erase(&t);
+    lock.unlock();
+    has_element_.notify_all(); // the next command of `t` may be waited for by any worker
+}
+
+std::atomic<int64_t> ConcurrentScheduler::next_start_time = 0;
+
+ConcurrentScheduler::~ConcurrentScheduler()
+{
+    query_queue_.close();
+    for (auto &worker : worker_threads_)
+        worker.join();
+}
+
+std::future<bool> ConcurrentScheduler::schedule_command(Transaction &t, std::unique_ptr<ast::Command> command,
+                                                        Diagnostic &diag)
+{
+    std::promise<bool> execution_completed;
+    auto execution_completed_future = execution_completed.get_future();
+    query_queue_.push(t, std::move(command), diag, std::move(execution_completed));
+
+    std::lock_guard<std::mutex> lock(workers_mutex_);
+    if (worker_threads_.empty()) [[unlikely]] {
+        // Creating the worker threads not here but in the constructor causes deadlocks, see `SerialScheduler`.
+        const unsigned num_workers = std::max(1U, std::thread::hardware_concurrency());
+        worker_threads_.reserve(num_workers);
+        for (unsigned i = 0; i != num_workers; ++i)
+            worker_threads_.emplace_back(&ConcurrentScheduler::worker_thread, this);
+    }
+    return execution_completed_future;
+}
+
+std::unique_ptr<ConcurrentScheduler::Transaction> ConcurrentScheduler::begin_transaction() {
+    return std::make_unique<ConcurrentScheduler::Transaction>();
+}
+
+bool ConcurrentScheduler::commit(std::unique_ptr<ConcurrentScheduler::Transaction> t) {
+    /* TODO: When autocommit is not used as the default anymore, the transaction must check for conflicts with
+     * other transactions that were introduced in the time between when this transaction executed statements and now. */
+    WriteAheadLog::Get().commit(*t); // concurrently committing transactions share a sync of the log
+    Replication::Get().commit(*t); // ship only durable changes
+    Compaction::Get().transaction_ended(*t);
+    return true;
+}
+
+bool ConcurrentScheduler::abort(std::unique_ptr<ConcurrentScheduler::Transaction> t) {
+    /* TODO: Undo changes of transaction */
+    WriteAheadLog::Get().abort(*t);
+    Replication::Get().abort(*t);
+    Compaction::Get().transaction_ended(*t);
+    return true;
+}
+
+void ConcurrentScheduler::worker_thread()
+{
+    WorkerPool::Pin_To_Reserved_CPUs();
+    while (not query_queue_.is_closed()) {
+        auto ret = query_queue_.pop();
+        // pop() should only return no value if the queue is closed
+        if (not ret.has_value()) continue;
+
+        auto [t, ast, diag, promise] = std::move(ret.value());
+
+        // check if transaction has a start_time, set one if not. -1 represents an undefined value.
+        if (t.start_time() == -1)
+            Compaction::Get().transaction_started(t, next_start_time); // keeps the versions `t` sees until it ends
+        if (next_start_time < 0) [[unlikely]] M_unreachable("Transaction timestamp overflow");
+
+        Maintenance::Get().command_started();
+        const bool executed = execute(t, std::move(ast), diag);
+        Maintenance::Get().command_finished();
+        query_queue_.finish_command(t);
+        promise.set_value(executed);
+    }
+}
+
+bool ConcurrentScheduler::execute(Transaction &t, std::unique_ptr<ast::Command> command, Diagnostic &diag)
+{
+    /* Queries only read the database and may run concurrently, all other commands must run exclusively.  The lock is
+     * acquired before semantic analysis since analysis looks up the database schema. */
+    reader_writer_lock lock{database_mutex_};
+    if (is<ast::SelectStmt>(*command))
+        lock.lock_read();
+    else
+        lock.lock_write();
+
+    bool err = diag.num_errors() > 0; // parser errors
+    auto cmd = [&]() {
+        std::lock_guard<std::mutex> sema_lock(sema_mutex_);
+        ast::Sema sema(diag);
+        diag.clear();
+        return sema.analyze(std::move(command));
+    }();
+    err |= diag.num_errors() > 0; // sema errors
+
+    M_insist(not err == bool(cmd), "when there are no errors, Sema must have returned a command");
+    if (err or not cmd)
+        return false;
+    cmd->transaction(&t);
+    cmd->execute(diag);
+    return true;
+}
+
+__attribute__((constructor(202)))
+static void register_scheduler()
+{
+    Catalog &C = Catalog::Get();
+    C.register_scheduler(
+        C.pool("ConcurrentScheduler"),
+        std::make_unique<ConcurrentScheduler>(),
+        "executes queries of different transactions concurrently, all other commands exclusively"
+    );
+}
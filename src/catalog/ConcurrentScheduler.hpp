@@ -0,0 +1,79 @@
+#pragma once
+
+#include <mutable/catalog/Scheduler.hpp>
+#include <mutable/util/reader_writer_lock.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+
+namespace m {
+
+/** This class implements a Scheduler that executes read-only queries concurrently on a pool of worker threads.
+ * Commands of the same `Transaction` are executed in the order of their arrival, one at a time.  Commands of different
+ * transactions are executed concurrently iff all of them are queries, i.e. `ast::SelectStmt`s, and exclusively
+ * otherwise.  To this end, queries acquire a read lock and all other commands acquire a write lock on the database. */
+struct ConcurrentScheduler : Scheduler
+{
+    private:
+    /** A thread-safe command queue that only returns commands of transactions without a command in execution. */
+    struct CommandQueue
+    {
+        private:
+        std::list<queued_command> command_list_;
+        ///> the transactions with a command in execution; their other commands are not returned
+        std::unordered_set<const Transaction*> running_transactions_;
+        std::mutex mutex_;
+        std::condition_variable has_element_;
+        bool closed_ = false;
+
+        public:
+        CommandQueue() = default;
+        ~CommandQueue() = default;
+
+        /** Returns the first queued command whose transaction has no command in execution and marks the transaction as
+         * running.  Returns `std::nullopt` if the queue is closed. */
+        std::optional<queued_command> pop();
+        /** Appends the command to the queue. */
+        void push(Transaction &t, std::unique_ptr<ast::Command> command, Diagnostic &diag, std::promise<bool> promise);
+        void close(); ///< empties and closes the queue without executing the remaining `ast::Command`s.
+        bool is_closed(); ///< returns `true` iff the queue is closed
+        void finish_command(Transaction &t); ///< marks `t` as no longer having a command in execution
+    };
+
+    CommandQueue query_queue_; ///< the queue of all incoming commands
+    std::vector<std::thread> worker_threads_; ///< the worker threads executing the incoming commands
+    std::mutex workers_mutex_; ///< protects starting the worker threads
+    std::mutex sema_mutex_; ///< serializes semantic analysis
+    reader_writer_mutex database_mutex_; ///< isolates queries against all other commands
+
+    static std::atomic<int64_t> next_start_time; ///< stores the next transaction start time
+
+    public:
+    ConcurrentScheduler() = default;
+    ~ConcurrentScheduler();
+
+    std::future<bool> schedule_command(Transaction &t, std::unique_ptr<ast::Command> command, Diagnostic &diag) override;
+
+    std::unique_ptr<Transaction> begin_transaction() override;
+
+    bool commit(std::unique_ptr<Transaction> t) override;
+
+    bool abort(std::unique_ptr<Transaction> t) override;
+
+    private:
+    /** The method run by each worker thread.  While stopping, the commands already being executed will complete their
+     * execution but queued commands will not be executed. */
+    void worker_thread();
+
+    /** Analyzes and executes a single command.  Returns `true` iff the command was executed. */
+    bool execute(Transaction &t, std::unique_ptr<ast::Command> command, Diagnostic &diag);
+};
+
+}
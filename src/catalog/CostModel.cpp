@@ -1,11 +1,17 @@
 #include <mutable/catalog/CostModel.hpp>
 
+#include "backend/WasmOperator.hpp"
+#include "catalog/OperatorCalibration.hpp"
+#include "catalog/SortOrders.hpp"
 #include "storage/ColumnStore.hpp"
 #include "storage/store_manip.hpp"
 #include "util/GridSearch.hpp"
 #include "util/stream.hpp"
+#include <chrono>
+#include <cmath>
 #include <mutable/catalog/TrainedCostFunction.hpp>
 #include <mutable/mutable.hpp>
+#include <numeric>
 #include <type_traits>
 
 
@@ -606,3 +612,140 @@ DEFINE(int64_t);
 DEFINE(float);
 DEFINE(double);
 #undef DEFINE
+
+
+//======================================================================================================================
+// OperatorCalibration Methods
+//======================================================================================================================
+
+/** Adds a table \p name of \p num_rows rows to \p DB for calibrating the physical operators.  The table consists of a
+ * 4-byte integer `key`, holding the row IDs in ascending order iff \p sorted and a random permutation of them
+ * otherwise, and the 8-byte integer payloads `p0` to `p3`. */
+Table & add_calibration_table(Database &DB, const char *name, std::size_t num_rows, bool sorted)
+{
+    Catalog &C = Catalog::Get();
+    auto &table = DB.add_table(C.pool(name));
+    table.push_back(C.pool("key"), Type::Get_Integer(Type::TY_Vector, 4));
+    for (auto payload : { "p0", "p1", "p2", "p3" })
+        table.push_back(C.pool(payload), Type::Get_Integer(Type::TY_Vector, 8));
+    table.store(C.create_store(C.pool("PaxStore"), table));
+    PAXLayoutFactory factory(PAXLayoutFactory::NTuples, num_rows);
+    table.layout(factory);
+
+    for (std::size_t i = 0; i != num_rows; ++i) table.store().append(); // allocate fresh rows in store
+    uint8_t *mem_ptr = reinterpret_cast<uint8_t*>(table.store().memory().addr());
+    set_all_not_null(mem_ptr + get_column_offset_in_bytes(table.layout(), table.num_attrs()), table.num_attrs(), 0,
+                     num_rows);
+    for (std::size_t idx = 0; idx != table.num_attrs(); ++idx)
+        generate_primary_keys(mem_ptr + get_column_offset_in_bytes(table.layout(), idx), *table[idx].type, 0,
+                              num_rows);
+    if (not sorted) {
+        std::vector<int32_t> keys(num_rows);
+        std::iota(keys.begin(), keys.end(), 0);
+        fill_uniform(reinterpret_cast<int32_t*>(mem_ptr + get_column_offset_in_bytes(table.layout(), 0)),
+                     std::move(keys), 0, num_rows); // uses each key exactly once, i.e. permutes the keys
+    }
+
+    /* Observe the order of the keys, such that only an unsorted table is sorted by a sort merge join. */
+    SortOrders::Get().reset(DB.name, table);
+    return table;
+}
+
+OperatorCalibration::Coefficients OperatorCalibration::Calibrate(std::size_t num_rows)
+{
+    Catalog &C = Catalog::Get();
+    M_insist(num_rows >= 4, "calibration requires at least four rows");
+    const double N = num_rows;
+    const double log_N = std::log2(N);
+    constexpr double PAYLOAD_SIZE_IN_BYTES = 4 * 8; // the payloads `p0` to `p3`
+    constexpr double KEY_SIZE_IN_BYTES = 4;
+
+    /*----- Set up database. -----------------------------------------------------------------------------------------*/
+    Database &DB = C.add_database(C.pool("$db_calibrate_operators"));
+    add_calibration_table(DB, "small",  num_rows / 4, true);
+    add_calibration_table(DB, "left",   num_rows,     true);
+    add_calibration_table(DB, "right",  num_rows,     true);
+    add_calibration_table(DB, "random", num_rows,     false);
+
+    /* Force one physical implementation at a time and restore the options afterwards. */
+    const auto prev_simd = options::simd;
+    const auto prev_scan_implementations = options::scan_implementations;
+    const auto prev_grouping_implementations = options::grouping_implementations;
+    const auto prev_join_implementations = options::join_implementations;
+    options::scan_implementations = option_configs::ScanImplementation::SCAN;
+
+    /* Returns the median time of executing `query`, in seconds. */
+    auto time = [&DB](const char *query) {
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(time_select_query_execution(DB, query)).count() / 1e9;
+    };
+
+    /*----- Measure the scans, which define the unit of the coefficients. --------------------------------------------*/
+    options::simd = false;
+    const double scan_scalar = time("SELECT key FROM left;");
+    options::simd = true;
+    const double scan_narrow = time("SELECT key FROM left;");
+    const double scan_narrow_small = time("SELECT key FROM small;");
+    const double scan_wide = time("SELECT key, p0, p1, p2, p3 FROM left;");
+    const double scan_wide_random = time("SELECT key, p0, p1, p2, p3 FROM random;");
+
+    Coefficients coefficients;
+    const double unit = scan_narrow / N; // the time of a SIMDfied scan per row
+    if (unit > 0) {
+        /* Relates the time `t`, in seconds, to `num` rows, in units. */
+        auto per_row = [unit](double t, double num) { return std::max(0., t / num / unit); };
+
+        coefficients.scan_scalar = per_row(scan_scalar, N);
+
+        /*----- Measure hash-based grouping of unique keys with narrow and wide entries. -----------------------------*/
+        options::grouping_implementations = option_configs::GroupingImplementation::HASH_BASED;
+        const double hash_grouping_narrow = time("SELECT key FROM left GROUP BY key;") - scan_narrow;
+        const double hash_grouping_wide =
+            time("SELECT key, MIN(p0), MIN(p1), MIN(p2), MIN(p3) FROM left GROUP BY key;") - scan_wide;
+        coefficients.hash_table_per_byte =
+            per_row(hash_grouping_wide - hash_grouping_narrow, N * PAYLOAD_SIZE_IN_BYTES);
+        coefficients.hash_grouping_per_row = std::max(
+            0., per_row(hash_grouping_narrow, N) - KEY_SIZE_IN_BYTES * coefficients.hash_table_per_byte
+        );
+
+        /*----- Measure ordered grouping of sorted keys. -------------------------------------------------------------*/
+        options::grouping_implementations = option_configs::GroupingImplementation::ORDERED;
+        coefficients.ordered_grouping_per_row = per_row(time("SELECT key FROM left GROUP BY key;") - scan_narrow, N);
+        options::grouping_implementations = prev_grouping_implementations;
+
+        /*----- Measure simple hash join with build children of two sizes to separate building from probing. --------*/
+        options::join_implementations = option_configs::JoinImplementation::SIMPLE_HASH;
+        const double hash_join_small =
+            time("SELECT 1 FROM small, left WHERE small.key = left.key;") - scan_narrow_small - scan_narrow;
+        const double hash_join_large =
+            time("SELECT 1 FROM left, right WHERE left.key = right.key;") - 2 * scan_narrow;
+        const double build_per_row = per_row(hash_join_large - hash_join_small, N - num_rows / 4);
+        coefficients.hash_join_build_per_row =
+            std::max(0., build_per_row - KEY_SIZE_IN_BYTES * coefficients.hash_table_per_byte);
+        coefficients.hash_join_probe_per_row = std::max(0., per_row(hash_join_large, N) - build_per_row);
+
+        /*----- Measure sort merge join of sorted keys, which only merges, and of unsorted keys with narrow and wide
+         * tuples, which sorts one child. --------------------------------------------------------------------------*/
+        options::join_implementations = option_configs::JoinImplementation::SORT_MERGE;
+        const double merge = time("SELECT 1 FROM left, right WHERE left.key = right.key;") - 2 * scan_narrow;
+        coefficients.sort_merge_join_merge_per_row = per_row(merge, 2 * N);
+        const double sort_narrow =
+            time("SELECT 1 FROM left, random WHERE left.key = random.key;") - 2 * scan_narrow - merge;
+        const double sort_wide =
+            time("SELECT random.p0, random.p1, random.p2, random.p3 FROM left, random WHERE left.key = random.key;") -
+            scan_narrow - scan_wide_random - merge;
+        coefficients.sort_per_byte = per_row(sort_wide - sort_narrow, N * log_N * PAYLOAD_SIZE_IN_BYTES);
+        coefficients.sort_merge_join_sort_per_row = std::max(
+            0., per_row(sort_narrow, N * log_N) - KEY_SIZE_IN_BYTES * coefficients.sort_per_byte
+        );
+    }
+
+    options::simd = prev_simd;
+    options::scan_implementations = prev_scan_implementations;
+    options::grouping_implementations = prev_grouping_implementations;
+    options::join_implementations = prev_join_implementations;
+    C.unset_database_in_use();
+    C.drop_database(DB);
+
+    return coefficients;
+}
@@ -1,6 +1,37 @@
 #include <mutable/catalog/DatabaseCommand.hpp>
 
+#include "backend/AutoBackend.hpp"
+#include "backend/Interpreter.hpp"
+#include "backend/ResultWriter.hpp"
 #include "backend/StackMachine.hpp"
+#include "catalog/AdmissionControl.hpp"
+#include "catalog/ApproximateAggregates.hpp"
+#include "catalog/CardinalityFeedback.hpp"
+#include "catalog/Cluster.hpp"
+#include "catalog/ColumnSketches.hpp"
+#include "catalog/ColumnStatistics.hpp"
+#include "catalog/Compaction.hpp"
+#include "catalog/LayoutAdvisor.hpp"
+#include "catalog/Maintenance.hpp"
+#include "catalog/MaterializedViews.hpp"
+#include "catalog/Partitionings.hpp"
+#include "catalog/QueryCancellation.hpp"
+#include "catalog/Replication.hpp"
+#include "catalog/ResultCache.hpp"
+#include "catalog/ResultSinks.hpp"
+#include "catalog/SetOperations.hpp"
+#include "catalog/SortOrders.hpp"
+#include "catalog/SpnWrapper.hpp"
+#include "catalog/WriteAheadLog.hpp"
+#include "IR/PlanCache.hpp"
+#include "parse/ASTPrinter.hpp"
+#include "parse/Sema.hpp"
+#include "storage/IndexMaintenance.hpp"
+#include "storage/PaxStore.hpp"
+#include "util/PerfCounters.hpp"
+#include "util/WorkerPool.hpp"
+#include "util/WireProtocol.hpp"
+#include <algorithm>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/IR/Optimizer.hpp>
@@ -8,6 +39,10 @@
 #include <mutable/Options.hpp>
 #include <mutable/storage/Index.hpp>
 #include <mutable/util/DotTool.hpp>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <vector>
 
 
 using namespace m;
@@ -32,10 +67,866 @@ void learn_spns::execute(Diagnostic &diag)
     auto spn_estimator = cast<SpnEstimator>(CE.get());
     spn_estimator->learn_spns();
     DB.cardinality_estimator(std::move(CE));
+    PlanCache::Get().clear(); // cached join orders were chosen using the previous estimates
 
     if (not Options::Get().quiet) { diag.out() << "Learned SPN on every table in " << DB.name << ".\n"; }
 }
 
+namespace {
+
+/** Passes the rows of a query result to the sink of the transaction of the query, if any, or prints them exactly like
+ * `PrintOperator` and `NoOpOperator` do.  Used to replay results of the `ResultCache` and to pass on the results
+ * gathered from the nodes of a `Cluster`. */
+struct ResultConsumer
+{
+    private:
+    const ResultSinks::sink_type *sink_;
+    std::optional<ResultWriter> writer_; ///< prints the rows, unless they are passed to a sink or only counted
+    std::size_t num_rows_ = 0;
+
+    public:
+    ResultConsumer(const Schema &S, const ResultSinks::sink_type *sink) : sink_(sink) {
+        if (not sink_ and not Options::Get().benchmark)
+            writer_.emplace(std::cout, S);
+    }
+
+    void operator()(const Schema &S, const Tuple &t) {
+        ++num_rows_;
+        if (sink_)
+            (*sink_)(S, t);
+        else if (writer_)
+            writer_->write(t);
+    }
+
+    /** Completes the result, after all rows were consumed. */
+    void finish() {
+        if (sink_)
+            return;
+        if (writer_) {
+            writer_->flush();
+            if (Options::Get().quiet or not ResultWriter::Is_Textual(writer_->format()))
+                return;
+        }
+        std::cout << num_rows_ << " rows\n";
+    }
+};
+
+/** Adds the rows of table \p T of database \p DB from \p first_row on to the indexes of \p T.  Returns `false` if some
+ * index could not be maintained incrementally and must be invalidated. */
+bool append_to_indexes(Database &DB, const Table &T, std::size_t first_row)
+{
+    bool maintained = true;
+    for (auto &entry : T.schema()) {
+        for (auto method : { idx::IndexMethod::Array, idx::IndexMethod::Rmi }) {
+            if (not DB.has_index(T.name(), entry.id.name, method))
+                continue;
+            Schema key_schema;
+            key_schema.add(entry); // only one-dimensional indexes are supported, see `CreateIndex`
+            /* `DB` owns the index; it hands out a const reference only since scans must not modify it. */
+            auto &index = const_cast<idx::IndexBase&>(DB.get_index(T.name(), entry.id.name, method));
+            try {
+                maintained = idx::append_rows(index, T, key_schema, first_row) and maintained;
+            } catch (invalid_argument) {
+                maintained = false;
+            }
+        }
+    }
+    return maintained;
+}
+
+/** Maintains the derived state of table \p T of database \p DB after rows were appended from \p first_row on by
+ * transaction \p t: adds the rows to its indexes, invalidates its partitions and the cached results that read it,
+ * updates its SPN, column sketches, sort orders, and materialized views, counts the rows for its refresh, and logs the
+ * rows and ships them to the replicas. */
+void rows_appended(Database &DB, Table &T, std::size_t first_row, const Scheduler::Transaction *t)
+{
+    /* Add the new rows to the indexes on the table, or invalidate them if that fails.  Invalidate the partitions of
+     * the table and all cached results that read the table. */
+    if (not append_to_indexes(DB, T, first_row))
+        DB.invalidate_indexes(T.name());
+    Partitionings::Get().invalidate(DB.name, T);
+    ResultCache::Get().invalidate(T);
+    /* Insert the new rows into the SPN of the table, if any, into the sketches of its columns, and observe the orders
+     * of its columns. */
+    SpnMaintenance::Get().rows_appended(DB.name, T, first_row);
+    ColumnSketches::Get().update(DB.name, T);
+    SortOrders::Get().update(DB.name, T);
+    /* Add the new rows to the materialized views of the table. */
+    MaterializedViews::Get().rows_appended(DB.name, T);
+    /* Count the new rows towards refreshing the statistics and indexes of the table. */
+    Maintenance::Get().rows_modified(DB.name, T, T.store().num_rows() - first_row);
+    /* Log the new rows; they become durable when the transaction commits. */
+    if (WriteAheadLog::enabled() and t)
+        WriteAheadLog::Get().log_rows(*t, DB.name, T, first_row);
+    /* Ship the new rows to the replicas, if any, when the transaction commits. */
+    if (t and Replication::Get().is_primary())
+        Replication::Get().log_rows(*t, DB.name, T, first_row);
+}
+
+/** Returns `true` iff rows may be deleted.  Otherwise, reports to \p diag that neither the `WriteAheadLog` nor the
+ * `Replication` record deletions, such that recovery and the replicas would retain the deleted rows. */
+bool may_delete_rows(Diagnostic &diag)
+{
+    if (WriteAheadLog::enabled()) {
+        diag.err() << "Cannot delete rows while appended rows are logged, since deletions are not logged, see --wal.\n";
+        return false;
+    }
+    if (Replication::Get().is_primary()) {
+        diag.err() << "Cannot delete rows while transactions are shipped to replicas, since deletions are not shipped, "
+                      "see --replica.\n";
+        return false;
+    }
+    return true;
+}
+
+/** Ships the DDL statement \p command, executed by transaction \p t in the database \p database_name or in none if
+ * \p database_name is `nullptr`, to the replicas, if any, when \p t commits. */
+void statement_executed(const Scheduler::Transaction *t, const ThreadSafePooledString *database_name,
+                        const ast::Command &command)
+{
+    if (t and Replication::Get().is_primary())
+        Replication::Get().log_statement(*t, database_name, command);
+}
+
+/** Executes the statement \p sql in transaction \p t from within another command, i.e. on the thread and under the
+ * locks of the scheduler executing that command.  Errors are reported to \p diag.  Returns `true` on success. */
+bool execute_nested(const std::string &sql, Scheduler::Transaction *t, Diagnostic &diag)
+{
+    std::ostringstream out, err;
+    Diagnostic nested_diag(false, out, err);
+    auto command = command_from_string(nested_diag, sql);
+    if (nested_diag.num_errors() == 0 and command) {
+        ast::Sema sema(nested_diag);
+        if (auto cmd = sema.analyze(std::move(command)); nested_diag.num_errors() == 0 and cmd) {
+            cmd->transaction(t);
+            cmd->execute(nested_diag);
+        }
+    }
+    diag.err() << err.str();
+    return nested_diag.num_errors() == 0;
+}
+
+/** Returns the delete bitmap of the rows of table \p T that are visible to transaction \p t and satisfy the condition
+ * of \p where, or of all visible rows if \p where is `nullptr`.  Calls \p callback with each selected row, loaded with
+ * the schema of \p T, and its row id. */
+template<typename Callback>
+std::vector<bool> select_rows(const Table &T, const ast::Clause *where, const Scheduler::Transaction &t,
+                              Callback &&callback)
+{
+    Catalog &C = Catalog::Get();
+    const Schema S = T.schema();
+    const std::size_t num_rows = T.store().num_rows();
+
+    /*----- Compile the condition, conjunct with the visibility of the row to `t` if the table is multi-versioned. --*/
+    std::optional<StackMachine> filter;
+    Tuple filter_result({ Type::Get_Boolean(Type::TY_Vector) });
+    if (where) {
+        filter.emplace(S);
+        filter->emit(*as<const ast::WhereClause>(*where).where, 1);
+        filter->emit_St_Tup_b(0, 0);
+    }
+    auto ts_begin = S.find(Schema::Identifier(T.name(), C.pool("$ts_begin")));
+    auto ts_end = S.find(Schema::Identifier(T.name(), C.pool("$ts_end")));
+    const bool is_multi_versioned = ts_begin != S.cend();
+    M_insist(is_multi_versioned == (ts_end != S.cend()));
+
+    std::vector<bool> selected(num_rows);
+    auto loader = Interpreter::compile_load(S, T.store().memory().addr(), T.layout(), S);
+    Tuple row(S);
+    for (std::size_t row_id = 0; row_id != num_rows; ++row_id) {
+        Tuple *load_args[] = { &row };
+        loader(load_args);
+
+        if (is_multi_versioned) { // only the live versions inserted before `t` started are visible
+            if (row[std::distance(S.cbegin(), ts_begin)].as_i() > t.start_time() or
+                row[std::distance(S.cbegin(), ts_end)].as_i() != -1)
+                continue;
+        }
+        if (filter) {
+            Tuple *args[] = { &filter_result, &row };
+            (*filter)(args);
+            if (filter_result.is_null(0) or not filter_result[0].as_b()) continue;
+        }
+
+        selected[row_id] = true;
+        callback(row, row_id);
+    }
+    return selected;
+}
+
+/** Computes the statistics of the columns of every table in the database in use, see `ColumnStatistics`. */
+struct analyze : Instruction
+{
+    using Instruction::Instruction;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Creates a materialized view of a query, see `MaterializedView`.  The first argument is the name of the view, the
+ * remaining arguments form the query, e.g. `\create_materialized_view V SELECT c, SUM(x) FROM T GROUP BY c;`. */
+struct create_materialized_view : Instruction
+{
+    using Instruction::Instruction;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Drops the materialized views given as arguments and the tables storing them. */
+struct drop_materialized_view : Instruction
+{
+    using Instruction::Instruction;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Declares a column to be sorted, see `SortOrders`, e.g. `\sorted_by T ts asc;`.  The arguments are the table, the
+ * attribute, and optionally the direction, `asc` or `desc`, defaulting to ascending. */
+struct sorted_by : Instruction
+{
+    using Instruction::Instruction;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Partitions a table by the hash or by ranges of an attribute and clusters its rows by partition, see
+ * `Partitionings`, e.g. `\partition_by orders o_custkey hash 64;` or
+ * `\partition_by orders o_orderdate range d'1994-01-01' d'1995-01-01';`.  The arguments are the table, the attribute,
+ * and either `hash` and the number of partitions or `range` and the ascending first value of each partition but the
+ * first one.  Without further arguments, the rows of the table are clustered anew by its previous partitioning, e.g.
+ * after rows were appended. */
+struct partition_by : Instruction
+{
+    using Instruction::Instruction;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Removes the deleted versions of the given tables, or of all tables of the database in use if no table is given,
+ * see `Compaction`. */
+struct compact : Instruction
+{
+    using Instruction::Instruction;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Replays the rows of the write-ahead log into the tables of the database in use, see `WriteAheadLog`. */
+struct recover : Instruction
+{
+    using Instruction::Instruction;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Adds the `mutable-server`s given as `HOST:PORT` arguments as nodes to the `Cluster`. */
+struct add_node : Instruction
+{
+    using Instruction::Instruction;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Repartitions the rows of a table across the nodes of the `Cluster` by the hash of an attribute, e.g.
+ * `\partition orders o_custkey;`. */
+struct partition : Instruction
+{
+    using Instruction::Instruction;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Broadcasts the rows of the tables given as arguments to every node of the `Cluster`. */
+struct broadcast : Instruction
+{
+    using Instruction::Instruction;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Executes a query on every node of the `Cluster` and combines the rows of the results, e.g. `\gather SELECT * FROM
+ * orders, customer WHERE o_custkey = c_custkey;`. */
+struct gather : Instruction
+{
+    using Instruction::Instruction;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Executes `SELECT` statements combined by the set operators `UNION [ALL]`, `INTERSECT`, and `EXCEPT` in parallel and
+ * combines their results, e.g. `\compound_select SELECT * FROM sales_jan UNION ALL SELECT * FROM sales_feb;`, see
+ * `SetOperations`. */
+struct compound_select : Instruction
+{
+    using Instruction::Instruction;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Appends the record batches received by `mutable-server` in the transaction of this instruction, see
+ * `Cluster::stage()`. */
+struct append_batches : Instruction
+{
+    using Instruction::Instruction;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Removes the deleted versions of the tables given as arguments and refreshes their statistics, zone maps, and indexes,
+ * see `Maintenance`. */
+struct refresh_table : Instruction
+{
+    using Instruction::Instruction;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Adds the read-only replicas given as `HOST:PORT` arguments, to which committed transactions are shipped, see
+ * `Replication`. */
+struct add_replica : Instruction
+{
+    using Instruction::Instruction;
+
+    void execute(Diagnostic &diag) override;
+};
+
+/** Prints the progress of the replicas of a primary or the position and replication lag of a replica, see
+ * `Replication`. */
+struct replication_status : Instruction
+{
+    using Instruction::Instruction;
+
+    void execute(Diagnostic &diag) override;
+};
+
+}
+
+void analyze::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    if (not C.has_database_in_use()) { diag.err() << "No database selected.\n"; return; }
+
+    auto &DB = C.get_database_in_use();
+    if (DB.size() == 0) { diag.err() << "There are no tables in the database.\n"; return; }
+
+    for (auto it = DB.begin_tables(); it != DB.end_tables(); ++it)
+        M_TIME_EXPR(ColumnStatistics::Get().analyze(DB.name, *it->second), "Analyze table", C.timer());
+    PlanCache::Get().clear(); // cached join orders were chosen using the previous estimates
+
+    if (not Options::Get().quiet) { diag.out() << "Analyzed every table in " << DB.name << ".\n"; }
+}
+
+void create_materialized_view::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    if (not C.has_database_in_use()) { diag.err() << "No database selected.\n"; return; }
+    if (args().size() < 2) { diag.err() << "Usage: \\create_materialized_view <name> <query>;\n"; return; }
+
+    auto &DB = C.get_database_in_use();
+    auto name = C.pool(args()[0].c_str());
+    std::ostringstream query;
+    for (auto it = std::next(args().begin()); it != args().end(); ++it)
+        query << *it << ' ';
+    query << ';';
+
+    try {
+        auto stmt = statement_from_string(diag, query.str());
+        if (not is<ast::SelectStmt>(stmt.get())) { diag.err() << "Expected a SELECT statement.\n"; return; }
+        std::unique_ptr<ast::SelectStmt> select(as<ast::SelectStmt>(stmt.release()));
+        auto &views = MaterializedViews::Get();
+        const std::size_t num_rows = M_TIME_EXPR(views.create(DB, name, std::move(select)).num_groups(),
+                                                 "Create materialized view", C.timer());
+        if (not Options::Get().quiet)
+            diag.out() << "Created materialized view " << name << " of " << num_rows << " rows.\n";
+    } catch (frontend_exception) {
+        diag.err() << "Invalid query of materialized view " << name << ".\n";
+    } catch (m::invalid_argument e) {
+        diag.err() << "Cannot create materialized view " << name << ": " << e.what() << "\n";
+    } catch (std::invalid_argument) {
+        diag.err() << "Table " << name << " already exists in database " << DB.name << ".\n";
+    }
+}
+
+void drop_materialized_view::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    if (not C.has_database_in_use()) { diag.err() << "No database selected.\n"; return; }
+
+    auto &DB = C.get_database_in_use();
+    for (auto &arg : args()) {
+        auto name = C.pool(arg.c_str());
+        if (MaterializedViews::Get().drop(DB, name)) {
+            if (not Options::Get().quiet)
+                diag.out() << "Dropped materialized view " << name << ".\n";
+        } else {
+            diag.err() << "Materialized view " << name << " does not exist in database " << DB.name << ".\n";
+        }
+    }
+}
+
+void sorted_by::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    if (not C.has_database_in_use()) { diag.err() << "No database selected.\n"; return; }
+    if (args().size() < 2 or args().size() > 3 or (args().size() == 3 and args()[2] != "asc" and args()[2] != "desc"))
+    {
+        diag.err() << "Usage: \\sorted_by <table> <attribute> [asc|desc];\n";
+        return;
+    }
+
+    auto &DB = C.get_database_in_use();
+    const Table *table;
+    try {
+        table = &DB.get_table(C.pool(args()[0].c_str()));
+    } catch (std::out_of_range) {
+        diag.err() << "Table " << args()[0] << " does not exist in database " << DB.name << ".\n";
+        return;
+    }
+    auto attr = C.pool(args()[1].c_str());
+    const Schema &schema = table->schema();
+    if (std::none_of(schema.begin(), schema.end(), [&attr](auto &e) { return e.id.name == attr; })) {
+        diag.err() << "Table " << table->name() << " has no attribute " << attr << ".\n";
+        return;
+    }
+
+    const bool ascending = args().size() == 2 or args()[2] == "asc";
+    if (not SortOrders::Get().declare(DB.name, *table, attr, ascending)) {
+        diag.err() << "The rows of " << table->name() << " are not sorted by " << attr
+                   << (ascending ? " ascending" : " descending") << ".\n";
+        return;
+    }
+
+    if (not Options::Get().quiet)
+        diag.out() << "Declared " << table->name() << " to be sorted by " << attr
+                   << (ascending ? " ascending" : " descending") << ".\n";
+}
+
+void partition_by::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    if (not C.has_database_in_use()) { diag.err() << "No database selected.\n"; return; }
+    auto usage = [&diag]() {
+        diag.err() << "Usage: \\partition_by <table> [<attribute> (hash <partitions> | range <bound>...)];\n";
+    };
+    if (args().size() == 2 or args().size() == 3) { usage(); return; }
+    if (args().size() > 3 and args()[2] != "hash" and args()[2] != "range") { usage(); return; }
+    if (args().size() > 4 and args()[2] == "hash") { usage(); return; }
+
+    auto &DB = C.get_database_in_use();
+    Table *table;
+    try {
+        table = &DB.get_table(C.pool(args()[0].c_str()));
+    } catch (std::out_of_range) {
+        diag.err() << "Table " << args()[0] << " does not exist in database " << DB.name << ".\n";
+        return;
+    }
+
+    if (args().size() == 1) {
+        if (not M_TIME_EXPR(Partitionings::Get().repartition(DB, *table), "Partition table", C.timer())) {
+            diag.err() << "Table " << table->name() << " is not partitioned.\n";
+            return;
+        }
+        if (not Options::Get().quiet)
+            diag.out() << "Clustered the rows of " << table->name() << " by partition.\n";
+        return;
+    }
+
+    Partitionings::Scheme scheme;
+    scheme.attr = C.pool(args()[1].c_str());
+    try {
+        const Attribute &attr = (*table)[scheme.attr];
+        if (not Partitionings::Is_Partitionable(*attr.type)) {
+            diag.err() << "Attribute " << scheme.attr << " of type " << *attr.type
+                       << " is not integral, a date, or a datetime.\n";
+            return;
+        }
+    } catch (std::out_of_range) {
+        diag.err() << "Table " << table->name() << " has no attribute " << scheme.attr << ".\n";
+        return;
+    }
+    try {
+        if (args()[2] == "hash") {
+            scheme.kind = Partitionings::Scheme::P_Hash;
+            scheme.num_partitions = std::stoul(args()[3]);
+            if (scheme.num_partitions == 0) throw std::invalid_argument("no partitions");
+        } else {
+            scheme.kind = Partitionings::Scheme::P_Range;
+            for (auto it = args().begin() + 3; it != args().end(); ++it) {
+                /* Parse the bound as constant expression, e.g. an integer or a date. */
+                auto stmt = statement_from_string(diag, "SELECT " + *it + ";");
+                auto &select = as<const ast::SelectClause>(*as<const ast::SelectStmt>(*stmt).select);
+                const ast::Expr *expr = select.select.front().first.get();
+                bool is_negative = false;
+                if (auto u = cast<const ast::UnaryExpr>(expr); u and u->op().type == TK_MINUS) {
+                    expr = u->expr.get();
+                    is_negative = true;
+                }
+                auto constant = cast<const ast::Constant>(expr);
+                if (not constant or not Partitionings::Is_Partitionable(*constant->type()))
+                    throw std::invalid_argument("invalid bound");
+                const int64_t value = Interpreter::eval(*constant).as_i();
+                const int64_t bound = is_negative ? -value : value;
+                if (not scheme.bounds.empty() and bound <= scheme.bounds.back())
+                    throw std::invalid_argument("bounds not ascending");
+                scheme.bounds.push_back(bound);
+            }
+            scheme.num_partitions = scheme.bounds.size() + 1;
+        }
+    } catch (frontend_exception) {
+        usage();
+        return;
+    } catch (std::exception&) {
+        usage();
+        return;
+    }
+
+    const std::size_t num_partitions = scheme.num_partitions;
+    M_TIME_EXPR(Partitionings::Get().partition(DB, *table, std::move(scheme)), "Partition table", C.timer());
+    if (not Options::Get().quiet)
+        diag.out() << "Partitioned " << table->name() << " by " << args()[1] << " into " << num_partitions
+                   << " partitions.\n";
+}
+
+void compact::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    if (not C.has_database_in_use()) { diag.err() << "No database selected.\n"; return; }
+
+    auto &DB = C.get_database_in_use();
+    std::vector<Table*> tables;
+    if (args().empty()) {
+        for (auto it = DB.begin_tables(); it != DB.end_tables(); ++it)
+            tables.push_back(&*it->second);
+    } else {
+        for (auto &name : args()) {
+            try {
+                tables.push_back(&DB.get_table(C.pool(name.c_str())));
+            } catch (std::out_of_range) {
+                diag.err() << "Table " << name << " does not exist in database " << DB.name << ".\n";
+                return;
+            }
+        }
+    }
+
+    std::size_t num_rows = 0;
+    for (auto table : tables)
+        num_rows += M_TIME_EXPR(Compaction::Get().compact(DB, *table), "Compact table", C.timer());
+
+    if (not Options::Get().quiet) { diag.out() << "Removed " << num_rows << " deleted rows.\n"; }
+}
+
+void recover::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    if (not C.has_database_in_use()) { diag.err() << "No database selected.\n"; return; }
+    if (not WriteAheadLog::enabled()) { diag.err() << "No write-ahead log given, see --wal.\n"; return; }
+
+    auto &DB = C.get_database_in_use();
+    const std::size_t num_rows = M_TIME_EXPR(WriteAheadLog::Get().replay(DB, diag), "Replay write-ahead log",
+                                             C.timer());
+    for (auto it = DB.begin_tables(); it != DB.end_tables(); ++it) {
+        ColumnSketches::Get().update(DB.name, *it->second);
+        SortOrders::Get().update(DB.name, *it->second);
+    }
+
+    if (not Options::Get().quiet) { diag.out() << "Recovered " << num_rows << " rows of " << DB.name << ".\n"; }
+}
+
+void add_node::execute(Diagnostic &diag)
+{
+    if (args().empty()) { diag.err() << "Usage: \\add_node <host>:<port>...;\n"; return; }
+
+    for (auto &arg : args()) {
+        try {
+            auto node = Cluster::Node::Parse(arg);
+            if (not Options::Get().quiet)
+                diag.out() << "Added node " << node << " to the cluster.\n";
+            Cluster::Get().add_node(std::move(node));
+        } catch (m::invalid_argument) {
+            diag.err() << "Invalid node " << arg << ", expected <host>:<port>.\n";
+        }
+    }
+}
+
+void partition::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    if (not C.has_database_in_use()) { diag.err() << "No database selected.\n"; return; }
+    if (args().size() != 2) { diag.err() << "Usage: \\partition <table> <attribute>;\n"; return; }
+
+    auto &DB = C.get_database_in_use();
+    const Table *table;
+    try {
+        table = &DB.get_table(C.pool(args()[0].c_str()));
+    } catch (std::out_of_range) {
+        diag.err() << "Table " << args()[0] << " does not exist in database " << DB.name << ".\n";
+        return;
+    }
+
+    const auto num_errors = diag.num_errors();
+    const std::size_t num_rows = M_TIME_EXPR(Cluster::Get().partition(*table, C.pool(args()[1].c_str()), diag),
+                                             "Repartition table", C.timer());
+    if (diag.num_errors() == num_errors and not Options::Get().quiet)
+        diag.out() << "Partitioned " << num_rows << " rows of " << table->name() << " by " << args()[1] << " across "
+                   << Cluster::Get().nodes().size() << " nodes.\n";
+}
+
+void broadcast::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    if (not C.has_database_in_use()) { diag.err() << "No database selected.\n"; return; }
+    if (args().empty()) { diag.err() << "Usage: \\broadcast <table>...;\n"; return; }
+
+    auto &DB = C.get_database_in_use();
+    for (auto &arg : args()) {
+        const Table *table;
+        try {
+            table = &DB.get_table(C.pool(arg.c_str()));
+        } catch (std::out_of_range) {
+            diag.err() << "Table " << arg << " does not exist in database " << DB.name << ".\n";
+            continue;
+        }
+
+        const auto num_errors = diag.num_errors();
+        const std::size_t num_rows = M_TIME_EXPR(Cluster::Get().broadcast(*table, diag), "Broadcast table",
+                                                 C.timer());
+        if (diag.num_errors() == num_errors and not Options::Get().quiet)
+            diag.out() << "Broadcast " << num_rows << " rows of " << table->name() << " to "
+                       << Cluster::Get().nodes().size() << " nodes.\n";
+    }
+}
+
+void gather::execute(Diagnostic &diag)
+{
+    if (args().empty()) { diag.err() << "Usage: \\gather <query>;\n"; return; }
+
+    std::ostringstream query;
+    for (auto &arg : args())
+        query << arg << ' ';
+    query << ';';
+
+    auto &C = Catalog::Get();
+    auto sink = ResultSinks::Get().find(transaction());
+    std::optional<ResultConsumer> consumer;
+    const bool success = M_TIME_EXPR(
+        Cluster::Get().gather(query.str(), [&](const Schema &S, const Tuple &t) {
+            if (not consumer) consumer.emplace(S, sink);
+            (*consumer)(S, t);
+        }, diag),
+        "Gather query results", C.timer()
+    );
+    if (success and consumer)
+        consumer->finish();
+}
+
+void compound_select::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    if (not C.has_database_in_use()) { diag.err() << "No database selected.\n"; return; }
+
+    SetOperations::compound_query query;
+    try {
+        query = SetOperations::Parse(args());
+    } catch (m::invalid_argument e) {
+        diag.err() << "Invalid compound query: " << e.what() << ".\n"
+                   << "Usage: \\compound_select <query> {UNION [ALL] | INTERSECT | EXCEPT} <query>...;\n";
+        return;
+    }
+
+    /*----- Analyze the queries one after another, since semantic analysis is not thread-safe.  Check that their
+     * results are compatible before executing any of them, such that no rows are produced for an invalid query. -----*/
+    const auto num_errors = diag.num_errors();
+    std::vector<std::unique_ptr<DatabaseCommand>> queries;
+    std::vector<const Type*> result_types;
+    for (auto &sql : query.selects) {
+        auto command = command_from_string(diag, sql);
+        if (diag.num_errors() != num_errors or not command)
+            return;
+        if (not is<ast::SelectStmt>(*command)) { diag.err() << "Expected a SELECT statement.\n"; return; }
+        ast::Sema sema(diag);
+        auto cmd = sema.analyze(std::move(command));
+        if (diag.num_errors() != num_errors or not cmd)
+            return;
+        auto types = SetOperations::Result_Types(as<const ast::SelectStmt>(cmd->ast()));
+        if (queries.empty()) {
+            result_types = std::move(types);
+        } else if (not SetOperations::Is_Compatible(result_types, types)) {
+            diag.err() << "Query " << queries.size() + 1 << " of the compound query produces rows that do not match "
+                       << "the rows of the first query.\n";
+            return;
+        }
+        queries.push_back(std::move(cmd));
+    }
+    const std::size_t num_queries = queries.size();
+
+    /* Every query executes in a transaction of its own, which reads the snapshot of this transaction and passes the
+     * rows of the query to a sink of its own.  The sinks are removed on every path. */
+    struct Transactions
+    {
+        std::vector<std::unique_ptr<Scheduler::Transaction>> transactions;
+        ~Transactions() { for (auto &t : transactions) ResultSinks::Get().remove(*t); }
+    } query_transactions;
+
+    const bool concatenate = query.is_concatenation();
+    auto sink = ResultSinks::Get().find(transaction());
+    std::mutex mutex; ///< protects `schema` and `consumer`
+    std::optional<Schema> schema; ///< the schema of the first row produced by any query
+    std::optional<ResultConsumer> consumer; ///< consumes the concatenated rows
+    std::vector<std::vector<Tuple>> results(num_queries); ///< the rows of the queries, unless concatenated
+    for (std::size_t i = 0; i != num_queries; ++i) {
+        auto &t = *query_transactions.transactions.emplace_back(C.scheduler().begin_transaction());
+        if (transaction())
+            t.start_time(transaction()->start_time());
+        ResultSinks::Get().add(t, [&, i](const Schema &S, const Tuple &tup) {
+            if (concatenate) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (not schema) {
+                    schema.emplace(S);
+                    consumer.emplace(*schema, sink);
+                }
+                (*consumer)(*schema, tup);
+            } else {
+                if (results[i].empty()) { // the sink of a query is only called by the thread executing it
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (not schema)
+                        schema.emplace(S);
+                }
+                results[i].push_back(tup.clone(S));
+            }
+        });
+    }
+
+    /*----- Execute the queries in parallel. -----*/
+    std::vector<std::ostringstream> outs(num_queries), errs(num_queries);
+    std::vector<std::size_t> query_errors(num_queries, 0);
+    M_TIME_EXPR(
+        WorkerPool::Get().parallel_for(num_queries, [&](std::size_t i) {
+            Diagnostic query_diag(false, outs[i], errs[i]);
+            queries[i]->transaction(query_transactions.transactions[i].get());
+            queries[i]->execute(query_diag);
+            query_errors[i] = query_diag.num_errors();
+        }),
+        "Execute compound query", C.timer()
+    );
+    bool success = true;
+    for (std::size_t i = 0; i != num_queries; ++i) {
+        diag.out() << outs[i].str();
+        diag.err() << errs[i].str();
+        success = success and query_errors[i] == 0;
+    }
+    if (not success or not schema)
+        return;
+
+    /*----- Combine the results. -----*/
+    if (concatenate) {
+        consumer->finish();
+        return;
+    }
+    auto rows = M_TIME_EXPR(SetOperations::Combine(*schema, std::move(results), query.operators),
+                            "Combine query results", C.timer());
+    ResultConsumer combined(*schema, sink);
+    for (auto &row : rows)
+        combined(*schema, row);
+    combined.finish();
+}
+
+void append_batches::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    auto batches = Cluster::Get().take_staged(transaction());
+    if (batches.empty()) return;
+    if (not C.has_database_in_use()) { diag.err() << "No database selected.\n"; return; }
+
+    auto &DB = C.get_database_in_use();
+    for (auto &[table_name, batch] : batches) {
+        Table *table;
+        try {
+            table = &DB.get_table(C.pool(table_name.c_str()));
+        } catch (std::out_of_range) {
+            diag.err() << "Table " << table_name << " does not exist in database " << DB.name << ".\n";
+            continue;
+        }
+
+        const std::size_t first_row = table->store().num_rows();
+        StoreWriter W(table->store());
+        try {
+            wire::BatchReader R(W.schema(), batch);
+            Tuple tuple(W.schema());
+            while (not R.empty()) {
+                R.read(tuple);
+                W.append(tuple);
+            }
+        } catch (m::invalid_argument) {
+            diag.err() << "Record batch does not match the schema of table " << table_name << ".\n";
+            continue;
+        }
+        if (auto pax = cast<const PaxStore>(&table->store()))
+            pax->update_synopses();
+        rows_appended(DB, *table, first_row, transaction());
+    }
+}
+
+void refresh_table::execute(Diagnostic &diag)
+{
+    auto &C = Catalog::Get();
+    if (not C.has_database_in_use()) { diag.err() << "No database selected.\n"; return; }
+    if (args().empty()) { diag.err() << "Usage: \\refresh_table <table>...;\n"; return; }
+
+    auto &DB = C.get_database_in_use();
+    for (auto &arg : args()) {
+        Table *table;
+        try {
+            table = &DB.get_table(C.pool(arg.c_str()));
+        } catch (std::out_of_range) {
+            diag.err() << "Table " << arg << " does not exist in database " << DB.name << ".\n";
+            continue;
+        }
+
+        /*----- Vacuum the table, i.e. remove the deleted versions that no transaction sees anymore. -----*/
+        M_TIME_EXPR(Compaction::Get().compact(DB, *table), "Compact table", C.timer());
+
+        /*----- Re-analyze the table, if it was analyzed. -----*/
+        if (ColumnStatistics::Get().find(DB.name, table->name())) {
+            M_TIME_EXPR(ColumnStatistics::Get().analyze(DB.name, *table), "Analyze table", C.timer());
+            PlanCache::Get().clear(); // cached join orders were chosen using the previous estimates
+        }
+
+        /*----- Recompute the zone maps of blocks whose synopses were invalidated. -----*/
+        if (auto pax = cast<const PaxStore>(&table->store()))
+            M_TIME_EXPR(pax->update_synopses(), "Update zone maps", C.timer());
+
+        /*----- Rebuild the indexes of the table, which were invalidated by the writes. -----*/
+        for (auto &[index_name, create_index] : Maintenance::Get().indexes(DB.name, table->name())) {
+            std::ostringstream drop_index;
+            drop_index << "DROP INDEX " << index_name << ';';
+            if (execute_nested(drop_index.str(), transaction(), diag))
+                M_TIME_EXPR(execute_nested(create_index, transaction(), diag), "Rebuild index", C.timer());
+        }
+
+        Maintenance::Get().refreshed(DB.name, *table);
+        if (not Options::Get().quiet)
+            diag.out() << "Refreshed table " << table->name() << ".\n";
+    }
+}
+
+void add_replica::execute(Diagnostic &diag)
+{
+    if (args().empty()) { diag.err() << "Usage: \\add_replica <host>:<port>...;\n"; return; }
+    if (Replication::Is_Replica()) { diag.err() << "A read-only replica cannot have replicas.\n"; return; }
+
+    for (auto &arg : args()) {
+        try {
+            auto node = Cluster::Node::Parse(arg);
+            if (not Options::Get().quiet)
+                diag.out() << "Added replica " << node << ".\n";
+            Replication::Get().add_replica(std::move(node));
+        } catch (m::invalid_argument) {
+            diag.err() << "Invalid replica " << arg << ", expected <host>:<port>.\n";
+        }
+    }
+}
+
+void replication_status::execute(Diagnostic &diag) { Replication::Get().print_status(diag.out()); }
+
 __attribute__((constructor(201)))
 static void register_instructions()
 {
@@ -43,6 +934,22 @@ static void register_instructions()
 #define REGISTER(NAME, DESCRIPTION) \
     C.register_instruction<NAME>(C.pool(#NAME), DESCRIPTION)
     REGISTER(learn_spns, "create an SPN for every table in the database");
+    REGISTER(analyze, "compute statistics of the columns of every table in the database");
+    REGISTER(create_materialized_view, "create an incrementally maintained materialized view of a query");
+    REGISTER(drop_materialized_view, "drop materialized views");
+    REGISTER(sorted_by, "declare a column of a table to be sorted");
+    REGISTER(partition_by, "partition a table by an attribute and cluster its rows by partition");
+    REGISTER(compact, "remove the deleted versions of tables");
+    REGISTER(recover, "replay the rows of the write-ahead log into the tables of the database");
+    REGISTER(add_node, "add nodes to the cluster");
+    REGISTER(partition, "repartition the rows of a table across the nodes of the cluster by an attribute");
+    REGISTER(broadcast, "copy the rows of tables to every node of the cluster");
+    REGISTER(gather, "execute a query on every node of the cluster and combine the results");
+    REGISTER(compound_select, "execute queries combined by UNION, INTERSECT, and EXCEPT in parallel");
+    REGISTER(append_batches, "append the record batches received by mutable-server");
+    REGISTER(refresh_table, "refresh the statistics, zone maps, and indexes of tables");
+    REGISTER(add_replica, "add read-only replicas to which committed transactions are shipped");
+    REGISTER(replication_status, "print the progress of the replicas or the replication lag of this replica");
 #undef REGISTER
 }
 
@@ -50,6 +957,29 @@ static void register_instructions()
  * Data Manipulation Language (DML)
  *====================================================================================================================*/
 
+namespace {
+
+/** Collects the tables read by the query of \p G and its nested queries into \p tables.  Returns `false` iff any of
+ * the tables is multi-versioned, since the result of the query then depends on the start time of its transaction. */
+bool collect_tables(const QueryGraph &G, std::vector<const Table*> &tables)
+{
+    auto &C = Catalog::Get();
+    for (auto &ds : G.sources()) {
+        if (auto bt = cast<const BaseTable>(ds.get())) {
+            auto &table = bt->table();
+            auto is_ts = [&](const Attribute &attr) { return attr.name == C.pool("$ts_begin"); };
+            if (std::find_if(table.cbegin_hidden(), table.end_hidden(), is_ts) != table.end_hidden())
+                return false;
+            tables.push_back(&table);
+        } else if (not collect_tables(*as<const Query>(*ds).query_graph(), tables)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
 void QueryDatabase::execute(Diagnostic &diag)
 {
     Catalog &C = Catalog::Get();
@@ -64,6 +994,9 @@ void QueryDatabase::execute(Diagnostic &diag)
         }
     }
 
+    if (advise_layouts())
+        LayoutAdvisor::Get().record(ast<ast::SelectStmt>());
+
     auto graph_construction = C.timer().create_timing("Construct the query graph");
     graph_ = QueryGraph::Build(ast<ast::SelectStmt>());
     graph_->transaction(this->transaction());
@@ -83,6 +1016,64 @@ void QueryDatabase::execute(Diagnostic &diag)
         std::cout.flush();
     }
 
+    auto sink = ResultSinks::Get().find(transaction());
+
+    /*----- Answer the query from the result cache, if possible. -----*/
+    std::optional<ResultCache::key_type> cache_key;
+    ResultCache::versions_type cache_versions;
+    /* Withdraws the announcement to compute the cached result on every path that does not insert the result, s.t.
+     * concurrent queries waiting for it resume. */
+    struct Announcement
+    {
+        const ResultCache::key_type *key = nullptr; ///< the key whose result is announced to be computed, if any
+        ~Announcement() { if (key) ResultCache::Get().abandon(*key); }
+    } announcement;
+    if (ResultCache::enabled() and not Options::Get().dryrun) {
+        std::vector<const Table*> tables;
+        if (collect_tables(*graph_, tables)) {
+            std::ostringstream key;
+            key << C.get_database_in_use().name << ';';
+            ast::ASTPrinter print(key);
+            print(ast<ast::SelectStmt>());
+            cache_key = key.str();
+            cache_versions = ResultCache::Get().versions(tables);
+
+            bool announced;
+            auto cached = ResultCache::Get().find_or_wait(*cache_key, announced);
+            if (announced)
+                announcement.key = &*cache_key;
+            if (cached) {
+                ResultConsumer consumer(cached->schema, sink);
+                for (auto &t : cached->rows)
+                    consumer(cached->schema, t);
+                consumer.finish();
+                if (Options::Get().statistics)
+                    ResultCache::Get().print_statistics(std::cout);
+                if (advise_layouts())
+                    LayoutAdvisor::Get().report_changes(ast<ast::SelectStmt>(), std::cerr);
+                return;
+            }
+        }
+    }
+
+    /*----- Answer the query approximately from the SPN of its table, if requested and possible. -----*/
+    if (ApproximateAggregates::enabled() and not Options::Get().dryrun) {
+        if (auto approx = ApproximateAggregates::answer(C.get_database_in_use().name, *graph_)) {
+            ResultConsumer consumer(approx->schema, sink);
+            consumer(approx->schema, approx->row);
+            consumer.finish();
+            if (not sink and not Options::Get().quiet) {
+                std::cout << "approximate result from SPN, bounds:";
+                for (auto [lo, hi] : approx->bounds)
+                    std::cout << " [" << lo << ", " << hi << ']';
+                std::cout << '\n';
+            }
+            if (advise_layouts())
+                LayoutAdvisor::Get().report_changes(ast<ast::SelectStmt>(), std::cerr);
+            return;
+        }
+    }
+
     auto logical_plan_computation = C.timer().create_timing("Compute the logical query plan");
     Optimizer Opt(C.plan_enumerator(), C.cost_function());
     std::unique_ptr<Producer> producer = Opt(*graph_);
@@ -99,7 +1090,29 @@ void QueryDatabase::execute(Diagnostic &diag)
         dot.show("logical_plan", false, "dot");
     }
 
-    if (Options::Get().benchmark)
+    /* Collect the rows of a cacheable result while passing them on, unless the result exceeds the capacity of the
+     * cache. */
+    const Schema result_schema = producer->schema();
+    std::optional<ResultConsumer> consumer;
+    std::vector<Tuple> cached_rows;
+    bool cache_result = cache_key.has_value();
+    if (cache_key) {
+        const std::size_t max_cached_rows = ResultCache::Get().capacity() / ResultCache::Row_Size(result_schema);
+        consumer.emplace(result_schema, sink);
+        logical_plan_ = std::make_unique<CallbackOperator>([&, max_cached_rows](const Schema &S, const Tuple &t) {
+            if (cache_result) {
+                if (cached_rows.size() == max_cached_rows) {
+                    cache_result = false;
+                    cached_rows = std::vector<Tuple>();
+                } else {
+                    cached_rows.push_back(t.clone(S));
+                }
+            }
+            (*consumer)(S, t);
+        });
+    } else if (sink)
+        logical_plan_ = std::make_unique<CallbackOperator>(*sink);
+    else if (Options::Get().benchmark)
         logical_plan_ = std::make_unique<NoOpOperator>(std::cout);
     else
         logical_plan_ = std::make_unique<PrintOperator>(std::cout);
@@ -108,6 +1121,8 @@ void QueryDatabase::execute(Diagnostic &diag)
     static thread_local std::unique_ptr<Backend> backend;
     if (not backend)
         backend = M_TIME_EXPR(C.create_backend(), "Create backend", C.timer());
+    if (auto auto_backend = cast<AutoBackend>(backend.get()))
+        auto_backend->choose(*logical_plan_); // choose the backend per query
 
     auto physical_plan_computation = C.timer().create_timing("Compute the physical query plan");
     PhysicalOptimizerImpl<ConcretePhysicalPlanTable> PhysOpt;
@@ -121,8 +1136,46 @@ void QueryDatabase::execute(Diagnostic &diag)
     if (Options::Get().physplan)
         physical_plan_->dump(std::cout);
 
-    if (not Options::Get().dryrun)
-        M_TIME_EXPR(backend->execute(*physical_plan_), "Execute query", C.timer());
+    if (not Options::Get().dryrun) {
+        /* Admit the query against the memory budget, waiting while the queries in execution hold too much memory.  The
+         * memory is released when `admission` is destroyed, after the query is executed. */
+        auto admission = M_TIME_EXPR(
+            AdmissionControl::Get().admit(AdmissionControl::Estimate_Peak_Memory(*logical_plan_)),
+            "Admit query", C.timer()
+        );
+
+        std::optional<PerfCounters> counters; ///< hardware counters of the execution, if statistics are requested
+        if (Options::Get().statistics) {
+            counters.emplace();
+            counters->start();
+        }
+        try {
+            QueryCancellation::Scope cancellation(transaction());
+            M_TIME_EXPR(backend->execute(*physical_plan_), "Execute query", C.timer());
+        } catch (query_cancelled) {
+            diag.err() << "Query cancelled.\n";
+            return;
+        }
+        if (counters) {
+            counters->stop();
+            std::cout << "Hardware counters of query execution: " << *counters << std::endl;
+        }
+        if (CardinalityFeedback::enabled())
+            CardinalityFeedback::Get().record(*graph_, *logical_plan_, Options::Get().statistics ? &std::cout : nullptr);
+        if (consumer) {
+            consumer->finish();
+            if (cache_result) {
+                announcement.key = nullptr; // inserting resumes the waiting queries
+                ResultCache::Get().insert(std::move(*cache_key), result_schema, std::move(cached_rows),
+                                          std::move(cache_versions));
+            }
+            if (Options::Get().statistics)
+                ResultCache::Get().print_statistics(std::cout);
+        }
+    }
+
+    if (advise_layouts())
+        LayoutAdvisor::Get().report_changes(ast<ast::SelectStmt>(), std::cerr);
 }
 
 void InsertRecords::execute(Diagnostic&)
@@ -133,9 +1186,9 @@ void InsertRecords::execute(Diagnostic&)
     auto &I = ast<ast::InsertStmt>();
     auto &T = DB.get_table(I.table_name.text.assert_not_none());
     auto &store = T.store();
+    const std::size_t first_row = store.num_rows();
     StoreWriter W(store);
     auto &S = W.schema();
-    Tuple tup(S);
 
     /* Find timestamp attributes */
     auto ts_begin = std::find_if(T.cbegin_hidden(), T.end_hidden(),
@@ -147,53 +1200,135 @@ void InsertRecords::execute(Diagnostic&)
                                     return attr.name == C.pool("$ts_end");
     });
 
+    /* Compile a single stack machine per batch of tuples rather than per tuple, since constructing the stack machine
+     * dominates evaluating the usually constant values. */
+    constexpr std::size_t BATCH_SIZE = 1024;
+    const std::size_t num_tuples_per_batch = std::min(BATCH_SIZE, I.tuples.size());
+    std::vector<Tuple> tuples;
+    std::vector<Tuple*> args;
+    tuples.reserve(num_tuples_per_batch);
+    args.reserve(num_tuples_per_batch);
+    for (std::size_t j = 0; j != num_tuples_per_batch; ++j) {
+        tuples.emplace_back(S);
+        args.push_back(&tuples.back());
+    }
+
     /* Write all tuples to the store. */
-    for (auto &t : I.tuples) {
-        StackMachine get_tuple(Schema{});
-        for (std::size_t i = 0; i != t.size(); ++i) {
-            auto attr_id = T.convert_id(i); // hidden attributes change the actual id of the attribute
-            auto &v = t[i];
-            switch (v.first) {
-                case ast::InsertStmt::I_Null:
-                    get_tuple.emit_St_Tup_Null(0, i);
-                    break;
-
-                case ast::InsertStmt::I_Default:
-                    /* nothing to be done, Tuples are initialized to default values */
-                    break;
-
-                case ast::InsertStmt::I_Expr:
-                    get_tuple.emit(*v.second);
-                    get_tuple.emit_Cast(S[attr_id].type, v.second->type());
-                    get_tuple.emit_St_Tup(0, attr_id, S[attr_id].type);
-                    break;
+    for (std::size_t batch_begin = 0; batch_begin < I.tuples.size(); batch_begin += BATCH_SIZE) {
+        const std::size_t batch_end = std::min(batch_begin + BATCH_SIZE, I.tuples.size());
+
+        StackMachine get_tuples(Schema{});
+        for (std::size_t j = 0; j != batch_end - batch_begin; ++j) {
+            auto &t = I.tuples[batch_begin + j];
+            for (std::size_t i = 0; i != t.size(); ++i) {
+                auto attr_id = T.convert_id(i); // hidden attributes change the actual id of the attribute
+                auto &v = t[i];
+                switch (v.first) {
+                    case ast::InsertStmt::I_Null:
+                        get_tuples.emit_St_Tup_Null(j, i);
+                        break;
+
+                    case ast::InsertStmt::I_Default:
+                        /* nothing to be done, Tuples are initialized to default values */
+                        break;
+
+                    case ast::InsertStmt::I_Expr:
+                        get_tuples.emit(*v.second);
+                        get_tuples.emit_Cast(S[attr_id].type, v.second->type());
+                        get_tuples.emit_St_Tup(j, attr_id, S[attr_id].type);
+                        get_tuples.emit_Pop(); // keep the stack small, independent of the batch size
+                        break;
+                }
             }
         }
-        Tuple *args[] = { &tup };
-        get_tuple(args);
+        get_tuples(args.data());
 
-        /*----- set timestamps if available. -----*/
-        if (ts_begin != T.end_hidden()) {
-            tup.set(ts_begin->id, Value(transaction()->start_time()));
-            /* Set $ts_end to -1. It is a special value representing infinity. */
-            M_insist(ts_end != T.end_hidden());
-            tup.set(ts_end->id, Value(-1));
+        for (std::size_t j = 0; j != batch_end - batch_begin; ++j) {
+            auto &tup = tuples[j];
+
+            /*----- set timestamps if available. -----*/
+            if (ts_begin != T.end_hidden()) {
+                tup.set(ts_begin->id, Value(transaction()->start_time()));
+                /* Set $ts_end to -1. It is a special value representing infinity. */
+                M_insist(ts_end != T.end_hidden());
+                tup.set(ts_end->id, Value(-1));
+            }
+
+            W.append(tup);
         }
 
-        W.append(tup);
+        /* Release the expressions of this batch as soon as its tuples are written.  The AST of a huge `INSERT` thus
+         * shrinks while the statement executes, rather than peaking at the AST plus all written rows. */
+        for (std::size_t j = batch_begin; j != batch_end; ++j)
+            I.tuples[j] = {};
     }
-    /* Invalidate all indexes on the table. */
-    DB.invalidate_indexes(T.name());
+    rows_appended(DB, T, first_row, transaction());
 }
 
-void UpdateRecords::execute(Diagnostic&)
+void UpdateRecords::execute(Diagnostic &diag)
 {
-    M_unreachable("not yet implemented");
+    if (not may_delete_rows(diag)) return; // an update deletes the old versions of the rows
+    Catalog &C = Catalog::Get();
+    auto &DB = C.get_database_in_use();
+
+    auto &U = ast<ast::UpdateStmt>();
+    auto &T = DB.get_table(U.table_name.text.assert_not_none());
+    const Schema S = T.schema();
+
+    /* Compile the computation of the new version of a row from the old one: the assigned attributes are computed from
+     * their expressions, all others are copied. */
+    StackMachine compute_row(S);
+    std::vector<bool> is_assigned(S.num_entries());
+    for (auto &[attr, expr] : U.set) {
+        const std::size_t attr_id = S[Schema::Identifier(T.name(), attr.text.assert_not_none())].first;
+        is_assigned[attr_id] = true;
+        compute_row.emit(*expr, 1);
+        compute_row.emit_Cast(S[attr_id].type, expr->type());
+        compute_row.emit_St_Tup(0, attr_id, S[attr_id].type);
+        compute_row.emit_Pop();
+    }
+    for (std::size_t attr_id = 0; attr_id != S.num_entries(); ++attr_id) {
+        if (is_assigned[attr_id]) continue;
+        compute_row.emit_Ld_Tup(1, attr_id);
+        compute_row.emit_St_Tup(0, attr_id, S[attr_id].type);
+        compute_row.emit_Pop();
+    }
+    auto ts_begin = S.find(Schema::Identifier(T.name(), C.pool("$ts_begin")));
+    auto ts_end = S.find(Schema::Identifier(T.name(), C.pool("$ts_end")));
+
+    /* Compute the new versions of the selected rows.  The new versions are copied, since they may reference the old
+     * rows in the store, which are about to be moved. */
+    std::vector<Tuple> new_rows;
+    Tuple new_row(S);
+    auto deleted = select_rows(T, U.where.get(), *transaction(), [&](Tuple &old_row, std::size_t) {
+        Tuple *args[] = { &new_row, &old_row };
+        compute_row(args);
+        if (ts_begin != S.cend()) {
+            new_row.set(std::distance(S.cbegin(), ts_begin), Value(transaction()->start_time()));
+            new_row.set(std::distance(S.cbegin(), ts_end), Value(-1)); // -1 represents infinity
+        }
+        new_rows.push_back(new_row.clone(S));
+    });
+
+    /* An update deletes the old versions of the rows and appends their new versions. */
+    Compaction::Get().delete_rows(DB, T, deleted, *transaction());
+    const std::size_t first_row = T.store().num_rows();
+    StoreWriter W(T.store());
+    for (auto &tup : new_rows)
+        W.append(tup);
+    rows_appended(DB, T, first_row, transaction());
 }
 
-void DeleteRecords::execute(Diagnostic&)
+void DeleteRecords::execute(Diagnostic &diag)
 {
-    M_unreachable("not yet implemented");
+    if (not may_delete_rows(diag)) return;
+    Catalog &C = Catalog::Get();
+    auto &DB = C.get_database_in_use();
+
+    auto &D = ast<ast::DeleteStmt>();
+    auto &T = DB.get_table(D.table_name.text.assert_not_none());
+    auto deleted = select_rows(T, D.where.get(), *transaction(), [](const Tuple&, std::size_t) { });
+    Compaction::Get().delete_rows(DB, T, deleted, *transaction());
 }
 
 void ImportDSV::execute(Diagnostic &diag)
@@ -211,11 +1346,53 @@ void ImportDSV::execute(Diagnostic &diag)
                 diag.err() << ": " << strerror(errsv);
             diag.err() << std::endl;
         } else {
+            const std::size_t first_row = table_.store().num_rows();
             M_TIME_EXPR(R(file, path_.c_str()), "Read DSV file", C.timer());
+
+            /*----- Summarize the imported rows in the zone maps of PAX stores. -----*/
+            if (auto pax = cast<const PaxStore>(&table_.store()))
+                M_TIME_EXPR(pax->update_synopses(), "Update zone maps", C.timer());
+
+            /*----- Insert the imported rows into the SPN of the table, if any. -----*/
+            if (C.has_database_in_use())
+                M_TIME_EXPR(SpnMaintenance::Get().rows_appended(C.get_database_in_use().name, table_, first_row),
+                            "Update SPN", C.timer());
+
+            /*----- Feed the imported rows into the sketches of the columns. -----*/
+            if (C.has_database_in_use())
+                M_TIME_EXPR(ColumnSketches::Get().update(C.get_database_in_use().name, table_),
+                            "Update column sketches", C.timer());
+
+            /*----- Observe the orders of the columns of the imported rows. -----*/
+            if (C.has_database_in_use())
+                M_TIME_EXPR(SortOrders::Get().update(C.get_database_in_use().name, table_),
+                            "Detect sort orders", C.timer());
+
+            /*----- Add the imported rows to the materialized views of the table. -----*/
+            if (C.has_database_in_use())
+                MaterializedViews::Get().rows_appended(C.get_database_in_use().name, table_);
+
+            /*----- Count the imported rows towards refreshing the statistics and indexes of the table. -----*/
+            if (C.has_database_in_use())
+                Maintenance::Get().rows_modified(C.get_database_in_use().name, table_,
+                                                 table_.store().num_rows() - first_row);
+
+            /*----- Log the imported rows; they become durable when the transaction commits. -----*/
+            if (C.has_database_in_use() and WriteAheadLog::enabled() and transaction())
+                M_TIME_EXPR(WriteAheadLog::Get().log_rows(*transaction(), C.get_database_in_use().name, table_,
+                                                          first_row),
+                            "Log imported rows", C.timer());
+
+            /*----- Ship the imported rows to the replicas, if any, when the transaction commits. -----*/
+            if (C.has_database_in_use() and transaction() and Replication::Get().is_primary())
+                M_TIME_EXPR(Replication::Get().log_rows(*transaction(), C.get_database_in_use().name, table_,
+                                                        first_row),
+                            "Ship imported rows", C.timer());
         }
     } catch (m::invalid_argument e) {
         diag.err() << "Error reading DSV file: " << e.what() << "\n";
     }
+    ResultCache::Get().invalidate(table_); // rows may have been imported before an error
 }
 
 
@@ -227,6 +1404,7 @@ void CreateDatabase::execute(Diagnostic &diag)
 {
     try {
         Catalog::Get().add_database(db_name_);
+        statement_executed(transaction(), nullptr, ast());
         if (not Options::Get().quiet)
             diag.out() << "Created database " << db_name_ << ".\n";
     } catch (std::invalid_argument) {
@@ -237,7 +1415,11 @@ void CreateDatabase::execute(Diagnostic &diag)
 void DropDatabase::execute(Diagnostic &diag)
 {
     try {
+        MaterializedViews::Get().database_dropped(db_name_);
         Catalog::Get().drop_database(db_name_);
+        Maintenance::Get().database_dropped(db_name_);
+        ResultCache::Get().clear();
+        statement_executed(transaction(), nullptr, ast());
         if (not Options::Get().quiet)
             diag.out() << "Dropped database " << db_name_ << ".\n";
     } catch (std::invalid_argument) {
@@ -272,6 +1454,8 @@ void CreateTable::execute(Diagnostic &diag)
 
     table->layout(C.data_layout());
     table->store(C.create_store(*table));
+    ResultCache::Get().invalidate(*table); // a dropped table may have had the same address
+    statement_executed(transaction(), &DB.name, ast());
 
     if (not Options::Get().quiet)
         diag.out() << "Created table " << table->name() << ".\n";
@@ -282,15 +1466,22 @@ void DropTable::execute(Diagnostic &diag)
     auto &C = Catalog::Get();
     auto &DB = C.get_database_in_use();
 
+    bool dropped_all = true;
     for (auto &table_name : table_names_) {
         try {
+            MaterializedViews::Get().table_dropped(DB.name, table_name);
             DB.drop_table(table_name);
+            Maintenance::Get().table_dropped(DB.name, table_name);
+            ResultCache::Get().clear();
             if (not Options::Get().quiet)
                 diag.out() << "Dropped table " << table_name << ".\n";
         } catch (std::invalid_argument) {
             diag.err() << "Table " << table_name << " does not exist in Database " << DB.name << ".\n";
+            dropped_all = false;
         }
     }
+    if (dropped_all)
+        statement_executed(transaction(), &DB.name, ast());
 }
 
 void CreateIndex::execute(Diagnostic &diag)
@@ -318,6 +1509,8 @@ void CreateIndex::execute(Diagnostic &diag)
     /* Add index to database. */
     try {
         DB.add_index(std::move(index_), table_name_, attribute_name_, index_name_);
+        Maintenance::Get().index_created(DB.name, table_name_, index_name_, ast());
+        statement_executed(transaction(), &DB.name, ast());
         if (not Options::Get().quiet)
             diag.out() << "Created index " << index_name_ << ".\n";
     } catch (std::out_of_range) {
@@ -333,15 +1526,20 @@ void DropIndex::execute(Diagnostic &diag)
     auto &C = Catalog::Get();
     auto &DB = C.get_database_in_use();
 
+    bool dropped_all = true;
     for (auto &index_name : index_names_) {
         try {
             DB.drop_index(index_name);
+            Maintenance::Get().index_dropped(DB.name, index_name);
             if (not Options::Get().quiet)
                 diag.out() << "Dropped index " << index_name << ".\n";
         } catch (invalid_argument) {
             diag.err() << "Index " << index_name << " does not exist in Database " << DB.name << ".\n";
+            dropped_all = false;
         }
     }
+    if (dropped_all)
+        statement_executed(transaction(), &DB.name, ast());
 }
 
 #define ACCEPT(CLASS) \
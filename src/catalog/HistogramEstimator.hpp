@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutable/catalog/CardinalityEstimator.hpp>
+#include <mutable/IR/CNF.hpp>
+#include <mutable/IR/QueryGraph.hpp>
+#include <mutable/util/Pool.hpp>
+#include <optional>
+#include <vector>
+
+
+namespace m {
+
+/** Estimates cardinalities by the column statistics computed by `analyze`, see `ColumnStatistics`.  Predicates
+ * comparing a column with a constant are estimated by the MCVs and the equi-depth histogram of the column, equi-joins
+ * by the numbers of distinct values of the joined columns.  Predicates, and clauses of a CNF, are assumed to be
+ * independent.  Predicates that cannot be estimated by the statistics get the default selectivities below, like in
+ * PostgreSQL. */
+struct HistogramEstimator : CardinalityEstimator
+{
+    ///> the selectivity of an equality predicate that cannot be estimated by statistics
+    static constexpr double DEFAULT_EQUALITY_SELECTIVITY = 0.005;
+    ///> the selectivity of any other predicate that cannot be estimated by statistics
+    static constexpr double DEFAULT_SELECTIVITY = 1. / 3;
+
+    struct HistogramDataModel : DataModel
+    {
+        friend struct HistogramEstimator;
+
+        private:
+        Subproblem subproblem_;
+        double size_; ///< the estimated number of rows
+
+        public:
+        HistogramDataModel(Subproblem subproblem, double size) : subproblem_(subproblem), size_(size) { }
+
+        double size() const { return size_; }
+    };
+
+    HistogramEstimator(ThreadSafePooledString) { }
+
+    /*----- Model calculation ----------------------------------------------------------------------------------------*/
+    std::unique_ptr<DataModel> empty_model() const override;
+    std::unique_ptr<DataModel> estimate_scan(const QueryGraph &G, Subproblem P) const override;
+    std::unique_ptr<DataModel>
+    estimate_filter(const QueryGraph &G, const DataModel &data, const cnf::CNF &filter) const override;
+    std::unique_ptr<DataModel>
+    estimate_limit(const QueryGraph &G, const DataModel &data, std::size_t limit, std::size_t offset) const override;
+    std::unique_ptr<DataModel>
+    estimate_grouping(const QueryGraph &G, const DataModel &data, const std::vector<group_type> &groups) const override;
+    std::unique_ptr<DataModel>
+    estimate_join(const QueryGraph &G, const DataModel &left, const DataModel &right,
+                  const cnf::CNF &condition) const override;
+
+    template<typename PlanTable>
+    std::unique_ptr<DataModel>
+    operator()(estimate_join_all_tag, PlanTable &&PT, const QueryGraph &G, Subproblem to_join,
+               const cnf::CNF &condition) const;
+
+    /*----- Interpretation -------------------------------------------------------------------------------------------*/
+    std::size_t predict_cardinality(const DataModel &data) const override;
+
+    void print(std::ostream &out) const override;
+
+    /** Returns the estimated selectivity of \p cnf, assuming independent clauses. */
+    static double selectivity(const cnf::CNF &cnf);
+
+    private:
+    /** Returns the estimated selectivity of \p pred, or `std::nullopt` if it cannot be estimated by statistics. */
+    static std::optional<double> selectivity(const cnf::Predicate &pred);
+
+    /** Returns the estimated number of distinct values of \p attr, preferring the statistics of `analyze` over the
+     * sketches of `ColumnSketches`, or `std::nullopt` if neither knows \p attr. */
+    static std::optional<double> distinct_values(const Attribute &attr);
+};
+
+}
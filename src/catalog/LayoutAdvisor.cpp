@@ -0,0 +1,209 @@
+#include "catalog/LayoutAdvisor.hpp"
+
+#include <algorithm>
+#include <map>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/util/fn.hpp>
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** Whether to record the workload and report changes of the advised data layout per table. */
+bool advise_layouts = false;
+
+}
+
+__attribute__((constructor(201)))
+static void add_layout_advisor_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<bool>(
+        /* group=       */ "Catalog",
+        /* short=       */ nullptr,
+        /* long=        */ "--advise-layouts",
+        /* description= */ "record the attributes accessed by queries and report the data layout advised per table",
+        /* callback=    */ [](bool b){ options::advise_layouts = b; }
+    );
+}
+
+}
+
+bool m::advise_layouts() { return options::advise_layouts; }
+
+LayoutAdvisor & LayoutAdvisor::Get()
+{
+    static LayoutAdvisor the_advisor;
+    return the_advisor;
+}
+
+void LayoutAdvisor::collect(const ast::SelectStmt &stmt, std::unordered_map<const Table*, std::vector<bool>> &accessed)
+{
+    auto handle_fn = overloaded {
+        [](auto&) { },
+        [&accessed](const ast::Designator &d) {
+            if (auto attr = std::get_if<const Attribute*>(&d.target())) {
+                auto &bitmap = accessed[&(*attr)->table];
+                bitmap.resize((*attr)->table.num_attrs(), false);
+                bitmap[(*attr)->id] = true;
+            }
+        },
+        [&accessed](const ast::QueryExpr &e) {
+            collect(as<const ast::SelectStmt>(*e.query), accessed);
+            throw visit_skip_subtree{};
+        },
+    };
+    auto collect_expr = [&handle_fn](const ast::Expr &e) {
+        visit(handle_fn, e, m::tag<ast::ConstPreOrderExprVisitor>());
+    };
+
+    auto &SELECT = as<const ast::SelectClause>(*stmt.select);
+    for (auto &e : SELECT.expanded_select_all)
+        collect_expr(*e);
+    for (auto &s : SELECT.select)
+        collect_expr(*s.first);
+
+    if (stmt.from) {
+        for (auto &tbl : as<const ast::FromClause>(*stmt.from).from) {
+            if (auto nested = std::get_if<ast::Stmt*>(&tbl.source))
+                collect(as<const ast::SelectStmt>(**nested), accessed);
+            else if (tbl.has_table())
+                accessed[&tbl.table()].resize(tbl.table().num_attrs(), false); // accessed even if no attribute is used
+        }
+    }
+    if (stmt.where)
+        collect_expr(*as<const ast::WhereClause>(*stmt.where).where);
+    if (stmt.group_by) {
+        for (auto &[grp, alias] : as<const ast::GroupByClause>(*stmt.group_by).group_by)
+            collect_expr(*grp);
+    }
+    if (stmt.having)
+        collect_expr(*as<const ast::HavingClause>(*stmt.having).having);
+    if (stmt.order_by) {
+        for (auto &o : as<const ast::OrderByClause>(*stmt.order_by).order_by)
+            collect_expr(*o.first);
+    }
+}
+
+void LayoutAdvisor::record(const ast::SelectStmt &stmt)
+{
+    std::unordered_map<const Table*, std::vector<bool>> accessed;
+    collect(stmt, accessed);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &[table, bitmap] : accessed) {
+        auto &workload = tables_[table->name()];
+        ++workload.num_queries;
+        ++workload.attribute_sets[bitmap];
+    }
+}
+
+LayoutAdvisor::Advice LayoutAdvisor::advise(const Table &table) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return advise_unlocked(table);
+}
+
+LayoutAdvisor::Advice LayoutAdvisor::advise_unlocked(const Table &table) const
+{
+    Catalog &C = Catalog::Get();
+    Advice advice;
+
+    auto it = tables_.find(table.name());
+    if (it == tables_.end() or it->second.num_queries == 0)
+        return advice;
+    auto &workload = it->second;
+
+    const std::size_t num_attrs = table.num_attrs();
+    std::vector<std::size_t> bits(num_attrs);
+    std::size_t row_bits = 0;
+    for (std::size_t id = 0; id != num_attrs; ++id) {
+        bits[id] = table[id].type->size();
+        row_bits += bits[id];
+    }
+
+    /* Group the attributes by the attribute sets containing them.  Attributes in the same group are always accessed
+     * together and hence form a vertical partition. */
+    std::map<std::vector<bool>, std::vector<std::size_t>> groups;
+    for (std::size_t id = 0; id != num_attrs; ++id) {
+        std::vector<bool> signature;
+        signature.reserve(workload.attribute_sets.size());
+        for (auto &[set, _] : workload.attribute_sets)
+            signature.push_back(id < set.size() and set[id]);
+        groups[std::move(signature)].push_back(id);
+    }
+
+    /* Estimate the bits loaded per tuple, averaged over all recorded queries.  A row layout loads entire tuples.  A PAX
+     * layout loads only the accessed attributes but each from a separate memory region, a vertically partitioned
+     * layout loads only the accessed partitions. */
+    for (auto &[set, count] : workload.attribute_sets) {
+        advice.cost_row += count * double(row_bits);
+        for (std::size_t id = 0; id != std::min(set.size(), num_attrs); ++id) {
+            if (set[id])
+                advice.cost_pax += count * (bits[id] + BITS_PER_PARTITION);
+        }
+    }
+    std::size_t idx = 0;
+    for (auto &[set, count] : workload.attribute_sets) {
+        for (auto &[signature, ids] : groups) {
+            if (not signature[idx]) continue;
+            std::size_t partition_bits = 0;
+            for (auto id : ids)
+                partition_bits += bits[id];
+            advice.cost_partitioned += count * (partition_bits + BITS_PER_PARTITION);
+        }
+        ++idx;
+    }
+    advice.cost_row /= workload.num_queries;
+    advice.cost_pax /= workload.num_queries;
+    advice.cost_partitioned /= workload.num_queries;
+
+    /* Recommend the cheaper of the registered row and PAX layouts.  Report the vertical partitions if they promise an
+     * improvement over both, i.e. if there are attributes that are always accessed together. */
+    advice.layout = advice.cost_row <= advice.cost_pax ? C.pool("Row") : C.pool("PAX4M");
+    if (groups.size() > 1 and groups.size() < num_attrs and
+        advice.cost_partitioned < std::min(advice.cost_row, advice.cost_pax))
+    {
+        for (auto &[_, ids] : groups)
+            advice.partitions.push_back(ids);
+    }
+    return advice;
+}
+
+void LayoutAdvisor::report_changes(const ast::SelectStmt &stmt, std::ostream &out)
+{
+    std::unordered_map<const Table*, std::vector<bool>> accessed;
+    collect(stmt, accessed);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &[table, _] : accessed) {
+        auto advice = advise_unlocked(*table);
+        auto &last_advice = tables_[table->name()].last_advice;
+        if (not advice.layout.has_value() or advice.layout == last_advice)
+            continue;
+        last_advice = advice.layout;
+
+        out << "Layout advice for table `" << table->name() << "`: " << *advice.layout
+            << " (estimated bits per tuple and query: row " << advice.cost_row
+            << ", PAX " << advice.cost_pax
+            << ", partitioned " << advice.cost_partitioned << ")";
+        if (not advice.partitions.empty()) {
+            out << ", vertical partitions";
+            for (auto &partition : advice.partitions) {
+                out << " {";
+                for (auto it = partition.begin(); it != partition.end(); ++it) {
+                    if (it != partition.begin()) out << ", ";
+                    out << (*table)[*it].name;
+                }
+                out << '}';
+            }
+        }
+        out << '\n';
+    }
+}
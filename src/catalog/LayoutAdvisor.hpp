@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/parse/AST.hpp>
+#include <mutable/util/Pool.hpp>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+namespace m {
+
+/** Records which attributes of which tables the queries of the workload access and recommends a data layout per table
+ * based on the recorded workload.  The recommendation compares the estimated number of bits loaded per tuple when
+ * storing the table in row-major order, in column-major order within large blocks, i.e. a PAX layout, or vertically
+ * partitioned such that attributes always accessed together are stored together.
+ *
+ * Since queries of different transactions may be executed concurrently, all methods are thread-safe. */
+struct LayoutAdvisor
+{
+    /** The advice for a single table. */
+    struct Advice
+    {
+        ///> the name of the registered data layout recommended for the table; none if no query accessed the table
+        ThreadSafePooledOptionalString layout;
+        ///> the estimated number of bits loaded per tuple on average per recorded query when using a row layout
+        double cost_row = 0;
+        ///> the estimated number of bits loaded per tuple on average per recorded query when using a PAX layout
+        double cost_pax = 0;
+        ///> the estimated number of bits loaded per tuple on average per recorded query when vertically partitioned
+        double cost_partitioned = 0;
+        ///> the vertical partitions, i.e. attribute IDs accessed by exactly the same queries; empty if not beneficial
+        std::vector<std::vector<std::size_t>> partitions;
+    };
+
+    ///> the estimated overhead in bits per tuple for each additional attribute loaded from a separate memory region
+    static constexpr double BITS_PER_PARTITION = 8;
+
+    private:
+    /** The workload recorded for a single table. */
+    struct TableWorkload
+    {
+        std::size_t num_queries = 0; ///< the number of queries accessing the table
+        ///> the distinct sets of accessed attributes, as bitmaps over attribute IDs, and their number of queries
+        std::unordered_map<std::vector<bool>, std::size_t> attribute_sets;
+        ThreadSafePooledOptionalString last_advice; ///< the name of the most recently recommended data layout
+    };
+
+    std::unordered_map<ThreadSafePooledString, TableWorkload> tables_; ///< the workload recorded per table
+    mutable std::mutex mutex_; ///< protects `tables_`
+
+    LayoutAdvisor() = default;
+
+    public:
+    static LayoutAdvisor & Get();
+
+    /** Records the attributes accessed by \p stmt, including those accessed by nested queries. */
+    void record(const ast::SelectStmt &stmt);
+
+    /** Recommends a data layout for \p table based on the recorded workload.  Recommends no data layout if no query
+     * accessing \p table was recorded. */
+    Advice advise(const Table &table) const;
+
+    /** Writes the advice for each table accessed by \p stmt to \p out if the advice differs from the previous advice
+     * for that table. */
+    void report_changes(const ast::SelectStmt &stmt, std::ostream &out);
+
+    /** Discards the recorded workload. */
+    void clear() { std::lock_guard<std::mutex> lock(mutex_); tables_.clear(); }
+
+    private:
+    /** Collects the attributes accessed by \p stmt per table into \p accessed. */
+    static void collect(const ast::SelectStmt &stmt,
+                        std::unordered_map<const Table*, std::vector<bool>> &accessed);
+    Advice advise_unlocked(const Table &table) const;
+};
+
+/** Returns `true` iff the workload should be recorded to advise data layouts. */
+bool advise_layouts();
+
+}
@@ -0,0 +1,200 @@
+#include "catalog/Maintenance.hpp"
+
+#include "catalog/CommandBatches.hpp"
+#include "parse/ASTPrinter.hpp"
+#include "util/WorkerPool.hpp"
+#include <algorithm>
+#include <memory>
+#include <mutable/catalog/Catalog.hpp>
+#include <sstream>
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** Whether stale tables are refreshed in the background. */
+bool background_maintenance = false;
+/** The fraction of modified rows of a table at which it is refreshed. */
+double threshold = 0.1;
+/** The minimal number of modified rows of a table at which it is refreshed. */
+std::size_t min_rows = 10'000;
+/** The time in milliseconds without executed commands after which stale tables are refreshed. */
+unsigned idle_time = 100;
+/** The time in milliseconds between two checks for stale tables. */
+unsigned interval = 1000;
+
+}
+
+__attribute__((constructor(201)))
+static void add_maintenance_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<bool>(
+        /* group=       */ "Maintenance",
+        /* short=       */ nullptr,
+        /* long=        */ "--background-maintenance",
+        /* description= */ "vacuum tables modified by writes and refresh their statistics, zone maps, and indexes "
+                           "in the background",
+        /* callback=    */ [](bool b){ options::background_maintenance = b; }
+    );
+    C.arg_parser().add<double>(
+        /* group=       */ "Maintenance",
+        /* short=       */ nullptr,
+        /* long=        */ "--maintenance-threshold",
+        /* description= */ "the fraction of modified rows of a table at which it is refreshed in the background",
+        /* callback=    */ [](double threshold){ options::threshold = std::max(threshold, 0.); }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Maintenance",
+        /* short=       */ nullptr,
+        /* long=        */ "--maintenance-min-rows",
+        /* description= */ "the minimal number of modified rows of a table at which it is refreshed in the background",
+        /* callback=    */ [](std::size_t n){ options::min_rows = std::max<std::size_t>(n, 1); }
+    );
+    C.arg_parser().add<unsigned>(
+        /* group=       */ "Maintenance",
+        /* short=       */ nullptr,
+        /* long=        */ "--maintenance-idle-time",
+        /* description= */ "the time in milliseconds without executed commands after which tables are refreshed in "
+                           "the background",
+        /* callback=    */ [](unsigned t){ options::idle_time = t; }
+    );
+    C.arg_parser().add<unsigned>(
+        /* group=       */ "Maintenance",
+        /* short=       */ nullptr,
+        /* long=        */ "--maintenance-interval",
+        /* description= */ "the time in milliseconds between two checks for tables to refresh in the background",
+        /* callback=    */ [](unsigned t){ options::interval = std::max(t, 1U); }
+    );
+}
+
+}
+
+Maintenance::Maintenance()
+{
+    /* The daemon submits refreshes as command batches.  Construct them first, such that they are destroyed after the
+     * daemon terminated. */
+    CommandBatches::Get();
+}
+
+Maintenance::~Maintenance()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    stopped_.notify_one();
+    if (daemon_.joinable())
+        daemon_.join();
+}
+
+Maintenance & Maintenance::Get()
+{
+    static Maintenance the_maintenance;
+    return the_maintenance;
+}
+
+bool Maintenance::enabled() { return options::background_maintenance; }
+
+void Maintenance::rows_modified(const ThreadSafePooledString &database_name, const Table &table,
+                                std::size_t num_rows)
+{
+    if (num_rows == 0) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    tables_[database_name][table.name()].num_modified += num_rows;
+    if (enabled() and not daemon_.joinable())
+        daemon_ = std::thread(&Maintenance::daemon_loop, this);
+}
+
+void Maintenance::refreshed(const ThreadSafePooledString &database_name, const Table &table)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &state = tables_[database_name][table.name()];
+    state.num_rows = table.store().num_rows();
+    state.num_modified = 0;
+}
+
+void Maintenance::index_created(const ThreadSafePooledString &database_name, const ThreadSafePooledString &table_name,
+                                const ThreadSafePooledString &index_name, const ast::Command &command)
+{
+    std::ostringstream sql;
+    ast::ASTPrinter print(sql);
+    print(command);
+    std::string text = sql.str();
+    if (text.empty() or text.back() != ';')
+        text += ';';
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    indexes_[database_name][index_name] = { table_name, std::move(text) };
+}
+
+void Maintenance::table_dropped(const ThreadSafePooledString &database_name, const ThreadSafePooledString &table_name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto it = tables_.find(database_name); it != tables_.end())
+        it->second.erase(table_name);
+    if (auto it = indexes_.find(database_name); it != indexes_.end())
+        std::erase_if(it->second, [&table_name](auto &entry) { return entry.second.table_name == table_name; });
+}
+
+std::vector<std::pair<ThreadSafePooledString, std::string>>
+Maintenance::indexes(const ThreadSafePooledString &database_name, const ThreadSafePooledString &table_name) const
+{
+    std::vector<std::pair<ThreadSafePooledString, std::string>> indexes;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto it = indexes_.find(database_name); it != indexes_.end()) {
+        for (auto &[index_name, definition] : it->second) {
+            if (definition.table_name == table_name)
+                indexes.emplace_back(index_name, definition.sql);
+        }
+    }
+    return indexes;
+}
+
+void Maintenance::daemon_loop()
+{
+    WorkerPool::Pin_To_Reserved_CPUs();
+    Catalog &C = Catalog::Get();
+    std::shared_ptr<const CommandBatches::Batch> refresh; ///< the refresh in progress, if any
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (not stopped_.wait_for(lock, std::chrono::milliseconds(options::interval), [this]() { return stop_; })) {
+        if (refresh and not refresh->done())
+            continue; // refresh one table at a time
+        refresh.reset();
+
+        /*----- Defer to foreground commands. -----*/
+        const clock::time_point last_activity{clock::duration(last_activity_.load())};
+        if (num_active_commands_ != 0 or clock::now() - last_activity < std::chrono::milliseconds(options::idle_time))
+            continue;
+
+        /*----- Refresh the table of the database in use with the most modified rows beyond the threshold. -----*/
+        if (not C.has_database_in_use())
+            continue;
+        auto db_it = tables_.find(C.get_database_in_use().name);
+        if (db_it == tables_.end())
+            continue;
+        table_state *stale = nullptr;
+        const ThreadSafePooledString *stale_name = nullptr;
+        for (auto &[table_name, state] : db_it->second) {
+            const std::size_t threshold = std::max<std::size_t>(options::min_rows, options::threshold * state.num_rows);
+            if (state.num_modified >= threshold and (not stale or state.num_modified > stale->num_modified)) {
+                stale = &state;
+                stale_name = &table_name;
+            }
+        }
+        if (not stale)
+            continue;
+        stale->num_modified = 0; // do not retry a failing refresh before further modifications
+        std::vector<std::string> statements{ "\\refresh_table " + std::string(**stale_name) + ";" };
+
+        lock.unlock();
+        refresh = CommandBatches::Get().submit(std::move(statements));
+        lock.lock();
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/util/Pool.hpp>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace m {
+
+namespace ast { struct Command; }
+
+/** Refreshes the derived state of tables that went stale by writes, see `\refresh_table`: the statistics of analyzed
+ * tables, see `ColumnStatistics`, the zone maps of PAX stores, whose synopses are invalidated when rows are
+ * overwritten, and the indexes, which are invalidated when rows are overwritten or removed and are rebuilt from the
+ * `CREATE INDEX` statements that created them.  Indexes, SPNs, and column sketches are already maintained
+ * incrementally when rows are appended.  A
+ * refresh first *vacuums* a multi-versioned table, i.e. removes the versions deleted by `DELETE` and `UPDATE` that no
+ * active transaction sees anymore, see `Compaction`.
+ *
+ * With `--background-maintenance`, a daemon thread counts the rows appended and overwritten per table and refreshes a
+ * table once its modified rows exceed `--maintenance-threshold` of its rows at the last refresh, and at least
+ * `--maintenance-min-rows`.  To not delay foreground queries, the daemon refreshes at most one table at a time and only
+ * after no command was executed for `--maintenance-idle-time`.  The refresh is submitted as `CommandBatches`, such that
+ * it is serialized with writes by the scheduler.  Only tables of the database in use are refreshed. */
+struct Maintenance
+{
+    using clock = std::chrono::steady_clock;
+
+    private:
+    /** The modifications of a table since its last refresh. */
+    struct table_state
+    {
+        std::size_t num_rows = 0; ///< the number of rows of the table at its last refresh
+        std::size_t num_modified = 0; ///< the number of rows appended or overwritten since its last refresh
+    };
+
+    /** An index and the statement that created it. */
+    struct index_definition
+    {
+        ThreadSafePooledString table_name;
+        std::string sql; ///< the `CREATE INDEX` statement
+    };
+
+    ///> the modifications of the tables, by database name and table name
+    std::unordered_map<ThreadSafePooledString, std::unordered_map<ThreadSafePooledString, table_state>> tables_;
+    ///> the definitions of the indexes, by database name and index name
+    std::unordered_map<ThreadSafePooledString, std::unordered_map<ThreadSafePooledString, index_definition>> indexes_;
+    std::atomic<std::size_t> num_active_commands_ = 0; ///< the number of commands currently executed
+    std::atomic<clock::rep> last_activity_ = 0; ///< the time the last command finished, since the epoch of `clock`
+    bool stop_ = false; ///< whether the daemon thread shall terminate
+    std::thread daemon_;
+    mutable std::mutex mutex_;
+    std::condition_variable stopped_; ///< signals the daemon thread to terminate
+
+    Maintenance();
+    ~Maintenance();
+
+    public:
+    static Maintenance & Get();
+
+    /** Returns `true` iff stale tables are refreshed in the background, see `--background-maintenance`. */
+    static bool enabled();
+
+    /** Records that \p num_rows rows of \p table of the database \p database_name were appended or overwritten.  Starts
+     * the daemon thread on the first modification, if `enabled()`. */
+    void rows_modified(const ThreadSafePooledString &database_name, const Table &table, std::size_t num_rows);
+    /** Records that \p table of the database \p database_name was refreshed. */
+    void refreshed(const ThreadSafePooledString &database_name, const Table &table);
+
+    /** Records that the index \p index_name on table \p table_name of the database \p database_name was created by the
+     * statement \p command. */
+    void index_created(const ThreadSafePooledString &database_name, const ThreadSafePooledString &table_name,
+                       const ThreadSafePooledString &index_name, const ast::Command &command);
+    /** Records that the index \p index_name of the database \p database_name was dropped. */
+    void index_dropped(const ThreadSafePooledString &database_name, const ThreadSafePooledString &index_name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto it = indexes_.find(database_name); it != indexes_.end())
+            it->second.erase(index_name);
+    }
+    /** Records that the table \p table_name of the database \p database_name was dropped. */
+    void table_dropped(const ThreadSafePooledString &database_name, const ThreadSafePooledString &table_name);
+    /** Records that the database \p database_name was dropped. */
+    void database_dropped(const ThreadSafePooledString &database_name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tables_.erase(database_name);
+        indexes_.erase(database_name);
+    }
+
+    /** Returns the names and `CREATE INDEX` statements of the indexes on table \p table_name of the database \p
+     * database_name. */
+    std::vector<std::pair<ThreadSafePooledString, std::string>>
+    indexes(const ThreadSafePooledString &database_name, const ThreadSafePooledString &table_name) const;
+
+    /** Records that the scheduler started executing a command. */
+    void command_started() { ++num_active_commands_; }
+    /** Records that the scheduler finished executing a command. */
+    void command_finished() {
+        last_activity_ = clock::now().time_since_epoch().count();
+        --num_active_commands_;
+    }
+
+    private:
+    /** Refreshes stale tables until `stop_` is set. */
+    void daemon_loop();
+};
+
+}
@@ -0,0 +1,287 @@
+#include "catalog/MaterializedViews.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "catalog/ResultCache.hpp"
+#include "storage/PaxStore.hpp"
+#include <algorithm>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/storage/Store.hpp>
+#include <stdexcept>
+
+
+using namespace m;
+
+
+/*======================================================================================================================
+ * MaterializedView
+ *====================================================================================================================*/
+
+MaterializedView::MaterializedView(Database &DB, ThreadSafePooledString name, std::unique_ptr<ast::SelectStmt> stmt)
+    : DB_(DB)
+    , stmt_(std::move(stmt))
+{
+    auto &C = Catalog::Get();
+    graph_ = QueryGraph::Build(*stmt_);
+
+    /*----- Check whether the query is supported. -----*/
+    if (graph_->sources().size() != 1 or not is<const BaseTable>(graph_->sources()[0].get()))
+        throw invalid_argument("the query of a materialized view must read exactly one table");
+    if (graph_->group_by().empty() and graph_->aggregates().empty())
+        throw invalid_argument("the query of a materialized view must group or aggregate");
+    if (stmt_->having or not graph_->order_by().empty() or graph_->limit().limit or graph_->limit().offset)
+        throw invalid_argument("HAVING, ORDER BY, and LIMIT are not supported in materialized views");
+    if (graph_->projections().empty())
+        throw invalid_argument("the query of a materialized view must not select *");
+    for (auto agg : graph_->aggregates()) {
+        switch (agg.get().get_function().fnid) {
+            default:
+                throw invalid_argument("only COUNT, SUM, AVG, MIN, and MAX are supported in materialized views");
+            case Function::FN_COUNT:
+            case Function::FN_SUM:
+            case Function::FN_AVG:
+            case Function::FN_MIN:
+            case Function::FN_MAX:
+                break;
+        }
+    }
+
+    auto &bt = as<const BaseTable>(*graph_->sources()[0]);
+    base_ = &bt.table();
+    alias_ = bt.name();
+    scan_schema_ = base_->schema(alias_);
+
+    /*----- Compile the filter. -----*/
+    if (not bt.filter().empty()) {
+        filter_.emplace(scan_schema_);
+        filter_->emit(bt.filter(), 1);
+        filter_->emit_St_Tup_b(0, 0);
+        filter_result_ = Tuple({ Type::Get_Boolean(Type::TY_Vector) });
+    }
+
+    /*----- Compile the computation of the key and of the arguments of the aggregates, see `GroupingData`. -----*/
+    grouping_ = std::make_unique<GroupingOperator>(graph_->group_by(), graph_->aggregates());
+    const std::size_t key_size = graph_->group_by().size();
+    groups_ = decltype(groups_)(1024, hasher(key_size), equals(key_size));
+
+    compute_key_.emplace(scan_schema_);
+    std::size_t key_idx = 0;
+    for (auto [grp, alias] : graph_->group_by()) {
+        compute_key_->emit(grp.get(), 1);
+        compute_key_->emit_St_Tup(0, key_idx++, grp.get().type());
+        compute_key_->emit_Pop();
+    }
+
+    for (auto agg : graph_->aggregates()) {
+        auto &fe = agg.get();
+        StackMachine &sm = compute_arguments_.emplace_back(scan_schema_);
+        std::size_t arg_idx = 0;
+        std::vector<const Type*> arg_types;
+        for (auto &arg : fe.args) {
+            sm.emit(*arg, 1);
+            sm.emit_Cast(fe.type(), arg->type()); // cast argument type to aggregate type, e.g. f32 to f64 for SUM
+            sm.emit_St_Tup(0, arg_idx++, arg->type());
+            sm.emit_Pop();
+            arg_types.push_back(arg->type());
+        }
+        arguments_.emplace_back(std::move(arg_types));
+    }
+
+    /*----- Compile the projections computing a row of the view from a group. -----*/
+    project_.emplace(grouping_->schema());
+    std::size_t out_idx = 0;
+    for (auto &[proj, alias] : graph_->projections()) {
+        project_->emit(proj.get(), 1);
+        project_->emit_St_Tup(0, out_idx++, proj.get().type());
+        project_->emit_Pop();
+    }
+
+    reset_groups();
+
+    /*----- Create the table storing the view. -----*/
+    ProjectionOperator projection(graph_->projections());
+    table_ = &DB.add_table(std::move(name));
+    for (auto &e : projection.schema())
+        table_->push_back(e.id.name, as<const PrimitiveType>(e.type)->as_vectorial());
+    table_->layout(C.data_layout());
+    table_->store(C.create_store(*table_));
+
+    refresh();
+}
+
+void MaterializedView::refresh()
+{
+    auto &store = base_->store();
+    auto &view_store = table_->store();
+    const std::size_t num_rows = store.num_rows();
+    const std::size_t key_size = graph_->group_by().size();
+    auto &aggregates = graph_->aggregates();
+
+    /*----- Add the appended rows to their groups and find the first row of the view to rewrite. -----*/
+    std::size_t first_dirty_row = std::min(rows_.size(), view_store.num_rows());
+    if (num_rows_seen_ < num_rows) {
+        auto loader = Interpreter::compile_load(scan_schema_, store.memory().addr(), base_->layout(), scan_schema_,
+                                                num_rows_seen_);
+        Tuple row(scan_schema_);
+        Tuple key(grouping_->schema());
+        for (std::size_t i = num_rows_seen_; i != num_rows; ++i) {
+            Tuple *load_args[] = { &row };
+            loader(load_args);
+
+            if (filter_) {
+                Tuple *args[] = { &filter_result_, &row };
+                (*filter_)(args);
+                if (filter_result_.is_null(0) or not filter_result_[0].as_b()) continue;
+            }
+
+            Tuple *key_args[] = { &key, &row };
+            (*compute_key_)(key_args);
+            auto it = groups_.find(key);
+            if (it == groups_.end()) {
+                it = groups_.emplace_hint(it, std::move(key), group_info{ .row = rows_.size() });
+                rows_.push_back(&it->first);
+                key = Tuple(grouping_->schema());
+            }
+            first_dirty_row = std::min(first_dirty_row, it->second.row);
+
+            Tuple &group = const_cast<Tuple&>(it->first); // the key of the group is not modified
+            const std::size_t nth_tuple = ++it->second.num_tuples;
+            for (std::size_t j = 0; j != aggregates.size(); ++j) {
+                Tuple *args[] = { &arguments_[j], &row };
+                compute_arguments_[j](args);
+                Interpreter::update_aggregate(aggregates[j].get(), group, key_size + j, arguments_[j], nth_tuple);
+            }
+        }
+        num_rows_seen_ = num_rows;
+    }
+
+    if (first_dirty_row == rows_.size() and view_store.num_rows() == rows_.size())
+        return; // nothing changed
+
+    /*----- Rewrite the rows of the view starting at the first changed group. -----*/
+    while (view_store.num_rows() > first_dirty_row)
+        view_store.drop();
+    StoreWriter W(view_store);
+    Tuple tup(W.schema());
+    for (std::size_t r = first_dirty_row; r != rows_.size(); ++r) {
+        Tuple *args[] = { &tup, const_cast<Tuple*>(rows_[r]) };
+        (*project_)(args);
+        W.append(tup);
+    }
+
+    if (auto pax = cast<const PaxStore>(&view_store))
+        pax->update_synopses();
+    DB_.invalidate_indexes(table_->name());
+    ResultCache::Get().invalidate(*table_);
+}
+
+void MaterializedView::recompute()
+{
+    reset_groups();
+    num_rows_seen_ = 0;
+    auto &view_store = table_->store();
+    while (view_store.num_rows()) // rewrite all rows, even if no row of the base table is left to aggregate
+        view_store.drop();
+    refresh();
+}
+
+void MaterializedView::reset_groups()
+{
+    rows_.clear();
+    groups_.clear();
+
+    /*----- Without grouping, the view has exactly one row, even if no row is aggregated. -----*/
+    if (graph_->group_by().empty()) {
+        Tuple group(grouping_->schema());
+        for (std::size_t i = 0; i != graph_->aggregates().size(); ++i) {
+            if (graph_->aggregates()[i].get().get_function().fnid == Function::FN_COUNT)
+                group.set(i, int64_t(0));
+        }
+        auto it = groups_.emplace(std::move(group), group_info{ .row = 0 }).first;
+        rows_.push_back(&it->first);
+    }
+}
+
+
+/*======================================================================================================================
+ * MaterializedViews
+ *====================================================================================================================*/
+
+MaterializedViews & MaterializedViews::Get()
+{
+    static MaterializedViews the_views;
+    return the_views;
+}
+
+const MaterializedView & MaterializedViews::create(Database &DB, ThreadSafePooledString name,
+                                                   std::unique_ptr<ast::SelectStmt> stmt)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &views = views_[DB.name];
+    auto view = std::make_unique<MaterializedView>(DB, name, std::move(stmt));
+    for (auto &[_, other] : views) {
+        if (&view->base() == &other->table()) {
+            /* A view is rewritten rather than appended to, hence views of views cannot be maintained. */
+            DB.drop_table(name);
+            throw invalid_argument("materialized views of materialized views are not supported");
+        }
+    }
+    return *views.emplace(std::move(name), std::move(view)).first->second;
+}
+
+bool MaterializedViews::drop(Database &DB, const ThreadSafePooledString &name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto db_it = views_.find(DB.name);
+    if (db_it == views_.end() or not db_it->second.erase(name))
+        return false;
+    DB.drop_table(name);
+    ResultCache::Get().clear();
+    return true;
+}
+
+bool MaterializedViews::contains(const ThreadSafePooledString &database_name, const ThreadSafePooledString &name) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto db_it = views_.find(database_name);
+    return db_it != views_.end() and db_it->second.contains(name);
+}
+
+void MaterializedViews::rows_appended(const ThreadSafePooledString &database_name, const Table &table)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto db_it = views_.find(database_name);
+    if (db_it == views_.end()) return;
+    for (auto &[_, view] : db_it->second) {
+        if (&view->base() == &table)
+            M_TIME_EXPR(view->refresh(), "Refresh materialized view", Catalog::Get().timer());
+    }
+}
+
+void MaterializedViews::rows_deleted(const ThreadSafePooledString &database_name, const Table &table)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto db_it = views_.find(database_name);
+    if (db_it == views_.end()) return;
+    for (auto &[_, view] : db_it->second) {
+        if (&view->base() == &table)
+            M_TIME_EXPR(view->recompute(), "Recompute materialized view", Catalog::Get().timer());
+    }
+}
+
+void MaterializedViews::table_dropped(const ThreadSafePooledString &database_name,
+                                      const ThreadSafePooledString &table_name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto db_it = views_.find(database_name);
+    if (db_it == views_.end()) return;
+    std::erase_if(db_it->second, [&](auto &entry) {
+        return entry.second->base().name() == table_name or entry.second->table().name() == table_name;
+    });
+}
+
+void MaterializedViews::database_dropped(const ThreadSafePooledString &database_name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    views_.erase(database_name);
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "backend/StackMachine.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/Operator.hpp>
+#include <mutable/IR/QueryGraph.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/parse/AST.hpp>
+#include <mutable/util/Pool.hpp>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+
+namespace m {
+
+/** A materialized view of a query that groups and aggregates the rows of a single table, e.g. `SELECT c, SUM(x) FROM
+ * T WHERE ... GROUP BY c`.  The result of the query is stored in a table of the name of the view, from which the view
+ * is read like any other table.
+ *
+ * The view keeps the state of the grouping, i.e. the groups with their partial aggregates, in a hash table.  As rows
+ * are appended to the base table, the view is maintained incrementally: the appended rows are filtered and added to their
+ * groups, exactly like the `Interpreter` computes a `GroupingOperator`.  The cost of maintenance is hence proportional
+ * to the number of appended rows rather than to the size of the table.  The rows of the view are stored in the order
+ * in which their groups were created.  Only the rows starting at the first one whose group changed are rewritten,
+ * which amounts to appending rows if the appended rows only create new groups.  When rows of the base table are
+ * deleted or updated, the view is computed anew.
+ *
+ * Supported aggregates are `COUNT`, `SUM`, `AVG`, `MIN`, and `MAX`.  `HAVING`, `ORDER BY`, and `LIMIT` are not
+ * supported. */
+struct MaterializedView
+{
+    private:
+    /** Computes the hash of the key of a group. */
+    struct hasher
+    {
+        std::size_t key_size;
+
+        hasher(std::size_t key_size = 0) : key_size(key_size) { }
+
+        uint64_t operator()(const Tuple &tup) const {
+            std::hash<Value> h;
+            uint64_t hash = 0xcbf29ce484222325;
+            for (std::size_t i = 0; i != key_size; ++i) {
+                hash ^= tup.is_null(i) ? 0 : h(tup[i]);
+                hash *= 1099511628211;
+            }
+            return hash;
+        }
+    };
+
+    /** Compares two groups by their keys. */
+    struct equals
+    {
+        std::size_t key_size;
+
+        equals(std::size_t key_size = 0) : key_size(key_size) { }
+
+        bool operator()(const Tuple &first, const Tuple &second) const {
+            for (std::size_t i = 0; i != key_size; ++i) {
+                if (first.is_null(i) != second.is_null(i)) return false;
+                if (not first.is_null(i))
+                    if (first.get(i) != second.get(i)) return false;
+            }
+            return true;
+        }
+    };
+
+    struct group_info
+    {
+        std::size_t num_tuples = 0; ///< the number of tuples added to the group
+        std::size_t row; ///< the row of the group in the store of the view
+    };
+
+    Database &DB_;
+    const Table *base_ = nullptr; ///< the table the view is computed from
+    Table *table_ = nullptr; ///< the table storing the view
+    ThreadSafePooledString alias_; ///< the name of `base_` within the query
+    std::unique_ptr<ast::SelectStmt> stmt_; ///< the query of the view, referenced by `graph_`
+    std::unique_ptr<QueryGraph> graph_;
+    std::unique_ptr<GroupingOperator> grouping_; ///< computes the schema of the groups
+    Schema scan_schema_; ///< the schema of the rows of `base_` within the query
+
+    std::optional<StackMachine> filter_; ///< evaluates the filter of the query on a row of `base_`
+    Tuple filter_result_;
+    std::optional<StackMachine> compute_key_; ///< computes the key of the group of a row of `base_`
+    std::vector<StackMachine> compute_arguments_; ///< compute the arguments of each aggregate
+    std::vector<Tuple> arguments_;
+    std::optional<StackMachine> project_; ///< computes a row of the view from a group
+
+    ///> the groups with their aggregates
+    std::unordered_map<Tuple, group_info, hasher, equals> groups_;
+    ///> the groups in the order of their rows in the store of the view
+    std::vector<const Tuple*> rows_;
+    std::size_t num_rows_seen_ = 0; ///< the number of rows of `base_` added to the groups
+
+    public:
+    /** Creates the view \p name of query \p stmt in database \p DB, including the table storing the view, and
+     * computes its rows.  Throws `m::invalid_argument` if the query is not supported and `std::invalid_argument` if a
+     * table \p name already exists. */
+    MaterializedView(Database &DB, ThreadSafePooledString name, std::unique_ptr<ast::SelectStmt> stmt);
+    MaterializedView(const MaterializedView&) = delete;
+
+    const Table & base() const { return *base_; }
+    const Table & table() const { return *table_; }
+    const ast::SelectStmt & stmt() const { return *stmt_; }
+    std::size_t num_groups() const { return rows_.size(); }
+
+    /** Adds the rows appended to the base table since the last refresh to the view. */
+    void refresh();
+    /** Computes the view anew from all rows of the base table, e.g. after rows were deleted from it. */
+    void recompute();
+
+    private:
+    /** Discards all groups.  Without grouping, creates the single group aggregating no row. */
+    void reset_groups();
+};
+
+/** Holds the materialized views of all databases and maintains them when rows are appended to their base tables. */
+struct MaterializedViews
+{
+    private:
+    ///> the views by database name and view name
+    std::unordered_map<ThreadSafePooledString,
+                       std::unordered_map<ThreadSafePooledString, std::unique_ptr<MaterializedView>>> views_;
+    mutable std::mutex mutex_;
+
+    MaterializedViews() = default;
+
+    public:
+    static MaterializedViews & Get();
+
+    /** Creates the view \p name of query \p stmt in database \p DB, see `MaterializedView::MaterializedView()`. */
+    const MaterializedView & create(Database &DB, ThreadSafePooledString name, std::unique_ptr<ast::SelectStmt> stmt);
+    /** Drops the view \p name of database \p DB and the table storing it.  Returns `false` if there is no such view. */
+    bool drop(Database &DB, const ThreadSafePooledString &name);
+
+    /** Returns `true` iff there is a view \p name in database \p database_name. */
+    bool contains(const ThreadSafePooledString &database_name, const ThreadSafePooledString &name) const;
+
+    /** Adds the rows appended to \p table of database \p database_name to all views of \p table. */
+    void rows_appended(const ThreadSafePooledString &database_name, const Table &table);
+    /** Computes all views of \p table of database \p database_name anew after rows of \p table were deleted or
+     * modified.  Since aggregates like `MIN` cannot be maintained under deletions, the views are not maintained
+     * incrementally. */
+    void rows_deleted(const ThreadSafePooledString &database_name, const Table &table);
+
+    /** Discards the views of database \p database_name that read or store table \p table_name, which is about to be
+     * dropped.  The tables storing the discarded views are retained. */
+    void table_dropped(const ThreadSafePooledString &database_name, const ThreadSafePooledString &table_name);
+    /** Discards all views of database \p database_name, which is about to be dropped. */
+    void database_dropped(const ThreadSafePooledString &database_name);
+};
+
+}
@@ -0,0 +1,112 @@
+#include "catalog/NullFreeColumns.hpp"
+
+#include "backend/Interpreter.hpp"
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <vector>
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** Whether to track the columns that contain no NULL. */
+bool null_tracking = true;
+
+}
+
+__attribute__((constructor(201)))
+static void add_null_free_columns_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<bool>(
+        /* group=       */ "Catalog",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-null-tracking",
+        /* description= */ "do not track columns without NULL; always load the NULL bits of nullable columns",
+        /* callback=    */ [](bool){ options::null_tracking = false; }
+    );
+}
+
+}
+
+NullFreeColumns & NullFreeColumns::Get()
+{
+    static NullFreeColumns the_columns;
+    return the_columns;
+}
+
+bool NullFreeColumns::enabled() { return options::null_tracking; }
+
+NullFreeColumns::TableColumns & NullFreeColumns::update_unlocked(const ThreadSafePooledString &database_name,
+                                                                 const Table &table)
+{
+    auto &T = tables_[database_name][table.name()];
+    const std::size_t num_rows = table.store().num_rows();
+    if (T.store != &table.store() or num_rows < T.num_rows_seen) // the table was replaced, observe it anew
+        T = TableColumns{ .store = &table.store() };
+    if (num_rows == T.num_rows_seen)
+        return T;
+
+    /* Load only the nullable columns that contained no NULL so far. */
+    const Schema table_schema = table.schema();
+    Schema schema;
+    std::vector<bool*> has_nulls;
+    for (auto &e : table_schema) {
+        auto &has_null = T.has_nulls.try_emplace(e.id.name, false).first->second;
+        if (e.nullable() and not has_null) {
+            schema.add(e.id, e.type, e.constraints);
+            has_nulls.push_back(&has_null);
+        }
+    }
+
+    if (schema.num_entries()) {
+        auto loader = Interpreter::compile_load(schema, table.store().memory().addr(), table.layout(), table_schema,
+                                                T.num_rows_seen);
+        Tuple tuple(schema);
+        Tuple *args[] = { &tuple };
+        std::size_t num_null_free = schema.num_entries();
+        for (std::size_t row = T.num_rows_seen; row != num_rows and num_null_free; ++row) {
+            loader(args);
+            for (std::size_t idx = 0; idx != schema.num_entries(); ++idx) {
+                if (tuple.is_null(idx) and not *has_nulls[idx]) {
+                    *has_nulls[idx] = true;
+                    --num_null_free;
+                }
+            }
+        }
+    }
+    T.num_rows_seen = num_rows;
+    return T;
+}
+
+bool NullFreeColumns::null_free(const ThreadSafePooledString &database_name, const Table &table,
+                                const ThreadSafePooledString &attr)
+{
+    if (not enabled()) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &T = update_unlocked(database_name, table);
+    auto it = T.has_nulls.find(attr);
+    return it != T.has_nulls.end() and not it->second;
+}
+
+Schema NullFreeColumns::layout_schema(const ThreadSafePooledString &database_name, const Table &table,
+                                      const ThreadSafePooledOptionalString &alias)
+{
+    if (not enabled()) return table.schema(alias);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &T = update_unlocked(database_name, table);
+    Schema S;
+    for (auto &e : table.schema(alias)) {
+        auto constraints = e.constraints;
+        if (auto it = T.has_nulls.find(e.id.name); it != T.has_nulls.end() and not it->second)
+            constraints |= Schema::entry_type::NOT_NULLABLE;
+        S.add(e.id, e.type, constraints);
+    }
+    return S;
+}
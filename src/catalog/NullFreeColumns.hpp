@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/util/Pool.hpp>
+#include <mutex>
+#include <unordered_map>
+
+
+namespace m {
+
+/** Tracks which columns of the tables of all databases contain no NULL, although their attributes are nullable.  Most
+ * columns of fact tables never contain NULL, yet loads of nullable columns fetch and test their NULL bits.  Columns
+ * are observed lazily: before a column is reported NULL-free, the rows appended since the last observation are
+ * checked.  Since rows are only appended, a column containing NULL is never observed again.
+ *
+ * Scans load tuples with the layout schema of `layout_schema()`, in which NULL-free columns are not nullable, such
+ * that `Interpreter::compile_load()` and `compile_load_sequential()` omit the NULL bits of these columns entirely. */
+struct NullFreeColumns
+{
+    private:
+    struct TableColumns
+    {
+        const Store *store = nullptr; ///< the store observed; a different store is observed anew
+        std::size_t num_rows_seen = 0; ///< the number of rows of the table observed
+        ///> whether the column of an attribute, by name, contains NULL
+        std::unordered_map<ThreadSafePooledString, bool> has_nulls;
+    };
+
+    ///> the columns by database name and table name
+    std::unordered_map<ThreadSafePooledString, std::unordered_map<ThreadSafePooledString, TableColumns>> tables_;
+    mutable std::mutex mutex_;
+
+    NullFreeColumns() = default;
+
+    public:
+    static NullFreeColumns & Get();
+
+    /** Returns `true` iff NULL-free columns are tracked, see `--no-null-tracking`. */
+    static bool enabled();
+
+    /** Returns `true` iff the column of \p attr of \p table of the database \p database_name contains no NULL. */
+    bool null_free(const ThreadSafePooledString &database_name, const Table &table, const ThreadSafePooledString &attr);
+
+    /** Returns the schema of \p table with alias \p alias, like `Table::schema()`, in which the attributes whose
+     * columns contain no NULL are not nullable.  The schema is only valid for the rows of \p table at the time of the
+     * call. */
+    Schema layout_schema(const ThreadSafePooledString &database_name, const Table &table,
+                         const ThreadSafePooledOptionalString &alias = {});
+
+    /** Discards all observations. */
+    void clear() { std::lock_guard<std::mutex> lock(mutex_); tables_.clear(); }
+
+    private:
+    /** Observes the rows of \p table of the database \p database_name appended since the last update. */
+    TableColumns & update_unlocked(const ThreadSafePooledString &database_name, const Table &table);
+};
+
+}
@@ -0,0 +1,100 @@
+#include "catalog/OperatorCalibration.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/util/exception.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+
+using namespace m;
+
+
+namespace {
+
+/** The names of the coefficients in files written by `OperatorCalibration::save()`. */
+constexpr std::pair<std::string_view, double OperatorCalibration::Coefficients::*> COEFFICIENTS[] = {
+    { "scan_simdfied",                 &OperatorCalibration::Coefficients::scan_simdfied },
+    { "scan_scalar",                   &OperatorCalibration::Coefficients::scan_scalar },
+    { "hash_grouping_per_row",         &OperatorCalibration::Coefficients::hash_grouping_per_row },
+    { "ordered_grouping_per_row",      &OperatorCalibration::Coefficients::ordered_grouping_per_row },
+    { "hash_join_build_per_row",       &OperatorCalibration::Coefficients::hash_join_build_per_row },
+    { "hash_join_probe_per_row",       &OperatorCalibration::Coefficients::hash_join_probe_per_row },
+    { "sort_merge_join_merge_per_row", &OperatorCalibration::Coefficients::sort_merge_join_merge_per_row },
+    { "sort_merge_join_sort_per_row",  &OperatorCalibration::Coefficients::sort_merge_join_sort_per_row },
+    { "hash_table_per_byte",           &OperatorCalibration::Coefficients::hash_table_per_byte },
+    { "sort_per_byte",                 &OperatorCalibration::Coefficients::sort_per_byte },
+};
+
+__attribute__((constructor(201)))
+static void add_operator_calibration_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<const char*>(
+        /* group=       */ "Catalog",
+        /* short=       */ nullptr,
+        /* long=        */ "--operator-calibration",
+        /* description= */ "load the cost coefficients of the physical operators from this file, as written by "
+                           "`train-operator-model --calibrate`",
+        /* callback=    */ [](const char *filename){
+            std::ifstream in(filename);
+            if (not in) {
+                std::cerr << "warning: could not open operator calibration " << filename << std::endl;
+                return;
+            }
+            try {
+                OperatorCalibration::Get().load(in);
+            } catch (const invalid_argument &e) {
+                std::cerr << "warning: ignore invalid operator calibration " << filename << ": " << e.what()
+                          << std::endl;
+            }
+        }
+    );
+}
+
+}
+
+OperatorCalibration & OperatorCalibration::Get()
+{
+    static OperatorCalibration the_operator_calibration;
+    return the_operator_calibration;
+}
+
+void OperatorCalibration::load(std::istream &in)
+{
+    Coefficients coefficients = coefficients_;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        const auto comma = line.find(',');
+        if (comma == std::string::npos)
+            throw invalid_argument("expected `<name>,<value>`");
+        const std::string_view name(line.data(), comma);
+        auto it = std::find_if(std::begin(COEFFICIENTS), std::end(COEFFICIENTS), [&](const auto &coefficient) {
+            return coefficient.first == name;
+        });
+        if (it == std::end(COEFFICIENTS))
+            throw invalid_argument("unknown coefficient");
+        try {
+            coefficients.*(it->second) = std::stod(line.substr(comma + 1));
+        } catch (const std::logic_error&) { // `std::invalid_argument` or `std::out_of_range`
+            throw invalid_argument("invalid value of coefficient");
+        }
+    }
+    coefficients_ = coefficients; // only apply a completely valid calibration
+}
+
+void OperatorCalibration::save(std::ostream &out) const
+{
+    const auto precision = out.precision(std::numeric_limits<double>::max_digits10);
+    for (auto &[name, coefficient] : COEFFICIENTS)
+        out << name << ',' << coefficients_.*coefficient << '\n';
+    out.precision(precision);
+}
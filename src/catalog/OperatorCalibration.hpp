@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+
+
+namespace m {
+
+/** Maintains the cost coefficients of the physical operators of the WebAssembly backend, see the `cost()` functions in
+ * `WasmOperator.cpp`.  The coefficients are given in units of the time a SIMDfied `wasm::Scan` takes per row, such that
+ * the costs of alternative operators, e.g. of `wasm::SimpleHashJoin` and `wasm::SortMergeJoin`, are comparable.  The
+ * defaults are heuristic.  `Calibrate()` measures the coefficients on the host, e.g. once after installation by
+ * `train-operator-model --calibrate <file>`, and `--operator-calibration <file>` loads them when starting up.
+ *
+ * The coefficients are set before any query is optimized and read without synchronization by the cost functions. */
+struct OperatorCalibration
+{
+    /** The cost coefficients.  Coefficients *per row* are multiplied by the estimated cardinality of the respective
+     * input, coefficients *per byte* additionally by the width of the tuples stored in a hash table or sorted. */
+    struct Coefficients
+    {
+        double scan_simdfied = 1.0; ///< the relative cost of a SIMDfied `wasm::Scan`
+        double scan_scalar = 2.0; ///< the relative cost of a non-SIMDfied `wasm::Scan`
+        double hash_grouping_per_row = 1.5; ///< `wasm::HashBasedGrouping`, per input row
+        double ordered_grouping_per_row = 1.0; ///< `wasm::OrderedGrouping`, per input row
+        double hash_join_build_per_row = 1.5; ///< `wasm::SimpleHashJoin`, per build row
+        double hash_join_probe_per_row = 1.0; ///< `wasm::SimpleHashJoin` with unique build keys, per probe row
+        double sort_merge_join_merge_per_row = 1.0; ///< `wasm::SortMergeJoin`, per row of both inputs
+        ///> `wasm::SortMergeJoin`, per sorted row and level of sorting, i.e. times the logarithm of the rows
+        double sort_merge_join_sort_per_row = 1.0;
+        double hash_table_per_byte = 0.0; ///< per byte of a row inserted into a hash table
+        double sort_per_byte = 0.0; ///< per byte of a sorted row and level of sorting
+    };
+
+    private:
+    Coefficients coefficients_;
+
+    OperatorCalibration() = default;
+
+    public:
+    static OperatorCalibration & Get();
+
+    const Coefficients & coefficients() const { return coefficients_; }
+    void coefficients(Coefficients coefficients) { coefficients_ = coefficients; }
+
+    /** Reads coefficients from \p in, one `<name>,<value>` pair per line as written by `save()`.  Coefficients absent
+     * from \p in retain their current values.  Throws `m::invalid_argument` for an unknown name or a malformed value,
+     * in which case no coefficient is changed. */
+    void load(std::istream &in);
+    /** Writes all coefficients to \p out, one `<name>,<value>` pair per line. */
+    void save(std::ostream &out) const;
+
+    /** Measures the coefficients on the host by timing queries of tables with \p num_rows rows, forcing one physical
+     * implementation at a time.  The time of scanning the input is subtracted from the time of each query.  The
+     * coefficients per byte are fitted from two tuple widths.  Defined in `CostModel.cpp`, next to the training
+     * suites of the `CostModelFactory`. */
+    static Coefficients Calibrate(std::size_t num_rows = 1e6);
+};
+
+}
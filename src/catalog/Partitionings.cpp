@@ -0,0 +1,248 @@
+#include "catalog/Partitionings.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "catalog/Compaction.hpp"
+#include "catalog/NullFreeColumns.hpp"
+#include <algorithm>
+#include <iterator>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/parse/AST.hpp>
+#include <numeric>
+#include <utility>
+
+
+using namespace m;
+
+
+namespace {
+
+/** Mixes the bits of \p value, s.t. values of a narrow domain spread evenly over the hash partitions.  This is the
+ * finalizer of MurmurHash3. */
+uint64_t mix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdUL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53UL;
+    value ^= value >> 33;
+    return value;
+}
+
+/** Returns the constant of \p expr, negated if \p expr is a unary minus, if \p expr is a constant or a unary minus or
+ * plus applied to a constant. */
+std::optional<std::pair<const ast::Constant&, bool>> get_constant(const ast::Expr &expr)
+{
+    if (auto c = cast<const ast::Constant>(&expr))
+        return std::pair<const ast::Constant&, bool>(*c, false);
+    if (auto u = cast<const ast::UnaryExpr>(&expr)) {
+        if (auto c = cast<const ast::Constant>(u->expr.get());
+            c and (u->op().type == TK_MINUS or u->op().type == TK_PLUS))
+            return std::pair<const ast::Constant&, bool>(*c, u->op().type == TK_MINUS);
+    }
+    return std::nullopt;
+}
+
+/** Returns for each partition of \p partitioning of \p table whether it may contain a row satisfying \p pred, or
+ * `std::nullopt` if \p pred is no comparison of the partitioning attribute with a constant. */
+std::optional<std::vector<bool>> prune_predicate(const Partitionings::Partitioning &partitioning, const Table &table,
+                                                 const cnf::Predicate &pred)
+{
+    auto &scheme = partitioning.scheme;
+    if (pred.negative()) return std::nullopt;
+    auto binary = cast<const ast::BinaryExpr>(&pred.expr());
+    if (not binary) return std::nullopt;
+
+    /*----- Determine the comparison with the partitioning attribute on the left-hand side. -----*/
+    TokenType cmp = binary->op().type;
+    auto is_partitioning_attr = [&](const ast::Expr &e) {
+        auto D = cast<const ast::Designator>(&e);
+        if (not D) return false;
+        auto attr = std::get_if<const Attribute*>(&D->target());
+        return attr and &(*attr)->table == &table and (*attr)->name == scheme.attr;
+    };
+    const ast::Expr *bound;
+    if (is_partitioning_attr(*binary->lhs)) {
+        bound = binary->rhs.get();
+    } else if (is_partitioning_attr(*binary->rhs)) {
+        bound = binary->lhs.get();
+        switch (cmp) { // mirror comparison
+            default:               break;
+            case TK_LESS:          cmp = TK_GREATER;       break;
+            case TK_LESS_EQUAL:    cmp = TK_GREATER_EQUAL; break;
+            case TK_GREATER:       cmp = TK_LESS;          break;
+            case TK_GREATER_EQUAL: cmp = TK_LESS_EQUAL;    break;
+        }
+    } else {
+        return std::nullopt;
+    }
+    switch (cmp) {
+        default: return std::nullopt; // unsupported comparison
+        case TK_EQUAL:
+        case TK_LESS:
+        case TK_LESS_EQUAL:
+        case TK_GREATER:
+        case TK_GREATER_EQUAL:
+            break;
+    }
+    if (scheme.kind == Partitionings::Scheme::P_Hash and cmp != TK_EQUAL)
+        return std::nullopt; // hash partitions are only pruned by equality
+
+    /*----- Interpret the bound as value of the partitioning attribute. -----*/
+    auto constant = get_constant(*bound);
+    if (not constant) return std::nullopt;
+    auto &ty_attr = *table[scheme.attr].type;
+    auto &ty_bound = *constant->first.type();
+    if (not ((ty_attr.is_integral() and ty_bound.is_integral()) or (ty_attr.is_date() and ty_bound.is_date()) or
+             (ty_attr.is_date_time() and ty_bound.is_date_time())))
+        return std::nullopt;
+    const int64_t value = Interpreter::eval(constant->first).as_i();
+    const int64_t c = constant->second ? -value : value;
+
+    /*----- Decide for each partition whether one of its values may satisfy the comparison. -----*/
+    std::vector<bool> remaining(scheme.num_partitions);
+    if (scheme.kind == Partitionings::Scheme::P_Hash) {
+        remaining[scheme.partition_of(c)] = true;
+        return remaining;
+    }
+    for (std::size_t p = 0; p != scheme.num_partitions; ++p) {
+        /* Partition `p` contains the values in `[lo, hi)`, where absent bounds are unbounded. */
+        const std::optional<int64_t> lo = p == 0 ? std::nullopt : std::optional(scheme.bounds[p - 1]);
+        const std::optional<int64_t> hi = p + 1 == scheme.num_partitions ? std::nullopt
+                                                                         : std::optional(scheme.bounds[p]);
+        switch (cmp) {
+            default: M_unreachable("invalid comparison");
+            case TK_EQUAL:         remaining[p] = (not lo or *lo <= c) and (not hi or c < *hi); break;
+            case TK_LESS:          remaining[p] = not lo or *lo < c;                           break;
+            case TK_LESS_EQUAL:    remaining[p] = not lo or *lo <= c;                          break;
+            case TK_GREATER:       remaining[p] = not hi or *hi - 1 > c;                       break;
+            case TK_GREATER_EQUAL: remaining[p] = not hi or *hi > c;                           break;
+        }
+    }
+    return remaining;
+}
+
+}
+
+std::size_t Partitionings::Scheme::partition_of(int64_t value) const
+{
+    if (kind == P_Hash)
+        return mix(value) % num_partitions;
+    return std::distance(bounds.begin(), std::upper_bound(bounds.begin(), bounds.end(), value));
+}
+
+Partitionings & Partitionings::Get()
+{
+    static Partitionings the_partitionings;
+    return the_partitionings;
+}
+
+void Partitionings::partition(Database &DB, Table &table, Scheme scheme)
+{
+    M_insist(scheme.num_partitions != 0, "at least one partition required");
+    M_insist(scheme.kind == Scheme::P_Hash or scheme.bounds.size() + 1 == scheme.num_partitions,
+             "one bound per partition but the first required");
+    M_insist(std::is_sorted(scheme.bounds.begin(), scheme.bounds.end()), "bounds must be ascending");
+    M_insist(Is_Partitionable(*table[scheme.attr].type), "attribute must be partitionable");
+
+    /* Observe the NULL-free columns of all rows before rows are moved into the observed prefix of the table. */
+    NullFreeColumns::Get().layout_schema(DB.name, table);
+
+    /*----- Load all rows and determine their partitions. -----*/
+    const Schema schema = table.schema();
+    const std::size_t attr_idx = std::distance(schema.cbegin(),
+                                               schema.find(Schema::Identifier(table.name(), scheme.attr)));
+    const std::size_t num_rows = table.store().num_rows();
+    M_insist(std::in_range<uint32_t>(num_rows), "number of rows must fit in uint32_t");
+    void *addr = table.store().memory().addr();
+    auto loader = Interpreter::compile_load(schema, addr, table.layout(), schema);
+    Tuple tuple(schema);
+    Tuple *load_args[] = { &tuple };
+    std::vector<Tuple> rows;
+    std::vector<std::size_t> partitions;
+    rows.reserve(num_rows);
+    partitions.reserve(num_rows);
+    std::vector<uint32_t> offsets(scheme.num_partitions + 1);
+    for (std::size_t row = 0; row != num_rows; ++row) {
+        loader(load_args);
+        const std::size_t p = tuple.is_null(attr_idx) ? 0 : scheme.partition_of(tuple[attr_idx].as_i());
+        rows.push_back(tuple.clone(schema));
+        partitions.push_back(p);
+        ++offsets[p + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    /*----- Store the rows partition by partition, preserving their order within each partition. -----*/
+    std::vector<std::size_t> order(num_rows);
+    {
+        std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+        for (std::size_t row = 0; row != num_rows; ++row)
+            order[cursors[partitions[row]]++] = row;
+    }
+    auto storer = Interpreter::compile_store(schema, addr, table.layout(), schema);
+    for (auto row : order) {
+        Tuple *store_args[] = { &rows[row] };
+        storer(store_args);
+    }
+    Compaction::rows_overwritten(DB, table, 0); // invalidates the previous partitions, if any
+
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    ranges.reserve(scheme.num_partitions);
+    for (std::size_t p = 0; p != scheme.num_partitions; ++p)
+        ranges.emplace_back(offsets[p], offsets[p + 1]);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    partitionings_[DB.name][table.name()] = TablePartitioning{ std::move(scheme), std::move(ranges) };
+}
+
+bool Partitionings::repartition(Database &DB, Table &table)
+{
+    std::optional<Scheme> scheme;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto db = partitionings_.find(DB.name); db != partitionings_.end()) {
+            if (auto it = db->second.find(table.name()); it != db->second.end())
+                scheme = it->second.scheme;
+        }
+    }
+    if (not scheme)
+        return false;
+    partition(DB, table, std::move(*scheme));
+    return true;
+}
+
+std::optional<Partitionings::Partitioning> Partitionings::get(const ThreadSafePooledString &database_name,
+                                                              const Table &table) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto db = partitionings_.find(database_name);
+    if (db == partitionings_.end()) return std::nullopt;
+    auto it = db->second.find(table.name());
+    if (it == db->second.end() or not it->second.ranges) return std::nullopt;
+    if (it->second.ranges->back().second != table.store().num_rows())
+        return std::nullopt; // the rows changed without notice, e.g. the table was replaced
+    return Partitioning{ it->second.scheme, *it->second.ranges };
+}
+
+std::vector<bool> Partitionings::Prune(const Partitioning &partitioning, const Table &table, const cnf::CNF &filter)
+{
+    std::vector<bool> remaining(partitioning.scheme.num_partitions, true);
+    for (auto &clause : filter) {
+        /* A clause rules out the partitions none of whose predicates any value of the partition satisfies. */
+        std::vector<bool> remaining_clause(partitioning.scheme.num_partitions, false);
+        bool prunes = not clause.empty();
+        for (auto &pred : clause) {
+            auto remaining_pred = prune_predicate(partitioning, table, pred);
+            if (not remaining_pred) {
+                prunes = false;
+                break;
+            }
+            for (std::size_t p = 0; p != remaining_clause.size(); ++p)
+                remaining_clause[p] = remaining_clause[p] or (*remaining_pred)[p];
+        }
+        if (not prunes) continue;
+        for (std::size_t p = 0; p != remaining.size(); ++p)
+            remaining[p] = remaining[p] and remaining_clause[p];
+    }
+    return remaining;
+}
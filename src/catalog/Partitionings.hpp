@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/CNF.hpp>
+#include <mutable/util/Pool.hpp>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace m {
+
+/** Maintains the partitionings of the tables of all databases.  A table is *partitioned* by the hash of an attribute
+ * into a fixed number of partitions or by ranges of an attribute's values, as declared by the `\partition_by`
+ * instruction.  Partitioning a table *clusters* its rows, i.e. moves the rows of each partition next to each other,
+ * such that each partition is a single range of row IDs.  Rows with NULL as partitioning value belong to the first
+ * partition.
+ *
+ * Since appending, deleting, or moving rows breaks the clustering, the partitions of a table are invalidated then.  The
+ * scheme is retained, such that `\partition_by <table>` clusters the rows anew.
+ *
+ * The partitions are used by
+ * - `Optimizer::optimize_source_plans()`, which prunes the partitions ruled out by the filter of a table and bounds the
+ *   estimated cardinality of the filtered table by the rows of the remaining partitions, see `Prune()`,
+ * - `wasm::ZoneMapScan`, which only loads the rows of the remaining partitions, and
+ * - `wasm::PartitionWiseHashJoin`, which joins two tables partitioned by the same scheme on their partitioning
+ *   attributes partition by partition, each with a small hash table. */
+struct Partitionings
+{
+    /** Assigns the rows of a table to partitions by the value of its partitioning attribute. */
+    struct Scheme
+    {
+        enum kind_t { P_Hash, P_Range };
+
+        kind_t kind;
+        ThreadSafePooledString attr; ///< the name of the partitioning attribute
+        std::size_t num_partitions;
+        ///> for range partitioning, the ascending first value of each partition but the first one
+        std::vector<int64_t> bounds;
+
+        /** Returns the partition of a row whose partitioning attribute has value \p value. */
+        std::size_t partition_of(int64_t value) const;
+
+        /** Returns `true` iff `this` and \p other assign equal values to the same partition, i.e. tables partitioned
+         * by both are *co-partitioned* on their partitioning attributes. */
+        bool co_partitioned(const Scheme &other) const {
+            return kind == other.kind and num_partitions == other.num_partitions and bounds == other.bounds;
+        }
+    };
+
+    /** The partitions of a table. */
+    struct Partitioning
+    {
+        Scheme scheme;
+        std::vector<std::pair<uint32_t, uint32_t>> ranges; ///< the row IDs `[begin, end)` of each partition
+    };
+
+    private:
+    struct TablePartitioning
+    {
+        Scheme scheme;
+        ///> the row IDs of each partition, or `std::nullopt` if the rows are not clustered by the scheme
+        std::optional<std::vector<std::pair<uint32_t, uint32_t>>> ranges;
+    };
+
+    ///> the partitionings by database name and table name
+    std::unordered_map<ThreadSafePooledString,
+                       std::unordered_map<ThreadSafePooledString, TablePartitioning>> partitionings_;
+    mutable std::mutex mutex_;
+
+    Partitionings() = default;
+
+    public:
+    static Partitionings & Get();
+
+    /** Returns `true` iff a table can be partitioned by an attribute of `Type` \p type, i.e. an integral, date, or
+     * datetime attribute. */
+    static bool Is_Partitionable(const Type &type) {
+        return type.is_integral() or type.is_date() or type.is_date_time();
+    }
+
+    /** Partitions \p table of database \p DB by \p scheme and clusters its rows accordingly.  The partitioning
+     * attribute of \p scheme must exist and be partitionable. */
+    void partition(Database &DB, Table &table, Scheme scheme);
+
+    /** Clusters the rows of \p table of database \p DB anew by its scheme.  Returns `false`, and does nothing, if
+     * \p table was never partitioned. */
+    bool repartition(Database &DB, Table &table);
+
+    /** Returns the partitions of \p table of database \p database_name, or `std::nullopt` if \p table is not
+     * partitioned or its partitions were invalidated. */
+    std::optional<Partitioning> get(const ThreadSafePooledString &database_name, const Table &table) const;
+
+    /** Invalidates the partitions of \p table of database \p database_name after its rows were appended, deleted, or
+     * moved.  The scheme is retained. */
+    void invalidate(const ThreadSafePooledString &database_name, const Table &table) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto db = partitionings_.find(database_name); db != partitionings_.end()) {
+            if (auto it = db->second.find(table.name()); it != db->second.end())
+                it->second.ranges.reset();
+        }
+    }
+
+    /** Returns for each partition of \p partitioning of \p table whether it may contain rows satisfying \p filter.  A
+     * partition is *pruned* if a clause of \p filter consists of comparisons of the partitioning attribute with
+     * constants only, none of which any value of the partition satisfies.  Hash partitions are only pruned by
+     * equality comparisons. */
+    static std::vector<bool> Prune(const Partitioning &partitioning, const Table &table, const cnf::CNF &filter);
+
+    /** Discards all partitionings. */
+    void clear() { std::lock_guard<std::mutex> lock(mutex_); partitionings_.clear(); }
+};
+
+}
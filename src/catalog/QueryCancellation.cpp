@@ -0,0 +1,146 @@
+#include "catalog/QueryCancellation.hpp"
+
+#include "util/WorkerPool.hpp"
+#include <mutable/catalog/Catalog.hpp>
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** The time in milliseconds after which a query is cancelled, 0 to never cancel queries. */
+std::size_t statement_timeout = 0;
+
+}
+
+__attribute__((constructor(201)))
+static void add_query_cancellation_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Catalog",
+        /* short=       */ nullptr,
+        /* long=        */ "--statement-timeout",
+        /* description= */ "cancel queries running longer than this many milliseconds, 0 to never cancel queries",
+        /* callback=    */ [](std::size_t ms){ options::statement_timeout = ms; }
+    );
+}
+
+thread_local QueryCancellation::Token *current_token = nullptr;
+
+}
+
+QueryCancellation::Scope::Scope(const Scheduler::Transaction *t)
+    : transaction_(t)
+    , previous_(current_token)
+{
+    current_token = &token_;
+    auto &QC = QueryCancellation::Get();
+    std::lock_guard<std::mutex> lock(QC.mutex_);
+    if (transaction_)
+        QC.running_.emplace(transaction_, &token_);
+    if (options::statement_timeout) {
+        QC.deadlines_.emplace(clock::now() + std::chrono::milliseconds(options::statement_timeout), &token_);
+        if (not QC.watchdog_.joinable())
+            QC.watchdog_ = std::thread(&QueryCancellation::watch, &QC);
+        QC.deadlines_changed_.notify_one();
+    }
+}
+
+QueryCancellation::Scope::~Scope()
+{
+    current_token = previous_;
+    auto &QC = QueryCancellation::Get();
+    std::lock_guard<std::mutex> lock(QC.mutex_);
+    std::erase_if(QC.deadlines_, [this](auto &entry) { return entry.second == &token_; });
+    if (transaction_) {
+        auto [begin, end] = QC.running_.equal_range(transaction_);
+        for (auto it = begin; it != end; ++it) {
+            if (it->second == &token_) {
+                QC.running_.erase(it);
+                break;
+            }
+        }
+    }
+}
+
+QueryCancellation::Hook::Hook(std::function<void()> on_cancel)
+    : token_(current_token)
+{
+    if (not token_) return;
+    std::lock_guard<std::mutex> lock(QueryCancellation::Get().mutex_);
+    token_->on_cancel = std::move(on_cancel);
+    if (token_->cancelled)
+        token_->on_cancel(); // cancelled before the hook was set
+}
+
+QueryCancellation::Hook::~Hook()
+{
+    if (not token_) return;
+    std::lock_guard<std::mutex> lock(QueryCancellation::Get().mutex_);
+    token_->on_cancel = nullptr;
+}
+
+QueryCancellation::~QueryCancellation()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    deadlines_changed_.notify_one();
+    if (watchdog_.joinable())
+        watchdog_.join();
+}
+
+QueryCancellation & QueryCancellation::Get()
+{
+    static QueryCancellation the_cancellation;
+    return the_cancellation;
+}
+
+QueryCancellation::Token * QueryCancellation::Current() { return current_token; }
+
+void QueryCancellation::Current(Token *token) { current_token = token; }
+
+std::size_t QueryCancellation::cancel(const Scheduler::Transaction &t)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [begin, end] = running_.equal_range(&t);
+    std::size_t num_cancelled = 0;
+    for (auto it = begin; it != end; ++it, ++num_cancelled)
+        cancel_unlocked(*it->second);
+    return num_cancelled;
+}
+
+void QueryCancellation::cancel_unlocked(Token &token)
+{
+    if (token.cancelled.exchange(true)) return; // already cancelled
+    if (token.on_cancel)
+        token.on_cancel();
+}
+
+void QueryCancellation::watch()
+{
+    WorkerPool::Pin_To_Reserved_CPUs();
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (not stop_) {
+        if (deadlines_.empty()) {
+            deadlines_changed_.wait(lock);
+            continue;
+        }
+
+        /* Cancel the queries whose deadline passed and wait for the next deadline. */
+        const auto now = clock::now();
+        while (not deadlines_.empty() and deadlines_.begin()->first <= now) {
+            cancel_unlocked(*deadlines_.begin()->second);
+            deadlines_.erase(deadlines_.begin());
+        }
+        if (not deadlines_.empty())
+            deadlines_changed_.wait_until(lock, deadlines_.begin()->first);
+    }
+}
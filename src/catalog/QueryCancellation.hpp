@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutable/catalog/Scheduler.hpp>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+
+namespace m {
+
+/** Thrown by the backends to unwind the execution of a cancelled query. */
+struct query_cancelled : std::exception
+{
+    const char * what() const noexcept override { return "query cancelled"; }
+};
+
+/** Cancels queries that exceed the statement timeout, see `--statement-timeout`, or that are cancelled explicitly by
+ * their transaction, e.g. on behalf of a client of `mutable-server`.  Cancellation is cooperative: the `Interpreter`
+ * checks the flag of the running query once per block produced by a scan, and the WebAssembly backends register a
+ * hook that terminates the execution of the generated code.  A cancelled query unwinds by throwing `query_cancelled`,
+ * such that its command completes and the scheduler continues with the next transaction.
+ *
+ * The flag of the query running in a thread is thread-local.  Threads executing part of a query, e.g. the workers of a
+ * parallel scan, must adopt the flag with `Current()`. */
+struct QueryCancellation
+{
+    /** The cancellation state of a running query. */
+    struct Token
+    {
+        std::atomic<bool> cancelled = false;
+        std::function<void()> on_cancel; ///< invoked once when the query is cancelled, guarded by `mutex_`
+    };
+
+    /** Registers the query executed by the calling thread for the duration of its lifetime and arms the statement
+     * timeout. */
+    struct Scope
+    {
+        private:
+        Token token_;
+        const Scheduler::Transaction *transaction_;
+        Token *previous_;
+
+        public:
+        explicit Scope(const Scheduler::Transaction *t);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope & operator=(const Scope&) = delete;
+    };
+
+    /** Sets the hook of the current query to cancel its execution for the lifetime of this object. */
+    struct Hook
+    {
+        private:
+        Token *token_;
+
+        public:
+        explicit Hook(std::function<void()> on_cancel);
+        ~Hook();
+
+        Hook(const Hook&) = delete;
+        Hook & operator=(const Hook&) = delete;
+    };
+
+    private:
+    using clock = std::chrono::steady_clock;
+
+    ///> the tokens of running queries by their deadline
+    std::multimap<clock::time_point, Token*> deadlines_;
+    ///> the tokens of running queries by their transaction
+    std::unordered_multimap<const Scheduler::Transaction*, Token*> running_;
+    bool stop_ = false; ///< whether the watchdog thread shall terminate
+    std::thread watchdog_;
+    std::mutex mutex_;
+    std::condition_variable deadlines_changed_;
+
+    QueryCancellation() = default;
+    ~QueryCancellation();
+
+    public:
+    static QueryCancellation & Get();
+
+    /** Returns the token of the query executed by the calling thread, or `nullptr` if there is none. */
+    static Token * Current();
+    /** Makes the calling thread execute part of the query with token \p token. */
+    static void Current(Token *token);
+
+    /** Throws `query_cancelled` if the query executed by the calling thread was cancelled. */
+    static void Check() {
+        if (auto token = Current(); token and token->cancelled.load(std::memory_order_relaxed)) [[unlikely]]
+            throw query_cancelled();
+    }
+
+    /** Cancels all running queries of transaction \p t.  Returns the number of cancelled queries. */
+    std::size_t cancel(const Scheduler::Transaction &t);
+
+    private:
+    /** Cancels \p token.  Must be called with `mutex_` held. */
+    static void cancel_unlocked(Token &token);
+    /** Cancels the queries whose deadline passed until `stop_` is set. */
+    void watch();
+};
+
+}
@@ -0,0 +1,266 @@
+#include "catalog/Replication.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "parse/ASTPrinter.hpp"
+#include "util/WireClient.hpp"
+#include "util/WorkerPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/util/exception.hpp>
+#include <sstream>
+#include <string_view>
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** Whether this instance serves as read-only replica. */
+bool read_only_replica = false;
+/** The maximum number of rows per record batch shipped to the replicas. */
+std::size_t batch_size = 64 * 1024;
+/** The time in milliseconds after which shipping to a failed replica is retried. */
+unsigned retry_delay = 1000;
+
+}
+
+__attribute__((constructor(201)))
+static void add_replication_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<const char*>(
+        /* group=       */ "Replication",
+        /* short=       */ nullptr,
+        /* long=        */ "--replica",
+        /* description= */ "ship committed transactions to the read-only replica at HOST:PORT",
+        /* callback=    */ [](const char *str){
+            try {
+                Replication::Get().add_replica(Cluster::Node::Parse(str));
+            } catch (invalid_argument) {
+                std::cerr << "Invalid replica " << str << ", expected HOST:PORT.\n";
+                std::exit(EXIT_FAILURE);
+            }
+        }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Replication",
+        /* short=       */ nullptr,
+        /* long=        */ "--read-only-replica",
+        /* description= */ "serve as read-only replica: reject changes of clients and apply the transactions shipped "
+                           "by the primary",
+        /* callback=    */ [](bool b){ options::read_only_replica = b; }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Replication",
+        /* short=       */ nullptr,
+        /* long=        */ "--replication-batch-size",
+        /* description= */ "the maximum number of rows per record batch shipped to the replicas",
+        /* callback=    */ [](std::size_t n){ options::batch_size = std::max<std::size_t>(n, 1); }
+    );
+    C.arg_parser().add<unsigned>(
+        /* group=       */ "Replication",
+        /* short=       */ nullptr,
+        /* long=        */ "--replication-retry-delay",
+        /* description= */ "the time in milliseconds after which shipping to a failed replica is retried",
+        /* callback=    */ [](unsigned delay){ options::retry_delay = delay; }
+    );
+}
+
+/** Returns the current time in microseconds since the epoch. */
+int64_t now()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+}
+
+Replication::Replica::Replica(Cluster::Node node) : node(std::move(node)) { }
+Replication::Replica::~Replica() { }
+
+Replication::~Replication()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    committed_.notify_one();
+    if (shipper_.joinable())
+        shipper_.join();
+}
+
+Replication & Replication::Get()
+{
+    static Replication the_replication;
+    return the_replication;
+}
+
+bool Replication::Is_Replica() { return options::read_only_replica; }
+
+void Replication::add_replica(Cluster::Node node)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        replicas_.push_back(std::make_unique<Replica>(std::move(node)));
+        if (not shipper_.joinable())
+            shipper_ = std::thread(&Replication::ship_loop, this);
+    }
+    committed_.notify_one(); // catch up on the transactions committed so far
+}
+
+void Replication::log_rows(const Scheduler::Transaction &t, const ThreadSafePooledString &database_name,
+                           const Table &table, std::size_t first_row)
+{
+    const std::size_t num_rows = table.store().num_rows();
+    if (first_row >= num_rows) return;
+
+    /*----- Encode the appended rows in record batches. -----*/
+    const Schema &schema = table.schema();
+    std::vector<wire::ReplicatedChange> changes;
+    wire::BatchWriter batch(schema);
+    auto finish = [&]() { changes.push_back({ *database_name, *table.name(), batch.finish() }); };
+    auto loader = Interpreter::compile_load(schema, table.store().memory().addr(), table.layout(), schema, first_row);
+    Tuple tuple(schema);
+    Tuple *args[] = { &tuple };
+    for (std::size_t row = first_row; row != num_rows; ++row) {
+        loader(args);
+        batch.append(tuple);
+        if (batch.num_rows() == options::batch_size)
+            finish();
+    }
+    if (batch.num_rows())
+        finish();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &staged = changes_[&t];
+    std::move(changes.begin(), changes.end(), std::back_inserter(staged));
+}
+
+void Replication::log_statement(const Scheduler::Transaction &t, const ThreadSafePooledString *database_name,
+                                const ast::Command &command)
+{
+    std::ostringstream sql;
+    ast::ASTPrinter print(sql);
+    print(command);
+    std::string text = sql.str();
+    if (text.empty() or text.back() != ';')
+        text += ';';
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    changes_[&t].push_back({ database_name ? std::string(**database_name) : std::string(), {}, std::move(text) });
+}
+
+void Replication::commit(const Scheduler::Transaction &t)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = changes_.find(&t);
+        if (it == changes_.end()) return; // nothing changed
+        wire::ReplicatedTransaction transaction;
+        transaction.position = shipped_.size() + 1;
+        transaction.commit_time = now();
+        transaction.changes = std::move(it->second);
+        changes_.erase(it);
+        shipped_.push_back(wire::encode_replicate(transaction));
+    }
+    committed_.notify_one();
+}
+
+void Replication::applied(const wire::ReplicatedTransaction &transaction)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    applied_position_ = transaction.position;
+    applied_commit_time_ = transaction.commit_time;
+    lag_ = std::max<int64_t>(now() - transaction.commit_time, 0);
+}
+
+void Replication::print_status(std::ostream &out) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (Is_Replica()) {
+        out << "Replica at position " << applied_position_ << ", replication lag " << lag_ / 1000.0 << " ms";
+        if (applied_position_)
+            out << ", last transaction committed by the primary " << (now() - applied_commit_time_) / 1000.0
+                << " ms ago";
+        out << ".\n";
+    }
+    if (not replicas_.empty()) {
+        out << "Primary at position " << shipped_.size() << ".\n";
+        for (auto &R : replicas_) {
+            out << "  Replica " << R->node << " at position " << R->acknowledged;
+            if (not R->error.empty()) {
+                std::string_view error(R->error);
+                while (not error.empty() and error.back() == '\n') error.remove_suffix(1);
+                out << ", failing: " << error;
+            }
+            out << ".\n";
+        }
+    }
+    if (not Is_Replica() and replicas_.empty())
+        out << "Replication is not configured, see --replica and --read-only-replica.\n";
+}
+
+void Replication::ship_loop()
+{
+    WorkerPool::Pin_To_Reserved_CPUs();
+    std::unique_lock<std::mutex> lock(mutex_);
+    bool failed = false;
+    for (;;) {
+        auto is_behind = [this]() {
+            return std::any_of(replicas_.begin(), replicas_.end(), [this](auto &R) {
+                return R->acknowledged < shipped_.size();
+            });
+        };
+        if (failed) // give failed replicas time to recover
+            committed_.wait_for(lock, std::chrono::milliseconds(options::retry_delay), [this]() { return stop_; });
+        else
+            committed_.wait(lock, [&]() { return stop_ or is_behind(); });
+        if (stop_) return;
+        failed = false;
+
+        /*----- Collect the transactions missing at any replica.  Elements of `shipped_` are never moved. -----*/
+        std::vector<Replica*> replicas;
+        uint64_t first = shipped_.size();
+        for (auto &R : replicas_) {
+            replicas.push_back(R.get());
+            first = std::min(first, R->acknowledged);
+        }
+        std::vector<const std::string*> payloads;
+        for (uint64_t i = first; i != shipped_.size(); ++i)
+            payloads.push_back(&shipped_[i]);
+        const uint64_t end = shipped_.size();
+
+        /*----- Ship them without blocking transactions from committing.  Only this thread accesses the clients. ----*/
+        lock.unlock();
+        for (auto R : replicas) {
+            uint64_t acknowledged = R->acknowledged; // only written by this thread
+            std::string error;
+            try {
+                if (not R->client)
+                    R->client = std::make_unique<wire::Client>(R->node.host, R->node.port);
+                while (acknowledged != end and R->client->replicate(*payloads[acknowledged - first], error))
+                    ++acknowledged;
+            } catch (const std::exception &e) {
+                error = e.what();
+                R->client.reset(); // reconnect on the next attempt
+            }
+            failed = failed or not error.empty();
+
+            std::lock_guard<std::mutex> replica_lock(mutex_);
+            R->acknowledged = acknowledged;
+            R->error = std::move(error);
+        }
+        lock.lock();
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "catalog/Cluster.hpp"
+#include "util/WireProtocol.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutable/catalog/Scheduler.hpp>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/util/Pool.hpp>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+namespace m {
+
+namespace ast { struct Command; }
+namespace wire { struct Client; }
+
+/** Ships the changes of committed transactions from a *primary* to read-only *replicas*, i.e. `mutable-server`s
+ * started with `--read-only-replica`, such that read-heavy workloads scale by adding replicas rather than by scaling
+ * up the single instance of the scheduler.  Replicas are added with `--replica` and `\add_replica`.
+ *
+ * Like the `WriteAheadLog`, the primary collects the rows appended by each transaction, in columnar record batches,
+ * and additionally the DDL statements it executes.  Deletions are not shipped, hence a primary rejects `DELETE` and
+ * `UPDATE`.  When the transaction commits, its changes are assigned the next position in the commit order and a
+ * shipper thread sends them to every replica with `wire::MSG_REPLICATE`.  The shipper retains all shipped
+ * transactions, such that a replica added later catches up from the first one, and retries replicas that failed after
+ * `--replication-retry-delay`.
+ *
+ * A replica applies each shipped transaction in a single transaction of its own, appending the record batches
+ * through `\append_batches`, which maintains the zone maps, indexes, SPNs, and sketches of the tables incrementally.
+ * Queries hence observe either all or none of the changes of a primary transaction.  The replica reports its
+ * replication lag, i.e. the time between the commit on the primary and the commit on the replica of the last applied
+ * transaction, with `\replication_status`.  The lag is measured with the clocks of both hosts. */
+struct Replication
+{
+    private:
+    /** A replica of this primary. */
+    struct Replica
+    {
+        Cluster::Node node;
+        std::unique_ptr<wire::Client> client; ///< the connection to the replica, `nullptr` if not connected
+        uint64_t acknowledged = 0; ///< the position of the last transaction applied by the replica
+        std::string error; ///< the last error of the replica, empty if shipping succeeds
+
+        explicit Replica(Cluster::Node node);
+        ~Replica();
+    };
+
+    /*----- Primary -----*/
+    std::vector<std::unique_ptr<Replica>> replicas_;
+    ///> the changes of every transaction that changed the database and did not yet commit
+    std::unordered_map<const Scheduler::Transaction*, std::vector<wire::ReplicatedChange>> changes_;
+    ///> the `MSG_REPLICATE` payloads of all committed transactions, the transaction at position `i` at index `i - 1`
+    std::deque<std::string> shipped_;
+    bool stop_ = false; ///< whether the shipper thread shall terminate
+    std::thread shipper_;
+    std::condition_variable committed_; ///< signals the shipper thread that a transaction committed
+
+    /*----- Replica -----*/
+    uint64_t applied_position_ = 0; ///< the position of the last applied transaction
+    int64_t applied_commit_time_ = 0; ///< the commit time on the primary of the last applied transaction
+    int64_t lag_ = 0; ///< the replication lag of the last applied transaction in microseconds
+
+    mutable std::mutex mutex_;
+
+    Replication() = default;
+    ~Replication();
+
+    public:
+    static Replication & Get();
+
+    /** Returns `true` iff this instance serves as read-only replica, see `--read-only-replica`. */
+    static bool Is_Replica();
+
+    /*----- Primary -----*/
+    /** Adds \p node as replica.  It receives all transactions committed so far and from now on. */
+    void add_replica(Cluster::Node node);
+    /** Returns `true` iff this instance ships its transactions to replicas. */
+    bool is_primary() const { std::lock_guard<std::mutex> lock(mutex_); return not replicas_.empty(); }
+
+    /** Records the rows of \p table of the database \p database_name from \p first_row on, appended by transaction
+     * \p t.  They are shipped when \p t commits. */
+    void log_rows(const Scheduler::Transaction &t, const ThreadSafePooledString &database_name, const Table &table,
+                  std::size_t first_row);
+    /** Records the DDL statement \p command executed by transaction \p t in the database \p database_name, or in no
+     * database if \p database_name is `nullptr`.  It is shipped when \p t commits. */
+    void log_statement(const Scheduler::Transaction &t, const ThreadSafePooledString *database_name,
+                       const ast::Command &command);
+
+    /** Ships the changes of transaction \p t, which committed. */
+    void commit(const Scheduler::Transaction &t);
+    /** Forgets the changes of transaction \p t, which aborted. */
+    void abort(const Scheduler::Transaction &t) { std::lock_guard<std::mutex> lock(mutex_); changes_.erase(&t); }
+
+    /*----- Replica -----*/
+    /** Returns the position of the last transaction applied by this replica. */
+    uint64_t applied_position() const { std::lock_guard<std::mutex> lock(mutex_); return applied_position_; }
+    /** Records that this replica committed the shipped transaction \p transaction. */
+    void applied(const wire::ReplicatedTransaction &transaction);
+
+    /** Prints the state of replication, i.e. the progress of the replicas of a primary or the position and lag of a
+     * replica, to \p out. */
+    void print_status(std::ostream &out) const;
+
+    private:
+    /** Ships committed transactions to the replicas until `stop_` is set. */
+    void ship_loop();
+};
+
+}
@@ -0,0 +1,222 @@
+#include "catalog/ResultCache.hpp"
+
+#include <algorithm>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/util/macro.hpp>
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** Whether to cache the results of queries. */
+bool result_cache = false;
+/** The capacity of the result cache in MiB. */
+std::size_t result_cache_size = 64;
+
+}
+
+__attribute__((constructor(201)))
+static void add_result_cache_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<bool>(
+        /* group=       */ "Catalog",
+        /* short=       */ nullptr,
+        /* long=        */ "--result-cache",
+        /* description= */ "cache the results of queries until the tables they read are modified",
+        /* callback=    */ [](bool b){ options::result_cache = b; }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Catalog",
+        /* short=       */ nullptr,
+        /* long=        */ "--result-cache-size",
+        /* description= */ "the capacity of the result cache in MiB",
+        /* callback=    */ [](std::size_t n){
+            options::result_cache_size = n;
+            ResultCache::Get().capacity(n << 20);
+        }
+    );
+}
+
+}
+
+ResultCache::ResultCache() : capacity_(options::result_cache_size << 20) { }
+
+ResultCache & ResultCache::Get()
+{
+    static ResultCache the_cache;
+    return the_cache;
+}
+
+bool ResultCache::enabled() { return options::result_cache; }
+
+std::size_t ResultCache::Row_Size(const Schema &S)
+{
+    std::size_t size = sizeof(Tuple) + S.num_entries() * sizeof(Value);
+    for (auto &e : S) {
+        if (auto cs = cast<const CharacterSequence>(e.type))
+            size += cs->length + 1; // NUL-terminated
+    }
+    return size;
+}
+
+std::shared_ptr<const ResultCache::entry_type> ResultCache::find(const key_type &key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        ++num_misses_;
+        return nullptr;
+    }
+    ++num_hits_;
+    lru_.splice(lru_.begin(), lru_, it->second.lru_pos); // mark as most recently used
+    return it->second.entry;
+}
+
+std::shared_ptr<const ResultCache::entry_type> ResultCache::find_or_wait(const key_type &key, bool &announced)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    announced = false;
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        auto [pending_it, inserted] = pending_.try_emplace(key);
+        if (inserted) {
+            pending_it->second = std::make_shared<pending_type>();
+            announced = true;
+            ++num_misses_;
+            return nullptr;
+        }
+
+        /* Wait for the concurrent query computing the result.  Hold on to the pending result, since it is erased from
+         * `pending_` when finished. */
+        auto pending = pending_it->second;
+        pending->cv.wait(lock, [&]() { return pending->finished; });
+        it = entries_.find(key);
+        if (it == entries_.end()) {
+            ++num_misses_;
+            return nullptr; // result was not cached
+        }
+        ++num_shared_;
+    }
+    ++num_hits_;
+    lru_.splice(lru_.begin(), lru_, it->second.lru_pos); // mark as most recently used
+    return it->second.entry;
+}
+
+void ResultCache::abandon(const key_type &key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    finish(key);
+}
+
+ResultCache::versions_type ResultCache::versions(const std::vector<const Table*> &tables)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    versions_type versions;
+    versions.emplace_back(nullptr, versions_[nullptr]);
+    for (auto table : tables)
+        versions.emplace_back(table, versions_[table]);
+    return versions;
+}
+
+bool ResultCache::insert(key_type key, Schema S, std::vector<Tuple> rows, versions_type versions)
+{
+    const std::size_t size_in_bytes = key.size() + rows.size() * Row_Size(S);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    finish(key);
+    if (size_in_bytes > capacity_)
+        return false;
+    for (auto [table, version] : versions) {
+        if (versions_[table] != version)
+            return false; // table was modified while the query was executed
+    }
+
+    if (auto it = entries_.find(key); it != entries_.end())
+        erase(it);
+    auto entry = std::make_shared<entry_type>(entry_type{
+        .schema = std::move(S),
+        .rows = std::move(rows),
+        .versions = std::move(versions),
+        .size_in_bytes = size_in_bytes,
+    });
+    lru_.push_front(key);
+    entries_.emplace(std::move(key), slot_type{ std::move(entry), lru_.begin() });
+    size_in_bytes_ += size_in_bytes;
+    evict();
+    return true;
+}
+
+void ResultCache::invalidate(const Table &table)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++versions_[&table];
+    for (auto it = entries_.begin(); it != entries_.end(); ) {
+        auto &versions = it->second.entry->versions;
+        auto reads_table = std::any_of(versions.begin(), versions.end(), [&](auto &v) { return v.first == &table; });
+        if (reads_table) {
+            auto next = std::next(it);
+            erase(it);
+            it = next;
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ResultCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++versions_[nullptr]; // results of queries currently executed must not be cached either
+    entries_.clear();
+    lru_.clear();
+    size_in_bytes_ = 0;
+}
+
+void ResultCache::capacity(std::size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    evict();
+}
+
+void ResultCache::print_statistics(std::ostream &out) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    out << "Result cache: " << num_hits_ << " hits (" << num_shared_ << " shared with concurrent queries), "
+        << num_misses_ << " misses, " << num_evictions_
+        << " evictions, " << entries_.size() << " results of " << size_in_bytes_ << " of " << capacity_
+        << " bytes\n";
+}
+
+void ResultCache::erase(std::unordered_map<key_type, slot_type>::iterator it)
+{
+    size_in_bytes_ -= it->second.entry->size_in_bytes;
+    lru_.erase(it->second.lru_pos);
+    entries_.erase(it);
+}
+
+void ResultCache::finish(const key_type &key)
+{
+    if (auto it = pending_.find(key); it != pending_.end()) {
+        it->second->finished = true;
+        it->second->cv.notify_all();
+        pending_.erase(it);
+    }
+}
+
+void ResultCache::evict()
+{
+    while (size_in_bytes_ > capacity_) {
+        M_insist(not lru_.empty());
+        erase(entries_.find(lru_.back()));
+        ++num_evictions_;
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace m {
+
+/** Caches the results of read-only queries, such that a query that is issued repeatedly against tables that did not
+ * change since is answered without optimizing, compiling, and executing it.  A query is identified by the name of the
+ * database in use and its fully-parenthesized SQL as printed by the `ASTPrinter`, i.e. queries that only differ in
+ * whitespace or in the case of keywords share their result.
+ *
+ * Every table has a version that is incremented whenever the table is modified, i.e. by `INSERT`, `IMPORT`, and DDL.
+ * The versions of the tables read by a query are captured *before* the query is executed and stored with its result.
+ * Incrementing the version of a table discards all results that read the table, and a result whose captured versions
+ * are outdated when it is inserted is not cached at all, since the table was modified while the query was executed.
+ *
+ * The size of all cached results is bounded by a capacity in bytes.  When a result is inserted into a full cache, the
+ * least recently used results are evicted.
+ *
+ * Identical queries issued concurrently, e.g. by a reporting job submitting a batch of queries at once, are executed
+ * only once: the first query announces that it computes the result, and the others wait for its result instead of
+ * computing it themselves, see `find_or_wait()`. */
+struct ResultCache
+{
+    using key_type = std::string;
+    ///> the tables read by a query and their versions; the entry of `nullptr` is the version of the entire cache
+    using versions_type = std::vector<std::pair<const Table*, uint64_t>>;
+
+    /** A cached query result. */
+    struct entry_type
+    {
+        Schema schema;
+        std::vector<Tuple> rows;
+        versions_type versions; ///< the versions of the tables read when the result was computed
+        std::size_t size_in_bytes;
+    };
+
+    private:
+    struct slot_type
+    {
+        std::shared_ptr<const entry_type> entry;
+        std::list<key_type>::iterator lru_pos; ///< the position of the key in `lru_`
+    };
+
+    /** A result currently computed by a query, which concurrent queries of the same key wait for. */
+    struct pending_type
+    {
+        std::condition_variable cv; ///< notified when the result is inserted or abandoned
+        bool finished = false;
+    };
+
+    ///> the cached results by key
+    std::unordered_map<key_type, slot_type> entries_;
+    ///> the keys of all cached results, from most to least recently used
+    std::list<key_type> lru_;
+    ///> the current version of every table that was modified or read by a cached query
+    std::unordered_map<const Table*, uint64_t> versions_;
+    ///> the results currently computed, by key
+    std::unordered_map<key_type, std::shared_ptr<pending_type>> pending_;
+    std::size_t size_in_bytes_ = 0;
+    std::size_t capacity_;
+    std::size_t num_hits_ = 0;
+    std::size_t num_misses_ = 0;
+    std::size_t num_evictions_ = 0;
+    std::size_t num_shared_ = 0; ///< the number of hits that waited for a concurrently computed result
+    mutable std::mutex mutex_;
+
+    ResultCache();
+
+    public:
+    static ResultCache & Get();
+
+    /** Returns `true` iff the results of queries should be cached. */
+    static bool enabled();
+
+    /** Returns the estimated size in bytes of a single cached row of schema \p S. */
+    static std::size_t Row_Size(const Schema &S);
+
+    /** Returns the result cached for \p key, or `nullptr` if there is none.  Returns a shared pointer, s.t. the result
+     * can be read while it is concurrently evicted. */
+    std::shared_ptr<const entry_type> find(const key_type &key);
+
+    /** Returns the result cached for \p key, like `find()`.  If there is none but a concurrent query is computing the
+     * result of \p key, waits until that query inserted or abandoned its result and returns the result, if it was
+     * cached.  Otherwise, returns `nullptr` and sets \p announced iff the caller is now announced to compute the result
+     * of \p key.  An announced caller must eventually `insert()` or `abandon()` the result, s.t. waiting queries
+     * resume. */
+    std::shared_ptr<const entry_type> find_or_wait(const key_type &key, bool &announced);
+
+    /** Withdraws the announcement of `find_or_wait()` to compute the result of \p key, e.g. because the query failed or
+     * its result exceeds the capacity, and lets the queries waiting for the result compute it themselves. */
+    void abandon(const key_type &key);
+
+    /** Returns the current versions of the \p tables. */
+    versions_type versions(const std::vector<const Table*> &tables);
+
+    /** Caches the \p rows of schema \p S as the result of \p key computed from the tables of versions \p versions.
+     * The result is not cached if it exceeds the capacity or if any of the tables was modified since its version was
+     * captured.  Returns `true` iff the result was cached.  Resumes the queries waiting for the result of \p key. */
+    bool insert(key_type key, Schema S, std::vector<Tuple> rows, versions_type versions);
+
+    /** Increments the version of \p table, discarding all results that read \p table. */
+    void invalidate(const Table &table);
+
+    /** Discards all cached results, e.g. when tables are dropped. */
+    void clear();
+
+    std::size_t capacity() const { std::lock_guard<std::mutex> lock(mutex_); return capacity_; }
+    /** Sets the capacity to \p capacity bytes, evicting results if necessary. */
+    void capacity(std::size_t capacity);
+
+    std::size_t size() const { std::lock_guard<std::mutex> lock(mutex_); return entries_.size(); }
+    std::size_t size_in_bytes() const { std::lock_guard<std::mutex> lock(mutex_); return size_in_bytes_; }
+    std::size_t num_hits() const { std::lock_guard<std::mutex> lock(mutex_); return num_hits_; }
+    std::size_t num_misses() const { std::lock_guard<std::mutex> lock(mutex_); return num_misses_; }
+    std::size_t num_evictions() const { std::lock_guard<std::mutex> lock(mutex_); return num_evictions_; }
+    std::size_t num_shared() const { std::lock_guard<std::mutex> lock(mutex_); return num_shared_; }
+
+    /** Writes the statistics of the cache to \p out. */
+    void print_statistics(std::ostream &out) const;
+
+    private:
+    /** Removes the result at \p it.  Requires `mutex_` to be held. */
+    void erase(std::unordered_map<key_type, slot_type>::iterator it);
+    /** Resumes the queries waiting for the result of \p key, if any.  Requires `mutex_` to be held. */
+    void finish(const key_type &key);
+    /** Evicts least recently used results until the cached results fit into the capacity.  Requires `mutex_` to be
+     * held. */
+    void evict();
+};
+
+}
@@ -0,0 +1,11 @@
+#include "catalog/ResultSinks.hpp"
+
+
+using namespace m;
+
+
+ResultSinks & ResultSinks::Get()
+{
+    static ResultSinks the_sinks;
+    return the_sinks;
+}
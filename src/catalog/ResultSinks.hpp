@@ -0,0 +1,52 @@
+#pragma once
+
+#include <functional>
+#include <mutable/catalog/Scheduler.hpp>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutex>
+#include <unordered_map>
+
+
+namespace m {
+
+/** The consumers of the results of the queries of transactions, e.g. of the transactions of clients of
+ * `mutable-server`.  The results of a query of a transaction with a sink are passed tuple by tuple to the sink, instead
+ * of printing them.  Sinks are registered by transaction since the command of a query is created by the scheduler,
+ * possibly in another thread than the one that scheduled it. */
+struct ResultSinks
+{
+    using sink_type = std::function<void(const Schema&, const Tuple&)>;
+
+    private:
+    ///> the sinks by transaction
+    std::unordered_map<const Scheduler::Transaction*, sink_type> sinks_;
+    mutable std::mutex mutex_;
+
+    ResultSinks() = default;
+
+    public:
+    static ResultSinks & Get();
+
+    /** Passes the results of all subsequent queries of transaction \p t to \p sink. */
+    void add(const Scheduler::Transaction &t, sink_type sink) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sinks_[&t] = std::move(sink);
+    }
+
+    /** Returns the sink of transaction \p t, or `nullptr` if the results of \p t are printed. */
+    const sink_type * find(const Scheduler::Transaction *t) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto it = sinks_.find(t); it != sinks_.end())
+            return &it->second;
+        return nullptr;
+    }
+
+    /** Removes the sink of transaction \p t.  Must be called before \p t is committed or aborted. */
+    void remove(const Scheduler::Transaction &t) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sinks_.erase(&t);
+    }
+};
+
+}
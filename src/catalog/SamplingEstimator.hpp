@@ -0,0 +1,134 @@
+#pragma once
+
+#include "util/hash.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutable/catalog/CardinalityEstimator.hpp>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/CNF.hpp>
+#include <mutable/IR/QueryGraph.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/util/Pool.hpp>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace m {
+
+/** Estimates cardinalities by evaluating the filters and join conditions of a query on uniform random samples of its
+ * tables.  Since predicates are evaluated by a `StackMachine` on actual tuples, arbitrary predicates, e.g. `LIKE` or
+ * predicates on correlated attributes, are estimated as accurately as the sample allows.
+ *
+ * Every table has a reservoir sample of at most `SAMPLE_SIZE` rows, which is drawn when the table is first scanned by
+ * an estimate.  Rows appended by `INSERT` or `IMPORT` since are fed into the reservoir on the next estimate, such that
+ * the sample remains uniform without rescanning the table.  A join condition is evaluated clause by clause on the cross
+ * product of the filtered samples of the two data sources a clause references, assuming independence of the clauses.
+ * If a clause is not satisfied by any pair of sampled rows, its selectivity is estimated from the distinct values of
+ * the joined columns, see `ColumnSketches`. */
+struct SamplingEstimator : CardinalityEstimator
+{
+    ///> the maximum number of rows sampled per table
+    static constexpr std::size_t SAMPLE_SIZE = 1024;
+    ///> the maximum number of filtered sample rows per data source that a join clause is evaluated on
+    static constexpr std::size_t JOIN_SAMPLE_SIZE = 256;
+
+    ///> the sampled tuples of a table; tuples are shared by all samples of the table that contain them
+    using sample_type = std::vector<std::shared_ptr<Tuple>>;
+
+    /** The sample of a data source, restricted to the sampled rows that satisfy the filter of the data source. */
+    struct FilteredSample
+    {
+        std::shared_ptr<const sample_type> tuples; ///< the sampled tuples of the table
+        ///> the schema of the sampled tuples, qualified by the name of the data source
+        Schema schema;
+        ///> the indices of the sampled tuples that satisfy the filter of the data source
+        std::vector<uint32_t> rows;
+        ///> the number of rows of the table
+        std::size_t num_table_rows = 0;
+
+        private:
+        ///> the selectivities of join clauses with another filtered sample, computed so far
+        mutable std::unordered_map<std::vector<uintptr_t>, double> selectivities_;
+        mutable std::mutex mutex_;
+
+        friend struct SamplingEstimator;
+    };
+
+    struct SamplingDataModel : DataModel
+    {
+        friend struct SamplingEstimator;
+
+        private:
+        Subproblem subproblem_;
+        double size_; ///< the estimated number of rows
+        ///> the filtered samples of the data sources in `subproblem_` that have a sample, e.g. base tables
+        std::vector<std::shared_ptr<const FilteredSample>> samples_;
+
+        public:
+        SamplingDataModel(Subproblem subproblem, double size,
+                          std::vector<std::shared_ptr<const FilteredSample>> samples = {})
+            : subproblem_(subproblem), size_(size), samples_(std::move(samples))
+        { }
+
+        double size() const { return size_; }
+    };
+
+    private:
+    /** The reservoir sample of a table. */
+    struct TableSample
+    {
+        std::shared_ptr<const sample_type> tuples; ///< the current reservoir, replaced when it changes
+        std::vector<std::size_t> row_ids; ///< the row id of each sampled tuple
+        std::size_t num_rows_seen = 0; ///< the number of rows of the table fed into the reservoir
+        std::mt19937_64 g; ///< the random generator of the reservoir
+    };
+
+    ///> the samples of the tables, by table name
+    mutable std::unordered_map<ThreadSafePooledString, TableSample> samples_;
+    mutable std::mutex mutex_;
+
+    public:
+    SamplingEstimator(ThreadSafePooledString) { }
+
+    /*----- Model calculation ----------------------------------------------------------------------------------------*/
+    std::unique_ptr<DataModel> empty_model() const override;
+    std::unique_ptr<DataModel> estimate_scan(const QueryGraph &G, Subproblem P) const override;
+    std::unique_ptr<DataModel>
+    estimate_filter(const QueryGraph &G, const DataModel &data, const cnf::CNF &filter) const override;
+    std::unique_ptr<DataModel>
+    estimate_limit(const QueryGraph &G, const DataModel &data, std::size_t limit, std::size_t offset) const override;
+    std::unique_ptr<DataModel>
+    estimate_grouping(const QueryGraph &G, const DataModel &data, const std::vector<group_type> &groups) const override;
+    std::unique_ptr<DataModel>
+    estimate_join(const QueryGraph &G, const DataModel &left, const DataModel &right,
+                  const cnf::CNF &condition) const override;
+
+    template<typename PlanTable>
+    std::unique_ptr<DataModel>
+    operator()(estimate_join_all_tag, PlanTable &&PT, const QueryGraph &G, Subproblem to_join,
+               const cnf::CNF &condition) const;
+
+    /*----- Interpretation -------------------------------------------------------------------------------------------*/
+    std::size_t predict_cardinality(const DataModel &data) const override;
+
+    void print(std::ostream &out) const override;
+
+    private:
+    /** Returns the reservoir sample of \p table, after feeding all rows appended since the last call into it. */
+    std::shared_ptr<const sample_type> sample(const Table &table) const;
+
+    /** Returns the model of joining the data sources of \p models under \p condition. */
+    std::unique_ptr<SamplingDataModel>
+    join(const std::vector<const SamplingDataModel*> &models, const cnf::CNF &condition) const;
+
+    /** Returns the selectivity of \p clause, estimated on the filtered samples referenced by the clause among
+     * \p samples. */
+    static double selectivity(const cnf::Clause &clause,
+                              const std::vector<std::shared_ptr<const FilteredSample>> &samples);
+};
+
+}
@@ -1,37 +1,50 @@
 #include "catalog/SerialScheduler.hpp"
+#include "catalog/Compaction.hpp"
+#include "catalog/Maintenance.hpp"
+#include "catalog/Replication.hpp"
+#include "catalog/WriteAheadLog.hpp"
 #include "parse/Sema.hpp"
+#include "util/WorkerPool.hpp"
 #include <mutable/mutable.hpp>
 
 
 using namespace m;
 
 
+bool SerialScheduler::CommandQueue::has_next() const
+{
+    // if there is a running transaction, only its commands are returned
+    if (running_transaction_)
+        return commands_.contains(running_transaction_);
+    // otherwise, the first command of the first waiting transaction is returned
+    return not waiting_transactions_.empty();
+}
+
 std::optional<m::Scheduler::queued_command> SerialScheduler::CommandQueue::pop()
 {
     std::unique_lock<std::mutex> lock(mutex_);
-    has_element_.wait(lock, []{
+    has_element_.wait(lock, [this]{
         // always wake up if the queue is closed
-        if (query_queue_.closed_) [[unlikely]]
-            return true;
-        // keep waiting if the queue is empty but not closed
-        else if (query_queue_.command_list_.empty())
-            return false;
-        // wake up if there is no running_transaction_ or if the next command is from the running_transaction_
-        else if (not query_queue_.running_transaction_ or std::get<0>(query_queue_.command_list_.front()) == *query_queue_.running_transaction_)
+        if (closed_) [[unlikely]]
             return true;
-        // otherwise keep waiting
-        else
-            return false;
+        // wake up if there is a command of the running transaction or, if there is none, of any transaction
+        return has_next();
     });
-    // if the queue is still empty here the queue should be closed.
-    if (command_list_.empty()) [[unlikely]] return std::nullopt;
+    // if the queue is closed here, it has been emptied
+    if (closed_) [[unlikely]] return std::nullopt;
 
-    queued_command res = std::move(command_list_.front());
-    command_list_.pop_front();
+    // if there is currently no running transaction, set the next waiting transaction as the running transaction
+    if (not running_transaction_) {
+        running_transaction_ = waiting_transactions_.front();
+        waiting_transactions_.pop_front();
+    }
 
-    // if there is currently no running transaction, set the next transaction in the queue as the running transaction
-    if (not running_transaction_)
-        running_transaction_ = &std::get<0>(res);
+    auto it = commands_.find(running_transaction_);
+    M_insist(it != commands_.end(), "running transaction must have queued commands");
+    queued_command res = std::move(it->second.front());
+    it->second.pop_front();
+    if (it->second.empty())
+        commands_.erase(it);
 
     return {std::move(res)};
 }
@@ -46,17 +59,12 @@ void SerialScheduler::CommandQueue::push(Transaction &t, std::unique_ptr<ast::Co
         return;
     }
 
-    /* Check if transaction `t` already has elements in the queue, if not then check if the transaction is the currently
-     * running transaction. If yes, then emplace the command in the front, otherwise emplace at the end. */
-    auto it = std::find_if(command_list_.rend(), command_list_.rbegin(),
-            [&t](queued_command &x){ return (t == std::get<0>(x)); }
-    );
-    if (running_transaction_ and *running_transaction_ == t and it == command_list_.rend())
-        command_list_.emplace_front(t, std::move(command), diag, std::move(promise));
-    else if (it == command_list_.rbegin())
-        command_list_.emplace_back(t, std::move(command), diag, std::move(promise));
-    else
-        command_list_.emplace(++it.base(), t, std::move(command), diag, std::move(promise));
+    /* Append the command to the commands of `t`.  If `t` had no queued commands and is not running, it starts waiting
+     * behind all other waiting transactions. */
+    auto &commands = commands_[&t];
+    if (commands.empty() and running_transaction_ != &t)
+        waiting_transactions_.push_back(&t);
+    commands.emplace_back(t, std::move(command), diag, std::move(promise));
 
     lock.unlock();
     has_element_.notify_one();
@@ -66,10 +74,12 @@ void SerialScheduler::CommandQueue::close()
 {
     std::unique_lock<std::mutex> lock(mutex_);
     closed_ = true;
-    while (not command_list_.empty()) {
-        std::get<3>(command_list_.front()).set_value(false);
-        command_list_.pop_front();
+    for (auto &[_, commands] : commands_) {
+        for (auto &command : commands)
+            std::get<3>(command).set_value(false);
     }
+    commands_.clear();
+    waiting_transactions_.clear();
     lock.unlock();
     has_element_.notify_all();
 }
@@ -77,13 +87,16 @@ void SerialScheduler::CommandQueue::close()
 bool SerialScheduler::CommandQueue::is_closed()
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    return query_queue_.closed_;
+    return closed_;
 }
 
 void SerialScheduler::CommandQueue::stop_transaction(Transaction &t) {
     std::unique_lock<std::mutex> lock(mutex_);
     M_insist(&t == running_transaction_);
     running_transaction_ = nullptr;
+    // remaining commands of `t` are executed next
+    if (commands_.contains(&t))
+        waiting_transactions_.push_front(&t);
     lock.unlock();
     has_element_.notify_one();
 }
@@ -119,17 +132,25 @@ bool SerialScheduler::commit(std::unique_ptr<SerialScheduler::Transaction> t) {
     /* TODO: When autocommit is not used as the default anymore, the transaction must check for conflicts with
      * other transactions that were introduced in the time between when this transaction executed statements and now. */
     query_queue_.stop_transaction(*t);
+    /* Wait for the logged rows only after the next transaction may run, such that it can join the sync of the log. */
+    WriteAheadLog::Get().commit(*t);
+    Replication::Get().commit(*t); // ship only durable changes
+    Compaction::Get().transaction_ended(*t);
     return true;
 }
 
 bool SerialScheduler::abort(std::unique_ptr<SerialScheduler::Transaction> t) {
     /* TODO: Undo changes of transaction */
     query_queue_.stop_transaction(*t);
+    WriteAheadLog::Get().abort(*t);
+    Replication::Get().abort(*t);
+    Compaction::Get().transaction_ended(*t);
     return true;
 }
 
 void SerialScheduler::schedule_thread()
 {
+    WorkerPool::Pin_To_Reserved_CPUs();
     Catalog &C = Catalog::Get();
     while (not query_queue_.is_closed()) {
         auto ret = query_queue_.pop();
@@ -139,12 +160,14 @@ void SerialScheduler::schedule_thread()
         auto [t, ast, diag, promise] = std::move(ret.value());
 
         // check if transaction has a start_time, set one if not. -1 represents an undefined value.
-        if (t.start_time() == -1) t.start_time(next_start_time++);
+        if (t.start_time() == -1)
+            Compaction::Get().transaction_started(t, next_start_time); // keeps the versions `t` sees until it ends
         /* TODO: Implement overflow handling: if the transaction timestamps overflow, then outdated versions of tuples
          * can become visible and other weird behaviour can occur. For this to happen, (2^63)-1 Transactions need to
          * run without every restarting mutable. */
         if (next_start_time < 0) [[unlikely]] M_unreachable("Transaction timestamp overflow");
 
+        Maintenance::Get().command_started();
         ast::Sema sema(diag);
         bool err = diag.num_errors() > 0; // parser errors
 
@@ -156,10 +179,9 @@ void SerialScheduler::schedule_thread()
         if (not err and cmd) {
             cmd->transaction(&t);
             cmd->execute(diag);
-            promise.set_value(true);
-            continue;
         }
-        promise.set_value(false);
+        Maintenance::Get().command_finished();
+        promise.set_value(not err and cmd);
     }
 }
 
@@ -2,9 +2,11 @@
 
 #include <mutable/catalog/Scheduler.hpp>
 #include <condition_variable>
-#include <list>
+#include <deque>
 #include <future>
+#include <optional>
 #include <thread>
+#include <unordered_map>
 
 
 namespace m {
@@ -15,12 +17,17 @@ namespace m {
 struct SerialScheduler : Scheduler
 {
     private:
-    /** A thread-safe query plan queue. */
+    /** A thread-safe query plan queue.  Commands are queued per transaction, such that both pushing a command and
+     * popping the next command are in constant time, independent of the number of queued commands. */
     struct CommandQueue
     {
         private:
-        std::list<queued_command> command_list_;
-        Transaction *running_transaction_; ///< the currently running transaction. Only commands by this transaction are returned.
+        ///> the queued commands of each transaction with queued commands, in FIFO order
+        std::unordered_map<const Transaction*, std::deque<queued_command>> commands_;
+        ///> the transactions with queued commands, except the running transaction, in order of arrival of their first
+        ///> queued command
+        std::deque<Transaction*> waiting_transactions_;
+        Transaction *running_transaction_ = nullptr; ///< the currently running transaction. Only commands by this transaction are returned.
         std::mutex mutex_;
         std::condition_variable has_element_;
         bool closed_ = false;
@@ -31,13 +38,17 @@ struct SerialScheduler : Scheduler
 
         ///> returns the next queued `ast::Command`. Returns `std::nullopt` if the queue is closed.
         std::optional<queued_command> pop();
-        /** Inserts the command into the queue. Internally the position in the `command_list_` is determined by the
-         * start time of `Transaction t`. A smaller start time is inserted before a larger start time and elements
-         * with the same start time are ordered in FIFO order by the time of arrival. */
+        /** Inserts the command into the queue.  Commands of the same transaction are returned in FIFO order.  The
+         * commands of the running transaction are returned first, those of other transactions in order of arrival of
+         * the transaction's first queued command. */
         void push(Transaction &t, std::unique_ptr<ast::Command> command, Diagnostic &diag, std::promise<bool> promise);
         void close();    ///< empties and closes the queue without executing the remaining `ast::Command`s.
         bool is_closed();  ///< signals waiting threads that no more elements will be pushed
         void stop_transaction(Transaction &t); ///< Marks `t` as no longer running.
+
+        private:
+        /** Returns `true` iff there is a command that can be popped.  Must be called with `mutex_` locked. */
+        bool has_next() const;
     };
 
     static CommandQueue query_queue_; ///< instance of our thread-safe query queue that stores all incoming plans.
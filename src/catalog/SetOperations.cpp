@@ -0,0 +1,227 @@
+#include "catalog/SetOperations.hpp"
+
+#include <cctype>
+#include <cstdint>
+#include <iterator>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/parse/AST.hpp>
+#include <mutable/util/exception.hpp>
+#include <mutable/util/macro.hpp>
+#include <optional>
+#include <sstream>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+
+using namespace m;
+
+
+namespace {
+
+/** Computes the hash of all values of a row. */
+struct hasher
+{
+    std::size_t num_values;
+
+    hasher(std::size_t num_values) : num_values(num_values) { }
+
+    uint64_t operator()(const Tuple &tup) const {
+        std::hash<Value> h;
+        uint64_t hash = 0xcbf29ce484222325;
+        for (std::size_t i = 0; i != num_values; ++i) {
+            hash ^= tup.is_null(i) ? 0 : h(tup[i]);
+            hash *= 1099511628211;
+        }
+        return hash;
+    }
+};
+
+/** Compares two rows by all their values, considering `NULL`s equal. */
+struct equals
+{
+    std::size_t num_values;
+
+    equals(std::size_t num_values) : num_values(num_values) { }
+
+    bool operator()(const Tuple &first, const Tuple &second) const {
+        for (std::size_t i = 0; i != num_values; ++i) {
+            if (first.is_null(i) != second.is_null(i)) return false;
+            if (not first.is_null(i))
+                if (first.get(i) != second.get(i)) return false;
+        }
+        return true;
+    }
+};
+
+using set_type = std::unordered_set<Tuple, hasher, equals>;
+
+/** Returns `true` iff \p word is the keyword \p keyword, ignoring case. */
+bool is_keyword(std::string_view word, std::string_view keyword)
+{
+    if (word.size() != keyword.size()) return false;
+    for (std::size_t i = 0; i != word.size(); ++i)
+        if (std::toupper(static_cast<unsigned char>(word[i])) != keyword[i]) return false;
+    return true;
+}
+
+/** Moves the rows of \p set to the end of \p rows. */
+void drain(set_type &set, std::vector<Tuple> &rows)
+{
+    rows.reserve(rows.size() + set.size());
+    while (not set.empty())
+        rows.push_back(std::move(set.extract(set.begin()).value()));
+}
+
+/** Returns the distinct rows of \p rows, which have \p num_values values. */
+std::vector<Tuple> distinct(std::vector<Tuple> rows, std::size_t num_values)
+{
+    set_type set(rows.size(), hasher(num_values), equals(num_values));
+    for (auto &row : rows)
+        set.insert(std::move(row));
+    rows.clear();
+    drain(set, rows);
+    return rows;
+}
+
+/** Returns the distinct rows of \p left that are contained in \p right iff \p contained, i.e. computes \p left
+ * `INTERSECT` \p right if \p contained and \p left `EXCEPT` \p right otherwise.  The rows have \p num_values values. */
+std::vector<Tuple> probe(std::vector<Tuple> left, std::vector<Tuple> right, bool contained, std::size_t num_values)
+{
+    set_type build(right.size(), hasher(num_values), equals(num_values));
+    for (auto &row : right)
+        build.insert(std::move(row));
+    right = std::vector<Tuple>(); // release the operand early
+
+    set_type result(0, hasher(num_values), equals(num_values));
+    for (auto &row : left) {
+        if (build.contains(row) == contained)
+            result.insert(std::move(row));
+    }
+    std::vector<Tuple> rows;
+    drain(result, rows);
+    return rows;
+}
+
+}
+
+SetOperations::compound_query SetOperations::Parse(const std::vector<std::string> &words)
+{
+    compound_query query;
+    std::ostringstream select;
+    bool is_empty = true;
+    int depth = 0; ///< the nesting depth of parentheses
+    auto finish = [&]() {
+        if (is_empty)
+            throw invalid_argument("operand of set operator must not be empty");
+        select << ';';
+        query.selects.push_back(select.str());
+        select.str("");
+        is_empty = true;
+    };
+
+    for (std::size_t i = 0; i != words.size(); ++i) {
+        auto &word = words[i];
+        if (depth == 0) {
+            const bool has_next = i + 1 != words.size();
+            std::optional<set_operator> op;
+            if (is_keyword(word, "UNION")) {
+                op = UNION;
+                if (has_next and is_keyword(words[i + 1], "ALL")) {
+                    op = UNION_ALL;
+                    ++i;
+                } else if (has_next and is_keyword(words[i + 1], "DISTINCT")) {
+                    ++i;
+                }
+            } else if (is_keyword(word, "INTERSECT")) {
+                op = INTERSECT;
+            } else if (is_keyword(word, "EXCEPT")) {
+                op = EXCEPT;
+            }
+            if (op) {
+                if (*op != UNION_ALL and has_next and is_keyword(words[i + 1], "ALL"))
+                    throw invalid_argument("INTERSECT ALL and EXCEPT ALL are not supported");
+                finish();
+                query.operators.push_back(*op);
+                continue;
+            }
+        }
+        for (char c : word)
+            depth += (c == '(') - (c == ')');
+        select << word << ' ';
+        is_empty = false;
+    }
+    finish();
+
+    return query;
+}
+
+std::vector<Tuple> SetOperations::Combine(const Schema &S, std::vector<std::vector<Tuple>> results,
+                                          const std::vector<set_operator> &operators)
+{
+    M_insist(results.size() == operators.size() + 1, "every operator combines two operands");
+    const std::size_t num_values = S.num_entries();
+
+    /*----- Evaluate `INTERSECT` first, since it binds tighter. -----*/
+    std::vector<std::vector<Tuple>> terms;
+    std::vector<set_operator> term_operators;
+    terms.push_back(std::move(results[0]));
+    for (std::size_t i = 0; i != operators.size(); ++i) {
+        if (operators[i] == INTERSECT) {
+            terms.back() = probe(std::move(terms.back()), std::move(results[i + 1]), true, num_values);
+        } else {
+            terms.push_back(std::move(results[i + 1]));
+            term_operators.push_back(operators[i]);
+        }
+    }
+
+    /*----- Apply the remaining operators from left to right. -----*/
+    std::vector<Tuple> rows = std::move(terms[0]);
+    for (std::size_t i = 0; i != term_operators.size(); ++i) {
+        auto &term = terms[i + 1];
+        switch (term_operators[i]) {
+            case UNION_ALL:
+            case UNION:
+                rows.reserve(rows.size() + term.size());
+                std::move(term.begin(), term.end(), std::back_inserter(rows));
+                term = std::vector<Tuple>();
+                if (term_operators[i] == UNION)
+                    rows = distinct(std::move(rows), num_values);
+                break;
+
+            case EXCEPT:
+                rows = probe(std::move(rows), std::move(term), false, num_values);
+                break;
+
+            case INTERSECT:
+                M_unreachable("INTERSECT was already evaluated");
+        }
+    }
+
+    return rows;
+}
+
+std::vector<const Type*> SetOperations::Result_Types(const ast::SelectStmt &select)
+{
+    std::vector<const Type*> types;
+    auto &SELECT = as<const ast::SelectClause>(*select.select);
+    for (auto &e : SELECT.expanded_select_all) // `*` is expanded before the other projections
+        types.push_back(e->type());
+    for (auto &s : SELECT.select)
+        types.push_back(s.first->type());
+    return types;
+}
+
+bool SetOperations::Is_Compatible(const std::vector<const Type*> &first, const std::vector<const Type*> &second)
+{
+    if (first.size() != second.size()) return false;
+    auto vectorial = [](const Type *type) -> const Type* {
+        if (auto pt = cast<const PrimitiveType>(type))
+            return pt->as_vectorial();
+        return type;
+    };
+    for (std::size_t i = 0; i != first.size(); ++i) {
+        if (vectorial(first[i]) != vectorial(second[i])) return false;
+    }
+    return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <string>
+#include <vector>
+
+
+namespace m {
+
+namespace ast { struct SelectStmt; }
+
+/** Evaluates compound queries, i.e. `SELECT` statements combined by the set operators `UNION ALL`, `UNION`,
+ * `INTERSECT`, and `EXCEPT`, see `\compound_select`.  Each `SELECT` is optimized and executed on its own, such that
+ * its filters and projections are applied, and its partitions pruned, before the results are combined.  The queries
+ * are executed in parallel.
+ *
+ * `UNION ALL` concatenates the results without materializing them.  The other operators have set semantics: `UNION`
+ * eliminates duplicates of the concatenated results, `INTERSECT` and `EXCEPT` build a hash table of the distinct rows
+ * of their right operand and probe it with the rows of their left operand.  Two rows are duplicates iff their values
+ * are equal or both `NULL`.  Like in SQL, `INTERSECT` binds tighter than `UNION` and `EXCEPT`, which are applied from
+ * left to right. */
+struct SetOperations
+{
+    enum set_operator
+    {
+        UNION_ALL,
+        UNION,
+        INTERSECT,
+        EXCEPT,
+    };
+
+    /** A compound query. */
+    struct compound_query
+    {
+        std::vector<std::string> selects; ///< the `SELECT` statements, each terminated by `;`
+        ///> the operator combining `selects[i]` with the `selects` before it, at index `i - 1`
+        std::vector<set_operator> operators;
+
+        /** Returns `true` iff the results of the `selects` are only concatenated. */
+        bool is_concatenation() const {
+            for (auto op : operators)
+                if (op != UNION_ALL) return false;
+            return true;
+        }
+    };
+
+    /** Splits the words \p words of a compound query at the set operators outside of parentheses.  Throws
+     * `m::invalid_argument` if an operand is empty. */
+    static compound_query Parse(const std::vector<std::string> &words);
+
+    /** Combines the rows \p results of the `selects` of a compound query with its \p operators.  The rows have the
+     * schema \p S. */
+    static std::vector<Tuple> Combine(const Schema &S, std::vector<std::vector<Tuple>> results,
+                                      const std::vector<set_operator> &operators);
+
+    /** Returns the types of the attributes of the result of the analyzed query \p select, in the order of its
+     * projections. */
+    static std::vector<const Type*> Result_Types(const ast::SelectStmt &select);
+
+    /** Returns `true` iff the results of two operands of a set operator, whose attributes have the types \p first and
+     * \p second, are compatible, i.e. have the same number of attributes of the same types, regardless of whether
+     * the types are scalar or vectorial. */
+    static bool Is_Compatible(const std::vector<const Type*> &first, const std::vector<const Type*> &second);
+};
+
+}
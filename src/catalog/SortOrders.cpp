@@ -0,0 +1,146 @@
+#include "catalog/SortOrders.hpp"
+
+#include "backend/Interpreter.hpp"
+#include <cstring>
+#include <mutable/catalog/Catalog.hpp>
+#include <vector>
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** Whether to observe the orders of the columns of appended rows. */
+bool sort_order_detection = true;
+
+}
+
+__attribute__((constructor(201)))
+static void add_sort_orders_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<bool>(
+        /* group=       */ "Catalog",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-sort-order-detection",
+        /* description= */ "do not observe the sort order of appended rows; trust declared orders instead",
+        /* callback=    */ [](bool){ options::sort_order_detection = false; }
+    );
+}
+
+/** Returns a negative number, zero, or a positive number if \p left is less than, equal to, or greater than \p right,
+ * both of type \p ty. */
+int compare(const Type *ty, const Value &left, const Value &right)
+{
+    auto cmp = [](auto l, auto r) { return (l > r) - (l < r); };
+    if (ty->is_boolean()) return cmp(left.as_b(), right.as_b());
+    if (ty->is_float()) return cmp(left.as_f(), right.as_f());
+    if (ty->is_double()) return cmp(left.as_d(), right.as_d());
+    return cmp(left.as_i(), right.as_i());
+}
+
+}
+
+SortOrders & SortOrders::Get()
+{
+    static SortOrders the_orders;
+    return the_orders;
+}
+
+bool SortOrders::detection_enabled() { return options::sort_order_detection; }
+
+void SortOrders::update_unlocked(const ThreadSafePooledString &database_name, const Table &table)
+{
+    if (not detection_enabled()) return;
+
+    auto &T = orders_[database_name][table.name()];
+    const std::size_t num_rows = table.store().num_rows();
+    if (num_rows < T.num_rows_seen) { // the table was replaced by a smaller one, observe it anew
+        T.observed.clear();
+        T.num_rows_seen = 0;
+    }
+    if (num_rows == T.num_rows_seen)
+        return;
+
+    const Schema &schema = table.schema();
+    std::vector<ColumnOrder*> columns;
+    for (auto &e : schema)
+        columns.push_back(&T.observed[e.id.name]);
+
+    auto loader = Interpreter::compile_load(schema, table.store().memory().addr(), table.layout(), schema,
+                                            T.num_rows_seen);
+    Tuple tuple(schema);
+    Tuple *args[] = { &tuple };
+    for (std::size_t row = T.num_rows_seen; row != num_rows; ++row) {
+        loader(args);
+        for (std::size_t idx = 0; idx != schema.num_entries(); ++idx) {
+            auto &C = *columns[idx];
+            if (not C.asc and not C.desc) continue; // already unsorted
+            if (tuple.is_null(idx)) { // the position of NULL in an order is undefined
+                C.asc = C.desc = false;
+                continue;
+            }
+            const Type *ty = schema[idx].type;
+            if (ty->is_character_sequence()) {
+                const char *str = reinterpret_cast<const char*>(tuple[idx].as_p());
+                if (C.last) {
+                    const int cmp = std::strcmp(C.last_string.c_str(), str);
+                    C.asc = C.asc and cmp <= 0;
+                    C.desc = C.desc and cmp >= 0;
+                }
+                C.last_string = str;
+                C.last = tuple[idx];
+            } else {
+                if (C.last) {
+                    const int cmp = compare(ty, *C.last, tuple[idx]);
+                    C.asc = C.asc and cmp <= 0;
+                    C.desc = C.desc and cmp >= 0;
+                }
+                C.last = tuple[idx];
+            }
+        }
+    }
+    T.num_rows_seen = num_rows;
+}
+
+bool SortOrders::declare(const ThreadSafePooledString &database_name, const Table &table,
+                         const ThreadSafePooledString &attr, bool ascending)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    update_unlocked(database_name, table);
+    auto &T = orders_[database_name][table.name()];
+    if (detection_enabled()) {
+        auto it = T.observed.find(attr);
+        if (it != T.observed.end() and not (ascending ? it->second.asc : it->second.desc))
+            return false;
+    }
+    T.declared[attr] = ascending;
+    return true;
+}
+
+std::optional<bool> SortOrders::order(const ThreadSafePooledString &database_name, const Table &table,
+                                      const ThreadSafePooledString &attr)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    update_unlocked(database_name, table);
+    auto &T = orders_[database_name][table.name()];
+    auto declared = T.declared.find(attr);
+    if (not detection_enabled()) {
+        if (declared != T.declared.end()) return declared->second;
+        return std::nullopt;
+    }
+
+    auto observed = T.observed.find(attr);
+    if (observed == T.observed.end()) return std::nullopt; // e.g. a hidden attribute
+    auto &C = observed->second;
+    if (declared != T.declared.end() and (declared->second ? C.asc : C.desc))
+        return declared->second; // the declared order still holds
+    if (C.asc) return true;
+    if (C.desc) return false;
+    return std::nullopt;
+}
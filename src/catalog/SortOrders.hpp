@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/util/Pool.hpp>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+
+namespace m {
+
+/** Maintains the sort order of the columns of the tables of all databases.  A column is *sorted* if its values appear
+ * in ascending or descending order when the table is scanned, e.g. the timestamps of a time-ordered table.  Orders are
+ * *observed* by feeding the rows appended by `INSERT` and `IMPORT` when the rows are written, just like the
+ * `ColumnSketches`.  Since rows are only appended, the order of a column must only be compared to its last value.
+ * Additionally, orders are *declared* with the `\sorted_by` instruction.  A declared order fixes the direction of a
+ * column of equal values and, with `--no-sort-order-detection`, is trusted without observing the rows.
+ *
+ * The scans of the WebAssembly backend report the orders as `Sortedness` post-condition, such that sort-based
+ * operators, e.g. ordered grouping or sort merge join, are applicable and sorting can be omitted. */
+struct SortOrders
+{
+    private:
+    struct ColumnOrder
+    {
+        bool asc = true; ///< whether the values observed so far are in ascending order
+        bool desc = true; ///< whether the values observed so far are in descending order
+        std::optional<Value> last; ///< the last value observed, if any
+        std::string last_string; ///< the last value observed, if the column is a character sequence
+    };
+
+    struct TableOrders
+    {
+        ///> the observed orders of the columns, by attribute name
+        std::unordered_map<ThreadSafePooledString, ColumnOrder> observed;
+        ///> the declared orders of the columns, by attribute name, `true` for ascending
+        std::unordered_map<ThreadSafePooledString, bool> declared;
+        std::size_t num_rows_seen = 0; ///< the number of rows of the table observed
+    };
+
+    ///> the orders by database name and table name
+    std::unordered_map<ThreadSafePooledString, std::unordered_map<ThreadSafePooledString, TableOrders>> orders_;
+    mutable std::mutex mutex_;
+
+    SortOrders() = default;
+
+    public:
+    static SortOrders & Get();
+
+    /** Returns `true` iff orders are observed, see `--no-sort-order-detection`. */
+    static bool detection_enabled();
+
+    /** Observes the rows of \p table of the database \p database_name appended since the last update. */
+    void update(const ThreadSafePooledString &database_name, const Table &table) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        update_unlocked(database_name, table);
+    }
+
+    /** Observes the rows of \p table of the database \p database_name anew, e.g. after rows were overwritten by
+     * `DELETE` or `UPDATE`.  Declared orders are retained. */
+    void reset(const ThreadSafePooledString &database_name, const Table &table) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &T = orders_[database_name][table.name()];
+        T.observed.clear();
+        T.num_rows_seen = 0;
+        update_unlocked(database_name, table);
+    }
+
+    /** Declares \p attr of \p table of the database \p database_name to be sorted in ascending order iff \p ascending
+     * is set, in descending order otherwise.  Returns `false`, and declares nothing, if the rows of \p table
+     * contradict the order. */
+    bool declare(const ThreadSafePooledString &database_name, const Table &table, const ThreadSafePooledString &attr,
+                 bool ascending);
+
+    /** Returns `true` if \p attr of \p table of the database \p database_name is sorted in ascending order, `false` if
+     * it is sorted in descending order, and `std::nullopt` if it is not known to be sorted. */
+    std::optional<bool> order(const ThreadSafePooledString &database_name, const Table &table,
+                              const ThreadSafePooledString &attr);
+
+    /** Discards all orders. */
+    void clear() { std::lock_guard<std::mutex> lock(mutex_); orders_.clear(); }
+
+    private:
+    void update_unlocked(const ThreadSafePooledString &database_name, const Table &table);
+};
+
+}
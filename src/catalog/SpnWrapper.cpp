@@ -1,14 +1,61 @@
 #include "SpnWrapper.hpp"
+#include "backend/Interpreter.hpp"
+#include "util/WorkerPool.hpp"
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <vector>
+#include <mutable/catalog/Catalog.hpp>
 #include <mutable/mutable.hpp>
+#include <mutable/Options.hpp>
 #include <mutable/util/Diagnostic.hpp>
 
 using namespace m;
 using namespace Eigen;
 using namespace std;
 
+
+namespace {
+
+namespace options {
+
+/** The number of threads used to learn an SPN.  0 means all threads of the `WorkerPool`. */
+unsigned spn_learning_threads = 0;
+/** The number of rows sampled to learn an SPN.  0 means all rows. */
+std::size_t spn_sample_size = 0;
+
+}
+
+__attribute__((constructor(201)))
+static void add_spn_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<unsigned>(
+        /* group=       */ "Cardinality estimation",
+        /* short=       */ nullptr,
+        /* long=        */ "--spn-learning-threads",
+        /* description= */ "specify the number of threads used to learn SPNs (0 means all threads of the worker pool)",
+        /* callback=    */ [](unsigned spn_learning_threads){ options::spn_learning_threads = spn_learning_threads; }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Cardinality estimation",
+        /* short=       */ nullptr,
+        /* long=        */ "--spn-sample-size",
+        /* description= */ "learn SPNs on a uniform sample of the given number of rows per table (0 means all rows)",
+        /* callback=    */ [](std::size_t spn_sample_size){ options::spn_sample_size = spn_sample_size; }
+    );
+}
+
+/** Returns the number of threads to learn an SPN with. */
+std::size_t num_learning_threads()
+{
+    return options::spn_learning_threads ? options::spn_learning_threads : WorkerPool::Get().num_threads();
+}
+
+}
+
 SpnWrapper SpnWrapper::learn_spn_csv(const std::string &csv_file,
                                     std::vector<Spn::LeafType> leaf_types,
                                     const std::vector<std::size_t>& primary_key_columns)
@@ -108,7 +155,8 @@ SpnWrapper SpnWrapper::learn_spn_csv(const std::string &csv_file,
         }
     }
 
-    return SpnWrapper(Spn::learn_spn(data, null_matrix, leaf_types), std::move(attribute_to_id));
+    return SpnWrapper(Spn::learn_spn(data, null_matrix, leaf_types, num_learning_threads(), options::spn_sample_size),
+                      std::move(attribute_to_id));
 }
 
 unordered_map<string, SpnWrapper*> SpnWrapper::learn_spn_from_csvs(const vector<string> &csv_files, unordered_map<string, vector<Spn::LeafType>> leaf_types)
@@ -122,3 +170,161 @@ unordered_map<string, SpnWrapper*> SpnWrapper::learn_spn_from_csvs(const vector<
 
     return spns;
 }
+
+template<typename T>
+static void write_value(std::ostream &out, T value) { out.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+template<typename T>
+static T read_value(std::istream &in)
+{
+    T value;
+    if (not in.read(reinterpret_cast<char*>(&value), sizeof(value)))
+        throw invalid_argument("unexpected end of serialized SPN");
+    return value;
+}
+
+void SpnWrapper::save(std::ostream &out) const
+{
+    write_value<uint32_t>(out, attribute_to_id_.size());
+    for (auto &[attr, id] : attribute_to_id_) {
+        const std::string_view name(*attr);
+        write_value<uint32_t>(out, name.size());
+        out.write(name.data(), name.size());
+        write_value<uint32_t>(out, id);
+    }
+    write_value<uint64_t>(out, num_learned_rows_);
+    write_value<uint64_t>(out, num_inserted_rows_);
+    spn_.save(out);
+}
+
+SpnWrapper SpnWrapper::load(std::istream &in)
+{
+    auto &C = Catalog::Get();
+    std::unordered_map<ThreadSafePooledString, unsigned> attribute_to_id;
+    for (auto n = read_value<uint32_t>(in); n; --n) {
+        std::string name(read_value<uint32_t>(in), '\0');
+        if (not in.read(name.data(), name.size()))
+            throw invalid_argument("unexpected end of serialized SPN");
+        const auto id = read_value<uint32_t>(in);
+        attribute_to_id.emplace(C.pool(name.c_str()), id);
+    }
+    const auto num_learned_rows = read_value<uint64_t>(in);
+    const auto num_inserted_rows = read_value<uint64_t>(in);
+
+    SpnWrapper spn(Spn::load(in), std::move(attribute_to_id));
+    spn.num_learned_rows_ = num_learned_rows;
+    spn.num_inserted_rows_ = num_inserted_rows;
+    return spn;
+}
+
+
+/*======================================================================================================================
+ * SpnMaintenance
+ *====================================================================================================================*/
+
+SpnMaintenance & SpnMaintenance::Get()
+{
+    static SpnMaintenance the_maintenance;
+    return the_maintenance;
+}
+
+void SpnMaintenance::add(const ThreadSafePooledString &database_name, const ThreadSafePooledString &table_name,
+                         SpnWrapper &spn)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    spns_[database_name].insert_or_assign(table_name, &spn);
+}
+
+void SpnMaintenance::remove(const SpnWrapper &spn)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &[_, tables] : spns_) {
+        for (auto it = tables.begin(); it != tables.end();) {
+            if (it->second == &spn)
+                it = tables.erase(it);
+            else
+                ++it;
+        }
+    }
+}
+
+void SpnMaintenance::rows_appended(const ThreadSafePooledString &database_name, const Table &table,
+                                   std::size_t first_row)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto db_it = spns_.find(database_name);
+    if (db_it == spns_.end()) return;
+    auto it = db_it->second.find(table.name());
+    if (it == db_it->second.end()) return;
+    SpnWrapper &spn = *it->second;
+
+    const std::size_t num_rows = table.store().num_rows();
+    if (first_row >= num_rows) return;
+    const bool was_stale = spn.is_stale();
+
+    /* Locate the attributes of the SPN in the schema of the table.  Attributes whose values cannot be translated to
+     * the values the SPN was learned on prevent maintaining the SPN. */
+    const Schema &schema = table.schema();
+    std::vector<std::pair<std::size_t, unsigned>> columns; // index in `schema` and SPN internal id
+    bool is_maintainable = true;
+    for (auto &[attr, id] : spn.get_attribute_to_id()) {
+        auto schema_it = schema.find({ table.name(), attr });
+        if (schema_it == schema.cend()) {
+            is_maintainable = false;
+            break;
+        }
+        const Type *ty = schema_it->type;
+        if (not (ty->is_boolean() or ty->is_integral() or ty->is_float() or ty->is_double() or ty->is_date() or
+                 ty->is_date_time()))
+        {
+            is_maintainable = false;
+            break;
+        }
+        columns.emplace_back(std::distance(schema.cbegin(), schema_it), id);
+    }
+
+    if (is_maintainable) {
+        /* Load the appended rows and insert them in batches.  Rows with NULL are skipped since updates of an SPN cannot
+         * represent NULL. */
+        auto loader = Interpreter::compile_load(schema, table.store().memory().addr(), table.layout(), schema,
+                                                first_row);
+        Tuple tuple(schema);
+        Tuple *args[] = { &tuple };
+        MatrixXf batch(BATCH_SIZE, columns.size());
+        std::size_t batch_size = 0;
+        std::size_t num_skipped = 0;
+        for (std::size_t row = first_row; row != num_rows; ++row) {
+            loader(args);
+            bool has_null = false;
+            for (auto [idx, id] : columns) {
+                if (tuple.is_null(idx)) {
+                    has_null = true;
+                    break;
+                }
+                const Type *ty = schema[idx].type;
+                const Value &v = tuple[idx];
+                batch(batch_size, id) = ty->is_boolean() ? float(v.as_b())
+                                      : ty->is_float()   ? v.as_f()
+                                      : ty->is_double()  ? float(v.as_d())
+                                      :                    float(v.as_i());
+            }
+            if (has_null) {
+                ++num_skipped;
+                continue;
+            }
+            if (++batch_size == BATCH_SIZE) {
+                spn.insert_rows(batch);
+                batch_size = 0;
+            }
+        }
+        if (batch_size)
+            spn.insert_rows(batch.topRows(batch_size));
+        spn.skip_rows(num_skipped);
+    } else {
+        spn.skip_rows(num_rows - first_row);
+    }
+
+    if (not was_stale and spn.is_stale() and not Options::Get().quiet)
+        std::cerr << "warning: the SPN of table " << table.name() << " is stale after updates, consider relearning it "
+                  << "with `learn_spns`\n";
+}
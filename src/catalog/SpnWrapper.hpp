@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <mutable/catalog/Schema.hpp>
 #include <mutable/util/Pool.hpp>
+#include <mutex>
 #include <unordered_map>
 #include <util/Spn.hpp>
 #include <vector>
@@ -14,13 +17,19 @@ struct SpnWrapper
     using Filter = std::unordered_map<unsigned, std::pair<Spn::SpnOperator, float>>;
     using AttrFilter = std::unordered_map<ThreadSafePooledString, std::pair<Spn::SpnOperator, float>>;
 
+    ///> the fraction of rows inserted after learning, relative to the learned rows, after which an SPN is stale
+    static constexpr double STALENESS_THRESHOLD = 0.2;
+
     private:
     Spn spn_;
     std::unordered_map<ThreadSafePooledString, unsigned> attribute_to_id_; ///< a map from attribute to spn internal id
+    std::size_t num_learned_rows_; ///< the number of rows the SPN was learned on
+    std::size_t num_inserted_rows_ = 0; ///< the number of rows inserted or skipped since learning
 
     SpnWrapper(Spn spn, std::unordered_map<ThreadSafePooledString, unsigned> attribute_to_id)
         : spn_(std::move(spn))
         , attribute_to_id_(std::move(attribute_to_id))
+        , num_learned_rows_(spn_.num_rows())
     { }
 
     Filter translate_filter(const AttrFilter &attr_filter) const {
@@ -77,6 +86,11 @@ struct SpnWrapper
     /** Compute the likelihood of the given filter predicates given by a map from spn internal id to the
      * respective operator and value. The predicates in the map are seen as conjunctions. */
     float likelihood(const Filter &filter) const { return spn_.likelihood(filter); };
+    /** Compute the likelihoods of many filters given by maps from spn internal id to the respective operator and value
+     * at once. */
+    void likelihoods(const std::vector<Filter> &filters, std::vector<float> &likelihoods) const {
+        spn_.likelihoods(filters, likelihoods);
+    }
 
     /** Compute the upper bound probability for continuous domains. */
     float upper_bound(const AttrFilter &attr_filter) const { return spn_.upper_bound(translate_filter(attr_filter)); };
@@ -106,6 +120,18 @@ struct SpnWrapper
     /** Delete the given row from the SPN. */
     void delete_row(Eigen::VectorXf &row) { spn_.delete_row(row); };
 
+    /** Insert the given rows, one row per matrix row, into the SPN. */
+    void insert_rows(const Eigen::MatrixXf &rows) { spn_.insert_rows(rows); num_inserted_rows_ += rows.rows(); }
+
+    /** Accounts \p num_rows rows written to the table that could not be inserted into the SPN, e.g. due to `NULL`. */
+    void skip_rows(std::size_t num_rows) { num_inserted_rows_ += num_rows; }
+
+    /** Returns `true` iff so many rows were inserted since learning that the structure of the SPN, which updates do
+     * not adapt, likely no longer fits the data and the SPN should be relearned. */
+    bool is_stale() const {
+        return num_inserted_rows_ > STALENESS_THRESHOLD * std::max<std::size_t>(num_learned_rows_, 1);
+    }
+
     /** Estimate the number of distinct values of the given attribute. */
     std::size_t estimate_number_distinct_values(const ThreadSafePooledString &attribute) const {
         return spn_.estimate_number_distinct_values(translate_attribute(attribute));
@@ -115,6 +141,12 @@ struct SpnWrapper
         return spn_.estimate_number_distinct_values(attribute_id);
     };
 
+    /** Writes the SPN and its mapping of attributes to \p out, such that it can be restored by `load()` without
+     * learning it again, e.g. when restarting. */
+    void save(std::ostream &out) const;
+    /** Reads an SPN written by `save()` from \p in.  Throws `invalid_argument` if \p in does not hold an SPN. */
+    static SpnWrapper load(std::istream &in);
+
     unsigned height() const { return spn_.height(); }
     unsigned breadth() const { return spn_.breadth(); }
     unsigned degree() const { return spn_.degree(); }
@@ -123,4 +155,45 @@ struct SpnWrapper
     void dump(std::ostream &out) const { spn_.dump(out); };
 };
 
+/** Keeps the SPNs used for cardinality estimation up to date with the rows appended to their tables.  SPN estimators
+ * register the SPNs they learned.  The write paths, i.e. `INSERT` and `IMPORT`, report the rows they appended, which are
+ * then inserted into the registered SPN of the table in batches.  When an SPN becomes stale, a warning is issued once. */
+struct SpnMaintenance
+{
+    ///> the number of rows inserted into an SPN at once
+    static constexpr std::size_t BATCH_SIZE = 1024;
+
+    private:
+    ///> the registered SPNs by database and table name
+    std::unordered_map<ThreadSafePooledString, std::unordered_map<ThreadSafePooledString, SpnWrapper*>> spns_;
+    mutable std::mutex mutex_;
+
+    SpnMaintenance() = default;
+
+    public:
+    static SpnMaintenance & Get();
+
+    /** Registers \p spn as the SPN of table \p table_name of database \p database_name. */
+    void add(const ThreadSafePooledString &database_name, const ThreadSafePooledString &table_name, SpnWrapper &spn);
+    /** Unregisters \p spn. */
+    void remove(const SpnWrapper &spn);
+
+    /** Inserts the rows of \p table of database \p database_name starting at row \p first_row into the registered
+     * SPN of \p table, if any. */
+    void rows_appended(const ThreadSafePooledString &database_name, const Table &table, std::size_t first_row);
+
+    /** Calls \p fn with the registered SPN of table \p table_name of database \p database_name, while no rows are
+     * inserted into it.  Returns `false` iff no SPN is registered for the table. */
+    template<typename Fn>
+    bool with_spn(const ThreadSafePooledString &database_name, const ThreadSafePooledString &table_name, Fn &&fn) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto db_it = spns_.find(database_name);
+        if (db_it == spns_.end()) return false;
+        auto it = db_it->second.find(table_name);
+        if (it == db_it->second.end()) return false;
+        fn(static_cast<const SpnWrapper&>(*it->second));
+        return true;
+    }
+};
+
 }
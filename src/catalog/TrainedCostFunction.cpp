@@ -18,7 +18,7 @@ double TrainedCostFunction::operator()(calculate_filter_cost_tag, PlanTable &&PT
     M_insist(cardinality > 0);
     auto selectivity = double(result_size) / double(cardinality);
 
-    Eigen::RowVectorXd feature_matrix(3);
+    static thread_local Eigen::RowVectorXd feature_matrix(3);
     feature_matrix << 1, // add 1 for y-intercept coefficient
             cardinality,
             selectivity;
@@ -38,12 +38,20 @@ double TrainedCostFunction::operator()(calculate_join_cost_tag, PlanTable &&PT,
     M_insist(cardinality_left > 0 and cardinality_right > 0);
     auto redundancy_left = cardinality_left / num_distinct_values_left;
     auto redundancy_right = cardinality_right / num_distinct_values_right;
-    // TODO before calculating the model for the join result, check whether we already have that model in the plan table
-    // to avoid recalculating it
-    auto post_join = CE.estimate_join(G, *PT[left].model, *PT[right].model, condition);
-    auto result_size = CE.predict_cardinality(*post_join);
 
-    Eigen::RowVectorXd feature_matrix(6);
+    /* The model of the join result is the same for every partition of `left|right`, hence reuse it once the plan table
+     * holds it and only estimate the join for the first partition. */
+    const Subproblem joined = left | right;
+    std::size_t result_size;
+    if (PT.has_plan(joined) and PT[joined].model) {
+        result_size = CE.predict_cardinality(*PT[joined].model);
+    } else {
+        auto post_join = CE.estimate_join(G, *PT[left].model, *PT[right].model, condition);
+        result_size = CE.predict_cardinality(*post_join);
+    }
+
+    /* Reuse the feature vector across calls to not allocate it for each of the many candidates of plan enumeration. */
+    static thread_local Eigen::RowVectorXd feature_matrix(6);
     feature_matrix << 1,    // add 1 for y-intercept coefficient
             cardinality_left,
             cardinality_right,
@@ -0,0 +1,386 @@
+#include "catalog/WriteAheadLog.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "catalog/ResultCache.hpp"
+#include "storage/PaxStore.hpp"
+#include "util/WorkerPool.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/storage/Store.hpp>
+#include <stdexcept>
+#include <unistd.h>
+#include <vector>
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** The path of the write-ahead log, `nullptr` if appended rows are not logged. */
+const char *wal = nullptr;
+/** The time in microseconds the flusher waits for further commits to join a sync. */
+unsigned wal_group_commit_delay = 1000;
+/** The number of pending bytes that triggers a sync without waiting for further commits. */
+std::size_t wal_group_commit_size = 1UL << 20;
+
+}
+
+__attribute__((constructor(201)))
+static void add_write_ahead_log_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<const char*>(
+        /* group=       */ "Write-ahead log",
+        /* short=       */ nullptr,
+        /* long=        */ "--wal",
+        /* description= */ "log the rows appended by INSERT and IMPORT to this file, replay them with \\recover",
+        /* callback=    */ [](const char *path){ options::wal = path; }
+    );
+    C.arg_parser().add<unsigned>(
+        /* group=       */ "Write-ahead log",
+        /* short=       */ nullptr,
+        /* long=        */ "--wal-group-commit-delay",
+        /* description= */ "the time in microseconds a sync of the log waits for further commits to join",
+        /* callback=    */ [](unsigned delay){ options::wal_group_commit_delay = delay; }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Write-ahead log",
+        /* short=       */ nullptr,
+        /* long=        */ "--wal-group-commit-size",
+        /* description= */ "the number of pending bytes of the log that triggers a sync without further waiting",
+        /* callback=    */ [](std::size_t size){ options::wal_group_commit_size = size; }
+    );
+}
+
+/** The magic number starting every record of the log. */
+constexpr uint32_t RECORD_MAGIC = 0x4c41574d; // "MWAL"
+
+/** Computes the FNV-1a hash of the \p size bytes at \p data, used to detect torn records. */
+uint64_t checksum(const char *data, std::size_t size)
+{
+    uint64_t h = 0xcbf29ce484222325UL;
+    for (auto p = data, end = data + size; p != end; ++p) {
+        h ^= uint8_t(*p);
+        h *= 0x100000001b3UL;
+    }
+    return h;
+}
+
+template<typename T>
+void put(std::string &buf, T value) { buf.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+void put(std::string &buf, const char *str, uint32_t length)
+{
+    put(buf, length);
+    buf.append(str, length);
+}
+
+/** Reads the values of a record. */
+struct RecordReader
+{
+    private:
+    const char *pos_;
+    const char *end_;
+
+    public:
+    RecordReader(const char *begin, const char *end) : pos_(begin), end_(end) { }
+
+    bool exhausted() const { return pos_ == end_; }
+
+    template<typename T>
+    T get() {
+        if (std::size_t(end_ - pos_) < sizeof(T)) throw std::out_of_range("record too short");
+        T value;
+        std::memcpy(&value, pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+    }
+
+    const char * get_bytes(std::size_t n) {
+        if (std::size_t(end_ - pos_) < n) throw std::out_of_range("record too short");
+        auto bytes = pos_;
+        pos_ += n;
+        return bytes;
+    }
+
+    std::string get_string() {
+        const auto length = get<uint32_t>();
+        return std::string(get_bytes(length), length);
+    }
+};
+
+[[noreturn]] void fail(const char *what)
+{
+    const auto errsv = errno;
+    std::cerr << "FATAL: Could not " << what << " the write-ahead log " << options::wal << ": " << strerror(errsv)
+              << std::endl;
+    std::abort(); // the log cannot be trusted anymore, see PostgreSQL's fsync handling
+}
+
+}
+
+WriteAheadLog::~WriteAheadLog()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    flush_.notify_one();
+    if (flusher_.joinable())
+        flusher_.join();
+    if (fd_ != -1)
+        close(fd_);
+}
+
+WriteAheadLog & WriteAheadLog::Get()
+{
+    static WriteAheadLog the_log;
+    return the_log;
+}
+
+bool WriteAheadLog::enabled() { return options::wal != nullptr; }
+
+void WriteAheadLog::log_rows(const Scheduler::Transaction &t, const ThreadSafePooledString &database_name,
+                             const Table &table, std::size_t first_row)
+{
+    const std::size_t num_rows = table.store().num_rows();
+    if (not enabled() or first_row >= num_rows) return;
+
+    /*----- Load the appended rows. -----*/
+    const Schema &schema = table.schema();
+    const std::size_t count = num_rows - first_row;
+    std::vector<Tuple> rows;
+    rows.reserve(count);
+    auto loader = Interpreter::compile_load(schema, table.store().memory().addr(), table.layout(), schema, first_row);
+    for (std::size_t row = 0; row != count; ++row) {
+        Tuple *args[] = { &rows.emplace_back(schema) };
+        loader(args);
+    }
+
+    /*----- Serialize the rows column by column. -----*/
+    std::string payload;
+    put(payload, *database_name, strlen(*database_name));
+    put(payload, *table.name(), strlen(*table.name()));
+    put(payload, uint64_t(count));
+    put(payload, uint32_t(schema.num_entries()));
+    for (std::size_t idx = 0; idx != schema.num_entries(); ++idx) {
+        const Type *ty = schema[idx].type;
+        put(payload, *schema[idx].id.name, strlen(*schema[idx].id.name));
+
+        /* NULL bitmap */
+        std::string nulls((count + 7) / 8, '\0');
+        for (std::size_t row = 0; row != count; ++row) {
+            if (rows[row].is_null(idx))
+                nulls[row / 8] |= char(1U << (row % 8));
+        }
+        payload += nulls;
+
+        /* Values of the non-NULL rows */
+        for (auto &tuple : rows) {
+            if (tuple.is_null(idx)) continue;
+            if (ty->is_character_sequence()) {
+                auto str = reinterpret_cast<const char*>(tuple[idx].as_p());
+                put(payload, str, strnlen(str, as<const CharacterSequence>(*ty).length));
+            } else if (ty->is_boolean()) {
+                put(payload, uint8_t(tuple[idx].as_b()));
+            } else if (ty->is_float()) {
+                put(payload, tuple[idx].as_f());
+            } else if (ty->is_double()) {
+                put(payload, tuple[idx].as_d());
+            } else {
+                put(payload, tuple[idx].as_i());
+            }
+        }
+    }
+
+    std::string record;
+    put(record, RECORD_MAGIC);
+    put(record, uint64_t(payload.size()));
+    put(record, checksum(payload.data(), payload.size()));
+    record += payload;
+
+    /*----- Buffer the record. -----*/
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (fd_ == -1) {
+        fd_ = open(options::wal, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd_ == -1) fail("open");
+        flusher_ = std::thread(&WriteAheadLog::flush_loop, this);
+    }
+    pending_ += record;
+    end_lsn_ += record.size();
+    commit_lsns_[&t] = end_lsn_;
+    const bool must_flush = pending_.size() >= options::wal_group_commit_size;
+    lock.unlock();
+    if (must_flush) flush_.notify_one();
+}
+
+void WriteAheadLog::commit(const Scheduler::Transaction &t)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = commit_lsns_.find(&t);
+    if (it == commit_lsns_.end()) return; // nothing logged
+    const uint64_t lsn = it->second;
+    commit_lsns_.erase(it);
+
+    if (flushed_lsn_ >= lsn) return;
+    ++num_waiting_;
+    flush_.notify_one();
+    durable_.wait(lock, [this, lsn]() { return flushed_lsn_ >= lsn; });
+    --num_waiting_;
+}
+
+void WriteAheadLog::abort(const Scheduler::Transaction &t)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    commit_lsns_.erase(&t);
+}
+
+void WriteAheadLog::flush_loop()
+{
+    WorkerPool::Pin_To_Reserved_CPUs();
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        flush_.wait(lock, [this]() {
+            return stop_ or num_waiting_ != 0 or pending_.size() >= options::wal_group_commit_size;
+        });
+        if (pending_.empty()) {
+            if (stop_) return;
+            continue;
+        }
+
+        /* Give further commits the chance to join this sync, unless enough bytes are pending already. */
+        if (not stop_ and pending_.size() < options::wal_group_commit_size) {
+            flush_.wait_for(lock, std::chrono::microseconds(options::wal_group_commit_delay), [this]() {
+                return stop_ or pending_.size() >= options::wal_group_commit_size;
+            });
+        }
+
+        /* Write and sync the pending records without blocking further records from being buffered. */
+        std::string records;
+        records.swap(pending_);
+        const uint64_t lsn = end_lsn_;
+        lock.unlock();
+        for (const char *p = records.data(), *end = p + records.size(); p != end; ) {
+            const auto n = write(fd_, p, end - p);
+            if (n == -1) {
+                if (errno == EINTR) continue;
+                fail("write");
+            }
+            p += n;
+        }
+        if (fdatasync(fd_) != 0) fail("sync");
+        lock.lock();
+
+        flushed_lsn_ = lsn;
+        durable_.notify_all();
+    }
+}
+
+std::size_t WriteAheadLog::replay(Database &DB, Diagnostic &diag)
+{
+    if (not enabled()) return 0;
+
+    std::ifstream in(options::wal, std::ios::binary);
+    if (not in) return 0; // nothing logged yet
+    const std::string log(std::istreambuf_iterator<char>(in), {});
+
+    Catalog &C = Catalog::Get();
+    Position pos("WriteAheadLog");
+    std::size_t num_rows_replayed = 0;
+    RecordReader records(log.data(), log.data() + log.size());
+    while (not records.exhausted()) {
+        /*----- Read and validate the record, stop at a record torn by a crash. -----*/
+        const char *payload;
+        uint64_t payload_size;
+        try {
+            if (records.get<uint32_t>() != RECORD_MAGIC) throw std::out_of_range("invalid magic number");
+            payload_size = records.get<uint64_t>();
+            const auto expected_checksum = records.get<uint64_t>();
+            payload = records.get_bytes(payload_size);
+            if (checksum(payload, payload_size) != expected_checksum) throw std::out_of_range("invalid checksum");
+        } catch (std::out_of_range) {
+            diag.w(pos) << "Ignoring the torn tail of the write-ahead log.\n";
+            break;
+        }
+
+        RecordReader R(payload, payload + payload_size);
+        if (R.get_string() != *DB.name) continue;
+        const auto table_name = R.get_string();
+        Table *table;
+        try {
+            table = &DB.get_table(C.pool(table_name.c_str()));
+        } catch (std::out_of_range) {
+            diag.w(pos) << "Table " << table_name << " of the write-ahead log does not exist.\n";
+            continue;
+        }
+        const std::size_t count = R.get<uint64_t>();
+        const std::size_t num_columns = R.get<uint32_t>();
+
+        /*----- Decode the rows column by column. -----*/
+        StoreWriter W(table->store());
+        const Schema &S = W.schema();
+        if (num_columns != S.num_entries()) {
+            diag.w(pos) << "Schema of table " << table_name << " differs from the write-ahead log.\n";
+            continue;
+        }
+        std::vector<Tuple> rows;
+        rows.reserve(count);
+        for (std::size_t row = 0; row != count; ++row)
+            rows.emplace_back(S);
+        bool is_matching = true;
+        for (std::size_t idx = 0; idx != num_columns; ++idx) {
+            const Type *ty = S[idx].type;
+            if (R.get_string() != *S[idx].id.name) {
+                is_matching = false;
+                break;
+            }
+            const char *nulls = R.get_bytes((count + 7) / 8);
+            for (std::size_t row = 0; row != count; ++row) {
+                auto &tuple = rows[row];
+                if (nulls[row / 8] & (1U << (row % 8))) {
+                    tuple.null(idx);
+                } else if (ty->is_character_sequence()) {
+                    const auto str = R.get_string();
+                    tuple.not_null(idx);
+                    char *dst = reinterpret_cast<char*>(tuple[idx].as_p());
+                    std::memcpy(dst, str.data(), str.size());
+                    dst[str.size()] = 0;
+                } else if (ty->is_boolean()) {
+                    tuple.set(idx, bool(R.get<uint8_t>()));
+                } else if (ty->is_float()) {
+                    tuple.set(idx, R.get<float>());
+                } else if (ty->is_double()) {
+                    tuple.set(idx, R.get<double>());
+                } else {
+                    tuple.set(idx, R.get<int64_t>());
+                }
+            }
+        }
+        if (not is_matching) {
+            diag.w(pos) << "Schema of table " << table_name << " differs from the write-ahead log.\n";
+            continue;
+        }
+
+        /*----- Append the rows to the store. -----*/
+        for (auto &tuple : rows)
+            W.append(tuple);
+        num_rows_replayed += count;
+        if (auto pax = cast<const PaxStore>(&table->store()))
+            pax->update_synopses();
+        DB.invalidate_indexes(table->name());
+        ResultCache::Get().invalidate(*table);
+    }
+    return num_rows_replayed;
+}
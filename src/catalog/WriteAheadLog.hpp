@@ -0,0 +1,76 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutable/catalog/Scheduler.hpp>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/util/Diagnostic.hpp>
+#include <mutable/util/Pool.hpp>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+
+namespace m {
+
+/** Logs the rows appended by `INSERT` and `IMPORT` to a file, see `--wal`, such that they can be replayed into the
+ * stores after a restart with the `\recover` instruction.  Each record holds the rows appended by a single command to
+ * a single table in columnar form, i.e. per column a NULL bitmap followed by the values of the non-NULL rows.  Records
+ * are checksummed, such that a record torn by a crash while writing is detected and ignored on recovery.
+ *
+ * Records are buffered in memory and made durable by *group commit*: a committing transaction waits until a single
+ * flusher thread has written and synced the buffer.  The flusher waits up to `--wal-group-commit-delay` for further
+ * commits to join a sync, unless at least `--wal-group-commit-size` bytes are pending.  Hence, concurrent transactions
+ * share the cost of an `fdatasync()`, rather than paying one per command.
+ *
+ * The log only holds rows, not the schema.  Recovery must hence be performed after the tables were created again.
+ * Since there are no checkpoints, the log grows until it is deleted.  Deletions are not logged, hence `DELETE` and
+ * `UPDATE` are rejected while the log is enabled. */
+struct WriteAheadLog
+{
+    private:
+    int fd_ = -1; ///< the file descriptor of the log, `-1` if not yet opened
+    std::string pending_; ///< the records not yet written to the log
+    uint64_t end_lsn_ = 0; ///< the log sequence number, i.e. the offset, past the last buffered record
+    uint64_t flushed_lsn_ = 0; ///< the log sequence number up to which the log is durable
+    ///> the log sequence number past the last record of every transaction that logged rows and did not yet commit
+    std::unordered_map<const Scheduler::Transaction*, uint64_t> commit_lsns_;
+    std::size_t num_waiting_ = 0; ///< the number of transactions waiting for the log to become durable
+    bool stop_ = false; ///< whether the flusher thread shall terminate
+    std::thread flusher_;
+    std::mutex mutex_;
+    std::condition_variable flush_; ///< signals the flusher thread that records are to be flushed
+    std::condition_variable durable_; ///< signals waiting transactions that the log became more durable
+
+    WriteAheadLog() = default;
+    ~WriteAheadLog();
+
+    public:
+    static WriteAheadLog & Get();
+
+    /** Returns `true` iff appended rows are logged, see `--wal`. */
+    static bool enabled();
+
+    /** Logs the rows of \p table of the database \p database_name from \p first_row on, appended by transaction \p t.
+     * The rows become durable when \p t commits. */
+    void log_rows(const Scheduler::Transaction &t, const ThreadSafePooledString &database_name, const Table &table,
+                  std::size_t first_row);
+
+    /** Waits until all rows logged by transaction \p t are durable. */
+    void commit(const Scheduler::Transaction &t);
+
+    /** Forgets transaction \p t without waiting for its rows to become durable. */
+    void abort(const Scheduler::Transaction &t);
+
+    /** Appends the rows of all records of the log for the database \p DB to its tables.  Returns the number of rows
+     * replayed.  Records of tables that do not exist or whose schema differs are reported and skipped. */
+    std::size_t replay(Database &DB, Diagnostic &diag);
+
+    private:
+    /** Writes and syncs the pending records until `stop_` is set. */
+    void flush_loop();
+};
+
+}
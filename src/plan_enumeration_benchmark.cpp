@@ -0,0 +1,475 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutable/catalog/CardinalityEstimator.hpp>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/CostFunctionCout.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/IR/PlanTable.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/Options.hpp>
+#include <mutable/util/ArgParser.hpp>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#if __has_include(<malloc.h>)
+#include <malloc.h>
+#endif
+
+
+using namespace m;
+using Subproblem = SmallBitset;
+
+
+/*======================================================================================================================
+ * Synthetic query graphs
+ *====================================================================================================================*/
+
+namespace {
+
+/** The maximum number of relations of a query graph, i.e. the capacity of `SmallBitset`. */
+constexpr std::size_t MAX_RELATIONS = 64;
+
+/** The shapes of the generated query graphs. */
+constexpr std::string_view SHAPES[] = { "chain", "star", "cycle", "clique", "random" };
+
+/** The plan enumerators that enumerate the entire search space, s.t. the plans they find are optimal. */
+constexpr std::string_view EXHAUSTIVE_ENUMERATORS[] = {
+    "DPccp", "DPsize", "DPsizeOpt", "DPsizeSub", "DPsub", "DPsubOpt", "DPsubPar", "TDbasic", "TDMinCutAGaT", "PEall",
+};
+
+struct
+{
+    ///> whether to show a help message
+    bool show_help;
+    ///> the seed for the PRNG
+    unsigned seed;
+    ///> the shapes of the query graphs
+    std::vector<std::string> shapes;
+    ///> the numbers of relations of the query graphs
+    std::vector<std::size_t> sizes;
+    ///> the plan enumerators to benchmark
+    std::vector<std::string> enumerators;
+    ///> the number of times each plan enumerator is run per query graph and plan table
+    unsigned repetitions;
+    ///> minimum cardinality of base relations
+    std::size_t min_cardinality;
+    ///> maximum cardinality of base relations
+    std::size_t max_cardinality;
+    ///> the probability of an edge between two relations of a random query graph, beyond its spanning tree
+    double edge_probability;
+    ///> the maximum number of connected subgraphs of a query graph whose cardinalities are injected
+    std::size_t max_subproblems;
+    ///> the maximum number of relations for which `PlanTableSmallOrDense` is benchmarked
+    std::size_t max_dense_relations;
+} args;
+
+/** A join edge between two relations with the selectivity of its join predicate. */
+struct edge_t
+{
+    unsigned left, right;
+    double log_selectivity;
+};
+
+/** A generated query graph: the cardinalities of its relations and its join edges. */
+struct graph_t
+{
+    std::vector<double> log_cardinalities;
+    std::vector<edge_t> edges;
+};
+
+/** Thrown to stop enumerating the connected subgraphs of a query graph when there are too many. */
+struct too_many_subproblems { };
+
+/** Returns the edges of a query graph of shape \p shape with \p n relations. */
+template<typename Generator>
+std::vector<std::pair<unsigned, unsigned>> generate_edges(std::string_view shape, unsigned n, Generator &&g)
+{
+    std::vector<std::pair<unsigned, unsigned>> edges;
+    if (shape == "chain" or shape == "cycle") {
+        for (unsigned i = 1; i < n; ++i)
+            edges.emplace_back(i - 1, i);
+        if (shape == "cycle" and n > 2)
+            edges.emplace_back(0, n - 1);
+    } else if (shape == "star") {
+        for (unsigned i = 1; i < n; ++i)
+            edges.emplace_back(0, i);
+    } else if (shape == "clique") {
+        for (unsigned i = 0; i != n; ++i) {
+            for (unsigned j = i + 1; j < n; ++j)
+                edges.emplace_back(i, j);
+        }
+    } else {
+        M_insist(shape == "random");
+        /* Connect each relation to a random predecessor, s.t. the graph is connected, then add further edges. */
+        std::bernoulli_distribution extra_edge(args.edge_probability);
+        for (unsigned j = 1; j < n; ++j) {
+            const unsigned parent = std::uniform_int_distribution<unsigned>(0, j - 1)(g);
+            for (unsigned i = 0; i != j; ++i) {
+                if (i == parent or extra_edge(g))
+                    edges.emplace_back(i, j);
+            }
+        }
+    }
+    return edges;
+}
+
+/** Generates synthetic cardinalities for the relations of a query graph with the given \p edges.  The cardinalities of
+ * the relations are distributed log-uniformly.  Each join behaves like a foreign-key join with a fan-out between 0.1
+ * and 2, i.e. its selectivity is the fan-out divided by the larger cardinality of the two relations. */
+template<typename Generator>
+graph_t generate_graph(unsigned n, std::vector<std::pair<unsigned, unsigned>> edges, Generator &&g)
+{
+    graph_t graph;
+    std::uniform_real_distribution<double> log_cardinality(std::log(args.min_cardinality),
+                                                           std::log(args.max_cardinality));
+    std::uniform_real_distribution<double> log_fan_out(std::log(0.1), std::log(2.));
+    for (unsigned i = 0; i != n; ++i)
+        graph.log_cardinalities.push_back(log_cardinality(g));
+    for (auto [left, right] : edges) {
+        const double larger = std::max(graph.log_cardinalities[left], graph.log_cardinalities[right]);
+        graph.edges.push_back({ left, right, log_fan_out(g) - larger });
+    }
+    return graph;
+}
+
+/** Returns the name of the `i`-th relation. */
+std::string relation_name(unsigned i) { return "T" + std::to_string(i); }
+
+/** Creates the tables of \p graph in \p DB and returns the query joining them along the edges of \p graph.  Each edge
+ * joins a column of its own, s.t. no join predicates are implied transitively. */
+std::string create_tables(Catalog &C, Database &DB, const graph_t &graph)
+{
+    std::vector<std::reference_wrapper<Table>> tables;
+    for (unsigned i = 0; i != graph.log_cardinalities.size(); ++i) {
+        Table &table = DB.add_table(C.pool(relation_name(i).c_str()));
+        table.push_back(C.pool("id"), Type::Get_Integer(Type::TY_Vector, 4));
+        tables.emplace_back(table);
+    }
+    std::ostringstream query;
+    query << "SELECT * FROM ";
+    for (unsigned i = 0; i != tables.size(); ++i)
+        query << (i ? ", " : "") << relation_name(i);
+    for (std::size_t e = 0; e != graph.edges.size(); ++e) {
+        auto [left, right, _] = graph.edges[e];
+        const std::string column = "r" + std::to_string(right);
+        tables[left].get().push_back(C.pool(column.c_str()), Type::Get_Integer(Type::TY_Vector, 4));
+        query << (e ? " AND " : " WHERE ") << relation_name(left) << '.' << column << " = " << relation_name(right)
+              << ".id";
+    }
+    query << ';';
+    for (Table &table : tables) {
+        table.store(C.create_store(table));
+        table.layout(C.data_layout());
+    }
+    return query.str();
+}
+
+/** Emits the cardinalities of all connected subgraphs of \p G as input to the `InjectionCardinalityEstimator` for the
+ * database \p DB.  The cardinality of a subgraph is the product of the cardinalities of its relations and the
+ * selectivities of the edges within, clamped to `[1, max_cardinality²]`.  Throws `too_many_subproblems` if \p G has
+ * more than `args.max_subproblems` connected subgraphs. */
+void emit_cardinalities(std::ostream &out, const Database &DB, const QueryGraph &G, const graph_t &graph)
+{
+    const AdjacencyMatrix &M = G.adjacency_matrix();
+    const Subproblem All = Subproblem::All(G.num_sources());
+
+    /* Count the connected subgraphs first, to not generate the cardinalities of a graph that is too large. */
+    std::size_t num_subproblems = 0;
+    M.for_each_CSG_undirected(All, [&num_subproblems](Subproblem) {
+        if (++num_subproblems > args.max_subproblems)
+            throw too_many_subproblems{};
+    });
+
+    const double max_log_cardinality = 2 * std::log(args.max_cardinality);
+    out << "{ \"" << DB.name << "\": [";
+    bool first = true;
+    M.for_each_CSG_undirected(All, [&](Subproblem S) {
+        double log_cardinality = 0;
+        for (auto it = S.begin(); it != S.end(); ++it)
+            log_cardinality += graph.log_cardinalities[G.sources()[*it]->id()];
+        for (auto &edge : graph.edges) {
+            if (S[edge.left] and S[edge.right])
+                log_cardinality += edge.log_selectivity;
+        }
+        const std::size_t cardinality = std::llround(std::exp(std::clamp(log_cardinality, 0., max_log_cardinality)));
+
+        out << (first ? "\n" : ",\n") << "  { \"relations\": [";
+        first = false;
+        for (auto it = S.begin(); it != S.end(); ++it)
+            out << (it == S.begin() ? "\"" : ", \"") << G.sources()[*it]->name() << '"';
+        out << "], \"size\": " << cardinality << " }";
+    });
+    out << "\n] }\n";
+}
+
+
+/*======================================================================================================================
+ * Measurements
+ *====================================================================================================================*/
+
+/** Returns the number of bytes currently allocated on the heap, if the C library reports it. */
+std::optional<std::size_t> heap_in_use()
+{
+#if defined(__GLIBC__) and (__GLIBC__ > 2 or (__GLIBC__ == 2 and __GLIBC_MINOR__ >= 33))
+    const auto info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return std::nullopt;
+#endif
+}
+
+/** The measurements of one plan enumerator with one plan table for one query graph. */
+struct measurement_t
+{
+    std::string enumerator;
+    const char *plan_table;
+    double time_ms; ///< the median planning time over all repetitions
+    std::optional<std::size_t> heap_bytes; ///< the heap allocated by the plan table and the plans after enumeration
+    double cost; ///< the cost of the plan found
+};
+
+/** Runs the current plan enumerator `args.repetitions` times on \p G with a fresh plan table of type `PlanTable`. */
+template<typename PlanTable>
+measurement_t measure(const QueryGraph &G, const CostFunction &CF, const std::string &enumerator,
+                      const char *plan_table)
+{
+    Catalog &C = Catalog::Get();
+    auto &CE = C.get_database_in_use().cardinality_estimator();
+
+    measurement_t measurement{ enumerator, plan_table, 0, std::nullopt, 0 };
+    std::vector<double> times;
+    for (unsigned r = 0; r != args.repetitions; ++r) {
+        const auto heap_before = heap_in_use();
+        PlanTable PT(G);
+        for (auto &ds : G.sources()) {
+            const Subproblem S = Subproblem::Singleton(ds->id());
+            PT[S].cost = 0;
+            PT[S].model = CE.estimate_scan(G, S);
+        }
+
+        using namespace std::chrono;
+        const auto begin = steady_clock::now();
+        C.plan_enumerator()(G, CF, PT);
+        const auto end = steady_clock::now();
+        times.push_back(duration_cast<nanoseconds>(end - begin).count() / 1e6);
+
+        if (auto heap_after = heap_in_use(); heap_before and heap_after)
+            measurement.heap_bytes = *heap_after > *heap_before ? *heap_after - *heap_before : 0;
+        measurement.cost = PT.get_final().cost;
+    }
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    measurement.time_ms = times[times.size() / 2];
+    return measurement;
+}
+
+/** Splits the comma separated list \p str. */
+std::vector<std::string> split(std::string_view str)
+{
+    std::vector<std::string> parts;
+    for (std::size_t begin = 0; begin <= str.size(); ) {
+        const std::size_t end = std::min(str.find(',', begin), str.size());
+        if (end != begin)
+            parts.emplace_back(str.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    return parts;
+}
+
+void usage(std::ostream &out, const char *name)
+{
+    out << "A benchmark of plan enumerators on synthetic query graphs with injected cardinalities.\n"
+        << "Prints one CSV row per query graph, plan enumerator, and plan table.\n"
+        << "USAGE:\n\t" << name << " [<OPTIONS>]"
+        << std::endl;
+}
+
+}
+
+
+int main(int argc, const char **argv)
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Parse command line arguments. ----------------------------------------------------------------------------*/
+    ArgParser &AP = C.arg_parser();
+#define ADD(TYPE, VAR, INIT, SHORT, LONG, DESCR, CALLBACK)\
+    VAR = INIT;\
+    {\
+        AP.add<TYPE>(SHORT, LONG, DESCR, CALLBACK);\
+    }
+    /*----- Help message ---------------------------------------------------------------------------------------------*/
+    ADD(bool, args.show_help, false,                                        /* Type, Var, Init  */
+        "-h", "--help",                                                     /* Short, Long      */
+        "prints this help message",                                         /* Description      */
+        [&](bool) { args.show_help = true; });                              /* Callback         */
+    /*----- Seed -----------------------------------------------------------------------------------------------------*/
+    ADD(unsigned, args.seed, 42,                                            /* Type, Var, Init  */
+        nullptr, "--seed",                                                  /* Short, Long      */
+        "the seed for the PRNG",                                            /* Description      */
+        [&](unsigned s) { args.seed = s; });                                /* Callback         */
+    /*----- Query graphs ---------------------------------------------------------------------------------------------*/
+    ADD(const char*, args.shapes, split("chain,star,cycle,clique,random"), /* Type, Var, Init  */
+        nullptr, "--shapes",                                                /* Short, Long      */
+        "a comma separated list of query graph shapes (chain, star, cycle, clique, random)",
+        [&](const char *str) { args.shapes = split(str); });                /* Callback         */
+    ADD(const char*, args.sizes, (std::vector<std::size_t>{ 10, 15, 20, 30, 40, 50, 64 }), /* Type, Var, Init */
+        nullptr, "--sizes",                                                 /* Short, Long      */
+        "a comma separated list of the numbers of relations, at most 64",   /* Description      */
+        [&](const char *str) {                                              /* Callback         */
+            args.sizes.clear();
+            for (auto &size : split(str))
+                args.sizes.push_back(std::strtoul(size.c_str(), nullptr, 10));
+        });
+    ADD(double, args.edge_probability, .05,                                 /* Type, Var, Init  */
+        nullptr, "--edge-probability",                                      /* Short, Long      */
+        "the probability of an edge between two relations of a random query graph, beyond its spanning tree",
+        [&](double p) { args.edge_probability = p; });                      /* Callback         */
+    /*----- Cardinalities --------------------------------------------------------------------------------------------*/
+    ADD(std::size_t, args.min_cardinality, 10,                              /* Type, Var, Init  */
+        nullptr, "--min",                                                   /* Short, Long      */
+        "the minimum cardinality of base tables",                           /* Description      */
+        [&](std::size_t card) { args.min_cardinality = card; });            /* Callback         */
+    ADD(std::size_t, args.max_cardinality, 1e6,                             /* Type, Var, Init  */
+        nullptr, "--max",                                                   /* Short, Long      */
+        "the maximum cardinality of base tables",                           /* Description      */
+        [&](std::size_t card) { args.max_cardinality = card; });            /* Callback         */
+    ADD(std::size_t, args.max_subproblems, 1UL << 18,                       /* Type, Var, Init  */
+        nullptr, "--max-subproblems",                                       /* Short, Long      */
+        "skip query graphs with more connected subgraphs, whose cardinalities are all injected",
+        [&](std::size_t n) { args.max_subproblems = n; });                  /* Callback         */
+    /*----- Plan enumeration -----------------------------------------------------------------------------------------*/
+    ADD(const char*, args.enumerators, split("DPccp,TDMinCutAGaT,IKKBZ,LinearizedDP,GOO,HeuristicSearch"),
+        nullptr, "--enumerators",                                           /* Short, Long      */
+        "a comma separated list of plan enumerators",                       /* Description      */
+        [&](const char *str) { args.enumerators = split(str); });           /* Callback         */
+    ADD(unsigned, args.repetitions, 3,                                      /* Type, Var, Init  */
+        nullptr, "--repetitions",                                           /* Short, Long      */
+        "the number of runs per measurement, of which the median time is reported",
+        [&](unsigned n) { args.repetitions = std::max(n, 1U); });           /* Callback         */
+    ADD(std::size_t, args.max_dense_relations, 20,                          /* Type, Var, Init  */
+        nullptr, "--max-dense-relations",                                   /* Short, Long      */
+        "the maximum number of relations for which `PlanTableSmallOrDense` is benchmarked",
+        [&](std::size_t n) { args.max_dense_relations = n; });              /* Callback         */
+#undef ADD
+    /*----- Parse command line arguments. ----------------------------------------------------------------------------*/
+    AP.parse_args(argc, argv);
+
+    /*----- Help message. -----*/
+    if (args.show_help) {
+        usage(std::cout, argv[0]);
+        std::cout << "WHERE\n" << AP;
+        std::exit(EXIT_SUCCESS);
+    }
+
+    /*----- Validate command line arguments. -------------------------------------------------------------------------*/
+    for (auto &shape : args.shapes) {
+        if (std::find(std::begin(SHAPES), std::end(SHAPES), shape) == std::end(SHAPES)) {
+            std::cerr << "There is no query graph shape with the name \"" << shape << "\".\n";
+            std::exit(EXIT_FAILURE);
+        }
+    }
+    for (auto size : args.sizes) {
+        if (size < 2 or size > MAX_RELATIONS) {
+            std::cerr << "The number of relations must be in [2, " << MAX_RELATIONS << "].\n";
+            std::exit(EXIT_FAILURE);
+        }
+    }
+    for (auto &enumerator : args.enumerators) {
+        try {
+            C.default_plan_enumerator(C.pool(enumerator.c_str()));
+        } catch (std::invalid_argument) {
+            std::cerr << "There is no plan enumerator with the name \"" << enumerator << "\".\n";
+            std::exit(EXIT_FAILURE);
+        }
+    }
+    if (args.min_cardinality == 0 or args.min_cardinality > args.max_cardinality) {
+        std::cerr << "The cardinalities must satisfy 0 < min <= max.\n";
+        std::exit(EXIT_FAILURE);
+    }
+
+    /*----- Configure mutable. ---------------------------------------------------------------------------------------*/
+    Options::Get().quiet = true;
+    Diagnostic diag(false, std::cout, std::cerr);
+    CostFunctionCout C_out;
+
+    std::cout << "shape,relations,joins,enumerator,plan_table,time_ms,heap_bytes,cost,relative_cost,reference\n";
+    unsigned graph_id = 0;
+    for (auto &shape : args.shapes) {
+        for (auto n : args.sizes) {
+            std::mt19937_64 g(args.seed ^ (0x9e3779b97f4a7c15UL * ++graph_id));
+            const graph_t graph = generate_graph(n, generate_edges(shape, n, g), g);
+
+            /*----- Create the tables, the query graph, and the injected cardinalities. -----*/
+            const ThreadSafePooledString db_name = C.pool(("plan_enumeration_" + std::to_string(graph_id)).c_str());
+            Database &DB = C.add_database(db_name);
+            C.set_database_in_use(DB);
+            auto stmt = statement_from_string(diag, create_tables(C, DB, graph));
+            M_insist(not diag.num_errors(), "generated query must be valid");
+            auto G = QueryGraph::Build(*stmt);
+
+            std::stringstream cardinalities;
+            try {
+                emit_cardinalities(cardinalities, DB, *G, graph);
+            } catch (too_many_subproblems) {
+                std::cerr << "Skipping " << shape << " query graph of " << n << " relations with more than "
+                          << args.max_subproblems << " connected subgraphs.\n";
+                G.reset();
+                stmt.reset();
+                C.unset_database_in_use();
+                C.drop_database(db_name);
+                continue;
+            }
+            DB.cardinality_estimator(std::make_unique<InjectionCardinalityEstimator>(diag, db_name, cardinalities));
+            /* Let the estimator map the injected cardinalities to the subproblems of `G` before measuring the heap. */
+            M_DISCARD DB.cardinality_estimator().estimate_scan(*G, Subproblem::Singleton(0));
+
+            /*----- Run each plan enumerator with each plan table. -----*/
+            std::vector<measurement_t> measurements;
+            bool optimal = false;
+            for (auto &enumerator : args.enumerators) {
+                C.default_plan_enumerator(C.pool(enumerator.c_str()));
+                if (n <= args.max_dense_relations)
+                    measurements.push_back(measure<PlanTableSmallOrDense>(*G, C_out, enumerator,
+                                                                          "PlanTableSmallOrDense"));
+                measurements.push_back(measure<PlanTableLargeAndSparse>(*G, C_out, enumerator,
+                                                                        "PlanTableLargeAndSparse"));
+                optimal = optimal or std::find(std::begin(EXHAUSTIVE_ENUMERATORS), std::end(EXHAUSTIVE_ENUMERATORS),
+                                               enumerator) != std::end(EXHAUSTIVE_ENUMERATORS);
+            }
+
+            /*----- Report the costs relative to the optimal plan, if found, or else to the best plan found. -----*/
+            double reference_cost = std::numeric_limits<double>::infinity();
+            for (auto &measurement : measurements)
+                reference_cost = std::min(reference_cost, measurement.cost);
+            for (auto &measurement : measurements) {
+                std::cout << shape << ',' << n << ',' << graph.edges.size() << ',' << measurement.enumerator << ','
+                          << measurement.plan_table << ',' << measurement.time_ms << ',';
+                if (measurement.heap_bytes)
+                    std::cout << *measurement.heap_bytes;
+                std::cout << ',' << measurement.cost << ','
+                          << (reference_cost > 0 ? measurement.cost / reference_cost : 1.) << ','
+                          << (optimal ? "optimal" : "best") << '\n';
+            }
+            std::cout.flush();
+
+            G.reset();
+            stmt.reset();
+            C.unset_database_in_use();
+            C.drop_database(db_name);
+        }
+    }
+
+    Catalog::Destroy();
+}
@@ -1,18 +1,24 @@
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
 #include <deque>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <mutable/IR/PlanTable.hpp>
 #include <mutable/mutable.hpp>
 #include <mutable/Options.hpp>
 #include <mutable/util/ArgParser.hpp>
+#include <queue>
 #include <random>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 #ifdef __BMI2__
 #include <x86intrin.h>
 #endif
@@ -24,10 +30,16 @@ struct args_t
 {
     ///> whether to show a help message
     bool show_help;
+    ///> the number of files to distribute the queries to
+    unsigned num_shards;
+    ///> the path prefix of the files to distribute the queries to
+    const char *shard_prefix;
 };
 
 void emit_CSG_queries(std::ostream &out, const m::QueryGraph &G, const m::AdjacencyMatrix &M);
 void emit_query_slice(std::ostream &out, const m::QueryGraph &G, m::Subproblem slice);
+void emit_sharded_query_slices(const m::QueryGraph &G, const m::AdjacencyMatrix &M, unsigned num_shards,
+                               const char *prefix);
 
 void usage(std::ostream &out, const char *name)
 {
@@ -51,6 +63,15 @@ int main(int argc, const char **argv)
         "-h", "--help",                                                     /* Short, Long      */
         "prints this help message",                                         /* Description      */
         [&](bool) { args.show_help = true; });                              /* Callback         */
+    /*----- Sharding -------------------------------------------------------------------------------------------------*/
+    ADD(unsigned, args.num_shards, 1,                                       /* Type, Var, Init  */
+        nullptr, "--shards",                                                /* Short, Long      */
+        "distribute the queries to this many files, balanced by their estimated cost, to run them in parallel",
+        [&](unsigned n) { args.num_shards = n; });                          /* Callback         */
+    ADD(const char*, args.shard_prefix, "slice",                            /* Type, Var, Init  */
+        nullptr, "--shard-prefix",                                          /* Short, Long      */
+        "the path prefix of the files to distribute the queries to",        /* Description      */
+        [&](const char *prefix) { args.shard_prefix = prefix; });           /* Callback         */
     /*----- Parse command line arguments. ----------------------------------------------------------------------------*/
     AP.parse_args(argc, argv);
 
@@ -66,6 +87,10 @@ int main(int argc, const char **argv)
         usage(std::cout, argv[0]);
         std::exit(EXIT_FAILURE);
     }
+    if (args.num_shards == 0) {
+        std::cerr << "The number of shards must be positive.\n";
+        std::exit(EXIT_FAILURE);
+    }
 
     /*----- Configure mutable. ---------------------------------------------------------------------------------------*/
     m::Options::Get().quiet = true;
@@ -114,9 +139,56 @@ int main(int argc, const char **argv)
     m::AdjacencyMatrix &M = G->adjacency_matrix();
 
     /*----- Emit the queries. ----------------------------------------------------------------------------------------*/
-    const Subproblem All = Subproblem::All(G->num_sources());
-    auto emit = [&G](Subproblem S) { emit_query_slice(std::cout, *G, S); };
-    M.for_each_CSG_undirected(All, emit);
+    if (args.num_shards > 1) {
+        emit_sharded_query_slices(*G, M, args.num_shards, args.shard_prefix);
+    } else {
+        const Subproblem All = Subproblem::All(G->num_sources());
+        auto emit = [&G](Subproblem S) { emit_query_slice(std::cout, *G, S); };
+        M.for_each_CSG_undirected(All, emit);
+    }
+}
+
+/** Distributes the queries of all connected subgraphs of \p G to \p num_shards files `<prefix>.<i>.sql`, such that
+ * independent processes can execute the shards in parallel.  The slices are assigned greedily, most expensive first,
+ * to the shard with the least total cost, where the cost of a slice is estimated by its number of relations.  Hence,
+ * the few large slices, which dominate the execution time, are spread across the shards. */
+void emit_sharded_query_slices(const m::QueryGraph &G, const m::AdjacencyMatrix &M, unsigned num_shards,
+                               const char *prefix)
+{
+    /*----- Collect the slices, most expensive first. -----*/
+    std::vector<Subproblem> slices;
+    M.for_each_CSG_undirected(Subproblem::All(G.num_sources()), [&slices](Subproblem S) { slices.push_back(S); });
+    std::stable_sort(slices.begin(), slices.end(), [](Subproblem left, Subproblem right) {
+        return left.size() > right.size();
+    });
+
+    /*----- Open the shards. -----*/
+    std::vector<std::ofstream> shards;
+    for (unsigned i = 0; i != num_shards; ++i) {
+        const std::string path = std::string(prefix) + '.' + std::to_string(i) + ".sql";
+        errno = 0;
+        auto &out = shards.emplace_back(path);
+        if (not out) {
+            std::cerr << "Could not open file '" << path << '\'';
+            const auto errsv = errno;
+            if (errsv)
+                std::cerr << ": " << strerror(errsv);
+            std::cerr << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    /*----- Assign each slice to the shard with the least total cost so far. -----*/
+    using entry_type = std::pair<std::size_t, unsigned>; // total cost, shard
+    std::priority_queue<entry_type, std::vector<entry_type>, std::greater<entry_type>> Q;
+    for (unsigned i = 0; i != num_shards; ++i)
+        Q.emplace(0, i);
+    for (auto S : slices) {
+        auto [cost, shard] = Q.top();
+        Q.pop();
+        emit_query_slice(shards[shard], G, S);
+        Q.emplace(cost + S.size(), shard);
+    }
 }
 
 void emit_query_slice(std::ostream &out, const m::QueryGraph &G, m::Subproblem slice)
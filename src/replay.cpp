@@ -0,0 +1,344 @@
+#include "catalog/ResultSinks.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutable/mutable.hpp>
+#include <mutable/Options.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+using namespace m;
+using clock_type = std::chrono::steady_clock;
+
+
+struct args_t
+{
+    ///> the query log to replay
+    const char *log;
+    ///> the number of concurrent sessions
+    unsigned num_sessions;
+    ///> the factor by which the replay is faster than the log, 0 to issue every query as soon as possible
+    double speed;
+    ///> the file to write the latencies to, if any
+    const char *output;
+    ///> the latencies of a previous replay to compare to, if any
+    const char *baseline;
+    ///> the relative increase of a latency over the baseline that is reported as regression
+    double tolerance;
+};
+
+void usage(std::ostream &out, const char *name)
+{
+    out << "A tool to replay a query log with many concurrent sessions and to measure the latencies of the queries.  "
+           "The <FILE>s, e.g. schema definitions and data imports, are executed before replaying.\n"
+           "Every line of the log is a query of the form `<TIMESTAMP>\\t<CLIENT>\\t<LABEL>\\t<SQL>`, where the "
+           "timestamp is in milliseconds since the start of the log and the label names the query, e.g. `job/q1a`.  "
+           "The queries of a client are issued by one session in the order of the log, the clients are distributed "
+           "round-robin to the sessions.  Lines starting with `#` are ignored.\n"
+        << "USAGE:\n\t" << name << " --log <LOG> [<FILE>...]"
+        << std::endl;
+}
+
+
+/*======================================================================================================================
+ * Query log
+ *====================================================================================================================*/
+
+/** A query of the log. */
+struct query_t
+{
+    std::chrono::milliseconds timestamp; ///< the time the query is issued, relative to the start of the log
+    unsigned client;
+    std::string label;
+    std::string sql;
+};
+
+/** Reads the queries of the log \p path.  Exits on malformed lines. */
+std::vector<query_t> read_log(const char *path)
+{
+    std::ifstream in(path);
+    if (not in) {
+        std::cerr << "Could not open the query log \"" << path << "\".\n";
+        std::exit(EXIT_FAILURE);
+    }
+
+    std::vector<query_t> queries;
+    std::string line;
+    for (std::size_t line_no = 1; std::getline(in, line); ++line_no) {
+        if (line.empty() or line[0] == '#')
+            continue;
+        std::istringstream fields(line);
+        std::string timestamp, client;
+        query_t query;
+        if (not std::getline(fields, timestamp, '\t') or not std::getline(fields, client, '\t') or
+            not std::getline(fields, query.label, '\t') or not std::getline(fields, query.sql))
+        {
+            std::cerr << path << ':' << line_no << ": expected `<TIMESTAMP>\\t<CLIENT>\\t<LABEL>\\t<SQL>`\n";
+            std::exit(EXIT_FAILURE);
+        }
+        try {
+            query.timestamp = std::chrono::milliseconds(std::stoll(timestamp));
+            query.client = std::stoul(client);
+        } catch (const std::logic_error&) {
+            std::cerr << path << ':' << line_no << ": invalid timestamp or client\n";
+            std::exit(EXIT_FAILURE);
+        }
+        queries.push_back(std::move(query));
+    }
+    return queries;
+}
+
+
+/*======================================================================================================================
+ * Latencies
+ *====================================================================================================================*/
+
+/** The latencies of the queries of a label in milliseconds, sorted. */
+struct latencies_t
+{
+    std::vector<double> samples;
+    std::size_t num_errors = 0;
+
+    /** Returns the \p p-quantile of the latencies, with \p p in [0, 1]. */
+    double quantile(double p) const {
+        if (samples.empty()) return 0;
+        const std::size_t idx = std::min<std::size_t>(p * samples.size(), samples.size() - 1);
+        return samples[idx];
+    }
+};
+
+/** The quantiles reported per label. */
+constexpr std::pair<const char*, double> QUANTILES[] = { { "p50", .5 }, { "p99", .99 }, { "p999", .999 } };
+
+/** Writes the number of queries and the quantiles of the latencies of every label in \p latencies as CSV to \p out. */
+void write_latencies(std::ostream &out, const std::map<std::string, latencies_t> &latencies)
+{
+    out << "label,count,errors";
+    for (auto [name, _] : QUANTILES)
+        out << ',' << name;
+    out << '\n' << std::fixed << std::setprecision(3);
+    for (auto &[label, L] : latencies) {
+        out << label << ',' << L.samples.size() << ',' << L.num_errors;
+        for (auto [_, p] : QUANTILES)
+            out << ',' << L.quantile(p);
+        out << '\n';
+    }
+}
+
+/** Compares the quantiles of \p latencies with those of the CSV file \p path written by `write_latencies()`.  Reports
+ * every quantile that exceeds its baseline by more than \p tolerance to \p out and returns their number. */
+std::size_t compare_latencies(std::ostream &out, const char *path, const std::map<std::string, latencies_t> &latencies,
+                              double tolerance)
+{
+    std::ifstream in(path);
+    if (not in) {
+        std::cerr << "Could not open the baseline \"" << path << "\".\n";
+        std::exit(EXIT_FAILURE);
+    }
+
+    std::size_t num_regressions = 0;
+    std::string line;
+    std::getline(in, line); // skip header
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string label, count, errors;
+        std::getline(fields, label, ',');
+        std::getline(fields, count, ',');
+        std::getline(fields, errors, ',');
+        auto it = latencies.find(label);
+        if (it == latencies.end())
+            continue; // label not replayed
+        for (auto [name, p] : QUANTILES) {
+            std::string field;
+            if (not std::getline(fields, field, ','))
+                break;
+            const double baseline = std::stod(field);
+            const double latency = it->second.quantile(p);
+            if (latency > baseline * (1 + tolerance)) {
+                out << "REGRESSION of " << label << ": " << name << " " << baseline << " ms -> " << latency
+                    << " ms\n";
+                ++num_regressions;
+            }
+        }
+    }
+    return num_regressions;
+}
+
+
+/*======================================================================================================================
+ * Replay
+ *====================================================================================================================*/
+
+/** Executes \p sql in a transaction of its own and discards its results.  Returns `true` iff it succeeded. */
+bool execute(const std::string &sql)
+{
+    Scheduler &S = Catalog::Get().scheduler();
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    auto command = command_from_string(diag, sql);
+    if (diag.num_errors() or not command)
+        return false;
+
+    auto t = S.begin_transaction();
+    ResultSinks::Get().add(*t, [](const Schema&, const Tuple&) { /* discard */ });
+    bool success = S.schedule_command(*t, std::move(command), diag).get() and diag.num_errors() == 0;
+    ResultSinks::Get().remove(*t);
+    if (success)
+        success = S.commit(std::move(t));
+    else
+        S.abort(std::move(t));
+    return success;
+}
+
+/** Issues the \p queries of a session one after the other, each not before its timestamp scaled by `args.speed`
+ * relative to \p start, and records their latencies by label in \p latencies.  The latency of a query is measured from
+ * the time it is due, such that queries delayed by their predecessors in the session account for the delay. */
+void replay_session(const std::vector<const query_t*> &queries, const args_t &args, clock_type::time_point start,
+                    std::map<std::string, latencies_t> &latencies)
+{
+    for (auto query : queries) {
+        auto due = clock_type::now();
+        if (args.speed > 0) {
+            due = start + std::chrono::duration_cast<clock_type::duration>(query->timestamp / args.speed);
+            std::this_thread::sleep_until(due);
+        }
+        const bool success = execute(query->sql);
+        const std::chrono::duration<double, std::milli> latency = clock_type::now() - due;
+        auto &L = latencies[query->label];
+        if (success)
+            L.samples.push_back(latency.count());
+        else
+            ++L.num_errors;
+    }
+}
+
+
+/*======================================================================================================================
+ * main
+ *====================================================================================================================*/
+
+int main(int argc, const char **argv)
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Parse command line arguments. ----------------------------------------------------------------------------*/
+    ArgParser &AP = C.arg_parser();
+    args_t args;
+#define ADD(TYPE, VAR, INIT, SHORT, LONG, DESCR, CALLBACK)\
+    VAR = INIT;\
+    {\
+        AP.add<TYPE>(SHORT, LONG, DESCR, CALLBACK);\
+    }
+    ADD(bool, Options::Get().show_help, false,                                          /* Type, Var, Init  */
+        "-h", "--help",                                                                 /* Short, Long      */
+        "prints this help message",                                                     /* Description      */
+        [&](bool) { Options::Get().show_help = true; });                                /* Callback         */
+    ADD(bool, Options::Get().quiet, false,                                              /* Type, Var, Init  */
+        "-q", "--quiet",                                                                /* Short, Long      */
+        "work in quiet mode",                                                           /* Description      */
+        [&](bool) { Options::Get().quiet = true; });                                    /* Callback         */
+    ADD(const char*, args.log, nullptr,                                                 /* Type, Var, Init  */
+        nullptr, "--log",                                                               /* Short, Long      */
+        "the query log to replay",                                                      /* Description      */
+        [&](const char *path) { args.log = path; });                                    /* Callback         */
+    ADD(unsigned, args.num_sessions, 8,                                                 /* Type, Var, Init  */
+        nullptr, "--sessions",                                                          /* Short, Long      */
+        "the number of concurrent sessions issuing the queries",                        /* Description      */
+        [&](unsigned n) { args.num_sessions = std::max(n, 1U); });                      /* Callback         */
+    ADD(double, args.speed, 1,                                                          /* Type, Var, Init  */
+        nullptr, "--speed",                                                             /* Short, Long      */
+        "replay this many times faster than logged, 0 to issue every query as soon as its session is idle",
+        [&](double speed) { args.speed = std::max(speed, 0.); });                       /* Callback         */
+    ADD(const char*, args.output, nullptr,                                              /* Type, Var, Init  */
+        nullptr, "--output",                                                            /* Short, Long      */
+        "write the latency quantiles per query label as CSV to this file, e.g. to serve as baseline",
+        [&](const char *path) { args.output = path; });                                 /* Callback         */
+    ADD(const char*, args.baseline, nullptr,                                            /* Type, Var, Init  */
+        nullptr, "--baseline",                                                          /* Short, Long      */
+        "compare the latency quantiles to those of this CSV file written by `--output` and fail on regressions",
+        [&](const char *path) { args.baseline = path; });                               /* Callback         */
+    ADD(double, args.tolerance, .1,                                                     /* Type, Var, Init  */
+        nullptr, "--tolerance",                                                         /* Short, Long      */
+        "the relative increase of a latency quantile over the baseline reported as regression",
+        [&](double tolerance) { args.tolerance = tolerance; });                         /* Callback         */
+#undef ADD
+    AP.parse_args(argc, argv);
+
+    if (Options::Get().show_help) {
+        usage(std::cout, argv[0]);
+        std::cout << "WHERE\n" << AP;
+        std::exit(EXIT_SUCCESS);
+    }
+    if (not args.log) {
+        usage(std::cerr, argv[0]);
+        std::exit(EXIT_FAILURE);
+    }
+
+    /*----- Execute the given files, e.g. to create the schema and load the data. -----------------------------------*/
+    Diagnostic diag(false, std::cout, std::cerr);
+    for (auto filename : AP.args())
+        execute_file(diag, std::filesystem::path(filename));
+    if (diag.num_errors())
+        std::exit(EXIT_FAILURE);
+
+    /*----- Distribute the queries of the clients to the sessions. ---------------------------------------------------*/
+    const auto queries = read_log(args.log);
+    std::vector<std::vector<const query_t*>> sessions(args.num_sessions);
+    for (auto &query : queries)
+        sessions[query.client % args.num_sessions].push_back(&query);
+    for (auto &session : sessions)
+        std::stable_sort(session.begin(), session.end(), [](auto lhs, auto rhs) {
+            return lhs->timestamp < rhs->timestamp;
+        });
+
+    /*----- Replay the sessions concurrently. ------------------------------------------------------------------------*/
+    std::vector<std::map<std::string, latencies_t>> session_latencies(args.num_sessions);
+    std::vector<std::thread> threads;
+    const auto start = clock_type::now();
+    for (unsigned i = 0; i != args.num_sessions; ++i)
+        threads.emplace_back(replay_session, std::cref(sessions[i]), std::cref(args), start,
+                             std::ref(session_latencies[i]));
+    for (auto &thread : threads)
+        thread.join();
+    const std::chrono::duration<double> duration = clock_type::now() - start;
+
+    /*----- Merge the latencies of the sessions, overall under the label `*`. ----------------------------------------*/
+    std::map<std::string, latencies_t> latencies;
+    for (auto &session : session_latencies) {
+        for (auto &[label, L] : session) {
+            for (auto *merged : { &latencies[label], &latencies["*"] }) {
+                merged->samples.insert(merged->samples.end(), L.samples.begin(), L.samples.end());
+                merged->num_errors += L.num_errors;
+            }
+        }
+    }
+    for (auto &[_, L] : latencies)
+        std::sort(L.samples.begin(), L.samples.end());
+
+    /*----- Report. --------------------------------------------------------------------------------------------------*/
+    if (not Options::Get().quiet) {
+        std::cout << "Replayed " << queries.size() << " queries with " << args.num_sessions << " sessions in "
+                  << duration.count() << " s, i.e. " << queries.size() / duration.count() << " queries/s\n";
+        write_latencies(std::cout, latencies);
+    }
+    if (args.output) {
+        std::ofstream out(args.output);
+        write_latencies(out, latencies);
+    }
+    if (args.baseline) {
+        if (compare_latencies(std::cout, args.baseline, latencies, args.tolerance))
+            std::exit(EXIT_FAILURE);
+    }
+    std::exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,422 @@
+#include "catalog/Cluster.hpp"
+#include "catalog/Replication.hpp"
+#include "catalog/ResultSinks.hpp"
+#include "util/WireProtocol.hpp"
+#include "util/WorkerPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutable/mutable.hpp>
+#include <mutable/Options.hpp>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+
+using namespace m;
+using namespace m::wire;
+namespace ip = boost::asio::ip;
+
+
+struct args_t
+{
+    ///> the address to listen on
+    const char *address;
+    ///> the port to listen on
+    unsigned port;
+    ///> the maximum number of concurrently served clients
+    unsigned max_connections;
+    ///> the maximum number of rows per record batch
+    std::size_t batch_size;
+};
+
+void usage(std::ostream &out, const char *name)
+{
+    out << "A server executing the queries of many concurrent clients on a single, shared instance of the database "
+           "system.  The <FILE>s, e.g. schema definitions and data imports, are executed before accepting clients.\n"
+        << "USAGE:\n\t" << name << " [<FILE>...]"
+        << std::endl;
+}
+
+
+/*======================================================================================================================
+ * Connection
+ *====================================================================================================================*/
+
+/** A connection to a client, served by its own thread.  The requests of the client, see `m::wire`, are executed one
+ * after the other in the client's explicit transaction, if any, and in a transaction of their own otherwise.  Results
+ * are streamed to the client in record batches while the query is executed. */
+struct Connection
+{
+    private:
+    ip::tcp::socket socket_;
+    const args_t &args_;
+    ///> the explicit transaction of the client, if any
+    std::unique_ptr<Scheduler::Transaction> transaction_;
+    ///> whether sending to the client failed, e.g. because the client disconnected
+    bool broken_ = false;
+
+    public:
+    Connection(ip::tcp::socket socket, const args_t &args) : socket_(std::move(socket)), args_(args) { }
+    Connection(const Connection&) = delete;
+
+    ~Connection() {
+        if (transaction_)
+            Catalog::Get().scheduler().abort(std::move(transaction_));
+    }
+
+    /** Serves the requests of the client until it terminates the connection. */
+    void serve();
+    /** Refuses to serve the client for the reason \p reason. */
+    void refuse(std::string_view reason) { send(MSG_ERROR, reason); }
+
+    private:
+    /** Reads the next message of the client.  Returns `std::nullopt` if the client closed the connection. */
+    std::optional<std::pair<message_type, std::string>> receive();
+    /** Sends the message of type \p type with payload \p payload to the client. */
+    void send(message_type type, std::string_view payload = {});
+
+    /** Executes the SQL statement or instruction \p sql and streams its results to the client.  \p prepare, if given,
+     * is invoked with the transaction executing \p sql before \p sql is scheduled. */
+    void execute(const std::string &sql,
+                 const std::function<void(const Scheduler::Transaction&)> &prepare = nullptr);
+    /** Appends the record batch of the `MSG_APPEND` payload \p payload to its table. */
+    void append(std::string_view payload);
+    /** Applies the transaction of the `MSG_REPLICATE` payload \p payload, shipped by the primary of this replica. */
+    void replicate(std::string_view payload);
+    /** Begins, commits, or aborts the explicit transaction of the client, as requested by \p type. */
+    void control_transaction(message_type type);
+};
+
+void Connection::serve()
+{
+    while (not broken_) {
+        auto msg = receive();
+        if (not msg)
+            return;
+        auto &[type, payload] = *msg;
+        switch (type) {
+            case MSG_QUERY:
+                execute(payload);
+                break;
+
+            case MSG_APPEND:
+                append(payload);
+                break;
+
+            case MSG_REPLICATE:
+                replicate(payload);
+                break;
+
+            case MSG_BEGIN:
+            case MSG_COMMIT:
+            case MSG_ABORT:
+                control_transaction(type);
+                break;
+
+            case MSG_TERMINATE:
+                return;
+
+            default:
+                send(MSG_ERROR, "unknown message type");
+                return;
+        }
+    }
+}
+
+std::optional<std::pair<message_type, std::string>> Connection::receive()
+{
+    char header[HEADER_SIZE];
+    boost::system::error_code ec;
+    boost::asio::read(socket_, boost::asio::buffer(header, HEADER_SIZE), ec);
+    if (ec)
+        return std::nullopt;
+    auto [type, length] = decode_header(header);
+    std::string payload(length, '\0');
+    boost::asio::read(socket_, boost::asio::buffer(payload.data(), length), ec);
+    if (ec)
+        return std::nullopt;
+    return std::make_pair(type, std::move(payload));
+}
+
+void Connection::send(message_type type, std::string_view payload)
+{
+    if (broken_)
+        return;
+    std::string buffer;
+    buffer.reserve(HEADER_SIZE + payload.size());
+    append_message(buffer, type, payload);
+    boost::system::error_code ec;
+    boost::asio::write(socket_, boost::asio::buffer(buffer), ec);
+    broken_ = bool(ec);
+}
+
+void Connection::execute(const std::string &sql,
+                         const std::function<void(const Scheduler::Transaction&)> &prepare)
+{
+    Scheduler &S = Catalog::Get().scheduler();
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    auto command = command_from_string(diag, sql);
+    if (diag.num_errors() or not command) {
+        send(MSG_ERROR, err.str());
+        return;
+    }
+    if (Replication::Is_Replica() and not is<ast::SelectStmt>(*command) and not is<ast::UseDatabaseStmt>(*command) and
+        not is<ast::Instruction>(*command))
+    {
+        send(MSG_ERROR, "This is a read-only replica, changes must be sent to the primary.\n");
+        return;
+    }
+
+    /*----- Execute the command in the explicit transaction, if any, and in a transaction of its own otherwise. -----*/
+    std::unique_ptr<Scheduler::Transaction> autocommit;
+    Scheduler::Transaction *t = transaction_.get();
+    if (not t) {
+        autocommit = S.begin_transaction();
+        t = autocommit.get();
+    }
+    if (prepare)
+        prepare(*t);
+
+    /*----- Stream the results in record batches.  The sink is invoked by the thread executing the query. -----*/
+    std::optional<BatchWriter> batch;
+    ResultSinks::Get().add(*t, [this, &batch](const Schema &schema, const Tuple &tuple) {
+        if (not batch) {
+            batch.emplace(schema);
+            send(MSG_SCHEMA, encode_schema(schema));
+        }
+        batch->append(tuple);
+        if (batch->num_rows() == args_.batch_size)
+            send(MSG_BATCH, batch->finish());
+    });
+    bool success = S.schedule_command(*t, std::move(command), diag).get();
+    ResultSinks::Get().remove(*t);
+    Cluster::Get().take_staged(t); // discard record batches that were not appended, e.g. due to an error
+    if (batch and batch->num_rows())
+        send(MSG_BATCH, batch->finish());
+    success = success and diag.num_errors() == 0;
+
+    if (autocommit) {
+        if (success)
+            success = S.commit(std::move(autocommit));
+        else
+            S.abort(std::move(autocommit));
+    }
+
+    if (not out.str().empty())
+        send(MSG_OUTPUT, out.str());
+    if (success)
+        send(MSG_READY);
+    else
+        send(MSG_ERROR, err.str());
+}
+
+void Connection::append(std::string_view payload)
+{
+    if (Replication::Is_Replica()) {
+        send(MSG_ERROR, "This is a read-only replica, changes must be sent to the primary.\n");
+        return;
+    }
+
+    std::string table_name;
+    std::string_view batch;
+    try {
+        std::tie(table_name, batch) = decode_append(payload);
+    } catch (m::invalid_argument) {
+        send(MSG_ERROR, "malformed append message");
+        return;
+    }
+
+    /*----- Stage the batch for the transaction, in which the `\append_batches` instruction appends it. -----*/
+    execute("\\append_batches;", [&](const Scheduler::Transaction &t) {
+        Cluster::Get().stage(t, std::move(table_name), std::string(batch));
+    });
+}
+
+void Connection::replicate(std::string_view payload)
+{
+    if (not Replication::Is_Replica()) {
+        send(MSG_ERROR, "Not a replica, see --read-only-replica.\n");
+        return;
+    }
+    ReplicatedTransaction transaction;
+    try {
+        transaction = decode_replicate(payload);
+    } catch (m::invalid_argument) {
+        send(MSG_ERROR, "malformed replicate message");
+        return;
+    }
+    auto &R = Replication::Get();
+    if (transaction.position <= R.applied_position())
+        return send(MSG_READY); // applied before, e.g. when the primary retries after a lost acknowledgement
+    if (transaction.position != R.applied_position() + 1)
+        return send(MSG_ERROR, "Transactions preceding the shipped transaction are missing.\n");
+
+    /*----- Apply the changes in a single transaction, appending consecutive record batches by a single command. ----*/
+    Scheduler &S = Catalog::Get().scheduler();
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+    auto t = S.begin_transaction();
+    auto run = [&](const std::string &sql) {
+        auto command = command_from_string(diag, sql);
+        if (diag.num_errors() or not command)
+            return false;
+        return S.schedule_command(*t, std::move(command), diag).get() and diag.num_errors() == 0;
+    };
+    bool success = true;
+    const std::string *database = nullptr; ///< the database in use by the previous change
+    auto &changes = transaction.changes;
+    for (auto it = changes.begin(); success and it != changes.end(); ) {
+        if (not it->database.empty() and (not database or *database != it->database))
+            success = run("USE " + it->database + ";");
+        database = &it->database;
+        if (not success)
+            break;
+
+        if (it->table.empty()) {
+            success = run(it->data);
+            ++it;
+            continue;
+        }
+        auto end = std::find_if(it, changes.end(), [&](const ReplicatedChange &change) {
+            return change.table.empty() or change.database != it->database;
+        });
+        for (; it != end; ++it)
+            Cluster::Get().stage(*t, std::move(it->table), std::move(it->data));
+        success = run("\\append_batches;");
+        Cluster::Get().take_staged(t.get()); // discard record batches that were not appended
+    }
+
+    if (success)
+        success = S.commit(std::move(t));
+    else
+        S.abort(std::move(t));
+    if (not success)
+        return send(MSG_ERROR, err.str());
+    R.applied(transaction);
+    send(MSG_READY);
+}
+
+void Connection::control_transaction(message_type type)
+{
+    Scheduler &S = Catalog::Get().scheduler();
+    switch (type) {
+        default:
+            M_unreachable("not a transaction control message");
+
+        case MSG_BEGIN:
+            if (transaction_)
+                return send(MSG_ERROR, "already in a transaction");
+            transaction_ = S.begin_transaction();
+            return send(MSG_READY);
+
+        case MSG_COMMIT:
+            if (not transaction_)
+                return send(MSG_ERROR, "not in a transaction");
+            if (S.commit(std::move(transaction_)))
+                return send(MSG_READY);
+            return send(MSG_ERROR, "could not commit the transaction");
+
+        case MSG_ABORT:
+            if (not transaction_)
+                return send(MSG_ERROR, "not in a transaction");
+            S.abort(std::move(transaction_));
+            return send(MSG_READY);
+    }
+}
+
+
+/*======================================================================================================================
+ * main
+ *====================================================================================================================*/
+
+int main(int argc, const char **argv)
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Parse command line arguments. ----------------------------------------------------------------------------*/
+    ArgParser &AP = C.arg_parser();
+    args_t args;
+#define ADD(TYPE, VAR, INIT, SHORT, LONG, DESCR, CALLBACK)\
+    VAR = INIT;\
+    {\
+        AP.add<TYPE>(SHORT, LONG, DESCR, CALLBACK);\
+    }
+    ADD(bool, Options::Get().show_help, false,                                          /* Type, Var, Init  */
+        "-h", "--help",                                                                 /* Short, Long      */
+        "prints this help message",                                                     /* Description      */
+        [&](bool) { Options::Get().show_help = true; });                                /* Callback         */
+    ADD(bool, Options::Get().quiet, false,                                              /* Type, Var, Init  */
+        "-q", "--quiet",                                                                /* Short, Long      */
+        "work in quiet mode",                                                           /* Description      */
+        [&](bool) { Options::Get().quiet = true; });                                    /* Callback         */
+    ADD(const char*, args.address, "127.0.0.1",                                         /* Type, Var, Init  */
+        nullptr, "--address",                                                           /* Short, Long      */
+        "the address to listen on",                                                     /* Description      */
+        [&](const char *str) { args.address = str; });                                  /* Callback         */
+    ADD(unsigned, args.port, 5433,                                                      /* Type, Var, Init  */
+        "-p", "--port",                                                                 /* Short, Long      */
+        "the port to listen on",                                                        /* Description      */
+        [&](unsigned port) { args.port = port; });                                      /* Callback         */
+    ADD(unsigned, args.max_connections, 64,                                             /* Type, Var, Init  */
+        nullptr, "--max-connections",                                                   /* Short, Long      */
+        "the maximum number of concurrently connected clients",                         /* Description      */
+        [&](unsigned n) { args.max_connections = n; });                                 /* Callback         */
+    ADD(std::size_t, args.batch_size, 64 * 1024,                                        /* Type, Var, Init  */
+        nullptr, "--batch-size",                                                        /* Short, Long      */
+        "the maximum number of rows per record batch sent to clients",                  /* Description      */
+        [&](std::size_t n) { args.batch_size = std::max<std::size_t>(n, 1); });         /* Callback         */
+#undef ADD
+    AP.parse_args(argc, argv);
+
+    if (Options::Get().show_help) {
+        usage(std::cout, argv[0]);
+        std::cout << "WHERE\n" << AP;
+        std::exit(EXIT_SUCCESS);
+    }
+    if (args.port > UINT16_MAX) {
+        std::cerr << "Invalid port " << args.port << ".\n";
+        std::exit(EXIT_FAILURE);
+    }
+
+    /*----- Execute the given files, e.g. to create the schema and load the data. -----------------------------------*/
+    Diagnostic diag(false, std::cout, std::cerr);
+    for (auto filename : AP.args())
+        execute_file(diag, std::filesystem::path(filename));
+    if (diag.num_errors())
+        std::exit(EXIT_FAILURE);
+
+    /*----- Accept clients. ------------------------------------------------------------------------------------------*/
+    boost::asio::io_context io_ctx(/* concurrency_level= */ 1);
+    ip::tcp::acceptor acceptor(io_ctx, { ip::make_address(args.address), uint16_t(args.port) });
+    if (not Options::Get().quiet)
+        std::cout << "Listening on " << args.address << ':' << args.port << std::endl;
+
+    std::atomic<unsigned> num_connections = 0;
+    for (;;) {
+        ip::tcp::socket socket(io_ctx);
+        acceptor.accept(socket);
+        if (num_connections.fetch_add(1) >= args.max_connections) {
+            num_connections.fetch_sub(1);
+            Connection(std::move(socket), args).refuse("too many connections");
+            continue;
+        }
+        std::thread([socket=std::move(socket), &args, &num_connections]() mutable {
+            WorkerPool::Pin_To_Reserved_CPUs();
+            Connection(std::move(socket), args).serve();
+            num_connections.fetch_sub(1);
+        }).detach();
+    }
+}
@@ -1,4 +1,5 @@
 #include "util/glyphs.hpp"
+#include "util/TraceEvents.hpp"
 #include <cerrno>
 #include <cstdlib>
 #include <dlfcn.h>
@@ -390,6 +391,11 @@ int main(int argc, const char **argv)
         "train cost models (may take a couple of minutes)",             /* Description      */
         [&](bool) { Options::Get().train_cost_models = true; }          /* Callback         */
     );
+    const char *trace_events_file;
+    ADD(const char*, trace_events_file, nullptr,                                        /* Type, Var, Init  */
+        nullptr, "--trace-events",                                                      /* Short, Long      */
+        "write the timings to the given file in Chrome's Trace Event Format",           /* Description      */
+        [&](const char *str) { trace_events_file = str; });                             /* Callback         */
     /*------ Plugins -------------------------------------------------------------------------------------------------*/
     ADD(const char*, Options::Get().plugins, nullptr,                                   /* Type, Var, Init  */
         nullptr, "--plugins",                                                           /* Short, Long      */
@@ -661,6 +667,15 @@ Immanuel Haffner\
         }
     }
 
+    /* Write the timings for trace viewers like Perfetto. */
+    if (trace_events_file) {
+        std::ofstream out(trace_events_file);
+        if (out)
+            write_trace_events(out, C.timer());
+        else
+            diag.err() << "Could not open file '" << trace_events_file << "' to write the trace events." << std::endl;
+    }
+
     /* Explicitly destroy the `Catalog` to dispose of all held resources.  This is particularly important as the address
      * sanitizer scans for leaked allocations *before* any `__attribute((destructor))__` annotated functions are run. */
     Catalog::Destroy();
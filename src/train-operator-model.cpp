@@ -1,3 +1,4 @@
+#include "catalog/OperatorCalibration.hpp"
 #include "storage/store_manip.hpp"
 #include "util/GridSearch.hpp"
 #include <Eigen/LU>
@@ -8,6 +9,7 @@
 #include <mutable/IR/Operator.hpp>
 #include <mutable/Options.hpp>
 #include <mutable/util/ArgParser.hpp>
+#include <sched.h>
 
 
 using namespace m;
@@ -157,6 +159,10 @@ int main(int argc, const char **argv)
         const char* eval_group_by_model;
         const char* eval_join_model;
 
+        /* Operator Calibration */
+        const char* calibrate;
+        unsigned calibration_rows;
+
         /* Filter Model polynomial degree*/
         unsigned degree;
 
@@ -173,6 +179,9 @@ int main(int argc, const char **argv)
 
         /* Catalog Options */
         const char *backend;
+
+        /* Measurement Options */
+        int pin_cpu;
     } args;
 
     /*----- Parse command line arguments. ----------------------------------------------------------------------------*/
@@ -223,6 +232,15 @@ int main(int argc, const char **argv)
         nullptr, "--eval_join",                                                     /* Short, Long      */
         "load & evaluate a join model from csv file",                               /* Description      */
         [&](const char *str) { args.eval_join_model = str; });                      /* Callback         */
+    ADD(const char *, args.calibrate, nullptr,                                      /* Type, Var, Init  */
+        nullptr, "--calibrate",                                                     /* Short, Long      */
+        "measure the cost coefficients of the physical operators and save them in " /* Description      */
+        "the given file, to be loaded with `--operator-calibration`",
+        [&](const char *str) { args.calibrate = str; });                            /* Callback         */
+    ADD(unsigned, args.calibration_rows, 1e6,                                       /* Type, Var, Init  */
+        nullptr, "--calibration-rows",                                              /* Short, Long      */
+        "set the number of rows of the tables used for calibration (default = 1e6)",/* Description      */
+        [&](unsigned nr) { args.calibration_rows = nr; });                          /* Callback         */
     ADD(int, args.degree, 9,                                                        /* Type, Var, Init  */
         nullptr, "--degree",                                                        /* Short, Long      */
         "set the polynomial degree used in the filter cost model (default = 9)",    /* Description      */
@@ -275,6 +293,11 @@ int main(int argc, const char **argv)
             }
         }
     );
+    /*----- Measurement ----------------------------------------------------------------------------------------------*/
+    ADD(int, args.pin_cpu, -1,                                                      /* Type, Var, Init  */
+        nullptr, "--pin-cpu",                                                       /* Short, Long      */
+        "pin the process to this CPU to isolate the timed training queries",        /* Description      */
+        [&](int cpu) { args.pin_cpu = cpu; });                                      /* Callback         */
 #undef ADD
     AP.parse_args(argc, argv);
 
@@ -290,6 +313,30 @@ int main(int argc, const char **argv)
         std::exit(EXIT_FAILURE);
     }
 
+    /* Pin the process, and hence all timed queries, to a single CPU to avoid migrations distorting the measurements. */
+    if (args.pin_cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(args.pin_cpu, &cpus);
+        if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+            std::cerr << "ERROR: Could not pin the process to CPU " << args.pin_cpu << ".\n";
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    if (args.calibrate) {
+        std::ofstream out(args.calibrate);
+        if (not out) {
+            std::cerr << "Filepath \"" << args.calibrate << "\" is invalid.";
+            exit(EXIT_FAILURE);
+        }
+        std::cout << "Calibration will be written to '" << args.calibrate << "'.\n";
+        OperatorCalibration::Get().coefficients(OperatorCalibration::Calibrate(args.calibration_rows));
+        OperatorCalibration::Get().save(out);
+        OperatorCalibration::Get().save(std::cout);
+        exit(EXIT_SUCCESS);
+    }
+
     if (args.gen_filter_model) {
         std::cout << "Measurement data will be written to '" << args.gen_filter_model << "'.\n";
         auto costmodel = CostModelFactory::get_cost_model<int32_t>(OperatorKind::FilterOperator,
@@ -14,49 +14,41 @@ AdjacencyMatrix AdjacencyMatrix::transitive_closure_directed() const
 {
     AdjacencyMatrix closure(*this); // copy
 
-    bool changed;
-    do {
-        changed = false;
+    /* Warshall's algorithm on bitset rows: after iteration `k`, row `i` contains all vertices reachable from `i` via
+     * intermediate vertices in `{ 0, ..., k }`.  Every update ORs an entire row, i.e. processes all columns at once. */
+    for (std::size_t k = 0; k != num_vertices_; ++k) {
+        const SmallBitset row_k = closure.m_[k];
         for (std::size_t i = 0; i != num_vertices_; ++i) {
-            for (std::size_t j = 0; j != num_vertices_; ++j) {
-                if (not closure(i, j)) {
-                    const SmallBitset row = closure.m_[i];
-                    const SmallBitset col_mask = SmallBitset::Singleton(j);
-                    for (std::size_t k : row) {
-                        M_insist(row[k]);
-                        if (closure.m_[k] & col_mask) {
-                            closure(i, j) = true;
-                            changed = true;
-                            break;
-                        }
-                    }
-                }
-            }
+            if (closure.m_[i][k])
+                closure.m_[i] |= row_k;
         }
-    } while (changed);
+    }
 
     return closure;
 }
 
 AdjacencyMatrix AdjacencyMatrix::transitive_closure_undirected() const
 {
-    AdjacencyMatrix closure(*this); // copy
+    AdjacencyMatrix closure(num_vertices_);
 
-    bool changed;
-    do {
-        changed = false;
-        for (std::size_t i = 0; i != num_vertices_; ++i) {
-            for (std::size_t j = i; j != num_vertices_; ++j) { // exploit symmetry
-                M_insist(closure(i, j) == closure(j, i), "not symmetric");
-                const bool before = closure(i, j);
-                const SmallBitset row = closure.m_[i];
-                const SmallBitset col = closure.m_[j]; // exploit symmetry
-                const bool dot = not (row & col).empty(); // compute connected-ness as "dot product"
-                closure(i, j) = closure(j, i) = dot;
-                changed = changed or before != dot;
-            }
+    /* Compute the connected components by expanding each component by its neighborhood until it no longer grows.  A
+     * component is connected to itself entirely, unless it is a single vertex without an edge. */
+    SmallBitset vertices_remaining = SmallBitset::All(num_vertices_);
+    while (vertices_remaining) {
+        SmallBitset component = vertices_remaining.begin().as_set();
+        SmallBitset edges; // union of the neighborhoods of `component`, including self-loops
+        for (SmallBitset frontier = component; frontier; ) {
+            for (std::size_t v : frontier)
+                edges |= this->m_[v];
+            frontier = edges - component;
+            component |= frontier;
         }
-    } while (changed);
+        vertices_remaining = vertices_remaining - component;
+        if (edges.empty())
+            continue; // isolated vertex
+        for (std::size_t v : component)
+            closure.m_[v] = component;
+    }
 
     return closure;
 }
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+
+namespace m {
+
+/** Kernels on dates and datetimes as they are encoded in tuples and stores.  A date is an `int32_t` with the year in
+ * the upper 23 bits, the month in the next 4 bits, and the day in the lowest 5 bits, i.e. `year << 9 | month << 5 |
+ * day`.  Hence, dates compare like integers.  A datetime is an `int64_t` of the seconds since the UNIX epoch.
+ *
+ * All kernels are free of data-dependent branches, such that they can be applied to columns in tight loops.  The
+ * conversions between dates and days since the epoch follow Howard Hinnant's `days_from_civil()` and
+ * `civil_from_days()`, see https://howardhinnant.github.io/date_algorithms.html. */
+namespace date {
+
+constexpr int64_t SECONDS_PER_DAY = 24 * 60 * 60;
+
+/** Returns the date of \p year, \p month, and \p day. */
+constexpr int32_t encode(int32_t year, unsigned month, unsigned day)
+{
+    return int32_t(uint32_t(year) << 9 | month << 5 | day);
+}
+
+/** Returns the year of \p date. */
+constexpr int32_t year(int32_t date) { return date >> 9; } // arithmetic shift because year is signed
+/** Returns the month of \p date, in the range 1 to 12. */
+constexpr unsigned month(int32_t date) { return (date >> 5) & 0xF; }
+/** Returns the day of \p date, in the range 1 to 31. */
+constexpr unsigned day(int32_t date) { return date & 0x1F; }
+
+/** Returns `true` iff \p year is a leap year. */
+constexpr bool is_leap_year(int32_t year) { return (year % 4 == 0) & ((year % 100 != 0) | (year % 400 == 0)); }
+
+/** Returns the number of days of \p month of \p year. */
+constexpr unsigned days_in_month(int32_t year, unsigned month)
+{
+    /* 30 or 31 days alternating, flipping after July; February is corrected below. */
+    const unsigned days = 30 + ((month + (month >> 3)) & 1);
+    return month == 2 ? 28 + is_leap_year(year) : days;
+}
+
+/** Returns the number of days from the UNIX epoch to \p date. */
+constexpr int32_t to_days(int32_t date)
+{
+    const unsigned m = month(date);
+    const int32_t y = year(date) - (m <= 2);
+    const int32_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = unsigned(y - era * 400); // [0, 399]
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + day(date) - 1; // [0, 365]
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy; // [0, 146096]
+    return era * 146097 + int32_t(doe) - 719468;
+}
+
+/** Returns the date \p days days after the UNIX epoch. */
+constexpr int32_t from_days(int32_t days)
+{
+    days += 719468;
+    const int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = unsigned(days - era * 146097); // [0, 146096]
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365; // [0, 399]
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100); // [0, 365]
+    const unsigned mp = (5 * doy + 2) / 153; // [0, 11], starting in March
+    const unsigned d = doy - (153 * mp + 2) / 5 + 1; // [1, 31]
+    const unsigned m = mp < 10 ? mp + 3 : mp - 9; // [1, 12]
+    return encode(int32_t(yoe) + era * 400 + (m <= 2), m, d);
+}
+
+/** Returns the date \p n days after \p date. */
+constexpr int32_t add_days(int32_t date, int32_t n) { return from_days(to_days(date) + n); }
+
+/** Returns the date \p n months after \p date.  The day is clamped to the last day of the resulting month, e.g. one
+ * month after January 31 is February 28 or 29. */
+constexpr int32_t add_months(int32_t date, int32_t n)
+{
+    const int32_t months = year(date) * 12 + int32_t(month(date)) - 1 + n;
+    const int32_t y = (months >= 0 ? months : months - 11) / 12; // floor division
+    const unsigned m = unsigned(months - y * 12) + 1;
+    return encode(y, m, std::min(day(date), days_in_month(y, m)));
+}
+
+/** Returns the first day of the month of \p date. */
+constexpr int32_t trunc_month(int32_t date) { return (date & ~0x1F) | 1; }
+/** Returns the first day of the year of \p date. */
+constexpr int32_t trunc_year(int32_t date) { return (date & ~0x1FF) | 1 << 5 | 1; }
+
+/** Returns the smallest and the largest encoding of a date in \p year.  A predicate `year(d) = y` is equivalent to
+ * the range predicate `d BETWEEN lo AND hi`, which can be answered by indexes and zone maps. */
+constexpr std::pair<int32_t, int32_t> year_bounds(int32_t year) { return { encode(year, 0, 0), encode(year, 15, 31) }; }
+/** Returns the smallest and the largest encoding of a date in \p month of \p year, see `year_bounds()`. */
+constexpr std::pair<int32_t, int32_t> month_bounds(int32_t year, unsigned month)
+{
+    return { encode(year, month, 0), encode(year, month, 31) };
+}
+
+/** Returns the date of the datetime \p time. */
+constexpr int32_t from_datetime(int64_t time)
+{
+    return from_days(int32_t((time >= 0 ? time : time - (SECONDS_PER_DAY - 1)) / SECONDS_PER_DAY));
+}
+/** Returns the datetime of midnight of \p date. */
+constexpr int64_t to_datetime(int32_t date) { return int64_t(to_days(date)) * SECONDS_PER_DAY; }
+
+/** Returns the datetime \p time truncated to a multiple of \p seconds since the epoch, e.g. to bucket datetimes by the
+ * hour with `seconds = 3600`. */
+constexpr int64_t trunc_datetime(int64_t time, int64_t seconds)
+{
+    const int64_t rem = time % seconds;
+    return time - rem - (rem < 0 ? seconds : 0);
+}
+
+}
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "util/WorkerPool.hpp"
 #include <algorithm>
 #include <array>
 #include <cfenv>
@@ -155,6 +156,12 @@ struct GridSearch
     void search(callback_type fn) const;
     void operator()(callback_type fn) const { search(fn); }
 
+    /** Evaluates \p fn at all points of the grid, distributed to up to \p num_threads threads of the `WorkerPool`, or
+     * to all of its threads if \p num_threads is 0.  Each thread evaluates a contiguous range of points in the order of
+     * `search()`, but the ranges are evaluated concurrently.  Hence, \p fn must be thread-safe, and this is only suited
+     * for pure computations, not for timing measurements. */
+    void search_parallel(callback_type fn, unsigned num_threads = 0) const;
+
 M_LCOV_EXCL_START
     friend std::ostream & operator<<(std::ostream &out, const GridSearch &GS) {
         out << "grid search with";
@@ -178,6 +185,19 @@ M_LCOV_EXCL_STOP
             return std::make_tuple(space(counters[I])...);
         }, spaces_);
     }
+
+    /** Returns the counters of the \p n-th point of the grid in the order of `search()`. */
+    std::array<unsigned, NUM_SPACES> counters_of(std::size_t n) const {
+        const std::array<unsigned, NUM_SPACES> num_steps = std::apply([](auto&... space) {
+            return std::array<unsigned, NUM_SPACES>{ space.num_steps()... };
+        }, spaces_);
+        std::array<unsigned, NUM_SPACES> counters;
+        for (std::size_t idx = NUM_SPACES; idx-- != 0; ) {
+            counters[idx] = n % (num_steps[idx] + 1);
+            n /= num_steps[idx] + 1;
+        }
+        return counters;
+    }
 };
 
 template<typename... Spaces>
@@ -205,6 +225,23 @@ void GridSearch<Spaces...>::search(callback_type fn) const
 finished:;
 }
 
+template<typename... Spaces>
+void GridSearch<Spaces...>::search_parallel(callback_type fn, unsigned num_threads) const
+{
+    const std::size_t n = num_points();
+    auto &pool = WorkerPool::Get();
+    const std::size_t num_ranges = std::clamp<std::size_t>(num_threads ? num_threads : pool.num_threads(), 1, n);
+    if (num_ranges == 1)
+        return search(fn);
+
+    pool.parallel_for(num_ranges, [this, &fn, n, num_ranges](std::size_t t) {
+        for (std::size_t i = n * t / num_ranges, end = n * (t + 1) / num_ranges; i != end; ++i) {
+            auto counters = counters_of(i);
+            std::apply(fn, make_args(counters, std::index_sequence_for<Spaces...>{}));
+        }
+    }, num_ranges);
+}
+
 }
 
 }
@@ -1,5 +1,7 @@
 #include "util/Kmeans.hpp"
 
+#include "util/WorkerPool.hpp"
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <limits>
@@ -12,6 +14,59 @@ using namespace Eigen;
 
 
 static constexpr unsigned KMEANS_MAX_ITERATIONS = 100;
+/** The number of data points from which on *k*-means runs in mini-batch mode. */
+static constexpr std::size_t KMEANS_MINI_BATCH_THRESHOLD = 1UL << 16;
+/** The number of data points sampled per iteration in mini-batch mode. */
+static constexpr std::size_t KMEANS_MINI_BATCH_SIZE = 1024;
+/** The number of data points whose distances to the centroids are computed at once. */
+static constexpr std::size_t KMEANS_BLOCK_SIZE = 1024;
+/** The minimal number of data points assigned by a thread of their own. */
+static constexpr std::size_t KMEANS_MIN_ROWS_PER_THREAD = 4 * KMEANS_BLOCK_SIZE;
+
+
+namespace {
+
+/** Assigns each data point in the rows `[begin, end)` of \p data to its nearest centroid and returns whether any label
+ * changed.  The squared distances of a block of data points to all centroids are computed at once as
+ * `||c||^2 - 2 * x * c`, i.e. by a single matrix product; `||x||^2` is the same for all centroids and thus omitted. */
+bool assign_rows(const MatrixXf &data, const MatrixRXf &centroids, const VectorXf &squared_norms,
+                 std::vector<unsigned> &labels, std::size_t begin, std::size_t end)
+{
+    bool change = false;
+    MatrixXf distances;
+    for (std::size_t block = begin; block < end; block += KMEANS_BLOCK_SIZE) {
+        const std::size_t num_rows = std::min(KMEANS_BLOCK_SIZE, end - block);
+        distances.noalias() = data.middleRows(block, num_rows) * centroids.transpose() * -2.f;
+        distances.rowwise() += squared_norms.transpose();
+        for (std::size_t i = 0; i != num_rows; ++i) {
+            unsigned label;
+            distances.row(i).minCoeff(&label);
+            change = change or labels[block + i] != label; // label has changed
+            labels[block + i] = label;
+        }
+    }
+    return change;
+}
+
+/** Assigns each data point of \p data to its nearest centroid, distributing the data points to up to \p num_threads
+ * threads of the `WorkerPool`, and returns whether any label changed. */
+bool assign(const MatrixXf &data, const MatrixRXf &centroids, std::vector<unsigned> &labels, unsigned num_threads)
+{
+    const std::size_t num_rows = data.rows();
+    const VectorXf squared_norms = centroids.rowwise().squaredNorm();
+    num_threads = std::clamp<std::size_t>(num_rows / KMEANS_MIN_ROWS_PER_THREAD, 1, std::max(num_threads, 1U));
+    const std::size_t rows_per_thread = (num_rows + num_threads - 1) / num_threads;
+
+    std::vector<char> changes(num_threads, false);
+    WorkerPool::Get().parallel_for(num_threads, [&](std::size_t t) {
+        changes[t] = assign_rows(data, centroids, squared_norms, labels, std::min(num_rows, t * rows_per_thread),
+                                 std::min(num_rows, (t + 1) * rows_per_thread));
+    }, num_threads);
+
+    return std::find(changes.begin(), changes.end(), true) != changes.end();
+}
+
+}
 
 
 MatrixRXf m::kmeans_plus_plus(const MatrixXf &data, unsigned k)
@@ -35,7 +90,8 @@ MatrixRXf m::kmeans_plus_plus(const MatrixXf &data, unsigned k)
     return centroids;
 }
 
-std::pair<std::vector<unsigned>, MatrixRXf> m::kmeans_with_centroids(const MatrixXf &data, unsigned k)
+std::pair<std::vector<unsigned>, MatrixRXf> m::kmeans_with_centroids(const MatrixXf &data, unsigned k,
+                                                                    unsigned num_threads)
 {
     M_insist(k >= 1, "kmeans requires at least one cluster");
     if (data.size() == 0) return std::make_pair(std::vector<unsigned>(), MatrixXf(0, data.cols()));
@@ -45,20 +101,36 @@ std::pair<std::vector<unsigned>, MatrixRXf> m::kmeans_with_centroids(const Matri
 
     std::vector<unsigned> labels(data.rows(), 0); // the labels assigned to the data points
     std::vector<unsigned> label_counters(k, 0); // the frequency of each label, used for iterative mean
+
+    if (std::size_t(data.rows()) >= KMEANS_MINI_BATCH_THRESHOLD) {
+        /*----- Mini-batch k-means: Move the centroids towards the data points of random samples. --------------------*/
+        std::mt19937 g(0);
+        std::uniform_int_distribution<Index> dist(0, data.rows() - 1);
+        MatrixXf batch(KMEANS_MINI_BATCH_SIZE, data.cols());
+        std::vector<unsigned> batch_labels(KMEANS_MINI_BATCH_SIZE, 0);
+        for (unsigned i = 0; i != KMEANS_MAX_ITERATIONS; ++i) {
+            for (std::size_t row_id = 0; row_id != KMEANS_MINI_BATCH_SIZE; ++row_id)
+                batch.row(row_id) = data.row(dist(g));
+            assign_rows(batch, centroids, centroids.rowwise().squaredNorm(), batch_labels, 0, KMEANS_MINI_BATCH_SIZE);
+            /* Each centroid is the iterative mean of all data points ever assigned to it, i.e. its learning rate
+             * decreases with the number of assigned data points. */
+            for (std::size_t row_id = 0; row_id != KMEANS_MINI_BATCH_SIZE; ++row_id) {
+                const auto l = batch_labels[row_id];
+                centroids.row(l) += (batch.row(row_id) - centroids.row(l)) / ++label_counters[l];
+            }
+        }
+
+        /*----- Assign all data points to the final centroids. -------------------------------------------------------*/
+        assign(data, centroids, labels, num_threads);
+        return std::make_pair(std::move(labels), std::move(centroids));
+    }
+
     bool change = true; // whether the assignment of labels changed
 
     unsigned i = KMEANS_MAX_ITERATIONS;
     while (change and i--) {
-        change = false;
-
         /*----- Assignment step: Compute nearest centroid for all data points. ---------------------------------------*/
-        for (unsigned row_id = 0; row_id != data.rows(); ++row_id) {
-            unsigned label;
-            auto deltas = (centroids.rowwise() - data.row(row_id)).rowwise().squaredNorm();
-            deltas.minCoeff(&label);
-            change = change or labels[row_id] != label; // label has changed
-            labels[row_id] = label;
-        }
+        change = assign(data, centroids, labels, num_threads);
 
         /*----- Update step: Compute new centroids as the mean of data points in the cluster. ------------------------*/
         label_counters.assign(k, 0); // reset frequencies
@@ -23,12 +23,19 @@ MatrixRXf M_EXPORT kmeans_plus_plus(const Eigen::MatrixXf &data, unsigned k);
  * assigns an integer label to each data point, identifying to which cluster the data point is assigned.  See
  * https://en.wikipedia.org/wiki/K-means_clustering.
  *
- * @param data the data to cluster, as `Eigen::Matrix`; rows are data points, columns are attributes of data points
- * @param k    the number of clusters to form (more like an upper bound, as clusters may be empty)
- * @return     a `std::pair` of a `std::vector<unsigned>` assigning a label to each data point and an `Eigen::Matrix` of
- *             `k` rows with the centroids of the formed clusters
+ * For large inputs, the centroids are computed by mini-batch *k*-means, i.e. each iteration moves the centroids only
+ * towards a random sample of the data points, and the data points are assigned to their nearest centroid once at the
+ * end.  See https://dl.acm.org/doi/10.1145/1772690.1772862.
+ *
+ * @param data        the data to cluster, as `Eigen::Matrix`; rows are data points, columns are attributes of data
+ *                    points
+ * @param k           the number of clusters to form (more like an upper bound, as clusters may be empty)
+ * @param num_threads the maximal number of threads assigning data points to centroids
+ * @return            a `std::pair` of a `std::vector<unsigned>` assigning a label to each data point and an `Eigen::Matrix` of
+ *                    `k` rows with the centroids of the formed clusters
  */
-std::pair<std::vector<unsigned>, MatrixRXf> M_EXPORT kmeans_with_centroids(const Eigen::MatrixXf &data, unsigned k);
+std::pair<std::vector<unsigned>, MatrixRXf> M_EXPORT kmeans_with_centroids(const Eigen::MatrixXf &data, unsigned k,
+                                                                           unsigned num_threads = 1);
 
 /** Clusters the given data according to the *k*-means algorithm.
  *
@@ -36,12 +43,14 @@ std::pair<std::vector<unsigned>, MatrixRXf> M_EXPORT kmeans_with_centroids(const
  * assigns an integer label to each data point, identifying to which cluster the data point is assigned.  See
  * https://en.wikipedia.org/wiki/K-means_clustering.
  *
- * @param data the data to cluster, as `Eigen::Matrix`; rows are data points, columns are attributes of data points
- * @param k    the number of clusters to form (more like an upper bound, as clusters may be empty)
- * @return     a `std::vector<unsigned>` assigning a label to each data point
+ * @param data        the data to cluster, as `Eigen::Matrix`; rows are data points, columns are attributes of data
+ *                    points
+ * @param k           the number of clusters to form (more like an upper bound, as clusters may be empty)
+ * @param num_threads the maximal number of threads assigning data points to centroids
+ * @return            a `std::vector<unsigned>` assigning a label to each data point
  */
-inline std::vector<unsigned> M_EXPORT kmeans(const Eigen::MatrixXf &data, unsigned k) {
-    return kmeans_with_centroids(data, k).first;
+inline std::vector<unsigned> M_EXPORT kmeans(const Eigen::MatrixXf &data, unsigned k, unsigned num_threads = 1) {
+    return kmeans_with_centroids(data, k, num_threads).first;
 }
 
 }
@@ -0,0 +1,146 @@
+#include "util/LikeDFA.hpp"
+
+#include <map>
+#include <mutable/util/macro.hpp>
+
+
+using namespace m;
+
+
+namespace {
+
+/** A single element of a LIKE pattern. */
+struct token_t
+{
+    enum kind_t { T_Char, T_AnyChar, T_AnySequence } kind;
+    char c; ///< the literal character of `T_Char`
+};
+
+}
+
+std::optional<LikeDFA> LikeDFA::Compile(std::string_view pattern, const char escape_char)
+{
+    M_insist('_' != escape_char and '%' != escape_char, "illegal escape character");
+
+    /*----- Tokenize the pattern, resolving escape sequences. -----*/
+    std::vector<token_t> tokens;
+    for (std::size_t i = 0; i != pattern.size(); ++i) {
+        const char c = pattern[i];
+        if (c == escape_char) {
+            if (++i == pattern.size())
+                return std::nullopt; // invalid escape sequence
+            const char escaped = pattern[i];
+            if ('_' != escaped and '%' != escaped and escape_char != escaped)
+                return std::nullopt; // invalid escape sequence
+            tokens.push_back({ token_t::T_Char, escaped });
+        } else if ('%' == c) {
+            if (tokens.empty() or tokens.back().kind != token_t::T_AnySequence) // `%%` is equivalent to `%`
+                tokens.push_back({ token_t::T_AnySequence, '\0' });
+        } else if ('_' == c) {
+            tokens.push_back({ token_t::T_AnyChar, '\0' });
+        } else {
+            tokens.push_back({ token_t::T_Char, c });
+        }
+    }
+
+    LikeDFA dfa;
+
+    /*----- Assign a class to every literal character of the pattern. -----*/
+    dfa.classes_.fill(0);
+    dfa.num_classes_ = 1;
+    for (auto &t : tokens) {
+        if (t.kind == token_t::T_Char and dfa.class_of(t.c) == 0)
+            dfa.classes_[static_cast<unsigned char>(t.c)] = dfa.num_classes_++;
+    }
+    const std::size_t C = dfa.num_classes_;
+
+    /*----- Construct the DFA from the NFA whose states are the positions in the pattern by subset construction. ----*/
+    using subset_type = std::vector<bool>;
+    const std::size_t final_position = tokens.size();
+    auto closure = [&](subset_type &subset) {
+        for (std::size_t i = 0; i != final_position; ++i) {
+            if (subset[i] and tokens[i].kind == token_t::T_AnySequence)
+                subset[i + 1] = true; // `%` matches the empty sequence
+        }
+    };
+    auto step = [&](const subset_type &subset, class_type cls) {
+        subset_type next(final_position + 1, false);
+        for (std::size_t i = 0; i != final_position; ++i) {
+            if (not subset[i])
+                continue;
+            switch (tokens[i].kind) {
+                case token_t::T_Char:
+                    if (dfa.class_of(tokens[i].c) == cls)
+                        next[i + 1] = true;
+                    break;
+                case token_t::T_AnyChar:
+                    next[i + 1] = true;
+                    break;
+                case token_t::T_AnySequence:
+                    next[i] = true;
+                    break;
+            }
+        }
+        closure(next);
+        return next;
+    };
+
+    std::vector<subset_type> subsets;
+    std::map<subset_type, state_type> subset_to_state;
+    std::vector<state_type> transitions;
+    auto add_state = [&](subset_type subset) -> std::optional<state_type> {
+        if (auto it = subset_to_state.find(subset); it != subset_to_state.end())
+            return it->second;
+        if (subsets.size() == MAX_STATES)
+            return std::nullopt;
+        const state_type s = subsets.size();
+        subset_to_state.emplace(subset, s);
+        subsets.push_back(std::move(subset));
+        return s;
+    };
+
+    subset_type start(final_position + 1, false);
+    start[0] = true;
+    closure(start);
+    add_state(std::move(start));
+    for (std::size_t s = 0; s != subsets.size(); ++s) { // `subsets` grows while iterating
+        for (std::size_t cls = 0; cls != C; ++cls) {
+            auto next = add_state(step(subsets[s], cls));
+            if (not next)
+                return std::nullopt; // too many states
+            transitions.push_back(*next);
+        }
+    }
+    const std::size_t num_states = subsets.size();
+
+    /*----- Minimize the DFA by Moore's partition refinement. -----*/
+    std::vector<std::size_t> block(num_states);
+    std::size_t num_blocks = 0;
+    for (std::size_t s = 0; s != num_states; ++s)
+        block[s] = subsets[s][final_position];
+    for (;;) {
+        std::map<std::vector<std::size_t>, std::size_t> signature_to_block;
+        std::vector<std::size_t> refined(num_states);
+        for (std::size_t s = 0; s != num_states; ++s) { // start state 0 is assigned to block 0
+            std::vector<std::size_t> signature{ block[s] };
+            for (std::size_t cls = 0; cls != C; ++cls)
+                signature.push_back(block[transitions[s * C + cls]]);
+            refined[s] = signature_to_block.emplace(std::move(signature), signature_to_block.size()).first->second;
+        }
+        block = std::move(refined);
+        if (signature_to_block.size() == num_blocks)
+            break; // partition is stable
+        num_blocks = signature_to_block.size();
+    }
+
+    dfa.transitions_.resize(num_blocks * C);
+    dfa.accepting_.resize(num_blocks);
+    for (std::size_t s = 0; s != num_states; ++s) {
+        for (std::size_t cls = 0; cls != C; ++cls)
+            dfa.transitions_[block[s] * C + cls] = block[transitions[s * C + cls]];
+        dfa.accepting_[block[s]] = subsets[s][final_position];
+    }
+    M_insist(block[0] == 0, "start state must be state 0");
+
+    return dfa;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+
+namespace m {
+
+/** A minimal deterministic finite automaton deciding whether a string matches a SQL LIKE pattern.  Compiling a pattern
+ * once and running the DFA costs a single table lookup per character of the string, in contrast to the dynamic
+ * programming of `m::like()` or backtracking regular expressions, whose cost per string grows with the product of the
+ * lengths of string and pattern.
+ *
+ * Characters are mapped to *classes* first: every character that occurs literally in the pattern has a class of its
+ * own, all other characters share class 0.  The transitions are stored as a dense table of `num_states() *
+ * num_classes()` entries.  The start state is 0.  A string is consumed up to its terminating NUL byte. */
+struct LikeDFA
+{
+    using state_type = uint16_t;
+    using class_type = uint8_t;
+
+    ///> the maximal number of states of the (not yet minimized) DFA of a pattern to compile
+    static constexpr std::size_t MAX_STATES = 1024;
+
+    private:
+    ///> the class of every character
+    std::array<class_type, 256> classes_;
+    std::size_t num_classes_;
+    ///> the transitions of all states, `num_classes_` consecutive entries per state
+    std::vector<state_type> transitions_;
+    ///> for each state whether it is accepting
+    std::vector<bool> accepting_;
+
+    LikeDFA() = default;
+
+    public:
+    /** Compiles the LIKE pattern \p pattern with escape character \p escape_char into a minimal DFA.  Returns
+     * `std::nullopt` if \p pattern contains an invalid escape sequence or if its DFA exceeds `MAX_STATES` states. */
+    static std::optional<LikeDFA> Compile(std::string_view pattern, char escape_char = '\\');
+
+    std::size_t num_states() const { return accepting_.size(); }
+    std::size_t num_classes() const { return num_classes_; }
+
+    /** Returns the class of character \p c. */
+    class_type class_of(char c) const { return classes_[static_cast<unsigned char>(c)]; }
+    /** Returns the state reached from state \p s by a character of class \p cls. */
+    state_type transition(state_type s, class_type cls) const { return transitions_[s * num_classes_ + cls]; }
+    /** Returns `true` iff \p s is an accepting state. */
+    bool is_accepting(state_type s) const { return accepting_[s]; }
+    /** Returns `true` iff state \p s cannot be left, i.e. the result is decided once \p s is reached. */
+    bool is_sink(state_type s) const {
+        for (std::size_t cls = 0; cls != num_classes_; ++cls) {
+            if (transition(s, cls) != s)
+                return false;
+        }
+        return true;
+    }
+
+    const std::array<class_type, 256> & classes() const { return classes_; }
+    const std::vector<state_type> & transitions() const { return transitions_; }
+
+    /** Returns `true` iff the NUL-terminated string \p str matches the pattern. */
+    bool operator()(const char *str) const {
+        state_type s = 0;
+        for (; *str; ++str)
+            s = transition(s, class_of(*str));
+        return is_accepting(s);
+    }
+};
+
+}
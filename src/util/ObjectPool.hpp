@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+
+namespace m {
+
+/** A thread-safe pool of memory for many small, short-lived objects of varying size, e.g. the candidate matches of the
+ * physical optimizer.  Objects are rounded up to size classes, which are multiples of `GRANULARITY`.  Memory of a
+ * size class is carved from large blocks by bumping a pointer and recycled through a free list per size class, linked
+ * through the freed objects.  Hence, allocating and deallocating an object costs a few instructions rather than a
+ * call to `malloc()`.  Blocks are retained until the pool is destroyed, i.e. the pool keeps its peak memory consumption
+ * for subsequent allocations.  Objects larger than `MAX_OBJECT_SIZE` are allocated by the global `operator new`. */
+struct ObjectPool
+{
+    ///> the granularity of size classes, which is also the alignment of objects
+    static constexpr std::size_t GRANULARITY = alignof(std::max_align_t);
+    ///> the size of the largest size class
+    static constexpr std::size_t MAX_OBJECT_SIZE = 1024;
+    ///> the size of the blocks memory is carved from
+    static constexpr std::size_t BLOCK_SIZE = 64 * 1024;
+
+    private:
+    /** A freed object, linked into the free list of its size class. */
+    struct free_object { free_object *next; };
+    static_assert(sizeof(free_object) <= GRANULARITY);
+
+    ///> the heads of the free lists by size class
+    std::array<free_object*, MAX_OBJECT_SIZE / GRANULARITY> free_lists_{};
+    ///> all blocks of this pool
+    std::vector<std::unique_ptr<std::byte[]>> blocks_;
+    std::byte *bump_ = nullptr; ///< the next free byte of the current block
+    std::byte *bump_end_ = nullptr; ///< the end of the current block
+    std::mutex mutex_;
+
+    public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&) = delete;
+
+    /** Allocates memory for an object of \p size bytes. */
+    void * allocate(std::size_t size) {
+        if (size == 0 or size > MAX_OBJECT_SIZE)
+            return ::operator new(size);
+        const std::size_t size_class = (size + GRANULARITY - 1) / GRANULARITY;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_object *obj = free_lists_[size_class - 1]) { // recycle freed object
+            free_lists_[size_class - 1] = obj->next;
+            return obj;
+        }
+        const std::size_t bytes = size_class * GRANULARITY;
+        if (bump_end_ - bump_ < std::ptrdiff_t(bytes)) { // current block exhausted, the remainder is lost
+            /* `new[]` of `std::byte` returns memory aligned to `__STDCPP_DEFAULT_NEW_ALIGNMENT__`. */
+            static_assert(GRANULARITY <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+            bump_ = blocks_.emplace_back(std::make_unique_for_overwrite<std::byte[]>(BLOCK_SIZE)).get();
+            bump_end_ = bump_ + BLOCK_SIZE;
+        }
+        return std::exchange(bump_, bump_ + bytes);
+    }
+
+    /** Deallocates the object at \p ptr of \p size bytes, which must have been allocated by this pool with the same
+     * \p size. */
+    void deallocate(void *ptr, std::size_t size) {
+        if (not ptr) return;
+        if (size == 0 or size > MAX_OBJECT_SIZE)
+            return ::operator delete(ptr);
+        const std::size_t size_class = (size + GRANULARITY - 1) / GRANULARITY;
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto obj = ::new (ptr) free_object{ free_lists_[size_class - 1] };
+        free_lists_[size_class - 1] = obj;
+    }
+};
+
+}
@@ -0,0 +1,120 @@
+#include "util/PerfCounters.hpp"
+
+#include <cstring>
+#if __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+using namespace m;
+
+
+#if __linux__
+namespace {
+
+/** Opens a counter of the event given by \p type and \p config, which is disabled until enabled by `ioctl()`.  Returns
+ * the file descriptor of the counter, or -1 if the counter cannot be opened. */
+int open_counter(uint32_t type, uint64_t config)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1; // count threads created while counting, e.g. workers of parallel scans
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(SYS_perf_event_open, &attr, /* pid= */ 0, /* cpu= */ -1, /* group_fd= */ -1, /* flags= */ 0);
+}
+
+}
+#endif
+
+PerfCounters::PerfCounters()
+{
+    fds_.fill(-1);
+#if __linux__
+    fds_[CYCLES]        = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    fds_[INSTRUCTIONS]  = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    fds_[LLC_MISSES]    = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    fds_[BRANCH_MISSES] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    fds_[DTLB_MISSES]   = open_counter(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB |
+                                                           (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                           (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#if __linux__
+    for (int fd : fds_) {
+        if (fd != -1)
+            close(fd);
+    }
+#endif
+}
+
+bool PerfCounters::available() const
+{
+    for (int fd : fds_) {
+        if (fd != -1)
+            return true;
+    }
+    return false;
+}
+
+void PerfCounters::start()
+{
+#if __linux__
+    for (int fd : fds_) {
+        if (fd != -1) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+void PerfCounters::stop()
+{
+#if __linux__
+    for (int fd : fds_) {
+        if (fd != -1)
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+#endif
+}
+
+std::optional<uint64_t> PerfCounters::get(event_type event) const
+{
+#if __linux__
+    uint64_t value;
+    if (fds_[event] != -1 and read(fds_[event], &value, sizeof(value)) == sizeof(value))
+        return value;
+#endif
+    return std::nullopt;
+}
+
+std::ostream & m::operator<<(std::ostream &out, const PerfCounters &counters)
+{
+    bool first = true;
+    for (unsigned event = 0; event != PerfCounters::NUM_EVENTS; ++event) {
+        if (auto value = counters.get(PerfCounters::event_type(event))) {
+            if (not first) out << ", ";
+            first = false;
+            out << *value << ' ' << PerfCounters::EVENT_NAMES[event];
+        }
+    }
+    if (first)
+        return out << "no hardware counters available";
+
+    auto cycles = counters.get(PerfCounters::CYCLES);
+    auto instructions = counters.get(PerfCounters::INSTRUCTIONS);
+    if (cycles and instructions and *cycles)
+        out << ", " << double(*instructions) / *cycles << " instructions per cycle";
+    return out;
+}
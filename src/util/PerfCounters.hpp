@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+
+
+namespace m {
+
+/** Hardware performance counters of the calling thread and of all threads it creates while counting, read through
+ * Linux' `perf_event_open`.  Each counter is opened individually such that events the CPU or the kernel do not support,
+ * e.g. because of the `perf_event_paranoid` setting or in a virtual machine, are merely unavailable.  On other operating
+ * systems, all counters are unavailable.  Only events in user space are counted. */
+struct PerfCounters
+{
+    enum event_type : unsigned
+    {
+        CYCLES,
+        INSTRUCTIONS,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        DTLB_MISSES,
+        NUM_EVENTS,
+    };
+
+    static constexpr std::array<const char*, NUM_EVENTS> EVENT_NAMES = {
+        "cycles", "instructions", "LLC misses", "branch misses", "dTLB misses",
+    };
+
+    private:
+    std::array<int, NUM_EVENTS> fds_; ///< the file descriptors of the counters, -1 if unavailable
+
+    public:
+    /** Opens the counters.  They are not counting until `start()`. */
+    PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    ~PerfCounters();
+
+    /** Returns `true` iff at least one counter is available. */
+    bool available() const;
+
+    /** Resets the counters and starts counting. */
+    void start();
+    /** Stops counting. */
+    void stop();
+
+    /** Returns the value of the counter of \p event, or `std::nullopt` if it is unavailable. */
+    std::optional<uint64_t> get(event_type event) const;
+};
+
+/** Prints the values of all available counters of \p counters, and the instructions per cycle if available, in a
+ * single line. */
+std::ostream & operator<<(std::ostream &out, const PerfCounters &counters);
+
+}
@@ -68,6 +68,17 @@ MatrixXf create_w_b(float stddev, unsigned num_rows, unsigned k, URBG &&g)
     return w_b;
 }
 
+/** Computes the random non-linear projections `sin(CDFs * w_b)` and centers them to zero mean. */
+MatrixXf project(const MatrixXf &CDFs, const MatrixXf &w_b)
+{
+    M_insist(w_b.rows() == CDFs.cols());
+    MatrixXf features = (CDFs * w_b).array().sin().matrix();
+    const RowVectorXf means = features.colwise().mean();
+    features.rowwise() -= means;
+    return features;
+}
+
+
 }
 
 
@@ -91,37 +102,51 @@ float m::rdc(const Eigen::MatrixXf &X, const Eigen::MatrixXf &Y, unsigned k, flo
 }
 
 template<typename URBG>
-float m::rdc_precomputed_CDF(MatrixXf &CDFs_of_X, MatrixXf &CDFs_of_Y, unsigned k, float stddev, URBG &&g)
+float m::rdc_precomputed_CDF(const MatrixXf &CDFs_of_X, const MatrixXf &CDFs_of_Y, unsigned k, float stddev, URBG &&g)
 {
-    unsigned num_rows = CDFs_of_X.rows();
-    M_insist(num_rows == CDFs_of_Y.rows());
+    M_insist(CDFs_of_X.rows() == CDFs_of_Y.rows());
 
     /* Generate random non-linear projections. */
     MatrixXf X_w_b = create_w_b(stddev, CDFs_of_X.cols(), k, g);
     MatrixXf Y_w_b = create_w_b(stddev, CDFs_of_Y.cols(), k, g);
-    M_insist(X_w_b.rows() == CDFs_of_X.cols());
-    M_insist(Y_w_b.rows() == CDFs_of_Y.cols());
     M_insist(X_w_b.cols() == k);
     M_insist(Y_w_b.cols() == k);
 
-    /* Compute canonical correlations. */
-    MatrixXf concat_matrix(CDFs_of_X.rows(), 2 * k);
-    concat_matrix << (CDFs_of_X * X_w_b), (CDFs_of_Y * Y_w_b);
-    concat_matrix.array() = concat_matrix.array().sin();
+    return rdc_precomputed_features(project(CDFs_of_X, X_w_b), project(CDFs_of_Y, Y_w_b));
+}
 
-    /* Center concat matrix. */
-    const RowVectorXf means = concat_matrix.colwise().mean();
-    concat_matrix.rowwise() -= means;
+template<typename URBG>
+std::pair<MatrixXf, MatrixXf> m::rdc_features(const MatrixXf &CDFs, unsigned k, float stddev, URBG &&g)
+{
+    /* Draw the projections in the same order as `rdc_precomputed_CDF()`. */
+    MatrixXf X_w_b = create_w_b(stddev, CDFs.cols(), k, g);
+    MatrixXf Y_w_b = create_w_b(stddev, CDFs.cols(), k, g);
+    return std::make_pair(project(CDFs, X_w_b), project(CDFs, Y_w_b));
+}
 
-    /* Compute covariance matrix. */
-    MatrixXf covariance_matrix = concat_matrix.adjoint() * concat_matrix / float(num_rows - 1);
+float m::rdc_precomputed_features(const MatrixXf &features_of_X, const MatrixXf &features_of_Y)
+{
+    const unsigned num_rows = features_of_X.rows();
+    M_insist(num_rows == features_of_Y.rows());
+    M_insist(features_of_X.cols() == features_of_Y.cols());
 
-    FullPivLU<MatrixXf> CXX(covariance_matrix.block(0, 0, k, k));
-    FullPivLU<MatrixXf> CYY(covariance_matrix.block(k, k, k, k));
-    MatrixXf CXY = covariance_matrix.block(0, k, k, k);
-    MatrixXf CYX = covariance_matrix.block(k, 0, k, k);
+    /* Compute the blocks of the covariance matrix of the concatenated projections.  The block `CYX` is the transpose
+     * of `CXY` and the blocks `CXX` and `CYY` are symmetric, hence only their lower triangles are computed. */
+    const unsigned k = features_of_X.cols();
+    MatrixXf CXX_matrix = MatrixXf::Zero(k, k);
+    MatrixXf CYY_matrix = MatrixXf::Zero(k, k);
+    CXX_matrix.selfadjointView<Lower>().rankUpdate(features_of_X.adjoint(), 1.f / float(num_rows - 1));
+    CYY_matrix.selfadjointView<Lower>().rankUpdate(features_of_Y.adjoint(), 1.f / float(num_rows - 1));
+    const MatrixXf CXY = features_of_X.adjoint() * features_of_Y / float(num_rows - 1);
 
-    SelfAdjointEigenSolver<MatrixXf> eigensolver((CXX.inverse() * CXY) * (CYY.inverse() * CYX));
+    FullPivLU<MatrixXf> CXX(MatrixXf(CXX_matrix.selfadjointView<Lower>()));
+    FullPivLU<MatrixXf> CYY(MatrixXf(CYY_matrix.selfadjointView<Lower>()));
+
+    SelfAdjointEigenSolver<MatrixXf> eigensolver((CXX.inverse() * CXY) * (CYY.inverse() * CXY.adjoint()));
 
     return sqrtf(eigensolver.eigenvalues().maxCoeff());
 }
+
+/* Explicitly instantiate the templates for the default random number generator. */
+template float m::rdc_precomputed_CDF(const MatrixXf&, const MatrixXf&, unsigned, float, std::mt19937_64&&);
+template std::pair<MatrixXf, MatrixXf> m::rdc_features(const MatrixXf&, unsigned, float, std::mt19937_64&&);
@@ -2,6 +2,7 @@
 
 #include <Eigen/Core>
 #include <random>
+#include <utility>
 
 
 namespace m {
@@ -25,7 +26,23 @@ float rdc(const Eigen::MatrixXf &X, const Eigen::MatrixXf &Y, unsigned k = 5, fl
 
 /** Compute the RDC value without having to compute CDF matrices to avoid sorting the same data multiple times. */
 template<typename URBG = std::mt19937_64>
-float rdc_precomputed_CDF(Eigen::MatrixXf &CDFs_of_X, Eigen::MatrixXf &CDFs_of_Y, unsigned k = 5,
+float rdc_precomputed_CDF(const Eigen::MatrixXf &CDFs_of_X, const Eigen::MatrixXf &CDFs_of_Y, unsigned k = 5,
                           float stddev = 1.f/6.f, URBG &&g = URBG());
 
+/** Compute the centered random non-linear projections of the CDFs of a random variable, once as they are computed for
+ * the first and once as they are computed for the second random variable by `rdc_precomputed_CDF()` with the same
+ * arguments.  Since the projections only depend on the CDFs of the respective variable, computing the RDC values of
+ * *n* variables of equally many columns pairwise by `rdc_precomputed_features()` projects the CDFs of each variable
+ * twice rather than *n - 1* times, with the same results as `rdc_precomputed_CDF()`.
+ *
+ * @return a `std::pair` of the projections of the variable as first and as second random variable
+ */
+template<typename URBG = std::mt19937_64>
+std::pair<Eigen::MatrixXf, Eigen::MatrixXf> rdc_features(const Eigen::MatrixXf &CDFs, unsigned k = 5,
+                                                         float stddev = 1.f/6.f, URBG &&g = URBG());
+
+/** Compute the RDC value from the centered random non-linear projections of two random variables, see
+ * `rdc_features()`. */
+float rdc_precomputed_features(const Eigen::MatrixXf &features_of_X, const Eigen::MatrixXf &features_of_Y);
+
 }
@@ -1,10 +1,18 @@
 #include "Spn.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <iomanip>
+#include <iterator>
 #include "mutable/util/AdjacencyMatrix.hpp"
+#include <mutable/util/exception.hpp>
 #include <mutable/util/fn.hpp>
+#include <numeric>
+#include <random>
 #include "util/Kmeans.hpp"
 #include "util/RDC.hpp"
+#include "util/WorkerPool.hpp"
 
 
 using namespace m;
@@ -16,6 +24,21 @@ namespace {
 std::size_t MIN_INSTANCE_SLICE = 0;
 const int MAX_K = 7;
 const float RDC_THRESHOLD = 0.3f;
+/** The minimal number of rows of the data of a node for which learning its children or the RDC values of its columns
+ * is distributed to multiple threads.  For smaller nodes, spawning threads would dominate. */
+const std::size_t MIN_ROWS_PER_TASK = 1024;
+
+/** The maximal number of threads of the `WorkerPool` learning an SPN. */
+std::size_t max_threads = 1;
+
+/** Calls \p fn for each `i` in `[0, n)` and waits for all calls to finish.  If \p parallel, the calls are distributed
+ * to up to `max_threads` threads of the `WorkerPool`, and run on the calling thread otherwise.  Since the pool balances
+ * nested calls, threads idle in small subtrees help with the others, e.g. when the subtrees are unbalanced. */
+template<typename Fn>
+void fork_join(std::size_t n, bool parallel, Fn &&fn)
+{
+    WorkerPool::Get().parallel_for(n, std::forward<Fn>(fn), parallel ? max_threads : 1);
+}
 
 MatrixXf normalize_minmax(const MatrixXf &data)
 {
@@ -42,17 +65,25 @@ std::pair<std::vector<SmallBitset>, std::vector<SmallBitset>>rdc_split(const Mat
 {
     const auto num_cols = data.cols();
     AdjacencyMatrix adjacency_matrix(num_cols);
-    std::vector<MatrixXf> CDF_matrices(num_cols);
+    std::vector<std::pair<MatrixXf, MatrixXf>> features(num_cols);
+
+    const bool parallel = data.rows() >= MIN_ROWS_PER_TASK;
+
+    /* precompute the CDF matrices and their random non-linear projections once per column */
+    fork_join(num_cols, parallel, [&](std::size_t i) { features[i] = rdc_features(create_CDF_matrix(data.col(i))); });
 
-    /* precompute CDF matrices */
-    for (int i = 0; i < num_cols; i++) { CDF_matrices[i] = create_CDF_matrix(data.col(i)); }
+    /* compute the pairwise RDC values; each thread computes the values of entire rows of the upper triangle */
+    std::vector<float> rdc_values(num_cols * num_cols, 0.f);
+    fork_join(num_cols - 1, parallel, [&](std::size_t i) {
+        for (std::size_t j = i + 1; j < std::size_t(num_cols); j++)
+            rdc_values[i * num_cols + j] = rdc_precomputed_features(features[i].first, features[j].second);
+    });
 
     /* build a graph with edges between correlated columns (attributes) */
     for (unsigned i = 0; i < num_cols - 1; i++) {
         for (unsigned j = i+1; j < num_cols; j++) {
-            const float rdc_value = rdc_precomputed_CDF(CDF_matrices[i], CDF_matrices[j]);
             /* if the rdc value is greater or equal to the threshold, consider columns dependent */
-            if (rdc_value >= RDC_THRESHOLD) {
+            if (rdc_values[i * num_cols + j] >= RDC_THRESHOLD) {
                 adjacency_matrix(i,j) = true;
                 adjacency_matrix(j,i) = true;
             }
@@ -227,48 +258,53 @@ void Spn::Product::print(std::ostream &out, std::size_t num_tabs) const
 std::pair<float, float> Spn::DiscreteLeaf::evaluate(const Filter &filter, unsigned leaf_id, EvalType eval_type) const
 {
     auto [spn_operator, value] = filter.at(leaf_id);
+    return evaluate_bins(bins.data(), bins.data() + bins.size(), null_probability, spn_operator, value);
+}
 
+std::pair<float, float> Spn::DiscreteLeaf::evaluate_bins(const Bin *begin, const Bin *end, float null_probability,
+                                                         SpnOperator spn_operator, float value)
+{
     if (spn_operator == IS_NULL) { return { null_probability, null_probability }; }
 
-    if (bins.empty()) { return { 0.f, 0.f }; }
+    if (begin == end) { return { 0.f, 0.f }; }
 
     if (spn_operator == EXPECTATION) {
-        float expectation = bins[0].cumulative_probability * bins[0].value;
-        float prev_probability = bins[0].cumulative_probability;
-        for (std::size_t bin_id = 1; bin_id < bins.size(); bin_id++) {
-            float cumulative_probability = bins[bin_id].cumulative_probability;
+        float expectation = begin[0].cumulative_probability * begin[0].value;
+        float prev_probability = begin[0].cumulative_probability;
+        for (std::size_t bin_id = 1; bin_id < std::size_t(end - begin); bin_id++) {
+            float cumulative_probability = begin[bin_id].cumulative_probability;
             float probability = cumulative_probability - prev_probability;
-            expectation += probability * bins[bin_id].value;
+            expectation += probability * begin[bin_id].value;
             prev_probability = cumulative_probability;
         }
         return {expectation, 1.f };
     }
     /* probability of last bin, because the cumulative probability of the last bin is not always 1 because of NULL */
-    float last_prob = std::prev(bins.end())->cumulative_probability;
+    float last_prob = std::prev(end)->cumulative_probability;
     float probability = 0.f;
 
     if (spn_operator == SpnOperator::EQUAL) {
-        if (bins.begin()->value > value or (std::prev(bins.end()))->value < value) { return { 0.f, 0.f }; }
-        auto lower_bound = std::lower_bound(bins.begin(), bins.end(), value);
+        if (begin->value > value or (std::prev(end))->value < value) { return { 0.f, 0.f }; }
+        auto lower_bound = std::lower_bound(begin, end, value);
         if (lower_bound->value == value) {
             probability = lower_bound->cumulative_probability;
-            if (lower_bound != bins.begin()) { probability -= (--lower_bound)->cumulative_probability; }
+            if (lower_bound != begin) { probability -= (--lower_bound)->cumulative_probability; }
         }
         return { probability, probability };
     }
 
     if (spn_operator == SpnOperator::LESS) {
-        if (bins.begin()->value >= value) { return { 0.f, 0.f }; }
-        if ((std::prev(bins.end()))->value < value) { return { last_prob, last_prob }; }
-        auto lower_bound = std::lower_bound(bins.begin(), bins.end(), value);
+        if (begin->value >= value) { return { 0.f, 0.f }; }
+        if ((std::prev(end))->value < value) { return { last_prob, last_prob }; }
+        auto lower_bound = std::lower_bound(begin, end, value);
         probability = (--lower_bound)->cumulative_probability;
         return { probability, probability };
     }
 
     if (spn_operator == SpnOperator::LESS_EQUAL) {
-        if (bins.begin()->value > value) { return { 0.f, 0.f }; }
-        if ((std::prev(bins.end()))->value <= value) { return { last_prob, last_prob }; }
-        auto upper_bound = std::upper_bound(bins.begin(), bins.end(), value,
+        if (begin->value > value) { return { 0.f, 0.f }; }
+        if ((std::prev(end))->value <= value) { return { last_prob, last_prob }; }
+        auto upper_bound = std::upper_bound(begin, end, value,
             [](float bin_value, DiscreteLeaf::Bin bin) { return bin_value < bin.value; }
         );
         probability = (--upper_bound)->cumulative_probability;
@@ -276,9 +312,9 @@ std::pair<float, float> Spn::DiscreteLeaf::evaluate(const Filter &filter, unsign
     }
 
     if (spn_operator == SpnOperator::GREATER) {
-        if (bins.begin()->value > value) { return { last_prob, last_prob }; }
-        if ((std::prev(bins.end()))->value <= value) { return { 0.f, 0.f }; }
-        auto upper_bound = std::upper_bound(bins.begin(), bins.end(), value,
+        if (begin->value > value) { return { last_prob, last_prob }; }
+        if ((std::prev(end))->value <= value) { return { 0.f, 0.f }; }
+        auto upper_bound = std::upper_bound(begin, end, value,
             [](float bin_value, DiscreteLeaf::Bin bin) { return bin_value < bin.value; }
         );
         probability = last_prob - (--upper_bound)->cumulative_probability;
@@ -286,9 +322,9 @@ std::pair<float, float> Spn::DiscreteLeaf::evaluate(const Filter &filter, unsign
     }
 
     if (spn_operator == SpnOperator::GREATER_EQUAL) {
-        if (bins.begin()->value >= value) { return { last_prob, last_prob }; }
-        if ((std::prev(bins.end()))->value < value) { return { 0.f, 0.f }; }
-        auto lower_bound = std::lower_bound(bins.begin(), bins.end(), value);
+        if (begin->value >= value) { return { last_prob, last_prob }; }
+        if ((std::prev(end))->value < value) { return { 0.f, 0.f }; }
+        auto lower_bound = std::lower_bound(begin, end, value);
         probability = last_prob - (--lower_bound)->cumulative_probability;
         return { probability, probability };
     }
@@ -375,18 +411,26 @@ void Spn::DiscreteLeaf::print(std::ostream &out, std::size_t num_tabs) const
 std::pair<float, float> Spn::ContinuousLeaf::evaluate(const Filter &filter, unsigned leaf_id, EvalType eval_type) const
 {
     auto [spn_operator, value] = filter.at(leaf_id);
+    return evaluate_bins(bins.data(), bins.data() + bins.size(), lower_bound, lower_bound_probability, null_probability,
+                         spn_operator, value, eval_type);
+}
+
+std::pair<float, float> Spn::ContinuousLeaf::evaluate_bins(const Bin *begin, const Bin *end, float lower_bound,
+                                                           float lower_bound_probability, float null_probability,
+                                                           SpnOperator spn_operator, float value, EvalType eval_type)
+{
     float probability = 0.f;
     if (spn_operator == IS_NULL) { return { null_probability, null_probability }; }
-    if (bins.empty()) { return { 0.f, 0.f }; }
+    if (begin == end) { return { 0.f, 0.f }; }
 
     if (spn_operator == SpnOperator::EXPECTATION) {
         float expectation = lower_bound * lower_bound_probability;
-        expectation += bins[0].cumulative_probability * ((bins[0].upper_bound + lower_bound) / 2.f);
-        float prev_probability = bins[0].cumulative_probability;
-        float prev_upper_bound = bins[0].upper_bound;
-        for (std::size_t bin_id = 1; bin_id < bins.size(); bin_id++) {
-            float upper_bound = bins[bin_id].upper_bound;
-            float cumulative_probability = bins[bin_id].cumulative_probability;
+        expectation += begin[0].cumulative_probability * ((begin[0].upper_bound + lower_bound) / 2.f);
+        float prev_probability = begin[0].cumulative_probability;
+        float prev_upper_bound = begin[0].upper_bound;
+        for (std::size_t bin_id = 1; bin_id < std::size_t(end - begin); bin_id++) {
+            float upper_bound = begin[bin_id].upper_bound;
+            float cumulative_probability = begin[bin_id].cumulative_probability;
             float current_probability = cumulative_probability - prev_probability;
             expectation += current_probability * ((prev_upper_bound + upper_bound) / 2);
             prev_probability = cumulative_probability;
@@ -396,13 +440,13 @@ std::pair<float, float> Spn::ContinuousLeaf::evaluate(const Filter &filter, unsi
     }
 
     if (spn_operator == SpnOperator::EQUAL) {
-        if (lower_bound > value or (std::prev(bins.end()))->upper_bound < value) { return { 0.f, 0.f }; }
+        if (lower_bound > value or (std::prev(end))->upper_bound < value) { return { 0.f, 0.f }; }
         if (lower_bound == value) { return { lower_bound_probability, lower_bound_probability }; }
-        if (value <= bins[0].upper_bound) {
-            probability = bins[0].cumulative_probability - lower_bound_probability;
+        if (value <= begin[0].upper_bound) {
+            probability = begin[0].cumulative_probability - lower_bound_probability;
             return { probability, probability };
         }
-        auto std_lower_bound = std::lower_bound(bins.begin(), bins.end(), value);
+        auto std_lower_bound = std::lower_bound(begin, end, value);
         probability = std_lower_bound->cumulative_probability - (--std_lower_bound)->cumulative_probability;
         return { probability, probability };
     }
@@ -414,17 +458,17 @@ std::pair<float, float> Spn::ContinuousLeaf::evaluate(const Filter &filter, unsi
             }
             return { 0.f, 0.f };
         }
-        if ((std::prev(bins.end()))->upper_bound <= value) {
-            probability = std::prev(bins.end())->cumulative_probability;
+        if ((std::prev(end))->upper_bound <= value) {
+            probability = std::prev(end)->cumulative_probability;
             return { probability, probability };
         }
-        if (value <= bins[0].upper_bound) {
-            float prob = bins[0].cumulative_probability - lower_bound_probability;
+        if (value <= begin[0].upper_bound) {
+            float prob = begin[0].cumulative_probability - lower_bound_probability;
             probability = lower_bound_probability +
-                (prob * ((value - lower_bound) / (bins[0].upper_bound - lower_bound)));
+                (prob * ((value - lower_bound) / (begin[0].upper_bound - lower_bound)));
             return { probability, probability };
         }
-        auto std_lower_bound = std::lower_bound(bins.begin(), bins.end(), value);
+        auto std_lower_bound = std::lower_bound(begin, end, value);
         auto &bin = *std_lower_bound;
         auto &prev_bin = *(--std_lower_bound);
         float bin_probability = bin.cumulative_probability - prev_bin.cumulative_probability;
@@ -441,7 +485,7 @@ std::pair<float, float> Spn::ContinuousLeaf::evaluate(const Filter &filter, unsi
     }
 
     if (spn_operator == GREATER_EQUAL or spn_operator == GREATER) {
-        float last_prob = std::prev(bins.end())->cumulative_probability;
+        float last_prob = std::prev(end)->cumulative_probability;
         if (lower_bound >= value) {
             if (lower_bound == value and spn_operator == GREATER) {
                 probability = last_prob - lower_bound_probability;
@@ -449,14 +493,14 @@ std::pair<float, float> Spn::ContinuousLeaf::evaluate(const Filter &filter, unsi
             }
             return { last_prob, last_prob };
         }
-        if ((std::prev(bins.end()))->upper_bound <= value) { return { 0.f, 0.f }; }
-        if (value <= bins[0].upper_bound) {
-            float prob = bins[0].cumulative_probability - lower_bound_probability;
-            float split_bin_prob = (prob * (1.f - ((value - lower_bound) / (bins[0].upper_bound - lower_bound))));
-            probability = last_prob - bins[0].cumulative_probability + split_bin_prob;
+        if ((std::prev(end))->upper_bound <= value) { return { 0.f, 0.f }; }
+        if (value <= begin[0].upper_bound) {
+            float prob = begin[0].cumulative_probability - lower_bound_probability;
+            float split_bin_prob = (prob * (1.f - ((value - lower_bound) / (begin[0].upper_bound - lower_bound))));
+            probability = last_prob - begin[0].cumulative_probability + split_bin_prob;
             return { probability, probability };
         }
-        auto std_lower_bound = std::lower_bound(bins.begin(), bins.end(), value);
+        auto std_lower_bound = std::lower_bound(begin, end, value);
         auto &bin = *std_lower_bound;
         auto &prev_bin = *(--std_lower_bound);
         float bin_probability = bin.cumulative_probability - prev_bin.cumulative_probability;
@@ -568,6 +612,156 @@ void Spn::ContinuousLeaf::print(std::ostream &out, std::size_t num_tabs) const
     out << "\n";
 }
 
+/*======================================================================================================================
+ * Compiled SPN
+ *====================================================================================================================*/
+
+Spn::Compiled::Compiled(const Node &root)
+{
+    /* The scope of the root is the union of the scopes of the children of the topmost product node.  A leaf as root
+     * models the single variable 0. */
+    auto scope_of = [](const Node &node, auto &scope_rec) -> SmallBitset {
+        if (auto sum = dynamic_cast<const Sum*>(&node))
+            return scope_rec(*sum->children[0]->child, scope_rec);
+        if (auto product = dynamic_cast<const Product*>(&node)) {
+            SmallBitset scope;
+            for (auto &child : product->children)
+                scope = scope | child->variables;
+            return scope;
+        }
+        return SmallBitset(1UL);
+    };
+    const SmallBitset scope = scope_of(root, scope_of);
+    for (auto it = scope.begin(); it != scope.end(); ++it)
+        num_variables = std::max<unsigned>(num_variables, *it + 1);
+
+    add(root, scope);
+}
+
+uint32_t Spn::Compiled::add(const Node &node, SmallBitset variables)
+{
+    FlatNode flat{};
+    flat.variables = variables;
+
+    if (auto sum = dynamic_cast<const Sum*>(&node)) {
+        std::vector<Edge> children;
+        children.reserve(sum->children.size());
+        for (auto &child : sum->children)
+            children.push_back({ add(*child->child, variables), child->weight });
+        flat.kind = SUM;
+        flat.begin = edges.size();
+        edges.insert(edges.end(), children.begin(), children.end());
+        flat.end = edges.size();
+    } else if (auto product = dynamic_cast<const Product*>(&node)) {
+        std::vector<Edge> children;
+        children.reserve(product->children.size());
+        for (auto &child : product->children)
+            children.push_back({ add(*child->child, child->variables), 1.f });
+        flat.kind = PRODUCT;
+        flat.begin = edges.size();
+        edges.insert(edges.end(), children.begin(), children.end());
+        flat.end = edges.size();
+    } else if (auto leaf = dynamic_cast<const DiscreteLeaf*>(&node)) {
+        flat.kind = DISCRETE_LEAF;
+        flat.variable = *variables.begin();
+        flat.null_probability = leaf->null_probability;
+        flat.begin = discrete_bins.size();
+        discrete_bins.insert(discrete_bins.end(), leaf->bins.begin(), leaf->bins.end());
+        flat.end = discrete_bins.size();
+    } else {
+        auto &continuous_leaf = dynamic_cast<const ContinuousLeaf&>(node);
+        flat.kind = CONTINUOUS_LEAF;
+        flat.variable = *variables.begin();
+        flat.lower_bound = continuous_leaf.lower_bound;
+        flat.lower_bound_probability = continuous_leaf.lower_bound_probability;
+        flat.null_probability = continuous_leaf.null_probability;
+        flat.begin = continuous_bins.size();
+        continuous_bins.insert(continuous_bins.end(), continuous_leaf.bins.begin(), continuous_leaf.bins.end());
+        flat.end = continuous_bins.size();
+    }
+
+    nodes.push_back(flat);
+    return nodes.size() - 1;
+}
+
+void Spn::Compiled::evaluate(const Filter *filters, std::size_t num_filters, EvalType eval_type,
+                             std::pair<float, float> *results) const
+{
+    if (num_filters == 0)
+        return;
+
+    /* Translate each filter into the set of filtered variables and a dense array of the predicates by variable.  The
+     * buffers are local to the thread since plans may be enumerated concurrently. */
+    static thread_local std::vector<SmallBitset> filtered;
+    static thread_local std::vector<std::pair<SpnOperator, float>> predicates;
+    static thread_local std::vector<std::pair<float, float>> values; ///< the values of all nodes, node by node
+    filtered.assign(num_filters, SmallBitset());
+    predicates.resize(num_filters * num_variables);
+    for (std::size_t f = 0; f != num_filters; ++f) {
+        for (auto &[variable, predicate] : filters[f]) {
+            if (variable >= num_variables) continue; // not modelled by this SPN
+            filtered[f][variable] = true;
+            predicates[f * num_variables + variable] = predicate;
+        }
+    }
+
+    /* Evaluate the nodes bottom-up.  A node without filtered variables evaluates to 1, s.t. it is neutral in the
+     * product of its parent, exactly like a child that is skipped by `Product::evaluate()`. */
+    values.resize(nodes.size() * num_filters);
+    for (std::size_t i = 0; i != nodes.size(); ++i) {
+        const FlatNode &node = nodes[i];
+        auto out = &values[i * num_filters];
+        for (std::size_t f = 0; f != num_filters; ++f) {
+            if (not (node.variables & filtered[f])) {
+                out[f] = { 1.f, 1.f };
+                continue;
+            }
+            switch (node.kind) {
+                case SUM: {
+                    float expectation = 0.f;
+                    float likelihood = 0.f;
+                    for (auto edge = edges.data() + node.begin, end = edges.data() + node.end; edge != end; ++edge) {
+                        auto &child = values[edge->child * num_filters + f];
+                        expectation += edge->weight * child.first;
+                        likelihood += edge->weight * child.second;
+                    }
+                    out[f] = { expectation, likelihood };
+                    break;
+                }
+                case PRODUCT: {
+                    float expectation = 1.f;
+                    float likelihood = 1.f;
+                    for (auto edge = edges.data() + node.begin, end = edges.data() + node.end; edge != end; ++edge) {
+                        auto &child = values[edge->child * num_filters + f];
+                        expectation *= child.first;
+                        likelihood *= child.second;
+                    }
+                    out[f] = { expectation, likelihood };
+                    break;
+                }
+                case DISCRETE_LEAF: {
+                    auto [spn_operator, value] = predicates[f * num_variables + node.variable];
+                    out[f] = DiscreteLeaf::evaluate_bins(discrete_bins.data() + node.begin,
+                                                         discrete_bins.data() + node.end,
+                                                         node.null_probability, spn_operator, value);
+                    break;
+                }
+                case CONTINUOUS_LEAF: {
+                    auto [spn_operator, value] = predicates[f * num_variables + node.variable];
+                    out[f] = ContinuousLeaf::evaluate_bins(continuous_bins.data() + node.begin,
+                                                           continuous_bins.data() + node.end,
+                                                           node.lower_bound, node.lower_bound_probability,
+                                                           node.null_probability, spn_operator, value, eval_type);
+                    break;
+                }
+            }
+        }
+    }
+
+    const auto root = &values[(nodes.size() - 1) * num_filters];
+    std::copy(root, root + num_filters, results);
+}
+
 /*======================================================================================================================
  * Spn
  *====================================================================================================================*/
@@ -576,14 +770,18 @@ void Spn::ContinuousLeaf::print(std::ostream &out, std::size_t num_tabs) const
 
 std::unique_ptr<Spn::Product> Spn::create_product_min_slice(LearningData &ld)
 {
-    std::vector<std::unique_ptr<Product::ChildWithVariables>> children;
-    auto variable_it = ld.variables.begin();
-    for (auto i = 0; i < ld.data.cols(); i++) {
+    std::vector<SmallBitset> column_variables;
+    column_variables.reserve(ld.data.cols());
+    for (auto variable_it = ld.variables.begin(); variable_it != ld.variables.end(); ++variable_it)
+        column_variables.emplace_back(variable_it.as_set());
+
+    /* learn the children of independent columns in parallel */
+    std::vector<std::unique_ptr<Product::ChildWithVariables>> children(ld.data.cols());
+    fork_join(ld.data.cols(), ld.data.rows() >= MIN_ROWS_PER_TASK, [&](std::size_t i) {
         const MatrixXf &data = ld.data.col(i);
         const MatrixXf &normalized = ld.normalized.col(i);
         const MatrixXi &null_matrix = ld.null_matrix.col(i);
-        SmallBitset variables(variable_it.as_set());
-        ++variable_it;
+        SmallBitset variables(column_variables[i]);
         std::vector<LeafType> split_leaf_types{ld.leaf_types[i]};
         LearningData split_data(
             data,
@@ -592,9 +790,8 @@ std::unique_ptr<Spn::Product> Spn::create_product_min_slice(LearningData &ld)
             variables,
             split_leaf_types
         );
-        auto child = std::make_unique<Product::ChildWithVariables>(learn_node(split_data), variables);
-        children.push_back(std::move(child));
-    }
+        children[i] = std::make_unique<Product::ChildWithVariables>(learn_node(split_data), variables);
+    });
     return std::make_unique<Product>(std::move(children), ld.data.rows());
 }
 
@@ -605,8 +802,9 @@ std::unique_ptr<Spn::Product> Spn::create_product_rdc(
     std::vector<SmallBitset> &variable_candidates
 )
 {
-    std::vector<std::unique_ptr<Product::ChildWithVariables>> children;
-    for (std::size_t current_split = 0; current_split < column_candidates.size(); current_split++) {
+    /* learn the children of the independent splits in parallel */
+    std::vector<std::unique_ptr<Product::ChildWithVariables>> children(column_candidates.size());
+    fork_join(column_candidates.size(), ld.data.rows() >= MIN_ROWS_PER_TASK, [&](std::size_t current_split) {
         std::size_t split_size = column_candidates[current_split].size();
         std::vector<LeafType> split_leaf_types;
         split_leaf_types.reserve(split_size);
@@ -621,12 +819,11 @@ std::unique_ptr<Spn::Product> Spn::create_product_rdc(
         const MatrixXf &normalized = ld.normalized(all, column_index);
         const MatrixXi &null_matrix = ld.null_matrix(all, column_index);
         LearningData split_data(data, normalized, null_matrix, variable_candidates[current_split], split_leaf_types);
-        auto child = std::make_unique<Product::ChildWithVariables>(
+        children[current_split] = std::make_unique<Product::ChildWithVariables>(
             learn_node(split_data),
             variable_candidates[current_split]
         );
-        children.push_back(std::move(child));
-    }
+    });
     return std::make_unique<Product>(std::move(children), ld.data.rows());
 }
 
@@ -646,7 +843,9 @@ std::unique_ptr<Spn::Sum> Spn::create_sum(Spn::LearningData &ld)
     while (true) {
         unsigned num_split_nodes = 0;
 
-        auto [labels, centroids] = kmeans_with_centroids(ld.normalized, k);
+        /* assign the rows to the clusters on up to `max_threads` threads, but at least 4096 rows per thread */
+        const std::size_t num_threads = std::clamp<std::size_t>(num_rows / (4 * MIN_ROWS_PER_TASK), 1, max_threads);
+        auto [labels, centroids] = kmeans_with_centroids(ld.normalized, k, num_threads);
 
         std::vector<std::vector<SmallBitset>> cluster_column_candidates(k);
         std::vector<std::vector<SmallBitset>> cluster_variable_candidates(k);
@@ -704,8 +903,9 @@ std::unique_ptr<Spn::Sum> Spn::create_sum(Spn::LearningData &ld)
             ((num_split_nodes <= prev_num_split_nodes or prev_num_split_nodes == prev_cluster_row_ids.size())
              and prev_num_split_nodes != 0) or k >= MAX_K
         ) {
-            std::vector<std::unique_ptr<Sum::ChildWithWeight>> children;
-            for (std::size_t cluster_id = 0; cluster_id < k - 1; cluster_id++) {
+            /* learn the children of the clusters in parallel */
+            std::vector<std::unique_ptr<Sum::ChildWithWeight>> children(k - 1);
+            fork_join(k - 1, num_rows >= MIN_ROWS_PER_TASK, [&](std::size_t cluster_id) {
                 const MatrixXf &data = ld.data(prev_cluster_row_ids[cluster_id], all);
                 const MatrixXf &normalized = ld.normalized(prev_cluster_row_ids[cluster_id], all);
                 const MatrixXi &null_matrix = ld.null_matrix(prev_cluster_row_ids[cluster_id], all);
@@ -727,14 +927,12 @@ std::unique_ptr<Spn::Sum> Spn::create_sum(Spn::LearningData &ld)
                         prev_cluster_variable_candidates[cluster_id]
                     );
                 }
-                std::unique_ptr<Sum::ChildWithWeight> child = std::make_unique<Sum::ChildWithWeight>(
+                children[cluster_id] = std::make_unique<Sum::ChildWithWeight>(
                     std::move(child_node),
                     weight,
                     prev_centroids.row(cluster_id)
                 );
-
-                children.push_back(std::move(child));
-            }
+            });
 
             return std::make_unique<Sum>(std::move(children), num_rows);
         }
@@ -848,16 +1046,34 @@ std::unique_ptr<Spn::Node> Spn::learn_node(LearningData &ld)
 
 /*----- Learning -----------------------------------------------------------------------------------------------------*/
 
-Spn Spn::learn_spn(Eigen::MatrixXf &data, Eigen::MatrixXi &null_matrix, std::vector<LeafType> &leaf_types)
+Spn Spn::learn_spn(Eigen::MatrixXf &data, Eigen::MatrixXi &null_matrix, std::vector<LeafType> &leaf_types,
+                   std::size_t num_threads, std::size_t sample_size)
 {
-    std::size_t num_rows = data.rows();
-    MIN_INSTANCE_SLICE = std::max<std::size_t>((0.1 * num_rows), 1);
+    const std::size_t num_rows = data.rows();
 
     if (num_rows == 0) {
         std::vector<DiscreteLeaf::Bin> bins;
         return Spn(0, std::make_unique<DiscreteLeaf>(std::move(bins), 0, 0));
     }
 
+    /* learn on a uniform sample of the rows, drawn deterministically */
+    if (sample_size != 0 and sample_size < num_rows) {
+        std::vector<unsigned> all_row_ids(num_rows);
+        std::iota(all_row_ids.begin(), all_row_ids.end(), 0);
+        std::vector<unsigned> row_ids;
+        row_ids.reserve(sample_size);
+        std::mt19937 g(0);
+        std::sample(all_row_ids.begin(), all_row_ids.end(), std::back_inserter(row_ids), sample_size, g);
+        MatrixXf sampled_data = data(row_ids, all);
+        MatrixXi sampled_null_matrix = null_matrix(row_ids, all);
+        Spn spn = learn_spn(sampled_data, sampled_null_matrix, leaf_types, num_threads, 0);
+        spn.num_rows_ = num_rows; // the SPN represents the entire data
+        return spn;
+    }
+
+    MIN_INSTANCE_SLICE = std::max<std::size_t>((0.1 * num_rows), 1);
+    max_threads = std::max<std::size_t>(num_threads, 1);
+
     /* replace NULL in the data matrix with the mean of the attribute */
     for (std::size_t col_id = 0; col_id < data.cols(); col_id++) {
         if (null_matrix.col(col_id).maxCoeff() == 0) { continue; } // there is no NULL
@@ -893,21 +1109,28 @@ void Spn::update(VectorXf &row, UpdateType update_type)
 {
     SmallBitset variables((1 << row.size()) - 1);
     root_->update(row, variables, update_type);
+    compiled_ = std::make_unique<Compiled>(*root_);
 }
 
 float Spn::likelihood(const Filter &filter) const
 {
-    return root_->evaluate(filter, filter.begin()->first, APPROXIMATE).second;
+    std::pair<float, float> result;
+    compiled_->evaluate(&filter, 1, APPROXIMATE, &result);
+    return result.second;
 }
 
 float Spn::upper_bound(const Filter &filter) const
 {
-    return root_->evaluate(filter, filter.begin()->first, UPPER_BOUND).second;
+    std::pair<float, float> result;
+    compiled_->evaluate(&filter, 1, UPPER_BOUND, &result);
+    return result.second;
 }
 
 float Spn::lower_bound(const Filter &filter) const
 {
-    return root_->evaluate(filter, filter.begin()->first, LOWER_BOUND).second;
+    std::pair<float, float> result;
+    compiled_->evaluate(&filter, 1, LOWER_BOUND, &result);
+    return result.second;
 }
 
 float Spn::expectation(unsigned attribute_id, const Filter &filter) const
@@ -915,7 +1138,9 @@ float Spn::expectation(unsigned attribute_id, const Filter &filter) const
     auto filter_copy = filter;
     filter_copy.emplace(attribute_id, std::make_pair(EXPECTATION, 0.f));
 
-    auto [cond_expectation, likelihood] = root_->evaluate(filter_copy, filter_copy.begin()->first, APPROXIMATE);
+    std::pair<float, float> result;
+    compiled_->evaluate(&filter_copy, 1, APPROXIMATE, &result);
+    auto [cond_expectation, likelihood] = result;
     float llh = 1.f;
     if (!filter.empty()) {
         if (likelihood == 0) { return 0; }
@@ -925,6 +1150,16 @@ float Spn::expectation(unsigned attribute_id, const Filter &filter) const
     return cond_expectation / llh;
 }
 
+void Spn::likelihoods(const std::vector<Filter> &filters, std::vector<float> &likelihoods) const
+{
+    static thread_local std::vector<std::pair<float, float>> results;
+    results.resize(filters.size());
+    compiled_->evaluate(filters.data(), filters.size(), APPROXIMATE, results.data());
+    likelihoods.resize(filters.size());
+    for (std::size_t i = 0; i != filters.size(); ++i)
+        likelihoods[i] = results[i].second;
+}
+
 void Spn::update_row(VectorXf &old_row, VectorXf &updated_row)
 {
     delete_row(old_row);
@@ -943,11 +1178,172 @@ void Spn::delete_row(VectorXf &row)
     num_rows_--;
 }
 
+void Spn::insert_rows(const MatrixXf &rows)
+{
+    if (rows.rows() == 0) return;
+    SmallBitset variables((1 << rows.cols()) - 1);
+    VectorXf row(rows.cols());
+    for (Eigen::Index i = 0; i != rows.rows(); ++i) {
+        row = rows.row(i).transpose();
+        root_->update(row, variables, INSERT);
+    }
+    num_rows_ += rows.rows();
+    compiled_ = std::make_unique<Compiled>(*root_); // compile once per batch rather than once per row
+}
+
 std::size_t Spn::estimate_number_distinct_values(unsigned attribute_id) const
 {
     return root_->estimate_number_distinct_values(attribute_id);
 }
 
+/*----- Serialization ------------------------------------------------------------------------------------------------*/
+
+namespace {
+
+/** The magic number starting every serialized SPN. */
+constexpr uint32_t SPN_MAGIC = 0x4e50534d; // "MSPN"
+/** The version of the format of serialized SPNs, incremented on incompatible changes. */
+constexpr uint32_t SPN_FORMAT_VERSION = 1;
+
+template<typename T>
+void write(std::ostream &out, T value) { out.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+template<typename T>
+T read(std::istream &in)
+{
+    std::array<char, sizeof(T)> bytes;
+    if (not in.read(bytes.data(), bytes.size()))
+        throw invalid_argument("unexpected end of serialized SPN");
+    return std::bit_cast<T>(bytes); // `T` need not be default constructible
+}
+
+/** Writes the \p n elements at \p data, preceded by their number. */
+template<typename T>
+void write_array(std::ostream &out, const T *data, uint32_t n)
+{
+    write(out, n);
+    out.write(reinterpret_cast<const char*>(data), n * sizeof(T));
+}
+
+/** Reads an array written by `write_array()`. */
+template<typename T>
+std::vector<T> read_array(std::istream &in)
+{
+    const auto n = read<uint32_t>(in);
+    std::vector<T> elems;
+    elems.reserve(n);
+    for (uint32_t i = 0; i != n; ++i)
+        elems.push_back(read<T>(in));
+    return elems;
+}
+
+}
+
+void Spn::save_node(std::ostream &out, const Node &node)
+{
+    if (auto sum = dynamic_cast<const Sum*>(&node)) {
+        write(out, Compiled::SUM);
+        write<uint64_t>(out, sum->num_rows);
+        write<uint32_t>(out, sum->children.size());
+        for (auto &child : sum->children) {
+            write(out, child->weight);
+            write_array(out, child->centroid.data(), child->centroid.size());
+            save_node(out, *child->child);
+        }
+    } else if (auto product = dynamic_cast<const Product*>(&node)) {
+        write(out, Compiled::PRODUCT);
+        write<uint64_t>(out, product->num_rows);
+        write<uint32_t>(out, product->children.size());
+        for (auto &child : product->children) {
+            write(out, uint64_t(child->variables));
+            save_node(out, *child->child);
+        }
+    } else if (auto leaf = dynamic_cast<const DiscreteLeaf*>(&node)) {
+        write(out, Compiled::DISCRETE_LEAF);
+        write<uint64_t>(out, leaf->num_rows);
+        write(out, leaf->null_probability);
+        write_array(out, leaf->bins.data(), leaf->bins.size());
+    } else {
+        auto &continuous_leaf = dynamic_cast<const ContinuousLeaf&>(node);
+        write(out, Compiled::CONTINUOUS_LEAF);
+        write<uint64_t>(out, continuous_leaf.num_rows);
+        write(out, continuous_leaf.lower_bound);
+        write(out, continuous_leaf.lower_bound_probability);
+        write(out, continuous_leaf.null_probability);
+        write_array(out, continuous_leaf.bins.data(), continuous_leaf.bins.size());
+    }
+}
+
+std::unique_ptr<Spn::Node> Spn::load_node(std::istream &in)
+{
+    const auto kind = read<Compiled::Kind>(in);
+    const auto num_rows = read<uint64_t>(in);
+    switch (kind) {
+        case Compiled::SUM: {
+            const auto num_children = read<uint32_t>(in);
+            std::vector<std::unique_ptr<Sum::ChildWithWeight>> children;
+            children.reserve(num_children);
+            for (uint32_t i = 0; i != num_children; ++i) {
+                const auto weight = read<float>(in);
+                const auto centroid = read_array<float>(in);
+                auto child = load_node(in);
+                children.push_back(std::make_unique<Sum::ChildWithWeight>(
+                    std::move(child), weight, Eigen::Map<const VectorXf>(centroid.data(), centroid.size())
+                ));
+            }
+            return std::make_unique<Sum>(std::move(children), num_rows);
+        }
+
+        case Compiled::PRODUCT: {
+            const auto num_children = read<uint32_t>(in);
+            std::vector<std::unique_ptr<Product::ChildWithVariables>> children;
+            children.reserve(num_children);
+            for (uint32_t i = 0; i != num_children; ++i) {
+                const SmallBitset variables(read<uint64_t>(in));
+                auto child = load_node(in);
+                children.push_back(std::make_unique<Product::ChildWithVariables>(std::move(child), variables));
+            }
+            return std::make_unique<Product>(std::move(children), num_rows);
+        }
+
+        case Compiled::DISCRETE_LEAF: {
+            const auto null_probability = read<float>(in);
+            auto bins = read_array<DiscreteLeaf::Bin>(in);
+            return std::make_unique<DiscreteLeaf>(std::move(bins), null_probability, num_rows);
+        }
+
+        case Compiled::CONTINUOUS_LEAF: {
+            const auto lower_bound = read<float>(in);
+            const auto lower_bound_probability = read<float>(in);
+            const auto null_probability = read<float>(in);
+            auto bins = read_array<ContinuousLeaf::Bin>(in);
+            return std::make_unique<ContinuousLeaf>(std::move(bins), lower_bound, lower_bound_probability,
+                                                    null_probability, num_rows);
+        }
+
+        default:
+            throw invalid_argument("invalid node of serialized SPN");
+    }
+}
+
+void Spn::save(std::ostream &out) const
+{
+    write(out, SPN_MAGIC);
+    write(out, SPN_FORMAT_VERSION);
+    write<uint64_t>(out, num_rows_);
+    save_node(out, *root_);
+}
+
+Spn Spn::load(std::istream &in)
+{
+    if (read<uint32_t>(in) != SPN_MAGIC)
+        throw invalid_argument("not a serialized SPN");
+    if (read<uint32_t>(in) != SPN_FORMAT_VERSION)
+        throw invalid_argument("unsupported version of serialized SPN");
+    const auto num_rows = read<uint64_t>(in);
+    return Spn(num_rows, load_node(in));
+}
+
 void Spn::dump() const { dump(std::cerr); }
 
 void Spn::dump(std::ostream &out) const
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <Eigen/Core>
 #include <iostream>
 #include <map>
@@ -239,6 +240,10 @@ struct Spn
 
         std::pair<float, float> evaluate(const Filter &bin_value, unsigned leaf_id, EvalType eval_type) const override;
 
+        /** Evaluates the predicate \p spn_operator with \p value on the bins `[begin, end)` of a discrete leaf. */
+        static std::pair<float, float> evaluate_bins(const Bin *begin, const Bin *end, float null_probability,
+                                                     SpnOperator spn_operator, float value);
+
         void update(Eigen::VectorXf &row, SmallBitset variables, UpdateType update_type) override;
 
         std::size_t estimate_number_distinct_values(unsigned id) const override;
@@ -290,6 +295,11 @@ struct Spn
 
         std::pair<float, float> evaluate(const Filter &filter, unsigned leaf_id, EvalType eval_type) const override;
 
+        /** Evaluates the predicate \p spn_operator with \p value on the bins `[begin, end)` of a continuous leaf. */
+        static std::pair<float, float> evaluate_bins(const Bin *begin, const Bin *end, float lower_bound,
+                                                     float lower_bound_probability, float null_probability,
+                                                     SpnOperator spn_operator, float value, EvalType eval_type);
+
         void update(Eigen::VectorXf &row, SmallBitset variables, UpdateType update_type) override;
 
         std::size_t estimate_number_distinct_values(unsigned id) const override;
@@ -303,10 +313,71 @@ struct Spn
         void print(std::ostream &out, std::size_t num_tabs) const override;
     };
 
+    /** A compiled representation of an SPN for fast inference.  The nodes are stored in a flat array in post-order,
+     * i.e. the children of a node precede it, and are evaluated bottom-up in a single loop without virtual calls.  The
+     * bins of all leaves are stored contiguously.  Many filters can be evaluated at once, node by node, such that each
+     * node and its bins are loaded only once per batch. */
+    struct Compiled
+    {
+        enum Kind : uint8_t {
+            SUM,
+            PRODUCT,
+            DISCRETE_LEAF,
+            CONTINUOUS_LEAF
+        };
+
+        struct FlatNode
+        {
+            Kind kind;
+            SmallBitset variables; ///< the variable scope of the node
+            ///> the range of the children in `edges` for inner nodes; the range of the bins for leaves
+            uint32_t begin, end;
+            float lower_bound; ///< the lower bound of the first bin of a continuous leaf
+            float lower_bound_probability; ///< the probability of the lower bound of a continuous leaf
+            float null_probability; ///< the probability of NULL values of a leaf
+            unsigned variable; ///< the variable of a leaf
+        };
+
+        struct Edge
+        {
+            uint32_t child; ///< the index of the child in `nodes`
+            float weight; ///< the weight of the child of a sum node
+        };
+
+        std::vector<FlatNode> nodes;
+        std::vector<Edge> edges;
+        std::vector<DiscreteLeaf::Bin> discrete_bins;
+        std::vector<ContinuousLeaf::Bin> continuous_bins;
+        unsigned num_variables = 0; ///< one more than the largest variable of the SPN
+
+        /** Compiles the SPN rooted in \p root. */
+        explicit Compiled(const Node &root);
+
+        /** Evaluates the \p num_filters filters at \p filters and writes the pairs <conditional expectation,
+         * likelihood> of the root to \p results. */
+        void evaluate(const Filter *filters, std::size_t num_filters, EvalType eval_type,
+                      std::pair<float, float> *results) const;
+
+        private:
+        /** Adds \p node with variable scope \p variables and all its descendants in post-order and returns the index
+         * of \p node. */
+        uint32_t add(const Node &node, SmallBitset variables);
+    };
+
     std::size_t num_rows_;
     std::unique_ptr<Node> root_;
+    std::unique_ptr<Compiled> compiled_; ///< the compiled `root_`, recompiled after updates
+
+    /** Writes \p node and all its descendants in pre-order to \p out, see `save()`. */
+    static void save_node(std::ostream &out, const Node &node);
+    /** Reads a node and all its descendants written by `save_node()` from \p in. */
+    static std::unique_ptr<Node> load_node(std::istream &in);
 
-    Spn(std::size_t num_rows, std::unique_ptr<Node> root) : num_rows_(num_rows), root_(std::move(root)) { }
+    Spn(std::size_t num_rows, std::unique_ptr<Node> root)
+        : num_rows_(num_rows)
+        , root_(std::move(root))
+        , compiled_(std::make_unique<Compiled>(*root_))
+    { }
 
     public:
 
@@ -343,9 +414,13 @@ struct Spn
      * @param null_matrix       the NULL values of the data as a matrix
      * @param attribute_to_id   a map from the attributes (random variables) to internal id
      * @param leaf_types        the types of a leaf for a non-primary key attribute
+     * @param num_threads       the maximal number of threads of the `WorkerPool` to learn independent subtrees and RDC
+     *                          values in parallel
+     * @param sample_size       the number of rows sampled uniformly to learn from; 0 means all rows
      * @return                  the learned SPN
      */
-    static Spn learn_spn(Eigen::MatrixXf &data, Eigen::MatrixXi &null_matrix, std::vector<LeafType> &leaf_types);
+    static Spn learn_spn(Eigen::MatrixXf &data, Eigen::MatrixXi &null_matrix, std::vector<LeafType> &leaf_types,
+                         std::size_t num_threads = 1, std::size_t sample_size = 0);
 
     /*==================================================================================================================
      * Inference
@@ -375,6 +450,10 @@ struct Spn
     /** Compute the expectation of the given attribute. */
     float expectation(unsigned attribute_id, const Filter &filter) const;
 
+    /** Compute the likelihoods of many filters at once and write them to \p likelihoods.  Faster than computing the
+     * likelihood of each filter separately. */
+    void likelihoods(const std::vector<Filter> &filters, std::vector<float> &likelihoods) const;
+
     /** Update the SPN with the given row. */
     void update_row(Eigen::VectorXf &old_row, Eigen::VectorXf &updated_row);
 
@@ -384,6 +463,9 @@ struct Spn
     /** Delete the given row from the SPN. */
     void delete_row(Eigen::VectorXf &row);
 
+    /** Insert the given rows, one row per matrix row, into the SPN.  Faster than inserting each row separately. */
+    void insert_rows(const Eigen::MatrixXf &rows);
+
     /** Estimate the number of distinct values of the given attribute. */
     std::size_t estimate_number_distinct_values(unsigned attribute_id) const;
 
@@ -397,6 +479,17 @@ struct Spn
         return memory_used;
     }
 
+    /*==================================================================================================================
+     * Serialization
+     *================================================================================================================*/
+
+    /** Writes the SPN in a compact binary format to \p out, such that it can be restored by `load()` without learning
+     * it again. */
+    void save(std::ostream &out) const;
+
+    /** Reads an SPN written by `save()` from \p in.  Throws `invalid_argument` if \p in does not hold an SPN. */
+    static Spn load(std::istream &in);
+
     void dump() const;
     void dump(std::ostream &out) const;
 };
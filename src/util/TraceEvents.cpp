@@ -0,0 +1,39 @@
+#include "util/TraceEvents.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <mutable/util/fn.hpp>
+#include <optional>
+#include <string>
+
+
+using namespace m;
+
+
+void m::write_trace_events(std::ostream &out, const Timer &timer)
+{
+    using namespace std::chrono;
+
+    /*----- Find the begin of the trace. -----*/
+    std::optional<Timer::time_point> trace_begin;
+    for (auto &M : timer) {
+        if (M.is_finished())
+            trace_begin = trace_begin ? std::min(*trace_begin, M.begin) : M.begin;
+    }
+
+    /*----- Emit a complete event per finished measurement. -----*/
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    for (auto &M : timer) {
+        if (not M.is_finished()) continue;
+        std::string name(M.name);
+        name.erase(0, name.find_first_not_of(" |-`")); // strip the prefixes of nested measurements
+        if (not first) out << ',';
+        first = false;
+        out << "\n{\"name\":\"" << escape(name, '\\', '"') << "\",\"cat\":\"mutable\",\"ph\":\"X\""
+            << ",\"ts\":" << duration_cast<nanoseconds>(M.begin - *trace_begin).count() / 1e3
+            << ",\"dur\":" << duration_cast<nanoseconds>(M.duration()).count() / 1e3
+            << ",\"pid\":1,\"tid\":1}";
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+}
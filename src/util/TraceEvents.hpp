@@ -0,0 +1,16 @@
+#pragma once
+
+#include <mutable/util/Timer.hpp>
+#include <ostream>
+
+
+namespace m {
+
+/** Writes the measurements of \p timer to \p out as JSON in the Trace Event Format of Chrome, which is read by
+ * `chrome://tracing` and Perfetto.  Every finished measurement becomes a *complete* event with its begin relative to
+ * the earliest begin of all measurements.  The viewers recover the nesting of the phases, which `Timer` expresses by
+ * prefixing the names with `|- ` and `` ` ``, from the time spans; hence, these prefixes are stripped.  Unused and
+ * unfinished measurements are omitted. */
+void write_trace_events(std::ostream &out, const Timer &timer);
+
+}
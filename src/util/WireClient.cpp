@@ -0,0 +1,107 @@
+#include "util/WireClient.hpp"
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <stdexcept>
+
+
+using namespace m;
+using namespace m::wire;
+namespace ip = boost::asio::ip;
+
+
+Client::Client(const std::string &host, uint16_t port)
+    : socket_(io_ctx_)
+{
+    boost::system::error_code ec;
+    ip::tcp::resolver resolver(io_ctx_);
+    auto endpoints = resolver.resolve(host, std::to_string(port), ec);
+    if (not ec)
+        boost::asio::connect(socket_, endpoints, ec);
+    if (ec)
+        throw std::runtime_error("could not connect to " + host + ':' + std::to_string(port) + ": " + ec.message());
+}
+
+Client::~Client()
+{
+    try {
+        send(MSG_TERMINATE);
+    } catch (std::runtime_error) {
+        /* The server already closed the connection. */
+    }
+}
+
+bool Client::query(std::string_view sql, const on_schema_t &on_schema, const on_batch_t &on_batch,
+                   std::string &error)
+{
+    send(MSG_QUERY, sql);
+    return complete(on_schema, on_batch, error);
+}
+
+bool Client::append(std::string_view table_name, std::string_view batch, std::string &error)
+{
+    send(MSG_APPEND, encode_append(table_name, batch));
+    return complete(nullptr, nullptr, error);
+}
+
+bool Client::replicate(std::string_view payload, std::string &error)
+{
+    send(MSG_REPLICATE, payload);
+    return complete(nullptr, nullptr, error);
+}
+
+void Client::send(message_type type, std::string_view payload)
+{
+    std::string buffer;
+    buffer.reserve(HEADER_SIZE + payload.size());
+    append_message(buffer, type, payload);
+    boost::system::error_code ec;
+    boost::asio::write(socket_, boost::asio::buffer(buffer), ec);
+    if (ec)
+        throw std::runtime_error("could not send to the server: " + ec.message());
+}
+
+std::pair<message_type, std::string> Client::receive()
+{
+    char header[HEADER_SIZE];
+    boost::system::error_code ec;
+    boost::asio::read(socket_, boost::asio::buffer(header, HEADER_SIZE), ec);
+    if (ec)
+        throw std::runtime_error("could not receive from the server: " + ec.message());
+    auto [type, length] = decode_header(header);
+    std::string payload(length, '\0');
+    boost::asio::read(socket_, boost::asio::buffer(payload.data(), length), ec);
+    if (ec)
+        throw std::runtime_error("could not receive from the server: " + ec.message());
+    return { type, std::move(payload) };
+}
+
+bool Client::complete(const on_schema_t &on_schema, const on_batch_t &on_batch, std::string &error)
+{
+    for (;;) {
+        auto [type, payload] = receive();
+        switch (type) {
+            case MSG_SCHEMA:
+                if (on_schema) on_schema(payload);
+                break;
+
+            case MSG_BATCH:
+                if (on_batch) on_batch(payload);
+                break;
+
+            case MSG_OUTPUT:
+                break; // textual output of the node is not forwarded
+
+            case MSG_READY:
+                return true;
+
+            case MSG_ERROR:
+                error = std::move(payload);
+                return false;
+
+            default:
+                throw std::runtime_error("unexpected message from the server");
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "util/WireProtocol.hpp"
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+
+namespace m {
+
+namespace wire {
+
+/** A blocking client of `mutable-server`, see `m::wire`.  Used by the nodes of a `Cluster` to move rows between nodes
+ * and to gather the results of queries. */
+struct Client
+{
+    using on_schema_t = std::function<void(std::string_view)>;
+    using on_batch_t = std::function<void(std::string_view)>;
+
+    private:
+    boost::asio::io_context io_ctx_;
+    boost::asio::ip::tcp::socket socket_;
+
+    public:
+    /** Connects to the server at \p host and \p port.  Throws `std::runtime_error` if the connection fails. */
+    Client(const std::string &host, uint16_t port);
+    ~Client();
+
+    Client(const Client&) = delete;
+    Client & operator=(const Client&) = delete;
+
+    /** Executes the SQL statement or instruction \p sql.  The payloads of the `MSG_SCHEMA` and `MSG_BATCH` messages of
+     * the result are passed to \p on_schema and \p on_batch, respectively.  Returns `true` on success, otherwise the
+     * error messages of the server are stored in \p error. */
+    bool query(std::string_view sql, const on_schema_t &on_schema, const on_batch_t &on_batch, std::string &error);
+
+    /** Appends the record batch \p batch to the table \p table_name.  Returns `true` on success, otherwise the error
+     * messages of the server are stored in \p error. */
+    bool append(std::string_view table_name, std::string_view batch, std::string &error);
+
+    /** Ships the transaction of the `MSG_REPLICATE` payload \p payload to the replica.  Returns `true` once the
+     * replica applied the transaction, otherwise the error messages of the replica are stored in \p error. */
+    bool replicate(std::string_view payload, std::string &error);
+
+    private:
+    /** Sends the message of type \p type with payload \p payload.  Throws `std::runtime_error` on failure. */
+    void send(message_type type, std::string_view payload = {});
+    /** Receives the next message.  Throws `std::runtime_error` on failure. */
+    std::pair<message_type, std::string> receive();
+    /** Receives messages up to the final `MSG_READY` or `MSG_ERROR`, passing results to the callbacks. */
+    bool complete(const on_schema_t &on_schema, const on_batch_t &on_batch, std::string &error);
+};
+
+}
+
+}
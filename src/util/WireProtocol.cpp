@@ -0,0 +1,399 @@
+#include "util/WireProtocol.hpp"
+
+#include "util/Date.hpp"
+#include <bit>
+#include <cstring>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/util/exception.hpp>
+#include <mutable/util/fn.hpp>
+#include <mutable/util/macro.hpp>
+#include <sstream>
+
+
+using namespace m;
+using namespace m::wire;
+
+
+namespace {
+
+/** Appends the \p size least significant bytes of \p value to \p buffer, little endian. */
+template<typename T>
+void put(std::string &buffer, T value, std::size_t size = sizeof(T))
+{
+    static_assert(std::endian::native == std::endian::little, "the wire protocol is little endian");
+    buffer.append(reinterpret_cast<const char*>(&value), size);
+}
+
+void put_string(std::string &buffer, std::string_view str)
+{
+    put<uint32_t>(buffer, str.size());
+    buffer.append(str);
+}
+
+/** Reads the integers and strings of a payload front to back.  Throws `invalid_argument` when reading past its end. */
+struct PayloadReader
+{
+    private:
+    const char *pos_;
+    const char *end_;
+
+    public:
+    explicit PayloadReader(std::string_view payload) : pos_(payload.data()), end_(payload.data() + payload.size()) { }
+
+    /** Returns the remaining bytes of the payload. */
+    std::string_view rest() const { return { pos_, std::size_t(end_ - pos_) }; }
+
+    const char * get_bytes(std::size_t size) {
+        if (std::size_t(end_ - pos_) < size)
+            throw invalid_argument("truncated payload");
+        const char *bytes = pos_;
+        pos_ += size;
+        return bytes;
+    }
+
+    template<typename T>
+    T get() {
+        T value;
+        std::memcpy(&value, get_bytes(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    std::string_view get_string() {
+        const uint32_t length = get<uint32_t>();
+        return { get_bytes(length), length };
+    }
+};
+
+/** Returns the number of bytes of the values of \p num_rows rows of a column of `Type` \p type in a record batch. */
+std::size_t values_size(const Type &type, std::size_t num_rows)
+{
+    return visit(overloaded {
+        [&](const Boolean&) -> std::size_t { return (num_rows + 7) / 8; },
+        [&](const Numeric &n) -> std::size_t { return n.size() / 8 * num_rows; },
+        [&](const CharacterSequence &cs) -> std::size_t { return cs.size() / 8 * num_rows; },
+        [&](const Date&) -> std::size_t { return sizeof(int32_t) * num_rows; },
+        [&](const DateTime&) -> std::size_t { return sizeof(int64_t) * num_rows; },
+        [&](const NoneType&) -> std::size_t { return 0; },
+        [](auto&&) -> std::size_t { M_unreachable("invalid type"); },
+    }, type);
+}
+
+}
+
+
+/*======================================================================================================================
+ * Messages
+ *====================================================================================================================*/
+
+void wire::append_message(std::string &buffer, message_type type, std::string_view payload)
+{
+    M_insist(payload.size() <= UINT32_MAX, "payload too large");
+    buffer.push_back(type);
+    put<uint32_t>(buffer, payload.size());
+    buffer.append(payload);
+}
+
+std::pair<message_type, uint32_t> wire::decode_header(const char *header)
+{
+    uint32_t length;
+    std::memcpy(&length, header + 1, sizeof(length));
+    return { message_type(header[0]), length };
+}
+
+std::string wire::format(const Type &type)
+{
+    std::ostringstream oss;
+    visit(overloaded {
+        [&](const Boolean&) { oss << 'b'; },
+        [&](const Numeric &n) {
+            switch (n.kind) {
+                case Numeric::N_Int:
+                    switch (n.size()) {
+                        default: M_unreachable("invalid integer size");
+                        case 8:  oss << 'c'; break;
+                        case 16: oss << 's'; break;
+                        case 32: oss << 'i'; break;
+                        case 64: oss << 'l'; break;
+                    }
+                    break;
+                case Numeric::N_Decimal:
+                    oss << "d:" << n.precision << ',' << n.scale << ',' << n.size(); // 32 or 64 bit decimal
+                    break;
+                case Numeric::N_Float:
+                    oss << (n.size() == 32 ? 'f' : 'g');
+                    break;
+            }
+        },
+        [&](const CharacterSequence &cs) { oss << "w:" << cs.size() / 8; }, // fixed-size, NUL-padded binary
+        [&](const Date&) { oss << "tdD"; },
+        [&](const DateTime&) { oss << "tss:"; }, // seconds since epoch without time zone
+        [&](const NoneType&) { oss << 'n'; },
+        [](auto&&) { M_unreachable("invalid type"); },
+    }, type);
+    return oss.str();
+}
+
+const Type * wire::parse_format(std::string_view format)
+{
+    auto parse_numbers = [format](std::size_t prefix_length) {
+        std::vector<unsigned> numbers;
+        std::istringstream in{std::string(format.substr(prefix_length))};
+        unsigned n;
+        while (in >> n) {
+            numbers.push_back(n);
+            if (in.peek() == ',') in.get();
+        }
+        if (not in.eof()) throw invalid_argument("invalid format");
+        return numbers;
+    };
+
+    if (format == "b") return Type::Get_Boolean(Type::TY_Vector);
+    if (format == "c") return Type::Get_Integer(Type::TY_Vector, 1);
+    if (format == "s") return Type::Get_Integer(Type::TY_Vector, 2);
+    if (format == "i") return Type::Get_Integer(Type::TY_Vector, 4);
+    if (format == "l") return Type::Get_Integer(Type::TY_Vector, 8);
+    if (format == "f") return Type::Get_Float(Type::TY_Vector);
+    if (format == "g") return Type::Get_Double(Type::TY_Vector);
+    if (format == "tdD") return Type::Get_Date(Type::TY_Vector);
+    if (format == "tss:") return Type::Get_Datetime(Type::TY_Vector);
+    if (format == "n") return Type::Get_None();
+    if (format.starts_with("d:")) {
+        auto numbers = parse_numbers(2);
+        if (numbers.size() != 3) throw invalid_argument("invalid decimal format");
+        return Type::Get_Decimal(Type::TY_Vector, numbers[0], numbers[1]);
+    }
+    if (format.starts_with("w:")) {
+        auto numbers = parse_numbers(2);
+        if (numbers.size() != 1) throw invalid_argument("invalid fixed-size binary format");
+        return Type::Get_Char(Type::TY_Vector, numbers[0]);
+    }
+    throw invalid_argument("unsupported format");
+}
+
+Schema wire::decode_schema(std::string_view payload)
+{
+    Catalog &C = Catalog::Get();
+    PayloadReader R(payload);
+    Schema schema;
+    const uint32_t num_columns = R.get<uint32_t>();
+    for (uint32_t idx = 0; idx != num_columns; ++idx) {
+        const std::string name(R.get_string());
+        schema.add(C.pool(name.c_str()), parse_format(R.get_string()));
+    }
+    return schema;
+}
+
+std::string wire::encode_append(std::string_view table_name, std::string_view batch)
+{
+    std::string payload;
+    put_string(payload, table_name);
+    payload.append(batch);
+    return payload;
+}
+
+std::pair<std::string, std::string_view> wire::decode_append(std::string_view payload)
+{
+    PayloadReader R(payload);
+    std::string table_name(R.get_string());
+    return { std::move(table_name), R.rest() };
+}
+
+std::string wire::encode_replicate(const ReplicatedTransaction &transaction)
+{
+    std::string payload;
+    put<uint64_t>(payload, transaction.position);
+    put<int64_t>(payload, transaction.commit_time);
+    put<uint32_t>(payload, transaction.changes.size());
+    for (auto &change : transaction.changes) {
+        put_string(payload, change.database);
+        put_string(payload, change.table);
+        M_insist(change.data.size() <= UINT32_MAX, "change too large");
+        put_string(payload, change.data);
+    }
+    return payload;
+}
+
+ReplicatedTransaction wire::decode_replicate(std::string_view payload)
+{
+    PayloadReader R(payload);
+    ReplicatedTransaction transaction;
+    transaction.position = R.get<uint64_t>();
+    transaction.commit_time = R.get<int64_t>();
+    const uint32_t num_changes = R.get<uint32_t>();
+    for (uint32_t i = 0; i != num_changes; ++i) {
+        auto &change = transaction.changes.emplace_back();
+        change.database = R.get_string();
+        change.table = R.get_string();
+        change.data = R.get_string();
+    }
+    if (not R.rest().empty())
+        throw invalid_argument("trailing bytes after the changes");
+    return transaction;
+}
+
+std::string wire::encode_schema(const Schema &schema)
+{
+    std::string payload;
+    put<uint32_t>(payload, schema.num_entries());
+    for (auto &e : schema) {
+        std::ostringstream name;
+        name << e.id;
+        put_string(payload, name.str());
+        put_string(payload, format(*e.type));
+    }
+    return payload;
+}
+
+
+/*======================================================================================================================
+ * BatchWriter
+ *====================================================================================================================*/
+
+BatchWriter::BatchWriter(Schema schema)
+    : schema_(std::move(schema))
+    , validity_(schema_.num_entries())
+    , values_(schema_.num_entries())
+{ }
+
+void BatchWriter::append(const Tuple &tuple)
+{
+    const std::size_t row = num_rows_++;
+    for (std::size_t idx = 0; idx != schema_.num_entries(); ++idx) {
+        auto &validity = validity_[idx];
+        auto &values = values_[idx];
+        if (row % 8 == 0)
+            validity.push_back('\0');
+        const bool is_null = tuple.is_null(idx);
+        if (not is_null)
+            validity.back() |= char(1U << (row % 8));
+
+        auto &type = *schema_[idx].type;
+        if (type.is_none())
+            continue; // Arrow's null type has no buffers
+        const Value value = is_null ? Value() : tuple[idx];
+        visit(overloaded {
+            [&](const Boolean&) {
+                if (row % 8 == 0)
+                    values.push_back('\0');
+                if (not is_null and value.as_b())
+                    values.back() |= char(1U << (row % 8));
+            },
+            [&](const Numeric &n) {
+                switch (n.kind) {
+                    case Numeric::N_Int:
+                    case Numeric::N_Decimal:
+                        put<int64_t>(values, is_null ? 0 : value.as_i(), n.size() / 8); // truncates
+                        break;
+                    case Numeric::N_Float:
+                        if (n.size() == 32)
+                            put<float>(values, is_null ? 0.f : value.as_f());
+                        else
+                            put<double>(values, is_null ? 0. : value.as_d());
+                        break;
+                }
+            },
+            [&](const CharacterSequence &cs) {
+                const std::size_t length = cs.size() / 8;
+                const std::size_t offset = values.size();
+                values.append(length, '\0');
+                if (not is_null)
+                    std::strncpy(values.data() + offset, reinterpret_cast<const char*>(value.as_p()), length);
+            },
+            [&](const Date&) { put<int32_t>(values, is_null ? 0 : date::to_days(value.as_i())); },
+            [&](const DateTime&) { put<int64_t>(values, is_null ? 0 : value.as_i()); },
+            [](auto&&) { M_unreachable("invalid type"); },
+        }, type);
+    }
+}
+
+std::string BatchWriter::finish()
+{
+    std::string payload;
+    put<uint32_t>(payload, num_rows_);
+    for (std::size_t idx = 0; idx != schema_.num_entries(); ++idx) {
+        payload.append(validity_[idx]);
+        payload.append(values_[idx]);
+        validity_[idx].clear();
+        values_[idx].clear();
+    }
+    num_rows_ = 0;
+    return payload;
+}
+
+
+/*======================================================================================================================
+ * BatchReader
+ *====================================================================================================================*/
+
+BatchReader::BatchReader(const Schema &schema, std::string_view payload)
+    : schema_(schema)
+{
+    PayloadReader R(payload);
+    num_rows_ = R.get<uint32_t>();
+    for (auto &e : schema_) {
+        validity_.push_back(R.get_bytes((num_rows_ + 7) / 8));
+        values_.push_back(R.get_bytes(values_size(*e.type, num_rows_)));
+    }
+    if (not R.rest().empty())
+        throw invalid_argument("record batch does not match the schema");
+}
+
+void BatchReader::read(Tuple &tuple)
+{
+    M_insist(row_ < num_rows_, "all rows were read");
+    const std::size_t row = row_++;
+    for (std::size_t idx = 0; idx != schema_.num_entries(); ++idx) {
+        auto &type = *schema_[idx].type;
+        if (type.is_none() or not (validity_[idx][row / 8] & (1U << (row % 8)))) {
+            tuple.null(idx);
+            continue;
+        }
+        const char *values = values_[idx];
+        visit(overloaded {
+            [&](const Boolean&) { tuple.set(idx, bool(values[row / 8] & (1U << (row % 8)))); },
+            [&](const Numeric &n) {
+                const std::size_t size = n.size() / 8;
+                switch (n.kind) {
+                    case Numeric::N_Int:
+                    case Numeric::N_Decimal: {
+                        uint64_t bits = 0;
+                        std::memcpy(&bits, values + row * size, size);
+                        const unsigned shift = 64 - 8 * size;
+                        tuple.set(idx, int64_t(bits << shift) >> shift); // sign extend
+                        break;
+                    }
+                    case Numeric::N_Float:
+                        if (size == sizeof(float)) {
+                            float f;
+                            std::memcpy(&f, values + row * size, size);
+                            tuple.set(idx, f);
+                        } else {
+                            double d;
+                            std::memcpy(&d, values + row * size, size);
+                            tuple.set(idx, d);
+                        }
+                        break;
+                }
+            },
+            [&](const CharacterSequence &cs) {
+                const std::size_t length = cs.size() / 8;
+                tuple.not_null(idx);
+                char *dst = reinterpret_cast<char*>(tuple[idx].as_p());
+                std::memcpy(dst, values + row * length, length);
+                dst[length] = 0;
+            },
+            [&](const Date&) {
+                int32_t days;
+                std::memcpy(&days, values + row * sizeof(days), sizeof(days));
+                tuple.set(idx, int64_t(date::from_days(days)));
+            },
+            [&](const DateTime&) {
+                int64_t time;
+                std::memcpy(&time, values + row * sizeof(time), sizeof(time));
+                tuple.set(idx, time);
+            },
+            [](auto&&) { M_unreachable("invalid type"); },
+        }, type);
+    }
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstdint>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace m {
+
+/** The binary wire protocol of `mutable-server`.
+ *
+ * Every message consists of a header of five bytes, i.e. the message type as single byte followed by the length of
+ * the payload in bytes as 32 bit unsigned integer, and the payload.  All integers are little endian.  Strings are
+ * encoded by their length as 32 bit unsigned integer followed by their characters.
+ *
+ * The client sends one request at a time: the SQL text of a single statement or instruction (`MSG_QUERY`), or one of
+ * `MSG_BEGIN`, `MSG_COMMIT`, and `MSG_ABORT` with empty payload to control its transaction.  Queries outside an
+ * explicit transaction are executed in a transaction of their own.  The server answers each request with any number
+ * of `MSG_SCHEMA`, `MSG_BATCH`, and `MSG_OUTPUT` messages followed by exactly one `MSG_READY` or `MSG_ERROR`.
+ *
+ * Results are streamed column by column in record batches.  `MSG_SCHEMA` precedes the first batch of a result and
+ * contains the number of columns followed by the name and the Arrow format string of each column.  `MSG_BATCH`
+ * contains the number of rows followed by, for each column, its validity bitmap and its values, both laid out exactly
+ * like the buffers of an Arrow array of the column's format.  Values of NULL entries are zero.
+ *
+ * Nodes of a cluster, see `Cluster`, exchange rows with `MSG_APPEND`, which contains the name of a table followed by
+ * a record batch in the schema of the table.  The server appends the rows to the table and answers with `MSG_READY`
+ * or `MSG_ERROR`.
+ *
+ * A primary ships its committed transactions to its read-only replicas, see `Replication`, with `MSG_REPLICATE`,
+ * which contains the position of the transaction in the commit order of the primary, its commit time, and its
+ * changes, each the name of a database followed by either the SQL text of a DDL statement or the name of a table and
+ * a record batch appended to it.  The replica applies the changes in a single transaction and answers with
+ * `MSG_READY` or `MSG_ERROR`. */
+namespace wire {
+
+enum message_type : char
+{
+    /*----- Client to server -----*/
+    MSG_QUERY       = 'Q', ///< execute the SQL statement or instruction in the payload
+    MSG_BEGIN       = 'B', ///< begin an explicit transaction
+    MSG_COMMIT      = 'C', ///< commit the explicit transaction
+    MSG_ABORT       = 'A', ///< abort the explicit transaction
+    MSG_TERMINATE   = 'X', ///< close the connection, aborting an explicit transaction
+    MSG_APPEND      = 'P', ///< append the record batch in the payload to a table
+    MSG_REPLICATE   = 'R', ///< apply the transaction in the payload, shipped by the primary
+
+    /*----- Server to client -----*/
+    MSG_SCHEMA      = 'T', ///< the schema of the following record batches
+    MSG_BATCH       = 'D', ///< a record batch of a result
+    MSG_OUTPUT      = 'O', ///< textual output of a command, e.g. of an instruction
+    MSG_READY       = 'K', ///< the request succeeded
+    MSG_ERROR       = 'E', ///< the request failed, the payload contains the error messages
+};
+
+///> the size of a message header in bytes
+constexpr std::size_t HEADER_SIZE = 5;
+
+/** Appends the message of type \p type with payload \p payload to \p buffer. */
+void append_message(std::string &buffer, message_type type, std::string_view payload);
+
+/** Returns the type and the payload length of the message with header \p header of `HEADER_SIZE` bytes. */
+std::pair<message_type, uint32_t> decode_header(const char *header);
+
+/** Returns the payload of a `MSG_SCHEMA` message describing \p schema. */
+std::string encode_schema(const Schema &schema);
+
+/** Returns the schema described by the payload \p payload of a `MSG_SCHEMA` message.  Throws `invalid_argument` if
+ * the payload is malformed. */
+Schema decode_schema(std::string_view payload);
+
+/** Returns the Arrow format string of values of `Type` \p type used by `MSG_SCHEMA`. */
+std::string format(const Type &type);
+/** Returns the `Type` of values of the Arrow format string \p format, see `format()`.  Throws `invalid_argument` if
+ * \p format is not used by `MSG_SCHEMA`. */
+const Type * parse_format(std::string_view format);
+
+/** Returns the payload of a `MSG_APPEND` message appending the record batch \p batch to the table \p table_name. */
+std::string encode_append(std::string_view table_name, std::string_view batch);
+/** Returns the table name and the record batch of the payload \p payload of a `MSG_APPEND` message.  Throws
+ * `invalid_argument` if the payload is malformed. */
+std::pair<std::string, std::string_view> decode_append(std::string_view payload);
+
+/** A change of a transaction shipped by a primary to its replicas: either a DDL statement or a record batch appended
+ * to a table. */
+struct ReplicatedChange
+{
+    std::string database; ///< the database in use by the change, empty if none, e.g. for `CREATE DATABASE`
+    std::string table; ///< the table the record batch is appended to, empty for a statement
+    std::string data; ///< the SQL text of the statement or the record batch
+};
+
+/** A transaction committed by a primary, shipped to its replicas. */
+struct ReplicatedTransaction
+{
+    uint64_t position = 0; ///< the position of the transaction in the commit order of the primary, starting at 1
+    int64_t commit_time = 0; ///< the commit time on the primary in microseconds since the epoch
+    std::vector<ReplicatedChange> changes;
+};
+
+/** Returns the payload of a `MSG_REPLICATE` message shipping \p transaction. */
+std::string encode_replicate(const ReplicatedTransaction &transaction);
+/** Returns the transaction of the payload \p payload of a `MSG_REPLICATE` message.  Throws `invalid_argument` if the
+ * payload is malformed. */
+ReplicatedTransaction decode_replicate(std::string_view payload);
+
+/** Collects the tuples of a result column by column and encodes them as payload of `MSG_BATCH` messages. */
+struct BatchWriter
+{
+    private:
+    Schema schema_;
+    std::size_t num_rows_ = 0;
+    ///> the validity bitmap of each column
+    std::vector<std::string> validity_;
+    ///> the values of each column
+    std::vector<std::string> values_;
+
+    public:
+    explicit BatchWriter(Schema schema);
+
+    const Schema & schema() const { return schema_; }
+    /** Returns the number of rows of the current batch. */
+    std::size_t num_rows() const { return num_rows_; }
+
+    /** Appends \p tuple of the schema of this writer to the current batch. */
+    void append(const Tuple &tuple);
+
+    /** Returns the payload of the `MSG_BATCH` message of the current batch and starts a new, empty batch. */
+    std::string finish();
+};
+
+/** Decodes the payload of a `MSG_BATCH` message into tuples, row by row.  The inverse of `BatchWriter`. */
+struct BatchReader
+{
+    private:
+    const Schema &schema_;
+    std::size_t num_rows_;
+    std::size_t row_ = 0; ///< the next row to read
+    ///> the validity bitmap of each column
+    std::vector<const char*> validity_;
+    ///> the values of each column
+    std::vector<const char*> values_;
+
+    public:
+    /** Creates a reader of the record batch \p payload in schema \p schema.  The payload must outlive the reader.
+     * Throws `invalid_argument` if the payload is malformed. */
+    BatchReader(const Schema &schema, std::string_view payload);
+
+    /** Returns the number of rows of the batch. */
+    std::size_t num_rows() const { return num_rows_; }
+    /** Returns `true` iff all rows were read. */
+    bool empty() const { return row_ == num_rows_; }
+
+    /** Reads the next row into \p tuple of the schema of this reader. */
+    void read(Tuple &tuple);
+};
+
+}
+
+}
@@ -0,0 +1,272 @@
+#include "util/WorkerPool.hpp"
+
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutable/catalog/Catalog.hpp>
+#include <string>
+#include <string_view>
+#if __linux__
+#include <filesystem>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+using namespace m;
+
+
+namespace {
+
+namespace options {
+
+/** The number of worker threads; 0 for one per CPU not reserved, less one for the thread calling `parallel_for()`. */
+std::size_t worker_threads = 0;
+/** The CPUs left to the threads serving queries and connections. */
+std::vector<unsigned> reserved_cpus;
+/** Whether to pin the workers to CPUs. */
+bool pin_workers = true;
+
+}
+
+__attribute__((constructor(201)))
+static void add_worker_pool_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Workers",
+        /* short=       */ nullptr,
+        /* long=        */ "--worker-threads",
+        /* description= */ "the number of threads of the shared worker pool (0 for one per CPU not reserved)",
+        /* callback=    */ [](std::size_t num_threads){ options::worker_threads = num_threads; }
+    );
+    C.arg_parser().add<std::vector<std::string_view>>(
+        /* group=       */ "Workers",
+        /* short=       */ nullptr,
+        /* long=        */ "--reserved-cpus",
+        /* description= */ "a comma separated list of CPUs reserved for the threads serving queries and connections, "
+                           "i.e. not used by the worker pool",
+        /* callback=    */ [](std::vector<std::string_view> cpus){
+            options::reserved_cpus.clear();
+            for (auto cpu : cpus) {
+                unsigned id;
+                auto [ptr, ec] = std::from_chars(cpu.data(), cpu.data() + cpu.size(), id);
+                if (ec != std::errc() or ptr != cpu.data() + cpu.size())
+                    std::cerr << "warning: ignore invalid CPU " << cpu << std::endl;
+                else
+                    options::reserved_cpus.push_back(id);
+            }
+        }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Workers",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-worker-pinning",
+        /* description= */ "do not pin the threads of the worker pool to CPUs",
+        /* callback=    */ [](bool){ options::pin_workers = false; }
+    );
+}
+
+/** The ID of the worker executing the current thread, or -1 if the current thread is no worker. */
+thread_local std::size_t current_worker = -1;
+
+/** Pins the calling thread to the CPUs \p cpus.  Returns `false` if pinning is not supported or fails. */
+bool pin_current_thread(const std::vector<unsigned> &cpus)
+{
+#if __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (auto cpu : cpus)
+        CPU_SET(cpu, &mask);
+    return pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) == 0;
+#else
+    (void) cpus;
+    return false;
+#endif
+}
+
+#if __linux__
+/** Reads an unsigned integer from the file \p path, or returns \p fallback if the file cannot be read. */
+unsigned read_unsigned(const std::string &path, unsigned fallback)
+{
+    std::ifstream in(path);
+    unsigned value;
+    return in >> value ? value : fallback;
+}
+#endif
+
+}
+
+WorkerPool::Topology WorkerPool::Topology::Detect()
+{
+    Topology T;
+#if __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        for (unsigned id = 0; id != CPU_SETSIZE; ++id) {
+            if (not CPU_ISSET(id, &mask)) continue;
+            const std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(id);
+            const unsigned package = read_unsigned(dir + "/topology/physical_package_id", 0);
+            const unsigned core = read_unsigned(dir + "/topology/core_id", id);
+            unsigned node = 0;
+            std::error_code ec;
+            for (auto &entry : std::filesystem::directory_iterator(dir, ec)) {
+                const std::string name = entry.path().filename();
+                if (name.starts_with("node")) {
+                    std::from_chars(name.data() + 4, name.data() + name.size(), node);
+                    break;
+                }
+            }
+            T.cpus.push_back({ id, package << 16 | core, node });
+        }
+    }
+#endif
+    if (T.cpus.empty()) {
+        for (unsigned id = 0, n = std::max(1U, std::thread::hardware_concurrency()); id != n; ++id)
+            T.cpus.push_back({ id, id, 0 });
+    }
+    return T;
+}
+
+std::vector<unsigned> WorkerPool::Topology::placement_order(const std::vector<unsigned> &excluded) const
+{
+    /*----- Group the hardware threads by NUMA node and core. -----*/
+    std::map<unsigned, std::map<unsigned, std::vector<unsigned>>> nodes;
+    for (auto &cpu : cpus) {
+        if (std::find(excluded.begin(), excluded.end(), cpu.id) == excluded.end())
+            nodes[cpu.node][cpu.core].push_back(cpu.id);
+    }
+
+    /*----- Round `r` places the `r`-th hardware thread of each core, alternating between the nodes. -----*/
+    std::vector<unsigned> order;
+    for (std::size_t round = 0; ; ++round) {
+        std::vector<std::vector<unsigned>> per_node;
+        for (auto &node : nodes) {
+            auto &round_cpus = per_node.emplace_back();
+            for (auto &core : node.second) {
+                if (round < core.second.size())
+                    round_cpus.push_back(core.second[round]);
+            }
+        }
+        const std::size_t size_before = order.size();
+        for (std::size_t i = 0; ; ++i) {
+            bool placed = false;
+            for (auto &round_cpus : per_node) {
+                if (i < round_cpus.size()) {
+                    order.push_back(round_cpus[i]);
+                    placed = true;
+                }
+            }
+            if (not placed) break;
+        }
+        if (order.size() == size_before) break; // all hardware threads placed
+    }
+    return order;
+}
+
+WorkerPool::WorkerPool()
+{
+    const auto placement = Topology::Detect().placement_order(options::reserved_cpus);
+    const std::size_t num_workers = options::worker_threads ? options::worker_threads
+                                                            : std::max<std::size_t>(placement.size(), 1) - 1;
+    workers_.reserve(num_workers);
+    for (std::size_t id = 0; id != num_workers; ++id)
+        workers_.emplace_back(std::make_unique<Worker>());
+    for (std::size_t id = 0; id != num_workers; ++id) {
+        workers_[id]->thread = std::thread([this, id, cpu = placement.empty() ? 0 : placement[id % placement.size()],
+                                            pin = options::pin_workers and not placement.empty()]() {
+            if (pin)
+                pin_current_thread({ cpu });
+            work(id);
+        });
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    task_available_.notify_all();
+    for (auto &worker : workers_)
+        worker->thread.join();
+}
+
+WorkerPool & WorkerPool::Get()
+{
+    static WorkerPool the_worker_pool;
+    return the_worker_pool;
+}
+
+void WorkerPool::Pin_To_Reserved_CPUs()
+{
+    if (not options::reserved_cpus.empty())
+        pin_current_thread(options::reserved_cpus);
+}
+
+void WorkerPool::submit(std::function<void(void)> task)
+{
+    if (workers_.empty()) {
+        task(); // no workers to execute the task asynchronously
+        return;
+    }
+    const std::size_t id = current_worker < workers_.size() ? current_worker
+                                                            : next_worker_++ % workers_.size();
+    ++num_pending_; // before pushing, s.t. taking the task never observes fewer pending tasks
+    {
+        std::lock_guard<std::mutex> lock(workers_[id]->mutex);
+        workers_[id]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_); // do not notify a worker between its check and its wait
+    }
+    task_available_.notify_one();
+}
+
+std::function<void(void)> WorkerPool::take(std::size_t id)
+{
+    /*----- Pop the most recent task of the own deque. -----*/
+    {
+        auto &own = *workers_[id];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (not own.tasks.empty()) {
+            auto task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            --num_pending_;
+            return task;
+        }
+    }
+
+    /*----- Steal the oldest task of another worker. -----*/
+    for (std::size_t i = 1; i != workers_.size(); ++i) {
+        auto &victim = *workers_[(id + i) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (not victim.tasks.empty()) {
+            auto task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --num_pending_;
+            return task;
+        }
+    }
+    return {};
+}
+
+void WorkerPool::work(std::size_t id)
+{
+    current_worker = id;
+    for (;;) {
+        if (auto task = take(id)) {
+            task();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        task_available_.wait(lock, [this]() { return stop_ or num_pending_ != 0; });
+        if (stop_ and num_pending_ == 0)
+            return;
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace m {
+
+/** The pool of worker threads shared by all parallel work of the process, e.g. building indexes, analyzing tables,
+ * enumerating plans, or learning SPNs, such that parallel features do not oversubscribe the machine and compete with
+ * each other.
+ *
+ * Each worker owns a deque of tasks.  A worker pushes the tasks it submits to the back of its own deque and pops from
+ * there, such that nested parallelism stays cache-local, and steals from the front of the deques of other workers when
+ * its own deque is empty.  Tasks submitted by other threads are distributed round-robin.
+ *
+ * The workers are pinned to the CPUs the process may run on, see `Topology`: first to one hardware thread of each
+ * physical core, alternating between NUMA nodes, and only then to the SMT siblings.  The CPUs given by
+ * `--reserved-cpus` are excluded; they are left to the threads serving queries and connections, which pin themselves
+ * there with `Pin_To_Reserved_CPUs()`.  The pool is started on first use, i.e. after the command-line arguments were
+ * parsed. */
+struct WorkerPool
+{
+    /** The CPUs the process may run on and their placement in the machine, read from `/sys/devices/system/cpu`. */
+    struct Topology
+    {
+        struct CPU
+        {
+            unsigned id; ///< the number of the CPU, i.e. of the hardware thread, used for pinning
+            unsigned core; ///< the physical core, unique across packages
+            unsigned node; ///< the NUMA node
+        };
+
+        std::vector<CPU> cpus;
+
+        /** Detects the topology of the CPUs in the affinity mask of the process.  Without topology information, e.g.
+         * on other operating systems than Linux, each CPU is considered a core of its own on node 0. */
+        static Topology Detect();
+
+        /** Returns the IDs of the CPUs not in \p excluded in placement order: first one hardware thread per physical
+         * core, alternating between NUMA nodes, then the remaining SMT siblings in the same manner. */
+        std::vector<unsigned> placement_order(const std::vector<unsigned> &excluded) const;
+    };
+
+    private:
+    struct Worker
+    {
+        std::mutex mutex; ///< protects `tasks`
+        std::deque<std::function<void(void)>> tasks;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<std::size_t> num_pending_ = 0; ///< the number of submitted tasks not yet taken by a worker
+    std::atomic<std::size_t> next_worker_ = 0; ///< the worker receiving the next task submitted by another thread
+    std::mutex sleep_mutex_; ///< protects `stop_` and guards sleeping on `task_available_`
+    std::condition_variable task_available_;
+    bool stop_ = false;
+
+    WorkerPool();
+    ~WorkerPool();
+
+    public:
+    static WorkerPool & Get();
+
+    /** Pins the calling thread to the CPUs given by `--reserved-cpus`, if any, e.g. the scheduler or a connection. */
+    static void Pin_To_Reserved_CPUs();
+
+    /** Returns the number of worker threads. */
+    std::size_t num_workers() const { return workers_.size(); }
+    /** Returns the number of threads executing a `parallel_for()`, i.e. the workers and the calling thread. */
+    std::size_t num_threads() const { return num_workers() + 1; }
+
+    /** Submits \p task for asynchronous execution by a worker.  \p task must not throw. */
+    void submit(std::function<void(void)> task);
+
+    /** Calls \p fn for each `i` in `[0, n)` on the calling thread and on up to `max_threads - 1` workers, or on all
+     * workers if \p max_threads is 0, and returns when all calls finished.  The indices are claimed dynamically.  Since
+     * the calling thread claims indices itself and only waits for calls already started, `parallel_for()` may be
+     * nested, e.g. inside tasks of the pool.  The first exception thrown by \p fn is rethrown once all calls
+     * finished. */
+    template<typename Fn>
+    void parallel_for(std::size_t n, Fn &&fn, std::size_t max_threads = 0) {
+        if (n == 0) return;
+        const std::size_t num_helpers =
+            std::min({ n, max_threads ? max_threads : num_threads(), num_threads() }) - 1;
+        if (num_helpers == 0) {
+            for (std::size_t i = 0; i != n; ++i)
+                fn(i);
+            return;
+        }
+
+        /* The state is shared with the helper tasks, which may start only after all calls finished. */
+        struct state_t
+        {
+            std::atomic<std::size_t> next = 0;
+            std::atomic<std::size_t> num_done = 0;
+            std::mutex mutex; ///< protects `exception` and guards waiting on `done`
+            std::condition_variable done;
+            std::exception_ptr exception;
+        };
+        auto state = std::make_shared<state_t>();
+        auto run = [state, n, &fn]() {
+            for (std::size_t i; (i = state->next++) < n; ) { // `fn` is only accessed while calls remain
+                try {
+                    fn(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (not state->exception)
+                        state->exception = std::current_exception();
+                }
+                if (++state->num_done == n) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->done.notify_all();
+                }
+            }
+        };
+        for (std::size_t h = 0; h != num_helpers; ++h)
+            submit(run);
+        run();
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->done.wait(lock, [&state, n]() { return state->num_done == n; });
+        if (state->exception)
+            std::rethrow_exception(state->exception);
+    }
+
+    private:
+    /** The loop of worker \p id. */
+    void work(std::size_t id);
+    /** Takes a task from the deque of worker \p id or, if empty, steals one from another worker.  Returns an empty
+     * function if no task is available. */
+    std::function<void(void)> take(std::size_t id);
+};
+
+}
@@ -4,6 +4,7 @@
 #include <mutable/util/macro.hpp>
 #include <algorithm>
 #include <cassert>
+#include <climits>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
@@ -20,6 +21,15 @@ namespace m {
 
 /*======================================================================================================================
  * This class implements an open addressing hash map that uses reference counting for fast collision resolution.
+ *
+ * Every entry stores a tag of the most significant bits of the hash of its key.  Lookups compare the tags before the
+ * keys, s.t. most entries of other keys in a probe sequence are skipped without comparing keys, which is expensive
+ * for keys like `Tuple`s.
+ *
+ * When an insertion exceeds the maximum load factor, the table grows *incrementally*: a table of twice the capacity
+ * is allocated and every following insertion migrates the entries of the next `MIGRATION_STEP` slots of the old
+ * table, s.t. no single insertion pays for rehashing the entire table.  While the table grows, `for_all()` and
+ * `count()` search both tables; all other lookups and the iteration complete the migration first.
  *====================================================================================================================*/
 
 template<
@@ -47,6 +57,8 @@ struct RefCountingHashMap
     {
         /** Counts the length of the probe sequence. */
         uint32_t probe_length = 0;
+        /** The tag of the hash of the key stored in this entry, see `tag_of()`. */
+        uint8_t tag = 0;
         /** The value stored in this entry. */
         value_type value;
     };
@@ -150,6 +162,11 @@ struct RefCountingHashMap
     using bucket_iterator = the_bucket_iterator<false>;
     using const_bucket_iterator = the_bucket_iterator<true>;
 
+    /** The number of keys whose buckets are prefetched at once by a batched lookup. */
+    static constexpr size_type BATCH_SIZE = 32;
+    /** The number of slots of the old table migrated by each insertion while the table grows. */
+    static constexpr size_type MIGRATION_STEP = 8;
+
     private:
     const hasher h_;
     const key_equal eq_;
@@ -164,6 +181,12 @@ struct RefCountingHashMap
     size_type watermark_high_;
     /** The maximum load factor before resizing. */
     float max_load_factor_ = .85;
+    /** The table before the table started to grow, or `nullptr` if the table is not growing. */
+    entry_type *old_table_ = nullptr;
+    /** The total number of entries allocated in the old table. */
+    size_type old_capacity_ = 0;
+    /** The number of slots of the old table whose entries were migrated to the table. */
+    size_type num_migrated_ = 0;
 
     public:
     RefCountingHashMap(size_type bucket_count,
@@ -190,6 +213,13 @@ struct RefCountingHashMap
                 p->~entry_type();
         }
         free(table_);
+        if (old_table_) {
+            for (auto p = old_table_ + num_migrated_, end = old_table_ + old_capacity_; p != end; ++p) {
+                if (p->probe_length != 0)
+                    p->~entry_type();
+            }
+            free(old_table_);
+        }
     }
 
     size_type capacity() const { return capacity_; }
@@ -202,56 +232,41 @@ struct RefCountingHashMap
         watermark_high_ = max_load_factor_ * capacity_;
     }
     size_type watermark_high() const { return watermark_high_; }
-
-    iterator begin() { return iterator(*this, table_); }
-    iterator end()   { return iterator(*this, table_ + capacity()); }
-    const_iterator begin() const { return const_iterator(*this, table_); }
-    const_iterator end()   const { return const_iterator(*this, table_ + capacity()); }
+    /** Returns `true` iff the table is growing, i.e. entries of the old table are not yet migrated. */
+    bool growing() const { return old_table_ != nullptr; }
+
+    iterator begin() {
+        finish_growing();
+        iterator it(*this, table_);
+        if (table_->probe_length == 0)
+            ++it; // advance to the first occupied entry
+        return it;
+    }
+    iterator end() { finish_growing(); return iterator(*this, table_ + capacity()); }
+    const_iterator begin() const {
+        return const_iterator(*this, const_cast<RefCountingHashMap*>(this)->begin().bucket_);
+    }
+    const_iterator end() const { return const_iterator(*this, const_cast<RefCountingHashMap*>(this)->end().bucket_); }
     const_iterator cbegin() const { return begin(); }
     const_iterator cend()   const { return end(); }
 
     iterator insert_with_duplicates(key_type key, mapped_type value) {
         if (size_ >= watermark_high_)
-            resize(2 * capacity_);
+            grow();
+        migrate(MIGRATION_STEP);
 
         const auto hash = h_(key);
-        const size_type index = masked(hash);
-        entry_type * const bucket = table_ + index;
-
-        if (bucket->probe_length == 0) [[likely]] { // bucket is free
-            ++bucket->probe_length;
-            new (&bucket->value) value_type(std::move(key), std::move(value));
-            ++size_;
-            return iterator(*this, bucket);
-        }
-
-        /* Compute distance to end of probe sequence. */
-        size_type distance = (bucket->probe_length * bucket->probe_length + bucket->probe_length) >> 1;
-        M_insist(distance > 0, "the distance must not be 0, otherwise we would have run into the likely case above");
-
-        /* Search next free slot in bucket's probe sequence. */
-        entry_type *probe = table_ + masked(index + distance);
-        M_insist(probe != bucket, "the probed slot must not be the original bucket as the distance is not 0 and always "
-                                 "less than capacity");
-        while (probe->probe_length != 0) {
-            ++bucket->probe_length;
-            distance += bucket->probe_length;
-            probe = table_ + masked(index + distance);
-        }
-
-        /* Found free slot in bucket's probe sequence.  Place element in slot and update probe length. */
-        ++probe->probe_length; // set probe_length from 0 to 1
-        ++bucket->probe_length;
-        new (&probe->value) value_type(std::move(key), std::move(value));
         ++size_;
-        return iterator(*this, probe);
+        return iterator(*this, place(hash, std::move(key), std::move(value)));
     }
 
     std::pair<iterator, bool> insert_without_duplicates(key_type key, mapped_type value) {
+        finish_growing(); // the key may be in the old table
         if (size_ >= watermark_high_)
             resize(2 * capacity_);
 
         const auto hash = h_(key);
+        const uint8_t tag = tag_of(hash);
         const size_type index = masked(hash);
         entry_type * const bucket = table_ + index;
 
@@ -259,7 +274,7 @@ struct RefCountingHashMap
         size_type insertion_probe_length = 0;
         size_type insertion_probe_distance = 0;
         while (probe->probe_length != 0) {
-            if (eq_(key, probe->value.first))
+            if (probe->tag == tag and eq_(key, probe->value.first))
                 return std::make_pair(iterator(*this, probe), false); // duplicate key
             ++insertion_probe_length;
             insertion_probe_distance += insertion_probe_length;
@@ -267,6 +282,7 @@ struct RefCountingHashMap
         }
 
         ++probe->probe_length; // set probe_length from 0 to 1
+        probe->tag = tag;
         bucket->probe_length = insertion_probe_length + 1;
         new (&probe->value) value_type(std::move(key), std::move(value));
         ++size_;
@@ -274,7 +290,9 @@ struct RefCountingHashMap
     }
 
     iterator find(const key_type &key) {
+        finish_growing();
         const auto hash = h_(key);
+        const uint8_t tag = tag_of(hash);
         const size_type index = masked(hash);
         entry_type * const bucket = table_ + index;
 
@@ -284,7 +302,7 @@ struct RefCountingHashMap
         size_type lookup_probe_length = 0;
         size_type lookup_probe_distance = 0;
         while (probe->probe_length != 0 and lookup_probe_length < bucket->probe_length) {
-            if (eq_(key, probe->value.first))
+            if (probe->tag == tag and eq_(key, probe->value.first))
                 return iterator(*this, probe);
             ++lookup_probe_length;
             lookup_probe_distance += lookup_probe_length;
@@ -296,7 +314,7 @@ struct RefCountingHashMap
         size_type lookup_probe_distance = (lookup_probe_length * (lookup_probe_length - 1)) >> 1;
         while (lookup_probe_length != 0) {
             entry_type *probe = table_ + masked(index + lookup_probe_distance);
-            if (eq_(key, probe->value.first))
+            if (probe->tag == tag and eq_(key, probe->value.first))
                 return iterator(*this, probe);
             --lookup_probe_length;
             lookup_probe_distance -= lookup_probe_length;
@@ -309,6 +327,7 @@ struct RefCountingHashMap
     }
 
     bucket_iterator bucket(const key_type &key) {
+        finish_growing();
         const auto hash = h_(key);
         const size_type index = masked(hash);
         return bucket_iterator(*this, index);
@@ -318,15 +337,39 @@ struct RefCountingHashMap
     }
 
     void for_all(const key_type &key, std::function<void(value_type&)> callback) {
-        for (auto it = bucket(key); it.has_next(); ++it) {
-            if (eq_(key, it->first))
-                callback(*it);
-        }
+        const auto hash = h_(key);
+        for_all_in(table_, capacity_, 0, key, hash, callback);
+        if (old_table_)
+            for_all_in(old_table_, old_capacity_, num_migrated_, key, hash, callback);
     }
     void for_all(const key_type &key, std::function<void(const value_type&)> callback) const {
-        for (auto it = bucket(key); it.has_next(); ++it) {
-            if (eq_(key, it->first))
-                callback(*it);
+        const auto hash = h_(key);
+        for_all_in(table_, capacity_, 0, key, hash, callback);
+        if (old_table_)
+            for_all_in(old_table_, old_capacity_, num_migrated_, key, hash, callback);
+    }
+
+    /** Invokes \p callback as `callback(i, entry)` for every entry matching the `i`-th of the \p num_keys keys starting
+     * at \p keys, in the order of the keys.  The keys are processed in batches of `BATCH_SIZE`: first, the buckets of
+     * all keys of a batch are computed and prefetched, then the buckets are searched, s.t. the cache misses of the
+     * lookups overlap.  \p callback must not modify the map. */
+    template<typename Callback>
+    void for_all(const key_type *keys, size_type num_keys, Callback &&callback) {
+        size_type hashes[BATCH_SIZE];
+        for (size_type batch = 0; batch < num_keys; batch += BATCH_SIZE) {
+            const size_type batch_end = std::min(num_keys, batch + BATCH_SIZE);
+            for (size_type i = batch; i != batch_end; ++i) {
+                hashes[i - batch] = h_(keys[i]);
+                __builtin_prefetch(table_ + masked(hashes[i - batch]));
+                if (old_table_)
+                    __builtin_prefetch(old_table_ + (hashes[i - batch] & (old_capacity_ - 1)));
+            }
+            for (size_type i = batch; i != batch_end; ++i) {
+                auto match = [&](value_type &v) { callback(i, v); };
+                for_all_in(table_, capacity_, 0, keys[i], hashes[i - batch], match);
+                if (old_table_)
+                    for_all_in(old_table_, old_capacity_, num_migrated_, keys[i], hashes[i - batch], match);
+            }
         }
     }
 
@@ -336,10 +379,101 @@ struct RefCountingHashMap
         return cnt;
     }
 
+    private:
+    /** Places the entry of \p key with hash \p hash and \p value in the table and returns it.  Does not update the
+     * size. */
+    entry_type * place(size_type hash, key_type &&key, mapped_type &&value) {
+        const size_type index = masked(hash);
+        entry_type * const bucket = table_ + index;
+
+        if (bucket->probe_length == 0) [[likely]] { // bucket is free
+            ++bucket->probe_length;
+            bucket->tag = tag_of(hash);
+            new (&bucket->value) value_type(std::move(key), std::move(value));
+            return bucket;
+        }
+
+        /* Compute distance to end of probe sequence. */
+        size_type distance = (bucket->probe_length * bucket->probe_length + bucket->probe_length) >> 1;
+        M_insist(distance > 0, "the distance must not be 0, otherwise we would have run into the likely case above");
+
+        /* Search next free slot in bucket's probe sequence. */
+        entry_type *probe = table_ + masked(index + distance);
+        M_insist(probe != bucket, "the probed slot must not be the original bucket as the distance is not 0 and always "
+                                 "less than capacity");
+        while (probe->probe_length != 0) {
+            ++bucket->probe_length;
+            distance += bucket->probe_length;
+            probe = table_ + masked(index + distance);
+        }
+
+        /* Found free slot in bucket's probe sequence.  Place element in slot and update probe length. */
+        ++probe->probe_length; // set probe_length from 0 to 1
+        probe->tag = tag_of(hash);
+        ++bucket->probe_length;
+        new (&probe->value) value_type(std::move(key), std::move(value));
+        return probe;
+    }
+
+    /** Invokes \p callback for every entry of \p key with hash \p hash in \p table of \p capacity entries, ignoring
+     * the first \p num_skipped slots, whose entries were migrated. */
+    template<typename Callback>
+    void for_all_in(entry_type *table, size_type capacity, size_type num_skipped, const key_type &key, size_type hash,
+                    Callback &&callback) const
+    {
+        const uint8_t tag = tag_of(hash);
+        const size_type mask = capacity - size_type(1);
+        const size_type index = hash & mask;
+        const size_type probe_length = table[index].probe_length;
+        size_type distance = 0;
+        for (size_type step = 0; step != probe_length; distance += ++step) {
+            const size_type current = (index + distance) & mask;
+            entry_type &probe = table[current];
+            if (probe.tag == tag and current >= num_skipped and eq_(key, probe.value.first))
+                callback(probe.value);
+        }
+    }
+
+    /** Starts growing the table to twice its capacity, see `migrate()`. */
+    void grow() {
+        finish_growing();
+        old_table_ = table_;
+        old_capacity_ = capacity_;
+        num_migrated_ = 0;
+        capacity_ = 2 * capacity_;
+        table_ = allocate(capacity_);
+        initialize();
+        watermark_high_ = capacity_ * max_load_factor_;
+    }
+
+    /** Migrates the entries of the next \p num_slots slots of the old table, if the table is growing. */
+    void migrate(size_type num_slots) {
+        if (not old_table_) [[likely]] return;
+        for (const size_type end = std::min(old_capacity_, num_migrated_ + num_slots); num_migrated_ != end;
+             ++num_migrated_)
+        {
+            auto &slot = old_table_[num_migrated_];
+            if (slot.probe_length) {
+                auto &key_ref = const_cast<key_type&>(slot.value.first); // hack around the `const key_type`
+                place(h_(key_ref), std::move(key_ref), std::move(slot.value.second));
+            }
+        }
+        if (num_migrated_ == old_capacity_) {
+            free(old_table_);
+            old_table_ = nullptr;
+            old_capacity_ = num_migrated_ = 0;
+        }
+    }
+
+    public:
+    /** Migrates all remaining entries of the old table, if the table is growing. */
+    void finish_growing() { migrate(old_capacity_); }
+
     /** Rehash all elements. */
     private:
     void rehash(std::size_t new_capacity) {
         M_insist((new_capacity & (new_capacity - 1)) == 0, "not a power of 2");
+        M_insist(not old_table_, "the table must not be growing");
         M_insist(size_ <= watermark_high_, "there are more elements to rehash than the high watermark allows");
 
         auto old_table = table_;
@@ -360,9 +494,10 @@ struct RefCountingHashMap
     }
 
     public:
-    void rehash() { rehash(capacity_); }
+    void rehash() { finish_growing(); rehash(capacity_); }
 
     void resize(std::size_t new_capacity) {
+        finish_growing();
         new_capacity = std::max<decltype(new_capacity)>(new_capacity, std::ceil(size() / max_load_factor()));
         new_capacity = ceil_to_pow_2(new_capacity);
 
@@ -395,6 +530,9 @@ M_LCOV_EXCL_START
 M_LCOV_EXCL_STOP
 
     private:
+    /** Returns the tag of \p hash, i.e. its most significant byte, which is not used to select the bucket. */
+    static uint8_t tag_of(size_type hash) { return hash >> (CHAR_BIT * sizeof(size_type) - 8); }
+
     static entry_type * allocate(size_type n, entry_type *hint = nullptr) {
         auto p = static_cast<entry_type*>(realloc(hint, n * sizeof(entry_type)));
         if (p == nullptr)
@@ -5,9 +5,13 @@
 #include <climits>
 #include <cstring>
 #include <exception>
+#include <iterator>
+#include <limits>
 #include <stdexcept>
 
 #if __linux
+#include <fcntl.h>
+#include <linux/falloc.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -117,6 +121,23 @@ M_LCOV_EXCL_STOP
  * LinearAllocator
  *====================================================================================================================*/
 
+namespace {
+
+/** Set MSB of a std::size_t. */
+constexpr std::size_t MSB = std::size_t(1UL) << (sizeof(MSB) * CHAR_BIT - 1U);
+
+/** Mark offset for deallocation by setting MSB.  This is safe as offsets with set MSB would exceed maximum file
+ * size. */
+std::size_t mark_for_deallocation(std::size_t offset) { return offset | MSB; }
+
+/** Check whether MSB is set, i.e. offset marked for deallocation. */
+bool is_marked_for_deallocation(uintptr_t offset) { return offset & MSB; }
+
+/** Clear MSB. */
+std::size_t unmarked(std::size_t offset) { return offset & ~MSB; }
+
+}
+
 Memory LinearAllocator::allocate(std::size_t size)
 {
     if (size == 0) return Memory();
@@ -125,6 +146,32 @@ Memory LinearAllocator::allocate(std::size_t size)
     M_insist(aligned_size >= size, "size must be ceiled");
     M_insist(Is_Page_Aligned(aligned_size), "not page aligned");
 #if __linux
+    /* Reuse the smallest range of deallocated memory that fits, if any, rather than growing the file.  Deallocated
+     * ranges are marked allocations followed by an unmarked one, since adjacent ranges are coalesced and a trailing
+     * range is truncated. */
+    auto best = allocations_.end();
+    std::size_t best_size = std::numeric_limits<std::size_t>::max();
+    for (auto it = allocations_.begin(); it != allocations_.end(); ++it) {
+        if (not is_marked_for_deallocation(*it)) continue;
+        M_insist(std::next(it) != allocations_.end(), "trailing deallocated range must have been truncated");
+        const std::size_t range_size = unmarked(*std::next(it)) - unmarked(*it);
+        if (range_size >= aligned_size and range_size < best_size) {
+            best = it;
+            best_size = range_size;
+            if (range_size == aligned_size) break; // perfect fit
+        }
+    }
+    if (best != allocations_.end()) {
+        const std::size_t offset = unmarked(*best);
+        void *addr = mmap(nullptr, aligned_size, PROT_READ|PROT_WRITE, MAP_SHARED, fd(), offset);
+        if (addr == MAP_FAILED)
+            throw std::runtime_error(strerror(errno));
+        *best = offset;
+        if (best_size != aligned_size) // split range, the remainder stays deallocated
+            allocations_.insert(std::next(best), mark_for_deallocation(offset + aligned_size));
+        return create_memory(addr, aligned_size, offset);
+    }
+
     if (ftruncate(fd(), offset_ + aligned_size))
         throw std::runtime_error(strerror(errno));
 #elif __APPLE__
@@ -142,23 +189,6 @@ Memory LinearAllocator::allocate(std::size_t size)
     return mem;
 }
 
-namespace {
-
-/** Set MSB of a std::size_t. */
-constexpr std::size_t MSB = std::size_t(1UL) << (sizeof(MSB) * CHAR_BIT - 1U);
-
-/** Mark offset for deallocation by setting MSB.  This is safe as offsets with set MSB would exceed maximum file
- * size. */
-std::size_t mark_for_deallocation(std::size_t offset) { return offset | MSB; }
-
-/** Check whether MSB is set, i.e. offset marked for deallocation. */
-bool is_marked_for_deallocation(uintptr_t offset) { return offset & MSB; }
-
-/** Clear MSB. */
-std::size_t unmarked(std::size_t offset) { return offset & ~MSB; }
-
-}
-
 void LinearAllocator::deallocate(Memory &&mem)
 {
     if (&mem.allocator() != this)
@@ -192,6 +222,18 @@ void LinearAllocator::deallocate(Memory &&mem)
 
         /* Remove reclaimed allocations. */
         allocations_.resize(std::distance(it, allocations_.rend()));
+    } else {
+        /* Release the physical memory of the range, such that it is zero-filled when reused.  The file is only
+         * shrunk when the deallocated ranges are trailing. */
+        if (fallocate(fd(), FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, mem.offset(), mem.size()))
+            throw std::runtime_error(strerror(errno));
+
+        /* Coalesce with the adjacent deallocated ranges. */
+        auto fwd = std::prev(it.base()); // forward iterator to the same allocation
+        if (is_marked_for_deallocation(*std::next(fwd)))
+            fwd = std::prev(allocations_.erase(std::next(fwd)));
+        if (fwd != allocations_.begin() and is_marked_for_deallocation(*std::prev(fwd)))
+            allocations_.erase(fwd);
     }
 #elif __APPLE__
     /* Nothing to be done.
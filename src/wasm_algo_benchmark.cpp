@@ -0,0 +1,330 @@
+#include "backend/V8Engine.hpp"
+#include "backend/WasmAlgo.hpp"
+#include "backend/WasmDSL.hpp"
+#include "backend/WasmUtil.hpp"
+#include "backend/WebAssembly.hpp"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/parse/AST.hpp>
+#include <sstream>
+#include <string>
+#include <v8.h>
+#include <vector>
+
+// must be included after Binaryen due to conflicts, e.g. with `::wasm::Throw`
+#include "backend/WasmMacro.hpp"
+
+
+using namespace m;
+using namespace m::wasm;
+using namespace m::wasm::detail;
+using namespace std::chrono;
+
+#ifndef NDEBUG
+static constexpr uint32_t NUM_ELEMENTS_START = 1U<<10;
+static constexpr uint32_t NUM_ELEMENTS_STOP  = 1U<<14;
+#else
+static constexpr uint32_t NUM_ELEMENTS_START = 1U<<10;
+static constexpr uint32_t NUM_ELEMENTS_STOP  = 1U<<22;
+#endif
+
+
+/*======================================================================================================================
+ * Helpers to compile and execute a kernel
+ *====================================================================================================================*/
+
+namespace m {
+
+namespace wasm { struct BenchmarkOp { }; }
+
+/** A dummy match to create a Wasm context without a physical plan. */
+template<>
+struct Match<wasm::BenchmarkOp> : MatchBase
+{
+    void execute(setup_t, pipeline_t, teardown_t) const override { M_unreachable("must not be called"); }
+    const Operator & get_matched_root() const override { M_unreachable("must not be called"); }
+    void print(std::ostream&, unsigned) const override { M_unreachable("must not be called"); }
+};
+
+}
+
+namespace {
+
+const Match<BenchmarkOp> dummy_plan; ///< only needed to create a Wasm context
+
+///> the points in time at which the executed kernel called the imported function `mark`
+std::vector<steady_clock::time_point> marks;
+
+void mark(const v8::FunctionCallbackInfo<v8::Value>&) { marks.push_back(steady_clock::now()); }
+
+/** Emits a call to the imported function `mark`, which records the current point in time. */
+void emit_mark() { Module::Get().emit_call<void>("mark"); }
+
+/** Creates a fresh module and code generation context to emit a kernel into. */
+void init_kernel()
+{
+    Module::Init();
+    CodeGenContext::Init();
+    M_DISCARD WasmEngine::Ensure_Wasm_Context_For_ID(Module::ID(), dummy_plan);
+    Module::Get().emit_function_import<void(void)>("mark");
+}
+
+/** Compiles the current module, whose function `main` emits marks around the measured phases of the kernel,
+ * and executes `main`.  Returns the durations between successive marks in milliseconds. */
+std::vector<double> run_kernel(v8::Isolate &isolate)
+{
+    Module::Get().emit_function_export("main");
+    Module::Allocator().perform_pre_allocations();
+    M_insist(Module::Validate(), "invalid module");
+
+    std::vector<double> durations;
+    {
+        v8::Locker locker(&isolate);
+        v8::Isolate::Scope isolate_scope(&isolate);
+        v8::HandleScope handle_scope(&isolate);
+
+        v8::Local<v8::ObjectTemplate> global = v8::ObjectTemplate::New(&isolate);
+        global->Set(&isolate, "set_wasm_instance_raw_memory",
+                    v8::FunctionTemplate::New(&isolate, set_wasm_instance_raw_memory));
+        v8::Local<v8::Context> context = v8::Context::New(&isolate, /* extensions= */ nullptr, global);
+        v8::Context::Scope context_scope(context);
+
+        auto imports = v8::Object::New(&isolate);
+        auto env = v8::Object::New(&isolate);
+        env->Set(context, mkstr(isolate, "insist"), v8::Function::New(context, insist).ToLocalChecked()).Check();
+        env->Set(context, mkstr(isolate, "throw"), v8::Function::New(context, _throw).ToLocalChecked()).Check();
+        env->Set(context, mkstr(isolate, "mark"), v8::Function::New(context, mark).ToLocalChecked()).Check();
+        M_DISCARD imports->Set(context, mkstr(isolate, "imports"), env);
+
+        auto instance = instantiate(isolate, imports);
+
+        /* Map the remaining address space to the memory of the kernel. */
+        auto &wasm_context = WasmEngine::Get_Wasm_Context_By_ID(Module::ID());
+        const auto bytes_remaining = wasm_context.vm.size() - wasm_context.heap;
+        memory::Memory mem = Catalog::Get().allocator().allocate(bytes_remaining);
+        mem.map(bytes_remaining, 0, wasm_context.vm, wasm_context.heap);
+        v8::SetWasmInstanceRawMemory(instance, wasm_context.vm.as<uint8_t*>(), wasm_context.vm.size());
+
+        auto exports = instance->Get(context, mkstr(isolate, "exports")).ToLocalChecked().As<v8::Object>();
+        auto main = exports->Get(context, mkstr(isolate, "main")).ToLocalChecked().As<v8::Function>();
+
+        marks.clear();
+        M_DISCARD main->Call(context, context->Global(), 0, nullptr).ToLocalChecked();
+        for (std::size_t i = 1; i < marks.size(); ++i)
+            durations.push_back(duration_cast<nanoseconds>(marks[i] - marks[i - 1]).count() / 1e6);
+    }
+
+    WasmEngine::Dispose_Wasm_Context(Module::ID());
+    CodeGenContext::Dispose();
+    Module::Dispose();
+    return durations;
+}
+
+/** Returns the `idx`-th of `num_elements` distinct pseudo-random keys of type \p type; multiplying by an odd number
+ * is a bijection on unsigned integers. */
+SQL_t key(const Type *type, U32x1 idx)
+{
+    if (type->size() == 32)
+        return _I32x1((idx * 2654435761U).make_signed());
+    return _I64x1((idx.to<uint64_t>() * uint64_t(0x9e3779b97f4a7c15ULL)).make_signed());
+}
+
+std::string type_name(const Type *type) { std::ostringstream oss; oss << *type; return oss.str(); }
+
+
+/*======================================================================================================================
+ * Kernels
+ *====================================================================================================================*/
+
+/** Inserts \p num_elements distinct keys of type \p key_type into an open addressing hash table with the maximal load
+ * factor \p load_factor, presized for all keys, and looks up as many keys, of which half are contained.  Then, inserts
+ * the keys into a hash table of the smallest capacity to measure the rehashing. */
+void benchmark_hash_table(v8::Isolate &isolate, const Type *key_type, uint32_t num_elements, double load_factor)
+{
+    Catalog &C = Catalog::Get();
+    Schema ht_schema;
+    ht_schema.add(Schema::Identifier(C.pool("key")), key_type);
+
+    init_kernel();
+    Function<uint32_t(void)> main("main");
+    BLOCK_OPEN(main.body())
+    {
+        Var<U32x1> num_found(0U);
+
+        const auto presized_capacity = uint32_t(num_elements / load_factor) + 1;
+        GlobalOpenAddressingInPlaceHashTable presized(ht_schema, { 0 }, presized_capacity);
+        presized.set_probing_strategy<LinearProbing>();
+        presized.setup();
+        presized.set_high_watermark(load_factor);
+        emit_mark();
+        Var<U32x1> i(0U);
+        WHILE (i < num_elements) {
+            presized.emplace({ key(key_type, i.val()) });
+            i += 1U;
+        }
+        emit_mark();
+        i = U32x1(num_elements / 2);
+        WHILE (i < num_elements + num_elements / 2) {
+            auto [entry, found] = presized.find({ key(key_type, i.val()) });
+            num_found += found.to<uint32_t>();
+            i += 1U;
+        }
+        emit_mark();
+        presized.teardown();
+
+        GlobalOpenAddressingInPlaceHashTable growing(ht_schema, { 0 }, 1U);
+        growing.set_probing_strategy<LinearProbing>();
+        growing.setup();
+        growing.set_high_watermark(load_factor);
+        emit_mark();
+        i = U32x1(0U);
+        WHILE (i < num_elements) {
+            growing.emplace({ key(key_type, i.val()) });
+            i += 1U;
+        }
+        emit_mark();
+        growing.teardown();
+
+        main.emit_return(num_found);
+    }
+    auto durations = run_kernel(isolate);
+    M_insist(durations.size() == 4);
+
+    const auto name = type_name(key_type);
+    std::cout << "insert," << name << ',' << num_elements << ',' << load_factor << ',' << durations[0] << '\n'
+              << "find," << name << ',' << num_elements << ',' << load_factor << ',' << durations[1] << '\n'
+              << "rehash," << name << ',' << num_elements << ',' << load_factor << ',' << durations[3] << std::endl;
+}
+
+/** Sorts \p num_elements pseudo-random keys of type \p key_type by `quicksort()`. */
+void benchmark_quicksort(v8::Isolate &isolate, const Type *key_type, uint32_t num_elements)
+{
+    Catalog &C = Catalog::Get();
+    Position pos(C.pool("Benchmark"));
+    ast::Designator designator(ast::Token(pos, C.pool("."), TK_DOT), ast::Token(pos, C.pool("T"), TK_IDENTIFIER),
+                               ast::Token(pos, C.pool("key"), TK_IDENTIFIER));
+    designator.type(key_type);
+    Schema schema;
+    schema.add(Schema::Identifier(designator), key_type);
+    std::vector<SortingOperator::order_type> order;
+    order.emplace_back(designator, /* ascending= */ true);
+
+    init_kernel();
+    Function<uint32_t(void)> main("main");
+    BLOCK_OPEN(main.body())
+    {
+        auto S = CodeGenContext::Get().scoped_environment();
+        GlobalBuffer buffer(schema, *m::options::hard_pipeline_breaker_layout);
+
+        buffer.setup();
+        Var<U32x1> i(0U);
+        WHILE (i < num_elements) {
+            auto S = CodeGenContext::Get().scoped_environment();
+            CodeGenContext::Get().env().add(schema[0].id, key(key_type, i.val()));
+            buffer.consume();
+            i += 1U;
+        }
+        buffer.teardown();
+
+        emit_mark();
+        quicksort</* CmpPredicated= */ false>(buffer, order);
+        emit_mark();
+
+        main.emit_return(buffer.size());
+    }
+    auto durations = run_kernel(isolate);
+    M_insist(durations.size() == 1);
+
+    std::cout << "quicksort," << type_name(key_type) << ',' << num_elements << ",," << durations[0] << std::endl;
+}
+
+/** Hashes \p num_elements pseudo-random keys of type \p key_type by `murmur3_64a_hash()`. */
+void benchmark_murmur3_64a_hash(v8::Isolate &isolate, const Type *key_type, uint32_t num_elements)
+{
+    init_kernel();
+    Function<uint32_t(void)> main("main");
+    BLOCK_OPEN(main.body())
+    {
+        Var<U64x1> checksum(0UL);
+        emit_mark();
+        Var<U32x1> i(0U);
+        WHILE (i < num_elements) {
+            checksum += murmur3_64a_hash({ { key_type, key(key_type, i.val()) } });
+            i += 1U;
+        }
+        emit_mark();
+        main.emit_return(checksum.to<uint32_t>());
+    }
+    auto durations = run_kernel(isolate);
+    M_insist(durations.size() == 1);
+
+    std::cout << "murmur3_64a_hash," << type_name(key_type) << ',' << num_elements << ",," << durations[0] << std::endl;
+}
+
+/** Hashes \p num_elements pseudo-random strings of \p length characters by `str_hash()`. */
+void benchmark_str_hash(v8::Isolate &isolate, uint32_t length, uint32_t num_elements)
+{
+    init_kernel();
+    Function<uint32_t(void)> main("main");
+    BLOCK_OPEN(main.body())
+    {
+        /*----- Fill the strings with pseudo-random printable characters. -----*/
+        const uint32_t num_bytes = length * num_elements;
+        Var<Ptr<Charx1>> strings(Module::Allocator().allocate(num_bytes).to<char*>());
+        Var<U32x1> i(0U);
+        WHILE (i < num_bytes) {
+            *(strings + i.make_signed()) = ((i * 2654435761U) % 95U + 32U).to<char>();
+            i += 1U;
+        }
+
+        Var<U64x1> checksum(0UL);
+        emit_mark();
+        i = U32x1(0U);
+        WHILE (i < num_elements) {
+            NChar str(strings + (i * length).make_signed(), /* can_be_null= */ false, length,
+                      /* guarantees_terminating_nul= */ false);
+            checksum += str_hash(str);
+            i += 1U;
+        }
+        emit_mark();
+        main.emit_return(checksum.to<uint32_t>());
+    }
+    auto durations = run_kernel(isolate);
+    M_insist(durations.size() == 1);
+
+    std::cout << "str_hash,CHAR(" << length << ")," << num_elements << ",," << durations[0] << std::endl;
+}
+
+}
+
+
+int main(void)
+{
+    v8::V8::SetFlagsFromString("--no-liftoff --no-wasm-lazy-compilation --no-wasm-bounds-checks "
+                               "--no-wasm-stack-checks");
+    v8::Isolate::CreateParams create_params;
+    create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+    v8::Isolate *isolate = v8::Isolate::New(create_params);
+
+    const std::vector<const Type*> key_types = {
+        Type::Get_Integer(Type::TY_Vector, 4),
+        Type::Get_Integer(Type::TY_Vector, 8),
+    };
+
+    std::cout << "kernel,type,count,load_factor,time" << std::endl;
+    for (uint32_t num_elements = NUM_ELEMENTS_START; num_elements <= NUM_ELEMENTS_STOP; num_elements *= 4) {
+        for (auto key_type : key_types) {
+            for (double load_factor : { .5, .7, .9 })
+                benchmark_hash_table(*isolate, key_type, num_elements, load_factor);
+            benchmark_quicksort(*isolate, key_type, num_elements);
+            benchmark_murmur3_64a_hash(*isolate, key_type, num_elements);
+        }
+        for (uint32_t length : { 8U, 32U, 128U })
+            benchmark_str_hash(*isolate, length, num_elements);
+    }
+
+    isolate->Dispose();
+    delete create_params.array_buffer_allocator;
+}
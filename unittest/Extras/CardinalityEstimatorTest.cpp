@@ -1,5 +1,8 @@
 #include "catch2/catch.hpp"
 
+#include "catalog/ColumnStatistics.hpp"
+#include "catalog/HistogramEstimator.hpp"
+#include "catalog/SamplingEstimator.hpp"
 #include "parse/Parser.hpp"
 #include "parse/Sema.hpp"
 #include <cstring>
@@ -8,6 +11,8 @@
 #include <mutable/mutable.hpp>
 #include <mutable/util/ADT.hpp>
 #include <sstream>
+#include <string>
+#include <vector>
 
 
 using namespace m;
@@ -267,3 +272,171 @@ TEST_CASE("Cartesian estimator estimates", "[core][catalog][cardinality]")
         CHECK(CE.predict_cardinality(*join_model) == 50);
     }
 }
+
+TEST_CASE("Sampling estimator estimates", "[core][catalog][cardinality]")
+{
+    using Subproblem = SmallBitset;
+    /* Get Catalog and create new database to use for unit testing. */
+    Catalog::Clear();
+    Catalog &Cat = Catalog::Get();
+    auto &db = Cat.add_database(Cat.pool("db"));
+    Cat.set_database_in_use(db);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    auto execute = [&](const std::string &sql) {
+        auto stmt = m::statement_from_string(diag, sql);
+        M_insist(diag.num_errors() == 0);
+        execute_statement(diag, *stmt);
+    };
+
+    /* Create tables `A` with 10 rows and `B` with 20 rows, each row of `B` referencing a row of `A`. */
+    execute("CREATE TABLE A (id INT(4), name CHAR(8));");
+    execute("CREATE TABLE B (id INT(4), aid INT(4));");
+    for (int i = 0; i != 10; ++i)
+        execute("INSERT INTO A VALUES (" + std::to_string(i) + ", \"" + (i < 2 ? "foo" : "bar") + "\");");
+    for (int i = 0; i != 20; ++i)
+        execute("INSERT INTO B VALUES (" + std::to_string(i) + ", " + std::to_string(i % 10) + ");");
+
+    const char *query = "SELECT * FROM A, B WHERE A.name LIKE \"f%\" AND A.id = B.aid;";
+    auto S = m::statement_from_string(diag, query);
+    M_insist(diag.num_errors() == 0);
+    auto G = QueryGraph::Build(*S);
+    SamplingEstimator SE(Cat.pool("db"));
+
+    auto scan_A = SE.estimate_scan(*G, Subproblem::Singleton(0));
+    auto scan_B = SE.estimate_scan(*G, Subproblem::Singleton(1));
+
+    SECTION("estimate_scan")
+    {
+        CHECK(SE.predict_cardinality(*scan_A) == 10);
+        CHECK(SE.predict_cardinality(*scan_B) == 20);
+    }
+
+    SECTION("estimate_filter")
+    {
+        /* The sample contains all rows, hence the selectivity of the `LIKE` predicate is exact. */
+        auto filter_A = SE.estimate_filter(*G, *scan_A, G->sources()[0]->filter());
+        CHECK(SE.predict_cardinality(*filter_A) == 2);
+    }
+
+    SECTION("estimate_join")
+    {
+        auto filter_A = SE.estimate_filter(*G, *scan_A, G->sources()[0]->filter());
+        auto join_model = SE.estimate_join(*G, *filter_A, *scan_B, G->joins()[0]->condition());
+        CHECK(SE.predict_cardinality(*join_model) == 4);
+    }
+
+    SECTION("insert rows")
+    {
+        /* Appended rows are fed into the sample of the table. */
+        for (int i = 0; i != 4; ++i)
+            execute("INSERT INTO A VALUES (" + std::to_string(10 + i) + ", \"foo\");");
+        auto scan_model = SE.estimate_scan(*G, Subproblem::Singleton(0));
+        auto filter_model = SE.estimate_filter(*G, *scan_model, G->sources()[0]->filter());
+        CHECK(SE.predict_cardinality(*scan_model) == 14);
+        CHECK(SE.predict_cardinality(*filter_model) == 6);
+    }
+}
+
+TEST_CASE("Column histograms", "[core][catalog][cardinality]")
+{
+    SECTION("equi-depth histogram")
+    {
+        std::vector<double> values;
+        for (int i = 0; i != 1000; ++i)
+            values.push_back(i);
+        auto H = ColumnHistogram::Build(values, 0, 1000);
+        CHECK(H.mcvs.empty());
+        CHECK(H.bounds.size() == ColumnHistogram::NUM_BUCKETS + 1);
+        CHECK(H.num_distinct == Approx(1000));
+        CHECK(H.selectivity_less(250, false) == Approx(.25).epsilon(.01));
+        CHECK(H.selectivity_greater(900, true) == Approx(.1).epsilon(.02));
+        CHECK(H.selectivity_less(-1, true) == Approx(0));
+        CHECK(H.selectivity_equal(42) == Approx(.001));
+        CHECK(H.selectivity_equal(4242) == Approx(0));
+    }
+
+    SECTION("most common values")
+    {
+        /* Half of the values are 0, the others are distinct. */
+        std::vector<double> values;
+        for (int i = 0; i != 1000; ++i)
+            values.push_back(i % 2 ? i : 0);
+        auto H = ColumnHistogram::Build(values, 0, 1000);
+        REQUIRE(H.mcvs.size() == 1);
+        CHECK(H.mcvs[0].first == 0);
+        CHECK(H.selectivity_equal(0) == Approx(.5));
+        CHECK(H.selectivity_less(0, true) == Approx(.5));
+        CHECK(H.histogram_fraction == Approx(.5));
+    }
+
+    SECTION("NULL and strings")
+    {
+        std::vector<std::string> values = { "foo", "foo", "bar" };
+        auto H = ColumnHistogram::Build(values, 1, 4);
+        CHECK(H.null_fraction == Approx(.25));
+        CHECK(H.selectivity_equal(std::string("foo")) == Approx(.5));
+        CHECK(H.selectivity_equal(std::string("baz")) == Approx(0));
+    }
+}
+
+TEST_CASE("Histogram estimator estimates", "[core][catalog][cardinality]")
+{
+    using Subproblem = SmallBitset;
+    /* Get Catalog and create new database to use for unit testing. */
+    Catalog::Clear();
+    Catalog &Cat = Catalog::Get();
+    auto &db = Cat.add_database(Cat.pool("db"));
+    Cat.set_database_in_use(db);
+    ColumnStatistics::Get().clear();
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    auto execute = [&](const std::string &sql) {
+        auto stmt = m::statement_from_string(diag, sql);
+        M_insist(diag.num_errors() == 0);
+        execute_statement(diag, *stmt);
+    };
+
+    /* Create tables `A` with 10 rows and `B` with 20 rows, each row of `B` referencing a row of `A`. */
+    execute("CREATE TABLE A (id INT(4));");
+    execute("CREATE TABLE B (id INT(4), aid INT(4));");
+    for (int i = 0; i != 10; ++i)
+        execute("INSERT INTO A VALUES (" + std::to_string(i) + ");");
+    for (int i = 0; i != 20; ++i)
+        execute("INSERT INTO B VALUES (" + std::to_string(i) + ", " + std::to_string(i % 10) + ");");
+    ColumnStatistics::Get().analyze(db.name, db.get_table(Cat.pool("A")));
+    ColumnStatistics::Get().analyze(db.name, db.get_table(Cat.pool("B")));
+
+    const char *query = "SELECT * FROM A, B WHERE A.id < 5 AND A.id = B.aid;";
+    auto S = m::statement_from_string(diag, query);
+    M_insist(diag.num_errors() == 0);
+    auto G = QueryGraph::Build(*S);
+    HistogramEstimator HE(Cat.pool("db"));
+
+    auto scan_A = HE.estimate_scan(*G, Subproblem::Singleton(0));
+    auto scan_B = HE.estimate_scan(*G, Subproblem::Singleton(1));
+
+    SECTION("estimate_scan")
+    {
+        CHECK(HE.predict_cardinality(*scan_A) == 10);
+        CHECK(HE.predict_cardinality(*scan_B) == 20);
+    }
+
+    SECTION("estimate_filter")
+    {
+        auto filter_A = HE.estimate_filter(*G, *scan_A, G->sources()[0]->filter());
+        CHECK(HE.predict_cardinality(*filter_A) == 5);
+    }
+
+    SECTION("estimate_join")
+    {
+        auto join_model = HE.estimate_join(*G, *scan_A, *scan_B, G->joins()[0]->condition());
+        CHECK(HE.predict_cardinality(*join_model) == 20);
+    }
+
+    ColumnStatistics::Get().clear();
+}
@@ -63,6 +63,40 @@ TEST_CASE("ColumnStore", "[core][storage][columnstore]")
         REQUIRE(store.num_rows() == 2);
     }
 
+    SECTION("append batch")
+    {
+        REQUIRE(store.append(3) == 0);
+        REQUIRE(store.num_rows() == 3);
+        REQUIRE(store.append(2) == 3);
+        REQUIRE(store.num_rows() == 5);
+    }
+
+    SECTION("write_column")
+    {
+        const std::size_t first_row = store.append(4);
+        const int32_t values[] = { 1, -2, 3, -4 };
+        const uint8_t is_null = 0b0100;
+        store.write_column(i4.id, first_row, 4, values, &is_null);
+        const uint8_t bits = 0b1010;
+        store.write_column(b1.id, first_row, 4, &bits);
+
+        auto column = reinterpret_cast<const int32_t*>(store.memory(i4.id));
+        for (std::size_t i = 0; i != 4; ++i)
+            CHECK(column[i] == values[i]);
+        auto bool_column = reinterpret_cast<const uint8_t*>(store.memory(b1.id));
+        CHECK((bool_column[0] & 0b1111) == bits);
+
+        auto null_bitmap = reinterpret_cast<const uint8_t*>(store.memory(table.num_attrs()));
+        auto is_null_bit = [&](std::size_t row, std::size_t attr_id) {
+            const std::size_t idx = row * table.num_attrs() + attr_id;
+            return bool(null_bitmap[idx / 8] >> (idx % 8) & 1U);
+        };
+        for (std::size_t i = 0; i != 4; ++i) {
+            CHECK(is_null_bit(i, i4.id) == (i == 2));
+            CHECK_FALSE(is_null_bit(i, b1.id));
+        }
+    }
+
     SECTION("drop")
     {
         store.append();
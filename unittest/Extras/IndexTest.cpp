@@ -5,6 +5,8 @@
 #include <mutable/storage/Index.hpp>
 #include <mutable/util/concepts.hpp>
 #include <mutable/util/Diagnostic.hpp>
+#include "storage/CompositeKey.hpp"
+#include "storage/IndexMaintenance.hpp"
 #include "storage/PaxStore.hpp"
 
 
@@ -119,3 +121,137 @@ TEMPLATE_TEST_CASE("ArrayIndex::bulkload() with Numeric types", "[core][storage]
     /* Index should not contain NULL. */
     REQUIRE(idx.num_entries() == keys.size());
 }
+
+TEST_CASE("ArrayIndex::bulkload() with composite keys", "[core][storage][index]")
+{
+    Catalog::Clear();
+    Diagnostic diag(false, std::cout, std::cerr);
+
+    /* Create and use a DB. */
+    Catalog &C = Catalog::Get();
+    ThreadSafePooledString db_name = C.pool("db");
+    auto &DB = C.add_database(db_name);
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("t"));
+
+    /* Create a table with two attributes. */
+    table.push_back(C.pool("tenant_id"), Type::Get_Integer(Type::TY_Vector, 2));
+    table.push_back(C.pool("ts"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.layout(C.data_layout());
+    table.store(C.create_store(table));
+
+    auto insert_stmt = statement_from_string(diag,
+                                             "INSERT INTO t VALUES (2, 10), (1, 30), (2, -5), (1, NULL), (1, 20);");
+    execute_statement(diag, *insert_stmt);
+
+    /* Bulkload index from table. */
+    ArrayIndex<int64_t> idx;
+    idx.bulkload(table, table.schema());
+    REQUIRE(idx.finalized());
+
+    /* Index should not contain tuples with NULL. */
+    REQUIRE(idx.num_entries() == 4);
+
+    /* Check lexicographic order of entries. */
+    const std::vector<std::size_t> expected = { 4, 1, 2, 0 };
+    REQUIRE(std::equal(idx.begin(), idx.end(), expected.begin(), expected.end(),
+                       [](const auto &entry, std::size_t tuple_id) { return entry.second == tuple_id; }));
+
+    CompositeKey key(table.schema());
+
+    SECTION("full key")
+    {
+        auto it = idx.lower_bound(key.pack({ 1, 30 }));
+        REQUIRE(it->second == 1);
+    }
+
+    SECTION("prefix")
+    {
+        REQUIRE(idx.lower_bound(key.lower({ 2 })) - idx.begin() == 2);
+        REQUIRE(idx.upper_bound(key.upper({ 2 })) == idx.end());
+    }
+
+    SECTION("range on last attribute")
+    {
+        auto begin = idx.lower_bound(key.lower({ 1, 25 }));
+        auto end = idx.upper_bound(key.upper({ 2, 0 }));
+        REQUIRE(end - begin == 2);
+        REQUIRE(begin->second == 1);
+    }
+}
+
+TEMPLATE_TEST_CASE("append_rows()", "[core][storage][index]", ArrayIndex<int32_t>, RecursiveModelIndex<int32_t>)
+{
+    Catalog::Clear();
+    Diagnostic diag(false, std::cout, std::cerr);
+
+    /* Create and use a DB. */
+    Catalog &C = Catalog::Get();
+    ThreadSafePooledString db_name = C.pool("db");
+    auto &DB = C.add_database(db_name);
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("t"));
+
+    /* Create a table with a single attribute. */
+    table.push_back(C.pool("val"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.layout(C.data_layout());
+    table.store(C.create_store(table));
+
+    auto insert_stmt = statement_from_string(diag, "INSERT INTO t VALUES (5), (1), (NULL);");
+    execute_statement(diag, *insert_stmt);
+
+    /* Bulkload index from table. */
+    TestType idx;
+    idx.bulkload(table, table.schema());
+    REQUIRE(idx.num_entries() == 2);
+
+    /* Append rows and add them to the index. */
+    insert_stmt = statement_from_string(diag, "INSERT INTO t VALUES (3), (NULL), (7);");
+    execute_statement(diag, *insert_stmt);
+    REQUIRE(append_rows(idx, table, table.schema(), 3));
+    REQUIRE(idx.finalized());
+
+    /* Index should contain the keys of all rows without NULL in sorted order. */
+    REQUIRE(idx.num_entries() == 4);
+    const std::vector<std::size_t> expected = { 1, 3, 0, 5 };
+    REQUIRE(std::equal(idx.begin(), idx.end(), expected.begin(), expected.end(),
+                       [](const auto &entry, std::size_t tuple_id) { return entry.second == tuple_id; }));
+    for (int32_t key : { 1, 3, 5, 7 })
+        REQUIRE(idx.lower_bound(key)->first == key);
+}
+
+TEST_CASE("CompositeKey", "[core][storage][index]")
+{
+    Catalog &C = Catalog::Get();
+
+    SECTION("keys order lexicographically")
+    {
+        Schema S;
+        S.add(C.pool("a"), Type::Get_Integer(Type::TY_Vector, 2));
+        S.add(C.pool("b"), Type::Get_Integer(Type::TY_Vector, 4));
+        CompositeKey key(S);
+        REQUIRE(key.num_attributes() == 2);
+
+        REQUIRE(key.pack({ -5, 3 }) < key.pack({ -5, 100 }));
+        REQUIRE(key.pack({ -5, 100 }) < key.pack({ 0, -2147483648L }));
+        REQUIRE(key.pack({ 0, 2147483647L }) < key.pack({ 7, -1 }));
+        REQUIRE(key.lower({ 7 }) <= key.pack({ 7, -2147483648L }));
+        REQUIRE(key.upper({ 7 }) >= key.pack({ 7, 2147483647L }));
+        REQUIRE(key.upper({ 6 }) < key.lower({ 7 }));
+    }
+
+    SECTION("keys must fit into 64 bits")
+    {
+        Schema S;
+        S.add(C.pool("a"), Type::Get_Integer(Type::TY_Vector, 8));
+        S.add(C.pool("b"), Type::Get_Integer(Type::TY_Vector, 1));
+        REQUIRE_THROWS_AS(CompositeKey(S), invalid_argument);
+    }
+
+    SECTION("floating-point attributes are not supported")
+    {
+        Schema S;
+        S.add(C.pool("a"), Type::Get_Double(Type::TY_Vector));
+        REQUIRE_THROWS_AS(CompositeKey(S), invalid_argument);
+    }
+}
@@ -0,0 +1,101 @@
+#include "catch2/catch.hpp"
+
+#include "catalog/LayoutAdvisor.hpp"
+#include <iostream>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/mutable.hpp>
+#include <sstream>
+#include <string>
+
+
+using namespace m;
+
+
+TEST_CASE("LayoutAdvisor", "[core][catalog][unit]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+    Diagnostic diag(false, std::cout, std::cerr);
+    LayoutAdvisor &A = LayoutAdvisor::Get();
+    A.clear();
+
+    /* Create a table of eight 4-byte integer attributes `a0` to `a7`. */
+    auto &DB = C.add_database(C.pool("LayoutAdvisor_DB"));
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("T"));
+    for (std::size_t i = 0; i != 8; ++i)
+        table.push_back(C.pool(("a" + std::to_string(i)).c_str()), Type::Get_Integer(Type::TY_Vector, 4));
+
+    auto record = [&](const char *query) {
+        auto stmt = m::statement_from_string(diag, query);
+        A.record(as<const ast::SelectStmt>(*stmt));
+    };
+
+    SECTION("no workload")
+    {
+        auto advice = A.advise(table);
+        CHECK_FALSE(advice.layout.has_value());
+        CHECK(advice.partitions.empty());
+    }
+
+    SECTION("narrow queries")
+    {
+        record("SELECT a0 FROM T WHERE a1 < 5;");
+        record("SELECT a1 FROM T WHERE a0 = 42;");
+
+        auto advice = A.advise(table);
+        REQUIRE(advice.layout.has_value());
+        CHECK(*advice.layout == C.pool("PAX4M"));
+        CHECK(advice.cost_row == Approx(256));
+        CHECK(advice.cost_pax == Approx(80));
+        CHECK(advice.cost_partitioned == Approx(72));
+
+        /* `a0` and `a1` are always accessed together. */
+        REQUIRE(advice.partitions.size() == 2);
+        CHECK(((advice.partitions[0] == std::vector<std::size_t>{ 0, 1 }) or
+               (advice.partitions[1] == std::vector<std::size_t>{ 0, 1 })));
+    }
+
+    SECTION("wide queries")
+    {
+        record("SELECT * FROM T;");
+        record("SELECT * FROM T WHERE a3 < 5;");
+
+        auto advice = A.advise(table);
+        REQUIRE(advice.layout.has_value());
+        CHECK(*advice.layout == C.pool("Row"));
+        CHECK(advice.cost_row == Approx(256));
+        CHECK(advice.cost_pax == Approx(320));
+        CHECK(advice.partitions.empty());
+    }
+
+    SECTION("nested queries")
+    {
+        record("SELECT a0 FROM T WHERE a1 = (SELECT MAX(a2) FROM T);");
+
+        auto advice = A.advise(table);
+        REQUIRE(advice.layout.has_value());
+        /* The outer and the nested query touch three attributes in total. */
+        CHECK(advice.cost_pax == Approx(120));
+    }
+
+    SECTION("report changes")
+    {
+        const char *query = "SELECT a0 FROM T;";
+        auto stmt = m::statement_from_string(diag, query);
+        auto &select = as<const ast::SelectStmt>(*stmt);
+        A.record(select);
+
+        std::ostringstream out;
+        A.report_changes(select, out);
+        CHECK(out.str().find("PAX4M") != std::string::npos);
+
+        /* Unchanged advice is not reported again. */
+        std::ostringstream out2;
+        A.report_changes(select, out2);
+        CHECK(out2.str().empty());
+    }
+
+    A.clear();
+}
@@ -0,0 +1,94 @@
+#include "catch2/catch.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "catalog/MaterializedViews.hpp"
+#include <map>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/util/Diagnostic.hpp>
+#include <sstream>
+#include <utility>
+
+
+using namespace m;
+
+
+namespace {
+
+/** Returns the rows of the view \p view of two integer columns as a map from the first to the second column. */
+std::map<int64_t, int64_t> read_view(const MaterializedView &view)
+{
+    auto &table = view.table();
+    auto loader = Interpreter::compile_load(table.schema(), table.store().memory().addr(), table.layout(),
+                                            table.schema());
+    std::map<int64_t, int64_t> rows;
+    Tuple tup(table.schema());
+    Tuple *args[] = { &tup };
+    for (std::size_t i = 0; i != table.store().num_rows(); ++i) {
+        loader(args);
+        rows.emplace(tup[0].as_i(), tup[1].as_i());
+    }
+    return rows;
+}
+
+}
+
+TEST_CASE("MaterializedView", "[core][catalog][unit]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("MaterializedView_DB"));
+    C.set_database_in_use(DB);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+    auto execute = [&](const char *sql) { execute_statement(diag, *statement_from_string(diag, sql)); };
+    auto create = [&](const char *name, const char *sql) -> const MaterializedView & {
+        auto stmt = statement_from_string(diag, sql);
+        return MaterializedViews::Get().create(DB, C.pool(name),
+                                               std::unique_ptr<ast::SelectStmt>(as<ast::SelectStmt>(stmt.release())));
+    };
+
+    execute("CREATE TABLE T ( c INT(4), x INT(4) );");
+    execute("INSERT INTO T VALUES (1, 10), (2, 20), (1, 5), (3, -1);");
+
+    SECTION("grouping")
+    {
+        auto &view = create("V", "SELECT c, SUM(x) FROM T WHERE x > 0 GROUP BY c;");
+        CHECK(view.num_groups() == 2);
+        CHECK(read_view(view) == std::map<int64_t, int64_t>{ { 1, 15 }, { 2, 20 } });
+
+        execute("INSERT INTO T VALUES (2, 1), (4, 7), (4, -3);");
+        CHECK(view.num_groups() == 3);
+        CHECK(read_view(view) == std::map<int64_t, int64_t>{ { 1, 15 }, { 2, 21 }, { 4, 7 } });
+    }
+
+    SECTION("aggregation")
+    {
+        auto &view = create("V", "SELECT COUNT(*), MAX(x) FROM T;");
+        REQUIRE(view.table().store().num_rows() == 1);
+        CHECK(read_view(view) == std::map<int64_t, int64_t>{ { 4, 20 } });
+
+        execute("INSERT INTO T VALUES (5, 42);");
+        REQUIRE(view.table().store().num_rows() == 1);
+        CHECK(read_view(view) == std::map<int64_t, int64_t>{ { 5, 42 } });
+    }
+
+    SECTION("unsupported queries")
+    {
+        CHECK_THROWS_AS(create("V", "SELECT c, x FROM T;"), m::invalid_argument);
+        CHECK_THROWS_AS(create("V", "SELECT c, SUM(x) FROM T GROUP BY c ORDER BY c;"), m::invalid_argument);
+        CHECK_FALSE(MaterializedViews::Get().contains(DB.name, C.pool("V")));
+    }
+
+    SECTION("drop")
+    {
+        create("V", "SELECT c, COUNT(*) FROM T GROUP BY c;");
+        REQUIRE(MaterializedViews::Get().contains(DB.name, C.pool("V")));
+        CHECK(MaterializedViews::Get().drop(DB, C.pool("V")));
+        CHECK_FALSE(MaterializedViews::Get().contains(DB.name, C.pool("V")));
+        CHECK_FALSE(MaterializedViews::Get().drop(DB, C.pool("V")));
+    }
+
+    MaterializedViews::Get().database_dropped(DB.name);
+}
@@ -0,0 +1,54 @@
+#include "catch2/catch.hpp"
+
+#include "catalog/NullFreeColumns.hpp"
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/util/Diagnostic.hpp>
+#include <sstream>
+
+
+using namespace m;
+
+
+TEST_CASE("NullFreeColumns", "[core][catalog][unit]")
+{
+    Catalog::Clear();
+    NullFreeColumns::Get().clear();
+    Catalog &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("NullFreeColumns_DB"));
+    C.set_database_in_use(DB);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+    auto execute = [&](const char *sql) { execute_statement(diag, *statement_from_string(diag, sql)); };
+
+    execute("CREATE TABLE T ( a INT(4), b INT(4), c INT(4) NOT NULL );");
+    execute("INSERT INTO T VALUES (1, 10, 0), (2, NULL, 0);");
+    auto &T = DB.get_table(C.pool("T"));
+    auto &NFC = NullFreeColumns::Get();
+
+    CHECK(NFC.null_free(DB.name, T, C.pool("a")));
+    CHECK_FALSE(NFC.null_free(DB.name, T, C.pool("b")));
+
+    SECTION("layout schema")
+    {
+        auto S = NFC.layout_schema(DB.name, T);
+        CHECK_FALSE(S[0].nullable());
+        CHECK(S[1].nullable());
+        CHECK_FALSE(S[2].nullable());
+    }
+
+    SECTION("appended NULL")
+    {
+        execute("INSERT INTO T VALUES (NULL, 30, 0);");
+        CHECK_FALSE(NFC.null_free(DB.name, T, C.pool("a")));
+        CHECK(NFC.layout_schema(DB.name, T)[0].nullable());
+    }
+
+    SECTION("scans omit no values")
+    {
+        execute("INSERT INTO T VALUES (3, NULL, 0);");
+        execute("SELECT a, b FROM T WHERE a > 1;");
+        CHECK(err.str().empty());
+    }
+}
@@ -2,10 +2,14 @@
 
 #include "storage/PaxStore.hpp"
 #include <mutable/catalog/Catalog.hpp>
+#include <mutable/io/Reader.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
 #include <mutable/storage/Store.hpp>
+#include <sstream>
 
 
 using namespace m;
+using namespace m::storage;
 
 
 TEST_CASE("PaxStore", "[core][storage][paxstore]")
@@ -115,3 +119,66 @@ TEST_CASE("PaxStore sanity checks", "[core][storage][columnstore]")
         REQUIRE_THROWS_AS(store.append(), std::logic_error);
     }
 }
+
+TEST_CASE("PaxStore synopses", "[core][storage][paxstore]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("test_db"));
+    auto &table = DB.add_table(C.pool("test"));
+
+    /* Construct a table definition. */
+    table.push_back(C.pool("i4"),    Type::Get_Integer(Type::TY_Vector, 4));
+    table.push_back(C.pool("d"),     Type::Get_Double(Type::TY_Vector));
+    table.push_back(C.pool("char3"), Type::Get_Char(Type::TY_Vector, 3));
+
+    table.store(std::make_unique<PaxStore>(table));
+    RowLayoutFactory layout;
+    table.layout(layout);
+    auto &store = as<const PaxStore>(table.store());
+
+    auto &i4 = table[C.pool("i4")];
+    auto &d = table[C.pool("d")];
+    auto &char3 = table[C.pool("char3")];
+
+    REQUIRE(store.has_synopses(i4));
+    REQUIRE(store.has_synopses(d));
+    REQUIRE_FALSE(store.has_synopses(char3));
+
+    /* Import two full PAX blocks and a partial one, s.t. `i4` is the row ID in descending order and `d` is NULL. */
+    const std::size_t num_rows_per_block = store.num_rows_per_block();
+    const std::size_t num_rows = 2 * num_rows_per_block + 3;
+    std::stringstream ss;
+    for (std::size_t i = 0; i != num_rows; ++i)
+        ss << (num_rows - 1 - i) << ",,abc\n";
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+    DSVReader::Config cfg;
+    DSVReader R(table, cfg, diag);
+    R(ss, "stringstream_in");
+    REQUIRE(diag.num_errors() == 0);
+    REQUIRE(store.num_rows() == num_rows);
+
+    SECTION("min and max")
+    {
+        auto &synopses = store.synopses(i4);
+        REQUIRE(synopses.size() == 3);
+        for (std::size_t block = 0; block != 3; ++block) {
+            const int64_t max = num_rows - 1 - block * num_rows_per_block;
+            const int64_t min = block == 2 ? 0 : max - (num_rows_per_block - 1);
+            CHECK(std::get<int64_t>(synopses[block].min) == min);
+            CHECK(std::get<int64_t>(synopses[block].max) == max);
+            CHECK(synopses[block].num_nulls == 0);
+        }
+    }
+
+    SECTION("only NULL")
+    {
+        auto &synopses = store.synopses(d);
+        REQUIRE(synopses.size() == 3);
+        CHECK(std::holds_alternative<std::monostate>(synopses[0].min));
+        CHECK(std::holds_alternative<std::monostate>(synopses[2].max));
+        CHECK(synopses[0].num_nulls == num_rows_per_block);
+        CHECK(synopses[2].num_nulls == 3);
+    }
+}
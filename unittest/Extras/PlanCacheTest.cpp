@@ -0,0 +1,62 @@
+#include "catch2/catch.hpp"
+
+#include "IR/PlanCache.hpp"
+#include <mutable/util/ADT.hpp>
+
+
+using namespace m;
+
+
+TEST_CASE("PlanCache", "[core][IR][unit]")
+{
+    auto &cache = PlanCache::Get();
+    cache.clear();
+
+    const Subproblem A(1UL), B(2UL), C(4UL);
+    const PlanCache::key_type key{ 42, 3, 7 };
+    const PlanCache::join_order_type join_order{ { A, B }, { A|B, C } };
+
+    SECTION("miss")
+    {
+        CHECK_FALSE(cache.find(key).has_value());
+    }
+
+    SECTION("hit")
+    {
+        cache.insert(key, join_order);
+        REQUIRE(cache.size() == 1);
+        auto found = cache.find(key);
+        REQUIRE(found.has_value());
+        CHECK(*found == join_order);
+        CHECK_FALSE(cache.find(PlanCache::key_type{ 42, 3, 8 }).has_value());
+    }
+
+    SECTION("overwrite")
+    {
+        cache.insert(key, join_order);
+        const PlanCache::join_order_type other{ { B, C }, { A, B|C } };
+        cache.insert(key, other);
+        REQUIRE(cache.size() == 1);
+        CHECK(*cache.find(key) == other);
+    }
+
+    SECTION("capacity")
+    {
+        for (uint64_t i = 0; i != PlanCache::CAPACITY; ++i)
+            cache.insert(PlanCache::key_type{ i }, join_order);
+        CHECK(cache.size() == PlanCache::CAPACITY);
+        cache.insert(key, join_order); // exceeds the capacity and clears the cache
+        CHECK(cache.size() == 1);
+        CHECK(cache.find(key).has_value());
+    }
+
+    SECTION("clear")
+    {
+        cache.insert(key, join_order);
+        cache.clear();
+        CHECK(cache.size() == 0);
+        CHECK_FALSE(cache.find(key).has_value());
+    }
+
+    cache.clear();
+}
@@ -239,6 +239,22 @@ WHERE A.id = C.aid AND A.id = D.aid AND B.id = D.bid AND C.id = D.cid;";
             REQUIRE(expected == plan_table);
         }
 
+        SECTION("DPsubPar")
+        {
+            make_entry(A, C);
+            make_entry(A, D);
+            make_entry(B, D);
+            make_entry(B, A|D);
+            make_entry(C, D);
+            make_entry(A|C, D);
+            make_entry(B, C|D);
+            make_entry(A|C, B|D);
+
+            auto &PE = Cat.plan_enumerator(Cat.pool("DPsubPar"));
+            PE(G, C_out, plan_table);
+            REQUIRE(expected == plan_table);
+        }
+
         SECTION("DPccp")
         {
             make_entry(C, A);
@@ -255,6 +271,23 @@ WHERE A.id = C.aid AND A.id = D.aid AND B.id = D.bid AND C.id = D.cid;";
             REQUIRE(expected == plan_table);
         }
 
+        SECTION("Adaptive")
+        {
+            /* The query graph is small enough for exhaustive enumeration by DPccp. */
+            make_entry(C, A);
+            make_entry(D, A);
+            make_entry(D, B);
+            make_entry(D, C);
+            make_entry(A|D, B);
+            make_entry(D, A|C);
+            make_entry(C|D, B);
+            make_entry(B|D, A|C);
+
+            auto &PE = Cat.plan_enumerator(Cat.pool("Adaptive"));
+            PE(G, C_out, plan_table);
+            REQUIRE(expected == plan_table);
+        }
+
         SECTION("TDbasic")
         {
             make_entry(A, C);
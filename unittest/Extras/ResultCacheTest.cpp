@@ -0,0 +1,139 @@
+#include "catch2/catch.hpp"
+
+#include "catalog/ResultCache.hpp"
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+using namespace m;
+
+
+TEST_CASE("ResultCache", "[core][catalog][unit]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+    auto &cache = ResultCache::Get();
+    cache.clear();
+    const std::size_t old_capacity = cache.capacity();
+    cache.capacity(1UL << 20);
+
+    auto &DB = C.add_database(C.pool("ResultCache_DB"));
+    auto &A = DB.add_table(C.pool("A"));
+    auto &B = DB.add_table(C.pool("B"));
+
+    Schema S;
+    S.add(C.pool("x"), Type::Get_Integer(Type::TY_Vector, 4));
+    auto make_rows = [&](std::size_t num_rows) {
+        std::vector<Tuple> rows;
+        for (std::size_t i = 0; i != num_rows; ++i) {
+            rows.emplace_back(S);
+            rows.back().set(0, int64_t(i));
+        }
+        return rows;
+    };
+
+    SECTION("miss")
+    {
+        const std::size_t num_misses = cache.num_misses();
+        CHECK(cache.find("q") == nullptr);
+        CHECK(cache.num_misses() == num_misses + 1);
+    }
+
+    SECTION("hit")
+    {
+        REQUIRE(cache.insert("q", S, make_rows(3), cache.versions({ &A })));
+        const std::size_t num_hits = cache.num_hits();
+        auto entry = cache.find("q");
+        REQUIRE(entry != nullptr);
+        CHECK(cache.num_hits() == num_hits + 1);
+        REQUIRE(entry->rows.size() == 3);
+        CHECK(entry->rows[2][0].as_i() == 2);
+        CHECK(entry->schema.num_entries() == 1);
+    }
+
+    SECTION("invalidate")
+    {
+        REQUIRE(cache.insert("qA", S, make_rows(1), cache.versions({ &A })));
+        REQUIRE(cache.insert("qAB", S, make_rows(1), cache.versions({ &A, &B })));
+        REQUIRE(cache.insert("qB", S, make_rows(1), cache.versions({ &B })));
+        cache.invalidate(A);
+        CHECK(cache.find("qA") == nullptr);
+        CHECK(cache.find("qAB") == nullptr);
+        CHECK(cache.find("qB") != nullptr);
+        CHECK(cache.size() == 1);
+    }
+
+    SECTION("modified during execution")
+    {
+        auto versions = cache.versions({ &A });
+        cache.invalidate(A);
+        CHECK_FALSE(cache.insert("q", S, make_rows(1), std::move(versions)));
+        CHECK(cache.size() == 0);
+
+        auto outdated = cache.versions({ &B });
+        cache.clear();
+        CHECK_FALSE(cache.insert("q", S, make_rows(1), std::move(outdated)));
+    }
+
+    SECTION("wait for concurrently computed result")
+    {
+        bool announced;
+        REQUIRE(cache.find_or_wait("q", announced) == nullptr);
+        REQUIRE(announced);
+
+        std::shared_ptr<const ResultCache::entry_type> shared;
+        bool waiter_announced = true;
+        std::thread waiter([&]() { shared = cache.find_or_wait("q", waiter_announced); });
+        REQUIRE(cache.insert("q", S, make_rows(3), cache.versions({ &A })));
+        waiter.join();
+        CHECK_FALSE(waiter_announced);
+        REQUIRE(shared != nullptr);
+        CHECK(shared->rows.size() == 3);
+    }
+
+    SECTION("abandon concurrently computed result")
+    {
+        bool announced;
+        REQUIRE(cache.find_or_wait("q", announced) == nullptr);
+        REQUIRE(announced);
+
+        std::shared_ptr<const ResultCache::entry_type> shared;
+        bool waiter_announced = true;
+        std::thread waiter([&]() { shared = cache.find_or_wait("q", waiter_announced); });
+        cache.abandon("q");
+        waiter.join();
+        CHECK(shared == nullptr); // the waiter computes the result itself
+        if (waiter_announced)
+            cache.abandon("q"); // the waiter started after the result was abandoned
+
+        /* The result is no longer announced, hence the next query computes it. */
+        REQUIRE(cache.find_or_wait("q", announced) == nullptr);
+        CHECK(announced);
+        cache.abandon("q");
+    }
+
+    SECTION("LRU eviction")
+    {
+        const std::size_t entry_size = 2 + 100 * ResultCache::Row_Size(S);
+        cache.capacity(2 * entry_size);
+        REQUIRE(cache.insert("q1", S, make_rows(100), cache.versions({ &A })));
+        REQUIRE(cache.insert("q2", S, make_rows(100), cache.versions({ &A })));
+        CHECK(cache.size_in_bytes() == 2 * entry_size);
+        REQUIRE(cache.find("q1") != nullptr); // q2 becomes the least recently used result
+        const std::size_t num_evictions = cache.num_evictions();
+        REQUIRE(cache.insert("q3", S, make_rows(100), cache.versions({ &A })));
+        CHECK(cache.num_evictions() == num_evictions + 1);
+        CHECK(cache.find("q1") != nullptr);
+        CHECK(cache.find("q2") == nullptr);
+        CHECK(cache.find("q3") != nullptr);
+
+        CHECK_FALSE(cache.insert("q4", S, make_rows(300), cache.versions({ &A }))); // exceeds the capacity
+        CHECK(cache.size() == 2);
+    }
+
+    cache.clear();
+    cache.capacity(old_capacity);
+}
@@ -0,0 +1,150 @@
+#include "catch2/catch.hpp"
+
+#include "catalog/SetOperations.hpp"
+#include <algorithm>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/util/exception.hpp>
+#include <optional>
+#include <utility>
+#include <vector>
+
+
+using namespace m;
+
+
+TEST_CASE("SetOperations::Parse", "[core][catalog][unit]")
+{
+    using SO = SetOperations;
+
+    SECTION("single query")
+    {
+        auto query = SO::Parse({ "SELECT", "*", "FROM", "A" });
+        REQUIRE(query.selects.size() == 1);
+        CHECK(query.selects[0] == "SELECT * FROM A ;");
+        CHECK(query.operators.empty());
+        CHECK(query.is_concatenation());
+    }
+
+    SECTION("operators")
+    {
+        auto query = SO::Parse({ "SELECT", "x", "FROM", "A", "union", "all", "SELECT", "x", "FROM", "B", "UNION",
+                                 "SELECT", "x", "FROM", "C", "INTERSECT", "SELECT", "x", "FROM", "D", "Except",
+                                 "SELECT", "x", "FROM", "E", "UNION", "DISTINCT", "SELECT", "x", "FROM", "F" });
+        REQUIRE(query.selects.size() == 6);
+        CHECK(query.selects[1] == "SELECT x FROM B ;");
+        CHECK(query.selects[5] == "SELECT x FROM F ;");
+        REQUIRE(query.operators.size() == 5);
+        CHECK(query.operators[0] == SO::UNION_ALL);
+        CHECK(query.operators[1] == SO::UNION);
+        CHECK(query.operators[2] == SO::INTERSECT);
+        CHECK(query.operators[3] == SO::EXCEPT);
+        CHECK(query.operators[4] == SO::UNION);
+        CHECK_FALSE(query.is_concatenation());
+    }
+
+    SECTION("operators in parentheses")
+    {
+        auto query = SO::Parse({ "SELECT", "x", "FROM", "(SELECT", "x", "FROM", "A", "UNION", "SELECT", "x", "FROM",
+                                 "B)", "AS", "T", "UNION", "ALL", "SELECT", "x", "FROM", "C" });
+        REQUIRE(query.selects.size() == 2);
+        CHECK(query.selects[0] == "SELECT x FROM (SELECT x FROM A UNION SELECT x FROM B) AS T ;");
+        CHECK(query.operators == std::vector<SO::set_operator>{ SO::UNION_ALL });
+    }
+
+    SECTION("errors")
+    {
+        CHECK_THROWS_AS(SO::Parse({ }), invalid_argument);
+        CHECK_THROWS_AS(SO::Parse({ "SELECT", "x", "FROM", "A", "UNION" }), invalid_argument);
+        CHECK_THROWS_AS(SO::Parse({ "UNION", "ALL", "SELECT", "x", "FROM", "A" }), invalid_argument);
+        CHECK_THROWS_AS(SO::Parse({ "SELECT", "x", "FROM", "A", "INTERSECT", "ALL", "SELECT", "x", "FROM", "B" }),
+                        invalid_argument);
+    }
+}
+
+TEST_CASE("SetOperations::Combine", "[core][catalog][unit]")
+{
+    using SO = SetOperations;
+    Catalog &C = Catalog::Get();
+
+    Schema S;
+    S.add(C.pool("x"), Type::Get_Integer(Type::TY_Vector, 4));
+    /* Creates rows of the values `xs`, where `std::nullopt` is `NULL`. */
+    auto make_rows = [&](std::vector<std::optional<int64_t>> xs) {
+        std::vector<Tuple> rows;
+        for (auto x : xs) {
+            rows.emplace_back(S);
+            if (x)
+                rows.back().set(0, *x);
+        }
+        return rows;
+    };
+    /* Returns the values of `rows` in ascending order, `NULL` as -1. */
+    auto values = [](const std::vector<Tuple> &rows) {
+        std::vector<int64_t> xs;
+        for (auto &row : rows)
+            xs.push_back(row.is_null(0) ? -1 : row[0].as_i());
+        std::sort(xs.begin(), xs.end());
+        return xs;
+    };
+    auto combine = [&](std::vector<std::vector<Tuple>> results, std::vector<SO::set_operator> operators) {
+        return values(SO::Combine(S, std::move(results), operators));
+    };
+
+    SECTION("UNION ALL")
+    {
+        auto rows = combine({ make_rows({ 1, 2 }), make_rows({ 2, std::nullopt }), make_rows({ }) },
+                            { SO::UNION_ALL, SO::UNION_ALL });
+        CHECK(rows == std::vector<int64_t>{ -1, 1, 2, 2 });
+    }
+
+    SECTION("UNION")
+    {
+        auto rows = combine({ make_rows({ 1, 1, std::nullopt }), make_rows({ 2, 1, std::nullopt }) }, { SO::UNION });
+        CHECK(rows == std::vector<int64_t>{ -1, 1, 2 });
+    }
+
+    SECTION("INTERSECT")
+    {
+        auto rows = combine({ make_rows({ 1, 1, 2, 3, std::nullopt }), make_rows({ 3, 1, std::nullopt }) },
+                            { SO::INTERSECT });
+        CHECK(rows == std::vector<int64_t>{ -1, 1, 3 });
+    }
+
+    SECTION("EXCEPT")
+    {
+        auto rows = combine({ make_rows({ 1, 1, 2, 3, std::nullopt }), make_rows({ 3, std::nullopt }) },
+                            { SO::EXCEPT });
+        CHECK(rows == std::vector<int64_t>{ 1, 2 });
+    }
+
+    SECTION("INTERSECT binds tighter")
+    {
+        /* {1, 2} UNION ALL ({2, 3} INTERSECT {3}) */
+        auto rows = combine({ make_rows({ 1, 2 }), make_rows({ 2, 3 }), make_rows({ 3 }) },
+                            { SO::UNION_ALL, SO::INTERSECT });
+        CHECK(rows == std::vector<int64_t>{ 1, 2, 3 });
+    }
+
+    SECTION("left to right")
+    {
+        /* ({1, 2, 3} EXCEPT {2}) UNION ALL {3} */
+        auto rows = combine({ make_rows({ 1, 2, 3 }), make_rows({ 2 }), make_rows({ 3 }) },
+                            { SO::EXCEPT, SO::UNION_ALL });
+        CHECK(rows == std::vector<int64_t>{ 1, 3, 3 });
+    }
+}
+
+TEST_CASE("SetOperations::Is_Compatible", "[core][catalog][unit]")
+{
+    using types = std::vector<const Type*>;
+    auto i4 = Type::Get_Integer(Type::TY_Vector, 4);
+    auto i4_scalar = Type::Get_Integer(Type::TY_Scalar, 4);
+    auto i8 = Type::Get_Integer(Type::TY_Vector, 8);
+
+    CHECK(SetOperations::Is_Compatible(types{ i4 }, types{ i4 }));
+    CHECK(SetOperations::Is_Compatible(types{ i4 }, types{ i4_scalar }));
+    CHECK(SetOperations::Is_Compatible(types{ }, types{ }));
+    CHECK_FALSE(SetOperations::Is_Compatible(types{ i4 }, types{ i8 }));
+    CHECK_FALSE(SetOperations::Is_Compatible(types{ i4 }, types{ i4, i4 }));
+}
@@ -3,6 +3,7 @@
 #include "storage/ColumnStore.hpp"
 #include "storage/PaxStore.hpp"
 #include "storage/RowStore.hpp"
+#include "storage/Store.hpp"
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/storage/Store.hpp>
@@ -50,3 +51,56 @@ TEST_CASE("Store", "[core][storage]")
         TEST(PaxStore);
     }
 }
+
+TEST_CASE("Store/memory_of_rows", "[core][storage]")
+{
+    Catalog &C = Catalog::Get();
+    ConcreteTable table(C.pool("mytable"));
+    table.push_back(C.pool("i4"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.push_back(C.pool("i1"), Type::Get_Integer(Type::TY_Vector, 1));
+
+    SECTION("empty range")
+    {
+        RowStore store(table);
+        CHECK(memory_of_rows(store, 42, 42).empty());
+    }
+
+    SECTION("RowStore")
+    {
+        RowStore store(table);
+        const std::size_t row_size = store.row_size() / 8;
+        auto ranges = memory_of_rows(store, 10, 20);
+        REQUIRE(ranges.size() == 1);
+        CHECK(ranges[0].first == reinterpret_cast<const uint8_t*>(store.memory().addr()) + 10 * row_size);
+        CHECK(ranges[0].second == 10 * row_size);
+    }
+
+    SECTION("ColumnStore")
+    {
+        ColumnStore store(table);
+        auto ranges = memory_of_rows(store, 8, 16);
+        REQUIRE(ranges.size() == 3); // two columns and the NULL bitmap
+        CHECK(ranges[0].first == reinterpret_cast<const uint8_t*>(store.memory(0)) + 8 * 4);
+        CHECK(ranges[0].second == 8 * 4);
+        CHECK(ranges[1].first == reinterpret_cast<const uint8_t*>(store.memory(1)) + 8);
+        CHECK(ranges[1].second == 8);
+        CHECK(ranges[2].first == reinterpret_cast<const uint8_t*>(store.memory(2)) + 2);
+        CHECK(ranges[2].second == 2);
+    }
+
+    SECTION("PaxStore covers whole blocks")
+    {
+        PaxStore store(table);
+        const std::size_t n = store.num_rows_per_block();
+        auto ranges = memory_of_rows(store, n + 1, 2 * n + 1);
+        REQUIRE(ranges.size() == 1);
+        CHECK(ranges[0].first == reinterpret_cast<const uint8_t*>(store.memory().addr()) + store.block_size());
+        CHECK(ranges[0].second == 2 * store.block_size());
+    }
+
+    SECTION("unknown store")
+    {
+        TestStore store(table);
+        CHECK(memory_of_rows(store, 0, 10).empty());
+    }
+}
@@ -4,7 +4,9 @@
 #include "storage/store_manip.hpp"
 #include <mutable/catalog/Catalog.hpp>
 #include <set>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 
 using namespace m;
@@ -263,6 +265,24 @@ TEST_CASE("Store Data Manipulation", "[core][storage][store_manip]")
                 distinct_values_set.insert(*ptr);
             REQUIRE(distinct_values_set.size() == NUM_DISTINCT_VALUES);
         }
+
+        SECTION("INT(4), multiple chunks")
+        {
+            auto &attr = table.at(C.pool("i4"));
+            const std::size_t num_rows = (1UL << 18) + 3;
+            std::vector<int32_t> attr_column(num_rows);
+
+            generate_column_data(attr_column.data(), attr, NUM_DISTINCT_VALUES, 0, num_rows);
+
+            std::unordered_map<int32_t, std::size_t> value_counts;
+            for (auto v : attr_column)
+                ++value_counts[v];
+            REQUIRE(value_counts.size() == NUM_DISTINCT_VALUES);
+            for (auto &[_, count] : value_counts) {
+                CHECK(count >= num_rows / NUM_DISTINCT_VALUES);
+                CHECK(count <= num_rows / NUM_DISTINCT_VALUES + 1);
+            }
+        }
     }
 
     SECTION("generate_correlated_column_data")
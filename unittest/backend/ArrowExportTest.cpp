@@ -0,0 +1,115 @@
+#include "catch2/catch.hpp"
+
+#include "backend/ArrowExport.hpp"
+#include <cstring>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
+#include <string>
+#include <vector>
+
+
+using namespace m;
+using namespace m::storage;
+using namespace m::wasm;
+
+
+TEST_CASE("export_result_set_to_arrow", "[core][backend][arrow]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+
+    Schema S;
+    S.add(C.pool("a"), Type::Get_Integer(Type::TY_Vector, 8));
+    S.add(C.pool("b"), Type::Get_Double(Type::TY_Vector));
+    S.add(C.pool("d"), Type::Get_Date(Type::TY_Vector));
+
+    /* Mirror the PAX blocks of four tuples created by our standard PAX layout factory. */
+    constexpr std::size_t NUM_TUPLES_PER_BLOCK = 4;
+    struct Block
+    {
+        int64_t a[NUM_TUPLES_PER_BLOCK];
+        double b[NUM_TUPLES_PER_BLOCK];
+        int32_t d[NUM_TUPLES_PER_BLOCK];
+        uint8_t is_null[NUM_TUPLES_PER_BLOCK]; // bit i is set iff attribute i is NULL
+    };
+    PAXLayoutFactory factory(PAXLayoutFactory::NTuples, NUM_TUPLES_PER_BLOCK);
+    auto layout = factory.make(S);
+
+    constexpr int32_t DATE_1970_01_01 = (1970 << 9) | (1 << 5) | 1;
+    constexpr int32_t DATE_2020_03_15 = (2020 << 9) | (3 << 5) | 15;
+    Block blocks[2];
+    std::memset(blocks, 0, sizeof(blocks));
+    for (std::size_t i = 0; i != 6; ++i) {
+        auto &block = blocks[i / NUM_TUPLES_PER_BLOCK];
+        block.a[i % NUM_TUPLES_PER_BLOCK] = 10 * i;
+        block.b[i % NUM_TUPLES_PER_BLOCK] = 0.5 * i;
+        block.d[i % NUM_TUPLES_PER_BLOCK] = i % 2 ? DATE_2020_03_15 : DATE_1970_01_01;
+    }
+    blocks[0].is_null[1] = 0b010; // b of tuple 1 is NULL
+    const auto data = reinterpret_cast<const uint8_t*>(blocks);
+
+    struct batch_t
+    {
+        int64_t length;
+        std::vector<std::string> formats, names;
+        std::vector<int64_t> null_counts;
+        std::vector<const void*> validity, values;
+        std::vector<uint8_t> validity_b;
+        std::vector<int32_t> days;
+    };
+    std::vector<batch_t> batches;
+    auto callback = [&](ArrowSchema &schema, ArrowArray &array) {
+        REQUIRE(std::string(schema.format) == "+s");
+        REQUIRE(schema.n_children == array.n_children);
+        auto &batch = batches.emplace_back();
+        batch.length = array.length;
+        for (int64_t i = 0; i != schema.n_children; ++i) {
+            batch.formats.emplace_back(schema.children[i]->format);
+            batch.names.emplace_back(schema.children[i]->name);
+            batch.null_counts.push_back(array.children[i]->null_count);
+            batch.validity.push_back(array.children[i]->buffers[0]);
+            batch.values.push_back(array.children[i]->buffers[1]);
+        }
+        if (auto validity = static_cast<const uint8_t*>(array.children[1]->buffers[0]))
+            batch.validity_b.push_back(*validity); // copy since only valid during callback
+        auto days = static_cast<const int32_t*>(array.children[2]->buffers[1]);
+        batch.days.assign(days, days + array.length); // copy since only valid during callback
+    };
+
+    std::vector<const ast::Constant*> constants(S.num_entries(), nullptr);
+    export_result_set_to_arrow(S, S, &layout, data, 6, constants, callback);
+
+    REQUIRE(batches.size() == 2);
+    CHECK(batches[0].length == 4);
+    CHECK(batches[1].length == 2);
+    for (auto &batch : batches) {
+        CHECK(batch.formats == std::vector<std::string>{ "l", "g", "tdD" });
+        CHECK(batch.names == std::vector<std::string>{ "a", "b", "d" });
+    }
+
+    SECTION("zero copy")
+    {
+        for (std::size_t i = 0; i != 2; ++i) {
+            CHECK(batches[i].values[0] == blocks[i].a);
+            CHECK(batches[i].values[1] == blocks[i].b);
+            CHECK(batches[i].values[2] != blocks[i].d); // dates are converted
+        }
+    }
+
+    SECTION("validity")
+    {
+        CHECK(batches[0].null_counts == std::vector<int64_t>{ 0, 1, 0 });
+        CHECK(batches[0].validity[0] == nullptr);
+        CHECK(batches[0].validity[2] == nullptr);
+        REQUIRE(batches[0].validity_b.size() == 1);
+        CHECK((batches[0].validity_b[0] & 0b1111) == 0b1101);
+        CHECK(batches[1].null_counts == std::vector<int64_t>{ 0, 0, 0 });
+        CHECK(batches[1].validity[1] == nullptr);
+    }
+
+    SECTION("dates")
+    {
+        CHECK(batches[0].days == std::vector<int32_t>{ 0, 18336, 0, 18336 });
+        CHECK(batches[1].days == std::vector<int32_t>{ 0, 18336 });
+    }
+}
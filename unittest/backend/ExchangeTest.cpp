@@ -0,0 +1,131 @@
+#include "catch2/catch.hpp"
+
+#include "backend/Exchange.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+
+using namespace m;
+
+
+namespace {
+
+/** Runs \p num_producers producers, each pushing the values `[p * num_values, (p + 1) * num_values)`, and returns the
+ * values received by each consumer. */
+template<exchange_kind Kind>
+std::vector<std::vector<std::size_t>> run(Exchange<std::size_t, Kind> &exchange, std::size_t num_values)
+{
+    std::vector<std::thread> producers;
+    for (std::size_t p = 0; p != exchange.num_producers(); ++p) {
+        producers.emplace_back([&exchange, p, num_values]() {
+            auto producer = exchange.producer(p);
+            for (std::size_t i = p * num_values; i != (p + 1) * num_values; ++i)
+                producer.push(i, /* hash= */ i);
+            producer.finish();
+        });
+    }
+
+    std::vector<std::vector<std::size_t>> received(exchange.num_consumers());
+    std::vector<std::thread> consumers;
+    for (std::size_t c = 0; c != exchange.num_consumers(); ++c) {
+        consumers.emplace_back([&exchange, &received, c]() {
+            while (auto batch = exchange.receive(c)) {
+                REQUIRE(batch->size() <= exchange.batch_size());
+                received[c].insert(received[c].end(), batch->begin(), batch->end());
+            }
+        });
+    }
+
+    for (auto &t : producers) t.join();
+    for (auto &t : consumers) t.join();
+    return received;
+}
+
+}
+
+TEST_CASE("SpscQueue", "[core][backend][exchange]")
+{
+    SpscQueue<int> queue(2);
+    CHECK_FALSE(queue.try_pop());
+
+    int one = 1, two = 2, three = 3;
+    CHECK(queue.try_push(one));
+    CHECK(queue.try_push(two));
+    CHECK_FALSE(queue.try_push(three)); // full
+    CHECK(three == 3);
+
+    CHECK(queue.try_pop() == 1);
+    CHECK(queue.try_push(three));
+    CHECK(queue.try_pop() == 2);
+    CHECK(queue.try_pop() == 3);
+    CHECK_FALSE(queue.try_pop());
+}
+
+TEST_CASE("Exchange", "[core][backend][exchange]")
+{
+    constexpr std::size_t NUM_VALUES = 10'000;
+    std::vector<std::size_t> expected(3 * NUM_VALUES);
+    std::iota(expected.begin(), expected.end(), 0);
+
+    SECTION("repartition")
+    {
+        Exchange<std::size_t, E_Repartition> exchange(3, 4, /* batch_size= */ 64, /* queue_capacity= */ 2);
+        auto received = run(exchange, NUM_VALUES);
+        std::vector<std::size_t> all;
+        for (std::size_t c = 0; c != received.size(); ++c) {
+            for (auto v : received[c])
+                CHECK(v % 4 == c); // every value at the consumer chosen by its hash
+            all.insert(all.end(), received[c].begin(), received[c].end());
+        }
+        std::sort(all.begin(), all.end());
+        CHECK(all == expected);
+    }
+
+    SECTION("broadcast")
+    {
+        Exchange<std::size_t, E_Broadcast> exchange(3, 2, /* batch_size= */ 100);
+        auto received = run(exchange, NUM_VALUES);
+        for (auto &values : received) {
+            std::sort(values.begin(), values.end());
+            CHECK(values == expected);
+        }
+    }
+
+    SECTION("round robin")
+    {
+        Exchange<std::size_t, E_RoundRobin> exchange(3, 2, /* batch_size= */ 100);
+        auto received = run(exchange, NUM_VALUES);
+        CHECK_FALSE(received[0].empty());
+        CHECK_FALSE(received[1].empty());
+        std::vector<std::size_t> all(received[0]);
+        all.insert(all.end(), received[1].begin(), received[1].end());
+        std::sort(all.begin(), all.end());
+        CHECK(all == expected);
+    }
+
+    SECTION("gather retains the order of each producer")
+    {
+        Exchange<std::size_t, E_RoundRobin> exchange(3, 1, /* batch_size= */ 7);
+        auto received = run(exchange, NUM_VALUES);
+        std::vector<std::size_t> last(3, 0);
+        for (auto v : received[0]) {
+            const std::size_t p = v / NUM_VALUES;
+            CHECK(v >= last[p]);
+            last[p] = v;
+        }
+        CHECK(received[0].size() == expected.size());
+    }
+
+    SECTION("cancel")
+    {
+        Exchange<std::size_t, E_RoundRobin> exchange(1, 1, /* batch_size= */ 1, /* queue_capacity= */ 1);
+        auto producer = exchange.producer(0);
+        producer.push(0); // fills the queue
+        exchange.cancel();
+        CHECK_THROWS_AS(producer.push(1), exchange_cancelled);
+        CHECK_FALSE(exchange.receive(0));
+    }
+}
@@ -1,5 +1,6 @@
 #include "catch2/catch.hpp"
 
+#include "backend/Interpreter.hpp"
 #include "storage/RowStore.hpp"
 #include "storage/ColumnStore.hpp"
 #include "storage/PaxStore.hpp"
@@ -1107,3 +1108,94 @@ TEST_CASE("PaxStore/access", "[core][backend]")
         REQUIRE(num_tuples == 30);
     }
 }
+
+/*======================================================================================================================
+ * Block.
+ *====================================================================================================================*/
+
+TEST_CASE("Block/multi-word mask", "[core][backend]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+
+    Schema S;
+    S.add(C.pool("a"), Type::Get_Integer(Type::TY_Vector, 4));
+
+    Block<200> block(S, 130);
+    REQUIRE(block.capacity() == 130);
+    REQUIRE(block.empty());
+
+    SECTION("fill")
+    {
+        block.fill();
+        CHECK(block.size() == 130);
+        CHECK(block.alive(0));
+        CHECK(block.alive(129));
+
+        block.fill(70);
+        CHECK(block.size() == 70);
+        CHECK(block.alive(63));
+        CHECK(block.alive(64));
+        CHECK(block.alive(69));
+        CHECK_FALSE(block.alive(70));
+    }
+
+    SECTION("iterate across words")
+    {
+        block.fill(130);
+        for (std::size_t i = 1; i != 130; ++i) {
+            if (i != 63 and i != 64 and i != 128)
+                block.erase(i);
+        }
+        REQUIRE(block.size() == 3);
+
+        std::vector<std::size_t> indices;
+        for (auto it = block.begin(); it != block.end(); ++it)
+            indices.push_back(it.index());
+        CHECK(indices == std::vector<std::size_t>{ 63, 64, 128 });
+
+        auto it = block.at(64);
+        REQUIRE(it != block.end());
+        CHECK(it.index() == 64);
+
+        block.erase(63);
+        block.erase(64);
+        block.erase(128);
+        CHECK(block.empty());
+        CHECK(block.begin() == block.end());
+    }
+}
+
+TEST_CASE("Block/capacity below the maximum", "[core][backend]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+
+    Schema S;
+    S.add(C.pool("a"), Type::Get_Integer(Type::TY_Vector, 4));
+
+    Block<2048> block(S, 64);
+    REQUIRE(block.capacity() == 64);
+    REQUIRE(block.empty());
+    REQUIRE(block.begin() == block.end());
+
+    block.fill();
+    CHECK(block.size() == 64);
+    block.erase(0);
+    block.erase(63);
+
+    std::size_t num_alive = 0;
+    for (auto it = block.cbegin(); it != block.cend(); ++it)
+        ++num_alive;
+    CHECK(num_alive == 62);
+
+    Block<2048> copy(S, 64);
+    copy.mask(block.mask());
+    CHECK(copy.size() == 62);
+    CHECK_FALSE(copy.alive(0));
+    CHECK(copy.alive(1));
+
+    block.clear();
+    CHECK(block.empty());
+    CHECK(block.begin() == block.end());
+}
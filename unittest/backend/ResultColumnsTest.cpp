@@ -0,0 +1,129 @@
+#include "catch2/catch.hpp"
+
+#include "backend/ResultColumns.hpp"
+#include "backend/ResultWriter.hpp"
+#include <cstring>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
+#include <sstream>
+#include <vector>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+namespace {
+
+template<typename T>
+T read(const uint8_t *p)
+{
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+}
+
+TEST_CASE("ResultSetDecoder", "[core][backend]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+
+    Schema S;
+    S.add(C.pool("a"), Type::Get_Integer(Type::TY_Vector, 8));
+    S.add(C.pool("b"), Type::Get_Double(Type::TY_Vector));
+    S.add(C.pool("d"), Type::Get_Date(Type::TY_Vector));
+
+    /* Mirror the PAX blocks of four tuples created by our standard PAX layout factory. */
+    constexpr std::size_t NUM_TUPLES_PER_BLOCK = 4;
+    struct Block
+    {
+        int64_t a[NUM_TUPLES_PER_BLOCK];
+        double b[NUM_TUPLES_PER_BLOCK];
+        int32_t d[NUM_TUPLES_PER_BLOCK];
+        uint8_t is_null[NUM_TUPLES_PER_BLOCK]; // bit i is set iff attribute i is NULL
+    };
+    PAXLayoutFactory factory(PAXLayoutFactory::NTuples, NUM_TUPLES_PER_BLOCK);
+    auto layout = factory.make(S);
+
+    constexpr int32_t DATE_1970_01_01 = (1970 << 9) | (1 << 5) | 1;
+    constexpr int32_t DATE_2020_03_15 = (2020 << 9) | (3 << 5) | 15;
+    Block blocks[2];
+    std::memset(blocks, 0, sizeof(blocks));
+    for (std::size_t i = 0; i != 6; ++i) {
+        auto &block = blocks[i / NUM_TUPLES_PER_BLOCK];
+        block.a[i % NUM_TUPLES_PER_BLOCK] = 10 * i;
+        block.b[i % NUM_TUPLES_PER_BLOCK] = 0.5 * i;
+        block.d[i % NUM_TUPLES_PER_BLOCK] = i % 2 ? DATE_2020_03_15 : DATE_1970_01_01;
+    }
+    blocks[0].is_null[1] = 0b010; // b of tuple 1 is NULL
+    const auto data = reinterpret_cast<const uint8_t*>(blocks);
+
+    std::vector<const ast::Constant*> constants(S.num_entries(), nullptr);
+    ResultSetDecoder decoder(S, S, &layout, constants);
+    ResultColumns columns(S);
+
+    SECTION("value sizes")
+    {
+        REQUIRE(columns.columns.size() == 3);
+        CHECK(columns.columns[0].value_size == 8);
+        CHECK(columns.columns[1].value_size == 8);
+        CHECK(columns.columns[2].value_size == 4);
+    }
+
+    SECTION("across blocks")
+    {
+        decoder.decode(data, 2, 3, columns);
+        REQUIRE(columns.num_tuples == 3);
+        for (std::size_t j = 0; j != 3; ++j) {
+            const std::size_t i = 2 + j;
+            CHECK(read<int64_t>(columns.columns[0][j]) == int64_t(10 * i));
+            CHECK(read<double>(columns.columns[1][j]) == 0.5 * i);
+            CHECK(read<int32_t>(columns.columns[2][j]) == (i % 2 ? DATE_2020_03_15 : DATE_1970_01_01));
+            CHECK(not columns.columns[0].is_null[j]);
+            CHECK(not columns.columns[1].is_null[j]);
+            CHECK(not columns.columns[2].is_null[j]);
+        }
+    }
+
+    SECTION("NULL bits")
+    {
+        decoder.decode(data, 0, 6, columns);
+        CHECK(columns.columns[0].is_null == std::vector<uint8_t>{ 0, 0, 0, 0, 0, 0 });
+        CHECK(columns.columns[1].is_null == std::vector<uint8_t>{ 0, 1, 0, 0, 0, 0 });
+        CHECK(columns.columns[2].is_null == std::vector<uint8_t>{ 0, 0, 0, 0, 0, 0 });
+    }
+
+    SECTION("duplicate entries")
+    {
+        Schema S_dupl;
+        S_dupl.add(C.pool("d"), Type::Get_Date(Type::TY_Vector));
+        S_dupl.add(C.pool("a"), Type::Get_Integer(Type::TY_Vector, 8));
+        S_dupl.add(C.pool("d"), Type::Get_Date(Type::TY_Vector));
+        std::vector<const ast::Constant*> constants_dupl(S_dupl.num_entries(), nullptr);
+        ResultSetDecoder decoder_dupl(S_dupl, S, &layout, constants_dupl);
+        ResultColumns columns_dupl(S_dupl);
+        decoder_dupl.decode(data, 4, 2, columns_dupl);
+        REQUIRE(columns_dupl.num_tuples == 2);
+        CHECK(read<int64_t>(columns_dupl.columns[1][0]) == 40);
+        CHECK(read<int64_t>(columns_dupl.columns[1][1]) == 50);
+        CHECK(columns_dupl.columns[0].values == columns_dupl.columns[2].values);
+    }
+
+    SECTION("writing columns")
+    {
+        decoder.decode(data, 0, 6, columns);
+        std::ostringstream out;
+        {
+            ResultWriter writer(out, S, ResultWriter::F_CSV);
+            writer.write(columns);
+        }
+        CHECK(out.str() == "0,0,1970-01-01\n"
+                           "10,NULL,2020-03-15\n"
+                           "20,1,1970-01-01\n"
+                           "30,1.5,2020-03-15\n"
+                           "40,2,1970-01-01\n"
+                           "50,2.5,2020-03-15\n");
+    }
+}
@@ -0,0 +1,125 @@
+#include "catch2/catch.hpp"
+
+#include "backend/ResultWriter.hpp"
+#include "backend/StackMachine.hpp"
+#include <cstring>
+#include <mutable/catalog/Catalog.hpp>
+#include <sstream>
+#include <string>
+
+
+using namespace m;
+
+
+namespace {
+
+template<typename T>
+T read(const std::string &buffer, std::size_t offset)
+{
+    T value;
+    std::memcpy(&value, buffer.data() + offset, sizeof(T));
+    return value;
+}
+
+}
+
+TEST_CASE("ResultWriter", "[core][backend]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+
+    Schema S;
+    S.add(C.pool("i"),   Type::Get_Integer(Type::TY_Vector, 4));
+    S.add(C.pool("f"),   Type::Get_Float(Type::TY_Vector));
+    S.add(C.pool("d"),   Type::Get_Double(Type::TY_Vector));
+    S.add(C.pool("b"),   Type::Get_Boolean(Type::TY_Vector));
+    S.add(C.pool("s"),   Type::Get_Char(Type::TY_Vector, 6));
+    S.add(C.pool("dt"),  Type::Get_Date(Type::TY_Vector));
+    S.add(C.pool("ts"),  Type::Get_Datetime(Type::TY_Vector));
+    S.add(C.pool("dec"), Type::Get_Decimal(Type::TY_Vector, 8, 2));
+
+    Tuple tup(S);
+    tup.set(0, int64_t(-42));
+    tup.set(1, 13.37f);
+    tup.set(2, 1. / 3);
+    tup.set(3, true);
+    tup.not_null(4);
+    std::strcpy(reinterpret_cast<char*>(tup[4].as_p()), "a\tb");
+    tup.set(5, int64_t((2001 << 9) | (9 << 5) | 28));
+    tup.set(6, int64_t(1001709520)); // 2001-09-28 20:38:40
+    tup.set(7, int64_t(-1205)); // -12.05
+
+    Tuple tup_null(S); // entries which are not set are NULL
+    tup_null.set(0, int64_t(7));
+    tup_null.set(3, false);
+
+    SECTION("CSV equals StackMachine printing")
+    {
+        std::ostringstream expected;
+        StackMachine printer(S);
+        auto ostream_index = printer.add(&expected);
+        for (std::size_t i = 0; i != S.num_entries(); ++i) {
+            if (i != 0)
+                printer.emit_Putc(ostream_index, ',');
+            printer.emit_Ld_Tup(0, i);
+            printer.emit_Print(ostream_index, S[i].type);
+        }
+        for (Tuple *t : { &tup, &tup_null }) {
+            Tuple *args[] = { t };
+            printer(args);
+            expected << '\n';
+        }
+
+        std::ostringstream out;
+        {
+            ResultWriter W(out, S, ResultWriter::F_CSV);
+            W.write(tup);
+            W.write(tup_null);
+        }
+        CHECK(out.str() == expected.str());
+        CHECK(out.str() == "-42,13.37,0.3333333333333333,TRUE,\"a\tb\",2001-09-28,2001-09-28 20:38:40,-1205\n"
+                           "7,NULL,NULL,FALSE,NULL,NULL,NULL,NULL\n");
+    }
+
+    SECTION("TSV")
+    {
+        std::ostringstream out;
+        ResultWriter W(out, S, ResultWriter::F_TSV);
+        W.write(tup);
+        CHECK(out.str().empty()); // buffered
+        W.flush();
+        CHECK(out.str() == "-42\t13.37\t0.3333333333333333\tTRUE\ta\\tb\t2001-09-28\t2001-09-28 20:38:40\t-12.05\n");
+    }
+
+    SECTION("binary")
+    {
+        std::ostringstream out;
+        {
+            ResultWriter W(out, S, ResultWriter::F_Binary);
+            W.write(tup);
+            W.write(tup_null);
+        }
+        const std::size_t decimal_size = S[7].type->size() / 8;
+        const std::size_t row_size = 1 + 4 + 4 + 8 + 1 + 6 + 4 + 8 + decimal_size;
+        const std::string bytes = out.str();
+        REQUIRE(bytes.size() == 2 * row_size);
+
+        CHECK(uint8_t(bytes[0]) == 0);
+        CHECK(read<int32_t>(bytes, 1) == -42);
+        CHECK(read<float>(bytes, 5) == 13.37f);
+        CHECK(read<double>(bytes, 9) == 1. / 3);
+        CHECK(bytes[17] == 1);
+        CHECK(bytes.substr(18, 6) == std::string("a\tb\0\0\0", 6));
+        CHECK(read<int32_t>(bytes, 24) == ((2001 << 9) | (9 << 5) | 28));
+        CHECK(read<int64_t>(bytes, 28) == 1001709520);
+        if (decimal_size == 4)
+            CHECK(read<int32_t>(bytes, 36) == -1205);
+        else
+            CHECK(read<int64_t>(bytes, 36) == -1205);
+
+        CHECK(uint8_t(bytes[row_size]) == 0b11110110);
+        CHECK(read<int32_t>(bytes, row_size + 1) == 7);
+        CHECK(read<double>(bytes, row_size + 9) == 0.); // NULL
+        CHECK(bytes[row_size + 17] == 0);
+    }
+}
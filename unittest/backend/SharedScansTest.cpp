@@ -0,0 +1,73 @@
+#include "catch2/catch.hpp"
+
+#include "backend/SharedScans.hpp"
+#include "storage/RowStore.hpp"
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <utility>
+#include <vector>
+
+
+using namespace m;
+
+
+TEST_CASE("SharedScans", "[core][backend][unit]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("SharedScans_DB"));
+    auto &A = DB.add_table(C.pool("A"));
+    A.push_back(C.pool("x"), Type::Get_Integer(Type::TY_Vector, 4));
+    A.store(std::make_unique<RowStore>(A));
+    auto &B = DB.add_table(C.pool("B"));
+    B.push_back(C.pool("x"), Type::Get_Integer(Type::TY_Vector, 4));
+    B.store(std::make_unique<RowStore>(B));
+
+    auto &scans = SharedScans::Get();
+    constexpr std::size_t M = SharedScans::MORSEL_SIZE;
+    const std::size_t num_rows = 3 * M + 42;
+
+    SECTION("first scan starts at row 0")
+    {
+        auto cursor = scans.attach(A.store(), num_rows);
+        CHECK(cursor.start() == 0);
+        CHECK(scans.num_scans(A.store()) == 1);
+
+        std::vector<std::pair<std::size_t, std::size_t>> morsels;
+        cursor.for_each_morsel([&](std::size_t begin, std::size_t end) { morsels.emplace_back(begin, end); });
+        CHECK(morsels == std::vector<std::pair<std::size_t, std::size_t>>{
+            { 0, M }, { M, 2 * M }, { 2 * M, 3 * M }, { 3 * M, num_rows }
+        });
+    }
+
+    SECTION("attach to a running scan")
+    {
+        auto running = scans.attach(A.store(), num_rows);
+        std::vector<std::pair<std::size_t, std::size_t>> morsels;
+        running.for_each_morsel([&](std::size_t begin, std::size_t end) {
+            if (begin != 2 * M) return;
+            /* Attach while the running scan reads its third morsel. */
+            auto cursor = scans.attach(A.store(), num_rows);
+            CHECK(cursor.start() == 2 * M);
+            CHECK(scans.num_scans(A.store()) == 2);
+            CHECK(scans.attach(B.store(), num_rows).start() == 0); // other store
+            cursor.for_each_morsel([&](std::size_t begin, std::size_t end) { morsels.emplace_back(begin, end); });
+        });
+        CHECK(morsels == std::vector<std::pair<std::size_t, std::size_t>>{
+            { 2 * M, 3 * M }, { 3 * M, num_rows }, { 0, M }, { M, 2 * M }
+        });
+        CHECK(scans.num_scans(A.store()) == 1);
+    }
+
+    SECTION("running scan beyond the rows to scan")
+    {
+        auto running = scans.attach(A.store(), num_rows);
+        running.for_each_morsel([&](std::size_t begin, std::size_t) {
+            if (begin == 3 * M)
+                CHECK(scans.attach(A.store(), 2 * M).start() == 0);
+        });
+    }
+
+    CHECK(scans.num_scans(A.store()) == 0);
+    CHECK(scans.num_scans(B.store()) == 0);
+}
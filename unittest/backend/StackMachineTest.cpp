@@ -336,6 +336,56 @@ TEST_CASE("StackMachine/emit/CNF", "[core][backend]")
     check_emit_cnf("Negation of disjunction",       "NOT (TRUE OR FALSE)",                  false);
 }
 
+TEST_CASE("StackMachine/emit/constant folding", "[core][backend]")
+{
+    auto parse = [](const char *expr_str) -> std::unique_ptr<Stmt> {
+        std::ostringstream oss;
+        oss << "SELECT " << expr_str << ";";
+        Diagnostic diag(true, std::cout, std::cerr);
+        auto stmt = statement_from_string(diag, oss.str());
+        M_insist(diag.num_errors() == 0);
+        return stmt;
+    };
+    auto get_expr = [](const Stmt &stmt) -> const Expr & {
+        auto select = as<const SelectStmt>(stmt).select.get();
+        return *as<const SelectClause>(select)->select[0].first;
+    };
+
+    SECTION("constant expressions are evaluated once")
+    {
+        auto stmt = parse("1 + 2 * 3");
+        auto value = Interpreter::fold(get_expr(*stmt));
+        REQUIRE(value);
+        CHECK(value->as_i() == 7);
+
+        auto stmt_constant = parse("7");
+        StackMachine SM, SM_constant;
+        SM.emit(get_expr(*stmt));
+        SM_constant.emit(get_expr(*stmt_constant));
+        CHECK(SM.num_ops() == SM_constant.num_ops());
+    }
+
+    SECTION("integral division is not folded")
+    {
+        auto stmt = parse("1 / 0");
+        CHECK_FALSE(Interpreter::fold(get_expr(*stmt)));
+    }
+
+    SECTION("identity operations")
+    {
+        auto stmt = parse("5 * 1");
+        auto &expr = as<const BinaryExpr>(get_expr(*stmt));
+        CHECK(Interpreter::identity_operand(expr) == expr.lhs.get());
+
+        auto stmt_add = parse("0 + 5");
+        auto &expr_add = as<const BinaryExpr>(get_expr(*stmt_add));
+        CHECK(Interpreter::identity_operand(expr_add) == expr_add.rhs.get());
+
+        auto stmt_sub = parse("0 - 5");
+        CHECK(Interpreter::identity_operand(as<const BinaryExpr>(get_expr(*stmt_sub))) == nullptr);
+    }
+}
+
 TEST_CASE("StackMachine/emit_Ld", "[core][backend]")
 {
     SECTION("emit_Ld_i8")
@@ -3486,3 +3536,151 @@ TEST_CASE("StackMachine/Intrinsic/Cast_d_f", "[core][backend]")
     REQUIRE(not res.is_null(0));
     REQUIRE(res[0] == d);
 }
+
+/*======================================================================================================================
+ * Superinstructions
+ *====================================================================================================================*/
+
+TEST_CASE("StackMachine/Superinstructions/LT_Tup_Ctx_i", "[core][backend]")
+{
+    StackMachine SM;
+    Tuple res({ Type::Get_Boolean(Type::TY_Scalar) });
+    Tuple in({ Type::Get_Integer(Type::TY_Scalar, 8) });
+    Tuple *args[] = { &res, &in };
+
+    SM.emit_Ld_Tup(1, 0);
+    SM.add_and_emit_load(int64_t(5));
+    SM.emit_LT_i();
+    SM.emit_St_Tup_b(0, 0);
+    const std::size_t num_ops = SM.num_ops();
+
+    in.set(0, int64_t(3));
+    SM(args);
+    REQUIRE(SM.num_ops() < num_ops); // `Ld_Tup; Ld_Ctx; LT_i` is fused
+    REQUIRE(not res.is_null(0));
+    REQUIRE(res[0].as_b());
+
+    in.set(0, int64_t(7));
+    SM(args);
+    REQUIRE(not res.is_null(0));
+    REQUIRE(not res[0].as_b());
+
+    in.null(0);
+    SM(args);
+    REQUIRE(res.is_null(0));
+}
+
+TEST_CASE("StackMachine/Superinstructions/Ld_Tup_Cast_d_i", "[core][backend]")
+{
+    StackMachine SM;
+    Tuple res({ Type::Get_Double(Type::TY_Scalar) });
+    Tuple in({ Type::Get_Integer(Type::TY_Scalar, 8) });
+    Tuple *args[] = { &res, &in };
+
+    SM.emit_Ld_Tup(1, 0);
+    SM.emit_Cast_d_i();
+    SM.emit_St_Tup_d(0, 0);
+    const std::size_t num_ops = SM.num_ops();
+
+    in.set(0, int64_t(42));
+    SM(args);
+    REQUIRE(SM.num_ops() < num_ops); // `Ld_Tup; Cast_d_i` is fused
+    REQUIRE(not res.is_null(0));
+    REQUIRE(res[0] == 42.);
+}
+
+TEST_CASE("StackMachine/Superinstructions/Cp_Tup", "[core][backend]")
+{
+    StackMachine SM;
+    Tuple res({ Type::Get_Integer(Type::TY_Scalar, 8), Type::Get_Double(Type::TY_Scalar) });
+    Tuple in({ Type::Get_Double(Type::TY_Scalar), Type::Get_Integer(Type::TY_Scalar, 8) });
+    Tuple *args[] = { &res, &in };
+
+    SM.emit_Ld_Tup(1, 1);
+    SM.emit_St_Tup_i(0, 0);
+    SM.emit_Pop();
+    SM.emit_Ld_Tup(1, 0);
+    SM.emit_St_Tup_d(0, 1);
+    SM.emit_Pop();
+    const std::size_t num_ops = SM.num_ops();
+
+    in.set(0, 3.14);
+    in.set(1, int64_t(42));
+    SM(args);
+    REQUIRE(SM.num_ops() < num_ops); // `Ld_Tup; St_Tup_X; Pop` is fused
+    REQUIRE(not res.is_null(0));
+    REQUIRE(res[0].as_i() == 42);
+    REQUIRE(not res.is_null(1));
+    REQUIRE(res[1].as_d() == 3.14);
+
+    in.null(1);
+    SM(args);
+    REQUIRE(res.is_null(0));
+}
+
+TEST_CASE("StackMachine/Superinstructions/Context registers", "[core][backend]")
+{
+    StackMachine SM;
+    Tuple res({ Type::Get_Integer(Type::TY_Scalar, 4), Type::Get_Integer(Type::TY_Scalar, 8) });
+    Tuple *args[] = { &res };
+
+    int32_t data[] = { 42, -1, 7 };
+    const std::size_t ptr = SM.add(reinterpret_cast<void*>(data));
+    const std::size_t counter = SM.add(int64_t(0));
+
+    /* Load the current value and advance the pointer, like `Interpreter::compile_load()`. */
+    SM.emit_Ld_Ctx(ptr);
+    SM.emit_Ld_i32();
+    SM.emit_St_Tup_i(0, 0);
+    SM.emit_Pop();
+    SM.add_and_emit_load(int64_t(sizeof(int32_t)));
+    SM.emit_Ld_Ctx(ptr);
+    SM.emit_Add_p();
+    SM.emit_Upd_Ctx(ptr);
+    SM.emit_Pop();
+
+    /* Count the loaded values. */
+    SM.emit_Ld_Ctx(counter);
+    SM.emit_Inc();
+    SM.emit_Upd_Ctx(counter);
+    SM.emit_Pop();
+    SM.emit_Ld_Ctx(counter);
+    SM.emit_St_Tup_i(0, 1);
+    const std::size_t num_ops = SM.num_ops();
+
+    for (std::size_t i = 0; i != 3; ++i) {
+        SM(args);
+        REQUIRE(not res.is_null(0));
+        REQUIRE(res[0].as_i() == data[i]);
+        REQUIRE(res[1].as_i() == int64_t(i + 1));
+    }
+    REQUIRE(SM.num_ops() < num_ops);
+}
+
+TEST_CASE("StackMachine/copy", "[core][backend]")
+{
+    StackMachine SM;
+    Tuple res({ Type::Get_Integer(Type::TY_Scalar, 8) });
+    Tuple *args[] = { &res };
+
+    const std::size_t counter = SM.add(int64_t(0));
+    SM.emit_Ld_Ctx(counter);
+    SM.emit_Inc();
+    SM.emit_Upd_Ctx(counter);
+    SM.emit_St_Tup_i(0, 0);
+
+    /* The copy starts from the context of the original but is evaluated independently. */
+    StackMachine copy(SM);
+    SM(args);
+    REQUIRE(res[0].as_i() == 1);
+    SM(args);
+    REQUIRE(res[0].as_i() == 2);
+    copy(args);
+    REQUIRE(res[0].as_i() == 1);
+
+    StackMachine copy_of_evaluated(SM);
+    copy_of_evaluated(args);
+    REQUIRE(res[0].as_i() == 3);
+    SM(args);
+    REQUIRE(res[0].as_i() == 3);
+}
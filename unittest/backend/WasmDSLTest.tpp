@@ -24,6 +24,26 @@ TEST_CASE("Wasm/" BACKEND_NAME "/ModuleInstance create from module", "[core][was
     Module::Dispose();
 }
 
+TEST_CASE("Wasm/" BACKEND_NAME "/Module release & reuse", "[core][wasm]")
+{
+    Module::Init();
+    Module::Get().emit_global<int32_t>("g", false, 42);
+    const unsigned id = Module::ID();
+
+    auto module = Module::Release();
+    REQUIRE(bool(module));
+    Module::Init(std::move(module));
+    CHECK(Module::ID() != id);
+    REQUIRE(Module::Validate());
+    Module::Get().emit_global<int32_t>("g", false, 42); // the global of the previous query was removed
+
+    CHECK_RESULT_INLINE(42, int(), {
+        RETURN(42);
+    });
+
+    Module::Dispose();
+}
+
 TEST_CASE("Wasm/" BACKEND_NAME "/wasm_type", "[core][wasm]")
 {
     /*----- Void -----*/
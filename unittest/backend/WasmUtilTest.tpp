@@ -423,6 +423,65 @@ TEST_CASE("Wasm/" BACKEND_NAME "/string comparison", "[core][wasm]")
         }
     }
 
+    SECTION("equality decided on prefixes")
+    {
+        auto cs = m::Type::Get_Varchar(m::Type::TY_Scalar, 8);
+
+        SECTION("short strings with garbage after the NUL byte")
+        {
+            FUNCTION(test, void(void)) {
+                auto left = Module::Allocator().malloc<char>(8);
+                *left = 'D'; *(left + 1) = 'E'; *(left + 2) = '\0'; *(left + 3) = 'x';
+                auto right = Module::Allocator().malloc<char>(8);
+                *right = 'D'; *(right + 1) = 'E'; *(right + 2) = '\0'; *(right + 3) = 'y';
+                auto equal = strcmp(NChar(left, false, cs), NChar(right, false, cs), EQ);
+                WASM_CHECK(equal.insist_not_null(), "result mismatch");
+            }
+            REQUIRE_NOTHROW(INVOKE(test));
+        }
+
+        SECTION("different prefixes")
+        {
+            FUNCTION(test, void(void)) {
+                auto left = Module::Allocator().malloc<char>(8);
+                *left = 'D'; *(left + 1) = 'E'; *(left + 2) = '\0';
+                auto right = Module::Allocator().malloc<char>(8);
+                *right = 'D'; *(right + 1) = 'K'; *(right + 2) = '\0';
+                auto not_equal = strcmp(NChar(left, false, cs), NChar(right, false, cs), NE);
+                WASM_CHECK(not_equal.insist_not_null(), "result mismatch");
+            }
+            REQUIRE_NOTHROW(INVOKE(test));
+        }
+
+        SECTION("equal prefixes, different suffixes")
+        {
+            FUNCTION(test, void(void)) {
+                auto left = Module::Allocator().malloc<char>(8);
+                *left = 'T'; *(left + 1) = 'e'; *(left + 2) = 's'; *(left + 3) = 't'; *(left + 4) = 'a';
+                *(left + 5) = '\0';
+                auto right = Module::Allocator().malloc<char>(8);
+                *right = 'T'; *(right + 1) = 'e'; *(right + 2) = 's'; *(right + 3) = 't'; *(right + 4) = 'b';
+                *(right + 5) = '\0';
+                auto equal = strcmp(NChar(left, false, cs), NChar(right, false, cs), EQ);
+                WASM_CHECK(not equal.insist_not_null(), "result mismatch");
+            }
+            REQUIRE_NOTHROW(INVOKE(test));
+        }
+
+        SECTION("comparison of fewer characters than the prefix")
+        {
+            FUNCTION(test, void(void)) {
+                auto left = Module::Allocator().malloc<char>(8);
+                *left = 'T'; *(left + 1) = 'e'; *(left + 2) = 's'; *(left + 3) = 't'; *(left + 4) = '\0';
+                auto right = Module::Allocator().malloc<char>(8);
+                *right = 'T'; *(right + 1) = 'e'; *(right + 2) = 'a'; *(right + 3) = 'm'; *(right + 4) = '\0';
+                auto equal = strncmp(NChar(left, false, cs), NChar(right, false, cs), U32x1(2), EQ);
+                WASM_CHECK(equal.insist_not_null(), "result mismatch");
+            }
+            REQUIRE_NOTHROW(INVOKE(test));
+        }
+    }
+
     CodeGenContext::Dispose();
     Module::Dispose();
 }
@@ -492,6 +551,81 @@ TEST_CASE("Wasm/" BACKEND_NAME "/strncpy", "[core][wasm]")
     Module::Dispose();
 }
 
+TEST_CASE("Wasm/" BACKEND_NAME "/LIKE with static pattern", "[core][wasm]")
+{
+    Module::Init();
+    CodeGenContext::Init();
+
+    /* Strings longer than 16 characters to exercise the SIMD kernels across chunk boundaries. */
+    constexpr std::size_t LENGTH = 40;
+    auto cs = m::Type::Get_Char(m::Type::TY_Scalar, LENGTH);
+    auto make_string = [&](const char *str) {
+        auto ptr = Module::Allocator().malloc<char>(LENGTH);
+        const std::size_t len = std::min(strlen(str) + 1, LENGTH); // including terminating NUL byte, if it fits
+        for (std::size_t i = 0; i != len; ++i)
+            *(ptr + i) = str[i];
+        for (std::size_t i = len; i < LENGTH; ++i)
+            *(ptr + i) = 'x'; // garbage after the terminating NUL byte must be ignored
+        return NChar(ptr, false, cs);
+    };
+    auto pool = [](const char *str) { return m::Catalog::Get().pool(str); };
+
+    SECTION("contains")
+    {
+        FUNCTION(test, void(void)) {
+            auto match = like_contains(make_string("The quick brown fox jumps over the dog"), pool("%over the%"));
+            WASM_CHECK(match.insist_not_null(), "result mismatch");
+            auto first = like_contains(make_string("quick brown fox"), pool("%qu%"));
+            WASM_CHECK(first.insist_not_null(), "result mismatch");
+            auto no_match = like_contains(make_string("The quick brown fox jumps over the dog"), pool("%over a%"));
+            WASM_CHECK(not no_match.insist_not_null(), "result mismatch");
+            auto after_nul = like_contains(make_string("The quick brown fox"), pool("%xxx%"));
+            WASM_CHECK(not after_nul.insist_not_null(), "result mismatch");
+        }
+        REQUIRE_NOTHROW(INVOKE(test));
+    }
+
+    SECTION("prefix")
+    {
+        FUNCTION(test, void(void)) {
+            auto match = like_prefix(make_string("The quick brown fox jumps"), pool("The quick brown fox%"));
+            WASM_CHECK(match.insist_not_null(), "result mismatch");
+            auto no_match = like_prefix(make_string("The quick brown fox jumps"), pool("The quick brown cat%"));
+            WASM_CHECK(not no_match.insist_not_null(), "result mismatch");
+            auto too_short = like_prefix(make_string("The"), pool("The quick%"));
+            WASM_CHECK(not too_short.insist_not_null(), "result mismatch");
+        }
+        REQUIRE_NOTHROW(INVOKE(test));
+    }
+
+    SECTION("suffix")
+    {
+        FUNCTION(test, void(void)) {
+            auto match = like_suffix(make_string("The quick brown fox jumps"), pool("%brown fox jumps"));
+            WASM_CHECK(match.insist_not_null(), "result mismatch");
+            auto no_match = like_suffix(make_string("The quick brown fox jumps"), pool("%brown fox jump"));
+            WASM_CHECK(not no_match.insist_not_null(), "result mismatch");
+            auto too_short = like_suffix(make_string("fox"), pool("%a fox"));
+            WASM_CHECK(not too_short.insist_not_null(), "result mismatch");
+        }
+        REQUIRE_NOTHROW(INVOKE(test));
+    }
+
+    SECTION("equality of long strings")
+    {
+        FUNCTION(test, void(void)) {
+            auto equal = strcmp(make_string("The quick brown fox jumps"), make_string("The quick brown fox jumps"), EQ);
+            WASM_CHECK(equal.insist_not_null(), "result mismatch");
+            auto less = strcmp(make_string("The quick brown fox jumps"), make_string("The quick brown fox lumps"), LT);
+            WASM_CHECK(less.insist_not_null(), "result mismatch");
+        }
+        REQUIRE_NOTHROW(INVOKE(test));
+    }
+
+    CodeGenContext::Dispose();
+    Module::Dispose();
+}
+
 TEMPLATE_TEST_CASE("Wasm/" BACKEND_NAME "/Decimal", "[core][wasm]",
     Decimal32, Decimal64)
 {
@@ -430,6 +430,20 @@ TEST_CASE("AdjacencyMatrix/transitive_closure_directed", "[core][util][unit]")
         expected(D, B) = expected(D, C) = expected(D, E) = true;
         CHECK(expected == closure);
     }
+
+    SECTION("long chain")
+    {
+        /* 63 → 62 → ... → 1 → 0 */
+        const std::size_t N = 64;
+        AdjacencyMatrix M(N);
+        for (std::size_t i = 1; i != N; ++i)
+            M(i, i - 1) = true;
+        AdjacencyMatrix closure = M.transitive_closure_directed();
+
+        for (std::size_t i = 0; i != N; ++i)
+            for (std::size_t j = 0; j != N; ++j)
+                REQUIRE(closure(i, j) == (j < i));
+    }
 }
 
 TEST_CASE("AdjacencyMatrix/transitive_closure_undirected", "[core][util][unit]")
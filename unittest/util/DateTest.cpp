@@ -0,0 +1,95 @@
+#include "catch2/catch.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include "util/Date.hpp"
+
+
+using namespace m;
+
+
+TEST_CASE("date/encoding", "[core][util][date]")
+{
+    const int32_t d = date::encode(1995, 3, 17);
+    CHECK(date::year(d) == 1995);
+    CHECK(date::month(d) == 3);
+    CHECK(date::day(d) == 17);
+    CHECK(date::year(date::encode(-44, 3, 15)) == -44);
+    CHECK(date::encode(1995, 3, 17) < date::encode(1995, 3, 18));
+    CHECK(date::encode(1995, 12, 31) < date::encode(1996, 1, 1));
+}
+
+TEST_CASE("date/days", "[core][util][date]")
+{
+    using namespace std::chrono;
+
+    CHECK(date::to_days(date::encode(1970, 1, 1)) == 0);
+    CHECK(date::from_days(0) == date::encode(1970, 1, 1));
+
+    for (int32_t n = -1'000'000; n <= 1'000'000; n += 37) {
+        const year_month_day ymd{ sys_days(days(n)) };
+        const int32_t d = date::from_days(n);
+        REQUIRE(date::year(d) == int(ymd.year()));
+        REQUIRE(date::month(d) == unsigned(ymd.month()));
+        REQUIRE(date::day(d) == unsigned(ymd.day()));
+        REQUIRE(date::to_days(d) == n);
+    }
+}
+
+TEST_CASE("date/arithmetic", "[core][util][date]")
+{
+    SECTION("days")
+    {
+        CHECK(date::add_days(date::encode(1996, 2, 28), 1) == date::encode(1996, 2, 29));
+        CHECK(date::add_days(date::encode(1995, 2, 28), 1) == date::encode(1995, 3, 1));
+        CHECK(date::add_days(date::encode(1995, 1, 1), -1) == date::encode(1994, 12, 31));
+    }
+
+    SECTION("months")
+    {
+        CHECK(date::add_months(date::encode(1995, 1, 31), 1) == date::encode(1995, 2, 28));
+        CHECK(date::add_months(date::encode(1996, 1, 31), 1) == date::encode(1996, 2, 29));
+        CHECK(date::add_months(date::encode(1995, 11, 15), 3) == date::encode(1996, 2, 15));
+        CHECK(date::add_months(date::encode(1995, 1, 15), -13) == date::encode(1993, 12, 15));
+    }
+
+    SECTION("days in month")
+    {
+        const unsigned expected[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        for (unsigned m = 1; m <= 12; ++m)
+            CHECK(date::days_in_month(1995, m) == expected[m - 1]);
+        CHECK(date::days_in_month(1996, 2) == 29);
+        CHECK(date::days_in_month(1900, 2) == 28);
+        CHECK(date::days_in_month(2000, 2) == 29);
+    }
+}
+
+TEST_CASE("date/truncation", "[core][util][date]")
+{
+    CHECK(date::trunc_month(date::encode(1995, 7, 4)) == date::encode(1995, 7, 1));
+    CHECK(date::trunc_year(date::encode(1995, 7, 4)) == date::encode(1995, 1, 1));
+    CHECK(date::trunc_datetime(7199, 3600) == 3600);
+    CHECK(date::trunc_datetime(-1, 3600) == -3600);
+}
+
+TEST_CASE("date/bounds", "[core][util][date]")
+{
+    auto [lo, hi] = date::year_bounds(1995);
+    CHECK(lo < date::encode(1995, 1, 1));
+    CHECK(date::encode(1995, 12, 31) <= hi);
+    CHECK(date::encode(1994, 12, 31) < lo);
+    CHECK(hi < date::encode(1996, 1, 1));
+
+    auto [mlo, mhi] = date::month_bounds(1995, 2);
+    CHECK(date::encode(1995, 1, 31) < mlo);
+    CHECK(mlo < date::encode(1995, 2, 1));
+    CHECK(date::encode(1995, 2, 28) <= mhi);
+    CHECK(mhi < date::encode(1995, 3, 1));
+}
+
+TEST_CASE("date/datetime", "[core][util][date]")
+{
+    CHECK(date::to_datetime(date::encode(1970, 1, 2)) == date::SECONDS_PER_DAY);
+    CHECK(date::from_datetime(date::SECONDS_PER_DAY - 1) == date::encode(1970, 1, 1));
+    CHECK(date::from_datetime(-1) == date::encode(1969, 12, 31));
+}
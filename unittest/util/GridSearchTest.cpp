@@ -1,6 +1,10 @@
 #include "catch2/catch.hpp"
 
+#include <algorithm>
+#include <mutex>
+#include <tuple>
 #include "util/GridSearch.hpp"
+#include <vector>
 
 
 using namespace m;
@@ -408,3 +412,25 @@ TEST_CASE("GridSearch", "[core][util]")
         {1, -10}, {1, -5}, {1, 0}, {1, 5}, {1, 10},
     });
 }
+
+TEST_CASE("GridSearch/search_parallel", "[core][util]")
+{
+    LinearSpace<int> A(0, 3, 3);
+    LinearSpace<int> B(-10, 10, 4);
+    LinearSpace<int> C(0, 2, 2);
+
+    GridSearch GS(A, B, C);
+    std::vector<std::tuple<int, int, int>> expected;
+    GS.search([&expected](int a, int b, int c) { expected.emplace_back(a, b, c); });
+
+    for (unsigned num_threads : { 1U, 2U, 7U, 100U }) {
+        std::mutex mutex;
+        std::vector<std::tuple<int, int, int>> points;
+        GS.search_parallel([&](int a, int b, int c) {
+            std::lock_guard<std::mutex> lock(mutex);
+            points.emplace_back(a, b, c);
+        }, num_threads);
+        std::sort(points.begin(), points.end());
+        CHECK(points == expected);
+    }
+}
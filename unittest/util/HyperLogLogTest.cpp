@@ -0,0 +1,68 @@
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include "util/HyperLogLog.hpp"
+#include <vector>
+
+
+using namespace m;
+
+
+TEST_CASE("hyperloglog/estimate", "[core][util][hyperloglog]")
+{
+    HyperLogLog<> sketch;
+
+    SECTION("empty")
+    {
+        CHECK(sketch.empty());
+        CHECK(sketch.estimate() == Approx(0));
+    }
+
+    SECTION("duplicates")
+    {
+        for (unsigned i = 0; i != 1000; ++i)
+            sketch.add(i % 10);
+        CHECK_FALSE(sketch.empty());
+        CHECK(sketch.estimate() == Approx(10).epsilon(0.05));
+    }
+
+    SECTION("many distinct values")
+    {
+        for (uint64_t i = 0; i != 100000; ++i)
+            sketch.add(i);
+        CHECK(sketch.estimate() == Approx(100000).epsilon(0.05));
+    }
+}
+
+TEST_CASE("hyperloglog/merge", "[core][util][hyperloglog]")
+{
+    HyperLogLog<> lhs, rhs;
+    for (uint64_t i = 0; i != 20000; ++i)
+        lhs.add(i);
+    for (uint64_t i = 10000; i != 30000; ++i)
+        rhs.add(i);
+
+    lhs.merge(rhs);
+    CHECK(lhs.estimate() == Approx(30000).epsilon(0.05));
+}
+
+TEST_CASE("hyperloglog/external registers", "[core][util][hyperloglog]")
+{
+    using HLL = HyperLogLog<>;
+    std::vector<uint8_t> groups(2 * HLL::NUM_REGISTERS, 0); // two groups with a sketch each
+    uint8_t *g0 = groups.data();
+    uint8_t *g1 = groups.data() + HLL::NUM_REGISTERS;
+
+    HLL owned;
+    for (uint64_t i = 0; i != 20000; ++i) {
+        HLL::Add(i % 2 ? g1 : g0, i);
+        owned.add(i);
+    }
+    CHECK(HLL::Estimate(g0) == Approx(10000).epsilon(0.05));
+    CHECK(HLL::Estimate(g1) == Approx(10000).epsilon(0.05));
+
+    HLL::Merge(g0, g1);
+    CHECK(std::equal(g0, g0 + HLL::NUM_REGISTERS, owned.registers()));
+    CHECK(HLL::Estimate(g0) == owned.estimate());
+}
@@ -2,6 +2,7 @@
 
 #include "util/Kmeans.hpp"
 #include <numeric>
+#include <random>
 
 
 using namespace m;
@@ -110,3 +111,33 @@ TEST_CASE("kmeans/clustering 12 rows of 2 columns into three clusters","[core][u
     CHECK(*smallest >= 0);
     CHECK(*greatest < 3);
 }
+
+TEST_CASE("kmeans/clustering many rows in mini-batch mode on multiple threads","[core][util][kmeans]")
+{
+    /* Three clusters of points around (0, 0), (50, 50), and (100, 100), interleaved. */
+    constexpr unsigned NUM_ROWS = 3 * 30000;
+    std::mt19937 g(42);
+    std::uniform_real_distribution<float> noise(-1.f, 1.f);
+    Eigen::MatrixXf test_matrix(NUM_ROWS, 2);
+    for (unsigned row_id = 0; row_id != NUM_ROWS; ++row_id) {
+        const float center = 50.f * (row_id % 3);
+        test_matrix(row_id, 0) = center + noise(g);
+        test_matrix(row_id, 1) = center + noise(g);
+    }
+
+    std::vector<unsigned> labels = kmeans(test_matrix, 3, 4);
+    REQUIRE(labels.size() == NUM_ROWS);
+
+    /* Clusters must be pairwise distinct. */
+    CHECK(labels[0] != labels[1]);
+    CHECK(labels[0] != labels[2]);
+    CHECK(labels[1] != labels[2]);
+
+    bool all_in_cluster = true;
+    for (unsigned row_id = 0; row_id != NUM_ROWS; ++row_id)
+        all_in_cluster = all_in_cluster and labels[row_id] == labels[row_id % 3];
+    CHECK(all_in_cluster);
+
+    /* The result must not depend on the number of threads. */
+    CHECK(labels == kmeans(test_matrix, 3, 1));
+}
@@ -0,0 +1,95 @@
+#include "catch2/catch.hpp"
+
+#include "util/LikeDFA.hpp"
+#include <mutable/util/fn.hpp>
+#include <string>
+#include <tuple>
+
+
+using namespace m;
+
+
+TEST_CASE("LikeDFA", "[core][util][LikeDFA]")
+{
+    SECTION("match")
+    {
+        std::tuple<std::string, std::string, bool> triples[] = {
+            /* { string, pattern, result } */
+            { "", "", true },
+            { "a", "", false },
+            { "abc", "abc", true },
+            { "abcd", "abc", false },
+            { "\\a", "\\\\_", true },
+            { "_", "\\_", true },
+            { "\\a", "\\_", false },
+            { "%", "\\%", true },
+            { "axbyzc", "a_b__c", true },
+            { "axbyc", "a_b__c", false },
+            { "", "%", true },
+            { "abc", "a%b%%c", true },
+            { "axyzbrstcd", "a%b%%c", false },
+            { "rstabuvwcxydqlmke", "%_ab%c__d%e", true },
+            { "xabcydqe", "%_ab%c__d%e", false },
+            { "xyz_u%vw", "%\\__\\%%", true },
+            { "xyz\\uv%abc", "%\\__\\%%", false },
+            { "aaab", "%aab", true },
+            { "abab", "%aab", false },
+        };
+
+        for (const auto& [str, pattern, exp] : triples) {
+            CAPTURE(str, pattern);
+            auto dfa = LikeDFA::Compile(pattern);
+            REQUIRE(dfa.has_value());
+            CHECK(exp == (*dfa)(str.c_str()));
+        }
+    }
+
+    SECTION("equivalence to like")
+    {
+        const std::string patterns[] = {
+            "%ab%", "ab%", "%ab", "a_%b", "%a%b%a%", "_%_", "%aab%ab", "a%%b__", "%\\%%", "%b_a%_b",
+        };
+        /* Compare on all strings of length up to 7 over the alphabet of the patterns and one other character. */
+        const char alphabet[] = { 'a', 'b', '%', 'x' };
+        for (auto &pattern : patterns) {
+            auto dfa = LikeDFA::Compile(pattern);
+            REQUIRE(dfa.has_value());
+            std::string str;
+            auto check = [&](auto &check, std::size_t length) -> void {
+                CAPTURE(str, pattern);
+                REQUIRE(like(str, pattern) == (*dfa)(str.c_str()));
+                if (length == 0)
+                    return;
+                for (char c : alphabet) {
+                    str.push_back(c);
+                    check(check, length - 1);
+                    str.pop_back();
+                }
+            };
+            check(check, 7);
+        }
+    }
+
+    SECTION("minimal")
+    {
+        auto dfa = LikeDFA::Compile("abc%");
+        REQUIRE(dfa.has_value());
+        CHECK(dfa->num_classes() == 4);
+        CHECK(dfa->num_states() == 5); // three prefix states, accepting sink, and rejecting sink
+        CHECK(dfa->is_sink(dfa->transition(0, dfa->class_of('x'))));
+        CHECK_FALSE(dfa->is_accepting(dfa->transition(0, dfa->class_of('x'))));
+
+        auto any = LikeDFA::Compile("%%%");
+        REQUIRE(any.has_value());
+        CHECK(any->num_states() == 1);
+        CHECK(any->is_accepting(0));
+        CHECK(any->is_sink(0));
+    }
+
+    SECTION("invalid escape sequence")
+    {
+        auto pattern = GENERATE("\\", "a\\", "\\a", "\\\\\\");
+        CAPTURE(pattern);
+        CHECK_FALSE(LikeDFA::Compile(pattern).has_value());
+    }
+}
@@ -87,6 +87,37 @@ TEST_CASE("memory::LinearAllocator", "[core][util][memory]")
         mem2.reset(); // deallocate last allocation -> reclaim memory
         CHECK(A.offset() == 0);
     }
+
+    SECTION("reusing deallocations")
+    {
+        auto mem0 = std::make_unique<Memory>(A.allocate(PAGE_SIZE));
+        auto mem1 = std::make_unique<Memory>(A.allocate(PAGE_SIZE));
+        auto mem2 = std::make_unique<Memory>(A.allocate(PAGE_SIZE));
+        CHECK(A.offset() == 3 * PAGE_SIZE);
+        *mem0->as<unsigned*>() = 42;
+
+        mem0.reset(); // deallocate first allocation
+        auto mem3 = std::make_unique<Memory>(A.allocate(PAGE_SIZE)); // reuse first allocation
+        CHECK(mem3->offset() == 0);
+        CHECK(A.offset() == 3 * PAGE_SIZE);
+        CHECK(*mem3->as<unsigned*>() == 0); // zero-filled
+
+        mem3.reset();
+        mem1.reset(); // coalesce with deallocated first allocation
+        auto mem4 = std::make_unique<Memory>(A.allocate(2 * PAGE_SIZE));
+        CHECK(mem4->offset() == 0);
+        CHECK(A.offset() == 3 * PAGE_SIZE);
+
+        mem4.reset();
+        auto mem5 = std::make_unique<Memory>(A.allocate(PAGE_SIZE)); // split deallocated range
+        CHECK(mem5->offset() == 0);
+        auto mem6 = std::make_unique<Memory>(A.allocate(PAGE_SIZE));
+        CHECK(mem6->offset() == PAGE_SIZE);
+        CHECK(A.offset() == 3 * PAGE_SIZE);
+
+        mem2.reset(); // deallocate last allocation -> reclaim memory
+        CHECK(A.offset() == 2 * PAGE_SIZE);
+    }
 #elif __APPLE__
 #endif
 
@@ -0,0 +1,65 @@
+#include "catch2/catch.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include "util/ObjectPool.hpp"
+#include <vector>
+
+
+using namespace m;
+
+
+TEST_CASE("ObjectPool", "[core][util][allocator]")
+{
+    ObjectPool pool;
+
+    SECTION("alignment")
+    {
+        for (std::size_t size : { 1, 7, 16, 17, 100, 1024 }) {
+            void *ptr = pool.allocate(size);
+            CHECK(reinterpret_cast<std::uintptr_t>(ptr) % ObjectPool::GRANULARITY == 0);
+            std::memset(ptr, 0xff, size);
+            pool.deallocate(ptr, size);
+        }
+    }
+
+    SECTION("recycle within size class")
+    {
+        void *p0 = pool.allocate(24);
+        void *p1 = pool.allocate(24);
+        CHECK(p0 != p1);
+        pool.deallocate(p0, 24);
+        CHECK(pool.allocate(17) == p0); // same size class
+        CHECK(pool.allocate(24) != p1);
+    }
+
+    SECTION("distinct size classes")
+    {
+        void *p0 = pool.allocate(16);
+        pool.deallocate(p0, 16);
+        void *p1 = pool.allocate(48);
+        CHECK(p1 != p0);
+        CHECK(pool.allocate(16) == p0);
+    }
+
+    SECTION("many objects span blocks")
+    {
+        std::vector<void*> objects;
+        for (std::size_t i = 0; i != 2 * ObjectPool::BLOCK_SIZE / 64; ++i) {
+            auto ptr = static_cast<uint64_t*>(pool.allocate(64));
+            *ptr = i;
+            objects.push_back(ptr);
+        }
+        for (std::size_t i = 0; i != objects.size(); ++i)
+            REQUIRE(*static_cast<uint64_t*>(objects[i]) == i);
+        for (auto ptr : objects)
+            pool.deallocate(ptr, 64);
+    }
+
+    SECTION("large objects")
+    {
+        void *ptr = pool.allocate(ObjectPool::MAX_OBJECT_SIZE + 1);
+        std::memset(ptr, 0, ObjectPool::MAX_OBJECT_SIZE + 1);
+        pool.deallocate(ptr, ObjectPool::MAX_OBJECT_SIZE + 1);
+    }
+}
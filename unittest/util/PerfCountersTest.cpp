@@ -0,0 +1,32 @@
+#include "catch2/catch.hpp"
+
+#include <sstream>
+#include "util/PerfCounters.hpp"
+
+
+using namespace m;
+
+
+TEST_CASE("PerfCounters", "[core][util]")
+{
+    PerfCounters counters;
+
+    counters.start();
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i != 100000; ++i)
+        sum = sum + i;
+    counters.stop();
+
+    std::ostringstream oss;
+    oss << counters;
+
+    if (not counters.available()) {
+        /* E.g. not on Linux, in a virtual machine, or prohibited by `perf_event_paranoid`. */
+        for (unsigned event = 0; event != PerfCounters::NUM_EVENTS; ++event)
+            CHECK_FALSE(counters.get(PerfCounters::event_type(event)));
+        CHECK(oss.str() == "no hardware counters available");
+    } else if (auto instructions = counters.get(PerfCounters::INSTRUCTIONS)) {
+        CHECK(*instructions >= 100000); // at least one instruction per iteration
+        CHECK(oss.str().find("instructions") != std::string::npos);
+    }
+}
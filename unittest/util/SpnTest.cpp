@@ -145,6 +145,157 @@ TEST_CASE("spn/learning","[core][util][spn]")
     }
 }
 
+TEST_CASE("spn/parallel learning","[core][util][spn]")
+{
+    /* Two pairs of dependent columns with enough rows to learn nodes in parallel. */
+    constexpr std::size_t NUM_ROWS = 4096;
+    Eigen::MatrixXf data(NUM_ROWS, 4);
+    for (std::size_t i = 0; i != NUM_ROWS; ++i) {
+        data(i, 0) = i % 16;
+        data(i, 1) = 2 * (i % 16);
+        data(i, 2) = (i * 7) % 32;
+        data(i, 3) = (i * 7) % 32 < 16 ? 0 : 1;
+    }
+    Eigen::MatrixXi null_matrix = Eigen::MatrixXi::Zero(NUM_ROWS, 4);
+
+    auto learn = [&](std::size_t num_threads, std::size_t sample_size) {
+        Eigen::MatrixXf D = data;
+        Eigen::MatrixXi N = null_matrix;
+        std::vector<Spn::LeafType> leaf_types(4, Spn::DISCRETE);
+        return Spn::learn_spn(D, N, leaf_types, num_threads, sample_size);
+    };
+
+    SECTION("same SPN as serial learning")
+    {
+        auto serial = learn(1, 0);
+        auto parallel = learn(4, 0);
+        CHECK(parallel.num_rows() == NUM_ROWS);
+        CHECK(parallel.height() == serial.height());
+        CHECK(parallel.breadth() == serial.breadth());
+        CHECK(parallel.degree() == serial.degree());
+    }
+
+    SECTION("sample")
+    {
+        auto spn = learn(2, 512);
+        /* The SPN represents all rows, although it is learned on a sample. */
+        CHECK(spn.num_rows() == NUM_ROWS);
+    }
+}
+
+TEST_CASE("spn/batch inference","[core][util][spn]")
+{
+    constexpr std::size_t NUM_ROWS = 1000;
+    Eigen::MatrixXf data(NUM_ROWS, 3);
+    for (std::size_t i = 0; i != NUM_ROWS; ++i) {
+        data(i, 0) = i % 10;
+        data(i, 1) = 3 * (i % 10);
+        data(i, 2) = i;
+    }
+    Eigen::MatrixXi null_matrix = Eigen::MatrixXi::Zero(NUM_ROWS, 3);
+    std::vector<Spn::LeafType> leaf_types = { Spn::DISCRETE, Spn::DISCRETE, Spn::CONTINUOUS };
+    auto spn = Spn::learn_spn(data, null_matrix, leaf_types);
+
+    std::vector<Spn::Filter> filters;
+    for (int i = 0; i != 10; ++i) {
+        Spn::Filter filter;
+        filter.emplace(0, std::make_pair(Spn::EQUAL, float(i)));
+        if (i % 2)
+            filter.emplace(2, std::make_pair(Spn::LESS, 100.f * i));
+        filters.push_back(std::move(filter));
+    }
+
+    std::vector<float> likelihoods;
+    spn.likelihoods(filters, likelihoods);
+    REQUIRE(likelihoods.size() == filters.size());
+    for (std::size_t i = 0; i != filters.size(); ++i)
+        CHECK(likelihoods[i] == Approx(spn.likelihood(filters[i])));
+
+    /* Every value of the first attribute occurs in a tenth of the rows. */
+    CHECK(likelihoods[0] == Approx(0.1f).margin(0.02f));
+}
+
+TEST_CASE("spn/batch update","[core][util][spn]")
+{
+    constexpr std::size_t NUM_ROWS = 100;
+    Eigen::MatrixXf data(NUM_ROWS, 2);
+    for (std::size_t i = 0; i != NUM_ROWS; ++i) {
+        data(i, 0) = i % 5;
+        data(i, 1) = i % 7;
+    }
+    Eigen::MatrixXi null_matrix = Eigen::MatrixXi::Zero(NUM_ROWS, 2);
+
+    auto learn = [&]() {
+        Eigen::MatrixXf D = data;
+        Eigen::MatrixXi N = null_matrix;
+        std::vector<Spn::LeafType> leaf_types(2, Spn::DISCRETE);
+        return Spn::learn_spn(D, N, leaf_types);
+    };
+    auto batched = learn();
+    auto single = learn();
+
+    /* Insert 50 rows with the new value 9 of the first attribute. */
+    Eigen::MatrixXf rows(50, 2);
+    for (int i = 0; i != 50; ++i) {
+        rows(i, 0) = 9;
+        rows(i, 1) = i % 7;
+    }
+    batched.insert_rows(rows);
+    for (int i = 0; i != 50; ++i) {
+        Eigen::VectorXf row = rows.row(i).transpose();
+        single.insert_row(row);
+    }
+
+    CHECK(batched.num_rows() == NUM_ROWS + 50);
+    Spn::Filter filter;
+    filter.emplace(0, std::make_pair(Spn::EQUAL, 9.f));
+    CHECK(batched.likelihood(filter) == Approx(single.likelihood(filter)));
+    CHECK(batched.likelihood(filter) > 0.f);
+}
+
+TEST_CASE("spn/serialization","[core][util][spn]")
+{
+    constexpr std::size_t NUM_ROWS = 1000;
+    Eigen::MatrixXf data(NUM_ROWS, 3);
+    for (std::size_t i = 0; i != NUM_ROWS; ++i) {
+        data(i, 0) = i % 10;
+        data(i, 1) = 3 * (i % 10);
+        data(i, 2) = i;
+    }
+    Eigen::MatrixXi null_matrix = Eigen::MatrixXi::Zero(NUM_ROWS, 3);
+    std::vector<Spn::LeafType> leaf_types = { Spn::DISCRETE, Spn::DISCRETE, Spn::CONTINUOUS };
+    auto spn = Spn::learn_spn(data, null_matrix, leaf_types);
+
+    std::stringstream buf;
+    spn.save(buf);
+    auto loaded = Spn::load(buf);
+
+    CHECK(loaded.num_rows() == spn.num_rows());
+    CHECK(loaded.height() == spn.height());
+    CHECK(loaded.breadth() == spn.breadth());
+    CHECK(loaded.degree() == spn.degree());
+    for (int i = 0; i != 10; ++i) {
+        Spn::Filter filter;
+        filter.emplace(0, std::make_pair(Spn::EQUAL, float(i)));
+        filter.emplace(2, std::make_pair(Spn::LESS, 100.f * i));
+        CHECK(loaded.likelihood(filter) == spn.likelihood(filter));
+        CHECK(loaded.expectation(2, filter) == spn.expectation(2, filter));
+    }
+
+    SECTION("truncated")
+    {
+        const std::string bytes = buf.str();
+        std::stringstream truncated(bytes.substr(0, bytes.size() / 2));
+        REQUIRE_THROWS_AS(Spn::load(truncated), m::invalid_argument);
+    }
+
+    SECTION("not an SPN")
+    {
+        std::stringstream garbage("garbage");
+        REQUIRE_THROWS_AS(Spn::load(garbage), m::invalid_argument);
+    }
+}
+
 TEST_CASE("spn/inference","[core][util][spn]")
 {
     Catalog::Clear();
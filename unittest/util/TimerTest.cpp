@@ -1,6 +1,8 @@
 #include "catch2/catch.hpp"
 #include <chrono>
 #include <mutable/util/Timer.hpp>
+#include <sstream>
+#include "util/TraceEvents.hpp"
 
 using namespace m;
 
@@ -84,3 +86,24 @@ TEST_CASE("Timer", "[core][util][timer]")
         REQUIRE_THROWS_AS(T.get("m0"), m::out_of_range);
     }
 }
+
+TEST_CASE("write_trace_events", "[core][util][timer]")
+{
+    Timer T;
+
+    {
+        auto outer = T.create_timing("outer");
+        auto inner = T.create_timing("|- inner");
+    }
+    auto active = T.create_timing("active");
+
+    std::ostringstream oss;
+    write_trace_events(oss, T);
+    const auto json = oss.str();
+
+    REQUIRE(json.starts_with("{\"traceEvents\":["));
+    REQUIRE(json.find("\"name\":\"outer\"") != std::string::npos);
+    REQUIRE(json.find("\"name\":\"inner\"") != std::string::npos); // prefix stripped
+    REQUIRE(json.find("\"name\":\"active\"") == std::string::npos); // not yet finished
+    REQUIRE(json.find("\"ts\":0,") != std::string::npos); // relative to the first measurement
+}
@@ -0,0 +1,204 @@
+#include "catch2/catch.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/util/exception.hpp>
+#include <string>
+#include "util/WireProtocol.hpp"
+
+
+using namespace m;
+using namespace m::wire;
+
+
+namespace {
+
+template<typename T>
+T read(const std::string &buffer, std::size_t offset)
+{
+    T value;
+    std::memcpy(&value, buffer.data() + offset, sizeof(T));
+    return value;
+}
+
+}
+
+TEST_CASE("wire/message", "[core][util]")
+{
+    std::string buffer;
+    append_message(buffer, MSG_QUERY, "SELECT 1;");
+    append_message(buffer, MSG_READY, "");
+
+    REQUIRE(buffer.size() == 2 * HEADER_SIZE + 9);
+    auto [type, length] = decode_header(buffer.data());
+    CHECK(type == MSG_QUERY);
+    REQUIRE(length == 9);
+    CHECK(buffer.substr(HEADER_SIZE, length) == "SELECT 1;");
+
+    auto [next_type, next_length] = decode_header(buffer.data() + HEADER_SIZE + length);
+    CHECK(next_type == MSG_READY);
+    CHECK(next_length == 0);
+}
+
+TEST_CASE("wire/BatchWriter", "[core][util]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+
+    Schema S;
+    S.add(C.pool("a"), Type::Get_Integer(Type::TY_Vector, 4));
+    S.add(C.pool("b"), Type::Get_Boolean(Type::TY_Vector));
+    S.add(C.pool("c"), Type::Get_Double(Type::TY_Vector));
+
+    SECTION("schema")
+    {
+        const std::string payload = encode_schema(S);
+        REQUIRE(read<uint32_t>(payload, 0) == 3);
+        REQUIRE(read<uint32_t>(payload, 4) == 1);
+        CHECK(payload.substr(8, 1) == "a");
+        REQUIRE(read<uint32_t>(payload, 9) == 1);
+        CHECK(payload.substr(13, 1) == "i");
+    }
+
+    SECTION("batch")
+    {
+        BatchWriter W(S);
+        Tuple tup(S);
+        for (int i = 0; i != 3; ++i) {
+            tup.set(0, i);
+            tup.set(1, i % 2 == 0);
+            tup.set(2, 0.5 * i, /* is_null= */ i == 1);
+            W.append(tup);
+        }
+        REQUIRE(W.num_rows() == 3);
+
+        const std::string payload = W.finish();
+        CHECK(W.num_rows() == 0);
+        REQUIRE(payload.size() == 4 + (1 + 3 * 4) + (1 + 1) + (1 + 3 * 8));
+        CHECK(read<uint32_t>(payload, 0) == 3);
+
+        /* a */
+        CHECK(uint8_t(payload[4]) == 0b111);
+        CHECK(read<int32_t>(payload, 5) == 0);
+        CHECK(read<int32_t>(payload, 9) == 1);
+        CHECK(read<int32_t>(payload, 13) == 2);
+
+        /* b */
+        CHECK(uint8_t(payload[17]) == 0b111);
+        CHECK(uint8_t(payload[18]) == 0b101);
+
+        /* c */
+        CHECK(uint8_t(payload[19]) == 0b101);
+        CHECK(read<double>(payload, 20) == 0.);
+        CHECK(read<double>(payload, 28) == 0.); // NULL
+        CHECK(read<double>(payload, 36) == 1.);
+    }
+}
+
+TEST_CASE("wire/decode_schema", "[core][util]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+
+    Schema S;
+    S.add(C.pool("a"), Type::Get_Integer(Type::TY_Vector, 2));
+    S.add(C.pool("b"), Type::Get_Decimal(Type::TY_Vector, 10, 2));
+    S.add(C.pool("c"), Type::Get_Char(Type::TY_Vector, 7));
+    S.add(C.pool("d"), Type::Get_Date(Type::TY_Vector));
+    S.add(C.pool("e"), Type::Get_Datetime(Type::TY_Vector));
+    S.add(C.pool("f"), Type::Get_Float(Type::TY_Vector));
+
+    const Schema decoded = decode_schema(encode_schema(S));
+    REQUIRE(decoded.num_entries() == S.num_entries());
+    for (std::size_t idx = 0; idx != S.num_entries(); ++idx) {
+        CHECK(decoded[idx].id.name == S[idx].id.name);
+        CHECK(decoded[idx].type == S[idx].type);
+    }
+
+    CHECK_THROWS_AS(parse_format("x"), m::invalid_argument);
+    CHECK_THROWS_AS(decode_schema(std::string(3, '\0')), m::invalid_argument);
+}
+
+TEST_CASE("wire/BatchReader", "[core][util]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+
+    Schema S;
+    S.add(C.pool("a"), Type::Get_Integer(Type::TY_Vector, 2));
+    S.add(C.pool("b"), Type::Get_Boolean(Type::TY_Vector));
+    S.add(C.pool("c"), Type::Get_Char(Type::TY_Vector, 5));
+    S.add(C.pool("d"), Type::Get_Date(Type::TY_Vector));
+    S.add(C.pool("e"), Type::Get_Double(Type::TY_Vector));
+
+    const char *strings[] = { "ab", "hello", "" };
+    const int32_t dates[] = { 1995 << 9 | 3 << 5 | 17, 1969 << 9 | 12 << 5 | 31, 2024 << 9 | 2 << 5 | 29 };
+
+    BatchWriter W(S);
+    Tuple tup(S);
+    for (int i = 0; i != 3; ++i) {
+        tup.set(0, int64_t(i - 1) * 1000); // negative values must be sign extended
+        tup.set(1, i % 2 == 0);
+        tup.not_null(2);
+        std::strcpy(reinterpret_cast<char*>(tup[2].as_p()), strings[i]);
+        tup.set(3, int64_t(dates[i]));
+        tup.set(4, 0.5 * i, /* is_null= */ i == 1);
+        W.append(tup);
+    }
+    const std::string payload = W.finish();
+
+    BatchReader R(S, payload);
+    REQUIRE(R.num_rows() == 3);
+    Tuple out(S);
+    for (int i = 0; i != 3; ++i) {
+        REQUIRE_FALSE(R.empty());
+        R.read(out);
+        CHECK(out[0].as_i() == (i - 1) * 1000);
+        CHECK(out[1].as_b() == (i % 2 == 0));
+        CHECK(std::strcmp(reinterpret_cast<const char*>(out[2].as_p()), strings[i]) == 0);
+        CHECK(out[3].as_i() == dates[i]);
+        if (i == 1)
+            CHECK(out.is_null(4));
+        else
+            CHECK(out[4].as_d() == 0.5 * i);
+    }
+    CHECK(R.empty());
+
+    SECTION("malformed batch")
+    {
+        CHECK_THROWS_AS(BatchReader(S, payload.substr(0, payload.size() - 1)), m::invalid_argument);
+    }
+
+    SECTION("append message")
+    {
+        const std::string message = encode_append("T", payload);
+        auto [table_name, batch] = decode_append(message);
+        CHECK(table_name == "T");
+        CHECK(batch == payload);
+    }
+}
+
+TEST_CASE("wire/replicate", "[core][util]")
+{
+    ReplicatedTransaction transaction;
+    transaction.position = 42;
+    transaction.commit_time = 1700000000123456;
+    transaction.changes.push_back({ "", "", "CREATE DATABASE db;" });
+    transaction.changes.push_back({ "db", "T", std::string("\x03\0\0\0\0\0\0\0", 8) });
+
+    const std::string payload = encode_replicate(transaction);
+    const ReplicatedTransaction decoded = decode_replicate(payload);
+    CHECK(decoded.position == 42);
+    CHECK(decoded.commit_time == 1700000000123456);
+    REQUIRE(decoded.changes.size() == 2);
+    CHECK(decoded.changes[0].database.empty());
+    CHECK(decoded.changes[0].table.empty());
+    CHECK(decoded.changes[0].data == "CREATE DATABASE db;");
+    CHECK(decoded.changes[1].database == "db");
+    CHECK(decoded.changes[1].table == "T");
+    CHECK(decoded.changes[1].data == transaction.changes[1].data);
+
+    CHECK_THROWS_AS(decode_replicate(payload.substr(0, payload.size() - 1)), m::invalid_argument);
+    CHECK_THROWS_AS(decode_replicate(payload + '\0'), m::invalid_argument);
+}
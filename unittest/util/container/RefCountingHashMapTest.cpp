@@ -1,7 +1,12 @@
 #include "catch2/catch.hpp"
 
 #include "util/container/RefCountingHashMap.hpp"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
 #include <set>
+#include <vector>
 
 
 using namespace m;
@@ -379,6 +384,40 @@ TEST_CASE("RefCountingHashMap", "[core][util][container]")
         }
     }
 
+    SECTION("for_all batched")
+    {
+        map_type map(8);
+
+        map.insert_with_duplicates(0, 0);
+        map.insert_with_duplicates(0, 1);
+        map.insert_with_duplicates(1, 0);
+        map.insert_with_duplicates(3, 0);
+        map.insert_with_duplicates(1, 1);
+
+        const int32_t keys[] = { 1, 2, 0, 3, 1 };
+        std::vector<std::set<typename map_type::value_type>> matches(std::size(keys));
+        map.for_all(keys, std::size(keys), [&](std::size_t i, map_type::value_type &v) {
+            matches[i].insert(v);
+        });
+        REQUIRE(matches[0] == std::set<typename map_type::value_type>{ {1, 0}, {1, 1} });
+        REQUIRE(matches[1].empty());
+        REQUIRE(matches[2] == std::set<typename map_type::value_type>{ {0, 0}, {0, 1} });
+        REQUIRE(matches[3] == std::set<typename map_type::value_type>{ {3, 0} });
+        REQUIRE(matches[4] == matches[0]);
+
+        /* more keys than fit into a single batch */
+        std::vector<int32_t> many_keys(3 * map_type::BATCH_SIZE + 1);
+        for (std::size_t i = 0; i != many_keys.size(); ++i)
+            many_keys[i] = i % 4;
+        std::vector<std::size_t> num_matches(many_keys.size());
+        map.for_all(many_keys.data(), many_keys.size(), [&](std::size_t i, map_type::value_type &v) {
+            REQUIRE(v.first == many_keys[i]);
+            ++num_matches[i];
+        });
+        for (std::size_t i = 0; i != many_keys.size(); ++i)
+            CHECK(num_matches[i] == map.count(many_keys[i]));
+    }
+
     SECTION("count")
     {
         map_type map(8);
@@ -612,3 +651,96 @@ TEST_CASE("RefCountingHashMap", "[core][util][container]")
         CHECK(map.count(7) == 1);
     }
 }
+
+TEST_CASE("RefCountingHashMap/growing", "[core][util][container]")
+{
+    using map_type = RefCountingHashMap<int32_t, int32_t>;
+    map_type map(1024);
+
+    /* Fill the map up to its high watermark and insert one more entry to start growing. */
+    const int32_t n = map.watermark_high() + 1;
+    for (int32_t i = 0; i != n; ++i)
+        map.insert_with_duplicates(i % 700, i);
+    REQUIRE(map.growing());
+    REQUIRE(map.capacity() == 2048);
+    REQUIRE(map.size() == std::size_t(n));
+
+    SECTION("lookups find entries of both tables")
+    {
+        for (int32_t key = 0; key != 700; ++key)
+            CHECK(map.count(key) == std::size_t(key < n - 700 ? 2 : 1));
+        CHECK(map.count(700) == 0);
+
+        const int32_t keys[] = { 0, 699, 700, 1 };
+        std::vector<std::size_t> num_matches(std::size(keys));
+        map.for_all(keys, std::size(keys), [&](std::size_t i, map_type::value_type &v) {
+            CHECK(v.first == keys[i]);
+            ++num_matches[i];
+        });
+        CHECK(num_matches == std::vector<std::size_t>{ 2, 1, 0, 2 });
+    }
+
+    SECTION("insertions migrate the old table")
+    {
+        const std::size_t num_inserts = 1024 / map_type::MIGRATION_STEP;
+        for (std::size_t i = 0; i != num_inserts; ++i)
+            map.insert_with_duplicates(-1, i);
+        CHECK_FALSE(map.growing());
+        CHECK(map.size() == n + num_inserts);
+        CHECK(map.count(-1) == num_inserts);
+        CHECK(map.count(0) == 2);
+    }
+
+    SECTION("iteration completes the migration")
+    {
+        std::size_t num_entries = 0;
+        for (auto &entry : map) {
+            CHECK(entry.second % 700 == entry.first);
+            ++num_entries;
+        }
+        CHECK_FALSE(map.growing());
+        CHECK(num_entries == std::size_t(n));
+    }
+
+    SECTION("find completes the migration")
+    {
+        auto it = map.find(42);
+        REQUIRE(it != map.end());
+        CHECK(it->first == 42);
+        CHECK_FALSE(map.growing());
+    }
+}
+
+TEST_CASE("RefCountingHashMap/benchmark", "[.][benchmark][util][container]")
+{
+    /* Hidden by default, run with `[benchmark]`.  Reports the throughput of insertions and lookups with a quarter of
+     * missing keys when the map is filled to various load factors. */
+    using map_type = RefCountingHashMap<uint64_t, uint64_t>;
+    using clock = std::chrono::steady_clock;
+    constexpr std::size_t CAPACITY = 1UL << 20;
+    auto hash = [](uint64_t key) { return key * 0x9e3779b97f4a7c15UL; }; // spread keys over all bits, incl. the tag
+
+    for (float load_factor : { .25f, .5f, .75f, .9f }) {
+        RefCountingHashMap<uint64_t, uint64_t, decltype(hash)> map(CAPACITY, hash);
+        map.max_load_factor(.99f);
+        const std::size_t num_keys = CAPACITY * load_factor;
+
+        auto start = clock::now();
+        for (uint64_t key = 0; key != num_keys; ++key)
+            map.insert_with_duplicates(key, key);
+        const std::chrono::duration<double> insert_time = clock::now() - start;
+
+        std::vector<uint64_t> keys(num_keys);
+        for (std::size_t i = 0; i != num_keys; ++i)
+            keys[i] = (i * 7919) % (num_keys + num_keys / 3); // about a quarter of the keys are missing
+        std::size_t num_matches = 0;
+        start = clock::now();
+        map.for_all(keys.data(), keys.size(), [&](std::size_t, map_type::value_type&) { ++num_matches; });
+        const std::chrono::duration<double> lookup_time = clock::now() - start;
+
+        CHECK(map.capacity() == CAPACITY);
+        std::cout << "load factor " << load_factor << ": " << num_keys / insert_time.count() / 1e6
+                  << " M inserts/s, " << num_keys / lookup_time.count() / 1e6 << " M lookups/s, " << num_matches
+                  << " matches\n";
+    }
+}